@@ -95,6 +95,7 @@ class CLIEventTestTest(ScriptedLoadableModuleTest):
         self.test_CLIStatusEventTestCancel()
         self.test_CLIStatusEventOnErrorTestSynchronous()
         self.test_CLIStatusEventOnErrorTestAsynchronous()
+        self.test_CLIRunAsync()
         self.test_SubjectHierarchyReference()
 
     # Testing a the status event on a normal execution
@@ -139,6 +140,35 @@ class CLIEventTestTest(ScriptedLoadableModuleTest):
         self.assertEqual(logic.StatusEvents, expectedEvents)
         self.delayDisplay("Testing normal execution Passed")
 
+    def test_CLIRunAsync(self):
+        self.delayDisplay("Testing future returned by slicer.cli.runAsync")
+
+        tempFile = qt.QTemporaryFile("CLIEventTest-outputFile-XXXXXX")
+        self.assertTrue(tempFile.open())
+
+        parameters = {}
+        parameters["InputValue1"] = 1
+        parameters["InputValue2"] = 2
+        parameters["OperationType"] = "Addition"
+        parameters["OutputFile"] = tempFile.fileName()
+
+        completedFutures = []
+        future = slicer.cli.runAsync(slicer.modules.cli4test, parameters=parameters)
+        future.add_done_callback(completedFutures.append)
+        self.assertFalse(future.done())
+
+        cliNode = future.result(timeout=60)
+        self.assertTrue(future.done())
+        self.assertFalse(future.cancelled())
+        self.assertEqual(cliNode.GetStatus(), cliNode.Completed)
+        self.assertEqual(completedFutures, [future])
+
+        # Callback added after completion is called immediately
+        future.add_done_callback(completedFutures.append)
+        self.assertEqual(len(completedFutures), 2)
+
+        self.delayDisplay("Testing slicer.cli.runAsync Passed")
+
     # Testing the status event on a bad execution
     def test_CLIStatusEventOnErrorTestSynchronous(self):
         self._testCLIStatusEventOnErrorTest(True)
@@ -79,6 +79,7 @@ class UtilTestTest(ScriptedLoadableModuleTest):
         self.test_arrayFromVTKMatrix()
         self.test_arrayFromTransformMatrix()
         self.test_arrayFromMarkupsControlPoints()
+        self.test_arrayFromSegmentInternalBinaryLabelmap()
         self.test_array()
 
     def test_setSliceViewerLayers(self):
@@ -444,6 +445,47 @@ class UtilTestTest(ScriptedLoadableModuleTest):
         markupsNode.GetNthControlPointPositionWorld(1, position)
         np.testing.assert_array_equal(position, narray[1, :])
 
+    def test_arrayFromSegmentInternalBinaryLabelmap(self):
+        # Test if modifying a segment via a numpy array and reporting the modified region works
+        import numpy as np
+
+        self.delayDisplay("Test arrayFromSegmentInternalBinaryLabelmap")
+
+        segmentationNode = slicer.mrmlScene.AddNewNodeByClass("vtkMRMLSegmentationNode")
+        segmentId = segmentationNode.GetSegmentation().AddEmptySegment("Segment")
+        labelmap = slicer.vtkOrientedImageData()
+        labelmap.SetExtent(5, 24, 0, 29, 0, 9)
+        labelmap.AllocateScalars(vtk.VTK_UNSIGNED_CHAR, 1)
+        labelmap.GetPointData().GetScalars().Fill(1)
+        slicer.vtkSlicerSegmentationsModuleLogic.SetBinaryLabelmapToSegment(labelmap, segmentationNode, segmentId)
+
+        narray = slicer.util.arrayFromSegmentInternalBinaryLabelmap(segmentationNode, segmentId)
+        self.assertEqual(narray.shape, (10, 30, 20))
+
+        self.delayDisplay("Test arrayFromSegmentInternalBinaryLabelmapModified with modified region")
+
+        internalLabelmap = segmentationNode.GetBinaryLabelmapInternalRepresentation(segmentId)
+        labelmapExtent = internalLabelmap.GetExtent()
+        lastUpdateMTime = internalLabelmap.GetMTime()
+        narray[2:4, 10:15, 3] = 0
+        slicer.util.arrayFromSegmentInternalBinaryLabelmapModified(segmentationNode, segmentId, np.s_[2:4, 10:15, 3])
+        self.assertGreater(internalLabelmap.GetMTime(), lastUpdateMTime)
+        self.assertEqual(internalLabelmap.GetScalarComponentAsDouble(labelmapExtent[0] + 3, labelmapExtent[2] + 12, labelmapExtent[4] + 3, 0), 0)
+        modifiedExtent = [0] * 6
+        self.assertTrue(internalLabelmap.GetModifiedExtent(lastUpdateMTime, modifiedExtent))
+        self.assertEqual(modifiedExtent, [
+            labelmapExtent[0] + 3, labelmapExtent[0] + 3,
+            labelmapExtent[2] + 10, labelmapExtent[2] + 14,
+            labelmapExtent[4] + 2, labelmapExtent[4] + 3])
+
+        self.delayDisplay("Test arrayFromSegmentInternalBinaryLabelmapModified without modified region")
+
+        lastUpdateMTime = internalLabelmap.GetMTime()
+        narray[:] = 1
+        slicer.util.arrayFromSegmentInternalBinaryLabelmapModified(segmentationNode, segmentId)
+        self.assertGreater(internalLabelmap.GetMTime(), lastUpdateMTime)
+        self.assertFalse(internalLabelmap.GetModifiedExtent(lastUpdateMTime, modifiedExtent))
+
     def test_array(self):
         # Test if convenience function of getting numpy array from various nodes works
 
@@ -14,7 +14,104 @@
 #include "vtkMRMLCoreTestingMacros.h"
 #include "vtkDataIOManagerLogic.h"
 
-int vtkDataIOManagerLogicTest1(int , char * [] )
+// MRML includes
+#include <vtkCacheManager.h>
+#include <vtkMRMLModelNode.h>
+#include <vtkMRMLModelStorageNode.h>
+#include <vtkMRMLScene.h>
+#include <vtkURIHandler.h>
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkCollection.h>
+#include <vtkCylinderSource.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkPolyData.h>
+
+// VTKsys includes
+#include <vtksys/SystemTools.hxx>
+
+// STD includes
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+/// State shared by all the copies of the handler
+struct FakeTransferState
+{
+  std::atomic<int> NumberOfRunningTransfers{0};
+  std::atomic<int> MaximumNumberOfRunningTransfers{0};
+  std::atomic<bool> Released{false};
+  std::string SourceFileName;
+} FakeState;
+
+//-----------------------------------------------------------------------------
+/// Handler that "downloads" a local file once the transfers are released
+class vtkFakeURIHandler : public vtkURIHandler
+{
+public:
+  static vtkFakeURIHandler* New();
+  vtkTypeMacro(vtkFakeURIHandler, vtkURIHandler);
+
+  int CanHandleURI(const char* uri) override
+    {
+    return uri && std::string(uri).compare(0, 7, "fake://") == 0;
+    }
+
+  void StageFileRead(const char* vtkNotUsed(source), const char* destination) override
+    {
+    int numberOfRunningTransfers = ++FakeState.NumberOfRunningTransfers;
+    int maximum = FakeState.MaximumNumberOfRunningTransfers;
+    while (numberOfRunningTransfers > maximum
+      && !FakeState.MaximumNumberOfRunningTransfers.compare_exchange_weak(maximum, numberOfRunningTransfers))
+      {
+      }
+    while (!FakeState.Released && !this->GetTransferCancelRequested())
+      {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    if (!this->GetTransferCancelRequested())
+      {
+      vtksys::SystemTools::CopyFileAlways(FakeState.SourceFileName, destination);
+      }
+    --FakeState.NumberOfRunningTransfers;
+    }
+  using vtkURIHandler::StageFileRead;
+
+protected:
+  vtkFakeURIHandler() = default;
+  ~vtkFakeURIHandler() override = default;
+};
+
+vtkStandardNewMacro(vtkFakeURIHandler);
+
+//-----------------------------------------------------------------------------
+/// Wait until the condition is true (or a timeout expires)
+template <typename Condition>
+bool WaitFor(Condition condition)
+{
+  for (int i = 0; i < 1000 && !condition(); ++i)
+    {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  return condition();
+}
+
+//-----------------------------------------------------------------------------
+void CountEventCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+  void* clientData, void* vtkNotUsed(callData))
+{
+  ++(*reinterpret_cast<int*>(clientData));
+}
+
+//-----------------------------------------------------------------------------
+int TestBasics()
 {
   vtkNew<vtkDataIOManagerLogic> logic;
   EXERCISE_BASIC_OBJECT_METHODS(logic.GetPointer());
@@ -29,3 +126,125 @@ int vtkDataIOManagerLogicTest1(int , char * [] )
   return EXIT_SUCCESS;
 }
 
+//-----------------------------------------------------------------------------
+int TestConcurrentTransfers(const std::string& tempDir)
+{
+  // Write the file that the handler "downloads"
+  FakeState.SourceFileName = tempDir + "/vtkDataIOManagerLogicTest1.vtk";
+  vtkNew<vtkCylinderSource> cylinderSource;
+  cylinderSource->Update();
+  int numberOfPoints = cylinderSource->GetOutput()->GetNumberOfPoints();
+  {
+    vtkNew<vtkMRMLScene> scene;
+    vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLModelNode"));
+    modelNode->SetAndObservePolyData(cylinderSource->GetOutput());
+    vtkNew<vtkMRMLModelStorageNode> storageNode;
+    storageNode->SetFileName(FakeState.SourceFileName.c_str());
+    CHECK_BOOL(storageNode->WriteData(modelNode) != 0, true);
+  }
+
+  std::string cacheDirectory = tempDir + "/vtkDataIOManagerLogicTest1Cache";
+  vtksys::SystemTools::RemoveADirectory(cacheDirectory);
+
+  vtkNew<vtkMRMLScene> scene;
+  vtkNew<vtkCacheManager> cacheManager;
+  cacheManager->SetRemoteCacheDirectory(cacheDirectory.c_str());
+  scene->SetCacheManager(cacheManager);
+  vtkNew<vtkDataIOManager> dataIOManager;
+  dataIOManager->SetCacheManager(cacheManager);
+  dataIOManager->SetEnableAsynchronousIO(1);
+  dataIOManager->SetMaximumNumberOfConcurrentTransfers(2);
+  scene->SetDataIOManager(dataIOManager);
+
+  int numberOfDoneTransfers = 0;
+  vtkNew<vtkCallbackCommand> doneCallback;
+  doneCallback->SetCallback(CountEventCallback);
+  doneCallback->SetClientData(&numberOfDoneTransfers);
+  dataIOManager->AddObserver(vtkDataIOManager::TransferDoneEvent, doneCallback);
+
+  vtkNew<vtkSlicerApplicationLogic> appLogic;
+  appLogic->SetMRMLScene(scene);
+  appLogic->SetNumberOfNetworkingThreads(4);
+  appLogic->CreateProcessingThread();
+
+  vtkNew<vtkDataIOManagerLogic> logic;
+  logic->SetMRMLApplicationLogic(appLogic);
+  logic->SetMRMLScene(scene);
+  logic->SetAndObserveDataIOManager(dataIOManager);
+
+  vtkNew<vtkFakeURIHandler> handler;
+  const int numberOfNodes = 4;
+  std::vector<vtkMRMLModelNode*> modelNodes;
+  std::vector<vtkMRMLStorageNode*> storageNodes;
+  for (int nodeIndex = 0; nodeIndex < numberOfNodes; ++nodeIndex)
+    {
+    vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLModelNode"));
+    vtkMRMLStorageNode* storageNode = vtkMRMLStorageNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLModelStorageNode"));
+    std::string uri = "fake://host/model" + std::to_string(nodeIndex) + ".vtk";
+    storageNode->SetURI(uri.c_str());
+    storageNode->SetURIHandler(handler);
+    modelNode->SetAndObserveStorageNodeID(storageNode->GetID());
+    storageNode->SetReadStateScheduled();
+    CHECK_INT(logic->QueueRead(modelNode), 1);
+    modelNodes.push_back(modelNode);
+    storageNodes.push_back(storageNode);
+    }
+
+  // only two transfers run at once, the others are queued
+  CHECK_BOOL(WaitFor([]() { return FakeState.NumberOfRunningTransfers == 2; }), true);
+  CHECK_INT(logic->GetNumberOfRunningTransfers(), 2);
+  CHECK_INT(logic->GetNumberOfPendingTransfers(), 2);
+  CHECK_INT(dataIOManager->GetDataTransferCollection()->GetNumberOfItems(), numberOfNodes);
+
+  // cancel a queued transfer: it is never started
+  vtkDataTransfer* queuedTransfer = vtkDataTransfer::SafeDownCast(
+    dataIOManager->GetDataTransferCollection()->GetItemAsObject(numberOfNodes - 1));
+  logic->CancelDataTransfer(queuedTransfer);
+  CHECK_INT(logic->GetNumberOfPendingTransfers(), 1);
+  CHECK_INT(queuedTransfer->GetTransferStatus(), vtkDataTransfer::Cancelled);
+
+  // cancel a running transfer: the handler stops it
+  vtkDataTransfer* runningTransfer = vtkDataTransfer::SafeDownCast(
+    dataIOManager->GetDataTransferCollection()->GetItemAsObject(0));
+  logic->CancelDataTransfer(runningTransfer);
+
+  // the other files are transferred then read
+  FakeState.Released = true;
+  CHECK_BOOL(WaitFor([&]()
+    {
+    logic->ProcessCompletedTransfers();
+    return storageNodes[0]->GetReadState() == vtkMRMLStorageNode::Cancelled
+      && storageNodes[1]->GetReadState() == vtkMRMLStorageNode::Idle
+      && storageNodes[2]->GetReadState() == vtkMRMLStorageNode::Idle
+      && storageNodes[3]->GetReadState() == vtkMRMLStorageNode::Cancelled;
+    }), true);
+  CHECK_INT(runningTransfer->GetTransferStatus(), vtkDataTransfer::Cancelled);
+  CHECK_INT(FakeState.MaximumNumberOfRunningTransfers, 2);
+  CHECK_INT(numberOfDoneTransfers, numberOfNodes);
+  CHECK_INT(logic->GetNumberOfRunningTransfers(), 0);
+  for (int nodeIndex = 1; nodeIndex < 3; ++nodeIndex)
+    {
+    CHECK_NOT_NULL(modelNodes[nodeIndex]->GetPolyData());
+    CHECK_INT(modelNodes[nodeIndex]->GetPolyData()->GetNumberOfPoints(), numberOfPoints);
+    CHECK_NOT_NULL(modelNodes[nodeIndex]->GetDisplayNode());
+    }
+  CHECK_NULL(modelNodes[0]->GetPolyData());
+
+  appLogic->TerminateProcessingThread();
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+int vtkDataIOManagerLogicTest1(int argc, char * argv[] )
+{
+  if (argc != 2)
+    {
+    std::cerr << "Usage: " << argv[0] << " /path/to/temp" << std::endl;
+    return EXIT_FAILURE;
+    }
+  CHECK_EXIT_SUCCESS(TestBasics());
+  CHECK_EXIT_SUCCESS(TestConcurrentTransfers(argv[1]));
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,279 @@
+/*=========================================================================
+
+  Copyright (c) Brigham and Women's Hospital (BWH) All Rights Reserved.
+
+  See License.txt or http://www.slicer.org/copyright/copyright.txt for details.
+
+==========================================================================*/
+
+// Slicer includes
+#include "vtkSlicerApplicationLogic.h"
+#include "vtkSlicerTask.h"
+#include "vtkMRMLCoreTestingMacros.h"
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+
+// STD includes
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+class vtkTaskTestLogic : public vtkMRMLAbstractLogic
+{
+public:
+  static vtkTaskTestLogic* New();
+  vtkTypeMacro(vtkTaskTestLogic, vtkMRMLAbstractLogic);
+
+  /// Record the identifier of the executed task
+  void RecordTask(void* clientData)
+    {
+    std::lock_guard<std::mutex> lock(this->ExecutedTasksLock);
+    this->ExecutedTasks.push_back(*reinterpret_cast<int*>(clientData));
+    }
+
+  /// Block the thread until the task is released
+  void BlockingTask(void* vtkNotUsed(clientData))
+    {
+    ++this->NumberOfStartedBlockingTasks;
+    WaitFor([this]() { return this->Released.load(); });
+    }
+
+  std::vector<int> GetExecutedTasks()
+    {
+    std::lock_guard<std::mutex> lock(this->ExecutedTasksLock);
+    return this->ExecutedTasks;
+    }
+
+  /// Wait until the condition is true (or a timeout expires)
+  template <typename Condition>
+  static bool WaitFor(Condition condition)
+    {
+    for (int i = 0; i < 1000 && !condition(); ++i)
+      {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    return condition();
+    }
+
+  std::atomic<int> NumberOfStartedBlockingTasks{0};
+  std::atomic<bool> Released{false};
+
+protected:
+  vtkTaskTestLogic() = default;
+  ~vtkTaskTestLogic() override = default;
+
+  std::mutex ExecutedTasksLock;
+  std::vector<int> ExecutedTasks;
+};
+
+vtkStandardNewMacro(vtkTaskTestLogic);
+
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkSlicerTask> CreateTask(vtkTaskTestLogic* logic,
+  vtkSlicerTask::TaskFunctionPointer function, void* clientData, int priority = 0)
+{
+  vtkSmartPointer<vtkSlicerTask> task = vtkSmartPointer<vtkSlicerTask>::New();
+  task->SetTypeToProcessing();
+  task->SetPriority(priority);
+  task->SetTaskFunction(logic, function, clientData);
+  return task;
+}
+
+//-----------------------------------------------------------------------------
+int TestPriorityAndCancel()
+{
+  vtkNew<vtkSlicerApplicationLogic> appLogic;
+  vtkNew<vtkTaskTestLogic> logic;
+  vtkSlicerTask::TaskFunctionPointer recordTask =
+    (vtkSlicerTask::TaskFunctionPointer)&vtkTaskTestLogic::RecordTask;
+  vtkSlicerTask::TaskFunctionPointer blockingTask =
+    (vtkSlicerTask::TaskFunctionPointer)&vtkTaskTestLogic::BlockingTask;
+
+  // tasks cannot be scheduled before the threads are created
+  CHECK_INT(appLogic->ScheduleTask(CreateTask(logic, recordTask, nullptr)), 0);
+
+  appLogic->SetNumberOfProcessingThreads(1);
+  appLogic->CreateProcessingThread();
+
+  // tasks without type are rejected
+  vtkNew<vtkSlicerTask> undefinedTask;
+  TESTING_OUTPUT_ASSERT_WARNINGS_BEGIN();
+  CHECK_INT(appLogic->ScheduleTask(undefinedTask), 0);
+  TESTING_OUTPUT_ASSERT_WARNINGS_END();
+
+  // keep the only processing thread busy while the other tasks are queued
+  CHECK_INT(appLogic->ScheduleTask(CreateTask(logic, blockingTask, nullptr)), 1);
+  CHECK_BOOL(vtkTaskTestLogic::WaitFor([&logic]() { return logic->NumberOfStartedBlockingTasks == 1; }), true);
+
+  int taskIds[4] = { 0, 1, 2, 3 };
+  CHECK_INT(appLogic->ScheduleTask(CreateTask(logic, recordTask, &taskIds[0], 0)), 1);
+  CHECK_INT(appLogic->ScheduleTask(CreateTask(logic, recordTask, &taskIds[1], 10)), 1);
+  vtkSmartPointer<vtkSlicerTask> canceledTask = CreateTask(logic, recordTask, &taskIds[2], 5);
+  CHECK_INT(appLogic->ScheduleTask(canceledTask), 1);
+  CHECK_INT(appLogic->ScheduleTask(CreateTask(logic, recordTask, &taskIds[3], 0)), 1);
+  CHECK_INT(appLogic->GetNumberOfQueuedTasks(), 4);
+  canceledTask->Cancel();
+  CHECK_BOOL(canceledTask->GetCanceled(), true);
+  CHECK_INT(appLogic->GetNumberOfQueuedTasks(), 3);
+
+  logic->Released = true;
+  CHECK_BOOL(vtkTaskTestLogic::WaitFor([&appLogic, &logic]()
+    { return appLogic->GetNumberOfQueuedTasks() == 0 && logic->GetExecutedTasks().size() == 3; }), true);
+
+  // higher priority first, then in scheduling order; canceled task is not executed
+  std::vector<int> executedTasks = logic->GetExecutedTasks();
+  CHECK_INT(static_cast<int>(executedTasks.size()), 3);
+  CHECK_INT(executedTasks[0], 1);
+  CHECK_INT(executedTasks[1], 0);
+  CHECK_INT(executedTasks[2], 3);
+
+  appLogic->TerminateProcessingThread();
+  return EXIT_SUCCESS;
+}
+
+//-----------------------------------------------------------------------------
+int TestConcurrentTasks()
+{
+  vtkNew<vtkSlicerApplicationLogic> appLogic;
+  vtkNew<vtkTaskTestLogic> logic;
+  vtkSlicerTask::TaskFunctionPointer blockingTask =
+    (vtkSlicerTask::TaskFunctionPointer)&vtkTaskTestLogic::BlockingTask;
+
+  const int numberOfThreads = 3;
+  appLogic->SetNumberOfProcessingThreads(numberOfThreads);
+  CHECK_INT(appLogic->GetNumberOfProcessingThreads(), numberOfThreads);
+  appLogic->CreateProcessingThread();
+
+  // all tasks must be started at the same time, as none of them finishes before being released
+  for (int i = 0; i < numberOfThreads; ++i)
+    {
+    CHECK_INT(appLogic->ScheduleTask(CreateTask(logic, blockingTask, nullptr)), 1);
+    }
+  CHECK_BOOL(vtkTaskTestLogic::WaitFor([&logic]()
+    { return logic->NumberOfStartedBlockingTasks == numberOfThreads; }), true);
+  CHECK_INT(appLogic->GetNumberOfQueuedTasks(), 0);
+
+  logic->Released = true;
+  appLogic->TerminateProcessingThread();
+
+  // tasks cannot be scheduled after the threads are terminated
+  CHECK_INT(appLogic->ScheduleTask(CreateTask(logic, blockingTask, nullptr)), 0);
+  return EXIT_SUCCESS;
+}
+
+//-----------------------------------------------------------------------------
+void CountEventCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+  void* clientData, void* vtkNotUsed(callData))
+{
+  ++(*reinterpret_cast<int*>(clientData));
+}
+
+//-----------------------------------------------------------------------------
+int TestRequestModifiedFromThreads()
+{
+  vtkNew<vtkSlicerApplicationLogic> appLogic;
+
+  // requests are rejected until the communication channel is set up
+  vtkNew<vtkTaskTestLogic> modifiedObject;
+  CHECK_INT(appLogic->RequestModified(modifiedObject), 0);
+  appLogic->CreateProcessingThread();
+
+  int numberOfWakeUps = 0;
+  vtkNew<vtkCallbackCommand> wakeUpCallback;
+  wakeUpCallback->SetCallback(CountEventCallback);
+  wakeUpCallback->SetClientData(&numberOfWakeUps);
+  appLogic->AddObserver(vtkMRMLApplicationLogic::RequestInvokeEvent, wakeUpCallback);
+
+  int numberOfProcessingRequests = 0;
+  vtkNew<vtkCallbackCommand> processingCallback;
+  processingCallback->SetCallback(CountEventCallback);
+  processingCallback->SetClientData(&numberOfProcessingRequests);
+  appLogic->AddObserver(vtkSlicerApplicationLogic::RequestModifiedEvent, processingCallback);
+
+  const int numberOfThreads = 4;
+  const int numberOfRequestsPerThread = 100;
+  std::vector<vtkSmartPointer<vtkTaskTestLogic> > objects;
+  std::vector<int> numberOfModifiedEvents(numberOfThreads, 0);
+  std::vector<vtkSmartPointer<vtkCallbackCommand> > modifiedCallbacks;
+  for (int i = 0; i < numberOfThreads; ++i)
+    {
+    objects.push_back(vtkSmartPointer<vtkTaskTestLogic>::New());
+    modifiedCallbacks.push_back(vtkSmartPointer<vtkCallbackCommand>::New());
+    modifiedCallbacks[i]->SetCallback(CountEventCallback);
+    modifiedCallbacks[i]->SetClientData(&numberOfModifiedEvents[i]);
+    objects[i]->AddObserver(vtkCommand::ModifiedEvent, modifiedCallbacks[i]);
+    }
+
+  // queue requests from several threads at once
+  std::atomic<bool> allRequestsQueued{true};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numberOfThreads; ++i)
+    {
+    vtkTaskTestLogic* object = objects[i];
+    threads.emplace_back([&appLogic, &allRequestsQueued, object]()
+      {
+      for (int request = 0; request < numberOfRequestsPerThread; ++request)
+        {
+        if (appLogic->RequestModified(object) == 0)
+          {
+          allRequestsQueued = false;
+          }
+        }
+      });
+    }
+  for (std::thread& thread : threads)
+    {
+    thread.join();
+    }
+  CHECK_BOOL(allRequestsQueued, true);
+
+  // the main thread is woken up only once for all the requests
+  CHECK_INT(numberOfWakeUps, 1);
+
+  // process the queue in the main thread until it does not request more processing
+  int numberOfProcessings = 0;
+  int previousNumberOfProcessingRequests = -1;
+  while (numberOfProcessingRequests != previousNumberOfProcessingRequests
+    && numberOfProcessings <= numberOfThreads * numberOfRequestsPerThread)
+    {
+    previousNumberOfProcessingRequests = numberOfProcessingRequests;
+    appLogic->ProcessModified();
+    ++numberOfProcessings;
+    }
+  CHECK_BOOL(numberOfProcessings <= numberOfThreads * numberOfRequestsPerThread, true);
+  for (int i = 0; i < numberOfThreads; ++i)
+    {
+    // consecutive requests for the same object are merged
+    CHECK_BOOL(numberOfModifiedEvents[i] >= 1, true);
+    CHECK_BOOL(numberOfModifiedEvents[i] <= numberOfRequestsPerThread, true);
+    }
+
+  // a new request wakes up the main thread again
+  CHECK_BOOL(appLogic->RequestModified(objects[0]) != 0, true);
+  CHECK_INT(numberOfWakeUps, 2);
+  appLogic->ProcessModified();
+  CHECK_BOOL(numberOfModifiedEvents[0] >= 2, true);
+
+  appLogic->TerminateProcessingThread();
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+int vtkSlicerTaskTest1(int vtkNotUsed(argc), char * vtkNotUsed(argv)[])
+{
+  CHECK_EXIT_SUCCESS(TestPriorityAndCancel());
+  CHECK_EXIT_SUCCESS(TestConcurrentTasks());
+  CHECK_EXIT_SUCCESS(TestRequestModifiedFromThreads());
+  return EXIT_SUCCESS;
+}
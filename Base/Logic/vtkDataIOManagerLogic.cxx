@@ -4,6 +4,8 @@
 
 // MRML includes
 #include "vtkCacheManager.h"
+#include "vtkMRMLDisplayableNode.h"
+#include "vtkMRMLMessageCollection.h"
 #include "vtkMRMLStorageNode.h"
 #include "vtkMRMLStorableNode.h"
 #include "vtkPermissionPrompter.h"
@@ -12,8 +14,10 @@
 
 // VTK includes
 #include <vtkCallbackCommand.h>
+#include <vtkCollection.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
+#include <vtkWeakPointer.h>
 
 // VTKsys includes
 #include <vtksys/SystemTools.hxx>
@@ -21,7 +25,13 @@
 // ITKsys includes
 
 // STD includes
+#include <atomic>
 #include <cassert>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #ifdef linux
 #include "unistd.h"
@@ -51,10 +61,323 @@ vtkStandardNewMacro ( vtkDataIOManagerLogic );
 
 typedef std::pair< vtkDataTransfer *, vtkMRMLNode * > TransferNodePair;
 
+namespace
+{
+
+/// Event invoked on the logic (in the main thread) to process the completed transfers
+const unsigned long ProcessCompletedTransfersEvent = vtkCommand::UserEvent + 1;
+
+//----------------------------------------------------------------------------
+/// Forward the progress events of a URI handler to a data transfer.
+/// The events are invoked in the thread running the transfer, so the
+/// transfer is modified in the main thread.
+class vtkDataTransferProgressCommand : public vtkCommand
+{
+public:
+  static vtkDataTransferProgressCommand* New()
+    {
+    return new vtkDataTransferProgressCommand;
+    }
+  vtkTypeMacro(vtkDataTransferProgressCommand, vtkCommand);
+
+  void Execute(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid), void* callData) override
+    {
+    if (!this->Transfer || !this->ApplicationLogic || !callData)
+      {
+      return;
+      }
+    double progress = *reinterpret_cast<double*>(callData);
+    this->Transfer->SetProgressNoModify(static_cast<int>(progress * 100.0));
+    this->ApplicationLogic->RequestModified(this->Transfer);
+    }
+
+  vtkDataTransfer* Transfer{nullptr};
+  vtkSlicerApplicationLogic* ApplicationLogic{nullptr};
+};
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+class vtkDataIOManagerLogic::vtkInternal
+{
+public:
+  /// Files of a storage node read asynchronously: the storage node is
+  /// read once all of them are transferred.
+  struct StorageNodeRead
+    {
+    std::string NodeID;
+    vtkWeakPointer<vtkMRMLStorageNode> StorageNode;
+    std::string FileName;
+    int NumberOfRemainingTransfers{0};
+    bool Cancelled{false};
+    bool Failed{false};
+    /// Copies of the nodes that are not in the scene, to read the data in a
+    /// processing thread. Null if the storage node must be read in the main thread.
+    vtkSmartPointer<vtkMRMLStorableNode> NodeCopy;
+    vtkSmartPointer<vtkMRMLStorageNode> StorageNodeCopy;
+    bool DataRead{false};
+    };
+
+  struct ScheduledTransfer
+    {
+    vtkSmartPointer<vtkDataTransfer> Transfer;
+    /// Null for uploads
+    std::shared_ptr<StorageNodeRead> Read;
+    };
+
+  vtkInternal(vtkDataIOManagerLogic* external)
+    : External(external)
+    {
+    }
+
+  /// Create the record of the files to transfer for reading \a storageNode.
+  /// Must be called from the main thread, once the file names are set.
+  std::shared_ptr<StorageNodeRead> CreateStorageNodeRead(vtkMRMLStorableNode* node, vtkMRMLStorageNode* storageNode);
+  /// Queue the transfer and start it if a transfer slot is available.
+  /// Must be called from the main thread.
+  void ScheduleTransfer(vtkDataTransfer* transfer, const std::shared_ptr<StorageNodeRead>& read);
+  /// Start queued transfers while transfer slots are available
+  void StartPendingTransfers();
+  /// Called in the networking thread when a scheduled transfer is done
+  void TransferDone(vtkDataTransfer* transfer);
+  /// Record that the transfer is done, and read the storage node if it was
+  /// the last file to transfer
+  void CompleteTransfer(const ScheduledTransfer& scheduledTransfer);
+  /// Read the storage node in a processing thread if possible,
+  /// otherwise let the main thread read it.
+  void ScheduleRead(const std::shared_ptr<StorageNodeRead>& read);
+  /// Called in the processing thread when the data of the storage node is read
+  void ReadDone(StorageNodeRead* read);
+  /// Wake up the main thread to run ProcessCompletedTransfers()
+  void RequestProcessing();
+
+  static void ProcessingCallback(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
+
+  vtkDataIOManagerLogic* External;
+  std::mutex Mutex;
+  int MaximumNumberOfConcurrentTransfers{1};
+  std::deque<ScheduledTransfer> PendingTransfers;
+  std::map<vtkDataTransfer*, ScheduledTransfer> RunningTransfers;
+  std::map<StorageNodeRead*, std::shared_ptr<StorageNodeRead> > RunningReads;
+  /// Transfers and reads done in the networking and processing threads,
+  /// applied in the main thread
+  std::vector<vtkSmartPointer<vtkDataTransfer> > DoneTransfers;
+  std::vector<std::shared_ptr<StorageNodeRead> > DoneReads;
+  std::atomic<bool> ProcessingRequested{false};
+  vtkNew<vtkCallbackCommand> ProcessingCommand;
+};
+
+//----------------------------------------------------------------------------
+std::shared_ptr<vtkDataIOManagerLogic::vtkInternal::StorageNodeRead>
+vtkDataIOManagerLogic::vtkInternal::CreateStorageNodeRead(vtkMRMLStorableNode* node, vtkMRMLStorageNode* storageNode)
+{
+  std::shared_ptr<StorageNodeRead> read = std::make_shared<StorageNodeRead>();
+  read->NodeID = node->GetID() ? node->GetID() : "";
+  read->StorageNode = storageNode;
+  read->FileName = storageNode->GetFileName() ? storageNode->GetFileName() : "";
+  read->NumberOfRemainingTransfers = 1 + storageNode->GetNumberOfURIs();
+  if (node->GetNumberOfStorageNodes() != 1 || !storageNode->CanReadInBackgroundThread() || !node->HasCopyContent())
+    {
+    return read;
+    }
+  // Read into copies of the nodes that are not in the scene, so that
+  // reading does not invoke any events in the scene.
+  read->NodeCopy = vtkSmartPointer<vtkMRMLStorableNode>::Take(
+    vtkMRMLStorableNode::SafeDownCast(node->CreateNodeInstance()));
+  read->StorageNodeCopy = vtkSmartPointer<vtkMRMLStorageNode>::Take(
+    vtkMRMLStorageNode::SafeDownCast(storageNode->CreateNodeInstance()));
+  if (!read->NodeCopy || !read->StorageNodeCopy)
+    {
+    read->NodeCopy = nullptr;
+    read->StorageNodeCopy = nullptr;
+    return read;
+    }
+  read->NodeCopy->CopyContent(node, false);
+  read->NodeCopy->SetName(node->GetName());
+  read->StorageNodeCopy->Copy(storageNode);
+  read->StorageNodeCopy->GetUserMessages()->ClearMessages();
+  // The copy reads the transferred files: it has no URI and, as it is not
+  // in the scene, file names must be absolute paths
+  read->StorageNodeCopy->SetURI(nullptr);
+  read->StorageNodeCopy->ResetURIList();
+  read->StorageNodeCopy->SetFileName(storageNode->GetFullNameFromFileName().c_str());
+  read->StorageNodeCopy->ResetFileNameList();
+  for (int fileIndex = 0; fileIndex < storageNode->GetNumberOfFileNames(); fileIndex++)
+    {
+    read->StorageNodeCopy->AddFileName(storageNode->GetFullNameFromNthFileName(fileIndex).c_str());
+    }
+  return read;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataIOManagerLogic::vtkInternal::ScheduleTransfer(
+  vtkDataTransfer* transfer, const std::shared_ptr<StorageNodeRead>& read)
+{
+  // A handler runs one transfer at a time: use a copy for each transfer
+  // so that they can run concurrently and be cancelled individually.
+  vtkURIHandler* handler = transfer->GetHandler();
+  if (handler)
+    {
+    vtkSmartPointer<vtkURIHandler> handlerCopy = vtkSmartPointer<vtkURIHandler>::Take(handler->NewInstance());
+    handlerCopy->CopySettings(handler);
+    transfer->SetHandler(handlerCopy);
+    }
+  transfer->SetTransferStatus(vtkDataTransfer::Pending);
+
+  ScheduledTransfer scheduledTransfer;
+  scheduledTransfer.Transfer = transfer;
+  scheduledTransfer.Read = read;
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->MaximumNumberOfConcurrentTransfers = this->External->GetDataIOManager() ?
+      this->External->GetDataIOManager()->GetMaximumNumberOfConcurrentTransfers() : 1;
+    this->PendingTransfers.push_back(scheduledTransfer);
+  }
+  this->StartPendingTransfers();
+}
+
+//----------------------------------------------------------------------------
+void vtkDataIOManagerLogic::vtkInternal::StartPendingTransfers()
+{
+  std::vector<ScheduledTransfer> transfersToStart;
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    while (!this->PendingTransfers.empty()
+      && static_cast<int>(this->RunningTransfers.size()) < this->MaximumNumberOfConcurrentTransfers)
+      {
+      ScheduledTransfer scheduledTransfer = this->PendingTransfers.front();
+      this->PendingTransfers.pop_front();
+      this->RunningTransfers[scheduledTransfer.Transfer] = scheduledTransfer;
+      transfersToStart.push_back(scheduledTransfer);
+      }
+  }
+  for (const ScheduledTransfer& scheduledTransfer : transfersToStart)
+    {
+    vtkNew<vtkSlicerTask> task;
+    task->SetTypeToNetworking();
+    task->SetTaskFunction(this->External, (vtkSlicerTask::TaskFunctionPointer)
+                          &vtkDataIOManagerLogic::ApplyScheduledTransfer, scheduledTransfer.Transfer.GetPointer());
+    if (!this->External->GetApplicationLogic()
+        || !this->External->GetApplicationLogic()->ScheduleTask(task))
+      {
+      scheduledTransfer.Transfer->SetTransferStatusNoModify(vtkDataTransfer::CompletedWithErrors);
+      this->TransferDone(scheduledTransfer.Transfer);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkDataIOManagerLogic::vtkInternal::TransferDone(vtkDataTransfer* transfer)
+{
+  ScheduledTransfer scheduledTransfer;
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    std::map<vtkDataTransfer*, ScheduledTransfer>::iterator it = this->RunningTransfers.find(transfer);
+    if (it == this->RunningTransfers.end())
+      {
+      return;
+      }
+    scheduledTransfer = it->second;
+    this->RunningTransfers.erase(it);
+  }
+  this->CompleteTransfer(scheduledTransfer);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataIOManagerLogic::vtkInternal::CompleteTransfer(const ScheduledTransfer& scheduledTransfer)
+{
+  std::shared_ptr<StorageNodeRead> completedRead;
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->DoneTransfers.push_back(scheduledTransfer.Transfer);
+    if (scheduledTransfer.Read)
+      {
+      int status = scheduledTransfer.Transfer->GetTransferStatus();
+      scheduledTransfer.Read->Cancelled |= (status == vtkDataTransfer::Cancelled);
+      scheduledTransfer.Read->Failed |= (status != vtkDataTransfer::Completed);
+      if (--scheduledTransfer.Read->NumberOfRemainingTransfers == 0)
+        {
+        completedRead = scheduledTransfer.Read;
+        }
+      }
+  }
+  // the transfer slot is free
+  this->StartPendingTransfers();
+  if (completedRead)
+    {
+    this->ScheduleRead(completedRead);
+    }
+  this->RequestProcessing();
+}
+
+//----------------------------------------------------------------------------
+void vtkDataIOManagerLogic::vtkInternal::ScheduleRead(const std::shared_ptr<StorageNodeRead>& read)
+{
+  if (!read->Cancelled && !read->Failed && read->StorageNodeCopy && this->External->GetApplicationLogic())
+    {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->RunningReads[read.get()] = read;
+    }
+    vtkNew<vtkSlicerTask> task;
+    task->SetTypeToProcessing();
+    task->SetTaskFunction(this->External, (vtkSlicerTask::TaskFunctionPointer)
+                          &vtkDataIOManagerLogic::ReadTransferredData, read.get());
+    if (this->External->GetApplicationLogic()->ScheduleTask(task))
+      {
+      return;
+      }
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->RunningReads.erase(read.get());
+    }
+  // read in the main thread
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->DoneReads.push_back(read);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataIOManagerLogic::vtkInternal::ReadDone(StorageNodeRead* read)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    std::map<StorageNodeRead*, std::shared_ptr<StorageNodeRead> >::iterator it = this->RunningReads.find(read);
+    if (it == this->RunningReads.end())
+      {
+      return;
+      }
+    this->DoneReads.push_back(it->second);
+    this->RunningReads.erase(it);
+  }
+  this->RequestProcessing();
+}
+
+//----------------------------------------------------------------------------
+void vtkDataIOManagerLogic::vtkInternal::RequestProcessing()
+{
+  // Only the first request since the last processing wakes up the main thread
+  if (!this->ProcessingRequested.exchange(true) && this->External->GetApplicationLogic())
+    {
+    // Safe to call from any thread: the event is invoked in the main thread.
+    this->External->GetApplicationLogic()->InvokeEventWithDelay(0, this->External, ProcessCompletedTransfersEvent);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkDataIOManagerLogic::vtkInternal::ProcessingCallback(vtkObject* vtkNotUsed(caller),
+  unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
+{
+  vtkDataIOManagerLogic* self = reinterpret_cast<vtkDataIOManagerLogic*>(clientData);
+  self->ProcessCompletedTransfers();
+}
+
 //----------------------------------------------------------------------------
 vtkDataIOManagerLogic::vtkDataIOManagerLogic()
 {
   this->DataIOManager = nullptr;
+  this->Internal = new vtkInternal(this);
+  this->Internal->ProcessingCommand->SetClientData(this);
+  this->Internal->ProcessingCommand->SetCallback(vtkInternal::ProcessingCallback);
+  this->AddObserver(ProcessCompletedTransfersEvent, this->Internal->ProcessingCommand);
 
   this->DataIOObserverManager = vtkObserverManager::New();
   this->DataIOObserverManager->GetCallbackCommand()->SetClientData(this);
@@ -78,6 +401,8 @@ vtkDataIOManagerLogic::~vtkDataIOManagerLogic()
     {
     this->DataIOObserverManager->Delete();
     }
+  this->RemoveObserver(this->Internal->ProcessingCommand);
+  delete this->Internal;
 }
 
 
@@ -197,6 +522,102 @@ void vtkDataIOManagerLogic::CancelDataTransfer ( vtkDataTransfer *dt )
     {
     dt->SetCancelRequested ( 1 );
     dt->SetTransferStatus ( vtkDataTransfer::CancelPending );
+    if ( dt->GetHandler() != nullptr )
+      {
+      dt->GetHandler()->SetTransferCancelRequested ( true );
+      }
+
+    //--- a transfer that has not started yet is done right away
+    vtkInternal::ScheduledTransfer cancelledTransfer;
+    {
+      std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+      for (std::deque<vtkInternal::ScheduledTransfer>::iterator it = this->Internal->PendingTransfers.begin();
+           it != this->Internal->PendingTransfers.end(); ++it)
+        {
+        if (it->Transfer == dt)
+          {
+          cancelledTransfer = *it;
+          this->Internal->PendingTransfers.erase(it);
+          break;
+          }
+        }
+    }
+    if ( cancelledTransfer.Transfer )
+      {
+      dt->SetTransferStatus ( vtkDataTransfer::Cancelled );
+      this->Internal->CompleteTransfer ( cancelledTransfer );
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkDataIOManagerLogic::GetNumberOfPendingTransfers()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return static_cast<int>(this->Internal->PendingTransfers.size());
+}
+
+//----------------------------------------------------------------------------
+int vtkDataIOManagerLogic::GetNumberOfRunningTransfers()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return static_cast<int>(this->Internal->RunningTransfers.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkDataIOManagerLogic::ProcessCompletedTransfers()
+{
+  this->Internal->ProcessingRequested = false;
+  std::vector<vtkSmartPointer<vtkDataTransfer> > doneTransfers;
+  std::vector<std::shared_ptr<vtkInternal::StorageNodeRead> > doneReads;
+  {
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    doneTransfers.swap(this->Internal->DoneTransfers);
+    doneReads.swap(this->Internal->DoneReads);
+  }
+
+  for (vtkDataTransfer* transfer : doneTransfers)
+    {
+    if ( this->GetDataIOManager() != nullptr )
+      {
+      this->GetDataIOManager()->InvokeEvent ( vtkDataIOManager::TransferDoneEvent, transfer );
+      }
+    }
+
+  for (const std::shared_ptr<vtkInternal::StorageNodeRead>& read : doneReads)
+    {
+    vtkMRMLStorageNode* storageNode = read->StorageNode;
+    vtkMRMLStorableNode* storableNode = this->GetMRMLScene() ? vtkMRMLStorableNode::SafeDownCast(
+      this->GetMRMLScene()->GetNodeByID(read->NodeID)) : nullptr;
+    if ( storageNode == nullptr || storableNode == nullptr )
+      {
+      //--- the node was removed from the scene meanwhile
+      continue;
+      }
+    if ( read->Cancelled )
+      {
+      storageNode->SetReadStateCancelled();
+      continue;
+      }
+    if ( read->DataRead )
+      {
+      //--- the data was read in a processing thread into a copy of the node
+      storableNode->CopyContent ( read->NodeCopy, false );
+      storageNode->UpdateFromReadDataCopy ( read->StorageNodeCopy, storableNode );
+      vtkMRMLDisplayableNode* displayableNode = vtkMRMLDisplayableNode::SafeDownCast ( storableNode );
+      if ( displayableNode )
+        {
+        displayableNode->CreateDefaultDisplayNodes();
+        }
+      continue;
+      }
+    // let the storage node know that the remote transfer is done
+    vtkDebugMacro("ProcessCompletedTransfers: setting storage node read state to transfer done for uri " << storageNode->GetURI());
+    storageNode->SetReadStateTransferDone();
+    if ( this->GetApplicationLogic() )
+      {
+      this->GetApplicationLogic()->RequestReadFile ( read->NodeID.c_str(), read->FileName.c_str(), 0, 0 );
+      }
     }
 }
 
@@ -310,6 +731,12 @@ int vtkDataIOManagerLogic::QueueRead ( vtkMRMLNode *node )
         }
       }
     }
+  //---
+  //--- Remove the least recently used files if the cache is full:
+  //--- the cached version of dest is kept if it is still referenced
+  //--- by storage nodes.
+  cm->FreeCacheSpace();
+
   //---
   //--- WJPtest:
   //--- Again, test for space to download the file.
@@ -353,11 +780,16 @@ int vtkDataIOManagerLogic::QueueRead ( vtkMRMLNode *node )
        allCachedFilesExist &&
        ( !(cm->GetEnableForceRedownload())) )
     {
+    cm->UpdateCachedFileAccessTime ( dest );
     dnode->GetNthStorageNode(storageNodeIndex)->SetReadStateTransferDone();
     vtkDebugMacro("QueueRead: the destination file is there and we're not forceing redownload");
     return 1;
     }
 
+  //--- a cached file that shares its content with other cached files
+  //--- is removed, so that downloading it again does not modify them.
+  cm->UnlinkCachedFile ( dest );
+
   //--- Otherwise, just do the data transfer whether
   //--- the file already exists in cache or not
   //--- (download or redownload)
@@ -384,6 +816,14 @@ int vtkDataIOManagerLogic::QueueRead ( vtkMRMLNode *node )
     return 0;
     }
 
+  //--- with asynchronous IO, the storage node is read
+  //--- once all its files are transferred.
+  std::shared_ptr<vtkInternal::StorageNodeRead> read;
+  if ( this->GetDataIOManager()->GetEnableAsynchronousIO() )
+    {
+    read = this->Internal->CreateStorageNodeRead( dnode, dnode->GetNthStorageNode(storageNodeIndex) );
+    }
+
   //--- construct and add a record of the transfer
   //--- which includes the ID of associated node
   vtkNew<vtkDataTransfer> transfer0;
@@ -409,18 +849,7 @@ int vtkDataIOManagerLogic::QueueRead ( vtkMRMLNode *node )
     //---
     //--- Schedule an ASYNCHRONOUS data transfer
     //---
-    vtkNew<vtkSlicerTask> task;
-    task->SetTypeToNetworking();
-    transfer0->SetTransferStatus ( vtkDataTransfer::Pending );
-    task->SetTaskFunction(this, (vtkSlicerTask::TaskFunctionPointer)
-                          &vtkDataIOManagerLogic::ApplyTransfer, transfer0.GetPointer());
-
-    // Schedule the transfer
-    if ( ! this->GetApplicationLogic()->ScheduleTask( task.GetPointer() ) )
-      {
-      transfer0->SetTransferStatus( vtkDataTransfer::CompletedWithErrors);
-      return 0;
-      }
+    this->Internal->ScheduleTransfer( transfer0.GetPointer(), read );
     }
   else
     {
@@ -453,6 +882,7 @@ int vtkDataIOManagerLogic::QueueRead ( vtkMRMLNode *node )
     transfer1->SetSourceURI ( sourceN );
     transfer1->SetDestinationURI ( destN );
     // use one handler for all files in the storage node
+    // (copied for each asynchronous transfer)
     transfer1->SetHandler ( handler );
     transfer1->SetTransferType ( vtkDataTransfer::RemoteDownload );
     transfer1->SetTransferStatus ( vtkDataTransfer::Idle );
@@ -463,18 +893,7 @@ int vtkDataIOManagerLogic::QueueRead ( vtkMRMLNode *node )
     if ( this->GetDataIOManager()->GetEnableAsynchronousIO() )
       {
       vtkDebugMacro("QueueRead: Schedule an ASYNCHRONOUS data transfer, n = " << n);
-      vtkNew<vtkSlicerTask> task;
-      task->SetTypeToNetworking();
-      transfer1->SetTransferStatus ( vtkDataTransfer::Pending );
-      task->SetTaskFunction(this, (vtkSlicerTask::TaskFunctionPointer)
-                            &vtkDataIOManagerLogic::ApplyTransfer, transfer1.GetPointer());
-
-      // Schedule the transfer
-      if ( ! this->GetApplicationLogic()->ScheduleTask( task.GetPointer() ) )
-        {
-        transfer1->SetTransferStatus( vtkDataTransfer::CompletedWithErrors);
-        return 0;
-        }
+      this->Internal->ScheduleTransfer( transfer1.GetPointer(), read );
       }
     else
       {
@@ -634,18 +1053,7 @@ int vtkDataIOManagerLogic::QueueWrite ( vtkMRMLNode *node )
       //---
       //--- Schedule an ASYNCHRONOUS data transfer
       //---
-      vtkNew<vtkSlicerTask> task;
-      task->SetTypeToNetworking();
-      transfer->SetTransferStatus ( vtkDataTransfer::Pending );
-      task->SetTaskFunction(this, (vtkSlicerTask::TaskFunctionPointer)
-                            &vtkDataIOManagerLogic::ApplyTransfer, transfer.GetPointer());
-
-      // Schedule the transfer
-      if ( ! this->GetApplicationLogic()->ScheduleTask( task.GetPointer() ) )
-        {
-        transfer->SetTransferStatus( vtkDataTransfer::CompletedWithErrors);
-        return 0;
-        }
+      this->Internal->ScheduleTransfer( transfer.GetPointer(), nullptr );
       }
     else
       {
@@ -667,6 +1075,19 @@ int vtkDataIOManagerLogic::QueueWrite ( vtkMRMLNode *node )
 
 
 
+//----------------------------------------------------------------------------
+void vtkDataIOManagerLogic::AddDownloadedFileToCache( const char *source, const char *dest )
+{
+  vtkDataIOManager *iom = this->GetDataIOManager();
+  vtkCacheManager *cm = iom ? iom->GetCacheManager() : nullptr;
+  if ( cm == nullptr || dest == nullptr || !vtksys::SystemTools::FileExists( dest, true ) )
+    {
+    return;
+    }
+  //--- record the file in the cache index, may be called from the networking threads.
+  cm->AddFileToCache( source, dest );
+}
+
 //----------------------------------------------------------------------------
 void vtkDataIOManagerLogic::ApplyTransfer( void *clientdata )
 {
@@ -715,50 +1136,37 @@ void vtkDataIOManagerLogic::ApplyTransfer( void *clientdata )
       if ( asynchIO && dt->GetTransferStatus() == vtkDataTransfer::Pending)
         {
         dt->SetTransferStatusNoModify ( vtkDataTransfer::Running );
+        dt->SetProgressNoModify ( 0 );
         this->GetApplicationLogic()->RequestModified( dt );
+        vtkNew<vtkDataTransferProgressCommand> progressCommand;
+        progressCommand->Transfer = dt;
+        progressCommand->ApplicationLogic = this->GetApplicationLogic();
+        unsigned long progressObserverTag = handler->AddObserver(vtkCommand::ProgressEvent, progressCommand);
         handler->StageFileRead( source, dest);
-        dt->SetTransferStatusNoModify ( vtkDataTransfer::Completed );
-        this->GetApplicationLogic()->RequestModified( dt );
-
-        vtkMRMLStorableNode *storableNode = vtkMRMLStorableNode::SafeDownCast( node );
-        if ( !storableNode )
-          {
-          vtkErrorMacro( "ApplyTransfer: could not get storable node for scheduled data transfer" );
-          return;
-          }
-        // find the storage node that's been scheduled  and we're working on it
-        int storageNodeIndex = -1;
-        for (int i = 0; i < storableNode->GetNumberOfStorageNodes(); i++)
+        handler->RemoveObserver(progressObserverTag);
+        if ( handler->GetTransferCancelRequested() )
           {
-          if (storableNode->GetNthStorageNode(i)->GetReadState() == vtkMRMLStorageNode::Transferring &&
-              strcmp(storableNode->GetNthStorageNode(i)->GetURI(),source) == 0)
-            {
-            vtkDebugMacro("ApplyTransfer: found a working storage node who's uri matches source " << source << " at " << i);
-            storageNodeIndex = i;
-            break;
-            }
+          dt->SetTransferStatusNoModify ( vtkDataTransfer::Cancelled );
           }
-        if (storageNodeIndex == -1)
+        else if ( vtksys::SystemTools::FileExists( dest, true ) )
           {
-          vtkErrorMacro("ApplyTransfer: unable to find a storage node in scheduled state.");
+          this->AddDownloadedFileToCache( source, dest );
+          dt->SetProgressNoModify ( 100 );
+          dt->SetTransferStatusNoModify ( vtkDataTransfer::Completed );
           }
-        vtkMRMLStorageNode *storageNode = storableNode->GetNthStorageNode(storageNodeIndex);
-        if ( !storageNode )
+        else
           {
-          vtkErrorMacro( "ApplyTransfer: no storage node for scheduled data transfer" );
-          return;
+          dt->SetTransferStatusNoModify ( vtkDataTransfer::CompletedWithErrors );
           }
-        storageNode->SetDisableModifiedEvent( 1 );
-        // let the storage node know that the remote transfer is done
-        vtkDebugMacro("ApplyTransfer: setting storage node read state to transfer done for uri " << storageNode->GetURI());
-        storageNode->SetReadStateTransferDone();
-        storageNode->SetDisableModifiedEvent( 0 );
-        this->GetApplicationLogic()->RequestReadFile( node->GetID(), dest, 0, 0 );
+        this->GetApplicationLogic()->RequestModified( dt );
+        //--- the storage node is read by ProcessCompletedTransfers() or
+        //--- ReadTransferredData() once all its files are transferred.
         }
       else
         {
         vtkDebugMacro("ApplyTransfer: stage file read on the handler..., source = " << source << ", dest = " << dest);
         handler->StageFileRead( source, dest);
+        this->AddDownloadedFileToCache( source, dest );
         }
       }
     }
@@ -826,6 +1234,32 @@ void vtkDataIOManagerLogic::ApplyTransfer( void *clientdata )
 
 
 
+//----------------------------------------------------------------------------
+void vtkDataIOManagerLogic::ApplyScheduledTransfer( void *clientdata )
+{
+  vtkDataTransfer *dt = reinterpret_cast < vtkDataTransfer*> (clientdata);
+  if ( dt->GetCancelRequested() ||
+       ( dt->GetHandler() != nullptr && dt->GetHandler()->GetTransferCancelRequested() ) )
+    {
+    //--- cancelled after the transfer was started but before it had a networking thread
+    dt->SetTransferStatusNoModify ( vtkDataTransfer::Cancelled );
+    this->GetApplicationLogic()->RequestModified( dt );
+    }
+  else
+    {
+    this->ApplyTransfer( clientdata );
+    }
+  this->Internal->TransferDone( dt );
+}
+
+//----------------------------------------------------------------------------
+void vtkDataIOManagerLogic::ReadTransferredData( void *clientdata )
+{
+  vtkInternal::StorageNodeRead *read = reinterpret_cast < vtkInternal::StorageNodeRead*> (clientdata);
+  read->DataRead = ( read->StorageNodeCopy->ReadData( read->NodeCopy ) != 0 );
+  this->Internal->ReadDone( read );
+}
+
 //----------------------------------------------------------------------------
 void vtkDataIOManagerLogic::ProgressCallback ( void * vtkNotUsed(who) )
 {
@@ -34,7 +34,13 @@ class VTK_SLICER_BASE_LOGIC_EXPORT vtkDataIOManagerLogic : public vtkSlicerModul
   virtual void SetAndObserveDataIOManager ( vtkDataIOManager *);
 
   ///
-  /// Methods that Queues the read
+  /// Methods that Queues the read.
+  /// If asynchronous IO is enabled, the files of the storage node are
+  /// transferred concurrently with other transfers (see
+  /// vtkDataIOManager::MaximumNumberOfConcurrentTransfers) and the storage
+  /// node is read once all of them are done: in a processing thread if the
+  /// storage node supports it (vtkMRMLStorageNode::CanReadInBackgroundThread()),
+  /// otherwise in the main thread.
   virtual int QueueRead ( vtkMRMLNode *node );
 
   ///
@@ -45,6 +51,10 @@ class VTK_SLICER_BASE_LOGIC_EXPORT vtkDataIOManagerLogic : public vtkSlicerModul
   /// The method that executes the data transfer in another thread
   virtual void ApplyTransfer(void *clientdata);
 
+  ///
+  /// Register the file downloaded from \a source in the cache index
+  void AddDownloadedFileToCache(const char *source, const char *dest);
+
   /// Description
   /// Communicates progress back to the DataIOManager
   static void ProgressCallback ( void * );
@@ -53,10 +63,27 @@ class VTK_SLICER_BASE_LOGIC_EXPORT vtkDataIOManagerLogic : public vtkSlicerModul
   /// Convenience method that goes through vtkDataIOManager
   /// to create a new DataTransfer object.
   virtual void AddNewDataTransfer ( vtkDataTransfer *transfer, vtkMRMLNode *node );
+  ///
+  /// Stop a transfer: a queued transfer is not started, a running
+  /// transfer is stopped if its handler supports it.
   virtual void CancelDataTransfer ( vtkDataTransfer *transfer );
   virtual void ClearCache();
   virtual void DeleteDataTransferFromCache ( vtkDataTransfer *transfer);
 
+  ///
+  /// Apply the asynchronous transfers and reads that are done: invoke
+  /// vtkDataIOManager::TransferDoneEvent and update the storable nodes.
+  /// Called in the main thread once transfers are done (it must be called
+  /// from the main thread only).
+  void ProcessCompletedTransfers();
+
+  ///
+  /// Number of asynchronous transfers waiting for a free transfer slot
+  int GetNumberOfPendingTransfers();
+  ///
+  /// Number of asynchronous transfers that are running
+  int GetNumberOfRunningTransfers();
+
  private:
   vtkDataIOManager *DataIOManager;
 
@@ -66,8 +93,18 @@ class VTK_SLICER_BASE_LOGIC_EXPORT vtkDataIOManagerLogic : public vtkSlicerModul
   vtkDataIOManagerLogic(const vtkDataIOManagerLogic&);
   void operator=(const vtkDataIOManagerLogic&);
 
+  ///
+  /// Task run in a networking thread for the transfers scheduled by QueueRead() and QueueWrite()
+  void ApplyScheduledTransfer(void *clientdata);
+  ///
+  /// Task run in a processing thread to read the files of a storage node once they are transferred
+  void ReadTransferredData(void *clientdata);
+
   vtkObserverManager* GetDataIOObserverManager();
   vtkObserverManager* DataIOObserverManager;
+
+  class vtkInternal;
+  vtkInternal* Internal;
   static void DataIOManagerCallback(vtkObject *caller, unsigned long eid, void *clientData, void *callData);
   virtual void ProcessDataIOManagerEvents( vtkObject *caller, unsigned long event, void *calldata );
 };
@@ -34,12 +34,14 @@
 // VTK includes
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
+#include <vtkTimeStamp.h>
 
 // ITKSYS includes
 #include <itksys/SystemTools.hxx>
 
 // STD includes
 #include <algorithm>
+#include <atomic>
 
 #ifdef ITK_USE_PTHREADS
 # include <unistd.h>
@@ -47,15 +49,195 @@
 # include <sys/resource.h>
 #endif
 
-#include <queue>
+#include <deque>
+#include <map>
+#include <thread>
 
 #include "vtkSlicerApplicationLogicRequests.h"
 
 //----------------------------------------------------------------------------
-class ProcessingTaskQueue : public std::queue<vtkSmartPointer<vtkSlicerTask> > {};
-class ModifiedQueue : public std::queue<vtkSmartPointer<vtkObject> > {};
-class ReadDataQueue : public std::queue<DataRequest*> {};
-class WriteDataQueue : public std::queue<DataRequest*> {};
+class ProcessingTaskQueue
+{
+public:
+  /// Add a task after the queued tasks of the same type that have the same or higher priority
+  void Push(vtkSlicerTask* task)
+    {
+    std::deque<vtkSmartPointer<vtkSlicerTask> >& tasks = this->Tasks[task->GetType()];
+    std::deque<vtkSmartPointer<vtkSlicerTask> >::iterator it =
+      std::find_if(tasks.begin(), tasks.end(), [task](const vtkSmartPointer<vtkSlicerTask>& queuedTask)
+        {
+        return queuedTask->GetPriority() < task->GetPriority();
+        });
+    tasks.insert(it, task);
+    }
+
+  /// Return true if there may be a task of the given type to run
+  bool HasTasks(int taskType) const
+    {
+    std::map<int, std::deque<vtkSmartPointer<vtkSlicerTask> > >::const_iterator it = this->Tasks.find(taskType);
+    return it != this->Tasks.end() && !it->second.empty();
+    }
+
+  /// Remove the highest priority task of the given type from the queue.
+  /// Canceled tasks are discarded. Returns nullptr if there is no task to run.
+  vtkSmartPointer<vtkSlicerTask> Pop(int taskType)
+    {
+    std::deque<vtkSmartPointer<vtkSlicerTask> >& tasks = this->Tasks[taskType];
+    while (!tasks.empty())
+      {
+      vtkSmartPointer<vtkSlicerTask> task = tasks.front();
+      tasks.pop_front();
+      if (!task->GetCanceled())
+        {
+        return task;
+        }
+      }
+    return nullptr;
+    }
+
+  /// Number of queued tasks that are not canceled
+  int GetNumberOfTasks()
+    {
+    int numberOfTasks = 0;
+    for (std::pair<const int, std::deque<vtkSmartPointer<vtkSlicerTask> > >& tasksOfType : this->Tasks)
+      {
+      for (vtkSlicerTask* task : tasksOfType.second)
+        {
+        if (!task->GetCanceled())
+          {
+          ++numberOfTasks;
+          }
+        }
+      }
+    return numberOfTasks;
+    }
+
+  void Clear()
+    {
+    this->Tasks.clear();
+    }
+
+private:
+  /// Queued tasks by task type, in decreasing order of priority
+  std::map<int, std::deque<vtkSmartPointer<vtkSlicerTask> > > Tasks;
+};
+
+//----------------------------------------------------------------------------
+/// Unbounded multiple-producer single-consumer queue.
+/// Push() can be called from any thread without locking, while Front(), Pop()
+/// and IsEmpty() must only be called from the consumer (main) thread.
+template <typename T>
+class RequestQueue
+{
+public:
+  RequestQueue()
+    {
+    Node* stub = new Node;
+    this->Head.store(stub);
+    this->Tail = stub;
+    }
+
+  ~RequestQueue()
+    {
+    T value;
+    while (this->Pop(value))
+      {
+      }
+    delete this->Tail;
+    }
+
+  void Push(T value)
+    {
+    Node* node = new Node;
+    node->Value = value;
+    // count the item first so that the size never gets negative
+    ++this->Size;
+    Node* previousHead = this->Head.exchange(node, std::memory_order_acq_rel);
+    previousHead->Next.store(node, std::memory_order_release);
+    }
+
+  bool IsEmpty() const
+    {
+    return this->Tail->Next.load(std::memory_order_acquire) == nullptr;
+    }
+
+  /// Return the oldest item without removing it. The queue must not be empty.
+  T Front() const
+    {
+    return this->Tail->Next.load(std::memory_order_acquire)->Value;
+    }
+
+  /// Remove the oldest item from the queue. Returns false if the queue is empty.
+  bool Pop(T& value)
+    {
+    Node* next = this->Tail->Next.load(std::memory_order_acquire);
+    if (!next)
+      {
+      return false;
+      }
+    value = next->Value;
+    delete this->Tail;
+    this->Tail = next;
+    --this->Size;
+    return true;
+    }
+
+  /// Number of items in the queue. The value is approximate while items are pushed.
+  unsigned int GetSize() const
+    {
+    return static_cast<unsigned int>(this->Size.load());
+    }
+
+private:
+  struct Node
+    {
+    std::atomic<Node*> Next{nullptr};
+    T Value{};
+    };
+  /// Last pushed node, shared by the producers
+  std::atomic<Node*> Head;
+  /// Node preceding the oldest item, only accessed by the consumer
+  Node* Tail;
+  std::atomic<int> Size{0};
+};
+
+class ModifiedQueue : public RequestQueue<vtkObject*> {};
+class ReadDataQueue : public RequestQueue<DataRequest*> {};
+class WriteDataQueue : public RequestQueue<DataRequest*> {};
+
+namespace
+{
+/// Delay passed to the Request*Event invoked when a queue needs to be processed
+int ImmediateProcessingDelay = 0;
+
+//----------------------------------------------------------------------------
+/// Return a new monotonically increasing request UID. The global modified time
+/// counter is atomic, so UIDs can be created by several threads at once.
+vtkMTimeType GetNewRequestUID()
+{
+  vtkTimeStamp requestTimeStamp;
+  requestTimeStamp.Modified();
+  return requestTimeStamp.GetMTime();
+}
+
+//----------------------------------------------------------------------------
+/// Return true if the consumer must process the queue again. If the queue is
+/// empty, processing stops until a producer requests it.
+template <typename Queue>
+bool IsQueueProcessingNeeded(Queue* queue, std::atomic<bool>& processingRequested)
+{
+  if (!queue->IsEmpty())
+    {
+    return true;
+    }
+  // Exchange (and not store) so that requests queued by producers that have seen
+  // the flag set are visible after the reset.
+  processingRequested.exchange(false);
+  // A request may have been queued after the queue was found empty but before
+  // the flag was reset, in which case the producer did not request processing.
+  return !queue->IsEmpty() && !processingRequested.exchange(true);
+}
+}
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSlicerApplicationLogic);
@@ -64,18 +246,21 @@ vtkStandardNewMacro(vtkSlicerApplicationLogic);
 vtkSlicerApplicationLogic::vtkSlicerApplicationLogic()
 {
   this->ProcessingThreader = itk::PlatformMultiThreader::New();
-  this->ProcessingThreadId = -1;
   this->ProcessingThreadActive = false;
+  // CLI modules are often multi-threaded themselves, therefore only a few of them are run at once
+  this->NumberOfProcessingThreads = std::max(1, std::min(4, static_cast<int>(std::thread::hardware_concurrency())));
+  // A single networking thread is used by default, as curl may not be built thread-safe
+  this->NumberOfNetworkingThreads = 1;
 
   this->ModifiedQueueActive = false;
-
   this->ReadDataQueueActive = false;
-
   this->WriteDataQueueActive = false;
+  this->ModifiedQueueProcessingRequested = false;
+  this->ReadDataQueueProcessingRequested = false;
+  this->WriteDataQueueProcessingRequested = false;
 
   this->InternalTaskQueue = new ProcessingTaskQueue;
   this->InternalModifiedQueue = new ModifiedQueue;
-
   this->InternalReadDataQueue = new ReadDataQueue;
   this->InternalWriteDataQueue = new WriteDataQueue;
 
@@ -85,34 +270,29 @@ vtkSlicerApplicationLogic::vtkSlicerApplicationLogic()
 //----------------------------------------------------------------------------
 vtkSlicerApplicationLogic::~vtkSlicerApplicationLogic()
 {
-  // Note that TerminateThread does not kill a thread, it only waits
-  // for the thread to finish.  We need to signal the thread that we
-  // want to terminate
-  if (this->ProcessingThreadId != -1 && this->ProcessingThreader)
-    {
-    // Signal the processingThread that we are terminating.
-    this->ProcessingThreadActiveLock.lock();
-    this->ProcessingThreadActive = false;
-    this->ProcessingThreadActiveLock.unlock();
-
-    // Wait for the thread to finish and clean up the state of the threader
-    this->ProcessingThreader->TerminateThread( this->ProcessingThreadId );
-
-    this->ProcessingThreadId = -1;
-    }
+  // Signal the processing and networking threads that we are terminating
+  // and wait for them to finish
+  this->TerminateProcessingThread();
 
   delete this->InternalTaskQueue;
 
-  this->ModifiedQueueLock.lock();
-  while (!(*this->InternalModifiedQueue).empty())
+  // The threads are terminated, the queues can be emptied without contention
+  vtkObject* obj = nullptr;
+  while (this->InternalModifiedQueue->Pop(obj))
     {
-    vtkObject *obj = (*this->InternalModifiedQueue).front();
-    (*this->InternalModifiedQueue).pop();
-    obj->Delete(); // decrement ref count
+    obj->UnRegister(this); // decrement ref count
     }
-  this->ModifiedQueueLock.unlock();
   delete this->InternalModifiedQueue;
+  DataRequest* req = nullptr;
+  while (this->InternalReadDataQueue->Pop(req))
+    {
+    delete req;
+    }
   delete this->InternalReadDataQueue;
+  while (this->InternalWriteDataQueue->Pop(req))
+    {
+    delete req;
+    }
   delete this->InternalWriteDataQueue;
 
   this->UserInformation->Delete();
@@ -121,7 +301,7 @@ vtkSlicerApplicationLogic::~vtkSlicerApplicationLogic()
 //----------------------------------------------------------------------------
 unsigned int vtkSlicerApplicationLogic::GetReadDataQueueSize()
 {
-  return static_cast<unsigned int>( (*this->InternalReadDataQueue).size() );
+  return this->InternalReadDataQueue->GetSize();
 }
 
 //-----------------------------------------------------------------------------
@@ -164,93 +344,83 @@ void vtkSlicerApplicationLogic::PrintSelf(ostream& os, vtkIndent indent)
   this->vtkObject::PrintSelf(os, indent);
 
   os << indent << "SlicerApplicationLogic:             " << this->GetClassName() << "\n";
+  os << indent << "NumberOfProcessingThreads:          " << this->NumberOfProcessingThreads << "\n";
+  os << indent << "NumberOfNetworkingThreads:          " << this->NumberOfNetworkingThreads << "\n";
 }
 
 //----------------------------------------------------------------------------
 void vtkSlicerApplicationLogic::CreateProcessingThread()
 {
-  if (this->ProcessingThreadId == -1)
+  if (this->ProcessingThreadIDs.empty())
     {
     this->ProcessingThreadActiveLock.lock();
     this->ProcessingThreadActive = true;
     this->ProcessingThreadActiveLock.unlock();
 
-    this->ProcessingThreadId
-      = this->ProcessingThreader
-      ->SpawnThread(vtkSlicerApplicationLogic::ProcessingThreaderCallback,
-                    this);
-
-    // Start four network threads (TODO: make the number of threads a setting)
-    this->NetworkingThreadIDs.push_back ( this->ProcessingThreader
-          ->SpawnThread(vtkSlicerApplicationLogic::NetworkingThreaderCallback,
-                    this) );
-    /*
-     * TODO: it looks like curl is not thread safe by default
-     * - maybe there's a setting that cmcurl can have
-     *   similar to the --enable-threading of the standard curl build
-     *
-    this->NetworkingThreadIDs.push_back ( this->ProcessingThreader
-          ->SpawnThread(vtkSlicerApplicationLogic::NetworkingThreaderCallback,
-                    this) );
-    this->NetworkingThreadIDs.push_back ( this->ProcessingThreader
-          ->SpawnThread(vtkSlicerApplicationLogic::NetworkingThreaderCallback,
-                    this) );
-    this->NetworkingThreadIDs.push_back ( this->ProcessingThreader
-          ->SpawnThread(vtkSlicerApplicationLogic::NetworkingThreaderCallback,
-                    this) );
-    */
-
-    // Setup the communication channel back to the main thread
-    this->ModifiedQueueActiveLock.lock();
+    for (int i = 0; i < this->NumberOfProcessingThreads; ++i)
+      {
+      this->ProcessingThreadIDs.push_back( this->ProcessingThreader
+        ->SpawnThread(vtkSlicerApplicationLogic::ProcessingThreaderCallback,
+                      this) );
+      }
+
+    // Note: curl may not be thread safe (if it is not built with
+    // --enable-threading), so only increase the number of networking
+    // threads if all networking tasks are known to support it.
+    for (int i = 0; i < this->NumberOfNetworkingThreads; ++i)
+      {
+      this->NetworkingThreadIDs.push_back( this->ProcessingThreader
+        ->SpawnThread(vtkSlicerApplicationLogic::NetworkingThreaderCallback,
+                      this) );
+      }
+
+    // Setup the communication channel back to the main thread.
+    // Queues are not polled: processing is requested when a request is queued.
+    this->ModifiedQueueProcessingRequested = false;
+    this->ReadDataQueueProcessingRequested = false;
+    this->WriteDataQueueProcessingRequested = false;
     this->ModifiedQueueActive = true;
-    this->ModifiedQueueActiveLock.unlock();
-    this->ReadDataQueueActiveLock.lock();
     this->ReadDataQueueActive = true;
-    this->ReadDataQueueActiveLock.unlock();
-    this->WriteDataQueueActiveLock.lock();
     this->WriteDataQueueActive = true;
-    this->WriteDataQueueActiveLock.unlock();
-
-    int delay = 1000;
-    this->InvokeEvent(vtkSlicerApplicationLogic::RequestModifiedEvent, &delay);
-    this->InvokeEvent(vtkSlicerApplicationLogic::RequestReadDataEvent, &delay);
-    this->InvokeEvent(vtkSlicerApplicationLogic::RequestWriteDataEvent, &delay);
     }
 }
 
 //----------------------------------------------------------------------------
 void vtkSlicerApplicationLogic::TerminateProcessingThread()
 {
-  if (this->ProcessingThreadId != -1)
+  if (!this->ProcessingThreadIDs.empty())
     {
-    this->ModifiedQueueActiveLock.lock();
     this->ModifiedQueueActive = false;
-    this->ModifiedQueueActiveLock.unlock();
-
-    this->ReadDataQueueActiveLock.lock();
     this->ReadDataQueueActive = false;
-    this->ReadDataQueueActiveLock.unlock();
-
-    this->WriteDataQueueActiveLock.lock();
     this->WriteDataQueueActive = false;
-    this->WriteDataQueueActiveLock.unlock();
 
     this->ProcessingThreadActiveLock.lock();
     this->ProcessingThreadActive = false;
     this->ProcessingThreadActiveLock.unlock();
 
-    this->ProcessingThreader->TerminateThread( this->ProcessingThreadId );
-    this->ProcessingThreadId = -1;
+    // Wake up the threads that are waiting for a task. The queue lock ensures
+    // that a thread either has seen the inactive state or is already waiting.
+    this->ProcessingTaskQueueLock.lock();
+    this->ProcessingTaskQueueLock.unlock();
+    this->ProcessingTaskQueueCondition.notify_all();
 
-    std::vector<int>::const_iterator idIterator;
-    idIterator = this->NetworkingThreadIDs.begin();
-    while (idIterator != this->NetworkingThreadIDs.end())
+    // Note that TerminateThread does not kill a thread, it only waits
+    // for the thread to finish.
+    for (int threadId : this->ProcessingThreadIDs)
+      {
+      this->ProcessingThreader->TerminateThread( threadId );
+      }
+    this->ProcessingThreadIDs.clear();
+    for (int threadId : this->NetworkingThreadIDs)
       {
-      this->ProcessingThreader->TerminateThread( *idIterator );
-      ++idIterator;
+      this->ProcessingThreader->TerminateThread( threadId );
       }
     this->NetworkingThreadIDs.clear();
 
+    // Discard tasks that have not been started
+    this->ProcessingTaskQueueLock.lock();
+    this->InternalTaskQueue->Clear();
+    this->ProcessingTaskQueueLock.unlock();
     }
 }
 
@@ -276,48 +446,7 @@ vtkSlicerApplicationLogic::ProcessingThreaderCallback(void* arg)
 //----------------------------------------------------------------------------
 void vtkSlicerApplicationLogic::ProcessProcessingTasks()
 {
-  int active = true;
-  vtkSmartPointer<vtkSlicerTask> task = nullptr;
-
-  while (active)
-    {
-    // Check to see if we should be shutting down
-    this->ProcessingThreadActiveLock.lock();
-    active = this->ProcessingThreadActive;
-    this->ProcessingThreadActiveLock.unlock();
-
-    if (active)
-      {
-      // pull a task off the queue
-      this->ProcessingTaskQueueLock.lock();
-      if ((*this->InternalTaskQueue).size() > 0)
-        {
-        // std::cout << "Number of queued tasks: " << (*this->InternalTaskQueue).size() << std::endl;
-
-        // only handle processing tasks in this thread
-        task = (*this->InternalTaskQueue).front();
-        if ( task->GetType() == vtkSlicerTask::Processing )
-          {
-          (*this->InternalTaskQueue).pop();
-          }
-        else
-          {
-          task = nullptr;
-          }
-        }
-      this->ProcessingTaskQueueLock.unlock();
-
-      // process the task (should this be in a separate thread?)
-      if (task)
-        {
-        task->Execute();
-        task = nullptr;
-        }
-      }
-
-    // busy wait
-    itksys::SystemTools::Delay(100);
-    }
+  this->ProcessTasks(vtkSlicerTask::Processing);
 }
 
 itk::ITK_THREAD_RETURN_TYPE
@@ -341,45 +470,38 @@ vtkSlicerApplicationLogic::NetworkingThreaderCallback(void* arg)
 //----------------------------------------------------------------------------
 void vtkSlicerApplicationLogic::ProcessNetworkingTasks()
 {
-  int active = true;
-  vtkSmartPointer<vtkSlicerTask> task = nullptr;
+  this->ProcessTasks(vtkSlicerTask::Networking);
+}
 
-  while (active)
+//----------------------------------------------------------------------------
+void vtkSlicerApplicationLogic::ProcessTasks(int taskType)
+{
+  while (true)
     {
-    // Check to see if we should be shutting down
-    this->ProcessingThreadActiveLock.lock();
-    active = this->ProcessingThreadActive;
-    this->ProcessingThreadActiveLock.unlock();
-
-    if (active)
+    vtkSmartPointer<vtkSlicerTask> task;
       {
-      // pull a task off the queue
-      this->ProcessingTaskQueueLock.lock();
-      if ((*this->InternalTaskQueue).size() > 0)
+      std::unique_lock<std::mutex> lock(this->ProcessingTaskQueueLock);
+      bool active = true;
+      this->ProcessingTaskQueueCondition.wait(lock, [this, taskType, &active]()
         {
-        // std::cout << "Number of queued tasks: " << (*this->InternalTaskQueue).size() << std::endl;
-        task = (*this->InternalTaskQueue).front();
-        if ( task->GetType() == vtkSlicerTask::Networking )
-          {
-          (*this->InternalTaskQueue).pop();
-          }
-        else
-          {
-          task = nullptr;
-          }
-        }
-      this->ProcessingTaskQueueLock.unlock();
-
-      // process the task (should this be in a separate thread?)
-      if (task)
+        // Check to see if we should be shutting down
+        this->ProcessingThreadActiveLock.lock();
+        active = this->ProcessingThreadActive;
+        this->ProcessingThreadActiveLock.unlock();
+        return !active || this->InternalTaskQueue->HasTasks(taskType);
+        });
+      if (!active)
         {
-        task->Execute();
-        task = nullptr;
+        return;
         }
+      // pull the highest priority task of this type off the queue
+      task = this->InternalTaskQueue->Pop(taskType);
       }
 
-    // busy wait
-    itksys::SystemTools::Delay(100);
+    if (task)
+      {
+      task->Execute();
+      }
     }
 }
 
@@ -395,31 +517,54 @@ int vtkSlicerApplicationLogic::ScheduleTask( vtkSlicerTask *task )
     return false;
     }
 
+  if (!task || (task->GetType() != vtkSlicerTask::Processing && task->GetType() != vtkSlicerTask::Networking))
+    {
+    vtkWarningMacro("ScheduleTask failed: task type must be Processing or Networking");
+    return false;
+    }
+
   this->ProcessingTaskQueueLock.lock();
-  (*this->InternalTaskQueue).push( task );
+  this->InternalTaskQueue->Push( task );
   this->ProcessingTaskQueueLock.unlock();
+  this->ProcessingTaskQueueCondition.notify_all();
   return true;
 }
 
+//----------------------------------------------------------------------------
+int vtkSlicerApplicationLogic::GetNumberOfQueuedTasks()
+{
+  std::lock_guard<std::mutex> lock(this->ProcessingTaskQueueLock);
+  return this->InternalTaskQueue->GetNumberOfTasks();
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerApplicationLogic::RequestQueueProcessing(
+  std::atomic<bool>& processingRequested, unsigned long event)
+{
+  // Only the first request queued since the last processing wakes up the main
+  // thread, the following ones are handled by the same processing.
+  if (!processingRequested.exchange(true))
+    {
+    // Safe to call from any thread: the event is invoked in the main thread.
+    this->InvokeEventWithDelay(0, this, event, &ImmediateProcessingDelay);
+    }
+}
+
 //----------------------------------------------------------------------------
 vtkMTimeType vtkSlicerApplicationLogic::RequestModified(vtkObject *obj)
 {
   // only request a Modified if the Modified queue is up
-  this->ModifiedQueueActiveLock.lock();
-  int active = this->ModifiedQueueActive;
-  this->ModifiedQueueActiveLock.unlock();
-  if (!active)
+  if (!this->ModifiedQueueActive)
     {
     // could not request the Modified
     return 0;
     }
 
   obj->Register(this);
-  this->ModifiedQueueLock.lock();
-  this->RequestTimeStamp.Modified();
-  vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
-  (*this->InternalModifiedQueue).push(obj);
-  this->ModifiedQueueLock.unlock();
+  vtkMTimeType uid = GetNewRequestUID();
+  this->InternalModifiedQueue->Push(obj);
+  this->RequestQueueProcessing(this->ModifiedQueueProcessingRequested,
+    vtkSlicerApplicationLogic::RequestModifiedEvent);
   return uid;
 }
 
@@ -427,21 +572,16 @@ vtkMTimeType vtkSlicerApplicationLogic::RequestModified(vtkObject *obj)
 vtkMTimeType vtkSlicerApplicationLogic::RequestReadFile(const char *refNode, const char *filename, int displayData, int deleteFile)
 {
   // only request to read a file if the ReadData queue is up
-  this->ReadDataQueueActiveLock.lock();
-  int active = this->ReadDataQueueActive;
-  this->ReadDataQueueActiveLock.unlock();
-  if (!active)
+  if (!this->ReadDataQueueActive)
   {
     // could not request the record be added to the queue
     return 0;
   }
 
-  this->ReadDataQueueLock.lock();
-  this->RequestTimeStamp.Modified();
-  vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
-  (*this->InternalReadDataQueue).push(
-    new ReadDataRequestFile(refNode, filename, displayData, deleteFile, uid));
-  this->ReadDataQueueLock.unlock();
+  vtkMTimeType uid = GetNewRequestUID();
+  this->InternalReadDataQueue->Push(new ReadDataRequestFile(refNode, filename, displayData, deleteFile, uid));
+  this->RequestQueueProcessing(this->ReadDataQueueProcessingRequested,
+    vtkSlicerApplicationLogic::RequestReadDataEvent);
   return uid;
 }
 
@@ -449,20 +589,16 @@ vtkMTimeType vtkSlicerApplicationLogic::RequestReadFile(const char *refNode, con
 vtkMTimeType vtkSlicerApplicationLogic::RequestUpdateParentTransform(const std::string &refNode, const std::string& parentTransformNode)
 {
   // only request to read a file if the ReadData queue is up
-  this->ReadDataQueueActiveLock.lock();
-  int active = this->ReadDataQueueActive;
-  this->ReadDataQueueActiveLock.unlock();
-  if (!active)
+  if (!this->ReadDataQueueActive)
     {
     // could not request the record be added to the queue
     return 0;
     }
 
-  this->ReadDataQueueLock.lock();
-  this->RequestTimeStamp.Modified();
-  vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
-  (*this->InternalReadDataQueue).push(new ReadDataRequestUpdateParentTransform(refNode, parentTransformNode, uid));
-  this->ReadDataQueueLock.unlock();
+  vtkMTimeType uid = GetNewRequestUID();
+  this->InternalReadDataQueue->Push(new ReadDataRequestUpdateParentTransform(refNode, parentTransformNode, uid));
+  this->RequestQueueProcessing(this->ReadDataQueueProcessingRequested,
+    vtkSlicerApplicationLogic::RequestReadDataEvent);
   return uid;
 }
 
@@ -470,20 +606,16 @@ vtkMTimeType vtkSlicerApplicationLogic::RequestUpdateParentTransform(const std::
 vtkMTimeType vtkSlicerApplicationLogic::RequestUpdateSubjectHierarchyLocation(const std::string &updatedNode, const std::string& siblingNode)
 {
   // only request to read a file if the ReadData queue is up
-  this->ReadDataQueueActiveLock.lock();
-  int active = this->ReadDataQueueActive;
-  this->ReadDataQueueActiveLock.unlock();
-  if (!active)
+  if (!this->ReadDataQueueActive)
     {
     // could not request the record be added to the queue
     return 0;
     }
 
-  this->ReadDataQueueLock.lock();
-  this->RequestTimeStamp.Modified();
-  vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
-  (*this->InternalReadDataQueue).push(new ReadDataRequestUpdateSubjectHierarchyLocation(updatedNode, siblingNode, uid));
-  this->ReadDataQueueLock.unlock();
+  vtkMTimeType uid = GetNewRequestUID();
+  this->InternalReadDataQueue->Push(new ReadDataRequestUpdateSubjectHierarchyLocation(updatedNode, siblingNode, uid));
+  this->RequestQueueProcessing(this->ReadDataQueueProcessingRequested,
+    vtkSlicerApplicationLogic::RequestReadDataEvent);
   return uid;
 }
 
@@ -491,20 +623,16 @@ vtkMTimeType vtkSlicerApplicationLogic::RequestUpdateSubjectHierarchyLocation(co
 vtkMTimeType vtkSlicerApplicationLogic::RequestAddNodeReference(const std::string &referencingNode, const std::string& referencedNode, const std::string& role)
 {
   // only request to read a file if the ReadData queue is up
-  this->ReadDataQueueActiveLock.lock();
-  int active = this->ReadDataQueueActive;
-  this->ReadDataQueueActiveLock.unlock();
-  if (!active)
+  if (!this->ReadDataQueueActive)
     {
     // could not request the record be added to the queue
     return 0;
     }
 
-  this->ReadDataQueueLock.lock();
-  this->RequestTimeStamp.Modified();
-  vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
-  (*this->InternalReadDataQueue).push(new ReadDataRequestAddNodeReference(referencingNode, referencedNode, role, uid));
-  this->ReadDataQueueLock.unlock();
+  vtkMTimeType uid = GetNewRequestUID();
+  this->InternalReadDataQueue->Push(new ReadDataRequestAddNodeReference(referencingNode, referencedNode, role, uid));
+  this->RequestQueueProcessing(this->ReadDataQueueProcessingRequested,
+    vtkSlicerApplicationLogic::RequestReadDataEvent);
   return uid;
 }
 
@@ -512,21 +640,16 @@ vtkMTimeType vtkSlicerApplicationLogic::RequestAddNodeReference(const std::strin
 vtkMTimeType vtkSlicerApplicationLogic::RequestWriteData(const char *refNode, const char *filename)
 {
   // only request to write a file if the WriteData queue is up
-  this->WriteDataQueueActiveLock.lock();
-  int active = this->WriteDataQueueActive;
-  this->WriteDataQueueActiveLock.unlock();
-  if (!active)
+  if (!this->WriteDataQueueActive)
     {
     // could not request the record be added to the queue
     return 0;
     }
 
-  this->WriteDataQueueLock.lock();
-  this->RequestTimeStamp.Modified();
-  vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
-  (*this->InternalWriteDataQueue).push(
-    new WriteDataRequestFile(refNode, filename, uid) );
-  this->WriteDataQueueLock.unlock();
+  vtkMTimeType uid = GetNewRequestUID();
+  this->InternalWriteDataQueue->Push(new WriteDataRequestFile(refNode, filename, uid));
+  this->RequestQueueProcessing(this->WriteDataQueueProcessingRequested,
+    vtkSlicerApplicationLogic::RequestWriteDataEvent);
   return uid;
 }
 
@@ -538,21 +661,16 @@ vtkMTimeType vtkSlicerApplicationLogic::RequestReadScene(
     int displayData, int deleteFile)
 {
   // only request to read a file if the ReadData queue is up
-  this->ReadDataQueueActiveLock.lock();
-  int active = this->ReadDataQueueActive;
-  this->ReadDataQueueActiveLock.unlock();
-  if (!active)
+  if (!this->ReadDataQueueActive)
     {
     // could not request the record be added to the queue
     return 0;
     }
 
-  this->ReadDataQueueLock.lock();
-  this->RequestTimeStamp.Modified();
-  vtkMTimeType uid = this->RequestTimeStamp.GetMTime();
-  (*this->InternalReadDataQueue).push(
-    new ReadDataRequestScene(targetIDs, sourceIDs, filename, displayData, deleteFile, uid));
-  this->ReadDataQueueLock.unlock();
+  vtkMTimeType uid = GetNewRequestUID();
+  this->InternalReadDataQueue->Push(new ReadDataRequestScene(targetIDs, sourceIDs, filename, displayData, deleteFile, uid));
+  this->RequestQueueProcessing(this->ReadDataQueueProcessingRequested,
+    vtkSlicerApplicationLogic::RequestReadDataEvent);
   return uid;
 }
 
@@ -560,35 +678,28 @@ vtkMTimeType vtkSlicerApplicationLogic::RequestReadScene(
 void vtkSlicerApplicationLogic::ProcessModified()
 {
   // Check to see if we should be shutting down
-  this->ModifiedQueueActiveLock.lock();
-  int active = this->ModifiedQueueActive;
-  this->ModifiedQueueActiveLock.unlock();
-  if (!active)
+  if (!this->ModifiedQueueActive)
     {
     return;
     }
 
-  vtkSmartPointer<vtkObject> obj = nullptr;
   // pull an object off the queue to modify
-  this->ModifiedQueueLock.lock();
-  if ((*this->InternalModifiedQueue).size() > 0)
+  vtkObject* obj = nullptr;
+  if (this->InternalModifiedQueue->Pop(obj))
     {
-    obj = (*this->InternalModifiedQueue).front();
-    (*this->InternalModifiedQueue).pop();
-
     // pop off any extra copies of the same object to save some updates
-    while (!(*this->InternalModifiedQueue).empty()
-           && (obj == (*this->InternalModifiedQueue).front()))
+    while (!this->InternalModifiedQueue->IsEmpty()
+           && (obj == this->InternalModifiedQueue->Front()))
       {
-      (*this->InternalModifiedQueue).pop();
-      obj->Delete(); // decrement ref count
+      vtkObject* duplicate = nullptr;
+      this->InternalModifiedQueue->Pop(duplicate);
+      duplicate->UnRegister(this); // decrement ref count
       }
     }
-  this->ModifiedQueueLock.unlock();
 
   // Modify the object
   //  - decrement reference count that was increased when it was added to the queue
-  if (obj.GetPointer())
+  if (obj)
     {
     vtkMRMLNode* node = vtkMRMLNode::SafeDownCast(obj);
     if (node)
@@ -603,37 +714,30 @@ void vtkSlicerApplicationLogic::ProcessModified()
       {
       obj->Modified();
       }
-    obj->Delete();
+    obj->UnRegister(this);
     obj = nullptr;
     }
 
-  // schedule the next timer sooner in case there is stuff in the queue
-  // otherwise for a while later
-  int delay = (*this->InternalModifiedQueue).size() > 0 ? 0: 200;
-  this->InvokeEvent(vtkSlicerApplicationLogic::RequestModifiedEvent, &delay);
+  // schedule the next processing right away if there is stuff in the queue,
+  // the GUI events are processed in between
+  if (IsQueueProcessingNeeded(this->InternalModifiedQueue, this->ModifiedQueueProcessingRequested))
+    {
+    this->InvokeEvent(vtkSlicerApplicationLogic::RequestModifiedEvent, &ImmediateProcessingDelay);
+    }
 }
 
 //----------------------------------------------------------------------------
 void vtkSlicerApplicationLogic::ProcessReadData()
 {
   // Check to see if we should be shutting down
-  this->ReadDataQueueActiveLock.lock();
-  int active = this->ReadDataQueueActive;
-  this->ReadDataQueueActiveLock.unlock();
-  if (!active)
+  if (!this->ReadDataQueueActive)
     {
     return;
     }
 
   // pull an object off the queue
   DataRequest* req = nullptr;
-  this->ReadDataQueueLock.lock();
-  if ((*this->InternalReadDataQueue).size() > 0)
-    {
-    req = (*this->InternalReadDataQueue).front();
-    (*this->InternalReadDataQueue).pop();
-    }
-  this->ReadDataQueueLock.unlock();
+  this->InternalReadDataQueue->Pop(req);
 
   vtkMTimeType uid = 0;
   if (req)
@@ -643,10 +747,12 @@ void vtkSlicerApplicationLogic::ProcessReadData()
     delete req;
     }
 
-  int delay = (*this->InternalReadDataQueue).size() > 0 ? 0: 200;
-  // schedule the next timer sooner in case there is stuff in the queue
-  // otherwise for a while later
-  this->InvokeEvent(vtkSlicerApplicationLogic::RequestReadDataEvent, &delay);
+  // schedule the next processing right away if there is stuff in the queue,
+  // the GUI events are processed in between
+  if (IsQueueProcessingNeeded(this->InternalReadDataQueue, this->ReadDataQueueProcessingRequested))
+    {
+    this->InvokeEvent(vtkSlicerApplicationLogic::RequestReadDataEvent, &ImmediateProcessingDelay);
+    }
   if (uid)
     {
     this->InvokeEvent(vtkSlicerApplicationLogic::RequestProcessedEvent,
@@ -658,40 +764,34 @@ void vtkSlicerApplicationLogic::ProcessReadData()
 void vtkSlicerApplicationLogic::ProcessWriteData()
 {
   // Check to see if we should be shutting down
-  this->WriteDataQueueActiveLock.lock();
-  int active = this->WriteDataQueueActive;
-  this->WriteDataQueueActiveLock.unlock();
-  if (!active)
+  if (!this->WriteDataQueueActive)
     {
     return;
     }
 
   // pull an object off the queue
   DataRequest *req = nullptr;
-  this->WriteDataQueueLock.lock();
-  if ((*this->InternalWriteDataQueue).size() > 0)
-    {
-    req = (*this->InternalWriteDataQueue).front();
-    (*this->InternalWriteDataQueue).pop();
-    }
-  this->WriteDataQueueLock.unlock();
+  this->InternalWriteDataQueue->Pop(req);
 
+  vtkMTimeType uid = 0;
   if (req)
-  {
-    vtkMTimeType uid = req->GetUID();
+    {
+    uid = req->GetUID();
     req->Execute(this);
     delete req;
+    }
 
-    // schedule the next timer sooner in case there is stuff in the queue
-    // otherwise for a while later
-    int delay = (*this->InternalWriteDataQueue).size() > 0 ? 0 : 200;
-    this->InvokeEvent(vtkSlicerApplicationLogic::RequestWriteDataEvent, &delay);
-    if (uid)
-      {
-      this->InvokeEvent(vtkSlicerApplicationLogic::RequestProcessedEvent,
-        reinterpret_cast<void*>(uid));
-      }
-  }
+  // schedule the next processing right away if there is stuff in the queue,
+  // the GUI events are processed in between
+  if (IsQueueProcessingNeeded(this->InternalWriteDataQueue, this->WriteDataQueueProcessingRequested))
+    {
+    this->InvokeEvent(vtkSlicerApplicationLogic::RequestWriteDataEvent, &ImmediateProcessingDelay);
+    }
+  if (uid)
+    {
+    this->InvokeEvent(vtkSlicerApplicationLogic::RequestProcessedEvent,
+                      reinterpret_cast<void*>(uid));
+    }
 }
 
 //----------------------------------------------------------------------------
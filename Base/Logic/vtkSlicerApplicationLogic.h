@@ -31,7 +31,10 @@
 #include <itkPlatformMultiThreader.h>
 
 // STL includes
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
+#include <vector>
 
 class vtkMRMLSelectionNode;
 class vtkMRMLInteractionNode;
@@ -68,11 +71,29 @@ class VTK_SLICER_BASE_LOGIC_EXPORT vtkSlicerApplicationLogic
                           vtkDataIOManagerLogic *dataIOManagerLogic);
 
 
-  /// Create a thread for processing
+  /// Create the threads for processing and networking tasks
+  /// \sa SetNumberOfProcessingThreads(), SetNumberOfNetworkingThreads()
   void CreateProcessingThread();
 
-  /// Shutdown the processing thread
+  /// Shutdown the processing and networking threads.
+  /// Tasks that are running are completed, tasks that have not started yet are discarded.
   void TerminateProcessingThread();
+
+  /// Number of threads that run vtkSlicerTask::Processing tasks concurrently
+  /// (for example CLI module executions).
+  /// Default is the number of hardware threads, at most 4.
+  /// The value is used by the next CreateProcessingThread() call.
+  vtkSetClampMacro(NumberOfProcessingThreads, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfProcessingThreads, int);
+
+  /// Number of threads that run vtkSlicerTask::Networking tasks concurrently
+  /// (for example remote downloads). Default is 1.
+  /// The value is used by the next CreateProcessingThread() call.
+  vtkSetClampMacro(NumberOfNetworkingThreads, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfNetworkingThreads, int);
+
+  /// Number of scheduled tasks that have not been started yet
+  int GetNumberOfQueuedTasks();
   /// List of events potentially fired by the application logic
   enum RequestEvents
     {
@@ -86,9 +107,13 @@ class VTK_SLICER_BASE_LOGIC_EXPORT vtkSlicerApplicationLogic
       RequestProcessedEvent
     };
 
-  /// Schedule a task to run in the processing thread. Returns true if
-  /// task was successfully scheduled. ScheduleTask() is called from the
-  /// main thread to run something in the processing thread.
+  /// Schedule a task to run in a processing or networking thread (depending on
+  /// the task type). Returns true if task was successfully scheduled.
+  /// ScheduleTask() is called from the main thread to run something in the
+  /// processing thread.
+  /// Queued tasks are started in order of decreasing priority as soon as a thread
+  /// of the matching type is available, so multiple tasks may run concurrently.
+  /// \sa vtkSlicerTask::SetPriority(), vtkSlicerTask::Cancel()
   int ScheduleTask( vtkSlicerTask* );
 
   /// Request a Modified call on an object.  This method allows a
@@ -170,6 +195,11 @@ class VTK_SLICER_BASE_LOGIC_EXPORT vtkSlicerApplicationLogic
   /// in the main thread of the application because calls to Modified()
   /// can cause an update to the GUI. (Method needs to be public to fit
   /// in the event callback chain.)
+  ///
+  /// The request queues are not polled: queuing a request into an idle queue
+  /// (from any thread) invokes the associated Request*Event in the main thread
+  /// using InvokeEventWithDelay(), and the queue is processed one request at a
+  /// time until it is empty.
   void ProcessModified();
 
   /// Process a request to read data and set it on a referenced node.
@@ -239,6 +269,14 @@ protected:
   /// Networking Task processing loop that is run in a networking thread
   void ProcessNetworkingTasks();
 
+  /// Run tasks of the given type until the threads are terminated
+  void ProcessTasks(int taskType);
+
+  /// Request the main thread to process a request queue by invoking \a event
+  /// (RequestModifiedEvent, RequestReadDataEvent or RequestWriteDataEvent),
+  /// unless processing is already requested. Can be called from any thread.
+  void RequestQueueProcessing(std::atomic<bool>& processingRequested, unsigned long event);
+
   /// Process a request to read data into a scene.  This method is
   /// called by ProcessReadData() in the application main thread
   /// because calls to load data will cause a Modified() on a node
@@ -259,19 +297,20 @@ private:
   itk::PlatformMultiThreader::Pointer ProcessingThreader;
   std::mutex ProcessingThreadActiveLock;
   std::mutex ProcessingTaskQueueLock;
-  std::mutex ModifiedQueueActiveLock;
-  std::mutex ModifiedQueueLock;
-  std::mutex ReadDataQueueActiveLock;
-  std::mutex ReadDataQueueLock;
-  std::mutex WriteDataQueueActiveLock;
-  std::mutex WriteDataQueueLock;
-  vtkTimeStamp RequestTimeStamp;
-  int ProcessingThreadId;
+  /// Notified when a task is queued or when the threads are terminated
+  std::condition_variable ProcessingTaskQueueCondition;
+  std::vector<int> ProcessingThreadIDs;
   std::vector<int> NetworkingThreadIDs;
+  int NumberOfProcessingThreads;
+  int NumberOfNetworkingThreads;
   int ProcessingThreadActive;
-  int ModifiedQueueActive;
-  int ReadDataQueueActive;
-  int WriteDataQueueActive;
+  std::atomic<bool> ModifiedQueueActive;
+  std::atomic<bool> ReadDataQueueActive;
+  std::atomic<bool> WriteDataQueueActive;
+  /// Set when the main thread has been requested to process the queue
+  std::atomic<bool> ModifiedQueueProcessingRequested;
+  std::atomic<bool> ReadDataQueueProcessingRequested;
+  std::atomic<bool> WriteDataQueueProcessingRequested;
 
   ProcessingTaskQueue* InternalTaskQueue;
   ModifiedQueue*       InternalModifiedQueue;
@@ -6,6 +6,9 @@
 #include "vtkMRMLAbstractLogic.h"
 #include "vtkSlicerBaseLogic.h"
 
+// STD includes
+#include <atomic>
+
 class VTK_SLICER_BASE_LOGIC_EXPORT vtkSlicerTask : public vtkObject
 {
 public:
@@ -48,6 +51,22 @@ public:
     return "Unknown";
   }
 
+  ///
+  /// Scheduling priority of the task. Queued tasks with higher priority
+  /// are started first, tasks with the same priority are started in
+  /// the order they were scheduled. Default is 0.
+  /// The priority must not be changed after the task is scheduled.
+  vtkSetMacro (Priority, int);
+  vtkGetMacro (Priority, int);
+
+  ///
+  /// Request cancellation of the task. A task that is canceled before it
+  /// is started is removed from the queue without being executed.
+  /// Task functions that run for a long time may check GetCanceled()
+  /// to stop early. Can be called from any thread.
+  void Cancel() { this->Canceled = true; };
+  bool GetCanceled() { return this->Canceled; };
+
 protected:
   vtkSlicerTask();
   ~vtkSlicerTask() override;
@@ -60,7 +79,8 @@ private:
   void *TaskClientData;
 
   int Type;
-
+  int Priority;
+  std::atomic<bool> Canceled;
 };
 #endif
 
@@ -95,5 +95,108 @@ def run(module, node=None, parameters=None, wait_for_completion=False, delete_te
     return node
 
 
+class CLIFuture:
+    """Future-like handle of a CLI module that is running in the background.
+
+    The CLI is executed in a worker thread, the application (including timers,
+    web server request handlers, and the GUI) remains responsive while it runs.
+
+    Example::
+
+      def onCompleted(future):
+          print("Completed:", future.node.GetStatusString())
+
+      future = slicer.cli.runAsync(slicer.modules.thresholdscalarvolume, parameters=params)
+      future.add_done_callback(onCompleted)
+    """
+
+    def __init__(self, node):
+        import slicer
+
+        self.node = node
+        self._doneCallbacks = []
+        self._observerTag = node.AddObserver(slicer.vtkMRMLCommandLineModuleNode.StatusModifiedEvent, self._onStatusModified)
+
+    def _onStatusModified(self, caller=None, event=None):
+        if not self.done():
+            return
+        if self._observerTag is not None:
+            self.node.RemoveObserver(self._observerTag)
+            self._observerTag = None
+        callbacks = self._doneCallbacks
+        self._doneCallbacks = []
+        for callback in callbacks:
+            callback(self)
+
+    def done(self):
+        """Returns True if execution of the CLI has been completed (successfully, with errors, or cancelled)."""
+        return not self.node.IsBusy() and self.node.GetStatus() != self.node.Idle
+
+    def cancelled(self):
+        return self.node.GetStatus() == self.node.Cancelled
+
+    def cancel(self):
+        """Request cancellation of the CLI execution. Returns False if the CLI has already been completed."""
+        if self.done():
+            return False
+        self.node.Cancel()
+        return True
+
+    def add_done_callback(self, callback):
+        """Add a function that is called with this future as argument when the CLI execution is completed.
+        The function is called immediately if execution is already completed.
+        """
+        if self.done():
+            callback(self)
+        else:
+            self._doneCallbacks.append(callback)
+
+    def result(self, timeout=None):
+        """Wait for the CLI execution to complete and return the CLI node.
+
+        Application events are processed while waiting, therefore the application remains responsive.
+
+        :param timeout: maximum time to wait, in seconds. Wait until completion if None.
+        :raises TimeoutError: if the CLI is not completed within the specified time.
+        :raises RuntimeError: if the CLI is completed with errors or cancelled.
+        """
+        import time
+        import qt
+        import slicer
+
+        startTime = time.time()
+        while not self.done():
+            if timeout is not None and time.time() - startTime > timeout:
+                raise TimeoutError(f"CLI {self.node.GetName()} did not complete within {timeout} seconds")
+            slicer.app.processEvents(qt.QEventLoop.AllEvents, 50)
+        # make sure done callbacks are called before the result is returned
+        self._onStatusModified()
+        if self.node.GetStatus() == self.node.CompletedWithErrors:
+            raise RuntimeError(f"CLI {self.node.GetName()} completed with errors: {self.node.GetErrorText()}")
+        if self.cancelled():
+            raise RuntimeError(f"CLI {self.node.GetName()} was cancelled")
+        return self.node
+
+
+def runAsync(module, node=None, parameters=None, delete_temporary_files=True, update_display=True):
+    """Run a CLI in the background and return a future-like handle (:py:class:`CLIFuture`)
+    that can be used for getting notified about completion or waiting for the results.
+    node: existing parameter node (None by default)
+    parameters: dictionary of parameters for cli (None by default)
+    delete_temporary_files: remove temp files created during execution (True by default)
+    update_display: show output nodes after completion
+    """
+    if node:
+        setNodeParameters(node, parameters)
+    else:
+        node = createNode(module, parameters)
+        if not node:
+            return None
+    run(module, node=node, wait_for_completion=False, delete_temporary_files=delete_temporary_files, update_display=update_display)
+    # Status is set to scheduled when the CLI is started and status changes of the worker thread
+    # are applied in the main thread, therefore completion cannot be missed by observing the node now.
+    return CLIFuture(node)
+
+
 def cancel(node):
     print("Not yet implemented")
@@ -686,6 +686,56 @@ def forceRenderAllViews():
         lm.plotWidget(viewIndex).plotView().repaint()
 
 
+def _getDisplayableManagerGroupsByViewName():
+    import slicer
+
+    lm = slicer.app.layoutManager()
+    groups = {}
+    for viewIndex in range(lm.threeDViewCount):
+        threeDView = lm.threeDWidget(viewIndex).threeDView()
+        groups[threeDView.mrmlViewNode().GetName()] = threeDView.displayableManagerGroup()
+    for sliceViewName in lm.sliceViewNames():
+        groups[sliceViewName] = lm.sliceWidget(sliceViewName).sliceView().displayableManagerGroup()
+    return groups
+
+
+def getInteractionLatencies(clear=False):
+    """Get interaction latency statistics of all slice and 3D views.
+
+    Interaction latency is the time from receiving a mouse or keyboard event in a view
+    until the end of rendering of the frame that reflects it.
+
+    :param clear: remove latency values after retrieving them, so that subsequent calls only
+      report interactions that happen after this call (e.g., for measuring each step of a benchmark).
+    :return: dictionary that contains a dictionary with ``count``, ``p50``, ``p95``, and ``p99``
+      latency values (in milliseconds) for each view name.
+
+    Example::
+
+      slicer.util.getInteractionLatencies(clear=True)
+      # ... perform interactions ...
+      for viewName, latency in slicer.util.getInteractionLatencies().items():
+          print(f"{viewName}: p95 = {latency['p95']:.1f} ms ({latency['count']} samples)")
+    """
+    latencies = {}
+    for viewName, group in _getDisplayableManagerGroupsByViewName().items():
+        latencies[viewName] = {
+            "count": group.GetNumberOfInteractionLatencies(),
+            "p50": group.GetInteractionLatencyPercentile(50.0),
+            "p95": group.GetInteractionLatencyPercentile(95.0),
+            "p99": group.GetInteractionLatencyPercentile(99.0),
+        }
+        if clear:
+            group.ClearInteractionLatencies()
+    return latencies
+
+
+def setInteractionLatencyOverlayVisible(visible):
+    """Show/hide interaction latency statistics in the lower-left corner of all slice and 3D views."""
+    for group in _getDisplayableManagerGroupsByViewName().values():
+        group.SetInteractionLatencyOverlayVisible(visible)
+
+
 #
 # IO
 #
@@ -1604,6 +1654,86 @@ def getFirstNodeByName(name, className=None):
     return scene.GetFirstNode(name, className, False, False)
 
 
+def getNodeMemoryUsage(groupBy="node", scene=None):
+    """Return memory size of data of nodes in the scene, in kilobytes.
+
+    :param groupBy: ``node`` (memory size of each node, keyed by node ID),
+      ``class`` (total memory size of nodes by node class name), or
+      ``module`` (total memory size of nodes by the title of the module that
+      is associated with the node class; nodes not associated with any module
+      are listed under ``Other``).
+    :return: dictionary of memory sizes in kilobytes, sorted by decreasing size.
+
+    Memory size of a node is computed by ``vtkMRMLNode.GetDataMemorySize()``, which does not
+    include memory that is shared with other nodes or memory that is not owned by the node
+    (such as display data cached by views).
+
+    Example::
+
+      for moduleName, memoryKB in slicer.util.getNodeMemoryUsage("module").items():
+          print(f"{moduleName}: {memoryKB / 1024:.1f} MB")
+    """
+    import slicer
+
+    if scene is None:
+        scene = slicer.mrmlScene
+    if groupBy not in ["node", "class", "module"]:
+        raise ValueError(f"Invalid groupBy value: {groupBy} (expected node, class, or module)")
+
+    moduleTitleByNodeClass = {}
+    if groupBy == "module":
+        moduleManager = slicer.app.moduleManager()
+        for moduleName in moduleManager.modulesNames():
+            module = moduleManager.module(moduleName)
+            if not module:
+                continue
+            for nodeClassName in module.associatedNodeTypes():
+                moduleTitleByNodeClass.setdefault(nodeClassName, module.title)
+
+    memoryUsage = {}
+    for nodeIndex in range(scene.GetNumberOfNodes()):
+        node = scene.GetNthNode(nodeIndex)
+        memorySize = node.GetDataMemorySize()
+        if groupBy == "node":
+            key = node.GetID()
+        elif groupBy == "class":
+            key = node.GetClassName()
+        else:
+            key = "Other"
+            for nodeClassName, moduleTitle in moduleTitleByNodeClass.items():
+                if node.IsA(nodeClassName):
+                    key = moduleTitle
+                    break
+        memoryUsage[key] = memoryUsage.get(key, 0) + memorySize
+    return dict(sorted(memoryUsage.items(), key=lambda item: item[1], reverse=True))
+
+
+def checkMemoryBudget(maximumMemorySizeMB, includeUndoStack=True, scene=None):
+    """Raise ``MemoryError`` if node data in the scene uses more memory than the specified budget.
+
+    This can be used in scripts and tests to detect unexpected memory usage growth.
+
+    :param maximumMemorySizeMB: memory budget in megabytes.
+    :param includeUndoStack: also count memory used by the undo stack of the scene.
+    :return: current memory size in megabytes.
+    :raises MemoryError: if memory size exceeds the budget.
+    """
+    import slicer
+
+    if scene is None:
+        scene = slicer.mrmlScene
+    memorySizeKB = scene.GetNodesDataMemorySize()
+    if includeUndoStack:
+        memorySizeKB += scene.GetUndoStackMemorySize()
+    memorySizeMB = memorySizeKB / 1024.0
+    if memorySizeMB > maximumMemorySizeMB:
+        largestNodes = list(getNodeMemoryUsage("node", scene).items())[:5]
+        details = ", ".join(f"{nodeID}: {memoryKB / 1024.0:.1f} MB" for nodeID, memoryKB in largestNodes)
+        raise MemoryError(f"Scene memory usage {memorySizeMB:.1f} MB exceeds budget of {maximumMemorySizeMB} MB"
+                          f" (largest nodes: {details})")
+    return memorySizeMB
+
+
 class NodeModify:
     """Context manager to conveniently compress mrml node modified event."""
 
@@ -1786,7 +1916,8 @@ def arrayFromModelPointsModified(modelNode):
     if modelNode.GetMesh():
         modelNode.GetMesh().GetPoints().GetData().Modified()
     # Trigger re-render
-    modelNode.GetDisplayNode().Modified()
+    if modelNode.GetDisplayNode():
+        modelNode.GetDisplayNode().Modified()
 
 
 def _vtkArrayFromModelData(modelNode, arrayName, location):
@@ -2086,9 +2217,8 @@ def arrayFromSegmentInternalBinaryLabelmap(segmentationNode, segmentId):
       segmentationNode->GetSegmentation()->CollapseBinaryLabelmaps()
 
     If binary labelmap is the source representation then voxel values in the volume node can be modified
-    by changing values in the numpy array. After all modifications has been completed, call::
-
-      segmentationNode.GetSegmentation().GetSegment(segmentID).Modified()
+    by changing values in the numpy array. After all modifications has been completed, call
+    :py:meth:`arrayFromSegmentInternalBinaryLabelmapModified`.
 
     .. warning:: Important: memory area of the returned array is managed by VTK,
       therefore values in the array may be changed, but the array must not be reallocated.
@@ -2102,6 +2232,56 @@ def arrayFromSegmentInternalBinaryLabelmap(segmentationNode, segmentId):
     return narray
 
 
+def arrayFromSegmentInternalBinaryLabelmapModified(segmentationNode, segmentId, modifiedRegion=None):
+    """Indicate that modification of a numpy array returned by :py:meth:`arrayFromSegmentInternalBinaryLabelmap` has been completed.
+
+    :param segmentationNode: segmentation node that contains the modified segment.
+    :param segmentId: ID of the segment whose array was modified.
+    :param modifiedRegion: region of the array that contains all the modified voxels, specified as a tuple of slices
+      or indices, in the same (KJI) axis order as the array is indexed. For example: ``numpy.s_[10:20, 35:60, :]``.
+      If specified then views and derived representations (such as closed surface) only update this region,
+      which is much faster than updating the entire segment when only a small region of a large labelmap is changed
+      (for example, in an interactive AI inference loop).
+      If not specified then the entire labelmap is considered modified.
+
+    All segments that are stored in the same labelmap layer (that share the same voxel array) are notified.
+    """
+    import slicer
+
+    vimage = segmentationNode.GetBinaryLabelmapInternalRepresentation(segmentId)
+    baseMTime = vimage.GetMTime()
+    vimage.GetPointData().GetScalars().Modified()
+
+    if modifiedRegion is not None:
+        if not isinstance(modifiedRegion, tuple):
+            modifiedRegion = (modifiedRegion,)
+        imageExtent = vimage.GetExtent()
+        arrayShape = tuple(reversed(vimage.GetDimensions()))
+        modifiedExtent = list(imageExtent)
+        for arrayAxis, axisRegion in enumerate(modifiedRegion):
+            # array axes are in KJI order, extent is in IJK order
+            imageAxis = 2 - arrayAxis
+            if isinstance(axisRegion, slice):
+                start, stop, step = axisRegion.indices(arrayShape[arrayAxis])
+                if step != 1:
+                    # only the bounding range of the slice matters
+                    start, stop = min(start, stop - step), max(start, stop - step) + 1
+            else:
+                start = int(axisRegion)
+                if start < 0:
+                    start += arrayShape[arrayAxis]
+                stop = start + 1
+            modifiedExtent[imageAxis * 2] = imageExtent[imageAxis * 2] + start
+            modifiedExtent[imageAxis * 2 + 1] = imageExtent[imageAxis * 2] + stop - 1
+        vimage.SetModifiedExtent(modifiedExtent, baseMTime)
+
+    segmentation = segmentationNode.GetSegmentation()
+    binaryLabelmapName = slicer.vtkSegmentationConverter.GetBinaryLabelmapRepresentationName()
+    layerIndex = segmentation.GetLayerIndex(segmentId, binaryLabelmapName)
+    for sharedSegmentId in segmentation.GetSegmentIDsForLayer(layerIndex, binaryLabelmapName):
+        segmentation.GetSegment(sharedSegmentId).Modified()
+
+
 def arrayFromSegmentBinaryLabelmap(segmentationNode, segmentId, referenceVolumeNode=None):
     """Return voxel array of a segment's binary labelmap representation as numpy array.
 
@@ -3132,6 +3312,40 @@ def displayPythonShell(display=True):
             console.setVisible(consoleVisible)
 
 
+@contextmanager
+def traceScope(name, category="Python"):
+    """Record the time spent in the code in the context manager as a trace event.
+
+    Events are only recorded if recording is enabled in ``slicer.vtkTraceRecorder``
+    (for example, in the Developer section of application settings).
+    Recorded events can be exported in Chrome trace event format, together with events
+    recorded in C++ using ``vtkTraceScopeMacro``.
+
+    :param name: name of the event.
+    :param category: category of the event, can be used for filtering events in the trace viewer.
+
+    .. code-block:: python
+
+      with slicer.util.traceScope("MyModule.process"):
+        logic.process(inputVolume, outputVolume)
+
+      recorder = slicer.vtkTraceRecorder.GetInstance()
+      recorder.WriteEventsAsChromeTrace("c:/tmp/trace.json")
+
+    """
+    import slicer
+
+    recorder = slicer.vtkTraceRecorder.GetInstance()
+    if not recorder.GetRecording():
+        yield
+        return
+    startTime = recorder.GetTime()
+    try:
+        yield
+    finally:
+        recorder.AddEventWithCopiedStrings(name, category, startTime, recorder.GetTime() - startTime)
+
+
 class WaitCursor:
     """Display a wait cursor while the code in the context manager is being run.
 
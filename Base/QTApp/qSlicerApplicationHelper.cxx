@@ -21,9 +21,11 @@
 #include "qSlicerApplicationHelper.h"
 
 // Qt includes
+#include <QDir>
 #include <QFont>
 #include <QLabel>
 #include <QSettings>
+#include <QStandardPaths>
 #include <QSysInfo>
 #include <QThread>
 #include <QTimer>
@@ -184,6 +186,9 @@ void qSlicerApplicationHelper::setupModuleFactoryManager(qSlicerModuleFactoryMan
 
     qSlicerCLIExecutableModuleFactory* cliExecutableFactory = new qSlicerCLIExecutableModuleFactory();
     cliExecutableFactory->setTempDirectory(tempDirectory);
+    // Store XML descriptions of CLI executables so that they do not have to be run at each startup
+    cliExecutableFactory->setXmlDescriptionCacheDirectory(
+      QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("CLIModuleDescriptions"));
     moduleFactoryManager->registerFactory(cliExecutableFactory, preferExecutableCLIs ? 1 : 0);
 
     if (!options->disableBuiltInModules() &&
@@ -163,7 +163,9 @@ int qSlicerApplicationHelper::postInitializeApplication(
 
   // Register and instantiate modules
   splashMessage(splashScreen, qSlicerApplication::tr("Registering modules..."));
+  app.beginStartupPhase("Register modules");
   moduleFactoryManager->registerModules();
+  app.endStartupPhase("Register modules");
   if (app.commandOptions()->verboseModuleDiscovery())
     {
     qDebug() << "Number of registered modules:"
@@ -176,7 +178,9 @@ int qSlicerApplicationHelper::postInitializeApplication(
   QMetaObject::Connection moduleAboutToBeInstantiatedConnection = QObject::connect(
     moduleFactoryManager, &qSlicerAbstractModuleFactoryManager::moduleAboutToBeInstantiated,
     [&splashScreen](QString moduleName){splashMessage(splashScreen, qSlicerApplication::tr("Instantiating module \"%1\"...").arg(moduleName));});
+  app.beginStartupPhase("Instantiate modules");
   moduleFactoryManager->instantiateModules();
+  app.endStartupPhase("Instantiate modules");
   QObject::disconnect(moduleAboutToBeInstantiatedConnection);
 
   if (app.commandOptions()->verboseModuleDiscovery())
@@ -206,7 +210,9 @@ int qSlicerApplicationHelper::postInitializeApplication(
   splashMessage(splashScreen, qSlicerApplication::tr("Initializing user interface..."));
   if (enableMainWindow)
     {
+    app.beginStartupPhase("Create main window");
     window.reset(new SlicerMainWindowType);
+    app.endStartupPhase("Create main window");
     }
   else if (app.commandOptions()->showPythonConsole()
     && !app.commandOptions()->runPythonAndExit())
@@ -222,13 +228,21 @@ int qSlicerApplicationHelper::postInitializeApplication(
 #endif
     }
 
-  // Load all available modules
+  // Load all available modules, except those that are loaded when they are first used
+  moduleManager->setLazyLoadedModuleNames(
+    app.revisionUserSettings()->value("Modules/LazyLoadModules").toStringList());
+  app.beginStartupPhase("Load modules");
   foreach(const QString& name, moduleFactoryManager->instantiatedModuleNames())
     {
     Q_ASSERT(!name.isNull());
+    if (moduleManager->lazyLoadedModuleNames().contains(name))
+      {
+      continue;
+      }
     splashMessage(splashScreen, qSlicerApplication::tr("Loading module \"%1\"...").arg(name));
     moduleFactoryManager->loadModule(name);
     }
+  app.endStartupPhase("Load modules");
   if (app.commandOptions()->verboseModuleDiscovery())
     {
     qDebug() << "Number of loaded modules:" << moduleManager->modulesNames().count();
@@ -236,6 +250,8 @@ int qSlicerApplicationHelper::postInitializeApplication(
 
   splashMessage(splashScreen, QString());
 
+  // Stop recording startup phases (and write them to file if requested) when startup is completed
+  QObject::connect(&app, &qSlicerApplication::startupCompleted, &app, &qSlicerCoreApplication::completeStartupProfile);
   if (window)
     {
     QObject::connect(window.data(), SIGNAL(initialWindowShown()), &app, SIGNAL(startupCompleted()));
@@ -19,8 +19,12 @@
 ==============================================================================*/
 
 // Qt includes
+#include <QCryptographicHash>
+#include <QDateTime>
 #include <QProcess>
+#include <QSaveFile>
 #include <QStandardPaths>
+#include <QThread>
 
 // Slicer includes
 #include "qSlicerCLIExecutableModuleFactory.h"
@@ -49,12 +53,24 @@ QString findPython()
 
 //-----------------------------------------------------------------------------
 qSlicerCLIExecutableModuleFactoryItem::qSlicerCLIExecutableModuleFactoryItem(
-  const QString& newTempDirectory)
+  const QString& newTempDirectory, qSlicerCLIExecutableModuleFactory* factory)
   : TempDirectory(newTempDirectory)
   , CLIModule(nullptr)
+  , Factory(factory)
+  , XmlDescriptionRetrieved(false)
 {
 }
 
+//-----------------------------------------------------------------------------
+qSlicerCLIExecutableModuleFactoryItem::~qSlicerCLIExecutableModuleFactoryItem()
+{
+  if (this->CLIWithXmlArgumentProcess && this->CLIWithXmlArgumentProcess->state() != QProcess::NotRunning)
+    {
+    this->CLIWithXmlArgumentProcess->kill();
+    this->CLIWithXmlArgumentProcess->waitForFinished();
+    }
+}
+
 //-----------------------------------------------------------------------------
 bool qSlicerCLIExecutableModuleFactoryItem::load()
 {
@@ -94,6 +110,12 @@ qSlicerAbstractCoreModule* qSlicerCLIExecutableModuleFactoryItem::instanciator()
       module->moduleDescription().SetTarget(this->path().toStdString());
     }
 
+  // Start retrieving XML description of the next CLI executables while this one is set up
+  if (this->Factory)
+    {
+    this->Factory->prefetchXmlDescriptions();
+    }
+
   QString xmlFilePath = this->xmlModuleDescriptionFilePath();
 
   //
@@ -114,10 +136,15 @@ qSlicerAbstractCoreModule* qSlicerCLIExecutableModuleFactoryItem::instanciator()
       this->appendInstantiateErrorString(qSlicerCLIModule::tr("Failed to read XML Description"));
       }
     }
-  else
+  else if (!this->readCachedXmlDescription(&xmlDescription))
     {
     xmlDescription = this->runCLIWithXmlArgument();
+    if (!xmlDescription.isEmpty())
+      {
+      this->writeCachedXmlDescription(xmlDescription);
+      }
     }
+  this->XmlDescriptionRetrieved = true;
   if (xmlDescription.isEmpty())
     {
     return nullptr;
@@ -135,17 +162,127 @@ qSlicerAbstractCoreModule* qSlicerCLIExecutableModuleFactoryItem::instanciator()
 }
 
 //-----------------------------------------------------------------------------
-QString qSlicerCLIExecutableModuleFactoryItem::runCLIWithXmlArgument()
+bool qSlicerCLIExecutableModuleFactoryItem::startCLIWithXmlArgument()
 {
-  ctkScopedCurrentDir scopedCurrentDir(QFileInfo(this->path()).path());
+  if (this->CLIWithXmlArgumentProcess || this->XmlDescriptionRetrieved
+    || QFile::exists(this->xmlModuleDescriptionFilePath())
+    || this->readCachedXmlDescription(nullptr))
+    {
+    // already started or not needed
+    return false;
+    }
+  this->CLIWithXmlArgumentProcess.reset(this->createCLIWithXmlArgumentProcess());
+  return true;
+}
 
-  int cliProcessTimeoutInMs = 5000;
-  QProcess cli;
+//-----------------------------------------------------------------------------
+QProcess* qSlicerCLIExecutableModuleFactoryItem::createCLIWithXmlArgumentProcess()
+{
+  QProcess* cli = new QProcess();
   QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
   env.insert("ITK_AUTOLOAD_PATH", "");
-  cli.setProcessEnvironment(env);
-  cli.start(this->path(), QStringList(QString("--xml")));
-  bool res = cli.waitForFinished(cliProcessTimeoutInMs);
+  cli->setProcessEnvironment(env);
+  cli->setWorkingDirectory(QFileInfo(this->path()).path());
+  cli->start(this->path(), QStringList(QString("--xml")));
+  return cli;
+}
+
+//-----------------------------------------------------------------------------
+bool qSlicerCLIExecutableModuleFactoryItem::isCLIWithXmlArgumentRunning()const
+{
+  return this->CLIWithXmlArgumentProcess
+    && this->CLIWithXmlArgumentProcess->state() != QProcess::NotRunning;
+}
+
+//-----------------------------------------------------------------------------
+QString qSlicerCLIExecutableModuleFactoryItem::xmlDescriptionCacheFilePath()const
+{
+  QString cacheDirectory = (this->Factory ? this->Factory->xmlDescriptionCacheDirectory() : QString());
+  if (cacheDirectory.isEmpty())
+    {
+    return QString();
+    }
+  QFileInfo info(this->path());
+  // Use a hash of the full path, as the same module name may be found in multiple folders
+  QString pathHash = QCryptographicHash::hash(info.absoluteFilePath().toUtf8(), QCryptographicHash::Md5).toHex();
+  return QDir(cacheDirectory).filePath(info.baseName() + "-" + pathHash + ".xml");
+}
+
+//-----------------------------------------------------------------------------
+QString qSlicerCLIExecutableModuleFactoryItem::xmlDescriptionCacheKey()const
+{
+  QFileInfo info(this->path());
+  return QString("%1 %2 %3").arg(info.absoluteFilePath()).arg(info.size())
+    .arg(info.lastModified().toMSecsSinceEpoch());
+}
+
+//-----------------------------------------------------------------------------
+bool qSlicerCLIExecutableModuleFactoryItem::readCachedXmlDescription(QString* xmlDescription)
+{
+  QString cacheFilePath = this->xmlDescriptionCacheFilePath();
+  if (cacheFilePath.isEmpty())
+    {
+    return false;
+    }
+  QFile cacheFile(cacheFilePath);
+  if (!cacheFile.open(QIODevice::ReadOnly))
+    {
+    return false;
+    }
+  // The first line identifies the executable, the XML description follows.
+  QTextStream cacheStream(&cacheFile);
+  cacheStream.setCodec("UTF-8");
+  if (cacheStream.readLine() != this->xmlDescriptionCacheKey())
+    {
+    return false;
+    }
+  if (xmlDescription)
+    {
+    *xmlDescription = cacheStream.readAll();
+    return !xmlDescription->isEmpty();
+    }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerCLIExecutableModuleFactoryItem::writeCachedXmlDescription(const QString& xmlDescription)
+{
+  QString cacheFilePath = this->xmlDescriptionCacheFilePath();
+  if (cacheFilePath.isEmpty())
+    {
+    return;
+    }
+  QDir().mkpath(QFileInfo(cacheFilePath).absolutePath());
+  QSaveFile cacheFile(cacheFilePath);
+  if (!cacheFile.open(QIODevice::WriteOnly))
+    {
+    this->appendInstantiateWarningString(qSlicerCLIModule::tr("Failed to write XML description cache file: %1").arg(cacheFilePath));
+    return;
+    }
+  QTextStream cacheStream(&cacheFile);
+  cacheStream.setCodec("UTF-8");
+  cacheStream << this->xmlDescriptionCacheKey() << "\n" << xmlDescription;
+  cacheStream.flush();
+  if (!cacheFile.commit())
+    {
+    this->appendInstantiateWarningString(qSlicerCLIModule::tr("Failed to write XML description cache file: %1").arg(cacheFilePath));
+    }
+}
+
+//-----------------------------------------------------------------------------
+QString qSlicerCLIExecutableModuleFactoryItem::runCLIWithXmlArgument()
+{
+  // Use the process that has been already started by prefetchXmlDescriptions()
+  QScopedPointer<QProcess> cliProcess(this->CLIWithXmlArgumentProcess.take());
+  if (!cliProcess)
+    {
+    cliProcess.reset(this->createCLIWithXmlArgumentProcess());
+    }
+  QProcess& cli = *cliProcess;
+
+  int cliProcessTimeoutInMs = 5000;
+  bool res = (cli.state() == QProcess::NotRunning && cli.error() == QProcess::UnknownError)
+    || cli.waitForFinished(cliProcessTimeoutInMs);
   if (!res)
     {
     this->appendInstantiateErrorString(qSlicerCLIModule::tr("CLI executable: %1").arg(this->path()));
@@ -235,6 +372,7 @@ public:
 
 private:
   QString TempDirectory;
+  QString XmlDescriptionCacheDirectory;
 };
 
 //-----------------------------------------------------------------------------
@@ -285,7 +423,7 @@ ctkAbstractFactoryItem<qSlicerAbstractCoreModule>* qSlicerCLIExecutableModuleFac
 ::createFactoryFileBasedItem()
 {
   Q_D(qSlicerCLIExecutableModuleFactory);
-  return new qSlicerCLIExecutableModuleFactoryItem(d->TempDirectory);
+  return new qSlicerCLIExecutableModuleFactoryItem(d->TempDirectory, this);
 }
 
 //-----------------------------------------------------------------------------
@@ -300,3 +438,53 @@ void qSlicerCLIExecutableModuleFactory::setTempDirectory(const QString& newTempD
   Q_D(qSlicerCLIExecutableModuleFactory);
   d->TempDirectory = newTempDirectory;
 }
+
+//-----------------------------------------------------------------------------
+void qSlicerCLIExecutableModuleFactory::setXmlDescriptionCacheDirectory(const QString& directory)
+{
+  Q_D(qSlicerCLIExecutableModuleFactory);
+  d->XmlDescriptionCacheDirectory = directory;
+}
+
+//-----------------------------------------------------------------------------
+QString qSlicerCLIExecutableModuleFactory::xmlDescriptionCacheDirectory()const
+{
+  Q_D(const qSlicerCLIExecutableModuleFactory);
+  return d->XmlDescriptionCacheDirectory;
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerCLIExecutableModuleFactory::prefetchXmlDescriptions(int maximumNumberOfProcesses)
+{
+  if (maximumNumberOfProcesses <= 0)
+    {
+    maximumNumberOfProcesses = qMax(QThread::idealThreadCount(), 1);
+    }
+  QList<qSlicerCLIExecutableModuleFactoryItem*> items;
+  int numberOfRunningProcesses = 0;
+  foreach(const QString& key, this->itemKeys())
+    {
+    qSlicerCLIExecutableModuleFactoryItem* item =
+      dynamic_cast<qSlicerCLIExecutableModuleFactoryItem*>(this->item(key));
+    if (!item)
+      {
+      continue;
+      }
+    if (item->isCLIWithXmlArgumentRunning())
+      {
+      numberOfRunningProcesses++;
+      }
+    items << item;
+    }
+  foreach(qSlicerCLIExecutableModuleFactoryItem* item, items)
+    {
+    if (numberOfRunningProcesses >= maximumNumberOfProcesses)
+      {
+      break;
+      }
+    if (item->startCLIWithXmlArgument())
+      {
+      numberOfRunningProcesses++;
+      }
+    }
+}
@@ -21,9 +21,14 @@
 #ifndef __qSlicerCLIExecutableModuleFactory_h
 #define __qSlicerCLIExecutableModuleFactory_h
 
+// Qt includes
+#include <QScopedPointer>
+class QProcess;
+
 // Slicer includes
 #include "qSlicerAbstractCoreModule.h"
 #include "qSlicerBaseQTCLIExport.h"
+class qSlicerCLIExecutableModuleFactory;
 class qSlicerCLIModule;
 
 // CTK includes
@@ -35,18 +40,48 @@ class qSlicerCLIExecutableModuleFactoryItem
   : public ctkAbstractFactoryFileBasedItem<qSlicerAbstractCoreModule>
 {
 public:
-  qSlicerCLIExecutableModuleFactoryItem(const QString& newTempDirectory);
+  qSlicerCLIExecutableModuleFactoryItem(const QString& newTempDirectory,
+    qSlicerCLIExecutableModuleFactory* factory = nullptr);
+  ~qSlicerCLIExecutableModuleFactoryItem() override;
   bool load() override;
   void uninstantiate() override;
+
+  /// Start the CLI executable with "--xml" argument in a background process
+  /// if the XML description is needed and it has not been retrieved or started yet.
+  /// Returns true if a new process was started.
+  bool startCLIWithXmlArgument();
+
+  /// Returns true if the CLI executable is running with "--xml" argument.
+  bool isCLIWithXmlArgumentRunning()const;
+
+  /// Get XML description from the cache directory of the factory.
+  /// Returns false if the description is not cached or the CLI executable has changed since
+  /// it was cached (a different file size or modification time). If \a xmlDescription is nullptr
+  /// then cache validity is checked but the description is not read.
+  /// \sa qSlicerCLIExecutableModuleFactory::setXmlDescriptionCacheDirectory
+  bool readCachedXmlDescription(QString* xmlDescription);
+
 protected:
   /// Return path of the expected XML file.
   QString xmlModuleDescriptionFilePath();
 
   qSlicerAbstractCoreModule* instanciator() override;
   QString runCLIWithXmlArgument();
+  /// Start the CLI executable with "--xml" argument. The caller owns the returned process.
+  QProcess* createCLIWithXmlArgumentProcess();
+
+  /// Path of the file that stores the cached XML description. Empty if caching is disabled.
+  QString xmlDescriptionCacheFilePath()const;
+  /// Identifies the version of the CLI executable that the cached XML description belongs to.
+  QString xmlDescriptionCacheKey()const;
+  void writeCachedXmlDescription(const QString& xmlDescription);
 private:
   QString TempDirectory;
   qSlicerCLIModule* CLIModule;
+  qSlicerCLIExecutableModuleFactory* Factory;
+  /// Process that retrieves the XML description, started by startCLIWithXmlArgument()
+  QScopedPointer<QProcess> CLIWithXmlArgumentProcess;
+  bool XmlDescriptionRetrieved;
 };
 
 class qSlicerCLIExecutableModuleFactoryPrivate;
@@ -71,6 +106,21 @@ public:
 
   void setTempDirectory(const QString& newTempDirectory);
 
+  /// Start retrieving XML description of registered CLI executables that
+  /// have no XML description file, in parallel background processes.
+  /// At most \a maximumNumberOfProcesses are running at the same time.
+  /// It is called each time a module is instantiated, so that the XML description
+  /// is already available when the next modules are instantiated.
+  /// If \a maximumNumberOfProcesses is 0 then the ideal thread count is used.
+  void prefetchXmlDescriptions(int maximumNumberOfProcesses = 0);
+
+  /// Set folder where XML descriptions retrieved by running CLI executables with "--xml"
+  /// are stored, so that unchanged executables do not need to be run again at next startup.
+  /// Cached descriptions are invalidated when the executable's size or modification time changes.
+  /// Caching is disabled if the directory is empty (default).
+  void setXmlDescriptionCacheDirectory(const QString& directory);
+  QString xmlDescriptionCacheDirectory()const;
+
 protected:
   bool isValidFile(const QFileInfo& file)const override;
 
@@ -376,6 +376,7 @@ void qSlicerCLIProgressBar::updateUiFromCommandLineModuleNode(
       d->ProgressBar->setMaximum(0);
       break;
     case vtkMRMLCommandLineModuleNode::Scheduled:
+    case vtkMRMLCommandLineModuleNode::Waiting:
       d->ProgressBar->setMaximum(0);
       break;
     case vtkMRMLCommandLineModuleNode::Running:
@@ -29,14 +29,18 @@
 #include <vtkMRMLStorageNode.h>
 #include <vtkMRMLModelStorageNode.h>
 #include <vtkMRMLTransformNode.h>
+#include <vtkMRMLVolumeNode.h>
 
 // VTK includes
 #include <vtkCallbackCommand.h>
+#include <vtkImageData.h>
 #include <vtkIntArray.h>
 #include <vtkMultiThreader.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
+#include <vtkPointSet.h>
 #include <vtkStringArray.h>
+#include <vtksys/SystemInformation.hxx>
 #include <vtksys/SystemTools.hxx>
 
 // ITKSYS includes
@@ -46,16 +50,32 @@
 
 // STL includes
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
 #include <ctime>
 #include <mutex>
+#include <memory>
 #include <random>
 #include <set>
+#include <thread>
 
 #ifdef _WIN32
 #else
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 #include <unistd.h>
+extern char** environ;
+#endif
+#if defined(__linux__)
+#include <sys/statvfs.h>
 #endif
 
 //----------------------------------------------------------------------------
@@ -72,6 +92,572 @@ struct DigitsToCharacters
     }
 };
 
+//----------------------------------------------------------------------------
+// Directory of a RAM backed file system shared by all the processes,
+// empty if there is none.
+std::string GetSharedMemoryDirectory()
+{
+#if defined(__linux__)
+  const char* directory = "/dev/shm";
+  if (vtksys::SystemTools::FileIsDirectory(directory) && access(directory, W_OK) == 0)
+    {
+    return directory;
+    }
+#endif
+  return std::string();
+}
+
+//----------------------------------------------------------------------------
+// Return true if \a size bytes can be written in the shared memory
+// \a directory while keeping at least half of it free for the outputs.
+bool HasSharedMemoryFor(const std::string& directory, unsigned long long size)
+{
+#if defined(__linux__)
+  struct statvfs stats;
+  if (statvfs(directory.c_str(), &stats) != 0)
+    {
+    return false;
+    }
+  unsigned long long total = static_cast<unsigned long long>(stats.f_blocks) * stats.f_frsize;
+  unsigned long long available = static_cast<unsigned long long>(stats.f_bavail) * stats.f_frsize;
+  return available > size && available - size > total / 2;
+#else
+  (void)directory;
+  (void)size;
+  return false;
+#endif
+}
+
+//----------------------------------------------------------------------------
+// Size in bytes of the data of a volume or model node, 0 for other nodes.
+unsigned long long GetDataExchangeSize(vtkMRMLNode* node)
+{
+  vtkMRMLVolumeNode* volumeNode = vtkMRMLVolumeNode::SafeDownCast(node);
+  if (volumeNode && volumeNode->GetImageData())
+    {
+    return 1024ull * volumeNode->GetImageData()->GetActualMemorySize();
+    }
+  vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(node);
+  if (modelNode && modelNode->GetMesh())
+    {
+    return 1024ull * modelNode->GetMesh()->GetActualMemorySize();
+    }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Size in bytes of the input volumes and models of a CLI execution.
+unsigned long long GetInputDataSize(vtkMRMLScene* scene, const ModuleDescription& description)
+{
+  unsigned long long size = 0;
+  for (const ModuleParameterGroup& group : description.GetParameterGroups())
+    {
+    for (const ModuleParameter& parameter : group.GetParameters())
+      {
+      if ((parameter.GetTag() == "image" || parameter.GetTag() == "geometry")
+          && parameter.GetChannel() == "input")
+        {
+        size += GetDataExchangeSize(scene->GetNodeByID(parameter.GetValue().c_str()));
+        }
+      }
+    }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+// Memory reserved by the running CLIs of all the CLI logics.
+class CLIMemoryReservations
+{
+public:
+  static CLIMemoryReservations& GetInstance()
+    {
+    static CLIMemoryReservations instance;
+    return instance;
+    }
+
+  /// Wait until \a size fits in the limit with the other reservations,
+  /// or until there is no other reservation.
+  /// \a waiting is called once if the reservation cannot be made immediately.
+  /// Returns false without reserving if \a canceled returns true while waiting.
+  template <typename WaitingFunction, typename CanceledFunction>
+  bool Reserve(unsigned long long size, WaitingFunction waiting, CanceledFunction canceled)
+    {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    bool isWaiting = false;
+    while (size > 0 && this->Limit > 0 && this->Reserved > 0 && this->Reserved + size > this->Limit)
+      {
+      if (!isWaiting)
+        {
+        isWaiting = true;
+        waiting();
+        }
+      // cancellation of the node is not notified, check it regularly
+      this->Released.wait_for(lock, std::chrono::milliseconds(200));
+      if (canceled())
+        {
+        return false;
+        }
+      }
+    this->Reserved += size;
+    return true;
+    }
+
+  void Release(unsigned long long size)
+    {
+      {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Reserved -= size;
+      }
+    this->Released.notify_all();
+    }
+
+  void SetLimit(unsigned long long limit)
+    {
+      {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Limit = limit;
+      }
+    this->Released.notify_all();
+    }
+
+  unsigned long long GetLimit()
+    {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->Limit;
+    }
+
+private:
+  CLIMemoryReservations()
+    {
+    vtksys::SystemInformation systemInformation;
+    systemInformation.RunMemoryCheck();
+    // total physical memory is in MiB
+    this->Limit = static_cast<unsigned long long>(systemInformation.GetTotalPhysicalMemory()) * 1024 * 1024 / 2;
+    }
+
+  std::mutex Mutex;
+  std::condition_variable Released;
+  unsigned long long Limit{0};
+  unsigned long long Reserved{0};
+};
+
+//----------------------------------------------------------------------------
+// Release the memory reserved for a CLI execution when it goes out of scope.
+struct CLIMemoryReservationGuard
+{
+  unsigned long long Size{0};
+  ~CLIMemoryReservationGuard()
+    {
+    if (this->Size > 0)
+      {
+      CLIMemoryReservations::GetInstance().Release(this->Size);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Update the process information from the last progress tags found in the
+// standard output of a CLI. Returns true if a tag was found.
+bool UpdateProcessInformationFromOutput(const std::string& stdoutbuffer,
+                                        ModuleProcessInformation* information)
+{
+  bool foundTag = false;
+  std::string::size_type tagend;
+  std::string::size_type tagstart;
+  // search for the last occurrence of </filter-progress>
+  tagend = stdoutbuffer.rfind("</filter-progress>");
+  if (tagend != std::string::npos)
+    {
+    tagstart = stdoutbuffer.rfind("<filter-progress>");
+    if (tagstart != std::string::npos)
+      {
+      std::string progressString(stdoutbuffer, tagstart+17,
+                                 tagend-tagstart-17);
+      information->Progress = atof(progressString.c_str());
+      foundTag = true;
+      }
+    }
+  // search for the last occurrence of </filter-stage-progress>
+  tagend = stdoutbuffer.rfind("</filter-stage-progress>");
+  if (tagend != std::string::npos)
+    {
+    tagstart = stdoutbuffer.rfind("<filter-stage-progress>");
+    if (tagstart != std::string::npos)
+      {
+      std::string progressString(stdoutbuffer, tagstart+23,
+                                 tagend-tagstart-23);
+      information->StageProgress = atof(progressString.c_str());
+      foundTag = true;
+      }
+    }
+
+  // search for the last occurrence of </filter-name>
+  tagend = stdoutbuffer.rfind("</filter-name>");
+  if (tagend != std::string::npos)
+    {
+    tagstart = stdoutbuffer.rfind("<filter-name>");
+    if (tagstart != std::string::npos)
+      {
+      std::string filterString(stdoutbuffer, tagstart+13,
+                               tagend-tagstart-13);
+      strncpy(information->ProgressMessage, filterString.c_str(), 1023);
+      foundTag = true;
+      }
+    }
+
+  // search for the last occurrence of </filter-comment>
+  tagend = stdoutbuffer.rfind("</filter-comment>");
+  if (tagend != std::string::npos)
+    {
+    tagstart = stdoutbuffer.rfind("<filter-comment>");
+    if (tagstart != std::string::npos)
+      {
+      std::string progressMessage(stdoutbuffer, tagstart+16,
+                                 tagend-tagstart-16);
+      strncpy (information->ProgressMessage, progressMessage.c_str(), 1023);
+      foundTag = true;
+      }
+    }
+  return foundTag;
+}
+
+#ifndef _WIN32
+//----------------------------------------------------------------------------
+// Executable CLI kept running between executions. The module wrapper runs in
+// worker mode when SLICER_CLI_WORKER=1: it reads the arguments of successive
+// executions on its standard input and reports the end of each of them on
+// its standard output.
+// \sa SEMCommandLineLibraryWrapper.cxx.in
+class CLIWorkerProcess
+{
+public:
+  ~CLIWorkerProcess()
+    {
+    this->Stop();
+    }
+
+  bool IsRunning() const
+    {
+    return this->Pid > 0;
+    }
+
+  const std::string& GetExecutable() const
+    {
+    return this->Executable;
+    }
+
+  /// Start the executable in worker mode and wait until it is ready.
+  bool Start(const std::string& executable)
+    {
+    this->Stop();
+    int input[2], output[2], error[2];
+    if (pipe(input) != 0)
+      {
+      return false;
+      }
+    if (pipe(output) != 0)
+      {
+      close(input[0]);
+      close(input[1]);
+      return false;
+      }
+    if (pipe(error) != 0)
+      {
+      close(input[0]);
+      close(input[1]);
+      close(output[0]);
+      close(output[1]);
+      return false;
+      }
+
+    // The environment is prepared before fork(), only async-signal-safe
+    // functions can be called in the child. ITK_AUTOLOAD_PATH is unset as for
+    // the other executions of executable CLIs.
+    std::vector<std::string> environment;
+    for (char** variable = environ; *variable; ++variable)
+      {
+      if (strncmp(*variable, "ITK_AUTOLOAD_PATH=", 18) != 0
+          && strncmp(*variable, "SLICER_CLI_WORKER=", 18) != 0)
+        {
+        environment.emplace_back(*variable);
+        }
+      }
+    environment.emplace_back("ITK_AUTOLOAD_PATH=");
+    environment.emplace_back("SLICER_CLI_WORKER=1");
+    std::vector<char*> envp;
+    for (std::string& variable : environment)
+      {
+      envp.push_back(&variable[0]);
+      }
+    envp.push_back(nullptr);
+    std::string program = executable;
+    char* argv[] = { &program[0], nullptr };
+
+    // other child processes must not inherit the ends used by this process
+    fcntl(input[1], F_SETFD, FD_CLOEXEC);
+    fcntl(output[0], F_SETFD, FD_CLOEXEC);
+    fcntl(error[0], F_SETFD, FD_CLOEXEC);
+
+    pid_t pid = fork();
+    if (pid == 0)
+      {
+      dup2(input[0], STDIN_FILENO);
+      dup2(output[1], STDOUT_FILENO);
+      dup2(error[1], STDERR_FILENO);
+      close(input[0]);
+      close(input[1]);
+      close(output[0]);
+      close(output[1]);
+      close(error[0]);
+      close(error[1]);
+      execve(program.c_str(), argv, envp.data());
+      _exit(127);
+      }
+    close(input[0]);
+    close(output[1]);
+    close(error[1]);
+    if (pid < 0)
+      {
+      close(input[1]);
+      close(output[0]);
+      close(error[0]);
+      return false;
+      }
+    this->Pid = pid;
+    this->Input = input[1];
+    this->Output = output[0];
+    this->Error = error[0];
+    this->Executable = executable;
+    this->OutputBuffer.clear();
+
+    // Executables that are not built with the module wrapper do not
+    // support the worker mode.
+    const std::string ready = "<slicer-cli-worker-ready/>";
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (this->OutputBuffer.find(ready) == std::string::npos
+           && std::chrono::steady_clock::now() < deadline)
+      {
+      if (!this->ReadAvailableData(0.1))
+        {
+        break;
+        }
+      }
+    std::string::size_type readyPosition = this->OutputBuffer.find(ready);
+    if (readyPosition == std::string::npos)
+      {
+      this->Stop();
+      return false;
+      }
+    this->OutputBuffer.erase(0, this->OutputBuffer.find('\n', readyPosition) + 1);
+    this->ErrorBuffer.clear();
+    return true;
+    }
+
+  /// Close the input of the worker so that it exits, kill it if it does not.
+  void Stop()
+    {
+    if (this->Input >= 0)
+      {
+      close(this->Input);
+      this->Input = -1;
+      }
+    if (this->Pid > 0)
+      {
+      int status = 0;
+      int i = 0;
+      while (waitpid(this->Pid, &status, WNOHANG) == 0)
+        {
+        if (++i > 20)
+          {
+          kill(this->Pid, SIGKILL);
+          waitpid(this->Pid, &status, 0);
+          break;
+          }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+      this->Pid = -1;
+      }
+    if (this->Output >= 0)
+      {
+      close(this->Output);
+      this->Output = -1;
+      }
+    if (this->Error >= 0)
+      {
+      close(this->Error);
+      this->Error = -1;
+      }
+    }
+
+  /// Can be called from any thread to abort the current execution.
+  void Kill()
+    {
+    pid_t pid = this->Pid;
+    if (pid > 0)
+      {
+      kill(pid, SIGKILL);
+      }
+    }
+
+  /// Send the arguments of an execution to the worker.
+  bool Send(const std::vector<std::string>& arguments)
+    {
+    std::ostringstream message;
+    message << arguments.size() << "\n";
+    for (const std::string& argument : arguments)
+      {
+      message << argument.size() << "\n" << argument;
+      }
+    std::string data = message.str();
+
+    // Writing to a worker that exited must not terminate the application
+    // with SIGPIPE.
+    sigset_t pipeSignal, previousMask;
+    sigemptyset(&pipeSignal);
+    sigaddset(&pipeSignal, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipeSignal, &previousMask);
+    bool success = true;
+    ::size_t written = 0;
+    while (written < data.size())
+      {
+      ssize_t count = write(this->Input, data.data() + written, data.size() - written);
+      if (count < 0 && errno == EINTR)
+        {
+        continue;
+        }
+      if (count <= 0)
+        {
+        success = false;
+        break;
+        }
+      written += count;
+      }
+    sigset_t pending;
+    sigpending(&pending);
+    if (!success && sigismember(&pending, SIGPIPE))
+      {
+      int signal = 0;
+      sigwait(&pipeSignal, &signal);
+      }
+    pthread_sigmask(SIG_SETMASK, &previousMask, nullptr);
+    return success;
+    }
+
+  /// Wait at most \a timeout seconds for output of the current execution.
+  /// Output data is appended to \a outputData and \a errorData.
+  /// \a exited is set to true and \a returnValue is set when the execution
+  /// is completed. Returns false if the worker is no longer running.
+  bool WaitForData(double timeout, std::string& outputData, std::string& errorData,
+                   bool& exited, int& returnValue)
+    {
+    bool running = this->ReadAvailableData(timeout);
+    const std::string exitStart = "<slicer-cli-worker-exit>";
+    const std::string exitEnd = "</slicer-cli-worker-exit>";
+    std::string::size_type exitStartPosition = this->OutputBuffer.find(exitStart);
+    std::string::size_type exitEndPosition = this->OutputBuffer.find(exitEnd);
+    exited = (exitStartPosition != std::string::npos && exitEndPosition != std::string::npos);
+    if (exited)
+      {
+      // the error output of the execution is already in the pipe
+      while (this->ReadAvailableData(0.0, true))
+        {
+        }
+      returnValue = atoi(this->OutputBuffer.substr(exitStartPosition + exitStart.size(),
+        exitEndPosition - exitStartPosition - exitStart.size()).c_str());
+      // remove the new line that precedes the tag
+      std::string::size_type outputEnd = exitStartPosition;
+      if (outputEnd > 0 && this->OutputBuffer[outputEnd - 1] == '\n')
+        {
+        --outputEnd;
+        }
+      outputData.append(this->OutputBuffer, 0, outputEnd);
+      this->OutputBuffer.erase(0, this->OutputBuffer.find('\n', exitEndPosition) + 1);
+      }
+    else
+      {
+      // keep the end of the output in case it is the beginning of the exit tag
+      ::size_t keep = std::min(this->OutputBuffer.size(), exitStart.size());
+      outputData.append(this->OutputBuffer, 0, this->OutputBuffer.size() - keep);
+      this->OutputBuffer.erase(0, this->OutputBuffer.size() - keep);
+      }
+    errorData.append(this->ErrorBuffer);
+    this->ErrorBuffer.clear();
+    if (!running && !exited)
+      {
+      outputData.append(this->OutputBuffer);
+      this->OutputBuffer.clear();
+      this->Stop();
+      }
+    return running || exited;
+    }
+
+private:
+  /// Read the data available on the output and error pipes within \a timeout
+  /// seconds. Returns false if the worker closed its output.
+  /// If \a errorOnly is true, return false when there is no more error data.
+  bool ReadAvailableData(double timeout, bool errorOnly = false)
+    {
+    if (this->Output < 0 || this->Error < 0)
+      {
+      return false;
+      }
+    struct pollfd fds[2];
+    fds[0].fd = this->Output;
+    fds[0].events = errorOnly ? 0 : POLLIN;
+    fds[1].fd = this->Error;
+    fds[1].events = POLLIN;
+    int ready = poll(fds, 2, static_cast<int>(timeout * 1000));
+    if (ready < 0)
+      {
+      return errno == EINTR;
+      }
+    if (ready == 0)
+      {
+      return !errorOnly;
+      }
+    char buffer[4096];
+    bool open = true;
+    if (fds[1].revents & (POLLIN | POLLHUP))
+      {
+      ssize_t count = read(this->Error, buffer, sizeof(buffer));
+      if (count > 0)
+        {
+        this->ErrorBuffer.append(buffer, count);
+        }
+      else if (errorOnly)
+        {
+        return false;
+        }
+      }
+    else if (errorOnly)
+      {
+      return false;
+      }
+    if (fds[0].revents & (POLLIN | POLLHUP))
+      {
+      ssize_t count = read(this->Output, buffer, sizeof(buffer));
+      if (count > 0)
+        {
+        this->OutputBuffer.append(buffer, count);
+        }
+      else
+        {
+        open = false;
+        }
+      }
+    return open;
+    }
+
+  std::atomic<pid_t> Pid{-1};
+  int Input{-1};
+  int Output{-1};
+  int Error{-1};
+  std::string Executable;
+  std::string OutputBuffer;
+  std::string ErrorBuffer;
+};
+#endif
+
 typedef std::pair<vtkSlicerCLIModuleLogic *, vtkMRMLCommandLineModuleNode *> LogicNodePair;
 class MRMLIDMap : public std::map<std::string, std::string> {};
 
@@ -192,6 +778,9 @@ public:
   ModuleDescription DefaultModuleDescription;
   int DeleteTemporaryFiles;
   int AllowInMemoryTransfer;
+  int AllowSharedMemoryTransfer;
+  std::string SharedMemoryDirectory;
+  double MemoryEstimateFactor;
 
   int RedirectModuleStreams;
 
@@ -200,6 +789,13 @@ public:
   std::mutex ProcessesKillLock;
   std::vector<itksysProcess*> Processes;
 
+  int UseWorkerProcess;
+#ifndef _WIN32
+  std::mutex WorkerProcessLock;
+  std::unique_ptr<CLIWorkerProcess> WorkerProcess;
+  std::set<std::string> UnsupportedWorkerExecutables;
+#endif
+
   typedef std::vector<std::pair<vtkMTimeType, vtkMRMLCommandLineModuleNode*> > RequestType;
   struct FindRequest
   {
@@ -305,6 +901,10 @@ vtkSlicerCLIModuleLogic::vtkSlicerCLIModuleLogic()
 
   this->Internal->DeleteTemporaryFiles = 1;
   this->Internal->AllowInMemoryTransfer = 1;
+  this->Internal->AllowSharedMemoryTransfer = 1;
+  this->Internal->SharedMemoryDirectory = GetSharedMemoryDirectory();
+  this->Internal->MemoryEstimateFactor = 3.0;
+  this->Internal->UseWorkerProcess = 0;
   this->Internal->RedirectModuleStreams = 1;
   this->Internal->RescheduleCallback =
     vtkSmartPointer<vtkSlicerCLIRescheduleCallback>::New();
@@ -408,6 +1008,71 @@ int vtkSlicerCLIModuleLogic::GetAllowInMemoryTransfer() const
   return this->Internal->AllowInMemoryTransfer;
 }
 
+//----------------------------------------------------------------------------
+void vtkSlicerCLIModuleLogic::SetAllowSharedMemoryTransfer(int value)
+{
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting AllowSharedMemoryTransfer to " << value);
+  if (this->Internal->AllowSharedMemoryTransfer != value)
+    {
+    this->Internal->AllowSharedMemoryTransfer = value;
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkSlicerCLIModuleLogic::GetAllowSharedMemoryTransfer() const
+{
+  return this->Internal->AllowSharedMemoryTransfer;
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerCLIModuleLogic::SetUseWorkerProcess(int value)
+{
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting UseWorkerProcess to " << value);
+  if (this->Internal->UseWorkerProcess != value)
+    {
+    this->Internal->UseWorkerProcess = value;
+#ifndef _WIN32
+    if (!value)
+      {
+      std::lock_guard<std::mutex> lock(this->Internal->WorkerProcessLock);
+      std::lock_guard<std::mutex> killLock(this->Internal->ProcessesKillLock);
+      this->Internal->WorkerProcess.reset();
+      }
+#endif
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkSlicerCLIModuleLogic::GetUseWorkerProcess() const
+{
+  return this->Internal->UseWorkerProcess;
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerCLIModuleLogic::SetMemoryEstimateFactor(double factor)
+{
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting MemoryEstimateFactor to " << factor);
+  this->Internal->MemoryEstimateFactor = std::max(0.0, factor);
+}
+
+//----------------------------------------------------------------------------
+double vtkSlicerCLIModuleLogic::GetMemoryEstimateFactor() const
+{
+  return this->Internal->MemoryEstimateFactor;
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerCLIModuleLogic::SetRunningModulesMemoryLimit(unsigned long long limit)
+{
+  CLIMemoryReservations::GetInstance().SetLimit(limit);
+}
+
+//----------------------------------------------------------------------------
+unsigned long long vtkSlicerCLIModuleLogic::GetRunningModulesMemoryLimit()
+{
+  return CLIMemoryReservations::GetInstance().GetLimit();
+}
+
 //----------------------------------------------------------------------------
 void vtkSlicerCLIModuleLogic::RedirectModuleStreamsOn()
 {
@@ -522,6 +1187,12 @@ vtkSlicerCLIModuleLogic
   // process, then this encoding will need to be changed to be unique
   // per module execution.
   //
+  // 4. If the consumer of the file is an executable and a RAM backed
+  // file system is shared by the processes (/dev/shm on Linux), the
+  // real temporary file is created there instead of the Temporary
+  // directory, as long as it leaves enough shared memory for the outputs.
+  // The executable reads and writes it with its usual readers and writers.
+  //
 
   // Encode process id into a string.  To avoid confusing the
   // Archetype reader, convert the numbers in pid to characters [0-9]->[A-J]
@@ -546,6 +1217,16 @@ vtkSlicerCLIModuleLogic
     {
     temporaryDirectory = appLogic->GetTemporaryPath();
     }
+  if (commandType == CommandLineModule
+      && this->GetAllowSharedMemoryTransfer() != 0
+      && !this->Internal->SharedMemoryDirectory.empty())
+    {
+    vtkMRMLNode* node = this->GetMRMLScene() ? this->GetMRMLScene()->GetNodeByID(name) : nullptr;
+    if (HasSharedMemoryFor(this->Internal->SharedMemoryDirectory, GetDataExchangeSize(node)))
+      {
+      temporaryDirectory = this->Internal->SharedMemoryDirectory;
+      }
+    }
   fname = temporaryDirectory + "/" + pid + "_" + fname;
 
   if (tag == "image")
@@ -691,9 +1372,154 @@ void vtkSlicerCLIModuleLogic::KillProcesses()
     itksysProcess* process = *it;
     itksysProcess_Kill(process);
     }
+#ifndef _WIN32
+  if (this->Internal->WorkerProcess)
+    {
+    this->Internal->WorkerProcess->Kill();
+    }
+#endif
   this->Internal->ProcessesKillLock.unlock();
 }
 
+//-----------------------------------------------------------------------------
+bool vtkSlicerCLIModuleLogic::RunInWorkerProcess(vtkMRMLCommandLineModuleNode* node0,
+                                                 const std::vector<std::string>& commandLine)
+{
+#ifdef _WIN32
+  (void)node0;
+  (void)commandLine;
+  return false;
+#else
+  // Executions that run at the same time use their own process.
+  std::unique_lock<std::mutex> lock(this->Internal->WorkerProcessLock, std::try_to_lock);
+  if (!lock.owns_lock() || commandLine.empty())
+    {
+    return false;
+    }
+  const std::string& executable = commandLine[0];
+  if (this->Internal->UnsupportedWorkerExecutables.count(executable))
+    {
+    return false;
+    }
+  if (!this->Internal->WorkerProcess
+      || !this->Internal->WorkerProcess->IsRunning()
+      || this->Internal->WorkerProcess->GetExecutable() != executable)
+    {
+    std::unique_ptr<CLIWorkerProcess> worker(new CLIWorkerProcess);
+    if (!worker->Start(executable))
+      {
+      vtkWarningMacro(<< node0->GetModuleDescription().GetTitle()
+                      << ": worker mode is not supported by " << executable);
+      this->Internal->UnsupportedWorkerExecutables.insert(executable);
+      return false;
+      }
+    std::lock_guard<std::mutex> killLock(this->Internal->ProcessesKillLock);
+    this->Internal->WorkerProcess = std::move(worker);
+    }
+  CLIWorkerProcess* worker = this->Internal->WorkerProcess.get();
+  if (!worker->Send(commandLine))
+    {
+    std::lock_guard<std::mutex> killLock(this->Internal->ProcessesKillLock);
+    this->Internal->WorkerProcess.reset();
+    return false;
+    }
+
+  ModuleProcessInformation* information = node0->GetModuleDescription().GetProcessInformation();
+  const double timeout = 0.1;    // tenth of a second
+  std::string stdoutbuffer;
+  std::string stdoutbufferWithoutProgressInfo; // stdout, with progress information removed
+  std::string stderrbuffer;
+  bool exited = false;
+  bool running = true;
+  int returnValue = EXIT_FAILURE;
+  while (!exited)
+    {
+    std::string stdoutNewContent;
+    std::string::size_type stderrSize = stderrbuffer.size();
+    auto start = std::chrono::steady_clock::now();
+    running = worker->WaitForData(timeout, stdoutNewContent, stderrbuffer, exited, returnValue);
+    bool enableUpdateOutputDuringExecution = node0->IsContinuousOutputUpdate();
+    information->ElapsedTime += std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+    this->GetApplicationLogic()->RequestModified( node0 );
+
+    // Check to see if the plugin was cancelled
+    if (information->Abort)
+      {
+      std::lock_guard<std::mutex> killLock(this->Internal->ProcessesKillLock);
+      worker->Kill();
+      this->Internal->WorkerProcess.reset();
+      information->Progress = 0;
+      information->StageProgress = 0;
+      this->GetApplicationLogic()->RequestModified( node0 );
+      break;
+      }
+    if (!stdoutNewContent.empty())
+      {
+      stdoutbuffer.append(stdoutNewContent);
+      bool foundTag = UpdateProcessInformationFromOutput(stdoutbuffer, information);
+      if (enableUpdateOutputDuringExecution)
+        {
+        vtkSlicerCLIModuleLogic::RemoveProgressInfoFromProcessOutput(stdoutNewContent);
+        stdoutbufferWithoutProgressInfo.append(stdoutNewContent);
+        node0->SetOutputText(stdoutbufferWithoutProgressInfo, false);
+        }
+      if (foundTag || enableUpdateOutputDuringExecution)
+        {
+        this->GetApplicationLogic()->RequestModified( node0 );
+        }
+      }
+    if (stderrbuffer.size() != stderrSize && enableUpdateOutputDuringExecution)
+      {
+      node0->SetErrorText(stderrbuffer, false);
+      this->GetApplicationLogic()->RequestModified(node0);
+      }
+    if (!running)
+      {
+      break;
+      }
+    }
+
+  vtkSlicerCLIModuleLogic::RemoveProgressInfoFromProcessOutput(stdoutbuffer);
+  if (stdoutbuffer.size() > 0)
+    {
+    vtkInfoMacro(<< node0->GetModuleDescription().GetTitle() << " standard output:\n\n" << stdoutbuffer);
+    }
+  node0->SetOutputText(stdoutbuffer, false);
+
+  if (stderrbuffer.size() > 0)
+    {
+    vtkErrorMacro(<< node0->GetModuleDescription().GetTitle() << " standard error:\n\n" << stderrbuffer);
+    }
+  node0->SetErrorText(stderrbuffer, false);
+
+  // check the exit state / error state of the execution
+  if (node0->GetStatus() == vtkMRMLCommandLineModuleNode::Cancelling)
+    {
+    node0->SetStatus(vtkMRMLCommandLineModuleNode::Cancelled, false);
+    this->GetApplicationLogic()->RequestModified(node0);
+    }
+  else if (!exited)
+    {
+    // the worker is started again by the next execution
+    vtkErrorMacro(<< node0->GetModuleDescription().GetTitle() << " worker process terminated");
+    node0->SetStatus(vtkMRMLCommandLineModuleNode::CompletedWithErrors, false);
+    this->GetApplicationLogic()->RequestModified( node0 );
+    }
+  else if (returnValue == 0)
+    {
+    vtkInfoMacro(<< node0->GetModuleDescription().GetTitle() << " completed without errors");
+    }
+  else
+    {
+    vtkErrorMacro(<< node0->GetModuleDescription().GetTitle() << " completed with errors");
+    node0->SetStatus(vtkMRMLCommandLineModuleNode::CompletedWithErrors, false);
+    this->GetApplicationLogic()->RequestModified( node0 );
+    }
+  return true;
+#endif
+}
+
 //-----------------------------------------------------------------------------
 void vtkSlicerCLIModuleLogic::Apply ( vtkMRMLCommandLineModuleNode* node, bool updateDisplay )
 {
@@ -701,6 +1527,7 @@ void vtkSlicerCLIModuleLogic::Apply ( vtkMRMLCommandLineModuleNode* node, bool u
 
   vtkNew<vtkSlicerTask> task;
   task->SetTypeToProcessing();
+  task->SetPriority(node->GetPriority());
 
   // Pass the current node as client data to the task.  This allows
   // the user to switch to another parameter set after the task is
@@ -844,6 +1671,29 @@ void vtkSlicerCLIModuleLogic::ApplyTask(void *clientdata)
     return;
     }
 
+  // Reserve the memory estimated for this execution, wait for other CLIs
+  // to complete if it exceeds the limit. It is released when the task returns.
+  CLIMemoryReservationGuard memoryReservation;
+  unsigned long long memoryEstimate = static_cast<unsigned long long>(this->GetMemoryEstimateFactor()
+    * GetInputDataSize(this->GetMRMLScene(), node0->GetModuleDescription()));
+  bool reserved = CLIMemoryReservations::GetInstance().Reserve(memoryEstimate,
+    [this, node0]()
+      {
+      node0->SetStatus(vtkMRMLCommandLineModuleNode::Waiting, false);
+      this->GetApplicationLogic()->RequestModified( node0 );
+      },
+    [node0]()
+      {
+      return node0->GetStatus() == vtkMRMLCommandLineModuleNode::Cancelling;
+      });
+  if (!reserved)
+    {
+    node0->SetStatus(vtkMRMLCommandLineModuleNode::Cancelled, false);
+    this->GetApplicationLogic()->RequestModified( node0 );
+    return;
+    }
+  memoryReservation.Size = memoryEstimate;
+
   // Set the callback for progress.  This will only be used for the
   // scope of this function.
   LogicNodePair lnp( this, node0 );
@@ -1736,7 +2586,15 @@ void vtkSlicerCLIModuleLogic::ApplyTask(void *clientdata)
   node0->SetErrorText("", false);
   node0->SetStatus(vtkMRMLCommandLineModuleNode::Running, false);
   this->GetApplicationLogic()->RequestModified( node0 );
-  if (commandType == CommandLineModule)
+  if (commandType == CommandLineModule
+      && this->GetUseWorkerProcess() != 0
+      && (node0->GetModuleDescription().GetLocation().empty()
+          || node0->GetModuleDescription().GetLocation() == node0->GetModuleDescription().GetTarget())
+      && this->RunInWorkerProcess(node0, commandLineAsString))
+    {
+    // Ran in the worker process of the module
+    }
+  else if (commandType == CommandLineModule)
     {
     // Run as a command line module
     //
@@ -1795,8 +2653,6 @@ void vtkSlicerCLIModuleLogic::ApplyTask(void *clientdata)
     std::string stdoutbuffer;
     std::string stdoutbufferWithoutProgressInfo; // stdout, with progress information removed
     std::string stderrbuffer;
-    std::string::size_type tagend;
-    std::string::size_type tagstart;
     while ((pipe = itksysProcess_WaitForData(process ,&tbuffer,
                                              &length, &timeout)) != 0)
       {
@@ -1830,61 +2686,8 @@ void vtkSlicerCLIModuleLogic::ApplyTask(void *clientdata)
           std::string stdoutNewContent(tbuffer, length);
           stdoutbuffer.append(stdoutNewContent);
 
-          bool foundTag = false;
-          // search for the last occurrence of </filter-progress>
-          tagend = stdoutbuffer.rfind("</filter-progress>");
-          if (tagend != std::string::npos)
-            {
-            tagstart = stdoutbuffer.rfind("<filter-progress>");
-            if (tagstart != std::string::npos)
-              {
-              std::string progressString(stdoutbuffer, tagstart+17,
-                                         tagend-tagstart-17);
-              node0->GetModuleDescription().GetProcessInformation()->Progress = atof(progressString.c_str());
-              foundTag = true;
-              }
-            }
-          // search for the last occurrence of </filter-stage-progress>
-          tagend = stdoutbuffer.rfind("</filter-stage-progress>");
-          if (tagend != std::string::npos)
-            {
-            tagstart = stdoutbuffer.rfind("<filter-stage-progress>");
-            if (tagstart != std::string::npos)
-              {
-              std::string progressString(stdoutbuffer, tagstart+23,
-                                         tagend-tagstart-23);
-              node0->GetModuleDescription().GetProcessInformation()->StageProgress = atof(progressString.c_str());
-              foundTag = true;
-              }
-            }
-
-          // search for the last occurrence of </filter-name>
-          tagend = stdoutbuffer.rfind("</filter-name>");
-          if (tagend != std::string::npos)
-            {
-            tagstart = stdoutbuffer.rfind("<filter-name>");
-            if (tagstart != std::string::npos)
-              {
-              std::string filterString(stdoutbuffer, tagstart+13,
-                                       tagend-tagstart-13);
-              strncpy(node0->GetModuleDescription().GetProcessInformation()->ProgressMessage, filterString.c_str(), 1023);
-              foundTag = true;
-              }
-            }
-
-          // search for the last occurrence of </filter-comment>
-          tagend = stdoutbuffer.rfind("</filter-comment>");
-          if (tagend != std::string::npos)
-            {
-            tagstart = stdoutbuffer.rfind("<filter-comment>");
-            if (tagstart != std::string::npos)
-              {
-              std::string progressMessage(stdoutbuffer, tagstart+16,
-                                         tagend-tagstart-16);
-              strncpy (node0->GetModuleDescription().GetProcessInformation()->ProgressMessage, progressMessage.c_str(), 1023);
-              foundTag = true;
-              }
-            }
+          bool foundTag = UpdateProcessInformationFromOutput(stdoutbuffer,
+            node0->GetModuleDescription().GetProcessInformation());
           if (enableUpdateOutputDuringExecution)
             {
             vtkSlicerCLIModuleLogic::RemoveProgressInfoFromProcessOutput(stdoutNewContent);
@@ -28,6 +28,7 @@ class MRMLIDMap;
 
 // STL includes
 #include <string>
+#include <vector>
 
 #include "qSlicerBaseQTCLIExport.h"
 
@@ -96,6 +97,42 @@ public:
   void SetAllowInMemoryTransfer(int value);
   int GetAllowInMemoryTransfer() const;
 
+  /// Control the exchange of data files with command line executables
+  /// through a RAM backed file system shared by the processes (/dev/shm on
+  /// Linux) instead of the temporary directory, when it has enough free space.
+  /// Enabled by default.
+  void SetAllowSharedMemoryTransfer(int value);
+  int GetAllowSharedMemoryTransfer() const;
+
+  /// The memory needed by an execution of this CLI is estimated as the size
+  /// of its input volumes and models multiplied by this factor. 3 by default.
+  /// \sa SetRunningModulesMemoryLimit()
+  void SetMemoryEstimateFactor(double factor);
+  double GetMemoryEstimateFactor() const;
+
+  /// Maximum memory (in bytes) estimated to be used by the CLIs that run at
+  /// the same time, for all the CLI modules. The executions that would exceed
+  /// it wait (in vtkMRMLCommandLineModuleNode::Waiting state) for running CLIs
+  /// to complete. An execution that exceeds the limit alone still runs when no
+  /// other CLI is running. 0 disables the limit.
+  /// Default is half of the physical memory.
+  /// The number of CLIs that run at the same time is also limited by
+  /// vtkSlicerApplicationLogic::SetNumberOfProcessingThreads().
+  /// \sa SetMemoryEstimateFactor(), vtkMRMLCommandLineModuleNode::SetPriority()
+  static void SetRunningModulesMemoryLimit(unsigned long long limit);
+  static unsigned long long GetRunningModulesMemoryLimit();
+
+  /// Run the executable of this CLI in a worker process that is kept running
+  /// between executions, to avoid the startup time (loading of the libraries
+  /// and registration of the ITK factories) of each execution. Executions that
+  /// start while the worker is busy, and executables that are not built with
+  /// the module wrapper, run in their own process.
+  /// The worker is only supported on Linux and macOS. Disabled by default
+  /// because not all the CLIs support to be executed several times in the
+  /// same process.
+  void SetUseWorkerProcess(int value);
+  int GetUseWorkerProcess() const;
+
   /// For debugging, control redirection of cout and cerr
   virtual void RedirectModuleStreamsOn();
   virtual void RedirectModuleStreamsOff();
@@ -151,6 +188,12 @@ protected:
   // The method that runs the command line module
   void ApplyTask(void *clientdata);
 
+  /// Run an execution of an executable CLI in the worker process.
+  /// Returns false if the execution must run in its own process instead.
+  /// \sa SetUseWorkerProcess()
+  bool RunInWorkerProcess(vtkMRMLCommandLineModuleNode* node,
+                          const std::vector<std::string>& commandLine);
+
   // Communicate progress back to the node
   static void ProgressCallback(void *);
 
@@ -19,6 +19,9 @@
 ==============================================================================*/
 // Qt includes
 #include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSignalSpy>
 #include <QStringList>
 
 // Qt Core includes
@@ -26,11 +29,91 @@
 #include "qSlicerCoreIOManager.h"
 
 // MRML includes
+#include "vtkMRMLModelNode.h"
+#include "vtkMRMLScalarVolumeNode.h"
 #include "vtkMRMLScene.h"
+#include "vtkMRMLSegmentationNode.h"
 #include "vtkMRMLStorableNode.h"
 
 #include "vtkMRMLCoreTestingMacros.h"
 
+// VTK includes
+#include <vtkCylinderSource.h>
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkOrientedImageData.h>
+#include <vtkPointData.h>
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+bool IsAutoSaved(const QDir& autoSaveDir, vtkMRMLNode* node)
+{
+  return autoSaveDir.entryList(QStringList() << QString("%1_*").arg(node->GetID()), QDir::Files).size() == 1;
+}
+
+//-----------------------------------------------------------------------------
+int TestAutoSave(qSlicerCoreApplication& app, qSlicerCoreIOManager& manager)
+{
+  app.mrmlScene()->Clear(true);
+  QDir autoSaveDir(QDir(app.temporaryPath()).filePath("qSlicerCoreIOManagerTest1AutoSave"));
+  autoSaveDir.removeRecursively();
+  manager.setAutoSaveDirectory(autoSaveDir.absolutePath());
+
+  // Models are written in the background thread
+  vtkNew<vtkCylinderSource> cylinderSource;
+  cylinderSource->Update();
+  vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(
+    app.mrmlScene()->AddNewNodeByClass("vtkMRMLModelNode", "Model"));
+  CHECK_NOT_NULL(modelNode);
+  modelNode->SetAndObservePolyData(cylinderSource->GetOutput());
+
+  // Scalar volume storage nodes cannot write in a background thread,
+  // the volume is written in NRRD format in the background thread instead
+  vtkNew<vtkImageData> imageData;
+  imageData->SetDimensions(8, 8, 8);
+  imageData->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  imageData->GetPointData()->GetScalars()->Fill(1);
+  vtkMRMLScalarVolumeNode* volumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(
+    app.mrmlScene()->AddNewNodeByClass("vtkMRMLScalarVolumeNode", "Volume"));
+  CHECK_NOT_NULL(volumeNode);
+  volumeNode->SetAndObserveImageData(imageData);
+
+  // Segmentations are written in the background thread from a copy with collapsed labelmap layers
+  vtkNew<vtkOrientedImageData> labelmap;
+  labelmap->SetDimensions(8, 8, 8);
+  labelmap->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  labelmap->GetPointData()->GetScalars()->Fill(1);
+  vtkMRMLSegmentationNode* segmentationNode = vtkMRMLSegmentationNode::SafeDownCast(
+    app.mrmlScene()->AddNewNodeByClass("vtkMRMLSegmentationNode", "Segmentation"));
+  CHECK_NOT_NULL(segmentationNode);
+  CHECK_BOOL(segmentationNode->AddSegmentFromBinaryLabelmapRepresentation(labelmap, "Segment").empty(), false);
+
+  QSignalSpy autoSaveFinishedSpy(&manager, SIGNAL(autoSaveFinished(bool)));
+  CHECK_BOOL(manager.autoSave(), true);
+  CHECK_BOOL(manager.isAutoSaveInProgress(), true);
+  CHECK_BOOL(autoSaveFinishedSpy.wait(10000), true);
+  CHECK_BOOL(manager.isAutoSaveInProgress(), false);
+  CHECK_INT(autoSaveFinishedSpy.count(), 1);
+  CHECK_BOOL(autoSaveFinishedSpy.at(0).at(0).toBool(), true);
+  CHECK_BOOL(IsAutoSaved(autoSaveDir, modelNode), true);
+  CHECK_BOOL(IsAutoSaved(autoSaveDir, volumeNode), true);
+  CHECK_BOOL(QFileInfo::exists(autoSaveDir.filePath(QString("%1_Volume.nrrd").arg(volumeNode->GetID()))), true);
+  CHECK_BOOL(IsAutoSaved(autoSaveDir, segmentationNode), true);
+
+  // Nodes that have not changed since the last automatic save are not written again
+  CHECK_BOOL(manager.autoSave(), true);
+  CHECK_BOOL(manager.isAutoSaveInProgress(), false);
+  CHECK_INT(autoSaveFinishedSpy.count(), 2);
+
+  autoSaveDir.removeRecursively();
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
 int qSlicerCoreIOManagerTest1(int argc, char * argv [])
 {
   // make the core application so that the manager can be instantiated
@@ -105,5 +188,7 @@ int qSlicerCoreIOManagerTest1(int argc, char * argv [])
     qDebug() << "Found extension " << ext << " from file " << testFileNames[i] << " using " << storageNodeClassNames[i];
     }
 
+  CHECK_EXIT_SUCCESS(TestAutoSave(app, manager));
+
   return EXIT_SUCCESS;
 }
@@ -311,6 +311,25 @@ vtkMRMLAbstractLogic* qSlicerAbstractCoreModule::logic()
   return d->Logic;
 }
 
+//-----------------------------------------------------------------------------
+vtkMRMLAbstractLogic* qSlicerAbstractCoreModule::createLogicForScene(vtkMRMLScene* scene, vtkSlicerApplicationLogic* appLogic)
+{
+  vtkMRMLAbstractLogic* logic = this->createLogic();
+  if (!logic)
+    {
+    return nullptr;
+    }
+  vtkSlicerModuleLogic* moduleLogic = vtkSlicerModuleLogic::SafeDownCast(logic);
+  if (moduleLogic)
+    {
+    moduleLogic->SetMRMLApplicationLogic(appLogic);
+    moduleLogic->SetModuleShareDirectory(vtkSlicerApplicationLogic::GetModuleShareDirectory(
+                                     this->name().toStdString(), this->path().toStdString()));
+    }
+  logic->SetMRMLScene(scene);
+  return logic;
+}
+
 //-----------------------------------------------------------------------------
 void qSlicerAbstractCoreModule::representationDeleted(qSlicerAbstractModuleRepresentation *representation)
 {
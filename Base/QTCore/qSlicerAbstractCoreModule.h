@@ -284,6 +284,16 @@ public:
   /// A module logic is typically a vtkSlicerModuleLogic but not necessarily.
   Q_INVOKABLE vtkMRMLAbstractLogic* logic();
 
+  /// Create a new instance of the module logic that operates on the specified scene,
+  /// independently from the module logic returned by logic().
+  /// The application logic of the new logic is set to \a appLogic, which allows
+  /// the logic to access logics of other modules that operate on the same scene.
+  /// Initialization that the module performs in setup() is not applied to the new logic.
+  /// Returns nullptr if the module has no logic.
+  /// \note The caller is responsible for deleting the returned logic.
+  /// \sa qSlicerModuleManager::createLogicsForScene()
+  vtkMRMLAbstractLogic* createLogicForScene(vtkMRMLScene* scene, vtkSlicerApplicationLogic* appLogic);
+
   /// Return a pointer on the MRML scene
   Q_INVOKABLE vtkMRMLScene* mrmlScene() const;
 
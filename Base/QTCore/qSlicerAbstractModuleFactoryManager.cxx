@@ -20,6 +20,7 @@
 
 // Qt includes
 #include <QDir>
+#include <QElapsedTimer>
 
 // Slicer includes
 #include "qSlicerCoreApplication.h"
@@ -401,12 +402,28 @@ qSlicerAbstractCoreModule* qSlicerAbstractModuleFactoryManager
     qCritical() << "Fail to instantiate module " << moduleName << " (not registered)";
     return nullptr;
     }
+  QElapsedTimer timer;
+  timer.start();
+  QString startupPhaseName = QString("Instantiate module %1").arg(moduleName);
+  qSlicerCoreApplication* app = qSlicerCoreApplication::application();
+  if (app)
+    {
+    app->beginStartupPhase(startupPhaseName);
+    }
   qSlicerAbstractCoreModule* module = factory->instantiate(moduleName);
+  if (app)
+    {
+    app->endStartupPhase(startupPhaseName);
+    }
   if (!module)
     {
     qCritical() << "Fail to instantiate module " << moduleName;
     return nullptr;
     }
+  if (d->Verbose)
+    {
+    qDebug() << "Instantiated module" << moduleName << "in" << timer.elapsed() << "ms";
+    }
   module->setName(moduleName);
   module->setObjectName(QString("%1Module").arg(moduleName));
   foreach(const QString& associatedNodeType, module->associatedNodeTypes())
@@ -24,6 +24,10 @@
 // Qt includes
 #include <QDebug>
 #include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QLocale>
 #include <QMessageBox>
 #include <QTimer>
@@ -204,6 +208,7 @@ qSlicerCoreApplicationPrivate::qSlicerCoreApplicationPrivate(
   qSlicerCoreCommandOptions * coreCommandOptions,
   qSlicerCoreIOManager * coreIOManager) : q_ptr(&object)
 {
+  this->StartupTimer.start();
   qRegisterMetaType<qSlicerCoreApplication::ReturnCode>("qSlicerCoreApplication::ReturnCode");
   this->DefaultSettings = nullptr;
   this->UserSettings = nullptr;
@@ -284,7 +289,11 @@ void qSlicerCoreApplicationPrivate::init()
     qDebug() << "qSlicerCoreApplication must be given the True argc/argv";
     }
 
+  q->beginStartupPhase("Core application initialization");
+
+  q->beginStartupPhase("Parse arguments");
   this->parseArguments();
+  q->endStartupPhase("Parse arguments");
 
   this->SlicerHome = this->discoverSlicerHomeDirectory();
 
@@ -303,6 +312,7 @@ void qSlicerCoreApplicationPrivate::init()
 
   q->setEnvironmentVariable("SLICER_HOME", this->SlicerHome);
 
+  q->beginStartupPhase("Read launcher settings");
   ctkAppLauncherSettings appLauncherSettings;
   appLauncherSettings.setLauncherName(q->applicationName());
   appLauncherSettings.setLauncherDir(this->SlicerHome);
@@ -335,6 +345,7 @@ void qSlicerCoreApplicationPrivate::init()
       }
     q->setEnvironmentVariable(key, value);
     }
+  q->endStartupPhase("Read launcher settings");
 
 #ifdef Slicer_USE_PYTHONQT_WITH_OPENSSL
   if (!QSslSocket::supportsSsl())
@@ -352,6 +363,7 @@ void qSlicerCoreApplicationPrivate::init()
   q->setEnvironmentVariable("SLICER_SHARE_DIR", Slicer_SHARE_DIR);
 
   // Load default settings if any.
+  q->beginStartupPhase("Load settings");
   if (q->defaultSettings())
     {
     foreach(const QString& key, q->defaultSettings()->allKeys())
@@ -366,6 +378,7 @@ void qSlicerCoreApplicationPrivate::init()
         }
       }
     }
+  q->endStartupPhase("Load settings");
 
   // Create the application Logic object,
   this->AppLogic = vtkSmartPointer<vtkSlicerApplicationLogic>::New();
@@ -438,13 +451,19 @@ void qSlicerCoreApplicationPrivate::init()
   // in MRMLApplicationLogic.
   //this->AppLogic->ProcessMRMLEvents(scene, vtkCommand::ModifiedEvent, nullptr);
   //this->AppLogic->SetAndObserveMRMLScene(scene);
+  // Each remote transfer uses its own copy of the URI handler (and
+  // vtkHTTPHandler initializes curl once), so transfers can run concurrently.
+  // \sa vtkDataIOManager::SetMaximumNumberOfConcurrentTransfers()
+  this->AppLogic->SetNumberOfNetworkingThreads(4);
   this->AppLogic->CreateProcessingThread();
 
   // Set up Slicer to use the system proxy
   QNetworkProxyFactory::setUseSystemConfiguration(true);
 
   // Set up Data IO
+  q->beginStartupPhase("Data IO initialization");
   this->initDataIO();
+  q->endStartupPhase("Data IO initialization");
 
   // Create MRML scene
   vtkMRMLScene* scene = vtkMRMLScene::New();
@@ -471,16 +490,28 @@ void qSlicerCoreApplicationPrivate::init()
     {
     if (q->corePythonManager())
       {
-      q->corePythonManager()->mainContext(); // Initialize python
-      q->corePythonManager()->setSystemExitExceptionHandlerEnabled(true);
       q->connect(q->corePythonManager(), SIGNAL(systemExitExceptionRaised(int)),
                  q, SLOT(terminate(int)));
+      if (q->coreCommandOptions()->isPythonInitializationDeferred())
+        {
+        // Python is initialized when it is first used (for example, by a scripted module)
+        q->connect(q->corePythonManager(), SIGNAL(pythonInitialized()),
+                   q, SLOT(onPythonInitialized()));
+        }
+      else
+        {
+        q->beginStartupPhase("Python initialization");
+        q->corePythonManager()->mainContext(); // Initialize python
+        q->endStartupPhase("Python initialization");
+        q->onPythonInitialized();
+        }
       }
     }
 #endif
 
 #ifdef Slicer_BUILD_EXTENSIONMANAGER_SUPPORT
 
+  q->beginStartupPhase("Extensions manager initialization");
   qSlicerExtensionsManagerModel * model = new qSlicerExtensionsManagerModel(q);
   model->setExtensionsSettingsFilePath(q->slicerRevisionUserSettingsFilePath());
   model->setSlicerRequirements(q->revision(), q->os(), q->arch());
@@ -561,6 +592,7 @@ void qSlicerCoreApplicationPrivate::init()
   // if the scene is loaded with some of the extensions not present.
   QString extensionList = model->installedExtensions().join(";");
   scene->SetExtensions(extensionList.toStdString().c_str());
+  q->endStartupPhase("Extensions manager initialization");
 
 #endif
 
@@ -594,6 +626,8 @@ void qSlicerCoreApplicationPrivate::init()
     }
 
   q->connect(q, SIGNAL(aboutToQuit()), q, SLOT(onAboutToQuit()));
+
+  q->endStartupPhase("Core application initialization");
 }
 
 //-----------------------------------------------------------------------------
@@ -1637,6 +1671,18 @@ void qSlicerCoreApplication::setExtensionsInstallPath(const QString& path)
 //-----------------------------------------------------------------------------
 #ifdef Slicer_USE_PYTHONQT
 
+//-----------------------------------------------------------------------------
+void qSlicerCoreApplication::callWhenPythonInitialized(const std::function<void()>& function)
+{
+  Q_D(qSlicerCoreApplication);
+  if (d->PythonInitialized)
+    {
+    function();
+    return;
+    }
+  d->PythonInitializedCallbacks.append(function);
+}
+
 //-----------------------------------------------------------------------------
 void qSlicerCoreApplication::setCorePythonManager(qSlicerCorePythonManager* manager)
 {
@@ -2026,6 +2072,27 @@ void qSlicerCoreApplication
     }
 }
 
+//-----------------------------------------------------------------------------
+void qSlicerCoreApplication::onPythonInitialized()
+{
+#ifdef Slicer_USE_PYTHONQT
+  Q_D(qSlicerCoreApplication);
+  if (d->PythonInitialized || !this->corePythonManager())
+    {
+    return;
+    }
+  d->PythonInitialized = true;
+  this->corePythonManager()->setSystemExitExceptionHandlerEnabled(true);
+  // Callbacks may add new callbacks, which are then called immediately
+  QList<std::function<void()>> callbacks = d->PythonInitializedCallbacks;
+  d->PythonInitializedCallbacks.clear();
+  foreach(const std::function<void()>& callback, callbacks)
+    {
+    callback();
+    }
+#endif
+}
+
 //-----------------------------------------------------------------------------
 void qSlicerCoreApplication::processAppLogicModified()
 {
@@ -2391,6 +2458,108 @@ bool qSlicerCoreApplication::loadFiles(const QStringList& filePaths, vtkMRMLMess
   return success;
 }
 
+//-----------------------------------------------------------------------------
+void qSlicerCoreApplication::beginStartupPhase(const QString& name)
+{
+  Q_D(qSlicerCoreApplication);
+  if (!d->StartupProfiling)
+    {
+    return;
+    }
+  qSlicerCoreApplicationPrivate::StartupPhase phase;
+  phase.Name = name;
+  phase.StartTime = d->StartupTimer.nsecsElapsed() / 1000;
+  d->StartupPhases.append(phase);
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerCoreApplication::endStartupPhase(const QString& name)
+{
+  Q_D(qSlicerCoreApplication);
+  if (!d->StartupProfiling)
+    {
+    return;
+    }
+  for (int phaseIndex = d->StartupPhases.size() - 1; phaseIndex >= 0; --phaseIndex)
+    {
+    qSlicerCoreApplicationPrivate::StartupPhase& phase = d->StartupPhases[phaseIndex];
+    if (phase.Duration < 0 && phase.Name == name)
+      {
+      phase.Duration = d->StartupTimer.nsecsElapsed() / 1000 - phase.StartTime;
+      return;
+      }
+    }
+  qWarning() << Q_FUNC_INFO << "failed: startup phase" << name << "has not been started";
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerCoreApplication::completeStartupProfile()
+{
+  Q_D(qSlicerCoreApplication);
+  if (!d->StartupProfiling)
+    {
+    return;
+    }
+  // Record the total startup time as an ended phase
+  qSlicerCoreApplicationPrivate::StartupPhase startupPhase;
+  startupPhase.Name = "Startup";
+  startupPhase.Duration = d->StartupTimer.nsecsElapsed() / 1000;
+  d->StartupPhases.prepend(startupPhase);
+  d->StartupProfiling = false;
+
+  QString startupProfileFilePath = this->coreCommandOptions() ? this->coreCommandOptions()->startupProfileFilePath() : QString();
+  if (!startupProfileFilePath.isEmpty())
+    {
+    this->saveStartupProfile(startupProfileFilePath);
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool qSlicerCoreApplication::saveStartupProfile(const QString& filePath) const
+{
+  Q_D(const qSlicerCoreApplication);
+  QList<qSlicerCoreApplicationPrivate::StartupPhase> phases = d->StartupPhases;
+  if (d->StartupProfiling)
+    {
+    // Startup is not completed yet, report the total time until now
+    qSlicerCoreApplicationPrivate::StartupPhase startupPhase;
+    startupPhase.Name = "Startup";
+    startupPhase.Duration = d->StartupTimer.nsecsElapsed() / 1000;
+    phases.prepend(startupPhase);
+    }
+
+  QJsonArray traceEvents;
+  foreach(const qSlicerCoreApplicationPrivate::StartupPhase& phase, phases)
+    {
+    if (phase.Duration < 0)
+      {
+      // not ended
+      continue;
+      }
+    QJsonObject event;
+    event["name"] = phase.Name;
+    event["cat"] = QString("startup");
+    event["ph"] = QString("X");
+    event["ts"] = phase.StartTime;
+    event["dur"] = phase.Duration;
+    event["pid"] = QCoreApplication::applicationPid();
+    event["tid"] = 0;
+    traceEvents.append(event);
+    }
+  QJsonObject profile;
+  profile["traceEvents"] = traceEvents;
+  profile["displayTimeUnit"] = QString("ms");
+
+  QFile file(filePath);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+    qWarning() << Q_FUNC_INFO << "failed: cannot write startup profile to file" << filePath;
+    return false;
+    }
+  file.write(QJsonDocument(profile).toJson(QJsonDocument::Indented));
+  return true;
+}
+
 //------------------------------------------------------------------------------
 void qSlicerCoreApplication::openUrl(const QString& url)
 {
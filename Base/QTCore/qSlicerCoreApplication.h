@@ -28,6 +28,9 @@
 #include <QStringList>
 #include <QVariant>
 
+// STD includes
+#include <functional>
+
 // CTK includes
 #include <ctkVTKObject.h>
 
@@ -352,6 +355,14 @@ public:
   /// (either it is part of the main window or a top-level window).
   void setPythonConsole(ctkPythonConsole* pythonConsole);
 
+  /// \brief Call the function when the python interpreter is initialized.
+  ///
+  /// If python is already initialized then the function is called immediately.
+  /// Otherwise (for example, initialization is deferred by `--defer-python-initialization`)
+  /// the function is called after python is initialized, when it is first used.
+  /// \sa qSlicerCoreCommandOptions::isPythonInitializationDeferred()
+  void callWhenPythonInitialized(const std::function<void()>& function);
+
 #endif
 
 #ifdef Slicer_BUILD_EXTENSIONMANAGER_SUPPORT
@@ -573,6 +584,33 @@ public:
   /// Leaves other paths unchanged.
   Q_INVOKABLE QStringList toSlicerHomeRelativePaths(const QStringList& path) const;
 
+  /// \brief Record the start of a startup phase.
+  ///
+  /// Phases may be nested. Timings are measured from the creation of the application object.
+  /// Call endStartupPhase() with the same name when the phase is completed.
+  /// Phases are only recorded until completeStartupProfile() is called.
+  /// \sa endStartupPhase(), completeStartupProfile()
+  void beginStartupPhase(const QString& name);
+  /// Record the end of the most recently started, not yet ended startup phase of the given name.
+  /// \sa beginStartupPhase()
+  void endStartupPhase(const QString& name);
+
+  /// \brief Stop recording startup phases.
+  ///
+  /// If a file path was specified by the `--startup-profile` command-line argument
+  /// then the recorded phases are written to that file.
+  /// Called when application startup is completed.
+  /// \sa saveStartupProfile(), qSlicerCoreCommandOptions::startupProfileFilePath()
+  void completeStartupProfile();
+
+  /// \brief Write recorded startup phases to a file in Chrome trace event JSON format.
+  ///
+  /// Each ended phase is written as a complete ("X") event, nesting of the phases can be
+  /// seen from the event times. A "Startup" event spans from the creation of the application
+  /// object to the completion of the startup (or the current time if startup is not completed yet).
+  /// \return Returns true on success.
+  Q_INVOKABLE bool saveStartupProfile(const QString& filePath) const;
+
 public slots:
 
   /// Restart the application with the arguments passed at startup time
@@ -625,6 +663,9 @@ protected slots:
 
   virtual void onSlicerApplicationLogicModified();
   virtual void onUserInformationModified();
+  /// Finalize setup of python after the interpreter is initialized.
+  /// \sa callWhenPythonInitialized()
+  void onPythonInitialized();
   void onSlicerApplicationLogicRequest(vtkObject*, void* , unsigned long);
   void processAppLogicModified();
   void processAppLogicReadData();
@@ -33,6 +33,7 @@
 //
 
 // Qt includes
+#include <QElapsedTimer>
 #include <QPointer>
 #include <QProcessEnvironment>
 #include <QSettings>
@@ -178,6 +179,9 @@ public:
   /// CorePythonManager - It should exist only one instance of the CorePythonManager
   QSharedPointer<qSlicerCorePythonManager>    CorePythonManager;
   QPointer<ctkPythonConsole> PythonConsole; // it may be owned by a widget, so we cannot refer to it by a strong pointer
+  /// Functions to call when python is initialized
+  QList<std::function<void()>> PythonInitializedCallbacks;
+  bool PythonInitialized{false};
 #endif
 
 #ifdef Slicer_BUILD_EXTENSIONMANAGER_SUPPORT
@@ -193,6 +197,19 @@ public:
   QLocale                                     ApplicationLocale;
   QString                                     ApplicationLocaleName;
 
+  /// Startup profiling
+  struct StartupPhase
+    {
+    QString Name;
+    /// Start time and duration in microseconds, measured from StartupTimer start.
+    /// Duration is -1 if the phase has not ended yet.
+    qint64 StartTime{0};
+    qint64 Duration{-1};
+    };
+  QElapsedTimer StartupTimer;
+  QList<StartupPhase> StartupPhases;
+  bool StartupProfiling{true};
+
 #ifdef Slicer_BUILD_DICOM_SUPPORT
   /// Application-wide database instance
   QSharedPointer<ctkDICOMDatabase>            DICOMDatabase;
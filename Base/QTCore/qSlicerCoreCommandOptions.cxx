@@ -340,6 +340,13 @@ bool qSlicerCoreCommandOptions::verbose()const
   return !this->runPythonAndExit();
 }
 
+//-----------------------------------------------------------------------------
+QString qSlicerCoreCommandOptions::startupProfileFilePath() const
+{
+  Q_D(const qSlicerCoreCommandOptions);
+  return QDir::fromNativeSeparators(d->ParsedArgs.value("startup-profile").toString());
+}
+
 //-----------------------------------------------------------------------------
 bool qSlicerCoreCommandOptions::disableMessageHandlers() const
 {
@@ -387,6 +394,13 @@ bool qSlicerCoreCommandOptions::isPythonDisabled() const
   Q_D(const qSlicerCoreCommandOptions);
   return d->ParsedArgs.value("disable-python").toBool();
 }
+
+//-----------------------------------------------------------------------------
+bool qSlicerCoreCommandOptions::isPythonInitializationDeferred() const
+{
+  Q_D(const qSlicerCoreCommandOptions);
+  return d->ParsedArgs.value("defer-python-initialization").toBool();
+}
 #endif
 
 //-----------------------------------------------------------------------------
@@ -412,6 +426,10 @@ void qSlicerCoreCommandOptions::addArguments()
   this->addArgument("disable-python", "", QVariant::Bool,
                     /*no tr*/"Disable python support. This is equivalent to build the application with Slicer_USE_PYTHONQT=OFF.");
 
+  this->addArgument("defer-python-initialization", "", QVariant::Bool,
+                    /*no tr*/"Initialize python only when it is first used (by a scripted module, python code, or the python console). "
+                    "Reduces startup time and memory usage when only C++ modules are used, for example in batch processing.");
+
   this->addArgument("python-script", "", QVariant::String,
                     /*no tr*/"Python script to execute after slicer loads.");
 
@@ -483,6 +501,10 @@ void qSlicerCoreCommandOptions::addArguments()
   this->addArgument("verbose-module-discovery", "", QVariant::Bool,
                     /*no tr*/"Enable verbose output during module discovery process.");
 
+  this->addArgument("startup-profile", "", QVariant::String,
+                    /*no tr*/"Write timing of startup phases (including setup of each module) to the specified file "
+                    "in Chrome trace event JSON format. The file can be viewed in chrome://tracing or Perfetto.");
+
   this->addArgument("disable-settings", "", QVariant::Bool,
                     /*no tr*/"Start application ignoring user settings and using new temporary settings.");
 
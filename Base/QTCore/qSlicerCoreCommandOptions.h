@@ -54,10 +54,12 @@ class Q_SLICER_BASE_QTCORE_EXPORT qSlicerCoreCommandOptions : public ctkCommandL
   Q_PROPERTY(bool displayTemporaryPathAndExit READ displayTemporaryPathAndExit CONSTANT)
   Q_PROPERTY(bool displayMessageAndExit READ displayMessageAndExit STORED false CONSTANT)
   Q_PROPERTY(bool verboseModuleDiscovery READ verboseModuleDiscovery CONSTANT)
+  Q_PROPERTY(QString startupProfileFilePath READ startupProfileFilePath CONSTANT)
   Q_PROPERTY(bool disableMessageHandlers READ disableMessageHandlers CONSTANT)
   Q_PROPERTY(bool testingEnabled READ isTestingEnabled CONSTANT)
 #ifdef Slicer_USE_PYTHONQT
   Q_PROPERTY(bool pythonDisabled READ isPythonDisabled CONSTANT)
+  Q_PROPERTY(bool pythonInitializationDeferred READ isPythonInitializationDeferred CONSTANT)
 #endif
   Q_PROPERTY(QStringList additionalModulePaths READ additionalModulePaths CONSTANT)
   Q_PROPERTY(QStringList modulesToIgnore READ modulesToIgnore CONSTANT)
@@ -164,6 +166,11 @@ public:
   /// Return True if slicer should display details regarding the module discovery process
   bool verboseModuleDiscovery()const;
 
+  /// Return the file path where the timing of startup phases should be written to.
+  /// Empty if startup profile should not be written.
+  /// \sa qSlicerCoreApplication::completeStartupProfile()
+  QString startupProfileFilePath()const;
+
   /// Return True if slicer should display information at startup
   bool verbose()const;
 
@@ -203,6 +210,10 @@ public:
   /// Python is still compiled with the app, but not enabled at run-time.
   /// \sa settingsDisabled()
   bool isPythonDisabled()const;
+
+  /// Return True if the Python interpreter should be initialized only when it is first used
+  /// (by a scripted module, Python code, or Python console) instead of at application startup.
+  bool isPythonInitializationDeferred()const;
 #endif
 
 
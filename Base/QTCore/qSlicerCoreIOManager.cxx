@@ -23,6 +23,9 @@
 #include <QDir>
 #include <QElapsedTimer>
 #include <QFileInfo>
+#include <QHash>
+#include <QThread>
+#include <QTimer>
 
 // CTK includes
 #include <ctkUtils.h>
@@ -38,20 +41,31 @@
 #include <vtkMRMLDisplayableNode.h>
 #include <vtkMRMLDisplayNode.h>
 #include <vtkMRMLMessageCollection.h>
+#include <vtkMRMLModelNode.h>
 #include <vtkMRMLNode.h>
+#include <vtkMRMLNRRDStorageNode.h>
+#include <vtkMRMLSegmentationNode.h>
 #include <vtkMRMLTransformableNode.h>
 #include <vtkMRMLTransformNode.h>
 #include <vtkMRMLScene.h>
 #include <vtkMRMLStorableNode.h>
 #include <vtkMRMLStorageNode.h>
+#include <vtkMRMLVolumeNode.h>
 
 // VTK includes
 #include <vtkCollection.h>
 #include <vtkDataFileFormatHelper.h> // for GetFileExtensionFromFormatString()
+#include <vtkImageData.h>
 #include <vtkNew.h>
+#include <vtkPointSet.h>
+#include <vtkSegmentation.h>
+#include <vtkSmartPointer.h>
 #include <vtkStringArray.h>
 #include <vtkGeneralTransform.h>
 
+// STD includes
+#include <vector>
+
 //-----------------------------------------------------------------------------
 class qSlicerCoreIOManagerPrivate
 {
@@ -75,6 +89,27 @@ public:
   QMap<qSlicerIO::IOFileType, QStringList> FileTypes;
 
   QString DefaultSceneFileType;
+
+  /// Snapshot of a storable node that is written by automatic save
+  struct AutoSaveItem
+    {
+    QString NodeID;
+    vtkMTimeType ContentMTime{0};
+    vtkSmartPointer<vtkMRMLStorableNode> Node;
+    vtkSmartPointer<vtkMRMLStorageNode> StorageNode;
+    bool Success{false};
+    };
+
+  QTimer AutoSaveTimer;
+  int AutoSaveInterval{0};
+  QString AutoSaveDirectory;
+  /// Background thread that writes AutoSaveItems, nullptr if no automatic save is in progress
+  QThread* AutoSaveThread{nullptr};
+  std::vector<AutoSaveItem> AutoSaveItems;
+  /// False if any of the files that were written on the main thread could not be written
+  bool AutoSaveSuccess{true};
+  /// Content modified time of nodes when they were last saved automatically
+  QHash<QString, vtkMTimeType> AutoSavedContentMTimes;
 };
 
 //-----------------------------------------------------------------------------
@@ -211,10 +246,22 @@ qSlicerCoreIOManager::qSlicerCoreIOManager(QObject* _parent)
   :QObject(_parent)
   , d_ptr(new qSlicerCoreIOManagerPrivate)
 {
+  Q_D(qSlicerCoreIOManager);
+  QObject::connect(&d->AutoSaveTimer, SIGNAL(timeout()), this, SLOT(autoSave()));
 }
 
 //-----------------------------------------------------------------------------
-qSlicerCoreIOManager::~qSlicerCoreIOManager() = default;
+qSlicerCoreIOManager::~qSlicerCoreIOManager()
+{
+  Q_D(qSlicerCoreIOManager);
+  if (d->AutoSaveThread)
+    {
+    // Snapshots must not be deleted while they are being written
+    d->AutoSaveThread->wait();
+    delete d->AutoSaveThread;
+    d->AutoSaveThread = nullptr;
+    }
+}
 
 //-----------------------------------------------------------------------------
 qSlicerIO::IOFileType qSlicerCoreIOManager::fileType(const QString& fileName)const
@@ -1205,6 +1252,230 @@ void qSlicerCoreIOManager::setDefaultSceneFileType(QString fileType)
   d->DefaultSceneFileType = fileType;
 }
 
+//-----------------------------------------------------------------------------
+int qSlicerCoreIOManager::autoSaveInterval()const
+{
+  Q_D(const qSlicerCoreIOManager);
+  return d->AutoSaveInterval;
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerCoreIOManager::setAutoSaveInterval(int seconds)
+{
+  Q_D(qSlicerCoreIOManager);
+  d->AutoSaveInterval = qMax(0, seconds);
+  if (d->AutoSaveInterval > 0)
+    {
+    d->AutoSaveTimer.start(d->AutoSaveInterval * 1000);
+    }
+  else
+    {
+    d->AutoSaveTimer.stop();
+    }
+}
+
+//-----------------------------------------------------------------------------
+QString qSlicerCoreIOManager::autoSaveDirectory()const
+{
+  Q_D(const qSlicerCoreIOManager);
+  if (d->AutoSaveDirectory.isEmpty() && qSlicerCoreApplication::application())
+    {
+    return QDir(qSlicerCoreApplication::application()->temporaryPath()).filePath("AutoSave");
+    }
+  return d->AutoSaveDirectory;
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerCoreIOManager::setAutoSaveDirectory(const QString& directory)
+{
+  Q_D(qSlicerCoreIOManager);
+  d->AutoSaveDirectory = directory;
+}
+
+//-----------------------------------------------------------------------------
+bool qSlicerCoreIOManager::isAutoSaveInProgress()const
+{
+  Q_D(const qSlicerCoreIOManager);
+  return d->AutoSaveThread != nullptr;
+}
+
+//-----------------------------------------------------------------------------
+bool qSlicerCoreIOManager::autoSave()
+{
+  Q_D(qSlicerCoreIOManager);
+  vtkMRMLScene* scene = d->currentScene();
+  if (d->AutoSaveThread || !scene
+    || scene->IsBatchProcessing() || scene->IsImporting() || scene->IsClosing() || scene->IsRestoring())
+    {
+    return false;
+    }
+  QDir autoSaveDir(this->autoSaveDirectory());
+  if (!autoSaveDir.mkpath("."))
+    {
+    qWarning() << Q_FUNC_INFO << "failed: cannot create folder" << autoSaveDir.absolutePath();
+    return false;
+    }
+
+  // Capture the current state of modified nodes. This is done on the main thread,
+  // therefore it must be fast: bulk data of volumes and models is not copied, only shared.
+  // Only nodes whose storage node cannot write in a background thread and that have no
+  // thread-safe alternative (typically small nodes, such as tables or color tables)
+  // are written right away.
+  std::vector<qSlicerCoreIOManagerPrivate::AutoSaveItem> items;
+  bool success = true;
+  std::vector<vtkMRMLNode*> nodes;
+  scene->GetNodesByClass("vtkMRMLStorableNode", nodes);
+  for (vtkMRMLNode* node : nodes)
+    {
+    vtkMRMLStorableNode* storableNode = vtkMRMLStorableNode::SafeDownCast(node);
+    if (!storableNode || !storableNode->GetID() || !storableNode->GetSaveWithScene()
+      || !storableNode->GetModifiedSinceRead())
+      {
+      continue;
+      }
+    qSlicerCoreIOManagerPrivate::AutoSaveItem item;
+    item.NodeID = QString::fromUtf8(storableNode->GetID());
+    item.ContentMTime = storableNode->GetContentMTime();
+    if (d->AutoSavedContentMTimes.value(item.NodeID, 0) == item.ContentMTime)
+      {
+      // already saved automatically in this state
+      continue;
+      }
+
+    if (storableNode->GetStorageNode())
+      {
+      // Use the same format and options as the node's own storage node
+      item.StorageNode = vtkSmartPointer<vtkMRMLStorageNode>::Take(
+        vtkMRMLStorageNode::SafeDownCast(storableNode->GetStorageNode()->CreateNodeInstance()));
+      item.StorageNode->Copy(storableNode->GetStorageNode());
+      }
+    else
+      {
+      item.StorageNode = vtkSmartPointer<vtkMRMLStorageNode>::Take(storableNode->CreateDefaultStorageNode());
+      }
+    if (!item.StorageNode || !item.StorageNode->GetDefaultWriteFileExtension())
+      {
+      // the node is stored in the scene file
+      continue;
+      }
+    vtkMRMLVolumeNode* volumeNode = vtkMRMLVolumeNode::SafeDownCast(storableNode);
+    vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(storableNode);
+    vtkMRMLSegmentationNode* segmentationNode = vtkMRMLSegmentationNode::SafeDownCast(storableNode);
+    if (volumeNode && !item.StorageNode->CanWriteInBackgroundThread())
+      {
+      // The format of automatically saved files can be freely chosen, therefore volumes
+      // are written in NRRD format, which can be written in a background thread.
+      vtkSmartPointer<vtkMRMLNRRDStorageNode> nrrdStorageNode = vtkSmartPointer<vtkMRMLNRRDStorageNode>::New();
+      if (nrrdStorageNode->CanWriteFromReferenceNode(volumeNode))
+        {
+        nrrdStorageNode->SetUseCompression(item.StorageNode->GetUseCompression());
+        item.StorageNode = nrrdStorageNode;
+        }
+      }
+    QString fileName = QString("%1_%2.%3").arg(item.NodeID)
+      .arg(qSlicerCoreIOManager::forceFileNameValidCharacters(QString::fromUtf8(storableNode->GetName() ? storableNode->GetName() : "")))
+      .arg(QString::fromUtf8(item.StorageNode->GetDefaultWriteFileExtension()));
+    item.StorageNode->ResetFileNameList();
+    item.StorageNode->SetFileName(autoSaveDir.absoluteFilePath(fileName).toUtf8());
+
+    // Segmentations cannot be written in a background thread only because writing collapses the
+    // binary labelmap layers of the node, which is done on the snapshot instead.
+    if (!item.StorageNode->CanWriteInBackgroundThread() && !segmentationNode)
+      {
+      // The writer may access the scene or modify the node, therefore the scene node is written directly.
+      item.StorageNode->SetScene(scene);
+      if (item.StorageNode->WriteData(storableNode))
+        {
+        // writing may have modified the content of the node
+        d->AutoSavedContentMTimes[item.NodeID] = storableNode->GetContentMTime();
+        }
+      else
+        {
+        qWarning() << Q_FUNC_INFO << "failed: cannot write" << item.StorageNode->GetFileName();
+        success = false;
+        }
+      continue;
+      }
+
+    item.Node = vtkSmartPointer<vtkMRMLStorableNode>::Take(
+      vtkMRMLStorableNode::SafeDownCast(storableNode->CreateNodeInstance()));
+    bool shallowCopy = (volumeNode || modelNode);
+    item.Node->CopyContent(storableNode, !shallowCopy);
+    // The snapshot gets its own data object with shared data arrays. If the data object of the
+    // scene node is reallocated or its arrays are replaced while the file is written, the
+    // snapshot still holds a reference to the arrays that are being written.
+    if (volumeNode && volumeNode->GetImageData())
+      {
+      vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::Take(volumeNode->GetImageData()->NewInstance());
+      imageData->ShallowCopy(volumeNode->GetImageData());
+      vtkMRMLVolumeNode::SafeDownCast(item.Node)->SetAndObserveImageData(imageData);
+      }
+    if (modelNode && modelNode->GetMesh())
+      {
+      vtkSmartPointer<vtkPointSet> mesh = vtkSmartPointer<vtkPointSet>::Take(modelNode->GetMesh()->NewInstance());
+      mesh->ShallowCopy(modelNode->GetMesh());
+      vtkMRMLModelNode::SafeDownCast(item.Node)->SetAndObserveMesh(mesh);
+      }
+    vtkMRMLSegmentationNode* segmentationSnapshot = vtkMRMLSegmentationNode::SafeDownCast(item.Node);
+    if (segmentationSnapshot && segmentationSnapshot->GetSegmentation())
+      {
+      // collapse the layers of the copy now, so that the writer does not modify it in the background thread
+      segmentationSnapshot->GetSegmentation()->CollapseBinaryLabelmaps(false);
+      }
+    items.push_back(item);
+    }
+
+  if (items.empty())
+    {
+    emit autoSaveFinished(success);
+    return true;
+    }
+
+  // Write the files in a background thread. Only the snapshots are accessed from the thread.
+  d->AutoSaveSuccess = success;
+  d->AutoSaveItems = items;
+  std::vector<qSlicerCoreIOManagerPrivate::AutoSaveItem>* autoSaveItems = &d->AutoSaveItems;
+  d->AutoSaveThread = QThread::create([autoSaveItems]()
+    {
+    for (qSlicerCoreIOManagerPrivate::AutoSaveItem& item : *autoSaveItems)
+      {
+      item.Success = (item.StorageNode->WriteData(item.Node) != 0);
+      }
+    });
+  QObject::connect(d->AutoSaveThread, SIGNAL(finished()), this, SLOT(onAutoSaveThreadFinished()));
+  d->AutoSaveThread->start(QThread::LowestPriority);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerCoreIOManager::onAutoSaveThreadFinished()
+{
+  Q_D(qSlicerCoreIOManager);
+  if (!d->AutoSaveThread)
+    {
+    return;
+    }
+  d->AutoSaveThread->deleteLater();
+  d->AutoSaveThread = nullptr;
+
+  bool success = d->AutoSaveSuccess;
+  for (const qSlicerCoreIOManagerPrivate::AutoSaveItem& item : d->AutoSaveItems)
+    {
+    if (item.Success)
+      {
+      d->AutoSavedContentMTimes[item.NodeID] = item.ContentMTime;
+      }
+    else
+      {
+      qWarning() << Q_FUNC_INFO << "failed: cannot write" << item.StorageNode->GetFileName();
+      success = false;
+      }
+    }
+  // Snapshots are released on the main thread
+  d->AutoSaveItems.clear();
+  emit autoSaveFinished(success);
+}
+
 //-----------------------------------------------------------------------------
 bool qSlicerCoreIOManager::examineFileInfoList(QFileInfoList &fileInfoList, QFileInfo &archetypeFileInfo, QString &readerDescription, qSlicerIO::IOProperties &ioProperties)const
 {
@@ -50,6 +50,13 @@ class Q_SLICER_BASE_QTCORE_EXPORT qSlicerCoreIOManager:public QObject
 {
   Q_OBJECT;
   Q_PROPERTY(QString defaultSceneFileType READ defaultSceneFileType WRITE setDefaultSceneFileType)
+  /// Time between automatic saves in seconds. 0 (default) disables automatic saving.
+  /// \sa autoSave()
+  Q_PROPERTY(int autoSaveInterval READ autoSaveInterval WRITE setAutoSaveInterval)
+  /// Folder where automatically saved data files are written.
+  /// By default it is the AutoSave subfolder in the application temporary folder.
+  /// \sa autoSave()
+  Q_PROPERTY(QString autoSaveDirectory READ autoSaveDirectory WRITE setAutoSaveDirectory)
 
 public:
   qSlicerCoreIOManager(QObject* parent = nullptr);
@@ -252,6 +259,12 @@ public:
   /// Defines the file format that should be offered by default when the scene is saved.
   Q_INVOKABLE QString defaultSceneFileType()const;
 
+  int autoSaveInterval()const;
+  QString autoSaveDirectory()const;
+
+  /// Returns true if automatically saved files are being written.
+  Q_INVOKABLE bool isAutoSaveInProgress()const;
+
   /// Iterates through readers looking at the fileInfoList to see if there is an entry that can serve as
   /// an archetype for loading multiple fileInfos.  If so, the reader removes the recognized
   /// fileInfos from the list and sets the ioProperties so that the corresponding
@@ -274,6 +287,24 @@ public slots:
   /// or "Medical Reality Bundle (.mrb)").
   void setDefaultSceneFileType(QString);
 
+  void setAutoSaveInterval(int seconds);
+  void setAutoSaveDirectory(const QString& directory);
+
+  /// Save storable nodes that have been modified since they were last read, written,
+  /// or automatically saved into the autoSaveDirectory.
+  /// Nodes are captured on the main thread (volumes and models are shallow-copied, other nodes are deep-copied),
+  /// then their files are written in a low-priority background thread, so that the application remains
+  /// responsive while the files are written. Volumes are written in NRRD format if their storage node cannot
+  /// write in a background thread (vtkMRMLStorageNode::CanWriteInBackgroundThread()) and binary labelmap
+  /// layers of segmentations are collapsed in the captured copy. Other nodes whose storage node cannot write
+  /// in a background thread are written on the main thread before this method returns.
+  /// Storage nodes of the scene are not changed, therefore the nodes still appear as modified
+  /// in the Save data dialog.
+  /// \return False if an automatic save is already in progress or the scene is being
+  /// imported, closed, or batch processed.
+  /// \sa autoSaveFinished(), autoSaveInterval
+  bool autoSave();
+
 signals:
 
   /// This signal is emitted each time a file is loaded using loadNodes()
@@ -289,6 +320,14 @@ signals:
   /// \sa saveNodes()
   void fileSaved(const qSlicerIO::IOProperties& savedFileParameters);
 
+  /// This signal is emitted when all files of an automatic save are written.
+  /// \a success is false if any of the files could not be written.
+  /// \sa autoSave()
+  void autoSaveFinished(bool success);
+
+protected slots:
+  void onAutoSaveThreadFinished();
+
 protected:
 
   /// Returns the list of registered readers
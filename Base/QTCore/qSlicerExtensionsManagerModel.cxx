@@ -30,6 +30,7 @@
 #include <QNetworkReply>
 #include <QScopedPointer>
 #include <QSettings>
+#include <QSharedPointer>
 #include <QStandardItemModel>
 #include <QTemporaryFile>
 #include <QTextStream>
@@ -74,6 +75,14 @@ struct UpdateDownloadInformation
   qint64 DownloadProgress{0};
 };
 
+// --------------------------------------------------------------------------
+/// Information required for downloading an extension package from the server
+struct ExtensionFileInformation
+{
+  QString FileId;
+  QString ArchiveName;
+};
+
 // --------------------------------------------------------------------------
 class QStandardItemModelWithRole : public QStandardItemModel
 {
@@ -197,6 +206,11 @@ public:
 
   qSlicerExtensionDownloadTask* downloadExtensionByName(const QString& extensionName);
 
+  /// Retrieve package file information of the specified extensions from the server and store it
+  /// in ExtensionFilesFromServer. Queries for all extensions are sent at once, so that they are
+  /// processed concurrently instead of waiting for the response for each extension one by one.
+  void retrieveExtensionFiles(const QStringList& extensionNames);
+
   QStringList dependenciesToInstall(const QStringList& directDependencies, QStringList& unresolvedDependencies);
 
   /// Update (reinstall) specified extension.
@@ -248,6 +262,8 @@ public:
 
   qRestAPI ExtensionsMetadataFromServerAPI;
   QMap<QString, QVariantMap> ExtensionsMetadataFromServer;
+  /// Package file information of extensions, indexed by extension ID (which is different for each revision)
+  QHash<QString, ExtensionFileInformation> ExtensionFilesFromServer;
   QUuid ExtensionsMetadataFromServerQueryUID;  // if not null then it means that query is in progress
 
   QHash<QString, UpdateDownloadInformation> AvailableUpdates;
@@ -1593,35 +1609,15 @@ qSlicerExtensionsManagerModelPrivate::downloadExtensionByName(const QString& ext
       }
 
     // Retrieve file_id and archive name (extension package filename) associated with the item
-    QString file_id;
-    QString archivename;
-
-    this->debug(qSlicerExtensionsManagerModel::tr("Retrieving %1 extension files (extensionId: %2)").arg(extensionName).arg(item_id));
-    qRestAPI getItemFilesApi;
-    getItemFilesApi.setServerUrl(q->serverUrl().toString() + QString("/api/v1/item/%1/files").arg(item_id));
-    const QUuid& queryUuid = getItemFilesApi.get("");
-    QScopedPointer<qRestResult> restResult(getItemFilesApi.takeResult(queryUuid));
-    if(restResult)
+    // (it may have been already retrieved with other extensions).
+    if (!this->ExtensionFilesFromServer.contains(item_id))
       {
-      qGirderAPI::parseGirderAPIv1Response(restResult.data(), restResult->response());
-      QList<QVariantMap> results = restResult->results();
-      if (results.isEmpty())
-        {
-        // extension manager returned 0 file, this is not expected
-        return nullptr;
-        }
-      else if (results.count() == 1)
-        {
-        file_id = results.at(0).value("_id").toString();
-        archivename = results.at(0).value("name").toString();
-        }
-      else
-        {
-        // extension manager returned multiple files, this is not expected, do not use the results
-        return nullptr;
-        }
+      this->debug(qSlicerExtensionsManagerModel::tr("Retrieving %1 extension files (extensionId: %2)").arg(extensionName).arg(item_id));
+      this->retrieveExtensionFiles(QStringList() << extensionName);
       }
-
+    const ExtensionFileInformation fileInformation = this->ExtensionFilesFromServer.value(item_id);
+    QString file_id = fileInformation.FileId;
+    QString archivename = fileInformation.ArchiveName;
     if (file_id.isEmpty() || archivename.isEmpty())
       {
       return nullptr;
@@ -1650,6 +1646,57 @@ qSlicerExtensionsManagerModelPrivate::downloadExtensionByName(const QString& ext
   return task;
 }
 
+// --------------------------------------------------------------------------
+void qSlicerExtensionsManagerModelPrivate::retrieveExtensionFiles(const QStringList& extensionNames)
+{
+  Q_Q(qSlicerExtensionsManagerModel);
+  if (q->serverAPI() != qSlicerExtensionsManagerModel::Girder_v1)
+    {
+    return;
+    }
+
+  // Issue all queries before waiting for any of the results
+  QList<QSharedPointer<qRestAPI> > getItemFilesApis;
+  QList<QUuid> queryUuids;
+  QStringList itemIds;
+  foreach (const QString& extensionName, extensionNames)
+    {
+    QString itemId = this->ExtensionsMetadataFromServer.value(extensionName).value("extension_id").toString();
+    if (itemId.isEmpty() || itemIds.contains(itemId) || this->ExtensionFilesFromServer.contains(itemId))
+      {
+      continue;
+      }
+    QSharedPointer<qRestAPI> getItemFilesApi(new qRestAPI);
+    getItemFilesApi->setServerUrl(q->serverUrl().toString() + QString("/api/v1/item/%1/files").arg(itemId));
+    queryUuids << getItemFilesApi->get("");
+    getItemFilesApis << getItemFilesApi;
+    itemIds << itemId;
+    }
+
+  for (int queryIndex = 0; queryIndex < getItemFilesApis.count(); ++queryIndex)
+    {
+    QScopedPointer<qRestResult> restResult(getItemFilesApis[queryIndex]->takeResult(queryUuids[queryIndex]));
+    if (!restResult)
+      {
+      continue;
+      }
+    qGirderAPI::parseGirderAPIv1Response(restResult.data(), restResult->response());
+    QList<QVariantMap> results = restResult->results();
+    if (results.count() != 1)
+      {
+      // extension manager returned 0 or multiple files, this is not expected, do not use the results
+      continue;
+      }
+    ExtensionFileInformation fileInformation;
+    fileInformation.FileId = results.at(0).value("_id").toString();
+    fileInformation.ArchiveName = results.at(0).value("name").toString();
+    if (!fileInformation.FileId.isEmpty() && !fileInformation.ArchiveName.isEmpty())
+      {
+      this->ExtensionFilesFromServer[itemIds[queryIndex]] = fileInformation;
+      }
+    }
+}
+
 // --------------------------------------------------------------------------
 bool qSlicerExtensionsManagerModel::downloadAndInstallExtension(const QString& extensionId, bool installDependencies/*=true*/, bool waitForCompletion/*=false*/)
 {
@@ -2019,6 +2066,8 @@ bool qSlicerExtensionsManagerModel::installExtension(
         {
         // Install dependencies
         QString msg;
+        // Get package information of all dependencies at once, then all downloads can start immediately
+        d->retrieveExtensionFiles(dependenciesToInstall);
         foreach (const QString& dependency, dependenciesToInstall)
           {
           bool res = this->downloadAndInstallExtensionByName(dependency, false /*installation of dependencies already confirmed*/);
@@ -2257,6 +2306,7 @@ void qSlicerExtensionsManagerModel::checkForExtensionsUpdates()
 {
   Q_D(qSlicerExtensionsManagerModel);
   bool updatedExtensionsFound = false;
+  QStringList extensionsToUpdate;
 
   QSettings settings;
   foreach(const QString& extensionName, d->ExtensionsMetadataFromServer.keys())
@@ -2287,7 +2337,7 @@ void qSlicerExtensionsManagerModel::checkForExtensionsUpdates()
       // Immediately start update process if requested
       if (d->AutoUpdateInstall)
         {
-        this->scheduleExtensionForUpdate(extensionName);
+        extensionsToUpdate << extensionName;
         }
       emit this->extensionUpdateAvailable(extensionName);
       updatedExtensionsFound = true;
@@ -2304,6 +2354,11 @@ void qSlicerExtensionsManagerModel::checkForExtensionsUpdates()
       }
     }
 
+  if (!extensionsToUpdate.isEmpty())
+    {
+    this->scheduleExtensionsForUpdate(extensionsToUpdate);
+    }
+
   if (updatedExtensionsFound)
     {
     QSettings extensionSettings(this->extensionsSettingsFilePath(), QSettings::IniFormat);
@@ -2495,6 +2550,20 @@ bool qSlicerExtensionsManagerModel::scheduleExtensionForUpdate(
   return true;
 }
 
+// --------------------------------------------------------------------------
+bool qSlicerExtensionsManagerModel::scheduleExtensionsForUpdate(const QStringList& extensionNames)
+{
+  Q_D(qSlicerExtensionsManagerModel);
+  // Get package information of all extensions at once, so that all downloads can start immediately
+  d->retrieveExtensionFiles(extensionNames);
+  bool success = true;
+  foreach (const QString& extensionName, extensionNames)
+    {
+    success = this->scheduleExtensionForUpdate(extensionName) && success;
+    }
+  return success;
+}
+
 // --------------------------------------------------------------------------
 bool qSlicerExtensionsManagerModel::cancelExtensionScheduledForUpdate(
   const QString& extensionName)
@@ -449,6 +449,15 @@ public slots:
   /// \sa isExtensionScheduledForUpdate, updateScheduledExtensions
   bool scheduleExtensionForUpdate(const QString& extensionName);
 
+  /// Schedule all the specified extensions to be updated.
+  ///
+  /// Package information of all extensions is retrieved from the server at once
+  /// and then all the downloads are started, instead of retrieving information
+  /// for each extension one by one.
+  /// Returns false if any of the extensions could not be scheduled for update.
+  /// \sa scheduleExtensionForUpdate
+  bool scheduleExtensionsForUpdate(const QStringList& extensionNames);
+
   /// \brief Cancel the update of \a extensionName
   /// Tell the application to keep \a extensionName installed
   /// \sa scheduleExtensionForUninstall
@@ -58,13 +58,20 @@ qSlicerAbstractCoreModule* qSlicerLoadableModuleFactoryItem::instanciator()
   if (!qSlicerCoreApplication::testAttribute(qSlicerCoreApplication::AA_DisablePython))
     {
     // By convention, if the module is not embedded,
-    // "<MODULEPATH>/Python" will be appended to PYTHONPATH
-    if (!qSlicerScriptedUtils::importModulePythonExtensions(
-          app->corePythonManager(), app->intDir(), this->path(),
-          app->isEmbeddedModule(this->path())))
+    // "<MODULEPATH>/Python" will be appended to PYTHONPATH.
+    // Importing is delayed until python is initialized (python initialization may be deferred
+    // so that C++ modules can be used without starting the python interpreter).
+    QString modulePath = this->path();
+    QString moduleName = module->name();
+    bool embedded = app->isEmbeddedModule(modulePath);
+    app->callWhenPythonInitialized([app, modulePath, moduleName, embedded]()
       {
-      qWarning() << "qSlicerLoadableModuleFactory - Failed to instantiate module" << module->name() << "python extensions";
-      }
+      if (!qSlicerScriptedUtils::importModulePythonExtensions(
+            app->corePythonManager(), app->intDir(), modulePath, embedded))
+        {
+        qWarning() << "qSlicerLoadableModuleFactory - Failed to instantiate module" << moduleName << "python extensions";
+        }
+      });
     }
 #endif
 
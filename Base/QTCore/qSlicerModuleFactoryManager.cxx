@@ -18,9 +18,13 @@
 
 ==============================================================================*/
 
+// Qt includes
+#include <QElapsedTimer>
+
 // Slicer includes
 #include "qSlicerModuleFactoryManager.h"
 #include "qSlicerAbstractCoreModule.h"
+#include "qSlicerCoreApplication.h"
 
 #include "vtkSlicerConfigure.h" // XXX For modulePaths() function.
 
@@ -173,6 +177,16 @@ bool qSlicerModuleFactoryManager::loadModule(const QString& name, const QString&
       }
     }
 
+  // Only the time spent on setting up this module is reported (dependencies are already loaded)
+  QElapsedTimer timer;
+  timer.start();
+  QString startupPhaseName = QString("Load module %1").arg(name);
+  qSlicerCoreApplication* app = qSlicerCoreApplication::application();
+  if (app)
+    {
+    app->beginStartupPhase(startupPhaseName);
+    }
+
   // Update internal Map
   d->LoadedModules << name;
 
@@ -188,6 +202,10 @@ bool qSlicerModuleFactoryManager::loadModule(const QString& name, const QString&
     d->AppLogic->SetModuleLogic(name.toStdString().c_str(), nullptr);
     qWarning() << "Failed to retrieve module title corresponding to module name: " << name;
     Q_ASSERT(!instance->title().isEmpty());
+    if (app)
+      {
+      app->endStartupPhase(startupPhaseName);
+      }
     return false;
     }
 
@@ -201,6 +219,15 @@ bool qSlicerModuleFactoryManager::loadModule(const QString& name, const QString&
   // Handle post-load initialization
   emit this->moduleLoaded(name);
 
+  if (app)
+    {
+    app->endStartupPhase(startupPhaseName);
+    }
+  if (this->Superclass::isVerbose())
+    {
+    qDebug() << "Loaded module" << name << "in" << timer.elapsed() << "ms";
+    }
+
   return true;
 }
 
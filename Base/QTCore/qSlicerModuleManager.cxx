@@ -19,6 +19,7 @@
 ==============================================================================*/
 
 // Qt includes
+#include <QDebug>
 
 // Slicer includes
 #include "qSlicerModuleManager.h"
@@ -26,15 +27,62 @@
 #include "qSlicerAbstractCoreModule.h"
 #include "qSlicerModuleFactoryManager.h"
 
+// Slicer logic includes
+#include <vtkSlicerApplicationLogic.h>
+
 // MRML includes
+#include <vtkMRMLAbstractLogic.h>
+#include <vtkMRMLScene.h>
+
+// VTK includes
+#include <vtkCollection.h>
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
 
 //-----------------------------------------------------------------------------
 class qSlicerModuleManagerPrivate
 {
 public:
   qSlicerModuleFactoryManager* ModuleFactoryManager;
+  QStringList LazyLoadedModuleNames;
+
+  /// Create logic for the module and (first) for its dependencies.
+  /// \sa qSlicerModuleManager::createLogicsForScene()
+  void createLogicForScene(qSlicerModuleManager* moduleManager, const QString& moduleName, vtkMRMLScene* scene,
+    vtkSlicerApplicationLogic* appLogic, vtkCollection* logics, QStringList& processedModuleNames);
 };
 
+//-----------------------------------------------------------------------------
+void qSlicerModuleManagerPrivate::createLogicForScene(qSlicerModuleManager* moduleManager,
+  const QString& moduleName, vtkMRMLScene* scene, vtkSlicerApplicationLogic* appLogic,
+  vtkCollection* logics, QStringList& processedModuleNames)
+{
+  if (processedModuleNames.contains(moduleName))
+    {
+    return;
+    }
+  processedModuleNames << moduleName;
+  qSlicerAbstractCoreModule* module = moduleManager->module(moduleName);
+  if (!module)
+    {
+    qWarning() << "Failed to create logic of module" << moduleName << "for scene: module is not loaded";
+    return;
+    }
+  foreach(const QString& dependency, module->dependencies())
+    {
+    this->createLogicForScene(moduleManager, dependency, scene, appLogic, logics, processedModuleNames);
+    }
+  vtkSmartPointer<vtkMRMLAbstractLogic> logic;
+  logic.TakeReference(module->createLogicForScene(scene, appLogic));
+  if (!logic)
+    {
+    // module has no logic
+    return;
+    }
+  appLogic->SetModuleLogic(moduleName.toUtf8(), logic);
+  logics->AddItem(logic);
+}
+
 //-----------------------------------------------------------------------------
 qSlicerModuleManager::qSlicerModuleManager(QObject* newParent)
   : Superclass(newParent), d_ptr(new qSlicerModuleManagerPrivate)
@@ -69,9 +117,70 @@ qSlicerModuleFactoryManager* qSlicerModuleManager::factoryManager()const
 qSlicerAbstractCoreModule* qSlicerModuleManager::module(const QString& name)const
 {
   Q_D(const qSlicerModuleManager);
+  if (this->isModuleLoadPending(name))
+    {
+    d->ModuleFactoryManager->loadModule(name);
+    }
   return d->ModuleFactoryManager->loadedModule(name);
 }
 
+//---------------------------------------------------------------------------
+void qSlicerModuleManager::setLazyLoadedModuleNames(const QStringList& moduleNames)
+{
+  Q_D(qSlicerModuleManager);
+  d->LazyLoadedModuleNames = moduleNames;
+  foreach(const QString& name, moduleNames)
+    {
+    if (this->isModuleLoadPending(name))
+      {
+      emit moduleLoadDeferred(name);
+      }
+    }
+}
+
+//---------------------------------------------------------------------------
+QStringList qSlicerModuleManager::lazyLoadedModuleNames()const
+{
+  Q_D(const qSlicerModuleManager);
+  return d->LazyLoadedModuleNames;
+}
+
+//---------------------------------------------------------------------------
+bool qSlicerModuleManager::isModuleLoadPending(const QString& name)const
+{
+  Q_D(const qSlicerModuleManager);
+  return d->LazyLoadedModuleNames.contains(name)
+    && d->ModuleFactoryManager->isInstantiated(name)
+    && !d->ModuleFactoryManager->isLoaded(name);
+}
+
+//---------------------------------------------------------------------------
+vtkSlicerApplicationLogic* qSlicerModuleManager::createLogicsForScene(vtkMRMLScene* scene,
+  const QStringList& moduleNames, vtkCollection* logics)
+{
+  Q_D(qSlicerModuleManager);
+  if (!scene || !logics)
+    {
+    qCritical() << Q_FUNC_INFO << "failed: invalid scene or logics collection";
+    return nullptr;
+    }
+  vtkNew<vtkSlicerApplicationLogic> appLogic;
+  qSlicerCoreApplication* app = qSlicerCoreApplication::application();
+  if (app && app->applicationLogic())
+    {
+    appLogic->SetTemporaryPath(app->applicationLogic()->GetTemporaryPath());
+    }
+  appLogic->SetMRMLScene(scene);
+  logics->AddItem(appLogic);
+
+  QStringList processedModuleNames;
+  foreach(const QString& moduleName, moduleNames)
+    {
+    d->createLogicForScene(this, moduleName, scene, appLogic, logics, processedModuleNames);
+    }
+  return appLogic;
+}
+
 //---------------------------------------------------------------------------
 QStringList qSlicerModuleManager::modulesNames()const
 {
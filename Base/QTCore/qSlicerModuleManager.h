@@ -32,6 +32,9 @@
 
 class qSlicerAbstractCoreModule;
 class qSlicerModuleFactoryManager;
+class vtkCollection;
+class vtkMRMLScene;
+class vtkSlicerApplicationLogic;
 
 class qSlicerModuleManagerPrivate;
 
@@ -53,10 +56,46 @@ public:
   Q_INVOKABLE QStringList modulesNames()const;
 
   /// Return the loaded module identified by \a name
+  /// If the module is lazily loaded and it has not been loaded yet then it is loaded now.
+  /// \sa setLazyLoadedModuleNames()
   Q_INVOKABLE qSlicerAbstractCoreModule* module(const QString& name)const;
 
+  /// Set modules that are not loaded at startup but only when they are first requested
+  /// by module() (for example, when the module is selected in the module panel
+  /// or its logic is accessed).
+  /// Lazily loaded modules are still instantiated at startup, therefore their name, title,
+  /// categories, etc. are available. A lazily loaded module is loaded at startup anyway
+  /// if a loaded module depends on it.
+  /// Note that file readers/writers and other features that are registered when the module
+  /// is loaded are not available until the module is loaded.
+  Q_INVOKABLE void setLazyLoadedModuleNames(const QStringList& moduleNames);
+  Q_INVOKABLE QStringList lazyLoadedModuleNames()const;
+
+  /// Returns true if the module is instantiated and lazily loaded, but it has not been loaded yet.
+  Q_INVOKABLE bool isModuleLoadPending(const QString& name)const;
+
+  /// \brief Create an independent set of logics for processing a scene.
+  ///
+  /// An application logic and logics of the specified modules (and of the modules they depend on)
+  /// are created for \a scene. Module logics are registered in the returned application logic,
+  /// therefore they can access each other (for example, volumes logic finds the colors logic).
+  /// This allows processing several scenes in the same process, without paying the application
+  /// startup time for each. The application logic and the module logics are added to \a logics,
+  /// which keeps them alive: remove all items from the collection to delete the logics.
+  ///
+  /// \note MRML scenes share observers, the event broker, and node class registries,
+  /// therefore logics of different scenes must still be used from the main thread only.
+  ///
+  /// \return Application logic of the scene (owned by \a logics), nullptr on failure.
+  /// \sa qSlicerAbstractCoreModule::createLogicForScene()
+  Q_INVOKABLE vtkSlicerApplicationLogic* createLogicsForScene(vtkMRMLScene* scene,
+    const QStringList& moduleNames, vtkCollection* logics);
+
 signals:
   void moduleLoaded(const QString& module);
+  /// Emitted for each instantiated module that is not loaded
+  /// because it is lazily loaded. \sa setLazyLoadedModuleNames()
+  void moduleLoadDeferred(const QString& module);
   void moduleAboutToBeUnloaded(const QString& module);
 
 protected:
@@ -90,7 +90,15 @@ bool qSlicerSceneBundleReader::load(const qSlicerIO::IOProperties& properties)
     clear = properties["clear"].toBool();
     }
 
+  // If reading data on demand is requested then data files are only extracted
+  // from the bundle when they are needed
+  bool wasReadDataOnDemand = this->mrmlScene()->GetReadDataOnDemand();
+  if (properties.contains("readDataOnDemand"))
+    {
+    this->mrmlScene()->SetReadDataOnDemand(properties["readDataOnDemand"].toBool());
+    }
   bool success = this->mrmlScene()->ReadFromMRB(file.toUtf8(), clear, this->userMessages());
+  this->mrmlScene()->SetReadDataOnDemand(wasReadDataOnDemand);
   if (success)
     {
     // Set default scene file format to mrb
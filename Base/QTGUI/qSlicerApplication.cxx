@@ -296,28 +296,36 @@ void qSlicerApplicationPrivate::init()
     {
     // Initialize method prints the welcome message and a prompt, so we need to set these colors now.
     // All the other colors will be set later in the main window.
-    QPalette palette = qSlicerApplication::application()->palette();
-    q->pythonConsole()->setWelcomeTextColor(palette.color(QPalette::Disabled, QPalette::WindowText));
-    q->pythonConsole()->setPromptColor(palette.color(QPalette::Highlight));
-    q->pythonConsole()->initialize(q->pythonManager());
-    ctkSlicerPythonConsoleCompleter* completer = new ctkSlicerPythonConsoleCompleter(*q->pythonManager(), q);
-    q->pythonConsole()->setCompleter(completer);
-    QStringList autocompletePreferenceList;
-    autocompletePreferenceList
-      << "slicer"
-      << "slicer.mrmlScene"
-      << "qt.QPushButton";
-    q->pythonConsole()->completer()->setAutocompletePreferenceList(autocompletePreferenceList);
-    foreach(QAction* action, q->pythonConsole()->actions())
+    // If python initialization is deferred then the console is initialized when python is first used.
+    q->callWhenPythonInitialized([q]()
       {
-      if (action->shortcut() == QKeySequence("Ctrl+H"))
+      if (!q->pythonConsole())
         {
-        // Remove action as "Ctrl+H" is reserved for going to the "Home" module
-        q->pythonConsole()->removeAction(action);
-        action->setParent(nullptr);
-        break;
+        return;
         }
-      }
+      QPalette palette = qSlicerApplication::application()->palette();
+      q->pythonConsole()->setWelcomeTextColor(palette.color(QPalette::Disabled, QPalette::WindowText));
+      q->pythonConsole()->setPromptColor(palette.color(QPalette::Highlight));
+      q->pythonConsole()->initialize(q->pythonManager());
+      ctkSlicerPythonConsoleCompleter* completer = new ctkSlicerPythonConsoleCompleter(*q->pythonManager(), q);
+      q->pythonConsole()->setCompleter(completer);
+      QStringList autocompletePreferenceList;
+      autocompletePreferenceList
+        << "slicer"
+        << "slicer.mrmlScene"
+        << "qt.QPushButton";
+      q->pythonConsole()->completer()->setAutocompletePreferenceList(autocompletePreferenceList);
+      foreach(QAction* action, q->pythonConsole()->actions())
+        {
+        if (action->shortcut() == QKeySequence("Ctrl+H"))
+          {
+          // Remove action as "Ctrl+H" is reserved for going to the "Home" module
+          q->pythonConsole()->removeAction(action);
+          action->setParent(nullptr);
+          break;
+          }
+        }
+      });
     }
 #endif
 
@@ -671,10 +671,7 @@ void qSlicerExtensionsManagerWidget::onInstallUpdatesTriggered()
   // Save last update check time
   bool wasBatchProcessing = d->setBatchProcessing(true);
   QStringList extensionNames = this->extensionsManagerModel()->availableUpdateExtensions();
-  foreach(const QString & extensionName, extensionNames)
-    {
-    this->extensionsManagerModel()->scheduleExtensionForUpdate(extensionName);
-    }
+  this->extensionsManagerModel()->scheduleExtensionsForUpdate(extensionNames);
   d->setBatchProcessing(wasBatchProcessing);
 }
 
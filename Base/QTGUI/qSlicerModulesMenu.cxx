@@ -24,6 +24,7 @@
 
 // CTK includes
 #include "qSlicerAbstractModule.h"
+#include "qSlicerModuleFactoryManager.h"
 #include "qSlicerModuleManager.h"
 
 // Slicer includes
@@ -467,6 +468,9 @@ void qSlicerModulesMenu::setModuleManager(qSlicerModuleManager* moduleManager)
     QObject::disconnect(d->ModuleManager,
                         SIGNAL(moduleAboutToBeUnloaded(QString)),
                         this, SLOT(removeModule(QString)));
+    QObject::disconnect(d->ModuleManager,
+                        SIGNAL(moduleLoadDeferred(QString)),
+                        this, SLOT(onModuleLoadDeferred(QString)));
     }
 
   this->clear();
@@ -485,7 +489,17 @@ void qSlicerModulesMenu::setModuleManager(qSlicerModuleManager* moduleManager)
   QObject::connect(d->ModuleManager,
                    SIGNAL(moduleAboutToBeUnloaded(QString)),
                    this, SLOT(removeModule(QString)));
+  QObject::connect(d->ModuleManager,
+                   SIGNAL(moduleLoadDeferred(QString)),
+                   this, SLOT(onModuleLoadDeferred(QString)));
   this->addModules(d->ModuleManager->modulesNames());
+  foreach(const QString& moduleName, d->ModuleManager->lazyLoadedModuleNames())
+    {
+    if (d->ModuleManager->isModuleLoadPending(moduleName))
+      {
+      this->onModuleLoadDeferred(moduleName);
+      }
+    }
 }
 
 //---------------------------------------------------------------------------
@@ -506,9 +520,27 @@ QAction* qSlicerModulesMenu::moduleAction(const QString& moduleName)const
 void qSlicerModulesMenu::addModule(const QString& moduleName)
 {
   Q_D(qSlicerModulesMenu);
+  if (d->action(QVariant(moduleName)))
+    {
+    // already added (before the module was loaded)
+    return;
+    }
   this->addModule(d->ModuleManager ? d->ModuleManager->module(moduleName) : nullptr);
 }
 
+//---------------------------------------------------------------------------
+void qSlicerModulesMenu::onModuleLoadDeferred(const QString& moduleName)
+{
+  Q_D(qSlicerModulesMenu);
+  if (!d->ModuleManager || d->action(QVariant(moduleName)))
+    {
+    return;
+    }
+  // The module instance is available (so title, categories, etc. can be shown),
+  // the module is loaded when it is selected.
+  this->addModule(d->ModuleManager->factoryManager()->moduleInstance(moduleName));
+}
+
 //---------------------------------------------------------------------------
 void qSlicerModulesMenu::addModule(qSlicerAbstractCoreModule* moduleToAdd)
 {
@@ -149,6 +149,8 @@ signals:
 
 protected slots:
   void onActionTriggered();
+  /// Add module to the menu that is instantiated but not loaded yet
+  void onModuleLoadDeferred(const QString& moduleName);
   void actionSelected(QAction* action);
 
 protected:
@@ -19,6 +19,8 @@
 ==============================================================================*/
 
 // Qt includes
+#include <QFileDialog>
+#include <QMessageBox>
 #include <QSettings>
 
 // QtGUI includes
@@ -28,6 +30,9 @@
 #include "qSlicerSettingsDeveloperPanel.h"
 #include "ui_qSlicerSettingsDeveloperPanel.h"
 
+// MRML includes
+#include <vtkTraceRecorder.h>
+
 // --------------------------------------------------------------------------
 // qSlicerSettingsDeveloperPanelPrivate
 
@@ -64,6 +69,7 @@ void qSlicerSettingsDeveloperPanelPrivate::init()
   this->DeveloperModeEnabledCheckBox->setChecked(false);
   this->SelfTestMessageDelaySlider->setValue(750);
   this->QtTestingEnabledCheckBox->setChecked(false);
+  this->TraceRecordingCheckBox->setChecked(vtkTraceRecorder::GetInstance()->GetRecording());
 #ifndef Slicer_USE_QtTesting
   this->QtTestingEnabledCheckBox->hide();
   this->QtTestingEnabledLabel->hide();
@@ -94,6 +100,13 @@ void qSlicerSettingsDeveloperPanelPrivate::init()
   QObject::connect(this->QtTestingEnabledCheckBox, SIGNAL(toggled(bool)),
                    q, SLOT(enableQtTesting(bool)));
 
+  QObject::connect(this->TraceRecordingCheckBox, SIGNAL(toggled(bool)),
+                   q, SLOT(enableTraceRecording(bool)));
+  QObject::connect(this->ClearTraceButton, SIGNAL(clicked()),
+                   q, SLOT(clearTrace()));
+  QObject::connect(this->ExportTraceButton, SIGNAL(clicked()),
+                   q, SLOT(exportTrace()));
+
   QObject::connect(this->QtDesignerButton, SIGNAL(clicked()),
     qSlicerApplication::application(), SLOT(launchDesigner()));
 }
@@ -130,3 +143,30 @@ void qSlicerSettingsDeveloperPanel::enableQtTesting(bool value)
 {
   Q_UNUSED(value);
 }
+
+// --------------------------------------------------------------------------
+void qSlicerSettingsDeveloperPanel::enableTraceRecording(bool value)
+{
+  vtkTraceRecorder::GetInstance()->SetRecording(value);
+}
+
+// --------------------------------------------------------------------------
+void qSlicerSettingsDeveloperPanel::clearTrace()
+{
+  vtkTraceRecorder::GetInstance()->ClearEvents();
+}
+
+// --------------------------------------------------------------------------
+void qSlicerSettingsDeveloperPanel::exportTrace()
+{
+  QString fileName = QFileDialog::getSaveFileName(this, tr("Export trace"), "trace.json",
+    tr("Chrome trace event files (*.json)"));
+  if (fileName.isEmpty())
+    {
+    return;
+    }
+  if (!vtkTraceRecorder::GetInstance()->WriteEventsAsChromeTrace(fileName.toUtf8().constData()))
+    {
+    QMessageBox::warning(this, tr("Export trace"), tr("Failed to write trace events to file: %1").arg(fileName));
+    }
+}
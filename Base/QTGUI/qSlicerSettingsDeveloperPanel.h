@@ -53,6 +53,9 @@ protected slots:
   void enableDeveloperMode(bool value);
   void enableQtTesting(bool value);
   void preserveCLIModuleDataFiles(bool value);
+  void enableTraceRecording(bool value);
+  void clearTrace();
+  void exportTrace();
 
 protected:
   QScopedPointer<qSlicerSettingsDeveloperPanelPrivate> d_ptr;
@@ -59,6 +59,8 @@ public:
   int AutoRunMode;
   /// Delay in msecs to wait before the module is auto run.
   unsigned int AutoRunDelay;
+  /// Scheduling priority of the executions
+  int Priority;
 
   /// Last time the module was started.
   vtkTimeStamp LastRunTime;
@@ -100,6 +102,7 @@ vtkMRMLCommandLineModuleNode::vtkMRMLCommandLineModuleNode()
     vtkMRMLCommandLineModuleNode::AutoRunOnChangedParameter
     | vtkMRMLCommandLineModuleNode::AutoRunCancelsRunningProcess;
   this->Internal->AutoRunDelay = 1000;
+  this->Internal->Priority = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -290,6 +293,7 @@ void vtkMRMLCommandLineModuleNode::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Status: " << this->GetStatusString() << "\n";
   os << indent << "AutoRun:" << this->GetAutoRun() << "\n";
   os << indent << "AutoRunMode:" << this->GetAutoRunMode() << "\n";
+  os << indent << "Priority:" << this->GetPriority() << "\n";
 
   os << indent << "Parameter values:\n";
   std::vector<ModuleParameterGroup>::const_iterator pgbeginit = this->GetModuleDescription().GetParameterGroups().begin();
@@ -636,6 +640,23 @@ unsigned int vtkMRMLCommandLineModuleNode::GetAutoRunDelay() const
   return this->Internal->AutoRunDelay;
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLCommandLineModuleNode::SetPriority(int priority)
+{
+  if (this->Internal->Priority == priority)
+    {
+    return;
+    }
+  this->Internal->Priority = priority;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+int vtkMRMLCommandLineModuleNode::GetPriority() const
+{
+  return this->Internal->Priority;
+}
+
 //----------------------------------------------------------------------------
 vtkMTimeType vtkMRMLCommandLineModuleNode::GetLastRunTime() const
 {
@@ -662,6 +683,7 @@ const char* vtkMRMLCommandLineModuleNode::GetStatusString() const
     {
     case Idle: return "Idle";
     case Scheduled: return "Scheduled";
+    case Waiting: return "Waiting";
     case Running: return "Running";
     case Cancelling: return "Cancelling";
     case Cancelled: return "Cancelled";
@@ -681,6 +703,7 @@ std::string vtkMRMLCommandLineModuleNode::GetDisplayableStatusString() const
   {
   case Idle: return vtkMRMLTr("vtkMRMLCommandLineModuleNode", "Idle");
   case Scheduled: return vtkMRMLTr("vtkMRMLCommandLineModuleNode", "Scheduled");
+  case Waiting: return vtkMRMLTr("vtkMRMLCommandLineModuleNode", "Waiting");
   case Running: return vtkMRMLTr("vtkMRMLCommandLineModuleNode", "Running");
   case Cancelling: return vtkMRMLTr("vtkMRMLCommandLineModuleNode", "Cancelling");
   case Cancelled: return vtkMRMLTr("vtkMRMLCommandLineModuleNode", "Cancelled");
@@ -98,8 +98,12 @@ public:
     ErrorsMask=0x40,
     /// State when the CLI has been executed with errors
     CompletedWithErrors= Completed | ErrorsMask,
+    /// State when the CLI has been started but waits for the memory
+    /// reserved by the other running CLIs to be released.
+    /// \sa vtkSlicerCLIModuleLogic::SetRunningModulesMemoryLimit()
+    Waiting=0x80,
     /// Mask used to know if the CLI is in pending mode.
-    BusyMask = Scheduled | Running | Cancelling | Completing
+    BusyMask = Scheduled | Waiting | Running | Cancelling | Completing
     };
 
   /// Set the status of the node (Idle, Scheduled, Running,
@@ -153,8 +157,8 @@ public:
   std::string GetErrorText() const;
   //@}
 
-  /// Return true if the module is in a busy state: Scheduled, Running,
-  /// Cancelling, Completing.
+  /// Return true if the module is in a busy state: Scheduled, Waiting,
+  /// Running, Cancelling, Completing.
   /// \sa SetStatus(), GetStatus(), BusyMask, Cancel()
   bool IsBusy()const;
 
@@ -223,6 +227,14 @@ public:
   /// \sa SetAutoRunDelay(), GetAutoRun(), GetAutoRunMode()
   unsigned int GetAutoRunDelay()const;
 
+  /// Set the scheduling priority of the next executions of the module.
+  /// Scheduled CLIs with a higher priority are started first, CLIs with the
+  /// same priority are started in the order they were applied. 0 by default.
+  /// The value is not stored persistently in the scene file.
+  /// \sa vtkSlicerTask::SetPriority()
+  void SetPriority(int priority);
+  int GetPriority()const;
+
   /// Return the last time the module was ran.
   /// \sa GetParameterMTime(), GetInputMTime(), GetMTime()
   vtkMTimeType GetLastRunTime()const;
@@ -14,6 +14,7 @@
 #include "vtkArchive.h"
 
 // VTK includes
+#include <vtkNew.h>
 
 // VTKSYS includes
 #include <vtksys/SystemTools.hxx>
@@ -167,5 +168,43 @@ int vtkArchiveTest1(int argc, char * argv[] )
     return EXIT_FAILURE;
     }
 
+  //
+  // Write a zip file entry by entry and extract only some of the entries
+  //
+  std::string workingDirectory = vtksys::SystemTools::GetParentDirectory(zipDirPath);
+  std::string streamedZipFilePath = workingDirectory + "/streamedArchiveTest.zip";
+  std::cout << "creating " << streamedZipFilePath << std::endl;
+  vtkNew<vtkArchive> archive;
+  CHECK_BOOL(archive->IsZipOpen(), false);
+  CHECK_BOOL(archive->OpenZip(streamedZipFilePath.c_str()), true);
+  CHECK_BOOL(archive->IsZipOpen(), true);
+  CHECK_BOOL(archive->AddDirectory("streamedArchiveTest"), true);
+  CHECK_BOOL(archive->AddFile((zipDirPath + "/vol.mrml").c_str(), "streamedArchiveTest/vol.mrml"), true);
+  const std::string content = "streamed content";
+  CHECK_BOOL(archive->AddData("streamedArchiveTest/Data/content.txt", content.c_str(), content.size()), true);
+  CHECK_BOOL(archive->AddData("streamedArchiveTest/Data/other.txt", content.c_str(), content.size()), true);
+  CHECK_BOOL(archive->CloseZip(), true);
+  CHECK_BOOL(archive->IsZipOpen(), false);
+
+  std::string streamedExtractDir = workingDirectory + "/extractedStreamedArchiveTest";
+  if (vtksys::SystemTools::FileExists(streamedExtractDir))
+    {
+    CHECK_BOOL(vtksys::SystemTools::RemoveADirectory(streamedExtractDir), true);
+    }
+  vtksys::SystemTools::MakeDirectory(streamedExtractDir);
+  std::vector<std::string> entryNames;
+  entryNames.push_back("streamedArchiveTest/Data/");
+  CHECK_BOOL(vtkArchive::UnZipEntries(streamedZipFilePath.c_str(), streamedExtractDir.c_str(), entryNames), true);
+  CHECK_BOOL(vtksys::SystemTools::FileExists(streamedExtractDir + "/streamedArchiveTest/Data/content.txt", true), true);
+  CHECK_BOOL(vtksys::SystemTools::FileExists(streamedExtractDir + "/streamedArchiveTest/Data/other.txt", true), true);
+  CHECK_BOOL(vtksys::SystemTools::FileExists(streamedExtractDir + "/streamedArchiveTest/vol.mrml", true), false);
+  CHECK_INT(vtksys::SystemTools::FileLength(streamedExtractDir + "/streamedArchiveTest/Data/content.txt"),
+    static_cast<int>(content.size()));
+
+  entryNames.clear();
+  entryNames.push_back("streamedArchiveTest/vol.mrml");
+  CHECK_BOOL(vtkArchive::UnZipEntries(streamedZipFilePath.c_str(), streamedExtractDir.c_str(), entryNames), true);
+  CHECK_BOOL(vtksys::SystemTools::FileExists(streamedExtractDir + "/streamedArchiveTest/vol.mrml", true), true);
+
   return EXIT_SUCCESS;
 }
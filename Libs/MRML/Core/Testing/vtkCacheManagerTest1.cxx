@@ -0,0 +1,166 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH) All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   3D Slicer
+
+=========================================================================auto=*/
+
+// MRML includes
+#include "vtkCacheManager.h"
+#include "vtkMRMLCoreTestingMacros.h"
+
+// VTK includes
+#include <vtkNew.h>
+
+// VTKSYS includes
+#include <vtksys/SystemTools.hxx>
+
+// STD includes
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#include <sys/stat.h>
+
+namespace
+{
+
+//---------------------------------------------------------------------------
+std::string WriteFile(const std::string& directory, const std::string& name, char content)
+{
+  std::string fileName = directory + "/" + name;
+  std::ofstream file(fileName.c_str(), std::ios::binary);
+  file << std::string(1000000, content);
+  return fileName;
+}
+
+//---------------------------------------------------------------------------
+std::string ReadFile(const std::string& fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+//---------------------------------------------------------------------------
+bool IsFileWritable(const std::string& fileName)
+{
+  mode_t mode = 0;
+  vtksys::SystemTools::GetPermissions(fileName, mode);
+#if defined(_WIN32)
+  return (mode & _S_IWRITE) != 0;
+#else
+  return (mode & S_IWUSR) != 0;
+#endif
+}
+
+} // end of anonymous namespace
+
+//---------------------------------------------------------------------------
+int vtkCacheManagerTest1(int argc, char * argv[])
+{
+  if (argc != 2)
+    {
+    std::cerr << "Usage: " << argv[0] << " /path/to/temp" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::string cacheDirectory = std::string(argv[1]) + "/vtkCacheManagerTest1";
+  vtksys::SystemTools::RemoveADirectory(cacheDirectory);
+  CHECK_BOOL(static_cast<bool>(vtksys::SystemTools::MakeDirectory(cacheDirectory)), true);
+
+  std::string firstFileName = WriteFile(cacheDirectory, "first.nrrd", 'a');
+  std::string sameContentFileName = WriteFile(cacheDirectory, "sameContent.nrrd", 'a');
+  std::string oldestFileName = WriteFile(cacheDirectory, "oldest.nrrd", 'b');
+  std::string lastFileName = WriteFile(cacheDirectory, "last.nrrd", 'c');
+  std::string outsideFileName = WriteFile(argv[1], "vtkCacheManagerTest1Outside.nrrd", 'd');
+
+  std::string contentHash;
+  {
+    vtkNew<vtkCacheManager> cacheManager;
+    cacheManager->SetRemoteCacheDirectory(cacheDirectory.c_str());
+    cacheManager->SetRemoteCacheLimit(3);
+    cacheManager->SetRemoteCacheFreeBufferSize(0);
+
+    CHECK_INT(cacheManager->AddFileToCache("http://host/first.nrrd", firstFileName.c_str()), 1);
+    contentHash = cacheManager->GetCachedFileContentHash(firstFileName.c_str());
+    CHECK_BOOL(contentHash.empty(), false);
+    TESTING_OUTPUT_ASSERT_ERRORS_BEGIN();
+    CHECK_INT(cacheManager->AddFileToCache("http://host/outside.nrrd", outsideFileName.c_str()), 0);
+    TESTING_OUTPUT_ASSERT_ERRORS_END();
+
+    // files with identical content are identified by their hash and stored once
+    CHECK_INT(cacheManager->AddFileToCache("http://mirror/first.nrrd", sameContentFileName.c_str()), 1);
+    CHECK_STD_STRING(cacheManager->GetCachedFileContentHash(sameContentFileName.c_str()), contentHash);
+    CHECK_BOOL(cacheManager->FindCachedFileByContentHash(contentHash).empty(), false);
+    CHECK_BOOL(cacheManager->FindCachedFileByContentHash("unknown").empty(), true);
+    // linked files share their content, they cannot be modified in place
+    CHECK_BOOL(IsFileWritable(sameContentFileName), false);
+    CHECK_BOOL(IsFileWritable(firstFileName), false);
+
+    CHECK_INT(cacheManager->AddFileToCache("http://host/oldest.nrrd", oldestFileName.c_str()), 1);
+    CHECK_INT(cacheManager->AddFileToCache("http://host/last.nrrd", lastFileName.c_str()), 1);
+    CHECK_BOOL(cacheManager->GetIndexedCacheSize() > 2.9 && cacheManager->GetIndexedCacheSize() < 3.1, true);
+
+    // the index file is not reported as a cached file
+    cacheManager->UpdateCacheInformation();
+    std::vector<std::string> cachedFiles = cacheManager->GetCachedFiles();
+    CHECK_BOOL(std::find(cachedFiles.begin(), cachedFiles.end(),
+      vtkCacheManager::GetCacheIndexFileName()) == cachedFiles.end(), true);
+
+    // there is enough space, nothing is removed
+    CHECK_INT(cacheManager->FreeCacheSpace(), 1);
+    CHECK_BOOL(vtksys::SystemTools::FileExists(oldestFileName, true), true);
+
+    // accessing the first file makes "oldest" the least recently used content
+    std::string indexFileName = cacheDirectory + "/" + vtkCacheManager::GetCacheIndexFileName();
+    std::string index = ReadFile(indexFileName);
+    cacheManager->UpdateCachedFileAccessTime(firstFileName.c_str());
+    // cache hits do not write the index each time
+    CHECK_BOOL(ReadFile(indexFileName) == index, true);
+    cacheManager->SaveCacheIndex();
+    CHECK_BOOL(ReadFile(indexFileName) == index, false);
+    CHECK_INT(cacheManager->FreeCacheSpace(1.0), 1);
+    CHECK_BOOL(vtksys::SystemTools::FileExists(oldestFileName, true), false);
+    CHECK_BOOL(vtksys::SystemTools::FileExists(firstFileName, true), true);
+    CHECK_BOOL(vtksys::SystemTools::FileExists(sameContentFileName, true), true);
+    CHECK_BOOL(vtksys::SystemTools::FileExists(lastFileName, true), true);
+    CHECK_BOOL(cacheManager->GetIndexedCacheSize() > 1.9 && cacheManager->GetIndexedCacheSize() < 2.1, true);
+
+    // a linked file is removed before it is downloaded again, the content is kept
+    CHECK_BOOL(cacheManager->UnlinkCachedFile(firstFileName.c_str()), true);
+    CHECK_BOOL(vtksys::SystemTools::FileExists(firstFileName, true), false);
+    CHECK_BOOL(ReadFile(sameContentFileName) == std::string(1000000, 'a'), true);
+    CHECK_BOOL(IsFileWritable(sameContentFileName), true);
+    CHECK_BOOL(cacheManager->UnlinkCachedFile(sameContentFileName.c_str()), false);
+    CHECK_BOOL(cacheManager->UnlinkCachedFile(lastFileName.c_str()), false);
+    WriteFile(cacheDirectory, "first.nrrd", 'a');
+    CHECK_INT(cacheManager->AddFileToCache("http://host/first.nrrd", firstFileName.c_str()), 1);
+    CHECK_BOOL(IsFileWritable(firstFileName), false);
+  }
+
+  // the index is persistent
+  {
+    vtkNew<vtkCacheManager> cacheManager;
+    cacheManager->SetRemoteCacheDirectory(cacheDirectory.c_str());
+    cacheManager->SetRemoteCacheLimit(1);
+    cacheManager->SetRemoteCacheFreeBufferSize(0);
+    CHECK_STD_STRING(cacheManager->GetCachedFileContentHash(firstFileName.c_str()), contentHash);
+    CHECK_STD_STRING(cacheManager->GetCachedFileContentHash(oldestFileName.c_str()), "");
+
+    // "last" was accessed before "first"
+    CHECK_INT(cacheManager->FreeCacheSpace(), 1);
+    CHECK_BOOL(vtksys::SystemTools::FileExists(lastFileName, true), false);
+    CHECK_BOOL(vtksys::SystemTools::FileExists(firstFileName, true), true);
+
+    // not enough space even after removing everything that can be removed
+    CHECK_INT(cacheManager->FreeCacheSpace(10.0), 0);
+    CHECK_BOOL(vtksys::SystemTools::FileExists(firstFileName, true), false);
+    CHECK_BOOL(vtksys::SystemTools::FileExists(sameContentFileName, true), false);
+  }
+
+  vtksys::SystemTools::RemoveFile(outsideFileName);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,289 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH) All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   3D Slicer
+
+=========================================================================auto=*/
+
+// MRML includes
+#include "vtkEventBroker.h"
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLNode.h"
+#include "vtkMRMLScene.h"
+#include "vtkObservation.h"
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+#include <vtkStringArray.h>
+#include <vtkTable.h>
+#include <vtkTimerLog.h>
+
+// STD includes
+#include <vector>
+
+namespace
+{
+
+int CallbackCount = 0;
+
+//---------------------------------------------------------------------------
+void CountingCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+  void* vtkNotUsed(clientData), void* vtkNotUsed(callData))
+{
+  ++CallbackCount;
+}
+
+//---------------------------------------------------------------------------
+int TestObservationLookup()
+{
+  vtkEventBroker* broker = vtkEventBroker::GetInstance();
+  int initialNumberOfObservations = broker->GetNumberOfObservations();
+  CallbackCount = 0;
+
+  vtkNew<vtkCallbackCommand> callback;
+  callback->SetCallback(CountingCallback);
+  vtkNew<vtkObject> subject1;
+  vtkNew<vtkObject> subject2;
+  vtkSmartPointer<vtkObject> observer1 = vtkSmartPointer<vtkObject>::New();
+  vtkNew<vtkObject> observer2;
+
+  broker->AddObservation(subject1, vtkCommand::ModifiedEvent, observer1, callback);
+  broker->AddObservation(subject1, vtkCommand::UserEvent, observer1, callback);
+  broker->AddObservation(subject1, vtkCommand::ModifiedEvent, observer2, callback);
+  broker->AddObservation(subject2, vtkCommand::ModifiedEvent, observer1, callback);
+  CHECK_INT(broker->GetNumberOfObservations(), initialNumberOfObservations + 4);
+
+  CHECK_INT(static_cast<int>(broker->GetObservations(subject1, vtkCommand::ModifiedEvent).size()), 2);
+  CHECK_INT(static_cast<int>(broker->GetObservations(subject1, 0, observer1).size()), 2);
+  CHECK_INT(static_cast<int>(broker->GetObservations(subject1, vtkCommand::ModifiedEvent, observer1).size()), 1);
+  CHECK_INT(static_cast<int>(broker->GetObservations(subject2, vtkCommand::ModifiedEvent, observer2).size()), 0);
+  CHECK_BOOL(broker->GetObservationExist(subject2, vtkCommand::UserEvent), false);
+  CHECK_BOOL(broker->GetObservationExist(subject2, vtkCommand::ModifiedEvent, observer1, callback), true);
+
+  subject1->Modified();
+  CHECK_INT(CallbackCount, 2);
+
+  broker->RemoveObservations(subject1, vtkCommand::ModifiedEvent, observer1);
+  CHECK_INT(static_cast<int>(broker->GetObservations(subject1, vtkCommand::ModifiedEvent).size()), 1);
+  subject1->Modified();
+  CHECK_INT(CallbackCount, 3);
+
+  // Observations are removed when the observer is deleted
+  observer1 = nullptr;
+  CHECK_INT(static_cast<int>(broker->GetObservations(subject2, vtkCommand::ModifiedEvent).size()), 0);
+  CHECK_INT(static_cast<int>(broker->GetObservations(subject1, vtkCommand::UserEvent).size()), 0);
+  CHECK_INT(broker->GetNumberOfObservations(), initialNumberOfObservations + 1);
+
+  broker->RemoveObservations(subject1, observer2);
+  CHECK_INT(broker->GetNumberOfObservations(), initialNumberOfObservations);
+  return EXIT_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+struct CallRecord
+{
+  int Count{0};
+  void* LastCallData{nullptr};
+};
+
+//---------------------------------------------------------------------------
+void RecordingCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+  void* clientData, void* callData)
+{
+  CallRecord* record = reinterpret_cast<CallRecord*>(clientData);
+  ++record->Count;
+  record->LastCallData = callData;
+}
+
+//---------------------------------------------------------------------------
+int TestEventCoalescing()
+{
+  vtkEventBroker* broker = vtkEventBroker::GetInstance();
+  CHECK_INT(broker->GetEventMode(), vtkEventBroker::Synchronous);
+
+  vtkNew<vtkObject> subject;
+  vtkNew<vtkObject> observer;
+  CallRecord queuedRecord;
+  vtkNew<vtkCallbackCommand> queuedCallback;
+  queuedCallback->SetCallback(RecordingCallback);
+  queuedCallback->SetClientData(&queuedRecord);
+  CallRecord coalescedRecord;
+  vtkNew<vtkCallbackCommand> coalescedCallback;
+  coalescedCallback->SetCallback(RecordingCallback);
+  coalescedCallback->SetClientData(&coalescedRecord);
+
+  broker->AddObservation(subject, vtkCommand::UserEvent, observer, queuedCallback);
+  vtkObservation* coalescedObservation = broker->AddObservation(subject, vtkCommand::UserEvent, observer, coalescedCallback);
+  CHECK_NOT_NULL(coalescedObservation);
+  CHECK_INT(coalescedObservation->GetCoalesceEvents(), 0);
+  coalescedObservation->CoalesceEventsOn();
+
+  broker->SetEventModeToAsynchronous();
+  const int numberOfEvents = 500;
+  int callData[numberOfEvents];
+  for (int eventIndex = 0; eventIndex < numberOfEvents; ++eventIndex)
+    {
+    subject->InvokeEvent(vtkCommand::UserEvent, &callData[eventIndex]);
+    }
+  CHECK_INT(queuedRecord.Count, 0);
+  CHECK_INT(coalescedRecord.Count, 0);
+  broker->ProcessEventQueue();
+
+  // each call data is delivered separately, unless events are coalesced
+  CHECK_INT(queuedRecord.Count, numberOfEvents);
+  CHECK_INT(coalescedRecord.Count, 1);
+  CHECK_POINTER(coalescedRecord.LastCallData, &callData[numberOfEvents - 1]);
+
+  // invocations are not merged in synchronous mode
+  broker->SetEventModeToSynchronous();
+  subject->InvokeEvent(vtkCommand::UserEvent, &callData[0]);
+  subject->InvokeEvent(vtkCommand::UserEvent, &callData[1]);
+  CHECK_INT(coalescedRecord.Count, 3);
+
+  broker->RemoveObservations(subject, observer);
+  return EXIT_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+void NestingCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+  void* clientData, void* vtkNotUsed(callData))
+{
+  // invoke an event on another subject from the callback
+  reinterpret_cast<vtkObject*>(clientData)->InvokeEvent(vtkCommand::UserEvent);
+}
+
+//---------------------------------------------------------------------------
+int TestEventProfiling()
+{
+  vtkEventBroker* broker = vtkEventBroker::GetInstance();
+  CHECK_INT(broker->GetEventProfiling(), 0);
+
+  vtkNew<vtkObject> outerSubject;
+  vtkNew<vtkObject> innerSubject;
+  vtkNew<vtkObject> observer;
+  vtkNew<vtkCallbackCommand> outerCallback;
+  outerCallback->SetCallback(NestingCallback);
+  outerCallback->SetClientData(innerSubject.GetPointer());
+  vtkNew<vtkCallbackCommand> innerCallback;
+  innerCallback->SetCallback(CountingCallback);
+  vtkObservation* outerObservation = broker->AddObservation(outerSubject, vtkCommand::ModifiedEvent, observer, outerCallback);
+  vtkObservation* innerObservation = broker->AddObservation(innerSubject, vtkCommand::UserEvent, observer, innerCallback);
+
+  // statistics are not recorded by default
+  outerSubject->Modified();
+  CHECK_INT(outerObservation->GetInvocationCount(), 0);
+  CHECK_INT(innerObservation->GetInvocationCount(), 0);
+
+  broker->EventProfilingOn();
+  const int numberOfInvocations = 10;
+  for (int i = 0; i < numberOfInvocations; ++i)
+    {
+    outerSubject->Modified();
+    }
+  innerSubject->InvokeEvent(vtkCommand::UserEvent);
+  broker->EventProfilingOff();
+
+  CHECK_INT(outerObservation->GetInvocationCount(), numberOfInvocations);
+  CHECK_INT(innerObservation->GetInvocationCount(), numberOfInvocations + 1);
+  CHECK_INT(outerObservation->GetMaximumEventNestingLevel(), 1);
+  CHECK_INT(innerObservation->GetMaximumEventNestingLevel(), 2);
+  CHECK_BOOL(outerObservation->GetTotalSelfElapsedTime() >= 0.0, true);
+  CHECK_BOOL(outerObservation->GetTotalSelfElapsedTime() <= outerObservation->GetTotalElapsedTime(), true);
+  CHECK_BOOL(outerObservation->GetMaximumElapsedTime() <= outerObservation->GetTotalElapsedTime(), true);
+
+  vtkNew<vtkTable> profile;
+  broker->GetEventProfile(profile);
+  CHECK_INT(profile->GetNumberOfRows(), 2);
+  CHECK_INT(profile->GetNumberOfColumns(), 9);
+  vtkStringArray* subjectArray = vtkStringArray::SafeDownCast(profile->GetColumnByName("Subject"));
+  CHECK_NOT_NULL(subjectArray);
+  CHECK_STRING(subjectArray->GetValue(0).c_str(), "vtkObject");
+  CHECK_INT(profile->GetValueByName(0, "MaximumEventNestingLevel").ToInt()
+    + profile->GetValueByName(1, "MaximumEventNestingLevel").ToInt(), 3);
+  CHECK_BOOL(profile->GetValueByName(0, "TotalSelfElapsedTime").ToDouble()
+    >= profile->GetValueByName(1, "TotalSelfElapsedTime").ToDouble(), true);
+
+  broker->ResetEventProfile();
+  CHECK_INT(outerObservation->GetInvocationCount(), 0);
+  CHECK_INT(innerObservation->GetMaximumEventNestingLevel(), 0);
+  broker->GetEventProfile(profile);
+  CHECK_INT(profile->GetNumberOfRows(), 0);
+
+  broker->RemoveObservations(outerSubject, observer);
+  broker->RemoveObservations(innerSubject, observer);
+  return EXIT_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+int TestSceneClearPerformance()
+{
+  // This test is for performance
+  vtkEventBroker* broker = vtkEventBroker::GetInstance();
+  const int numberOfNodes = 5000;
+  const int numberOfEventsPerNode = 5;
+  vtkNew<vtkCallbackCommand> callback;
+  callback->SetCallback(CountingCallback);
+  vtkNew<vtkObject> observer;
+  vtkNew<vtkMRMLScene> scene;
+  int emptySceneNumberOfObservations = broker->GetNumberOfObservations();
+  std::vector<vtkMRMLNode*> nodes;
+  for (int nodeIndex = 0; nodeIndex < numberOfNodes; ++nodeIndex)
+    {
+    vtkMRMLNode* node = scene->AddNewNodeByClass("vtkMRMLScriptedModuleNode");
+    CHECK_NOT_NULL(node);
+    nodes.push_back(node);
+    }
+  int initialNumberOfObservations = broker->GetNumberOfObservations();
+  for (vtkMRMLNode* node : nodes)
+    {
+    for (int eventIndex = 0; eventIndex < numberOfEventsPerNode; ++eventIndex)
+      {
+      // node is observed by an object and the scene is observed by the node
+      broker->AddObservation(node, vtkCommand::UserEvent + eventIndex, observer, callback);
+      broker->AddObservation(scene, vtkCommand::UserEvent + eventIndex, node, callback);
+      }
+    }
+  const int numberOfObservations = 2 * numberOfNodes * numberOfEventsPerNode;
+  CHECK_INT(broker->GetNumberOfObservations(), initialNumberOfObservations + numberOfObservations);
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  for (vtkMRMLNode* node : nodes)
+    {
+    broker->RemoveObservations(scene, vtkCommand::UserEvent, node);
+    }
+  timer->StopTimer();
+  std::cout << "<DartMeasurement name=\"vtkEventBroker-RemoveObservationsPerformance-"
+            << numberOfObservations << "\" type=\"numeric/double\">"
+            << timer->GetElapsedTime() << "</DartMeasurement>" << std::endl;
+  CHECK_INT(broker->GetNumberOfObservations(), initialNumberOfObservations + numberOfObservations - numberOfNodes);
+
+  timer->StartTimer();
+  scene->Clear(1);
+  timer->StopTimer();
+  std::cout << "<DartMeasurement name=\"vtkEventBroker-SceneClearPerformance-"
+            << numberOfObservations << "\" type=\"numeric/double\">"
+            << timer->GetElapsedTime() << "</DartMeasurement>" << std::endl;
+
+  // all observations are removed when the nodes are deleted
+  CHECK_INT(broker->GetNumberOfObservations(), emptySceneNumberOfObservations);
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//---------------------------------------------------------------------------
+int vtkEventBrokerTest1(int vtkNotUsed(argc), char * vtkNotUsed(argv)[])
+{
+  CHECK_EXIT_SUCCESS(TestObservationLookup());
+  CHECK_EXIT_SUCCESS(TestEventCoalescing());
+  CHECK_EXIT_SUCCESS(TestEventProfiling());
+  CHECK_EXIT_SUCCESS(TestSceneClearPerformance());
+  return EXIT_SUCCESS;
+}
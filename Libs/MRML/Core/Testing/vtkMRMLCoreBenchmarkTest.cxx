@@ -0,0 +1,203 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLCoreTestingUtilities.h"
+#include "vtkMRMLLinearTransformNode.h"
+#include "vtkMRMLModelNode.h"
+#include "vtkMRMLScene.h"
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkEventBroker.h>
+#include <vtkGeneralTransform.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+
+// STD includes
+#include <vector>
+
+namespace
+{
+
+//---------------------------------------------------------------------------
+void CountEventCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+  void* clientData, void* vtkNotUsed(callData))
+{
+  ++(*reinterpret_cast<int*>(clientData));
+}
+
+//---------------------------------------------------------------------------
+/// Fill the scene with model nodes, each under one of a few chains of linear transforms
+void PopulateScene(vtkMRMLScene* scene, int numberOfModelNodes, int transformChainLength,
+  std::vector<vtkSmartPointer<vtkMRMLNode>>* addedNodes = nullptr)
+{
+  vtkMRMLTransformNode* parentTransformNode = nullptr;
+  for (int transformIndex = 0; transformIndex < transformChainLength; ++transformIndex)
+    {
+    vtkNew<vtkMRMLLinearTransformNode> transformNode;
+    vtkNew<vtkMatrix4x4> matrix;
+    matrix->SetElement(0, 3, transformIndex);
+    transformNode->SetMatrixTransformToParent(matrix);
+    scene->AddNode(transformNode);
+    transformNode->SetAndObserveTransformNodeID(parentTransformNode ? parentTransformNode->GetID() : nullptr);
+    parentTransformNode = transformNode;
+    if (addedNodes)
+      {
+      addedNodes->push_back(transformNode.GetPointer());
+      }
+    }
+  for (int modelIndex = 0; modelIndex < numberOfModelNodes; ++modelIndex)
+    {
+    vtkNew<vtkMRMLModelNode> modelNode;
+    scene->AddNode(modelNode);
+    modelNode->SetAndObserveTransformNodeID(parentTransformNode ? parentTransformNode->GetID() : nullptr);
+    if (addedNodes)
+      {
+      addedNodes->push_back(modelNode.GetPointer());
+      }
+    }
+}
+
+} // end of anonymous namespace
+
+//---------------------------------------------------------------------------
+/// Benchmarks of frequently used MRML scene operations.
+/// Times are reported as DartMeasurement. If a baseline file is specified as first argument
+/// (see TestData/vtkMRMLCoreBenchmarkTestBaselines.txt) then the test fails if any benchmark takes
+/// longer than its baseline.
+int vtkMRMLCoreBenchmarkTest(int argc, char* argv[])
+{
+  std::map<std::string, double> baselines;
+  if (argc > 1)
+    {
+    CHECK_BOOL(vtkMRMLCoreTestingUtilities::ReadBenchmarkBaselines(argv[1], baselines), true);
+    }
+  const int numberOfRepetitions = 3;
+  const int numberOfNodes = 2000;
+  bool success = true;
+
+  // Scene AddNode
+  vtkSmartPointer<vtkMRMLScene> scene;
+  success &= vtkMRMLCoreTestingUtilities::RunBenchmark("vtkMRMLScene-AddNode", baselines, numberOfRepetitions,
+    [&]() { PopulateScene(scene, numberOfNodes, 0); },
+    [&]() { scene = vtkSmartPointer<vtkMRMLScene>::New(); });
+
+  // Scene GetNodesByClass
+  int numberOfFoundNodes = 0;
+  success &= vtkMRMLCoreTestingUtilities::RunBenchmark("vtkMRMLScene-GetNodesByClass", baselines, numberOfRepetitions,
+    [&]()
+    {
+    for (int i = 0; i < 1000; ++i)
+      {
+      std::vector<vtkMRMLNode*> nodes;
+      numberOfFoundNodes = scene->GetNodesByClass("vtkMRMLModelNode", nodes);
+      }
+    });
+  CHECK_INT(numberOfFoundNodes, numberOfNodes);
+
+  // Scene RemoveNode
+  std::vector<vtkSmartPointer<vtkMRMLNode>> nodesToRemove;
+  success &= vtkMRMLCoreTestingUtilities::RunBenchmark("vtkMRMLScene-RemoveNode", baselines, numberOfRepetitions,
+    [&]()
+    {
+    for (vtkMRMLNode* node : nodesToRemove)
+      {
+      scene->RemoveNode(node);
+      }
+    },
+    [&]()
+    {
+    scene = vtkSmartPointer<vtkMRMLScene>::New();
+    nodesToRemove.clear();
+    PopulateScene(scene, numberOfNodes, 0, &nodesToRemove);
+    });
+  CHECK_INT(scene->GetNumberOfNodesByClass("vtkMRMLModelNode"), 0);
+
+  // Event broker dispatch
+  vtkNew<vtkMRMLModelNode> eventSubject;
+  int numberOfEvents = 0;
+  vtkNew<vtkCallbackCommand> callback;
+  callback->SetCallback(CountEventCallback);
+  callback->SetClientData(&numberOfEvents);
+  std::vector<vtkSmartPointer<vtkObject>> observers;
+  for (int i = 0; i < 100; ++i)
+    {
+    observers.push_back(vtkSmartPointer<vtkMRMLModelNode>::New());
+    vtkEventBroker::GetInstance()->AddObservation(eventSubject, vtkCommand::ModifiedEvent, observers.back(), callback);
+    }
+  success &= vtkMRMLCoreTestingUtilities::RunBenchmark("vtkEventBroker-Dispatch", baselines, numberOfRepetitions,
+    [&]()
+    {
+    for (int i = 0; i < 1000; ++i)
+      {
+      eventSubject->Modified();
+      }
+    });
+  CHECK_INT(numberOfEvents, numberOfRepetitions * 1000 * 100);
+  for (vtkObject* observer : observers)
+    {
+    vtkEventBroker::GetInstance()->RemoveObservations(eventSubject, observer);
+    }
+
+  // Transform to world queries
+  scene = vtkSmartPointer<vtkMRMLScene>::New();
+  PopulateScene(scene, 10, 20);
+  vtkMRMLTransformableNode* transformedNode = vtkMRMLTransformableNode::SafeDownCast(scene->GetFirstNodeByClass("vtkMRMLModelNode"));
+  CHECK_NOT_NULL(transformedNode);
+  vtkMRMLTransformNode* transformedNodeParent = transformedNode->GetParentTransformNode();
+  CHECK_NOT_NULL(transformedNodeParent);
+  success &= vtkMRMLCoreTestingUtilities::RunBenchmark("vtkMRMLTransformNode-GetTransformToWorld", baselines, numberOfRepetitions,
+    [&]()
+    {
+    vtkNew<vtkGeneralTransform> transformToWorld;
+    for (int i = 0; i < 10000; ++i)
+      {
+      transformedNodeParent->GetTransformToWorld(transformToWorld);
+      }
+    });
+  success &= vtkMRMLCoreTestingUtilities::RunBenchmark("vtkMRMLTransformNode-GetMatrixTransformToWorld", baselines, numberOfRepetitions,
+    [&]()
+    {
+    vtkNew<vtkMatrix4x4> matrixToWorld;
+    for (int i = 0; i < 10000; ++i)
+      {
+      transformedNodeParent->GetMatrixTransformToWorld(matrixToWorld);
+      }
+    });
+
+  // MRML write and parse
+  scene = vtkSmartPointer<vtkMRMLScene>::New();
+  PopulateScene(scene, numberOfNodes, 10);
+  scene->SetSaveToXMLString(1);
+  success &= vtkMRMLCoreTestingUtilities::RunBenchmark("vtkMRMLScene-WriteXML", baselines, numberOfRepetitions,
+    [&]() { scene->Commit(); });
+  std::string sceneXML = scene->GetSceneXMLString();
+  vtkSmartPointer<vtkMRMLScene> loadedScene;
+  success &= vtkMRMLCoreTestingUtilities::RunBenchmark("vtkMRMLScene-ParseXML", baselines, numberOfRepetitions,
+    [&]() { loadedScene->Import(); },
+    [&]()
+    {
+    loadedScene = vtkSmartPointer<vtkMRMLScene>::New();
+    loadedScene->SetLoadFromXMLString(1);
+    loadedScene->SetSceneXMLString(sceneXML);
+    });
+  CHECK_INT(loadedScene->GetNumberOfNodesByClass("vtkMRMLModelNode"), numberOfNodes);
+
+  CHECK_BOOL(success, true);
+  return EXIT_SUCCESS;
+}
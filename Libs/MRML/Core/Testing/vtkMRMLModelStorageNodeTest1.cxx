@@ -25,7 +25,8 @@ Program:   3D Slicer
 #include <array>
 
 //---------------------------------------------------------------------------
-int TestReadWriteData(vtkMRMLScene* scene, const char* extension, vtkPointSet* mesh, int coordinateSystem, bool cellsMayBeSubdivided = false);
+int TestReadWriteData(vtkMRMLScene* scene, const char* extension, vtkPointSet* mesh, int coordinateSystem, bool cellsMayBeSubdivided = false,
+  const std::string& compressionParameter = "");
 void CreateVoxelMeshes(vtkUnstructuredGrid* ug, vtkPolyData* poly);
 
 //---------------------------------------------------------------------------
@@ -58,12 +59,23 @@ int vtkMRMLModelStorageNodeTest1(int argc, char * argv[])
     CHECK_EXIT_SUCCESS(TestReadWriteData(scene.GetPointer(), ".vtu", ug.GetPointer(), coordinateSystem));
     }
 
+  // Test all compression presets of VTK XML files
+  for (const std::string& compressionParameter :
+    { node1->GetCompressionParameterFastest(), node1->GetCompressionParameterNormal(), node1->GetCompressionParameterMinimumSize() })
+    {
+    CHECK_EXIT_SUCCESS(TestReadWriteData(scene.GetPointer(), ".vtp", poly.GetPointer(),
+      vtkMRMLStorageNode::CoordinateSystemLPS, false, compressionParameter));
+    CHECK_EXIT_SUCCESS(TestReadWriteData(scene.GetPointer(), ".vtu", ug.GetPointer(),
+      vtkMRMLStorageNode::CoordinateSystemLPS, false, compressionParameter));
+    }
+
   std::cout << "Test passed." << std::endl;
   return EXIT_SUCCESS;
 }
 
 //---------------------------------------------------------------------------
-int TestReadWriteData(vtkMRMLScene* scene, const char *extension, vtkPointSet *mesh, int coordinateSystem, bool cellsMayBeSubdivided/*=false*/)
+int TestReadWriteData(vtkMRMLScene* scene, const char *extension, vtkPointSet *mesh, int coordinateSystem, bool cellsMayBeSubdivided/*=false*/,
+  const std::string& compressionParameter/*=""*/)
 {
   std::string fileName = std::string(scene->GetRootDirectory()) +
     std::string("/vtkMRMLModelNodeTest1") +
@@ -94,6 +106,10 @@ int TestReadWriteData(vtkMRMLScene* scene, const char *extension, vtkPointSet *m
   CHECK_NOT_NULL(storageNode);
   storageNode->SetFileName(fileName.c_str());
   storageNode->SetCoordinateSystem(coordinateSystem);
+  if (!compressionParameter.empty())
+    {
+    storageNode->SetCompressionParameter(compressionParameter);
+    }
 
   // Test writing
   CHECK_BOOL(storageNode->WriteData(modelNode.GetPointer()), true);
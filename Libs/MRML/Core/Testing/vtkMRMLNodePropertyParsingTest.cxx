@@ -0,0 +1,55 @@
+/*=auto=========================================================================
+
+Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH)
+All Rights Reserved.
+
+See COPYRIGHT.txt
+or http://www.slicer.org/copyright/copyright.txt for details.
+
+Program:   3D Slicer
+
+=========================================================================auto=*/
+
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLNodePropertyMacros.h"
+
+// STD includes
+#include <cstring>
+
+//---------------------------------------------------------------------------
+int vtkMRMLNodePropertyParsingTest(int vtkNotUsed(argc), char * vtkNotUsed(argv)[])
+{
+  int intValue = 0;
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToInt("12", nullptr, intValue), true);
+  CHECK_INT(intValue, 12);
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToInt(" -3 ", nullptr, intValue), true);
+  CHECK_INT(intValue, -3);
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToInt("", nullptr, intValue), false);
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToInt("  ", nullptr, intValue), false);
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToInt("2.5", nullptr, intValue), false);
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToInt("5x", nullptr, intValue), false);
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToInt("99999999999999999999", nullptr, intValue), false);
+
+  double doubleValue = 0.0;
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToDouble("1.5", nullptr, doubleValue), true);
+  CHECK_DOUBLE(doubleValue, 1.5);
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToDouble("-2e3 ", nullptr, doubleValue), true);
+  CHECK_DOUBLE(doubleValue, -2000.0);
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToDouble("abc", nullptr, doubleValue), false);
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToDouble("", nullptr, doubleValue), false);
+
+  // Parse part of a string
+  const char* values = "10 20.5 30";
+  const char* separator = strchr(values, ' ');
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToInt(values, separator, intValue), true);
+  CHECK_INT(intValue, 10);
+  const char* secondSeparator = strchr(separator + 1, ' ');
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToDouble(separator + 1, secondSeparator, doubleValue), true);
+  CHECK_DOUBLE(doubleValue, 20.5);
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToInt(separator + 1, secondSeparator, intValue), false);
+  // empty range
+  CHECK_BOOL(vtkMRMLNodePropertyParsing::ToInt(separator, separator, intValue), false);
+
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
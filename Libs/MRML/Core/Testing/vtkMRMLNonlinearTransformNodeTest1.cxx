@@ -19,6 +19,7 @@
 #include "vtkMRMLTransformNode.h"
 #include "vtkMRMLBSplineTransformNode.h"
 #include "vtkMRMLGridTransformNode.h"
+#include "vtkMRMLLinearTransformNode.h"
 #include "vtkMRMLScene.h"
 
 #include <vtkCollection.h>
@@ -26,6 +27,7 @@
 #include <vtkMath.h>
 #include <vtkPoints.h>
 #include <vtkPointSource.h>
+#include <vtkThinPlateSplineTransform.h>
 #include <vtkTransform.h>
 
 #include "vtkMRMLCoreTestingMacros.h"
@@ -37,6 +39,8 @@ int TestCompositeTransformHardenSplit(const char *filename);
 int TestBSplineLinearCompositeTransformSplit(const char *filename);
 int TestRelativeTransforms(const char *filename);
 int TestGetTransform();
+int TestBakeTransformToWorld();
+int TestInverseTransformPoints();
 
 int vtkMRMLNonlinearTransformNodeTest1(int argc, char * argv[] )
 {
@@ -55,6 +59,8 @@ int vtkMRMLNonlinearTransformNodeTest1(int argc, char * argv[] )
   CHECK_EXIT_SUCCESS(TestBSplineLinearCompositeTransformSplit(filename));
   CHECK_EXIT_SUCCESS(TestRelativeTransforms(filename));
   CHECK_EXIT_SUCCESS(TestGetTransform());
+  CHECK_EXIT_SUCCESS(TestBakeTransformToWorld());
+  CHECK_EXIT_SUCCESS(TestInverseTransformPoints());
 
   std::cout << "Success" << std::endl;
   return EXIT_SUCCESS;
@@ -415,3 +421,127 @@ int TestGetTransform()
 
   return EXIT_SUCCESS;
 }
+
+//---------------------------------------------------------------------------
+int TestBakeTransformToWorld()
+{
+  vtkNew<vtkMRMLScene> scene;
+
+  // thin-plate spline transform under a linear transform
+  vtkNew<vtkPoints> sourceLandmarks;
+  vtkNew<vtkPoints> targetLandmarks;
+  const double landmarks[5][3] = { { -20, -20, -20 }, { 20, -20, 0 }, { 0, 20, 20 }, { 0, 0, 0 }, { 20, 20, -20 } };
+  for (int i = 0; i < 5; i++)
+    {
+    sourceLandmarks->InsertNextPoint(landmarks[i]);
+    targetLandmarks->InsertNextPoint(landmarks[i][0] + (i == 3 ? 3.0 : 0.0), landmarks[i][1], landmarks[i][2] + (i == 1 ? -2.0 : 0.0));
+    }
+  vtkNew<vtkThinPlateSplineTransform> tpsTransform;
+  tpsTransform->SetBasisToR();
+  tpsTransform->SetSourceLandmarks(sourceLandmarks.GetPointer());
+  tpsTransform->SetTargetLandmarks(targetLandmarks.GetPointer());
+  vtkMRMLTransformNode* tpsTransformNode = vtkMRMLTransformNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLTransformNode"));
+  tpsTransformNode->SetAndObserveTransformToParent(tpsTransform.GetPointer());
+
+  vtkNew<vtkMatrix4x4> translation;
+  translation->SetElement(0, 3, 5.0);
+  vtkMRMLLinearTransformNode* linearTransformNode = vtkMRMLLinearTransformNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLLinearTransformNode"));
+  linearTransformNode->SetMatrixTransformToParent(translation.GetPointer());
+  tpsTransformNode->SetAndObserveTransformNodeID(linearTransformNode->GetID());
+
+  // Linear chains are not baked, invalid grids are rejected
+  const double bounds[6] = { -30, 30, -30, 30, -30, 30 };
+  const double spacing[3] = { 2.0, 2.0, 2.0 };
+  const double invalidSpacing[3] = { 2.0, 0.0, 2.0 };
+  CHECK_BOOL(linearTransformNode->BakeTransformToWorld(bounds, spacing), false);
+  TESTING_OUTPUT_ASSERT_ERRORS_BEGIN();
+  CHECK_BOOL(tpsTransformNode->BakeTransformToWorld(bounds, invalidSpacing), false);
+  TESTING_OUTPUT_ASSERT_ERRORS_END();
+  CHECK_BOOL(tpsTransformNode->IsTransformToWorldBaked(), false);
+
+  vtkNew<vtkGeneralTransform> exactTransformToWorld;
+  tpsTransformNode->GetTransformToWorld(exactTransformToWorld.GetPointer());
+  vtkNew<vtkGeneralTransform> exactTransformFromWorld;
+  tpsTransformNode->GetTransformFromWorld(exactTransformFromWorld.GetPointer());
+
+  CHECK_BOOL(tpsTransformNode->BakeTransformToWorld(bounds, spacing), true);
+  CHECK_BOOL(tpsTransformNode->IsTransformToWorldBaked(), true);
+
+  // Baked transforms are close to the exact transforms inside the grid
+  vtkNew<vtkGeneralTransform> bakedTransformToWorld;
+  tpsTransformNode->GetTransformToWorld(bakedTransformToWorld.GetPointer());
+  vtkNew<vtkGeneralTransform> bakedTransformFromWorld;
+  tpsTransformNode->GetTransformFromWorld(bakedTransformFromWorld.GetPointer());
+  const double testPoints[3][3] = { { 1.3, -2.7, 4.1 }, { -15.5, 10.2, 7.7 }, { 12.0, 18.4, -9.3 } };
+  for (int i = 0; i < 3; i++)
+    {
+    double exactPoint[3] = { 0.0, 0.0, 0.0 };
+    double bakedPoint[3] = { 0.0, 0.0, 0.0 };
+    exactTransformToWorld->TransformPoint(testPoints[i], exactPoint);
+    bakedTransformToWorld->TransformPoint(testPoints[i], bakedPoint);
+    CHECK_BOOL(sqrt(vtkMath::Distance2BetweenPoints(exactPoint, bakedPoint)) < 0.1, true);
+    exactTransformFromWorld->TransformPoint(testPoints[i], exactPoint);
+    bakedTransformFromWorld->TransformPoint(testPoints[i], bakedPoint);
+    CHECK_BOOL(sqrt(vtkMath::Distance2BetweenPoints(exactPoint, bakedPoint)) < 0.1, true);
+    }
+
+  // Modifying the chain discards the baked transforms
+  translation->SetElement(1, 3, 2.0);
+  linearTransformNode->SetMatrixTransformToParent(translation.GetPointer());
+  CHECK_BOOL(tpsTransformNode->IsTransformToWorldBaked(), false);
+  CHECK_BOOL(tpsTransformNode->BakeTransformToWorld(bounds, spacing), true);
+  tpsTransformNode->ClearBakedTransformToWorld();
+  CHECK_BOOL(tpsTransformNode->IsTransformToWorldBaked(), false);
+
+  return EXIT_SUCCESS;
+}
+
+//---------------------------------------------------------------------------
+int TestInverseTransformPoints()
+{
+  vtkNew<vtkPoints> sourceLandmarks;
+  vtkNew<vtkPoints> targetLandmarks;
+  const double landmarks[5][3] = { { -20, -20, -20 }, { 20, -20, 0 }, { 0, 20, 20 }, { 0, 0, 0 }, { 20, 20, -20 } };
+  for (int i = 0; i < 5; i++)
+    {
+    sourceLandmarks->InsertNextPoint(landmarks[i]);
+    targetLandmarks->InsertNextPoint(landmarks[i][0] + (i == 3 ? 4.0 : 0.0), landmarks[i][1] + (i == 2 ? -3.0 : 0.0), landmarks[i][2]);
+    }
+  vtkNew<vtkThinPlateSplineTransform> forwardTransform;
+  forwardTransform->SetBasisToR();
+  forwardTransform->SetSourceLandmarks(sourceLandmarks.GetPointer());
+  forwardTransform->SetTargetLandmarks(targetLandmarks.GetPointer());
+
+  // Rows of points, as used for reslicing
+  vtkNew<vtkPoints> inputPoints;
+  for (int j = 0; j < 20; j++)
+    {
+    for (int i = 0; i < 50; i++)
+      {
+      inputPoints->InsertNextPoint(-25.0 + i, -10.0 + j, 3.5);
+      }
+    }
+  vtkNew<vtkPoints> outputPoints;
+  vtkMRMLTransformNode::InverseTransformPoints(forwardTransform.GetPointer(), inputPoints.GetPointer(), outputPoints.GetPointer());
+  CHECK_INT(outputPoints->GetNumberOfPoints(), inputPoints->GetNumberOfPoints());
+
+  // Compare to the inverse transform
+  vtkAbstractTransform* inverseTransform = forwardTransform->GetInverse();
+  for (vtkIdType pointId = 0; pointId < inputPoints->GetNumberOfPoints(); pointId++)
+    {
+    double expectedPoint[3] = { 0.0, 0.0, 0.0 };
+    inverseTransform->TransformPoint(inputPoints->GetPoint(pointId), expectedPoint);
+    CHECK_BOOL(sqrt(vtkMath::Distance2BetweenPoints(expectedPoint, outputPoints->GetPoint(pointId))) < 0.01, true);
+    double transformedBackPoint[3] = { 0.0, 0.0, 0.0 };
+    forwardTransform->TransformPoint(outputPoints->GetPoint(pointId), transformedBackPoint);
+    CHECK_BOOL(sqrt(vtkMath::Distance2BetweenPoints(transformedBackPoint, inputPoints->GetPoint(pointId))) < 0.01, true);
+    }
+
+  // Empty input
+  vtkNew<vtkPoints> emptyPoints;
+  vtkMRMLTransformNode::InverseTransformPoints(forwardTransform.GetPointer(), emptyPoints.GetPointer(), outputPoints.GetPointer());
+  CHECK_INT(outputPoints->GetNumberOfPoints(), 0);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,226 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLMultiResolutionVolumeNode.h"
+#include "vtkMRMLOMEZarrStorageNode.h"
+#include "vtkMRMLScene.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkNew.h>
+
+// VTKsys includes
+#include <vtksys/SystemTools.hxx>
+
+// STD includes
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+
+// Level 0 is 10x8x6 voxels, level 1 is 5x4x3 voxels, chunks are 4x4x4 voxels
+const int LevelDimensions[2][3] = { { 10, 8, 6 }, { 5, 4, 3 } };
+const int ChunkSize = 4;
+const unsigned short FillValue = 7;
+
+//---------------------------------------------------------------------------
+unsigned short VoxelValue(int level, int i, int j, int k)
+{
+  int scale = (level == 0 ? 1 : 2);
+  return static_cast<unsigned short>(i * scale + 10 * j * scale + 100 * k * scale);
+}
+
+//---------------------------------------------------------------------------
+void WriteTextFile(const std::string& fileName, const std::string& text)
+{
+  std::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary);
+  file << text;
+}
+
+//---------------------------------------------------------------------------
+/// Write a small two level OME-Zarr volume of uncompressed little endian
+/// unsigned short voxels. The chunk 1.1.2 of level 0 is not written.
+void WriteOMEZarr(const std::string& directory)
+{
+  vtksys::SystemTools::RemoveADirectory(directory);
+  vtksys::SystemTools::MakeDirectory(directory);
+  WriteTextFile(directory + "/.zgroup", "{\"zarr_format\": 2}");
+  WriteTextFile(directory + "/.zattrs",
+    "{\"multiscales\": [{\"version\": \"0.4\","
+    " \"axes\": [{\"name\": \"z\", \"type\": \"space\"}, {\"name\": \"y\", \"type\": \"space\"}, {\"name\": \"x\", \"type\": \"space\"}],"
+    " \"datasets\": ["
+    "  {\"path\": \"0\", \"coordinateTransformations\": [{\"type\": \"scale\", \"scale\": [3.0, 2.0, 1.0]}]},"
+    "  {\"path\": \"1\", \"coordinateTransformations\": [{\"type\": \"scale\", \"scale\": [6.0, 4.0, 2.0]},"
+    "    {\"type\": \"translation\", \"translation\": [1.5, 1.0, 0.5]}]}"
+    " ]}]}");
+  for (int level = 0; level < 2; ++level)
+    {
+    const int* dimensions = LevelDimensions[level];
+    std::string levelDirectory = directory + "/" + std::to_string(level);
+    vtksys::SystemTools::MakeDirectory(levelDirectory);
+    std::stringstream zarray;
+    zarray << "{\"zarr_format\": 2, \"shape\": [" << dimensions[2] << ", " << dimensions[1] << ", " << dimensions[0] << "],"
+      << " \"chunks\": [4, 4, 4], \"dtype\": \"<u2\", \"compressor\": null, \"fill_value\": " << FillValue << ","
+      << " \"order\": \"C\", \"filters\": null}";
+    WriteTextFile(levelDirectory + "/.zarray", zarray.str());
+    for (int tk = 0; tk * ChunkSize < dimensions[2]; ++tk)
+      {
+      for (int tj = 0; tj * ChunkSize < dimensions[1]; ++tj)
+        {
+        for (int ti = 0; ti * ChunkSize < dimensions[0]; ++ti)
+          {
+          if (level == 0 && tk == 1 && tj == 1 && ti == 2)
+            {
+            continue;
+            }
+          std::string chunkFileName = levelDirectory + "/"
+            + std::to_string(tk) + "." + std::to_string(tj) + "." + std::to_string(ti);
+          std::ofstream chunk(chunkFileName.c_str(), std::ios::out | std::ios::binary);
+          // chunks are always complete, also at the end of the array
+          for (int k = tk * ChunkSize; k < (tk + 1) * ChunkSize; ++k)
+            {
+            for (int j = tj * ChunkSize; j < (tj + 1) * ChunkSize; ++j)
+              {
+              for (int i = ti * ChunkSize; i < (ti + 1) * ChunkSize; ++i)
+                {
+                unsigned short value = VoxelValue(level, i, j, k);
+                chunk.put(static_cast<char>(value & 0xff));
+                chunk.put(static_cast<char>(value >> 8));
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+}
+
+//---------------------------------------------------------------------------
+int TestReadOMEZarr(const std::string& tempDir)
+{
+  std::string directory = tempDir + "/vtkMRMLOMEZarrStorageNodeTest1.ome.zarr";
+  WriteOMEZarr(directory);
+
+  vtkNew<vtkMRMLScene> scene;
+  vtkMRMLMultiResolutionVolumeNode* volumeNode = vtkMRMLMultiResolutionVolumeNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLMultiResolutionVolumeNode"));
+  CHECK_NOT_NULL(volumeNode);
+  vtkMRMLOMEZarrStorageNode* storageNode = vtkMRMLOMEZarrStorageNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLOMEZarrStorageNode"));
+  CHECK_NOT_NULL(storageNode);
+  volumeNode->SetAndObserveStorageNodeID(storageNode->GetID());
+  storageNode->SetFileName(directory.c_str());
+  // level 0 is too large to be the overview
+  storageNode->SetOverviewMaximumNumberOfVoxels(100);
+  CHECK_INT(storageNode->ReadData(volumeNode), 1);
+
+  // Pyramid
+  CHECK_INT(volumeNode->GetNumberOfLevels(), 2);
+  int dimensions[3] = { 0, 0, 0 };
+  CHECK_BOOL(volumeNode->GetLevelDimensions(0, dimensions), true);
+  CHECK_INT(dimensions[0], 10);
+  CHECK_INT(dimensions[1], 8);
+  CHECK_INT(dimensions[2], 6);
+  CHECK_BOOL(volumeNode->GetLevelTileDimensions(1, dimensions), true);
+  CHECK_INT(dimensions[0], 4);
+  CHECK_BOOL(volumeNode->GetLevelDimensions(2, dimensions), false);
+  double spacing[3] = { 0.0, 0.0, 0.0 };
+  CHECK_BOOL(volumeNode->GetLevelSpacing(0, spacing), true);
+  CHECK_DOUBLE(spacing[0], 1.0);
+  CHECK_DOUBLE(spacing[1], 2.0);
+  CHECK_DOUBLE(spacing[2], 3.0);
+  CHECK_INT(volumeNode->GetLevelForSpacing(0.5), 0);
+  CHECK_INT(volumeNode->GetLevelForSpacing(1.0), 0);
+  CHECK_INT(volumeNode->GetLevelForSpacing(2.5), 1);
+
+  // Overview is level 1, in LPS
+  vtkImageData* overview = volumeNode->GetImageData();
+  CHECK_NOT_NULL(overview);
+  overview->GetDimensions(dimensions);
+  CHECK_INT(dimensions[0], 5);
+  CHECK_INT(dimensions[1], 4);
+  CHECK_INT(dimensions[2], 3);
+  CHECK_INT(overview->GetScalarType(), VTK_UNSIGNED_SHORT);
+  CHECK_INT(static_cast<int>(overview->GetScalarComponentAsDouble(1, 2, 1, 0)), VoxelValue(1, 1, 2, 1));
+  CHECK_DOUBLE(volumeNode->GetSpacing()[0], 2.0);
+  CHECK_DOUBLE(volumeNode->GetSpacing()[2], 6.0);
+  CHECK_DOUBLE(volumeNode->GetOrigin()[0], -0.5);
+  CHECK_DOUBLE(volumeNode->GetOrigin()[1], -1.0);
+  CHECK_DOUBLE(volumeNode->GetOrigin()[2], 1.5);
+
+  // Region of level 0 across several tiles, including the missing chunk
+  CHECK_INT(volumeNode->GetNumberOfCachedTiles(), 2);
+  volumeNode->ResetTileCacheStatistics();
+  int extent[6] = { 3, 9, 2, 7, 1, 5 };
+  vtkNew<vtkImageData> region;
+  CHECK_INT(volumeNode->GetRegion(0, extent, region, true), 0);
+  int* regionExtent = region->GetExtent();
+  for (int i = 0; i < 6; ++i)
+    {
+    CHECK_INT(regionExtent[i], extent[i]);
+    }
+  CHECK_INT(static_cast<int>(region->GetScalarComponentAsDouble(3, 2, 1, 0)), VoxelValue(0, 3, 2, 1));
+  CHECK_INT(static_cast<int>(region->GetScalarComponentAsDouble(5, 6, 3, 0)), VoxelValue(0, 5, 6, 3));
+  CHECK_INT(static_cast<int>(region->GetScalarComponentAsDouble(9, 3, 5, 0)), VoxelValue(0, 9, 3, 5));
+  CHECK_INT(static_cast<int>(region->GetScalarComponentAsDouble(9, 7, 5, 0)), FillValue);
+  CHECK_INT(volumeNode->GetTileCacheMissCount(), 12);
+  CHECK_INT(volumeNode->GetNumberOfCachedTiles(), 14);
+
+  // Second request is served from the cache
+  CHECK_INT(volumeNode->GetRegion(0, extent, region, true), 0);
+  CHECK_INT(volumeNode->GetTileCacheHitCount(), 12);
+  CHECK_INT(volumeNode->GetTileCacheMissCount(), 12);
+
+  // Regions are clipped to the level
+  int outsideExtent[6] = { 8, 20, -5, 1, 0, 0 };
+  CHECK_INT(volumeNode->GetRegion(0, outsideExtent, region, true), 0);
+  CHECK_INT(region->GetExtent()[1], 9);
+  CHECK_INT(region->GetExtent()[2], 0);
+
+  volumeNode->ClearTileCache();
+  CHECK_INT(volumeNode->GetNumberOfCachedTiles(), 0);
+  CHECK_INT(static_cast<int>(volumeNode->GetTileCacheSizeInBytes()), 0);
+
+  // Without an application to notify the main thread, tiles are read synchronously
+  CHECK_INT(volumeNode->GetRegion(0, extent, region), 0);
+
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//---------------------------------------------------------------------------
+int vtkMRMLOMEZarrStorageNodeTest1(int argc, char * argv[] )
+{
+  if (argc != 2)
+    {
+    std::cerr << "Usage: " << argv[0] << " /path/to/temp" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  vtkNew<vtkMRMLOMEZarrStorageNode> node1;
+  EXERCISE_ALL_BASIC_MRML_METHODS(node1.GetPointer());
+
+  vtkNew<vtkMRMLMultiResolutionVolumeNode> volumeNode;
+  vtkNew<vtkMRMLScene> scene;
+  scene->AddNode(volumeNode.GetPointer());
+  EXERCISE_ALL_BASIC_MRML_METHODS(volumeNode.GetPointer());
+
+  CHECK_EXIT_SUCCESS(TestReadOMEZarr(argv[1]));
+  return EXIT_SUCCESS;
+}
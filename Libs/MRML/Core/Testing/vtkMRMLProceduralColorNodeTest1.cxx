@@ -14,11 +14,33 @@
 #include "vtkMRMLProceduralColorNode.h"
 #include "vtkMRMLScene.h"
 
+// VTK includes
+#include <vtkColorTransferFunction.h>
+#include <vtkLookupTable.h>
+
 int vtkMRMLProceduralColorNodeTest1(int , char * [] )
 {
   vtkNew<vtkMRMLProceduralColorNode> node1;
   vtkNew<vtkMRMLScene> scene;
   scene->AddNode(node1.GetPointer());
   EXERCISE_ALL_BASIC_MRML_METHODS(node1.GetPointer());
+
+  // Converted lookup table is only rebuilt if the transfer function or the table size changes
+  node1->GetColorTransferFunction()->AddRGBPoint(0.0, 0.0, 0.0, 0.0);
+  node1->GetColorTransferFunction()->AddRGBPoint(100.0, 1.0, 1.0, 1.0);
+  vtkLookupTable* lut = node1->GetLookupTable();
+  vtkMTimeType lutMTime = lut->GetMTime();
+  CHECK_POINTER(node1->GetLookupTable(), lut);
+  CHECK_INT(lut->GetMTime(), lutMTime);
+  CHECK_INT(lut->GetNumberOfTableValues(), 256);
+  node1->GetColorTransferFunction()->AddRGBPoint(50.0, 1.0, 0.0, 0.0);
+  node1->GetLookupTable();
+  CHECK_BOOL(lut->GetMTime() > lutMTime, true);
+  double color[3] = { 0.0, 0.0, 0.0 };
+  lut->GetColor(50.0, color);
+  CHECK_DOUBLE_TOLERANCE(color[1], 0.0, 0.01);
+  node1->SetNumberOfTableValues(16);
+  CHECK_INT(node1->GetLookupTable()->GetNumberOfTableValues(), 16);
+
   return EXIT_SUCCESS;
 }
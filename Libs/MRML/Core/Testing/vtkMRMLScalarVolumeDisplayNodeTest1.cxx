@@ -13,9 +13,85 @@
 #include "vtkMRMLCoreTestingMacros.h"
 #include "vtkMRMLScalarVolumeDisplayNode.h"
 
+// VTK includes
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkTrivialProducer.h>
+
+namespace
+{
+
+//---------------------------------------------------------------------------
+int TestAutoLevelsSampling()
+{
+  // Intensity is 10 * i, from 0 to 190
+  vtkNew<vtkImageData> imageData;
+  imageData->SetDimensions(20, 20, 20);
+  imageData->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  for (int k = 0; k < 20; ++k)
+    {
+    for (int j = 0; j < 20; ++j)
+      {
+      for (int i = 0; i < 20; ++i)
+        {
+        imageData->SetScalarComponentFromDouble(i, j, k, 0, 10. * i);
+        }
+      }
+    }
+  vtkNew<vtkTrivialProducer> producer;
+  producer->SetOutput(imageData);
+
+  vtkNew<vtkMRMLScalarVolumeDisplayNode> displayNode;
+  CHECK_INT(displayNode->GetAutoLevelsSampleCount(), 0);
+  displayNode->SetInputImageDataConnection(producer->GetOutputPort());
+  displayNode->AutoWindowLevelOn();
+  displayNode->Modified();
+  double fullMax = displayNode->GetWindowLevelMax();
+  CHECK_BOOL(fullMax > 180. && fullMax <= 191., true);
+
+  // Every other voxel along each axis, intensity is from 0 to 180
+  displayNode->SetAutoLevelsSampleCount(1000);
+  CHECK_INT(displayNode->GetAutoLevelsSampleCount(), 1000);
+  displayNode->Modified();
+  double sampledMax = displayNode->GetWindowLevelMax();
+  CHECK_BOOL(sampledMax > 170. && sampledMax <= 181., true);
+
+  // Cached range is used as long as the scalars are not modified
+  displayNode->SetAutoWindowLevel(0);
+  displayNode->SetWindowLevelMinMax(0., 1.);
+  displayNode->SetAutoWindowLevel(1);
+  CHECK_DOUBLE(displayNode->GetWindowLevelMax(), sampledMax);
+  displayNode->SetAutoLevelsSampleCount(0);
+  CHECK_DOUBLE(displayNode->GetWindowLevelMax(), fullMax);
+
+  // Modified scalars are not found in the cache, intensity is from 0 to 95
+  for (int i = 0; i < 20; ++i)
+    {
+    for (int k = 0; k < 20; ++k)
+      {
+      for (int j = 0; j < 20; ++j)
+        {
+        imageData->SetScalarComponentFromDouble(i, j, k, 0, 5. * i);
+        }
+      }
+    }
+  imageData->GetPointData()->GetScalars()->Modified();
+  displayNode->Modified();
+  CHECK_BOOL(displayNode->GetWindowLevelMax() < 100., true);
+  displayNode->ClearAutoLevelsCache();
+
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//---------------------------------------------------------------------------
 int vtkMRMLScalarVolumeDisplayNodeTest1(int , char * [] )
 {
   vtkNew<vtkMRMLScalarVolumeDisplayNode> node1;
   EXERCISE_ALL_BASIC_MRML_METHODS(node1.GetPointer());
+  CHECK_EXIT_SUCCESS(TestAutoLevelsSampling());
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,93 @@
+/*=auto=========================================================================
+
+Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH)
+All Rights Reserved.
+
+See COPYRIGHT.txt
+or http://www.slicer.org/copyright/copyright.txt for details.
+
+Program:   3D Slicer
+
+=========================================================================auto=*/
+
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLModelDisplayNode.h"
+#include "vtkMRMLModelNode.h"
+#include "vtkMRMLParser.h"
+#include "vtkMRMLScene.h"
+
+#include <vtkNew.h>
+
+//---------------------------------------------------------------------------
+int vtkMRMLSceneBinaryFormatTest(int argc, char * argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " /path/to/temp" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char* tempDir = argv[1];
+  std::string xmlSceneFileName = std::string(tempDir) + "/vtkMRMLSceneBinaryFormatTest_xml.mrml";
+  std::string binarySceneFileName = std::string(tempDir) + "/vtkMRMLSceneBinaryFormatTest_binary.mrml";
+  const std::string specialAttributeValue = "<special & \"characters\" 'in' value>";
+  const int numberOfModels = 10;
+
+  // Write the same scene in XML and binary format
+  {
+    vtkNew<vtkMRMLScene> scene;
+    for (int modelIndex = 0; modelIndex < numberOfModels; ++modelIndex)
+      {
+      vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLModelNode"));
+      CHECK_NOT_NULL(modelNode);
+      modelNode->CreateDefaultDisplayNodes();
+      modelNode->SetAttribute("TestAttribute", specialAttributeValue.c_str());
+      modelNode->GetDisplayNode()->SetOpacity(0.1 * modelIndex);
+      }
+    scene->SetURL(xmlSceneFileName.c_str());
+    CHECK_INT(scene->Commit(), 1);
+    scene->WriteSceneInBinaryFormatOn();
+    scene->SetURL(binarySceneFileName.c_str());
+    CHECK_INT(scene->Commit(), 1);
+  }
+  CHECK_BOOL(vtkMRMLParser::IsBinarySceneFile(xmlSceneFileName.c_str()), false);
+  CHECK_BOOL(vtkMRMLParser::IsBinarySceneFile(binarySceneFileName.c_str()), true);
+
+  // Read both scenes and compare them
+  vtkNew<vtkMRMLScene> xmlScene;
+  xmlScene->SetURL(xmlSceneFileName.c_str());
+  CHECK_INT(xmlScene->Import(), 1);
+  vtkNew<vtkMRMLScene> binaryScene;
+  binaryScene->SetURL(binarySceneFileName.c_str());
+  CHECK_INT(binaryScene->Import(), 1);
+
+  CHECK_INT(binaryScene->GetNumberOfNodes(), xmlScene->GetNumberOfNodes());
+  CHECK_INT(binaryScene->GetNumberOfNodesByClass("vtkMRMLModelNode"), numberOfModels);
+  for (int nodeIndex = 0; nodeIndex < xmlScene->GetNumberOfNodes(); ++nodeIndex)
+    {
+    vtkMRMLNode* xmlNode = xmlScene->GetNthNode(nodeIndex);
+    vtkMRMLNode* binaryNode = binaryScene->GetNodeByID(xmlNode->GetID());
+    CHECK_NOT_NULL(binaryNode);
+    CHECK_STRING(binaryNode->GetClassName(), xmlNode->GetClassName());
+    CHECK_STRING(binaryNode->GetName(), xmlNode->GetName());
+    }
+  vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(binaryScene->GetFirstNodeByClass("vtkMRMLModelNode"));
+  CHECK_NOT_NULL(modelNode);
+  CHECK_STD_STRING(modelNode->GetAttribute("TestAttribute"), specialAttributeValue);
+  vtkMRMLModelNode* lastModelNode = vtkMRMLModelNode::SafeDownCast(
+    binaryScene->GetNthNodeByClass(numberOfModels - 1, "vtkMRMLModelNode"));
+  CHECK_NOT_NULL(lastModelNode);
+  CHECK_NOT_NULL(lastModelNode->GetDisplayNode());
+  CHECK_DOUBLE(lastModelNode->GetDisplayNode()->GetOpacity(), 0.1 * (numberOfModels - 1));
+
+  // Invalid binary data is rejected
+  vtkNew<vtkMRMLParser> parser;
+  parser->SetMRMLScene(binaryScene);
+  std::string truncatedData(vtkMRMLParser::GetBinarySceneSignature(), 12);
+  truncatedData += "S";
+  TESTING_OUTPUT_ASSERT_ERRORS_BEGIN();
+  CHECK_INT(parser->ParseBinary(truncatedData.c_str(), truncatedData.size()), 0);
+  TESTING_OUTPUT_ASSERT_ERRORS_END();
+
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
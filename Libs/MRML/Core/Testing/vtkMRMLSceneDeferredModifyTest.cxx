@@ -0,0 +1,165 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH) All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   3D Slicer
+
+=========================================================================auto=*/
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLNode.h"
+#include "vtkMRMLScene.h"
+#include "vtkMRMLSceneEventRecorder.h"
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkCollection.h>
+#include <vtkNew.h>
+
+// STD includes
+#include <vector>
+
+namespace
+{
+
+struct ModifiedRecord
+{
+  vtkMRMLScene* Scene{nullptr};
+  int NodeModifiedCount{0};
+  int NodeModifiedWhileInvokingDeferredEventsCount{0};
+  int CustomModifiedCount{0};
+  int NodesModifiedCount{0};
+  int NumberOfModifiedNodes{0};
+};
+
+//---------------------------------------------------------------------------
+void NodeModifiedCallback(vtkObject* vtkNotUsed(caller), unsigned long eid,
+  void* clientData, void* vtkNotUsed(callData))
+{
+  ModifiedRecord* record = reinterpret_cast<ModifiedRecord*>(clientData);
+  if (eid == vtkCommand::UserEvent)
+    {
+    ++record->CustomModifiedCount;
+    return;
+    }
+  ++record->NodeModifiedCount;
+  if (record->Scene->GetInvokingDeferredModifiedEvents())
+    {
+    ++record->NodeModifiedWhileInvokingDeferredEventsCount;
+    }
+}
+
+//---------------------------------------------------------------------------
+void NodesModifiedCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+  void* clientData, void* callData)
+{
+  ModifiedRecord* record = reinterpret_cast<ModifiedRecord*>(clientData);
+  vtkCollection* modifiedNodes = reinterpret_cast<vtkCollection*>(callData);
+  ++record->NodesModifiedCount;
+  record->NumberOfModifiedNodes = modifiedNodes ? modifiedNodes->GetNumberOfItems() : -1;
+}
+
+} // end of anonymous namespace
+
+//---------------------------------------------------------------------------
+int vtkMRMLSceneDeferredModifyTest(int vtkNotUsed(argc), char * vtkNotUsed(argv)[])
+{
+  vtkNew<vtkMRMLScene> scene;
+  ModifiedRecord record;
+  record.Scene = scene;
+
+  vtkNew<vtkCallbackCommand> nodeCallback;
+  nodeCallback->SetCallback(NodeModifiedCallback);
+  nodeCallback->SetClientData(&record);
+  vtkNew<vtkCallbackCommand> sceneCallback;
+  sceneCallback->SetCallback(NodesModifiedCallback);
+  sceneCallback->SetClientData(&record);
+  scene->AddObserver(vtkMRMLScene::NodesModifiedEvent, sceneCallback);
+  vtkNew<vtkMRMLSceneEventRecorder> sceneEventRecorder;
+  scene->AddObserver(vtkCommand::AnyEvent, sceneEventRecorder);
+
+  const int numberOfNodes = 100;
+  std::vector<vtkMRMLNode*> nodes;
+  for (int nodeIndex = 0; nodeIndex < numberOfNodes; ++nodeIndex)
+    {
+    vtkMRMLNode* node = scene->AddNewNodeByClass("vtkMRMLScriptedModuleNode");
+    CHECK_NOT_NULL(node);
+    node->AddObserver(vtkCommand::ModifiedEvent, nodeCallback);
+    node->AddObserver(vtkCommand::UserEvent, nodeCallback);
+    nodes.push_back(node);
+    }
+  sceneEventRecorder->CalledEvents.clear();
+
+  // Modified events are not invoked while the scene is in DeferredModify state
+  CHECK_BOOL(scene->IsDeferringModifiedEvents(), false);
+  scene->StartState(vtkMRMLScene::DeferredModifyState);
+  CHECK_BOOL(scene->IsDeferringModifiedEvents(), true);
+  CHECK_BOOL(scene->IsBatchProcessing(), false);
+  CHECK_INT(sceneEventRecorder->CalledEvents[vtkMRMLScene::StartDeferredModifyEvent], 1);
+  for (vtkMRMLNode* node : nodes)
+    {
+    node->SetName("modified");
+    node->SetDescription("modified");
+    node->SetAttribute("modified", "yes");
+    node->InvokeCustomModifiedEvent(vtkCommand::UserEvent);
+    }
+  CHECK_INT(record.NodeModifiedCount, 0);
+  CHECK_INT(record.CustomModifiedCount, 0);
+
+  // StartModify/EndModify blocks do not invoke the events either
+  int wasModifying = nodes[0]->StartModify();
+  nodes[0]->SetName("modified again");
+  nodes[0]->EndModify(wasModifying);
+  CHECK_INT(record.NodeModifiedCount, 0);
+
+  // Nested state does not invoke the events
+  scene->StartState(vtkMRMLScene::DeferredModifyState);
+  nodes[1]->SetName("modified again");
+  scene->EndState(vtkMRMLScene::DeferredModifyState);
+  CHECK_BOOL(scene->IsDeferringModifiedEvents(), true);
+  CHECK_INT(record.NodeModifiedCount, 0);
+  CHECK_INT(record.NodesModifiedCount, 0);
+
+  // Deleted nodes are not reported
+  scene->RemoveNode(nodes.back());
+  nodes.pop_back();
+
+  // Each node invokes its modified events once, then all the nodes are reported at once
+  scene->EndState(vtkMRMLScene::DeferredModifyState);
+  CHECK_BOOL(scene->IsDeferringModifiedEvents(), false);
+  CHECK_BOOL(scene->GetInvokingDeferredModifiedEvents(), false);
+  CHECK_INT(record.NodeModifiedCount, numberOfNodes - 1);
+  CHECK_INT(record.NodeModifiedWhileInvokingDeferredEventsCount, numberOfNodes - 1);
+  CHECK_INT(record.CustomModifiedCount, numberOfNodes - 1);
+  CHECK_INT(record.NodesModifiedCount, 1);
+  CHECK_INT(record.NumberOfModifiedNodes, numberOfNodes - 1);
+  CHECK_INT(sceneEventRecorder->CalledEvents[vtkMRMLScene::EndDeferredModifyEvent], 1);
+  CHECK_INT(sceneEventRecorder->CalledEvents[vtkMRMLScene::EndBatchProcessEvent], 0);
+
+  // Events are invoked immediately when the scene is not in DeferredModify state
+  nodes[0]->SetName("modified immediately");
+  CHECK_INT(record.NodeModifiedCount, numberOfNodes);
+  CHECK_INT(record.NodeModifiedWhileInvokingDeferredEventsCount, numberOfNodes - 1);
+
+  // Nodes that are still in a StartModify block invoke their events in EndModify
+  scene->StartState(vtkMRMLScene::DeferredModifyState);
+  wasModifying = nodes[0]->StartModify();
+  nodes[0]->SetName("modified in deferred state");
+  scene->EndState(vtkMRMLScene::DeferredModifyState);
+  CHECK_INT(record.NodeModifiedCount, numberOfNodes);
+  CHECK_INT(record.NodesModifiedCount, 2);
+  CHECK_INT(record.NumberOfModifiedNodes, 1);
+  nodes[0]->EndModify(wasModifying);
+  CHECK_INT(record.NodeModifiedCount, numberOfNodes + 1);
+
+  // Nothing is reported if no node is modified
+  scene->StartState(vtkMRMLScene::DeferredModifyState);
+  scene->EndState(vtkMRMLScene::DeferredModifyState);
+  CHECK_INT(record.NodesModifiedCount, 2);
+
+  return EXIT_SUCCESS;
+}
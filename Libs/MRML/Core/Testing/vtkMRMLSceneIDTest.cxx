@@ -26,9 +26,11 @@
 // VTK includes
 #include <vtkCallbackCommand.h>
 #include <vtkNew.h>
+#include <vtkTimerLog.h>
 
 // STD includes
 #include <iostream>
+#include <set>
 
 //---------------------------------------------------------------------------
 int vtkMRMLSceneIDTest(
@@ -189,5 +191,42 @@ int vtkMRMLSceneIDTest(
     return EXIT_FAILURE;
     }
 
+  //---------------------------------------------------------------------------
+  // Performance of adding many nodes with the same name
+  // (for example, many DICOM series with the same series description)
+  //---------------------------------------------------------------------------
+  vtkNew<vtkMRMLScene> largeScene;
+  largeScene->SetUndoOn();
+  const int numberOfNodes = 10000;
+  std::set<std::string> nodeNames;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  for (int i = 0; i < numberOfNodes; ++i)
+    {
+    vtkNew<vtkMRMLModelNode> modelNode;
+    modelNode->SetName(largeScene->GenerateUniqueName("Series description").c_str());
+    largeScene->AddNode(modelNode.GetPointer());
+    nodeNames.insert(modelNode->GetName());
+    }
+  timer->StopTimer();
+  std::cout << "<DartMeasurement name=\"vtkMRMLScene-AddNodesWithSameNamePerformance-"
+            << numberOfNodes << "\" type=\"numeric/double\">"
+            << timer->GetElapsedTime() << "</DartMeasurement>" << std::endl;
+  if (static_cast<int>(nodeNames.size()) != numberOfNodes)
+    {
+    std::cerr << __LINE__ << " GenerateUniqueName failed: generated "
+              << nodeNames.size() << " unique names for " << numberOfNodes << " nodes" << std::endl;
+    return EXIT_FAILURE;
+    }
+  // Generous time budget, it takes a fraction of this on a typical computer.
+  // If unique name or ID generation becomes quadratic then it takes much longer.
+  const double maximumElapsedTime = 10.0;
+  if (timer->GetElapsedTime() > maximumElapsedTime)
+    {
+    std::cerr << __LINE__ << " Adding " << numberOfNodes << " nodes with the same name took "
+              << timer->GetElapsedTime() << "s, more than " << maximumElapsedTime << "s" << std::endl;
+    return EXIT_FAILURE;
+    }
+
   return EXIT_SUCCESS;
 }
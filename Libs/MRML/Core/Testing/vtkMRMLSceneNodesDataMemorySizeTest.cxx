@@ -0,0 +1,76 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLScalarVolumeNode.h"
+#include "vtkMRMLScene.h"
+#include "vtkMRMLSequenceNode.h"
+#include "vtkMRMLTableNode.h"
+#include "vtkMRMLTextNode.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkNew.h>
+
+//------------------------------------------------------------------------------
+int vtkMRMLSceneNodesDataMemorySizeTest(int , char * [] )
+{
+  vtkNew<vtkMRMLScene> scene;
+  CHECK_INT(static_cast<int>(scene->GetNodesDataMemorySize()), 0);
+
+  // Nodes without bulk data
+  vtkMRMLTextNode* textNode = vtkMRMLTextNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLTextNode"));
+  CHECK_NOT_NULL(textNode);
+  textNode->SetText("some text");
+  CHECK_INT(static_cast<int>(textNode->GetDataMemorySize()), 0);
+
+  // Volume node: 64x64x64 voxels, 2 bytes each = 512 kilobytes
+  vtkMRMLScalarVolumeNode* volumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLScalarVolumeNode"));
+  CHECK_NOT_NULL(volumeNode);
+  vtkNew<vtkImageData> imageData;
+  imageData->SetDimensions(64, 64, 64);
+  imageData->AllocateScalars(VTK_SHORT, 1);
+  volumeNode->SetAndObserveImageData(imageData);
+  unsigned long volumeMemorySize = volumeNode->GetDataMemorySize();
+  CHECK_BOOL(volumeMemorySize >= 512, true);
+  CHECK_BOOL(volumeMemorySize < 600, true);
+
+  // Table node
+  vtkMRMLTableNode* tableNode = vtkMRMLTableNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLTableNode"));
+  CHECK_NOT_NULL(tableNode);
+  unsigned long tableMemorySize = tableNode->GetDataMemorySize();
+
+  CHECK_INT(static_cast<int>(scene->GetNodesDataMemorySize()), static_cast<int>(volumeMemorySize + tableMemorySize));
+  CHECK_INT(static_cast<int>(scene->GetNodesDataMemorySize("vtkMRMLVolumeNode")), static_cast<int>(volumeMemorySize));
+  CHECK_INT(static_cast<int>(scene->GetNodesDataMemorySize("vtkMRMLTextNode")), 0);
+
+  // Sequence node: sum of all items
+  vtkMRMLSequenceNode* sequenceNode = vtkMRMLSequenceNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLSequenceNode"));
+  CHECK_NOT_NULL(sequenceNode);
+  sequenceNode->SetDataNodeAtValue(volumeNode, "0");
+  sequenceNode->SetDataNodeAtValue(volumeNode, "1");
+  sequenceNode->SetDataNodeAtValue(volumeNode, "2");
+  CHECK_INT(static_cast<int>(sequenceNode->GetDataMemorySize()), static_cast<int>(3 * volumeMemorySize));
+  sequenceNode->RemoveDataNodeAtValue("1");
+  CHECK_INT(static_cast<int>(sequenceNode->GetDataMemorySize()), static_cast<int>(2 * volumeMemorySize));
+
+  // Removing the image data releases its memory
+  volumeNode->SetAndObserveImageData(nullptr);
+  CHECK_INT(static_cast<int>(volumeNode->GetDataMemorySize()), 0);
+
+  return EXIT_SUCCESS;
+}
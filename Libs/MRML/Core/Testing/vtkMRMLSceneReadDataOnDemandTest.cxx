@@ -0,0 +1,307 @@
+/*=auto=========================================================================
+
+Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH)
+All Rights Reserved.
+
+See COPYRIGHT.txt
+or http://www.slicer.org/copyright/copyright.txt for details.
+
+Program:   3D Slicer
+
+=========================================================================auto=*/
+
+#include "vtkCacheManager.h"
+#include "vtkDataIOManager.h"
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLModelDisplayNode.h"
+#include "vtkMRMLModelNode.h"
+#include "vtkMRMLModelStorageNode.h"
+#include "vtkMRMLScalarVolumeNode.h"
+#include "vtkMRMLScene.h"
+#include "vtkMRMLSequenceNode.h"
+#include "vtkMRMLSequenceStorageNode.h"
+#include "vtkMRMLVolumeArchetypeStorageNode.h"
+
+#include <vtkCylinderSource.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+//---------------------------------------------------------------------------
+int vtkMRMLSceneReadDataOnDemandTest(int argc, char * argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " /path/to/temp" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char* tempDir = argv[1];
+  std::string sceneFileName = std::string(tempDir) + "/vtkMRMLSceneReadDataOnDemandTest.mrml";
+
+  // Save a scene that contains two models
+  vtkNew<vtkCylinderSource> cylinderSource;
+  cylinderSource->Update();
+  int numberOfPoints = cylinderSource->GetOutput()->GetNumberOfPoints();
+  CHECK_BOOL(numberOfPoints > 0, true);
+  {
+    vtkNew<vtkMRMLScene> scene;
+    scene->SetRootDirectory(tempDir);
+    scene->SetURL(sceneFileName.c_str());
+    for (int modelIndex = 0; modelIndex < 2; ++modelIndex)
+      {
+      vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLModelNode"));
+      CHECK_NOT_NULL(modelNode);
+      modelNode->SetAndObservePolyData(cylinderSource->GetOutput());
+      modelNode->CreateDefaultDisplayNodes();
+      modelNode->GetDisplayNode()->SetVisibility(false);
+      CHECK_BOOL(modelNode->AddDefaultStorageNode(), true);
+      std::string modelFileName = std::string(tempDir) + "/vtkMRMLSceneReadDataOnDemandTest"
+        + (modelIndex == 0 ? "0" : "1") + ".vtk";
+      modelNode->GetStorageNode()->SetFileName(modelFileName.c_str());
+      CHECK_BOOL(modelNode->GetStorageNode()->WriteData(modelNode), true);
+      }
+    CHECK_BOOL(scene->Commit() != 0, true);
+  }
+
+  // Read scene with deferred data reading
+  vtkNew<vtkMRMLScene> scene;
+  scene->SetRootDirectory(tempDir);
+  scene->SetURL(sceneFileName.c_str());
+  scene->ReadDataOnDemandOn();
+  CHECK_BOOL(scene->Import() != 0, true);
+
+  vtkCollection* modelNodes = scene->GetNodesByClass("vtkMRMLModelNode");
+  CHECK_INT(modelNodes->GetNumberOfItems(), 2);
+  vtkMRMLModelNode* modelNode0 = vtkMRMLModelNode::SafeDownCast(modelNodes->GetItemAsObject(0));
+  vtkMRMLModelNode* modelNode1 = vtkMRMLModelNode::SafeDownCast(modelNodes->GetItemAsObject(1));
+  modelNodes->Delete();
+  CHECK_NOT_NULL(modelNode0);
+  CHECK_NOT_NULL(modelNode1);
+  CHECK_BOOL(modelNode0->GetDataReadPending(), true);
+  CHECK_BOOL(modelNode1->GetDataReadPending(), true);
+  CHECK_BOOL(modelNode0->GetModifiedSinceRead(), false);
+
+  // Data is read at first access
+  CHECK_NOT_NULL(modelNode0->GetPolyData());
+  CHECK_INT(modelNode0->GetPolyData()->GetNumberOfPoints(), numberOfPoints);
+  CHECK_BOOL(modelNode0->GetDataReadPending(), false);
+  CHECK_BOOL(modelNode0->GetModifiedSinceRead(), false);
+  CHECK_BOOL(modelNode1->GetDataReadPending(), true);
+
+  // Data is read when the model is shown
+  CHECK_NOT_NULL(modelNode1->GetDisplayNode());
+  modelNode1->GetDisplayNode()->SetVisibility(true);
+  CHECK_BOOL(modelNode1->GetDataReadPending(), false);
+  CHECK_NOT_NULL(modelNode1->GetPolyData());
+  CHECK_INT(modelNode1->GetPolyData()->GetNumberOfPoints(), numberOfPoints);
+
+  // Reading with the scene option disabled reads all data immediately
+  vtkNew<vtkMRMLScene> scene2;
+  scene2->SetRootDirectory(tempDir);
+  scene2->SetURL(sceneFileName.c_str());
+  CHECK_BOOL(scene2->Import() != 0, true);
+  vtkMRMLModelNode* modelNode2 = vtkMRMLModelNode::SafeDownCast(scene2->GetFirstNodeByClass("vtkMRMLModelNode"));
+  CHECK_NOT_NULL(modelNode2);
+  CHECK_BOOL(modelNode2->GetDataReadPending(), false);
+
+  // Read all pending data at once
+  vtkNew<vtkMRMLScene> scene3;
+  scene3->SetRootDirectory(tempDir);
+  scene3->SetURL(sceneFileName.c_str());
+  scene3->ReadDataOnDemandOn();
+  scene3->PrefetchDataOnDemandOff();
+  CHECK_BOOL(scene3->Import() != 0, true);
+  CHECK_BOOL(scene3->ReadPendingData(), true);
+  vtkMRMLModelNode* modelNode3 = vtkMRMLModelNode::SafeDownCast(scene3->GetFirstNodeByClass("vtkMRMLModelNode"));
+  CHECK_NOT_NULL(modelNode3);
+  CHECK_BOOL(modelNode3->GetDataReadPending(), false);
+  CHECK_INT(modelNode3->GetPolyData()->GetNumberOfPoints(), numberOfPoints);
+
+  // Read data in parallel during import
+  vtkNew<vtkMRMLScene> scene4;
+  scene4->SetRootDirectory(tempDir);
+  scene4->SetURL(sceneFileName.c_str());
+  scene4->ReadDataInParallelOn();
+  CHECK_BOOL(scene4->Import() != 0, true);
+  CHECK_BOOL(scene4->GetReadDataOnDemand(), false);
+  modelNodes = scene4->GetNodesByClass("vtkMRMLModelNode");
+  CHECK_INT(modelNodes->GetNumberOfItems(), 2);
+  for (int modelIndex = 0; modelIndex < 2; ++modelIndex)
+    {
+    vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(modelNodes->GetItemAsObject(modelIndex));
+    CHECK_NOT_NULL(modelNode);
+    CHECK_BOOL(modelNode->GetDataReadPending(), false);
+    CHECK_NOT_NULL(modelNode->GetPolyData());
+    CHECK_INT(modelNode->GetPolyData()->GetNumberOfPoints(), numberOfPoints);
+    CHECK_BOOL(modelNode->GetModifiedSinceRead(), false);
+    }
+  modelNodes->Delete();
+
+  // Read scene bundle, data files are extracted from the bundle on demand
+  std::string bundleFileName = std::string(tempDir) + "/vtkMRMLSceneReadDataOnDemandTest.mrb";
+  CHECK_BOOL(scene4->WriteToMRB(bundleFileName.c_str()), true);
+  vtkNew<vtkCacheManager> cacheManager;
+  cacheManager->SetRemoteCacheDirectory(tempDir);
+  vtkNew<vtkDataIOManager> dataIOManager;
+  dataIOManager->SetCacheManager(cacheManager);
+  vtkNew<vtkMRMLScene> scene5;
+  scene5->SetDataIOManager(dataIOManager);
+  scene5->ReadDataOnDemandOn();
+  scene5->PrefetchDataOnDemandOff();
+  CHECK_BOOL(scene5->ReadFromMRB(bundleFileName.c_str(), true), true);
+  modelNodes = scene5->GetNodesByClass("vtkMRMLModelNode");
+  CHECK_INT(modelNodes->GetNumberOfItems(), 2);
+  vtkMRMLModelNode* bundleModelNode0 = vtkMRMLModelNode::SafeDownCast(modelNodes->GetItemAsObject(0));
+  vtkMRMLModelNode* bundleModelNode1 = vtkMRMLModelNode::SafeDownCast(modelNodes->GetItemAsObject(1));
+  modelNodes->Delete();
+  CHECK_NOT_NULL(bundleModelNode0);
+  CHECK_NOT_NULL(bundleModelNode1);
+  CHECK_BOOL(bundleModelNode0->GetDataReadPending(), true);
+  CHECK_BOOL(bundleModelNode1->GetDataReadPending(), true);
+  CHECK_NOT_NULL(bundleModelNode0->GetPolyData());
+  CHECK_INT(bundleModelNode0->GetPolyData()->GetNumberOfPoints(), numberOfPoints);
+  // file names point to the bundle location
+  CHECK_BOOL(std::string(bundleModelNode0->GetStorageNode()->GetFileName()).compare(0, 5, "Data/") == 0, true);
+  // data can be read from the bundle again while it is open
+  CHECK_BOOL(bundleModelNode0->GetModifiedSinceRead(), false);
+  CHECK_BOOL(bundleModelNode1->GetDataReadPending(), true);
+  // closing the bundle reads the remaining data
+  scene5->CloseBundle();
+  CHECK_BOOL(bundleModelNode1->GetDataReadPending(), false);
+  // data is not stored in any file after the bundle is closed
+  CHECK_BOOL(bundleModelNode0->GetModifiedSinceRead(), true);
+  CHECK_BOOL(bundleModelNode0->ReleaseData(), false);
+  CHECK_NOT_NULL(bundleModelNode1->GetPolyData());
+  CHECK_INT(bundleModelNode1->GetPolyData()->GetNumberOfPoints(), numberOfPoints);
+
+  // Read sequence bundle, data nodes are read on demand and data of least recently used nodes is released
+  std::string sequenceFileName = std::string(tempDir) + "/vtkMRMLSceneReadDataOnDemandTest.seq.mrb";
+  const int numberOfFrames = 3;
+  {
+    vtkNew<vtkMRMLScene> sequenceWriteScene;
+    vtkMRMLSequenceNode* sequenceNode = vtkMRMLSequenceNode::SafeDownCast(
+      sequenceWriteScene->AddNewNodeByClass("vtkMRMLSequenceNode"));
+    CHECK_NOT_NULL(sequenceNode);
+    vtkNew<vtkMRMLModelNode> frameNode;
+    frameNode->SetName("Frame");
+    frameNode->SetAndObservePolyData(cylinderSource->GetOutput());
+    for (int frameIndex = 0; frameIndex < numberOfFrames; ++frameIndex)
+      {
+      CHECK_NOT_NULL(sequenceNode->SetDataNodeAtValue(frameNode, std::to_string(frameIndex)));
+      }
+    vtkNew<vtkMRMLSequenceStorageNode> sequenceStorageNode;
+    sequenceWriteScene->AddNode(sequenceStorageNode);
+    sequenceStorageNode->SetFileName(sequenceFileName.c_str());
+    CHECK_BOOL(sequenceStorageNode->WriteData(sequenceNode) != 0, true);
+  }
+  vtkNew<vtkMRMLScene> scene6;
+  scene6->SetDataIOManager(dataIOManager);
+  scene6->ReadDataOnDemandOn();
+  scene6->PrefetchDataOnDemandOff();
+  vtkMRMLSequenceNode* sequenceNode = vtkMRMLSequenceNode::SafeDownCast(scene6->AddNewNodeByClass("vtkMRMLSequenceNode"));
+  CHECK_NOT_NULL(sequenceNode);
+  vtkNew<vtkMRMLSequenceStorageNode> sequenceStorageNode;
+  scene6->AddNode(sequenceStorageNode);
+  sequenceStorageNode->SetFileName(sequenceFileName.c_str());
+  CHECK_BOOL(sequenceStorageNode->ReadData(sequenceNode) != 0, true);
+  CHECK_INT(sequenceNode->GetNumberOfDataNodes(), numberOfFrames);
+  sequenceNode->SetMaximumNumberOfLoadedDataNodes(1);
+  vtkMRMLModelNode* frameNode0 = vtkMRMLModelNode::SafeDownCast(sequenceNode->GetNthDataNode(0));
+  CHECK_NOT_NULL(frameNode0);
+  CHECK_BOOL(frameNode0->GetDataReadPending(), true);
+  CHECK_INT(frameNode0->GetPolyData()->GetNumberOfPoints(), numberOfPoints);
+  CHECK_BOOL(frameNode0->GetDataReadPending(), false);
+  vtkMRMLModelNode* frameNode1 = vtkMRMLModelNode::SafeDownCast(sequenceNode->GetDataNodeAtValue("1"));
+  CHECK_NOT_NULL(frameNode1);
+  CHECK_INT(frameNode1->GetPolyData()->GetNumberOfPoints(), numberOfPoints);
+  // data of the least recently used data node is released, it was not edited since read from the bundle
+  CHECK_BOOL(frameNode0->GetDataReadPending(), true);
+  CHECK_BOOL(frameNode1->GetModifiedSinceRead(), false);
+  CHECK_BOOL(frameNode1->GetDataReadPending(), false);
+  // released data is read from the bundle again
+  CHECK_POINTER(sequenceNode->GetNthDataNode(0), frameNode0);
+  CHECK_INT(frameNode0->GetPolyData()->GetNumberOfPoints(), numberOfPoints);
+  CHECK_BOOL(frameNode1->GetDataReadPending(), true);
+  CHECK_BOOL(frameNode0->GetModifiedSinceRead(), false);
+  // data that was modified after it was read from the bundle is not released
+  double modifiedPoint[3] = { 100.0, 200.0, 300.0 };
+  frameNode0->GetPolyData()->GetPoints()->SetPoint(0, modifiedPoint);
+  frameNode0->GetPolyData()->GetPoints()->Modified();
+  CHECK_BOOL(frameNode0->GetModifiedSinceRead(), true);
+  CHECK_BOOL(frameNode0->ReleaseData(), false);
+  CHECK_BOOL(frameNode0->GetDataReadPending(), false);
+  CHECK_POINTER(sequenceNode->GetNthDataNode(1), frameNode1);
+  CHECK_INT(frameNode1->GetPolyData()->GetNumberOfPoints(), numberOfPoints);
+  // least recently used node is not released by the sequence either
+  CHECK_BOOL(frameNode0->GetDataReadPending(), false);
+  CHECK_DOUBLE(frameNode0->GetPolyData()->GetPoint(0)[0], modifiedPoint[0]);
+  // data that cannot be read again is not released
+  sequenceNode->SetMaximumNumberOfLoadedDataNodes(0);
+  frameNode0->SetAndObservePolyData(cylinderSource->GetOutput());
+  frameNode0->GetStorageNode()->SetFileName("NotInBundle.vtk");
+  CHECK_BOOL(frameNode0->ReleaseData(), false);
+  CHECK_BOOL(frameNode0->GetDataReadPending(), false);
+
+  // Volumes that cannot be read from file again are compressed in memory instead of being released
+  vtkNew<vtkMRMLSequenceNode> volumeSequenceNode;
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(32, 32, 32);
+  image->AllocateScalars(VTK_SHORT, 1);
+  short* voxels = static_cast<short*>(image->GetScalarPointer());
+  for (vtkIdType voxelIndex = 0; voxelIndex < image->GetNumberOfPoints(); ++voxelIndex)
+    {
+    voxels[voxelIndex] = static_cast<short>(voxelIndex % 7);
+    }
+  vtkNew<vtkMRMLScalarVolumeNode> volumeFrameNode;
+  volumeFrameNode->SetAndObserveImageData(image);
+  for (int frameIndex = 0; frameIndex < 2; ++frameIndex)
+    {
+    CHECK_NOT_NULL(volumeSequenceNode->SetDataNodeAtValue(volumeFrameNode, std::to_string(frameIndex)));
+    }
+  volumeSequenceNode->SetMaximumNumberOfLoadedDataNodes(1);
+  volumeSequenceNode->SetCompressDataNodesInMemory(true);
+  vtkMRMLScalarVolumeNode* volumeFrameNode0 = vtkMRMLScalarVolumeNode::SafeDownCast(volumeSequenceNode->GetNthDataNode(0));
+  CHECK_NOT_NULL(volumeFrameNode0);
+  CHECK_NOT_NULL(volumeSequenceNode->GetNthDataNode(1));
+  CHECK_BOOL(volumeFrameNode0->GetDataCompressedInMemory(), true);
+  // compressed data is not stored in any file
+  CHECK_BOOL(volumeFrameNode0->GetModifiedSinceRead(), true);
+  // compressed data is restored on access
+  CHECK_NOT_NULL(volumeFrameNode0->GetImageData());
+  CHECK_BOOL(volumeFrameNode0->GetDataCompressedInMemory(), false);
+  CHECK_INT(volumeFrameNode0->GetImageData()->GetNumberOfPoints(), image->GetNumberOfPoints());
+  CHECK_INT(volumeFrameNode0->GetImageData()->GetScalarComponentAsDouble(5, 3, 2, 0), (5 + 3 * 32 + 2 * 32 * 32) % 7);
+
+  // Compression replaces the image data of the node instead of modifying it,
+  // and does not make a volume that is stored in a file modified since read
+  vtkMRMLScalarVolumeNode* storedVolumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLScalarVolumeNode"));
+  CHECK_NOT_NULL(storedVolumeNode);
+  storedVolumeNode->SetAndObserveImageData(image);
+  vtkMRMLVolumeArchetypeStorageNode* volumeStorageNode = vtkMRMLVolumeArchetypeStorageNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLVolumeArchetypeStorageNode"));
+  CHECK_NOT_NULL(volumeStorageNode);
+  storedVolumeNode->SetAndObserveStorageNodeID(volumeStorageNode->GetID());
+  std::string volumeFileName = std::string(tempDir) + "/vtkMRMLSceneReadDataOnDemandTest.nrrd";
+  volumeStorageNode->SetFileName(volumeFileName.c_str());
+  CHECK_BOOL(volumeStorageNode->WriteData(storedVolumeNode) != 0, true);
+  CHECK_BOOL(storedVolumeNode->GetModifiedSinceRead(), false);
+  CHECK_BOOL(storedVolumeNode->CompressDataInMemory(), true);
+  CHECK_BOOL(storedVolumeNode->GetDataCompressedInMemory(), true);
+  CHECK_BOOL(storedVolumeNode->GetModifiedSinceRead(), false);
+  CHECK_INT(image->GetNumberOfPoints(), 32 * 32 * 32);
+  CHECK_INT(image->GetPointData()->GetScalars()->GetNumberOfTuples(), 32 * 32 * 32);
+  vtkImageData* decompressedImage = storedVolumeNode->GetImageData();
+  CHECK_BOOL(decompressedImage != image.GetPointer(), true);
+  CHECK_INT(decompressedImage->GetScalarComponentAsDouble(5, 3, 2, 0), (5 + 3 * 32 + 2 * 32 * 32) % 7);
+  CHECK_BOOL(storedVolumeNode->GetModifiedSinceRead(), false);
+  // modifications after decompression are detected
+  decompressedImage->SetScalarComponentFromDouble(5, 3, 2, 0, 100.0);
+  decompressedImage->Modified();
+  CHECK_BOOL(storedVolumeNode->GetModifiedSinceRead(), true);
+
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -397,6 +397,60 @@ int vtkMRMLSceneTest1(int , char * [] )
       }
   }
 
+  //---------------------------------------------------------------------------
+  // Test class index consistency
+  //---------------------------------------------------------------------------
+  {
+    // Superclass queries must return nodes of all subclasses
+    int numberOfNodes = scene1->GetNumberOfNodesByClass("vtkMRMLNode");
+    CHECK_INT(numberOfNodes, scene1->GetNumberOfNodes());
+    CHECK_INT(scene1->GetNumberOfNodesByClass("vtkMRMLCustomNode"), 2);
+
+    // Removed nodes must not be returned anymore
+    scene1->RemoveNode(node4);
+    CHECK_INT(scene1->GetNumberOfNodesByClass("vtkMRMLCustomNode"), 1);
+    CHECK_INT(scene1->GetNumberOfNodesByClass("vtkMRMLNode"), numberOfNodes - 1);
+    CHECK_POINTER(scene1->GetNthNodeByClass(1, "vtkMRMLCustomNode"), nullptr);
+
+    // Inserted nodes must be returned in the scene order
+    vtkNew<vtkMRMLCustomNode> insertedNode;
+    scene1->InsertBeforeNode(node1, insertedNode.GetPointer());
+    CHECK_POINTER(scene1->GetFirstNodeByClass("vtkMRMLCustomNode"), insertedNode.GetPointer());
+    CHECK_POINTER(scene1->GetNthNodeByClass(1, "vtkMRMLCustomNode"), node1);
+    std::vector<vtkMRMLNode*> customNodes;
+    CHECK_INT(scene1->GetNodesByClass("vtkMRMLCustomNode", customNodes), 2);
+    CHECK_POINTER(customNodes[0], insertedNode.GetPointer());
+
+    // Newly added nodes must be appended to already-indexed classes
+    vtkMRMLNode* node5 = scene1->AddNode(vtkSmartPointer<vtkMRMLCustomNode>::New());
+    CHECK_POINTER(scene1->GetNthNodeByClass(2, "vtkMRMLCustomNode"), node5);
+    CHECK_INT(scene1->GetNumberOfNodesByClass("vtkMRMLNode"), numberOfNodes + 1);
+  }
+
+  //---------------------------------------------------------------------------
+  // Test name index consistency
+  //---------------------------------------------------------------------------
+  {
+    vtkSmartPointer<vtkCollection> prefixNodes;
+    prefixNodes.TakeReference(scene1->GetNodesByNamePrefix("Node"));
+    CHECK_INT(prefixNodes->GetNumberOfItems(), 3);
+    prefixNodes.TakeReference(scene1->GetNodesByNamePrefix("NodeWith"));
+    CHECK_INT(prefixNodes->GetNumberOfItems(), 1);
+    CHECK_POINTER(prefixNodes->GetItemAsObject(0), node2);
+
+    // Renamed nodes must be found by their new name only
+    node2->SetName("RenamedNode");
+    CHECK_POINTER(scene1->GetFirstNodeByName("NodeWithSuffix"), nullptr);
+    CHECK_POINTER(scene1->GetFirstNodeByName("RenamedNode"), node2);
+    prefixNodes.TakeReference(scene1->GetNodesByNamePrefix("NodeWith"));
+    CHECK_INT(prefixNodes->GetNumberOfItems(), 0);
+    prefixNodes.TakeReference(scene1->GetNodesByName("Node"));
+    CHECK_INT(prefixNodes->GetNumberOfItems(), 2);
+    CHECK_POINTER(prefixNodes->GetItemAsObject(0), node1);
+    CHECK_POINTER(prefixNodes->GetItemAsObject(1), node3);
+    node2->SetName("NodeWithSuffix");
+  }
+
   // Verify content of ReferencedIDChanges map
   {
     // Make sure IDs of nodes coming from private scenes are not stored in
@@ -0,0 +1,136 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH)
+  All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   3D Slicer
+
+=========================================================================auto=*/
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLScene.h"
+#include "vtkMRMLSegmentationNode.h"
+#include "vtkMRMLTextNode.h"
+
+// Segmentations includes
+#include "vtkOrientedImageData.h"
+#include "vtkSegment.h"
+#include "vtkSegmentation.h"
+#include "vtkSegmentationConverter.h"
+
+// VTK includes
+#include <vtkDataArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkWeakPointer.h>
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+vtkOrientedImageData* GetSegmentLabelmap(vtkMRMLSegmentationNode* segmentationNode)
+{
+  vtkSegment* segment = segmentationNode->GetSegmentation()->GetSegment("Segment_1");
+  if (!segment)
+    {
+    return nullptr;
+    }
+  return vtkOrientedImageData::SafeDownCast(segment->GetRepresentation(
+    vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName()));
+}
+
+} // end of anonymous namespace
+
+//------------------------------------------------------------------------------
+int vtkMRMLSceneUndoTest(int , char * [] )
+{
+  vtkNew<vtkMRMLScene> scene;
+  scene->SetUndoOn();
+
+  vtkWeakPointer<vtkMRMLTextNode> textNode = vtkMRMLTextNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLTextNode"));
+  CHECK_NOT_NULL(textNode);
+  textNode->SetUndoEnabled(true);
+  textNode->SetText("first");
+  std::string textNodeID = textNode->GetID();
+
+  // Unmodified node states are shared between undo levels
+  scene->SaveStateForUndo();
+  scene->SaveStateForUndo();
+  CHECK_INT(scene->GetNumberOfUndoLevels(), 2);
+  CHECK_INT(static_cast<int>(scene->GetUndoStackMemorySize()), 1);
+
+  textNode->SetText("second");
+  scene->SaveStateForUndo();
+  CHECK_INT(scene->GetNumberOfUndoLevels(), 3);
+  CHECK_INT(static_cast<int>(scene->GetUndoStackMemorySize()), 2);
+
+  textNode->SetText("third");
+  scene->Undo();
+  CHECK_STD_STRING(textNode->GetText(), "second");
+  scene->Undo();
+  CHECK_STD_STRING(textNode->GetText(), "first");
+  CHECK_INT(scene->GetNumberOfUndoLevels(), 1);
+
+  // Restoring a removed node from a shared state must not modify the shared state
+  scene->SaveStateForUndo();
+  scene->SaveStateForUndo();
+  scene->RemoveNode(textNode);
+  CHECK_NULL(scene->GetNodeByID(textNodeID));
+  scene->Undo();
+  textNode = vtkMRMLTextNode::SafeDownCast(scene->GetNodeByID(textNodeID));
+  CHECK_NOT_NULL(textNode);
+  CHECK_STD_STRING(textNode->GetText(), "first");
+  textNode->SetText("changed");
+  scene->Undo();
+  CHECK_STD_STRING(textNode->GetText(), "first");
+  CHECK_INT(scene->GetNumberOfUndoLevels(), 1);
+
+  // Memory budget removes the oldest levels
+  textNode->SetText("fourth");
+  scene->SaveStateForUndo();
+  textNode->SetText("fifth");
+  scene->SaveStateForUndo();
+  CHECK_INT(scene->GetNumberOfUndoLevels(), 3);
+  scene->SetMaximumUndoStackMemorySize(2);
+  CHECK_INT(scene->GetNumberOfUndoLevels(), 2);
+  CHECK_BOOL(scene->GetUndoStackMemorySize() <= 2, true);
+
+  scene->ClearUndoStack();
+  CHECK_INT(static_cast<int>(scene->GetUndoStackMemorySize()), 0);
+
+  // Segmentation labelmap edited in place, without modifying the segmentation node.
+  // The undo state must not be shared, otherwise undo would restore stale voxels.
+  vtkMRMLSegmentationNode* segmentationNode = vtkMRMLSegmentationNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLSegmentationNode"));
+  CHECK_NOT_NULL(segmentationNode);
+  segmentationNode->SetUndoEnabled(true);
+  segmentationNode->GetSegmentation()->SetSourceRepresentationName(
+    vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName());
+  vtkNew<vtkOrientedImageData> labelmap;
+  labelmap->SetDimensions(2, 2, 2);
+  labelmap->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  labelmap->GetPointData()->GetScalars()->Fill(0);
+  vtkNew<vtkSegment> segment;
+  segment->AddRepresentation(vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName(), labelmap);
+  CHECK_BOOL(segmentationNode->GetSegmentation()->AddSegment(segment, "Segment_1"), true);
+
+  scene->SaveStateForUndo();
+  CHECK_NOT_NULL(GetSegmentLabelmap(segmentationNode));
+  GetSegmentLabelmap(segmentationNode)->SetScalarComponentFromDouble(0, 0, 0, 0, 1);
+  scene->SaveStateForUndo();
+  GetSegmentLabelmap(segmentationNode)->SetScalarComponentFromDouble(0, 0, 0, 0, 2);
+  scene->Undo();
+  CHECK_NOT_NULL(GetSegmentLabelmap(segmentationNode));
+  CHECK_DOUBLE(GetSegmentLabelmap(segmentationNode)->GetScalarComponentAsDouble(0, 0, 0, 0), 1);
+  scene->Undo();
+  CHECK_NOT_NULL(GetSegmentLabelmap(segmentationNode));
+  CHECK_DOUBLE(GetSegmentLabelmap(segmentationNode)->GetScalarComponentAsDouble(0, 0, 0, 0), 0);
+  scene->ClearUndoStack();
+
+  return EXIT_SUCCESS;
+}
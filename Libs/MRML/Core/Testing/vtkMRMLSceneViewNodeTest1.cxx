@@ -12,6 +12,7 @@
 
 // MRML includes
 #include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLScalarVolumeDisplayNode.h"
 #include "vtkMRMLScene.h"
 #include "vtkMRMLSceneViewNode.h"
 
@@ -20,6 +21,47 @@
 #include <vtkImageData.h>
 #include <vtkNew.h>
 
+namespace
+{
+
+//---------------------------------------------------------------------------
+int TestRestoreOnlyModifiedNodes()
+{
+  vtkNew<vtkMRMLScene> scene;
+  vtkNew<vtkMRMLScalarVolumeDisplayNode> modifiedDisplayNode;
+  modifiedDisplayNode->SetWindowLevel(100.0, 50.0);
+  scene->AddNode(modifiedDisplayNode);
+  vtkNew<vtkMRMLScalarVolumeDisplayNode> unchangedDisplayNode;
+  unchangedDisplayNode->SetWindowLevel(200.0, 20.0);
+  scene->AddNode(unchangedDisplayNode);
+
+  vtkNew<vtkMRMLSceneViewNode> sceneViewNode;
+  scene->AddNode(sceneViewNode);
+  CHECK_BOOL(sceneViewNode->GetRestoreOnlyModifiedNodes(), true);
+  sceneViewNode->StoreScene();
+
+  modifiedDisplayNode->SetWindowLevel(300.0, 30.0);
+
+  vtkNew<vtkMRMLCoreTestingUtilities::vtkMRMLNodeCallback> modifiedCallback;
+  modifiedDisplayNode->AddObserver(vtkCommand::ModifiedEvent, modifiedCallback);
+  vtkNew<vtkMRMLCoreTestingUtilities::vtkMRMLNodeCallback> unchangedCallback;
+  unchangedDisplayNode->AddObserver(vtkCommand::ModifiedEvent, unchangedCallback);
+
+  CHECK_BOOL(sceneViewNode->RestoreScene(), true);
+
+  // Only the changed node is updated
+  CHECK_DOUBLE(modifiedDisplayNode->GetWindow(), 100.0);
+  CHECK_DOUBLE(modifiedDisplayNode->GetLevel(), 50.0);
+  CHECK_BOOL(modifiedCallback->GetNumberOfModified() > 0, true);
+  CHECK_DOUBLE(unchangedDisplayNode->GetWindow(), 200.0);
+  CHECK_INT(unchangedCallback->GetNumberOfModified(), 0);
+
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//---------------------------------------------------------------------------
 int vtkMRMLSceneViewNodeTest1(int , char * [] )
 {
   vtkNew<vtkMRMLSceneViewNode> node1;
@@ -60,5 +102,7 @@ int vtkMRMLSceneViewNodeTest1(int , char * [] )
   col->RemoveAllItems();
   col->Delete();
 
+  CHECK_EXIT_SUCCESS(TestRestoreOnlyModifiedNodes());
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,102 @@
+/*=auto=========================================================================
+
+Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH)
+All Rights Reserved.
+
+See COPYRIGHT.txt
+or http://www.slicer.org/copyright/copyright.txt for details.
+
+Program:   3D Slicer
+
+=========================================================================auto=*/
+
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLMessageCollection.h"
+#include "vtkMRMLModelNode.h"
+#include "vtkMRMLModelStorageNode.h"
+#include "vtkMRMLScene.h"
+
+#include <vtkCallbackCommand.h>
+#include <vtkCylinderSource.h>
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtksys/SystemTools.hxx>
+
+namespace
+{
+  int ProgressEventCount = 0;
+  double LastProgress = 0.0;
+
+  //---------------------------------------------------------------------------
+  void ProgressCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+    void* vtkNotUsed(clientData), void* callData)
+  {
+    ++ProgressEventCount;
+    LastProgress = *reinterpret_cast<double*>(callData);
+  }
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLSceneWriteDataInParallelTest(int argc, char * argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " /path/to/temp" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::string bundleDir = std::string(argv[1]) + "/vtkMRMLSceneWriteDataInParallelTest";
+  vtksys::SystemTools::RemoveADirectory(bundleDir);
+  vtksys::SystemTools::MakeDirectory(bundleDir);
+
+  vtkNew<vtkCylinderSource> cylinderSource;
+  cylinderSource->Update();
+
+  vtkNew<vtkMRMLScene> scene;
+  const int numberOfModels = 6;
+  for (int modelIndex = 0; modelIndex < numberOfModels; ++modelIndex)
+    {
+    // All nodes have the same name, to test that unique file names are generated
+    vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLModelNode", "Model"));
+    CHECK_NOT_NULL(modelNode);
+    modelNode->SetName("Model");
+    modelNode->SetAndObservePolyData(cylinderSource->GetOutput());
+    }
+
+  vtkNew<vtkCallbackCommand> progressCallback;
+  progressCallback->SetCallback(ProgressCallback);
+  scene->AddObserver(vtkCommand::ProgressEvent, progressCallback);
+
+  vtkNew<vtkMRMLMessageCollection> userMessages;
+  scene->WriteDataInParallelOn();
+  CHECK_BOOL(scene->SaveSceneToSlicerDataBundleDirectory(bundleDir.c_str(), nullptr, userMessages), true);
+  CHECK_INT(userMessages->GetNumberOfMessagesOfType(vtkCommand::ErrorEvent), 0);
+  CHECK_BOOL(ProgressEventCount > 0, true);
+  CHECK_DOUBLE(LastProgress, 1.0);
+
+  // Check that each model was written to a separate file
+  std::vector<std::string> dataDirComponents;
+  vtksys::SystemTools::SplitPath(bundleDir, dataDirComponents);
+  dataDirComponents.emplace_back("Data");
+  std::string dataDir = vtksys::SystemTools::JoinPath(dataDirComponents);
+  CHECK_BOOL(vtksys::SystemTools::FileExists(dataDir + "/Model.vtk", true), true);
+  for (int modelIndex = 1; modelIndex < numberOfModels; ++modelIndex)
+    {
+    std::stringstream ss;
+    ss << dataDir << "/Model_" << modelIndex << ".vtk";
+    CHECK_BOOL(vtksys::SystemTools::FileExists(ss.str(), true), true);
+    }
+
+  // Check that the written scene can be read
+  vtkNew<vtkMRMLScene> scene2;
+  std::string sceneFileName = bundleDir + "/vtkMRMLSceneWriteDataInParallelTest.mrml";
+  scene2->SetURL(sceneFileName.c_str());
+  CHECK_BOOL(scene2->Import() != 0, true);
+  CHECK_INT(scene2->GetNumberOfNodesByClass("vtkMRMLModelNode"), numberOfModels);
+  vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(scene2->GetFirstNodeByClass("vtkMRMLModelNode"));
+  CHECK_NOT_NULL(modelNode);
+  CHECK_NOT_NULL(modelNode->GetPolyData());
+  CHECK_INT(modelNode->GetPolyData()->GetNumberOfPoints(), cylinderSource->GetOutput()->GetNumberOfPoints());
+
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -114,5 +114,31 @@ int vtkMRMLSegmentationStorageNodeTest1(int argc, char * argv[] )
     CHECK_INT(numberOfLayers, 2);
   }
 
+  std::cout << "Testing partial loading of shared labelmap segmentation" << std::endl;
+  {
+    vtkNew<vtkMRMLSegmentationNode> segmentationNode;
+    scene->AddNode(segmentationNode);
+    vtkNew<vtkMRMLSegmentationStorageNode> segmentationStorageNode;
+    scene->AddNode(segmentationStorageNode);
+    segmentationStorageNode->SetFileName(slicerSegmentationFilename);
+
+    std::vector<std::string> segmentIDsInFile;
+    CHECK_BOOL(segmentationStorageNode->GetSegmentIDsInFile(segmentIDsInFile), true);
+    CHECK_INT(static_cast<int>(segmentIDsInFile.size()), 3);
+
+    segmentationStorageNode->AddSegmentIDToRead(segmentIDsInFile[1]);
+    segmentationStorageNode->AddSegmentIDToRead("NonExistingSegmentID");
+    segmentationStorageNode->ReadData(segmentationNode);
+    vtkSegmentation* segmentation = segmentationNode->GetSegmentation();
+    CHECK_NOT_NULL(segmentation);
+
+    int numberOfSegments = segmentation->GetNumberOfSegments();
+    CHECK_INT(numberOfSegments, 1);
+    CHECK_NOT_NULL(segmentation->GetSegment(segmentIDsInFile[1]));
+
+    int numberOfLayers = segmentation->GetNumberOfLayers(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName());
+    CHECK_INT(numberOfLayers, 1);
+  }
+
   return EXIT_SUCCESS;
 }
@@ -35,6 +35,7 @@ int InitializeDefaultMatrixTest();
 int SlabReconstructionEnabledTest();
 int SlabReconstructionTypeTest();
 int SlabReconstructionThicknessTest();
+int GPURenderingEnabledTest();
 
 //----------------------------------------------------------------------------
 int vtkMRMLSliceNodeTest1(int , char * [] )
@@ -54,6 +55,7 @@ int vtkMRMLSliceNodeTest1(int , char * [] )
   CHECK_EXIT_SUCCESS(SlabReconstructionEnabledTest());
   CHECK_EXIT_SUCCESS(SlabReconstructionTypeTest());
   CHECK_EXIT_SUCCESS(SlabReconstructionThicknessTest());
+  CHECK_EXIT_SUCCESS(GPURenderingEnabledTest());
 
   return EXIT_SUCCESS;
 }
@@ -516,3 +518,28 @@ int SlabReconstructionThicknessTest()
 
   return EXIT_SUCCESS;
 }
+
+//----------------------------------------------------------------------------
+int GPURenderingEnabledTest()
+{
+  vtkNew<vtkMRMLSliceNode> sliceNode;
+
+  CHECK_BOOL(sliceNode->GetGPURenderingEnabled(), false);
+
+  // Set using on/off macro
+  {
+    sliceNode->GPURenderingEnabledOn();
+    CHECK_BOOL(sliceNode->GetGPURenderingEnabled(), true);
+  }
+
+  // Copy
+  {
+    vtkNew<vtkMRMLSliceNode> copiedSliceNode;
+    copiedSliceNode->Copy(sliceNode);
+    CHECK_BOOL(copiedSliceNode->GetGPURenderingEnabled(), true);
+    sliceNode->GPURenderingEnabledOff();
+    CHECK_BOOL(sliceNode->GetGPURenderingEnabled(), false);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -19,10 +19,106 @@ Care Ontario.
 ==============================================================================*/
 
 // MRML includes
+#include "vtkEventBroker.h"
 #include "vtkMRMLCoreTestingMacros.h"
 #include "vtkMRMLScene.h"
 #include "vtkMRMLStreamingVolumeNode.h"
 
+// VTK includes
+#include <vtkCallbackCommand.h>
+
+// STD includes
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Objects that the worker threads requested to be modified, as the
+/// application does it on the main thread
+std::mutex RequestedObjectsMutex;
+std::vector<vtkObject*> RequestedObjects;
+
+//----------------------------------------------------------------------------
+void RequestModifiedCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+  void* vtkNotUsed(clientData), void* callData)
+{
+  std::lock_guard<std::mutex> lock(RequestedObjectsMutex);
+  RequestedObjects.push_back(reinterpret_cast<vtkObject*>(callData));
+}
+
+//----------------------------------------------------------------------------
+/// Call Modified() on the requested objects, wait until at least one is requested
+bool ProcessRequestedObjects()
+{
+  for (int attempt = 0; attempt < 500; ++attempt)
+    {
+    std::vector<vtkObject*> objects;
+    {
+      std::lock_guard<std::mutex> lock(RequestedObjectsMutex);
+      objects.swap(RequestedObjects);
+    }
+    for (vtkObject* object : objects)
+      {
+      object->Modified();
+      }
+    if (!objects.empty())
+      {
+      return true;
+      }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+int TestAsynchronousDecoding(vtkStreamingVolumeFrame* frame1, vtkStreamingVolumeFrame* frame2,
+  unsigned char frame1Value, unsigned char frame2Value)
+{
+  vtkNew<vtkCallbackCommand> requestModifiedCallback;
+  requestModifiedCallback->SetCallback(RequestModifiedCallback);
+  vtkEventBroker::GetInstance()->SetRequestModifiedCallback(requestModifiedCallback);
+
+  vtkNew<vtkMRMLStreamingVolumeNode> streamingVolumeNode;
+  CHECK_BOOL(streamingVolumeNode->GetAsynchronousDecoding(), false);
+  streamingVolumeNode->AsynchronousDecodingOn();
+  streamingVolumeNode->SetAndObserveFrame(frame1);
+
+  // Without any image, the first frame is decoded before returning
+  vtkSmartPointer<vtkImageData> imageData = streamingVolumeNode->GetImageData();
+  CHECK_NOT_NULL(imageData);
+  CHECK_INT(*static_cast<unsigned char*>(imageData->GetScalarPointer(1, 0, 0)), frame1Value);
+  CHECK_BOOL(ProcessRequestedObjects(), true);
+  CHECK_BOOL(streamingVolumeNode->UpdateImageDataFromDecodedFrame(), false);
+
+  // The image is observed, the next frame is decoded in the worker thread
+  // and replaces the image when the main thread is notified
+  streamingVolumeNode->SetAndObserveFrame(frame2);
+  CHECK_BOOL(ProcessRequestedObjects(), true);
+  vtkImageData* decodedImageData = streamingVolumeNode->GetImageData();
+  CHECK_NOT_NULL(decodedImageData);
+  CHECK_BOOL(decodedImageData != imageData.GetPointer(), true);
+  CHECK_INT(*static_cast<unsigned char*>(decodedImageData->GetScalarPointer(1, 0, 0)), frame2Value);
+  // the previous image is not modified
+  CHECK_INT(*static_cast<unsigned char*>(imageData->GetScalarPointer(1, 0, 0)), frame1Value);
+
+  // An image set externally is not replaced by the frames decoded meanwhile
+  vtkNew<vtkImageData> externalImageData;
+  streamingVolumeNode->SetAndObserveImageData(externalImageData);
+  CHECK_NULL(streamingVolumeNode->GetFrame());
+  CHECK_BOOL(streamingVolumeNode->UpdateImageDataFromDecodedFrame(), false);
+  CHECK_POINTER(streamingVolumeNode->GetImageData(), externalImageData.GetPointer());
+
+  vtkEventBroker::GetInstance()->SetRequestModifiedCallback(nullptr);
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
 int vtkMRMLStreamingVolumeNodeTest1(int , char * [] )
 {
   vtkNew<vtkMRMLStreamingVolumeNode> node1;
@@ -98,5 +194,16 @@ int vtkMRMLStreamingVolumeNodeTest1(int , char * [] )
       }
     }
 
+  // Encode a second frame from a modified image
+  unsigned char frame1Value = *static_cast<unsigned char*>(imageData1->GetScalarPointer(1, 0, 0));
+  unsigned char frame2Value = frame1Value + 100;
+  *static_cast<unsigned char*>(imageData1->GetScalarPointer(1, 0, 0)) = frame2Value;
+  imageData1->Modified();
+  CHECK_BOOL(streamingVolumeNode1->EncodeImageData(), true);
+  vtkSmartPointer<vtkStreamingVolumeFrame> frameData2 = streamingVolumeNode1->GetFrame();
+  CHECK_BOOL(frameData2 != frameData, true);
+
+  CHECK_EXIT_SUCCESS(TestAsynchronousDecoding(frameData, frameData2, frame1Value, frame2Value));
+
   return EXIT_SUCCESS;
 }
@@ -159,6 +159,46 @@ int vtkMRMLTransformNodeTest1(int , char * [] )
   vtkNew<vtkMatrix4x4> identity;
   CHECK_BOOL(vtkAddonMathUtilities::MatrixAreEqual(identity.GetPointer(), test_mx.GetPointer()), true);
 
+  // Cached transform to world follows the changes of the parents
+  vtkMTimeType transformToWorldMTime = eTransform->GetTransformToWorldMTime();
+  vtkSmartPointer<vtkMatrix4x4> w_from_b2_mx = vtkSmartPointer<vtkMatrix4x4>::Take(CreateTransformMatrix( 4,  3, -2,  4,  2,  8));
+  bTransform->SetMatrixTransformToParent(w_from_b2_mx.GetPointer());
+  CHECK_BOOL(eTransform->GetTransformToWorldMTime() > transformToWorldMTime, true);
+  vtkNew<vtkMatrix4x4> w2_from_e_mx;
+  vtkMatrix4x4::Multiply4x4(w_from_b2_mx.GetPointer(), b_from_e_mx.GetPointer(), w2_from_e_mx.GetPointer());
+  eTransform->GetMatrixTransformToWorld(test_mx.GetPointer());
+  CHECK_BOOL(vtkAddonMathUtilities::MatrixAreEqual(w2_from_e_mx.GetPointer(), test_mx.GetPointer()), true);
+  vtkNew<vtkMatrix4x4> e_from_w2_mx;
+  vtkMatrix4x4::Invert(w2_from_e_mx.GetPointer(), e_from_w2_mx.GetPointer());
+  eTransform->GetMatrixTransformFromWorld(test_mx.GetPointer());
+  CHECK_BOOL(vtkAddonMathUtilities::MatrixAreEqual(e_from_w2_mx.GetPointer(), test_mx.GetPointer()), true);
+  vtkNew<vtkGeneralTransform> e_to_w_transform;
+  eTransform->GetTransformToWorld(e_to_w_transform.GetPointer());
+  double pointE[3] = { 10., -20., 30. };
+  double pointW[4] = { 0., 0., 0., 1. };
+  e_to_w_transform->TransformPoint(pointE, pointW);
+  double pointEH[4] = { pointE[0], pointE[1], pointE[2], 1. };
+  double expectedPointW[4] = { 0., 0., 0., 1. };
+  w2_from_e_mx->MultiplyPoint(pointEH, expectedPointW);
+  for (int i = 0; i < 3; ++i)
+    {
+    CHECK_DOUBLE_TOLERANCE(pointW[i], expectedPointW[i], 1e-6);
+    }
+
+  // Cached transform to world follows the change of a parent transform node
+  transformToWorldMTime = eTransform->GetTransformToWorldMTime();
+  dTransform->SetAndObserveTransformNodeID(qTransform->GetID());
+  CHECK_BOOL(eTransform->GetTransformToWorldMTime() > transformToWorldMTime, true);
+  vtkNew<vtkMatrix4x4> w2_from_e_by_q_mx;
+  vtkMatrix4x4::Multiply4x4(c_from_d_mx.GetPointer(), d_from_e_mx.GetPointer(), w2_from_e_by_q_mx.GetPointer());
+  vtkMatrix4x4::Multiply4x4(b_from_q_mx.GetPointer(), w2_from_e_by_q_mx.GetPointer(), w2_from_e_by_q_mx.GetPointer());
+  vtkMatrix4x4::Multiply4x4(w_from_b2_mx.GetPointer(), w2_from_e_by_q_mx.GetPointer(), w2_from_e_by_q_mx.GetPointer());
+  vtkMRMLTransformNode::GetMatrixTransformBetweenNodes(eTransform.GetPointer(), nullptr, test_mx.GetPointer());
+  CHECK_BOOL(vtkAddonMathUtilities::MatrixAreEqual(w2_from_e_by_q_mx.GetPointer(), test_mx.GetPointer()), true);
+  dTransform->SetAndObserveTransformNodeID(cTransform->GetID());
+  eTransform->GetMatrixTransformToWorld(test_mx.GetPointer());
+  CHECK_BOOL(vtkAddonMathUtilities::MatrixAreEqual(w2_from_e_mx.GetPointer(), test_mx.GetPointer()), true);
+
   // Test when there is a nonlinear transform above the common parent of two transform nodes.
   // Transform to world is nonlinear but the relative transform is linear.
   vtkNew<vtkMRMLBSplineTransformNode> nonlinearTransform;
@@ -0,0 +1,87 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkTraceRecorder.h"
+
+// STD includes
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------
+int vtkTraceRecorderTest1(int , char * [] )
+{
+  vtkTraceRecorder* recorder = vtkTraceRecorder::GetInstance();
+  CHECK_NOT_NULL(recorder);
+  CHECK_BOOL(recorder->GetRecording(), false);
+
+  // Small buffer to test overwriting of oldest events
+  const int threadBufferSize = 16;
+  recorder->SetThreadBufferSize(threadBufferSize);
+
+  // Events are not recorded when recording is disabled
+  {
+  vtkTraceRecorder::Scope scope("NotRecorded");
+  }
+  CHECK_INT(recorder->GetNumberOfEvents(), 0);
+
+  recorder->RecordingOn();
+  {
+  vtkTraceRecorder::Scope scope("MainThreadScope", "Test");
+  recorder->AddEventWithCopiedStrings(std::string("Copied\"Name"), "Test", vtkTraceRecorder::GetTime(), 5);
+  }
+  CHECK_INT(recorder->GetNumberOfEvents(), 2);
+
+  std::string trace = recorder->GetEventsAsChromeTrace();
+  CHECK_BOOL(trace.find("\"name\":\"MainThreadScope\"") != std::string::npos, true);
+  CHECK_BOOL(trace.find("\"name\":\"Copied\\\"Name\"") != std::string::npos, true);
+  CHECK_BOOL(trace.find("\"name\":\"NotRecorded\"") == std::string::npos, true);
+
+  // Each thread records into its own buffer
+  const int numberOfThreads = 4;
+  const int numberOfEventsPerThread = 100;
+  std::vector<std::thread> threads;
+  for (int threadIndex = 0; threadIndex < numberOfThreads; ++threadIndex)
+    {
+    threads.emplace_back([]()
+      {
+      for (int i = 0; i < numberOfEventsPerThread; ++i)
+        {
+        vtkTraceRecorder::Scope scope("WorkerThreadScope", "Test");
+        }
+      });
+    }
+  for (std::thread& thread : threads)
+    {
+    thread.join();
+    }
+  // Only the most recent events are kept in each thread buffer
+  CHECK_INT(recorder->GetNumberOfEvents(), 2 + numberOfThreads * threadBufferSize);
+
+  trace = recorder->GetEventsAsChromeTrace();
+  CHECK_BOOL(trace.find("\"name\":\"WorkerThreadScope\"") != std::string::npos, true);
+
+  recorder->ClearEvents();
+  CHECK_INT(recorder->GetNumberOfEvents(), 0);
+
+  recorder->RecordingOff();
+  {
+  vtkTraceRecorder::Scope scope("NotRecorded");
+  }
+  CHECK_INT(recorder->GetNumberOfEvents(), 0);
+
+  return EXIT_SUCCESS;
+}
@@ -225,12 +225,19 @@ long copy_data(struct archive *ar, struct archive *aw)
 vtkArchive::vtkArchive() = default;
 
 //----------------------------------------------------------------------------
-vtkArchive::~vtkArchive() = default;
+vtkArchive::~vtkArchive()
+{
+  if (this->WriteArchive)
+    {
+    this->CloseZip();
+    }
+}
 
 //----------------------------------------------------------------------------
 void vtkArchive::PrintSelf(ostream& os, vtkIndent indent)
 {
   Superclass::PrintSelf(os,indent);
+  os << indent << "ZipOpen: " << (this->WriteArchive ? "true" : "false") << "\n";
 }
 
 //-----------------------------------------------------------------------------
@@ -674,3 +681,260 @@ bool vtkArchive::UnZip(const char* zipFileName, const char* destinationDirectory
 
   return (result == ARCHIVE_OK);
 }
+
+//-----------------------------------------------------------------------------
+bool vtkArchive::UnZipEntries(const char* zipFileName, const char* destinationDirectory,
+  const std::vector<std::string>& entryNames)
+{
+  if ( !zipFileName || !destinationDirectory )
+    {
+    vtkArchiveTools::Error("UnZipEntries:", "Invalid zipfile or directory");
+    return false;
+    }
+
+  if ( !vtksys::SystemTools::FileIsDirectory(destinationDirectory) )
+    {
+    vtkArchiveTools::Error("UnZipEntries:", "Destination is not a directory");
+    return false;
+    }
+
+  struct archive* zipArchive = archive_read_new();
+  archive_read_support_filter_all(zipArchive);
+  archive_read_support_format_all(zipArchive);
+  if (archive_read_open_filename(zipArchive, zipFileName, 10240) != ARCHIVE_OK)
+    {
+    vtkArchiveTools::Error("UnZipEntries: cannot open archive file", archive_error_string(zipArchive));
+    archive_read_free(zipArchive);
+    return false;
+    }
+
+  struct archive* diskDestination = archive_write_disk_new();
+  archive_write_disk_set_standard_lookup(diskDestination);
+
+  bool success = true;
+  struct archive_entry* entry;
+  int result;
+  while ((result = archive_read_next_header(zipArchive, &entry)) != ARCHIVE_EOF)
+    {
+    if (result != ARCHIVE_OK)
+      {
+      vtkArchiveTools::Error("UnZipEntries error:", archive_error_string(zipArchive));
+      if (result < ARCHIVE_WARN)
+        {
+        success = false;
+        break;
+        }
+      }
+    std::string entryName = archive_entry_pathname(entry);
+    bool requested = false;
+    for (const std::string& requestedName : entryNames)
+      {
+      if (entryName == requestedName
+        || (!requestedName.empty() && requestedName.back() == '/'
+          && entryName.compare(0, requestedName.size(), requestedName) == 0))
+        {
+        requested = true;
+        break;
+        }
+      }
+    if (!requested)
+      {
+      // Data of entries that are not requested is not decompressed
+      archive_read_data_skip(zipArchive);
+      continue;
+      }
+
+    // Extract relative to the destination directory (without changing current directory)
+    std::string destinationPath = std::string(destinationDirectory) + "/" + entryName;
+    archive_entry_copy_pathname(entry, destinationPath.c_str());
+    if (archive_write_header(diskDestination, entry) != ARCHIVE_OK)
+      {
+      vtkArchiveTools::Error("UnZipEntries error:", archive_error_string(diskDestination));
+      success = false;
+      continue;
+      }
+    if (copy_data(zipArchive, diskDestination) != ARCHIVE_OK)
+      {
+      vtkArchiveTools::Error("UnZipEntries error:", archive_error_string(zipArchive));
+      success = false;
+      }
+    archive_write_finish_entry(diskDestination);
+    }
+
+  archive_read_close(zipArchive);
+  archive_read_free(zipArchive);
+  archive_write_close(diskDestination);
+  archive_write_free(diskDestination);
+  return success;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkArchive::OpenZip(const char* zipFileName)
+{
+// only support the libarchive version 3.0 +
+#if !defined(ARCHIVE_VERSION_NUMBER) || ARCHIVE_VERSION_NUMBER < 3000000
+  return false;
+#endif
+
+  if (!zipFileName)
+    {
+    vtkArchiveTools::Error("OpenZip:", "Invalid zipfile");
+    return false;
+    }
+  if (this->WriteArchive)
+    {
+    vtkArchiveTools::Error("OpenZip:", "A zip file is already open");
+    return false;
+    }
+
+  this->WriteArchive = archive_write_new();
+
+#ifdef HAVE_ZLIB_H
+  std::string compression_type = "deflate";
+#else
+  std::string compression_type = "store";
+#endif
+
+  archive_write_set_format_zip(this->WriteArchive);
+  if (archive_write_set_format_option(this->WriteArchive, "zip", "compression", compression_type.c_str()) != ARCHIVE_OK)
+    {
+    vtkArchiveTools::Error("OpenZip: set format:", archive_error_string(this->WriteArchive));
+    archive_write_free(this->WriteArchive);
+    this->WriteArchive = nullptr;
+    return false;
+    }
+  if (archive_write_open_filename(this->WriteArchive, zipFileName) != ARCHIVE_OK)
+    {
+    vtkArchiveTools::Error("OpenZip: open output file:", archive_error_string(this->WriteArchive));
+    archive_write_free(this->WriteArchive);
+    this->WriteArchive = nullptr;
+    return false;
+    }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkArchive::AddDirectory(const char* entryName)
+{
+  if (!this->WriteArchive || !entryName)
+    {
+    vtkArchiveTools::Error("AddDirectory:", "Zip file is not open");
+    return false;
+    }
+  struct archive_entry* dirEntry = archive_entry_new();
+  archive_entry_set_mtime(dirEntry, 11, 110);
+  archive_entry_copy_pathname(dirEntry, entryName);
+  archive_entry_set_mode(dirEntry, S_IFDIR | 0755);
+  archive_entry_set_size(dirEntry, 512);
+  bool success = true;
+  if (archive_write_header(this->WriteArchive, dirEntry) != ARCHIVE_OK)
+    {
+    vtkArchiveTools::Error("AddDirectory: write file header:", archive_error_string(this->WriteArchive));
+    success = false;
+    }
+  archive_entry_free(dirEntry);
+  return success;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkArchive::AddFile(const char* fileName, const char* entryName)
+{
+  if (!this->WriteArchive || !fileName || !entryName)
+    {
+    vtkArchiveTools::Error("AddFile:", "Zip file is not open");
+    return false;
+    }
+  FILE *fd = fopen(fileName, "rb");
+  if (!fd)
+    {
+    vtkArchiveTools::Error("AddFile: cannot open input file:", fileName);
+    return false;
+    }
+
+  struct archive_entry* entry = archive_entry_new();
+  archive_entry_set_pathname(entry, entryName);
+  // size is required, for now use the vtksys call though it uses struct stat
+  // and may not be portable
+  archive_entry_set_size(entry, vtksys::SystemTools::FileLength(fileName));
+  archive_entry_set_filetype(entry, AE_IFREG);
+  archive_entry_set_perm(entry, 0644);
+  bool success = true;
+  if (archive_write_header(this->WriteArchive, entry) != ARCHIVE_OK)
+    {
+    vtkArchiveTools::Error("AddFile: write file header:", archive_error_string(this->WriteArchive));
+    success = false;
+    }
+  else
+    {
+    char buff[BUFSIZ];
+    size_t len = fread(buff, sizeof(char), sizeof(buff), fd);
+    while (len > 0 && success)
+      {
+      if (archive_write_data(this->WriteArchive, buff, len) < 0)
+        {
+        vtkArchiveTools::Error("AddFile: cannot write data:", archive_error_string(this->WriteArchive));
+        success = false;
+        }
+      len = fread(buff, sizeof(char), sizeof(buff), fd);
+      }
+    }
+  fclose(fd);
+  archive_entry_free(entry);
+  return success;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkArchive::AddData(const char* entryName, const void* data, size_t dataSize)
+{
+  if (!this->WriteArchive || !entryName || (!data && dataSize > 0))
+    {
+    vtkArchiveTools::Error("AddData:", "Zip file is not open");
+    return false;
+    }
+  struct archive_entry* entry = archive_entry_new();
+  archive_entry_set_pathname(entry, entryName);
+  archive_entry_set_size(entry, dataSize);
+  archive_entry_set_filetype(entry, AE_IFREG);
+  archive_entry_set_perm(entry, 0644);
+  bool success = true;
+  if (archive_write_header(this->WriteArchive, entry) != ARCHIVE_OK)
+    {
+    vtkArchiveTools::Error("AddData: write file header:", archive_error_string(this->WriteArchive));
+    success = false;
+    }
+  else if (dataSize > 0 && archive_write_data(this->WriteArchive, data, dataSize) < 0)
+    {
+    vtkArchiveTools::Error("AddData: cannot write data:", archive_error_string(this->WriteArchive));
+    success = false;
+    }
+  archive_entry_free(entry);
+  return success;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkArchive::CloseZip()
+{
+  if (!this->WriteArchive)
+    {
+    return false;
+    }
+  bool success = true;
+  if (archive_write_close(this->WriteArchive) != ARCHIVE_OK)
+    {
+    vtkArchiveTools::Error("CloseZip: close archive", archive_error_string(this->WriteArchive));
+    success = false;
+    }
+  if (archive_write_free(this->WriteArchive) != ARCHIVE_OK)
+    {
+    vtkArchiveTools::Error("CloseZip: cleanup", archive_error_string(this->WriteArchive));
+    success = false;
+    }
+  this->WriteArchive = nullptr;
+  return success;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkArchive::IsZipOpen()
+{
+  return this->WriteArchive != nullptr;
+}
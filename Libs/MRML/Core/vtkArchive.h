@@ -20,6 +20,8 @@ or http://www.slicer.org/copyright/copyright.txt for details.
 #include <string>
 #include <vector>
 
+struct archive;
+
 /// \brief Simple class for manipulating archive files
 ///
 class VTK_MRML_EXPORT vtkArchive : public vtkObject
@@ -43,11 +45,39 @@ public:
   // (internally this supports many formats of archive, not just zip)
   static bool UnZip(const char* zipFileName, const char *destinationDirectory);
 
+  // unzips only the specified entries of the zip file into the destination directory.
+  // An entry name that ends with "/" extracts all entries in that directory.
+  static bool UnZipEntries(const char* zipFileName, const char* destinationDirectory,
+    const std::vector<std::string>& entryNames);
+
+  // Start writing a zip file. Entries are added one by one using AddFile, AddDirectory,
+  // and AddData, and written to the zip file immediately, therefore there is no need to stage
+  // the entire content in a directory before zipping it. The zip file is completed by CloseZip.
+  bool OpenZip(const char* zipFileName);
+
+  // Add a directory entry to the zip file opened by OpenZip
+  bool AddDirectory(const char* entryName);
+
+  // Add the content of a file to the zip file opened by OpenZip
+  bool AddFile(const char* fileName, const char* entryName);
+
+  // Add data from memory to the zip file opened by OpenZip
+  bool AddData(const char* entryName, const void* data, size_t dataSize);
+
+  // Complete writing of the zip file opened by OpenZip
+  bool CloseZip();
+
+  // Returns true if a zip file is opened for writing
+  bool IsZipOpen();
+
 protected:
   vtkArchive();
   ~vtkArchive() override;
   vtkArchive(const vtkArchive&);
   void operator=(const vtkArchive&);
+
+  // Zip file opened for writing by OpenZip
+  archive* WriteArchive{nullptr};
 };
 
 #endif
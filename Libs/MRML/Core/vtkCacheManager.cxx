@@ -5,15 +5,287 @@
 #include "vtkMRMLStorageNode.h"
 
 #include <vtksys/Directory.hxx>
+#include <vtksys/MD5.h>
 #include <vtksys/SystemTools.hxx>
 
 #include <vtkCallbackCommand.h>
 #include <vtkObjectFactory.h>
 
+// STD includes
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+#include <sys/stat.h>
+
 vtkStandardNewMacro ( vtkCacheManager );
 
 #define MB 1000000.0
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Return the size of the file in bytes, or -1 if it cannot be read
+vtkTypeInt64 GetFileSize(const std::string& fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary | std::ios::ate);
+  if (!file.is_open())
+    {
+    return -1;
+    }
+  return static_cast<vtkTypeInt64>(file.tellg());
+}
+
+//----------------------------------------------------------------------------
+/// Return the MD5 hash of the content of the file, or an empty string if it cannot be read
+std::string ComputeFileContentHash(const std::string& fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  if (!file.is_open())
+    {
+    return std::string();
+    }
+  vtksysMD5* md5 = vtksysMD5_New();
+  vtksysMD5_Initialize(md5);
+  std::vector<char> buffer(1024 * 1024);
+  while (file)
+    {
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (file.gcount() > 0)
+      {
+      vtksysMD5_Append(md5, reinterpret_cast<unsigned char const*>(buffer.data()),
+                       static_cast<int>(file.gcount()));
+      }
+    }
+  char hash[33];
+  vtksysMD5_FinalizeHex(md5, hash);
+  hash[32] = '\0';
+  vtksysMD5_Delete(md5);
+  return std::string(hash);
+}
+
+//----------------------------------------------------------------------------
+/// Add the paths (relative to \a directory) of all the files in \a directory
+void CollectFiles(const std::string& directory, const std::string& relativeDirectory,
+                  std::vector<std::string>& relativeFileNames)
+{
+  vtksys::Directory dir;
+  if (!dir.Load(directory))
+    {
+    return;
+    }
+  for (unsigned long fileNum = 0; fileNum < dir.GetNumberOfFiles(); ++fileNum)
+    {
+    std::string name = dir.GetFile(fileNum);
+    if (name == "." || name == "..")
+      {
+      continue;
+      }
+    std::string relativeName = relativeDirectory.empty() ? name : relativeDirectory + "/" + name;
+    std::string fullName = directory + "/" + name;
+    if (vtksys::SystemTools::FileIsDirectory(fullName))
+      {
+      CollectFiles(fullName, relativeName, relativeFileNames);
+      }
+    else
+      {
+      relativeFileNames.push_back(relativeName);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+/// Allow or prevent writing the file. The permissions are shared by all the
+/// hard links to the file.
+bool SetFileWritable(const std::string& fileName, bool writable)
+{
+  mode_t mode = 0;
+  if (!vtksys::SystemTools::GetPermissions(fileName, mode))
+    {
+    return false;
+    }
+#if defined(_WIN32)
+  const mode_t ownerWriteMode = _S_IWRITE;
+  const mode_t writeMode = _S_IWRITE;
+#else
+  const mode_t ownerWriteMode = S_IWUSR;
+  const mode_t writeMode = S_IWUSR | S_IWGRP | S_IWOTH;
+#endif
+  if (writable)
+    {
+    mode |= ownerWriteMode;
+    }
+  else
+    {
+    mode &= ~writeMode;
+    }
+  return static_cast<bool>(vtksys::SystemTools::SetPermissions(fileName, mode));
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+class vtkCacheManager::vtkInternal
+{
+public:
+  struct CacheEntry
+    {
+    std::string URI;
+    /// MD5 hash of the content, empty if the file was not added with AddFileToCache()
+    std::string ContentHash;
+    vtkTypeInt64 Size{0};
+    /// Milliseconds since epoch, strictly increasing so that the order of accesses is kept
+    vtkTypeInt64 LastAccessTime{0};
+    /// True if the file is a hard link to the content of other cached files.
+    /// Linked files are read-only, as writing one would modify all of them.
+    bool Linked{false};
+    };
+
+  /// Return the path of \a fileName relative to the cache directory,
+  /// or an empty string if the file is not in the cache directory.
+  std::string GetRelativePath(const std::string& cacheDirectory, const std::string& fileName)
+    {
+    if (cacheDirectory.empty() || fileName.empty())
+      {
+      return std::string();
+      }
+    std::string directory = vtksys::SystemTools::CollapseFullPath(cacheDirectory);
+    std::string file = vtksys::SystemTools::CollapseFullPath(fileName);
+    if (!vtksys::SystemTools::IsSubDirectory(file, directory))
+      {
+      return std::string();
+      }
+    return vtksys::SystemTools::RelativePath(directory, file);
+    }
+
+  vtkTypeInt64 GetNextAccessTime()
+    {
+    vtkTypeInt64 now = static_cast<vtkTypeInt64>(std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count());
+    this->LastAccessTime = std::max(now, this->LastAccessTime + 1);
+    return this->LastAccessTime;
+    }
+
+  /// Read the index saved in the cache directory. Must be called with Mutex locked.
+  void Load(const std::string& cacheDirectory)
+    {
+    this->Entries.clear();
+    this->Modified = false;
+    std::ifstream indexFile((cacheDirectory + "/" + vtkCacheManager::GetCacheIndexFileName()).c_str());
+    std::string line;
+    while (std::getline(indexFile, line))
+      {
+      if (line.empty() || line[0] == '#')
+        {
+        continue;
+        }
+      // content hash, size, last access time, relative path, URI, "linked"
+      std::vector<std::string> fields;
+      std::stringstream lineStream(line);
+      std::string field;
+      while (std::getline(lineStream, field, '\t'))
+        {
+        fields.push_back(field);
+        }
+      if (fields.size() < 4)
+        {
+        continue;
+        }
+      CacheEntry entry;
+      entry.ContentHash = fields[0];
+      entry.Size = std::atoll(fields[1].c_str());
+      entry.LastAccessTime = std::atoll(fields[2].c_str());
+      entry.URI = fields.size() > 4 ? fields[4] : std::string();
+      entry.Linked = fields.size() > 5 && fields[5] == "linked";
+      this->LastAccessTime = std::max(this->LastAccessTime, entry.LastAccessTime);
+      this->Entries[fields[3]] = entry;
+      }
+    }
+
+  /// Write the index in the cache directory. Must be called with Mutex locked.
+  bool Save(const std::string& cacheDirectory)
+    {
+    this->Modified = false;
+    if (cacheDirectory.empty() || !vtksys::SystemTools::FileIsDirectory(cacheDirectory))
+      {
+      return false;
+      }
+    // write a temporary file first so that the index is never left incomplete
+    std::string indexFileName = cacheDirectory + "/" + vtkCacheManager::GetCacheIndexFileName();
+    std::string temporaryFileName = indexFileName + ".tmp";
+      {
+      std::ofstream indexFile(temporaryFileName.c_str());
+      if (!indexFile.is_open())
+        {
+        return false;
+        }
+      indexFile << "# content hash\tsize\tlast access time\trelative path\tURI\tlinked\n";
+      for (const std::pair<const std::string, CacheEntry>& entry : this->Entries)
+        {
+        indexFile << entry.second.ContentHash << "\t" << entry.second.Size << "\t"
+                  << entry.second.LastAccessTime << "\t" << entry.first << "\t"
+                  << entry.second.URI << "\t" << (entry.second.Linked ? "linked" : "") << "\n";
+        }
+      }
+    return static_cast<bool>(vtksys::SystemTools::RenameFile(temporaryFileName, indexFileName));
+    }
+
+  /// Remove the entries of deleted files and add the files that are missing
+  /// from the index. Must be called with Mutex locked.
+  void Synchronize(const std::string& cacheDirectory)
+    {
+    std::vector<std::string> relativeFileNames;
+    if (vtksys::SystemTools::FileIsDirectory(cacheDirectory))
+      {
+      CollectFiles(cacheDirectory, std::string(), relativeFileNames);
+      }
+    std::set<std::string> existingFiles(relativeFileNames.begin(), relativeFileNames.end());
+    for (std::map<std::string, CacheEntry>::iterator it = this->Entries.begin(); it != this->Entries.end();)
+      {
+      if (existingFiles.find(it->first) == existingFiles.end())
+        {
+        it = this->Entries.erase(it);
+        this->Modified = true;
+        }
+      else
+        {
+        ++it;
+        }
+      }
+    std::string indexFileName = vtkCacheManager::GetCacheIndexFileName();
+    for (const std::string& relativeFileName : relativeFileNames)
+      {
+      if (relativeFileName.compare(0, indexFileName.size(), indexFileName) == 0
+          || this->Entries.find(relativeFileName) != this->Entries.end())
+        {
+        continue;
+        }
+      // file added by another application or before the index existed
+      std::string fileName = cacheDirectory + "/" + relativeFileName;
+      CacheEntry entry;
+      entry.Size = std::max<vtkTypeInt64>(0, GetFileSize(fileName));
+      entry.LastAccessTime = static_cast<vtkTypeInt64>(vtksys::SystemTools::ModifiedTime(fileName)) * 1000;
+      this->Entries[relativeFileName] = entry;
+      this->Modified = true;
+      }
+    }
+
+  /// Cached files by path relative to the cache directory
+  std::map<std::string, CacheEntry> Entries;
+  vtkTypeInt64 LastAccessTime{0};
+  /// True if the index changed since it was last saved. Access times of
+  /// cache hits are only saved with the next change of the cached files,
+  /// when the cache directory changes or on destruction.
+  bool Modified{false};
+  /// Protects the index, which may be updated by the threads that download files
+  std::mutex Mutex;
+};
+
 //----------------------------------------------------------------------------
 vtkCacheManager::vtkCacheManager()
 {
@@ -28,6 +300,7 @@ vtkCacheManager::vtkCacheManager()
   this->InsufficientFreeBufferNotificationFlag = 0;
   // this->EnableRemoteCacheOverwriting = 1;
   this->uriMap.clear();
+  this->Internal = new vtkInternal;
 }
 
 
@@ -48,6 +321,8 @@ vtkCacheManager::~vtkCacheManager()
   this->EnableForceRedownload = 0;
   this->InsufficientFreeBufferNotificationFlag = 0;
 //  this->EnableRemoteCacheOverwriting = 1;
+  this->SaveCacheIndex();
+  delete this->Internal;
 }
 
 
@@ -128,11 +403,13 @@ void vtkCacheManager::SetRemoteCacheDirectory (const char *dir )
     return;
     }
 
+  this->SaveCacheIndex();
   this->RemoteCacheDirectory = dirstring;
   if (!vtksys::SystemTools::FileExists(this->RemoteCacheDirectory.c_str()))
     {
     vtksys::SystemTools::MakeDirectory(this->RemoteCacheDirectory.c_str());
     }
+  this->LoadCacheIndex();
   // scan files in cache, it calls Modified
   this->UpdateCacheInformation();
 }
@@ -306,7 +583,7 @@ int vtkCacheManager::GetCachedFileList ( const char *dirname )
               return (0);
               }
             }
-          else
+          else if (strcmp(dir.GetFile(static_cast<unsigned long>(fileNum)), vtkCacheManager::GetCacheIndexFileName()))
             {
             this->CachedFileList.emplace_back(dir.GetFile(static_cast<unsigned long>(fileNum)));
             }
@@ -516,9 +793,328 @@ void vtkCacheManager::UpdateCacheInformation ( )
   //--- and refresh list of cached files.
   this->CachedFileList.clear();
   this->GetCachedFileList ( this->GetRemoteCacheDirectory() );
+
+  //--- and keep the index consistent with the files on disk.
+  {
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    this->Internal->Synchronize(this->RemoteCacheDirectory);
+    if (this->Internal->Modified)
+      {
+      this->Internal->Save(this->RemoteCacheDirectory);
+      }
+  }
   this->Modified();
 }
 
+//----------------------------------------------------------------------------
+const char* vtkCacheManager::GetCacheIndexFileName()
+{
+  return "SlicerCacheIndex.txt";
+}
+
+//----------------------------------------------------------------------------
+void vtkCacheManager::LoadCacheIndex()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  this->Internal->Load(this->RemoteCacheDirectory);
+}
+
+//----------------------------------------------------------------------------
+void vtkCacheManager::SaveCacheIndex()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  if (this->Internal->Modified)
+    {
+    this->Internal->Save(this->RemoteCacheDirectory);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkCacheManager::AddFileToCache ( const char *uri, const char *fileName )
+{
+  if (fileName == nullptr)
+    {
+    vtkErrorMacro("AddFileToCache: file name is null");
+    return 0;
+    }
+  std::string relativePath = this->Internal->GetRelativePath(this->RemoteCacheDirectory, fileName);
+  if (relativePath.empty())
+    {
+    vtkErrorMacro("AddFileToCache: " << fileName << " is not in the cache directory " << this->RemoteCacheDirectory);
+    return 0;
+    }
+  // hash the file without locking the index, as it may take a while
+  vtkInternal::CacheEntry entry;
+  entry.URI = uri ? uri : "";
+  entry.Size = GetFileSize(fileName);
+  entry.ContentHash = ComputeFileContentHash(fileName);
+  if (entry.Size < 0 || entry.ContentHash.empty())
+    {
+    vtkErrorMacro("AddFileToCache: failed to read " << fileName);
+    return 0;
+    }
+
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  for (std::pair<const std::string, vtkInternal::CacheEntry>& cachedEntry : this->Internal->Entries)
+    {
+    if (cachedEntry.first == relativePath
+        || cachedEntry.second.ContentHash != entry.ContentHash
+        || cachedEntry.second.Size != entry.Size)
+      {
+      continue;
+      }
+    // Same content downloaded from another URI: store it only once
+    std::string cachedFileName = this->RemoteCacheDirectory + "/" + cachedEntry.first;
+    std::string linkFileName = std::string(fileName) + ".link";
+    vtksys::SystemTools::RemoveFile(linkFileName);
+    if (vtksys::SystemTools::FileExists(cachedFileName, true)
+        && vtksys::SystemTools::CreateLink(cachedFileName, linkFileName)
+        && vtksys::SystemTools::RenameFile(linkFileName, fileName))
+      {
+      vtkDebugMacro("AddFileToCache: " << fileName << " has the same content as " << cachedFileName);
+      // the files share their content, none of them can be modified in place
+      SetFileWritable(cachedFileName, false);
+      cachedEntry.second.Linked = true;
+      entry.Linked = true;
+      }
+    else
+      {
+      // hard links are not supported (e.g. FAT file system), keep the copy
+      vtksys::SystemTools::RemoveFile(linkFileName);
+      }
+    break;
+    }
+  entry.LastAccessTime = this->Internal->GetNextAccessTime();
+  this->Internal->Entries[relativePath] = entry;
+  this->Internal->Save(this->RemoteCacheDirectory);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkCacheManager::UpdateCachedFileAccessTime ( const char *fileName )
+{
+  if (fileName == nullptr)
+    {
+    return;
+    }
+  std::string relativePath = this->Internal->GetRelativePath(this->RemoteCacheDirectory, fileName);
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  std::map<std::string, vtkInternal::CacheEntry>::iterator it = this->Internal->Entries.find(relativePath);
+  if (it == this->Internal->Entries.end())
+    {
+    return;
+    }
+  it->second.LastAccessTime = this->Internal->GetNextAccessTime();
+  // cache hits are frequent, the index is saved later (see SaveCacheIndex())
+  this->Internal->Modified = true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkCacheManager::UnlinkCachedFile ( const char *fileName )
+{
+  if (fileName == nullptr)
+    {
+    return false;
+    }
+  std::string relativePath = this->Internal->GetRelativePath(this->RemoteCacheDirectory, fileName);
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  std::map<std::string, vtkInternal::CacheEntry>::iterator it = this->Internal->Entries.find(relativePath);
+  if (it == this->Internal->Entries.end() || !it->second.Linked)
+    {
+    return false;
+    }
+  std::string contentHash = it->second.ContentHash;
+  // the content is kept by the other links
+  if (!vtksys::SystemTools::RemoveFile(fileName))
+    {
+    vtkWarningMacro("UnlinkCachedFile: unable to remove cached file " << fileName << " from disk.");
+    return false;
+    }
+  this->Internal->Entries.erase(it);
+
+  // removing a read-only file may have made the shared content writable
+  std::vector<vtkInternal::CacheEntry*> linkedEntries;
+  std::string linkedFileName;
+  for (std::pair<const std::string, vtkInternal::CacheEntry>& entry : this->Internal->Entries)
+    {
+    if (entry.second.Linked && entry.second.ContentHash == contentHash)
+      {
+      linkedEntries.push_back(&entry.second);
+      linkedFileName = this->RemoteCacheDirectory + "/" + entry.first;
+      }
+    }
+  if (linkedEntries.size() == 1)
+    {
+    linkedEntries[0]->Linked = false;
+    }
+  if (!linkedEntries.empty())
+    {
+    SetFileWritable(linkedFileName, linkedEntries.size() == 1);
+    }
+  this->Internal->Save(this->RemoteCacheDirectory);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkCacheManager::GetCachedFileContentHash ( const char *fileName )
+{
+  if (fileName == nullptr)
+    {
+    return std::string();
+    }
+  std::string relativePath = this->Internal->GetRelativePath(this->RemoteCacheDirectory, fileName);
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  std::map<std::string, vtkInternal::CacheEntry>::iterator it = this->Internal->Entries.find(relativePath);
+  return it != this->Internal->Entries.end() ? it->second.ContentHash : std::string();
+}
+
+//----------------------------------------------------------------------------
+std::string vtkCacheManager::FindCachedFileByContentHash ( const std::string& contentHash )
+{
+  if (contentHash.empty())
+    {
+    return std::string();
+    }
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  for (const std::pair<const std::string, vtkInternal::CacheEntry>& entry : this->Internal->Entries)
+    {
+    std::string fileName = this->RemoteCacheDirectory + "/" + entry.first;
+    if (entry.second.ContentHash == contentHash && vtksys::SystemTools::FileExists(fileName, true))
+      {
+      return fileName;
+      }
+    }
+  return std::string();
+}
+
+//----------------------------------------------------------------------------
+float vtkCacheManager::GetIndexedCacheSize()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  vtkTypeInt64 size = 0;
+  std::set<std::string> countedContents;
+  for (const std::pair<const std::string, vtkInternal::CacheEntry>& entry : this->Internal->Entries)
+    {
+    if (entry.second.ContentHash.empty() || countedContents.insert(entry.second.ContentHash).second)
+      {
+      size += entry.second.Size;
+      }
+    }
+  return static_cast<float>(size / MB);
+}
+
+//----------------------------------------------------------------------------
+bool vtkCacheManager::IsCachedFileInUse(const std::string& fileName)
+{
+  if (this->MRMLScene == nullptr)
+    {
+    return false;
+    }
+  std::string collapsedFileName = vtksys::SystemTools::CollapseFullPath(fileName);
+  int nnodes = this->MRMLScene->GetNumberOfNodesByClass ( "vtkMRMLStorageNode" );
+  for ( int n=0; n < nnodes; n++ )
+    {
+    vtkMRMLStorageNode* storageNode = vtkMRMLStorageNode::SafeDownCast(
+      this->MRMLScene->GetNthNodeByClass(n, "vtkMRMLStorageNode"));
+    if (storageNode == nullptr)
+      {
+      continue;
+      }
+    if (storageNode->GetFileName()
+        && vtksys::SystemTools::CollapseFullPath(storageNode->GetFullNameFromFileName()) == collapsedFileName)
+      {
+      return true;
+      }
+    for (int i = 0; i < storageNode->GetNumberOfFileNames(); ++i)
+      {
+      if (vtksys::SystemTools::CollapseFullPath(storageNode->GetFullNameFromNthFileName(i)) == collapsedFileName)
+        {
+        return true;
+        }
+      }
+    }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+int vtkCacheManager::FreeCacheSpace ( float requiredSize )
+{
+  float availableSize = static_cast<float>(this->RemoteCacheLimit - this->RemoteCacheFreeBufferSize);
+  float cacheSize = this->GetIndexedCacheSize();
+  if (cacheSize + requiredSize <= availableSize)
+    {
+    return 1;
+    }
+
+  // Group the files that share the same content: the space is freed only
+  // when all of them are removed.
+  struct ContentGroup
+    {
+    vtkTypeInt64 LastAccessTime{0};
+    vtkTypeInt64 Size{0};
+    std::vector<std::string> RelativePaths;
+    };
+  std::vector<ContentGroup> groups;
+  {
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    std::map<std::string, size_t> groupIndexByContent;
+    for (const std::pair<const std::string, vtkInternal::CacheEntry>& entry : this->Internal->Entries)
+      {
+      std::string contentKey = entry.second.ContentHash.empty() ? "path:" + entry.first : entry.second.ContentHash;
+      std::map<std::string, size_t>::iterator it = groupIndexByContent.find(contentKey);
+      if (it == groupIndexByContent.end())
+        {
+        it = groupIndexByContent.insert(std::make_pair(contentKey, groups.size())).first;
+        groups.emplace_back();
+        groups.back().Size = entry.second.Size;
+        }
+      ContentGroup& group = groups[it->second];
+      group.LastAccessTime = std::max(group.LastAccessTime, entry.second.LastAccessTime);
+      group.RelativePaths.push_back(entry.first);
+      }
+  }
+  std::sort(groups.begin(), groups.end(), [](const ContentGroup& a, const ContentGroup& b)
+    {
+    return a.LastAccessTime < b.LastAccessTime;
+    });
+
+  bool removed = false;
+  for (const ContentGroup& group : groups)
+    {
+    if (cacheSize + requiredSize <= availableSize)
+      {
+      break;
+      }
+    bool inUse = false;
+    for (const std::string& relativePath : group.RelativePaths)
+      {
+      inUse = inUse || this->IsCachedFileInUse(this->RemoteCacheDirectory + "/" + relativePath);
+      }
+    if (inUse)
+      {
+      continue;
+      }
+    for (const std::string& relativePath : group.RelativePaths)
+      {
+      std::string fileName = this->RemoteCacheDirectory + "/" + relativePath;
+      vtkDebugMacro("FreeCacheSpace: removing least recently used file " << fileName);
+      if (!vtksys::SystemTools::RemoveFile(fileName))
+        {
+        vtkWarningMacro("FreeCacheSpace: unable to remove cached file " << fileName << " from disk.");
+        }
+      }
+    cacheSize -= static_cast<float>(group.Size / MB);
+    removed = true;
+    }
+
+  if (removed)
+    {
+    this->UpdateCacheInformation();
+    this->InvokeEvent ( vtkCacheManager::CacheDeleteEvent );
+    }
+  return cacheSize + requiredSize <= availableSize ? 1 : 0;
+}
+
 
 
 
@@ -824,8 +1420,7 @@ float vtkCacheManager::ComputeCacheSize( const char *dirName, unsigned long sz )
     return (-1);
     }
 
-  int byteSize = static_cast<int>(cachesize );
-  this->CurrentCacheSize =  (float)byteSize / MB;
+  this->CurrentCacheSize = static_cast<float>(cachesize / MB);
   return (this->CurrentCacheSize);
 }
 
@@ -116,6 +116,67 @@ class VTK_MRML_EXPORT vtkCacheManager : public vtkObject
 
   std::vector< std::string > GetCachedFiles()const;
 
+  ///
+  /// Register a file downloaded from \a uri into the cache directory.
+  /// The size and content hash of the file are recorded in the cache index,
+  /// which is saved in the cache directory (see GetCacheIndexFileName()).
+  /// If a file with the same content is already cached (e.g. downloaded
+  /// from another URI), \a fileName is replaced by a hard link to it so
+  /// that the data is stored only once. Linked files share their content,
+  /// so they are made read-only: use UnlinkCachedFile() before writing one.
+  /// This method can be called from any thread and does not invoke events.
+  /// Returns 1 on success, 0 if the file is not in the cache directory.
+  int AddFileToCache ( const char *uri, const char *fileName );
+
+  ///
+  /// Record that a cached file has just been used, so that the least
+  /// recently used files are removed first by FreeCacheSpace().
+  /// The access time is saved in the cache index by SaveCacheIndex().
+  /// This method can be called from any thread.
+  void UpdateCachedFileAccessTime ( const char *fileName );
+
+  ///
+  /// Write the cache index if it changed since it was last written.
+  /// Changes of the cached files are written immediately, while access
+  /// times are written by this method, which is called when the cache
+  /// directory changes and on destruction.
+  void SaveCacheIndex();
+
+  ///
+  /// If \a fileName is a hard link to the content of other cached files
+  /// (see AddFileToCache()), remove it from the cache so that it can be
+  /// downloaded again without modifying the other files.
+  /// Returns true if the file was removed.
+  bool UnlinkCachedFile ( const char *fileName );
+
+  ///
+  /// Return the content hash of a file registered with AddFileToCache(),
+  /// or an empty string if the file is not in the cache index.
+  std::string GetCachedFileContentHash ( const char *fileName );
+
+  ///
+  /// Return the full path of a cached file that has the given content hash,
+  /// or an empty string if there is none.
+  std::string FindCachedFileByContentHash ( const std::string& contentHash );
+
+  ///
+  /// Remove the least recently used files from the cache until \a requiredSize
+  /// (in MB) can be added without exceeding RemoteCacheLimit minus
+  /// RemoteCacheFreeBufferSize. Files with the same content count once.
+  /// Files that are used by storage nodes of the scene are kept.
+  /// Invokes CacheDeleteEvent if any file is removed.
+  /// Returns 1 if there is enough space in the cache.
+  int FreeCacheSpace ( float requiredSize = 0.0 );
+
+  ///
+  /// Return the size (in MB) of the files in the cache index,
+  /// counting files with the same content once.
+  float GetIndexedCacheSize();
+
+  ///
+  /// Name of the cache index file in the cache directory.
+  static const char* GetCacheIndexFileName();
+
   ///
   vtkGetMacro ( RemoteCacheLimit, int );
   vtkSetMacro ( RemoteCacheLimit, int );
@@ -165,6 +226,10 @@ class VTK_MRML_EXPORT vtkCacheManager : public vtkObject
 
   std::string RemoteCacheDirectory;
   int GetCachedFileList(const char *dirname);
+  /// Read the cache index of RemoteCacheDirectory
+  void LoadCacheIndex();
+  /// Return true if a storage node of the scene uses the file
+  bool IsCachedFileInUse(const std::string& fileName);
   std::vector< std::string > GetAllCachedFiles();
   /// This array contains a list of cached file names (without paths)
   /// in case it's faster to search thru this list than to
@@ -182,6 +247,8 @@ class VTK_MRML_EXPORT vtkCacheManager : public vtkObject
   /// Holder for callback
   vtkCallbackCommand *CallbackCommand;
 
+  class vtkInternal;
+  vtkInternal* Internal;
 };
 
 #endif
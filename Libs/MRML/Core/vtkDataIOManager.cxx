@@ -25,6 +25,7 @@ vtkDataIOManager::vtkDataIOManager()
   this->DataTransferCollection = vtkCollection::New();
   this->CacheManager = nullptr;
   this->EnableAsynchronousIO = 0;
+  this->MaximumNumberOfConcurrentTransfers = 4;
 
   //--- set up callback
   this->TransferUpdateCommand = vtkCallbackCommand::New();
@@ -100,6 +101,7 @@ void vtkDataIOManager::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "DataTransferCollection: " << this->GetDataTransferCollection() << "\n";
   os << indent << "CacheManager: " << this->GetCacheManager() << "\n";
   os << indent << "EnableAsynchronousIO: " << this->GetEnableAsynchronousIO() << "\n";
+  os << indent << "MaximumNumberOfConcurrentTransfers: " << this->GetMaximumNumberOfConcurrentTransfers() << "\n";
 
 }
 
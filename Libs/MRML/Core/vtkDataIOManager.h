@@ -40,6 +40,14 @@ class VTK_MRML_EXPORT vtkDataIOManager : public vtkObject
 
   void SetEnableAsynchronousIO ( int );
 
+  ///
+  /// Maximum number of remote transfers that run at the same time when
+  /// asynchronous IO is enabled. The other transfers wait in a queue.
+  /// The transfers also share the networking threads of the application logic.
+  /// Default is 4.
+  vtkSetClampMacro ( MaximumNumberOfConcurrentTransfers, int, 1, VTK_INT_MAX );
+  vtkGetMacro ( MaximumNumberOfConcurrentTransfers, int );
+
   ///
   /// Creates and adds a new data transfer object to the collection
   vtkDataTransfer *AddNewDataTransfer ( );
@@ -97,7 +105,10 @@ class VTK_MRML_EXPORT vtkDataIOManager : public vtkObject
       TransferUpdateEvent,
       SettingsUpdateEvent,
       DisplayManagerWindowEvent,
-      RefreshDisplayEvent
+      RefreshDisplayEvent,
+      /// Invoked in the main thread when an asynchronous transfer is done
+      /// (completed, failed or cancelled), with the vtkDataTransfer as call data.
+      TransferDoneEvent
     };
 
   /// function that gets called when a data transfer has been updated.
@@ -112,6 +123,7 @@ class VTK_MRML_EXPORT vtkDataIOManager : public vtkObject
   vtkCollection *DataTransferCollection;
   vtkCacheManager *CacheManager;
   int EnableAsynchronousIO;
+  int MaximumNumberOfConcurrentTransfers;
 
   vtkDataFileFormatHelper* FileFormatHelper;
 
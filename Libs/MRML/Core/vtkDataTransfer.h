@@ -46,6 +46,13 @@ class VTK_MRML_EXPORT vtkDataTransfer : public vtkObject
       this->TransferStatus = val;
       }
 
+  /// Set the progress (in percent) without invoking a modified event,
+  /// for use from the thread running the transfer.
+  void SetProgressNoModify ( int val)
+      {
+      this->Progress = val;
+      }
+
   const char* GetTransferStatusString( ) {
     switch (this->TransferStatus)
       {
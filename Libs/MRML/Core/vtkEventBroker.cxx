@@ -19,9 +19,18 @@
 // VTK includes
 #include <vtkCallbackCommand.h>
 #include <vtkCollection.h>
+#include <vtkDoubleArray.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
 #include <vtkObjectFactory.h>
+#include <vtkStringArray.h>
+#include <vtkTable.h>
 #include <vtkTimerLog.h>
 
+// STD includes
+#include <algorithm>
+#include <string>
+
 vtkCxxSetObjectMacro(vtkEventBroker, TimerLog, vtkTimerLog);
 vtkCxxSetObjectMacro(vtkEventBroker, RequestModifiedCallback, vtkCallbackCommand);
 
@@ -94,6 +103,7 @@ vtkEventBroker::vtkEventBroker()
   this->EventMode = vtkEventBroker::Synchronous;
   this->EventLogging = 0;
   this->EventNestingLevel = 0;
+  this->EventProfiling = 0;
   this->TimerLog = vtkTimerLog::New();
   this->CompressCallData = 0;
   this->LogFileName = nullptr;
@@ -140,13 +150,52 @@ void vtkEventBroker::DetachObservations()
     for(oiter=(mapiter->second).begin(); oiter != (mapiter->second).end(); oiter++)
       {
       this->DetachObservation (*oiter);
-      // Ideally the observation should be removed from SubjectMap and
-      // ObserverMap. This is what RemoveObservations() does, but it takes
+      // Ideally the observation should be removed from the observation
+      // maps one by one. This is what RemoveObservations() does, but it takes
       // time.
       (*oiter)->Delete();
       }
     }
   this->SubjectMap.clear();
+  this->ObserverMap.clear();
+  this->SubjectEventMap.clear();
+}
+
+//----------------------------------------------------------------------------
+namespace
+{
+template <class MapType, class KeyType>
+void RemoveObservationFromMap(MapType& observationMap, const KeyType& key, vtkObservation* observation)
+{
+  typename MapType::iterator mapIt = observationMap.find(key);
+  if (mapIt == observationMap.end())
+    {
+    return;
+    }
+  mapIt->second.erase(observation);
+  if (mapIt->second.empty())
+    {
+    // do not accumulate entries for objects that are not observed anymore
+    observationMap.erase(mapIt);
+    }
+}
+}
+
+//----------------------------------------------------------------------------
+void vtkEventBroker::IndexObservation (vtkObservation *observation)
+{
+  this->SubjectMap[observation->GetSubject()].insert( observation );
+  this->ObserverMap[observation->GetObserver()].insert( observation );
+  this->SubjectEventMap[SubjectEventKey(observation->GetSubject(), observation->GetEvent())].insert( observation );
+}
+
+//----------------------------------------------------------------------------
+void vtkEventBroker::UnindexObservation (vtkObservation *observation)
+{
+  RemoveObservationFromMap(this->SubjectMap, observation->GetSubject(), observation);
+  RemoveObservationFromMap(this->ObserverMap, observation->GetObserver(), observation);
+  RemoveObservationFromMap(this->SubjectEventMap,
+    SubjectEventKey(observation->GetSubject(), observation->GetEvent()), observation);
 }
 
 //----------------------------------------------------------------------------
@@ -157,13 +206,12 @@ vtkObservation *vtkEventBroker::AddObservation (
 
   vtkObservation *observation = vtkObservation::New();
   observation->SetEventBroker( this );
-  this->SubjectMap[subject].insert( observation );
-  this->ObserverMap[observer].insert( observation );
   observation->AssignSubject( subject );
   observation->SetEvent( event );
   observation->AssignObserver( observer );
   observation->SetCallbackCommand( notify );
   observation->SetPriority( priority );
+  this->IndexObservation( observation );
 
   this->AttachObservation( observation );
 
@@ -188,7 +236,6 @@ vtkObservation *vtkEventBroker::AddObservation (
 {
   vtkObservation *observation = vtkObservation::New();
   observation->SetEventBroker( this );
-  this->SubjectMap[subject].insert( observation );
   observation->AssignSubject( subject );
 
   // figure out event either as a predefined string, or
@@ -200,6 +247,7 @@ vtkObservation *vtkEventBroker::AddObservation (
     }
   observation->SetEvent( eventID );
   observation->SetScript( script );
+  this->IndexObservation( observation );
 
   this->AttachObservation( observation );
 
@@ -296,23 +344,19 @@ void vtkEventBroker::RemoveObservations (ObservationVector observations)
 
   ObservationVector::iterator inObsIter;
 
+  bool inEventQueue = false;
   for(inObsIter=observations.begin(); inObsIter != observations.end(); inObsIter++)
     {
-    vtkObservation *inObs = (*inObsIter);
-    ObservationVector& subjectObservations = this->SubjectMap[(*inObsIter)->GetSubject()];
-    subjectObservations.erase(subjectObservations.find(inObs));
-    }
-
-  for(inObsIter=observations.begin(); inObsIter != observations.end(); inObsIter++)
-    {
-    vtkObservation *inObs = (*inObsIter);
-    ObservationVector& observerObservations = this->ObserverMap[inObs->GetObserver()];
-    observerObservations.erase(observerObservations.find(inObs));
+    this->UnindexObservation( *inObsIter );
+    if ( (*inObsIter)->GetInEventQueue() )
+      {
+      inEventQueue = true;
+      }
     }
 
   // remove from event queue
   std::deque< vtkObservation *>::iterator queueIter;
-  for(queueIter=this->EventQueue.begin(); queueIter != this->EventQueue.end();)
+  for(queueIter=this->EventQueue.begin(); inEventQueue && queueIter != this->EventQueue.end();)
     {
     // foreach of the broker's observations see if it is in the list of items to be removed
     if (observations.find(*queueIter)!=observations.end())
@@ -370,9 +414,12 @@ vtkEventBroker::ObservationVector vtkEventBroker
 ::GetSubjectObservations (vtkObject *observer)
 {
   // find matching observations to remove
-  ObservationVector observationList = this->ObserverMap[observer];
-
-  return( observationList );
+  ObjectToObservationVectorMap::iterator mapIt = this->ObserverMap.find(observer);
+  if (mapIt == this->ObserverMap.end())
+    {
+    return ObservationVector();
+    }
+  return( mapIt->second );
 }
 
 //----------------------------------------------------------------------------
@@ -388,14 +435,44 @@ vtkEventBroker::ObservationVector vtkEventBroker::GetObservations (
     return observationList;
     }
   // find matching observations to remove
-  ObservationVector& subjectList = this->SubjectMap[subject];
+  // - start from the shortest list of the subject, (subject,event) and observer maps
+  ObjectToObservationVectorMap::iterator subjectIt = this->SubjectMap.find(subject);
+  if (subjectIt == this->SubjectMap.end())
+    {
+    return observationList;
+    }
+  const ObservationVector* candidateList = &(subjectIt->second);
+  if (event != 0)
+    {
+    SubjectEventToObservationVectorMap::iterator subjectEventIt = this->SubjectEventMap.find(SubjectEventKey(subject, event));
+    if (subjectEventIt == this->SubjectEventMap.end())
+      {
+      return observationList;
+      }
+    if (subjectEventIt->second.size() < candidateList->size())
+      {
+      candidateList = &(subjectEventIt->second);
+      }
+    }
+  if (observer != nullptr)
+    {
+    ObjectToObservationVectorMap::iterator observerIt = this->ObserverMap.find(observer);
+    if (observerIt == this->ObserverMap.end())
+      {
+      return observationList;
+      }
+    if (observerIt->second.size() < candidateList->size())
+      {
+      candidateList = &(observerIt->second);
+      }
+    }
 
-  for(ObservationVector::iterator obsIter = subjectList.begin();
-      obsIter != subjectList.end();
+  for(ObservationVector::const_iterator obsIter = candidateList->begin();
+      obsIter != candidateList->end();
       ++obsIter)
     {
     if ( (observer == nullptr || (*obsIter)->GetObserver() == observer) &&
-         //(subject == 0 || (*obsIter)->GetSubject() == subject) &&
+         (*obsIter)->GetSubject() == subject &&
          (event == 0 || (*obsIter)->GetEvent() == event) &&
          (notify == nullptr || (*obsIter)->GetCallbackCommand() == notify))
       {
@@ -425,8 +502,13 @@ vtkEventBroker::ObservationVector vtkEventBroker::GetObservationsForSubjectByTag
 {
   // find matching observations to remove
   // - all tags match 0
-  ObservationVector& subjectList = this->SubjectMap[subject];
   ObservationVector observationList;
+  ObjectToObservationVectorMap::iterator mapIt = this->SubjectMap.find(subject);
+  if (mapIt == this->SubjectMap.end())
+    {
+    return ( observationList );
+    }
+  ObservationVector& subjectList = mapIt->second;
   for (ObservationVector::iterator obsIter = subjectList.begin();
        obsIter != subjectList.end(); obsIter++)
     {
@@ -444,7 +526,12 @@ vtkEventBroker::ObservationVector vtkEventBroker::GetObservationsForSubjectByTag
 vtkCollection *vtkEventBroker::GetObservationsForSubject ( vtkObject *subject )
 {
   vtkCollection *collection = vtkCollection::New();
-  ObservationVector& subjectList = this->SubjectMap[subject];
+  ObjectToObservationVectorMap::iterator mapIt = this->SubjectMap.find(subject);
+  if (mapIt == this->SubjectMap.end())
+    {
+    return collection;
+    }
+  ObservationVector& subjectList = mapIt->second;
   for(ObservationVector::iterator iter=subjectList.begin();
       iter != subjectList.end(); iter++)
     {
@@ -460,7 +547,12 @@ vtkCollection *vtkEventBroker::GetObservationsForSubject ( vtkObject *subject )
 vtkCollection *vtkEventBroker::GetObservationsForObserver ( vtkObject *observer )
 {
   vtkCollection *collection = vtkCollection::New();
-  ObservationVector& observerList = this->ObserverMap[observer];
+  ObjectToObservationVectorMap::iterator mapIt = this->ObserverMap.find(observer);
+  if (mapIt == this->ObserverMap.end())
+    {
+    return collection;
+    }
+  ObservationVector& observerList = mapIt->second;
   for (ObservationVector::iterator iter = observerList.begin();
        iter != observerList.end(); iter++)
     {
@@ -578,6 +670,113 @@ int vtkEventBroker::GenerateGraphFile ( const char *graphFile )
   return 0;
 }
 
+//----------------------------------------------------------------------------
+void vtkEventBroker::GetEventProfile ( vtkTable *table )
+{
+  if ( !table )
+    {
+    vtkErrorMacro( "GetEventProfile: invalid table" );
+    return;
+    }
+
+  std::vector< vtkObservation* > invokedObservations;
+  ObjectToObservationVectorMap::iterator iter;
+  for (iter = this->SubjectMap.begin(); iter != this->SubjectMap.end(); ++iter)
+    {
+    for (vtkObservation* observation : iter->second)
+      {
+      if ( observation->GetInvocationCount() > 0 )
+        {
+        invokedObservations.push_back( observation );
+        }
+      }
+    }
+  std::sort( invokedObservations.begin(), invokedObservations.end(),
+    [](vtkObservation* a, vtkObservation* b)
+      {
+      return a->GetTotalSelfElapsedTime() > b->GetTotalSelfElapsedTime();
+      });
+
+  vtkNew<vtkStringArray> subjectArray;
+  subjectArray->SetName( "Subject" );
+  vtkNew<vtkStringArray> eventArray;
+  eventArray->SetName( "Event" );
+  vtkNew<vtkStringArray> observerArray;
+  observerArray->SetName( "Observer" );
+  vtkNew<vtkIntArray> invocationCountArray;
+  invocationCountArray->SetName( "InvocationCount" );
+  vtkNew<vtkDoubleArray> totalElapsedTimeArray;
+  totalElapsedTimeArray->SetName( "TotalElapsedTime" );
+  vtkNew<vtkDoubleArray> totalSelfElapsedTimeArray;
+  totalSelfElapsedTimeArray->SetName( "TotalSelfElapsedTime" );
+  vtkNew<vtkDoubleArray> averageSelfElapsedTimeArray;
+  averageSelfElapsedTimeArray->SetName( "AverageSelfElapsedTime" );
+  vtkNew<vtkDoubleArray> maximumElapsedTimeArray;
+  maximumElapsedTimeArray->SetName( "MaximumElapsedTime" );
+  vtkNew<vtkIntArray> maximumEventNestingLevelArray;
+  maximumEventNestingLevelArray->SetName( "MaximumEventNestingLevel" );
+
+  for (vtkObservation* observation : invokedObservations)
+    {
+    subjectArray->InsertNextValue( observation->GetSubject()->GetClassName() );
+
+    std::string eventString = vtkCommand::GetStringFromEventId( observation->GetEvent() );
+    if ( eventString == "NoEvent" )
+      {
+      eventString = std::to_string( observation->GetEvent() );
+      }
+    eventArray->InsertNextValue( eventString );
+
+    std::string observerString = "No observer class";
+    if ( observation->GetScript() != nullptr )
+      {
+      observerString = observation->GetScript();
+      }
+    else if ( observation->GetObserver() )
+      {
+      observerString = observation->GetObserver()->GetClassName();
+      }
+    observerArray->InsertNextValue( observerString );
+
+    invocationCountArray->InsertNextValue( observation->GetInvocationCount() );
+    totalElapsedTimeArray->InsertNextValue( observation->GetTotalElapsedTime() );
+    totalSelfElapsedTimeArray->InsertNextValue( observation->GetTotalSelfElapsedTime() );
+    averageSelfElapsedTimeArray->InsertNextValue(
+      observation->GetTotalSelfElapsedTime() / observation->GetInvocationCount() );
+    maximumElapsedTimeArray->InsertNextValue( observation->GetMaximumElapsedTime() );
+    maximumEventNestingLevelArray->InsertNextValue( observation->GetMaximumEventNestingLevel() );
+    }
+
+  table->Initialize();
+  table->AddColumn( subjectArray );
+  table->AddColumn( eventArray );
+  table->AddColumn( observerArray );
+  table->AddColumn( invocationCountArray );
+  table->AddColumn( totalElapsedTimeArray );
+  table->AddColumn( totalSelfElapsedTimeArray );
+  table->AddColumn( averageSelfElapsedTimeArray );
+  table->AddColumn( maximumElapsedTimeArray );
+  table->AddColumn( maximumEventNestingLevelArray );
+}
+
+//----------------------------------------------------------------------------
+void vtkEventBroker::ResetEventProfile ()
+{
+  ObjectToObservationVectorMap::iterator iter;
+  for (iter = this->SubjectMap.begin(); iter != this->SubjectMap.end(); ++iter)
+    {
+    for (vtkObservation* observation : iter->second)
+      {
+      observation->SetLastElapsedTime( 0.0 );
+      observation->SetTotalElapsedTime( 0.0 );
+      observation->SetInvocationCount( 0 );
+      observation->SetTotalSelfElapsedTime( 0.0 );
+      observation->SetMaximumElapsedTime( 0.0 );
+      observation->SetMaximumEventNestingLevel( 0 );
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkEventBroker::OpenLogFile ()
 {
@@ -713,14 +912,13 @@ void vtkEventBroker::ProcessEvent ( vtkObservation *observation, vtkObject *call
   if ( eid == vtkCommand::DeleteEvent )
     {
     // iterate list of observations for the deleted object (caller) as subject
-    ObservationVector::iterator obsIter;
-    ObservationVector& subjectList = this->SubjectMap[caller];
-    for(obsIter=subjectList.begin(); obsIter != subjectList.end(); ++obsIter)
+    SubjectEventToObservationVectorMap::iterator deleteObservationsIt =
+      this->SubjectEventMap.find(SubjectEventKey(caller, vtkCommand::DeleteEvent));
+    size_t numberOfDeleteObservations = (deleteObservationsIt != this->SubjectEventMap.end()
+      ? deleteObservationsIt->second.size() : 0);
+    for (size_t i = 0; i < numberOfDeleteObservations; ++i)
       {
-      if ( (*obsIter)->GetEvent() == vtkCommand::DeleteEvent )
-        {
-        this->InvokeObservation( observation, eid, callData );
-        }
+      this->InvokeObservation( observation, eid, callData );
       }
     if ( caller == observation->GetSubject() )
       {
@@ -755,10 +953,28 @@ void vtkEventBroker::QueueObservation ( vtkObservation *observation,
   //    one unique entry for each
   // it it's not there, add the current call data to the list so that each unique combination
   // can be invoked.
+  // If the observation coalesces events then only the most recent call data is kept for
+  // each event ID, regardless of the compression mode.
   // If the event is not currently in the queue, add it and keep a flag.
   //
   vtkObservation::CallType call(eid, callData);
-  if ( this->GetCompressCallData() &&
+  if ( observation->GetCoalesceEvents() )
+    {
+    std::deque< vtkObservation::CallType >::iterator dataIter;
+    for(dataIter=observation->GetCallDataList()->begin();dataIter != observation->GetCallDataList()->end(); dataIter++)
+      {
+      if ( call.EventID == dataIter->EventID )
+        {
+        dataIter->CallData = call.CallData;
+        break;
+        }
+      }
+    if ( dataIter == observation->GetCallDataList()->end() )
+      {
+      observation->GetCallDataList()->push_back( call );
+      }
+    }
+  else if ( this->GetCompressCallData() &&
        observation->GetEvent() != vtkCommand::AnyEvent)
     {
     observation->GetCallDataList()->clear();
@@ -820,6 +1036,11 @@ void vtkEventBroker::InvokeObservation ( vtkObservation *observation,
   this->EventNestingLevel++;
 
   double startTime = this->TimerLog->GetUniversalTime();
+  bool profiling = (this->EventProfiling != 0);
+  if (profiling)
+    {
+    this->NestedElapsedTimes.push_back(0.0);
+    }
 
   // Register so observation won't be deleted while callback is running
   observation->Register(this);
@@ -848,6 +1069,20 @@ void vtkEventBroker::InvokeObservation ( vtkObservation *observation,
   double elapsedTime = this->TimerLog->GetUniversalTime() - startTime;
   observation->SetTotalElapsedTime (observation->GetTotalElapsedTime() + elapsedTime);
   observation->SetLastElapsedTime (elapsedTime);
+  if (profiling && !this->NestedElapsedTimes.empty())
+    {
+    double nestedElapsedTime = this->NestedElapsedTimes.back();
+    this->NestedElapsedTimes.pop_back();
+    if (!this->NestedElapsedTimes.empty())
+      {
+      // the parent invocation does not include this time in its self time
+      this->NestedElapsedTimes.back() += elapsedTime;
+      }
+    observation->SetInvocationCount (observation->GetInvocationCount() + 1);
+    observation->SetTotalSelfElapsedTime (observation->GetTotalSelfElapsedTime() + elapsedTime - nestedElapsedTime);
+    observation->SetMaximumElapsedTime (std::max(observation->GetMaximumElapsedTime(), elapsedTime));
+    observation->SetMaximumEventNestingLevel (std::max(observation->GetMaximumEventNestingLevel(), this->EventNestingLevel));
+    }
   this->LogEvent (observation);
 
   // clear reference to observation (may cause delete)
@@ -899,6 +1134,7 @@ void vtkEventBroker::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EventMode: " << this->GetEventModeAsString() << "\n";
   os << indent << "EventLogging: " << this->EventLogging << "\n";
   os << indent << "EventNestingLevel: " << this->EventNestingLevel << "\n";
+  os << indent << "EventProfiling: " << this->EventProfiling << "\n";
   os << indent << "LogFileName: " <<
     (this->LogFileName ? this->LogFileName : "(none)") << "\n";
 }
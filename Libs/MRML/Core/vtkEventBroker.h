@@ -28,10 +28,13 @@ class vtkTimerLog;
 #include <set>
 #include <map>
 #include <fstream>
+#include <unordered_map>
+#include <utility>
 
 class vtkCollection;
 class vtkCallbackCommand;
 class vtkObservation;
+class vtkTable;
 
 /// \brief Class that manages adding and deleting of observers with events.
 ///
@@ -168,6 +171,31 @@ public:
   /// based on the filename and the EventLogging variable)
   void LogEvent (vtkObservation *observation);
 
+  /// Event Profiling
+  ///
+  /// Turn on recording of invocation statistics of each observation:
+  /// number of invocations, total elapsed time excluding nested invocations
+  /// ("self" time), maximum elapsed time and maximum event nesting level.
+  /// Profiling is off by default.
+  /// \sa GetEventProfile(), ResetEventProfile()
+  vtkBooleanMacro (EventProfiling, int);
+  vtkSetMacro (EventProfiling, int);
+  vtkGetMacro (EventProfiling, int);
+
+  ///
+  /// Fill \a table with one row per observation that has been invoked
+  /// since event profiling was enabled (or since the last ResetEventProfile()).
+  /// Columns: Subject (class name), Event, Observer (class name or script),
+  /// InvocationCount, TotalElapsedTime, TotalSelfElapsedTime,
+  /// AverageSelfElapsedTime, MaximumElapsedTime, MaximumEventNestingLevel.
+  /// Rows are sorted by decreasing TotalSelfElapsedTime, so the observations
+  /// that take the most time come first. Times are in seconds.
+  void GetEventProfile(vtkTable* table);
+
+  ///
+  /// Reset elapsed times and invocation statistics of all observations
+  void ResetEventProfile();
+
   /// Graph File
   ///
   /// Write out the current list of observations in graphviz format (.dot)
@@ -228,7 +256,9 @@ public:
   ///    observation is in the queue, replace the call data with the current value
   ///  - CompressCallDataOff: maintain the list of all call data values, but only
   ///    one unique entry for each
-  ///  Compression is ON by default
+  ///  Compression is OFF by default
+  ///  Independently of this setting, observations that have CoalesceEvents enabled keep
+  ///  only the most recent call data for each event (see vtkObservation::SetCoalesceEvents()).
   vtkBooleanMacro (CompressCallData, int);
   vtkGetMacro (CompressCallData, int);
   vtkSetMacro (CompressCallData, int);
@@ -272,16 +302,34 @@ protected:
   void AttachObservation (vtkObservation *observation);
   void DetachObservation (vtkObservation *observation);
 
+  ///
+  /// Add/remove the observation to/from SubjectMap, ObserverMap and SubjectEventMap.
+  void IndexObservation (vtkObservation *observation);
+  void UnindexObservation (vtkObservation *observation);
+
   friend class vtkEventBrokerInitialize;
   typedef vtkEventBroker Self;
 
 
   ///
-  typedef std::map< vtkObject*, ObservationVector > ObjectToObservationVectorMap;
+  typedef std::unordered_map< vtkObject*, ObservationVector > ObjectToObservationVectorMap;
+
+  typedef std::pair< vtkObject*, unsigned long > SubjectEventKey;
+  struct SubjectEventKeyHash
+    {
+    size_t operator()(const SubjectEventKey& key) const
+      {
+      return std::hash<vtkObject*>()(key.first) ^ (std::hash<unsigned long>()(key.second) << 1);
+      }
+    };
+  typedef std::unordered_map< SubjectEventKey, ObservationVector, SubjectEventKeyHash > SubjectEventToObservationVectorMap;
 
   /// maps to manage quick lookup by object
+  /// (entries are removed when the last observation of the object is removed)
   ObjectToObservationVectorMap SubjectMap;
   ObjectToObservationVectorMap ObserverMap;
+  /// map to manage quick lookup by subject and event
+  SubjectEventToObservationVectorMap SubjectEventMap;
 
   /// The event queue of triggered but not-yet-invoked observations
   std::deque< vtkObservation * > EventQueue;
@@ -291,6 +339,10 @@ protected:
 
   int EventLogging;
   int EventNestingLevel;
+  int EventProfiling;
+  /// Elapsed time of the nested invocations of each invocation in progress
+  /// (only used when EventProfiling is enabled)
+  std::vector<double> NestedElapsedTimes;
   char *LogFileName;
   vtkTimerLog *TimerLog;
 
@@ -304,7 +356,7 @@ protected:
 private:
   /// DetachObservations is a fast (but dangerous) method to delete all the
   /// observations. It leaves the event broker in an inconsistent state:
-  ///  - SubjectMap and ObserverMap are not being updated.
+  ///  - observation maps are cleared but the EventQueue is not being updated.
   void DetachObservations();
   /// vtkObservation can call these methods
   friend class vtkObservation;
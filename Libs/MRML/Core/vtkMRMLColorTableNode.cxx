@@ -24,6 +24,7 @@ Version:   $Revision: 1.0 $
 #include <vtkObjectFactory.h>
 
 // STD includes
+#include <cstring>
 #include <random>
 #include <sstream>
 
@@ -1495,6 +1496,76 @@ vtkLookupTable* vtkMRMLColorTableNode::GetLookupTable()
   return this->LookupTable;
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLColorTableNode::UpdateSparseLabelColorMap()
+{
+  vtkLookupTable* lut = this->GetLookupTable();
+  if (lut == this->SparseLabelColorMapLookupTable
+    && (!lut || lut->GetMTime() <= this->SparseLabelColorMapBuildTime.GetMTime()))
+    {
+    return;
+    }
+  this->SparseLabelColorMap.clear();
+  this->SparseLabelColorMapRange[0] = 0;
+  this->SparseLabelColorMapRange[1] = -1;
+  this->SparseLabelColorMapLookupTable = lut;
+  this->SparseLabelColorMapBuildTime.Modified();
+  if (!lut || lut->GetNumberOfTableValues() == 0)
+    {
+    return;
+    }
+
+  vtkIdType numberOfColors = lut->GetNumberOfTableValues();
+  // Same table range adjustment as in vtkMRMLLabelMapVolumeDisplayNode
+  int firstLabelValue = 0;
+  if (lut->GetTableRange()[1] - lut->GetTableRange()[0] + 1 == numberOfColors)
+    {
+    firstLabelValue = static_cast<int>(lut->GetTableRange()[0]);
+    }
+  this->SparseLabelColorMapRange[0] = firstLabelValue;
+  this->SparseLabelColorMapRange[1] = firstLabelValue + static_cast<int>(numberOfColors) - 1;
+
+  const unsigned char* table = lut->GetPointer(0);
+  for (vtkIdType colorIndex = 0; colorIndex < numberOfColors; ++colorIndex)
+    {
+    vtkTypeUInt32 rgba = 0;
+    memcpy(&rgba, table + colorIndex * 4, 4);
+    if (rgba != 0)
+      {
+      this->SparseLabelColorMap[firstLabelValue + static_cast<int>(colorIndex)] = rgba;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLColorTableNode::HasSparseLabelColors()
+{
+  // Small tables are always mapped most efficiently by direct indexing
+  const int minimumNumberOfColors = 1024;
+  int numberOfColors = this->GetNumberOfColors();
+  if (numberOfColors < minimumNumberOfColors)
+    {
+    return false;
+    }
+  this->UpdateSparseLabelColorMap();
+  return this->SparseLabelColorMap.size() * 4 < static_cast<size_t>(numberOfColors);
+}
+
+//----------------------------------------------------------------------------
+const vtkMRMLColorTableNode::SparseLabelColorMapType& vtkMRMLColorTableNode::GetSparseLabelColorMap()
+{
+  this->UpdateSparseLabelColorMap();
+  return this->SparseLabelColorMap;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLColorTableNode::GetSparseLabelColorMapRange(int range[2])
+{
+  this->UpdateSparseLabelColorMap();
+  range[0] = this->SparseLabelColorMapRange[0];
+  range[1] = this->SparseLabelColorMapRange[1];
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLColorTableNode::SetAndObserveLookupTable(vtkLookupTable *lut)
 {
@@ -17,6 +17,13 @@
 
 #include "vtkMRMLColorNode.h"
 
+// VTK includes
+#include <vtkTimeStamp.h>
+#include <vtkType.h>
+
+// STD includes
+#include <unordered_map>
+
 /// \brief MRML node to represent discrete color information.
 ///
 /// Color nodes describe color look up tables. The tables may be pre-generated by
@@ -237,6 +244,28 @@ public:
   /// Create default storage node or nullptr if does not have one
   vtkMRMLStorageNode* CreateDefaultStorageNode() override;
 
+  /// Map from label value to RGBA color (4 bytes, in memory order, packed into an integer).
+  typedef std::unordered_map<int, vtkTypeUInt32> SparseLabelColorMapType;
+
+  /// Return true if the table has many entries but only a small fraction of them
+  /// have a visible color (for example, label tables with large label values, such as
+  /// FreeSurfer labels). Label maps that use such tables are mapped to colors
+  /// faster using GetSparseLabelColorMap() than using the full lookup table.
+  /// \sa GetSparseLabelColorMap()
+  bool HasSparseLabelColors();
+
+  /// Get compact mapping of label values to colors, which only contains
+  /// entries of the lookup table that are not fully transparent black.
+  /// Label values are table indices, offset by the start of the table range if
+  /// the range matches the number of colors (same as label map display).
+  /// The map is rebuilt only when the lookup table changes.
+  /// \sa HasSparseLabelColors()
+  const SparseLabelColorMapType& GetSparseLabelColorMap();
+
+  /// Get the range of label values that GetSparseLabelColorMap() covers.
+  /// Label values outside of this range are displayed with the color of the closest end.
+  void GetSparseLabelColorMapRange(int range[2]);
+
 protected:
   vtkMRMLColorTableNode();
   ~vtkMRMLColorTableNode() override;
@@ -247,6 +276,14 @@ protected:
   /// The look up table, constructed according to the Type
   vtkLookupTable *LookupTable;
 
+  /// Rebuild SparseLabelColorMap if the lookup table changed since it was built.
+  void UpdateSparseLabelColorMap();
+
+  SparseLabelColorMapType SparseLabelColorMap;
+  int SparseLabelColorMapRange[2]{0, -1};
+  vtkTimeStamp SparseLabelColorMapBuildTime;
+  vtkLookupTable* SparseLabelColorMapLookupTable{nullptr};
+
 };
 
 #endif
@@ -38,11 +38,17 @@
 // VTK includes
 #include <vtkCallbackCommand.h>
 #include <vtkGeneralTransform.h>
+#include <vtkNew.h>
 #include <vtkStringArray.h>
 #include <vtkTestErrorObserver.h>
+#include <vtkTimerLog.h>
 #include <vtkURIHandler.h>
 #include <vtkXMLDataParser.h>
 
+// STD includes
+#include <algorithm>
+#include <fstream>
+
 namespace vtkMRMLCoreTestingUtilities
 {
 
@@ -716,6 +722,68 @@ std::vector<unsigned long> vtkMRMLNodeCallback::GetReceivedEvents()
   return receivedEvents;
 }
 
+//---------------------------------------------------------------------------
+bool ReadBenchmarkBaselines(const std::string& fileName, std::map<std::string, double>& baselines)
+{
+  std::ifstream baselineFile(fileName.c_str());
+  if (!baselineFile.is_open())
+    {
+    std::cerr << "ReadBenchmarkBaselines: failed to open file " << fileName << std::endl;
+    return false;
+    }
+  std::string line;
+  while (std::getline(baselineFile, line))
+    {
+    std::istringstream lineStream(line);
+    std::string name;
+    double maximumTime = 0.0;
+    if (!(lineStream >> name) || name[0] == '#')
+      {
+      continue;
+      }
+    if (!(lineStream >> maximumTime))
+      {
+      std::cerr << "ReadBenchmarkBaselines: invalid line in " << fileName << ": " << line << std::endl;
+      return false;
+      }
+    baselines[name] = maximumTime;
+    }
+  return true;
+}
+
+//---------------------------------------------------------------------------
+bool RunBenchmark(const std::string& name, const std::map<std::string, double>& baselines,
+  int numberOfRepetitions, std::function<void()> function, std::function<void()> setup)
+{
+  vtkNew<vtkTimerLog> timer;
+  double shortestTime = -1.0;
+  for (int repetition = 0; repetition < std::max(numberOfRepetitions, 1); ++repetition)
+    {
+    if (setup)
+      {
+      setup();
+      }
+    timer->StartTimer();
+    function();
+    timer->StopTimer();
+    if (shortestTime < 0 || timer->GetElapsedTime() < shortestTime)
+      {
+      shortestTime = timer->GetElapsedTime();
+      }
+    }
+  std::cout << "<DartMeasurement name=\"" << name << "\" type=\"numeric/double\">"
+            << shortestTime << "</DartMeasurement>" << std::endl;
+
+  std::map<std::string, double>::const_iterator baselineIt = baselines.find(name);
+  if (baselineIt != baselines.end() && shortestTime > baselineIt->second)
+    {
+    std::cerr << "Benchmark " << name << " took " << shortestTime
+              << "s, more than the baseline " << baselineIt->second << "s" << std::endl;
+    return false;
+    }
+  return true;
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLNodeCallback::PrintSelf(ostream& os, vtkIndent indent)
 {
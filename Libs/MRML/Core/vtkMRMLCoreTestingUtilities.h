@@ -28,6 +28,7 @@
 #include <vtkCallbackCommand.h>
 
 // STD includes
+#include <functional>
 #include <sstream>
 #include <vector>
 #include <map>
@@ -117,6 +118,23 @@ int ExerciseBasicTransformMRMLMethods(vtkMRMLTransformNode* node);
 VTK_MRML_EXPORT
 int ExerciseSceneLoadingMethods(const char * sceneFilePath, vtkMRMLScene* inputScene = nullptr);
 
+/// Read benchmark baselines from a text file.
+/// Each line contains a benchmark name and the maximum accepted time in seconds,
+/// separated by whitespace. Empty lines and lines starting with # are ignored.
+/// Returns false if the file cannot be read.
+VTK_MRML_EXPORT
+bool ReadBenchmarkBaselines(const std::string& fileName, std::map<std::string, double>& baselines);
+
+/// Measure the time of a benchmark function.
+/// The function is run numberOfRepetitions times and the shortest time is reported
+/// as a DartMeasurement (so that the dashboard keeps its history).
+/// The optional setup function is called before each repetition and is not timed.
+/// Returns false if a baseline is specified for this benchmark name and
+/// the shortest time is longer than the baseline.
+VTK_MRML_EXPORT
+bool RunBenchmark(const std::string& name, const std::map<std::string, double>& baselines,
+  int numberOfRepetitions, std::function<void()> function, std::function<void()> setup = nullptr);
+
 //---------------------------------------------------------------------------
 class VTK_MRML_EXPORT vtkMRMLNodeCallback : public vtkCallbackCommand
 {
@@ -49,6 +49,8 @@ vtkMRMLDiffusionTensorVolumeDisplayNode
  this->ScalarInvariant = vtkMRMLDiffusionTensorDisplayPropertiesNode::ColorOrientation;
  this->DTIMathematics = vtkDiffusionTensorMathematics::New();
  this->DTIMathematicsAlpha = vtkDiffusionTensorMathematics::New();
+ // Switching between scalar invariants reuses the already computed eigensystems
+ this->DTIMathematics->CacheEigensystemsOn();
  this->Threshold->SetInputConnection( this->DTIMathematics->GetOutputPort());
  this->MapToWindowLevelColors->SetInputConnection( this->DTIMathematics->GetOutputPort());
 
@@ -45,6 +45,11 @@ vtkMRMLDiffusionTensorVolumeSliceDisplayNode::vtkMRMLDiffusionTensorVolumeSliceD
   this->DiffusionTensorGlyphFilter->SetInputConnection(this->SliceImagePort);
   this->DiffusionTensorGlyphFilter->SetResolution (1);
 
+  this->DiffusionTensorGlyphInstancesFilter = vtkDiffusionTensorGlyph::New();
+  this->DiffusionTensorGlyphInstancesFilter->SetInputConnection(this->SliceImagePort);
+  this->DiffusionTensorGlyphInstancesFilter->SetResolution (1);
+  this->DiffusionTensorGlyphInstancesFilter->OutputGlyphInstancesOn();
+
   this->ColorMode = this->colorModeScalar;
 
   this->UpdateAssignedAttribute();
@@ -57,6 +62,7 @@ vtkMRMLDiffusionTensorVolumeSliceDisplayNode::~vtkMRMLDiffusionTensorVolumeSlice
   this->RemoveObservers ( vtkCommand::ModifiedEvent, this->MRMLCallbackCommand );
   this->SetAndObserveDiffusionTensorDisplayPropertiesNodeID(nullptr);
   this->DiffusionTensorGlyphFilter->Delete();
+  this->DiffusionTensorGlyphInstancesFilter->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -123,6 +129,7 @@ void vtkMRMLDiffusionTensorVolumeSliceDisplayNode::PrintSelf(ostream& os, vtkInd
 void vtkMRMLDiffusionTensorVolumeSliceDisplayNode::SetSliceGlyphRotationMatrix(vtkMatrix4x4 *matrix)
 {
   this->DiffusionTensorGlyphFilter->SetTensorRotationMatrix(matrix);
+  this->DiffusionTensorGlyphInstancesFilter->SetTensorRotationMatrix(matrix);
   this->Modified();
 }
 
@@ -134,6 +141,7 @@ void vtkMRMLDiffusionTensorVolumeSliceDisplayNode::SetSlicePositionMatrix(vtkMat
   // because the later fire the even Modified() which will update the pipeline
   // and execute the filter that needs to be up-to-date.
   this->DiffusionTensorGlyphFilter->SetVolumePositionMatrix(matrix);
+  this->DiffusionTensorGlyphInstancesFilter->SetVolumePositionMatrix(matrix);
   Superclass::SetSlicePositionMatrix(matrix);
 }
 
@@ -141,6 +149,7 @@ void vtkMRMLDiffusionTensorVolumeSliceDisplayNode::SetSlicePositionMatrix(vtkMat
 void vtkMRMLDiffusionTensorVolumeSliceDisplayNode::SetSliceImagePort(vtkAlgorithmOutput *imagePort)
 {
   this->DiffusionTensorGlyphFilter->SetInputConnection(imagePort);
+  this->DiffusionTensorGlyphInstancesFilter->SetInputConnection(imagePort);
   this->Superclass::SetSliceImagePort(imagePort);
 }
 
@@ -151,6 +160,13 @@ vtkAlgorithmOutput* vtkMRMLDiffusionTensorVolumeSliceDisplayNode
   return this->DiffusionTensorGlyphFilter->GetOutputPort();
 }
 
+//----------------------------------------------------------------------------
+vtkAlgorithmOutput* vtkMRMLDiffusionTensorVolumeSliceDisplayNode
+::GetGlyphInstancesConnection()
+{
+  return this->DiffusionTensorGlyphInstancesFilter->GetOutputPort();
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLDiffusionTensorVolumeSliceDisplayNode::UpdateAssignedAttribute()
 {
@@ -163,6 +179,9 @@ void vtkMRMLDiffusionTensorVolumeSliceDisplayNode::UpdateAssignedAttribute()
   this->DiffusionTensorGlyphFilter->SetSourceConnection(
     dtDPN ?
     dtDPN->GetGlyphConnection() : nullptr );
+  this->DiffusionTensorGlyphInstancesFilter->SetSourceConnection(
+    dtDPN ?
+    dtDPN->GetGlyphConnection() : nullptr );
 
   if (dtDPN == nullptr ||
       this->SliceImagePort == nullptr ||
@@ -272,6 +291,13 @@ void vtkMRMLDiffusionTensorVolumeSliceDisplayNode::UpdateAssignedAttribute()
       }
     }
 
+  // Glyph instances are generated with the same parameters
+  this->DiffusionTensorGlyphInstancesFilter->ClampScalingOff();
+  this->DiffusionTensorGlyphInstancesFilter->SetResolution(this->DiffusionTensorGlyphFilter->GetResolution());
+  this->DiffusionTensorGlyphInstancesFilter->SetDimensionResolution(this->DiffusionTensorGlyphFilter->GetDimensionResolution());
+  this->DiffusionTensorGlyphInstancesFilter->SetScaleFactor(this->DiffusionTensorGlyphFilter->GetScaleFactor());
+  this->DiffusionTensorGlyphInstancesFilter->ColorGlyphsBy(this->DiffusionTensorGlyphFilter->GetScalarInvariant());
+
   // Updating the filter can be time consuming, we want to refrain from updating
   // as much as possible. Not updating the filter may result into an out-of-date
   // scalar range if AutoScalarRange is true. We infer here that the user doesn't
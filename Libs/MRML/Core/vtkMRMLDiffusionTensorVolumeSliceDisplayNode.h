@@ -82,6 +82,12 @@ class VTK_MRML_EXPORT vtkMRMLDiffusionTensorVolumeSliceDisplayNode
   /// \sa GetOutputPolyData()
   vtkAlgorithmOutput* GetOutputMeshConnection() override;
 
+  /// Return the glyph instances for the input image data: one point for each glyph,
+  /// with orientation and scale arrays, for rendering with vtkGlyph3DMapper.
+  /// Points are not transformed to slice XY, \sa GetSliceToXYMatrix().
+  /// \sa vtkDiffusionTensorGlyph::SetOutputGlyphInstances()
+  vtkAlgorithmOutput* GetGlyphInstancesConnection();
+
   ///
   /// Update the pipeline based on this node attributes
   void UpdateAssignedAttribute() override;
@@ -192,6 +198,9 @@ class VTK_MRML_EXPORT vtkMRMLDiffusionTensorVolumeSliceDisplayNode
   void operator= ( const vtkMRMLDiffusionTensorVolumeSliceDisplayNode& );
 
   vtkDiffusionTensorGlyph  *DiffusionTensorGlyphFilter;
+  /// Same as DiffusionTensorGlyphFilter but outputs glyph instances instead of geometry.
+  /// It is only executed if its output is requested.
+  vtkDiffusionTensorGlyph  *DiffusionTensorGlyphInstancesFilter;
 
   /// ALL MRML nodes
   vtkMRMLDiffusionTensorDisplayPropertiesNode *DiffusionTensorDisplayPropertiesNode;
@@ -395,6 +395,25 @@ void vtkMRMLDisplayNode::UpdateReferenceID(const char *oldID, const char *newID)
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayNode::SetVisibility(int visibility)
+{
+  if (this->Visibility == visibility)
+    {
+    return;
+    }
+  this->Visibility = visibility;
+  if (this->Visibility && this->Scene && this->Scene->GetReadDataOnDemand())
+    {
+    vtkMRMLDisplayableNode* displayableNode = this->GetDisplayableNode();
+    if (displayableNode)
+      {
+      displayableNode->ReadPendingData();
+      }
+    }
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 vtkMRMLDisplayableNode* vtkMRMLDisplayNode::GetDisplayableNode()
 {
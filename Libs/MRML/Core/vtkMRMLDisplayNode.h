@@ -251,8 +251,10 @@ public:
   //@}
 
   /// Set the visibility of the display node.
+  /// If the display node is shown and reading of the displayable node's data
+  /// was deferred (see vtkMRMLScene::SetReadDataOnDemand()) then the data is read.
   /// \sa Visibility, GetVisibility(), VisibilityOn(), VisibilityOff()
-  vtkSetMacro(Visibility, int);
+  virtual void SetVisibility(int visibility);
   /// Get the visibility of the display node.
   /// \sa Visibility, SetVisibility(), VisibilityOn(), VisibilityOff()
   vtkGetMacro(Visibility, int);
@@ -114,6 +114,11 @@ class VTK_MRML_EXPORT vtkMRMLGlyphableVolumeSliceDisplayNode : public vtkMRMLMod
   /// \sa GetSliceOutputPolyData(), GetOutputPolyDataConnection()
   virtual vtkAlgorithmOutput* GetSliceOutputPort();
 
+  /// Get the transformation from glyph output coordinates to slice XY.
+  /// It can be used as actor user matrix for rendering glyph outputs
+  /// that are not transformed to slice XY (such as glyph instances).
+  vtkGetObjectMacro(SliceToXYMatrix, vtkMatrix4x4);
+
   ///
   /// Set slice to RAS transformation
   virtual void SetSlicePositionMatrix(vtkMatrix4x4 *matrix);
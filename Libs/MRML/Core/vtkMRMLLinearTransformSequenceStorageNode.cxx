@@ -9,7 +9,10 @@ or http://www.slicer.org/copyright/copyright.txt for details.
 
 // STD includes
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 #include "vtkMRMLI18N.h"
 #include "vtkMRMLLinearTransformSequenceStorageNode.h"
@@ -33,7 +36,8 @@ or http://www.slicer.org/copyright/copyright.txt for details.
 #include "vtksys/SystemTools.hxx"
 
 // Constants for reading sequence metafiles
-static const int MAX_LINE_LENGTH = 1000;
+// The header is read in blocks of this size and split into lines in memory
+static const int READ_BLOCK_SIZE = 65536;
 static std::string SEQMETA_FIELD_FRAME_FIELD_PREFIX = "Seq_Frame";
 static std::string SEQMETA_FIELD_IMG_STATUS = "ImageStatus";
 
@@ -82,6 +86,24 @@ void StringToInt(const char* strPtr, T &result)
   return;
 }
 
+//----------------------------------------------------------------------------
+/*! Parse the 16 elements of a 4x4 matrix, stored row by row, separated by whitespace */
+static bool ParseMatrixElements(const char* strPtr, double elements[16])
+{
+  for (int elementIndex = 0; elementIndex < 16; ++elementIndex)
+    {
+    char* pEnd = nullptr;
+    elements[elementIndex] = strtod(strPtr, &pEnd);
+    if (pEnd == strPtr)
+      {
+      // not enough numbers
+      return false;
+      }
+    strPtr = pEnd;
+    }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 int vtkMRMLLinearTransformSequenceStorageNode::ReadSequenceFileTransforms(const std::string& fileName, vtkMRMLScene *scene,
   std::deque< vtkSmartPointer<vtkMRMLSequenceNode> > &createdNodes, std::map< int, std::string >& frameNumberToIndexValueMap,
@@ -97,21 +119,36 @@ int vtkMRMLLinearTransformSequenceStorageNode::ReadSequenceFileTransforms(const
     return numberOfCreatedNodes;
     }
 
-  char line[MAX_LINE_LENGTH + 1] = { 0 };
-
   frameNumberToIndexValueMap.clear();
 
-  // This structure contains all the transform nodes that are read from the file.
-  // The nodes are not added immediately to the scene to allow them properly named, using the timestamp index value.
-  // Maps the frame number to a vector of transform nodes that belong to that frame.
-  std::map<int, std::vector<vtkMRMLLinearTransformNode*> > importedTransformNodes;
+  // Transforms read from the file. Only the matrix is stored while the header is parsed,
+  // transform nodes are created after the whole header is read, so that they can be
+  // properly named, using the timestamp index value.
+  struct ImportedTransform
+    {
+    int FrameNumber;
+    int TransformNameIndex;
+    double MatrixElements[16];
+    };
+  std::vector<ImportedTransform> importedTransforms;
+  // Frame field names of transforms (such as ProbeToTrackerTransform), in the order of first appearance
+  std::vector<std::string> transformNames;
+  std::map<std::string, int> transformNameToIndex;
 
   // It contains the largest frame number. It will be used to iterate through all the frame numbers from 0 to lastFrameNumber
   int lastFrameNumber = -1;
 
-  while (fgets(line, MAX_LINE_LENGTH, stream))
+  // Strings are reused for all lines to avoid repeated memory allocations
+  std::string lineStr;
+  std::string name;
+  std::string value;
+  std::string frameNumberStr;
+  std::string frameFieldName;
+
+  // Process a header line. Returns false if the end of the header is reached.
+  auto processLine = [&](const char* lineBegin, const char* lineEnd) -> bool
     {
-    std::string lineStr = line;
+    lineStr.assign(lineBegin, lineEnd);
 
     // Split line into name and value
     size_t separatorFound = 0;
@@ -121,7 +158,7 @@ int vtkMRMLLinearTransformSequenceStorageNode::ReadSequenceFileTransforms(const
       if (separatorFound != std::string::npos || lineStr.find("NRRD") == 0)
         {
         // Header definition or comment found, skip
-        continue;
+        return true;
         }
 
       separatorFound = lineStr.find_first_of(":");
@@ -137,23 +174,20 @@ int vtkMRMLLinearTransformSequenceStorageNode::ReadSequenceFileTransforms(const
         {
         // End of NRRD header
         // There are no more transforms to read
-        break;
+        return false;
         }
 
       vtkGenericWarningMacro("Parsing line failed, equal sign is missing (" << lineStr << ")");
-      continue;
+      return true;
       }
 
-    std::string name = lineStr.substr(0, separatorFound);
-    std::string value = lineStr.substr(separatorFound + 1);
-
-    if (fileType == NRRD_SEQUENCE_FILE)
+    size_t valueStart = separatorFound + 1;
+    if (fileType == NRRD_SEQUENCE_FILE && lineStr[valueStart] == '=')
       {
-      if (lineStr[separatorFound + 1] == '=')
-        {
-        value = lineStr.substr(separatorFound + 2);
-        }
+      valueStart++;
       }
+    name.assign(lineStr, 0, separatorFound);
+    value.assign(lineStr, valueStart, std::string::npos);
 
     // Trim spaces from the left and right
     Trim(name);
@@ -162,7 +196,7 @@ int vtkMRMLLinearTransformSequenceStorageNode::ReadSequenceFileTransforms(const
     if (name.compare("ElementDataFile") == 0)
       {
       // this is the last field of the header
-      break;
+      return false;
       }
 
     // Only consider the Seq_Frame
@@ -181,24 +215,21 @@ int vtkMRMLLinearTransformSequenceStorageNode::ReadSequenceFileTransforms(const
         {
         imageMetaData["NDims"] = value;
         }
-      continue;
+      return true;
       }
 
     // frame field
     // name: Seq_Frame0000_CustomTransform
-    name.erase(0, SEQMETA_FIELD_FRAME_FIELD_PREFIX.size()); // 0000_CustomTransform
-
-    // Split line into name and value
-    size_t underscoreFound;
-    underscoreFound = name.find_first_of("_");
+    size_t underscoreFound = name.find_first_of("_", SEQMETA_FIELD_FRAME_FIELD_PREFIX.size());
     if (underscoreFound == std::string::npos)
       {
       vtkGenericWarningMacro("Parsing line failed, underscore is missing from frame field name (" << lineStr << ")");
-      continue;
+      return true;
       }
 
-    std::string frameNumberStr = name.substr(0, underscoreFound); // 0000
-    std::string frameFieldName = name.substr(underscoreFound + 1); // CustomTransform
+    frameNumberStr.assign(name, SEQMETA_FIELD_FRAME_FIELD_PREFIX.size(),
+      underscoreFound - SEQMETA_FIELD_FRAME_FIELD_PREFIX.size()); // 0000
+    frameFieldName.assign(name, underscoreFound + 1, std::string::npos); // CustomTransform
 
     int frameNumber = 0;
     StringToInt(frameNumberStr.c_str(), frameNumber); // TODO: Removed warning
@@ -207,20 +238,23 @@ int vtkMRMLLinearTransformSequenceStorageNode::ReadSequenceFileTransforms(const
       lastFrameNumber = frameNumber;
       }
 
-    // Convert the string to transform and add transform to hierarchy
+    // Store the transform matrix, the transform node is created later
     if (frameFieldName.find("Transform") != std::string::npos && frameFieldName.find("Status") == std::string::npos)
       {
-      vtkNew<vtkMatrix4x4> matrix;
-      bool success = vtkAddonMathUtilities::FromString(matrix.GetPointer(), value);
-      if (!success)
+      ImportedTransform importedTransform;
+      if (!ParseMatrixElements(value.c_str(), importedTransform.MatrixElements))
+        {
+        return true;
+        }
+      importedTransform.FrameNumber = frameNumber;
+      auto transformNameIt = transformNameToIndex.find(frameFieldName);
+      if (transformNameIt == transformNameToIndex.end())
         {
-        continue;
+        transformNameIt = transformNameToIndex.emplace(frameFieldName, static_cast<int>(transformNames.size())).first;
+        transformNames.push_back(frameFieldName);
         }
-      vtkMRMLLinearTransformNode* currentTransform = vtkMRMLLinearTransformNode::New(); // will be deleted when added to the scene
-      currentTransform->SetMatrixTransformToParent(matrix.GetPointer());
-      // Generating a unique name is important because that will be used to generate the filename by default
-      currentTransform->SetName(frameFieldName.c_str());
-      importedTransformNodes[frameNumber].push_back(currentTransform);
+      importedTransform.TransformNameIndex = transformNameIt->second;
+      importedTransforms.push_back(importedTransform);
       }
 
     if (frameFieldName.compare("Timestamp") == 0)
@@ -228,91 +262,122 @@ int vtkMRMLLinearTransformSequenceStorageNode::ReadSequenceFileTransforms(const
       double timestampSec = atof(value.c_str());
       // round timestamp to 3 decimal digits, as timestamp is included in node names and having lots of decimal digits would
       // sometimes lead to extremely long node names
-      std::ostringstream timestampSecStr;
-      timestampSecStr << std::fixed << std::setprecision(3) << timestampSec << std::ends;
-      frameNumberToIndexValueMap[frameNumber] = timestampSecStr.str();
+      char timestampSecStr[64];
+      snprintf(timestampSecStr, sizeof(timestampSecStr), "%.3f", timestampSec);
+      frameNumberToIndexValueMap[frameNumber] = timestampSecStr;
       }
-
+    return true;
+    };
+
+  // Read the header in large blocks and split it into lines in memory,
+  // this is much faster than reading the file line by line.
+  std::vector<char> readBlock(READ_BLOCK_SIZE);
+  std::string buffer;
+  bool endOfHeader = false;
+  while (!endOfHeader)
+    {
+    size_t readSize = fread(readBlock.data(), 1, readBlock.size(), stream);
     if (ferror(stream))
       {
       vtkGenericWarningMacro("Error reading the file " << fileName.c_str());
       break;
       }
-    if (feof(stream))
+    if (readSize == 0)
       {
+      // end of file, process the last line if it is not terminated
+      if (!buffer.empty())
+        {
+        processLine(buffer.data(), buffer.data() + buffer.size());
+        }
       break;
       }
-
+    buffer.append(readBlock.data(), readSize);
+    const char* lineBegin = buffer.data();
+    const char* bufferEnd = buffer.data() + buffer.size();
+    const char* lineEnd = nullptr;
+    while ((lineEnd = static_cast<const char*>(memchr(lineBegin, '\n', bufferEnd - lineBegin))) != nullptr)
+      {
+      if (!processLine(lineBegin, lineEnd))
+        {
+        endOfHeader = true;
+        break;
+        }
+      lineBegin = lineEnd + 1;
+      }
+    // keep the incomplete last line
+    buffer.erase(0, lineBegin - buffer.data());
     }
   fclose(stream);
 
   // Now add all the nodes to the scene
 
-  std::map< std::string, vtkMRMLSequenceNode* > transformSequenceNodes;
+  // Sort transforms by frame number, keeping the order of transforms within a frame
+  std::stable_sort(importedTransforms.begin(), importedTransforms.end(),
+    [](const ImportedTransform& a, const ImportedTransform& b) { return a.FrameNumber < b.FrameNumber; });
 
-  for (int currentFrameNumber = 0; currentFrameNumber <= lastFrameNumber; currentFrameNumber++)
+  std::vector<vtkMRMLSequenceNode*> transformSequenceNodes(transformNames.size(), nullptr);
+  vtkNew<vtkMatrix4x4> matrix;
+  char frameNumberSuffix[32];
+  for (const ImportedTransform& importedTransform : importedTransforms)
     {
-    std::map<int, std::vector<vtkMRMLLinearTransformNode*> >::iterator transformsForCurrentFrame = importedTransformNodes.find(currentFrameNumber);
-    if (transformsForCurrentFrame == importedTransformNodes.end())
+    int currentFrameNumber = importedTransform.FrameNumber;
+    if (currentFrameNumber < 0 || currentFrameNumber > lastFrameNumber)
       {
-      // no transforms for this frame
+      // frames outside the valid range are ignored
       continue;
       }
     std::string paramValueString = frameNumberToIndexValueMap[currentFrameNumber];
-    for (std::vector<vtkMRMLLinearTransformNode*>::iterator transformIt = transformsForCurrentFrame->second.begin();
-      transformIt != transformsForCurrentFrame->second.end(); ++transformIt)
+    const std::string& frameTransformName = transformNames[importedTransform.TransformNameIndex];
+    vtkMRMLSequenceNode* transformsSequenceNode = transformSequenceNodes[importedTransform.TransformNameIndex];
+    if (!transformsSequenceNode)
       {
-      vtkMRMLLinearTransformNode* transform = (*transformIt);
-      vtkMRMLSequenceNode* transformsSequenceNode = nullptr;
-      if (transformSequenceNodes.find(transform->GetName()) == transformSequenceNodes.end())
+      // Setup hierarchy structure
+      vtkSmartPointer<vtkMRMLSequenceNode> newTransformsSequenceNode;
+      if (numberOfCreatedNodes < static_cast<int>(createdNodes.size()))
         {
-        // Setup hierarchy structure
-        vtkSmartPointer<vtkMRMLSequenceNode> newTransformsSequenceNode;
-        if (numberOfCreatedNodes < static_cast<int>(createdNodes.size()))
-          {
-          // reuse supplied sequence node
-          newTransformsSequenceNode = createdNodes[numberOfCreatedNodes];
-          newTransformsSequenceNode->RemoveAllDataNodes();
-          }
-        else
-          {
-          // Create new sequence node
-          newTransformsSequenceNode = vtkSmartPointer<vtkMRMLSequenceNode>::New();
-          createdNodes.push_back(newTransformsSequenceNode);
-          }
-        numberOfCreatedNodes++;
-        transformsSequenceNode = newTransformsSequenceNode;
-        transformsSequenceNode->SetIndexName("time");
-        transformsSequenceNode->SetIndexUnit("s");
-        std::string transformName = transform->GetName();
-        // Strip "Transform" from the end of the transform name
-        std::string transformPostfix = "Transform";
-        if (transformName.length() > transformPostfix.length() &&
-          transformName.compare(transformName.length() - transformPostfix.length(),
-          transformPostfix.length(), transformPostfix) == 0)
-          {
-          // ends with "Transform" (SomethingToSomethingElseTransform),
-          // remove it (to have SomethingToSomethingElse)
-          transformName.erase(transformName.length() - transformPostfix.length(), transformPostfix.length());
-          }
-        // Save transform name to Sequences.Source attribute so that modules can
-        // find a transform by matching the original the transform name.
-        transformsSequenceNode->SetAttribute("Sequences.Source", transformName.c_str());
-
-        transformSequenceNodes[transform->GetName()] = transformsSequenceNode;
+        // reuse supplied sequence node
+        newTransformsSequenceNode = createdNodes[numberOfCreatedNodes];
+        newTransformsSequenceNode->RemoveAllDataNodes();
         }
       else
         {
-        transformsSequenceNode = transformSequenceNodes[transform->GetName()];
+        // Create new sequence node
+        newTransformsSequenceNode = vtkSmartPointer<vtkMRMLSequenceNode>::New();
+        createdNodes.push_back(newTransformsSequenceNode);
+        }
+      numberOfCreatedNodes++;
+      transformsSequenceNode = newTransformsSequenceNode;
+      transformsSequenceNode->SetIndexName("time");
+      transformsSequenceNode->SetIndexUnit("s");
+      std::string transformName = frameTransformName;
+      // Strip "Transform" from the end of the transform name
+      std::string transformPostfix = "Transform";
+      if (transformName.length() > transformPostfix.length() &&
+        transformName.compare(transformName.length() - transformPostfix.length(),
+        transformPostfix.length(), transformPostfix) == 0)
+        {
+        // ends with "Transform" (SomethingToSomethingElseTransform),
+        // remove it (to have SomethingToSomethingElse)
+        transformName.erase(transformName.length() - transformPostfix.length(), transformPostfix.length());
         }
-      transform->SetHideFromEditors(false);
-      // Generating a unique name is important because that will be used to generate the filename by default
-      std::ostringstream nameStr;
-      nameStr << transform->GetName() << "_" << std::setw(4) << std::setfill('0') << currentFrameNumber << std::ends;
-      transform->SetName(nameStr.str().c_str());
-      transformsSequenceNode->SetDataNodeAtValue(transform, paramValueString.c_str());
-      transform->Delete(); // ownership transferred to the sequence node
+      // Save transform name to Sequences.Source attribute so that modules can
+      // find a transform by matching the original the transform name.
+      transformsSequenceNode->SetAttribute("Sequences.Source", transformName.c_str());
+
+      transformSequenceNodes[importedTransform.TransformNameIndex] = transformsSequenceNode;
       }
+
+    // The transform node is added to the sequence directly (without making a copy of it),
+    // so only one node is created for each frame.
+    matrix->DeepCopy(importedTransform.MatrixElements);
+    vtkMRMLLinearTransformNode* transform = vtkMRMLLinearTransformNode::New();
+    transform->SetMatrixTransformToParent(matrix.GetPointer());
+    transform->SetHideFromEditors(false);
+    // Generating a unique name is important because that will be used to generate the filename by default
+    snprintf(frameNumberSuffix, sizeof(frameNumberSuffix), "_%04d", currentFrameNumber);
+    transform->SetName((frameTransformName + frameNumberSuffix).c_str());
+    transformsSequenceNode->SetDataNodeAtValueWithoutCopy(transform, paramValueString.c_str());
+    transform->Delete(); // ownership transferred to the sequence node
     }
 
   // Add to scene and set name and storage node
@@ -30,11 +30,14 @@ Version:   $Revision: 1.3 $
 #include <vtkEventForwarderCommand.h>
 #include <vtkFloatArray.h>
 #include <vtkGeneralTransform.h>
+#include <vtkHomogeneousTransform.h>
+#include <vtkMath.h>
 #include <vtkMatrix4x4.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPointData.h>
 #include <vtkPolyData.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkTransformFilter.h>
 #include <vtkTrivialProducer.h>
@@ -42,6 +45,7 @@ Version:   $Revision: 1.3 $
 #include <vtkVersion.h>
 
 // STD includes
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 
@@ -202,9 +206,30 @@ void vtkMRMLModelNode::SetAndObservePolyData(vtkPolyData *polyData)
   this->SetAndObserveMesh(polyData);
 }
 
+//---------------------------------------------------------------------------
+bool vtkMRMLModelNode::ReleaseDataInternal()
+{
+  this->SetAndObserveMesh(nullptr);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+unsigned long vtkMRMLModelNode::GetDataMemorySize()
+{
+  if (this->GetDataReadPending() || !this->MeshConnection)
+    {
+    // Do not read the data just to get its size
+    return 0;
+    }
+  vtkAlgorithm* producer = this->MeshConnection->GetProducer();
+  vtkDataObject* mesh = producer ? producer->GetOutputDataObject(this->MeshConnection->GetIndex()) : nullptr;
+  return mesh ? mesh->GetActualMemorySize() : 0;
+}
+
 //---------------------------------------------------------------------------
 vtkPointSet *vtkMRMLModelNode::GetMesh()
 {
+  this->ReadPendingData();
   if (!this->MeshConnection)
     {
     return nullptr;
@@ -329,6 +354,13 @@ void vtkMRMLModelNode
   this->SetMeshConnection(newUnstructuredGridConnection);
 }
 
+//---------------------------------------------------------------------------
+vtkAlgorithmOutput* vtkMRMLModelNode::GetMeshConnection()
+{
+  this->ReadPendingData();
+  return this->MeshConnection;
+}
+
 //---------------------------------------------------------------------------
 vtkAlgorithmOutput* vtkMRMLModelNode::GetPolyDataConnection()
 {
@@ -690,6 +722,95 @@ bool vtkMRMLModelNode::CanApplyNonLinearTransforms()const
   return true;
 }
 
+//---------------------------------------------------------------------------
+namespace
+{
+/// Transform the points, point normals, and point vectors of the mesh in place
+/// by a non-linear transform, processing the points in parallel.
+/// Returns false if the mesh contains data that needs vtkTransformFilter (cell normals or vectors).
+bool TransformMeshInParallel(vtkPointSet* mesh, vtkAbstractTransform* transform)
+{
+  vtkPoints* inputPoints = mesh->GetPoints();
+  if (!inputPoints || mesh->GetCellData()->GetNormals() || mesh->GetCellData()->GetVectors())
+    {
+    return false;
+    }
+  vtkIdType numberOfPoints = inputPoints->GetNumberOfPoints();
+  vtkNew<vtkPoints> outputPoints;
+  outputPoints->SetDataType(inputPoints->GetDataType());
+  outputPoints->SetNumberOfPoints(numberOfPoints);
+
+  vtkPointData* pointData = mesh->GetPointData();
+  vtkDataArray* inputNormals = pointData->GetNormals();
+  vtkDataArray* inputVectors = pointData->GetVectors();
+  vtkSmartPointer<vtkDataArray> outputNormals;
+  if (inputNormals)
+    {
+    outputNormals = vtkSmartPointer<vtkDataArray>::Take(inputNormals->NewInstance());
+    outputNormals->SetNumberOfComponents(3);
+    outputNormals->SetNumberOfTuples(numberOfPoints);
+    outputNormals->SetName(inputNormals->GetName());
+    }
+  vtkSmartPointer<vtkDataArray> outputVectors;
+  if (inputVectors)
+    {
+    outputVectors = vtkSmartPointer<vtkDataArray>::Take(inputVectors->NewInstance());
+    outputVectors->SetNumberOfComponents(3);
+    outputVectors->SetNumberOfTuples(numberOfPoints);
+    outputVectors->SetName(inputVectors->GetName());
+    }
+
+  // the transform must be up to date before it is used from multiple threads
+  transform->Update();
+  vtkSMPTools::For(0, numberOfPoints, [&](vtkIdType pointBegin, vtkIdType pointEnd)
+    {
+    double point[3] = { 0.0, 0.0, 0.0 };
+    double transformedPoint[3] = { 0.0, 0.0, 0.0 };
+    double derivative[3][3];
+    double vector[3] = { 0.0, 0.0, 0.0 };
+    for (vtkIdType pointId = pointBegin; pointId < pointEnd; ++pointId)
+      {
+      inputPoints->GetPoint(pointId, point);
+      if (!outputNormals && !outputVectors)
+        {
+        transform->InternalTransformPoint(point, transformedPoint);
+        outputPoints->SetPoint(pointId, transformedPoint);
+        continue;
+        }
+      transform->InternalTransformDerivative(point, transformedPoint, derivative);
+      outputPoints->SetPoint(pointId, transformedPoint);
+      if (outputVectors)
+        {
+        inputVectors->GetTuple(pointId, vector);
+        vtkMath::Multiply3x3(derivative, vector, vector);
+        outputVectors->SetTuple(pointId, vector);
+        }
+      if (outputNormals)
+        {
+        // same as vtkAbstractTransform::TransformNormalAtPoint
+        inputNormals->GetTuple(pointId, vector);
+        vtkMath::Invert3x3(derivative, derivative);
+        vtkMath::Transpose3x3(derivative, derivative);
+        vtkMath::Multiply3x3(derivative, vector, vector);
+        vtkMath::Normalize(vector);
+        outputNormals->SetTuple(pointId, vector);
+        }
+      }
+    });
+
+  mesh->SetPoints(outputPoints.GetPointer());
+  if (outputNormals)
+    {
+    pointData->SetNormals(outputNormals);
+    }
+  if (outputVectors)
+    {
+    pointData->SetVectors(outputVectors);
+    }
+  return true;
+}
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLModelNode::ApplyTransform(vtkAbstractTransform* transform)
 {
@@ -698,13 +819,21 @@ void vtkMRMLModelNode::ApplyTransform(vtkAbstractTransform* transform)
     return;
     }
 
+  bool isInPipeline = !vtkTrivialProducer::SafeDownCast(
+     this->MeshConnection ? this->MeshConnection->GetProducer() : nullptr);
+
+  // Non-linear transforms are applied to the points of the data object
+  // in parallel, linear transforms are fast enough in vtkTransformFilter
+  if (!isInPipeline && !vtkHomogeneousTransform::SafeDownCast(transform)
+    && TransformMeshInParallel(this->GetMesh(), transform))
+    {
+    return;
+    }
+
   vtkTransformFilter* transformFilter = vtkTransformFilter::New();
   transformFilter->SetInputConnection(this->MeshConnection);
   transformFilter->SetTransform(transform);
 
-  bool isInPipeline = !vtkTrivialProducer::SafeDownCast(
-     this->MeshConnection ? this->MeshConnection->GetProducer() : nullptr);
-
   // If mesh was set through pipeline (SetMeshConnection), append
   // transform filter to that pipeline
   if (isInPipeline)
@@ -989,6 +1118,21 @@ void vtkMRMLModelNode
 //---------------------------------------------------------------------------
 bool vtkMRMLModelNode::GetModifiedSinceRead()
 {
+  if (this->DataReadPending)
+    {
+    return false;
+    }
   return this->Superclass::GetModifiedSinceRead() ||
     (this->GetMesh() && this->GetMesh()->GetMTime() > this->GetStoredTime());
 }
+
+//---------------------------------------------------------------------------
+vtkMTimeType vtkMRMLModelNode::GetContentMTime()
+{
+  vtkMTimeType contentMTime = this->Superclass::GetContentMTime();
+  if (this->GetMesh())
+    {
+    contentMTime = std::max(contentMTime, this->GetMesh()->GetMTime());
+    }
+  return contentMTime;
+}
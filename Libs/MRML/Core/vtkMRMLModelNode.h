@@ -99,8 +99,9 @@ public:
   virtual void SetUnstructuredGridConnection(vtkAlgorithmOutput *inputPort);
 
   /// Return the input mesh pipeline.
+  /// If reading of the mesh was deferred then the data is read from file first.
   /// \sa GetPolyDataConnection(), GetUnstructuredGridConnection()
-  vtkGetObjectMacro(MeshConnection,vtkAlgorithmOutput)
+  virtual vtkAlgorithmOutput* GetMeshConnection();
 
   /// Return the input mesh pipeline if the mesh
   /// is a polydata.
@@ -252,6 +253,16 @@ public:
   /// \sa vtkMRMLStorableNode::GetModifiedSinceRead()
   bool GetModifiedSinceRead() override;
 
+  /// Reimplemented to take into account the modified time of the mesh.
+  vtkMTimeType GetContentMTime() override;
+
+  /// Content modification time includes the mesh modification time,
+  /// therefore undo state can be shared between undo levels.
+  bool CanShareUndoState() override { return true; }
+
+  /// Memory size of the mesh.
+  unsigned long GetDataMemorySize() override;
+
   /// Determine if the mesh stores scalar data data that the user may want to see and if
   /// such data is found then display it.
   /// Currently, it displays single-component scalar array (with a colormap),
@@ -272,6 +283,9 @@ protected:
   /// to the new display node.
   virtual void UpdateDisplayNodeMesh(vtkMRMLDisplayNode *dnode);
 
+  /// Remove the mesh from memory, called by ReleaseData().
+  bool ReleaseDataInternal() override;
+
   ///
   /// Called when a node reference ID is added (list size increased).
   void OnNodeReferenceAdded(vtkMRMLNodeReference *reference) override;
@@ -99,6 +99,12 @@ vtkMRMLModelStorageNode::vtkMRMLModelStorageNode()
 {
   this->DefaultWriteFileExtension = "vtk";
   this->CoordinateSystem = vtkMRMLStorageNode::CoordinateSystemLPS;
+
+  this->CompressionPresets.emplace_back(this->GetCompressionParameterFastest(), "Fastest");
+  this->CompressionPresets.emplace_back(this->GetCompressionParameterNormal(), "Normal");
+  this->CompressionPresets.emplace_back(this->GetCompressionParameterMinimumSize(), "Minimum size");
+
+  this->CompressionParameter = this->GetCompressionParameterNormal();
 }
 
 //----------------------------------------------------------------------------
@@ -435,25 +441,39 @@ int vtkMRMLModelStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
     vtkMRMLModelStorageNode::ConvertBetweenRASAndLPS(meshFromFile, meshToSetInNode);
     }
   modelNode->SetAndObserveMesh(meshToSetInNode);
+  this->UpdateDisplayNodesScalarRange(modelNode);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLModelStorageNode::UpdateFromReadDataCopy(vtkMRMLStorageNode* storageNodeCopy, vtkMRMLNode* refNode)
+{
+  this->Superclass::UpdateFromReadDataCopy(storageNodeCopy, refNode);
+  // The node that the copy read into had no display nodes
+  this->UpdateDisplayNodesScalarRange(vtkMRMLModelNode::SafeDownCast(refNode));
+}
 
-  if (modelNode->GetMesh() != nullptr)
+//----------------------------------------------------------------------------
+void vtkMRMLModelStorageNode::UpdateDisplayNodesScalarRange(vtkMRMLModelNode* modelNode)
+{
+  if (!modelNode || modelNode->GetMesh() == nullptr)
     {
-    for (int i=0; i<modelNode->GetNumberOfDisplayNodes(); ++i)
+    return;
+    }
+  for (int i=0; i<modelNode->GetNumberOfDisplayNodes(); ++i)
+    {
+    vtkMRMLDisplayNode* displayNode = modelNode->GetNthDisplayNode(i);
+    // is there an active scalar array?
+    if (displayNode && displayNode->GetScalarRangeFlag() == vtkMRMLDisplayNode::UseDataScalarRange)
       {
-      vtkMRMLDisplayNode* displayNode = modelNode->GetNthDisplayNode(i);
-      // is there an active scalar array?
-      if (displayNode && displayNode->GetScalarRangeFlag() == vtkMRMLDisplayNode::UseDataScalarRange)
+      double *scalarRange = modelNode->GetMesh()->GetScalarRange();
+      if (scalarRange)
         {
-        double *scalarRange = modelNode->GetMesh()->GetScalarRange();
-        if (scalarRange)
-          {
-          vtkDebugMacro("ReadDataInternal (" << (this->ID ? this->ID : "(unknown)") << "): setting scalar range " << scalarRange[0] << ", " << scalarRange[1]);
-          displayNode->SetScalarRange(scalarRange);
-          }
+        vtkDebugMacro("ReadDataInternal (" << (this->ID ? this->ID : "(unknown)") << "): setting scalar range " << scalarRange[0] << ", " << scalarRange[1]);
+        displayNode->SetScalarRange(scalarRange);
         }
-      } // For all display nodes
-    }
-  return 1;
+      }
+    } // For all display nodes
 }
 
 //----------------------------------------------------------------------------
@@ -564,10 +584,31 @@ int vtkMRMLModelStorageNode::WriteDataInternal(vtkMRMLNode *refNode)
     this->GetUserMessages()->SetObservedObject(writer);
     writer->SetInputData(inputData);
     writer->SetFileName(fullName.c_str());
-    writer->SetCompressorType(
-      this->GetUseCompression() ? vtkXMLWriter::ZLIB : vtkXMLWriter::NONE);
-    writer->SetDataMode(
-      this->GetUseCompression() ? vtkXMLWriter::Appended : vtkXMLWriter::Ascii);
+    if (this->GetUseCompression())
+      {
+      int compressionLevel = 5;
+      if (this->CompressionParameter == this->GetCompressionParameterFastest())
+        {
+        writer->SetCompressorTypeToLZ4();
+        compressionLevel = 1;
+        }
+      else if (this->CompressionParameter == this->GetCompressionParameterMinimumSize())
+        {
+        writer->SetCompressorTypeToLZMA();
+        compressionLevel = 9;
+        }
+      else
+        {
+        writer->SetCompressorTypeToZLib();
+        }
+      writer->SetCompressionLevel(this->CompressionLevel >= 0 ? this->CompressionLevel : compressionLevel);
+      writer->SetDataModeToAppended();
+      }
+    else
+      {
+      writer->SetCompressorTypeToNone();
+      writer->SetDataModeToAscii();
+      }
 
     // Write coordinate system space (RAS) to field data
     // In the future (when Slicer switches to VTK8) array metadata may be used instead of separate field data.
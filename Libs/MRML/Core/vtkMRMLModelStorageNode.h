@@ -45,12 +45,34 @@ public:
   /// Return true if the reference node can be read in
   bool CanReadInReferenceNode(vtkMRMLNode *refNode) override;
 
+  /// Meshes are read by VTK readers into a separate mesh, without accessing the scene.
+  bool CanReadInBackgroundThread() override { return true; }
+
+  /// Meshes are written by VTK writers, without accessing the scene.
+  bool CanWriteInBackgroundThread() override { return true; }
+
+  /// Update scalar range of display nodes after data was read by a copy of this node.
+  void UpdateFromReadDataCopy(vtkMRMLStorageNode* storageNodeCopy, vtkMRMLNode* refNode) override;
+
   /// Get/Set flag that controls if points are to be written in various coordinate systems
   vtkSetClampMacro(CoordinateSystem, int, 0, vtkMRMLStorageNode::CoordinateSystemType_Last-1);
   vtkGetMacro(CoordinateSystem, int);
   static const char* GetCoordinateSystemAsString(int id);
   static int GetCoordinateSystemFromString(const char* name);
 
+  /// \brief Compression parameters for writing VTK XML (.vtp, .vtu) files.
+  ///
+  /// Only used if UseCompression is enabled. Data arrays are written in binary appended mode,
+  /// compressed with the selected method:
+  /// - fastest: LZ4, fast writing and reading, larger file size
+  /// - normal (default): zlib, same as files written by earlier Slicer versions
+  /// - minimum size: LZMA, slow writing, smallest file size
+  /// CompressionLevel overrides the level implied by the compression parameter.
+  /// Other file formats ignore the compression parameter.
+  std::string GetCompressionParameterFastest() { return "vtkxml_lz4"; };
+  std::string GetCompressionParameterNormal() { return "vtkxml_zlib"; };
+  std::string GetCompressionParameterMinimumSize() { return "vtkxml_lzma"; };
+
   /// Helper function that can convert a mesh (polydata, unstructured grid, or even just a point cloud)
   /// between RAS and LPS coordinate system.
   static void ConvertBetweenRASAndLPS(vtkPointSet* inputMesh, vtkPointSet* outputMesh);
@@ -73,6 +95,9 @@ protected:
   /// Read data and set it in the referenced node
   int ReadDataInternal(vtkMRMLNode *refNode) override;
 
+  /// Set scalar range of display nodes that use the data scalar range
+  void UpdateDisplayNodesScalarRange(vtkMRMLModelNode* modelNode);
+
   /// Write data from a  referenced node
   int WriteDataInternal(vtkMRMLNode *refNode) override;
 
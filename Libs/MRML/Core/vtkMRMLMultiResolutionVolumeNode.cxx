@@ -0,0 +1,692 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRML includes
+#include "vtkEventBroker.h"
+#include "vtkMRMLMultiResolutionVolumeNode.h"
+#include "vtkMRMLOMEZarrStorageNode.h"
+#include "vtkMRMLScene.h"
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkSmartPointer.h>
+#include <vtkWeakPointer.h>
+
+// STD includes
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------
+namespace
+{
+
+struct LevelInfo
+{
+  int Dimensions[3];
+  int TileDimensions[3];
+  double Spacing[3];
+  double Origin[3];
+};
+
+struct TileKey
+{
+  int Level;
+  int Index[3];
+
+  bool operator<(const TileKey& other) const
+    {
+    if (this->Level != other.Level)
+      {
+      return this->Level < other.Level;
+      }
+    return std::lexicographical_compare(this->Index, this->Index + 3, other.Index, other.Index + 3);
+    }
+};
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 GetTileSizeInBytes(vtkImageData* tile)
+{
+  return static_cast<vtkTypeInt64>(tile->GetNumberOfPoints())
+    * tile->GetNumberOfScalarComponents() * tile->GetScalarSize();
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+class vtkMRMLMultiResolutionVolumeNode::vtkInternal
+{
+public:
+  struct CacheEntry
+  {
+    vtkSmartPointer<vtkImageData> Tile;
+    std::list<TileKey>::iterator LRUPosition;
+  };
+
+  struct TileRequest
+  {
+    TileKey Key;
+    vtkSmartPointer<vtkMRMLOMEZarrStorageNode> StorageNode;
+    int Generation;
+  };
+
+  /// Only accessed from the main thread
+  std::vector<LevelInfo> Levels;
+  vtkWeakPointer<vtkMRMLOMEZarrStorageNode> TileStorageNode;
+  vtkNew<vtkObject> TilesLoadedNotifier;
+  vtkNew<vtkCallbackCommand> TilesLoadedCallbackCommand;
+
+  /// Shared with the worker threads, protected by Mutex
+  std::mutex Mutex;
+  std::map<TileKey, CacheEntry> Cache;
+  /// Most recently used tile first
+  std::list<TileKey> LRU;
+  vtkTypeInt64 CacheSizeInBytes{0};
+  vtkTypeInt64 MaximumCacheSizeInBytes{0};
+  std::deque<TileRequest> Queue;
+  std::set<TileKey> PendingTiles;
+  /// Tiles that could not be read, they are not requested again until the cache is cleared
+  std::set<TileKey> FailedTiles;
+  /// Incremented when the cache is cleared to discard the tiles read meanwhile
+  int Generation{0};
+  bool StopThreads{false};
+  std::condition_variable QueueCondition;
+  std::vector<std::thread> Threads;
+
+  std::atomic<vtkTypeInt64> NumberOfLoadedTiles{0};
+  std::atomic<bool> NotificationRequested{false};
+
+  /// Must be called with Mutex locked
+  void InsertTile(const TileKey& key, vtkImageData* tile);
+  void EvictTiles();
+  void ClearCache();
+
+  void StartThreads(int numberOfThreads);
+  void StopAndJoinThreads();
+  void ProcessRequests();
+};
+
+//----------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::vtkInternal::InsertTile(const TileKey& key, vtkImageData* tile)
+{
+  std::map<TileKey, CacheEntry>::iterator it = this->Cache.find(key);
+  if (it != this->Cache.end())
+    {
+    this->CacheSizeInBytes -= GetTileSizeInBytes(it->second.Tile);
+    this->LRU.erase(it->second.LRUPosition);
+    this->Cache.erase(it);
+    }
+  this->LRU.push_front(key);
+  CacheEntry& entry = this->Cache[key];
+  entry.Tile = tile;
+  entry.LRUPosition = this->LRU.begin();
+  this->CacheSizeInBytes += GetTileSizeInBytes(tile);
+  ++this->NumberOfLoadedTiles;
+  this->EvictTiles();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::vtkInternal::EvictTiles()
+{
+  // keep at least the most recently used tile, even if it is larger than the cache
+  while (this->CacheSizeInBytes > this->MaximumCacheSizeInBytes && this->LRU.size() > 1)
+    {
+    std::map<TileKey, CacheEntry>::iterator it = this->Cache.find(this->LRU.back());
+    this->CacheSizeInBytes -= GetTileSizeInBytes(it->second.Tile);
+    this->Cache.erase(it);
+    this->LRU.pop_back();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::vtkInternal::ClearCache()
+{
+  this->Cache.clear();
+  this->LRU.clear();
+  this->CacheSizeInBytes = 0;
+  this->Queue.clear();
+  this->PendingTiles.clear();
+  this->FailedTiles.clear();
+  ++this->Generation;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::vtkInternal::StartThreads(int numberOfThreads)
+{
+  for (int i = 0; i < numberOfThreads; ++i)
+    {
+    this->Threads.emplace_back(&vtkInternal::ProcessRequests, this);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::vtkInternal::StopAndJoinThreads()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->StopThreads = true;
+    this->Queue.clear();
+  }
+  this->QueueCondition.notify_all();
+  for (std::thread& thread : this->Threads)
+    {
+    thread.join();
+    }
+  this->Threads.clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::vtkInternal::ProcessRequests()
+{
+  while (true)
+    {
+    TileRequest request;
+    {
+      std::unique_lock<std::mutex> lock(this->Mutex);
+      this->QueueCondition.wait(lock, [this] { return this->StopThreads || !this->Queue.empty(); });
+      if (this->StopThreads)
+        {
+        return;
+        }
+      request = this->Queue.front();
+      this->Queue.pop_front();
+    }
+
+    vtkNew<vtkImageData> tile;
+    bool success = request.StorageNode->ReadTile(request.Key.Level, request.Key.Index, tile);
+    request.StorageNode = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      if (request.Generation != this->Generation)
+        {
+        // the cache was cleared meanwhile
+        continue;
+        }
+      this->PendingTiles.erase(request.Key);
+      if (success)
+        {
+        this->InsertTile(request.Key, tile);
+        }
+      else
+        {
+        this->FailedTiles.insert(request.Key);
+        }
+    }
+
+    // Notify the main thread once for all the tiles loaded until it processes the notification
+    if (success && !this->NotificationRequested.exchange(true))
+      {
+      if (!vtkEventBroker::GetInstance()->RequestModified(this->TilesLoadedNotifier))
+        {
+        this->NotificationRequested = false;
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkMRMLNodeNewMacro(vtkMRMLMultiResolutionVolumeNode);
+
+//----------------------------------------------------------------------------
+vtkMRMLMultiResolutionVolumeNode::vtkMRMLMultiResolutionVolumeNode()
+{
+  this->Internal = new vtkInternal;
+  this->Internal->MaximumCacheSizeInBytes = static_cast<vtkTypeInt64>(this->TileCacheSize) * 1024 * 1024;
+  this->Internal->TilesLoadedCallbackCommand->SetClientData(this);
+  this->Internal->TilesLoadedCallbackCommand->SetCallback(vtkMRMLMultiResolutionVolumeNode::TilesLoadedCallback);
+  this->Internal->TilesLoadedNotifier->AddObserver(vtkCommand::ModifiedEvent,
+    this->Internal->TilesLoadedCallbackCommand);
+}
+
+//----------------------------------------------------------------------------
+vtkMRMLMultiResolutionVolumeNode::~vtkMRMLMultiResolutionVolumeNode()
+{
+  this->Internal->StopAndJoinThreads();
+  // The notifier may still be in the modified queue of the application
+  this->Internal->TilesLoadedNotifier->RemoveObserver(this->Internal->TilesLoadedCallbackCommand);
+  this->Internal->TilesLoadedCallbackCommand->SetClientData(nullptr);
+  delete this->Internal;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::WriteXML(ostream& of, int nIndent)
+{
+  Superclass::WriteXML(of, nIndent);
+  vtkMRMLWriteXMLBeginMacro(of);
+  vtkMRMLWriteXMLIntMacro(tileCacheSize, TileCacheSize);
+  vtkMRMLWriteXMLBooleanMacro(asynchronousTileLoading, AsynchronousTileLoading);
+  vtkMRMLWriteXMLIntMacro(numberOfTileLoadingThreads, NumberOfTileLoadingThreads);
+  vtkMRMLWriteXMLEndMacro();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::ReadXMLAttributes(const char** atts)
+{
+  int disabledModify = this->StartModify();
+  Superclass::ReadXMLAttributes(atts);
+  vtkMRMLReadXMLBeginMacro(atts);
+  vtkMRMLReadXMLIntMacro(tileCacheSize, TileCacheSize);
+  vtkMRMLReadXMLBooleanMacro(asynchronousTileLoading, AsynchronousTileLoading);
+  vtkMRMLReadXMLIntMacro(numberOfTileLoadingThreads, NumberOfTileLoadingThreads);
+  vtkMRMLReadXMLEndMacro();
+  this->EndModify(disabledModify);
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::CopyContent(vtkMRMLNode* anode, bool deepCopy/*=true*/)
+{
+  MRMLNodeModifyBlocker blocker(this);
+  Superclass::CopyContent(anode, deepCopy);
+
+  vtkMRMLCopyBeginMacro(anode);
+  vtkMRMLCopyIntMacro(TileCacheSize);
+  vtkMRMLCopyBooleanMacro(AsynchronousTileLoading);
+  vtkMRMLCopyIntMacro(NumberOfTileLoadingThreads);
+  vtkMRMLCopyEndMacro();
+
+  vtkMRMLMultiResolutionVolumeNode* node = vtkMRMLMultiResolutionVolumeNode::SafeDownCast(anode);
+  if (node)
+    {
+    this->ClearTileCache();
+    this->Internal->Levels = node->Internal->Levels;
+    this->Internal->TileStorageNode = node->Internal->TileStorageNode;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::PrintSelf(ostream& os, vtkIndent indent)
+{
+  Superclass::PrintSelf(os,indent);
+  vtkMRMLPrintBeginMacro(os, indent);
+  vtkMRMLPrintIntMacro(TileCacheSize);
+  vtkMRMLPrintBooleanMacro(AsynchronousTileLoading);
+  vtkMRMLPrintIntMacro(NumberOfTileLoadingThreads);
+  vtkMRMLPrintIntMacro(TileCacheHitCount);
+  vtkMRMLPrintIntMacro(TileCacheMissCount);
+  vtkMRMLPrintEndMacro();
+  os << indent << "NumberOfCachedTiles: " << this->GetNumberOfCachedTiles() << "\n";
+  os << indent << "TileCacheSizeInBytes: " << this->GetTileCacheSizeInBytes() << "\n";
+  for (size_t level = 0; level < this->Internal->Levels.size(); ++level)
+    {
+    const LevelInfo& info = this->Internal->Levels[level];
+    os << indent << "Level " << level << ":"
+       << " dimensions " << info.Dimensions[0] << "x" << info.Dimensions[1] << "x" << info.Dimensions[2]
+       << ", tiles " << info.TileDimensions[0] << "x" << info.TileDimensions[1] << "x" << info.TileDimensions[2]
+       << ", spacing " << info.Spacing[0] << " " << info.Spacing[1] << " " << info.Spacing[2] << "\n";
+    }
+}
+
+//---------------------------------------------------------------------------
+vtkMRMLStorageNode* vtkMRMLMultiResolutionVolumeNode::CreateDefaultStorageNode()
+{
+  vtkMRMLScene* scene = this->GetScene();
+  if (scene == nullptr)
+    {
+    vtkErrorMacro("CreateDefaultStorageNode failed: scene is invalid");
+    return nullptr;
+    }
+  return vtkMRMLStorageNode::SafeDownCast(
+    scene->CreateNodeByClass("vtkMRMLOMEZarrStorageNode"));
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::RemoveAllLevels()
+{
+  this->ClearTileCache();
+  this->Internal->Levels.clear();
+  this->Modified();
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLMultiResolutionVolumeNode::AddLevel(const int dimensions[3], const int tileDimensions[3],
+  const double spacing[3], const double origin[3])
+{
+  LevelInfo info;
+  for (int i = 0; i < 3; ++i)
+    {
+    if (dimensions[i] < 1 || tileDimensions[i] < 1)
+      {
+      vtkErrorMacro("AddLevel failed: invalid dimensions");
+      return -1;
+      }
+    info.Dimensions[i] = dimensions[i];
+    info.TileDimensions[i] = tileDimensions[i];
+    info.Spacing[i] = spacing[i];
+    info.Origin[i] = origin[i];
+    }
+  this->Internal->Levels.push_back(info);
+  this->Modified();
+  return static_cast<int>(this->Internal->Levels.size()) - 1;
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLMultiResolutionVolumeNode::GetNumberOfLevels()
+{
+  return static_cast<int>(this->Internal->Levels.size());
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLMultiResolutionVolumeNode::GetLevelDimensions(int level, int dimensions[3])
+{
+  if (level < 0 || level >= this->GetNumberOfLevels())
+    {
+    return false;
+    }
+  std::copy(this->Internal->Levels[level].Dimensions, this->Internal->Levels[level].Dimensions + 3, dimensions);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLMultiResolutionVolumeNode::GetLevelTileDimensions(int level, int tileDimensions[3])
+{
+  if (level < 0 || level >= this->GetNumberOfLevels())
+    {
+    return false;
+    }
+  std::copy(this->Internal->Levels[level].TileDimensions, this->Internal->Levels[level].TileDimensions + 3, tileDimensions);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLMultiResolutionVolumeNode::GetLevelSpacing(int level, double spacing[3])
+{
+  if (level < 0 || level >= this->GetNumberOfLevels())
+    {
+    return false;
+    }
+  std::copy(this->Internal->Levels[level].Spacing, this->Internal->Levels[level].Spacing + 3, spacing);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLMultiResolutionVolumeNode::GetLevelIJKToRASMatrix(int level, vtkMatrix4x4* ijkToRAS)
+{
+  if (level < 0 || level >= this->GetNumberOfLevels() || !ijkToRAS)
+    {
+    return false;
+    }
+  const LevelInfo& info = this->Internal->Levels[level];
+  this->GetIJKToRASDirectionMatrix(ijkToRAS);
+  for (int row = 0; row < 3; ++row)
+    {
+    for (int column = 0; column < 3; ++column)
+      {
+      ijkToRAS->SetElement(row, column, ijkToRAS->GetElement(row, column) * info.Spacing[column]);
+      }
+    ijkToRAS->SetElement(row, 3, info.Origin[row]);
+    }
+  return true;
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLMultiResolutionVolumeNode::GetLevelForSpacing(double spacing)
+{
+  for (int level = this->GetNumberOfLevels() - 1; level > 0; --level)
+    {
+    const double* levelSpacing = this->Internal->Levels[level].Spacing;
+    double minimumSpacing = std::min(levelSpacing[0], std::min(levelSpacing[1], levelSpacing[2]));
+    // small tolerance so that a view showing exactly a level uses that level
+    if (minimumSpacing <= spacing * (1.0 + 1e-6))
+      {
+      return level;
+      }
+    }
+  return this->GetNumberOfLevels() > 0 ? 0 : -1;
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLMultiResolutionVolumeNode::GetRegion(int level, const int extent[6], vtkImageData* region, bool waitForTiles/*=false*/)
+{
+  if (level < 0 || level >= this->GetNumberOfLevels() || !region)
+    {
+    vtkErrorMacro("GetRegion failed: invalid level " << level);
+    return -1;
+    }
+  vtkSmartPointer<vtkMRMLOMEZarrStorageNode> storageNode = this->Internal->TileStorageNode.GetPointer();
+  if (!storageNode)
+    {
+    vtkErrorMacro("GetRegion failed: no storage node to read the tiles from");
+    return -1;
+    }
+  const LevelInfo info = this->Internal->Levels[level];
+
+  int regionExtent[6];
+  int firstTile[3];
+  int lastTile[3];
+  for (int i = 0; i < 3; ++i)
+    {
+    regionExtent[2 * i] = std::max(extent[2 * i], 0);
+    regionExtent[2 * i + 1] = std::min(extent[2 * i + 1], info.Dimensions[i] - 1);
+    if (regionExtent[2 * i] > regionExtent[2 * i + 1])
+      {
+      region->Initialize();
+      return 0;
+      }
+    firstTile[i] = regionExtent[2 * i] / info.TileDimensions[i];
+    lastTile[i] = regionExtent[2 * i + 1] / info.TileDimensions[i];
+    }
+
+  bool asynchronous = !waitForTiles && this->AsynchronousTileLoading
+    && vtkEventBroker::GetInstance()->GetRequestModifiedCallback() != nullptr;
+
+  // Collect the tiles, read or request the missing ones
+  std::vector<vtkSmartPointer<vtkImageData> > tiles;
+  int numberOfMissingTiles = 0;
+  TileKey key;
+  key.Level = level;
+  for (key.Index[2] = firstTile[2]; key.Index[2] <= lastTile[2]; ++key.Index[2])
+    {
+    for (key.Index[1] = firstTile[1]; key.Index[1] <= lastTile[1]; ++key.Index[1])
+      {
+      for (key.Index[0] = firstTile[0]; key.Index[0] <= lastTile[0]; ++key.Index[0])
+        {
+        {
+          std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+          std::map<TileKey, vtkInternal::CacheEntry>::iterator it = this->Internal->Cache.find(key);
+          if (it != this->Internal->Cache.end())
+            {
+            ++this->TileCacheHitCount;
+            this->Internal->LRU.splice(this->Internal->LRU.begin(), this->Internal->LRU, it->second.LRUPosition);
+            tiles.push_back(it->second.Tile);
+            continue;
+            }
+          ++this->TileCacheMissCount;
+          if (this->Internal->FailedTiles.count(key))
+            {
+            ++numberOfMissingTiles;
+            continue;
+            }
+          if (asynchronous)
+            {
+            ++numberOfMissingTiles;
+            if (this->Internal->PendingTiles.insert(key).second)
+              {
+              if (this->Internal->Threads.empty())
+                {
+                this->Internal->StartThreads(this->NumberOfTileLoadingThreads);
+                }
+              vtkInternal::TileRequest request;
+              request.Key = key;
+              request.StorageNode = storageNode;
+              request.Generation = this->Internal->Generation;
+              this->Internal->Queue.push_back(request);
+              this->Internal->QueueCondition.notify_one();
+              }
+            continue;
+            }
+        }
+        vtkSmartPointer<vtkImageData> tile = vtkSmartPointer<vtkImageData>::New();
+        if (!storageNode->ReadTile(level, key.Index, tile))
+          {
+          ++numberOfMissingTiles;
+          std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+          this->Internal->FailedTiles.insert(key);
+          continue;
+          }
+        {
+          std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+          this->Internal->InsertTile(key, tile);
+        }
+        tiles.push_back(tile);
+        }
+      }
+    }
+
+  // Allocate the region with the scalar type of the tiles
+  int scalarType = VTK_UNSIGNED_CHAR;
+  int numberOfComponents = 1;
+  if (!tiles.empty())
+    {
+    scalarType = tiles[0]->GetScalarType();
+    numberOfComponents = tiles[0]->GetNumberOfScalarComponents();
+    }
+  else if (this->GetImageData())
+    {
+    scalarType = this->GetImageData()->GetScalarType();
+    numberOfComponents = this->GetImageData()->GetNumberOfScalarComponents();
+    }
+  region->Initialize();
+  region->SetExtent(regionExtent);
+  region->AllocateScalars(scalarType, numberOfComponents);
+  if (numberOfMissingTiles > 0)
+    {
+    memset(region->GetScalarPointer(), 0, GetTileSizeInBytes(region));
+    }
+
+  // Copy the voxels of the tiles, row by row
+  for (vtkImageData* tile : tiles)
+    {
+    if (tile->GetScalarType() != scalarType || tile->GetNumberOfScalarComponents() != numberOfComponents)
+      {
+      vtkWarningMacro("GetRegion: skip tile with a different scalar type");
+      continue;
+      }
+    int* tileExtent = tile->GetExtent();
+    int copyExtent[6];
+    for (int i = 0; i < 3; ++i)
+      {
+      copyExtent[2 * i] = std::max(tileExtent[2 * i], regionExtent[2 * i]);
+      copyExtent[2 * i + 1] = std::min(tileExtent[2 * i + 1], regionExtent[2 * i + 1]);
+      }
+    if (copyExtent[0] > copyExtent[1] || copyExtent[2] > copyExtent[3] || copyExtent[4] > copyExtent[5])
+      {
+      continue;
+      }
+    size_t rowSize = static_cast<size_t>(copyExtent[1] - copyExtent[0] + 1) * numberOfComponents * region->GetScalarSize();
+    for (int k = copyExtent[4]; k <= copyExtent[5]; ++k)
+      {
+      for (int j = copyExtent[2]; j <= copyExtent[3]; ++j)
+        {
+        memcpy(region->GetScalarPointer(copyExtent[0], j, k), tile->GetScalarPointer(copyExtent[0], j, k), rowSize);
+        }
+      }
+    }
+  return numberOfMissingTiles;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::SetTileStorageNode(vtkMRMLOMEZarrStorageNode* storageNode)
+{
+  if (this->Internal->TileStorageNode == storageNode)
+    {
+    return;
+    }
+  this->ClearTileCache();
+  this->Internal->TileStorageNode = storageNode;
+  this->Modified();
+}
+
+//---------------------------------------------------------------------------
+vtkMRMLOMEZarrStorageNode* vtkMRMLMultiResolutionVolumeNode::GetTileStorageNode()
+{
+  return this->Internal->TileStorageNode;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::SetTileCacheSize(int sizeInMB)
+{
+  sizeInMB = std::max(sizeInMB, 1);
+  if (this->TileCacheSize == sizeInMB)
+    {
+    return;
+    }
+  this->TileCacheSize = sizeInMB;
+  {
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    this->Internal->MaximumCacheSizeInBytes = static_cast<vtkTypeInt64>(sizeInMB) * 1024 * 1024;
+    this->Internal->EvictTiles();
+  }
+  this->Modified();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::ClearTileCache()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  this->Internal->ClearCache();
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLMultiResolutionVolumeNode::GetNumberOfCachedTiles()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return static_cast<int>(this->Internal->Cache.size());
+}
+
+//---------------------------------------------------------------------------
+vtkTypeInt64 vtkMRMLMultiResolutionVolumeNode::GetTileCacheSizeInBytes()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  return this->Internal->CacheSizeInBytes;
+}
+
+//---------------------------------------------------------------------------
+vtkTypeInt64 vtkMRMLMultiResolutionVolumeNode::GetNumberOfLoadedTiles()
+{
+  return this->Internal->NumberOfLoadedTiles;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::ResetTileCacheStatistics()
+{
+  this->TileCacheHitCount = 0;
+  this->TileCacheMissCount = 0;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLMultiResolutionVolumeNode::TilesLoadedCallback(vtkObject* vtkNotUsed(caller),
+  unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
+{
+  vtkMRMLMultiResolutionVolumeNode* self = reinterpret_cast<vtkMRMLMultiResolutionVolumeNode*>(clientData);
+  if (!self)
+    {
+    return;
+    }
+  self->Internal->NotificationRequested = false;
+  self->InvokeEvent(vtkMRMLMultiResolutionVolumeNode::TilesLoadedEvent);
+}
@@ -0,0 +1,184 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __vtkMRMLMultiResolutionVolumeNode_h
+#define __vtkMRMLMultiResolutionVolumeNode_h
+
+// MRML includes
+#include "vtkMRMLScalarVolumeNode.h"
+class vtkMRMLOMEZarrStorageNode;
+
+// VTK includes
+class vtkMatrix4x4;
+
+/// \brief MRML node for representing a volume too large to be loaded in memory.
+///
+/// The volume is stored as a pyramid of levels, level 0 being the full
+/// resolution and each following level a downsampled copy of the previous
+/// one. Each level is split in tiles (chunks) that are read on demand by the
+/// storage node (see vtkMRMLOMEZarrStorageNode) and kept in a least recently
+/// used cache of TileCacheSize megabytes.
+///
+/// The image data of the node is an overview of the volume, a coarse level
+/// that fits in memory, so that all the modules working on regular scalar
+/// volumes (display, histogram, 3D rendering...) can still be used. The
+/// geometry of the node (IJKToRAS) is the geometry of the overview.
+/// Slice views use GetRegion() to reslice from the level that matches the
+/// resolution of the view (see vtkMRMLSliceLayerLogic).
+///
+/// If AsynchronousTileLoading is enabled, missing tiles are read by worker
+/// threads and TilesLoadedEvent is invoked on the main thread once they are
+/// in the cache. It requires vtkEventBroker to have a request modified
+/// callback (set by the application logic), tiles are read synchronously
+/// otherwise.
+class VTK_MRML_EXPORT vtkMRMLMultiResolutionVolumeNode : public vtkMRMLScalarVolumeNode
+{
+public:
+  static vtkMRMLMultiResolutionVolumeNode *New();
+  vtkTypeMacro(vtkMRMLMultiResolutionVolumeNode,vtkMRMLScalarVolumeNode);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  vtkMRMLNode* CreateNodeInstance() override;
+
+  /// Set node attributes
+  void ReadXMLAttributes( const char** atts) override;
+
+  /// Write this node's information to a MRML file in XML format.
+  void WriteXML(ostream& of, int indent) override;
+
+  /// Copy node content (excludes basic data, such as name and node references).
+  /// The tile cache is not copied.
+  /// \sa vtkMRMLNode::CopyContent
+  vtkMRMLCopyContentMacro(vtkMRMLMultiResolutionVolumeNode);
+
+  /// Get node XML tag name (like Volume, Model)
+  const char* GetNodeTagName() override {return "MultiResolutionVolume";}
+
+  /// Create default storage node or nullptr if does not have one
+  vtkMRMLStorageNode* CreateDefaultStorageNode() override;
+
+  enum
+    {
+    /// Invoked on the main thread when tiles requested by GetRegion()
+    /// have been loaded in the cache.
+    TilesLoadedEvent = 19500
+    };
+
+  /// Remove all the levels of the pyramid and clear the tile cache.
+  void RemoveAllLevels();
+
+  /// Add a level to the pyramid, levels must be added from the finest
+  /// to the coarsest. \a spacing and \a origin follow the conventions of
+  /// vtkMRMLVolumeNode: the axes are along the IJK to RAS directions of the
+  /// node and \a origin is the RAS position of the first voxel.
+  /// Returns the index of the new level.
+  int AddLevel(const int dimensions[3], const int tileDimensions[3],
+    const double spacing[3], const double origin[3]);
+
+  /// Number of levels of the pyramid.
+  int GetNumberOfLevels();
+
+  /// Get the number of voxels of \a level along each axis.
+  /// Returns false if \a level is invalid.
+  bool GetLevelDimensions(int level, int dimensions[3]);
+
+  /// Get the number of voxels of the tiles of \a level along each axis.
+  /// Returns false if \a level is invalid.
+  bool GetLevelTileDimensions(int level, int tileDimensions[3]);
+
+  /// Get the voxel spacing of \a level.
+  /// Returns false if \a level is invalid.
+  bool GetLevelSpacing(int level, double spacing[3]);
+
+  /// Get the matrix mapping the voxel indices of \a level to RAS.
+  /// Returns false if \a level is invalid.
+  bool GetLevelIJKToRASMatrix(int level, vtkMatrix4x4* ijkToRAS);
+
+  /// Coarsest level whose smallest voxel spacing is below \a spacing,
+  /// that is the level to use to display the volume with \a spacing mm
+  /// per pixel. Returns 0 if no level is fine enough and -1 if there is
+  /// no level.
+  int GetLevelForSpacing(double spacing);
+
+  /// Copy the voxels of \a extent (voxel indices of \a level) into
+  /// \a region, which is allocated with the extent of the intersection
+  /// of \a extent with the level. Voxels of tiles that are not loaded yet
+  /// are set to 0.
+  /// Missing tiles are requested from the storage node, and read in the
+  /// calling thread if \a waitForTiles is true or if asynchronous loading
+  /// is not available.
+  /// Returns the number of tiles that are still missing, or -1 on error.
+  int GetRegion(int level, const int extent[6], vtkImageData* region, bool waitForTiles = false);
+
+  /// Storage node used to read the tiles. Set by the storage node when the
+  /// volume is read.
+  void SetTileStorageNode(vtkMRMLOMEZarrStorageNode* storageNode);
+  vtkMRMLOMEZarrStorageNode* GetTileStorageNode();
+
+  /// Maximum size of the tile cache, in megabytes. Least recently used
+  /// tiles are removed when the cache exceeds this size.
+  /// Default is 1024.
+  void SetTileCacheSize(int sizeInMB);
+  vtkGetMacro(TileCacheSize, int);
+
+  /// Read missing tiles in worker threads.
+  /// Default is true.
+  vtkSetMacro(AsynchronousTileLoading, bool);
+  vtkGetMacro(AsynchronousTileLoading, bool);
+  vtkBooleanMacro(AsynchronousTileLoading, bool);
+
+  /// Number of worker threads reading the tiles.
+  /// Only used when the threads are started, by the first asynchronous request.
+  /// Default is 4.
+  vtkSetClampMacro(NumberOfTileLoadingThreads, int, 1, 64);
+  vtkGetMacro(NumberOfTileLoadingThreads, int);
+
+  /// Remove all the tiles from the cache. Pending requests are discarded.
+  void ClearTileCache();
+
+  /// Number of tiles and size in bytes of the tile cache.
+  int GetNumberOfCachedTiles();
+  vtkTypeInt64 GetTileCacheSizeInBytes();
+
+  /// Number of tiles that have been loaded in the cache since the node was
+  /// created. Can be used to know if GetRegion() needs to be called again.
+  vtkTypeInt64 GetNumberOfLoadedTiles();
+
+  /// Number of tiles found (hits) or not found (misses) in the cache by GetRegion().
+  vtkGetMacro(TileCacheHitCount, int);
+  vtkGetMacro(TileCacheMissCount, int);
+  void ResetTileCacheStatistics();
+
+protected:
+  vtkMRMLMultiResolutionVolumeNode();
+  ~vtkMRMLMultiResolutionVolumeNode() override;
+  vtkMRMLMultiResolutionVolumeNode(const vtkMRMLMultiResolutionVolumeNode&);
+  void operator=(const vtkMRMLMultiResolutionVolumeNode&);
+
+  /// Called on the main thread when worker threads have loaded tiles.
+  static void TilesLoadedCallback(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
+
+  int TileCacheSize{1024};
+  bool AsynchronousTileLoading{true};
+  int NumberOfTileLoadingThreads{4};
+  int TileCacheHitCount{0};
+  int TileCacheMissCount{0};
+
+private:
+  class vtkInternal;
+  vtkInternal* Internal;
+};
+
+#endif
@@ -180,6 +180,7 @@ int vtkMRMLNRRDStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
     }
 
   reader->SetFileName(fullName.c_str());
+  reader->SetNumberOfThreads(this->NumberOfCompressionThreads);
 
   // Check if this is a NRRD file that we can read
   if (!reader->CanReadFile(fullName.c_str()))
@@ -373,7 +374,9 @@ int vtkMRMLNRRDStorageNode::WriteDataInternal(vtkMRMLNode *refNode)
   writer->SetFileName(fullName.c_str());
   writer->SetInputConnection(volNode->GetImageDataConnection());
   writer->SetUseCompression(this->GetUseCompression());
-  writer->SetCompressionLevel(this->GetGzipCompressionLevelFromCompressionParameter(this->CompressionParameter));
+  writer->SetCompressionLevel(this->CompressionLevel >= 0 ? this->CompressionLevel
+    : this->GetGzipCompressionLevelFromCompressionParameter(this->CompressionParameter));
+  writer->SetNumberOfThreads(this->NumberOfCompressionThreads);
 
   // set volume attributes
   writer->SetIJKToRASMatrix(ijkToRas.GetPointer());
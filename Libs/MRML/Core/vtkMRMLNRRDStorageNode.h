@@ -60,6 +60,12 @@ class VTK_MRML_EXPORT vtkMRMLNRRDStorageNode : public vtkMRMLStorageNode
   /// Return true if the node can be read in.
   bool CanReadInReferenceNode(vtkMRMLNode *refNode) override;
 
+  /// NRRD files are read by teem into a separate image, without accessing the scene.
+  bool CanReadInBackgroundThread() override { return true; }
+
+  /// NRRD files are written by teem, without accessing the scene.
+  bool CanWriteInBackgroundThread() override { return true; }
+
   ///
   /// Configure the storage node for data exchange. This is an
   /// opportunity to optimize the storage node's settings, for
@@ -587,6 +587,22 @@ void vtkMRMLNode::ProcessMRMLEvents (vtkObject *caller,
   return;
 }
 
+//----------------------------------------------------------------------------
+bool vtkMRMLNode::DeferModifiedEvent()
+{
+  vtkMRMLScene* scene = this->Scene.GetPointer();
+  if (!scene || !scene->IsDeferringModifiedEvents())
+    {
+    return false;
+    }
+  if (!this->ModifiedEventDeferred)
+    {
+    this->ModifiedEventDeferred = true;
+    scene->AddDeferredModifiedNode(this);
+    }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 vtkMRMLScene* vtkMRMLNode::GetScene()
 {
@@ -605,6 +621,8 @@ void vtkMRMLNode::SetScene(vtkMRMLScene* scene)
     this->InvalidateNodeReferences();
     }
 
+  // Modified events that the previous scene deferred are not invoked by the new scene
+  this->ModifiedEventDeferred = false;
   this->Scene = scene;
   if (this->Scene)
     {
@@ -793,24 +811,31 @@ void vtkMRMLNode::SetAttribute(const char* name, const char* value)
     vtkErrorMacro(<< "SetAttribute: Name parameter is expected to be non nullptr.");
     return;
     }
-  if (strlen(name) == 0)
+  if (name[0] == '\0')
     {
     vtkErrorMacro(<< "SetAttribute: Name parameter is expected to have at least one character.");
     return;
     }
-  const char* oldValue = this->GetAttribute(name);
-  if ((!oldValue && !value) ||
-      (oldValue && value && !strcmp(oldValue, value)))
+  AttributesType::iterator iter = this->Attributes.find(name);
+  if (iter == this->Attributes.end())
     {
-    return;
+    if (!value)
+      {
+      return;
+      }
+    this->Attributes.emplace(name, value);
     }
-  if (value != nullptr)
+  else if (!value)
     {
-    this->Attributes[std::string(name)] = std::string(value);
+    this->Attributes.erase(iter);
     }
   else
     {
-    this->Attributes.erase(std::string(name));
+    if (iter->second == value)
+      {
+      return;
+      }
+    iter->second = value;
     }
   this->Modified();
 }
@@ -839,13 +864,12 @@ const char* vtkMRMLNode::GetAttribute(const char* name)
     vtkErrorMacro(<< "GetAttribute: Name parameter is expected to be non nullptr.");
     return nullptr;
     }
-  if (strlen(name) == 0)
+  if (name[0] == '\0')
     {
     vtkErrorMacro(<< "GetAttribute: Name parameter is expected to have at least one character.");
     return nullptr;
     }
-  AttributesType::const_iterator iter =
-    this->Attributes.find(std::string(name));
+  AttributesType::const_iterator iter = this->Attributes.find(name);
   if (iter == Attributes.end())
     {
     return nullptr;
@@ -860,6 +884,7 @@ const char* vtkMRMLNode::GetAttribute(const char* name)
 std::vector< std::string > vtkMRMLNode::GetAttributeNames()
 {
   std::vector< std::string > attributeNamesVector;
+  attributeNamesVector.reserve(this->Attributes.size());
   for ( AttributesType::iterator iter = this->Attributes.begin(); iter != this->Attributes.end(); ++iter )
     {
     attributeNamesVector.push_back(iter->first);
@@ -945,6 +970,40 @@ void vtkMRMLNode::SetID (const char* _arg)
   this->Modified();
 }
 
+//----------------------------------------------------------------------------
+vtkMTimeType vtkMRMLNode::GetContentMTime()
+{
+  return this->GetMTime();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLNode::SetName(const char* _arg)
+{
+  // Mostly copied from vtkSetStringMacro() in vtkSetGet.cxx
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting Name to " << (_arg?_arg:"(null)") );
+  if ( this->Name == nullptr && _arg == nullptr) { return;}
+  if ( this->Name && _arg && (!strcmp(this->Name,_arg))) { return;}
+  char* oldName = this->Name;
+  if (_arg)
+    {
+    size_t n = strlen(_arg) + 1;
+    char *cp1 =  new char[n];
+    const char *cp2 = (_arg);
+    this->Name = cp1;
+    do { *cp1++ = *cp2++; } while ( --n );
+    }
+   else
+    {
+    this->Name = nullptr;
+    }
+  if (this->Scene)
+    {
+    this->Scene->NodeNameChanged(this, oldName);
+    }
+  if (oldName) { delete [] oldName; }
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 const char * vtkMRMLNode::URLEncodeString(const char *inString)
 {
@@ -1224,7 +1283,13 @@ const char * vtkMRMLNode::GetNthNodeReferenceID(const char* referenceRole, int n
     return nullptr;
     }
 
-  NodeReferenceListType &references = this->NodeReferences[std::string(referenceRole)];
+  // Use find instead of operator[] to look up the role without adding it to the map
+  NodeReferencesType::iterator roleIt = this->NodeReferences.find(referenceRole);
+  if (roleIt == this->NodeReferences.end())
+    {
+    return nullptr;
+    }
+  NodeReferenceListType &references = roleIt->second;
   if (n >= static_cast<int>(references.size()))
     {
     return nullptr;
@@ -1246,13 +1311,21 @@ vtkMRMLNode* vtkMRMLNode::GetNthNodeReference(const char* referenceRole, int n)
     return nullptr;
     }
 
-  NodeReferenceListType &references = this->NodeReferences[std::string(referenceRole)];
-  if (n >= static_cast<int>(references.size()))
+  // The referenced node pointer is cached in the reference, so in the common case
+  // only the role lookup is needed (without inserting the role into the map).
+  NodeReferencesType::iterator roleIt = this->NodeReferences.find(referenceRole);
+  if (roleIt == this->NodeReferences.end() || n >= static_cast<int>(roleIt->second.size()))
     {
     return nullptr;
     }
 
-  vtkMRMLNode* node = references[n]->GetReferencedNode();
+  vtkMRMLNodeReference* reference = roleIt->second[n];
+  vtkMRMLNode* node = reference->GetReferencedNode();
+  if (!node && (!this->GetScene() || !reference->GetReferencedNodeID() || reference->GetReferencedNodeID()[0] == '\0'))
+    {
+    // There is nothing to resolve, skip updating the reference (that would look up the node in the scene)
+    return nullptr;
+    }
   // Maybe the node was not yet in the scene when the node ID was set.
   // Check to see if it's now there.
   // Similarly, if the scene is 0, clear the node if not already null.
@@ -1817,9 +1890,10 @@ void vtkMRMLNode::RemoveNthNodeReferenceID(const char* referenceRole, int n)
 int vtkMRMLNode::GetNumberOfNodeReferences(const char* referenceRole)
 {
   int n=0;
-  if (referenceRole)
+  NodeReferencesType::iterator roleIt = referenceRole ? this->NodeReferences.find(referenceRole) : this->NodeReferences.end();
+  if (roleIt != this->NodeReferences.end())
     {
-    NodeReferenceListType &references = this->NodeReferences[std::string(referenceRole)];
+    NodeReferenceListType &references = roleIt->second;
     NodeReferenceListType::iterator it;
     for (it = references.begin(); it != references.end(); it++)
       {
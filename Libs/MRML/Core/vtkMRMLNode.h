@@ -192,6 +192,16 @@ public:
   /// \brief Returns true if the class supports deep and shallow copying node content.
   virtual bool HasCopyContent() const;
 
+  /// \brief Estimated memory size of the data stored in the node (in kilobytes).
+  ///
+  /// Only bulk data (image data, mesh, table, sequence items, segmentation
+  /// representations, etc.) is taken into account, node properties are not.
+  /// Data that is not loaded yet (see vtkMRMLStorableNode::GetDataReadPending())
+  /// is not counted and it is not loaded by this method.
+  /// Returns 0 by default, \note Subclasses that store bulk data should reimplement this method.
+  /// \sa vtkMRMLScene::GetNodesDataMemorySize()
+  virtual unsigned long GetDataMemorySize() { return 0; }
+
   /// Set node attributes
   ///
   /// \note
@@ -404,12 +414,30 @@ public:
     this->InMRMLCallbackFlag = flag;
   }
 
+  /// \brief Get the modification time of the node, including its content (bulk data).
+  ///
+  /// The scene uses it to decide if the state of the node that is stored in the undo
+  /// stack can be shared between undo levels (see CanShareUndoState()).
+  /// The default implementation returns GetMTime(). Nodes that store data in objects
+  /// that can be modified without modifying the node (image data, mesh, table...)
+  /// must override it.
+  virtual vtkMTimeType GetContentMTime();
+
+  /// \brief Returns true if the node state stored in the undo stack can be shared between undo levels.
+  ///
+  /// Sharing is only safe if GetContentMTime() changes whenever the content of the node changes.
+  /// Many nodes can be modified without changing their modification time (for example, by
+  /// invoking only custom events), therefore sharing is disabled by default.
+  /// Subclasses that guarantee that GetContentMTime() reflects all content changes can enable it.
+  virtual bool CanShareUndoState() { return false; }
+
   /// Text description of this node, to be set by the user.
   vtkSetStringMacro(Description);
   vtkGetStringMacro(Description);
 
-  /// Name of this node, to be set by the user
-  vtkSetStringMacro(Name);
+  /// Name of this node, to be set by the user.
+  /// The scene is notified of the change so that its name index stays up-to-date.
+  virtual void SetName(const char* name);
   vtkGetStringMacro(Name);
 
   /// ID use by other nodes to reference this node in XML.
@@ -520,10 +548,14 @@ public:
   /// to invoke the event (if any of the `Set*` calls actually changed the values
   /// of the instance variables).
   ///
+  /// If the node is in a scene that is in
+  /// \link vtkMRMLScene::DeferredModifyState DeferredModifyState \endlink
+  /// then the event is pending until the scene leaves that state.
+  ///
   /// \sa GetDisableModifiedEvent()
   void Modified() override
     {
-    if (!this->GetDisableModifiedEvent())
+    if (!this->DeferModifiedEvent() && !this->GetDisableModifiedEvent())
       {
       Superclass::Modified();
       }
@@ -542,6 +574,12 @@ public:
   /// replaced by the just invoked modified event(s).
   virtual int InvokePendingModifiedEvent ()
     {
+    if ((this->ModifiedEventPending || !this->CustomModifiedEventPending.empty())
+      && this->DeferModifiedEvent())
+      {
+      // the scene will invoke the pending events
+      return 0;
+      }
     int oldModifiedEventPending = 0;
     // Invoke pending standard Modified event
     if ( this->ModifiedEventPending )
@@ -585,7 +623,7 @@ public:
   /// If the event is not invoked immediately then it will be sent with `callData=nullptr`.
   virtual void InvokeCustomModifiedEvent(int eventId, void *callData=nullptr)
     {
-    if (!this->GetDisableModifiedEvent())
+    if (!this->DeferModifiedEvent() && !this->GetDisableModifiedEvent())
       {
       // DisableModify is inactive, we immediately invoke the event
       this->InvokeEvent(eventId, callData);
@@ -1012,7 +1050,9 @@ protected:
   // the scene is deleted.
   vtkWeakPointer<vtkMRMLScene> Scene;
 
-  typedef std::map< std::string, std::string > AttributesType;
+  /// Transparent comparator allows looking up attributes by const char* name
+  /// without constructing a temporary std::string.
+  typedef std::map< std::string, std::string, std::less<> > AttributesType;
   AttributesType Attributes;
 
   vtkIntArray* ContentModifiedEvents;
@@ -1021,8 +1061,10 @@ protected:
 
   /// NodeReferences is a map that stores vector of references for each referenceRole,
   /// the referenceRole can be any unique string, for example "display", "transform" etc.
+  /// Transparent comparator allows looking up roles by const char* without constructing
+  /// a temporary std::string.
   typedef std::vector< vtkSmartPointer<vtkMRMLNodeReference> > NodeReferenceListType;
-  typedef std::map< std::string, NodeReferenceListType > NodeReferencesType;
+  typedef std::map< std::string, NodeReferenceListType, std::less<> > NodeReferencesType;
   NodeReferencesType NodeReferences;
 
   std::map< std::string, std::string> NodeReferenceMRMLAttributeNames;
@@ -1049,6 +1091,12 @@ private:
   int DisableModifiedEvent{0};
   int ModifiedEventPending{0};
   std::map<int, int> CustomModifiedEventPending; // event id, pending value (number of events grouped together)
+
+  /// Returns true if the scene is in DeferredModify state, in which case the
+  /// node is registered in the scene to invoke its pending events later.
+  bool DeferModifiedEvent();
+  /// Set when the node is registered in the scene to invoke its pending events later.
+  bool ModifiedEventDeferred{false};
 };
 
 /// \brief Safe replacement of MRML node start/end modify.
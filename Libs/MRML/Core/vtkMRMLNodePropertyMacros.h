@@ -10,11 +10,76 @@
 #ifndef __vtkMRMLNodePropertyMacros_h
 #define __vtkMRMLNodePropertyMacros_h
 
+#include <cctype> // needed for isspace
+#include <cerrno> // needed for errno
+#include <climits> // needed for INT_MIN, INT_MAX
+#include <cstdlib> // needed for strtod, strtol
 #include <sstream> // needed for std::stringstream
 #include <vtksys/SystemTools.hxx> // needed for vtksys::SystemTools functions
 
 /// @file
 
+/// Helper functions for parsing numbers in XML reading macros.
+/// Values are parsed directly from the attribute value buffer, without creating temporary strings
+/// or streams, as this is called for every attribute of every node when a scene is loaded.
+/// Leading and trailing whitespace is ignored, the same way as by vtkVariant::ToInt()
+/// and vtkVariant::ToDouble().
+namespace vtkMRMLNodePropertyParsing
+{
+  /// Returns true if the string contains only whitespace characters until \a end
+  /// (or until the terminating null character if \a end is nullptr).
+  inline bool IsWhitespace(const char* str, const char* end = nullptr)
+  {
+    for (; (end ? str < end : *str != '\0'); ++str)
+      {
+      if (!isspace(static_cast<unsigned char>(*str)))
+        {
+        return false;
+        }
+      }
+    return true;
+  }
+
+  /// Parse integer from the string between \a begin and \a end
+  /// (or the terminating null character if \a end is nullptr).
+  inline bool ToInt(const char* begin, const char* end, int& value)
+  {
+    if (end ? (begin >= end || IsWhitespace(begin, end)) : IsWhitespace(begin))
+      {
+      return false;
+      }
+    char* parsedEnd = nullptr;
+    errno = 0;
+    long longValue = strtol(begin, &parsedEnd, 10);
+    if (parsedEnd == begin || errno == ERANGE || longValue < INT_MIN || longValue > INT_MAX
+      || (end ? (parsedEnd > end || !IsWhitespace(parsedEnd, end)) : !IsWhitespace(parsedEnd)))
+      {
+      return false;
+      }
+    value = static_cast<int>(longValue);
+    return true;
+  }
+
+  /// Parse floating-point number from the string between \a begin and \a end
+  /// (or the terminating null character if \a end is nullptr).
+  inline bool ToDouble(const char* begin, const char* end, double& value)
+  {
+    if (end ? (begin >= end || IsWhitespace(begin, end)) : IsWhitespace(begin))
+      {
+      return false;
+      }
+    char* parsedEnd = nullptr;
+    double doubleValue = strtod(begin, &parsedEnd);
+    if (parsedEnd == begin
+      || (end ? (parsedEnd > end || !IsWhitespace(parsedEnd, end)) : !IsWhitespace(parsedEnd)))
+      {
+      return false;
+      }
+    value = doubleValue;
+    return true;
+  }
+}
+
 //----------------------------------------------------------------------------
 /// @defgroup vtkMRMLWriteXMLMacros Helper macros for writing MRML node properties to XML attributes.
 /// They are To be used in WriteXML(ostream& of, int nIndent) method.
@@ -229,10 +294,8 @@
 #define vtkMRMLReadXMLIntMacro(xmlAttributeName, propertyName) \
   if (!strcmp(xmlReadAttName, #xmlAttributeName)) \
     { \
-    vtkVariant variantValue(xmlReadAttValue); \
-    bool valid = false; \
-    int intValue =  variantValue.ToInt(&valid); \
-    if (valid) \
+    int intValue = 0; \
+    if (vtkMRMLNodePropertyParsing::ToInt(xmlReadAttValue, nullptr, intValue)) \
       { \
       this->Set##propertyName(intValue); \
       } \
@@ -246,10 +309,8 @@
 #define vtkMRMLReadXMLFloatMacro(xmlAttributeName, propertyName) \
   if (!strcmp(xmlReadAttName, #xmlAttributeName)) \
     { \
-    vtkVariant variantValue(xmlReadAttValue); \
-    bool valid = false; \
-    double scalarValue =  variantValue.ToDouble(&valid); \
-    if (valid) \
+    double scalarValue = 0.0; \
+    if (vtkMRMLNodePropertyParsing::ToDouble(xmlReadAttValue, nullptr, scalarValue)) \
       { \
       this->Set##propertyName(scalarValue); \
       } \
@@ -264,13 +325,17 @@
   if (!strcmp(xmlReadAttName, #xmlAttributeName)) \
     { \
     vectorType vectorValue[vectorSize] = {0}; \
-    std::stringstream ss; \
-    ss << xmlReadAttValue; \
+    const char* valuePtr = xmlReadAttValue; \
     for (int i=0; i<vectorSize; i++) \
       { \
-      vectorType val; \
-      ss >> val; \
-      vectorValue[i] = val; \
+      char* valueEnd = nullptr; \
+      double val = strtod(valuePtr, &valueEnd); \
+      if (valueEnd == valuePtr) \
+        { \
+        break; \
+        } \
+      vectorValue[i] = static_cast<vectorType>(val); \
+      valuePtr = valueEnd; \
       } \
     this->Set##propertyName(vectorValue); \
     }
@@ -280,20 +345,18 @@
   if (!strcmp(xmlReadAttName, #xmlAttributeName)) \
     { \
     vectorType vector; \
-    std::string valueString(xmlReadAttValue); \
-    size_t separatorPosition = valueString.find(" "); \
-    while(separatorPosition != std::string::npos) \
+    /* values are space-terminated */ \
+    const char* valueBegin = xmlReadAttValue; \
+    const char* separator = strchr(valueBegin, ' '); \
+    while (separator != nullptr) \
       { \
-      std::string attributeValue = valueString.substr(0, separatorPosition); \
-      vtkVariant variantValue(attributeValue); \
-      bool valid = false; \
-      vectorType::value_type scalarValue = variantValue.ToDouble(&valid); \
-      if (valid) \
+      double scalarValue = 0; \
+      if (vtkMRMLNodePropertyParsing::ToDouble(valueBegin, separator, scalarValue)) \
         { \
-        vector.insert(vector.end(), scalarValue); \
+        vector.insert(vector.end(), static_cast<vectorType::value_type>(scalarValue)); \
         } \
-      valueString = valueString.substr(separatorPosition+1); \
-      separatorPosition = valueString.find(" "); \
+      valueBegin = separator + 1; \
+      separator = strchr(valueBegin, ' '); \
       } \
     this->Set##propertyName(vector); \
   }
@@ -303,20 +366,18 @@
   if (!strcmp(xmlReadAttName, #xmlAttributeName)) \
     { \
     vectorType vector; \
-    std::string valueString(xmlReadAttValue); \
-    size_t separatorPosition = valueString.find(" "); \
-    while(separatorPosition != std::string::npos) \
+    /* values are space-terminated */ \
+    const char* valueBegin = xmlReadAttValue; \
+    const char* separator = strchr(valueBegin, ' '); \
+    while (separator != nullptr) \
       { \
-      std::string attributeValue = valueString.substr(0, separatorPosition); \
-      vtkVariant variantValue(attributeValue); \
-      bool valid = false; \
-      vectorType::value_type scalarValue = variantValue.ToInt(&valid); \
-      if (valid) \
+      int scalarValue = 0; \
+      if (vtkMRMLNodePropertyParsing::ToInt(valueBegin, separator, scalarValue)) \
         { \
-        vector.insert(vector.end(), scalarValue); \
+        vector.insert(vector.end(), static_cast<vectorType::value_type>(scalarValue)); \
         } \
-      valueString = valueString.substr(separatorPosition+1); \
-      separatorPosition = valueString.find(" "); \
+      valueBegin = separator + 1; \
+      separator = strchr(valueBegin, ' '); \
       } \
     this->Set##propertyName(vector); \
     }
@@ -370,9 +431,13 @@
 
 /// This macro must be placed before the first value copying macro.
 /// \param sourceNode pointer to the node where property values will be copied from
+///
+/// The source node is cast to the type of this node only once, as copying is performed
+/// very frequently (undo, sequence browsing, scene views) and type checking in SafeDownCast
+/// requires string comparisons along the whole class hierarchy.
 #define vtkMRMLCopyBeginMacro(sourceNode) \
   { \
-  vtkMRMLNode* copySourceNode = this->SafeDownCast(sourceNode); \
+  auto* copySourceNode = this->SafeDownCast(sourceNode); \
   if (copySourceNode != nullptr) \
     {
 
@@ -387,34 +452,34 @@
 
 /// Macro for copying bool node property value.
 #define vtkMRMLCopyBooleanMacro(propertyName) \
-  this->Set##propertyName(this->SafeDownCast(copySourceNode)->Get##propertyName());
+  this->Set##propertyName(copySourceNode->Get##propertyName());
 
 /// Macro for copying char* node property value.
 #define vtkMRMLCopyStringMacro(propertyName) \
-  this->Set##propertyName(this->SafeDownCast(copySourceNode)->Get##propertyName());
+  this->Set##propertyName(copySourceNode->Get##propertyName());
 
 /// Macro for copying std::string node property value.
 #define vtkMRMLCopyStdStringMacro(propertyName) \
-  this->Set##propertyName(this->SafeDownCast(copySourceNode)->Get##propertyName());
+  this->Set##propertyName(copySourceNode->Get##propertyName());
 
 /// Macro for copying int node property value.
 #define vtkMRMLCopyIntMacro(propertyName) \
-  this->Set##propertyName(this->SafeDownCast(copySourceNode)->Get##propertyName());
+  this->Set##propertyName(copySourceNode->Get##propertyName());
 
 /// Macro for copying enum node property value.
 #define vtkMRMLCopyEnumMacro(propertyName) \
-  this->Set##propertyName(this->SafeDownCast(copySourceNode)->Get##propertyName());
+  this->Set##propertyName(copySourceNode->Get##propertyName());
 
 /// Macro for copying floating-point (float or double) node property value.
 #define vtkMRMLCopyFloatMacro(propertyName) \
-  this->Set##propertyName(this->SafeDownCast(copySourceNode)->Get##propertyName());
+  this->Set##propertyName(copySourceNode->Get##propertyName());
 
 /// Macro for copying floating-point (float or double) vector node property value.
 #define vtkMRMLCopyVectorMacro(propertyName, vectorType, vectorSize) \
     { \
     /* Currently, vectorType and vectorSize is not essential, but in the future */ \
     /* this information may be used more. */ \
-    vectorType* sourceVector = this->SafeDownCast(copySourceNode)->Get##propertyName(); \
+    vectorType* sourceVector = copySourceNode->Get##propertyName(); \
     if (sourceVector != nullptr) \
       { \
       this->Set##propertyName(sourceVector); \
@@ -427,21 +492,21 @@
 
 /// Macro for copying an iterable container (float or double) vector node property value.
 #define vtkMRMLCopyStdFloatVectorMacro(propertyName) \
-  this->Set##propertyName(this->SafeDownCast(copySourceNode)->Get##propertyName());
+  this->Set##propertyName(copySourceNode->Get##propertyName());
 
 /// Macro for copying an iterable container (int) vector node property value.
 #define vtkMRMLCopyStdIntVectorMacro(propertyName) \
-  this->Set##propertyName(this->SafeDownCast(copySourceNode)->Get##propertyName());
+  this->Set##propertyName(copySourceNode->Get##propertyName());
 
 /// Macro for copying an iterable container (of std::string) vector node property value.
 #define vtkMRMLCopyStdStringVectorMacro(propertyName) \
-  this->Set##propertyName(this->SafeDownCast(copySourceNode)->Get##propertyName());
+  this->Set##propertyName(copySourceNode->Get##propertyName());
 
 /// Macro for copying a vtkMatrix4x4* property value.
 /// "Owned" means that the node owns the matrix, the object is always valid and cannot be replaced from outside
 /// (there is no public Set...() method for the matrix).
 #define vtkMRMLCopyOwnedMatrix4x4Macro(propertyName) \
-   this->Get##propertyName()->DeepCopy(this->SafeDownCast(copySourceNode)->Get##propertyName());
+   this->Get##propertyName()->DeepCopy(copySourceNode->Get##propertyName());
 
 /// @}
 
@@ -0,0 +1,641 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRML includes
+#include "vtkMRMLI18N.h"
+#include "vtkMRMLMessageCollection.h"
+#include "vtkMRMLMultiResolutionVolumeNode.h"
+#include "vtkMRMLOMEZarrStorageNode.h"
+
+// VTK includes
+#include <vtkByteSwap.h>
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkSmartPointer.h>
+#include <vtkStringArray.h>
+#include <vtk_zlib.h>
+
+// VTKsys includes
+#include <vtksys/SystemTools.hxx>
+
+// RapidJSON includes
+#include <rapidjson/document.h>
+
+// STD includes
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+//----------------------------------------------------------------------------
+namespace
+{
+
+enum CompressionType
+{
+  CompressionNone,
+  /// zlib or gzip stream, detected from the header
+  CompressionZlib
+};
+
+/// Zarr array of one level of the pyramid
+struct ZarrArrayInfo
+{
+  std::string Path;
+  /// All the axes, slowest varying first
+  std::vector<int> Shape;
+  std::vector<int> Chunks;
+  /// Spatial dimensions along x, y, z
+  int Dimensions[3]{1, 1, 1};
+  int TileDimensions[3]{1, 1, 1};
+  /// Index of the x, y, z axes in Shape, -1 if the axis does not exist
+  int SpatialAxes[3]{-1, -1, -1};
+  int ScalarType{VTK_UNSIGNED_CHAR};
+  int ScalarSize{1};
+  bool SwapBytes{false};
+  CompressionType Compression{CompressionNone};
+  std::string DimensionSeparator{"."};
+  double FillValue{0.0};
+};
+
+//----------------------------------------------------------------------------
+bool ReadJSONFile(const std::string& fileName, rapidjson::Document& document)
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+    {
+    return false;
+    }
+  std::stringstream content;
+  content << file.rdbuf();
+  std::string text = content.str();
+  return !document.Parse(text.c_str()).HasParseError() && document.IsObject();
+}
+
+//----------------------------------------------------------------------------
+bool ReadIntArray(const rapidjson::Value& value, std::vector<int>& values)
+{
+  if (!value.IsArray())
+    {
+    return false;
+    }
+  values.clear();
+  for (rapidjson::Value::ConstValueIterator it = value.Begin(); it != value.End(); ++it)
+    {
+    if (!it->IsInt() || it->GetInt() < 1)
+      {
+      return false;
+      }
+    values.push_back(it->GetInt());
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool ReadDoubleArray(const rapidjson::Value& value, std::vector<double>& values)
+{
+  if (!value.IsArray())
+    {
+    return false;
+    }
+  values.clear();
+  for (rapidjson::Value::ConstValueIterator it = value.Begin(); it != value.End(); ++it)
+    {
+    if (!it->IsNumber())
+      {
+      return false;
+      }
+    values.push_back(it->GetDouble());
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+/// Apply the "scale" and "translation" coordinate transformations to scale and translation
+void ReadCoordinateTransformations(const rapidjson::Value& value,
+  std::vector<double>& scale, std::vector<double>& translation)
+{
+  if (!value.IsArray())
+    {
+    return;
+    }
+  for (rapidjson::Value::ConstValueIterator it = value.Begin(); it != value.End(); ++it)
+    {
+    if (!it->IsObject() || !it->HasMember("type") || !(*it)["type"].IsString())
+      {
+      continue;
+      }
+    std::string type = (*it)["type"].GetString();
+    std::vector<double> values;
+    if (type == "scale" && it->HasMember("scale") && ReadDoubleArray((*it)["scale"], values)
+      && values.size() == scale.size())
+      {
+      for (size_t i = 0; i < scale.size(); ++i)
+        {
+        scale[i] *= values[i];
+        translation[i] *= values[i];
+        }
+      }
+    else if (type == "translation" && it->HasMember("translation") && ReadDoubleArray((*it)["translation"], values)
+      && values.size() == translation.size())
+      {
+      for (size_t i = 0; i < translation.size(); ++i)
+        {
+        translation[i] += values[i];
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+/// Parse a numpy type string such as "<u2"
+bool ParseDataType(const std::string& dtype, int& scalarType, int& scalarSize, bool& swapBytes)
+{
+  if (dtype.size() != 3)
+    {
+    return false;
+    }
+  char byteOrder = dtype[0];
+  char kind = dtype[1];
+  scalarSize = dtype[2] - '0';
+#ifdef VTK_WORDS_BIGENDIAN
+  swapBytes = (byteOrder == '<');
+#else
+  swapBytes = (byteOrder == '>');
+#endif
+  if (scalarSize == 1)
+    {
+    swapBytes = false;
+    }
+  switch (kind)
+    {
+    case 'b':
+    case 'u':
+      scalarType = (scalarSize == 1 ? VTK_UNSIGNED_CHAR : scalarSize == 2 ? VTK_UNSIGNED_SHORT
+        : scalarSize == 4 ? VTK_UNSIGNED_INT : VTK_VOID);
+      break;
+    case 'i':
+      scalarType = (scalarSize == 1 ? VTK_SIGNED_CHAR : scalarSize == 2 ? VTK_SHORT
+        : scalarSize == 4 ? VTK_INT : VTK_VOID);
+      break;
+    case 'f':
+      scalarType = (scalarSize == 4 ? VTK_FLOAT : scalarSize == 8 ? VTK_DOUBLE : VTK_VOID);
+      break;
+    default:
+      scalarType = VTK_VOID;
+    }
+  return scalarType != VTK_VOID;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void FillTile(T* voxels, vtkIdType numberOfVoxels, double value)
+{
+  std::fill(voxels, voxels + numberOfVoxels, static_cast<T>(value));
+}
+
+//----------------------------------------------------------------------------
+bool Inflate(const std::vector<char>& compressed, std::vector<char>& uncompressed)
+{
+  z_stream stream;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+  stream.avail_in = static_cast<uInt>(compressed.size());
+  // automatic zlib or gzip header detection
+  if (inflateInit2(&stream, 15 + 32) != Z_OK)
+    {
+    return false;
+    }
+  stream.next_out = reinterpret_cast<Bytef*>(uncompressed.data());
+  stream.avail_out = static_cast<uInt>(uncompressed.size());
+  int result = inflate(&stream, Z_FINISH);
+  inflateEnd(&stream);
+  return result == Z_STREAM_END && stream.avail_out == 0;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+class vtkMRMLOMEZarrStorageNode::vtkInternal
+{
+public:
+  /// Protects the members below, which are read by ReadTile() from the tile loading threads
+  std::mutex Mutex;
+  std::string Directory;
+  std::vector<ZarrArrayInfo> Levels;
+};
+
+//----------------------------------------------------------------------------
+vtkMRMLNodeNewMacro(vtkMRMLOMEZarrStorageNode);
+
+//----------------------------------------------------------------------------
+vtkMRMLOMEZarrStorageNode::vtkMRMLOMEZarrStorageNode()
+{
+  this->Internal = new vtkInternal;
+}
+
+//----------------------------------------------------------------------------
+vtkMRMLOMEZarrStorageNode::~vtkMRMLOMEZarrStorageNode()
+{
+  delete this->Internal;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLOMEZarrStorageNode::ReadXMLAttributes(const char** atts)
+{
+  MRMLNodeModifyBlocker blocker(this);
+  Superclass::ReadXMLAttributes(atts);
+  vtkMRMLReadXMLBeginMacro(atts);
+  vtkMRMLReadXMLIntMacro(overviewMaximumNumberOfVoxels, OverviewMaximumNumberOfVoxels);
+  vtkMRMLReadXMLEndMacro();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLOMEZarrStorageNode::WriteXML(ostream& of, int nIndent)
+{
+  Superclass::WriteXML(of, nIndent);
+  vtkMRMLWriteXMLBeginMacro(of);
+  vtkMRMLWriteXMLIntMacro(overviewMaximumNumberOfVoxels, OverviewMaximumNumberOfVoxels);
+  vtkMRMLWriteXMLEndMacro();
+}
+
+//----------------------------------------------------------------------------
+// Copy the node's attributes to this object.
+// Does NOT copy: ID, FilePrefix, Name, StorageID
+void vtkMRMLOMEZarrStorageNode::Copy(vtkMRMLNode *anode)
+{
+  MRMLNodeModifyBlocker blocker(anode);
+  Superclass::Copy(anode);
+  vtkMRMLCopyBeginMacro(anode);
+  vtkMRMLCopyIntMacro(OverviewMaximumNumberOfVoxels);
+  vtkMRMLCopyEndMacro();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLOMEZarrStorageNode::PrintSelf(ostream& os, vtkIndent indent)
+{
+  Superclass::PrintSelf(os,indent);
+  vtkMRMLPrintBeginMacro(os, indent);
+  vtkMRMLPrintIntMacro(OverviewMaximumNumberOfVoxels);
+  vtkMRMLPrintEndMacro();
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  os << indent << "NumberOfLevels: " << this->Internal->Levels.size() << "\n";
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLOMEZarrStorageNode::CanReadInReferenceNode(vtkMRMLNode *refNode)
+{
+  return refNode->IsA("vtkMRMLMultiResolutionVolumeNode");
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLOMEZarrStorageNode::CanWriteFromReferenceNode(vtkMRMLNode* vtkNotUsed(refNode))
+{
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLOMEZarrStorageNode::InitializeSupportedReadFileTypes()
+{
+  //: File format name
+  std::string fileType = vtkMRMLTr("vtkMRMLOMEZarrStorageNode", "OME-Zarr");
+  this->SupportedReadFileTypes->InsertNextValue(fileType + " (.ome.zarr)");
+  this->SupportedReadFileTypes->InsertNextValue(fileType + " (.zarr)");
+}
+
+//----------------------------------------------------------------------------
+int vtkMRMLOMEZarrStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
+{
+  vtkMRMLMultiResolutionVolumeNode* volumeNode = vtkMRMLMultiResolutionVolumeNode::SafeDownCast(refNode);
+  if (!volumeNode)
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLOMEZarrStorageNode::ReadDataInternal",
+      "Reference node is expected to be a vtkMRMLMultiResolutionVolumeNode");
+    return 0;
+    }
+  std::string directory = this->GetFullNameFromFileName();
+  if (directory.empty() || !vtksys::SystemTools::FileIsDirectory(directory))
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLOMEZarrStorageNode::ReadDataInternal",
+      "OME-Zarr directory not found: '" << directory << "'");
+    return 0;
+    }
+
+  rapidjson::Document attributes;
+  if (!ReadJSONFile(directory + "/.zattrs", attributes)
+    || !attributes.HasMember("multiscales") || !attributes["multiscales"].IsArray()
+    || attributes["multiscales"].Empty() || !attributes["multiscales"][0].IsObject())
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLOMEZarrStorageNode::ReadDataInternal",
+      "Invalid or missing multiscales metadata in '" << directory << "/.zattrs'");
+    return 0;
+    }
+  const rapidjson::Value& multiscale = attributes["multiscales"][0];
+  if (!multiscale.HasMember("datasets") || !multiscale["datasets"].IsArray() || multiscale["datasets"].Empty())
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLOMEZarrStorageNode::ReadDataInternal",
+      "No datasets in the multiscales metadata of '" << directory << "'");
+    return 0;
+    }
+
+  // Axis types (only in version 0.4 and later), used to find the z axis
+  std::vector<std::string> axisTypes;
+  if (multiscale.HasMember("axes") && multiscale["axes"].IsArray())
+    {
+    const rapidjson::Value& axes = multiscale["axes"];
+    for (rapidjson::Value::ConstValueIterator it = axes.Begin(); it != axes.End(); ++it)
+      {
+      std::string type = "space";
+      if (it->IsObject() && it->HasMember("type") && (*it)["type"].IsString())
+        {
+        type = (*it)["type"].GetString();
+        }
+      else if (it->IsString())
+        {
+        // version 0.3 lists axis names
+        std::string name = it->GetString();
+        type = (name == "x" || name == "y" || name == "z") ? "space" : name;
+        }
+      axisTypes.push_back(type);
+      }
+    }
+
+  std::vector<ZarrArrayInfo> levels;
+  std::vector<std::vector<double> > levelScales;
+  std::vector<std::vector<double> > levelTranslations;
+  const rapidjson::Value& datasets = multiscale["datasets"];
+  for (rapidjson::Value::ConstValueIterator it = datasets.Begin(); it != datasets.End(); ++it)
+    {
+    if (!it->IsObject() || !it->HasMember("path") || !(*it)["path"].IsString())
+      {
+      vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLOMEZarrStorageNode::ReadDataInternal",
+        "Invalid dataset in the multiscales metadata of '" << directory << "'");
+      return 0;
+      }
+    ZarrArrayInfo level;
+    level.Path = (*it)["path"].GetString();
+
+    rapidjson::Document array;
+    std::string arrayFileName = directory + "/" + level.Path + "/.zarray";
+    if (!ReadJSONFile(arrayFileName, array)
+      || !array.HasMember("shape") || !ReadIntArray(array["shape"], level.Shape)
+      || !array.HasMember("chunks") || !ReadIntArray(array["chunks"], level.Chunks)
+      || level.Shape.size() != level.Chunks.size() || level.Shape.size() < 2
+      || !array.HasMember("dtype") || !array["dtype"].IsString())
+      {
+      vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLOMEZarrStorageNode::ReadDataInternal",
+        "Invalid Zarr array metadata in '" << arrayFileName << "'");
+      return 0;
+      }
+    if (!ParseDataType(array["dtype"].GetString(), level.ScalarType, level.ScalarSize, level.SwapBytes))
+      {
+      vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLOMEZarrStorageNode::ReadDataInternal",
+        "Unsupported voxel type '" << array["dtype"].GetString() << "' in '" << arrayFileName << "'");
+      return 0;
+      }
+    if (array.HasMember("order") && array["order"].IsString() && std::string(array["order"].GetString()) != "C")
+      {
+      vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLOMEZarrStorageNode::ReadDataInternal",
+        "Only C order Zarr arrays are supported: '" << arrayFileName << "'");
+      return 0;
+      }
+    if (array.HasMember("filters") && !array["filters"].IsNull())
+      {
+      vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLOMEZarrStorageNode::ReadDataInternal",
+        "Zarr filters are not supported: '" << arrayFileName << "'");
+      return 0;
+      }
+    if (array.HasMember("compressor") && !array["compressor"].IsNull())
+      {
+      const rapidjson::Value& compressor = array["compressor"];
+      std::string id = (compressor.IsObject() && compressor.HasMember("id") && compressor["id"].IsString())
+        ? compressor["id"].GetString() : "";
+      if (id != "zlib" && id != "gzip")
+        {
+        vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLOMEZarrStorageNode::ReadDataInternal",
+          "Unsupported Zarr compressor '" << id << "' in '" << arrayFileName << "', only zlib and gzip are supported");
+        return 0;
+        }
+      level.Compression = CompressionZlib;
+      }
+    if (array.HasMember("dimension_separator") && array["dimension_separator"].IsString())
+      {
+      level.DimensionSeparator = array["dimension_separator"].GetString();
+      }
+    if (array.HasMember("fill_value"))
+      {
+      const rapidjson::Value& fillValue = array["fill_value"];
+      if (fillValue.IsNumber())
+        {
+        level.FillValue = fillValue.GetDouble();
+        }
+      else if (fillValue.IsString() && std::string(fillValue.GetString()) == "NaN")
+        {
+        level.FillValue = std::numeric_limits<double>::quiet_NaN();
+        }
+      }
+
+    // The last two or three axes are z, y, x
+    int numberOfAxes = static_cast<int>(level.Shape.size());
+    level.SpatialAxes[0] = numberOfAxes - 1;
+    level.SpatialAxes[1] = numberOfAxes - 2;
+    bool hasZAxis = numberOfAxes >= 3
+      && (axisTypes.size() != level.Shape.size() || axisTypes[numberOfAxes - 3] == "space");
+    level.SpatialAxes[2] = hasZAxis ? numberOfAxes - 3 : -1;
+    for (int i = 0; i < 3; ++i)
+      {
+      if (level.SpatialAxes[i] >= 0)
+        {
+        level.Dimensions[i] = level.Shape[level.SpatialAxes[i]];
+        level.TileDimensions[i] = level.Chunks[level.SpatialAxes[i]];
+        }
+      }
+
+    std::vector<double> scale(numberOfAxes, 1.0);
+    std::vector<double> translation(numberOfAxes, 0.0);
+    if (it->HasMember("coordinateTransformations"))
+      {
+      ReadCoordinateTransformations((*it)["coordinateTransformations"], scale, translation);
+      }
+    if (multiscale.HasMember("coordinateTransformations"))
+      {
+      ReadCoordinateTransformations(multiscale["coordinateTransformations"], scale, translation);
+      }
+    levels.push_back(level);
+    levelScales.push_back(scale);
+    levelTranslations.push_back(translation);
+    }
+
+  {
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    this->Internal->Directory = directory;
+    this->Internal->Levels = levels;
+  }
+
+  MRMLNodeModifyBlocker blocker(volumeNode);
+  volumeNode->RemoveAllLevels();
+  // OME-Zarr coordinates are interpreted as LPS
+  volumeNode->SetIJKToRASDirections(-1.0, 0.0, 0.0, 0.0, -1.0, 0.0, 0.0, 0.0, 1.0);
+  const double lpsToRAS[3] = { -1.0, -1.0, 1.0 };
+  int overviewLevel = static_cast<int>(levels.size()) - 1;
+  for (size_t levelIndex = 0; levelIndex < levels.size(); ++levelIndex)
+    {
+    const ZarrArrayInfo& level = levels[levelIndex];
+    double spacing[3] = { 1.0, 1.0, 1.0 };
+    double origin[3] = { 0.0, 0.0, 0.0 };
+    for (int i = 0; i < 3; ++i)
+      {
+      if (level.SpatialAxes[i] >= 0)
+        {
+        spacing[i] = levelScales[levelIndex][level.SpatialAxes[i]];
+        origin[i] = lpsToRAS[i] * levelTranslations[levelIndex][level.SpatialAxes[i]];
+        }
+      }
+    volumeNode->AddLevel(level.Dimensions, level.TileDimensions, spacing, origin);
+    double numberOfVoxels = static_cast<double>(level.Dimensions[0]) * level.Dimensions[1] * level.Dimensions[2];
+    if (numberOfVoxels <= this->OverviewMaximumNumberOfVoxels && static_cast<int>(levelIndex) < overviewLevel)
+      {
+      overviewLevel = static_cast<int>(levelIndex);
+      }
+    }
+  volumeNode->SetTileStorageNode(this);
+
+  // Read the overview
+  const ZarrArrayInfo& overview = levels[overviewLevel];
+  int overviewExtent[6] = { 0, overview.Dimensions[0] - 1, 0, overview.Dimensions[1] - 1, 0, overview.Dimensions[2] - 1 };
+  vtkSmartPointer<vtkImageData> overviewImage = vtkSmartPointer<vtkImageData>::New();
+  if (volumeNode->GetRegion(overviewLevel, overviewExtent, overviewImage, true) != 0)
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLOMEZarrStorageNode::ReadDataInternal",
+      "Failed to read level '" << overview.Path << "' of '" << directory << "'");
+    return 0;
+    }
+  double overviewSpacing[3];
+  volumeNode->GetLevelSpacing(overviewLevel, overviewSpacing);
+  vtkNew<vtkMatrix4x4> overviewIJKToRAS;
+  volumeNode->GetLevelIJKToRASMatrix(overviewLevel, overviewIJKToRAS);
+  volumeNode->SetSpacing(overviewSpacing);
+  volumeNode->SetOrigin(overviewIJKToRAS->GetElement(0, 3), overviewIJKToRAS->GetElement(1, 3), overviewIJKToRAS->GetElement(2, 3));
+  volumeNode->SetAndObserveImageData(overviewImage);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLOMEZarrStorageNode::ReadTile(int levelIndex, const int tileIndex[3], vtkImageData* tile)
+{
+  if (!tile)
+    {
+    return false;
+    }
+  ZarrArrayInfo level;
+  std::string directory;
+  {
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    if (levelIndex < 0 || levelIndex >= static_cast<int>(this->Internal->Levels.size()))
+      {
+      return false;
+      }
+    level = this->Internal->Levels[levelIndex];
+    directory = this->Internal->Directory;
+  }
+
+  // Chunk file name, the first element of the non spatial axes is read
+  std::vector<int> chunkIndex(level.Shape.size(), 0);
+  int tileExtent[6];
+  for (int i = 0; i < 3; ++i)
+    {
+    if (level.SpatialAxes[i] >= 0)
+      {
+      chunkIndex[level.SpatialAxes[i]] = tileIndex[i];
+      }
+    tileExtent[2 * i] = tileIndex[i] * level.TileDimensions[i];
+    tileExtent[2 * i + 1] = std::min(tileExtent[2 * i] + level.TileDimensions[i], level.Dimensions[i]) - 1;
+    if (tileIndex[i] < 0 || tileExtent[2 * i] > tileExtent[2 * i + 1])
+      {
+      return false;
+      }
+    }
+  std::stringstream chunkFileName;
+  chunkFileName << directory << "/" << level.Path << "/";
+  for (size_t axis = 0; axis < chunkIndex.size(); ++axis)
+    {
+    chunkFileName << (axis > 0 ? level.DimensionSeparator : "") << chunkIndex[axis];
+    }
+
+  tile->Initialize();
+  tile->SetExtent(tileExtent);
+  tile->AllocateScalars(level.ScalarType, 1);
+  vtkIdType numberOfVoxels = tile->GetNumberOfPoints();
+
+  std::ifstream file(chunkFileName.str().c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+    {
+    // Zarr does not store chunks that only contain the fill value
+    switch (level.ScalarType)
+      {
+      vtkTemplateMacro(FillTile(static_cast<VTK_TT*>(tile->GetScalarPointer()), numberOfVoxels, level.FillValue));
+      }
+    return true;
+    }
+  std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  // Chunks are always stored with the full chunk size, also at the end of the array
+  size_t chunkSize = static_cast<size_t>(level.ScalarSize);
+  for (int chunkDimension : level.Chunks)
+    {
+    chunkSize *= chunkDimension;
+    }
+  if (level.Compression == CompressionZlib)
+    {
+    std::vector<char> uncompressed(chunkSize);
+    if (!Inflate(data, uncompressed))
+      {
+      vtkErrorMacro("ReadTile: failed to decompress '" << chunkFileName.str() << "'");
+      return false;
+      }
+    data.swap(uncompressed);
+    }
+  if (data.size() != chunkSize)
+    {
+    vtkErrorMacro("ReadTile: unexpected size of '" << chunkFileName.str() << "'");
+    return false;
+    }
+
+  // Copy the rows of the chunk that are inside the array
+  size_t rowSize = static_cast<size_t>(tileExtent[1] - tileExtent[0] + 1) * level.ScalarSize;
+  for (int k = tileExtent[4]; k <= tileExtent[5]; ++k)
+    {
+    for (int j = tileExtent[2]; j <= tileExtent[3]; ++j)
+      {
+      size_t offset = (static_cast<size_t>(k - tileExtent[4]) * level.TileDimensions[1] + (j - tileExtent[2]))
+        * level.TileDimensions[0] * level.ScalarSize;
+      memcpy(tile->GetScalarPointer(tileExtent[0], j, k), data.data() + offset, rowSize);
+      }
+    }
+  if (level.SwapBytes)
+    {
+    vtkByteSwap::SwapVoidRange(tile->GetScalarPointer(), numberOfVoxels, level.ScalarSize);
+    }
+  return true;
+}
@@ -0,0 +1,97 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __vtkMRMLOMEZarrStorageNode_h
+#define __vtkMRMLOMEZarrStorageNode_h
+
+// MRML includes
+#include "vtkMRMLStorageNode.h"
+
+// VTK includes
+class vtkImageData;
+
+/// \brief MRML node for reading multi-resolution volumes stored as OME-Zarr.
+///
+/// FileName is the local .zarr (or .ome.zarr) directory. The pyramid levels
+/// listed in the "multiscales" metadata of its .zattrs file are added to the
+/// vtkMRMLMultiResolutionVolumeNode, then only the finest level with less than
+/// OverviewMaximumNumberOfVoxels voxels is read as the image data of the node.
+/// The other tiles (Zarr chunks) are read on demand by ReadTile().
+///
+/// Supported subset of the format: Zarr version 2 arrays in C order, with
+/// no compression or zlib/gzip compression, of 8, 16 or 32 bit integer or
+/// float voxels. The last axes are z, y, x; the first element of the other
+/// (time, channel) axes is read. Coordinates are interpreted as LPS millimeters.
+/// Writing is not supported.
+class VTK_MRML_EXPORT vtkMRMLOMEZarrStorageNode : public vtkMRMLStorageNode
+{
+public:
+  static vtkMRMLOMEZarrStorageNode *New();
+  vtkTypeMacro(vtkMRMLOMEZarrStorageNode,vtkMRMLStorageNode);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  vtkMRMLNode* CreateNodeInstance() override;
+
+  /// Read node attributes from XML file
+  void ReadXMLAttributes( const char** atts) override;
+
+  /// Write this node's information to a MRML file in XML format.
+  void WriteXML(ostream& of, int indent) override;
+
+  /// Copy the node's attributes to this object
+  void Copy(vtkMRMLNode *node) override;
+
+  /// Get node XML tag name (like Storage, Model)
+  const char* GetNodeTagName() override {return "OMEZarrStorage";}
+
+  /// Return true if the node can be read in.
+  bool CanReadInReferenceNode(vtkMRMLNode* refNode) override;
+
+  /// Writing is not supported.
+  bool CanWriteFromReferenceNode(vtkMRMLNode* refNode) override;
+
+  /// Maximum number of voxels of the level read as the image data of the
+  /// volume node. The coarsest level is used if all the levels are larger.
+  /// Default is 32M voxels.
+  vtkSetClampMacro(OverviewMaximumNumberOfVoxels, int, 1, VTK_INT_MAX);
+  vtkGetMacro(OverviewMaximumNumberOfVoxels, int);
+
+  /// Read the tile \a tileIndex of \a level into \a tile, which is
+  /// allocated with the extent of the tile (voxel indices of the level).
+  /// Voxels of tiles without a chunk file are set to the fill value.
+  /// This method can be called from any thread.
+  /// Returns false if the tile cannot be read.
+  bool ReadTile(int level, const int tileIndex[3], vtkImageData* tile);
+
+protected:
+  vtkMRMLOMEZarrStorageNode();
+  ~vtkMRMLOMEZarrStorageNode() override;
+  vtkMRMLOMEZarrStorageNode(const vtkMRMLOMEZarrStorageNode&);
+  void operator=(const vtkMRMLOMEZarrStorageNode&);
+
+  /// Initialize all the supported read file types
+  void InitializeSupportedReadFileTypes() override;
+
+  /// Read the metadata, the levels and the overview
+  int ReadDataInternal(vtkMRMLNode *refNode) override;
+
+  int OverviewMaximumNumberOfVoxels{32 * 1024 * 1024};
+
+private:
+  class vtkInternal;
+  vtkInternal* Internal;
+};
+
+#endif
@@ -24,15 +24,140 @@ Version:   $Revision: 1.8 $
 
 // VTK includes
 #include <vtkCollection.h>
+#include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkStdString.h>
 
+// VTKSYS includes
+#include <vtksys/SystemTools.hxx>
+
 // STD includes
+#include <cstring>
+#include <fstream>
+#include <map>
 #include <sstream>
+#include <vector>
 
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkMRMLParser);
 
+namespace
+{
+  /// Signature and format version. Contains a null character, which cannot occur in XML files.
+  const char BINARY_SCENE_SIGNATURE[] = "MRMLBIN\0" "\x01\0\0\0";
+  const size_t BINARY_SCENE_SIGNATURE_SIZE = 12;
+
+  /// Record types
+  const char BINARY_STRING_DEFINITION = 'D';
+  const char BINARY_START_ELEMENT = 'S';
+  const char BINARY_END_ELEMENT = 'E';
+
+  //----------------------------------------------------------------------------
+  void AppendUInt32(std::string& buffer, size_t value)
+  {
+    for (int byteIndex = 0; byteIndex < 4; ++byteIndex)
+      {
+      buffer.push_back(static_cast<char>((value >> (8 * byteIndex)) & 0xFF));
+      }
+  }
+
+  //----------------------------------------------------------------------------
+  bool ReadUInt32(const char* data, size_t dataSize, size_t& position, size_t& value)
+  {
+    if (dataSize < 4 || position > dataSize - 4)
+      {
+      return false;
+      }
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data + position);
+    value = static_cast<size_t>(bytes[0]) | (static_cast<size_t>(bytes[1]) << 8)
+      | (static_cast<size_t>(bytes[2]) << 16) | (static_cast<size_t>(bytes[3]) << 24);
+    position += 4;
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  /// Read a null-terminated string of the specified length (including the terminating null)
+  bool ReadString(const char* data, size_t dataSize, size_t& position, const char*& value)
+  {
+    size_t length = 0;
+    if (!ReadUInt32(data, dataSize, position, length) || length == 0
+      || length > dataSize - position || data[position + length - 1] != '\0')
+      {
+      return false;
+      }
+    value = data + position;
+    position += length;
+    return true;
+  }
+}
+
+//------------------------------------------------------------------------------
+/// \brief Converts XML elements to MRML binary format records.
+class vtkMRMLBinarySceneEncoder : public vtkXMLParser
+{
+public:
+  static vtkMRMLBinarySceneEncoder *New();
+  vtkTypeMacro(vtkMRMLBinarySceneEncoder, vtkXMLParser);
+
+  std::string BinaryScene;
+
+protected:
+  vtkMRMLBinarySceneEncoder() = default;
+  ~vtkMRMLBinarySceneEncoder() override = default;
+
+  /// Returns index of the string in the string table, defines it if it is not in the table yet.
+  size_t GetStringIndex(const char* str)
+  {
+    auto stringIt = this->StringIndices.find(str);
+    if (stringIt != this->StringIndices.end())
+      {
+      return stringIt->second;
+      }
+    size_t length = strlen(str) + 1;
+    this->BinaryScene.push_back(BINARY_STRING_DEFINITION);
+    AppendUInt32(this->BinaryScene, length);
+    this->BinaryScene.append(str, length);
+    size_t stringIndex = this->StringIndices.size();
+    this->StringIndices[str] = stringIndex;
+    return stringIndex;
+  }
+
+  void StartElement(const char* name, const char** atts) override
+  {
+    // Names must be defined before the element record
+    size_t numberOfAttributes = 0;
+    for (const char** att = atts; *att != nullptr; att += 2)
+      {
+      this->GetStringIndex(att[0]);
+      ++numberOfAttributes;
+      }
+    size_t nameIndex = this->GetStringIndex(name);
+    this->BinaryScene.push_back(BINARY_START_ELEMENT);
+    AppendUInt32(this->BinaryScene, nameIndex);
+    AppendUInt32(this->BinaryScene, numberOfAttributes);
+    for (const char** att = atts; *att != nullptr; att += 2)
+      {
+      AppendUInt32(this->BinaryScene, this->GetStringIndex(att[0]));
+      size_t valueLength = strlen(att[1]) + 1;
+      AppendUInt32(this->BinaryScene, valueLength);
+      this->BinaryScene.append(att[1], valueLength);
+      }
+  }
+
+  void EndElement(const char* vtkNotUsed(name)) override
+  {
+    this->BinaryScene.push_back(BINARY_END_ELEMENT);
+  }
+
+private:
+  vtkMRMLBinarySceneEncoder(const vtkMRMLBinarySceneEncoder&) = delete;
+  void operator=(const vtkMRMLBinarySceneEncoder&) = delete;
+
+  std::map<std::string, size_t> StringIndices;
+};
+
+vtkStandardNewMacro(vtkMRMLBinarySceneEncoder);
+
 //------------------------------------------------------------------------------
 void vtkMRMLParser::StartElement(const char* tagName, const char** atts)
 {
@@ -249,3 +374,137 @@ void vtkMRMLParser::EndElement(const char *name)
 
   this->NodeStack.pop();
 }
+
+//-----------------------------------------------------------------------------
+const char* vtkMRMLParser::GetBinarySceneSignature()
+{
+  return BINARY_SCENE_SIGNATURE;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkMRMLParser::EncodeBinaryScene(const std::string& xmlScene, std::string& binaryScene)
+{
+  vtkNew<vtkMRMLBinarySceneEncoder> encoder;
+  encoder->BinaryScene.assign(BINARY_SCENE_SIGNATURE, BINARY_SCENE_SIGNATURE_SIZE);
+  if (!encoder->Parse(xmlScene.c_str(), static_cast<unsigned int>(xmlScene.size())))
+    {
+    return false;
+    }
+  binaryScene.swap(encoder->BinaryScene);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkMRMLParser::IsBinarySceneFile(const char* fileName)
+{
+  if (!fileName)
+    {
+    return false;
+    }
+  std::ifstream file(fileName, std::ios::in | std::ios::binary);
+  char signature[BINARY_SCENE_SIGNATURE_SIZE];
+  if (!file.read(signature, BINARY_SCENE_SIGNATURE_SIZE))
+    {
+    return false;
+    }
+  return memcmp(signature, BINARY_SCENE_SIGNATURE, BINARY_SCENE_SIGNATURE_SIZE) == 0;
+}
+
+//-----------------------------------------------------------------------------
+int vtkMRMLParser::ParseBinaryFile(const char* fileName)
+{
+  std::ifstream file(fileName ? fileName : "", std::ios::in | std::ios::binary);
+  if (!file)
+    {
+    vtkErrorMacro("ParseBinaryFile: cannot open file " << (fileName ? fileName : "(null)"));
+    return 0;
+    }
+  std::vector<char> data(vtksys::SystemTools::FileLength(fileName));
+  if (!data.empty() && !file.read(data.data(), data.size()))
+    {
+    vtkErrorMacro("ParseBinaryFile: cannot read file " << fileName);
+    return 0;
+    }
+  return this->ParseBinary(data.data(), data.size());
+}
+
+//-----------------------------------------------------------------------------
+int vtkMRMLParser::ParseBinary(const char* data, size_t dataSize)
+{
+  if (!data || dataSize < BINARY_SCENE_SIGNATURE_SIZE
+    || memcmp(data, BINARY_SCENE_SIGNATURE, BINARY_SCENE_SIGNATURE_SIZE) != 0)
+    {
+    vtkErrorMacro("ParseBinary: data is not in MRML binary format");
+    return 0;
+    }
+
+  // Strings and attribute values are null-terminated in the buffer, therefore
+  // they are passed to the nodes without copying.
+  std::vector<const char*> strings;
+  std::vector<const char*> atts;
+  std::stack<const char*> elementNames;
+  size_t position = BINARY_SCENE_SIGNATURE_SIZE;
+  while (position < dataSize)
+    {
+    char recordType = data[position++];
+    if (recordType == BINARY_STRING_DEFINITION)
+      {
+      const char* str = nullptr;
+      if (!ReadString(data, dataSize, position, str))
+        {
+        vtkErrorMacro("ParseBinary: invalid string definition at position " << position);
+        return 0;
+        }
+      strings.push_back(str);
+      }
+    else if (recordType == BINARY_START_ELEMENT)
+      {
+      size_t nameIndex = 0;
+      size_t numberOfAttributes = 0;
+      if (!ReadUInt32(data, dataSize, position, nameIndex) || nameIndex >= strings.size()
+        || !ReadUInt32(data, dataSize, position, numberOfAttributes))
+        {
+        vtkErrorMacro("ParseBinary: invalid element at position " << position);
+        return 0;
+        }
+      atts.clear();
+      for (size_t attIndex = 0; attIndex < numberOfAttributes; ++attIndex)
+        {
+        size_t attNameIndex = 0;
+        const char* attValue = nullptr;
+        if (!ReadUInt32(data, dataSize, position, attNameIndex) || attNameIndex >= strings.size()
+          || !ReadString(data, dataSize, position, attValue))
+          {
+          vtkErrorMacro("ParseBinary: invalid attribute at position " << position);
+          return 0;
+          }
+        atts.push_back(strings[attNameIndex]);
+        atts.push_back(attValue);
+        }
+      atts.push_back(nullptr);
+      elementNames.push(strings[nameIndex]);
+      this->StartElement(strings[nameIndex], atts.data());
+      }
+    else if (recordType == BINARY_END_ELEMENT)
+      {
+      if (elementNames.empty())
+        {
+        vtkErrorMacro("ParseBinary: unexpected element end at position " << position);
+        return 0;
+        }
+      this->EndElement(elementNames.top());
+      elementNames.pop();
+      }
+    else
+      {
+      vtkErrorMacro("ParseBinary: invalid record type at position " << position);
+      return 0;
+      }
+    }
+  if (!elementNames.empty())
+    {
+    vtkErrorMacro("ParseBinary: incomplete scene data");
+    return 0;
+    }
+  return 1;
+}
@@ -20,8 +20,13 @@ class vtkCollection;
 
 // STD includes
 #include <stack>
+#include <string>
 
 /// \brief Parse XML scene file.
+///
+/// Scenes in MRML binary format (see EncodeBinaryScene()) are parsed
+/// by ParseBinary() and ParseBinaryFile(), which create the nodes the same way
+/// as parsing the equivalent XML file does.
 class VTK_MRML_EXPORT vtkMRMLParser : public vtkXMLParser
 {
 public:
@@ -34,6 +39,29 @@ public:
   vtkCollection* GetNodeCollection() {return this->NodeCollection;};
   void SetNodeCollection(vtkCollection* scene) {this->NodeCollection = scene;};
 
+  /// Parse scene in MRML binary format from memory.
+  /// Returns 1 on success and 0 on failure, similarly to Parse().
+  int ParseBinary(const char* data, size_t dataSize);
+
+  /// Parse scene file in MRML binary format.
+  /// Returns 1 on success and 0 on failure, similarly to Parse().
+  int ParseBinaryFile(const char* fileName);
+
+  /// Returns true if the file starts with the MRML binary format signature.
+  static bool IsBinarySceneFile(const char* fileName);
+
+  /// \brief Convert XML scene to MRML binary format.
+  ///
+  /// The binary format stores the same elements and attributes as the XML document,
+  /// but element and attribute names are stored only once and attribute values are stored
+  /// as length-prefixed, unescaped strings. This allows reading the scene without XML parsing:
+  /// attribute values are passed to the nodes directly from the file buffer.
+  /// Returns false if the XML scene cannot be parsed.
+  static bool EncodeBinaryScene(const std::string& xmlScene, std::string& binaryScene);
+
+  /// Signature at the beginning of scene files in MRML binary format.
+  static const char* GetBinarySceneSignature();
+
 protected:
   vtkMRMLParser() = default;;
   ~vtkMRMLParser() override  = default;
@@ -137,11 +137,26 @@ void vtkMRMLProceduralColorNode::ProcessMRMLEvents ( vtkObject *caller,
 //-----------------------------------------------------------
 vtkLookupTable* vtkMRMLProceduralColorNode::GetLookupTable()
 {
+  vtkColorTransferFunction *ctf = this->GetColorTransferFunction();
+  if (!ctf)
+    {
+    return this->ConvertedCTFtoLUT;
+    }
+
+  // Reuse the previously converted table if neither the transfer function
+  // nor the requested number of entries changed since it was built
+  if (ctf == this->ConvertedCTFtoLUTSource
+    && ctf->GetMTime() <= this->ConvertedCTFtoLUTBuildTime.GetMTime()
+    && this->ConvertedCTFtoLUT->GetMTime() <= this->ConvertedCTFtoLUTBuildTime.GetMTime()
+    && this->ConvertedCTFtoLUT->GetNumberOfTableValues() == static_cast<vtkIdType>(this->NumberOfTableValues))
+    {
+    return this->ConvertedCTFtoLUT;
+    }
+
   this->ConvertedCTFtoLUT->SetNumberOfTableValues(0);
 
   // since setting the range is a no-op on color transfer functions,
   // copy into a color look up table with NumberOfTableValues entries
-  vtkColorTransferFunction *ctf = this->GetColorTransferFunction();
   double *ctfRange = ctf->GetRange();
   std::vector<double> bareTable(this->NumberOfTableValues*3);
   if (this->NumberOfTableValues > 0)
@@ -166,6 +181,8 @@ vtkLookupTable* vtkMRMLProceduralColorNode::GetLookupTable()
                                            bareTable[baseIndex + 2],
                                            1.0);
     }
+  this->ConvertedCTFtoLUTSource = ctf;
+  this->ConvertedCTFtoLUTBuildTime.Modified();
   return this->ConvertedCTFtoLUT;
 }
 
@@ -17,6 +17,9 @@
 
 #include "vtkMRMLColorNode.h"
 
+// VTK includes
+#include <vtkTimeStamp.h>
+
 class vtkColorTransferFunction;
 
 /// \brief MRML node to represent procedurally defined color information.
@@ -90,7 +93,11 @@ public:
 
   /// Reimplemented vtkMRMLColorNode::GetLookupTable() to convert
   /// the continuous color transfer function to a look up table
-  /// with a number of entries defined by NumberOfTableValues
+  /// with a number of entries defined by NumberOfTableValues.
+  /// The table is only rebuilt if the color transfer function or the
+  /// number of table values changed since the last call, so that the
+  /// returned table's modified time (and therefore the pipelines that
+  /// use it, such as slice view color mapping) is not bumped at each call.
   /// \sa ConvertedCTFtoLUT, SetNumberOfTableValues()
   vtkLookupTable * GetLookupTable() override;
 
@@ -138,6 +145,12 @@ protected:
   /// \sa GetLookupTable(), NumberOfTableValues
   vtkLookupTable *ConvertedCTFtoLUT;
 
+  /// Time when ConvertedCTFtoLUT was last filled from the color transfer function
+  /// \sa GetLookupTable()
+  vtkTimeStamp ConvertedCTFtoLUTBuildTime;
+  /// Color transfer function that ConvertedCTFtoLUT was filled from
+  vtkColorTransferFunction* ConvertedCTFtoLUTSource{nullptr};
+
   /// Number of entries to use when discretizing
   /// the color transfer function into a lookup table
   /// \sa GetNumberOfTableValues(), SetNumberOfTableValues(),
@@ -22,6 +22,8 @@ Version:   $Revision: 1.2 $
 // VTK includes
 #include <vtkAlgorithmOutput.h>
 #include <vtkCallbackCommand.h>
+#include <vtkDataArray.h>
+#include <vtkExtractVOI.h>
 #include <vtkColorTransferFunction.h>
 #include <vtkImageAppendComponents.h>
 #include <vtkImageCast.h>
@@ -34,11 +36,13 @@ Version:   $Revision: 1.2 $
 #include <vtkImageThreshold.h>
 #include <vtkObjectFactory.h>
 #include <vtkLookupTable.h>
+#include <vtkNew.h>
 #include <vtkPointData.h>
 #include <vtkVersion.h>
 
 
 // STD includes
+#include <algorithm>
 #include <cassert>
 
 //----------------------------------------------------------------------------
@@ -252,6 +256,11 @@ void vtkMRMLScalarVolumeDisplayNode::WriteXML(ostream& of, int nIndent)
   }
   {
   std::stringstream ss;
+  ss << this->AutoLevelsSampleCount;
+  of << " autoLevelsSampleCount=\"" << ss.str() << "\"";
+  }
+  {
+  std::stringstream ss;
   ss << this->ApplyThreshold;
   of << " applyThreshold=\"" << ss.str() << "\"";
   }
@@ -330,6 +339,12 @@ void vtkMRMLScalarVolumeDisplayNode::ReadXMLAttributes(const char** atts)
       ss << attValue;
       ss >> this->AutoWindowLevel;
       }
+    else if (!strcmp(attName, "autoLevelsSampleCount"))
+      {
+      std::stringstream ss;
+      ss << attValue;
+      ss >> this->AutoLevelsSampleCount;
+      }
     else if (!strcmp(attName, "applyThreshold"))
       {
       std::stringstream ss;
@@ -362,6 +377,7 @@ void vtkMRMLScalarVolumeDisplayNode::CopyContent(vtkMRMLNode* anode, bool deepCo
     return;
     }
 
+  this->SetAutoLevelsSampleCount(node->GetAutoLevelsSampleCount());
   this->SetAutoWindowLevel( node->GetAutoWindowLevel() );
   this->SetWindowLevel(node->GetWindow(), node->GetLevel());
   this->SetAutoThreshold( node->GetAutoThreshold() ); // don't want to run CalculateAutoLevel
@@ -382,6 +398,7 @@ void vtkMRMLScalarVolumeDisplayNode::PrintSelf(ostream& os, vtkIndent indent)
   Superclass::PrintSelf(os,indent);
 
   os << indent << "AutoWindowLevel:   " << this->AutoWindowLevel << "\n";
+  os << indent << "AutoLevelsSampleCount: " << this->AutoLevelsSampleCount << "\n";
   os << indent << "Window:            " << this->GetWindow() << "\n";
   os << indent << "Level:             " << this->GetLevel() << "\n";
   os << indent << "Window Level Presets:\n";
@@ -714,6 +731,12 @@ void vtkMRMLScalarVolumeDisplayNode::GetDisplayScalarRange(double range[2])
     }
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLScalarVolumeDisplayNode::ClearAutoLevelsCache()
+{
+  this->AutoLevelsCache.clear();
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLScalarVolumeDisplayNode::CalculateAutoLevels()
 {
@@ -769,9 +792,77 @@ void vtkMRMLScalarVolumeDisplayNode::CalculateAutoLevels()
     }
 
   this->IsInCalculateAutoLevels = true;
-  this->HistogramStatistics->SetInputData(imageDataScalar);
-  this->HistogramStatistics->Update();
-  double* intensityRange = this->HistogramStatistics->GetAutoRange();
+
+  // Sequence frames are typically shallow copied into the same image data,
+  // therefore the cache is keyed on the scalar array and not on the image.
+  vtkDataArray* scalars = imageDataScalar->GetPointData()->GetScalars();
+  double intensityRange[2] = { 0.0, 0.0 };
+  std::deque<AutoLevelsCacheEntry>::iterator cacheIt = this->AutoLevelsCache.begin();
+  for (; cacheIt != this->AutoLevelsCache.end(); ++cacheIt)
+    {
+    if (cacheIt->Scalars.GetPointer() == scalars
+      && cacheIt->ScalarsMTime == scalars->GetMTime()
+      && cacheIt->SampleCount == this->AutoLevelsSampleCount)
+      {
+      break;
+      }
+    }
+  if (cacheIt != this->AutoLevelsCache.end())
+    {
+    AutoLevelsCacheEntry entry = *cacheIt;
+    this->AutoLevelsCache.erase(cacheIt);
+    this->AutoLevelsCache.push_front(entry);
+    intensityRange[0] = entry.AutoRange[0];
+    intensityRange[1] = entry.AutoRange[1];
+    }
+  else
+    {
+    int* extent = imageDataScalar->GetExtent();
+    int dimensions[3] = { 0, 0, 0 };
+    imageDataScalar->GetDimensions(dimensions);
+    // Smallest stride that does not use more than AutoLevelsSampleCount voxels
+    int sampleRate = 1;
+    if (this->AutoLevelsSampleCount > 0)
+      {
+      while ((static_cast<vtkTypeInt64>((dimensions[0] + sampleRate - 1) / sampleRate)
+          * ((dimensions[1] + sampleRate - 1) / sampleRate)
+          * ((dimensions[2] + sampleRate - 1) / sampleRate)) > this->AutoLevelsSampleCount
+        && sampleRate < std::max(dimensions[0], std::max(dimensions[1], dimensions[2])))
+        {
+        ++sampleRate;
+        }
+      }
+    if (sampleRate > 1)
+      {
+      vtkNew<vtkExtractVOI> sampler;
+      sampler->SetInputData(imageDataScalar);
+      sampler->SetVOI(extent);
+      sampler->SetSampleRate(sampleRate, sampleRate, sampleRate);
+      sampler->Update();
+      this->HistogramStatistics->SetInputData(sampler->GetOutput());
+      }
+    else
+      {
+      this->HistogramStatistics->SetInputData(imageDataScalar);
+      }
+    this->HistogramStatistics->Update();
+    this->HistogramStatistics->GetAutoRange(intensityRange);
+    // Do not keep a reference to the image
+    this->HistogramStatistics->SetInputData(nullptr);
+
+    AutoLevelsCacheEntry entry;
+    entry.Scalars = scalars;
+    entry.ScalarsMTime = scalars->GetMTime();
+    entry.SampleCount = this->AutoLevelsSampleCount;
+    entry.AutoRange[0] = intensityRange[0];
+    entry.AutoRange[1] = intensityRange[1];
+    this->AutoLevelsCache.push_front(entry);
+    const size_t maximumNumberOfCacheEntries = 32;
+    while (this->AutoLevelsCache.size() > maximumNumberOfCacheEntries)
+      {
+      this->AutoLevelsCache.pop_back();
+      }
+    }
   vtkDebugMacro("CalculateScalarAutoLevels:"
                 << " lower: " << intensityRange[0] << " upper: " << intensityRange[1]);
 
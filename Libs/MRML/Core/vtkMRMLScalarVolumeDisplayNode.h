@@ -30,8 +30,11 @@ class vtkImageStencil;
 class vtkImageThreshold;
 class vtkImageExtractComponents;
 class vtkImageMathematics;
+class vtkDataArray;
+#include <vtkWeakPointer.h>
 
 // STD includes
+#include <deque>
 #include <vector>
 
 /// \brief MRML node for representing a volume display attributes.
@@ -87,6 +90,19 @@ class VTK_MRML_EXPORT vtkMRMLScalarVolumeDisplayNode : public vtkMRMLVolumeDispl
   vtkGetMacro(AutoWindowLevel, int);
   vtkSetMacro(AutoWindowLevel, int);
 
+  ///
+  /// Maximum number of voxels used to compute the histogram for automatic
+  /// window/level and threshold. Larger images are sampled with a regular
+  /// stride along each axis. 0 (default) means that all voxels are used.
+  vtkSetClampMacro(AutoLevelsSampleCount, int, 0, VTK_INT_MAX);
+  vtkGetMacro(AutoLevelsSampleCount, int);
+
+  ///
+  /// Remove the automatic window/level ranges computed for previous images.
+  /// Ranges are cached for the last few scalar arrays (e.g. the frames of a
+  /// sequence) and reused as long as the arrays are not modified.
+  void ClearAutoLevelsCache();
+
   ///
   /// The window value to use when autoWindowLevel is 'no'
   double GetWindow();
@@ -251,6 +267,20 @@ protected:
   /// Used internally in CalculateScalarAutoLevels and CalculateStatisticsAutoLevels
   vtkImageHistogramStatistics *HistogramStatistics;
   bool IsInCalculateAutoLevels;
+
+  int AutoLevelsSampleCount{0};
+
+  ///
+  /// Automatic window/level range computed for a scalar array.
+  struct AutoLevelsCacheEntry
+  {
+    vtkWeakPointer<vtkDataArray> Scalars;
+    vtkMTimeType ScalarsMTime{0};
+    int SampleCount{0};
+    double AutoRange[2]{0.0, 0.0};
+  };
+  /// Most recently used entries first
+  std::deque<AutoLevelsCacheEntry> AutoLevelsCache;
 };
 
 #endif
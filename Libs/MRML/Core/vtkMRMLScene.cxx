@@ -19,6 +19,7 @@ Version:   $Revision: 1.18 $
 #include "vtkCacheManager.h"
 #include "vtkDataIOManager.h"
 #include "vtkTagTable.h"
+#include "vtkTraceRecorder.h"
 
 #include "vtkMRMLBSplineTransformNode.h"
 #include "vtkMRMLCameraNode.h"
@@ -40,6 +41,8 @@ Version:   $Revision: 1.18 $
 #include "vtkMRMLModelHierarchyNode.h"
 #include "vtkMRMLModelNode.h"
 #include "vtkMRMLModelStorageNode.h"
+#include "vtkMRMLMultiResolutionVolumeNode.h"
+#include "vtkMRMLOMEZarrStorageNode.h"
 #include "vtkMRMLPlotChartNode.h"
 #include "vtkMRMLPlotSeriesNode.h"
 #include "vtkMRMLPlotViewNode.h"
@@ -59,6 +62,7 @@ Version:   $Revision: 1.18 $
 #include "vtkMRMLSliceDisplayNode.h"
 #include "vtkMRMLSliceNode.h"
 #include "vtkMRMLSnapshotClipNode.h"
+#include "vtkMRMLStorableNode.h"
 #include "vtkMRMLSubjectHierarchyNode.h"
 #include "vtkMRMLTableNode.h"
 #include "vtkMRMLTableStorageNode.h"
@@ -71,6 +75,7 @@ Version:   $Revision: 1.18 $
 #include "vtkMRMLVectorVolumeDisplayNode.h"
 #include "vtkMRMLViewNode.h"
 #include "vtkMRMLVolumeArchetypeStorageNode.h"
+#include "vtkMRMLVolumeNode.h"
 #include "vtkMRMLVolumeSequenceStorageNode.h"
 #include "vtkURIHandler.h"
 
@@ -87,9 +92,14 @@ Version:   $Revision: 1.18 $
 #include <vtkCallbackCommand.h>
 #include <vtkCollection.h>
 #include <vtkDebugLeaks.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPNGWriter.h>
+#include <vtkPointSet.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
+#include <vtkTable.h>
 
 // VTKSYS includes
 #include <vtksys/RegularExpression.hxx>
@@ -98,7 +108,14 @@ Version:   $Revision: 1.18 $
 
 // STD includes
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <mutex>
 #include <numeric>
+#include <thread>
 
 //#define MRMLSCENE_VERBOSE
 
@@ -111,15 +128,83 @@ vtkCxxSetObjectMacro(vtkMRMLScene, DataIOManager, vtkDataIOManager)
 vtkCxxSetObjectMacro(vtkMRMLScene, UserTagTable, vtkTagTable)
 vtkCxxSetObjectMacro(vtkMRMLScene, URIHandlerCollection, vtkCollection)
 
+//------------------------------------------------------------------------------
+/// Reads requested files in a background thread, so that they get into the
+/// operating system's file cache. The file content is discarded.
+class vtkMRMLScene::vtkFilePrefetcher
+{
+public:
+  ~vtkFilePrefetcher()
+    {
+      {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Stop = true;
+      this->FileNames.clear();
+      }
+    this->Condition.notify_all();
+    if (this->Thread.joinable())
+      {
+      this->Thread.join();
+      }
+    }
+
+  void AddFile(const std::string& fileName)
+    {
+      {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->FileNames.push_back(fileName);
+      if (!this->Thread.joinable())
+        {
+        this->Thread = std::thread(&vtkFilePrefetcher::Run, this);
+        }
+      }
+    this->Condition.notify_one();
+    }
+
+protected:
+  void Run()
+    {
+    std::vector<char> buffer(1024 * 1024);
+    while (true)
+      {
+      std::string fileName;
+        {
+        std::unique_lock<std::mutex> lock(this->Mutex);
+        this->Condition.wait(lock, [this] { return this->Stop || !this->FileNames.empty(); });
+        if (this->Stop)
+          {
+          return;
+          }
+        fileName = this->FileNames.front();
+        this->FileNames.pop_front();
+        }
+      std::ifstream file(fileName.c_str(), std::ios::binary);
+      while (file && !this->Stop)
+        {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+      }
+    }
+
+  std::thread Thread;
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::deque<std::string> FileNames;
+  std::atomic<bool> Stop{false};
+};
+
 //------------------------------------------------------------------------------
 vtkMRMLScene::vtkMRMLScene()
 {
   this->RandomGenerator.seed(std::random_device{}());
 
   this->NodeIDsMTime = 0;
+  this->NextNodeOrder = 0;
+  this->NodesByClassMTime = 0;
 
   this->Nodes = vtkCollection::New();
   this->MaximumNumberOfSavedUndoStates = 20;
+  this->MaximumUndoStackMemorySize = 0;
   this->UndoFlag = false;
 
   this->CacheManager = nullptr;
@@ -188,6 +273,8 @@ vtkMRMLScene::vtkMRMLScene()
   this->RegisterNodeClass( vtkSmartPointer< vtkMRMLLabelMapVolumeNode >::New() );
   this->RegisterNodeClass( vtkSmartPointer< vtkMRMLColorNode >::New() );
   this->RegisterNodeClass( vtkSmartPointer< vtkMRMLDiffusionWeightedVolumeNode >::New() );
+  this->RegisterNodeClass( vtkSmartPointer< vtkMRMLMultiResolutionVolumeNode >::New() );
+  this->RegisterNodeClass( vtkSmartPointer< vtkMRMLOMEZarrStorageNode >::New() );
 #ifdef MRML_USE_vtkTeem
   this->RegisterNodeClass( vtkSmartPointer< vtkMRMLDiffusionTensorVolumeNode >::New() );
   this->RegisterNodeClass( vtkSmartPointer< vtkMRMLDiffusionTensorVolumeDisplayNode >::New() );
@@ -238,6 +325,10 @@ vtkMRMLScene::vtkMRMLScene()
 //------------------------------------------------------------------------------
 vtkMRMLScene::~vtkMRMLScene()
 {
+  delete this->FilePrefetcher;
+  this->FilePrefetcher = nullptr;
+  this->CloseBundle(false);
+
   this->ClearUndoStack ( );
   this->ClearRedoStack ( );
 
@@ -256,6 +347,8 @@ vtkMRMLScene::~vtkMRMLScene()
     {
     this->RegisteredNodeClasses[n]->Delete();
     }
+  this->RegisteredNodeClassByTag.clear();
+  this->RegisteredNodeClassByClassName.clear();
 
   if ( this->CacheManager != nullptr )
     {
@@ -318,7 +411,11 @@ void vtkMRMLScene::Clear(int removeSingletons)
   this->StartState(vtkMRMLScene::CloseState);
 
   this->RemoveAllNodes(removeSingletons);
+  // Data of removed nodes will not be read from the open bundle.
+  // The bundle is not closed, as Connect() clears the scene after ReadFromMRB() opened the bundle.
+  this->OpenBundleStorageFileNames.clear();
   this->NodeReferences.clear();
+  this->ReferencedIDsByReferencingNode.clear();
   this->ReferencedIDChanges.clear();
   this->ResetNodes();
 
@@ -367,15 +464,28 @@ void vtkMRMLScene::RemoveAllNodes(bool removeSingletons)
       removeNodeIds.emplace_back(node->GetID());
       }
     }
+  // When the scene is closed, removed nodes are kept alive until all nodes are removed
+  // and then released in one pass. This prevents destructors of nodes from running
+  // while other nodes are being removed (and their references are being torn down).
+  std::vector< vtkSmartPointer<vtkMRMLNode> > removedNodes;
+  if (this->IsClosing())
+    {
+    removedNodes.reserve(removeNodeIds.size());
+    }
   for(std::deque< std::string >::iterator nodeIt=removeNodeIds.begin(); nodeIt!=removeNodeIds.end(); ++nodeIt)
     {
     vtkMRMLNode* node=this->GetNodeByID(*nodeIt);
     if (node)
       {
       // node is still in the scene
+      if (this->IsClosing())
+        {
+        removedNodes.emplace_back(node);
+        }
       this->RemoveNode(node);
       }
     }
+  removedNodes.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -459,13 +569,10 @@ vtkMRMLNode* vtkMRMLScene::CreateNodeByClass(const char* className)
     return nullptr;
     }
   vtkMRMLNode* node = nullptr;
-  for (unsigned int i=0; i<RegisteredNodeClasses.size(); i++)
+  auto registeredNodeClassIt = this->RegisteredNodeClassByClassName.find(className);
+  if (registeredNodeClassIt != this->RegisteredNodeClassByClassName.end())
     {
-    if (!strcmp(RegisteredNodeClasses[i]->GetClassName(), className))
-      {
-      node = RegisteredNodeClasses[i]->CreateNodeInstance();
-      break;
-      }
+    node = registeredNodeClassIt->second->CreateNodeInstance();
     }
   // non-registered nodes can have a registered factory
   if (node == nullptr)
@@ -556,9 +663,23 @@ void vtkMRMLScene::RegisterNodeClass(vtkMRMLNode* node, const char* tagName)
   node->Register(this);
   this->RegisteredNodeClasses.push_back(node);
   this->RegisteredNodeTags.push_back(xmlTag);
+  this->UpdateRegisteredNodeClassMaps();
   this->InvokeEvent(vtkMRMLScene::NodeClassRegisteredEvent);
 }
 
+//------------------------------------------------------------------------------
+void vtkMRMLScene::UpdateRegisteredNodeClassMaps()
+{
+  this->RegisteredNodeClassByTag.clear();
+  this->RegisteredNodeClassByClassName.clear();
+  for (unsigned int i = 0; i < this->RegisteredNodeClasses.size(); ++i)
+    {
+    // emplace does not overwrite existing items, therefore the first match is kept
+    this->RegisteredNodeClassByTag.emplace(this->RegisteredNodeTags[i], this->RegisteredNodeClasses[i]);
+    this->RegisteredNodeClassByClassName.emplace(this->RegisteredNodeClasses[i]->GetClassName(), this->RegisteredNodeClasses[i]);
+    }
+}
+
 //------------------------------------------------------------------------------
 void vtkMRMLScene::RegisterAbstractNodeClass(std::string className, std::string typeDisplayName)
 {
@@ -628,14 +749,12 @@ const char* vtkMRMLScene::GetClassNameByTag(const char *tagName)
     vtkErrorMacro("GetClassNameByTag: tagname is null");
     return nullptr;
     }
-  for (unsigned int i=0; i<RegisteredNodeTags.size(); i++)
+  auto registeredNodeClassIt = this->RegisteredNodeClassByTag.find(tagName);
+  if (registeredNodeClassIt == this->RegisteredNodeClassByTag.end())
     {
-    if (!strcmp(RegisteredNodeTags[i].c_str(), tagName))
-      {
-      return (RegisteredNodeClasses[i])->GetClassName();
-      }
+    return nullptr;
     }
-  return nullptr;
+  return registeredNodeClassIt->second->GetClassName();
 }
 
 //------------------------------------------------------------------------------
@@ -646,14 +765,12 @@ const char* vtkMRMLScene::GetTagByClassName(const char *className)
     vtkErrorMacro("GetTagByClassName: className is null");
     return nullptr;
     }
-  for (unsigned int i=0; i<this->RegisteredNodeClasses.size(); i++)
+  auto registeredNodeClassIt = this->RegisteredNodeClassByClassName.find(className);
+  if (registeredNodeClassIt == this->RegisteredNodeClassByClassName.end())
     {
-    if (!strcmp(this->RegisteredNodeClasses[i]->GetClassName(), className))
-      {
-      return (this->RegisteredNodeClasses[i])->GetNodeTagName();
-      }
+    return nullptr;
     }
-  return nullptr;
+  return registeredNodeClassIt->second->GetNodeTagName();
 }
 
 //------------------------------------------------------------------------------
@@ -730,6 +847,10 @@ void vtkMRMLScene::EndState(unsigned long state)
   this->States.pop_back();
 
   bool isInState = ((this->GetStates() & state) == state);
+  if (state == vtkMRMLScene::DeferredModifyState && !isInState)
+    {
+    this->InvokeDeferredModifiedEvents();
+    }
   // vtkMRMLScene::BatchProcessState is handled after
   if (state != vtkMRMLScene::BatchProcessState &&
       !isInState)
@@ -745,6 +866,57 @@ void vtkMRMLScene::EndState(unsigned long state)
     }
 }
 
+//------------------------------------------------------------------------------
+void vtkMRMLScene::AddDeferredModifiedNode(vtkMRMLNode* node)
+{
+  if (!node)
+    {
+    return;
+    }
+  this->DeferredModifiedNodes.push_back(node);
+}
+
+//------------------------------------------------------------------------------
+void vtkMRMLScene::InvokeDeferredModifiedEvents()
+{
+  // Nodes that are modified by observers while the events are invoked
+  // are not deferred anymore, so the list is not modified during the iteration.
+  std::vector< vtkWeakPointer<vtkMRMLNode> > deferredModifiedNodes;
+  deferredModifiedNodes.swap(this->DeferredModifiedNodes);
+  vtkNew<vtkCollection> modifiedNodes;
+  for (vtkMRMLNode* node : deferredModifiedNodes)
+    {
+    if (!node)
+      {
+      // node has been deleted since it was modified
+      continue;
+      }
+    node->ModifiedEventDeferred = false;
+    modifiedNodes->AddItem(node);
+    }
+  if (modifiedNodes->GetNumberOfItems() == 0)
+    {
+    return;
+    }
+
+  bool wasInvokingDeferredModifiedEvents = this->InvokingDeferredModifiedEvents;
+  this->InvokingDeferredModifiedEvents = true;
+  vtkMRMLNode* node = nullptr;
+  vtkCollectionSimpleIterator it;
+  for (modifiedNodes->InitTraversal(it); (node = vtkMRMLNode::SafeDownCast(modifiedNodes->GetNextItemAsObject(it))); )
+    {
+    // If the node is still in a StartModify() block then its events
+    // will be invoked by the matching EndModify().
+    if (!node->GetDisableModifiedEvent())
+      {
+      node->InvokePendingModifiedEvent();
+      }
+    }
+  this->InvokingDeferredModifiedEvents = wasInvokingDeferredModifiedEvents;
+
+  this->InvokeEvent(vtkMRMLScene::NodesModifiedEvent, modifiedNodes.GetPointer());
+}
+
 //------------------------------------------------------------------------------
 void vtkMRMLScene::ProgressState(unsigned long state, int progress)
 {
@@ -794,6 +966,7 @@ int vtkMRMLScene::Connect(vtkMRMLMessageCollection* userMessagesInput/*=nullptr*
 //------------------------------------------------------------------------------
 int vtkMRMLScene::Import(vtkMRMLMessageCollection* userMessagesInput/*=nullptr*/)
 {
+  vtkTraceScopeWithCategoryMacro("vtkMRMLScene::Import", "MRML");
   bool wasSceneModified = this->GetModifiedSinceRead();
 
   // We use userMessages for collecting error information, so make sure we have it, even if the caller does not need it.
@@ -867,6 +1040,16 @@ int vtkMRMLScene::Import(vtkMRMLMessageCollection* userMessagesInput/*=nullptr*/
 
     this->InvokeEvent(vtkMRMLScene::NewSceneEvent, nullptr);
 
+    // If data is read in parallel then storable nodes only record that their
+    // data has to be read when UpdateScene is called, and reading happens afterward.
+    bool readDataInParallel = this->ReadDataInParallel && this->ReadDataOnLoad && !this->ReadDataOnDemand;
+    bool prefetchDataOnDemand = this->PrefetchDataOnDemand;
+    if (readDataInParallel)
+      {
+      this->ReadDataOnDemand = true;
+      this->PrefetchDataOnDemand = false;
+      }
+
     // Notify the imported nodes about that all nodes are created
     // (so the observers can be attached to referenced nodes, etc.)
     // by calling UpdateScene on each node
@@ -893,6 +1076,13 @@ int vtkMRMLScene::Import(vtkMRMLMessageCollection* userMessagesInput/*=nullptr*/
         }
       }
 
+    if (readDataInParallel)
+      {
+      this->ReadDataOnDemand = false;
+      this->PrefetchDataOnDemand = prefetchDataOnDemand;
+      this->ReadPendingDataInParallel(addedNodes, userMessages);
+      }
+
     this->Modified();
     this->RemoveUnusedNodeReferences();
 #ifdef MRMLSCENE_VERBOSE
@@ -1017,8 +1207,15 @@ int vtkMRMLScene::LoadIntoScene(vtkCollection* nodeCollection, vtkMRMLMessageCol
     else
       {
       vtkDebugMacro("Parsing: " << this->URL.c_str());
-      parser->SetFileName(URL.c_str());
-      success = parser->Parse();
+      if (vtkMRMLParser::IsBinarySceneFile(this->URL.c_str()))
+        {
+        success = parser->ParseBinaryFile(this->URL.c_str());
+        }
+      else
+        {
+        parser->SetFileName(URL.c_str());
+        success = parser->Parse();
+        }
       }
 
     userMessages->SetObservedObject(nullptr);
@@ -1031,6 +1228,7 @@ int vtkMRMLScene::LoadIntoScene(vtkCollection* nodeCollection, vtkMRMLMessageCol
 //------------------------------------------------------------------------------
 int vtkMRMLScene::Commit(const char* url, vtkMRMLMessageCollection * userMessagesInput/*=nullptr*/)
 {
+  vtkTraceScopeWithCategoryMacro("vtkMRMLScene::Commit", "MRML");
   // We use userMessages for collecting error information, so make sure we have it, even if the caller does not need it.
   vtkSmartPointer<vtkMRMLMessageCollection> userMessages = userMessagesInput;
   if (!userMessages)
@@ -1058,13 +1256,19 @@ int vtkMRMLScene::Commit(const char* url, vtkMRMLMessageCollection * userMessage
 
   std::ostream *os = nullptr;
 
-  if (this->GetSaveToXMLString())
+  // Binary scene is converted from the XML scene after all nodes are written
+  bool writeBinaryScene = this->WriteSceneInBinaryFormat && !this->GetSaveToXMLString();
+
+  if (this->GetSaveToXMLString() || writeBinaryScene)
     {
     os = &oss;
     }
   else
     {
     os = &ofs;
+    }
+  if (!this->GetSaveToXMLString())
+    {
     // set the root directory from the URL
     this->RootDirectory = vtksys::SystemTools::GetParentDirectory(url);
 
@@ -1072,7 +1276,7 @@ int vtkMRMLScene::Commit(const char* url, vtkMRMLMessageCollection * userMessage
 #ifdef _WIN32
     ofs.open(url, std::ios::out | std::ios::binary);
 #else
-    ofs.open(url, std::ios::out);
+    ofs.open(url, writeBinaryScene ? (std::ios::out | std::ios::binary) : std::ios::out);
 #endif
     if (ofs.fail())
       {
@@ -1185,7 +1389,21 @@ int vtkMRMLScene::Commit(const char* url, vtkMRMLMessageCollection * userMessage
     }
   else
     {
+    if (writeBinaryScene)
+      {
+      std::string binaryScene;
+      if (!vtkMRMLParser::EncodeBinaryScene(oss.str(), binaryScene))
+        {
+        vtkErrorToMessageCollectionMacro(userMessages, "vtkMRMLScene::Commit",
+          "Scene writing failed: Could not convert scene to binary format");
+        }
+      ofs.write(binaryScene.data(), binaryScene.size());
+      }
     ofs.close();
+    if (ofs.fail())
+      {
+      vtkErrorToMessageCollectionMacro(userMessages, "vtkMRMLScene::Commit", "Scene writing failed: Could not write file " << url);
+      }
     }
 
   bool success = (userMessages->GetNumberOfMessagesOfType(vtkCommand::ErrorEvent) == 0);
@@ -1211,6 +1429,14 @@ inline bool IsNodeWithoutName(vtkMRMLNode* node)
   return node->GetName() == nullptr || node->GetName()[0] == '\0';
 }
 
+//------------------------------------------------------------------------------
+// Estimate memory size of a node (in kilobytes), including its bulk data.
+unsigned long EstimateNodeMemorySize(vtkMRMLNode* node)
+{
+  // node properties + bulk data
+  return 1 + node->GetDataMemorySize();
+}
+
 }
 
 //------------------------------------------------------------------------------
@@ -1298,10 +1524,12 @@ vtkMRMLNode* vtkMRMLScene::AddNodeNoNotify(vtkMRMLNode *n)
     n->SetName(this->GenerateUniqueName(n).c_str());
     }
   n->SetScene( this );
+  this->UpdateNodesByClass();
   this->Nodes->vtkCollection::AddItem((vtkObject *)n);
 
   // cache the node so the whole scene cache stays up-to date
   this->AddNodeID(n);
+  this->AddNodeToClassIndex(n);
 
   // Keep the SH up-to-date
   if (vtkMRMLSubjectHierarchyNode::SafeDownCast(n) != nullptr &&
@@ -1515,10 +1743,19 @@ void vtkMRMLScene::RemoveNode(vtkMRMLNode *n)
     {
     n->SetScene(nullptr);
     }
+  this->UpdateNodesByClass();
   this->Nodes->vtkCollection::RemoveItem((vtkObject *)n);
 
   std::string nid = (n->GetID() ? n->GetID() : "");
   this->RemoveNodeID(n->GetID());
+  this->RemoveNodeFromClassIndex(n);
+  if (n->GetUndoEnabled())
+    {
+    // The undo stack may store this node itself (not a copy). References of the node
+    // are no longer counted as scene references, so they must be taken into account
+    // when checking what IDs are reserved by undo.
+    this->UndoStackReferenceIDsValid = false;
+    }
 
   this->InvokeEvent(vtkMRMLScene::NodeRemovedEvent, n);
 
@@ -1554,7 +1791,13 @@ void vtkMRMLScene::RemoveNode(vtkMRMLNode *n)
   n->UnRegister(this);
   n=nullptr;
 
-  this->Modified();
+  // When the scene is closed, Clear() calls Modified() once after all nodes are removed.
+  // Invoking ModifiedEvent for each removed node would make all scene observers update
+  // as many times as there are nodes in the scene.
+  if (!this->IsClosing())
+    {
+    this->Modified();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -1577,6 +1820,15 @@ void vtkMRMLScene::RemoveReferencedNodeID(const char *id, vtkMRMLNode *referenci
     return;
     }
   referenceIt->second.erase(referencingNode->GetID());
+  NodeReferencesType::iterator referencedIDsIt = this->ReferencedIDsByReferencingNode.find(referencingNode->GetID());
+  if (referencedIDsIt != this->ReferencedIDsByReferencingNode.end())
+    {
+    referencedIDsIt->second.erase(id);
+    if (referencedIDsIt->second.empty())
+      {
+      this->ReferencedIDsByReferencingNode.erase(referencedIDsIt);
+      }
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -1594,18 +1846,23 @@ void vtkMRMLScene::RemoveNodeReferences(vtkMRMLNode *n)
     }
   std::string nid=n->GetID();
 
-  NodeReferencesType::value_type::second_type::iterator referringNodesIt;
-  for (NodeReferencesType::iterator referenceIt = this->NodeReferences.begin();
-    referenceIt != this->NodeReferences.end();
-    ++referenceIt)
+  // Only visit the IDs that this node refers to, instead of all the references in the scene
+  NodeReferencesType::iterator referencedIDsIt = this->ReferencedIDsByReferencingNode.find(nid);
+  if (referencedIDsIt == this->ReferencedIDsByReferencingNode.end())
+    {
+    // this node does not refer to any nodes
+    return;
+    }
+  for (const std::string& referencedID : referencedIDsIt->second)
     {
-    referringNodesIt=referenceIt->second.find(nid);
-    if (referringNodesIt!=referenceIt->second.end())
+    NodeReferencesType::iterator referenceIt = this->NodeReferences.find(referencedID);
+    if (referenceIt != this->NodeReferences.end())
       {
       // observation has been deleted, so remove it from the index
-      referenceIt->second.erase(referringNodesIt);
+      referenceIt->second.erase(nid);
       }
     }
+  this->ReferencedIDsByReferencingNode.erase(referencedIDsIt);
 }
 
 //------------------------------------------------------------------------------
@@ -1652,6 +1909,21 @@ void vtkMRMLScene::RemoveUnusedNodeReferences()
     // go to next referenced ID
     ++referenceIt;
     }
+
+  this->UpdateReferencedIDsByReferencingNode();
+}
+
+//------------------------------------------------------------------------------
+void vtkMRMLScene::UpdateReferencedIDsByReferencingNode()
+{
+  this->ReferencedIDsByReferencingNode.clear();
+  for (const NodeReferencesType::value_type& reference : this->NodeReferences)
+    {
+    for (const std::string& referencingNodeID : reference.second)
+      {
+      this->ReferencedIDsByReferencingNode[referencingNodeID].insert(reference.first);
+      }
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -1662,7 +1934,25 @@ void vtkMRMLScene::RemoveReferencesToNode(vtkMRMLNode *n)
     vtkErrorMacro("RemoveReferencesToNode: node is null or has null id, can't remove refs");
     return;
     }
-  this->NodeReferences.erase(n->GetID());
+  NodeReferencesType::iterator referenceIt = this->NodeReferences.find(n->GetID());
+  if (referenceIt == this->NodeReferences.end())
+    {
+    // no references to this node
+    return;
+    }
+  for (const std::string& referencingNodeID : referenceIt->second)
+    {
+    NodeReferencesType::iterator referencedIDsIt = this->ReferencedIDsByReferencingNode.find(referencingNodeID);
+    if (referencedIDsIt != this->ReferencedIDsByReferencingNode.end())
+      {
+      referencedIDsIt->second.erase(referenceIt->first);
+      if (referencedIDsIt->second.empty())
+        {
+        this->ReferencedIDsByReferencingNode.erase(referencedIDsIt);
+        }
+      }
+    }
+  this->NodeReferences.erase(referenceIt);
 }
 
 //------------------------------------------------------------------------------
@@ -1699,18 +1989,7 @@ int vtkMRMLScene::GetNumberOfNodesByClass(const char *className)
     vtkErrorMacro("GetNumberOfNodesByClass: class name is null.");
     return 0;
     }
-  int num=0;
-  vtkMRMLNode *node;
-  vtkCollectionSimpleIterator it;
-  for (this->Nodes->InitTraversal(it);
-       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
-    {
-    if (node->IsA(className))
-      {
-      num++;
-      }
-    }
-  return num;
+  return static_cast<int>(this->GetIndexedNodesByClass(className).size());
 }
 
 //------------------------------------------------------------------------------
@@ -1722,15 +2001,11 @@ int vtkMRMLScene::GetNodesByClass(const char *className, std::vector<vtkMRMLNode
     vtkErrorMacro("GetNodesByClass: class name is null.");
     return 0;
     }
-  vtkMRMLNode *node;
-  vtkCollectionSimpleIterator it;
-  for (this->Nodes->InitTraversal(it);
-       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
+  const std::map<vtkIdType, vtkMRMLNode*>& classNodes = this->GetIndexedNodesByClass(className);
+  nodes.reserve(classNodes.size());
+  for (const auto& classNode : classNodes)
     {
-    if (node->IsA(className))
-      {
-      nodes.push_back(node);
-      }
+    nodes.push_back(classNode.second);
     }
   return static_cast<int>(nodes.size());
 }
@@ -1744,15 +2019,9 @@ vtkCollection* vtkMRMLScene::GetNodesByClass(const char *className)
     return nullptr;
     }
   vtkCollection* nodes = vtkCollection::New();
-  vtkMRMLNode *node;
-  vtkCollectionSimpleIterator it;
-  for (this->Nodes->InitTraversal(it);
-       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
+  for (const auto& classNode : this->GetIndexedNodesByClass(className))
     {
-    if (node->IsA(className))
-      {
-      nodes->AddItem(node);
-      }
+    nodes->AddItem(classNode.second);
     }
   return nodes;
 }
@@ -1813,13 +2082,10 @@ vtkMRMLNode* vtkMRMLScene::GetSingletonNode(const char* singletonTag, const char
     return nullptr;
     }
 
-  vtkCollectionSimpleIterator it;
-  vtkMRMLNode* node = nullptr;
-  for (this->Nodes->InitTraversal(it);
-       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
+  for (const auto& classNode : this->GetIndexedNodesByClass(className))
     {
-    if (node->IsA(className) &&
-        node->GetSingletonTag() != nullptr &&
+    vtkMRMLNode* node = classNode.second;
+    if (node->GetSingletonTag() != nullptr &&
         strcmp(node->GetSingletonTag(), singletonTag) == 0)
       {
       return node;
@@ -1889,22 +2155,12 @@ vtkMRMLNode* vtkMRMLScene::GetNthNodeByClass(int n, const char *className)
     return nullptr;
     }
 
-  int num=0;
-  vtkMRMLNode *node;
-  vtkCollectionSimpleIterator it;
-  for (this->Nodes->InitTraversal(it);
-       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
+  const std::map<vtkIdType, vtkMRMLNode*>& classNodes = this->GetIndexedNodesByClass(className);
+  if (n >= static_cast<int>(classNodes.size()))
     {
-    if (node->IsA(className))
-      {
-      if (num == n)
-        {
-        return node;
-        }
-      num++;
-      }
+    return nullptr;
     }
-  return nullptr;
+  return std::next(classNodes.begin(), n)->second;
 }
 
 //------------------------------------------------------------------------------
@@ -1924,50 +2180,110 @@ vtkCollection* vtkMRMLScene::GetNodesByName(const char* name)
     return nodes;
     }
 
-  vtkMRMLNode *node;
-  vtkCollectionSimpleIterator it;
-  for (this->Nodes->InitTraversal(it);
-       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
+  const std::map<vtkIdType, vtkMRMLNode*>* nameNodes = this->GetIndexedNodesByName(name);
+  if (nameNodes)
     {
-    if (node->GetName() != nullptr && !strcmp(node->GetName(), name))
+    for (const auto& nameNode : *nameNodes)
       {
-      nodes->AddItem(node);
+      nodes->AddItem(nameNode.second);
       }
     }
   return nodes;
 }
 
+//------------------------------------------------------------------------------
+vtkCollection* vtkMRMLScene::GetNodesByNamePrefix(const char* namePrefix)
+{
+  vtkCollection* nodes = vtkCollection::New();
+
+  if (!namePrefix)
+    {
+    vtkErrorMacro("GetNodesByNamePrefix: name prefix is null");
+    return nodes;
+    }
+
+  this->UpdateNodesByClass();
+  // Names are sorted, so all the names that start with the prefix are contiguous
+  std::string prefix(namePrefix);
+  std::map<vtkIdType, vtkMRMLNode*> prefixNodes;
+  for (auto nameNodesIt = this->NodesByName.lower_bound(prefix);
+       nameNodesIt != this->NodesByName.end() && nameNodesIt->first.compare(0, prefix.size(), prefix) == 0;
+       ++nameNodesIt)
+    {
+    prefixNodes.insert(nameNodesIt->second.begin(), nameNodesIt->second.end());
+    }
+  for (const auto& prefixNode : prefixNodes)
+    {
+    nodes->AddItem(prefixNode.second);
+    }
+  return nodes;
+}
+
 //-----------------------------------------------------------------------------
 vtkMRMLNode* vtkMRMLScene::GetFirstNode(const char* byName,
                                         const char* byClass,
                                         const int* byHideFromEditors,
                                         bool exactNameMatch)
 {
-  vtkCollectionSimpleIterator it;
-  vtkMRMLNode* node;
-  for (this->Nodes->InitTraversal(it);
-       (node= vtkMRMLNode::SafeDownCast(
-          this->Nodes->GetNextItemAsObject(it))) ;)
+  auto isMatching = [&](vtkMRMLNode* node)
     {
     if (exactNameMatch && byName &&
         node->GetName() != nullptr && strcmp(node->GetName(), byName) != 0)
       {
-      continue;
+      return false;
       }
     if (!exactNameMatch && byName &&
         node->GetName() != nullptr && !vtksys::RegularExpression(byName).find(node->GetName()))
       {
-      continue;
+      return false;
       }
-    if (byClass && !node->IsA(byClass))
+    if (byHideFromEditors && node->GetHideFromEditors() != *byHideFromEditors)
       {
-      continue;
+      return false;
       }
-    if (byHideFromEditors && node->GetHideFromEditors() != *byHideFromEditors)
+    return true;
+    };
+
+  if (exactNameMatch && byName)
+    {
+    // Only visit nodes that have the requested name
+    const std::map<vtkIdType, vtkMRMLNode*>* nameNodes = this->GetIndexedNodesByName(byName);
+    if (nameNodes)
       {
-      continue;
+      for (const auto& nameNode : *nameNodes)
+        {
+        if ((!byClass || nameNode.second->IsA(byClass)) && isMatching(nameNode.second))
+          {
+          return nameNode.second;
+          }
+        }
+      }
+    return nullptr;
+    }
+
+  if (byClass)
+    {
+    // Only visit nodes of the requested class
+    for (const auto& classNode : this->GetIndexedNodesByClass(byClass))
+      {
+      if (isMatching(classNode.second))
+        {
+        return classNode.second;
+        }
+      }
+    return nullptr;
+    }
+
+  vtkCollectionSimpleIterator it;
+  vtkMRMLNode* node;
+  for (this->Nodes->InitTraversal(it);
+       (node= vtkMRMLNode::SafeDownCast(
+          this->Nodes->GetNextItemAsObject(it))) ;)
+    {
+    if (isMatching(node))
+      {
+      return node;
       }
-    return node;
     }
   return nullptr;
 }
@@ -1982,16 +2298,12 @@ vtkMRMLNode* vtkMRMLScene::GetFirstNodeByName(const char* name)
     return node;
     }
 
-  vtkCollectionSimpleIterator it;
-  for (this->Nodes->InitTraversal(it);
-       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
+  const std::map<vtkIdType, vtkMRMLNode*>* nameNodes = this->GetIndexedNodesByName(name);
+  if (nameNodes && !nameNodes->empty())
     {
-    if (node->GetName() != nullptr && !strcmp(node->GetName(), name))
-      {
-      return node;
-      }
+    node = nameNodes->begin()->second;
     }
-  return nullptr;
+  return node;
 }
 
 //------------------------------------------------------------------------------
@@ -2051,13 +2363,15 @@ vtkCollection* vtkMRMLScene::GetNodesByClassByName(const char* className, const
     return nodes;
     }
 
-  vtkMRMLNode *node;
-  for (int n=0; n < this->Nodes->GetNumberOfItems(); n++)
+  const std::map<vtkIdType, vtkMRMLNode*>* nameNodes = this->GetIndexedNodesByName(name);
+  if (nameNodes)
     {
-    node = (vtkMRMLNode*)this->Nodes->GetItemAsObject(n);
-    if (node->GetName() != nullptr && !strcmp(node->GetName(), name) && node->IsA(className))
+    for (const auto& nameNode : *nameNodes)
       {
-      nodes->AddItem(node);
+      if (nameNode.second->IsA(className))
+        {
+        nodes->AddItem(nameNode.second);
+        }
       }
     }
 
@@ -2150,6 +2464,8 @@ vtkMRMLNode* vtkMRMLScene::InsertAfterNode(vtkMRMLNode *item, vtkMRMLNode *n)
     }
   // cache the node so the whole scene cache stays up-to-date
   this->AddNodeID(n);
+  // node order changed, the class index will be rebuilt at the next query
+  this->ClearNodesByClass();
 
   n->SetDisableModifiedEvent(modifyStatus);
 
@@ -2248,6 +2564,8 @@ vtkMRMLNode* vtkMRMLScene::InsertBeforeNode(vtkMRMLNode *item, vtkMRMLNode *n)
     }
   // cache the node so the whole scene cache stays up-todate
   this->AddNodeID(n);
+  // node order changed, the class index will be rebuilt at the next query
+  this->ClearNodesByClass();
 
   n->SetDisableModifiedEvent(modifyStatus);
 
@@ -2259,12 +2577,156 @@ vtkMRMLNode* vtkMRMLScene::InsertBeforeNode(vtkMRMLNode *item, vtkMRMLNode *n)
 }
 
 //------------------------------------------------------------------------------
-void vtkMRMLScene::PrintSelf(ostream& os, vtkIndent indent)
+bool vtkMRMLScene::ReadPendingData()
 {
-  this->Superclass::PrintSelf(os,indent);
-
-  os << indent << "Version = " << (this->GetVersion() ? this->GetVersion() : "NULL") << "\n";
-  os << indent << "Extensions = " << (this->GetExtensions() ? this->GetExtensions() : "NULL") << "\n";
+  // Collect nodes first, as reading data may add nodes to the scene
+  std::vector< vtkSmartPointer<vtkMRMLStorableNode> > pendingNodes;
+  vtkMRMLNode *node = nullptr;
+  vtkCollectionSimpleIterator it;
+  for (this->Nodes->InitTraversal(it);
+    (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it));)
+    {
+    vtkMRMLStorableNode* storableNode = vtkMRMLStorableNode::SafeDownCast(node);
+    if (storableNode && storableNode->GetDataReadPending())
+      {
+      pendingNodes.emplace_back(storableNode);
+      }
+    }
+  bool success = true;
+  for (vtkMRMLStorableNode* storableNode : pendingNodes)
+    {
+    if (!storableNode->ReadPendingData())
+      {
+      success = false;
+      }
+    }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+void vtkMRMLScene::ReadPendingDataInParallel(vtkCollection* nodes, vtkMRMLMessageCollection* userMessages)
+{
+  struct ReadJob
+    {
+    vtkSmartPointer<vtkMRMLStorableNode> Node;
+    vtkSmartPointer<vtkMRMLStorageNode> StorageNode;
+    vtkSmartPointer<vtkMRMLStorableNode> NodeCopy;
+    vtkSmartPointer<vtkMRMLStorageNode> StorageNodeCopy;
+    bool Success{false};
+    };
+  std::vector<ReadJob> parallelJobs;
+  std::vector< vtkSmartPointer<vtkMRMLStorableNode> > sequentialNodes;
+
+  vtkMRMLNode *node = nullptr;
+  vtkCollectionSimpleIterator it;
+  for (nodes->InitTraversal(it);
+    (node = (vtkMRMLNode*)nodes->GetNextItemAsObject(it));)
+    {
+    vtkMRMLStorableNode* storableNode = vtkMRMLStorableNode::SafeDownCast(node);
+    if (!storableNode || !storableNode->GetDataReadPending())
+      {
+      continue;
+      }
+    vtkMRMLStorageNode* storageNode = storableNode->GetStorageNode();
+    if (storableNode->GetNumberOfStorageNodes() != 1 || !storageNode
+      || !storageNode->CanReadInBackgroundThread() || !storableNode->HasCopyContent()
+      || storageNode->GetURI() != nullptr || storageNode->GetFileName() == nullptr
+      || !this->OpenBundleFileName.empty())
+      {
+      // files of a bundle opened for on-demand reading are extracted on the main thread
+      sequentialNodes.emplace_back(storableNode);
+      continue;
+      }
+
+    // Create copies of the nodes that are not in the scene, so that reading
+    // into them does not invoke any events in the scene.
+    ReadJob job;
+    job.Node = storableNode;
+    job.StorageNode = storageNode;
+    job.NodeCopy = vtkSmartPointer<vtkMRMLStorableNode>::Take(
+      vtkMRMLStorableNode::SafeDownCast(storableNode->CreateNodeInstance()));
+    job.StorageNodeCopy = vtkSmartPointer<vtkMRMLStorageNode>::Take(
+      vtkMRMLStorageNode::SafeDownCast(storageNode->CreateNodeInstance()));
+    if (!job.NodeCopy || !job.StorageNodeCopy)
+      {
+      sequentialNodes.emplace_back(storableNode);
+      continue;
+      }
+    // Clear the pending flag while copying, to prevent reading the data
+    storableNode->SetDataReadPending(false);
+    job.NodeCopy->CopyContent(storableNode, false);
+    storableNode->SetDataReadPending(true);
+    job.NodeCopy->SetName(storableNode->GetName());
+    job.StorageNodeCopy->Copy(storageNode);
+    job.StorageNodeCopy->GetUserMessages()->ClearMessages();
+    // The copy is not in the scene, therefore file names must be absolute paths
+    job.StorageNodeCopy->SetFileName(storageNode->GetFullNameFromFileName().c_str());
+    job.StorageNodeCopy->ResetFileNameList();
+    for (int fileIndex = 0; fileIndex < storageNode->GetNumberOfFileNames(); fileIndex++)
+      {
+      job.StorageNodeCopy->AddFileName(storageNode->GetFullNameFromNthFileName(fileIndex).c_str());
+      }
+    parallelJobs.push_back(job);
+    }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(parallelJobs.size()), 1,
+    [&](vtkIdType jobBegin, vtkIdType jobEnd)
+    {
+    for (vtkIdType jobIndex = jobBegin; jobIndex < jobEnd; ++jobIndex)
+      {
+      ReadJob& job = parallelJobs[jobIndex];
+      job.Success = (job.StorageNodeCopy->ReadData(job.NodeCopy) != 0);
+      }
+    });
+
+  // Apply the results in the main thread
+  for (ReadJob& job : parallelJobs)
+    {
+    if (!job.Success)
+      {
+      // Read again sequentially to report errors the same way as when data is not read in parallel
+      sequentialNodes.push_back(job.Node);
+      continue;
+      }
+    job.Node->SetDataReadPending(false);
+    job.Node->CopyContent(job.NodeCopy, false);
+    job.StorageNode->UpdateFromReadDataCopy(job.StorageNodeCopy, job.Node);
+    }
+
+  for (vtkMRMLStorableNode* storableNode : sequentialNodes)
+    {
+    userMessages->SetObservedObject(storableNode);
+    storableNode->ReadPendingData();
+    userMessages->SetObservedObject(nullptr);
+    }
+}
+
+//------------------------------------------------------------------------------
+void vtkMRMLScene::PrefetchFile(const std::string& fileName)
+{
+  if (!this->PrefetchDataOnDemand || fileName.empty())
+    {
+    return;
+    }
+  if (!this->FilePrefetcher)
+    {
+    this->FilePrefetcher = new vtkFilePrefetcher;
+    }
+  this->FilePrefetcher->AddFile(fileName);
+}
+
+//------------------------------------------------------------------------------
+void vtkMRMLScene::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "ReadDataOnLoad = " << this->ReadDataOnLoad << "\n";
+  os << indent << "ReadDataOnDemand = " << (this->ReadDataOnDemand ? "true" : "false") << "\n";
+  os << indent << "PrefetchDataOnDemand = " << (this->PrefetchDataOnDemand ? "true" : "false") << "\n";
+  os << indent << "WriteSceneInBinaryFormat = " << (this->WriteSceneInBinaryFormat ? "true" : "false") << "\n";
+
+  os << indent << "Version = " << (this->GetVersion() ? this->GetVersion() : "NULL") << "\n";
+  os << indent << "Extensions = " << (this->GetExtensions() ? this->GetExtensions() : "NULL") << "\n";
   os << indent << "LastLoadedVersion = " << (this->GetLastLoadedVersion() ? this->GetLastLoadedVersion() : "NULL") << "\n";
   os << indent << "LastLoadedExtensions= " << (this->GetLastLoadedExtensions() ? this->GetLastLoadedExtensions() : "NULL") << "\n";
   os << indent << "URL = " << this->GetURL() << "\n";
@@ -2471,9 +2933,20 @@ bool vtkMRMLScene::IsNodeIDReservedByUndo(const std::string id) const
     return false;
     }
 
-  std::set<std::string> undoReferenceIDs;
-  this->GetNodeReferenceIDsFromUndoStack(undoReferenceIDs);
-  if (undoReferenceIDs.find(id) != undoReferenceIDs.end())
+  if (this->UndoStack.empty())
+    {
+    return false;
+    }
+
+  // Collecting the reference IDs requires visiting all the nodes in the undo stack,
+  // therefore it is only done when the undo stack changed. Nodes in the undo stack
+  // are never modified.
+  if (!this->UndoStackReferenceIDsValid)
+    {
+    this->GetNodeReferenceIDsFromUndoStack(this->UndoStackReferenceIDs);
+    this->UndoStackReferenceIDsValid = true;
+    }
+  if (this->UndoStackReferenceIDs.find(id) != this->UndoStackReferenceIDs.end())
     {
     return true;
     }
@@ -2773,6 +3246,7 @@ void vtkMRMLScene::PushIntoUndoStack()
     }
 
   this->UndoStack.push_back(newScene);
+  this->UndoStackReferenceIDsValid = false;
   this->TrimUndoStack();
 }
 
@@ -2814,10 +3288,33 @@ void vtkMRMLScene::CopyNodeInUndoStack(vtkMRMLNode *copyNode)
     return;
     }
 
-  vtkMRMLNode *snode = copyNode->CreateNodeInstance();
-  if (snode != nullptr)
+  // If the node has not changed since its state was last stored in the undo stack
+  // then reuse that state instead of creating a new copy.
+  vtkSmartPointer<vtkMRMLNode> snode;
+  vtkMTimeType contentMTime = copyNode->GetContentMTime();
+  std::string nodeID = copyNode->GetID() ? copyNode->GetID() : "";
+  std::map< std::string, UndoNodeStateType >::iterator nodeStateIt = this->UndoNodeStates.find(nodeID);
+  if (copyNode->CanShareUndoState()
+    && nodeStateIt != this->UndoNodeStates.end()
+    && nodeStateIt->second.Node.GetPointer() == copyNode
+    && nodeStateIt->second.State.GetPointer() != nullptr
+    && nodeStateIt->second.ContentMTime == contentMTime)
     {
+    snode = nodeStateIt->second.State;
+    }
+  else
+    {
+    snode = vtkSmartPointer<vtkMRMLNode>::Take(copyNode->CreateNodeInstance());
+    if (snode == nullptr)
+      {
+      vtkErrorMacro("CopyNodeInUndoStack: failed to create node instance of class " << copyNode->GetClassName());
+      return;
+      }
     snode->CopyWithScene(copyNode);
+    UndoNodeStateType& nodeState = this->UndoNodeStates[nodeID];
+    nodeState.Node = copyNode;
+    nodeState.State = snode;
+    nodeState.ContentMTime = contentMTime;
     }
 
   vtkCollection* undoScene = this->UndoStack.back();
@@ -2828,10 +3325,36 @@ void vtkMRMLScene::CopyNodeInUndoStack(vtkMRMLNode *copyNode)
     if (node == copyNode)
       {
       undoScene->ReplaceItem (n, snode);
+      this->UndoStackReferenceIDsValid = false;
       break;
       }
     }
-  snode->Delete();
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkMRMLNode> vtkMRMLScene::GetUndoNodeToAdd(vtkMRMLNode* undoNode)
+{
+  vtkSmartPointer<vtkMRMLNode> nodeToAdd = undoNode;
+  if (!undoNode || !undoNode->GetID())
+    {
+    return nodeToAdd;
+    }
+  std::map< std::string, UndoNodeStateType >::iterator nodeStateIt = this->UndoNodeStates.find(undoNode->GetID());
+  if (nodeStateIt == this->UndoNodeStates.end() || nodeStateIt->second.State.GetPointer() != undoNode)
+    {
+    // not a stored node state
+    return nodeToAdd;
+    }
+  // The node state becomes a node in the scene, it must not be reused anymore
+  this->UndoNodeStates.erase(nodeStateIt);
+  // The undo level that is being restored holds one reference. If other levels
+  // refer to the same state then add a copy, as the node will be modified in the scene.
+  if (undoNode->GetReferenceCount() > 1)
+    {
+    nodeToAdd = vtkSmartPointer<vtkMRMLNode>::Take(undoNode->CreateNodeInstance());
+    nodeToAdd->CopyWithScene(undoNode);
+    }
+  return nodeToAdd;
 }
 
 //------------------------------------------------------------------------------
@@ -2962,8 +3485,9 @@ void vtkMRMLScene::Undo()
 
   for (nn=0; nn<addNodes.size(); nn++)
     {
-    this->AddNode(addNodes[nn]);
-    addNodes[nn]->SetSceneReferences();
+    vtkSmartPointer<vtkMRMLNode> nodeToAdd = this->GetUndoNodeToAdd(addNodes[nn]);
+    this->AddNode(nodeToAdd);
+    nodeToAdd->SetSceneReferences();
     }
   for (nn=0; nn<removeNodes.size(); nn++)
     {
@@ -2985,6 +3509,7 @@ void vtkMRMLScene::Undo()
   if (!this->UndoStack.empty())
    {
    this->UndoStack.pop_back();
+   this->UndoStackReferenceIDsValid = false;
    }
   this->Modified();
 
@@ -3127,6 +3652,8 @@ void vtkMRMLScene::ClearUndoStack()
     (*iter)->Delete();
     }
   this->UndoStack.clear();
+  this->UndoStackReferenceIDsValid = false;
+  this->UndoNodeStates.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -3170,6 +3697,7 @@ void vtkMRMLScene::AddReferencedNodeID(const char *id, vtkMRMLNode *referencingN
     return;
     }
   this->NodeReferences[id].insert(referencingNode->GetID());
+  this->ReferencedIDsByReferencingNode[referencingNode->GetID()].insert(id);
 }
 
 //------------------------------------------------------------------------------
@@ -3301,15 +3829,13 @@ void vtkMRMLScene::AddReferencedNodes(vtkMRMLNode *node, vtkCollection *refNodes
 
   std::deque<vtkMRMLNode*> newFoundReferencedNodes;
 
-  for (NodeReferencesType::iterator referenceIt = this->NodeReferences.begin();
-    referenceIt != this->NodeReferences.end();
-    ++referenceIt)
+  NodeReferencesType::iterator referencedIDsIt = this->ReferencedIDsByReferencingNode.find(node->GetID());
+  if (referencedIDsIt != this->ReferencedIDsByReferencingNode.end())
     {
-    NodeReferencesType::value_type::second_type::iterator referringNodesIt = referenceIt->second.find(node->GetID());
-    if (referringNodesIt!=referenceIt->second.end())
+    for (const std::string& referencedID : referencedIDsIt->second)
       {
       // this ID is referenced by this node
-      vtkMRMLNode *referencedNode = this->GetNodeByID(referenceIt->first);
+      vtkMRMLNode *referencedNode = this->GetNodeByID(referencedID);
       if (referencedNode!=nullptr && !refNodes->IsItemPresent(referencedNode))
         {
         // this ID is not yet in the list of reference nodes, so add it
@@ -3384,6 +3910,7 @@ void vtkMRMLScene::CopyNodeReferences(vtkMRMLScene *scene)
 
   //assuming the nodes exist in this scene
   this->NodeReferences=scene->NodeReferences;
+  this->ReferencedIDsByReferencingNode=scene->ReferencedIDsByReferencingNode;
 }
 
 //------------------------------------------------------------------------------
@@ -3482,6 +4009,167 @@ void vtkMRMLScene::ClearNodeIDs()
   }
 }
 
+//-----------------------------------------------------------------------------
+void vtkMRMLScene::UpdateNodesByClass()
+{
+  if (this->NodesByClassMTime > 0 && this->Nodes->GetMTime() <= this->NodesByClassMTime)
+    {
+    // up-to-date
+    return;
+    }
+#ifdef MRMLSCENE_VERBOSE
+  std::cerr << "Recompute node class index..." << std::endl;
+#endif
+  this->ClearNodesByClass();
+  this->NodeOrder.reserve(this->Nodes->GetNumberOfItems());
+  vtkMRMLNode *node;
+  vtkCollectionSimpleIterator it;
+  for (this->Nodes->InitTraversal(it);
+       (node = (vtkMRMLNode*)this->Nodes->GetNextItemAsObject(it)) ;)
+    {
+    vtkIdType order = this->NextNodeOrder++;
+    this->NodeOrder[node] = order;
+    if (node->GetName())
+      {
+      this->NodesByName[node->GetName()][order] = node;
+      }
+    }
+  this->NodesByClassMTime = this->Nodes->GetMTime();
+}
+
+//-----------------------------------------------------------------------------
+const std::map<vtkIdType, vtkMRMLNode*>& vtkMRMLScene::GetIndexedNodesByClass(const char* className)
+{
+  this->UpdateNodesByClass();
+  auto classNodesIt = this->NodesByClass.find(className);
+  if (classNodesIt != this->NodesByClass.end())
+    {
+    return classNodesIt->second;
+    }
+  // First query of this class, collect matching nodes
+  std::map<vtkIdType, vtkMRMLNode*>& classNodes = this->NodesByClass[className];
+  for (const auto& nodeOrder : this->NodeOrder)
+    {
+    if (nodeOrder.first->IsA(className))
+      {
+      classNodes[nodeOrder.second] = nodeOrder.first;
+      }
+    }
+  return classNodes;
+}
+
+//-----------------------------------------------------------------------------
+void vtkMRMLScene::AddNodeToClassIndex(vtkMRMLNode *node)
+{
+  if (!node || this->NodesByClassMTime == 0)
+    {
+    // index is not valid, it will be rebuilt at the next query
+    return;
+    }
+  vtkIdType order = this->NextNodeOrder++;
+  this->NodeOrder[node] = order;
+  if (node->GetName())
+    {
+    this->NodesByName[node->GetName()][order] = node;
+    }
+  for (auto& classNodes : this->NodesByClass)
+    {
+    if (node->IsA(classNodes.first.c_str()))
+      {
+      classNodes.second[order] = node;
+      }
+    }
+  this->NodesByClassMTime = this->Nodes->GetMTime();
+}
+
+//-----------------------------------------------------------------------------
+void vtkMRMLScene::RemoveNodeFromClassIndex(vtkMRMLNode *node)
+{
+  if (!node || this->NodesByClassMTime == 0)
+    {
+    // index is not valid, it will be rebuilt at the next query
+    return;
+    }
+  auto nodeOrderIt = this->NodeOrder.find(node);
+  if (nodeOrderIt == this->NodeOrder.end())
+    {
+    this->ClearNodesByClass();
+    return;
+    }
+  for (auto& classNodes : this->NodesByClass)
+    {
+    classNodes.second.erase(nodeOrderIt->second);
+    }
+  if (node->GetName())
+    {
+    auto nameNodesIt = this->NodesByName.find(node->GetName());
+    if (nameNodesIt != this->NodesByName.end())
+      {
+      nameNodesIt->second.erase(nodeOrderIt->second);
+      if (nameNodesIt->second.empty())
+        {
+        this->NodesByName.erase(nameNodesIt);
+        }
+      }
+    }
+  this->NodeOrder.erase(nodeOrderIt);
+  this->NodesByClassMTime = this->Nodes->GetMTime();
+}
+
+//-----------------------------------------------------------------------------
+void vtkMRMLScene::ClearNodesByClass()
+{
+  this->NodesByClass.clear();
+  this->NodesByName.clear();
+  this->NodeOrder.clear();
+  this->NextNodeOrder = 0;
+  this->NodesByClassMTime = 0;
+}
+
+//-----------------------------------------------------------------------------
+const std::map<vtkIdType, vtkMRMLNode*>* vtkMRMLScene::GetIndexedNodesByName(const char* name)
+{
+  this->UpdateNodesByClass();
+  auto nameNodesIt = this->NodesByName.find(name);
+  if (nameNodesIt == this->NodesByName.end())
+    {
+    return nullptr;
+    }
+  return &(nameNodesIt->second);
+}
+
+//-----------------------------------------------------------------------------
+void vtkMRMLScene::NodeNameChanged(vtkMRMLNode* node, const char* oldName)
+{
+  if (!node || this->NodesByClassMTime == 0)
+    {
+    // index is not valid, it will be rebuilt at the next query
+    return;
+    }
+  auto nodeOrderIt = this->NodeOrder.find(node);
+  if (nodeOrderIt == this->NodeOrder.end())
+    {
+    // node is not in the scene yet (name is set while the node is being added)
+    return;
+    }
+  if (oldName)
+    {
+    auto nameNodesIt = this->NodesByName.find(oldName);
+    if (nameNodesIt != this->NodesByName.end())
+      {
+      nameNodesIt->second.erase(nodeOrderIt->second);
+      if (nameNodesIt->second.empty())
+        {
+        this->NodesByName.erase(nameNodesIt);
+        }
+      }
+    }
+  if (node->GetName())
+    {
+    this->NodesByName[node->GetName()][nodeOrderIt->second] = node;
+    }
+}
+
 //------------------------------------------------------------------------------
 void vtkMRMLScene::AddURIHandler(vtkURIHandler *handler)
 {
@@ -3842,12 +4530,87 @@ void vtkMRMLScene::SetMaximumNumberOfSavedUndoStates(int stackSize)
 //-----------------------------------------------------------------------------
 void vtkMRMLScene::TrimUndoStack()
 {
-  std::list<vtkSmartPointer<vtkCollection> > removedStacks;
-  while(static_cast<int>(this->UndoStack.size()) > this->MaximumNumberOfSavedUndoStates)
+  bool stackTrimmed = false;
+  while (!this->UndoStack.empty()
+    && (static_cast<int>(this->UndoStack.size()) > this->MaximumNumberOfSavedUndoStates
+      || (this->MaximumUndoStackMemorySize > 0 && this->UndoStack.size() > 1
+        && this->GetUndoStackMemorySize() > this->MaximumUndoStackMemorySize)))
     {
-    removedStacks.emplace_back(this->UndoStack.front());
+    vtkCollection* removedStack = this->UndoStack.front();
     this->UndoStack.pop_front();
+    this->UndoStackReferenceIDsValid = false;
+    removedStack->RemoveAllItems();
+    removedStack->Delete();
+    stackTrimmed = true;
+    }
+  if (stackTrimmed)
+    {
+    // Forget states that are not referenced by the undo stack anymore
+    for (std::map< std::string, UndoNodeStateType >::iterator nodeStateIt = this->UndoNodeStates.begin();
+      nodeStateIt != this->UndoNodeStates.end();)
+      {
+      if (nodeStateIt->second.State.GetPointer() == nullptr)
+        {
+        nodeStateIt = this->UndoNodeStates.erase(nodeStateIt);
+        }
+      else
+        {
+        ++nodeStateIt;
+        }
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkMRMLScene::SetMaximumUndoStackMemorySize(unsigned long memorySizeKB)
+{
+  if (memorySizeKB == this->MaximumUndoStackMemorySize)
+    {
+    return;
+    }
+  this->MaximumUndoStackMemorySize = memorySizeKB;
+  this->TrimUndoStack();
+  this->Modified();
+}
+
+//-----------------------------------------------------------------------------
+unsigned long vtkMRMLScene::GetUndoStackMemorySize()
+{
+  // Nodes that are in the scene are not counted, only the copies that are owned by the undo stack.
+  std::set<vtkMRMLNode*> nodeStates;
+  unsigned long memorySize = 0;
+  for (vtkCollection* undoScene : this->UndoStack)
+    {
+    vtkMRMLNode* node = nullptr;
+    vtkCollectionSimpleIterator it;
+    for (undoScene->InitTraversal(it); (node = vtkMRMLNode::SafeDownCast(undoScene->GetNextItemAsObject(it)));)
+      {
+      if (this->GetNodeByID(node->GetID()) == node || !nodeStates.insert(node).second)
+        {
+        // node in the scene or node state that is already counted
+        continue;
+        }
+      memorySize += EstimateNodeMemorySize(node);
+      }
     }
+  return memorySize;
+}
+
+//-----------------------------------------------------------------------------
+unsigned long vtkMRMLScene::GetNodesDataMemorySize(const char* className/*=nullptr*/)
+{
+  unsigned long memorySize = 0;
+  vtkMRMLNode* node = nullptr;
+  vtkCollectionSimpleIterator it;
+  for (this->Nodes->InitTraversal(it); (node = vtkMRMLNode::SafeDownCast(this->Nodes->GetNextItemAsObject(it)));)
+    {
+    if (className && !node->IsA(className))
+      {
+      continue;
+      }
+    memorySize += node->GetDataMemorySize();
+    }
+  return memorySize;
 }
 
 //----------------------------------------------------------------------------
@@ -3863,6 +4626,12 @@ bool vtkMRMLScene::WriteToMRB(const char* filename, vtkImageData* thumbnail/*=nu
   std::string mrbFileName = vtksys::SystemTools::GetFilenameName(mrbFilePath);
   std::string mrbBaseName = vtksys::SystemTools::GetFilenameWithoutLastExtension(mrbFilePath);
 
+  if (mrbFilePath == this->OpenBundleFileName)
+    {
+    // The bundle is overwritten, therefore all data must be read from it before
+    this->CloseBundle();
+    }
+
   std::string tempBaseDir;
   if (this->GetDataIOManager()
     && this->GetDataIOManager()->GetCacheManager()
@@ -3904,22 +4673,42 @@ bool vtkMRMLScene::WriteToMRB(const char* filename, vtkImageData* thumbnail/*=nu
     }
 
   //
-  // Now save the scene into the bundle directory and then make a zip (mrb) file
-  // in the user's selected file location
+  // Now save the scene into the bundle directory. Each data file is moved into the zip (mrb) file
+  // in the user's selected file location right after it is written, therefore the temporary directory
+  // never contains more than a few data files.
   //
+  vtkDebugMacro("Zipping to " << mrbFilePath);
+  vtkNew<vtkArchive> archive;
+  if (!archive->OpenZip(mrbFilePath.c_str()) || !archive->AddDirectory(mrbBaseName.c_str()))
+    {
+    vtkErrorToMessageCollectionMacro(userMessages, "vtkMRMLScene::WriteToMRB",
+      "Failed to save " << filename << ": Could not compress bundle");
+    vtksys::SystemTools::RemoveADirectory(tempDir);
+    return false;
+    }
+  this->StreamingArchive = archive;
+  this->StreamingArchiveBaseDirectory = tempDir;
   bool retval = this->SaveSceneToSlicerDataBundleDirectory(bundleDir.c_str(), thumbnail, userMessages);
+  // Add remaining files (scene file, screenshot)
+  bool zipSuccess = this->MoveFilesToStreamingArchive(bundleDir, nullptr, userMessages);
+  this->StreamingArchive = nullptr;
+  this->StreamingArchiveBaseDirectory.clear();
+  if (!archive->CloseZip())
+    {
+    zipSuccess = false;
+    }
   if (!retval)
     {
     vtkErrorToMessageCollectionMacro(userMessages, "vtkMRMLScene::WriteToMRB",
       "Failed to save " << filename << ": Failed to save scene to data bundle directory");
+    vtksys::SystemTools::RemoveADirectory(tempDir);
     return false;
     }
-
-  vtkDebugMacro("Zipping to " << mrbFilePath);
-  if (!vtkArchive::Zip(mrbFilePath.c_str(), bundleDir.c_str()))
+  if (!zipSuccess)
     {
     vtkErrorToMessageCollectionMacro(userMessages, "vtkMRMLScene::WriteToMRB",
       "Failed to save " << filename << ": Could not compress bundle");
+    vtksys::SystemTools::RemoveADirectory(tempDir);
     return false;
     }
 
@@ -3983,7 +4772,18 @@ bool vtkMRMLScene::ReadFromMRB(const char* fullName, bool clear/*=false*/, vtkMR
     return false;
     }
 
-  std::string mrmlFile = vtkMRMLScene::UnpackSlicerDataBundle(fullName, unpackDir.c_str());
+  // Only one bundle can be open for on-demand reading at a time.
+  // Pending data of the previous bundle is not needed if the scene is cleared.
+  this->CloseBundle(!clear);
+  // If data is read on demand then data files are extracted from the bundle only when they are read
+  bool readDataOnDemand = this->ReadDataOnDemand && this->ReadDataOnLoad;
+  std::string mrmlFile = vtkMRMLScene::UnpackSlicerDataBundle(fullName, unpackDir.c_str(), nullptr, !readDataOnDemand);
+  if (readDataOnDemand)
+    {
+    this->OpenBundleFileName = vtksys::SystemTools::GetRealPath(fullName);
+    this->OpenBundleDirectory = unpackDir;
+    vtkArchive::ListArchive(fullName, this->OpenBundleEntries);
+    }
   this->SetURL(mrmlFile.c_str());
   int success = false;
   if (clear)
@@ -3994,14 +4794,22 @@ bool vtkMRMLScene::ReadFromMRB(const char* fullName, bool clear/*=false*/, vtkMR
     {
     success = this->Import(userMessages);
     }
-  if (!vtksys::SystemTools::RemoveADirectory(unpackDir))
+  if (readDataOnDemand)
     {
-    vtkErrorToMessageCollectionMacro(userMessages, "vtkMRMLScene::ReadFromMRB",
-      "vtkMRMLScene::ReadFromMRB failed: cannot remove directory '" << unpackDir << "'");
-    return false;
+    vtkDebugMacro("Opened bundle for on-demand reading in " << unpackDir);
+    }
+  else
+    {
+    // Data of nodes that is read on demand must be read before the unpacked files are removed
+    this->ReadPendingData();
+    if (!vtksys::SystemTools::RemoveADirectory(unpackDir))
+      {
+      vtkErrorToMessageCollectionMacro(userMessages, "vtkMRMLScene::ReadFromMRB",
+        "vtkMRMLScene::ReadFromMRB failed: cannot remove directory '" << unpackDir << "'");
+      return false;
+      }
+    vtkDebugMacro("Loaded bundle from " << unpackDir);
     }
-
-  vtkDebugMacro("Loaded bundle from " << unpackDir);
 
   // since the unpack path has been deleted, reset the scene to where the data bundle is
   std::string mrbFilePath = vtksys::SystemTools::GetRealPath(fullName);
@@ -4028,6 +4836,25 @@ bool vtkMRMLScene::ReadFromMRB(const char* fullName, bool clear/*=false*/, vtkMR
       {
       continue;
       }
+    if (readDataOnDemand && storageNode->GetID())
+      {
+      // Save file names in the unpack directory, which are used when data of the node is read from the bundle
+      std::vector<std::string> bundleFileNames;
+      bool inBundle = false;
+      for (int i = -1; i < storageNode->GetNumberOfFileNames(); ++i)
+        {
+        const char* storageFileNamePtr = (i < 0 ? storageNode->GetFileName() : storageNode->GetNthFileName(i));
+        bundleFileNames.push_back(storageFileNamePtr ? storageFileNamePtr : "");
+        if (storageFileNamePtr && vtksys::SystemTools::StringStartsWith(storageFileNamePtr, unpackDir.c_str()))
+          {
+          inBundle = true;
+          }
+        }
+      if (inBundle)
+        {
+        this->OpenBundleStorageFileNames[storageNode->GetID()].BundleFileNames = bundleFileNames;
+        }
+      }
     for (int i = -1; i < storageNode->GetNumberOfFileNames(); ++i)
       {
       const char* storageFileNamePtr = nullptr;
@@ -4057,6 +4884,12 @@ bool vtkMRMLScene::ReadFromMRB(const char* fullName, bool clear/*=false*/, vtkMR
         storageNode->ResetNthFileName(i, storageFileName.c_str());
         }
       }
+    auto bundleStorageIt = storageNode->GetID()
+      ? this->OpenBundleStorageFileNames.find(storageNode->GetID()) : this->OpenBundleStorageFileNames.end();
+    if (bundleStorageIt != this->OpenBundleStorageFileNames.end())
+      {
+      bundleStorageIt->second.FileName = storageNode->GetFileName() ? storageNode->GetFileName() : "";
+      }
     }
 
   // and mark storable nodes as modified since read
@@ -4070,9 +4903,226 @@ bool vtkMRMLScene::ReadFromMRB(const char* fullName, bool clear/*=false*/, vtkMR
 }
 
 //----------------------------------------------------------------------------
-std::string vtkMRMLScene::UnpackSlicerDataBundle(const char* sdbFilePath, const char* temporaryDirectory, vtkMRMLMessageCollection* userMessages/*=nullptr*/)
+bool vtkMRMLScene::BeginReadBundleFiles(vtkMRMLStorageNode* storageNode)
+{
+  if (!storageNode || this->OpenBundleFileName.empty()
+    || this->OpenBundleReadStates.find(storageNode) != this->OpenBundleReadStates.end())
+    {
+    return false;
+    }
+
+  BundleReadState readState;
+  readState.FileNames.push_back(storageNode->GetFileName() ? storageNode->GetFileName() : "");
+  for (int i = 0; i < storageNode->GetNumberOfFileNames(); ++i)
+    {
+    readState.FileNames.push_back(storageNode->GetNthFileName(i) ? storageNode->GetNthFileName(i) : "");
+    }
+
+  // Find the files to read in the unpack directory
+  std::vector<std::string> bundleFileNames;
+  bool changeFileNames = false;
+  auto bundleFileNamesIt = this->FindOpenBundleStorageFileNames(storageNode);
+  if (bundleFileNamesIt != this->OpenBundleStorageFileNames.end())
+    {
+    // File names were changed to point to the bundle file location when the bundle was opened
+    bundleFileNames = bundleFileNamesIt->second.BundleFileNames;
+    changeFileNames = true;
+    }
+  else
+    {
+    // Data is read while the bundle is opened, file names still point to the unpack directory
+    if (storageNode->GetFileName())
+      {
+      bundleFileNames.push_back(storageNode->GetFullNameFromFileName());
+      }
+    for (int i = 0; i < storageNode->GetNumberOfFileNames(); ++i)
+      {
+      bundleFileNames.push_back(storageNode->GetFullNameFromNthFileName(i));
+      }
+    }
+
+  // Get entries of the files and files next to them with the same base name
+  std::vector<std::string> entryNames;
+  for (const std::string& bundleFileName : bundleFileNames)
+    {
+    if (bundleFileName.empty()
+      || !vtksys::SystemTools::StringStartsWith(bundleFileName.c_str(), (this->OpenBundleDirectory + "/").c_str()))
+      {
+      continue;
+      }
+    std::string entryName = vtksys::SystemTools::RelativePath(this->OpenBundleDirectory, bundleFileName);
+    std::string entryDirectory = vtksys::SystemTools::GetFilenamePath(entryName);
+    std::string entryPrefix = (entryDirectory.empty() ? std::string() : entryDirectory + "/")
+      + vtksys::SystemTools::GetFilenameWithoutExtension(entryName) + ".";
+    for (const std::string& bundleEntryName : this->OpenBundleEntries)
+      {
+      if (bundleEntryName != entryName && !vtksys::SystemTools::StringStartsWith(bundleEntryName.c_str(), entryPrefix.c_str()))
+        {
+        continue;
+        }
+      std::string extractedFileName = this->OpenBundleDirectory + "/" + bundleEntryName;
+      if (vtksys::SystemTools::FileExists(extractedFileName, true)
+        || std::find(entryNames.begin(), entryNames.end(), bundleEntryName) != entryNames.end())
+        {
+        continue;
+        }
+      entryNames.push_back(bundleEntryName);
+      readState.ExtractedFileNames.push_back(extractedFileName);
+      }
+    }
+  if (!changeFileNames && entryNames.empty())
+    {
+    // not a bundle file, or already extracted
+    return false;
+    }
+  if (!entryNames.empty())
+    {
+    vtkDebugMacro("Extracting " << entryNames.size() << " files from bundle " << this->OpenBundleFileName);
+    if (!vtkArchive::UnZipEntries(this->OpenBundleFileName.c_str(), this->OpenBundleDirectory.c_str(), entryNames))
+      {
+      vtkErrorMacro("BeginReadBundleFiles: failed to extract files of " << (storageNode->GetID() ? storageNode->GetID() : "(none)")
+        << " from " << this->OpenBundleFileName);
+      }
+    }
+
+  if (changeFileNames)
+    {
+    storageNode->ResetFileNameList();
+    for (size_t fileIndex = 0; fileIndex < bundleFileNames.size(); ++fileIndex)
+      {
+      if (fileIndex == 0)
+        {
+        storageNode->SetFileName(bundleFileNames[fileIndex].empty() ? nullptr : bundleFileNames[fileIndex].c_str());
+        }
+      else
+        {
+        storageNode->AddFileName(bundleFileNames[fileIndex].c_str());
+        }
+      }
+    }
+  else
+    {
+    // File names are not changed
+    readState.FileNames.clear();
+    }
+  this->OpenBundleReadStates[storageNode] = readState;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLScene::EndReadBundleFiles(vtkMRMLStorageNode* storageNode)
+{
+  auto readStateIt = this->OpenBundleReadStates.find(storageNode);
+  if (readStateIt == this->OpenBundleReadStates.end())
+    {
+    return;
+    }
+  const BundleReadState& readState = readStateIt->second;
+  if (!readState.FileNames.empty())
+    {
+    storageNode->ResetFileNameList();
+    storageNode->SetFileName(readState.FileNames[0].empty() ? nullptr : readState.FileNames[0].c_str());
+    for (size_t fileIndex = 1; fileIndex < readState.FileNames.size(); ++fileIndex)
+      {
+      storageNode->AddFileName(readState.FileNames[fileIndex].c_str());
+      }
+    }
+  // Data is in memory now, extracted files are not needed anymore
+  for (const std::string& extractedFileName : readState.ExtractedFileNames)
+    {
+    vtksys::SystemTools::RemoveFile(extractedFileName);
+    }
+  this->OpenBundleReadStates.erase(readStateIt);
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLScene::CanReadBundleFiles(vtkMRMLStorageNode* storageNode)
+{
+  if (!storageNode || this->OpenBundleFileName.empty())
+    {
+    return false;
+    }
+  if (this->FindOpenBundleStorageFileNames(storageNode) != this->OpenBundleStorageFileNames.end())
+    {
+    return true;
+    }
+  // Storage node file name points to the unpack directory
+  return storageNode->GetFileName()
+    && vtksys::SystemTools::StringStartsWith(storageNode->GetFullNameFromFileName().c_str(), (this->OpenBundleDirectory + "/").c_str());
+}
+
+//----------------------------------------------------------------------------
+std::map<std::string, vtkMRMLScene::BundleStorageFileNames>::iterator vtkMRMLScene::FindOpenBundleStorageFileNames(
+  vtkMRMLStorageNode* storageNode)
+{
+  auto bundleFileNamesIt = storageNode->GetID()
+    ? this->OpenBundleStorageFileNames.find(storageNode->GetID()) : this->OpenBundleStorageFileNames.end();
+  if (bundleFileNamesIt == this->OpenBundleStorageFileNames.end())
+    {
+    return bundleFileNamesIt;
+    }
+  std::string fileName = storageNode->GetFileName() ? storageNode->GetFileName() : "";
+  if (fileName != bundleFileNamesIt->second.FileName)
+    {
+    // Storage node points to a different file now (for example, it was saved to a new location)
+    this->OpenBundleStorageFileNames.erase(bundleFileNamesIt);
+    return this->OpenBundleStorageFileNames.end();
+    }
+  return bundleFileNamesIt;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLScene::CloseBundle(bool readPendingData/*=true*/)
+{
+  if (this->OpenBundleFileName.empty())
+    {
+    return;
+    }
+  if (readPendingData)
+    {
+    this->ReadPendingData();
+    }
+  if (!vtksys::SystemTools::RemoveADirectory(this->OpenBundleDirectory))
+    {
+    vtkWarningMacro("CloseBundle: cannot remove directory '" << this->OpenBundleDirectory << "'");
+    }
+  vtkDebugMacro("Closed bundle " << this->OpenBundleFileName);
+  this->OpenBundleFileName.clear();
+  this->OpenBundleDirectory.clear();
+  this->OpenBundleEntries.clear();
+  this->OpenBundleStorageFileNames.clear();
+  this->OpenBundleReadStates.clear();
+}
+
+//----------------------------------------------------------------------------
+std::string vtkMRMLScene::UnpackSlicerDataBundle(const char* sdbFilePath, const char* temporaryDirectory, vtkMRMLMessageCollection* userMessages/*=nullptr*/,
+  bool extractDataFiles/*=true*/)
 {
-  if (!vtkArchive::UnZip(sdbFilePath, temporaryDirectory))
+  bool extracted = false;
+  if (extractDataFiles)
+    {
+    extracted = vtkArchive::UnZip(sdbFilePath, temporaryDirectory);
+    }
+  else
+    {
+    // Extract only entries that are not in a subdirectory of the top-level directory
+    std::vector<std::string> entryNames;
+    std::vector<std::string> topLevelEntryNames;
+    extracted = vtkArchive::ListArchive(sdbFilePath, entryNames);
+    for (const std::string& entryName : entryNames)
+      {
+      if (entryName.empty() || entryName.back() == '/')
+        {
+        continue;
+        }
+      if (std::count(entryName.begin(), entryName.end(), '/') <= 1)
+        {
+        topLevelEntryNames.push_back(entryName);
+        }
+      }
+    extracted = extracted && vtkArchive::UnZipEntries(sdbFilePath, temporaryDirectory, topLevelEntryNames);
+    }
+  if (!extracted)
     {
     vtkGenericWarningMacro("could not open bundle file");
     if (userMessages)
@@ -4234,6 +5284,10 @@ bool vtkMRMLScene::SaveSceneToSlicerDataBundleDirectory(const char* sdbDir,
 
   bool success = true;
   std::map<std::string, vtkMRMLNode *> storableNodes;
+  // Nodes of the main scene that are written in parallel, after all file names are assigned
+  std::vector<vtkMRMLStorableNode*> parallelWriteNodes;
+  std::set<std::string> reservedFileNames;
+  const size_t parallelWriteBatchSize = std::max<size_t>(1, static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads()));
   int numNodes = this->GetNumberOfNodes();
   for (int i = 0; i < numNodes; ++i)
     {
@@ -4249,13 +5303,29 @@ bool vtkMRMLScene::SaveSceneToSlicerDataBundleDirectory(const char* sdbDir,
       // get all storable nodes in the main scene
       // and store them in the map by ID to avoid duplicates for the scene views
       vtkMRMLStorableNode* storableNode = vtkMRMLStorableNode::SafeDownCast(mrmlNode);
-      if (!this->SaveStorableNodeToSlicerDataBundleDirectory(storableNode, dataDir, originalStorageNodeFileNames, userMessages))
+      if (!this->SaveStorableNodeToSlicerDataBundleDirectory(storableNode, dataDir, originalStorageNodeFileNames, userMessages,
+        this->WriteDataInParallel ? &parallelWriteNodes : nullptr, &reservedFileNames))
         {
         success = false;
         }
       storableNodes[std::string(storableNode->GetID())] = storableNode;
+      if (this->StreamingArchive && parallelWriteNodes.size() >= parallelWriteBatchSize)
+        {
+        // When writing into an archive, write nodes in batches to limit the size of temporary files
+        if (!this->WriteStorableNodesInParallel(parallelWriteNodes, userMessages)
+          || !this->MoveFilesToStreamingArchive(dataDir, &reservedFileNames, userMessages))
+          {
+          success = false;
+          }
+        parallelWriteNodes.clear();
+        }
       }
     }
+  if (!this->WriteStorableNodesInParallel(parallelWriteNodes, userMessages)
+    || !this->MoveFilesToStreamingArchive(dataDir, &reservedFileNames, userMessages))
+    {
+    success = false;
+    }
   // Update all storage nodes in all scene views.
   // Nodes that are not present in the main scene are actually saved to file, others just have their paths updated.
   for (int i = 0; i < numNodes; ++i)
@@ -4281,7 +5351,8 @@ bool vtkMRMLScene::SaveSceneToSlicerDataBundleDirectory(const char* sdbDir,
         userMessages->SetObservedObject(storableNode);
         storableNode->UpdateScene(this);
         userMessages->SetObservedObject(nullptr);
-        if (!this->SaveStorableNodeToSlicerDataBundleDirectory(storableNode, dataDir, originalStorageNodeFileNames, userMessages))
+        if (!this->SaveStorableNodeToSlicerDataBundleDirectory(storableNode, dataDir, originalStorageNodeFileNames, userMessages,
+          nullptr, &reservedFileNames))
           {
           success = false;
           }
@@ -4438,7 +5509,15 @@ void vtkMRMLScene::SaveSceneScreenshot(vtkImageData* screenshot)
 //----------------------------------------------------------------------------
 std::string vtkMRMLScene::CreateUniqueFileName(const std::string& filename, const std::string& knownExtension)
 {
-  if (!vtksys::SystemTools::FileExists(filename.c_str()))
+  return vtkMRMLScene::CreateUniqueFileName(filename, knownExtension, std::set<std::string>());
+}
+
+//----------------------------------------------------------------------------
+std::string vtkMRMLScene::CreateUniqueFileName(const std::string& filename, const std::string& knownExtension,
+  const std::set<std::string>& reservedFileNames)
+{
+  if (!vtksys::SystemTools::FileExists(filename.c_str())
+    && reservedFileNames.find(filename) == reservedFileNames.end())
     {
     // filename is unique already
     return filename;
@@ -4490,7 +5569,8 @@ std::string vtkMRMLScene::CreateUniqueFileName(const std::string& filename, cons
     std::stringstream ss;
     ss << baseName << "_" << suffix << extension;
     uniqueFilename = ss.str();
-    if (!vtksys::SystemTools::FileExists(uniqueFilename))
+    if (!vtksys::SystemTools::FileExists(uniqueFilename)
+      && reservedFileNames.find(uniqueFilename) == reservedFileNames.end())
       {
       // found unique filename
       break;
@@ -4501,7 +5581,8 @@ std::string vtkMRMLScene::CreateUniqueFileName(const std::string& filename, cons
 
 //----------------------------------------------------------------------------
 bool vtkMRMLScene::SaveStorableNodeToSlicerDataBundleDirectory(vtkMRMLStorableNode* storableNode, std::string &dataDir,
-  std::map<vtkMRMLStorageNode*, std::vector<std::string> > &originalStorageNodeFileNames, vtkMRMLMessageCollection* userMessages)
+  std::map<vtkMRMLStorageNode*, std::vector<std::string> > &originalStorageNodeFileNames, vtkMRMLMessageCollection* userMessages,
+  std::vector<vtkMRMLStorableNode*>* parallelWriteNodes/*=nullptr*/, std::set<std::string>* reservedFileNames/*=nullptr*/)
 {
   if (!storableNode || !storableNode->GetSaveWithScene())
     {
@@ -4566,14 +5647,28 @@ bool vtkMRMLScene::SaveStorableNodeToSlicerDataBundleDirectory(vtkMRMLStorableNo
   // Make sure the filename is unique (default filenames may be the same if for example there are multiple
   // nodes with the same name).
   std::string existingFileName = (storageNode->GetFileName() ? storageNode->GetFileName() : "");
-  if (vtksys::SystemTools::FileExists(existingFileName, true))
+  if (vtksys::SystemTools::FileExists(existingFileName, true)
+    || (reservedFileNames && reservedFileNames->find(existingFileName) != reservedFileNames->end()))
     {
     std::string currentExtension = storageNode->GetSupportedFileExtension(existingFileName.c_str());
-    std::string uniqueFileName = this->CreateUniqueFileName(existingFileName, currentExtension);
+    std::string uniqueFileName = reservedFileNames
+      ? vtkMRMLScene::CreateUniqueFileName(existingFileName, currentExtension, *reservedFileNames)
+      : vtkMRMLScene::CreateUniqueFileName(existingFileName, currentExtension);
     vtkDebugMacro("file " << existingFileName << " already exists, use " << uniqueFileName << " filename instead");
     storageNode->SetFileName(uniqueFileName.c_str());
     }
 
+  if (parallelWriteNodes && storageNode->CanWriteInBackgroundThread() && storageNode->GetURI() == nullptr)
+    {
+    // The file will be written later, make sure no other node gets the same file name
+    if (reservedFileNames && storageNode->GetFileName())
+      {
+      reservedFileNames->insert(storageNode->GetFileName());
+      }
+    parallelWriteNodes->push_back(storableNode);
+    return true;
+    }
+
   storageNode->GetUserMessages()->ClearMessages();
   int success = storageNode->WriteData(storableNode);
   if (userMessages)
@@ -4582,9 +5677,138 @@ bool vtkMRMLScene::SaveStorableNodeToSlicerDataBundleDirectory(vtkMRMLStorableNo
       + (storableNode->GetID() ? storableNode->GetID() : "none") + "): ";
     userMessages->AddMessages(storageNode->GetUserMessages(), messagePrefix);
     }
+  if (!this->MoveFilesToStreamingArchive(dataDir, reservedFileNames, userMessages))
+    {
+    success = false;
+    }
   return success;
  }
 
+//----------------------------------------------------------------------------
+bool vtkMRMLScene::MoveFilesToStreamingArchive(const std::string& directory, std::set<std::string>* reservedFileNames,
+  vtkMRMLMessageCollection* userMessages)
+{
+  if (!this->StreamingArchive)
+    {
+    return true;
+    }
+  vtksys::Glob glob;
+  glob.RecurseOn();
+  glob.RecurseThroughSymlinksOff();
+  if (!glob.FindFiles(directory + "/*"))
+    {
+    vtkErrorToMessageCollectionMacro(userMessages, "vtkMRMLScene::MoveFilesToStreamingArchive",
+      "Could not find files in directory " << directory);
+    return false;
+    }
+  bool success = true;
+  for (const std::string& fileName : glob.GetFiles())
+    {
+    std::string entryName = vtksys::SystemTools::RelativePath(this->StreamingArchiveBaseDirectory, fileName);
+    if (!this->StreamingArchive->AddFile(fileName.c_str(), entryName.c_str()))
+      {
+      vtkErrorToMessageCollectionMacro(userMessages, "vtkMRMLScene::MoveFilesToStreamingArchive",
+        "Could not add file " << fileName << " to the scene bundle");
+      success = false;
+      continue;
+      }
+    if (reservedFileNames)
+      {
+      // the file is removed, but its name is still in use in the archive
+      reservedFileNames->insert(fileName);
+      }
+    vtksys::SystemTools::RemoveFile(fileName);
+    }
+  return success;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLScene::WriteStorableNodesInParallel(const std::vector<vtkMRMLStorableNode*>& storableNodes,
+  vtkMRMLMessageCollection* userMessages)
+{
+  if (storableNodes.empty())
+    {
+    return true;
+    }
+
+  // Prepare nodes on the main thread: read deferred data and block modified events,
+  // so that no observers are called from the worker threads.
+  std::vector<int> storableNodeWasModifying(storableNodes.size());
+  std::vector<int> storageNodeWasModifying(storableNodes.size());
+  for (size_t nodeIndex = 0; nodeIndex < storableNodes.size(); ++nodeIndex)
+    {
+    vtkMRMLStorableNode* storableNode = storableNodes[nodeIndex];
+    storableNode->ReadPendingData();
+    vtkMRMLStorageNode* storageNode = storableNode->GetStorageNode();
+    storageNode->GetUserMessages()->ClearMessages();
+    storableNodeWasModifying[nodeIndex] = storableNode->StartModify();
+    storageNodeWasModifying[nodeIndex] = storageNode->StartModify();
+    }
+
+  std::vector<int> writeSuccess(storableNodes.size(), 0);
+  std::atomic<size_t> nextNodeIndex(0);
+  std::atomic<size_t> numberOfWrittenNodes(0);
+  std::mutex progressMutex;
+  std::condition_variable progressCondition;
+  auto writeNodes = [&]()
+    {
+    for (size_t nodeIndex = nextNodeIndex++; nodeIndex < storableNodes.size(); nodeIndex = nextNodeIndex++)
+      {
+      vtkMRMLStorableNode* storableNode = storableNodes[nodeIndex];
+      writeSuccess[nodeIndex] = storableNode->GetStorageNode()->WriteData(storableNode);
+        {
+        std::lock_guard<std::mutex> lock(progressMutex);
+        ++numberOfWrittenNodes;
+        }
+      progressCondition.notify_one();
+      }
+    };
+  size_t numberOfThreads = std::min<size_t>(storableNodes.size(),
+    std::max<size_t>(1, static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads())));
+  std::vector<std::thread> threads;
+  for (size_t threadIndex = 0; threadIndex < numberOfThreads; ++threadIndex)
+    {
+    threads.emplace_back(writeNodes);
+    }
+
+  // Report progress on the main thread
+  size_t numberOfReportedNodes = 0;
+  while (numberOfReportedNodes < storableNodes.size())
+    {
+      {
+      std::unique_lock<std::mutex> lock(progressMutex);
+      progressCondition.wait(lock, [&] { return numberOfWrittenNodes > numberOfReportedNodes; });
+      numberOfReportedNodes = numberOfWrittenNodes;
+      }
+    double progress = static_cast<double>(numberOfReportedNodes) / storableNodes.size();
+    this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+    }
+  for (std::thread& thread : threads)
+    {
+    thread.join();
+    }
+
+  bool success = true;
+  for (size_t nodeIndex = 0; nodeIndex < storableNodes.size(); ++nodeIndex)
+    {
+    vtkMRMLStorableNode* storableNode = storableNodes[nodeIndex];
+    vtkMRMLStorageNode* storageNode = storableNode->GetStorageNode();
+    storageNode->EndModify(storageNodeWasModifying[nodeIndex]);
+    storableNode->EndModify(storableNodeWasModifying[nodeIndex]);
+    if (!writeSuccess[nodeIndex])
+      {
+      success = false;
+      }
+    if (userMessages)
+      {
+      std::string messagePrefix = std::string(storableNode->GetName() ? storableNode->GetName() : "unknown") + " ("
+        + (storableNode->GetID() ? storableNode->GetID() : "none") + "): ";
+      userMessages->AddMessages(storageNode->GetUserMessages(), messagePrefix);
+      }
+    }
+  return success;
+}
+
 //----------------------------------------------------------------------------
 std::string vtkMRMLScene::PercentEncode(std::string s)
 {
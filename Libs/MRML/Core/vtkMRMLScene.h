@@ -29,8 +29,10 @@ Version:   $Revision: 1.18 $
 #include <random>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+class vtkArchive;
 class vtkCacheManager;
 class vtkDataIOManager;
 class vtkTagTable;
@@ -106,6 +108,9 @@ public:
   /// all singleton nodes (interaction, color, view nodes etc.)
   /// from the scene. If it is set to false then it just resets
   /// singleton nodes to their default state.
+  /// Nodes are removed in a single pass, between StartCloseEvent and EndCloseEvent:
+  /// node reference bookkeeping is cleared at once, the scene's ModifiedEvent is only
+  /// invoked once, and removed nodes are released after all of them are removed.
   void Clear(int removeSingletons=0);
 
   /// Reset all nodes to their constructor's state
@@ -276,6 +281,18 @@ public:
   vtkCollection *GetNodesByName(const char* name);
   vtkMRMLNode *GetFirstNodeByName(const char* name);
 
+  /// \brief Get nodes whose name starts with \a namePrefix.
+  ///
+  /// Nodes are returned in the order they are in the scene.
+  /// Lookup uses the scene name index, it does not visit all the nodes.
+  /// \warning You are responsible for deleting the returned collection.
+  vtkCollection *GetNodesByNamePrefix(const char* namePrefix);
+
+  /// \brief Update the name index when the name of a node in the scene changes.
+  ///
+  /// Called by vtkMRMLNode::SetName(), there is no need to call it directly.
+  void NodeNameChanged(vtkMRMLNode* node, const char* oldName);
+
   /// \brief Return the first node in the scene that matches the filtering
   /// criteria if specified.
   ///
@@ -422,6 +439,9 @@ public:
   /// that is 'has an interest' in the given ID so that the scene
   /// can notify that node when the ID has been remapped.   It does
   /// this notification through the UpdateNodeReferences() call.
+  /// The scene also maintains the reverse map (ReferencedIDsByReferencingNode),
+  /// so that removing a node or getting the nodes that a node references does not
+  /// require iterating through all the references in the scene.
   void AddReferencedNodeID(const char *id, vtkMRMLNode *refrencingNode);
   bool IsNodeReferencingNodeID(vtkMRMLNode* referencingNode, const char* id);
 
@@ -460,6 +480,10 @@ public:
 
   void RemoveUnusedNodeReferences();
 
+  /// Recompute ReferencedIDsByReferencingNode from NodeReferences.
+  /// Must be called after NodeReferences is modified in bulk.
+  void UpdateReferencedIDsByReferencingNode();
+
   bool IsReservedID(const std::string& id);
 
   void AddReservedID(const char *id);
@@ -520,6 +544,77 @@ public:
   vtkSetMacro(ReadDataOnLoad,int);
   vtkGetMacro(ReadDataOnLoad,int);
 
+  /// \brief Defer reading of storable nodes' data until first access.
+  ///
+  /// If enabled (and ReadDataOnLoad is enabled) then Import() does not read
+  /// data of storable nodes from file but only records that reading is pending.
+  /// The data is read when it is first accessed (e.g., vtkMRMLVolumeNode::GetImageData(),
+  /// vtkMRMLModelNode::GetMesh(), display node is shown), therefore the time needed
+  /// for opening the scene depends on what is displayed and not on the scene size.
+  /// Disabled by default.
+  /// \sa vtkMRMLStorableNode::ReadPendingData(), ReadPendingData(), PrefetchDataOnDemand
+  vtkSetMacro(ReadDataOnDemand, bool);
+  vtkGetMacro(ReadDataOnDemand, bool);
+  vtkBooleanMacro(ReadDataOnDemand, bool);
+
+  /// \brief Read files of nodes with pending data in a background thread.
+  ///
+  /// If enabled then files of nodes whose reading is deferred are read in a
+  /// background thread, so that subsequent reading of the nodes' data is served
+  /// from the operating system's file cache. Nodes are not modified by the
+  /// background thread. Enabled by default.
+  /// \sa ReadDataOnDemand
+  vtkSetMacro(PrefetchDataOnDemand, bool);
+  vtkGetMacro(PrefetchDataOnDemand, bool);
+  vtkBooleanMacro(PrefetchDataOnDemand, bool);
+
+  /// \brief Read data of storable nodes in parallel during Import().
+  ///
+  /// If enabled then Import() reads data of storable nodes whose storage node
+  /// supports it (vtkMRMLStorageNode::CanReadInBackgroundThread()) on a pool of
+  /// worker threads. Files are read into temporary nodes that are not in the scene
+  /// and the results are copied into the scene nodes on the main thread.
+  /// Data of other nodes is read sequentially, as before.
+  /// Has no effect if ReadDataOnDemand is enabled. Disabled by default.
+  /// \sa ReadDataOnDemand
+  vtkSetMacro(ReadDataInParallel, bool);
+  vtkGetMacro(ReadDataInParallel, bool);
+  vtkBooleanMacro(ReadDataInParallel, bool);
+
+  /// \brief Write data of storable nodes in parallel when saving a scene bundle.
+  ///
+  /// If enabled then SaveSceneToSlicerDataBundleDirectory() writes data of storable
+  /// nodes whose storage node supports it (vtkMRMLStorageNode::CanWriteInBackgroundThread())
+  /// on a pool of worker threads. File names are assigned on the main thread before
+  /// writing starts, therefore the result is the same as with sequential writing.
+  /// vtkCommand::ProgressEvent is invoked on the scene (with the completed fraction
+  /// as call data) while parallel writing is in progress. Disabled by default.
+  vtkSetMacro(WriteDataInParallel, bool);
+  vtkGetMacro(WriteDataInParallel, bool);
+  vtkBooleanMacro(WriteDataInParallel, bool);
+
+  /// \brief Write scene file in MRML binary format instead of XML.
+  ///
+  /// The binary format contains the same elements and attributes as the XML format,
+  /// but it can be read without XML parsing, which is faster for scenes with
+  /// large number of nodes or large attribute values.
+  /// Import() detects the format of the scene file automatically.
+  /// Has no effect if SaveToXMLString is enabled. Disabled by default.
+  /// \sa vtkMRMLParser::EncodeBinaryScene()
+  vtkSetMacro(WriteSceneInBinaryFormat, bool);
+  vtkGetMacro(WriteSceneInBinaryFormat, bool);
+  vtkBooleanMacro(WriteSceneInBinaryFormat, bool);
+
+  /// Read data of all storable nodes whose reading was deferred.
+  /// Returns false if reading of any of the nodes failed.
+  /// \sa ReadDataOnDemand
+  bool ReadPendingData();
+
+  /// Request reading of the file in a background thread to speed up reading its contents later.
+  /// Does nothing if PrefetchDataOnDemand is disabled.
+  /// \sa PrefetchDataOnDemand
+  void PrefetchFile(const std::string& fileName);
+
   /// \brief Set the XML string to read from by Import() if
   /// GetLoadFromXMLString() is true.
   ///
@@ -597,6 +692,7 @@ public:
     SaveState = 0x0010,
     UndoState = 0x0020,
     RedoState = 0x0040,
+    DeferredModifyState = 0x0080,
     };
 
   /// \brief Returns the current state of the scene.
@@ -620,6 +716,26 @@ public:
   inline bool IsUndoing()const;
   /// Return true if the scene is in Redo state (in the process of redoing node changes), false otherwise
   inline bool IsRedoing()const;
+  /// Return true if the scene is in DeferredModify state, false otherwise
+  /// \sa DeferredModifyState
+  inline bool IsDeferringModifiedEvents()const;
+
+  /// \brief Return true while the modified events that were deferred in
+  /// \link vtkMRMLScene::DeferredModifyState DeferredModifyState \endlink are being invoked.
+  ///
+  /// When the scene leaves the DeferredModify state, each node that was modified
+  /// in that state invokes its pending modified events once, and then the scene fires
+  /// \link vtkMRMLScene::NodesModifiedEvent NodesModifiedEvent \endlink with the
+  /// list of modified nodes. Observers that process NodesModifiedEvent (for example
+  /// views and node lists) may ignore the individual node modified events while
+  /// this method returns true.
+  vtkGetMacro(InvokingDeferredModifiedEvents, bool);
+
+  /// \brief Remember that a node has modified events pending until the scene
+  /// leaves the DeferredModify state.
+  ///
+  /// This method is for internal use only, it is called by vtkMRMLNode.
+  void AddDeferredModifiedNode(vtkMRMLNode* node);
 
   /// \brief Flag the scene as being in a \a state mode.
   ///
@@ -652,6 +768,15 @@ public:
   /// // fires: EndImportEvent, StartBatchProcessEvent
   /// \endcode
   ///
+  /// If the state is \link vtkMRMLScene::DeferredModifyState DeferredModifyState \endlink
+  /// then ModifiedEvent and custom modified events of the nodes of the scene are not
+  /// invoked immediately but kept pending (as if StartModify() was called on each
+  /// modified node). When the scene leaves the DeferredModify state, each modified node
+  /// invokes its pending events once and then
+  /// \link vtkMRMLScene::NodesModifiedEvent NodesModifiedEvent \endlink is fired
+  /// with the list of modified nodes. This allows modifying many nodes at once
+  /// (e.g. from a logic) without sending a separate event at each change to every observer.
+  ///
   /// StartState() internally pushes the state into a stack.
   ///
   /// \sa EndState, GetStates
@@ -677,6 +802,9 @@ public:
     NodeAboutToBeRemovedEvent,
     NodeRemovedEvent,
     NodeClassRegisteredEvent,
+    /// Fired when the scene leaves \link vtkMRMLScene::DeferredModifyState DeferredModifyState \endlink.
+    /// Call data is a vtkCollection of the nodes that were modified in that state.
+    NodesModifiedEvent,
 
     NewSceneEvent = 66030,
     MetadataAddedEvent = 66032, // ### Slicer 4.5: Simplify - Do not explicitly set for backward compat. See issue #3472
@@ -719,6 +847,10 @@ public:
     EndRedoEvent = StateEvent | EndEvent | RedoState,
     ProgressRedoEvent = StateEvent | ProgressEvent | RedoState,
 
+    StartDeferredModifyEvent = StateEvent | StartEvent | DeferredModifyState,
+    EndDeferredModifyEvent = StateEvent | EndEvent | DeferredModifyState,
+    ProgressDeferredModifyEvent = StateEvent | ProgressEvent | DeferredModifyState,
+
     };
 
   /// The version of the last loaded scene file.
@@ -783,6 +915,28 @@ public:
   void SetMaximumNumberOfSavedUndoStates(int stackSize);
   vtkGetMacro(MaximumNumberOfSavedUndoStates, int);
 
+  /// \brief Sets the maximum memory size (in kilobytes) of the node states saved in the undo stack.
+  ///
+  /// When the estimated memory size of the undo stack exceeds this value, the oldest saved
+  /// states are removed (the most recent state is always kept).
+  /// 0 means there is no limit (only MaximumNumberOfSavedUndoStates is enforced). Default is 0.
+  /// \sa GetUndoStackMemorySize()
+  void SetMaximumUndoStackMemorySize(unsigned long memorySizeKB);
+  vtkGetMacro(MaximumUndoStackMemorySize, unsigned long);
+
+  /// \brief Returns the estimated memory size (in kilobytes) of node states saved in the undo stack.
+  ///
+  /// Node states that are shared between several undo levels are only counted once.
+  unsigned long GetUndoStackMemorySize();
+
+  /// \brief Returns the estimated memory size (in kilobytes) of the data of nodes in the scene.
+  ///
+  /// If className is specified then only nodes of that class (or derived classes) are included.
+  /// Data that is shared between nodes (e.g., shallow-copied image data) may be counted multiple times.
+  /// This can be used by processing pipelines to enforce a memory budget.
+  /// \sa vtkMRMLNode::GetDataMemorySize(), GetUndoStackMemorySize()
+  unsigned long GetNodesDataMemorySize(const char* className = nullptr);
+
   /// \brief Write the scene to a MRML scene bundle (.mrb) file.
   /// If thumbnail image is provided then it is saved in the scene's root folder.
   /// If userMessages is not nullptr then the method may add messages to it about issues
@@ -800,7 +954,34 @@ public:
   /// directory will be used.
   /// If userMessages is not nullptr then the method may add messages to it about issues
   /// encountered during the operation.
-  static std::string UnpackSlicerDataBundle(const char* sdbFilePath, const char* temporaryDirectory, vtkMRMLMessageCollection* userMessages=nullptr);
+  /// If extractDataFiles is false then only files in the top-level directory of the bundle
+  /// (scene file, screenshots) are extracted.
+  static std::string UnpackSlicerDataBundle(const char* sdbFilePath, const char* temporaryDirectory, vtkMRMLMessageCollection* userMessages=nullptr,
+    bool extractDataFiles=true);
+
+  /// \brief Extract files of a storage node from the scene bundle that was opened for on-demand reading.
+  ///
+  /// If ReadFromMRB() is called while ReadDataOnDemand is enabled then data files are not extracted
+  /// when the scene is opened, only when the data of a node is first read.
+  /// This method extracts the files of the storage node (and files next to them that have the same
+  /// base name, such as the .raw file of a .nhdr header) and temporarily sets the storage node
+  /// file names to the extracted files.
+  /// Returns true if the storage node reads from the bundle, in this case EndReadBundleFiles()
+  /// must be called after reading.
+  /// \sa ReadFromMRB(), CloseBundle()
+  bool BeginReadBundleFiles(vtkMRMLStorageNode* storageNode);
+
+  /// Restore storage node file names changed by BeginReadBundleFiles() and remove the extracted files.
+  void EndReadBundleFiles(vtkMRMLStorageNode* storageNode);
+
+  /// Returns true if the data of the storage node can be read from the scene bundle
+  /// that is open for on-demand reading, even if it has been read already.
+  /// \sa BeginReadBundleFiles(), vtkMRMLStorableNode::ReleaseData()
+  bool CanReadBundleFiles(vtkMRMLStorageNode* storageNode);
+
+  /// Remove the temporary directory of the scene bundle that was opened for on-demand reading.
+  /// If readPendingData is true then data of all nodes that is not read yet is read before.
+  void CloseBundle(bool readPendingData=true);
 
   /// \brief Save the scene into a self contained directory, sdbDir
   /// If thumbnail image is provided then it is saved in the scene's root folder.
@@ -890,12 +1071,45 @@ protected:
   /// Clear NodeIDs map used to speedup GetByID() method.
   void ClearNodeIDs();
 
+  /// \brief Synchronize NodesByClass and NodesByName indices used to speedup GetNodesByClass(),
+  /// GetNthNodeByClass(), GetNumberOfNodesByClass(), GetNodesByName()... with the \a Nodes collection.
+  ///
+  /// The index is invalidated (and lazily rebuilt) if the \a Nodes collection
+  /// was modified without going through AddNode() or RemoveNode().
+  void UpdateNodesByClass();
+
+  /// \brief Get the list of scene nodes that are of class \a className
+  /// (or of one of its subclasses), in the order of the \a Nodes collection.
+  ///
+  /// The list is computed the first time the class is queried and then kept
+  /// up-to-date by AddNodeToClassIndex() and RemoveNodeFromClassIndex().
+  const std::map<vtkIdType, vtkMRMLNode*>& GetIndexedNodesByClass(const char* className);
+
+  /// Add node to \a NodesByClass index. Must be called after the node is appended to \a Nodes.
+  void AddNodeToClassIndex(vtkMRMLNode *node);
+
+  /// Remove node from \a NodesByClass index. Must be called after the node is removed from \a Nodes.
+  void RemoveNodeFromClassIndex(vtkMRMLNode *node);
+
+  /// Clear NodesByClass and NodesByName indices. They will be rebuilt at the next query.
+  void ClearNodesByClass();
+
+  /// Get the list of scene nodes that have the name \a name, in the order of the \a Nodes collection.
+  /// Returns nullptr if there is no such node.
+  const std::map<vtkIdType, vtkMRMLNode*>* GetIndexedNodesByName(const char* name);
+
   /// Get a NodeReferences iterator for a node reference.
   NodeReferencesType::iterator FindNodeReference(const char* referencedId, vtkMRMLNode* referencingNode);
 
-  /// Clean up elements of the undo/redo stack beyond the maximum size
+  /// Clean up elements of the undo/redo stack beyond the maximum size and memory size
   void TrimUndoStack();
 
+  /// \brief Get the node that must be added to the scene when undo restores a removed node.
+  ///
+  /// If \a undoNode is a node state that is shared between several undo levels
+  /// then a copy is returned, so that the shared state is not modified.
+  vtkSmartPointer<vtkMRMLNode> GetUndoNodeToAdd(vtkMRMLNode* undoNode);
+
   /// Reserve all node reference ids for a node
   void ReserveNodeReferenceIDs(vtkMRMLNode* node);
 
@@ -911,8 +1125,12 @@ protected:
   /// Returns true on success (written successfully or no need to write the node).
   /// If userMessages is not nullptr then the method may add messages to it about issues
   /// encountered during the operation.
+  /// If parallelWriteNodes is not nullptr and the storage node can write in a background thread
+  /// then only the file name is updated and the node is added to parallelWriteNodes, to be written later.
+  /// File names of these nodes are added to reservedFileNames, to keep file names unique.
   bool SaveStorableNodeToSlicerDataBundleDirectory(vtkMRMLStorableNode* storableNode, std::string& dataDir,
-    std::map<vtkMRMLStorageNode*, std::vector<std::string> > &originalStorageNodeFileNames, vtkMRMLMessageCollection* userMessages);
+    std::map<vtkMRMLStorageNode*, std::vector<std::string> > &originalStorageNodeFileNames, vtkMRMLMessageCollection* userMessages,
+    std::vector<vtkMRMLStorableNode*>* parallelWriteNodes = nullptr, std::set<std::string>* reservedFileNames = nullptr);
 
   vtkCollection*  Nodes;
 
@@ -927,27 +1145,69 @@ protected:
 
   std::vector<unsigned long> States;
 
+  /// Invoke pending modified events of the nodes that were modified in DeferredModify state
+  /// and fire NodesModifiedEvent.
+  void InvokeDeferredModifiedEvents();
+  /// Nodes that have modified events pending because they were modified in DeferredModify state
+  std::vector< vtkWeakPointer<vtkMRMLNode> > DeferredModifiedNodes;
+  bool InvokingDeferredModifiedEvents{false};
+
   int  MaximumNumberOfSavedUndoStates;
+  unsigned long MaximumUndoStackMemorySize;
   bool UndoFlag;
 
   std::list< vtkCollection* >  UndoStack;
   std::list< vtkCollection* >  RedoStack;
 
+  /// Last node state stored in the undo stack for each node ID. If a node has not been modified since
+  /// its state was stored, the same state is referenced in the new undo level instead of copying the node again.
+  struct UndoNodeStateType
+    {
+    vtkWeakPointer<vtkMRMLNode> Node;
+    vtkWeakPointer<vtkMRMLNode> State;
+    vtkMTimeType ContentMTime{0};
+    };
+  std::map< std::string, UndoNodeStateType > UndoNodeStates;
+
   std::string                 URL;
   std::string                 RootDirectory;
 
   std::map<std::string, int> UniqueIDs;
   std::map<std::string, int> UniqueNames;
   std::set<std::string>   ReservedIDs;
+  /// Node reference IDs in the undo stack, cached for IsNodeIDReservedByUndo().
+  /// Only valid if UndoStackReferenceIDsValid is true, must be invalidated when UndoStack is changed.
+  mutable std::set<std::string> UndoStackReferenceIDs;
+  mutable bool UndoStackReferenceIDsValid{false};
 
   std::vector< vtkMRMLNode* > RegisteredNodeClasses;
   std::vector< std::string >  RegisteredNodeTags;
+  /// Registered node classes indexed by XML tag and by class name, for fast lookup
+  /// of node classes while parsing scenes. Rebuilt by UpdateRegisteredNodeClassMaps().
+  /// If the same class is registered with multiple tags then the first registered
+  /// one is found by class name, same as when iterating through RegisteredNodeClasses.
+  std::map< std::string, vtkMRMLNode* > RegisteredNodeClassByTag;
+  std::map< std::string, vtkMRMLNode* > RegisteredNodeClassByClassName;
+  void UpdateRegisteredNodeClassMaps();
   std::map< std::string, std::string > RegisteredAbstractNodeClassTypeDisplayNames; // map class name to type display name
 
   NodeReferencesType NodeReferences; // ReferencedIDs (string), ReferencingNodes (node pointer)
+  NodeReferencesType ReferencedIDsByReferencingNode; // ReferencingNodeIDs (string), ReferencedIDs (string)
   std::map< std::string, std::string > ReferencedIDChanges;
   std::map< std::string, vtkSmartPointer<vtkMRMLNode> > NodeIDs;
 
+  // Index used to speedup class queries: for each class name that has been queried, the nodes
+  // that are of that class (IsA() returns true), sorted by their position in the Nodes collection.
+  // NodeOrder stores the position key of each node of the scene.
+  std::unordered_map< std::string, std::map<vtkIdType, vtkMRMLNode*> > NodesByClass;
+  std::unordered_map< vtkMRMLNode*, vtkIdType > NodeOrder;
+  // Index used to speedup name queries: for each node name, the nodes that have
+  // that name, sorted by their position in the Nodes collection.
+  // An ordered map is used to allow prefix search.
+  std::map< std::string, std::map<vtkIdType, vtkMRMLNode*> > NodesByName;
+  vtkIdType NextNodeOrder;
+  vtkMTimeType NodesByClassMTime;
+
   // Stores default nodes. If a class is created or reset (using CreateNodeByClass or Clear) and
   // a default node is defined for it then the content of the default node will be used to initialize
   // the class. It is useful for overriding default values that are set in a node's constructor.
@@ -961,6 +1221,42 @@ protected:
 
   int ReadDataOnLoad;
 
+  bool ReadDataOnDemand{false};
+  bool PrefetchDataOnDemand{true};
+  bool ReadDataInParallel{false};
+  bool WriteDataInParallel{false};
+  bool WriteSceneInBinaryFormat{false};
+
+  /// Write data of storable nodes using their storage nodes in parallel.
+  /// Messages of each storage node are added to \a userMessages, prefixed by the node name and ID.
+  /// Returns false if writing of any of the nodes failed.
+  bool WriteStorableNodesInParallel(const std::vector<vtkMRMLStorableNode*>& storableNodes,
+    vtkMRMLMessageCollection* userMessages);
+
+  /// Zip file that SaveSceneToSlicerDataBundleDirectory() moves written files into
+  /// right after they are written. It is only set during WriteToMRB(), to avoid staging
+  /// the entire scene in a temporary directory before compressing it.
+  vtkArchive* StreamingArchive{nullptr};
+  /// Entry names in StreamingArchive are file paths relative to this directory.
+  std::string StreamingArchiveBaseDirectory;
+
+  /// Add all files in \a directory (recursively) to StreamingArchive and remove them from disk.
+  /// Names of the moved files are added to \a reservedFileNames (if not nullptr),
+  /// so that files written later do not get the same name.
+  /// Returns true if StreamingArchive is not set or all files were moved successfully.
+  bool MoveFilesToStreamingArchive(const std::string& directory, std::set<std::string>* reservedFileNames,
+    vtkMRMLMessageCollection* userMessages);
+
+  /// Creates a unique file name that does not exist and is not in reservedFileNames.
+  /// \sa CreateUniqueFileName(const std::string&, const std::string&)
+  static std::string CreateUniqueFileName(const std::string& filename, const std::string& knownExtension,
+    const std::set<std::string>& reservedFileNames);
+
+  /// Read pending data of the nodes. Data of nodes whose storage node supports
+  /// reading in a background thread is read in parallel, other nodes are read sequentially.
+  /// Errors are added to \a userMessages.
+  void ReadPendingDataInParallel(vtkCollection* nodes, vtkMRMLMessageCollection* userMessages);
+
   vtkMTimeType  NodeIDsMTime;
 
   void RemoveAllNodes(bool removeSingletons);
@@ -987,6 +1283,40 @@ private:
 
   /// Time when the scene was last read or written.
   vtkTimeStamp StoredTime;
+
+  /// Background thread that reads files of nodes with pending data
+  class vtkFilePrefetcher;
+  vtkFilePrefetcher* FilePrefetcher{nullptr};
+
+  /// Scene bundle file that was opened for on-demand reading.
+  /// Empty if no bundle is open.
+  std::string OpenBundleFileName;
+  /// Temporary directory where the entries of the open bundle are extracted to.
+  std::string OpenBundleDirectory;
+  /// All entry names in the open bundle.
+  std::vector<std::string> OpenBundleEntries;
+  struct BundleStorageFileNames
+    {
+    /// Absolute file names in the unpacked bundle (primary file name first).
+    std::vector<std::string> BundleFileNames;
+    /// Storage node file name after the bundle was opened. If the storage node file name
+    /// changes (e.g., because node is saved to a different location) then the data is not read
+    /// from the bundle anymore.
+    std::string FileName;
+    };
+  /// Location of files in the unpacked bundle for each storage node ID.
+  std::map<std::string, BundleStorageFileNames> OpenBundleStorageFileNames;
+  /// Find bundle file names of the storage node. Returns end() if the storage node
+  /// is not read from the bundle.
+  std::map<std::string, BundleStorageFileNames>::iterator FindOpenBundleStorageFileNames(vtkMRMLStorageNode* storageNode);
+  struct BundleReadState
+    {
+    /// Storage node file names before BeginReadBundleFiles (primary file name first).
+    std::vector<std::string> FileNames;
+    /// Files extracted by BeginReadBundleFiles, removed by EndReadBundleFiles.
+    std::vector<std::string> ExtractedFileNames;
+    };
+  std::map<vtkMRMLStorageNode*, BundleReadState> OpenBundleReadStates;
 };
 
 //------------------------------------------------------------------------------
@@ -1031,4 +1361,11 @@ bool vtkMRMLScene::IsRedoing()const
     == vtkMRMLScene::RedoState;
 }
 
+//------------------------------------------------------------------------------
+bool vtkMRMLScene::IsDeferringModifiedEvents()const
+{
+  return (this->GetStates() & vtkMRMLScene::DeferredModifyState)
+    == vtkMRMLScene::DeferredModifyState;
+}
+
 #endif
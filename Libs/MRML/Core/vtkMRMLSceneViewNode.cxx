@@ -33,6 +33,24 @@ Version:   $Revision: 1.14 $
 #include <sstream>
 #include <stack>
 
+namespace
+{
+//----------------------------------------------------------------------------
+/// Returns true if the two nodes have the same MRML XML representation.
+bool AreNodePropertiesEqual(vtkMRMLNode* node1, vtkMRMLNode* node2)
+{
+  if (strcmp(node1->GetClassName(), node2->GetClassName()) != 0)
+    {
+    return false;
+    }
+  std::stringstream node1Properties;
+  node1->WriteXML(node1Properties, 0);
+  std::stringstream node2Properties;
+  node2->WriteXML(node2Properties, 0);
+  return node1Properties.str() == node2Properties.str();
+}
+}
+
 //----------------------------------------------------------------------------
 vtkMRMLNodeNewMacro(vtkMRMLSceneViewNode);
 
@@ -268,6 +286,7 @@ void vtkMRMLSceneViewNode::Copy(vtkMRMLNode *anode)
 void vtkMRMLSceneViewNode::PrintSelf(ostream& os, vtkIndent indent)
 {
   Superclass::PrintSelf(os,indent);
+  os << indent << "RestoreOnlyModifiedNodes: " << (this->RestoreOnlyModifiedNodes ? "true" : "false") << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -605,6 +624,12 @@ bool vtkMRMLSceneViewNode::RestoreScene(bool removeNodes)
         {
         vtkMRMLNode *snode = this->Scene->GetNodeByID(node->GetID());
 
+        if (snode && this->RestoreOnlyModifiedNodes && snode->GetScene() == this->Scene
+          && AreNodePropertiesEqual(snode, node))
+          {
+          // node is already in the stored state
+          continue;
+          }
         if (snode)
           {
           snode->SetScene(this->Scene);
@@ -87,9 +87,18 @@ class VTK_MRML_EXPORT vtkMRMLSceneViewNode : public vtkMRMLStorableNode
   /// This can be used for asking confirmation from the user to delete nodes
   /// (if the user decides that nodes can be removed then this method is called again
   /// with removeNodes=true).
-  /// \sa GetStoredScene() StoreScene() AddMissingNodes()
+  /// \sa GetStoredScene() StoreScene() AddMissingNodes() SetRestoreOnlyModifiedNodes()
   bool RestoreScene(bool removeNodes = true);
 
+  /// If enabled (default) then RestoreScene() only copies the stored content into
+  /// those scene nodes that have been changed since the scene was stored
+  /// (their MRML XML representation is different).
+  /// This prevents unnecessary modified events and display pipeline updates
+  /// for nodes that are already in the stored state.
+  vtkSetMacro(RestoreOnlyModifiedNodes, bool);
+  vtkGetMacro(RestoreOnlyModifiedNodes, bool);
+  vtkBooleanMacro(RestoreOnlyModifiedNodes, bool);
+
   void SetAbsentStorageFileNames();
 
   /// A description of this sceneView
@@ -150,6 +159,8 @@ protected:
   /// The type of the screenshot
   int ScreenShotType;
 
+  bool RestoreOnlyModifiedNodes{true};
+
 };
 
 #endif
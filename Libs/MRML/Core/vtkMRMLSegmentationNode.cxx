@@ -59,6 +59,7 @@
 
 // STD includes
 #include <algorithm>
+#include <set>
 
 //----------------------------------------------------------------------------
 vtkMRMLNodeNewMacro(vtkMRMLSegmentationNode);
@@ -424,6 +425,38 @@ vtkMRMLStorageNode* vtkMRMLSegmentationNode::CreateDefaultStorageNode()
     scene->CreateNodeByClass("vtkMRMLSegmentationStorageNode"));
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkMRMLSegmentationNode::GetDataMemorySize()
+{
+  if (!this->Segmentation)
+    {
+    return 0;
+    }
+  unsigned long memorySize = 0;
+  std::set<vtkDataObject*> countedRepresentations;
+  std::vector<std::string> segmentIDs;
+  this->Segmentation->GetSegmentIDs(segmentIDs);
+  for (const std::string& segmentID : segmentIDs)
+    {
+    vtkSegment* segment = this->Segmentation->GetSegment(segmentID);
+    if (!segment)
+      {
+      continue;
+      }
+    std::vector<std::string> representationNames;
+    segment->GetContainedRepresentationNames(representationNames);
+    for (const std::string& representationName : representationNames)
+      {
+      vtkDataObject* representation = segment->GetRepresentation(representationName);
+      if (representation && countedRepresentations.insert(representation).second)
+        {
+        memorySize += representation->GetActualMemorySize();
+        }
+      }
+    }
+  return memorySize;
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLSegmentationNode::CreateDefaultDisplayNodes()
 {
@@ -1092,6 +1125,7 @@ double* vtkMRMLSegmentationNode::GetSegmentCenter(const std::string& segmentID)
 
     vtkNew<vtkITKIslandMath> islandMath;
     islandMath->SetInputConnection(castToUint->GetOutputPort());
+    islandMath->ParallelComputationOn();
 
     vtkNew<vtkImageThreshold> largestIslandFilter;
     largestIslandFilter->SetInputConnection(islandMath->GetOutputPort());
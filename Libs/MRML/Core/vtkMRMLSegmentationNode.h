@@ -101,6 +101,10 @@ public:
   /// Create a segmentation storage node
   vtkMRMLStorageNode* CreateDefaultStorageNode() override;
 
+  /// Memory size of all representations of all segments.
+  /// Representations that are shared between segments (e.g., binary labelmap layers) are counted once.
+  unsigned long GetDataMemorySize() override;
+
   /// Create and observe a segmentation display node
   void CreateDefaultDisplayNodes() override;
 
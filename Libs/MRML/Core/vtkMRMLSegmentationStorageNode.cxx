@@ -107,6 +107,12 @@ void vtkMRMLSegmentationStorageNode::PrintSelf(ostream& os, vtkIndent indent)
   vtkMRMLPrintBeginMacro(os, indent);
   vtkMRMLPrintBooleanMacro(CropToMinimumExtent);
   vtkMRMLPrintEndMacro();
+  os << indent << "SegmentIDsToRead:";
+  for (const std::string& segmentID : this->SegmentIDsToRead)
+    {
+    os << " " << segmentID;
+    }
+  os << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -138,6 +144,126 @@ void vtkMRMLSegmentationStorageNode::Copy(vtkMRMLNode *anode)
   vtkMRMLCopyBeginMacro(anode);
   vtkMRMLCopyBooleanMacro(CropToMinimumExtent);
   vtkMRMLCopyEndMacro();
+  vtkMRMLSegmentationStorageNode* node = vtkMRMLSegmentationStorageNode::SafeDownCast(anode);
+  if (node)
+    {
+    this->SegmentIDsToRead = node->SegmentIDsToRead;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSegmentationStorageNode::SetSegmentIDsToRead(const std::vector<std::string>& segmentIDs)
+{
+  std::set<std::string> newSegmentIDs(segmentIDs.begin(), segmentIDs.end());
+  if (newSegmentIDs == this->SegmentIDsToRead)
+    {
+    return;
+    }
+  this->SegmentIDsToRead = newSegmentIDs;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSegmentationStorageNode::GetSegmentIDsToRead(std::vector<std::string>& segmentIDs)
+{
+  segmentIDs.assign(this->SegmentIDsToRead.begin(), this->SegmentIDsToRead.end());
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSegmentationStorageNode::AddSegmentIDToRead(const std::string& segmentID)
+{
+  if (!this->SegmentIDsToRead.insert(segmentID).second)
+    {
+    // already added
+    return;
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSegmentationStorageNode::RemoveAllSegmentIDsToRead()
+{
+  if (this->SegmentIDsToRead.empty())
+    {
+    return;
+    }
+  this->SegmentIDsToRead.clear();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLSegmentationStorageNode::IsSegmentToBeRead(const std::string& segmentID)
+{
+  return this->SegmentIDsToRead.empty() || this->SegmentIDsToRead.find(segmentID) != this->SegmentIDsToRead.end();
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLSegmentationStorageNode::GetSegmentIDsInFile(std::vector<std::string>& segmentIDs, const std::string& path/*=""*/)
+{
+  segmentIDs.clear();
+  std::string fullName = path.empty() ? this->GetFullNameFromFileName() : path;
+  if (fullName.empty() || !vtksys::SystemTools::FileExists(fullName.c_str()))
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLSegmentationStorageNode::GetSegmentIDsInFile",
+      "Segmentation file '" << fullName << "' is not found.");
+    return false;
+    }
+
+  vtkNew<vtkITKArchetypeImageSeriesVectorReaderFile> archetypeImageReader;
+  archetypeImageReader->SetSingleFile(1);
+  archetypeImageReader->SetArchetype(fullName.c_str());
+  if (archetypeImageReader->CanReadFile(fullName.c_str()))
+    {
+    // Only read the header, the metadata dictionary is available after the information pass
+    this->GetUserMessages()->SetObservedObject(archetypeImageReader);
+    archetypeImageReader->UpdateInformation();
+    this->GetUserMessages()->SetObservedObject(nullptr);
+    if (archetypeImageReader->GetErrorCode() != vtkErrorCode::NoError)
+      {
+      vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLSegmentationStorageNode::GetSegmentIDsInFile",
+        "Error reading image header from " << fullName);
+      return false;
+      }
+    itk::MetaDataDictionary dictionary = archetypeImageReader->GetMetaDataDictionary();
+    std::string segmentID;
+    for (int segmentIndex = 0; this->GetSegmentMetaDataFromDicitionary(segmentID, dictionary, segmentIndex, KEY_SEGMENT_ID); ++segmentIndex)
+      {
+      segmentIDs.push_back(segmentID);
+      }
+    return true;
+    }
+
+  vtkNew<vtkXMLMultiBlockDataReader> reader;
+  if (!reader->CanReadFile(fullName.c_str()))
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLSegmentationStorageNode::GetSegmentIDsInFile",
+      "File '" << fullName << "' is not a segmentation file.");
+    return false;
+    }
+  reader->SetFileName(fullName.c_str());
+  reader->Update();
+  vtkMultiBlockDataSet* multiBlockDataset = vtkMultiBlockDataSet::SafeDownCast(reader->GetOutput());
+  if (!multiBlockDataset)
+    {
+    vtkErrorToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLSegmentationStorageNode::GetSegmentIDsInFile",
+      "Failed to read file " << fullName);
+    return false;
+    }
+  for (unsigned int blockIndex = 0; blockIndex < multiBlockDataset->GetNumberOfBlocks(); ++blockIndex)
+    {
+    vtkPolyData* currentPolyData = vtkPolyData::SafeDownCast(multiBlockDataset->GetBlock(blockIndex));
+    if (!currentPolyData)
+      {
+      continue;
+      }
+    vtkStringArray* idArray = vtkStringArray::SafeDownCast(
+      currentPolyData->GetFieldData()->GetAbstractArray(GetSegmentMetaDataKey(SINGLE_SEGMENT_INDEX, KEY_SEGMENT_ID).c_str()));
+    if (idArray && idArray->GetNumberOfValues() > 0)
+      {
+      segmentIDs.push_back(idArray->GetValue(0));
+      }
+    }
+  return true;
 }
 
 //----------------------------------------------------------------------------
@@ -248,6 +374,18 @@ bool vtkMRMLSegmentationStorageNode::CanReadInReferenceNode(vtkMRMLNode *refNode
   return refNode->IsA("vtkMRMLSegmentationNode");
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLSegmentationStorageNode::UpdateFromReadDataCopy(vtkMRMLStorageNode* storageNodeCopy, vtkMRMLNode* refNode)
+{
+  this->Superclass::UpdateFromReadDataCopy(storageNodeCopy, refNode);
+  // The node that the copy read into was not in the scene and so it could not create a display node
+  vtkMRMLSegmentationNode* segmentationNode = vtkMRMLSegmentationNode::SafeDownCast(refNode);
+  if (segmentationNode && segmentationNode->GetScene() && !segmentationNode->GetDisplayNode())
+    {
+    segmentationNode->CreateDefaultDisplayNodes();
+    }
+}
+
 //----------------------------------------------------------------------------
 int vtkMRMLSegmentationStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
 {
@@ -287,6 +425,17 @@ int vtkMRMLSegmentationStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
   else if (this->ReadBinaryLabelmapRepresentation4DSpatial(segmentationNode, fullName))
     {
     success = true;
+    // Legacy format reader loads all segments, remove the ones that were not requested
+    vtkSegmentation* segmentation = segmentationNode->GetSegmentation();
+    std::vector<std::string> segmentIDs;
+    segmentation->GetSegmentIDs(segmentIDs);
+    for (const std::string& segmentID : segmentIDs)
+      {
+      if (!this->IsSegmentToBeRead(segmentID))
+        {
+        segmentation->RemoveSegment(segmentID);
+        }
+      }
     }
 #endif
   else if (this->ReadPolyDataRepresentation(segmentationNode, fullName))
@@ -294,8 +443,9 @@ int vtkMRMLSegmentationStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
     success = true;
     }
 
-  // Create display node if segmentation there is none
-  if (success && !segmentationNode->GetDisplayNode())
+  // Create display node if segmentation there is none.
+  // Nodes read outside of the scene get their display node in UpdateFromReadDataCopy().
+  if (success && segmentationNode->GetScene() && !segmentationNode->GetDisplayNode())
     {
     segmentationNode->CreateDefaultDisplayNodes();
     }
@@ -570,6 +720,8 @@ int vtkMRMLSegmentationStorageNode::ReadBinaryLabelmapRepresentation(vtkMRMLSegm
 
   int numberOfSegments = 0;
   std::map<int, std::vector<int> > segmentIndexInLayer;
+  // Segments that are not in SegmentIDsToRead are not loaded
+  std::vector<bool> segmentToBeRead;
   std::string containedRepresentationNames;
   vtkMatrix4x4* rasToFileIjk = nullptr;
   int imageExtentInFile[6] = { 0, -1, 0, -1, 0, -1 };
@@ -644,6 +796,16 @@ int vtkMRMLSegmentationStorageNode::ReadBinaryLabelmapRepresentation(vtkMRMLSegm
     while (dictionary.HasKey(GetSegmentMetaDataKey(numberOfSegments, KEY_SEGMENT_ID)))
       {
       int segmentIndex = numberOfSegments;
+      std::string segmentID;
+      this->GetSegmentMetaDataFromDicitionary(segmentID, dictionary, segmentIndex, KEY_SEGMENT_ID);
+      bool toBeRead = this->IsSegmentToBeRead(segmentID);
+      segmentToBeRead.push_back(toBeRead);
+      ++numberOfSegments;
+      if (!toBeRead)
+        {
+        // Layers that only contain skipped segments are not extracted
+        continue;
+        }
       std::string layerValue;
       if (this->GetSegmentMetaDataFromDicitionary(layerValue, dictionary, segmentIndex, KEY_SEGMENT_LAYER))
         {
@@ -653,7 +815,6 @@ int vtkMRMLSegmentationStorageNode::ReadBinaryLabelmapRepresentation(vtkMRMLSegm
         {
         segmentIndexInLayer[segmentIndex].push_back(segmentIndex);
         }
-      ++numberOfSegments;
       }
     }
   else
@@ -869,6 +1030,11 @@ int vtkMRMLSegmentationStorageNode::ReadBinaryLabelmapRepresentation(vtkMRMLSegm
   // Add the created segments to the segmentation
   for (int segmentIndex = 0; segmentIndex < static_cast<int>(segments.size()); ++segmentIndex)
     {
+    if (numberOfSegments != 0 && !segmentToBeRead[segmentIndex])
+      {
+      // Segment is not requested
+      continue;
+      }
     vtkSegment* currentSegment = segments[segmentIndex];
     if (!currentSegment)
       {
@@ -1070,6 +1236,11 @@ int vtkMRMLSegmentationStorageNode::ReadPolyDataRepresentation(vtkMRMLSegmentati
       {
       currentSegmentID = idArray->GetValue(0);
       }
+    if (!this->IsSegmentToBeRead(currentSegmentID))
+      {
+      // Segment is not requested
+      continue;
+      }
     else
       {
       vtkWarningToMessageCollectionMacro(this->GetUserMessages(), "vtkMRMLSegmentationStorageNode::ReadPolyDataRepresentation",
@@ -1271,6 +1442,11 @@ int vtkMRMLSegmentationStorageNode::WriteBinaryLabelmapRepresentation(vtkMRMLSeg
   vtkNew<vtkTeemNRRDWriter> writer;
   writer->SetFileName(fullName.c_str());
   writer->SetUseCompression(this->GetUseCompression());
+  if (this->CompressionLevel >= 0)
+    {
+    writer->SetCompressionLevel(this->CompressionLevel);
+    }
+  writer->SetNumberOfThreads(this->NumberOfCompressionThreads);
   writer->SetSpace(nrrdSpaceLeftPosteriorSuperior);
   writer->SetMeasurementFrameMatrix(nullptr);
 
@@ -28,6 +28,11 @@
 // MRML includes
 #include "vtkMRMLStorageNode.h"
 
+// STD includes
+#include <set>
+#include <string>
+#include <vector>
+
 #ifdef SUPPORT_4D_SPATIAL_NRRD
   // ITK includes
   #include <itkImageRegionIteratorWithIndex.h>
@@ -97,6 +102,16 @@ public:
   /// Return true if the reference node can be read in
   bool CanReadInReferenceNode(vtkMRMLNode *refNode) override;
 
+  /// Segmentations are read into a separate segmentation, without accessing the scene.
+  bool CanReadInBackgroundThread() override { return true; }
+
+  /// Segmentations are written on the main thread because writing a labelmap collapses
+  /// the binary labelmap layers of the storable node.
+  bool CanWriteInBackgroundThread() override { return false; }
+
+  /// Create default display nodes after data was read by a copy of this node.
+  void UpdateFromReadDataCopy(vtkMRMLStorageNode* storageNodeCopy, vtkMRMLNode* refNode) override;
+
   /// Reset supported write file types. Called when source representation is changed
   void ResetSupportedWriteFileTypes();
 
@@ -111,6 +126,29 @@ public:
   vtkGetMacro(CropToMinimumExtent, bool);
   vtkBooleanMacro(CropToMinimumExtent, bool);
 
+  /// \brief Restrict reading to the specified segments.
+  ///
+  /// If the list is not empty then only segments with these IDs are loaded from the file
+  /// when the data is read. Labelmap layers that do not contain any of the requested segments
+  /// are not extracted from the file, which reduces memory usage and reading time when only a few segments
+  /// of a large segmentation are needed. Segment IDs that are not found in the file are ignored.
+  /// If the list is empty (default) then all segments are read.
+  /// Use GetSegmentIDsInFile() to get the list of segment IDs stored in a file.
+  /// Note that if the segmentation is written after partial reading then the file will only
+  /// contain the loaded segments. The value is not saved in the scene.
+  void SetSegmentIDsToRead(const std::vector<std::string>& segmentIDs);
+  void GetSegmentIDsToRead(std::vector<std::string>& segmentIDs);
+  void AddSegmentIDToRead(const std::string& segmentID);
+  void RemoveAllSegmentIDsToRead();
+
+  /// Get IDs of segments stored in a segmentation file without reading the segments.
+  /// For labelmap (.seg.nrrd) files only the image header is read.
+  /// For polygonal mesh (.vtm) files the segment IDs are stored in each segment file,
+  /// therefore all the segment files have to be read.
+  /// If path is empty then the file name of this storage node is used.
+  /// Returns false if the file could not be read.
+  bool GetSegmentIDsInFile(std::vector<std::string>& segmentIDs, const std::string& path = "");
+
 protected:
   /// Initialize all the supported read file types
   void InitializeSupportedReadFileTypes() override;
@@ -174,8 +212,12 @@ protected:
   static std::string GetSegmentColorAsString(vtkMRMLSegmentationNode* segmentationNode, const std::string& segmentId);
   static void GetSegmentColorFromString(double color[3], std::string colorString);
 
+  /// Returns true if the segment is to be read (see SetSegmentIDsToRead)
+  bool IsSegmentToBeRead(const std::string& segmentID);
+
 protected:
   bool CropToMinimumExtent{false};
+  std::set<std::string> SegmentIDsToRead;
 
 protected:
   vtkMRMLSegmentationStorageNode();
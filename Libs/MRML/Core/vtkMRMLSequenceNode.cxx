@@ -20,6 +20,7 @@
 #include "vtkMRMLSequenceNode.h"
 #include "vtkMRMLSequenceStorageNode.h"
 #include "vtkMRMLStorableNode.h"
+#include "vtkMRMLVolumeNode.h"
 
 // MRML includes
 #include <vtkMRMLScene.h>
@@ -47,6 +48,24 @@
     this->Modified(); \
   }
 
+//------------------------------------------------------------------------------
+namespace
+{
+/// Get the name that data nodes created from this node are named after
+std::string GetDataNodeBaseName(vtkMRMLNode* node)
+{
+  if (node->GetAttribute("Sequences.BaseName") != 0)
+    {
+    return node->GetAttribute("Sequences.BaseName");
+    }
+  else if (node->GetName() != 0)
+    {
+    return node->GetName();
+    }
+  return "Data";
+}
+}
+
 //------------------------------------------------------------------------------
 vtkMRMLNodeNewMacro(vtkMRMLSequenceNode);
 vtkCxxSetVariableInDataAndStorageNodeMacro(IndexName, const std::string&);
@@ -79,6 +98,8 @@ vtkMRMLSequenceNode::~vtkMRMLSequenceNode()
 void vtkMRMLSequenceNode::RemoveAllDataNodes()
 {
   this->IndexEntries.clear();
+  this->TextIndexLookupValid = false;
+  this->RecentlyUsedDataNodes.clear();
   if (!this->SequenceScene)
     {
     return;
@@ -190,6 +211,7 @@ void vtkMRMLSequenceNode::ReadIndexValues(const std::string& indexText)
     this->IndexEntries.clear();
     modified = true;
     }
+  this->TextIndexLookupValid = false;
 
   std::stringstream ss(indexText);
   std::string nodeId_indexValue;
@@ -203,6 +225,7 @@ void vtkMRMLSequenceNode::ReadIndexValues(const std::string& indexText)
 
       IndexEntryType indexEntry;
       indexEntry.IndexValue=indexValue;
+      indexEntry.NumericIndexValue=atof(indexValue.c_str());
       // The nodes are not read yet, so we can only store the node ID and get the pointer to the node later (in UpdateScene())
       indexEntry.DataNodeID=nodeId;
       indexEntry.DataNode=nullptr;
@@ -268,10 +291,12 @@ void vtkMRMLSequenceNode::Copy(vtkMRMLNode *anode)
   bool mapDataNodeIds = !sourceToTargetDataNodeID.empty();
 
   this->IndexEntries.clear();
+  this->TextIndexLookupValid = false;
   for(std::deque< IndexEntryType >::iterator sourceIndexIt=snode->IndexEntries.begin(); sourceIndexIt!=snode->IndexEntries.end(); ++sourceIndexIt)
     {
     IndexEntryType seqItem;
     seqItem.IndexValue=sourceIndexIt->IndexValue;
+    seqItem.NumericIndexValue=sourceIndexIt->NumericIndexValue;
     seqItem.DataNode = nullptr;
     if (sourceIndexIt->DataNode!=nullptr)
       {
@@ -309,10 +334,12 @@ void vtkMRMLSequenceNode::CopySequenceIndex(vtkMRMLNode *anode)
   if (this->IndexEntries.size() > 0 || snode->IndexEntries.size() > 0)
     {
     this->IndexEntries.clear();
+    this->TextIndexLookupValid = false;
     for (std::deque< IndexEntryType >::iterator sourceIndexIt = snode->IndexEntries.begin(); sourceIndexIt != snode->IndexEntries.end(); ++sourceIndexIt)
       {
       IndexEntryType seqItem;
       seqItem.IndexValue = sourceIndexIt->IndexValue;
+      seqItem.NumericIndexValue = sourceIndexIt->NumericIndexValue;
       if (sourceIndexIt->DataNode != nullptr)
         {
         seqItem.DataNodeID = sourceIndexIt->DataNode->GetID();
@@ -340,6 +367,7 @@ void vtkMRMLSequenceNode::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "indexType: " << indexTypeString << "\n";
 
   os << indent << "numericIndexValueTolerance: " << this->NumericIndexValueTolerance << "\n";
+  os << indent << "maximumNumberOfLoadedDataNodes: " << this->MaximumNumberOfLoadedDataNodes << "\n";
 
   os << indent << "indexValues: ";
   if (this->IndexEntries.empty())
@@ -386,7 +414,7 @@ int vtkMRMLSequenceNode::GetInsertPosition(const std::string& indexValue)
     {
     int itemNumber = this->GetItemNumberFromIndexValue(indexValue, false);
     double numericIndexValue = atof(indexValue.c_str());
-    double foundNumericIndexValue = atof(this->IndexEntries[itemNumber].IndexValue.c_str());
+    double foundNumericIndexValue = this->IndexEntries[itemNumber].NumericIndexValue;
     if (numericIndexValue < foundNumericIndexValue) // Deals with case of index value being smaller than any in the sequence and numeric tolerances
       {
       insertPosition = itemNumber;
@@ -412,6 +440,37 @@ vtkMRMLNode* vtkMRMLSequenceNode::SetDataNodeAtValue(vtkMRMLNode* node, const st
   this->GetSequenceScene();
   // Add a copy of the node to the sequence's scene
   vtkMRMLNode* newNode = this->DeepCopyNodeToScene(node, this->SequenceScene);
+  this->SetSequenceSceneDataNodeAtValue(newNode, indexValue);
+  return newNode;
+}
+
+//----------------------------------------------------------------------------
+vtkMRMLNode* vtkMRMLSequenceNode::SetDataNodeAtValueWithoutCopy(vtkMRMLNode* node, const std::string& indexValue)
+{
+  if (node == nullptr)
+    {
+    vtkErrorMacro("vtkMRMLSequenceNode::SetDataNodeAtValueWithoutCopy failed, invalid node");
+    return nullptr;
+    }
+  if (node->GetScene() != nullptr)
+    {
+    vtkErrorMacro("vtkMRMLSequenceNode::SetDataNodeAtValueWithoutCopy failed, node is already in a scene");
+    return nullptr;
+    }
+  MRMLNodeModifyBlocker blocker(this);
+  // Make sure the sequence scene is created
+  this->GetSequenceScene();
+  std::string baseName = GetDataNodeBaseName(node);
+  node->SetName(baseName.c_str());
+  node->SetAttribute("Sequences.BaseName", baseName.c_str());
+  vtkMRMLNode* newNode = this->SequenceScene->AddNode(node);
+  this->SetSequenceSceneDataNodeAtValue(newNode, indexValue);
+  return newNode;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSequenceNode::SetSequenceSceneDataNodeAtValue(vtkMRMLNode* newNode, const std::string& indexValue)
+{
   vtkMRMLNode* oldNode = nullptr;
   int seqItemIndex = this->GetItemNumberFromIndexValue(indexValue);
   if (seqItemIndex >= 0)
@@ -425,6 +484,19 @@ vtkMRMLNode* vtkMRMLSequenceNode::SetDataNodeAtValue(vtkMRMLNode* node, const st
     // Create new item
     IndexEntryType seqItem;
     seqItem.IndexValue = indexValue;
+    seqItem.NumericIndexValue = atof(indexValue.c_str());
+    if (this->TextIndexLookupValid)
+      {
+      if (seqItemIndex == static_cast<int>(this->IndexEntries.size()))
+        {
+        // Appending an item (always the case for text index) does not change item numbers of existing items
+        this->TextIndexLookup.emplace(indexValue, seqItemIndex);
+        }
+      else
+        {
+        this->TextIndexLookupValid = false;
+        }
+      }
     this->IndexEntries.insert(this->IndexEntries.begin() + seqItemIndex, seqItem);
     }
   this->IndexEntries[seqItemIndex].DataNode = newNode;
@@ -444,7 +516,6 @@ vtkMRMLNode* vtkMRMLSequenceNode::SetDataNodeAtValue(vtkMRMLNode* node, const st
 
   this->Modified();
   this->StorableModifiedTime.Modified();
-  return newNode;
 }
 
 //----------------------------------------------------------------------------
@@ -468,6 +539,7 @@ void vtkMRMLSequenceNode::RemoveDataNodeAtValue(const std::string& indexValue)
     this->SequenceScene->RemoveNode(dataNode);
     }
   this->IndexEntries.erase(this->IndexEntries.begin()+seqItemIndex);
+  this->TextIndexLookupValid = false;
   this->Modified();
   this->StorableModifiedTime.Modified();
 }
@@ -489,8 +561,8 @@ int vtkMRMLSequenceNode::GetItemNumberFromIndexValue(const std::string& indexVal
 
     // Deal with index values not within the range of index values in the Sequence
     double numericIndexValue = atof(indexValue.c_str());
-    double lowerNumericIndexValue = atof(this->IndexEntries[lowerBound].IndexValue.c_str());
-    double upperNumericIndexValue = atof(this->IndexEntries[upperBound].IndexValue.c_str());
+    double lowerNumericIndexValue = this->IndexEntries[lowerBound].NumericIndexValue;
+    double upperNumericIndexValue = this->IndexEntries[upperBound].NumericIndexValue;
     if (numericIndexValue <= lowerNumericIndexValue + this->NumericIndexValueTolerance)
       {
       if (numericIndexValue < lowerNumericIndexValue - this->NumericIndexValueTolerance && exactMatchRequired)
@@ -518,7 +590,7 @@ int vtkMRMLSequenceNode::GetItemNumberFromIndexValue(const std::string& indexVal
       {
       // Note that if middle is equal to either lowerBound or upperBound then upperBound - lowerBound <= 1
       int middle = int((lowerBound + upperBound)/2);
-      double middleNumericIndexValue = atof(this->IndexEntries[middle].IndexValue.c_str());
+      double middleNumericIndexValue = this->IndexEntries[middle].NumericIndexValue;
       if (fabs(numericIndexValue - middleNumericIndexValue) <= this->NumericIndexValueTolerance)
         {
         return middle;
@@ -538,16 +610,31 @@ int vtkMRMLSequenceNode::GetItemNumberFromIndexValue(const std::string& indexVal
       }
     }
 
-  // Need linear search for non-numeric index
-  for (int i=0; i<numberOfSeqItems; i++)
+  // Need exact string match for non-numeric index
+  return this->GetItemNumberFromTextIndexValue(indexValue);
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLSequenceNode::GetItemNumberFromTextIndexValue(const std::string& indexValue)
+{
+  if (!this->TextIndexLookupValid)
     {
-    if (this->IndexEntries[i].IndexValue.compare(indexValue)==0)
+    this->TextIndexLookup.clear();
+    this->TextIndexLookup.reserve(this->IndexEntries.size());
+    int numberOfSeqItems = this->IndexEntries.size();
+    for (int i = 0; i < numberOfSeqItems; i++)
       {
-      return i;
+      // emplace does not overwrite existing values, so the first item is found if multiple items have the same index value
+      this->TextIndexLookup.emplace(this->IndexEntries[i].IndexValue, i);
       }
+    this->TextIndexLookupValid = true;
     }
-
-  return -1;
+  std::unordered_map<std::string, int>::iterator foundIt = this->TextIndexLookup.find(indexValue);
+  if (foundIt == this->TextIndexLookup.end())
+    {
+    return -1;
+    }
+  return foundIt->second;
 }
 
 //---------------------------------------------------------------------------
@@ -564,7 +651,7 @@ vtkMRMLNode* vtkMRMLSequenceNode::GetDataNodeAtValue(const std::string& indexVal
     // not found
     return nullptr;
     }
-  return this->IndexEntries[seqItemIndex].DataNode;
+  return this->GetNthDataNode(seqItemIndex);
 }
 
 //---------------------------------------------------------------------------
@@ -605,6 +692,8 @@ bool vtkMRMLSequenceNode::UpdateIndexValue(const std::string& oldIndexValue, con
     }
   // Update the index value
   this->IndexEntries[oldSeqItemIndex].IndexValue = newIndexValue;
+  this->IndexEntries[oldSeqItemIndex].NumericIndexValue = atof(newIndexValue.c_str());
+  this->TextIndexLookupValid = false;
   if (this->IndexType == vtkMRMLSequenceNode::NumericIndex)
     {
     IndexEntryType movingEntry = this->IndexEntries[oldSeqItemIndex];
@@ -668,7 +757,52 @@ vtkMRMLNode* vtkMRMLSequenceNode::GetNthDataNode(int itemNumber)
     vtkErrorMacro("vtkMRMLSequenceNode::GetNthDataNode failed: itemNumber "<<itemNumber<<" is out of range");
     return nullptr;
     }
-  return this->IndexEntries[itemNumber].DataNode;
+  vtkMRMLNode* dataNode = this->IndexEntries[itemNumber].DataNode;
+  if (this->MaximumNumberOfLoadedDataNodes > 0 && dataNode)
+    {
+    this->ReleaseDataOfLeastRecentlyUsedDataNodes(dataNode);
+    }
+  return dataNode;
+}
+
+//-----------------------------------------------------------------------------
+void vtkMRMLSequenceNode::ReleaseDataOfLeastRecentlyUsedDataNodes(vtkMRMLNode* retrievedNode)
+{
+  if (!vtkMRMLStorableNode::SafeDownCast(retrievedNode))
+    {
+    // only storable nodes can be released
+    return;
+    }
+  if (this->RecentlyUsedDataNodes.empty() || this->RecentlyUsedDataNodes.front() != retrievedNode)
+    {
+    for (auto nodeIt = this->RecentlyUsedDataNodes.begin(); nodeIt != this->RecentlyUsedDataNodes.end(); ++nodeIt)
+      {
+      if (*nodeIt == retrievedNode)
+        {
+        this->RecentlyUsedDataNodes.erase(nodeIt);
+        break;
+        }
+      }
+    this->RecentlyUsedDataNodes.push_front(retrievedNode);
+    }
+  while (static_cast<int>(this->RecentlyUsedDataNodes.size()) > this->MaximumNumberOfLoadedDataNodes)
+    {
+    vtkMRMLStorableNode* storableNode = vtkMRMLStorableNode::SafeDownCast(this->RecentlyUsedDataNodes.back());
+    this->RecentlyUsedDataNodes.pop_back();
+    if (storableNode)
+      {
+      // If data cannot be released (e.g., it is modified) then it is kept in memory,
+      // compressed if possible
+      if (!storableNode->ReleaseData() && this->CompressDataNodesInMemory)
+        {
+        vtkMRMLVolumeNode* volumeNode = vtkMRMLVolumeNode::SafeDownCast(storableNode);
+        if (volumeNode)
+          {
+          volumeNode->CompressDataInMemory();
+          }
+        }
+      }
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -695,6 +829,20 @@ vtkMRMLStorageNode* vtkMRMLSequenceNode::CreateDefaultStorageNode()
     scene->CreateNodeByClass(this->GetDefaultStorageNodeClassName().c_str()));
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkMRMLSequenceNode::GetDataMemorySize()
+{
+  unsigned long memorySize = 0;
+  for (IndexEntryType& indexEntry : this->IndexEntries)
+    {
+    if (indexEntry.DataNode)
+      {
+      memorySize += indexEntry.DataNode->GetDataMemorySize();
+      }
+    }
+  return memorySize;
+}
+
 //-----------------------------------------------------------
 std::string vtkMRMLSequenceNode::GetDefaultStorageNodeClassName(const char* filename /* =nullptr */)
 {
@@ -806,15 +954,7 @@ vtkMRMLNode* vtkMRMLSequenceNode::DeepCopyNodeToScene(vtkMRMLNode* source, vtkMR
     vtkGenericWarningMacro("vtkMRMLSequenceNode::DeepCopyNodeToScene failed, invalid node");
     return nullptr;
     }
-  std::string baseName = "Data";
-  if (source->GetAttribute("Sequences.BaseName") != 0)
-    {
-    baseName = source->GetAttribute("Sequences.BaseName");
-    }
-  else if (source->GetName() != 0)
-    {
-    baseName = source->GetName();
-    }
+  std::string baseName = GetDataNodeBaseName(source);
   std::string newNodeName = baseName;
 
   vtkSmartPointer<vtkMRMLNode> target = vtkSmartPointer<vtkMRMLNode>::Take(source->CreateNodeInstance());
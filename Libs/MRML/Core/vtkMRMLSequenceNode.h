@@ -25,6 +25,7 @@
 // std includes
 #include <deque>
 #include <set>
+#include <unordered_map>
 
 
 /// \brief MRML node for representing a sequence of MRML nodes
@@ -107,6 +108,13 @@ public:
   /// Returns the data node copy that has just been created.
   vtkMRMLNode* SetDataNodeAtValue(vtkMRMLNode* node, const std::string& indexValue);
 
+  /// Add the provided node to this sequence as a data node, without making a copy of it.
+  /// This is faster than SetDataNodeAtValue when the node is already a copy that
+  /// is not used anywhere else (for example, a snapshot that is taken during recording).
+  /// The node must not be in any scene.
+  /// Returns the added data node, nullptr on error.
+  vtkMRMLNode* SetDataNodeAtValueWithoutCopy(vtkMRMLNode* node, const std::string& indexValue);
+
   /// Update an existing data node.
   /// Return true if a data node was found by that index.
   bool UpdateDataNodeAtValue(vtkMRMLNode* node, const std::string& indexValue, bool shallowCopy = false);
@@ -122,6 +130,7 @@ public:
   vtkMRMLNode* GetDataNodeAtValue(const std::string& indexValue, bool exactMatchRequired = true);
 
   /// Get the data node corresponding to the n-th index value
+  /// \sa MaximumNumberOfLoadedDataNodes
   vtkMRMLNode* GetNthDataNode(int itemNumber);
 
   /// Index value of n-th data node.
@@ -152,6 +161,9 @@ public:
   /// requests a more specific storage node class.
   vtkMRMLStorageNode* CreateDefaultStorageNode() override;
 
+  /// Total memory size of the data of all data nodes stored in the sequence.
+  unsigned long GetDataMemorySize() override;
+
   /// Returns the most specific storage node possible (such as vtkMRMLVolumeSequenceStorageNode
   /// if sequence contains volumes with the same type and geometry, or vtkMRMLLinearTransformSequenceStorageNode
   /// if sequence contains a list of linear transforms) and generic vtkMRMLSequenceStorageNode otherwise.
@@ -160,6 +172,35 @@ public:
   /// Update node IDs in case of node ID conflicts on scene import
   void UpdateScene(vtkMRMLScene *scene) override;
 
+  /// \brief Limit the number of data nodes that keep their data in memory.
+  ///
+  /// If the value is larger than zero then each time a data node is retrieved
+  /// (by GetNthDataNode() or GetDataNodeAtValue()), data of the least recently
+  /// retrieved data nodes is released (see vtkMRMLStorableNode::ReleaseData()) so that
+  /// at most this many data nodes have their data in memory. Released data is read
+  /// from file again when it is accessed.
+  /// This is useful for replaying long sequences that are read from a sequence bundle
+  /// (.seq.mrb) when the scene's ReadDataOnDemand is enabled, as then each data node is
+  /// extracted and read from the bundle only when it is needed.
+  /// Data of nodes that cannot be read again (for example, it is modified since read) is kept.
+  /// Set to 0 (default) to keep data of all data nodes in memory.
+  /// The value is not saved in the scene.
+  vtkSetMacro(MaximumNumberOfLoadedDataNodes, int);
+  vtkGetMacro(MaximumNumberOfLoadedDataNodes, int);
+
+  /// \brief Compress data of volume data nodes in memory if it cannot be released.
+  ///
+  /// If enabled and data of a least recently retrieved volume data node cannot be released
+  /// (because it cannot be read from file again, for example, it is recorded in this session)
+  /// then its voxels are compressed in memory instead (see vtkMRMLVolumeNode::CompressDataInMemory()).
+  /// Voxels are decompressed automatically when the data node is accessed again.
+  /// This allows keeping long volume sequences in memory, while MaximumNumberOfLoadedDataNodes
+  /// specifies how many recently used items are kept decompressed.
+  /// Disabled by default. The value is not saved in the scene.
+  vtkSetMacro(CompressDataNodesInMemory, bool);
+  vtkGetMacro(CompressDataNodesInMemory, bool);
+  vtkBooleanMacro(CompressDataNodesInMemory, bool);
+
   /// Type of the index. Controls the behavior of sorting, finding, etc.
   /// Additional types may be added in the future, such as tag cloud, two-dimensional index, ...
   enum IndexTypes
@@ -183,9 +224,22 @@ protected:
 
   vtkMRMLNode* DeepCopyNodeToScene(vtkMRMLNode* source, vtkMRMLScene* scene);
 
+  /// Add a data node that is already in the sequence scene at the specified index value.
+  /// Replaces the existing data node at the same index value.
+  void SetSequenceSceneDataNodeAtValue(vtkMRMLNode* newNode, const std::string& indexValue);
+
+  /// Release data of least recently retrieved data nodes if there are more than MaximumNumberOfLoadedDataNodes.
+  void ReleaseDataOfLeastRecentlyUsedDataNodes(vtkMRMLNode* retrievedNode);
+
+  /// Get item number of an index value by exact string match.
+  /// Uses a hash map that is rebuilt if the index entries changed.
+  int GetItemNumberFromTextIndexValue(const std::string& indexValue);
+
   struct IndexEntryType
     {
     std::string IndexValue;
+    /// Numeric value of IndexValue (parsed when IndexValue is set, to avoid parsing it at each comparison)
+    double NumericIndexValue{0.0};
     vtkWeakPointer<vtkMRMLNode> DataNode;
     std::string DataNodeID; // only used temporarily, during scene load
     };
@@ -204,6 +258,16 @@ protected:
 
   /// List of data items (the scene may contain some more nodes, such as storage nodes)
   std::deque< IndexEntryType > IndexEntries;
+
+  /// Map from index value to item number, for fast lookup of text index values.
+  /// Only valid if TextIndexLookupValid is true, must be invalidated when IndexEntries is changed.
+  std::unordered_map<std::string, int> TextIndexLookup;
+  bool TextIndexLookupValid{false};
+
+  int MaximumNumberOfLoadedDataNodes{0};
+  bool CompressDataNodesInMemory{false};
+  /// Data nodes in the order they were retrieved (most recently retrieved first).
+  std::deque< vtkWeakPointer<vtkMRMLNode> > RecentlyUsedDataNodes;
 };
 
 #endif
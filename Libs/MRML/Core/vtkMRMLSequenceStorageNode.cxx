@@ -110,7 +110,13 @@ int vtkMRMLSequenceStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
   if (extension == std::string(".mrb"))
     {
     vtkMRMLScene* sequenceScene = sequenceNode->GetSequenceScene();
+    // If the scene reads data on demand then each data node is extracted from the bundle
+    // only when its data is accessed, which allows replaying long sequences without reading
+    // all of them into memory (see vtkMRMLSequenceNode::SetMaximumNumberOfLoadedDataNodes).
+    bool wasReadDataOnDemand = sequenceScene->GetReadDataOnDemand();
+    sequenceScene->SetReadDataOnDemand(this->GetScene() && this->GetScene()->GetReadDataOnDemand());
     success = sequenceScene->ReadFromMRB(fullName.c_str(), this->GetUserMessages());
+    sequenceScene->SetReadDataOnDemand(wasReadDataOnDemand);
     if (success)
       {
       // Remove scene view nodes, as they would interfere with re-saving of the embedded scene
@@ -174,8 +180,10 @@ int vtkMRMLSequenceStorageNode::WriteDataInternal(vtkMRMLNode *refNode)
   bool success = false;
   if (extension == ".mrb")
     {
-    this->ForceUniqueDataNodeFileNames(sequenceNode); // Prevents storable nodes' files from being overwritten due to the same node name
     vtkMRMLScene *sequenceScene=sequenceNode->GetSequenceScene();
+    // Data nodes that are not read from the sequence bundle yet must be read before their file names are changed
+    sequenceScene->ReadPendingData();
+    this->ForceUniqueDataNodeFileNames(sequenceNode); // Prevents storable nodes' files from being overwritten due to the same node name
 
     // Save sequence index information in the bundle file so that users can load
     // a sequence just from a .seq.mrb file
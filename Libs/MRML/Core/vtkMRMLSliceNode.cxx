@@ -89,6 +89,8 @@ vtkMRMLSliceNode::vtkMRMLSliceNode()
   this->SlabReconstructionThickness = 1.;
   this->SlabReconstructionOversamplingFactor = 2.0;
 
+  this->GPURenderingEnabled = false;
+
   this->XYZOrigin[0] = 0;
   this->XYZOrigin[1] = 0;
   this->XYZOrigin[2] = 0;
@@ -914,6 +916,7 @@ void vtkMRMLSliceNode::WriteXML(ostream& of, int nIndent)
   vtkMRMLWriteXMLEnumMacro(slabReconstructionType, SlabReconstructionType);
   vtkMRMLWriteXMLFloatMacro(slabReconstructionThickness, SlabReconstructionThickness);
   vtkMRMLWriteXMLFloatMacro(slabReconstructionOversamplingFactor, SlabReconstructionOversamplingFactor);
+  vtkMRMLWriteXMLBooleanMacro(gpuRenderingEnabled, GPURenderingEnabled);
 
   vtkMRMLWriteXMLEndMacro();
 }
@@ -1006,6 +1009,7 @@ void vtkMRMLSliceNode::ReadXMLAttributes(const char** atts)
   vtkMRMLReadXMLEnumMacro(slabReconstructionType, SlabReconstructionType);
   vtkMRMLReadXMLFloatMacro(slabReconstructionThickness, SlabReconstructionThickness);
   vtkMRMLReadXMLFloatMacro(slabReconstructionOversamplingFactor, SlabReconstructionOversamplingFactor);
+  vtkMRMLReadXMLBooleanMacro(gpuRenderingEnabled, GPURenderingEnabled);
 
   vtkMRMLReadXMLEndMacro();
 
@@ -1124,6 +1128,7 @@ void vtkMRMLSliceNode::CopyContent(vtkMRMLNode* anode, bool deepCopy/*=true*/)
   vtkMRMLCopyEnumMacro(SlabReconstructionType);
   vtkMRMLCopyFloatMacro(SlabReconstructionThickness);
   vtkMRMLCopyFloatMacro(SlabReconstructionOversamplingFactor);
+  vtkMRMLCopyBooleanMacro(GPURenderingEnabled);
 
   vtkMRMLCopyEndMacro();
 
@@ -1223,6 +1228,7 @@ void vtkMRMLSliceNode::PrintSelf(ostream& os, vtkIndent indent)
   vtkMRMLPrintEnumMacro(SlabReconstructionType);
   vtkMRMLPrintFloatMacro(SlabReconstructionThickness);
   vtkMRMLPrintFloatMacro(SlabReconstructionOversamplingFactor);
+  vtkMRMLPrintBooleanMacro(GPURenderingEnabled);
 
   vtkMRMLPrintEndMacro();
 }
@@ -552,6 +552,21 @@ public:
   vtkSetMacro(SlabReconstructionOversamplingFactor, double);
   /// @}
 
+  /// @{
+  /// Get/set GPU rendering of the slice.
+  /// If enabled, the layer volumes are uploaded to the graphics card as 3D
+  /// textures and resliced, mapped through window/level and lookup table,
+  /// outlined and blended in a fragment shader instead of the CPU
+  /// pipeline of vtkMRMLSliceLogic. Views fall back to the CPU pipeline
+  /// when the slice cannot be rendered on the GPU (e.g. slab reconstruction,
+  /// lightbox layout, non-linear transforms or multi-component volumes).
+  /// Disabled by default.
+  /// \sa vtkMRMLSliceLogic::IsGPURenderingActive()
+  vtkGetMacro(GPURenderingEnabled, bool);
+  vtkSetMacro(GPURenderingEnabled, bool);
+  vtkBooleanMacro(GPURenderingEnabled, bool);
+  /// @}
+
 protected:
   vtkMRMLSliceNode();
   ~vtkMRMLSliceNode() override;
@@ -592,6 +607,8 @@ protected:
   double SlabReconstructionThickness;
   double SlabReconstructionOversamplingFactor;
 
+  bool GPURenderingEnabled;
+
   // Hold the string returned by GetOrientationString
   std::string OrientationString;
 
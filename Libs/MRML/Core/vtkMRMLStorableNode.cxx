@@ -22,8 +22,10 @@ Version:   $Revision: 1.3 $
 
 // VTK includes
 #include <vtkCallbackCommand.h>
+#include <vtksys/SystemTools.hxx>
 
 // STD includes
+#include <algorithm>
 #include <sstream>
 
 const char* vtkMRMLStorableNode::StorageNodeReferenceRole = "storage";
@@ -269,6 +271,7 @@ void vtkMRMLStorableNode::PrintSelf(ostream& os, vtkIndent indent)
 {
 
   Superclass::PrintSelf(os,indent);
+  os << indent << "DataReadPending: " << (this->DataReadPending ? "true" : "false") << "\n";
   if (this->UserTagTable->GetNumberOfTags() > 0)
     {
     os << indent << "UserTagTable:\n";
@@ -296,6 +299,95 @@ void vtkMRMLStorableNode::UpdateScene(vtkMRMLScene *scene)
     return;
     }
 
+  if (scene && scene->GetReadDataOnDemand() && scene->GetReadDataOnLoad())
+    {
+    // Only record that data has to be read, actual reading happens at first access
+    int numStorageNodes = this->GetNumberOfNodeReferences(this->GetStorageNodeReferenceRole());
+    for (int i = 0; i < numStorageNodes; i++)
+      {
+      vtkMRMLStorageNode* storageNode = this->GetNthStorageNode(i);
+      if (!storageNode)
+        {
+        continue;
+        }
+      this->DataReadPending = true;
+      if (storageNode->GetFileName())
+        {
+        scene->PrefetchFile(storageNode->GetFullNameFromFileName());
+        }
+      for (int fileIndex = 0; fileIndex < storageNode->GetNumberOfFileNames(); fileIndex++)
+        {
+        scene->PrefetchFile(storageNode->GetFullNameFromNthFileName(fileIndex));
+        }
+      }
+    return;
+    }
+
+  this->ReadDataFromStorageNodes();
+}
+
+//-----------------------------------------------------------
+bool vtkMRMLStorableNode::ReadPendingData()
+{
+  if (!this->DataReadPending)
+    {
+    return true;
+    }
+  // Clear the flag before reading, as storage nodes access the node's data while reading
+  this->DataReadPending = false;
+  return this->ReadPendingDataInternal();
+}
+
+//-----------------------------------------------------------
+bool vtkMRMLStorableNode::ReleaseData()
+{
+  if (this->DataReadPending)
+    {
+    // already released
+    return true;
+    }
+  int numStorageNodes = this->GetNumberOfNodeReferences(this->GetStorageNodeReferenceRole());
+  if (numStorageNodes == 0)
+    {
+    return false;
+    }
+  if (this->GetModifiedSinceRead())
+    {
+    // data would be lost, even if it was read from an open bundle
+    return false;
+    }
+  vtkMRMLScene* scene = this->GetScene();
+  for (int i = 0; i < numStorageNodes; i++)
+    {
+    vtkMRMLStorageNode* storageNode = this->GetNthStorageNode(i);
+    if (!storageNode)
+      {
+      return false;
+      }
+    if (scene && scene->CanReadBundleFiles(storageNode))
+      {
+      // file is extracted from the bundle when data is read again
+      continue;
+      }
+    if (!storageNode->GetFileName()
+      || !vtksys::SystemTools::FileExists(storageNode->GetFullNameFromFileName(), true))
+      {
+      // data would be lost
+      return false;
+      }
+    }
+  if (!this->ReleaseDataInternal())
+    {
+    return false;
+    }
+  this->DataReadPending = true;
+  return true;
+}
+
+//-----------------------------------------------------------
+bool vtkMRMLStorableNode::ReadDataFromStorageNodes()
+{
+  bool success = true;
   std::string errorMessages;
 
   int numStorageNodes = this->GetNumberOfNodeReferences(this->GetStorageNodeReferenceRole());
@@ -318,12 +410,23 @@ void vtkMRMLStorableNode::UpdateScene(vtkMRMLScene *scene)
         }
       vtkDebugMacro("UpdateScene: calling ReadData, fname = " << fname.c_str());
       pnode->GetUserMessages()->ClearMessages();
-      if (pnode->ReadData(this) == 0)
+      // Files in a scene bundle that is read on demand are extracted just before reading
+      vtkMRMLScene* scene = this->GetScene();
+      bool readFromBundle = (scene && scene->BeginReadBundleFiles(pnode));
+      int readSuccess = pnode->ReadData(this);
+      if (readFromBundle)
+        {
+        scene->EndReadBundleFiles(pnode);
+        // extracted files are removed, the data is only stored in the bundle
+        this->BundleReadTime.Modified();
+        }
+      if (readSuccess == 0)
         {
         std::string msg = std::string("Failed to read node ") + (this->GetName() ? this->GetName() : "(null)")
           + " (" + (this->GetID() ? this->GetID() : "(null)") + ") using storage node "
           + (pnode->GetID() ? pnode->GetID() : "(null)") + ".";
         vtkErrorMacro("vtkMRMLStorableNode::UpdateScene failed: " << msg);
+        success = false;
         errorMessages += msg;
         std::string details = pnode->GetUserMessages()->GetAllMessagesAsString();
         if (!details.empty())
@@ -341,6 +444,7 @@ void vtkMRMLStorableNode::UpdateScene(vtkMRMLScene *scene)
       vtkErrorMacro("UpdateScene: error getting " << i << "th storage node, id = " << (this->GetNthStorageNodeID(i) == nullptr ? "null" : this->GetNthStorageNodeID(i)));
       }
     }
+  return success;
 }
 
 vtkMRMLStorageNode* vtkMRMLStorableNode::GetNthStorageNode(int n)
@@ -404,10 +508,46 @@ vtkMRMLStorageNode* vtkMRMLStorableNode::CreateDefaultStorageNode()
 //---------------------------------------------------------------------------
 bool vtkMRMLStorableNode::GetModifiedSinceRead()
 {
+  if (this->DataReadPending)
+    {
+    // data has not been read from file yet, therefore it cannot be modified
+    return false;
+    }
   vtkTimeStamp storedTime = this->GetStoredTime();
+  if (storedTime < this->BundleReadTime)
+    {
+    // Data was read from a scene bundle and has not been written to a file since then.
+    // It is not modified as long as it can be read from the bundle again.
+    return this->BundleReadTime < this->StorableModifiedTime || !this->CanReadDataFromBundle();
+    }
   return storedTime < this->StorableModifiedTime;
 }
 
+//---------------------------------------------------------------------------
+bool vtkMRMLStorableNode::CanReadDataFromBundle()
+{
+  vtkMRMLScene* scene = this->GetScene();
+  int numStorageNodes = this->GetNumberOfNodeReferences(this->GetStorageNodeReferenceRole());
+  if (!scene || numStorageNodes == 0)
+    {
+    return false;
+    }
+  for (int i = 0; i < numStorageNodes; i++)
+    {
+    if (!scene->CanReadBundleFiles(this->GetNthStorageNode(i)))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//---------------------------------------------------------------------------
+vtkMTimeType vtkMRMLStorableNode::GetContentMTime()
+{
+  return std::max(this->Superclass::GetContentMTime(), this->StorableModifiedTime.GetMTime());
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLStorableNode::StorableModified()
 {
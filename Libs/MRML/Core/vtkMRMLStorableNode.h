@@ -156,6 +156,34 @@ public:
   /// \sa GetStoredTime() StorableModifiedTime Modified() GetModifiedSinceRead()
   virtual void StorableModified();
 
+  /// Reimplemented to take into account the storable modified time.
+  /// \sa StorableModifiedTime
+  vtkMTimeType GetContentMTime() override;
+
+  /// Returns true if reading of the node's data from file was deferred
+  /// and the data has not been read yet.
+  /// \sa vtkMRMLScene::SetReadDataOnDemand(), ReadPendingData()
+  vtkGetMacro(DataReadPending, bool);
+  /// Set pending data read flag. It is only intended to be used by vtkMRMLScene,
+  /// when pending data is read outside of ReadPendingData().
+  vtkSetMacro(DataReadPending, bool);
+
+  /// Read the node's data from file if reading was deferred when the scene was imported.
+  /// It is called automatically when the data is first accessed (for example,
+  /// by vtkMRMLVolumeNode::GetImageData() or vtkMRMLModelNode::GetMesh()).
+  /// Returns false if reading of the data failed.
+  /// \sa vtkMRMLScene::SetReadDataOnDemand(), GetDataReadPending()
+  bool ReadPendingData();
+
+  /// Remove the node's data from memory and mark it as pending, so that it is
+  /// read from file again when it is accessed next time (see ReadPendingData()).
+  /// Data is only released if it can be read again: it is not modified since it
+  /// was read from a file that still exists, or it is in a scene bundle that is
+  /// open for on-demand reading.
+  /// Returns false if the data could not be released.
+  /// \sa vtkMRMLScene::CanReadBundleFiles(), ReleaseDataInternal()
+  bool ReleaseData();
+
  protected:
   vtkMRMLStorableNode();
   ~vtkMRMLStorableNode() override;
@@ -186,6 +214,27 @@ public:
   /// vtkMRMLStorageNode::GetStoredTime()
   virtual vtkTimeStamp GetStoredTime();
 
+  /// Returns true if the data of all storage nodes can be read from the scene bundle
+  /// that is open for on-demand reading.
+  /// \sa vtkMRMLScene::CanReadBundleFiles(), BundleReadTime
+  bool CanReadDataFromBundle();
+
+  /// Read data using all storage nodes. Returns false if any of the storage nodes failed.
+  bool ReadDataFromStorageNodes();
+
+  /// Restore the node's data that was marked as pending.
+  /// Called by ReadPendingData(). By default the data is read using all storage nodes.
+  /// Subclasses that can keep released data in memory in a compact form may restore it from there.
+  virtual bool ReadPendingDataInternal() { return this->ReadDataFromStorageNodes(); };
+
+  /// Remove the node's data (image, mesh, ...) from memory.
+  /// Called by ReleaseData(). Returns false if the node type does not support it,
+  /// which is the default.
+  virtual bool ReleaseDataInternal() { return false; };
+
+  /// Set to true if data reading was deferred in UpdateScene
+  bool DataReadPending{false};
+
   /// Last time when a storable property was modified. This is used to know
   /// if the node has been modified since the last time it was read or written
   /// on disk.
@@ -195,6 +244,13 @@ public:
   /// Model, voxel intensity or origin for a Volume...
   /// \sa GetModifiedSinceRead(), GetStoredTime()
   vtkTimeStamp StorableModifiedTime;
+
+  /// Last time when data was read from a scene bundle that is open for on-demand reading.
+  /// Until the data is written to a file, GetModifiedSinceRead() compares storable
+  /// modifications to this time and considers data that can no longer be read from
+  /// the bundle as modified.
+  /// \sa CanReadDataFromBundle(), ReleaseData()
+  vtkTimeStamp BundleReadTime;
 };
 
 #endif
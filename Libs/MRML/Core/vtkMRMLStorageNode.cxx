@@ -48,6 +48,8 @@ vtkMRMLStorageNode::vtkMRMLStorageNode()
   this->URI = nullptr;
   this->URIHandler = nullptr;
   this->UseCompression = 1;
+  this->CompressionLevel = -1;
+  this->NumberOfCompressionThreads = 0;
   this->ReadState = this->Idle;
   this->WriteState = this->Idle;
   this->URIHandler = nullptr;
@@ -199,6 +201,14 @@ void vtkMRMLStorageNode::WriteXML(ostream& of, int nIndent)
     {
     of << " compressionParameter=\"" << this->XMLAttributeEncodeString(this->CompressionParameter) << "\"";
     }
+  if (this->CompressionLevel >= 0)
+    {
+    of << " compressionLevel=\"" << this->CompressionLevel << "\"";
+    }
+  if (this->NumberOfCompressionThreads > 0)
+    {
+    of << " numberOfCompressionThreads=\"" << this->NumberOfCompressionThreads << "\"";
+    }
 
   if (this->GetDefaultWriteFileExtension() != nullptr)
     {
@@ -335,6 +345,18 @@ void vtkMRMLStorageNode::ReadXMLAttributes(const char** atts)
       {
       this->CompressionParameter = attValue;
       }
+    else if (!strcmp(attName, "compressionLevel"))
+      {
+      std::stringstream ss;
+      ss << attValue;
+      ss >> this->CompressionLevel;
+      }
+    else if (!strcmp(attName, "numberOfCompressionThreads"))
+      {
+      std::stringstream ss;
+      ss << attValue;
+      ss >> this->NumberOfCompressionThreads;
+      }
     else if (!strcmp(attName, "readState"))
       {
       std::stringstream ss;
@@ -371,6 +393,8 @@ void vtkMRMLStorageNode::Copy(vtkMRMLNode *anode)
     }
   this->SetUseCompression(node->UseCompression);
   this->SetCompressionParameter(node->CompressionParameter);
+  this->SetCompressionLevel(node->CompressionLevel);
+  this->SetNumberOfCompressionThreads(node->NumberOfCompressionThreads);
   this->SetReadState(node->ReadState);
   this->SetWriteState(node->WriteState);
   this->SetDefaultWriteFileExtension(node->GetDefaultWriteFileExtension());
@@ -401,6 +425,8 @@ void vtkMRMLStorageNode::PrintSelf(ostream& os, vtkIndent indent)
     {
     os << indent << "CompressionParameter:   " << this->CompressionParameter << "\n";
     }
+  os << indent << "CompressionLevel:   " << this->CompressionLevel << "\n";
+  os << indent << "NumberOfCompressionThreads:   " << this->NumberOfCompressionThreads << "\n";
 
   os << indent << "ReadState:  " << this->GetReadStateAsString() << "\n";
   os << indent << "WriteState: " << this->GetWriteStateAsString() << "\n";
@@ -1308,6 +1334,18 @@ int vtkMRMLStorageNode::ReadData(vtkMRMLNode* refNode, bool temporary)
   return success;
 }
 
+//------------------------------------------------------------------------------
+void vtkMRMLStorageNode::UpdateFromReadDataCopy(vtkMRMLStorageNode* storageNodeCopy, vtkMRMLNode* vtkNotUsed(refNode))
+{
+  if (!storageNodeCopy)
+    {
+    return;
+    }
+  this->GetUserMessages()->AddMessages(storageNodeCopy->GetUserMessages());
+  this->SetReadStateIdle();
+  this->StoredTime->Modified();
+}
+
 //------------------------------------------------------------------------------
 int vtkMRMLStorageNode::WriteData(vtkMRMLNode* refNode)
 {
@@ -303,6 +303,30 @@ public:
   /// \sa CanReadInReferenceNode, WriteData
   virtual bool CanWriteFromReferenceNode(vtkMRMLNode* refNode);
 
+  /// Return true if ReadData() can be called from a background thread.
+  /// This is only allowed if reading into a node that is not in the scene
+  /// does not access any shared state (scene, other nodes, non-thread-safe
+  /// global state of the underlying file reader).
+  /// False by default, subclasses can opt in by reimplementing the method.
+  /// \sa vtkMRMLScene::SetReadDataInParallel(), UpdateFromReadDataCopy()
+  virtual bool CanReadInBackgroundThread() { return false; }
+
+  /// Return true if WriteData() can be called from a background thread.
+  /// This is only allowed if writing does not access any shared state
+  /// (scene, other nodes, non-thread-safe global state of the underlying file writer)
+  /// and does not modify the storable node.
+  /// False by default, subclasses can opt in by reimplementing the method.
+  /// \sa vtkMRMLScene::SetWriteDataInParallel()
+  virtual bool CanWriteInBackgroundThread() { return false; }
+
+  /// Update the storage node as if ReadData() had been called after data was read
+  /// by a copy of this storage node (typically in a background thread) and the
+  /// data has been copied into \a refNode.
+  /// User messages of the copy are added to this node's user messages and stored time is updated.
+  /// Subclasses can reimplement the method to update nodes that the copy could not access.
+  /// \sa CanReadInBackgroundThread()
+  virtual void UpdateFromReadDataCopy(vtkMRMLStorageNode* storageNodeCopy, vtkMRMLNode* refNode);
+
   ///
   /// Configure the storage node for data exchange. This is an
   /// opportunity to optimize the storage node's settings, for
@@ -321,6 +345,18 @@ public:
   vtkSetMacro(CompressionParameter, std::string);
   vtkGetMacro(CompressionParameter, std::string);
 
+  /// Compression level that is used to save the node.
+  /// -1 (default) means that the level is determined by the CompressionParameter.
+  /// Only used by storage nodes that write zlib-compressed data.
+  vtkSetClampMacro(CompressionLevel, int, -1, 9);
+  vtkGetMacro(CompressionLevel, int);
+
+  /// Number of threads that are used for compressing and decompressing data.
+  /// 0 (default) means that all available threads are used, 1 disables parallel compression.
+  /// Only used by storage nodes that support parallel compression.
+  vtkSetClampMacro(NumberOfCompressionThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfCompressionThreads, int);
+
   /// Returns a list of displayable names of the supported compression presets
   virtual std::vector<std::string> GetCompressionPresetDisplayNames();
 
@@ -410,6 +446,8 @@ protected:
   int WriteState;
   std::string CompressionParameter;
   std::vector<CompressionPreset> CompressionPresets;
+  int CompressionLevel;
+  int NumberOfCompressionThreads;
 
   ///
   /// An array of file names, should contain the FileName but may not
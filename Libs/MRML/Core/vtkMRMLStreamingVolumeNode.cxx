@@ -19,6 +19,7 @@ Care Ontario.
 ==============================================================================*/
 
 // MRML includes
+#include "vtkEventBroker.h"
 #include "vtkMRMLStreamingVolumeNode.h"
 
 // VTK includes
@@ -27,10 +28,185 @@ Care Ontario.
 #include <vtkCallbackCommand.h>
 #include <vtkCommand.h>
 #include <vtkMatrix4x4.h>
+#include <vtkNew.h>
 
 // vtkAddon includes
 #include <vtkStreamingVolumeCodecFactory.h>
 
+// STD includes
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+//----------------------------------------------------------------------------
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Allocate \a imageData with the dimensions and scalar type of \a frame
+void AllocateImage(vtkStreamingVolumeFrame* frame, vtkImageData* imageData)
+{
+  int frameDimensions[3] = { 0,0,0 };
+  frame->GetDimensions(frameDimensions);
+  imageData->SetDimensions(frameDimensions);
+  imageData->AllocateScalars(frame->GetVTKScalarType(), frame->GetNumberOfComponents());
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+class vtkMRMLStreamingVolumeNode::vtkInternal
+{
+public:
+  struct DecodeRequest
+  {
+    vtkSmartPointer<vtkStreamingVolumeFrame> Frame;
+    vtkSmartPointer<vtkStreamingVolumeCodec> Codec;
+    int Generation;
+  };
+
+  /// Only accessed from the main thread
+  /// Codec used by the worker thread. It is not the codec of the node, as
+  /// decoders keep the state of the previously decoded frames.
+  vtkSmartPointer<vtkStreamingVolumeCodec> DecodingCodec;
+  /// True if the current frame of the node has been queued
+  bool FrameQueued{false};
+  vtkNew<vtkObject> FrameDecodedNotifier;
+  vtkNew<vtkCallbackCommand> FrameDecodedCallbackCommand;
+
+  /// Shared with the worker thread, protected by Mutex
+  std::mutex Mutex;
+  std::deque<DecodeRequest> Queue;
+  bool Decoding{false};
+  /// Most recent decoded frame and image, not yet set to the node
+  vtkSmartPointer<vtkStreamingVolumeFrame> DecodedFrame;
+  vtkSmartPointer<vtkImageData> DecodedImage;
+  /// Image previously used by the node, reused to decode the next frame
+  vtkSmartPointer<vtkImageData> SpareImage;
+  /// Incremented when the queue is cleared to discard the frames decoded meanwhile
+  int Generation{0};
+  bool StopThread{false};
+  std::condition_variable QueueCondition;
+  std::condition_variable DecodedCondition;
+  std::thread Thread;
+
+  std::atomic<bool> NotificationRequested{false};
+
+  void QueueFrame(vtkStreamingVolumeFrame* frame, vtkStreamingVolumeCodec* codec);
+  void ClearQueue();
+  /// Wait until all the queued frames are decoded
+  void WaitForQueue();
+  void StopAndJoinThread();
+  void ProcessRequests();
+};
+
+//----------------------------------------------------------------------------
+void vtkMRMLStreamingVolumeNode::vtkInternal::QueueFrame(vtkStreamingVolumeFrame* frame, vtkStreamingVolumeCodec* codec)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    if (frame->IsKeyFrame())
+      {
+      // the pending frames are not needed to decode a keyframe
+      this->Queue.clear();
+      }
+    this->Queue.push_back(DecodeRequest{frame, codec, this->Generation});
+    if (!this->Thread.joinable())
+      {
+      this->Thread = std::thread(&vtkInternal::ProcessRequests, this);
+      }
+  }
+  this->QueueCondition.notify_one();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLStreamingVolumeNode::vtkInternal::ClearQueue()
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->Queue.clear();
+  this->DecodedFrame = nullptr;
+  this->DecodedImage = nullptr;
+  ++this->Generation;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLStreamingVolumeNode::vtkInternal::WaitForQueue()
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  this->DecodedCondition.wait(lock, [this] { return this->Queue.empty() && !this->Decoding; });
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLStreamingVolumeNode::vtkInternal::StopAndJoinThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->StopThread = true;
+    this->Queue.clear();
+  }
+  this->QueueCondition.notify_all();
+  if (this->Thread.joinable())
+    {
+    this->Thread.join();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLStreamingVolumeNode::vtkInternal::ProcessRequests()
+{
+  while (true)
+    {
+    DecodeRequest request;
+    vtkSmartPointer<vtkImageData> imageData;
+    {
+      std::unique_lock<std::mutex> lock(this->Mutex);
+      this->QueueCondition.wait(lock, [this] { return this->StopThread || !this->Queue.empty(); });
+      if (this->StopThread)
+        {
+        return;
+        }
+      request = this->Queue.front();
+      this->Queue.pop_front();
+      this->Decoding = true;
+      imageData = this->SpareImage;
+      this->SpareImage = nullptr;
+    }
+
+    // the image is not used by the node until it is swapped in on the main thread
+    if (!imageData)
+      {
+      imageData = vtkSmartPointer<vtkImageData>::New();
+      }
+    AllocateImage(request.Frame, imageData);
+    bool success = request.Codec->DecodeFrame(request.Frame, imageData);
+
+    bool notify = false;
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Decoding = false;
+      if (success && request.Generation == this->Generation)
+        {
+        // replaces the previous image if the main thread has not used it yet
+        this->DecodedFrame = request.Frame;
+        this->DecodedImage = imageData;
+        notify = true;
+        }
+    }
+    this->DecodedCondition.notify_all();
+
+    // Notify the main thread once for all the frames decoded until it processes the notification
+    if (notify && !this->NotificationRequested.exchange(true))
+      {
+      if (!vtkEventBroker::GetInstance()->RequestModified(this->FrameDecodedNotifier))
+        {
+        this->NotificationRequested = false;
+        }
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 vtkMRMLNodeNewMacro(vtkMRMLStreamingVolumeNode);
 
@@ -48,10 +224,35 @@ vtkMRMLStreamingVolumeNode::vtkMRMLStreamingVolumeNode()
 {
   this->FrameModifiedCallbackCommand->SetClientData(reinterpret_cast<void *>(this));
   this->FrameModifiedCallbackCommand->SetCallback(vtkMRMLStreamingVolumeNode::FrameModifiedCallback);
+  this->Internal = new vtkInternal;
+  this->Internal->FrameDecodedCallbackCommand->SetClientData(this);
+  this->Internal->FrameDecodedCallbackCommand->SetCallback(vtkMRMLStreamingVolumeNode::FrameDecodedCallback);
+  this->Internal->FrameDecodedNotifier->AddObserver(vtkCommand::ModifiedEvent,
+    this->Internal->FrameDecodedCallbackCommand);
 }
 
 //-----------------------------------------------------------------------------
-vtkMRMLStreamingVolumeNode::~vtkMRMLStreamingVolumeNode() = default;
+vtkMRMLStreamingVolumeNode::~vtkMRMLStreamingVolumeNode()
+{
+  this->Internal->StopAndJoinThread();
+  // The notifier may still be in the modified queue of the application
+  this->Internal->FrameDecodedNotifier->RemoveObserver(this->Internal->FrameDecodedCallbackCommand);
+  this->Internal->FrameDecodedCallbackCommand->SetClientData(nullptr);
+  delete this->Internal;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLStreamingVolumeNode::FrameDecodedCallback(vtkObject* vtkNotUsed(caller),
+  unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
+{
+  vtkMRMLStreamingVolumeNode* self = reinterpret_cast<vtkMRMLStreamingVolumeNode*>(clientData);
+  if (!self)
+    {
+    return;
+    }
+  self->Internal->NotificationRequested = false;
+  self->UpdateImageDataFromDecodedFrame();
+}
 
 //---------------------------------------------------------------------------
 void vtkMRMLStreamingVolumeNode::FrameModifiedCallback(vtkObject *caller, unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
@@ -66,7 +267,7 @@ void vtkMRMLStreamingVolumeNode::FrameModifiedCallback(vtkObject *caller, unsign
     {
     if (self->HasExternalImageObserver())
       {
-      self->DecodeFrame();
+      self->RequestFrameDecoding();
       }
     self->InvokeCustomModifiedEvent(vtkMRMLStreamingVolumeNode::FrameModifiedEvent);
     }
@@ -116,10 +317,7 @@ void vtkMRMLStreamingVolumeNode::AllocateImageForFrame(vtkImageData* imageData)
 {
   if (imageData && this->Frame)
     {
-    int frameDimensions[3] = { 0,0,0 };
-    this->Frame->GetDimensions(frameDimensions);
-    imageData->SetDimensions(frameDimensions);
-    imageData->AllocateScalars(this->Frame->GetVTKScalarType(), this->Frame->GetNumberOfComponents());
+    AllocateImage(this->Frame, imageData);
     }
 }
 
@@ -128,7 +326,16 @@ vtkImageData* vtkMRMLStreamingVolumeNode::GetImageData()
 {
   if (this->Frame)
     {
-    this->DecodeFrame();
+    if (this->IsAsynchronousDecodingAvailable() && Superclass::GetImageData())
+      {
+      // use the most recent decoded image, the current frame replaces it once decoded
+      this->UpdateImageDataFromDecodedFrame();
+      this->RequestFrameDecoding();
+      }
+    else
+      {
+      this->DecodeFrame();
+      }
     }
 
   vtkImageData* imageData = Superclass::GetImageData();
@@ -140,11 +347,93 @@ vtkAlgorithmOutput* vtkMRMLStreamingVolumeNode::GetImageDataConnection()
 {
   if (this->Frame)
     {
-    this->DecodeFrame();
+    if (this->IsAsynchronousDecodingAvailable() && Superclass::GetImageData())
+      {
+      this->UpdateImageDataFromDecodedFrame();
+      this->RequestFrameDecoding();
+      }
+    else
+      {
+      this->DecodeFrame();
+      }
     }
   return Superclass::GetImageDataConnection();
 }
 
+//---------------------------------------------------------------------------
+bool vtkMRMLStreamingVolumeNode::IsAsynchronousDecodingAvailable()
+{
+  return this->AsynchronousDecoding
+    && vtkEventBroker::GetInstance()->GetRequestModifiedCallback() != nullptr;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLStreamingVolumeNode::RequestFrameDecoding()
+{
+  if (!this->IsAsynchronousDecodingAvailable())
+    {
+    this->DecodeFrame();
+    return;
+    }
+  if (!this->Frame || this->FrameDecoded || this->Internal->FrameQueued)
+    {
+    return;
+    }
+  if (!this->Internal->DecodingCodec
+      || this->Internal->DecodingCodec->GetFourCC() != this->GetCodecFourCC())
+    {
+    this->Internal->DecodingCodec = vtkSmartPointer<vtkStreamingVolumeCodec>::Take(
+      vtkStreamingVolumeCodecFactory::GetInstance()->CreateCodecByFourCC(this->GetCodecFourCC()));
+    if (this->Internal->DecodingCodec)
+      {
+      this->Internal->DecodingCodec->SetParametersFromString(this->GetCodecParameterString());
+      }
+    }
+  if (!this->Internal->DecodingCodec)
+    {
+    vtkErrorMacro("Could not find codec \"" << this->GetCodecFourCC() << "\"");
+    return;
+    }
+  this->Internal->QueueFrame(this->Frame, this->Internal->DecodingCodec);
+  this->Internal->FrameQueued = true;
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLStreamingVolumeNode::UpdateImageDataFromDecodedFrame()
+{
+  vtkSmartPointer<vtkStreamingVolumeFrame> decodedFrame;
+  vtkSmartPointer<vtkImageData> decodedImage;
+  {
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    decodedFrame = this->Internal->DecodedFrame;
+    decodedImage = this->Internal->DecodedImage;
+    this->Internal->DecodedFrame = nullptr;
+    this->Internal->DecodedImage = nullptr;
+  }
+  if (!decodedImage)
+    {
+    return false;
+    }
+
+  vtkSmartPointer<vtkImageData> previousImage = Superclass::GetImageData();
+  this->FrameDecodingInProgress = true;
+  this->SetAndObserveImageData(decodedImage);
+  this->FrameDecodingInProgress = false;
+  if (decodedFrame == this->Frame)
+    {
+    this->FrameDecoded = true;
+    this->Internal->FrameQueued = false;
+    }
+
+  // decode the next frame in the previous image if nothing else uses it
+  if (previousImage && previousImage != decodedImage && previousImage->GetReferenceCount() == 1)
+    {
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    this->Internal->SpareImage = previousImage;
+    }
+  return true;
+}
+
 //---------------------------------------------------------------------------
 vtkStreamingVolumeCodec* vtkMRMLStreamingVolumeNode::GetCodec()
 {
@@ -185,6 +474,12 @@ void vtkMRMLStreamingVolumeNode::SetAndObserveFrame(vtkStreamingVolumeFrame* fra
 
   this->Frame = frame;
   this->FrameDecoded = false;
+  this->Internal->FrameQueued = false;
+  if (!this->Frame)
+    {
+    // the image is set externally, frames decoded meanwhile must not replace it
+    this->Internal->ClearQueue();
+    }
 
   if (this->Frame)
     {
@@ -199,7 +494,7 @@ void vtkMRMLStreamingVolumeNode::SetAndObserveFrame(vtkStreamingVolumeFrame* fra
     // since some external class is observing the image data.
     if (this->HasExternalImageObserver())
       {
-      this->DecodeFrame();
+      this->RequestFrameDecoding();
       }
     }
   this->Modified();
@@ -228,6 +523,21 @@ bool vtkMRMLStreamingVolumeNode::DecodeFrame()
     return true;
     }
 
+  if (this->IsAsynchronousDecodingAvailable())
+    {
+    // the worker thread decodes the frames in order, wait for the current one
+    this->RequestFrameDecoding();
+    this->Internal->WaitForQueue();
+    this->UpdateImageDataFromDecodedFrame();
+    if (!this->FrameDecoded)
+      {
+      vtkErrorMacro("Could not decode frame!");
+      // do not queue it again
+      this->Internal->FrameQueued = true;
+      }
+    return this->FrameDecoded;
+    }
+
   this->FrameDecodingInProgress = true;
   this->FrameDecoded = false;
 
@@ -321,6 +631,7 @@ void vtkMRMLStreamingVolumeNode::WriteXML(ostream& of, int nIndent)
   vtkMRMLWriteXMLBeginMacro(of);
   vtkMRMLWriteXMLStdStringMacro(codecFourCC, CodecFourCC);
   vtkMRMLWriteXMLStdStringMacro(codecParameters, CodecParameterString);
+  vtkMRMLWriteXMLBooleanMacro(asynchronousDecoding, AsynchronousDecoding);
   vtkMRMLWriteXMLEndMacro();
 }
 
@@ -332,6 +643,7 @@ void vtkMRMLStreamingVolumeNode::ReadXMLAttributes(const char** atts)
   vtkMRMLReadXMLBeginMacro(atts);
   vtkMRMLReadXMLStdStringMacro(codecFourCC, CodecFourCC);
   vtkMRMLReadXMLStdStringMacro(codecParameters, CodecParameterString);
+  vtkMRMLReadXMLBooleanMacro(asynchronousDecoding, AsynchronousDecoding);
   vtkMRMLReadXMLEndMacro();
   this->EndModify(disabledModify);
 }
@@ -379,8 +691,9 @@ void vtkMRMLStreamingVolumeNode::CopyContent(vtkMRMLNode* anode, bool deepCopy/*
     }
 
   vtkMRMLCopyBeginMacro(anode);
+  vtkMRMLCopyBooleanMacro(AsynchronousDecoding);
   vtkMRMLCopyStdStringMacro(CodecFourCC);
-  this->SetAndObserveFrame(this->SafeDownCast(copySourceNode)->GetFrame());
+  this->SetAndObserveFrame(copySourceNode->GetFrame());
   vtkMRMLCopyStdStringMacro(CodecParameterString);
   vtkMRMLCopyEndMacro();
 }
@@ -399,5 +712,6 @@ void vtkMRMLStreamingVolumeNode::PrintSelf(ostream& os, vtkIndent indent)
     {
     vtkMRMLPrintStdStringMacro(CodecFourCC);
     }
+  vtkMRMLPrintBooleanMacro(AsynchronousDecoding);
   vtkMRMLPrintEndMacro();
 }
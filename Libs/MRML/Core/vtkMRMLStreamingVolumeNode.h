@@ -42,6 +42,12 @@ Care Ontario.
 /// In this context, a frame is considered to be a compressed image that may require additional frames to decode to an image,
 /// and an image is the uncompressed pixel based representation.
 /// A video codec can be used to decode and encode between frame and image representations
+///
+/// If AsynchronousDecoding is enabled, the frames are decoded in order by a
+/// worker thread, into a separate image data that replaces the image data of
+/// the node on the main thread. It requires vtkEventBroker to have a request
+/// modified callback (set by the application logic), frames are decoded
+/// synchronously otherwise.
 class  VTK_MRML_EXPORT vtkMRMLStreamingVolumeNode : public vtkMRMLVectorVolumeNode
 {
 public:
@@ -88,6 +94,11 @@ public:
   /// Returns true if the frame is successfully decoded
   virtual bool DecodeFrame();
 
+  /// Replace the image data by the most recent image decoded by the worker
+  /// thread, if any. Called on the main thread when a frame is decoded.
+  /// Returns true if the image data was replaced.
+  bool UpdateImageDataFromDecodedFrame();
+
   /// Returns true if the current frame is a keyframe
   /// KeyFrames are not interpolated and don't require any additional frames in order to be decoded to an uncompressed image
   virtual bool IsKeyFrame();
@@ -114,6 +125,16 @@ public:
   void SetCodecParameterString(std::string parameterString);
   std::string GetCodecParameterString();
 
+  /// Decode the frames in a worker thread. Frames that arrive while the
+  /// previous one is decoded are queued, pending frames are dropped when a
+  /// keyframe arrives. Until a frame is decoded, the image data of the node
+  /// is the most recent decoded image. Frames must not be modified after
+  /// they are set to the node.
+  /// Disabled by default.
+  vtkSetMacro(AsynchronousDecoding, bool);
+  vtkGetMacro(AsynchronousDecoding, bool);
+  vtkBooleanMacro(AsynchronousDecoding, bool);
+
 protected:
   vtkMRMLStreamingVolumeNode();
   ~vtkMRMLStreamingVolumeNode() override;
@@ -126,6 +147,15 @@ protected:
   /// Returns true if the number of observers on the ImageData or ImageDataConnection is greater than the default expected number
   bool HasExternalImageObserver();
 
+  /// Returns true if frames are decoded by the worker thread
+  bool IsAsynchronousDecodingAvailable();
+
+  /// Decode the current frame, in the worker thread if asynchronous decoding is available
+  void RequestFrameDecoding();
+
+  /// Called on the main thread when the worker thread has decoded a frame
+  static void FrameDecodedCallback(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
+
 protected:
   vtkSmartPointer<vtkStreamingVolumeCodec> Codec;
   std::string                              CodecFourCC;
@@ -133,7 +163,11 @@ protected:
   bool                                     FrameDecoded{false};
   bool                                     FrameDecodingInProgress{false};
   vtkSmartPointer<vtkCallbackCommand>      FrameModifiedCallbackCommand;
+  bool                                     AsynchronousDecoding{false};
 
+private:
+  class vtkInternal;
+  vtkInternal* Internal;
 };
 
 #endif
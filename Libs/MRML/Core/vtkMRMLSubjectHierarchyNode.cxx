@@ -41,6 +41,8 @@
 #include <sstream>
 #include <set>
 #include <map>
+#include <iterator>
+#include <unordered_map>
 #include <algorithm>
 
 //----------------------------------------------------------------------------
@@ -105,8 +107,13 @@ public:
 
   /// Item and data node cache to speed up lookups that are needed many times.
   /// It can be static as the item IDs are unique in one application session.
-  static std::map<vtkIdType, vtkWeakPointer<vtkSubjectHierarchyItem> > ItemCache;
-  static std::map<vtkMRMLNode*, vtkWeakPointer<vtkSubjectHierarchyItem> > DataNodeCache;
+  static std::unordered_map<vtkIdType, vtkWeakPointer<vtkSubjectHierarchyItem> > ItemCache;
+  static std::unordered_map<vtkMRMLNode*, vtkWeakPointer<vtkSubjectHierarchyItem> > DataNodeCache;
+  /// UID cache to speed up lookup of items by UID (for example during DICOM import).
+  /// All items that have UIDs are in the cache (also items that are not in any hierarchy yet),
+  /// therefore if an UID is not found in the cache then there is no item with that UID.
+  /// Entries are only added when UIDs are set, lookups check that the entry is still valid.
+  static std::unordered_multimap<std::string, vtkWeakPointer<vtkSubjectHierarchyItem> > UIDCache;
 
 // Get/set functions
 public:
@@ -132,6 +139,12 @@ public:
   /// Get a UID with a given name
   /// \return The UID value if exists, empty string if does not
   std::string GetUID(std::string uidName);
+  /// Add all UIDs of the item to the UID cache
+  void AddUIDsToCache();
+  /// Remove all UIDs of the item from the UID cache
+  void RemoveUIDsFromCache();
+  /// Get key of an UID in the UID cache
+  static std::string GetUIDCacheKey(const std::string& uidName, const std::string& uidValue);
   /// Set attribute to item
   /// \parameter attributeValue Value of attribute. If empty string, then attribute is removed
   void SetAttribute(std::string attributeName, std::string attributeValue);
@@ -152,6 +165,9 @@ public:
 public:
   /// Determine whether this item has any children
   bool HasChildren();
+  /// Determine whether this item is in the branch of the given item (the given item itself is not part of its branch)
+  /// \param recursive Flag whether to check only direct children (false) or the whole branch (true)
+  bool IsInBranch(vtkSubjectHierarchyItem* ancestorItem, bool recursive=true);
   /// Determine whether this item is the parent of a virtual branch
   /// Items in virtual branches are invalid without the parent item, as they represent the item's data node's content, so
   /// they are removed automatically when the parent item of the virtual branch is removed
@@ -247,10 +263,12 @@ vtkStandardNewMacro(vtkSubjectHierarchyItem);
 
 vtkIdType vtkSubjectHierarchyItem::NextSubjectHierarchyItemID = vtkMRMLSubjectHierarchyNode::INVALID_ITEM_ID + 1;
 
-std::map<vtkIdType, vtkWeakPointer<vtkSubjectHierarchyItem> > vtkSubjectHierarchyItem::ItemCache =
-  std::map<vtkIdType, vtkWeakPointer<vtkSubjectHierarchyItem> >();
-std::map<vtkMRMLNode*, vtkWeakPointer<vtkSubjectHierarchyItem> > vtkSubjectHierarchyItem::DataNodeCache =
-  std::map<vtkMRMLNode*, vtkWeakPointer<vtkSubjectHierarchyItem> >();
+std::unordered_map<vtkIdType, vtkWeakPointer<vtkSubjectHierarchyItem> > vtkSubjectHierarchyItem::ItemCache =
+  std::unordered_map<vtkIdType, vtkWeakPointer<vtkSubjectHierarchyItem> >();
+std::unordered_map<vtkMRMLNode*, vtkWeakPointer<vtkSubjectHierarchyItem> > vtkSubjectHierarchyItem::DataNodeCache =
+  std::unordered_map<vtkMRMLNode*, vtkWeakPointer<vtkSubjectHierarchyItem> >();
+std::unordered_multimap<std::string, vtkWeakPointer<vtkSubjectHierarchyItem> > vtkSubjectHierarchyItem::UIDCache =
+  std::unordered_multimap<std::string, vtkWeakPointer<vtkSubjectHierarchyItem> >();
 
 //---------------------------------------------------------------------------
 // vtkSubjectHierarchyItem methods
@@ -275,6 +293,7 @@ vtkSubjectHierarchyItem::~vtkSubjectHierarchyItem()
 {
   this->RemoveAllChildren();
 
+  this->RemoveUIDsFromCache();
   this->Attributes.clear();
   this->UIDs.clear();
 }
@@ -472,6 +491,7 @@ void vtkSubjectHierarchyItem::ReadXMLAttributes(const char** atts)
       ss << attValue;
       std::string valueStr = ss.str();
 
+      this->RemoveUIDsFromCache();
       this->UIDs.clear();
       size_t itemSeparatorPosition = valueStr.find(vtkMRMLSubjectHierarchyNode::SUBJECTHIERARCHY_SEPARATOR);
       while (itemSeparatorPosition != std::string::npos)
@@ -495,6 +515,7 @@ void vtkSubjectHierarchyItem::ReadXMLAttributes(const char** atts)
         std::string value = itemStr.substr(nameValueSeparatorPosition + vtkMRMLSubjectHierarchyNode::SUBJECTHIERARCHY_NAME_VALUE_SEPARATOR.size());
         this->UIDs[name] = value;
         }
+      this->AddUIDsToCache();
       }
     else if (!strcmp(attName, "attributes"))
       {
@@ -641,7 +662,9 @@ void vtkSubjectHierarchyItem::DeepCopy(vtkSubjectHierarchyItem* item, bool copyC
   this->Name = item->Name;
   this->OwnerPluginName = item->OwnerPluginName;
   this->Expanded = item->Expanded;
+  this->RemoveUIDsFromCache();
   this->UIDs = item->UIDs;
+  this->AddUIDsToCache();
   this->Attributes = item->Attributes;
 
   // Copy temporary members if they are valid, otherwise save from live members
@@ -703,6 +726,23 @@ bool vtkSubjectHierarchyItem::HasChildren()
   return !this->Children.empty();
 }
 
+//---------------------------------------------------------------------------
+bool vtkSubjectHierarchyItem::IsInBranch(vtkSubjectHierarchyItem* ancestorItem, bool recursive/*=true*/)
+{
+  if (!recursive)
+    {
+    return (this->Parent == ancestorItem && ancestorItem != nullptr);
+    }
+  for (vtkSubjectHierarchyItem* currentItem = this->Parent; currentItem; currentItem = currentItem->Parent)
+    {
+    if (currentItem == ancestorItem)
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
 //---------------------------------------------------------------------------
 bool vtkSubjectHierarchyItem::IsVirtualBranchParent()
 {
@@ -720,7 +760,7 @@ vtkSubjectHierarchyItem* vtkSubjectHierarchyItem::FindChildByID(vtkIdType itemID
     }
 
   // Try to find item in cache
-  std::map<vtkIdType, vtkWeakPointer<vtkSubjectHierarchyItem> >::iterator itemIt = vtkSubjectHierarchyItem::ItemCache.find(itemID);
+  std::unordered_map<vtkIdType, vtkWeakPointer<vtkSubjectHierarchyItem> >::iterator itemIt = vtkSubjectHierarchyItem::ItemCache.find(itemID);
   if (itemIt != vtkSubjectHierarchyItem::ItemCache.end())
     {
     if (itemIt->second != nullptr)
@@ -754,7 +794,7 @@ vtkSubjectHierarchyItem* vtkSubjectHierarchyItem::FindChildByID(vtkIdType itemID
     }
   if (foundItem)
     {
-    vtkSubjectHierarchyItem::ItemCache[itemID] = this;
+    vtkSubjectHierarchyItem::ItemCache[itemID] = foundItem;
     }
 
   return foundItem;
@@ -768,6 +808,19 @@ vtkSubjectHierarchyItem* vtkSubjectHierarchyItem::FindChildByDataNode(vtkMRMLNod
     return nullptr;
     }
 
+  // Try to find item in cache. A data node is associated with only one item, therefore
+  // the cached item is the same that would be found by traversing the branch.
+  auto cachedItemIt = vtkSubjectHierarchyItem::DataNodeCache.find(dataNode);
+  if (cachedItemIt != vtkSubjectHierarchyItem::DataNodeCache.end())
+    {
+    vtkSubjectHierarchyItem* cachedItem = cachedItemIt->second;
+    if (cachedItem && cachedItem->DataNode == dataNode && cachedItem->IsInBranch(this, recursive))
+      {
+      return cachedItem;
+      }
+    }
+
+  // On failure to look up in cache traverse tree to find item
   ChildVector::iterator childIt;
   for (childIt=this->Children.begin(); childIt!=this->Children.end(); ++childIt)
     {
@@ -795,6 +848,34 @@ vtkSubjectHierarchyItem* vtkSubjectHierarchyItem::FindChildByUID(std::string uid
     {
     return nullptr;
     }
+
+  // Look up items that have this UID in the cache. All items with UIDs are in the cache,
+  // so if no item is found in this branch then there is no need to traverse the tree.
+  vtkSubjectHierarchyItem* foundItem = nullptr;
+  int numberOfFoundItems = 0;
+  auto range = vtkSubjectHierarchyItem::UIDCache.equal_range(vtkSubjectHierarchyItem::GetUIDCacheKey(uidName, uidValue));
+  for (auto cacheIt = range.first; cacheIt != range.second; )
+    {
+    vtkSubjectHierarchyItem* cachedItem = cacheIt->second;
+    if (!cachedItem || cachedItem->GetUID(uidName) != uidValue)
+      {
+      // Item has been deleted or its UID has changed
+      cacheIt = vtkSubjectHierarchyItem::UIDCache.erase(cacheIt);
+      continue;
+      }
+    if (cachedItem->IsInBranch(this, recursive) && cachedItem != foundItem)
+      {
+      foundItem = cachedItem;
+      ++numberOfFoundItems;
+      }
+    ++cacheIt;
+    }
+  if (numberOfFoundItems < 2)
+    {
+    return foundItem;
+    }
+
+  // Multiple items have the same UID, traverse the tree to return the first one
   ChildVector::iterator childIt;
   for (childIt=this->Children.begin(); childIt!=this->Children.end(); ++childIt)
     {
@@ -1249,27 +1330,37 @@ void vtkSubjectHierarchyItem::RemoveAllChildren()
   // To avoid this, block Modified events on the data node until all of the children are removed.
   MRMLNodeModifyBlocker blocker(this->DataNode);
 
+  // Children are listed in depth-first order, therefore searching for leaf items from
+  // the end of the list finds a leaf item immediately (unless the hierarchy is changed
+  // in event callbacks) and the removed ID can be erased from the end of the list.
   std::vector<vtkIdType> childIDs;
   this->GetAllChildren(childIDs);
   while (childIDs.size())
     {
-    // Remove first leaf item found
-    std::vector<vtkIdType>::iterator childIt;
-    for (childIt=childIDs.begin(); childIt!=childIDs.end(); ++childIt)
+    // Remove last leaf item found
+    std::vector<vtkIdType>::reverse_iterator childIt;
+    for (childIt=childIDs.rbegin(); childIt!=childIDs.rend(); ++childIt)
       {
       if ((*childIt) == vtkMRMLSubjectHierarchyNode::INVALID_ITEM_ID)
         {
         // This can happen when UnresolvedItems are deleted. In that case the items will automatically deconstruct
-        childIDs.erase(childIt);
+        childIDs.erase(std::next(childIt).base());
         break;
         }
       vtkSubjectHierarchyItem* currentItem = this->FindChildByID(*childIt);
-      if (currentItem && !currentItem->HasChildren())
+      if (!currentItem)
+        {
+        // Item has been already removed (for example, by an event callback)
+        childIDs.erase(std::next(childIt).base());
+        break;
+        }
+      if (!currentItem->HasChildren())
         {
         // Remove leaf item
-        currentItem->Parent->RemoveChild(*childIt);
+        vtkIdType currentItemID = (*childIt);
         // Remove ID of deleted item from list and keep deleting until empty
-        childIDs.erase(childIt);
+        childIDs.erase(std::next(childIt).base());
+        currentItem->Parent->RemoveChild(currentItemID);
         break;
         }
       }
@@ -1294,6 +1385,8 @@ void vtkSubjectHierarchyItem::SetUID(std::string uidName, std::string uidValue)
       }
     }
   this->UIDs[uidName] = uidValue;
+  vtkSubjectHierarchyItem::UIDCache.insert(std::make_pair(
+    vtkSubjectHierarchyItem::GetUIDCacheKey(uidName, uidValue), vtkWeakPointer<vtkSubjectHierarchyItem>(this)));
   this->InvokeEvent(vtkMRMLSubjectHierarchyNode::SubjectHierarchyItemUIDAddedEvent, this);
   this->Modified();
 }
@@ -1309,6 +1402,47 @@ std::string vtkSubjectHierarchyItem::GetUID(std::string uidName)
   return std::string();
 }
 
+//---------------------------------------------------------------------------
+std::string vtkSubjectHierarchyItem::GetUIDCacheKey(const std::string& uidName, const std::string& uidValue)
+{
+  std::string key(uidName);
+  key.push_back('\0');
+  key.append(uidValue);
+  return key;
+}
+
+//---------------------------------------------------------------------------
+void vtkSubjectHierarchyItem::AddUIDsToCache()
+{
+  for (std::map<std::string, std::string>::iterator uidIt = this->UIDs.begin(); uidIt != this->UIDs.end(); ++uidIt)
+    {
+    vtkSubjectHierarchyItem::UIDCache.insert(std::make_pair(
+      vtkSubjectHierarchyItem::GetUIDCacheKey(uidIt->first, uidIt->second), vtkWeakPointer<vtkSubjectHierarchyItem>(this)));
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkSubjectHierarchyItem::RemoveUIDsFromCache()
+{
+  for (std::map<std::string, std::string>::iterator uidIt = this->UIDs.begin(); uidIt != this->UIDs.end(); ++uidIt)
+    {
+    auto range = vtkSubjectHierarchyItem::UIDCache.equal_range(
+      vtkSubjectHierarchyItem::GetUIDCacheKey(uidIt->first, uidIt->second));
+    for (auto cacheIt = range.first; cacheIt != range.second; )
+      {
+      // Weak pointer may be already cleared if this item is being deleted
+      if (cacheIt->second.GetPointer() == this || cacheIt->second.GetPointer() == nullptr)
+        {
+        cacheIt = vtkSubjectHierarchyItem::UIDCache.erase(cacheIt);
+        }
+      else
+        {
+        ++cacheIt;
+        }
+      }
+    }
+}
+
 //---------------------------------------------------------------------------
 void vtkSubjectHierarchyItem::SetAttribute(std::string attributeName, std::string attributeValue)
 {
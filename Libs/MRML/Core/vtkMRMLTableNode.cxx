@@ -40,6 +40,7 @@
 #include <vtksys/SystemTools.hxx>
 
 // STD includes
+#include <algorithm>
 #include <deque>
 #include <sstream>
 #include <string>
@@ -181,6 +182,23 @@ void vtkMRMLTableNode::CopyContent(vtkMRMLNode* anode, bool deepCopy/*=true*/)
   this->SetUseFirstColumnAsRowHeader(node->GetUseFirstColumnAsRowHeader());
 }
 
+//----------------------------------------------------------------------------
+vtkMTimeType vtkMRMLTableNode::GetContentMTime()
+{
+  vtkMTimeType contentMTime = this->Superclass::GetContentMTime();
+  if (this->Table)
+    {
+    contentMTime = std::max(contentMTime, this->Table->GetMTime());
+    }
+  return contentMTime;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkMRMLTableNode::GetDataMemorySize()
+{
+  return this->Table ? this->Table->GetActualMemorySize() : 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLTableNode::ProcessMRMLEvents( vtkObject *caller, unsigned long event, void *callData )
 {
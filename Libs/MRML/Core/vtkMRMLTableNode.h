@@ -78,6 +78,16 @@ public:
   /// Method to propagate events generated in mrml
   void ProcessMRMLEvents(vtkObject *caller, unsigned long event, void *callData) override;
 
+  /// Reimplemented to take into account the modified time of the table.
+  vtkMTimeType GetContentMTime() override;
+
+  /// Content modification time includes the table modification time,
+  /// therefore undo state can be shared between undo levels.
+  bool CanShareUndoState() override { return true; }
+
+  /// Memory size of the table.
+  unsigned long GetDataMemorySize() override;
+
   //----------------------------------------------------------------
   /// Get and Set Macros
   //----------------------------------------------------------------
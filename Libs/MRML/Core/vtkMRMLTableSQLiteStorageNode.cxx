@@ -108,6 +108,8 @@ int vtkMRMLTableSQLiteStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
   query->SetQuery(queryString.c_str());
   query->Execute();
 
+  // vtkRowQueryToTable creates typed columns (integer, real, or string)
+  // based on the column types that SQLite reports for the query result.
   vtkSmartPointer<vtkRowQueryToTable> queryToTable = vtkSmartPointer<vtkRowQueryToTable>::New();
   queryToTable->SetQuery(query);
   queryToTable->Update();
@@ -229,32 +231,46 @@ int vtkMRMLTableSQLiteStorageNode::WriteDataInternal(vtkMRMLNode *refNode)
     static_cast<vtkSQLiteQuery*>(database->GetQueryInstance());
 
   query->SetQuery(createTableQuery.c_str());
-  cout << "creating the table" << endl;
   if(!query->Execute())
     {
     vtkErrorMacro(<<"Error performing 'create table' query");
     }
 
+  // Insert all rows in a single transaction, using a prepared statement with bound values.
+  // Without a transaction each insert would be committed to the file separately,
+  // which makes writing of large tables extremely slow.
+  std::string insertQuery = insertPreamble;
+  for (vtkIdType j = 0; j < numColumns; j++)
+    {
+    insertQuery += (j < numColumns - 1 ? "?, " : "?");
+    }
+  insertQuery += ");";
+  bool transactionStarted = query->BeginTransaction();
+  if (!transactionStarted)
+    {
+    vtkWarningMacro("WriteData: failed to start transaction, rows are inserted one by one");
+    }
+  query->SetQuery(insertQuery.c_str());
+
   //iterate over the rows of the vtkTable to complete the insert query
   vtkIdType numRows = table->GetNumberOfRows();
   for(vtkIdType i = 0; i < numRows; i++)
     {
-    std::string insertQuery = insertPreamble;
     for (vtkIdType j = 0; j < numColumns; j++)
       {
-      insertQuery += "'" + table->GetValue(i, j).ToString() + "'";
-      if(j < numColumns - 1)
-        {
-        insertQuery += ", ";
-        }
+      // Bind the value with its own type (numbers are stored as numbers, without conversion to string)
+      query->BindParameter(static_cast<int>(j), table->GetValue(i, j));
       }
-    insertQuery += ");";
     //perform the insert query for this row
-    query->SetQuery(insertQuery.c_str());
     if(!query->Execute())
       {
       vtkErrorMacro(<<"Error performing 'insert' query");
       }
+    query->ClearParameterBindings();
+    }
+  if (transactionStarted && !query->CommitTransaction())
+    {
+    vtkErrorMacro("WriteData: failed to commit inserted rows to database: " << fullName);
     }
 
   //cleanup and return
@@ -39,7 +39,12 @@
 #include <vtksys/SystemTools.hxx>
 
 // STL includes
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
 #include <set>
+#include <type_traits>
 
 //------------------------------------------------------------------------------
 // Helper class to be able to read tables that have "\" characters in them.
@@ -469,6 +474,146 @@ std::vector<vtkMRMLTableStorageNode::ColumnInfo> vtkMRMLTableStorageNode::GetCol
   return columnDetails;
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+/// Returns true if the string is a plain decimal number: optional sign, digits,
+/// and (if allowed) fractional part and exponent, surrounded by optional whitespace.
+/// Numbers in this form are converted by strtod/strtoll exactly the same way as
+/// by stream extraction (used by vtkVariant), therefore the slow vtkVariant
+/// conversion is only needed for other strings.
+bool IsPlainNumber(const char* str, bool allowSign, bool allowFraction)
+{
+  const char* c = str;
+  while (isspace(static_cast<unsigned char>(*c)))
+    {
+    ++c;
+    }
+  if (*c == '+' || (allowSign && *c == '-'))
+    {
+    ++c;
+    }
+  bool digitFound = false;
+  while (isdigit(static_cast<unsigned char>(*c)))
+    {
+    ++c;
+    digitFound = true;
+    }
+  if (allowFraction)
+    {
+    if (*c == '.')
+      {
+      ++c;
+      while (isdigit(static_cast<unsigned char>(*c)))
+        {
+        ++c;
+        digitFound = true;
+        }
+      }
+    if (digitFound && (*c == 'e' || *c == 'E'))
+      {
+      ++c;
+      if (*c == '+' || *c == '-')
+        {
+        ++c;
+        }
+      if (!isdigit(static_cast<unsigned char>(*c)))
+        {
+        return false;
+        }
+      while (isdigit(static_cast<unsigned char>(*c)))
+        {
+        ++c;
+        }
+      }
+    }
+  while (isspace(static_cast<unsigned char>(*c)))
+    {
+    ++c;
+    }
+  return digitFound && *c == '\0';
+}
+
+/// Convert a plain number string to a value. Returns false if the string
+/// is not a plain number or the value is out of the range of the type.
+template <class T>
+bool ParsePlainNumber(const std::string& str, T& value, std::true_type vtkNotUsed(isFloatingPoint))
+{
+  if (!IsPlainNumber(str.c_str(), true, true))
+    {
+    return false;
+    }
+  errno = 0;
+  if (std::is_same<T, float>::value)
+    {
+    value = static_cast<T>(strtof(str.c_str(), nullptr));
+    }
+  else
+    {
+    value = static_cast<T>(strtod(str.c_str(), nullptr));
+    }
+  return errno != ERANGE;
+}
+
+template <class T>
+bool ParsePlainNumber(const std::string& str, T& value, std::false_type vtkNotUsed(isFloatingPoint))
+{
+  if (!IsPlainNumber(str.c_str(), std::is_signed<T>::value, false))
+    {
+    return false;
+    }
+  errno = 0;
+  if (std::is_signed<T>::value)
+    {
+    long long parsedValue = strtoll(str.c_str(), nullptr, 10);
+    if (errno == ERANGE
+      || parsedValue < static_cast<long long>(std::numeric_limits<T>::min())
+      || parsedValue > static_cast<long long>(std::numeric_limits<T>::max()))
+      {
+      return false;
+      }
+    value = static_cast<T>(parsedValue);
+    }
+  else
+    {
+    unsigned long long parsedValue = strtoull(str.c_str(), nullptr, 10);
+    if (errno == ERANGE || parsedValue > static_cast<unsigned long long>(std::numeric_limits<T>::max()))
+      {
+      return false;
+      }
+    value = static_cast<T>(parsedValue);
+    }
+  return true;
+}
+
+/// Set values of a numeric array from strings. Empty strings are skipped.
+/// Plain numbers are converted directly, all other strings are converted using vtkVariant.
+template <class T>
+void FillNumericValuesFromStringArray(vtkStringArray* stringArray, vtkDataArray* typedArray, T* vtkNotUsed(valueType))
+{
+  T* values = static_cast<T*>(typedArray->GetVoidPointer(0));
+  vtkIdType numberOfValues = stringArray->GetNumberOfValues();
+  for (vtkIdType valueIndex = 0; valueIndex < numberOfValues; ++valueIndex)
+    {
+    const std::string& str = stringArray->GetValue(valueIndex);
+    if (str.empty())
+      {
+      // empty cell, leave the null value
+      continue;
+      }
+    T value = 0;
+    if (ParsePlainNumber(str, value, std::is_floating_point<T>()))
+      {
+      values[valueIndex] = value;
+      }
+    else
+      {
+      typedArray->SetVariantValue(valueIndex, stringArray->GetVariantValue(valueIndex));
+      }
+    }
+}
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLTableStorageNode::FillDataFromStringArray(vtkStringArray* stringComponentArray, vtkDataArray* typedComponentArray, std::string nullValueString)
 {
@@ -531,14 +676,28 @@ void vtkMRMLTableStorageNode::FillDataFromStringArray(vtkStringArray* stringComp
     }
   else
     {
-    for (vtkIdType row = 0; row < numberOfTuples; ++row)
+    bool valuesSet = false;
+    if (typedComponentArray->IsNumeric() && typedComponentArray->GetNumberOfComponents() == 1
+      && scalarTypeId != VTK_BIT)
       {
-      if (stringComponentArray->GetValue(row).empty())
+      // Parsing numbers directly is much faster than converting each value using vtkVariant
+      switch (scalarTypeId)
         {
-        // empty cell, leave the null value
-        continue;
+        vtkTemplateMacro(FillNumericValuesFromStringArray(stringComponentArray, typedComponentArray, static_cast<VTK_TT*>(nullptr));
+          valuesSet = true);
+        }
+      }
+    if (!valuesSet)
+      {
+      for (vtkIdType row = 0; row < numberOfTuples; ++row)
+        {
+        if (stringComponentArray->GetValue(row).empty())
+          {
+          // empty cell, leave the null value
+          continue;
+          }
+        typedComponentArray->SetVariantValue(row, stringComponentArray->GetVariantValue(row));
         }
-      typedComponentArray->SetVariantValue(row, stringComponentArray->GetVariantValue(row));
       }
     }
 }
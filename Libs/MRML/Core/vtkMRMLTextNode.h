@@ -66,6 +66,10 @@ public:
   vtkGetMacro(Encoding, int);
   std::string GetEncodingAsString();
 
+  /// Text and encoding can only be changed by methods that modify the node,
+  /// therefore undo state can be shared between undo levels.
+  bool CanShareUndoState() override { return true; }
+
   /// Force the use of a storage node, regardless of text length.
   /// By default, a storage node will only be used for nodes that have been read from file (drag and drop),
   /// or for nodes that have text longer than 250 characters.
@@ -33,15 +33,18 @@ Version:   $Revision: 1.14 $
 #include <vtkGeneralTransform.h>
 #include <vtkImageData.h>
 #include <vtkLinearTransform.h>
+#include <vtkMath.h>
 #include <vtkHomogeneousTransform.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPoints.h>
+#include <vtkSMPTools.h>
 #include <vtkThinPlateSplineTransform.h>
 #include <vtkTransform.h>
 #include <vtksys/SystemTools.hxx>
 
 // STD includes
+#include <cmath>
 #include <sstream>
 #include <stack>
 
@@ -58,6 +61,16 @@ vtkMRMLTransformNode::vtkMRMLTransformNode()
   this->CachedMatrixTransformToParent=vtkMatrix4x4::New();
   this->CachedMatrixTransformFromParent=vtkMatrix4x4::New();
 
+  this->CachedTransformToWorld=vtkGeneralTransform::New();
+  this->CachedMatrixTransformToWorld=vtkMatrix4x4::New();
+  this->CachedTransformToWorldLinear=true;
+  this->CachedTransformToWorldValid=false;
+  this->CachedTransformToWorldMTime=0;
+
+  this->BakedTransformToWorld=nullptr;
+  this->BakedTransformFromWorld=nullptr;
+  this->BakedTransformToWorldMTime=0;
+
   this->ContentModifiedEvents->InsertNextValue(vtkMRMLTransformableNode::TransformModifiedEvent);
 
   this->DefaultSequenceStorageNodeClassName = "vtkMRMLLinearTransformSequenceStorageNode";
@@ -73,6 +86,11 @@ vtkMRMLTransformNode::~vtkMRMLTransformNode()
   this->CachedMatrixTransformToParent=nullptr;
   this->CachedMatrixTransformFromParent->Delete();
   this->CachedMatrixTransformFromParent=nullptr;
+  this->CachedTransformToWorld->Delete();
+  this->CachedTransformToWorld=nullptr;
+  this->CachedMatrixTransformToWorld->Delete();
+  this->CachedMatrixTransformToWorld=nullptr;
+  this->ClearBakedTransformToWorld();
 }
 
 //----------------------------------------------------------------------------
@@ -347,6 +365,7 @@ void vtkMRMLTransformNode::PrintSelf(ostream& os, vtkIndent indent)
 {
   Superclass::PrintSelf(os,indent);
   os << indent << "ReadAsTransformToParent: " << this->ReadAsTransformToParent << "\n";
+  os << indent << "TransformToWorldBaked: " << (this->IsTransformToWorldBaked() ? "true" : "false") << "\n";
 
   // Flatten the transform list to make the copying simpler
   if (this->TransformToParent)
@@ -435,7 +454,15 @@ void vtkMRMLTransformNode::GetTransformToWorld(vtkGeneralTransform* transformToW
     vtkErrorMacro("vtkMRMLTransformNode::GetTransformToWorld failed: transformToWorld is invalid");
     return;
     }
-  vtkMRMLTransformNode::GetTransformBetweenNodes(this, nullptr, transformToWorld);
+  transformToWorld->Identity();
+  transformToWorld->PostMultiply();
+  if (this->IsTransformToWorldBaked())
+    {
+    transformToWorld->Concatenate(this->BakedTransformToWorld);
+    return;
+    }
+  this->UpdateTransformToWorldCache();
+  transformToWorld->Concatenate(this->CachedTransformToWorld);
 }
 
 //----------------------------------------------------------------------------
@@ -446,7 +473,142 @@ void vtkMRMLTransformNode::GetTransformFromWorld(vtkGeneralTransform* transformF
     vtkErrorMacro("vtkMRMLTransformNode::GetTransformFromWorld failed: transformToWorld is invalid");
     return;
     }
-  vtkMRMLTransformNode::GetTransformBetweenNodes(nullptr, this, transformFromWorld);
+  transformFromWorld->Identity();
+  transformFromWorld->PostMultiply();
+  if (this->IsTransformToWorldBaked())
+    {
+    transformFromWorld->Concatenate(this->BakedTransformFromWorld);
+    return;
+    }
+  this->UpdateTransformToWorldCache();
+  transformFromWorld->Concatenate(this->CachedTransformToWorld);
+  transformFromWorld->Inverse();
+}
+
+//----------------------------------------------------------------------------
+namespace
+{
+/// Compute the displacement of the grid points of \a displacementField
+/// by \a transform. The transform must be up to date.
+void SampleDisplacementField(vtkAbstractTransform* transform, vtkImageData* displacementField)
+{
+  int* dimensions = displacementField->GetDimensions();
+  double* origin = displacementField->GetOrigin();
+  double* spacing = displacementField->GetSpacing();
+  double* displacements = static_cast<double*>(displacementField->GetScalarPointer());
+  const vtkIdType sliceSize = static_cast<vtkIdType>(dimensions[0]) * dimensions[1];
+  vtkSMPTools::For(0, static_cast<vtkIdType>(dimensions[2]),
+    [&](vtkIdType kBegin, vtkIdType kEnd)
+    {
+    double point[3] = { 0.0, 0.0, 0.0 };
+    double transformedPoint[3] = { 0.0, 0.0, 0.0 };
+    for (vtkIdType k = kBegin; k < kEnd; ++k)
+      {
+      double* displacement = displacements + 3 * k * sliceSize;
+      point[2] = origin[2] + k * spacing[2];
+      for (int j = 0; j < dimensions[1]; ++j)
+        {
+        point[1] = origin[1] + j * spacing[1];
+        for (int i = 0; i < dimensions[0]; ++i)
+          {
+          point[0] = origin[0] + i * spacing[0];
+          transform->InternalTransformPoint(point, transformedPoint);
+          *(displacement++) = transformedPoint[0] - point[0];
+          *(displacement++) = transformedPoint[1] - point[1];
+          *(displacement++) = transformedPoint[2] - point[2];
+          }
+        }
+      }
+    });
+}
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLTransformNode::BakeTransformToWorld(const double bounds[6], const double spacing[3])
+{
+  this->ClearBakedTransformToWorld();
+  if (!bounds || !spacing)
+    {
+    vtkErrorMacro("vtkMRMLTransformNode::BakeTransformToWorld failed: invalid bounds or spacing");
+    return false;
+    }
+  int dimensions[3] = { 0, 0, 0 };
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    if (spacing[axis] <= 0.0 || bounds[axis * 2 + 1] < bounds[axis * 2])
+      {
+      vtkErrorMacro("vtkMRMLTransformNode::BakeTransformToWorld failed: invalid bounds or spacing");
+      return false;
+      }
+    dimensions[axis] = static_cast<int>(ceil((bounds[axis * 2 + 1] - bounds[axis * 2]) / spacing[axis])) + 1;
+    }
+  if (this->IsTransformToWorldLinear())
+    {
+    // linear transforms are already computed as a single matrix
+    return false;
+    }
+
+  // Exact transforms, not using any previously baked transform
+  vtkNew<vtkGeneralTransform> transformToWorld;
+  vtkMRMLTransformNode::GetTransformBetweenNodes(this, nullptr, transformToWorld.GetPointer());
+  transformToWorld->Update();
+  vtkNew<vtkGeneralTransform> transformFromWorld;
+  vtkMRMLTransformNode::GetTransformBetweenNodes(nullptr, this, transformFromWorld.GetPointer());
+  transformFromWorld->Update();
+
+  vtkAbstractTransform* transforms[2] = { transformToWorld.GetPointer(), transformFromWorld.GetPointer() };
+  vtkOrientedGridTransform* bakedTransforms[2] = { nullptr, nullptr };
+  for (int transformIndex = 0; transformIndex < 2; ++transformIndex)
+    {
+    vtkNew<vtkImageData> displacementField;
+    displacementField->SetDimensions(dimensions);
+    displacementField->SetOrigin(bounds[0], bounds[2], bounds[4]);
+    displacementField->SetSpacing(spacing[0], spacing[1], spacing[2]);
+    displacementField->AllocateScalars(VTK_DOUBLE, 3);
+    SampleDisplacementField(transforms[transformIndex], displacementField.GetPointer());
+    bakedTransforms[transformIndex] = vtkOrientedGridTransform::New();
+    bakedTransforms[transformIndex]->SetInterpolationModeToLinear();
+    bakedTransforms[transformIndex]->SetDisplacementGridData(displacementField.GetPointer());
+    }
+  this->BakedTransformToWorld = bakedTransforms[0];
+  this->BakedTransformFromWorld = bakedTransforms[1];
+
+  // The modified time is read after sampling so that inverse transforms
+  // that were created while sampling are taken into account.
+  this->BakedTransformToWorldMTime = this->GetTransformToWorldMTime();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLTransformNode::ClearBakedTransformToWorld()
+{
+  if (this->BakedTransformToWorld)
+    {
+    this->BakedTransformToWorld->Delete();
+    this->BakedTransformToWorld = nullptr;
+    }
+  if (this->BakedTransformFromWorld)
+    {
+    this->BakedTransformFromWorld->Delete();
+    this->BakedTransformFromWorld = nullptr;
+    }
+  this->BakedTransformToWorldMTime = 0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLTransformNode::IsTransformToWorldBaked()
+{
+  if (!this->BakedTransformToWorld || !this->BakedTransformFromWorld)
+    {
+    return false;
+    }
+  if (this->BakedTransformToWorldMTime != this->GetTransformToWorldMTime())
+    {
+    // chain of transforms has been modified
+    this->ClearBakedTransformToWorld();
+    return false;
+    }
+  return true;
 }
 
 //----------------------------------------------------------------------------
@@ -908,13 +1070,31 @@ int vtkMRMLTransformNode::GetMatrixTransformFromParent(vtkMatrix4x4* matrix)
 //----------------------------------------------------------------------------
 int  vtkMRMLTransformNode::GetMatrixTransformToWorld(vtkMatrix4x4* transformToWorld)
 {
-  return vtkMRMLTransformNode::GetMatrixTransformBetweenNodes(this, nullptr, transformToWorld);
+  if (transformToWorld == nullptr)
+    {
+    vtkErrorMacro("vtkMRMLTransformNode::GetMatrixTransformToWorld failed: transformToWorld matrix is invalid");
+    return 0;
+    }
+  this->UpdateTransformToWorldCache();
+  if (!this->CachedTransformToWorldLinear)
+    {
+    vtkWarningMacro("vtkMRMLTransformNode::GetMatrixTransformToWorld failed: expected linear transforms between nodes");
+    transformToWorld->Identity();
+    return 0;
+    }
+  transformToWorld->DeepCopy(this->CachedMatrixTransformToWorld);
+  return 1;
 }
 
 //----------------------------------------------------------------------------
 int  vtkMRMLTransformNode::GetMatrixTransformFromWorld(vtkMatrix4x4* transformFromWorld)
 {
-  return vtkMRMLTransformNode::GetMatrixTransformBetweenNodes(nullptr, this, transformFromWorld);
+  if (!this->GetMatrixTransformToWorld(transformFromWorld))
+    {
+    return 0;
+    }
+  transformFromWorld->Invert();
+  return 1;
 }
 
 //----------------------------------------------------------------------------
@@ -944,6 +1124,16 @@ int  vtkMRMLTransformNode::GetMatrixTransformBetweenNodes(vtkMRMLTransformNode*
     return 1;
     }
 
+  // use the cached transforms to world
+  if (targetNode == nullptr)
+    {
+    return sourceNode->GetMatrixTransformToWorld(transformSourceToTarget);
+    }
+  if (sourceNode == nullptr)
+    {
+    return targetNode->GetMatrixTransformFromWorld(transformSourceToTarget);
+    }
+
   if (sourceNode && sourceNode->IsTransformNodeMyParent(targetNode))
     {
     transformSourceToTarget->Identity();
@@ -1242,9 +1432,9 @@ void vtkMRMLTransformNode::InverseName()
 //----------------------------------------------------------------------------
 vtkMTimeType vtkMRMLTransformNode::GetTransformToWorldMTime()
 {
-  vtkMTimeType latestMTime=0;
+  vtkMTimeType latestMTime=this->TransformToParentModifiedTime.GetMTime();
   vtkAbstractTransform* transformToParent=this->GetTransformToParent();
-  if (transformToParent!=nullptr)
+  if (transformToParent!=nullptr && transformToParent->GetMTime()>latestMTime)
     {
     latestMTime=transformToParent->GetMTime();
     }
@@ -1261,6 +1451,76 @@ vtkMTimeType vtkMRMLTransformNode::GetTransformToWorldMTime()
   return latestMTime;
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLTransformNode::OnTransformNodeReferenceChanged(vtkMRMLTransformNode* transformNode)
+{
+  this->TransformToParentModifiedTime.Modified();
+  Superclass::OnTransformNodeReferenceChanged(transformNode);
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLTransformNode::UpdateTransformToWorldCache()
+{
+  vtkMTimeType transformToWorldMTime = this->GetTransformToWorldMTime();
+  if (this->CachedTransformToWorldValid && this->CachedTransformToWorldMTime == transformToWorldMTime)
+    {
+    return;
+    }
+
+  this->CachedTransformToWorld->Identity();
+  this->CachedTransformToWorld->PostMultiply();
+  this->CachedTransformToWorldLinear = true;
+
+  // product of the last consecutive linear transforms of the chain
+  vtkNew<vtkMatrix4x4> linearTransformToParent;
+
+  // See loop detection in GetTransformBetweenNodes
+  int maxDepth = 100;
+  int currentDepth = 0;
+  std::set<vtkMRMLTransformNode*> visitedTransformNodes;
+  for (vtkMRMLTransformNode* current = this; current != nullptr; current = current->GetParentTransformNode())
+    {
+    vtkAbstractTransform* transformToParent = current->GetTransformToParent();
+    if (transformToParent)
+      {
+      vtkNew<vtkMatrix4x4> toParentMatrix;
+      if (current->IsLinear() && current->GetMatrixTransformToParent(toParentMatrix.GetPointer()))
+        {
+        vtkMatrix4x4::Multiply4x4(toParentMatrix.GetPointer(), linearTransformToParent.GetPointer(),
+          linearTransformToParent.GetPointer());
+        }
+      else
+        {
+        if (!linearTransformToParent->IsIdentity())
+          {
+          this->CachedTransformToWorld->Concatenate(linearTransformToParent.GetPointer());
+          linearTransformToParent->Identity();
+          }
+        this->CachedTransformToWorld->Concatenate(transformToParent);
+        this->CachedTransformToWorldLinear = false;
+        }
+      }
+
+    ++currentDepth;
+    if (currentDepth > maxDepth && !visitedTransformNodes.insert(current).second)
+      {
+      vtkWarningMacro("vtkMRMLTransformNode::UpdateTransformToWorldCache: Loop detected between transform nodes");
+      this->CachedTransformToWorld->Identity();
+      this->CachedTransformToWorldLinear = true;
+      linearTransformToParent->Identity();
+      break;
+      }
+    }
+  if (!linearTransformToParent->IsIdentity())
+    {
+    this->CachedTransformToWorld->Concatenate(linearTransformToParent.GetPointer());
+    }
+  this->CachedMatrixTransformToWorld->DeepCopy(linearTransformToParent.GetPointer());
+
+  this->CachedTransformToWorldMTime = transformToWorldMTime;
+  this->CachedTransformToWorldValid = true;
+}
+
 //----------------------------------------------------------------------------
 const char* vtkMRMLTransformNode::GetTransformToParentInfo()
 {
@@ -1646,6 +1906,98 @@ int vtkMRMLTransformNode::SetAndObserveMatrixTransformFromParent(vtkMatrix4x4 *m
   return SetMatrixTransformFromParent(matrix);
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLTransformNode::InverseTransformPoints(vtkAbstractTransform* forwardTransform,
+  vtkPoints* inputPoints, vtkPoints* outputPoints, double tolerance/*=0.001*/)
+{
+  if (!forwardTransform || !inputPoints || !outputPoints)
+    {
+    vtkGenericWarningMacro("vtkMRMLTransformNode::InverseTransformPoints failed: invalid input");
+    return;
+    }
+  const vtkIdType numberOfPoints = inputPoints->GetNumberOfPoints();
+  outputPoints->SetDataTypeToDouble();
+  outputPoints->SetNumberOfPoints(numberOfPoints);
+  if (numberOfPoints == 0)
+    {
+    return;
+    }
+  double* outputPointsPtr = static_cast<double*>(outputPoints->GetVoidPointer(0));
+
+  // Transforms must be up to date before they are used from multiple threads.
+  // The inverse is only used for the points where the iterations fail.
+  forwardTransform->Update();
+  vtkAbstractTransform* inverseTransform = forwardTransform->GetInverse();
+  inverseTransform->Update();
+
+  const double toleranceSquared = tolerance * tolerance;
+  const int maxNumberOfIterations = 10;
+  vtkSMPTools::For(0, numberOfPoints,
+    [&](vtkIdType pointBegin, vtkIdType pointEnd)
+    {
+    double previousInput[3] = { 0.0, 0.0, 0.0 };
+    double previousOutput[3] = { 0.0, 0.0, 0.0 };
+    bool previousValid = false;
+    double input[3] = { 0.0, 0.0, 0.0 };
+    double transformedOutput[3] = { 0.0, 0.0, 0.0 };
+    double derivative[3][3];
+    double error[3] = { 0.0, 0.0, 0.0 };
+    double step[3] = { 0.0, 0.0, 0.0 };
+    for (vtkIdType pointId = pointBegin; pointId < pointEnd; ++pointId)
+      {
+      inputPoints->GetPoint(pointId, input);
+      double* output = outputPointsPtr + 3 * pointId;
+
+      // Initial guess: solution of the previous point, shifted by the same amount as the input
+      if (previousValid)
+        {
+        for (int i = 0; i < 3; ++i)
+          {
+          output[i] = previousOutput[i] + input[i] - previousInput[i];
+          }
+        }
+      else
+        {
+        forwardTransform->InternalTransformPoint(input, transformedOutput);
+        for (int i = 0; i < 3; ++i)
+          {
+          output[i] = 2.0 * input[i] - transformedOutput[i];
+          }
+        }
+
+      bool converged = false;
+      for (int iteration = 0; iteration < maxNumberOfIterations; ++iteration)
+        {
+        forwardTransform->InternalTransformDerivative(output, transformedOutput, derivative);
+        vtkMath::Subtract(transformedOutput, input, error);
+        if (vtkMath::Dot(error, error) < toleranceSquared)
+          {
+          converged = true;
+          break;
+          }
+        if (fabs(vtkMath::Determinant3x3(derivative)) < 1e-12)
+          {
+          break;
+          }
+        vtkMath::LinearSolve3x3(derivative, error, step);
+        vtkMath::Subtract(output, step, output);
+        }
+      if (!converged)
+        {
+        inverseTransform->InternalTransformPoint(input, output);
+        }
+
+      for (int i = 0; i < 3; ++i)
+        {
+        previousInput[i] = input[i];
+        previousOutput[i] = output[i];
+        }
+      previousValid = true;
+      }
+    });
+  outputPoints->Modified();
+}
+
 //----------------------------------------------------------------------------
 bool vtkMRMLTransformNode::IsGeneralTransformLinear(vtkAbstractTransform* inputTransform, vtkTransform* concatenatedLinearTransform/*=nullptr*/)
 {
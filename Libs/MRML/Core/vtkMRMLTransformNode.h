@@ -21,6 +21,8 @@ class vtkCollection;
 class vtkAbstractTransform;
 class vtkGeneralTransform;
 class vtkMatrix4x4;
+class vtkOrientedGridTransform;
+class vtkPoints;
 class vtkTransform;
 
 /// \brief MRML node for representing a transformation
@@ -121,6 +123,9 @@ public:
   ///
   /// Get concatenated transforms to world.
   /// The method may change the PreMultiply/PostMultiply flag of the transform.
+  /// The concatenation is cached until the transform of this node or of a parent
+  /// changes (see GetTransformToWorldMTime()), consecutive linear transforms of the
+  /// chain are merged into a single matrix.
   /// \sa GetTransformBetweenNodes
   void GetTransformToWorld(vtkGeneralTransform* transformToWorld);
 
@@ -130,6 +135,27 @@ public:
   /// \sa GetTransformBetweenNodes
   void GetTransformFromWorld(vtkGeneralTransform* transformFromWorld);
 
+  ///
+  /// Evaluate the non-linear transform to world and from world once, on a regular
+  /// grid covering \a bounds (xmin, xmax, ymin, ymax, zmin, zmax) with \a spacing,
+  /// and store them as displacement fields. The grid points are sampled in parallel.
+  /// While the chain of transforms is not modified (see GetTransformToWorldMTime()),
+  /// GetTransformToWorld() and GetTransformFromWorld() return the baked grid
+  /// transforms instead of the concatenation, which avoids iterative inversion of
+  /// the transforms when reslicing or transforming models. Outside of the bounds the
+  /// displacement of the closest grid point is used. When the chain is modified the
+  /// baked transforms are discarded, this method has to be called again.
+  /// GetTransformBetweenNodes() always computes the exact transform.
+  /// Returns false if the transform to world is linear or the grid is invalid.
+  bool BakeTransformToWorld(const double bounds[6], const double spacing[3]);
+
+  /// Discard the transforms computed by BakeTransformToWorld().
+  void ClearBakedTransformToWorld();
+
+  /// Return true if the transforms computed by BakeTransformToWorld() are up to date
+  /// and used by GetTransformToWorld() and GetTransformFromWorld().
+  bool IsTransformToWorldBaked();
+
   ///
   /// Get concatenated transforms to the specified node.
   /// The method may change the PreMultiply/PostMultiply flag of the transform.
@@ -154,6 +180,7 @@ public:
   ///
   /// Get concatenated transforms to world.
   /// Returns 0 if the transform is not linear (cannot be described by a matrix).
+  /// The matrix is cached until the transform of this node or of a parent changes.
   /// \sa GetMatrixTransformBetweenNodes
   virtual int GetMatrixTransformToWorld(vtkMatrix4x4* transformToWorld);
 
@@ -279,6 +306,7 @@ public:
   /// and then re-enable transform modified events to invoke any pending notifications.
   virtual void TransformModified()
     {
+    this->TransformToParentModifiedTime.Modified();
     this->InvokeCustomModifiedEvent(vtkMRMLTransformableNode::TransformModifiedEvent);
     }
 
@@ -334,6 +362,19 @@ public:
   /// transformation matrix.
   static bool IsGeneralTransformLinear(vtkAbstractTransform* inputTransform, vtkTransform* concatenatedLinearTransform=nullptr);
 
+  ///
+  /// Utility function that transforms points by the inverse of \a forwardTransform.
+  /// Points are processed in parallel. Each point is computed by Newton iterations on
+  /// the forward transform, starting from the solution of the previous point of the
+  /// same batch, which converges in a few iterations for neighbor points (such as the
+  /// voxels of an image row). Points where the forward transformed solution is not
+  /// within \a tolerance of the input point after the iterations are computed by the
+  /// inverse of \a forwardTransform. This is much faster than the point by point inversion of
+  /// grid, BSpline, and thin-plate spline transforms.
+  /// The output points are stored as double.
+  static void InverseTransformPoints(vtkAbstractTransform* forwardTransform,
+    vtkPoints* inputPoints, vtkPoints* outputPoints, double tolerance=0.001);
+
   ///
   /// Utility function that determines if a transform is computed from its inverse.
   /// It may be important to know if a transform is computed from its inverse because then
@@ -355,7 +396,8 @@ public:
   /// Inversion is implemented by adding/removing " (-)" suffix.
   virtual void InverseName();
 
-  /// Get the latest modification time of the stored transform
+  /// Get the latest modification time of the stored transform, of the transforms
+  /// of the parents, and of the parent transform node references of the chain.
   vtkMTimeType GetTransformToWorldMTime();
 
   /// Get a human-readable description of the transformation
@@ -382,6 +424,14 @@ protected:
   /// transform type then it returns nullptr.
   virtual vtkAbstractTransform* GetAbstractTransformAs(vtkAbstractTransform* inputTransform, const char* transformClassName, bool logErrorIfFails);
 
+  /// Called when the parent transform node changes
+  void OnTransformNodeReferenceChanged(vtkMRMLTransformNode* transformNode) override;
+
+  ///
+  /// Compute the transform to world again if the chain of transforms has
+  /// been modified since it was cached (GetTransformToWorldMTime() changed).
+  void UpdateTransformToWorldCache();
+
   ///
   /// Sets and observes a transform and deletes the inverse (so that the inverse will be computed automatically)
   virtual void SetAndObserveTransform(vtkAbstractTransform** originalTransformPtr, vtkAbstractTransform** inverseTransformPtr, vtkAbstractTransform *transform);
@@ -405,6 +455,25 @@ protected:
   /// GetMatrixTransformToParent and GetMatrixFromParent methods
   vtkMatrix4x4* CachedMatrixTransformToParent;
   vtkMatrix4x4* CachedMatrixTransformFromParent;
+
+  /// Modified when the transform to parent or the parent transform node changes
+  vtkTimeStamp TransformToParentModifiedTime;
+
+  ///
+  /// Transform to world, updated by UpdateTransformToWorldCache().
+  /// CachedMatrixTransformToWorld is only valid if CachedTransformToWorldLinear is true.
+  vtkGeneralTransform* CachedTransformToWorld;
+  vtkMatrix4x4* CachedMatrixTransformToWorld;
+  bool CachedTransformToWorldLinear;
+  bool CachedTransformToWorldValid;
+  vtkMTimeType CachedTransformToWorldMTime;
+
+  ///
+  /// Displacement grids computed by BakeTransformToWorld().
+  /// Only used if BakedTransformToWorldMTime equals GetTransformToWorldMTime().
+  vtkOrientedGridTransform* BakedTransformToWorld;
+  vtkOrientedGridTransform* BakedTransformFromWorld;
+  vtkMTimeType BakedTransformToWorldMTime;
 };
 
 #endif
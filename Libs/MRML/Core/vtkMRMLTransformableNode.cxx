@@ -187,8 +187,9 @@ bool vtkMRMLTransformableNode::HardenTransform()
     }
   else
     {
+    // exact transform, not the transform baked by BakeTransformToWorld()
     vtkNew<vtkGeneralTransform> hardeningTransform;
-    transformNode->GetTransformToWorld(hardeningTransform.GetPointer());
+    vtkMRMLTransformNode::GetTransformBetweenNodes(transformNode, nullptr, hardeningTransform.GetPointer());
     this->ApplyTransform(hardeningTransform.GetPointer());
     }
 
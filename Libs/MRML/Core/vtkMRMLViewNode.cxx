@@ -63,6 +63,7 @@ vtkMRMLViewNode::vtkMRMLViewNode()
   this->RaycastTechnique = vtkMRMLViewNode::Composite;
   this->VolumeRenderingSurfaceSmoothing = false;
   this->VolumeRenderingOversamplingFactor = 2.0;
+  this->VolumeRenderingTargetLatency = 0.0;
   this->LinkedControl = 0;
   this->Interacting = 0;
   this->InteractionFlags = 0;
@@ -110,6 +111,7 @@ void vtkMRMLViewNode::WriteXML(ostream& of, int nIndent)
   vtkMRMLWriteXMLEnumMacro(raycastTechnique, RaycastTechnique);
   vtkMRMLWriteXMLIntMacro(volumeRenderingSurfaceSmoothing, VolumeRenderingSurfaceSmoothing);
   vtkMRMLWriteXMLFloatMacro(volumeRenderingOversamplingFactor, VolumeRenderingOversamplingFactor);
+  vtkMRMLWriteXMLFloatMacro(volumeRenderingTargetLatency, VolumeRenderingTargetLatency);
   vtkMRMLWriteXMLIntMacro(linkedControl, LinkedControl);
   vtkMRMLWriteXMLEndMacro();
 }
@@ -148,6 +150,7 @@ void vtkMRMLViewNode::ReadXMLAttributes(const char** atts)
   vtkMRMLReadXMLEnumMacro(raycastTechnique, RaycastTechnique);
   vtkMRMLReadXMLIntMacro(volumeRenderingSurfaceSmoothing, VolumeRenderingSurfaceSmoothing);
   vtkMRMLReadXMLFloatMacro(volumeRenderingOversamplingFactor, VolumeRenderingOversamplingFactor);
+  vtkMRMLReadXMLFloatMacro(volumeRenderingTargetLatency, VolumeRenderingTargetLatency);
   vtkMRMLReadXMLIntMacro(linkedControl, LinkedControl);
   vtkMRMLReadXMLEndMacro();
 
@@ -187,6 +190,7 @@ void vtkMRMLViewNode::CopyContent(vtkMRMLNode* anode, bool deepCopy/*=true*/)
   vtkMRMLCopyIntMacro(RaycastTechnique);
   vtkMRMLCopyIntMacro(VolumeRenderingSurfaceSmoothing);
   vtkMRMLCopyFloatMacro(VolumeRenderingOversamplingFactor);
+  vtkMRMLCopyFloatMacro(VolumeRenderingTargetLatency);
   vtkMRMLCopyIntMacro(LinkedControl);
   vtkMRMLCopyEndMacro();
 }
@@ -223,6 +227,7 @@ void vtkMRMLViewNode::PrintSelf(ostream& os, vtkIndent indent)
   vtkMRMLPrintIntMacro(RaycastTechnique);
   vtkMRMLPrintIntMacro(VolumeRenderingSurfaceSmoothing);
   vtkMRMLPrintFloatMacro(VolumeRenderingOversamplingFactor);
+  vtkMRMLPrintFloatMacro(VolumeRenderingTargetLatency);
   vtkMRMLPrintIntMacro(Interacting);
   vtkMRMLPrintIntMacro(LinkedControl);
   vtkMRMLPrintEndMacro();
@@ -189,6 +189,15 @@ public:
   vtkSetMacro(VolumeRenderingOversamplingFactor, double);
   vtkGetMacro(VolumeRenderingOversamplingFactor, double);
 
+  /// Target rendering time of interactive frames, in milliseconds.
+  /// If positive and \sa VolumeRenderingQuality is Adaptive, then the sample distance
+  /// and image sample distance of volume rendering are adjusted during interaction
+  /// based on the measured rendering time of previous frames, and a full quality
+  /// frame is rendered when interaction stops.
+  /// If 0 (default), the sampling is automatically adjusted by VTK to reach \sa ExpectedFPS.
+  vtkSetClampMacro(VolumeRenderingTargetLatency, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(VolumeRenderingTargetLatency, double);
+
   /// Modes for automatically controlling camera
   enum
     {
@@ -395,6 +404,8 @@ protected:
   /// If \sa VolumeRenderingQuality is set to maximum quality, then a fix oversampling factor of 10 is used.
   double VolumeRenderingOversamplingFactor;
 
+  double VolumeRenderingTargetLatency;
+
   int LinkedControl;
   int Interacting;
   unsigned int InteractionFlags;
@@ -30,7 +30,14 @@ Version:   $Revision: 1.6 $
 #include "vtkITKArchetypeImageSeriesVectorReaderSeries.h"
 #include "vtkITKImageWriter.h"
 
+// vtkTeem includes
+#include <vtkTeemNRRDReader.h>
+
+// ITK includes
+#include <itkMetaDataObject.h>
+
 // VTKsys includes
+#include <vtksys/SystemInformation.hxx>
 #include <vtksys/SystemTools.hxx>
 
 // VTK includes
@@ -85,6 +92,7 @@ vtkMRMLVolumeArchetypeStorageNode::vtkMRMLVolumeArchetypeStorageNode()
   this->CenterImage = 0;
   this->SingleFile  = 0;
   this->UseOrientationFromFile = 1;
+  this->UseMemoryMapping = false;
   this->DefaultWriteFileExtension = "nrrd";
 }
 
@@ -105,6 +113,10 @@ void vtkMRMLVolumeArchetypeStorageNode::WriteXML(ostream& of, int nIndent)
   ss << this->UseOrientationFromFile;
   of << " UseOrientationFromFile=\"" << ss.str() << "\"";
   }
+  if (this->UseMemoryMapping)
+    {
+    of << " useMemoryMapping=\"true\"";
+    }
   // SingleFile attribute is not written to file. GetNumberOfFileNames()
   // is used to determine if reader should read from single/multiple files.
 }
@@ -134,6 +146,10 @@ void vtkMRMLVolumeArchetypeStorageNode::ReadXMLAttributes(const char** atts)
       ss << attValue;
       ss >> this->UseOrientationFromFile;
       }
+    if (!strcmp(attName, "useMemoryMapping"))
+      {
+      this->UseMemoryMapping = !strcmp(attValue, "true");
+      }
     }
 
   // SingleFile attribute used to be read from the scene, but often
@@ -158,6 +174,7 @@ void vtkMRMLVolumeArchetypeStorageNode::Copy(vtkMRMLNode *anode)
   this->SetCenterImage(node->CenterImage);
   this->SetSingleFile(node->SingleFile);
   this->SetUseOrientationFromFile(node->UseOrientationFromFile);
+  this->SetUseMemoryMapping(node->UseMemoryMapping);
 
   this->EndModify(disabledModify);
 }
@@ -169,6 +186,7 @@ void vtkMRMLVolumeArchetypeStorageNode::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "CenterImage:   " << this->CenterImage << "\n";
   os << indent << "SingleFile:   " << this->SingleFile << "\n";
   os << indent << "UseOrientationFromFile:   " << this->UseOrientationFromFile << "\n";
+  os << indent << "UseMemoryMapping:   " << (this->UseMemoryMapping ? "true" : "false") << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -178,6 +196,25 @@ bool vtkMRMLVolumeArchetypeStorageNode::CanReadInReferenceNode(vtkMRMLNode *refN
          refNode->IsA("vtkMRMLVectorVolumeNode" );
 }
 
+//----------------------------------------------------------------------------
+bool vtkMRMLVolumeArchetypeStorageNode::CanReadInBackgroundThread()
+{
+  if (!this->GetFileName() || (!this->GetSingleFile() && this->GetNumberOfFileNames() > 1))
+    {
+    return false;
+    }
+  std::string fileName = vtksys::SystemTools::LowerCase(this->GetFileName());
+  const char* backgroundReadExtensions[] = { ".nrrd", ".nhdr", ".nii", ".nii.gz", ".mha", ".mhd" };
+  for (const char* extension : backgroundReadExtensions)
+    {
+    if (vtksys::SystemTools::StringEndsWith(fileName, extension))
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
 //----------------------------------------------------------------------------
 bool vtkMRMLVolumeArchetypeStorageNode::CanWriteFromReferenceNode(vtkMRMLNode *refNode)
 {
@@ -247,6 +284,16 @@ vtkMRMLVolumeArchetypeStorageNode::InstantiateVectorVolumeReader(const std::stri
 namespace
 {
 
+//----------------------------------------------------------------------------
+bool IsFileLargerThanAvailablePhysicalMemory(const std::string& fileName)
+{
+  vtksys::SystemInformation systemInformation;
+  // Available memory is reported in MiB
+  unsigned long long availableMemory = static_cast<unsigned long long>(systemInformation.GetAvailablePhysicalMemory()) * 1024 * 1024;
+  unsigned long long fileSize = static_cast<unsigned long long>(vtksys::SystemTools::FileLength(fileName));
+  return availableMemory > 0 && fileSize > availableMemory;
+}
+
 //----------------------------------------------------------------------------
 void ApplyImageSeriesReaderWorkaround(vtkMRMLVolumeArchetypeStorageNode * storageNode,
                                       vtkITKArchetypeImageSeriesReader * reader,
@@ -327,6 +374,20 @@ int vtkMRMLVolumeArchetypeStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
     return 0;
     }
 
+  if (this->UseOrientationFromFile && this->GetNumberOfFileNames() <= 1
+    && !refNode->IsA("vtkMRMLVectorVolumeNode") && !refNode->IsA("vtkMRMLTensorVolumeNode"))
+    {
+    std::string extension = vtksys::SystemTools::LowerCase(vtksys::SystemTools::GetFilenameLastExtension(fullName));
+    // Files that cannot be read into physical memory are always memory-mapped, the operating system
+    // then only keeps the recently accessed parts of the volume in memory.
+    if ((extension == ".nrrd" || extension == ".nhdr")
+      && (this->UseMemoryMapping || IsFileLargerThanAvailablePhysicalMemory(fullName))
+      && this->ReadDataMemoryMapped(volNode, fullName))
+      {
+      return 1;
+      }
+    }
+
   vtkSmartPointer<vtkITKArchetypeImageSeriesReader> reader;
 
   if (refNode->IsA("vtkMRMLVectorVolumeNode"))
@@ -529,6 +590,61 @@ int vtkMRMLVolumeArchetypeStorageNode::ReadDataInternal(vtkMRMLNode *refNode)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+bool vtkMRMLVolumeArchetypeStorageNode::ReadDataMemoryMapped(vtkMRMLScalarVolumeNode* volNode, const std::string& fullName)
+{
+  vtkNew<vtkTeemNRRDReader> reader;
+  if (!reader->CanReadFile(fullName.c_str()))
+    {
+    return false;
+    }
+  reader->SetFileName(fullName.c_str());
+  if (this->CenterImage)
+    {
+    reader->SetUseNativeOriginOff();
+    }
+  else
+    {
+    reader->SetUseNativeOriginOn();
+    }
+  reader->UseMemoryMappingOn();
+  reader->UpdateInformation();
+  if (reader->GetReadStatus() != 0
+    || reader->GetPointDataType() != vtkDataSetAttributes::SCALARS
+    || reader->GetNumberOfComponents() != 1)
+    {
+    // Only single-component scalar volumes are read this way
+    return false;
+    }
+  reader->Update();
+  vtkImageData* image = reader->GetOutput();
+  if (!image || !image->GetPointData() || !image->GetPointData()->GetScalars()
+    || image->GetPointData()->GetScalars()->GetNumberOfTuples() == 0)
+    {
+    return false;
+    }
+
+  vtkNew<vtkImageData> outputImage;
+  outputImage->ShallowCopy(image);
+  outputImage->SetSpacing(1.0, 1.0, 1.0);
+  outputImage->SetOrigin(0.0, 0.0, 0.0);
+  volNode->SetAndObserveImageData(outputImage);
+  volNode->SetRASToIJKMatrix(reader->GetRasToIjkMatrix());
+
+  itk::MetaDataDictionary dictionary;
+  const std::map<std::string, std::string> headerKeys = reader->GetHeaderKeysMap();
+  for (std::map<std::string, std::string>::const_iterator keyIt = headerKeys.begin(); keyIt != headerKeys.end(); ++keyIt)
+    {
+    itk::EncapsulateMetaData<std::string>(dictionary, keyIt->first, keyIt->second);
+    }
+  volNode->SetMetaDataDictionary(dictionary);
+
+  vtkDebugMacro(<< "Loaded volume from file using memory mapping: " << fullName
+    << ". Dimensions: " << outputImage->GetDimensions()[0] << "x" << outputImage->GetDimensions()[1] << "x" << outputImage->GetDimensions()[2]
+    << ". Pixel type: " << vtkImageScalarTypeNameMacro(outputImage->GetScalarType()) << ".");
+  return true;
+}
+
 //----------------------------------------------------------------------------
 int vtkMRMLVolumeArchetypeStorageNode::WriteDataInternal(vtkMRMLNode *refNode)
 {
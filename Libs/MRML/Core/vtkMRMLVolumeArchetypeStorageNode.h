@@ -19,6 +19,7 @@
 
 class vtkImageData;
 class vtkITKArchetypeImageSeriesReader;
+class vtkMRMLScalarVolumeNode;
 class vtkMRMLVolumeNode;
 
 /// \brief MRML node for representing a volume storage.
@@ -75,10 +76,33 @@ public:
   vtkSetMacro(UseOrientationFromFile, int);
   vtkGetMacro(UseOrientationFromFile, int);
 
+  ///
+  /// Map voxel data of uncompressed NRRD files (.nrrd, .nhdr) directly from the file
+  /// instead of copying it into a newly allocated buffer. This makes loading of large
+  /// volumes near-instant and memory is shared between processes that load the same file.
+  /// Voxel data is copy-on-write: modifying the volume does not change the file.
+  /// Only used for scalar volumes, other files are read normally. Disabled by default.
+  /// Files that are larger than the available physical memory are memory-mapped even
+  /// if this option is disabled: voxel data is then paged in from the file as it is
+  /// accessed (for example by slice views) and the operating system evicts the least
+  /// recently used pages when memory is needed.
+  vtkSetMacro(UseMemoryMapping, bool);
+  vtkGetMacro(UseMemoryMapping, bool);
+  vtkBooleanMacro(UseMemoryMapping, bool);
+
   /// Return true if the reference node is supported by the storage node
   bool CanReadInReferenceNode(vtkMRMLNode* refNode) override;
   bool CanWriteFromReferenceNode(vtkMRMLNode* refNode) override;
 
+  /// Single files in formats that ITK reads without global state (NRRD, NIfTI, MetaImage)
+  /// are read into a separate volume, without accessing the scene.
+  /// Image series and DICOM files are always read on the main thread.
+  bool CanReadInBackgroundThread() override;
+
+  /// Volumes are written on the main thread because the writer looks up the write file format
+  /// in the scene's data I/O manager and writes through a temporary directory that is named after the file.
+  bool CanWriteInBackgroundThread() override { return false; }
+
   ///
   /// Configure the storage node for data exchange. This is an
   /// opportunity to optimize the storage node's settings, for
@@ -108,12 +132,17 @@ protected:
   /// Read data and set it in the referenced node
   int ReadDataInternal(vtkMRMLNode *refNode) override;
 
+  /// Read scalar volume from NRRD file using memory mapping.
+  /// \return False if the file could not be read this way.
+  bool ReadDataMemoryMapped(vtkMRMLScalarVolumeNode* volNode, const std::string& fullName);
+
   /// Write data from a referenced node
   int WriteDataInternal(vtkMRMLNode *refNode) override;
 
   int CenterImage;
   int SingleFile;
   int UseOrientationFromFile;
+  bool UseMemoryMapping;
 
 };
 
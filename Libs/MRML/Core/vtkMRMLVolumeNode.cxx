@@ -26,21 +26,27 @@ Version:   $Revision: 1.14 $
 #include <vtkAppendPolyData.h>
 #include <vtkBoundingBox.h>
 #include <vtkCallbackCommand.h>
+#include <vtkDataArray.h>
 #include <vtkEventForwarderCommand.h>
 #include <vtkGeneralTransform.h>
+#include <vtkGridTransform.h>
 #include <vtkHomogeneousTransform.h>
 #include <vtkImageData.h>
 #include <vtkImageDataGeometryFilter.h>
 #include <vtkImageReslice.h>
+#include <vtkLZ4DataCompressor.h>
 #include <vtkMathUtilities.h>
 #include <vtkMatrix4x4.h>
 #include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
 #include <vtkSmartPointer.h>
 #include <vtkTransform.h>
 #include <vtkTrivialProducer.h>
 
-#include <algorithm> // For std::min
+#include <algorithm> // For std::min, std::max
 #include <cassert>
+#include <cstring> // For memcpy
 #include <vector>
 
 //----------------------------------------------------------------------------
@@ -667,6 +673,12 @@ const char* vtkMRMLVolumeNode::ComputeScanOrderFromIJKToRAS(vtkMatrix4x4 *ijkToR
 //----------------------------------------------------------------------------
 void vtkMRMLVolumeNode::SetAndObserveImageData(vtkImageData *imageData)
 {
+  if (this->CompressedScalarsArray)
+    {
+    // Compressed voxel values belong to the image data that is being replaced
+    this->ClearDataCompressedInMemory();
+    this->DataReadPending = false;
+    }
   if (imageData == nullptr)
     {
     vtkTrivialProducer* oldProducer = vtkTrivialProducer::SafeDownCast(
@@ -705,9 +717,119 @@ void vtkMRMLVolumeNode::SetAndObserveImageData(vtkImageData *imageData)
     }
 }
 
+//---------------------------------------------------------------------------
+bool vtkMRMLVolumeNode::ReleaseDataInternal()
+{
+  this->SetAndObserveImageData(nullptr);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLVolumeNode::CompressDataInMemory()
+{
+  if (this->DataReadPending)
+    {
+    // data is already compressed or not in memory
+    return this->GetDataCompressedInMemory();
+    }
+  vtkImageData* imageData = this->GetImageData();
+  vtkDataArray* scalars = imageData ? imageData->GetPointData()->GetScalars() : nullptr;
+  if (!scalars || scalars->GetNumberOfValues() == 0)
+    {
+    return false;
+    }
+  size_t uncompressedSize = static_cast<size_t>(scalars->GetNumberOfValues()) * scalars->GetDataTypeSize();
+
+  // LZ4 is used because decompression is very fast, which allows restoring the voxels
+  // whenever the volume is accessed (for example, during sequence replay).
+  vtkNew<vtkLZ4DataCompressor> compressor;
+  std::vector<unsigned char> compressedScalars(compressor->GetMaximumCompressionSpace(uncompressedSize));
+  size_t compressedSize = compressor->Compress(static_cast<unsigned char*>(scalars->GetVoidPointer(0)),
+    uncompressedSize, compressedScalars.data(), compressedScalars.size());
+  if (compressedSize == 0 || compressedSize >= uncompressedSize)
+    {
+    // compression failed or would not save memory
+    return false;
+    }
+  compressedScalars.resize(compressedSize);
+  compressedScalars.shrink_to_fit();
+
+  bool modifiedSinceRead = this->GetModifiedSinceRead();
+  vtkSmartPointer<vtkDataArray> compressedScalarsArray = vtkSmartPointer<vtkDataArray>::Take(scalars->NewInstance());
+  compressedScalarsArray->SetNumberOfComponents(scalars->GetNumberOfComponents());
+  compressedScalarsArray->SetName(scalars->GetName());
+  vtkIdType numberOfTuples = scalars->GetNumberOfTuples();
+
+  // As in ReleaseDataInternal(), the image data may be shared with other objects,
+  // therefore the node gets a new image data that only has the geometry.
+  // The superclass method is called so that subclasses do not reset their content.
+  vtkSmartPointer<vtkImageData> geometryImageData = vtkSmartPointer<vtkImageData>::Take(imageData->NewInstance());
+  geometryImageData->CopyStructure(imageData);
+  this->vtkMRMLVolumeNode::SetAndObserveImageData(geometryImageData);
+
+  this->CompressedScalars.swap(compressedScalars);
+  this->CompressedScalarsNumberOfTuples = numberOfTuples;
+  this->CompressedScalarsArray = compressedScalarsArray;
+  this->CompressedScalarsModifiedSinceRead = modifiedSinceRead;
+  this->DecompressedDataMTime = 0;
+  this->DataReadPending = true;
+  return true;
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLVolumeNode::GetDataCompressedInMemory()
+{
+  return (this->DataReadPending && this->CompressedScalarsArray != nullptr);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeNode::ClearDataCompressedInMemory()
+{
+  this->CompressedScalars.clear();
+  this->CompressedScalars.shrink_to_fit();
+  this->CompressedScalarsArray = nullptr;
+  this->CompressedScalarsNumberOfTuples = 0;
+  this->CompressedScalarsModifiedSinceRead = false;
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLVolumeNode::ReadPendingDataInternal()
+{
+  if (!this->CompressedScalarsArray)
+    {
+    return this->Superclass::ReadPendingDataInternal();
+    }
+  vtkSmartPointer<vtkDataArray> scalars = this->CompressedScalarsArray;
+  bool modifiedSinceRead = this->CompressedScalarsModifiedSinceRead;
+  scalars->SetNumberOfTuples(this->CompressedScalarsNumberOfTuples);
+  size_t uncompressedSize = static_cast<size_t>(scalars->GetNumberOfValues()) * scalars->GetDataTypeSize();
+  vtkNew<vtkLZ4DataCompressor> compressor;
+  size_t decompressedSize = compressor->Uncompress(this->CompressedScalars.data(), this->CompressedScalars.size(),
+    static_cast<unsigned char*>(scalars->GetVoidPointer(0)), uncompressedSize);
+  this->ClearDataCompressedInMemory();
+  if (decompressedSize != uncompressedSize)
+    {
+    vtkErrorMacro("ReadPendingDataInternal: failed to decompress voxel values of " << (this->GetID() ? this->GetID() : "(unknown)"));
+    return false;
+    }
+  vtkImageData* imageData = this->GetImageData();
+  if (imageData)
+    {
+    imageData->GetPointData()->SetScalars(scalars);
+    }
+  if (!modifiedSinceRead)
+    {
+    // restoring the voxels does not make the data different from the file
+    this->DecompressedDataMTime = std::max(this->StorableModifiedTime.GetMTime(),
+      imageData ? imageData->GetMTime() : 0);
+    }
+  return true;
+}
+
 //---------------------------------------------------------------------------
 vtkImageData* vtkMRMLVolumeNode::GetImageData()
 {
+  this->ReadPendingData();
   vtkAlgorithm* producer = this->ImageDataConnection ?
     this->ImageDataConnection->GetProducer() : nullptr;
   return vtkImageData::SafeDownCast(
@@ -715,6 +837,13 @@ vtkImageData* vtkMRMLVolumeNode::GetImageData()
       this->ImageDataConnection->GetIndex()) : nullptr);
 }
 
+//---------------------------------------------------------------------------
+vtkAlgorithmOutput* vtkMRMLVolumeNode::GetImageDataConnection()
+{
+  this->ReadPendingData();
+  return this->ImageDataConnection;
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLVolumeNode
 ::SetImageDataConnection(vtkAlgorithmOutput *newImageDataConnection)
@@ -981,10 +1110,51 @@ void vtkMRMLVolumeNode::GetBoundsInternal(double bounds[6],
 //---------------------------------------------------------------------------
 bool vtkMRMLVolumeNode::GetModifiedSinceRead()
 {
+  if (this->DataReadPending)
+    {
+    // Data that is compressed in memory may not be found in any file
+    return this->CompressedScalarsArray != nullptr && this->CompressedScalarsModifiedSinceRead;
+    }
+  if (this->DecompressedDataMTime != 0
+    && this->StorableModifiedTime.GetMTime() <= this->DecompressedDataMTime
+    && (!this->GetImageData() || this->GetImageData()->GetMTime() <= this->DecompressedDataMTime))
+    {
+    // data has not changed since it was decompressed
+    return false;
+    }
   return this->Superclass::GetModifiedSinceRead() ||
     (this->GetImageData() && this->GetImageData()->GetMTime() > this->GetStoredTime());
 }
 
+//---------------------------------------------------------------------------
+vtkMTimeType vtkMRMLVolumeNode::GetContentMTime()
+{
+  vtkMTimeType contentMTime = this->Superclass::GetContentMTime();
+  if (this->GetImageData())
+    {
+    contentMTime = std::max(contentMTime, this->GetImageData()->GetMTime());
+    }
+  return contentMTime;
+}
+
+//---------------------------------------------------------------------------
+unsigned long vtkMRMLVolumeNode::GetDataMemorySize()
+{
+  unsigned long memorySize = static_cast<unsigned long>(this->CompressedScalars.size() / 1024);
+  if (this->GetDataReadPending())
+    {
+    // Do not read the data just to get its size
+    return memorySize;
+    }
+  vtkAlgorithm* producer = this->ImageDataConnection ? this->ImageDataConnection->GetProducer() : nullptr;
+  vtkDataObject* imageData = producer ? producer->GetOutputDataObject(this->ImageDataConnection->GetIndex()) : nullptr;
+  if (imageData)
+    {
+    memorySize += imageData->GetActualMemorySize();
+    }
+  return memorySize;
+}
+
 //---------------------------------------------------------------------------
 bool vtkMRMLVolumeNode::CanApplyNonLinearTransforms()const
 {
@@ -1005,6 +1175,70 @@ void vtkMRMLVolumeNode::ApplyTransform(vtkAbstractTransform* transform)
     }
   return;
 }
+//-----------------------------------------------------------
+namespace
+{
+/// Store in \a gridTransform the input voxel positions of the output voxels in
+/// \a outputExtent (IJK coordinates, spacing 1, origin \a outputOrigin).
+/// The output voxels are transformed from world by inverting \a transformToWorld
+/// for all the voxels at once (see vtkMRMLTransformNode::InverseTransformPoints).
+void ComputeResamplingGridTransform(vtkAbstractTransform* transformToWorld,
+  vtkMatrix4x4* ijkToRAS, vtkMatrix4x4* rasToIJK, const double outputOrigin[3], const int outputExtent[6],
+  vtkGridTransform* gridTransform)
+{
+  int dimensions[3] = { outputExtent[1] - outputExtent[0] + 1,
+    outputExtent[3] - outputExtent[2] + 1, outputExtent[5] - outputExtent[4] + 1 };
+  vtkNew<vtkPoints> rasPoints;
+  rasPoints->SetDataTypeToDouble();
+  rasPoints->SetNumberOfPoints(static_cast<vtkIdType>(dimensions[0]) * dimensions[1] * dimensions[2]);
+  double outputPoint[4] = { 0.0, 0.0, 0.0, 1.0 };
+  double rasPoint[4] = { 0.0, 0.0, 0.0, 1.0 };
+  vtkIdType pointId = 0;
+  for (int k = outputExtent[4]; k <= outputExtent[5]; ++k)
+    {
+    for (int j = outputExtent[2]; j <= outputExtent[3]; ++j)
+      {
+      for (int i = outputExtent[0]; i <= outputExtent[1]; ++i)
+        {
+        outputPoint[0] = outputOrigin[0] + i;
+        outputPoint[1] = outputOrigin[1] + j;
+        outputPoint[2] = outputOrigin[2] + k;
+        ijkToRAS->MultiplyPoint(outputPoint, rasPoint);
+        rasPoints->SetPoint(pointId++, rasPoint);
+        }
+      }
+    }
+
+  vtkNew<vtkPoints> transformedPoints;
+  vtkMRMLTransformNode::InverseTransformPoints(transformToWorld, rasPoints.GetPointer(), transformedPoints.GetPointer());
+
+  vtkNew<vtkImageData> displacementGrid;
+  displacementGrid->SetExtent(const_cast<int*>(outputExtent));
+  displacementGrid->SetOrigin(outputOrigin[0], outputOrigin[1], outputOrigin[2]);
+  displacementGrid->AllocateScalars(VTK_DOUBLE, 3);
+  double* displacement = static_cast<double*>(displacementGrid->GetScalarPointer());
+  double transformedPoint[4] = { 0.0, 0.0, 0.0, 1.0 };
+  double inputPoint[4] = { 0.0, 0.0, 0.0, 1.0 };
+  pointId = 0;
+  for (int k = outputExtent[4]; k <= outputExtent[5]; ++k)
+    {
+    for (int j = outputExtent[2]; j <= outputExtent[3]; ++j)
+      {
+      for (int i = outputExtent[0]; i <= outputExtent[1]; ++i)
+        {
+        transformedPoints->GetPoint(pointId++, transformedPoint);
+        rasToIJK->MultiplyPoint(transformedPoint, inputPoint);
+        *(displacement++) = inputPoint[0] - (outputOrigin[0] + i);
+        *(displacement++) = inputPoint[1] - (outputOrigin[1] + j);
+        *(displacement++) = inputPoint[2] - (outputOrigin[2] + k);
+        }
+      }
+    }
+  gridTransform->SetInterpolationModeToLinear();
+  gridTransform->SetDisplacementGridData(displacementGrid.GetPointer());
+}
+}
+
 //-----------------------------------------------------------
 void vtkMRMLVolumeNode::ApplyNonLinearTransform(vtkAbstractTransform* transform)
 {
@@ -1029,6 +1263,9 @@ void vtkMRMLVolumeNode::ApplyNonLinearTransform(vtkAbstractTransform* transform)
   vtkNew<vtkMatrix4x4> IJKToRAS;
   IJKToRAS->DeepCopy(rasToIJK.GetPointer());
   IJKToRAS->Invert();
+  // transform to world, used for computing the resampling grid of non-linear transforms
+  vtkSmartPointer<vtkAbstractTransform> transformToWorld = vtkSmartPointer<vtkAbstractTransform>::Take(transform->MakeTransform());
+  transformToWorld->DeepCopy(transform);
   transform->Inverse();
 
   resampleXform->Concatenate(IJKToRAS.GetPointer());
@@ -1038,14 +1275,11 @@ void vtkMRMLVolumeNode::ApplyNonLinearTransform(vtkAbstractTransform* transform)
   // vtkImageReslice works faster if the input is a linear transform, so try to convert it
   // to a linear transform
   vtkNew<vtkTransform> linearResampleXform;
-  if (vtkMRMLTransformNode::IsGeneralTransformLinear(resampleXform.GetPointer(), linearResampleXform.GetPointer()))
+  bool linearResampling = vtkMRMLTransformNode::IsGeneralTransformLinear(resampleXform.GetPointer(), linearResampleXform.GetPointer());
+  if (linearResampling)
     {
     reslice->SetResliceTransform(linearResampleXform.GetPointer());
     }
-  else
-    {
-    reslice->SetResliceTransform(resampleXform.GetPointer());
-    }
 
   reslice->SetInputConnection(this->ImageDataConnection);
 
@@ -1077,13 +1311,15 @@ void vtkMRMLVolumeNode::ApplyNonLinearTransform(vtkAbstractTransform* transform)
   this->GetBoundsInternal(transformedBounds, rasToIJK, true);
   double spacing[3] = { 1.0, 1.0, 1.0 }; // output is specified in IJK coordinate system
   // transformedBounds is computed so that it includes the voxel corners, therefore the origin is half voxel towards the image center
-  reslice->SetOutputOrigin(transformedBounds[0] + 0.5 * spacing[0], transformedBounds[2] + 0.5 * spacing[1], transformedBounds[4] + 0.5 * spacing[2]);
+  double outputOrigin[3] = { transformedBounds[0] + 0.5 * spacing[0], transformedBounds[2] + 0.5 * spacing[1], transformedBounds[4] + 0.5 * spacing[2] };
+  reslice->SetOutputOrigin(outputOrigin);
   reslice->SetOutputSpacing(spacing);
   const double voxelExpandTolerance = 1e-3; // do not expand the volume with a new voxel if only expanding by 1/1000th of a voxel
-  reslice->SetOutputExtent(
-    0, ceil((transformedBounds[1] - transformedBounds[0]) / spacing[0] - voxelExpandTolerance) - 1,
-    0, ceil((transformedBounds[3] - transformedBounds[2]) / spacing[1] - voxelExpandTolerance) - 1,
-    0, ceil((transformedBounds[5] - transformedBounds[4]) / spacing[2] - voxelExpandTolerance) - 1);
+  int outputExtent[6] = {
+    0, static_cast<int>(ceil((transformedBounds[1] - transformedBounds[0]) / spacing[0] - voxelExpandTolerance)) - 1,
+    0, static_cast<int>(ceil((transformedBounds[3] - transformedBounds[2]) / spacing[1] - voxelExpandTolerance)) - 1,
+    0, static_cast<int>(ceil((transformedBounds[5] - transformedBounds[4]) / spacing[2] - voxelExpandTolerance)) - 1 };
+  reslice->SetOutputExtent(outputExtent);
 
   // Keep output spacing (1,1,1)
   reslice->TransformInputSamplingOff();
@@ -1091,10 +1327,49 @@ void vtkMRMLVolumeNode::ApplyNonLinearTransform(vtkAbstractTransform* transform)
   reslice->SetOptimization(1);
   reslice->SetOutputDimensionality(3);
 
-  reslice->Update();
-
   vtkNew<vtkImageData> resampleImage;
-  resampleImage->DeepCopy(reslice->GetOutput());
+  if (linearResampling)
+    {
+    reslice->Update();
+    resampleImage->DeepCopy(reslice->GetOutput());
+    }
+  else
+    {
+    // The input voxel position of each output voxel is computed for a slab of slices
+    // at once, in parallel, and then the slab is resampled through the resulting grid.
+    // Slabs limit the memory needed for the grid.
+    const vtkIdType maximumNumberOfVoxelsPerSlab = 4 * 1024 * 1024;
+    vtkIdType numberOfVoxelsPerSlice = static_cast<vtkIdType>(outputExtent[1] + 1) * (outputExtent[3] + 1);
+    int numberOfSlicesPerSlab = static_cast<int>(std::max(static_cast<vtkIdType>(1),
+      maximumNumberOfVoxelsPerSlab / std::max(static_cast<vtkIdType>(1), numberOfVoxelsPerSlice)));
+    for (int slabStart = outputExtent[4]; slabStart <= outputExtent[5]; slabStart += numberOfSlicesPerSlab)
+      {
+      int slabExtent[6] = { outputExtent[0], outputExtent[1], outputExtent[2], outputExtent[3],
+        slabStart, std::min(slabStart + numberOfSlicesPerSlab - 1, outputExtent[5]) };
+      vtkNew<vtkGridTransform> slabTransform;
+      ComputeResamplingGridTransform(transformToWorld, IJKToRAS.GetPointer(), rasToIJK.GetPointer(),
+        outputOrigin, slabExtent, slabTransform.GetPointer());
+      reslice->SetResliceTransform(slabTransform.GetPointer());
+      reslice->SetOutputExtent(slabExtent);
+      reslice->Update();
+      vtkImageData* slabImage = reslice->GetOutput();
+      if (slabStart == outputExtent[4])
+        {
+        resampleImage->SetExtent(outputExtent);
+        resampleImage->SetOrigin(slabImage->GetOrigin());
+        resampleImage->SetSpacing(slabImage->GetSpacing());
+        resampleImage->AllocateScalars(slabImage->GetScalarType(), slabImage->GetNumberOfScalarComponents());
+        if (slabImage->GetPointData()->GetScalars())
+          {
+          resampleImage->GetPointData()->GetScalars()->SetName(slabImage->GetPointData()->GetScalars()->GetName());
+          }
+        }
+      // slabs are complete slices, therefore they are contiguous in memory
+      memcpy(resampleImage->GetScalarPointer(outputExtent[0], outputExtent[2], slabExtent[4]),
+        slabImage->GetScalarPointer(), static_cast<size_t>(slabImage->GetNumberOfPoints())
+        * slabImage->GetNumberOfScalarComponents() * slabImage->GetScalarSize());
+      }
+    }
 
   // Perform image data and origin update in one step
   int wasModified = this->StartModify();
@@ -20,7 +20,9 @@
 class vtkMRMLVolumeDisplayNode;
 
 // VTK includes
+#include <vtkSmartPointer.h>
 class vtkAlgorithmOutput;
+class vtkDataArray;
 class vtkEventForwarderCommand;
 class vtkImageData;
 class vtkMatrix4x4;
@@ -28,6 +30,9 @@ class vtkMatrix4x4;
 // ITK includes
 #include "itkMetaDataDictionary.h"
 
+// STD includes
+#include <vector>
+
 /// \brief MRML node for representing a volume (image stack).
 ///
 /// Volume nodes describe data sets that can be thought of as stacks of 2D
@@ -182,13 +187,16 @@ public:
   /// vtkMRMLVolumeNode::Spacing, and vtkMRMLVolumeNode::IJKToRASDirections).
   /// \sa GetImageData(), SetImageDataConnection()
   virtual void SetAndObserveImageData(vtkImageData *ImageData);
+  /// Get image data. If reading of the image data was deferred (see vtkMRMLScene::SetReadDataOnDemand())
+  /// then the data is read from file first.
   virtual vtkImageData* GetImageData();
   /// Set and observe image data pipeline.
   /// It is propagated to the display nodes.
   /// \sa GetImageDataConnection()
   virtual void SetImageDataConnection(vtkAlgorithmOutput *inputPort);
   /// Return the input image data pipeline.
-  vtkGetObjectMacro(ImageDataConnection, vtkAlgorithmOutput);
+  /// If reading of the image data was deferred then the data is read from file first.
+  virtual vtkAlgorithmOutput* GetImageDataConnection();
 
   ///
   /// Make sure image data of a volume node has extents that start at zero.
@@ -223,6 +231,30 @@ public:
 
   bool GetModifiedSinceRead() override;
 
+  /// Compress voxel values of the image data in memory.
+  /// This reduces memory usage of volumes that are not accessed for a while and cannot be
+  /// released by ReleaseData() because their data cannot be read from file again
+  /// (for example, items of a recorded volume sequence).
+  /// The node gets a new image data with the same geometry, the previous image data is not modified.
+  /// Voxel values are decompressed automatically when the image data is accessed next time.
+  /// Returns false if there are no voxel values to compress.
+  /// \sa GetDataCompressedInMemory(), vtkMRMLSequenceNode::SetCompressDataNodesInMemory()
+  bool CompressDataInMemory();
+
+  /// Returns true if voxel values are compressed in memory.
+  /// \sa CompressDataInMemory()
+  bool GetDataCompressedInMemory();
+
+  /// Reimplemented to take into account the modified time of the image data.
+  vtkMTimeType GetContentMTime() override;
+
+  /// Content modification time includes the image data modification time,
+  /// therefore undo state can be shared between undo levels.
+  bool CanShareUndoState() override { return true; }
+
+  /// Memory size of the image data (or the compressed voxel values if data is compressed in memory).
+  unsigned long GetDataMemorySize() override;
+
   ///
   /// Get background voxel value of the image. It can be used for assigning
   /// intensity value to "empty" voxels when the image is transformed.
@@ -266,6 +298,15 @@ protected:
   /// to the new display node.
   virtual void UpdateDisplayNodeImageData(vtkMRMLDisplayNode *dnode);
 
+  /// Remove the image data from memory, called by ReleaseData().
+  bool ReleaseDataInternal() override;
+
+  /// Decompress voxel values if they were compressed in memory, otherwise read data from file.
+  bool ReadPendingDataInternal() override;
+
+  /// Discard voxel values that are compressed in memory
+  void ClearDataCompressedInMemory();
+
   ///
   /// Called when a node reference ID is added (list size increased).
   void OnNodeReferenceAdded(vtkMRMLNodeReference *reference) override;
@@ -299,6 +340,16 @@ protected:
   vtkAlgorithmOutput* ImageDataConnection;
   vtkEventForwarderCommand* DataEventForwarder;
 
+  /// Voxel values compressed by CompressDataInMemory()
+  std::vector<unsigned char> CompressedScalars;
+  /// Empty array with the same type, number of components and name as the compressed scalars
+  vtkSmartPointer<vtkDataArray> CompressedScalarsArray;
+  vtkIdType CompressedScalarsNumberOfTuples{0};
+  bool CompressedScalarsModifiedSinceRead{false};
+  /// Modified time of the data when voxel values that were not modified since read
+  /// have been decompressed, 0 if they were modified or not decompressed.
+  vtkMTimeType DecompressedDataMTime{0};
+
   int VoxelVectorType;
   itk::MetaDataDictionary Dictionary;
 };
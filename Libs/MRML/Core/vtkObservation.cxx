@@ -36,6 +36,7 @@ vtkObservation::vtkObservation()
   this->Script = nullptr;
   this->Comment = nullptr;
   this->Priority = 0.0f;
+  this->CoalesceEvents = 0;
   this->EventTag = 0;
   this->SubjectDeleteEventTag = 0;
   this->ObserverDeleteEventTag = 0;
@@ -46,6 +47,10 @@ vtkObservation::vtkObservation()
 
   this->LastElapsedTime = 0.0;
   this->TotalElapsedTime = 0.0;
+  this->InvocationCount = 0;
+  this->TotalSelfElapsedTime = 0.0;
+  this->MaximumElapsedTime = 0.0;
+  this->MaximumEventNestingLevel = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -94,10 +99,15 @@ void vtkObservation::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Comment: " <<
     (this->Comment ? this->Comment : "(none)") << "\n";
+  os << indent << "CoalesceEvents: " << this->CoalesceEvents << "\n";
   os << indent << "EventTag: " << this->EventTag << "\n";
   os << indent << "SubjectDeleteEventTag: " << this->SubjectDeleteEventTag << "\n";
   os << indent << "ObserverDeleteEventTag: " << this->ObserverDeleteEventTag << "\n";
 
   os << indent << "LastElapsedTime: " << this->LastElapsedTime << "\n";
   os << indent << "TotalElapsedTime: " << this->TotalElapsedTime << "\n";
+  os << indent << "InvocationCount: " << this->InvocationCount << "\n";
+  os << indent << "TotalSelfElapsedTime: " << this->TotalSelfElapsedTime << "\n";
+  os << indent << "MaximumElapsedTime: " << this->MaximumElapsedTime << "\n";
+  os << indent << "MaximumEventNestingLevel: " << this->MaximumEventNestingLevel << "\n";
 }
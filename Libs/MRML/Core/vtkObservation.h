@@ -75,6 +75,17 @@ class VTK_MRML_EXPORT vtkObservation : public vtkObject
   vtkSetMacro(Priority, float);
   vtkGetMacro(Priority, float);
 
+  /// Description
+  /// Merge queued invocations of the same event (asynchronous event mode only).
+  /// If enabled and the event is invoked while the observation is already in the
+  /// event queue then only the call data of the most recent invocation is kept,
+  /// so that the callback is called only once for each event type.
+  /// Disabled by default.
+  /// \sa vtkEventBroker::SetEventModeToAsynchronous()
+  vtkBooleanMacro (CoalesceEvents, int);
+  vtkSetMacro (CoalesceEvents, int);
+  vtkGetMacro (CoalesceEvents, int);
+
   vtkGetMacro (EventTag, unsigned long);
   vtkSetMacro (EventTag, unsigned long);
   vtkGetMacro (SubjectDeleteEventTag, unsigned long);
@@ -90,6 +101,21 @@ class VTK_MRML_EXPORT vtkObservation : public vtkObject
   vtkGetMacro (TotalElapsedTime, double);
   vtkSetMacro (TotalElapsedTime, double);
 
+  /// Description
+  /// Invocation statistics, only updated when event profiling is enabled
+  /// in the event broker (see vtkEventBroker::SetEventProfiling()).
+  /// Self elapsed time excludes the time spent in nested invocations
+  /// of other observations. Event nesting level is 1 for an observation
+  /// that is not invoked from the callback of another observation.
+  vtkGetMacro (InvocationCount, int);
+  vtkSetMacro (InvocationCount, int);
+  vtkGetMacro (TotalSelfElapsedTime, double);
+  vtkSetMacro (TotalSelfElapsedTime, double);
+  vtkGetMacro (MaximumElapsedTime, double);
+  vtkSetMacro (MaximumElapsedTime, double);
+  vtkGetMacro (MaximumEventNestingLevel, int);
+  vtkSetMacro (MaximumEventNestingLevel, int);
+
   struct CallType
   {
     inline CallType(unsigned long eventID, void* callData);
@@ -150,6 +176,10 @@ protected:
   /// Priority of the observer
   float Priority;
 
+  ///
+  /// Flag that tells the broker to merge queued invocations of the same event
+  int CoalesceEvents;
+
   ///
   /// keep track of the tags returned by vtkObject::AddObserver so this
   /// observation will be easy to remove when the time comes
@@ -160,6 +190,10 @@ protected:
   double LastElapsedTime;
   double TotalElapsedTime;
 
+  int InvocationCount;
+  double TotalSelfElapsedTime;
+  double MaximumElapsedTime;
+  int MaximumEventNestingLevel;
 };
 
 //----------------------------------------------------------------------------
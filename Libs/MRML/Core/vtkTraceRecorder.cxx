@@ -0,0 +1,342 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRML includes
+#include "vtkTraceRecorder.h"
+
+// VTK includes
+#include <vtkObjectFactory.h>
+
+// STD includes
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <vector>
+
+//----------------------------------------------------------------------------
+// The trace recorder singleton.
+// This MUST be default initialized to zero by the compiler and is
+// therefore not initialized here. The classInitialize and
+// classFinalize methods handle this instance.
+static vtkTraceRecorder* vtkTraceRecorderInstance;
+
+//----------------------------------------------------------------------------
+// Must NOT be initialized. Default initialization to zero is necessary.
+unsigned int vtkTraceRecorderInitialize::Count;
+
+//----------------------------------------------------------------------------
+namespace
+{
+struct TraceEventType
+{
+  const char* Name;
+  const char* Category;
+  vtkTypeInt64 StartTime;
+  vtkTypeInt64 Duration;
+};
+
+/// Events recorded by a single thread.
+/// Only the owner thread writes the buffer, other threads only read it when exporting.
+struct ThreadBufferType
+{
+  ThreadBufferType(int threadIndex, int size)
+    : ThreadIndex(threadIndex)
+    , Events(std::max(size, 2))
+    , NumberOfWrittenEvents(0)
+    {
+    }
+  int ThreadIndex;
+  std::vector<TraceEventType> Events;
+  std::atomic<vtkTypeUInt64> NumberOfWrittenEvents;
+};
+
+/// Time origin of all recorded events
+const std::chrono::steady_clock::time_point TraceStartTime = std::chrono::steady_clock::now();
+
+//----------------------------------------------------------------------------
+std::string EscapeJSONString(const char* text)
+{
+  std::stringstream ss;
+  for (const char* c = text; c && *c; ++c)
+    {
+    switch (*c)
+      {
+      case '"': ss << "\\\""; break;
+      case '\\': ss << "\\\\"; break;
+      case '\n': ss << "\\n"; break;
+      case '\r': ss << "\\r"; break;
+      case '\t': ss << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20)
+          {
+          ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(*c) << std::dec;
+          }
+        else
+          {
+          ss << *c;
+          }
+      }
+    }
+  return ss.str();
+}
+}
+
+//----------------------------------------------------------------------------
+class vtkTraceRecorder::vtkInternal
+{
+public:
+  /// Return the buffer of the current thread, create it if needed
+  ThreadBufferType* GetThreadBuffer(vtkTraceRecorder* recorder);
+
+  /// Protects ThreadBuffers and StringPool
+  std::mutex Mutex;
+  std::vector<std::unique_ptr<ThreadBufferType> > ThreadBuffers;
+  /// Storage for names and categories of events that are not recorded with static strings
+  std::set<std::string> StringPool;
+};
+
+//----------------------------------------------------------------------------
+ThreadBufferType* vtkTraceRecorder::vtkInternal::GetThreadBuffer(vtkTraceRecorder* recorder)
+{
+  // Cache the buffer of the thread, so that locking is only needed for the first event of each thread
+  struct ThreadBufferCacheType
+    {
+    vtkTraceRecorder* Recorder{ nullptr };
+    ThreadBufferType* Buffer{ nullptr };
+    };
+  thread_local ThreadBufferCacheType threadBufferCache;
+  if (threadBufferCache.Recorder != recorder)
+    {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    int threadIndex = static_cast<int>(this->ThreadBuffers.size()) + 1;
+    this->ThreadBuffers.emplace_back(new ThreadBufferType(threadIndex, recorder->GetThreadBufferSize()));
+    threadBufferCache.Recorder = recorder;
+    threadBufferCache.Buffer = this->ThreadBuffers.back().get();
+    }
+  return threadBufferCache.Buffer;
+}
+
+//----------------------------------------------------------------------------
+// Implementation of vtkTraceRecorderInitialize class.
+//----------------------------------------------------------------------------
+vtkTraceRecorderInitialize::vtkTraceRecorderInitialize()
+{
+  if (++Self::Count == 1)
+    {
+    vtkTraceRecorder::classInitialize();
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkTraceRecorderInitialize::~vtkTraceRecorderInitialize()
+{
+  if (--Self::Count == 0)
+    {
+    vtkTraceRecorder::classFinalize();
+    }
+}
+
+//----------------------------------------------------------------------------
+// Up the reference count so it behaves like New
+vtkTraceRecorder* vtkTraceRecorder::New()
+{
+  vtkTraceRecorder* ret = vtkTraceRecorder::GetInstance();
+  ret->Register(nullptr);
+  return ret;
+}
+
+//----------------------------------------------------------------------------
+// Return the single instance of the vtkTraceRecorder
+vtkTraceRecorder* vtkTraceRecorder::GetInstance()
+{
+  if (!vtkTraceRecorderInstance)
+    {
+    // Try the factory first
+    vtkTraceRecorderInstance = (vtkTraceRecorder*)vtkObjectFactory::CreateInstance("vtkTraceRecorder");
+    // if the factory did not provide one, then create it here
+    if (!vtkTraceRecorderInstance)
+      {
+      vtkTraceRecorderInstance = new vtkTraceRecorder;
+#ifdef VTK_HAS_INITIALIZE_OBJECT_BASE
+      vtkTraceRecorderInstance->InitializeObjectBase();
+#endif
+      }
+    }
+  // return the instance
+  return vtkTraceRecorderInstance;
+}
+
+//----------------------------------------------------------------------------
+void vtkTraceRecorder::classInitialize()
+{
+  // Allocate the singleton
+  vtkTraceRecorderInstance = vtkTraceRecorder::GetInstance();
+}
+
+//----------------------------------------------------------------------------
+void vtkTraceRecorder::classFinalize()
+{
+  vtkTraceRecorderInstance->Delete();
+  vtkTraceRecorderInstance = nullptr;
+}
+
+//----------------------------------------------------------------------------
+vtkTraceRecorder::vtkTraceRecorder()
+  : Recording(false)
+  , ThreadBufferSize(65536)
+{
+  this->Internal = new vtkInternal;
+}
+
+//----------------------------------------------------------------------------
+vtkTraceRecorder::~vtkTraceRecorder()
+{
+  delete this->Internal;
+}
+
+//----------------------------------------------------------------------------
+void vtkTraceRecorder::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Recording: " << (this->GetRecording() ? "true" : "false") << "\n";
+  os << indent << "ThreadBufferSize: " << this->ThreadBufferSize << "\n";
+  os << indent << "NumberOfEvents: " << this->GetNumberOfEvents() << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkTraceRecorder::SetRecording(bool recording)
+{
+  if (this->GetRecording() == recording)
+    {
+    return;
+    }
+  this->Recording.store(recording);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkTraceRecorder::GetTime()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - TraceStartTime).count();
+}
+
+//----------------------------------------------------------------------------
+void vtkTraceRecorder::AddEvent(const char* name, const char* category, vtkTypeInt64 startTime, vtkTypeInt64 duration)
+{
+  if (!this->GetRecording())
+    {
+    return;
+    }
+  ThreadBufferType* buffer = this->Internal->GetThreadBuffer(this);
+  vtkTypeUInt64 eventIndex = buffer->NumberOfWrittenEvents.load(std::memory_order_relaxed);
+  TraceEventType& event = buffer->Events[eventIndex % buffer->Events.size()];
+  event.Name = name;
+  event.Category = category;
+  event.StartTime = startTime;
+  event.Duration = duration;
+  // Make the event visible to exporting threads only after it is written
+  buffer->NumberOfWrittenEvents.store(eventIndex + 1, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------
+void vtkTraceRecorder::AddEventWithCopiedStrings(const std::string& name, const std::string& category,
+  vtkTypeInt64 startTime, vtkTypeInt64 duration)
+{
+  if (!this->GetRecording())
+    {
+    return;
+    }
+  const char* pooledName = nullptr;
+  const char* pooledCategory = nullptr;
+    {
+    // Strings in a std::set are never moved, therefore their pointers remain valid
+    std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+    pooledName = this->Internal->StringPool.insert(name).first->c_str();
+    pooledCategory = this->Internal->StringPool.insert(category).first->c_str();
+    }
+  this->AddEvent(pooledName, pooledCategory, startTime, duration);
+}
+
+//----------------------------------------------------------------------------
+void vtkTraceRecorder::ClearEvents()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  for (std::unique_ptr<ThreadBufferType>& buffer : this->Internal->ThreadBuffers)
+    {
+    buffer->NumberOfWrittenEvents.store(0);
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkTraceRecorder::GetNumberOfEvents()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  vtkTypeUInt64 numberOfEvents = 0;
+  for (std::unique_ptr<ThreadBufferType>& buffer : this->Internal->ThreadBuffers)
+    {
+    numberOfEvents += std::min<vtkTypeUInt64>(buffer->NumberOfWrittenEvents.load(std::memory_order_acquire),
+      buffer->Events.size());
+    }
+  return static_cast<int>(numberOfEvents);
+}
+
+//----------------------------------------------------------------------------
+std::string vtkTraceRecorder::GetEventsAsChromeTrace()
+{
+  std::lock_guard<std::mutex> lock(this->Internal->Mutex);
+  std::stringstream ss;
+  ss << "{\"traceEvents\":[";
+  bool firstEvent = true;
+  for (std::unique_ptr<ThreadBufferType>& buffer : this->Internal->ThreadBuffers)
+    {
+    vtkTypeUInt64 numberOfWrittenEvents = buffer->NumberOfWrittenEvents.load(std::memory_order_acquire);
+    vtkTypeUInt64 bufferSize = buffer->Events.size();
+    // Skip the oldest stored event, as it may be overwritten by the owner thread while exporting
+    vtkTypeUInt64 numberOfEvents = std::min(numberOfWrittenEvents, bufferSize - 1);
+    for (vtkTypeUInt64 eventIndex = numberOfWrittenEvents - numberOfEvents; eventIndex < numberOfWrittenEvents; ++eventIndex)
+      {
+      const TraceEventType& event = buffer->Events[eventIndex % bufferSize];
+      ss << (firstEvent ? "\n" : ",\n");
+      firstEvent = false;
+      ss << "{\"name\":\"" << EscapeJSONString(event.Name) << "\""
+        << ",\"cat\":\"" << EscapeJSONString(event.Category) << "\""
+        << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->ThreadIndex
+        << ",\"ts\":" << event.StartTime
+        << ",\"dur\":" << event.Duration << "}";
+      }
+    }
+  ss << "\n]}\n";
+  return ss.str();
+}
+
+//----------------------------------------------------------------------------
+bool vtkTraceRecorder::WriteEventsAsChromeTrace(const std::string& fileName)
+{
+  std::ofstream file(fileName.c_str());
+  if (!file.is_open())
+    {
+    vtkErrorMacro("WriteEventsAsChromeTrace: failed to open file for writing: " << fileName);
+    return false;
+    }
+  file << this->GetEventsAsChromeTrace();
+  file.close();
+  return !file.fail();
+}
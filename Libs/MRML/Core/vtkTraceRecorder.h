@@ -0,0 +1,202 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __vtkTraceRecorder_h
+#define __vtkTraceRecorder_h
+
+// MRML includes
+#include "vtkMRML.h"
+
+// VTK includes
+#include <vtkObject.h>
+
+// STD includes
+#include <atomic>
+#include <string>
+
+/// \brief Low-overhead recorder of timed scopes, for profiling processing pipelines.
+///
+/// Each thread records events into its own fixed-size ring buffer, without locking,
+/// therefore recording can be used in performance-critical code and in worker threads.
+/// When the buffer of a thread is full, the oldest events of that thread are overwritten.
+/// If recording is disabled (default) then the cost of a trace scope is reading a flag.
+///
+/// Recorded events can be exported in Chrome trace event JSON format, which can be
+/// displayed in chrome://tracing or https://ui.perfetto.dev.
+///
+/// Usage in C++:
+/// \code
+/// void vtkMyLogic::Process()
+/// {
+///   vtkTraceScopeMacro("vtkMyLogic::Process");
+///   ...
+/// }
+/// \endcode
+/// The macros are compiled to nothing if MRML is built with MRML_USE_TRACING disabled.
+/// Scope names and categories passed to the macros must be string literals (or strings
+/// that are not deleted until the program exits), as only the pointer is stored.
+///
+/// Usage in Python (see slicer.util.traceScope):
+/// \code
+/// with slicer.util.traceScope("MyModule.process"):
+///   ...
+/// \endcode
+///
+/// There is only one instance of this class per process.
+class VTK_MRML_EXPORT vtkTraceRecorder : public vtkObject
+{
+public:
+  vtkTypeMacro(vtkTraceRecorder, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Return the singleton instance with no reference counting.
+  static vtkTraceRecorder* GetInstance();
+
+  /// This is a singleton pattern New. There will only be ONE
+  /// reference to a vtkTraceRecorder object per process. Clients that
+  /// call this must call Delete on the object so that the reference
+  /// counting will work. The single instance will be unreferenced when
+  /// the program exits.
+  static vtkTraceRecorder* New();
+
+  /// Enable/disable recording of events. Disabled by default.
+  void SetRecording(bool recording);
+  bool GetRecording() { return this->Recording.load(std::memory_order_relaxed); }
+  void RecordingOn() { this->SetRecording(true); }
+  void RecordingOff() { this->SetRecording(false); }
+
+  /// Maximum number of events stored for each thread (default: 65536).
+  /// Changing the value only affects threads that have not recorded any events yet,
+  /// therefore it should be set before recording is enabled.
+  vtkSetMacro(ThreadBufferSize, int);
+  vtkGetMacro(ThreadBufferSize, int);
+
+  /// Time elapsed since the recorder was created, in microseconds.
+  /// Used as start time of events.
+  static vtkTypeInt64 GetTime();
+
+#ifndef __VTK_WRAP__
+  /// Record an event of the current thread. Start time and duration are in microseconds.
+  /// Name and category must remain valid until the program exits (e.g., string literals).
+  /// No-op if recording is disabled.
+  /// Not available in Python, as strings passed from Python are temporary.
+  void AddEvent(const char* name, const char* category, vtkTypeInt64 startTime, vtkTypeInt64 duration);
+#endif // __VTK_WRAP__
+
+  /// Record an event of the current thread, with arbitrary name and category.
+  /// Strings are copied into an internal string pool, therefore this is slower than
+  /// AddEvent() with static strings. Mainly intended for recording events from Python.
+  void AddEventWithCopiedStrings(const std::string& name, const std::string& category,
+    vtkTypeInt64 startTime, vtkTypeInt64 duration);
+
+  /// Remove all recorded events.
+  /// Should not be called while other threads are recording events.
+  void ClearEvents();
+
+  /// Total number of events that are stored in all thread buffers.
+  int GetNumberOfEvents();
+
+  /// Get all recorded events in Chrome trace event JSON format.
+  /// Events that are recorded while this method is running may be omitted.
+  std::string GetEventsAsChromeTrace();
+
+  /// Write all recorded events in Chrome trace event JSON format.
+  /// Returns false if the file could not be written.
+  bool WriteEventsAsChromeTrace(const std::string& fileName);
+
+#ifndef __VTK_WRAP__
+  /// \brief Records an event that lasts from construction until destruction of this object.
+  /// \sa vtkTraceScopeMacro
+  class Scope
+  {
+  public:
+    Scope(const char* name, const char* category = "General")
+      : Name(name)
+      , Category(category)
+      {
+      vtkTraceRecorder* recorder = vtkTraceRecorder::GetInstance();
+      this->StartTime = (recorder && recorder->GetRecording()) ? vtkTraceRecorder::GetTime() : -1;
+      }
+    ~Scope()
+      {
+      if (this->StartTime < 0)
+        {
+        return;
+        }
+      vtkTraceRecorder* recorder = vtkTraceRecorder::GetInstance();
+      if (recorder)
+        {
+        recorder->AddEvent(this->Name, this->Category, this->StartTime, vtkTraceRecorder::GetTime() - this->StartTime);
+        }
+      }
+    Scope(const Scope&) = delete;
+    void operator=(const Scope&) = delete;
+  protected:
+    const char* Name;
+    const char* Category;
+    vtkTypeInt64 StartTime;
+  };
+#endif // __VTK_WRAP__
+
+protected:
+  vtkTraceRecorder();
+  ~vtkTraceRecorder() override;
+  vtkTraceRecorder(const vtkTraceRecorder&);
+  void operator=(const vtkTraceRecorder&);
+
+  /// Singleton management functions.
+  static void classInitialize();
+  static void classFinalize();
+
+  friend class vtkTraceRecorderInitialize;
+
+  std::atomic<bool> Recording;
+  int ThreadBufferSize;
+
+  class vtkInternal;
+  vtkInternal* Internal;
+};
+
+/// Utility class to make sure vtkTraceRecorder is initialized before it is used.
+class VTK_MRML_EXPORT vtkTraceRecorderInitialize
+{
+public:
+  typedef vtkTraceRecorderInitialize Self;
+
+  vtkTraceRecorderInitialize();
+  ~vtkTraceRecorderInitialize();
+private:
+  static unsigned int Count;
+};
+
+/// This instance will show up in any translation unit that uses
+/// vtkTraceRecorder. It will make sure vtkTraceRecorder is initialized
+/// before it is used.
+static vtkTraceRecorderInitialize vtkTraceRecorderInitializer;
+
+#define vtkTraceRecorderConcatenateMacro2(a, b) a##b
+#define vtkTraceRecorderConcatenateMacro(a, b) vtkTraceRecorderConcatenateMacro2(a, b)
+
+/// Record the time spent in the current scope (until the end of the enclosing block).
+/// Name and category must be string literals.
+#ifdef MRML_USE_TRACING
+# define vtkTraceScopeWithCategoryMacro(name, category) \
+  vtkTraceRecorder::Scope vtkTraceRecorderConcatenateMacro(vtkTraceScope_, __LINE__)(name, category)
+#else
+# define vtkTraceScopeWithCategoryMacro(name, category)
+#endif
+#define vtkTraceScopeMacro(name) vtkTraceScopeWithCategoryMacro(name, "General")
+
+#endif
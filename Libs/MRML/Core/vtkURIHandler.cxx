@@ -47,6 +47,21 @@ vtkURIHandler::~vtkURIHandler()
 void vtkURIHandler::PrintSelf(ostream& os, vtkIndent indent)
 {
   Superclass::PrintSelf ( os, indent );
+  os << indent << "TransferCancelRequested: " << (this->GetTransferCancelRequested() ? "true" : "false") << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkURIHandler::CopySettings ( vtkURIHandler *handler )
+{
+  if ( handler == nullptr )
+    {
+    return;
+    }
+  this->SetHostName ( handler->GetHostName() );
+  this->SetRequiresPermission ( handler->GetRequiresPermission() );
+  this->SetPermissionPrompter ( handler->GetPermissionPrompter() );
+  this->SetPrefix ( handler->GetPrefix() );
+  this->SetName ( handler->GetName() );
 }
 
 
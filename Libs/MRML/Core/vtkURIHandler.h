@@ -8,6 +8,9 @@ class vtkPermissionPrompter;
 // VTK includes
 #include <vtkObject.h>
 
+// STD includes
+#include <atomic>
+
 class VTK_MRML_EXPORT vtkURIHandler : public vtkObject
 {
 public:
@@ -69,6 +72,26 @@ public:
   vtkGetStringMacro ( Name );
   vtkSetStringMacro ( Name );
 
+  ///
+  /// Copy the settings of \a handler (not the state of a transfer).
+  /// A handler runs one transfer at a time, therefore concurrent transfers
+  /// use copies of the handler registered in the scene.
+  /// Subclasses must call the superclass method.
+  virtual void CopySettings ( vtkURIHandler *handler );
+
+  ///
+  /// Request the running transfer to stop as soon as possible.
+  /// Can be called from any thread. Handlers that support cancellation
+  /// check the flag while transferring data.
+  void SetTransferCancelRequested ( bool cancel )
+    {
+    this->TransferCancelRequested = cancel;
+    }
+  bool GetTransferCancelRequested ( ) const
+    {
+    return this->TransferCancelRequested;
+    }
+
  private:
 
   //--- Methods to configure and close transfer
@@ -96,6 +119,7 @@ public:
   char *Prefix;
   char *Name;
   char *HostName;
+  std::atomic<bool> TransferCancelRequested{false};
 
 };
 
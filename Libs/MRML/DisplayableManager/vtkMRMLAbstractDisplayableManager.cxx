@@ -41,12 +41,14 @@
 #include <vtkRenderWindow.h>
 #include <vtkRenderWindowInteractor.h>
 #include <vtkSmartPointer.h>
+#include <vtkTimerLog.h>
 #include <vtkWeakPointer.h>
 
 // STD includes
 #include <cassert>
 #include <algorithm>
 #include <functional>
+#include <sstream>
 
 #if (_MSC_VER >= 1700 && _MSC_VER < 1800)
 // Visual Studio 2012 moves bind1st to <functional>
@@ -94,6 +96,15 @@ public:
   static void DoMRMLInteractionNodeCallback(vtkObject* vtk_obj, unsigned long event,
                                             void* client_data, void* call_data);
 
+  /// Set and observe vtkMRMLScene::NodesModifiedEvent of \a newScene.
+  /// The observer is independent of the scene events observed in SetMRMLSceneInternal(),
+  /// which subclasses may reimplement, so that deferred render requests are always processed.
+  void SetAndObserveMRMLSceneNodesModified(vtkMRMLScene* newScene);
+
+  /// Called after vtkMRMLScene::NodesModifiedEvent is invoked on the observed scene
+  static void DoMRMLSceneNodesModifiedCallback(vtkObject* vtk_obj, unsigned long event,
+                                               void* client_data, void* call_data);
+
   /// Called after MRML DisplayableNode is set, it will add/remove interactor style observer
   /// according to the state of the current MRML InteractionNode
   /// \sa DoMRMLInteractionNodeCallback
@@ -113,11 +124,14 @@ public:
   bool                                      Created;
   vtkObserverManager*                       WidgetsObserverManager;
   bool                                      UpdateFromMRMLRequested;
+  bool                                      RenderRequestDeferred;
   vtkRenderer*                              Renderer;
   vtkMRMLNode*                              MRMLDisplayableNode;
   vtkSmartPointer<vtkIntArray>              MRMLDisplayableNodeObservableEvents;
   vtkMRMLInteractionNode*                   MRMLInteractionNode;
   vtkSmartPointer<vtkCallbackCommand>       MRMLInteractionNodeCallBackCommand;
+  vtkWeakPointer<vtkMRMLScene>              NodesModifiedScene;
+  vtkSmartPointer<vtkCallbackCommand>       NodesModifiedSceneCallBackCommand;
   vtkMRMLDisplayableManagerGroup*           DisplayableManagerGroup;
   vtkSmartPointer<vtkCallbackCommand>       DeleteCallBackCommand;
   vtkRenderWindowInteractor*                Interactor;
@@ -140,6 +154,7 @@ vtkMRMLAbstractDisplayableManager::vtkInternal::vtkInternal(
   this->Created = false;
   this->WidgetsObserverManager = vtkObserverManager::New();
   this->UpdateFromMRMLRequested = false;
+  this->RenderRequestDeferred = false;
   this->Renderer = nullptr;
   this->LightBoxRendererManagerProxy = nullptr;
   this->MRMLDisplayableNode = nullptr;
@@ -162,6 +177,11 @@ vtkMRMLAbstractDisplayableManager::vtkInternal::vtkInternal(
       vtkMRMLAbstractDisplayableManager::vtkInternal::DoMRMLInteractionNodeCallback);
   this->MRMLInteractionNodeCallBackCommand->SetClientData(this->External);
 
+  this->NodesModifiedSceneCallBackCommand = vtkSmartPointer<vtkCallbackCommand>::New();
+  this->NodesModifiedSceneCallBackCommand->SetCallback(
+      vtkMRMLAbstractDisplayableManager::vtkInternal::DoMRMLSceneNodesModifiedCallback);
+  this->NodesModifiedSceneCallBackCommand->SetClientData(this->External);
+
   this->InteractorStyle = nullptr;
   this->InteractorStyleCallBackCommand = vtkSmartPointer<vtkCallbackCommand>::New();
   this->InteractorStyleCallBackCommand->SetCallback(
@@ -189,6 +209,7 @@ vtkMRMLAbstractDisplayableManager::vtkInternal::~vtkInternal()
   this->SetAndObserveInteractor(nullptr);
   this->SetAndObserveInteractorStyle(nullptr);
   this->SetAndObserveMRMLInteractionNode(nullptr);
+  this->SetAndObserveMRMLSceneNodesModified(nullptr);
   this->LightBoxRendererManagerProxy = nullptr;
   this->WidgetsObserverManager->Delete();
 }
@@ -266,6 +287,42 @@ void vtkMRMLAbstractDisplayableManager::vtkInternal::DoMRMLInteractionNodeCallba
   self->Internal->UpdateInteractorStyle();
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLAbstractDisplayableManager::vtkInternal::
+    SetAndObserveMRMLSceneNodesModified(vtkMRMLScene* newScene)
+{
+  if (this->NodesModifiedScene == newScene)
+    {
+    return;
+    }
+  if (this->NodesModifiedScene)
+    {
+    this->NodesModifiedScene->RemoveObserver(this->NodesModifiedSceneCallBackCommand);
+    }
+  if (newScene)
+    {
+    newScene->AddObserver(vtkMRMLScene::NodesModifiedEvent, this->NodesModifiedSceneCallBackCommand);
+    }
+  this->NodesModifiedScene = newScene;
+  this->RenderRequestDeferred = false;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLAbstractDisplayableManager::vtkInternal::DoMRMLSceneNodesModifiedCallback(
+    vtkObject* vtkNotUsed(vtk_obj), unsigned long event, void* client_data, void* call_data)
+{
+  assert(event == vtkMRMLScene::NodesModifiedEvent);
+#ifndef _DEBUG
+  (void)event;
+#endif
+
+  vtkMRMLAbstractDisplayableManager* self =
+      reinterpret_cast<vtkMRMLAbstractDisplayableManager*>(client_data);
+  assert(self);
+
+  self->OnMRMLSceneNodesModified(reinterpret_cast<vtkCollection*>(call_data));
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLAbstractDisplayableManager::vtkInternal::SetAndObserveInteractor(
     vtkRenderWindowInteractor* newInteractor)
@@ -513,6 +570,10 @@ vtkMRMLAbstractDisplayableManager::vtkMRMLAbstractDisplayableManager()
   widgetsObserver->GetCallbackCommand()->SetClientData(this);
   widgetsObserver->GetCallbackCommand()->SetCallback(
     vtkMRMLAbstractDisplayableManager::WidgetsCallback);
+
+  // Wrap MRML nodes callback to allow measuring node event processing time
+  this->GetMRMLNodesCallbackCommand()->SetCallback(
+    vtkMRMLAbstractDisplayableManager::DisplayableManagerMRMLNodesCallback);
 }
 
 //----------------------------------------------------------------------------
@@ -704,6 +765,17 @@ void vtkMRMLAbstractDisplayableManager
 {
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLAbstractDisplayableManager
+::OnMRMLSceneNodesModified(vtkCollection* vtkNotUsed(modifiedNodes))
+{
+  if (this->Internal->RenderRequestDeferred)
+    {
+    this->Internal->RenderRequestDeferred = false;
+    this->RequestRender();
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLAbstractDisplayableManager
 ::ProcessWidgetsEvents(vtkObject *vtkNotUsed(caller),
@@ -727,6 +799,38 @@ void vtkMRMLAbstractDisplayableManager::WidgetsCallback(vtkObject *caller,
   self->ProcessWidgetsEvents(caller, eid, callData);
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLAbstractDisplayableManager::DisplayableManagerMRMLNodesCallback(vtkObject *caller,
+                                                                            unsigned long eid,
+                                                                            void *clientData,
+                                                                            void *callData)
+{
+  vtkMRMLAbstractDisplayableManager* self =
+    reinterpret_cast<vtkMRMLAbstractDisplayableManager *>(clientData);
+  vtkMRMLDisplayableManagerGroup* group = self ? self->Internal->DisplayableManagerGroup : nullptr;
+  if (!group || !group->GetProfilingEnabled())
+    {
+    vtkMRMLAbstractLogic::MRMLNodesCallback(caller, eid, clientData, callData);
+    return;
+    }
+  double startTime = vtkTimerLog::GetUniversalTime();
+  vtkMRMLAbstractLogic::MRMLNodesCallback(caller, eid, clientData, callData);
+  double endTime = vtkTimerLog::GetUniversalTime();
+  std::stringstream details;
+  details << vtkCommand::GetStringFromEventId(eid);
+  vtkMRMLNode* callerNode = vtkMRMLNode::SafeDownCast(caller);
+  if (callerNode && callerNode->GetID())
+    {
+    details << " " << callerNode->GetID();
+    }
+  // The displayable manager may have been removed from the group while processing the event
+  if (self->Internal->DisplayableManagerGroup == group)
+    {
+    group->AddProfilingEvent(std::string(self->GetClassName()) + "::ProcessMRMLNodesEvents", "MRML",
+      startTime, endTime - startTime, details.str());
+    }
+}
+
 //----------------------------------------------------------------------------
 vtkCallbackCommand* vtkMRMLAbstractDisplayableManager::GetWidgetsCallbackCommand()
 {
@@ -803,6 +907,7 @@ void vtkMRMLAbstractDisplayableManager::SetAndObserveMRMLDisplayableNode(
                                       viewNode,
                                       this->Internal->MRMLDisplayableNodeObservableEvents);
   this->SetMRMLScene(sceneToObserve);
+  this->Internal->SetAndObserveMRMLSceneNodesModified(sceneToObserve);
   this->SetUpdateFromMRMLRequested(true);
   this->CreateIfPossible();
   if (viewNode != nullptr)
@@ -829,9 +934,29 @@ void vtkMRMLAbstractDisplayableManager::RequestRender()
 {
   // TODO Add a mechanism to check if Rendering is disable
 
+  if (this->GetMRMLScene() && this->GetMRMLScene() == this->Internal->NodesModifiedScene
+    && this->GetMRMLScene()->GetInvokingDeferredModifiedEvents())
+    {
+    // All render requests are processed at once in OnMRMLSceneNodesModified()
+    this->Internal->RenderRequestDeferred = true;
+    return;
+    }
+
   if (this->Internal->UpdateFromMRMLRequested)
     {
-    this->UpdateFromMRML();
+    vtkMRMLDisplayableManagerGroup* group = this->Internal->DisplayableManagerGroup;
+    if (group && group->GetProfilingEnabled())
+      {
+      double startTime = vtkTimerLog::GetUniversalTime();
+      this->UpdateFromMRML();
+      double endTime = vtkTimerLog::GetUniversalTime();
+      group->AddProfilingEvent(std::string(this->GetClassName()) + "::UpdateFromMRML", "MRML",
+        startTime, endTime - startTime);
+      }
+    else
+      {
+      this->UpdateFromMRML();
+      }
     }
 
   this->InvokeEvent(vtkCommand::UpdateEvent);
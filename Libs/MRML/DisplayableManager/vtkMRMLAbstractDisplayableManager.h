@@ -26,6 +26,7 @@
 
 #include "vtkMRMLDisplayableManagerExport.h"
 
+class vtkCollection;
 class vtkMRMLInteractionEventData;
 class vtkMRMLInteractionNode;
 class vtkMRMLSelectionNode;
@@ -166,6 +167,12 @@ protected:
   static void WidgetsCallback(vtkObject *caller, unsigned long eid,
                               void *clientData, void *callData);
 
+  /// Relay events from the observed MRML nodes to vtkMRMLAbstractLogic::MRMLNodesCallback
+  /// and record the processing time if profiling is enabled in the displayable manager group.
+  /// \sa vtkMRMLDisplayableManagerGroup::SetProfilingEnabled()
+  static void DisplayableManagerMRMLNodesCallback(vtkObject *caller, unsigned long eid,
+                                                  void *clientData, void *callData);
+
   /// Get vtkWidget callbackCommand
   vtkCallbackCommand * GetWidgetsCallbackCommand();
 
@@ -182,6 +189,18 @@ protected:
   /// Could be overloaded in DisplayableManager subclass.
   virtual void OnMRMLDisplayableNodeModifiedEvent(vtkObject* caller);
 
+  /// Called when the scene leaves vtkMRMLScene::DeferredModifyState, after
+  /// the pending modified events of the modified nodes have been invoked.
+  /// Render requests made while those events are invoked are collected into a
+  /// single RequestRender() call here.
+  /// The scene of the displayable node is observed independently of
+  /// SetMRMLSceneInternal(), so subclasses that reimplement it do not need to
+  /// observe vtkMRMLScene::NodesModifiedEvent.
+  /// Could be overloaded in DisplayableManager subclass to update the displayed
+  /// representation of all \a modifiedNodes at once.
+  /// \sa vtkMRMLScene::NodesModifiedEvent
+  virtual void OnMRMLSceneNodesModified(vtkCollection* modifiedNodes);
+
   /// \brief Allow to specify additional events that the DisplayableNode will observe
   /// \warning Should be called within AdditionalInitializeStep() method
   /// \sa AdditionalInitializeStep()
@@ -149,6 +149,12 @@ void vtkMRMLAbstractWidgetRepresentation::UpdateFromMRML(
 {
 }
 
+//-----------------------------------------------------------------------------
+bool vtkMRMLAbstractWidgetRepresentation::GetInteractionDisplayBounds(double vtkNotUsed(displayBounds)[4])
+{
+  return false;
+}
+
 //-----------------------------------------------------------------------------
 void vtkMRMLAbstractWidgetRepresentation::UpdateRelativeCoincidentTopologyOffsets(vtkMapper* mapper)
 {
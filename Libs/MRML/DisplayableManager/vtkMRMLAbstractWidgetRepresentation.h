@@ -118,6 +118,14 @@ public:
   */
   virtual void UpdateFromMRML(vtkMRMLNode* caller, unsigned long event, void *callData = nullptr);
 
+  /// Get the region in display coordinates (xmin, xmax, ymin, ymax) where the representation may
+  /// respond to mouse hover, including the picking tolerance. It is used for quickly finding
+  /// candidate widgets without asking each widget (see vtkMRMLWidgetPickingIndex).
+  /// If xmin > xmax then the representation cannot be interacted with anywhere.
+  /// Returns false if the region is not known (the widget must be always asked if it can interact).
+  /// The default implementation returns false.
+  virtual bool GetInteractionDisplayBounds(double displayBounds[4]);
+
   /// Specify tolerance for performing pick operations of points.
   /// For display renderers it is defined in pixels. The specified value is scaled with ScreenScaleFactor.
   /// For VR renderer it is defined in millimeters. The specified value is scaled with WorldToPhysicalScale.
@@ -37,12 +37,22 @@
 #include <vtkObjectFactory.h>
 #include <vtkRenderer.h>
 #include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
 #include <vtkSmartPointer.h>
+#include <vtkTextActor.h>
+#include <vtkTextProperty.h>
+#include <vtkTimerLog.h>
 #include <vtkWeakPointer.h>
 
 // STD includes
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
 #include <vector>
 
 //----------------------------------------------------------------------------
@@ -72,6 +82,58 @@ public:
   vtkMRMLNode*                          MRMLDisplayableNode;
   vtkRenderer*                          Renderer;
   vtkWeakPointer<vtkMRMLLightBoxRendererManagerProxy> LightBoxRendererManagerProxy;
+
+  /// Add/remove renderer observers that are used for measuring rendering time
+  void UpdateRenderObservers(vtkRenderer* oldRenderer, vtkRenderer* newRenderer);
+
+  struct ProfilingEventType
+    {
+    std::string Name;
+    std::string Category;
+    double StartTime; // in seconds
+    double Duration; // in seconds
+    std::string Details;
+    };
+
+  bool ProfilingEnabled;
+  int MaximumNumberOfProfilingEvents;
+  std::deque<ProfilingEventType> ProfilingEvents;
+  vtkSmartPointer<vtkCallbackCommand> RenderCallBackCommand;
+  double RenderStartTime;
+
+  /// Returns minimum time between two render requests (in seconds)
+  double GetMinimumRenderInterval();
+
+  /// Stop observing timer events of the observed interactor
+  void SetAndObserveTimerInteractor(vtkRenderWindowInteractor* interactor);
+
+  bool RenderRequestCoalescing;
+  double MaximumUpdateRate;
+  bool AdaptiveUpdateRate;
+  /// True if a render is requested from the view but rendering has not started yet
+  bool RenderRequestPending;
+  double RenderRequestPendingTime;
+  /// Last time a render was requested from the view (UpdateEvent was invoked)
+  double LastRenderRequestInvokedTime;
+  double LastRenderDuration;
+  vtkWeakPointer<vtkRenderWindowInteractor> TimerInteractor;
+  int DeferredRenderTimerId;
+  int NumberOfRenderRequests;
+  int NumberOfCoalescedRenderRequests;
+  int NumberOfRenders;
+
+  /// Add/remove interaction latency overlay actor to/from the renderer
+  void UpdateInteractionLatencyOverlay(vtkRenderer* oldRenderer, vtkRenderer* newRenderer);
+
+  /// Time of the earliest interaction event that has not been rendered yet
+  double PendingInteractionEventTime;
+  /// Time of the earliest interaction event that is reflected in the frame that is being rendered
+  double RenderingInteractionEventTime;
+  int MaximumNumberOfInteractionLatencies;
+  /// Most recent interaction latency values (in seconds)
+  std::deque<double> InteractionLatencies;
+  bool InteractionLatencyOverlayVisible;
+  vtkSmartPointer<vtkTextActor> InteractionLatencyActor;
 };
 
 //----------------------------------------------------------------------------
@@ -85,6 +147,123 @@ vtkMRMLDisplayableManagerGroup::vtkInternal::vtkInternal()
   this->CallBackCommand = vtkSmartPointer<vtkCallbackCommand>::New();
   this->DisplayableManagerFactory = nullptr;
   this->LightBoxRendererManagerProxy = nullptr;
+  this->ProfilingEnabled = false;
+  this->MaximumNumberOfProfilingEvents = 100000;
+  this->RenderCallBackCommand = vtkSmartPointer<vtkCallbackCommand>::New();
+  this->RenderStartTime = 0.0;
+  this->RenderRequestCoalescing = true;
+  this->MaximumUpdateRate = 0.0;
+  this->AdaptiveUpdateRate = false;
+  this->RenderRequestPending = false;
+  this->RenderRequestPendingTime = 0.0;
+  this->LastRenderRequestInvokedTime = 0.0;
+  this->LastRenderDuration = 0.0;
+  this->PendingInteractionEventTime = 0.0;
+  this->RenderingInteractionEventTime = 0.0;
+  this->MaximumNumberOfInteractionLatencies = 1000;
+  this->InteractionLatencyOverlayVisible = false;
+  this->DeferredRenderTimerId = 0;
+  this->NumberOfRenderRequests = 0;
+  this->NumberOfCoalescedRenderRequests = 0;
+  this->NumberOfRenders = 0;
+}
+
+//----------------------------------------------------------------------------
+double vtkMRMLDisplayableManagerGroup::vtkInternal::GetMinimumRenderInterval()
+{
+  double minimumInterval = 0.0;
+  if (this->MaximumUpdateRate > 0.0)
+    {
+    minimumInterval = 1.0 / this->MaximumUpdateRate;
+    }
+  if (this->AdaptiveUpdateRate)
+    {
+    // If rendering is slow then let rendering take at most half of the time,
+    // to leave time for processing of interaction events between renders.
+    minimumInterval = std::max(minimumInterval, 2.0 * this->LastRenderDuration);
+    }
+  return minimumInterval;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::vtkInternal::SetAndObserveTimerInteractor(
+  vtkRenderWindowInteractor* interactor)
+{
+  if (this->TimerInteractor == interactor)
+    {
+    return;
+    }
+  if (this->TimerInteractor)
+    {
+    if (this->DeferredRenderTimerId)
+      {
+      this->TimerInteractor->DestroyTimer(this->DeferredRenderTimerId);
+      }
+    this->TimerInteractor->RemoveObservers(vtkCommand::TimerEvent, this->RenderCallBackCommand);
+    }
+  this->DeferredRenderTimerId = 0;
+  this->TimerInteractor = interactor;
+  if (this->TimerInteractor)
+    {
+    this->TimerInteractor->AddObserver(vtkCommand::TimerEvent, this->RenderCallBackCommand);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::vtkInternal::UpdateRenderObservers(
+  vtkRenderer* oldRenderer, vtkRenderer* newRenderer)
+{
+  if (oldRenderer)
+    {
+    oldRenderer->RemoveObservers(vtkCommand::StartEvent, this->RenderCallBackCommand);
+    oldRenderer->RemoveObservers(vtkCommand::EndEvent, this->RenderCallBackCommand);
+    }
+  if (newRenderer)
+    {
+    newRenderer->AddObserver(vtkCommand::StartEvent, this->RenderCallBackCommand);
+    newRenderer->AddObserver(vtkCommand::EndEvent, this->RenderCallBackCommand);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::vtkInternal::UpdateInteractionLatencyOverlay(
+  vtkRenderer* oldRenderer, vtkRenderer* newRenderer)
+{
+  if (!this->InteractionLatencyActor)
+    {
+    if (!this->InteractionLatencyOverlayVisible)
+      {
+      // overlay has never been shown, no need to create the actor
+      return;
+      }
+    this->InteractionLatencyActor = vtkSmartPointer<vtkTextActor>::New();
+    this->InteractionLatencyActor->PickableOff();
+    this->InteractionLatencyActor->DragableOff();
+    this->InteractionLatencyActor->SetPosition(5, 5);
+    vtkTextProperty* textProperty = this->InteractionLatencyActor->GetTextProperty();
+    textProperty->SetFontSize(12);
+    textProperty->SetFontFamilyToCourier();
+    textProperty->SetColor(1.0, 1.0, 0.0);
+    textProperty->ShadowOn();
+    }
+  if (oldRenderer && oldRenderer != newRenderer)
+    {
+    oldRenderer->RemoveViewProp(this->InteractionLatencyActor);
+    }
+  if (newRenderer)
+    {
+    if (this->InteractionLatencyOverlayVisible)
+      {
+      if (!newRenderer->HasViewProp(this->InteractionLatencyActor))
+        {
+        newRenderer->AddViewProp(this->InteractionLatencyActor);
+        }
+      }
+    else
+      {
+      newRenderer->RemoveViewProp(this->InteractionLatencyActor);
+      }
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -96,6 +275,8 @@ vtkMRMLDisplayableManagerGroup::vtkMRMLDisplayableManagerGroup()
   this->Internal = new vtkInternal;
   this->Internal->CallBackCommand->SetCallback(Self::DoCallback);
   this->Internal->CallBackCommand->SetClientData(this);
+  this->Internal->RenderCallBackCommand->SetCallback(Self::DoRenderCallback);
+  this->Internal->RenderCallBackCommand->SetClientData(this);
 }
 
 //----------------------------------------------------------------------------
@@ -111,8 +292,11 @@ vtkMRMLDisplayableManagerGroup::~vtkMRMLDisplayableManagerGroup()
 
   if (this->Internal->Renderer)
     {
+    this->Internal->UpdateRenderObservers(this->Internal->Renderer, nullptr);
+    this->Internal->UpdateInteractionLatencyOverlay(this->Internal->Renderer, nullptr);
     this->Internal->Renderer->UnRegister(this);
     }
+  this->Internal->SetAndObserveTimerInteractor(nullptr);
 
   if (this->Internal->LightBoxRendererManagerProxy)
     {
@@ -126,6 +310,15 @@ vtkMRMLDisplayableManagerGroup::~vtkMRMLDisplayableManagerGroup()
 void vtkMRMLDisplayableManagerGroup::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ProfilingEnabled: " << (this->Internal->ProfilingEnabled ? "true" : "false") << "\n";
+  os << indent << "NumberOfProfilingEvents: " << this->Internal->ProfilingEvents.size() << "\n";
+  os << indent << "RenderRequestCoalescing: " << (this->Internal->RenderRequestCoalescing ? "true" : "false") << "\n";
+  os << indent << "MaximumUpdateRate: " << this->Internal->MaximumUpdateRate << "\n";
+  os << indent << "AdaptiveUpdateRate: " << (this->Internal->AdaptiveUpdateRate ? "true" : "false") << "\n";
+  os << indent << "NumberOfRenderRequests: " << this->Internal->NumberOfRenderRequests << "\n";
+  os << indent << "NumberOfCoalescedRenderRequests: " << this->Internal->NumberOfCoalescedRenderRequests << "\n";
+  os << indent << "NumberOfRenders: " << this->Internal->NumberOfRenders << "\n";
+  os << indent << "InteractionLatency: " << this->GetInteractionLatencySummary() << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -313,6 +506,12 @@ void vtkMRMLDisplayableManagerGroup::SetRenderer(vtkRenderer* newRenderer)
     return;
     }
 
+  this->Internal->UpdateRenderObservers(this->Internal->Renderer, newRenderer);
+  this->Internal->UpdateInteractionLatencyOverlay(this->Internal->Renderer, newRenderer);
+  this->Internal->SetAndObserveTimerInteractor(nullptr);
+  this->Internal->RenderRequestPending = false;
+  this->Internal->PendingInteractionEventTime = 0.0;
+
   if (this->Internal->Renderer)
     {
     this->Internal->Renderer->Delete();
@@ -355,9 +554,131 @@ vtkRenderWindowInteractor* vtkMRMLDisplayableManagerGroup::GetInteractor()
 //----------------------------------------------------------------------------
 void vtkMRMLDisplayableManagerGroup::RequestRender()
 {
+  this->Internal->NumberOfRenderRequests++;
+  if (!this->Internal->RenderRequestCoalescing)
+    {
+    this->InvokeEvent(vtkCommand::UpdateEvent);
+    return;
+    }
+
+  double currentTime = vtkTimerLog::GetUniversalTime();
+  // If the view does not render for a long time (e.g., because it is hidden)
+  // then the pending request is considered lost and the render is requested again.
+  const double maximumPendingTime = 1.0;
+  if (this->Internal->RenderRequestPending
+    && currentTime - this->Internal->RenderRequestPendingTime < maximumPendingTime)
+    {
+    // The view will render anyway, which will take into account all modifications made until then
+    this->Internal->NumberOfCoalescedRenderRequests++;
+    return;
+    }
+  this->Internal->RenderRequestPending = true;
+  this->Internal->RenderRequestPendingTime = currentTime;
+
+  double remainingTime = this->Internal->LastRenderRequestInvokedTime
+    + this->Internal->GetMinimumRenderInterval() - currentTime;
+  if (remainingTime > 0.0)
+    {
+    // Delay the render request to not exceed the maximum update rate
+    vtkRenderWindowInteractor* interactor = this->GetInteractor();
+    this->Internal->SetAndObserveTimerInteractor(interactor);
+    if (interactor)
+      {
+      unsigned long remainingTimeMs = static_cast<unsigned long>(std::ceil(remainingTime * 1000.0));
+      this->Internal->DeferredRenderTimerId = interactor->CreateOneShotTimer(remainingTimeMs);
+      if (this->Internal->DeferredRenderTimerId)
+        {
+        return;
+        }
+      }
+    }
+  this->InvokeRequestedRender();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::InvokeRequestedRender()
+{
+  this->Internal->LastRenderRequestInvokedTime = vtkTimerLog::GetUniversalTime();
   this->InvokeEvent(vtkCommand::UpdateEvent);
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::SetRenderRequestCoalescing(bool coalescing)
+{
+  if (this->Internal->RenderRequestCoalescing == coalescing)
+    {
+    return;
+    }
+  this->Internal->RenderRequestCoalescing = coalescing;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLDisplayableManagerGroup::GetRenderRequestCoalescing()
+{
+  return this->Internal->RenderRequestCoalescing;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::SetMaximumUpdateRate(double updateRate)
+{
+  if (this->Internal->MaximumUpdateRate == updateRate)
+    {
+    return;
+    }
+  this->Internal->MaximumUpdateRate = updateRate;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+double vtkMRMLDisplayableManagerGroup::GetMaximumUpdateRate()
+{
+  return this->Internal->MaximumUpdateRate;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::SetAdaptiveUpdateRate(bool adaptive)
+{
+  if (this->Internal->AdaptiveUpdateRate == adaptive)
+    {
+    return;
+    }
+  this->Internal->AdaptiveUpdateRate = adaptive;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLDisplayableManagerGroup::GetAdaptiveUpdateRate()
+{
+  return this->Internal->AdaptiveUpdateRate;
+}
+
+//----------------------------------------------------------------------------
+int vtkMRMLDisplayableManagerGroup::GetNumberOfRenderRequests()
+{
+  return this->Internal->NumberOfRenderRequests;
+}
+
+//----------------------------------------------------------------------------
+int vtkMRMLDisplayableManagerGroup::GetNumberOfCoalescedRenderRequests()
+{
+  return this->Internal->NumberOfCoalescedRenderRequests;
+}
+
+//----------------------------------------------------------------------------
+int vtkMRMLDisplayableManagerGroup::GetNumberOfRenders()
+{
+  return this->Internal->NumberOfRenders;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::ResetRenderRequestCounters()
+{
+  this->Internal->NumberOfRenderRequests = 0;
+  this->Internal->NumberOfCoalescedRenderRequests = 0;
+  this->Internal->NumberOfRenders = 0;
+}
+
 //----------------------------------------------------------------------------
 vtkRenderer* vtkMRMLDisplayableManagerGroup::GetRenderer()
 {
@@ -501,3 +822,343 @@ vtkMRMLLightBoxRendererManagerProxy* vtkMRMLDisplayableManagerGroup::GetLightBox
 {
   return this->Internal->LightBoxRendererManagerProxy;
 }
+
+//---------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::SetProfilingEnabled(bool enabled)
+{
+  if (this->Internal->ProfilingEnabled == enabled)
+    {
+    return;
+    }
+  this->Internal->ProfilingEnabled = enabled;
+  this->Internal->UpdateRenderObservers(this->Internal->Renderer, this->Internal->Renderer);
+  this->Modified();
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLDisplayableManagerGroup::GetProfilingEnabled()
+{
+  return this->Internal->ProfilingEnabled;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::AddProfilingEvent(const std::string& name, const std::string& category,
+  double startTime, double duration, const std::string& details/*=std::string()*/)
+{
+  if (!this->Internal->ProfilingEnabled || this->Internal->MaximumNumberOfProfilingEvents <= 0)
+    {
+    return;
+    }
+  while (static_cast<int>(this->Internal->ProfilingEvents.size()) >= this->Internal->MaximumNumberOfProfilingEvents)
+    {
+    this->Internal->ProfilingEvents.pop_front();
+    }
+  vtkInternal::ProfilingEventType profilingEvent;
+  profilingEvent.Name = name;
+  profilingEvent.Category = category;
+  profilingEvent.StartTime = startTime;
+  profilingEvent.Duration = duration;
+  profilingEvent.Details = details;
+  this->Internal->ProfilingEvents.push_back(profilingEvent);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::ClearProfilingEvents()
+{
+  this->Internal->ProfilingEvents.clear();
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLDisplayableManagerGroup::GetNumberOfProfilingEvents()
+{
+  return static_cast<int>(this->Internal->ProfilingEvents.size());
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::SetMaximumNumberOfProfilingEvents(int maximumNumberOfEvents)
+{
+  this->Internal->MaximumNumberOfProfilingEvents = maximumNumberOfEvents;
+  while (static_cast<int>(this->Internal->ProfilingEvents.size()) > std::max(maximumNumberOfEvents, 0))
+    {
+    this->Internal->ProfilingEvents.pop_front();
+    }
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLDisplayableManagerGroup::GetMaximumNumberOfProfilingEvents()
+{
+  return this->Internal->MaximumNumberOfProfilingEvents;
+}
+
+//---------------------------------------------------------------------------
+std::string vtkMRMLDisplayableManagerGroup::GetProfilingSummary()
+{
+  struct SummaryType
+    {
+    int NumberOfCalls{ 0 };
+    double TotalTime{ 0.0 };
+    double MaximumTime{ 0.0 };
+    };
+  std::map<std::string, SummaryType> summaries;
+  for (const vtkInternal::ProfilingEventType& profilingEvent : this->Internal->ProfilingEvents)
+    {
+    SummaryType& summary = summaries[profilingEvent.Name];
+    summary.NumberOfCalls++;
+    summary.TotalTime += profilingEvent.Duration;
+    summary.MaximumTime = std::max(summary.MaximumTime, profilingEvent.Duration);
+    }
+  std::vector<std::pair<std::string, SummaryType> > sortedSummaries(summaries.begin(), summaries.end());
+  std::sort(sortedSummaries.begin(), sortedSummaries.end(),
+    [](const std::pair<std::string, SummaryType>& a, const std::pair<std::string, SummaryType>& b)
+    {
+    return a.second.TotalTime > b.second.TotalTime;
+    });
+
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3);
+  ss << "Name\tCalls\tTotal [ms]\tMaximum [ms]\n";
+  for (const std::pair<std::string, SummaryType>& summary : sortedSummaries)
+    {
+    ss << summary.first << "\t" << summary.second.NumberOfCalls
+      << "\t" << summary.second.TotalTime * 1000.0
+      << "\t" << summary.second.MaximumTime * 1000.0 << "\n";
+    }
+  return ss.str();
+}
+
+//---------------------------------------------------------------------------
+namespace
+{
+std::string EscapeJSONString(const std::string& text)
+{
+  std::stringstream ss;
+  for (char c : text)
+    {
+    switch (c)
+      {
+      case '"': ss << "\\\""; break;
+      case '\\': ss << "\\\\"; break;
+      case '\n': ss << "\\n"; break;
+      case '\r': ss << "\\r"; break;
+      case '\t': ss << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+          {
+          ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+          }
+        else
+          {
+          ss << c;
+          }
+      }
+    }
+  return ss.str();
+}
+}
+
+//---------------------------------------------------------------------------
+std::string vtkMRMLDisplayableManagerGroup::GetProfilingEventsAsChromeTrace()
+{
+  // Events of each view are shown in a separate row, named after the view node
+  std::string viewName = "View";
+  if (this->Internal->MRMLDisplayableNode && this->Internal->MRMLDisplayableNode->GetName())
+    {
+    viewName = this->Internal->MRMLDisplayableNode->GetName();
+    }
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3);
+  ss << "{\"traceEvents\":[\n";
+  ss << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\""
+    << EscapeJSONString(viewName) << "\"}}";
+  for (const vtkInternal::ProfilingEventType& profilingEvent : this->Internal->ProfilingEvents)
+    {
+    // Chrome trace timestamps and durations are in microseconds
+    ss << ",\n{\"name\":\"" << EscapeJSONString(profilingEvent.Name) << "\""
+      << ",\"cat\":\"" << EscapeJSONString(profilingEvent.Category) << "\""
+      << ",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+      << ",\"ts\":" << profilingEvent.StartTime * 1.0e6
+      << ",\"dur\":" << profilingEvent.Duration * 1.0e6;
+    if (!profilingEvent.Details.empty())
+      {
+      ss << ",\"args\":{\"details\":\"" << EscapeJSONString(profilingEvent.Details) << "\"}";
+      }
+    ss << "}";
+    }
+  ss << "\n]}\n";
+  return ss.str();
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLDisplayableManagerGroup::WriteProfilingEventsAsChromeTrace(const std::string& fileName)
+{
+  std::ofstream file(fileName.c_str());
+  if (!file.is_open())
+    {
+    vtkErrorMacro("WriteProfilingEventsAsChromeTrace: failed to open file for writing: " << fileName);
+    return false;
+    }
+  file << this->GetProfilingEventsAsChromeTrace();
+  file.close();
+  return !file.fail();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::AddInteractionEventTime(double eventTime)
+{
+  if (this->Internal->PendingInteractionEventTime <= 0.0
+    || eventTime < this->Internal->PendingInteractionEventTime)
+    {
+    this->Internal->PendingInteractionEventTime = eventTime;
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::SetPendingInteractionEventTime(double eventTime)
+{
+  this->Internal->PendingInteractionEventTime = eventTime;
+}
+
+//---------------------------------------------------------------------------
+double vtkMRMLDisplayableManagerGroup::GetPendingInteractionEventTime()
+{
+  return this->Internal->PendingInteractionEventTime;
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLDisplayableManagerGroup::GetNumberOfInteractionLatencies()
+{
+  return static_cast<int>(this->Internal->InteractionLatencies.size());
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::SetMaximumNumberOfInteractionLatencies(int maximumNumberOfLatencies)
+{
+  this->Internal->MaximumNumberOfInteractionLatencies = maximumNumberOfLatencies;
+  while (static_cast<int>(this->Internal->InteractionLatencies.size()) > std::max(maximumNumberOfLatencies, 0))
+    {
+    this->Internal->InteractionLatencies.pop_front();
+    }
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLDisplayableManagerGroup::GetMaximumNumberOfInteractionLatencies()
+{
+  return this->Internal->MaximumNumberOfInteractionLatencies;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::ClearInteractionLatencies()
+{
+  this->Internal->InteractionLatencies.clear();
+}
+
+//---------------------------------------------------------------------------
+double vtkMRMLDisplayableManagerGroup::GetInteractionLatencyPercentile(double percentile)
+{
+  if (this->Internal->InteractionLatencies.empty())
+    {
+    return 0.0;
+    }
+  std::vector<double> latencies(this->Internal->InteractionLatencies.begin(), this->Internal->InteractionLatencies.end());
+  // nearest-rank method
+  percentile = std::max(0.0, std::min(100.0, percentile));
+  size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * latencies.size()));
+  size_t index = (rank > 0 ? rank - 1 : 0);
+  std::nth_element(latencies.begin(), latencies.begin() + index, latencies.end());
+  return latencies[index] * 1000.0;
+}
+
+//---------------------------------------------------------------------------
+std::string vtkMRMLDisplayableManagerGroup::GetInteractionLatencySummary()
+{
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(1)
+    << "Latency p50: " << this->GetInteractionLatencyPercentile(50.0)
+    << " ms, p95: " << this->GetInteractionLatencyPercentile(95.0)
+    << " ms, p99: " << this->GetInteractionLatencyPercentile(99.0)
+    << " ms (" << this->GetNumberOfInteractionLatencies() << " samples)";
+  return ss.str();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::SetInteractionLatencyOverlayVisible(bool visible)
+{
+  if (this->Internal->InteractionLatencyOverlayVisible == visible)
+    {
+    return;
+    }
+  this->Internal->InteractionLatencyOverlayVisible = visible;
+  this->Internal->UpdateInteractionLatencyOverlay(nullptr, this->Internal->Renderer);
+  if (visible)
+    {
+    this->Internal->InteractionLatencyActor->SetInput(this->GetInteractionLatencySummary().c_str());
+    }
+  this->RequestRender();
+  this->Modified();
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLDisplayableManagerGroup::GetInteractionLatencyOverlayVisible()
+{
+  return this->Internal->InteractionLatencyOverlayVisible;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLDisplayableManagerGroup::DoRenderCallback(vtkObject* vtkNotUsed(vtk_obj), unsigned long event,
+                                                      void* client_data, void* call_data)
+{
+  vtkMRMLDisplayableManagerGroup* self =
+      reinterpret_cast<vtkMRMLDisplayableManagerGroup*>(client_data);
+  assert(self);
+  if (event == vtkCommand::StartEvent)
+    {
+    // Render requests that are received during rendering need a new render
+    self->Internal->RenderRequestPending = false;
+    self->Internal->NumberOfRenders++;
+    self->Internal->RenderStartTime = vtkTimerLog::GetUniversalTime();
+    // This frame reflects all interaction events received so far
+    self->Internal->RenderingInteractionEventTime = self->Internal->PendingInteractionEventTime;
+    self->Internal->PendingInteractionEventTime = 0.0;
+    }
+  else if (event == vtkCommand::EndEvent)
+    {
+    double endTime = vtkTimerLog::GetUniversalTime();
+    self->Internal->LastRenderDuration = endTime - self->Internal->RenderStartTime;
+    self->AddProfilingEvent("Render", "Render",
+      self->Internal->RenderStartTime, self->Internal->LastRenderDuration);
+    if (self->Internal->RenderingInteractionEventTime > 0.0)
+      {
+      double latency = endTime - self->Internal->RenderingInteractionEventTime;
+      self->Internal->RenderingInteractionEventTime = 0.0;
+      // Latency of more than a few seconds means that the view was not rendered because of the
+      // interaction event (e.g., the event did not change anything that is visible in the view),
+      // therefore such values are ignored.
+      const double maximumLatency = 5.0;
+      if (latency >= 0.0 && latency < maximumLatency && self->Internal->MaximumNumberOfInteractionLatencies > 0)
+        {
+        while (static_cast<int>(self->Internal->InteractionLatencies.size())
+          >= self->Internal->MaximumNumberOfInteractionLatencies)
+          {
+          self->Internal->InteractionLatencies.pop_front();
+          }
+        self->Internal->InteractionLatencies.push_back(latency);
+        if (self->Internal->InteractionLatencyOverlayVisible && self->Internal->InteractionLatencyActor)
+          {
+          // The updated text is displayed in the next rendered frame
+          self->Internal->InteractionLatencyActor->SetInput(self->GetInteractionLatencySummary().c_str());
+          }
+        }
+      }
+    }
+  else if (event == vtkCommand::TimerEvent)
+    {
+    int* timerId = reinterpret_cast<int*>(call_data);
+    if (!timerId || !self->Internal->DeferredRenderTimerId || *timerId != self->Internal->DeferredRenderTimerId)
+      {
+      // not our timer
+      return;
+      }
+    self->Internal->DeferredRenderTimerId = 0;
+    self->InvokeRequestedRender();
+    }
+}
@@ -26,6 +26,9 @@
 
 #include "vtkMRMLDisplayableManagerExport.h"
 
+// STD includes
+#include <string>
+
 class vtkMRMLDisplayableManagerFactory;
 class vtkMRMLAbstractDisplayableManager;
 class vtkMRMLLightBoxRendererManagerProxy;
@@ -80,9 +83,57 @@ public:
   /// Invoke vtkCommand::UpdateEvent
   /// An observer can then listen for that event and "compress" the different Render requests
   /// to efficiently call RenderWindow->Render()
+  /// If RenderRequestCoalescing is enabled then the event is not invoked again
+  /// until the renderer starts rendering, and it is delayed to not exceed MaximumUpdateRate.
   /// \sa vtkMRMLAbstractDisplayableManager::RequestRender()
   void RequestRender();
 
+  /// \brief Coalesce render requests of displayable managers.
+  ///
+  /// If enabled (default) then all render requests that are received before
+  /// the renderer starts rendering result in a single vtkCommand::UpdateEvent.
+  /// This avoids flooding the view with render requests when many nodes are
+  /// updated at once (for example, all markups in the scene).
+  void SetRenderRequestCoalescing(bool coalescing);
+  bool GetRenderRequestCoalescing();
+  void RenderRequestCoalescingOn() { this->SetRenderRequestCoalescing(true); }
+  void RenderRequestCoalescingOff() { this->SetRenderRequestCoalescing(false); }
+
+  /// \brief Maximum number of render requests per second.
+  ///
+  /// If a render is requested sooner after the previous request then it is delayed
+  /// (using a one-shot timer of the view's interactor). Set to 0 to not limit the update rate.
+  /// Requires an interactor that processes timer events in an event loop, therefore it is
+  /// disabled (0) by default and enabled by the MRML views (qMRMLThreeDView, qMRMLSliceView).
+  /// Only used if RenderRequestCoalescing is enabled.
+  void SetMaximumUpdateRate(double updateRate);
+  double GetMaximumUpdateRate();
+
+  /// \brief Adapt the update rate to the rendering time.
+  ///
+  /// If enabled and rendering is slow (for example, during continuous interaction
+  /// with a large volume rendering) then render requests are delayed so that rendering
+  /// takes at most half of the time, leaving time for processing interaction events.
+  /// Same as MaximumUpdateRate, it is disabled by default and enabled by the MRML views.
+  /// Only used if RenderRequestCoalescing is enabled.
+  void SetAdaptiveUpdateRate(bool adaptive);
+  bool GetAdaptiveUpdateRate();
+  void AdaptiveUpdateRateOn() { this->SetAdaptiveUpdateRate(true); }
+  void AdaptiveUpdateRateOff() { this->SetAdaptiveUpdateRate(false); }
+
+  /// Number of times RequestRender() was called.
+  /// \sa ResetRenderRequestCounters()
+  int GetNumberOfRenderRequests();
+  /// Number of render requests that did not result in a separate render,
+  /// because they were merged with a pending render request.
+  /// \sa ResetRenderRequestCounters()
+  int GetNumberOfCoalescedRenderRequests();
+  /// Number of times the renderer was rendered.
+  /// \sa ResetRenderRequestCounters()
+  int GetNumberOfRenders();
+  /// Set render request and render counters to zero.
+  void ResetRenderRequestCounters();
+
   /// Get Renderer
   vtkRenderer* GetRenderer();
 
@@ -117,6 +168,90 @@ public:
   /// \sa SetLightBoxRendererManagerProxy(vtkMRMLLightBoxRendererManagerProxy *)
   virtual vtkMRMLLightBoxRendererManagerProxy* GetLightBoxRendererManagerProxy();
 
+  /// \brief Enable recording of time spent in updating and rendering the view.
+  ///
+  /// If enabled, the time spent in processing MRML node events and in UpdateFromMRML()
+  /// of each displayable manager, and the time spent in rendering the renderer
+  /// is recorded. This allows finding out what makes interaction slow in a view.
+  /// Recorded events can be retrieved as summary or in Chrome trace event format
+  /// (that can be displayed in chrome://tracing or https://ui.perfetto.dev).
+  /// Disabled by default.
+  /// \sa GetProfilingSummary(), WriteProfilingEventsAsChromeTrace()
+  void SetProfilingEnabled(bool enabled);
+  bool GetProfilingEnabled();
+  void ProfilingEnabledOn() { this->SetProfilingEnabled(true); }
+  void ProfilingEnabledOff() { this->SetProfilingEnabled(false); }
+
+  /// Record a profiling event. Start time and duration are specified in seconds.
+  /// Start time is expected to be retrieved by vtkTimerLog::GetUniversalTime().
+  /// No-op if profiling is not enabled.
+  /// If the maximum number of events is reached then the oldest events are discarded.
+  void AddProfilingEvent(const std::string& name, const std::string& category,
+    double startTime, double duration, const std::string& details = std::string());
+
+  /// Remove all recorded profiling events
+  void ClearProfilingEvents();
+
+  /// Return the number of recorded profiling events
+  int GetNumberOfProfilingEvents();
+
+  /// Maximum number of profiling events that are kept in memory (default: 100000).
+  void SetMaximumNumberOfProfilingEvents(int maximumNumberOfEvents);
+  int GetMaximumNumberOfProfilingEvents();
+
+  /// Get number of calls, total and maximum time (in milliseconds) of each recorded
+  /// event name as human-readable text, sorted by decreasing total time.
+  std::string GetProfilingSummary();
+
+  /// Get all recorded profiling events in Chrome trace event JSON format.
+  std::string GetProfilingEventsAsChromeTrace();
+
+  /// Write all recorded profiling events in Chrome trace event JSON format.
+  /// Returns false if the file could not be written.
+  bool WriteProfilingEventsAsChromeTrace(const std::string& fileName);
+
+  /// \brief Register an interaction event for measuring interaction latency.
+  ///
+  /// Interaction latency is the time from receiving an interaction event (such as mouse move)
+  /// until the end of rendering of the frame that reflects it. The interactor style of the view
+  /// calls this method for each interaction event that is processed by a displayable manager.
+  /// If multiple events are received before the next render then latency is measured from the earliest one.
+  /// Event time is specified in seconds, as returned by vtkTimerLog::GetUniversalTime().
+  /// \sa vtkMRMLInteractionEventData::GetEventTime()
+  void AddInteractionEventTime(double eventTime);
+
+  /// Time of the earliest interaction event that is not reflected in a rendered frame yet.
+  /// 0 if there is no such event.
+  void SetPendingInteractionEventTime(double eventTime);
+  double GetPendingInteractionEventTime();
+
+  /// Number of interaction latency values that are available for computing statistics.
+  int GetNumberOfInteractionLatencies();
+
+  /// Maximum number of most recent interaction latency values that are kept (default: 1000).
+  void SetMaximumNumberOfInteractionLatencies(int maximumNumberOfLatencies);
+  int GetMaximumNumberOfInteractionLatencies();
+
+  /// Remove all interaction latency values.
+  void ClearInteractionLatencies();
+
+  /// Get interaction latency percentile (in milliseconds) of the most recent interactions.
+  /// For example, percentile=95 returns latency that 95% of interactions did not exceed.
+  /// Returns 0 if there are no latency values.
+  double GetInteractionLatencyPercentile(double percentile);
+
+  /// Get number of measurements and 50th, 95th, and 99th percentile of interaction latency
+  /// as a single line of human-readable text (e.g., for logging during automated benchmarks).
+  std::string GetInteractionLatencySummary();
+
+  /// Show interaction latency statistics in the lower-left corner of the view.
+  /// Intended for developers, for assessing responsiveness of views during interaction.
+  /// Hidden by default.
+  void SetInteractionLatencyOverlayVisible(bool visible);
+  bool GetInteractionLatencyOverlayVisible();
+  void InteractionLatencyOverlayVisibleOn() { this->SetInteractionLatencyOverlayVisible(true); }
+  void InteractionLatencyOverlayVisibleOff() { this->SetInteractionLatencyOverlayVisible(false); }
+
 protected:
 
   vtkMRMLDisplayableManagerGroup();
@@ -125,6 +260,13 @@ protected:
   typedef vtkMRMLDisplayableManagerGroup Self;
   static void DoCallback(vtkObject* vtk_obj, unsigned long event,
                          void* client_data, void* call_data);
+  /// Invoke vtkCommand::UpdateEvent to request rendering from the view
+  void InvokeRequestedRender();
+
+  /// Called when rendering of the renderer starts and ends (used for profiling
+  /// and render request coalescing) and on deferred render request timer events
+  static void DoRenderCallback(vtkObject* vtk_obj, unsigned long event,
+                               void* client_data, void* call_data);
   /// Trigger upon a DisplayableManager is either registered or unregistered from
   /// the associated factory
   void onDisplayableManagerFactoryRegisteredEvent(const char* displayableManagerName);
@@ -25,6 +25,7 @@
 #include "vtkPoints.h"
 #include "vtkRenderer.h"
 #include "vtkRenderWindowInteractor.h"
+#include "vtkTimerLog.h"
 #include "vtkWindow.h"
 
 #include <algorithm>
@@ -65,6 +66,7 @@ vtkMRMLInteractionEventData::vtkMRMLInteractionEventData()
   this->LastTranslation[0] = this->LastTranslation[1] = 0.0;
   this->WorldToPhysicalScale = 1.0;
   this->InteractionContextName = "";
+  this->EventTime = vtkTimerLog::GetUniversalTime();
   this->ComponentType = -1;
   this->ComponentIndex = -1;
   this->MouseMovedSinceButtonDown = true;
@@ -340,6 +342,18 @@ const std::string& vtkMRMLInteractionEventData::GetInteractionContextName()
   return this->InteractionContextName;
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLInteractionEventData::SetEventTime(double eventTime)
+{
+  this->EventTime = eventTime;
+}
+
+//---------------------------------------------------------------------------
+double vtkMRMLInteractionEventData::GetEventTime() const
+{
+  return this->EventTime;
+}
+
 //---------------------------------------------------------------------------
 bool vtkMRMLInteractionEventData::ComputeAccurateWorldPosition(bool force/*=false*/)
 {
@@ -115,6 +115,12 @@ public:
   void SetInteractionContextName(const std::string& v);
   const std::string& GetInteractionContextName();
 
+  /// Time when the event was received (in seconds, as returned by vtkTimerLog::GetUniversalTime()).
+  /// It is set to the current time when the event data object is created.
+  /// Used for measuring latency between an interaction event and the rendered frame that reflects it.
+  void SetEventTime(double eventTime);
+  double GetEventTime() const;
+
   void WorldToDisplay(const double worldPosition[3], double displayPosition[3]);
 
 protected:
@@ -158,6 +164,8 @@ protected:
   /// Name of interaction context. In case of the mouse, it is empty string
   std::string InteractionContextName;
 
+  double EventTime;
+
   bool Equivalent(const vtkEventData *e) const override;
 
   vtkMRMLInteractionEventData();
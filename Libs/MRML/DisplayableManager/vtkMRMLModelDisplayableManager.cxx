@@ -41,6 +41,8 @@
 #include <vtkClipDataSet.h>
 #include <vtkClipPolyData.h>
 #include <vtkColorTransferFunction.h>
+#include <vtkCompositeDataDisplayAttributes.h>
+#include <vtkCompositePolyDataMapper2.h>
 #include <vtkDataSetAttributes.h>
 #include <vtkDataSetMapper.h>
 #include <vtkExtractGeometry.h>
@@ -52,18 +54,28 @@
 #include <vtkImplicitBoolean.h>
 #include <vtkLookupTable.h>
 #include <vtkMatrix4x4.h>
+#include <vtkMultiBlockDataSet.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPlane.h>
+#include <vtkPlaneCollection.h>
 #include <vtkPointData.h>
+#include <vtkPoints.h>
 #include <vtkPointSet.h>
+#include <vtkPolyData.h>
 #include <vtkPolyDataMapper.h>
+#include <vtkPolyDataNormals.h>
 #include <vtkProp3DCollection.h>
 #include <vtkProperty.h>
+#include <vtkQuadricDecimation.h>
 #include <vtkRenderWindowInteractor.h>
+#include <vtkRenderer.h>
 #include <vtkSmartPointer.h>
 #include <vtkTexture.h>
+#include <vtkTransform.h>
 #include <vtkTransformFilter.h>
+#include <vtkTransformPolyDataFilter.h>
+#include <vtkTriangleFilter.h>
 #include <vtkVersion.h>
 #include <vtkWeakPointer.h>
 // For picking
@@ -73,6 +85,13 @@
 #include <vtkRendererCollection.h>
 #include <vtkWorldPointPicker.h>
 
+// STD includes
+#include <atomic>
+#include <list>
+#include <set>
+#include <sstream>
+#include <thread>
+
 //---------------------------------------------------------------------------
 vtkStandardNewMacro (vtkMRMLModelDisplayableManager );
 
@@ -96,11 +115,56 @@ public:
   /// Find first picked node from prop3Ds in cell picker and set PickedNodeID in Internal
   void FindFirstPickedDisplayNodeFromPickerProp3Ds();
 
+  /// Return true if the current slice clipping can be done by the clipping
+  /// planes of the mappers
+  bool IsGPUClippingApplicable();
+  /// Return true if any displayed model is clipped by a filter
+  bool HasModelsClippedByFilter();
+  /// Rebuild ClippingPlanes from the active slice planes
+  void UpdateClippingPlanes();
+
+  /// Return true if the model actor can be rendered in a batch
+  bool IsBatchable(const std::string& displayNodeID, vtkActor* actor);
+  /// Return a key that is the same for all the actors that can share a batch
+  static std::string GetBatchKey(vtkProperty* property);
+  /// Render the model actor in a batch or with its own actor depending on
+  /// its current display properties
+  void UpdateBatchedModel(const std::string& displayNodeID, vtkActor* actor);
+  /// Stop rendering the model in a batch. The model actor is added back to
+  /// the renderer if \a restoreActor is true.
+  void RemoveBatchedModel(const std::string& displayNodeID, bool restoreActor);
+  /// Rebuild the blocks and block attributes of the modified batches
+  void UpdateBatches();
+  /// Remove all the batches from the renderer
+  void ClearBatches();
+  /// Return the ID of the display node of a batched model block
+  std::string GetBatchedDisplayNodeID(vtkDataObject* block);
+
+  /// Add, update or remove the level of detail of a model actor depending on
+  /// its current mesh and display properties
+  void UpdateLevelOfDetail(const std::string& displayNodeID, vtkActor* actor);
+  void RemoveLevelOfDetail(const std::string& displayNodeID);
+  void ClearLevelsOfDetail();
+  /// Start decimating the mesh of a level of detail on a worker thread
+  void StartLevelOfDetailComputation(const std::string& displayNodeID, vtkPolyData* mesh);
+  /// Use the decimated meshes computed by the worker threads
+  void ProcessComputedLevelsOfDetail();
+  void RequestLevelOfDetailNotification();
+  void JoinLevelOfDetailThreads();
+  static void LevelOfDetailComputedCallback(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
+
+  /// Show the levels of detail instead of the models during interactive renders
+  void ObserveRenderer();
+  bool IsInteractiveRender();
+  static void OnRendererStart(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
+  static void OnRendererEnd(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
+
 public:
   vtkMRMLModelDisplayableManager* External;
 
   std::map<std::string, vtkProp3D*>                DisplayedActors;
   std::map<std::string, vtkMRMLDisplayNode*>       DisplayedNodes;
+  /// 0: not clipped, 1: clipped by a filter, ClippedOnGPU: clipped by the mapper clipping planes
   std::map<std::string, int>                       DisplayedClipState;
   std::map<std::string, vtkMRMLDisplayableNode*>   DisplayableNodes;
   std::map<std::string, int>                       RegisteredModelHierarchies;
@@ -123,6 +187,11 @@ public:
   int                     ClippingMethod;
   bool                    ClippingOn;
 
+  /// Active slice planes shared by the mappers of models clipped on the GPU.
+  /// A new collection is created when the active planes change.
+  vtkSmartPointer<vtkPlaneCollection> ClippingPlanes;
+  static constexpr int ClippedOnGPU = 2;
+
   bool IsUpdatingModelsFromMRML;
 
   vtkSmartPointer<vtkWorldPointPicker> WorldPointPicker;
@@ -139,6 +208,64 @@ public:
   // Used for caching the node pointer so that we do not have to search in the scene each time.
   // We do not add an observer therefore we can let the selection node deleted without our knowledge.
   vtkWeakPointer<vtkMRMLSelectionNode> SelectionNode;
+
+  // Batch rendering
+  struct ModelBatch
+    {
+    vtkSmartPointer<vtkActor> Actor;
+    vtkSmartPointer<vtkCompositePolyDataMapper2> Mapper;
+    vtkSmartPointer<vtkMultiBlockDataSet> Blocks;
+    vtkSmartPointer<vtkCompositeDataDisplayAttributes> Attributes;
+    };
+  struct BatchedModel
+    {
+    std::string BatchKey;
+    // Keeps the model actor alive while it is not in the renderer
+    vtkSmartPointer<vtkActor> Actor;
+    // Applies the user matrix of the model actor
+    vtkSmartPointer<vtkTransformPolyDataFilter> Transformer;
+    vtkSmartPointer<vtkPolyData> Block;
+    };
+  std::map<std::string, ModelBatch>    Batches; // batch key -> batch
+  std::map<std::string, BatchedModel>  BatchedModels; // display node ID -> model
+  std::set<std::string>                ModifiedBatches;
+
+  // Levels of detail
+  /// Decimated version of a large model, rendered instead of the model during interaction
+  struct LevelOfDetailModel
+    {
+    vtkSmartPointer<vtkActor> Actor;
+    vtkWeakPointer<vtkActor> ModelActor;
+    /// Visibility of the model actor set from the display node
+    bool Visible{false};
+    /// Mesh the decimated mesh is computed from
+    vtkWeakPointer<vtkPolyData> Mesh;
+    vtkMTimeType MeshMTime{0};
+    vtkSmartPointer<vtkPolyData> Decimated;
+    };
+  /// Decimation of a copy of a mesh on a worker thread.
+  /// Only Completed and Output are written by the worker thread.
+  struct LevelOfDetailComputation
+    {
+    std::string DisplayNodeID;
+    vtkWeakPointer<vtkPolyData> Mesh;
+    vtkMTimeType MeshMTime{0};
+    vtkSmartPointer<vtkPolyData> Input;
+    double TargetReduction{0.0};
+    std::thread Thread;
+    std::atomic<bool> Completed{false};
+    vtkSmartPointer<vtkPolyData> Output;
+    };
+  std::map<std::string, LevelOfDetailModel>  LevelOfDetailModels; // display node ID -> level of detail
+  /// Elements are not moved, as they are accessed by the worker threads
+  std::list<LevelOfDetailComputation>         LevelOfDetailComputations;
+  vtkNew<vtkObject>                           LevelOfDetailNotifier;
+  vtkNew<vtkCallbackCommand>                  LevelOfDetailCallbackCommand;
+  std::atomic<bool>                           NotificationRequested{false};
+
+  vtkWeakPointer<vtkRenderer>  ObservedRenderer;
+  vtkNew<vtkCallbackCommand>   RendererStartCallback;
+  vtkNew<vtkCallbackCommand>   RendererEndCallback;
 };
 
 //---------------------------------------------------------------------------
@@ -162,10 +289,29 @@ vtkMRMLModelDisplayableManager::vtkInternal::vtkInternal(vtkMRMLModelDisplayable
   this->ResetPick();
 
   this->IsUpdatingModelsFromMRML = false;
+
+  this->LevelOfDetailCallbackCommand->SetClientData(this);
+  this->LevelOfDetailCallbackCommand->SetCallback(vtkInternal::LevelOfDetailComputedCallback);
+  this->LevelOfDetailNotifier->AddObserver(vtkCommand::ModifiedEvent, this->LevelOfDetailCallbackCommand);
+  this->RendererStartCallback->SetClientData(this);
+  this->RendererStartCallback->SetCallback(vtkInternal::OnRendererStart);
+  this->RendererEndCallback->SetClientData(this);
+  this->RendererEndCallback->SetCallback(vtkInternal::OnRendererEnd);
 }
 
 //---------------------------------------------------------------------------
-vtkMRMLModelDisplayableManager::vtkInternal::~vtkInternal() = default;
+vtkMRMLModelDisplayableManager::vtkInternal::~vtkInternal()
+{
+  this->JoinLevelOfDetailThreads();
+  // The notifier may still be in the modified queue of the application
+  this->LevelOfDetailNotifier->RemoveObserver(this->LevelOfDetailCallbackCommand);
+  this->LevelOfDetailCallbackCommand->SetClientData(nullptr);
+  if (this->ObservedRenderer)
+    {
+    this->ObservedRenderer->RemoveObserver(this->RendererStartCallback);
+    this->ObservedRenderer->RemoveObserver(this->RendererEndCallback);
+    }
+}
 
 //---------------------------------------------------------------------------
 void vtkMRMLModelDisplayableManager::vtkInternal::CreateClipSlices()
@@ -185,6 +331,53 @@ void vtkMRMLModelDisplayableManager::vtkInternal::CreateClipSlices()
   this->ClippingMethod = vtkMRMLClipModelsNode::Straight;
 
   this->ClippingOn = false;
+
+  this->ClippingPlanes = vtkSmartPointer<vtkPlaneCollection>::New();
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLModelDisplayableManager::vtkInternal::IsGPUClippingApplicable()
+{
+  if (!this->External->GPUClipping || this->ClippingMethod != vtkMRMLClipModelsNode::Straight)
+    {
+    return false;
+    }
+  // Mapper clipping planes keep the intersection of the positive half-spaces,
+  // which matches the union of the implicit functions. The intersection of the
+  // implicit functions keeps points on the positive side of any plane.
+  return this->ClipType == vtkMRMLClipModelsNode::ClipUnion
+    || this->ClippingPlanes->GetNumberOfItems() <= 1;
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLModelDisplayableManager::vtkInternal::HasModelsClippedByFilter()
+{
+  for (std::pair<const std::string, int>& clipState : this->DisplayedClipState)
+    {
+    if (clipState.second == 1)
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::UpdateClippingPlanes()
+{
+  this->ClippingPlanes = vtkSmartPointer<vtkPlaneCollection>::New();
+  if (this->RedSliceClipState != vtkMRMLClipModelsNode::ClipOff)
+    {
+    this->ClippingPlanes->AddItem(this->RedSlicePlane);
+    }
+  if (this->GreenSliceClipState != vtkMRMLClipModelsNode::ClipOff)
+    {
+    this->ClippingPlanes->AddItem(this->GreenSlicePlane);
+    }
+  if (this->YellowSliceClipState != vtkMRMLClipModelsNode::ClipOff)
+    {
+    this->ClippingPlanes->AddItem(this->YellowSlicePlane);
+    }
 }
 
 //---------------------------------------------------------------------------
@@ -220,6 +413,8 @@ void vtkMRMLModelDisplayableManager::vtkInternal::FindPickedDisplayNodeFromMesh(
         }
       }
     }
+  // Transformed blocks of batched models
+  this->PickedDisplayNodeID = this->GetBatchedDisplayNodeID(mesh);
 }
 //
 //---------------------------------------------------------------------------
@@ -320,9 +515,502 @@ void vtkMRMLModelDisplayableManager::vtkInternal::FindFirstPickedDisplayNodeFrom
         return; // Display node found
         }
       }
+    // Batch actors render several models, only the picked block is known
+    for (std::pair<const std::string, ModelBatch>& batch : this->Batches)
+      {
+      if (pickedProp == batch.second.Actor.GetPointer())
+        {
+        this->PickedDisplayNodeID = this->GetBatchedDisplayNodeID(this->CellPicker->GetDataSet());
+        if (!this->PickedDisplayNodeID.empty())
+          {
+          return; // Display node found
+          }
+        }
+      }
+    }
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLModelDisplayableManager::vtkInternal::IsBatchable(const std::string& displayNodeID, vtkActor* actor)
+{
+  if (!this->External->BatchRendering || !actor)
+    {
+    return false;
+    }
+  vtkPolyDataMapper* mapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
+  if (!mapper || mapper->GetScalarVisibility() || actor->GetTexture())
+    {
+    return false;
+    }
+  std::map<std::string, int>::iterator clipIt = this->DisplayedClipState.find(displayNodeID);
+  if (clipIt == this->DisplayedClipState.end() || clipIt->second)
+    {
+    return false;
+    }
+  mapper->Update();
+  vtkPolyData* polyData = mapper->GetInput();
+  return polyData && polyData->GetNumberOfCells() > 0
+    && polyData->GetNumberOfCells() <= this->External->BatchRenderingMaximumNumberOfCells;
+}
+
+//---------------------------------------------------------------------------
+std::string vtkMRMLModelDisplayableManager::vtkInternal::GetBatchKey(vtkProperty* property)
+{
+  // Color and opacity are set per block
+  std::stringstream key;
+  key << property->GetRepresentation() << " " << property->GetPointSize() << " " << property->GetLineWidth()
+    << " " << property->GetLighting() << " " << property->GetInterpolation() << " " << property->GetShading()
+    << " " << property->GetFrontfaceCulling() << " " << property->GetBackfaceCulling()
+    << " " << property->GetAmbient() << " " << property->GetDiffuse() << " " << property->GetSpecular()
+    << " " << property->GetSpecularPower() << " " << property->GetMetallic() << " " << property->GetRoughness()
+    << " " << property->GetEdgeVisibility();
+  if (property->GetEdgeVisibility())
+    {
+    double* edgeColor = property->GetEdgeColor();
+    key << " " << edgeColor[0] << " " << edgeColor[1] << " " << edgeColor[2];
+    }
+  return key.str();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::UpdateBatchedModel(const std::string& displayNodeID, vtkActor* actor)
+{
+  if (!this->IsBatchable(displayNodeID, actor))
+    {
+    this->RemoveBatchedModel(displayNodeID, true);
+    return;
+    }
+
+  std::string batchKey = vtkInternal::GetBatchKey(actor->GetProperty());
+  std::map<std::string, BatchedModel>::iterator modelIt = this->BatchedModels.find(displayNodeID);
+  if (modelIt == this->BatchedModels.end())
+    {
+    modelIt = this->BatchedModels.insert(std::make_pair(displayNodeID, BatchedModel())).first;
+    modelIt->second.Actor = actor;
+    this->External->GetRenderer()->RemoveViewProp(actor);
+    }
+  else if (modelIt->second.BatchKey != batchKey)
+    {
+    this->ModifiedBatches.insert(modelIt->second.BatchKey);
+    }
+  BatchedModel& model = modelIt->second;
+  model.BatchKey = batchKey;
+  this->ModifiedBatches.insert(batchKey);
+
+  vtkPolyData* polyData = vtkPolyDataMapper::SafeDownCast(actor->GetMapper())->GetInput();
+  vtkMatrix4x4* userMatrix = actor->GetUserMatrix();
+  if (!userMatrix || userMatrix->IsIdentity())
+    {
+    model.Transformer = nullptr;
+    model.Block = polyData;
+    return;
+    }
+  if (!model.Transformer)
+    {
+    model.Transformer = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
+    vtkNew<vtkTransform> newTransform;
+    model.Transformer->SetTransform(newTransform);
+    }
+  vtkTransform* transform = vtkTransform::SafeDownCast(model.Transformer->GetTransform());
+  // Only modify the transform if the matrix changed to avoid transforming the points again
+  bool matrixChanged = false;
+  for (int i = 0; i < 4 && !matrixChanged; i++)
+    {
+    for (int j = 0; j < 4; j++)
+      {
+      if (transform->GetMatrix()->GetElement(i, j) != userMatrix->GetElement(i, j))
+        {
+        matrixChanged = true;
+        break;
+        }
+      }
+    }
+  if (matrixChanged)
+    {
+    transform->SetMatrix(userMatrix);
+    }
+  model.Transformer->SetInputData(polyData);
+  model.Transformer->Update();
+  model.Block = model.Transformer->GetOutput();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::RemoveBatchedModel(const std::string& displayNodeID, bool restoreActor)
+{
+  std::map<std::string, BatchedModel>::iterator modelIt = this->BatchedModels.find(displayNodeID);
+  if (modelIt == this->BatchedModels.end())
+    {
+    return;
+    }
+  this->ModifiedBatches.insert(modelIt->second.BatchKey);
+  if (restoreActor && this->External->GetRenderer())
+    {
+    this->External->GetRenderer()->AddViewProp(modelIt->second.Actor);
+    }
+  this->BatchedModels.erase(modelIt);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::UpdateBatches()
+{
+  if (this->ModifiedBatches.empty())
+    {
+    return;
+    }
+  std::map<std::string, std::vector<BatchedModel*>> modelsInBatches;
+  for (std::pair<const std::string, BatchedModel>& model : this->BatchedModels)
+    {
+    if (this->ModifiedBatches.count(model.second.BatchKey))
+      {
+      modelsInBatches[model.second.BatchKey].push_back(&model.second);
+      }
+    }
+  for (const std::string& batchKey : this->ModifiedBatches)
+    {
+    std::map<std::string, ModelBatch>::iterator batchIt = this->Batches.find(batchKey);
+    std::vector<BatchedModel*>& models = modelsInBatches[batchKey];
+    if (models.empty())
+      {
+      if (batchIt != this->Batches.end())
+        {
+        this->External->GetRenderer()->RemoveViewProp(batchIt->second.Actor);
+        this->Batches.erase(batchIt);
+        }
+      continue;
+      }
+    if (batchIt == this->Batches.end())
+      {
+      ModelBatch newBatch;
+      newBatch.Actor = vtkSmartPointer<vtkActor>::New();
+      newBatch.Mapper = vtkSmartPointer<vtkCompositePolyDataMapper2>::New();
+      newBatch.Blocks = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+      newBatch.Attributes = vtkSmartPointer<vtkCompositeDataDisplayAttributes>::New();
+      newBatch.Mapper->SetInputDataObject(newBatch.Blocks);
+      newBatch.Mapper->SetCompositeDataDisplayAttributes(newBatch.Attributes);
+      newBatch.Mapper->ScalarVisibilityOff();
+      newBatch.Actor->SetMapper(newBatch.Mapper);
+      batchIt = this->Batches.insert(std::make_pair(batchKey, newBatch)).first;
+      this->External->GetRenderer()->AddViewProp(newBatch.Actor);
+      }
+    ModelBatch& batch = batchIt->second;
+    batch.Actor->GetProperty()->DeepCopy(models[0]->Actor->GetProperty());
+    batch.Attributes->RemoveBlockVisibilities();
+    batch.Attributes->RemoveBlockColors();
+    batch.Attributes->RemoveBlockOpacities();
+    batch.Attributes->RemoveBlockPickabilities();
+    batch.Blocks->Initialize();
+    batch.Blocks->SetNumberOfBlocks(static_cast<unsigned int>(models.size()));
+    for (unsigned int blockIndex = 0; blockIndex < models.size(); ++blockIndex)
+      {
+      BatchedModel* model = models[blockIndex];
+      vtkProperty* modelProperties = model->Actor->GetProperty();
+      batch.Blocks->SetBlock(blockIndex, model->Block);
+      batch.Attributes->SetBlockVisibility(model->Block, model->Actor->GetVisibility());
+      batch.Attributes->SetBlockColor(model->Block, modelProperties->GetColor());
+      batch.Attributes->SetBlockOpacity(model->Block, modelProperties->GetOpacity());
+      batch.Attributes->SetBlockPickability(model->Block, model->Actor->GetPickable());
+      }
+    batch.Attributes->Modified();
+    batch.Blocks->Modified();
+    }
+  this->ModifiedBatches.clear();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::ClearBatches()
+{
+  if (this->External->GetRenderer())
+    {
+    for (std::pair<const std::string, ModelBatch>& batch : this->Batches)
+      {
+      this->External->GetRenderer()->RemoveViewProp(batch.second.Actor);
+      }
+    }
+  this->Batches.clear();
+  this->BatchedModels.clear();
+  this->ModifiedBatches.clear();
+}
+
+//---------------------------------------------------------------------------
+std::string vtkMRMLModelDisplayableManager::vtkInternal::GetBatchedDisplayNodeID(vtkDataObject* block)
+{
+  if (!block)
+    {
+    return std::string();
+    }
+  for (std::pair<const std::string, BatchedModel>& model : this->BatchedModels)
+    {
+    if (model.second.Block.GetPointer() == block)
+      {
+      return model.first;
+      }
+    }
+  return std::string();
+}
+
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::UpdateLevelOfDetail(const std::string& displayNodeID, vtkActor* actor)
+{
+  vtkPolyDataMapper* mapper = actor ? vtkPolyDataMapper::SafeDownCast(actor->GetMapper()) : nullptr;
+  std::map<std::string, int>::iterator clipIt = this->DisplayedClipState.find(displayNodeID);
+  // Decimated meshes have no texture coordinates and scalars, and meshes clipped by a filter
+  // would be decimated again each time the slices move.
+  // Decimation is only done on worker threads, when they can notify the main thread.
+  bool applicable = this->External->LevelOfDetail && mapper
+    && !mapper->GetScalarVisibility() && !actor->GetTexture()
+    && (clipIt == this->DisplayedClipState.end() || clipIt->second != 1)
+    && this->BatchedModels.find(displayNodeID) == this->BatchedModels.end()
+    && vtkEventBroker::GetInstance()->GetRequestModifiedCallback() != nullptr;
+  vtkPolyData* mesh = nullptr;
+  if (applicable)
+    {
+    mapper->Update();
+    mesh = mapper->GetInput();
+    applicable = mesh && mesh->GetNumberOfPolys() >= this->External->LevelOfDetailMinimumNumberOfCells;
+    }
+  if (!applicable)
+    {
+    this->RemoveLevelOfDetail(displayNodeID);
+    return;
+    }
+
+  LevelOfDetailModel& levelOfDetail = this->LevelOfDetailModels[displayNodeID];
+  if (!levelOfDetail.Actor)
+    {
+    levelOfDetail.Actor = vtkSmartPointer<vtkActor>::New();
+    vtkNew<vtkPolyDataMapper> levelOfDetailMapper;
+    levelOfDetail.Actor->SetMapper(levelOfDetailMapper);
+    levelOfDetail.Actor->VisibilityOff();
+    levelOfDetail.Actor->PickableOff();
+    this->External->GetRenderer()->AddViewProp(levelOfDetail.Actor);
+    this->ObserveRenderer();
+    }
+  levelOfDetail.ModelActor = actor;
+  levelOfDetail.Visible = actor->GetVisibility();
+  levelOfDetail.Actor->SetProperty(actor->GetProperty());
+  levelOfDetail.Actor->SetBackfaceProperty(actor->GetBackfaceProperty());
+  levelOfDetail.Actor->SetUserMatrix(actor->GetUserMatrix());
+
+  // Same rendering settings (such as clipping planes) as the model, with the decimated mesh
+  vtkMapper* levelOfDetailMapper = levelOfDetail.Actor->GetMapper();
+  levelOfDetailMapper->ShallowCopy(mapper);
+  if (levelOfDetail.Mesh != mesh || levelOfDetail.MeshMTime != mesh->GetMTime())
+    {
+    // Cached decimated mesh is obsolete
+    levelOfDetail.Mesh = mesh;
+    levelOfDetail.MeshMTime = mesh->GetMTime();
+    levelOfDetail.Decimated = nullptr;
+    this->StartLevelOfDetailComputation(displayNodeID, mesh);
+    }
+  levelOfDetailMapper->SetInputDataObject(levelOfDetail.Decimated);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::RemoveLevelOfDetail(const std::string& displayNodeID)
+{
+  std::map<std::string, LevelOfDetailModel>::iterator levelOfDetailIt = this->LevelOfDetailModels.find(displayNodeID);
+  if (levelOfDetailIt == this->LevelOfDetailModels.end())
+    {
+    return;
+    }
+  if (this->External->GetRenderer())
+    {
+    this->External->GetRenderer()->RemoveViewProp(levelOfDetailIt->second.Actor);
+    }
+  // Computations in progress are discarded when they complete
+  this->LevelOfDetailModels.erase(levelOfDetailIt);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::ClearLevelsOfDetail()
+{
+  if (this->External->GetRenderer())
+    {
+    for (std::pair<const std::string, LevelOfDetailModel>& levelOfDetail : this->LevelOfDetailModels)
+      {
+      this->External->GetRenderer()->RemoveViewProp(levelOfDetail.second.Actor);
+      }
+    }
+  this->LevelOfDetailModels.clear();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::StartLevelOfDetailComputation(
+  const std::string& displayNodeID, vtkPolyData* mesh)
+{
+  for (const LevelOfDetailComputation& computation : this->LevelOfDetailComputations)
+    {
+    if (computation.DisplayNodeID == displayNodeID && computation.Mesh == mesh && computation.MeshMTime == mesh->GetMTime())
+      {
+      return; // already in progress
+      }
+    }
+  this->LevelOfDetailComputations.emplace_back();
+  LevelOfDetailComputation* computation = &this->LevelOfDetailComputations.back();
+  computation->DisplayNodeID = displayNodeID;
+  computation->Mesh = mesh;
+  computation->MeshMTime = mesh->GetMTime();
+  computation->TargetReduction = this->External->LevelOfDetailTargetReduction;
+  // The mesh may be modified on the main thread during the decimation
+  computation->Input = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  points->DeepCopy(mesh->GetPoints());
+  computation->Input->SetPoints(points);
+  vtkNew<vtkCellArray> polys;
+  polys->DeepCopy(mesh->GetPolys());
+  computation->Input->SetPolys(polys);
+
+  vtkInternal* internal = this;
+  computation->Thread = std::thread([internal, computation]()
+    {
+    vtkNew<vtkTriangleFilter> triangulator;
+    triangulator->SetInputData(computation->Input);
+    vtkNew<vtkQuadricDecimation> decimator;
+    decimator->SetInputConnection(triangulator->GetOutputPort());
+    decimator->SetTargetReduction(computation->TargetReduction);
+    decimator->VolumePreservationOn();
+    vtkNew<vtkPolyDataNormals> normals;
+    normals->SetInputConnection(decimator->GetOutputPort());
+    normals->SplittingOff();
+    normals->Update();
+    computation->Output = normals->GetOutput();
+    computation->Completed = true;
+    internal->RequestLevelOfDetailNotification();
+    });
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::ProcessComputedLevelsOfDetail()
+{
+  this->NotificationRequested = false;
+  for (auto computationIt = this->LevelOfDetailComputations.begin(); computationIt != this->LevelOfDetailComputations.end();)
+    {
+    if (!computationIt->Completed)
+      {
+      ++computationIt;
+      continue;
+      }
+    computationIt->Thread.join();
+    // The decimated mesh is discarded if the model was removed or its mesh modified during the computation
+    std::map<std::string, LevelOfDetailModel>::iterator levelOfDetailIt =
+      this->LevelOfDetailModels.find(computationIt->DisplayNodeID);
+    if (levelOfDetailIt != this->LevelOfDetailModels.end()
+      && computationIt->Mesh && levelOfDetailIt->second.Mesh == computationIt->Mesh
+      && levelOfDetailIt->second.MeshMTime == computationIt->MeshMTime
+      && computationIt->Mesh->GetMTime() == computationIt->MeshMTime)
+      {
+      levelOfDetailIt->second.Decimated = computationIt->Output;
+      levelOfDetailIt->second.Actor->GetMapper()->SetInputDataObject(computationIt->Output);
+      }
+    computationIt = this->LevelOfDetailComputations.erase(computationIt);
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::RequestLevelOfDetailNotification()
+{
+  // Notify the main thread once for all the meshes decimated until it processes the notification
+  if (!this->NotificationRequested.exchange(true))
+    {
+    if (!vtkEventBroker::GetInstance()->RequestModified(this->LevelOfDetailNotifier))
+      {
+      this->NotificationRequested = false;
+      }
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::JoinLevelOfDetailThreads()
+{
+  for (LevelOfDetailComputation& computation : this->LevelOfDetailComputations)
+    {
+    if (computation.Thread.joinable())
+      {
+      computation.Thread.join();
+      }
     }
+  this->LevelOfDetailComputations.clear();
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::LevelOfDetailComputedCallback(
+  vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
+{
+  vtkInternal* self = reinterpret_cast<vtkInternal*>(clientData);
+  if (!self)
+    {
+    return;
+    }
+  self->ProcessComputedLevelsOfDetail();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::ObserveRenderer()
+{
+  vtkRenderer* renderer = this->External->GetRenderer();
+  if (!renderer || this->ObservedRenderer == renderer)
+    {
+    return;
+    }
+  if (this->ObservedRenderer)
+    {
+    this->ObservedRenderer->RemoveObserver(this->RendererStartCallback);
+    this->ObservedRenderer->RemoveObserver(this->RendererEndCallback);
+    }
+  renderer->AddObserver(vtkCommand::StartEvent, this->RendererStartCallback);
+  renderer->AddObserver(vtkCommand::EndEvent, this->RendererEndCallback);
+  this->ObservedRenderer = renderer;
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLModelDisplayableManager::vtkInternal::IsInteractiveRender()
+{
+  // Interactor styles increase the desired update rate of the render window during interaction,
+  // and render a still frame when the interaction ends
+  vtkRenderWindow* renderWindow = this->External->GetRenderer() ? this->External->GetRenderer()->GetRenderWindow() : nullptr;
+  vtkRenderWindowInteractor* renderWindowInteractor = renderWindow ? renderWindow->GetInteractor() : nullptr;
+  if (!renderWindowInteractor)
+    {
+    return false;
+    }
+  return renderWindow->GetDesiredUpdateRate() > renderWindowInteractor->GetStillUpdateRate();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::OnRendererStart(
+  vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
+{
+  vtkInternal* self = reinterpret_cast<vtkInternal*>(clientData);
+  bool interactive = self->IsInteractiveRender();
+  for (std::pair<const std::string, LevelOfDetailModel>& item : self->LevelOfDetailModels)
+    {
+    LevelOfDetailModel& levelOfDetail = item.second;
+    bool useLevelOfDetail = interactive && levelOfDetail.Decimated && levelOfDetail.ModelActor;
+    if (levelOfDetail.ModelActor)
+      {
+      levelOfDetail.ModelActor->SetVisibility(levelOfDetail.Visible && !useLevelOfDetail);
+      }
+    levelOfDetail.Actor->SetVisibility(levelOfDetail.Visible && useLevelOfDetail);
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::vtkInternal::OnRendererEnd(
+  vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
+{
+  vtkInternal* self = reinterpret_cast<vtkInternal*>(clientData);
+  // Model actors keep the visibility of their display node outside of rendering
+  for (std::pair<const std::string, LevelOfDetailModel>& item : self->LevelOfDetailModels)
+    {
+    LevelOfDetailModel& levelOfDetail = item.second;
+    if (levelOfDetail.ModelActor)
+      {
+      levelOfDetail.ModelActor->SetVisibility(levelOfDetail.Visible);
+      }
+    levelOfDetail.Actor->VisibilityOff();
+    }
+}
 
 //---------------------------------------------------------------------------
 // vtkMRMLModelDisplayableManager methods
@@ -381,6 +1069,58 @@ void vtkMRMLModelDisplayableManager::PrintSelf ( ostream& os, vtkIndent indent )
       << this->Internal->PickedRAS[1] << ", "<< this->Internal->PickedRAS[2] << ")\n";
   os << indent << "PickedCellID = " << this->Internal->PickedCellID << "\n";
   os << indent << "PickedPointID = " << this->Internal->PickedPointID << "\n";
+
+  os << indent << "GPUClipping = " << (this->GPUClipping ? "true" : "false") << "\n";
+  os << indent << "BatchRendering = " << (this->BatchRendering ? "true" : "false") << "\n";
+  os << indent << "BatchRenderingMaximumNumberOfCells = " << this->BatchRenderingMaximumNumberOfCells << "\n";
+  os << indent << "NumberOfBatches = " << this->Internal->Batches.size() << "\n";
+  os << indent << "NumberOfBatchedModels = " << this->Internal->BatchedModels.size() << "\n";
+  os << indent << "LevelOfDetail = " << (this->LevelOfDetail ? "true" : "false") << "\n";
+  os << indent << "LevelOfDetailMinimumNumberOfCells = " << this->LevelOfDetailMinimumNumberOfCells << "\n";
+  os << indent << "LevelOfDetailTargetReduction = " << this->LevelOfDetailTargetReduction << "\n";
+  os << indent << "NumberOfLevelsOfDetail = " << this->Internal->LevelOfDetailModels.size() << "\n";
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::SetGPUClipping(bool enable)
+{
+  if (this->GPUClipping == enable)
+    {
+    return;
+    }
+  this->GPUClipping = enable;
+  this->Modified();
+  // Clipped models are rebuilt with or without clipping filters
+  this->SetUpdateFromMRMLRequested(true);
+  this->RequestRender();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::SetLevelOfDetail(bool enable)
+{
+  if (this->LevelOfDetail == enable)
+    {
+    return;
+    }
+  this->LevelOfDetail = enable;
+  this->Modified();
+  // Levels of detail are added or removed when the display properties of the models are updated
+  this->SetUpdateFromMRMLRequested(true);
+  this->RequestRender();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLModelDisplayableManager::SetBatchRendering(bool enable)
+{
+  if (this->BatchRendering == enable)
+    {
+    return;
+    }
+  this->BatchRendering = enable;
+  this->Modified();
+  // Models are moved in or out of the batches when their display properties are updated
+  this->SetUpdateFromMRMLRequested(true);
+  this->RequestRender();
 }
 
 //---------------------------------------------------------------------------
@@ -538,6 +1278,11 @@ int vtkMRMLModelDisplayableManager::UpdateClipSlicesFromMRML()
     this->Internal->ClippingMethod = this->Internal->ClipModelsNode->GetClippingMethod();
     }
 
+  if (modifiedState)
+    {
+    this->Internal->UpdateClippingPlanes();
+    }
+
   // compute clipping on/off
   if (this->Internal->ClipModelsNode->GetRedSliceClipState() == vtkMRMLClipModelsNode::ClipOff &&
       this->Internal->ClipModelsNode->GetGreenSliceClipState() == vtkMRMLClipModelsNode::ClipOff &&
@@ -651,11 +1396,12 @@ void vtkMRMLModelDisplayableManager::ProcessMRMLNodesEvents(vtkObject *caller,
     bool requestRender = true;
     if (event == vtkCommand::ModifiedEvent)
       {
-      if (this->UpdateClipSlicesFromMRML() || this->Internal->ClippingOn)
+      // Models clipped on the GPU share the slice planes, they just need to be rendered
+      if (this->UpdateClipSlicesFromMRML() || this->Internal->HasModelsClippedByFilter())
         {
         this->SetUpdateFromMRMLRequested(true);
         }
-      else
+      else if (!this->Internal->ClippingOn)
         {
         requestRender = vtkMRMLSliceNode::SafeDownCast(caller)->GetSliceVisible() == 1;
         }
@@ -970,6 +1716,7 @@ void vtkMRMLModelDisplayableManager::UpdateModelsFromMRML()
     {
     this->UpdateModifiedModel(model);
     }
+  this->Internal->UpdateBatches();
   this->Internal->IsUpdatingModelsFromMRML = false;
 }
 
@@ -1082,6 +1829,9 @@ void vtkMRMLModelDisplayableManager::UpdateModelMesh(vtkMRMLDisplayableNode *dis
 
     vtkMRMLModelNode::MeshTypeHint meshType = modelNode ? modelNode->GetMeshType() : vtkMRMLModelNode::PolyDataMeshType;
 
+    bool gpuClipping = this->Internal->ClippingOn && modelDisplayNode != nullptr && clipping
+      && this->Internal->IsGPUClippingApplicable();
+
     std::map<std::string, vtkProp3D *>::iterator ait;
     ait = this->Internal->DisplayedActors.find(displayNode->GetID());
     if (ait == this->Internal->DisplayedActors.end() )
@@ -1099,7 +1849,8 @@ void vtkMRMLModelDisplayableManager::UpdateModelMesh(vtkMRMLDisplayableNode *dis
         {
         cit = this->Internal->DisplayedClipState.find(modelDisplayNode->GetID());
         }
-      if (cit != this->Internal->DisplayedClipState.end() && cit->second == clipping )
+      bool clippedOnGPU = (cit != this->Internal->DisplayedClipState.end() && cit->second == vtkInternal::ClippedOnGPU);
+      if (cit != this->Internal->DisplayedClipState.end() && (cit->second == clipping || (clippedOnGPU && gpuClipping)))
         {
         // make sure that we are looking at the current mesh (most of the code in here
         // assumes a display node will never change what mesh it wants to view and hence
@@ -1114,7 +1865,7 @@ void vtkMRMLModelDisplayableManager::UpdateModelMesh(vtkMRMLDisplayableNode *dis
             {
             mapper->SetInputConnection(transformFilter->GetOutputPort());
             }
-          else if (mapper && !(this->Internal->ClippingOn && clipping))
+          else if (mapper && (!(this->Internal->ClippingOn && clipping) || clippedOnGPU))
             {
             mapper->SetInputConnection(meshConnection);
             }
@@ -1125,9 +1876,9 @@ void vtkMRMLModelDisplayableManager::UpdateModelMesh(vtkMRMLDisplayableNode *dis
             }
           }
         vtkMRMLTransformNode* tnode = displayableNode->GetParentTransformNode();
-        // clipped model could be transformed
+        // clipped model could be transformed, clipping planes of the mapper are in world coordinates
         // TODO: handle non-linear transforms
-        if ((clipping == 0 || tnode == nullptr || !tnode->IsTransformToWorldLinear()) && !mapperUpdateNeeded)
+        if ((clipping == 0 || clippedOnGPU || tnode == nullptr || !tnode->IsTransformToWorldLinear()) && !mapperUpdateNeeded)
           {
           continue;
           }
@@ -1138,7 +1889,7 @@ void vtkMRMLModelDisplayableManager::UpdateModelMesh(vtkMRMLDisplayableNode *dis
     vtkAlgorithm *clipper = nullptr;
     if(actor)
       {
-      if (this->Internal->ClippingOn && modelDisplayNode != nullptr && clipping)
+      if (this->Internal->ClippingOn && modelDisplayNode != nullptr && clipping && !gpuClipping)
         {
         clipper = this->CreateTransformedClipper(modelNode->GetParentTransformNode(), meshType);
         }
@@ -1168,6 +1919,9 @@ void vtkMRMLModelDisplayableManager::UpdateModelMesh(vtkMRMLDisplayableNode *dis
         mapper->SetInputConnection(meshConnection);
         }
 
+      // Clipping planes are applied in the shaders, the mesh does not need to be clipped again when they move
+      mapper->SetClippingPlanes(gpuClipping ? this->Internal->ClippingPlanes.GetPointer() : nullptr);
+
       actor->SetMapper(mapper);
       mapper->Delete();
       }
@@ -1185,7 +1939,7 @@ void vtkMRMLModelDisplayableManager::UpdateModelMesh(vtkMRMLDisplayableNode *dis
         }
       else
         {
-        this->Internal->DisplayedClipState[modelDisplayNode->GetID()] = 0;
+        this->Internal->DisplayedClipState[modelDisplayNode->GetID()] = gpuClipping ? vtkInternal::ClippedOnGPU : 0;
         }
       prop->Delete();
       }
@@ -1202,7 +1956,7 @@ void vtkMRMLModelDisplayableManager::UpdateModelMesh(vtkMRMLDisplayableNode *dis
         }
       else
         {
-        this->Internal->DisplayedClipState[modelDisplayNode->GetID()] = 0;
+        this->Internal->DisplayedClipState[modelDisplayNode->GetID()] = gpuClipping ? vtkInternal::ClippedOnGPU : 0;
         }
       }
     }
@@ -1270,7 +2024,19 @@ void vtkMRMLModelDisplayableManager::RemoveModelProps()
       else
         {
 
-        if (clipIter->second  || (this->Internal->ClippingOn && clipIter->second != clipModel))
+        bool clippingChanged = this->Internal->ClippingOn && (clipIter->second != 0) != (clipModel != 0);
+        if (clipIter->second == vtkInternal::ClippedOnGPU)
+          {
+          // Models clipped on the GPU are kept while they use the current clipping planes
+          vtkActor* actor = vtkActor::SafeDownCast(iter->second);
+          clippingChanged = clippingChanged || !this->Internal->ClippingOn || !this->Internal->IsGPUClippingApplicable()
+            || !actor || !actor->GetMapper() || actor->GetMapper()->GetClippingPlanes() != this->Internal->ClippingPlanes;
+          }
+        else if (clipIter->second)
+          {
+          clippingChanged = true;
+          }
+        if (clippingChanged)
           {
           this->GetRenderer()->RemoveViewProp(iter->second);
           removedIDs.push_back(iter->first);
@@ -1282,6 +2048,7 @@ void vtkMRMLModelDisplayableManager::RemoveModelProps()
     {
     this->RemoveDisplayedID(removedIDs[i]);
     }
+  this->Internal->UpdateBatches();
 }
 
 //---------------------------------------------------------------------------
@@ -1313,6 +2080,7 @@ void vtkMRMLModelDisplayableManager::RemoveDisplayable(vtkMRMLDisplayableNode* m
     {
     this->RemoveDisplayedID(removedIDs[i]);
     }
+  this->Internal->UpdateBatches();
   this->RemoveDisplayableNodeObservers(model);
   this->Internal->DisplayableNodes.erase(model->GetID());
 }
@@ -1321,6 +2089,8 @@ void vtkMRMLModelDisplayableManager::RemoveDisplayable(vtkMRMLDisplayableNode* m
 void vtkMRMLModelDisplayableManager::RemoveDisplayedID(std::string &id)
 {
   std::map<std::string, vtkMRMLDisplayNode *>::iterator modelIter;
+  this->Internal->RemoveBatchedModel(id, false);
+  this->Internal->RemoveLevelOfDetail(id);
   this->Internal->DisplayedActors.erase(id);
   this->Internal->DisplayedClipState.erase(id);
   modelIter = this->Internal->DisplayedNodes.find(id);
@@ -1371,6 +2141,8 @@ void vtkMRMLModelDisplayableManager::RemoveModelObservers(int clearCache)
   if (clearCache)
     {
     this->Internal->DisplayableNodes.clear();
+    this->Internal->ClearBatches();
+    this->Internal->ClearLevelsOfDetail();
     this->Internal->DisplayedActors.clear();
     this->Internal->DisplayedNodes.clear();
     this->Internal->DisplayedClipState.clear();
@@ -1604,6 +2376,14 @@ void vtkMRMLModelDisplayableManager::SetModelDisplayProperty(vtkMRMLDisplayableN
       imageActor->GetMapper()->SetInputConnection(displayNode->GetTextureImageDataConnection());
       imageActor->SetDisplayExtent(-1, 0, 0, 0, 0, 0);
       }
+
+    this->Internal->UpdateBatchedModel(modelDisplayNode->GetID(), actor);
+    this->Internal->UpdateLevelOfDetail(modelDisplayNode->GetID(), actor);
+    }
+  // Batches are rebuilt once at the end of UpdateModelsFromMRML
+  if (!this->Internal->IsUpdatingModelsFromMRML)
+    {
+    this->Internal->UpdateBatches();
     }
 }
 
@@ -85,6 +85,61 @@ public:
   /// Set tolerance for Pick() method. It will call vtkCellPicker.SetTolerance()
   void SetPickTolerance(double tolerance);
 
+  /// Clip models to the slice planes with the clipping planes of the mappers,
+  /// which are applied in the shaders so slice plane changes do not rebuild
+  /// the clipped meshes. Only applies to the straight clipping method, with
+  /// the union clip type or a single clipping slice; other settings use
+  /// clipping filters.
+  /// Disable it to clip the meshes with filters, when the clipped geometry
+  /// must be available as the input of the mappers (e.g. to export the scene).
+  /// Enabled by default.
+  void SetGPUClipping(bool enable);
+  vtkGetMacro(GPUClipping, bool);
+  vtkBooleanMacro(GPUClipping, bool);
+
+  /// Render a decimated version of large models during camera interaction,
+  /// like vtkLODProp3D. The decimated meshes are computed by vtkQuadricDecimation
+  /// on worker threads, when the application can process notifications from
+  /// them, and are kept until the mesh of the model is modified.
+  /// Models with visible scalars, texture or clipping filters, and models with
+  /// less than LevelOfDetailMinimumNumberOfCells polygons are always rendered
+  /// with their full mesh.
+  /// Enabled by default.
+  void SetLevelOfDetail(bool enable);
+  vtkGetMacro(LevelOfDetail, bool);
+  vtkBooleanMacro(LevelOfDetail, bool);
+
+  /// Minimum number of polygons of a model to compute a level of detail.
+  /// Default is 1000000.
+  /// Takes effect at the next update of the models.
+  vtkSetClampMacro(LevelOfDetailMinimumNumberOfCells, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(LevelOfDetailMinimumNumberOfCells, vtkIdType);
+
+  /// Fraction of the triangles removed by the decimation. Default is 0.9.
+  /// Takes effect for the meshes decimated afterward.
+  vtkSetClampMacro(LevelOfDetailTargetReduction, double, 0.0, 0.99);
+  vtkGetMacro(LevelOfDetailTargetReduction, double);
+
+  /// Render compatible models with one composite mapper per group of models
+  /// having the same display properties except color, opacity, visibility,
+  /// pickability and linear transform, to reduce the number of draw calls in
+  /// scenes with many small models.
+  /// Models with visible scalars, texture or clipping, unstructured grids and
+  /// models with more than BatchRenderingMaximumNumberOfCells cells are still
+  /// rendered by their own actor. Actors returned by GetActorByID() for batched
+  /// models are not in the renderer. Backface color offset is not applied on
+  /// batched models.
+  /// Disabled by default.
+  void SetBatchRendering(bool enable);
+  vtkGetMacro(BatchRendering, bool);
+  vtkBooleanMacro(BatchRendering, bool);
+
+  /// Maximum number of cells of a model to be rendered in a batch.
+  /// Larger models gain nothing from batching. Default is 100000.
+  /// Takes effect at the next update of the models.
+  vtkSetClampMacro(BatchRenderingMaximumNumberOfCells, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(BatchRenderingMaximumNumberOfCells, vtkIdType);
+
   /// Get the MRML ID of the picked node, returns empty string if no pick
   const char* GetPickedNodeID() override;
 
@@ -164,6 +219,13 @@ protected:
 
   void RemoveDisplayedID(std::string &id);
 
+  bool GPUClipping{true};
+  bool LevelOfDetail{true};
+  vtkIdType LevelOfDetailMinimumNumberOfCells{1000000};
+  double LevelOfDetailTargetReduction{0.9};
+  bool BatchRendering{false};
+  vtkIdType BatchRenderingMaximumNumberOfCells{100000};
+
 protected:
   vtkMRMLModelDisplayableManager();
   ~vtkMRMLModelDisplayableManager() override;
@@ -38,19 +38,26 @@
 #include <vtkActor2D.h>
 #include <vtkAlgorithmOutput.h>
 #include <vtkCallbackCommand.h>
+#include <vtkCellData.h>
 #include <vtkColorTransferFunction.h>
 #include <vtkDataSetSurfaceFilter.h>
 #include <vtkEventBroker.h>
 #include <vtkGeneralTransform.h>
+#include <vtkIdList.h>
 #include <vtkLookupTable.h>
+#include <vtkMath.h>
 #include <vtkMatrix4x4.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPlane.h>
+#include <vtkPointData.h>
 #include <vtkPointLocator.h>
+#include <vtkPolyData.h>
 #include <vtkPolyDataMapper2D.h>
 #include <vtkProperty2D.h>
 #include <vtkRenderer.h>
+#include <vtkSMPThreadLocalObject.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkTransform.h>
 #include <vtkTransformFilter.h>
@@ -65,8 +72,166 @@
 // STD includes
 #include <algorithm>
 #include <cassert>
+#include <memory>
+#include <numeric>
 #include <set>
 #include <map>
+#include <vector>
+
+namespace
+{
+
+/// Meshes with fewer cells are cut without the slice intersection index
+const vtkIdType SLICE_INTERSECTION_INDEX_MINIMUM_NUMBER_OF_CELLS = 10000;
+
+//---------------------------------------------------------------------------
+/// Returns true if the box intersects or touches the plane.
+bool BoundsIntersectPlane(const double bounds[6], vtkPlane* plane)
+{
+  bool below = false;
+  bool above = false;
+  for (int corner = 0; corner < 8; corner++)
+    {
+    double point[3] = { bounds[corner & 1], bounds[2 + ((corner >> 1) & 1)], bounds[4 + ((corner >> 2) & 1)] };
+    double distance = plane->EvaluateFunction(point);
+    below = below || distance <= 0.0;
+    above = above || distance >= 0.0;
+    }
+  return below && above;
+}
+
+//---------------------------------------------------------------------------
+/// Interval of the cells of a mesh along the slice normal, sorted by the start of the interval.
+/// The index is built once for a mesh and a slice orientation, then it gives the cells that
+/// may intersect the slice for any slice offset, so that only these cells are cut.
+class SliceIntersectionIndex
+{
+public:
+  /// Set to Candidates the cells of the mesh that intersect or touch the plane.
+  /// The index is rebuilt if the mesh or the orientation of the plane changed.
+  void UpdateCandidates(vtkPolyData* mesh, vtkPlane* plane);
+
+  /// Cells of the mesh that may intersect the plane, sharing the points of the mesh
+  vtkNew<vtkPolyData> Candidates;
+
+protected:
+  void Build(vtkPolyData* mesh, const double normal[3]);
+
+  vtkWeakPointer<vtkPolyData> Mesh;
+  vtkMTimeType MeshMTime{0};
+  double Normal[3] = { 0.0, 0.0, 0.0 };
+  /// Cell IDs sorted by the start of their interval
+  std::vector<vtkIdType> SortedCellIds;
+  std::vector<double> SortedCellMinimum;
+  /// End of the interval of each cell, indexed by cell ID
+  std::vector<double> CellMaximum;
+  double MaximumCellLength{0.0};
+};
+
+//---------------------------------------------------------------------------
+void SliceIntersectionIndex::Build(vtkPolyData* mesh, const double normal[3])
+{
+  vtkIdType numberOfCells = mesh->GetNumberOfCells();
+  std::vector<double> cellMinimum(numberOfCells);
+  this->CellMaximum.resize(numberOfCells);
+  if (mesh->NeedToBuildCells())
+    {
+    mesh->BuildCells();
+    }
+  vtkPoints* points = mesh->GetPoints();
+  vtkSMPThreadLocalObject<vtkIdList> localPointIds;
+  vtkSMPTools::For(0, numberOfCells, [&](vtkIdType begin, vtkIdType end)
+    {
+    vtkIdList* pointIdList = localPointIds.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+      vtkIdType numberOfCellPoints = 0;
+      const vtkIdType* cellPointIds = nullptr;
+      mesh->GetCellPoints(cellId, numberOfCellPoints, cellPointIds, pointIdList);
+      double minimum = VTK_DOUBLE_MAX;
+      double maximum = -VTK_DOUBLE_MAX;
+      for (vtkIdType i = 0; i < numberOfCellPoints; ++i)
+        {
+        double point[3];
+        points->GetPoint(cellPointIds[i], point);
+        double position = vtkMath::Dot(point, normal);
+        minimum = std::min(minimum, position);
+        maximum = std::max(maximum, position);
+        }
+      cellMinimum[cellId] = minimum;
+      this->CellMaximum[cellId] = maximum;
+      }
+    });
+
+  this->MaximumCellLength = 0.0;
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+    {
+    if (cellMinimum[cellId] <= this->CellMaximum[cellId])
+      {
+      this->MaximumCellLength = std::max(this->MaximumCellLength, this->CellMaximum[cellId] - cellMinimum[cellId]);
+      }
+    }
+
+  this->SortedCellIds.resize(numberOfCells);
+  std::iota(this->SortedCellIds.begin(), this->SortedCellIds.end(), 0);
+  vtkSMPTools::Sort(this->SortedCellIds.begin(), this->SortedCellIds.end(),
+    [&cellMinimum](vtkIdType cellId1, vtkIdType cellId2) { return cellMinimum[cellId1] < cellMinimum[cellId2]; });
+  this->SortedCellMinimum.resize(numberOfCells);
+  for (vtkIdType i = 0; i < numberOfCells; ++i)
+    {
+    this->SortedCellMinimum[i] = cellMinimum[this->SortedCellIds[i]];
+    }
+
+  this->Mesh = mesh;
+  this->MeshMTime = mesh->GetMTime();
+  for (int i = 0; i < 3; ++i)
+    {
+    this->Normal[i] = normal[i];
+    }
+}
+
+//---------------------------------------------------------------------------
+void SliceIntersectionIndex::UpdateCandidates(vtkPolyData* mesh, vtkPlane* plane)
+{
+  double normal[3];
+  plane->GetNormal(normal);
+  vtkMath::Normalize(normal);
+  if (mesh != this->Mesh || mesh->GetMTime() != this->MeshMTime
+    || vtkMath::Dot(normal, this->Normal) < 1.0 - 1e-12)
+    {
+    this->Build(mesh, normal);
+    }
+  double offset = vtkMath::Dot(plane->GetOrigin(), normal);
+
+  // Cells that start after the plane or end before the plane cannot intersect it
+  std::vector<double>::iterator firstIt = std::lower_bound(
+    this->SortedCellMinimum.begin(), this->SortedCellMinimum.end(), offset - this->MaximumCellLength);
+  std::vector<double>::iterator lastIt = std::upper_bound(firstIt, this->SortedCellMinimum.end(), offset);
+
+  this->Candidates->Initialize();
+  this->Candidates->SetPoints(mesh->GetPoints());
+  this->Candidates->GetPointData()->PassData(mesh->GetPointData());
+  vtkCellData* cellData = mesh->GetCellData();
+  vtkCellData* candidateCellData = this->Candidates->GetCellData();
+  candidateCellData->CopyAllocate(cellData, static_cast<vtkIdType>(lastIt - firstIt));
+  this->Candidates->AllocateEstimate(static_cast<vtkIdType>(lastIt - firstIt), 3);
+  vtkNew<vtkIdList> pointIdList;
+  for (std::vector<double>::iterator it = firstIt; it != lastIt; ++it)
+    {
+    vtkIdType cellId = this->SortedCellIds[it - this->SortedCellMinimum.begin()];
+    if (this->CellMaximum[cellId] < offset)
+      {
+      continue;
+      }
+    vtkIdType numberOfCellPoints = 0;
+    const vtkIdType* cellPointIds = nullptr;
+    mesh->GetCellPoints(cellId, numberOfCellPoints, cellPointIds, pointIdList);
+    vtkIdType candidateId = this->Candidates->InsertNextCell(mesh->GetCellType(cellId), numberOfCellPoints, cellPointIds);
+    candidateCellData->CopyData(cellData, cellId, candidateId);
+    }
+}
+
+} // end of anonymous namespace
 
 //---------------------------------------------------------------------------
 vtkStandardNewMacro(vtkMRMLModelSliceDisplayableManager );
@@ -87,6 +252,8 @@ public:
     vtkSmartPointer<vtkGeometryFilter> GeometryFilter;
     vtkSmartPointer<vtkSampleImplicitFunctionFilter> SliceDistance;
     vtkSmartPointer<vtkProp> Actor;
+    /// Cells of large surface meshes that straddle the slice plane
+    std::unique_ptr<SliceIntersectionIndex> IntersectionIndex;
     };
 
   typedef std::map < vtkMRMLDisplayNode*, const Pipeline* > PipelinesCacheType;
@@ -319,6 +486,7 @@ void vtkMRMLModelSliceDisplayableManager::vtkInternal
   pipeline->ModelWarper = vtkSmartPointer<vtkTransformFilter>::New();
   pipeline->SurfaceExtractor = vtkSmartPointer<vtkDataSetSurfaceFilter>::New();
   pipeline->Plane = vtkSmartPointer<vtkPlane>::New();
+  pipeline->IntersectionIndex.reset(new SliceIntersectionIndex);
 
   // Set up pipeline
   pipeline->Transformer->SetTransform(pipeline->TransformToSlice);
@@ -474,7 +642,31 @@ void vtkMRMLModelSliceDisplayableManager::vtkInternal
     // show intersection in the slice view
     // include clipper in the pipeline
     pipeline->Transformer->SetInputConnection(pipeline->GeometryFilter->GetOutputPort());
-    pipeline->Cutter->SetInputConnection(pipeline->ModelWarper->GetOutputPort());
+
+    // Models that are entirely on one side of the slice have no intersection
+    pipeline->ModelWarper->Update();
+    vtkPointSet* worldMesh = vtkPointSet::SafeDownCast(pipeline->ModelWarper->GetOutputDataObject(0));
+    if (!worldMesh || !BoundsIntersectPlane(worldMesh->GetBounds(), pipeline->Plane))
+      {
+      pipeline->Actor->SetVisibility(false);
+      return;
+      }
+    // Only cut the cells that straddle the slice plane in large surface meshes
+    vtkPolyData* worldPolyData = vtkPolyData::SafeDownCast(worldMesh);
+    if (worldPolyData && worldPolyData->GetNumberOfCells() >= SLICE_INTERSECTION_INDEX_MINIMUM_NUMBER_OF_CELLS)
+      {
+      pipeline->IntersectionIndex->UpdateCandidates(worldPolyData, pipeline->Plane);
+      if (pipeline->IntersectionIndex->Candidates->GetNumberOfCells() == 0)
+        {
+        pipeline->Actor->SetVisibility(false);
+        return;
+        }
+      pipeline->Cutter->SetInputData(pipeline->IntersectionIndex->Candidates);
+      }
+    else
+      {
+      pipeline->Cutter->SetInputConnection(pipeline->ModelWarper->GetOutputPort());
+      }
 
     // If there is no input or if the input has no points, the vtkTransformPolyDataFilter will display an error message
     // on every update: "No input data".
@@ -1322,8 +1322,22 @@ class vtkMRMLSliceIntersectionInteractionRepresentation::vtkInternal
 
     std::deque<SliceIntersectionInteractionDisplayPipeline*> SliceIntersectionInteractionDisplayPipelines;
     vtkNew<vtkCallbackCommand> SliceNodeModifiedCommand;
+
+    /// Result of the last ComputeSliceIntersectionPoint() call.
+    double ComputedSliceIntersectionPoint[3] = { 0.0, 0.0, 0.0 };
+    bool ComputedSliceIntersectionPointFound = false;
+    /// If enabled then UpdateSliceIntersectionDisplay() uses ComputedSliceIntersectionPoint
+    /// instead of computing the slice intersection point again for each pipeline.
+    bool UseComputedSliceIntersectionPoint = false;
 };
 
+namespace
+{
+/// Slice intersection point changes smaller than this (in pixels) do not require
+/// updating all the slice intersection display pipelines.
+const double SLICE_INTERSECTION_POINT_TOLERANCE_PIXELS = 1e-3;
+}
+
 //---------------------------------------------------------------------------
 // vtkInternal methods
 
@@ -1426,8 +1440,67 @@ void vtkMRMLSliceIntersectionInteractionRepresentation::SliceNodeModifiedCallbac
     return;
     }
 
-  // One of the intersecting slices are modified, update all slice intersections
-  self->SliceNodeModified(self->Internal->SliceNode);
+  // One of the intersecting slices are modified
+  SliceIntersectionInteractionDisplayPipeline* pipeline =
+    self->GetDisplayPipelineFromSliceLogic(vtkMRMLSliceLogic::SafeDownCast(caller));
+  if (!pipeline)
+    {
+    // update all slice intersections
+    self->SliceNodeModified(self->Internal->SliceNode);
+    return;
+    }
+  self->IntersectingSliceModified(pipeline);
+}
+
+//----------------------------------------------------------------------
+void vtkMRMLSliceIntersectionInteractionRepresentation::IntersectingSliceModified(SliceIntersectionInteractionDisplayPipeline* pipeline)
+{
+  // Only the modified slice's intersection needs to be updated, unless the change moves the
+  // common slice intersection point (which determines line gaps and handle positions of all intersections).
+  double previousSliceIntersectionPoint[3] = { this->Internal->ComputedSliceIntersectionPoint[0],
+    this->Internal->ComputedSliceIntersectionPoint[1], this->Internal->ComputedSliceIntersectionPoint[2] };
+  bool previousSliceIntersectionPointFound = this->Internal->ComputedSliceIntersectionPointFound;
+
+  this->UpdateSliceIntersectionDisplay(pipeline);
+  this->ComputeSliceIntersectionPoint();
+
+  if (this->Internal->ComputedSliceIntersectionPointFound != previousSliceIntersectionPointFound
+    || vtkMath::Distance2BetweenPoints(this->Internal->ComputedSliceIntersectionPoint, previousSliceIntersectionPoint)
+      > SLICE_INTERSECTION_POINT_TOLERANCE_PIXELS * SLICE_INTERSECTION_POINT_TOLERANCE_PIXELS)
+    {
+    this->SliceNodeModified(this->Internal->SliceNode);
+    return;
+    }
+  this->UpdatePipelinesHandlesVisibility();
+}
+
+//----------------------------------------------------------------------
+void vtkMRMLSliceIntersectionInteractionRepresentation::UpdateAllSliceIntersectionDisplays()
+{
+  // Compute the slice intersection point once and use it for all the pipelines
+  this->ComputeSliceIntersectionPoint();
+  this->Internal->UseComputedSliceIntersectionPoint = true;
+  for (std::deque<SliceIntersectionInteractionDisplayPipeline*>::iterator
+    sliceIntersectionIt = this->Internal->SliceIntersectionInteractionDisplayPipelines.begin();
+    sliceIntersectionIt != this->Internal->SliceIntersectionInteractionDisplayPipelines.end(); ++sliceIntersectionIt)
+    {
+    this->UpdateSliceIntersectionDisplay(*sliceIntersectionIt);
+    }
+  this->Internal->UseComputedSliceIntersectionPoint = false;
+}
+
+//----------------------------------------------------------------------
+void vtkMRMLSliceIntersectionInteractionRepresentation::UpdatePipelinesHandlesVisibility()
+{
+  bool handlesVisible = false;
+  vtkMRMLSliceDisplayNode* displayNode = this->GetSliceDisplayNode();
+  if (displayNode)
+    {
+    int componentType = displayNode->GetActiveComponentType();
+    handlesVisible = componentType != vtkMRMLSliceDisplayNode::ComponentNone
+      && componentType != vtkMRMLSliceDisplayNode::ComponentSliceIntersection; // hide handles during interaction:
+    }
+  this->SetPipelinesHandlesVisibility(handlesVisible);
 }
 
 //----------------------------------------------------------------------
@@ -1440,21 +1513,20 @@ void vtkMRMLSliceIntersectionInteractionRepresentation::SliceNodeModified(vtkMRM
   if (sliceNode == this->Internal->SliceNode)
     {
     // update all slice intersection
-    for (std::deque<SliceIntersectionInteractionDisplayPipeline*>::iterator
-      sliceIntersectionIt = this->Internal->SliceIntersectionInteractionDisplayPipelines.begin();
-      sliceIntersectionIt != this->Internal->SliceIntersectionInteractionDisplayPipelines.end(); ++sliceIntersectionIt)
+    this->UpdateAllSliceIntersectionDisplays();
+    double sliceIntersectionPoint[3] = { this->Internal->ComputedSliceIntersectionPoint[0],
+      this->Internal->ComputedSliceIntersectionPoint[1], this->Internal->ComputedSliceIntersectionPoint[2] };
+    bool sliceIntersectionPointFound = this->Internal->ComputedSliceIntersectionPointFound;
+    this->ComputeSliceIntersectionPoint();
+    if (this->Internal->ComputedSliceIntersectionPointFound != sliceIntersectionPointFound
+      || vtkMath::Distance2BetweenPoints(this->Internal->ComputedSliceIntersectionPoint, sliceIntersectionPoint)
+        > SLICE_INTERSECTION_POINT_TOLERANCE_PIXELS * SLICE_INTERSECTION_POINT_TOLERANCE_PIXELS)
       {
-      this->UpdateSliceIntersectionDisplay(*sliceIntersectionIt);
+      // Intersection lines have moved, which moved the slice intersection point,
+      // update once more so that all intersections use the new point.
+      this->UpdateAllSliceIntersectionDisplays();
       }
-    bool handlesVisible = false;
-    vtkMRMLSliceDisplayNode* displayNode = this->GetSliceDisplayNode();
-    if (displayNode)
-      {
-      int componentType = displayNode->GetActiveComponentType();
-      handlesVisible = componentType != vtkMRMLSliceDisplayNode::ComponentNone
-        && componentType != vtkMRMLSliceDisplayNode::ComponentSliceIntersection; // hide handles during interaction:
-      }
-    this->SetPipelinesHandlesVisibility(handlesVisible);
+    this->UpdatePipelinesHandlesVisibility();
     }
 }
 
@@ -1545,7 +1617,18 @@ void vtkMRMLSliceIntersectionInteractionRepresentation::UpdateSliceIntersectionD
   vtkMatrix4x4::Invert(xyToRAS, rasToXY);
 
   // Get slice intersection point XY
-  this->ComputeSliceIntersectionPoint();
+  if (this->Internal->UseComputedSliceIntersectionPoint)
+    {
+    // already computed for all pipelines, just restore it (it may have been overwritten by the previous pipeline)
+    this->SliceIntersectionPoint[0] = this->Internal->ComputedSliceIntersectionPoint[0];
+    this->SliceIntersectionPoint[1] = this->Internal->ComputedSliceIntersectionPoint[1];
+    this->SliceIntersectionPoint[2] = this->Internal->ComputedSliceIntersectionPoint[2];
+    this->SliceIntersectionPointFound = this->Internal->ComputedSliceIntersectionPointFound;
+    }
+  else
+    {
+    this->ComputeSliceIntersectionPoint();
+    }
   double sliceIntersectionPoint[4] = { this->SliceIntersectionPoint[0], this->SliceIntersectionPoint[1], this->SliceIntersectionPoint[2], 1 };
 
   // Get outer intersection line tips
@@ -2448,11 +2531,15 @@ void vtkMRMLSliceIntersectionInteractionRepresentation::ComputeSliceIntersection
   int numberOfFoundIntersectionPoints = 0;
   if (!this->Internal->SliceNode)
     {
+    this->Internal->ComputedSliceIntersectionPoint[0] = 0.0;
+    this->Internal->ComputedSliceIntersectionPoint[1] = 0.0;
+    this->Internal->ComputedSliceIntersectionPoint[2] = 0.0;
+    this->Internal->ComputedSliceIntersectionPointFound = false;
     return;
     }
 
   // Get intersection point
-  for (size_t slice1Index = 0; slice1Index < numberOfIntersections - 1; slice1Index++)
+  for (size_t slice1Index = 0; slice1Index + 1 < numberOfIntersections; slice1Index++)
     {
     if (!this->Internal->SliceIntersectionInteractionDisplayPipelines[slice1Index]->GetVisibility())
       {
@@ -2536,6 +2623,10 @@ void vtkMRMLSliceIntersectionInteractionRepresentation::ComputeSliceIntersection
     this->SliceIntersectionPoint[1] = sliceDimension[1] / 2.0;
     this->SliceIntersectionPoint[2] = 0.0;
     }
+  this->Internal->ComputedSliceIntersectionPoint[0] = this->SliceIntersectionPoint[0];
+  this->Internal->ComputedSliceIntersectionPoint[1] = this->SliceIntersectionPoint[1];
+  this->Internal->ComputedSliceIntersectionPoint[2] = this->SliceIntersectionPoint[2];
+  this->Internal->ComputedSliceIntersectionPointFound = this->SliceIntersectionPointFound;
 }
 //----------------------------------------------------------------------
 double* vtkMRMLSliceIntersectionInteractionRepresentation::GetSliceIntersectionPoint()
@@ -158,6 +158,13 @@ class VTK_MRML_DISPLAYABLEMANAGER_EXPORT vtkMRMLSliceIntersectionInteractionRepr
 
     static void SliceNodeModifiedCallback(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
     void SliceNodeModified(vtkMRMLSliceNode* sliceNode);
+    /// Update display of a single intersecting slice. All intersections are only updated
+    /// if the slice intersection point is moved.
+    void IntersectingSliceModified(SliceIntersectionInteractionDisplayPipeline* pipeline);
+    /// Update display of all intersecting slices, using a slice intersection point that is computed once.
+    void UpdateAllSliceIntersectionDisplays();
+    /// Show handles unless the user is interacting with the slice intersection.
+    void UpdatePipelinesHandlesVisibility();
     void SliceModelDisplayNodeModified(vtkMRMLModelDisplayNode* sliceNode);
 
     void UpdateSliceIntersectionDisplay(SliceIntersectionInteractionDisplayPipeline* pipeline);
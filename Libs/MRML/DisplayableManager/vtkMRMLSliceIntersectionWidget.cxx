@@ -457,10 +457,13 @@ bool vtkMRMLSliceIntersectionWidget::ProcessInteractionEvent(vtkMRMLInteractionE
     case WidgetEventTranslateStart:
       this->SetWidgetState(WidgetStateTranslate);
       this->SliceLogic->GetMRMLScene()->SaveStateForUndo();
+      // the slices are moved to the mouse position, see ProcessMouseMove()
+      this->SliceLogic->StartSliceNodeInteraction(vtkMRMLSliceNode::SliceToRASFlag);
       processedEvent = this->ProcessStartMouseDrag(eventData);
       break;
     case WidgetEventTranslateEnd:
       processedEvent = this->ProcessEndMouseDrag(eventData);
+      this->SliceLogic->EndSliceNodeInteraction();
       break;
     case WidgetEventRotateIntersectingSlicesStart:
       this->SliceLogic->GetMRMLScene()->SaveStateForUndo();
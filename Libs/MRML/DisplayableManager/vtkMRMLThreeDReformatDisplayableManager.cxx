@@ -83,6 +83,10 @@ public:
 
   SliceNodesLink                                SliceNodes;
   vtkMRMLThreeDReformatDisplayableManager*      External;
+  /// Slice node that is being reformatted by dragging its widget.
+  /// The widget is not updated from the slice node during the interaction,
+  /// as the widget is the source of the change.
+  vtkMRMLSliceNode*                             InteractingSliceNode{nullptr};
 };
 
 //---------------------------------------------------------------------------
@@ -156,6 +160,10 @@ void vtkMRMLThreeDReformatDisplayableManager::vtkInternal
     it->second->Delete();
     }
 
+  if (it->first == this->InteractingSliceNode)
+    {
+    this->InteractingSliceNode = nullptr;
+    }
   // TODO: it->first might have already been deleted
   it->first->RemoveObserver(this->External->GetMRMLNodesCallbackCommand());
   this->SliceNodes.erase(it);
@@ -414,6 +422,13 @@ OnMRMLNodeModified(vtkMRMLNode* node)
 {
   vtkMRMLSliceNode* sliceNode = vtkMRMLSliceNode::SafeDownCast(node);
   assert(sliceNode);
+  if (sliceNode == this->Internal->InteractingSliceNode)
+    {
+    // The widget already shows the new position, placing and orienting it again
+    // for each drag event would only slow down the interaction.
+    // The widget is updated when the interaction ends.
+    return;
+    }
   vtkImplicitPlaneWidget2* planeWidget = this->Internal->GetWidget(sliceNode);
   if (this->Internal->UpdateWidget(sliceNode, planeWidget))
     {
@@ -442,12 +457,22 @@ ProcessWidgetsEvents(vtkObject *caller,
   vtkMRMLSliceLogic* sliceLogic = this->GetMRMLApplicationLogic()->GetSliceLogic(sliceNode);
   if (event == vtkCommand::StartInteractionEvent && sliceLogic )
     {
+    // Only the reslice axes are updated during the interaction. Linked slice views are
+    // updated when the interaction ends (unless hot-linked) and layers are resliced
+    // at reduced quality if progressive rendering is enabled in the slice logic.
+    this->Internal->InteractingSliceNode = sliceNode;
     sliceLogic->StartSliceNodeInteraction(vtkMRMLSliceNode::MultiplanarReformatFlag);
     return;
     }
   else if (event == vtkCommand::EndInteractionEvent && sliceLogic)
     {
+    this->Internal->InteractingSliceNode = nullptr;
     sliceLogic->EndSliceNodeInteraction();
+    // Widget was not updated from the slice node during the interaction
+    if (this->Internal->UpdateWidget(sliceNode, planeWidget))
+      {
+      this->RequestRender();
+      }
     return;
     }
   // We should listen to the interactorStyle instead when LockNormalToCamera on.
@@ -463,6 +488,18 @@ ProcessWidgetsEvents(vtkObject *caller,
                            sliceToRAS->GetElement(1,2),
                            sliceToRAS->GetElement(2,2)};
 
+  // Skip the slice update if the widget has not moved (e.g., mouse move without dragging)
+  double* planeWidgetNormal = rep->GetNormal();
+  double* planeWidgetCenter = rep->GetOrigin();
+  const double tolerance = 1e-6;
+  if (fabs(vtkMath::Dot(sliceNormal, planeWidgetNormal) - 1.0) < tolerance
+    && fabs(sliceToRAS->GetElement(0, 3) - planeWidgetCenter[0]) < tolerance
+    && fabs(sliceToRAS->GetElement(1, 3) - planeWidgetCenter[1]) < tolerance
+    && fabs(sliceToRAS->GetElement(2, 3) - planeWidgetCenter[2]) < tolerance)
+    {
+    return;
+    }
+
   // Reset current translation
   sliceToRAS->SetElement(0,3,0);
   sliceToRAS->SetElement(1,3,0);
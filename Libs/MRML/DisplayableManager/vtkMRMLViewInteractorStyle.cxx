@@ -401,7 +401,17 @@ bool vtkMRMLViewInteractorStyle::DelegateInteractionEventDataToDisplayableManage
     {
     this->FocusedDisplayableManager->GetMRMLApplicationLogic()->PauseRender();
     }
+  // Register the event time before processing, as processing may render the view immediately.
+  // The time is removed if the event is not processed, as then it does not have to be rendered.
+  double previousPendingInteractionEventTime = this->DisplayableManagers->GetPendingInteractionEventTime();
+  this->DisplayableManagers->AddInteractionEventTime(eventData->GetEventTime());
+  double pendingInteractionEventTime = this->DisplayableManagers->GetPendingInteractionEventTime();
   bool processed = this->FocusedDisplayableManager->ProcessInteractionEvent(eventData);
+  if (!processed && this->DisplayableManagers
+    && this->DisplayableManagers->GetPendingInteractionEventTime() == pendingInteractionEventTime)
+    {
+    this->DisplayableManagers->SetPendingInteractionEventTime(previousPendingInteractionEventTime);
+    }
   int cursor = VTK_CURSOR_DEFAULT;
   if (processed)
     {
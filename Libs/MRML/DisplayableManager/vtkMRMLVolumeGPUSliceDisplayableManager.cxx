@@ -0,0 +1,865 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRMLDisplayableManager includes
+#include "vtkMRMLVolumeGPUSliceDisplayableManager.h"
+
+// MRMLLogic includes
+#include <vtkMRMLApplicationLogic.h>
+#include <vtkMRMLSliceLayerLogic.h>
+#include <vtkMRMLSliceLogic.h>
+
+// MRML includes
+#include <vtkEventBroker.h>
+#include <vtkMRMLColorNode.h>
+#include <vtkMRMLLabelMapVolumeDisplayNode.h>
+#include <vtkMRMLScalarVolumeDisplayNode.h>
+#include <vtkMRMLSliceCompositeNode.h>
+#include <vtkMRMLSliceNode.h>
+#include <vtkMRMLTransformNode.h>
+#include <vtkMRMLVolumeNode.h>
+
+// VTK includes
+#include <vtkFloatArray.h>
+#include <vtkGeneralTransform.h>
+#include <vtkImageData.h>
+#include <vtkLookupTable.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkOpenGLError.h>
+#include <vtkOpenGLQuadHelper.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkOpenGLShaderCache.h>
+#include <vtkOpenGLState.h>
+#include <vtkPointData.h>
+#include <vtkProp.h>
+#include <vtkRenderer.h>
+#include <vtkShaderProgram.h>
+#include <vtkSmartPointer.h>
+#include <vtkTextureObject.h>
+#include <vtkTransform.h>
+#include <vtkWeakPointer.h>
+#include <vtk_glew.h>
+
+// STD includes
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+
+//---------------------------------------------------------------------------
+// Reslices, maps and blends the layers. Layer specific code is generated in
+// place of //VTK::GPUSlice::Dec and //VTK::GPUSlice::Impl.
+const char* GPUSliceFragmentShader =
+  "//VTK::System::Dec\n"
+  "//VTK::Output::Dec\n"
+  "\n"
+  "struct LayerParameters\n"
+  "{\n"
+  "  mat4 xyToIJK;\n"
+  "  vec3 dimensions;\n"
+  "  float valueScale;\n"
+  "  float window;\n"
+  "  float level;\n"
+  "  bool applyThreshold;\n"
+  "  float lowerThreshold;\n"
+  "  float upperThreshold;\n"
+  "  bool interpolate;\n"
+  "  int outlineThickness;\n"
+  "  int lookupTableSize;\n"
+  "  int lookupTableOffset;\n"
+  "  float opacity;\n"
+  "};\n"
+  "\n"
+  "uniform LayerParameters layers[3];\n"
+  "uniform vec2 viewportOrigin;\n"
+  "uniform vec2 viewportToXY;\n"
+  "uniform vec2 sliceDimensions;\n"
+  "\n"
+  "//VTK::GPUSlice::Dec\n"
+  "\n"
+  "float sampleVolume(sampler3D volume, LayerParameters layer, vec2 xy, bool interpolate, out bool inside)\n"
+  "{\n"
+  "  // matrices are uploaded transposed, multiply on the left\n"
+  "  vec3 ijk = (vec4(xy, 0.0, 1.0) * layer.xyToIJK).xyz;\n"
+  "  inside = all(greaterThanEqual(ijk, vec3(-0.5))) && all(lessThanEqual(ijk, layer.dimensions - vec3(0.5)));\n"
+  "  if (!inside)\n"
+  "    {\n"
+  "    return 0.0;\n"
+  "    }\n"
+  "  if (interpolate)\n"
+  "    {\n"
+  "    return texture(volume, (ijk + vec3(0.5)) / layer.dimensions).r * layer.valueScale;\n"
+  "    }\n"
+  "  ivec3 index = clamp(ivec3(floor(ijk + vec3(0.5))), ivec3(0), ivec3(layer.dimensions) - ivec3(1));\n"
+  "  return texelFetch(volume, index, 0).r * layer.valueScale;\n"
+  "}\n"
+  "\n"
+  "vec4 scalarColor(sampler3D volume, sampler2D lut, LayerParameters layer, vec2 xy)\n"
+  "{\n"
+  "  bool inside;\n"
+  "  float value = sampleVolume(volume, layer, xy, layer.interpolate, inside);\n"
+  "  if (!inside)\n"
+  "    {\n"
+  "    return vec4(0.0);\n"
+  "    }\n"
+  "  // same mapping as vtkImageMapToWindowLevelColors followed by a 0-255 lookup table\n"
+  "  float window = abs(layer.window) < 1e-12 ? 1e-12 : layer.window;\n"
+  "  float luminance = clamp(floor((value - layer.level + 0.5 * window) / window * 255.0), 0.0, 255.0);\n"
+  "  vec4 color = texelFetch(lut, ivec2(int(luminance), 0), 0);\n"
+  "  bool visible = color.a > 0.0 &&\n"
+  "    (!layer.applyThreshold || (value >= layer.lowerThreshold && value <= layer.upperThreshold));\n"
+  "  return vec4(color.rgb, visible ? 1.0 : 0.0);\n"
+  "}\n"
+  "\n"
+  "int labelValue(sampler3D volume, LayerParameters layer, vec2 xy)\n"
+  "{\n"
+  "  bool inside;\n"
+  "  return int(floor(sampleVolume(volume, layer, xy, false, inside) + 0.5));\n"
+  "}\n"
+  "\n"
+  "vec4 labelColor(sampler3D volume, sampler2D lut, LayerParameters layer, vec2 xy)\n"
+  "{\n"
+  "  int label = labelValue(volume, layer, xy);\n"
+  "  if (label != 0 && layer.outlineThickness > 0)\n"
+  "    {\n"
+  "    // same as vtkImageLabelOutline: keep the pixels next to another label\n"
+  "    bool outline = false;\n"
+  "    for (int j = -layer.outlineThickness; j <= layer.outlineThickness && !outline; ++j)\n"
+  "      {\n"
+  "      for (int i = -layer.outlineThickness; i <= layer.outlineThickness && !outline; ++i)\n"
+  "        {\n"
+  "        vec2 neighbor = xy + vec2(i, j);\n"
+  "        outline = any(lessThan(neighbor, vec2(0.0)))\n"
+  "          || any(greaterThan(neighbor, sliceDimensions - vec2(1.0)))\n"
+  "          || labelValue(volume, layer, neighbor) != label;\n"
+  "        }\n"
+  "      }\n"
+  "    if (!outline)\n"
+  "      {\n"
+  "      label = 0;\n"
+  "      }\n"
+  "    }\n"
+  "  int index = clamp(label - layer.lookupTableOffset, 0, layer.lookupTableSize - 1);\n"
+  "  return texelFetch(lut, ivec2(index, 0), 0);\n"
+  "}\n"
+  "\n"
+  "// color is premultiplied by alpha\n"
+  "vec4 blendLayer(vec4 color, vec4 layerColor, float opacity)\n"
+  "{\n"
+  "  float alpha = layerColor.a * opacity;\n"
+  "  return color * (1.0 - alpha) + vec4(layerColor.rgb * alpha, alpha);\n"
+  "}\n"
+  "\n"
+  "void main()\n"
+  "{\n"
+  "  vec2 xy = (gl_FragCoord.xy - viewportOrigin) * viewportToXY - vec2(0.5);\n"
+  "  vec4 color = vec4(0.0);\n"
+  "  //VTK::GPUSlice::Impl\n"
+  "  gl_FragData[0] = color;\n"
+  "}\n";
+
+//---------------------------------------------------------------------------
+/// Volume uploaded as a 3D texture.
+struct VolumeTexture
+{
+  vtkSmartPointer<vtkTextureObject> Texture;
+  vtkMTimeType UploadTime{0};
+  double ValueScale{1.0};
+  bool Used{false};
+};
+
+//---------------------------------------------------------------------------
+/// Lookup table uploaded as a N x 1 RGBA texture.
+struct LookupTableTexture
+{
+  vtkSmartPointer<vtkTextureObject> Texture;
+  vtkWeakPointer<vtkScalarsToColors> LookupTable;
+  vtkMTimeType UploadTime{0};
+  int Size{0};
+  int Offset{0};
+};
+
+//---------------------------------------------------------------------------
+/// Layer displayed by the shader, in blending order.
+struct GPUSliceLayer
+{
+  vtkMRMLSliceLayerLogic* Layer{nullptr};
+  double Opacity{1.0};
+  bool LabelMap{false};
+};
+
+} // end of anonymous namespace
+
+//---------------------------------------------------------------------------
+/// Prop rendering the slice logic layers in a full viewport quad.
+class vtkMRMLVolumeGPUSliceProp : public vtkProp
+{
+public:
+  static vtkMRMLVolumeGPUSliceProp* New();
+  vtkTypeMacro(vtkMRMLVolumeGPUSliceProp, vtkProp);
+
+  vtkWeakPointer<vtkMRMLSliceLogic> SliceLogic;
+
+  int RenderOpaqueGeometry(vtkViewport* viewport) override;
+  vtkTypeBool HasTranslucentPolygonalGeometry() override { return 0; }
+  void ReleaseGraphicsResources(vtkWindow* window) override;
+
+protected:
+  vtkMRMLVolumeGPUSliceProp() = default;
+  ~vtkMRMLVolumeGPUSliceProp() override = default;
+
+  std::vector<GPUSliceLayer> GetLayers();
+  bool UpdateVolumeTexture(vtkOpenGLRenderWindow* renWin, vtkImageData* imageData);
+  bool UpdateLookupTableTexture(vtkOpenGLRenderWindow* renWin, LookupTableTexture& lutTexture,
+    vtkMRMLVolumeDisplayNode* displayNode, bool labelMap);
+  bool UpdateShader(vtkOpenGLRenderWindow* renWin, const std::vector<GPUSliceLayer>& layers);
+  void SetLayerUniforms(vtkShaderProgram* program, int index, const GPUSliceLayer& layer);
+  /// Switch the slice logic back to the CPU pipeline
+  void RenderingFailed(const char* reason);
+
+  std::map<vtkImageData*, VolumeTexture> VolumeTextures;
+  LookupTableTexture LookupTableTextures[3];
+  std::unique_ptr<vtkOpenGLQuadHelper> Quad;
+  std::string ShaderKey;
+
+private:
+  vtkMRMLVolumeGPUSliceProp(const vtkMRMLVolumeGPUSliceProp&) = delete;
+  void operator=(const vtkMRMLVolumeGPUSliceProp&) = delete;
+};
+
+vtkStandardNewMacro(vtkMRMLVolumeGPUSliceProp);
+
+//---------------------------------------------------------------------------
+std::vector<GPUSliceLayer> vtkMRMLVolumeGPUSliceProp::GetLayers()
+{
+  std::vector<GPUSliceLayer> layers;
+  vtkMRMLSliceCompositeNode* compositeNode = this->SliceLogic->GetSliceCompositeNode();
+  vtkMRMLSliceLayerLogic* background = this->SliceLogic->GetBackgroundLayer();
+  vtkMRMLSliceLayerLogic* foreground = this->SliceLogic->GetForegroundLayer();
+  double foregroundOpacity = compositeNode->GetForegroundOpacity();
+  // same order as vtkMRMLSliceLogic blend pipeline
+  vtkMRMLSliceLayerLogic* orderedLayers[3] = { background, foreground, this->SliceLogic->GetLabelLayer() };
+  if (compositeNode->GetCompositing() == vtkMRMLSliceCompositeNode::ReverseAlpha)
+    {
+    orderedLayers[0] = foreground;
+    orderedLayers[1] = background;
+    }
+  double opacities[3] = { 1.0, foregroundOpacity, compositeNode->GetLabelOpacity() };
+  for (int i = 0; i < 3; ++i)
+    {
+    if (!orderedLayers[i] || !orderedLayers[i]->GetVolumeNode() || !orderedLayers[i]->GetVolumeDisplayNode())
+      {
+      continue;
+      }
+    GPUSliceLayer layer;
+    layer.Layer = orderedLayers[i];
+    layer.Opacity = opacities[i];
+    layer.LabelMap = vtkMRMLLabelMapVolumeDisplayNode::SafeDownCast(orderedLayers[i]->GetVolumeDisplayNode()) != nullptr;
+    layers.push_back(layer);
+    }
+  return layers;
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLVolumeGPUSliceProp::UpdateVolumeTexture(vtkOpenGLRenderWindow* renWin, vtkImageData* imageData)
+{
+  VolumeTexture& volumeTexture = this->VolumeTextures[imageData];
+  volumeTexture.Used = true;
+  if (volumeTexture.Texture && volumeTexture.UploadTime > imageData->GetMTime())
+    {
+    return true;
+    }
+  vtkDataArray* scalars = imageData->GetPointData()->GetScalars();
+  int* dimensions = imageData->GetDimensions();
+  GLint maximumSize = 0;
+  glGetIntegerv(GL_MAX_3D_TEXTURE_SIZE, &maximumSize);
+  if (!scalars || dimensions[0] > maximumSize || dimensions[1] > maximumSize || dimensions[2] > maximumSize)
+    {
+    return false;
+    }
+
+  // Integer types up to 16 bits are uploaded in normalized textures, others
+  // are converted to float.
+  void* data = scalars->GetVoidPointer(0);
+  int dataType = scalars->GetDataType();
+  unsigned int internalFormat = GL_R32F;
+  volumeTexture.ValueScale = 1.0;
+  vtkNew<vtkFloatArray> floatScalars;
+  switch (dataType)
+    {
+    case VTK_UNSIGNED_CHAR:
+      internalFormat = GL_R8;
+      volumeTexture.ValueScale = VTK_UNSIGNED_CHAR_MAX;
+      break;
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+      dataType = VTK_SIGNED_CHAR;
+      internalFormat = GL_R8_SNORM;
+      volumeTexture.ValueScale = VTK_SIGNED_CHAR_MAX;
+      break;
+    case VTK_UNSIGNED_SHORT:
+      internalFormat = GL_R16;
+      volumeTexture.ValueScale = VTK_UNSIGNED_SHORT_MAX;
+      break;
+    case VTK_SHORT:
+      internalFormat = GL_R16_SNORM;
+      volumeTexture.ValueScale = VTK_SHORT_MAX;
+      break;
+    case VTK_FLOAT:
+      break;
+    default:
+      floatScalars->DeepCopy(scalars);
+      data = floatScalars->GetVoidPointer(0);
+      dataType = VTK_FLOAT;
+      break;
+    }
+
+  if (!volumeTexture.Texture)
+    {
+    volumeTexture.Texture = vtkSmartPointer<vtkTextureObject>::New();
+    }
+  volumeTexture.Texture->SetContext(renWin);
+  volumeTexture.Texture->ReleaseGraphicsResources(renWin);
+  volumeTexture.Texture->SetInternalFormat(internalFormat);
+  volumeTexture.Texture->SetWrapS(vtkTextureObject::ClampToEdge);
+  volumeTexture.Texture->SetWrapT(vtkTextureObject::ClampToEdge);
+  volumeTexture.Texture->SetWrapR(vtkTextureObject::ClampToEdge);
+  volumeTexture.Texture->SetMinificationFilter(vtkTextureObject::Linear);
+  volumeTexture.Texture->SetMagnificationFilter(vtkTextureObject::Linear);
+  vtkOpenGLClearErrorMacro();
+  if (!volumeTexture.Texture->Create3DFromRaw(dimensions[0], dimensions[1], dimensions[2], 1, dataType, data)
+    || glGetError() != GL_NO_ERROR)
+    {
+    volumeTexture.Texture = nullptr;
+    return false;
+    }
+  volumeTexture.UploadTime = volumeTexture.Texture->GetMTime();
+  return true;
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLVolumeGPUSliceProp::UpdateLookupTableTexture(vtkOpenGLRenderWindow* renWin,
+  LookupTableTexture& lutTexture, vtkMRMLVolumeDisplayNode* displayNode, bool labelMap)
+{
+  vtkMRMLColorNode* colorNode = displayNode->GetColorNode();
+  vtkScalarsToColors* lookupTable = colorNode ? colorNode->GetScalarsToColors() : nullptr;
+  if (labelMap)
+    {
+    lookupTable = colorNode ? colorNode->GetLookupTable() : nullptr;
+    }
+  if (!lookupTable)
+    {
+    return false;
+    }
+  if (lutTexture.Texture && lutTexture.LookupTable == lookupTable
+    && lutTexture.UploadTime > lookupTable->GetMTime())
+    {
+    return true;
+    }
+
+  std::vector<unsigned char> colors;
+  if (labelMap)
+    {
+    // 1:1 mapping of the labels, as in vtkMRMLLabelMapVolumeDisplayNode
+    vtkLookupTable* labelLookupTable = vtkLookupTable::SafeDownCast(lookupTable);
+    int numberOfColors = labelLookupTable->GetNumberOfTableValues();
+    double* tableRange = labelLookupTable->GetTableRange();
+    lutTexture.Offset = (tableRange[1] - tableRange[0] + 1 == numberOfColors) ? static_cast<int>(tableRange[0]) : 0;
+    lutTexture.Size = numberOfColors;
+    colors.resize(4 * numberOfColors);
+    for (int i = 0; i < numberOfColors; ++i)
+      {
+      double rgba[4];
+      labelLookupTable->GetTableValue(i, rgba);
+      for (int c = 0; c < 4; ++c)
+        {
+        colors[4 * i + c] = static_cast<unsigned char>(rgba[c] * 255.0 + 0.5);
+        }
+      }
+    }
+  else
+    {
+    // Window/level maps the values to 0-255, as in vtkMRMLScalarVolumeDisplayNode
+    vtkSmartPointer<vtkScalarsToColors> scaledLookupTable = vtkSmartPointer<vtkScalarsToColors>::Take(lookupTable->NewInstance());
+    scaledLookupTable->DeepCopy(lookupTable);
+    scaledLookupTable->SetRange(0, 255);
+    lutTexture.Offset = 0;
+    lutTexture.Size = 256;
+    colors.resize(4 * 256);
+    for (int i = 0; i < 256; ++i)
+      {
+      const unsigned char* rgba = scaledLookupTable->MapValue(i);
+      std::copy(rgba, rgba + 4, colors.begin() + 4 * i);
+      }
+    }
+  if (lutTexture.Size <= 0)
+    {
+    return false;
+    }
+
+  if (!lutTexture.Texture)
+    {
+    lutTexture.Texture = vtkSmartPointer<vtkTextureObject>::New();
+    }
+  lutTexture.Texture->SetContext(renWin);
+  lutTexture.Texture->ReleaseGraphicsResources(renWin);
+  lutTexture.Texture->SetMinificationFilter(vtkTextureObject::Nearest);
+  lutTexture.Texture->SetMagnificationFilter(vtkTextureObject::Nearest);
+  vtkOpenGLClearErrorMacro();
+  if (!lutTexture.Texture->Create2DFromRaw(lutTexture.Size, 1, 4, VTK_UNSIGNED_CHAR, colors.data())
+    || glGetError() != GL_NO_ERROR)
+    {
+    lutTexture.Texture = nullptr;
+    return false;
+    }
+  lutTexture.LookupTable = lookupTable;
+  lutTexture.UploadTime = lutTexture.Texture->GetMTime();
+  return true;
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLVolumeGPUSliceProp::UpdateShader(vtkOpenGLRenderWindow* renWin, const std::vector<GPUSliceLayer>& layers)
+{
+  std::string key;
+  for (const GPUSliceLayer& layer : layers)
+    {
+    key += layer.LabelMap ? "L" : "S";
+    }
+  if (this->Quad && this->Quad->Program && key == this->ShaderKey)
+    {
+    renWin->GetShaderCache()->ReadyShaderProgram(this->Quad->Program);
+    return true;
+    }
+
+  std::stringstream declarations;
+  std::stringstream implementation;
+  for (size_t i = 0; i < layers.size(); ++i)
+    {
+    declarations << "uniform sampler3D volume" << i << ";\n"
+                 << "uniform sampler2D lut" << i << ";\n";
+    implementation << "color = blendLayer(color, "
+                   << (layers[i].LabelMap ? "labelColor" : "scalarColor")
+                   << "(volume" << i << ", lut" << i << ", layers[" << i << "], xy), layers[" << i << "].opacity);\n";
+    }
+  std::string fragmentShader = GPUSliceFragmentShader;
+  vtkShaderProgram::Substitute(fragmentShader, "//VTK::GPUSlice::Dec", declarations.str());
+  vtkShaderProgram::Substitute(fragmentShader, "//VTK::GPUSlice::Impl", implementation.str());
+
+  if (this->Quad)
+    {
+    this->Quad->ReleaseGraphicsResources(renWin);
+    }
+  this->Quad.reset(new vtkOpenGLQuadHelper(renWin, nullptr, fragmentShader.c_str(), ""));
+  this->ShaderKey = key;
+  if (!this->Quad->Program || !this->Quad->Program->GetCompiled())
+    {
+    this->Quad.reset();
+    this->ShaderKey.clear();
+    return false;
+    }
+  return true;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGPUSliceProp::SetLayerUniforms(vtkShaderProgram* program, int index, const GPUSliceLayer& layer)
+{
+  std::stringstream prefixStream;
+  prefixStream << "layers[" << index << "].";
+  std::string prefix = prefixStream.str();
+
+  vtkImageData* imageData = layer.Layer->GetVolumeNode()->GetImageData();
+  int* extent = imageData->GetExtent();
+  int* dimensions = imageData->GetDimensions();
+
+  // XY to texture IJK (relative to the first voxel of the extent)
+  vtkNew<vtkTransform> xyToIJK;
+  vtkMRMLTransformNode::IsGeneralTransformLinear(layer.Layer->GetXYToIJKTransform(), xyToIJK);
+  vtkNew<vtkMatrix4x4> xyToTextureIJK;
+  xyToTextureIJK->DeepCopy(xyToIJK->GetMatrix());
+  for (int i = 0; i < 3; ++i)
+    {
+    xyToTextureIJK->SetElement(i, 3, xyToTextureIJK->GetElement(i, 3) - extent[2 * i]);
+    }
+  program->SetUniformMatrix((prefix + "xyToIJK").c_str(), xyToTextureIJK);
+  float textureDimensions[3] = { static_cast<float>(dimensions[0]),
+    static_cast<float>(dimensions[1]), static_cast<float>(dimensions[2]) };
+  program->SetUniform3f((prefix + "dimensions").c_str(), textureDimensions);
+  program->SetUniformf((prefix + "valueScale").c_str(), this->VolumeTextures[imageData].ValueScale);
+  program->SetUniformf((prefix + "opacity").c_str(), layer.Opacity);
+
+  vtkMRMLScalarVolumeDisplayNode* scalarDisplayNode = vtkMRMLScalarVolumeDisplayNode::SafeDownCast(layer.Layer->GetVolumeDisplayNode());
+  vtkMRMLLabelMapVolumeDisplayNode* labelMapDisplayNode = vtkMRMLLabelMapVolumeDisplayNode::SafeDownCast(layer.Layer->GetVolumeDisplayNode());
+  if (scalarDisplayNode)
+    {
+    program->SetUniformf((prefix + "window").c_str(), scalarDisplayNode->GetWindow());
+    program->SetUniformf((prefix + "level").c_str(), scalarDisplayNode->GetLevel());
+    program->SetUniformi((prefix + "applyThreshold").c_str(), scalarDisplayNode->GetApplyThreshold());
+    program->SetUniformf((prefix + "lowerThreshold").c_str(), scalarDisplayNode->GetLowerThreshold());
+    program->SetUniformf((prefix + "upperThreshold").c_str(), scalarDisplayNode->GetUpperThreshold());
+    // cubic interpolation of the CPU pipeline is approximated by linear interpolation
+    program->SetUniformi((prefix + "interpolate").c_str(), scalarDisplayNode->GetInterpolate() != 0);
+    }
+  int outlineThickness = 0;
+  if (labelMapDisplayNode && layer.Layer->GetIsLabelLayer()
+    && this->SliceLogic->GetSliceNode()->GetUseLabelOutline())
+    {
+    outlineThickness = labelMapDisplayNode->GetSliceIntersectionThickness();
+    }
+  program->SetUniformi((prefix + "outlineThickness").c_str(), outlineThickness);
+  program->SetUniformi((prefix + "lookupTableSize").c_str(), this->LookupTableTextures[index].Size);
+  program->SetUniformi((prefix + "lookupTableOffset").c_str(), this->LookupTableTextures[index].Offset);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGPUSliceProp::RenderingFailed(const char* reason)
+{
+  vtkWarningMacro("RenderingFailed: " << reason << ". Slice is rendered on the CPU.");
+  if (this->SliceLogic)
+    {
+    this->SliceLogic->SetGPURenderingSupported(false);
+    }
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLVolumeGPUSliceProp::RenderOpaqueGeometry(vtkViewport* viewport)
+{
+  vtkRenderer* renderer = vtkRenderer::SafeDownCast(viewport);
+  vtkOpenGLRenderWindow* renWin = renderer ? vtkOpenGLRenderWindow::SafeDownCast(renderer->GetRenderWindow()) : nullptr;
+  if (!renWin || !this->SliceLogic || !this->SliceLogic->IsGPURenderingActive())
+    {
+    return 0;
+    }
+  std::vector<GPUSliceLayer> layers = this->GetLayers();
+  if (layers.empty())
+    {
+    return 0;
+    }
+
+  for (auto& volumeTexture : this->VolumeTextures)
+    {
+    volumeTexture.second.Used = false;
+    }
+  for (size_t i = 0; i < layers.size(); ++i)
+    {
+    if (!this->UpdateVolumeTexture(renWin, layers[i].Layer->GetVolumeNode()->GetImageData()))
+      {
+      this->RenderingFailed("cannot upload volume as 3D texture");
+      return 0;
+      }
+    if (!this->UpdateLookupTableTexture(renWin, this->LookupTableTextures[i],
+      layers[i].Layer->GetVolumeDisplayNode(), layers[i].LabelMap))
+      {
+      this->RenderingFailed("cannot upload lookup table");
+      return 0;
+      }
+    }
+  // Free the memory of the volumes that are not displayed anymore
+  for (auto it = this->VolumeTextures.begin(); it != this->VolumeTextures.end();)
+    {
+    if (!it->second.Used)
+      {
+      if (it->second.Texture)
+        {
+        it->second.Texture->ReleaseGraphicsResources(renWin);
+        }
+      it = this->VolumeTextures.erase(it);
+      }
+    else
+      {
+      ++it;
+      }
+    }
+
+  if (!this->UpdateShader(renWin, layers))
+    {
+    this->RenderingFailed("cannot compile slice shader");
+    return 0;
+    }
+  vtkShaderProgram* program = this->Quad->Program;
+
+  int width = 0;
+  int height = 0;
+  int origin[2] = { 0, 0 };
+  renderer->GetTiledSizeAndOrigin(&width, &height, &origin[0], &origin[1]);
+  int* sliceDimensions = this->SliceLogic->GetSliceNode()->GetDimensions();
+  float viewportOrigin[2] = { static_cast<float>(origin[0]), static_cast<float>(origin[1]) };
+  float viewportToXY[2] = {
+    static_cast<float>(sliceDimensions[0]) / std::max(width, 1),
+    static_cast<float>(sliceDimensions[1]) / std::max(height, 1) };
+  float sliceDimensionsXY[2] = { static_cast<float>(sliceDimensions[0]), static_cast<float>(sliceDimensions[1]) };
+  program->SetUniform2f("viewportOrigin", viewportOrigin);
+  program->SetUniform2f("viewportToXY", viewportToXY);
+  program->SetUniform2f("sliceDimensions", sliceDimensionsXY);
+
+  std::vector<vtkTextureObject*> activeTextures;
+  for (size_t i = 0; i < layers.size(); ++i)
+    {
+    vtkImageData* imageData = layers[i].Layer->GetVolumeNode()->GetImageData();
+    vtkTextureObject* volumeTexture = this->VolumeTextures[imageData].Texture;
+    vtkTextureObject* lutTexture = this->LookupTableTextures[i].Texture;
+    volumeTexture->Activate();
+    lutTexture->Activate();
+    activeTextures.push_back(volumeTexture);
+    activeTextures.push_back(lutTexture);
+    std::stringstream volumeName;
+    volumeName << "volume" << i;
+    program->SetUniformi(volumeName.str().c_str(), volumeTexture->GetTextureUnit());
+    std::stringstream lutName;
+    lutName << "lut" << i;
+    program->SetUniformi(lutName.str().c_str(), lutTexture->GetTextureUnit());
+    this->SetLayerUniforms(program, static_cast<int>(i), layers[i]);
+    }
+
+  // Draw behind everything else, blending with the background where there is no layer
+  vtkOpenGLState* state = renWin->GetState();
+  vtkOpenGLState::ScopedglEnableDisable depthTestSaver(state, GL_DEPTH_TEST);
+  vtkOpenGLState::ScopedglDepthMask depthMaskSaver(state);
+  vtkOpenGLState::ScopedglEnableDisable blendSaver(state, GL_BLEND);
+  vtkOpenGLState::ScopedglBlendFuncSeparate blendFuncSaver(state);
+  state->vtkglDisable(GL_DEPTH_TEST);
+  state->vtkglDepthMask(GL_FALSE);
+  state->vtkglEnable(GL_BLEND);
+  state->vtkglBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+  this->Quad->Render();
+
+  for (vtkTextureObject* texture : activeTextures)
+    {
+    texture->Deactivate();
+    }
+  return 1;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGPUSliceProp::ReleaseGraphicsResources(vtkWindow* window)
+{
+  for (auto& volumeTexture : this->VolumeTextures)
+    {
+    if (volumeTexture.second.Texture)
+      {
+      volumeTexture.second.Texture->ReleaseGraphicsResources(window);
+      }
+    }
+  this->VolumeTextures.clear();
+  for (LookupTableTexture& lutTexture : this->LookupTableTextures)
+    {
+    if (lutTexture.Texture)
+      {
+      lutTexture.Texture->ReleaseGraphicsResources(window);
+      }
+    lutTexture = LookupTableTexture();
+    }
+  if (this->Quad)
+    {
+    this->Quad->ReleaseGraphicsResources(window);
+    this->Quad.reset();
+    }
+  this->ShaderKey.clear();
+}
+
+//---------------------------------------------------------------------------
+vtkStandardNewMacro(vtkMRMLVolumeGPUSliceDisplayableManager);
+
+//---------------------------------------------------------------------------
+class vtkMRMLVolumeGPUSliceDisplayableManager::vtkInternal
+{
+public:
+  vtkInternal(vtkMRMLVolumeGPUSliceDisplayableManager* external);
+  ~vtkInternal();
+
+  void UpdateSliceLogic();
+  void SetSliceLogic(vtkMRMLSliceLogic* sliceLogic);
+  void ObserveLayers();
+  void UpdateProp();
+
+  vtkMRMLVolumeGPUSliceDisplayableManager* External;
+  vtkWeakPointer<vtkMRMLSliceLogic> SliceLogic;
+  std::vector<vtkWeakPointer<vtkMRMLSliceLayerLogic> > ObservedLayers;
+  vtkNew<vtkMRMLVolumeGPUSliceProp> Prop;
+  bool PropAdded;
+};
+
+//---------------------------------------------------------------------------
+// vtkInternal methods
+
+//---------------------------------------------------------------------------
+vtkMRMLVolumeGPUSliceDisplayableManager::vtkInternal
+::vtkInternal(vtkMRMLVolumeGPUSliceDisplayableManager* external)
+{
+  this->External = external;
+  this->PropAdded = false;
+}
+
+//---------------------------------------------------------------------------
+vtkMRMLVolumeGPUSliceDisplayableManager::vtkInternal::~vtkInternal()
+{
+  this->SetSliceLogic(nullptr);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGPUSliceDisplayableManager::vtkInternal::UpdateSliceLogic()
+{
+  vtkMRMLApplicationLogic* appLogic = this->External->GetMRMLApplicationLogic();
+  vtkMRMLSliceNode* sliceNode = this->External->GetMRMLSliceNode();
+  this->SetSliceLogic(appLogic && sliceNode ? appLogic->GetSliceLogic(sliceNode) : nullptr);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGPUSliceDisplayableManager::vtkInternal::SetSliceLogic(vtkMRMLSliceLogic* sliceLogic)
+{
+  if (this->SliceLogic == sliceLogic)
+    {
+    return;
+    }
+  vtkEventBroker* broker = vtkEventBroker::GetInstance();
+  if (this->SliceLogic)
+    {
+    broker->RemoveObservations(this->SliceLogic, vtkCommand::ModifiedEvent,
+      this->External, this->External->GetMRMLLogicsCallbackCommand());
+    }
+  this->SliceLogic = sliceLogic;
+  this->Prop->SliceLogic = sliceLogic;
+  if (this->SliceLogic)
+    {
+    broker->AddObservation(this->SliceLogic, vtkCommand::ModifiedEvent,
+      this->External, this->External->GetMRMLLogicsCallbackCommand());
+    }
+  this->ObserveLayers();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGPUSliceDisplayableManager::vtkInternal::ObserveLayers()
+{
+  std::vector<vtkWeakPointer<vtkMRMLSliceLayerLogic> > layers;
+  if (this->SliceLogic)
+    {
+    layers.emplace_back(this->SliceLogic->GetBackgroundLayer());
+    layers.emplace_back(this->SliceLogic->GetForegroundLayer());
+    layers.emplace_back(this->SliceLogic->GetLabelLayer());
+    }
+  if (layers == this->ObservedLayers)
+    {
+    return;
+    }
+  vtkEventBroker* broker = vtkEventBroker::GetInstance();
+  for (vtkMRMLSliceLayerLogic* layer : this->ObservedLayers)
+    {
+    if (layer)
+      {
+      broker->RemoveObservations(layer, vtkCommand::ModifiedEvent,
+        this->External, this->External->GetMRMLLogicsCallbackCommand());
+      }
+    }
+  // layers are modified when the display node, the volume or the slice
+  // geometry is modified
+  this->ObservedLayers = layers;
+  for (vtkMRMLSliceLayerLogic* layer : this->ObservedLayers)
+    {
+    if (layer)
+      {
+      broker->AddObservation(layer, vtkCommand::ModifiedEvent,
+        this->External, this->External->GetMRMLLogicsCallbackCommand());
+      }
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGPUSliceDisplayableManager::vtkInternal::UpdateProp()
+{
+  bool active = this->SliceLogic && this->SliceLogic->IsGPURenderingActive();
+  vtkRenderer* renderer = this->External->GetRenderer();
+  if (active && !this->PropAdded && renderer)
+    {
+    renderer->AddViewProp(this->Prop);
+    this->PropAdded = true;
+    }
+  else if (!active && this->PropAdded && renderer)
+    {
+    renderer->RemoveViewProp(this->Prop);
+    this->PropAdded = false;
+    }
+  this->External->RequestRender();
+}
+
+//---------------------------------------------------------------------------
+// vtkMRMLVolumeGPUSliceDisplayableManager methods
+
+//---------------------------------------------------------------------------
+vtkMRMLVolumeGPUSliceDisplayableManager::vtkMRMLVolumeGPUSliceDisplayableManager()
+{
+  this->Internal = new vtkInternal(this);
+}
+
+//---------------------------------------------------------------------------
+vtkMRMLVolumeGPUSliceDisplayableManager::~vtkMRMLVolumeGPUSliceDisplayableManager()
+{
+  delete this->Internal;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGPUSliceDisplayableManager::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "SliceRenderedOnGPU: " << (this->Internal->PropAdded ? "true" : "false") << "\n";
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGPUSliceDisplayableManager::UnobserveMRMLScene()
+{
+  this->Internal->SetSliceLogic(nullptr);
+  this->Internal->UpdateProp();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGPUSliceDisplayableManager::UpdateFromMRMLScene()
+{
+  this->Internal->UpdateSliceLogic();
+  this->Internal->UpdateProp();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGPUSliceDisplayableManager::OnMRMLSliceNodeModifiedEvent()
+{
+  // the slice logic may not exist yet when the displayable manager is created
+  this->Internal->UpdateSliceLogic();
+  this->Internal->UpdateProp();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGPUSliceDisplayableManager::ProcessMRMLLogicsEvents(
+  vtkObject* caller, unsigned long event, void* callData)
+{
+  if (event == vtkCommand::ModifiedEvent && this->Internal->SliceLogic
+    && (caller == this->Internal->SliceLogic || vtkMRMLSliceLayerLogic::SafeDownCast(caller)))
+    {
+    this->Internal->ObserveLayers();
+    this->Internal->UpdateProp();
+    return;
+    }
+  this->Superclass::ProcessMRMLLogicsEvents(caller, event, callData);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGPUSliceDisplayableManager::Create()
+{
+  this->Internal->UpdateSliceLogic();
+  this->Internal->UpdateProp();
+}
@@ -0,0 +1,69 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __vtkMRMLVolumeGPUSliceDisplayableManager_h
+#define __vtkMRMLVolumeGPUSliceDisplayableManager_h
+
+// MRMLDisplayableManager includes
+#include "vtkMRMLAbstractSliceViewDisplayableManager.h"
+#include "vtkMRMLDisplayableManagerExport.h"
+
+/// \brief Displayable manager rendering the slice layers on the GPU.
+///
+/// When vtkMRMLSliceLogic::IsGPURenderingActive() is true, the volumes of the
+/// background, foreground and label layers are uploaded once as 3D textures
+/// and a fragment shader reslices them, applies window/level, threshold and
+/// lookup table, outlines the label map and blends the layers, replacing the
+/// CPU imaging pipeline of vtkMRMLSliceLayerLogic and vtkMRMLSliceLogic.
+///
+/// Textures are uploaded again only when the image data of a volume is
+/// modified. If the graphics card cannot create the textures or the shader,
+/// vtkMRMLSliceLogic::SetGPURenderingSupported(false) is called and the CPU
+/// pipeline is used instead.
+/// \sa vtkMRMLSliceNode::SetGPURenderingEnabled()
+class VTK_MRML_DISPLAYABLEMANAGER_EXPORT vtkMRMLVolumeGPUSliceDisplayableManager
+  : public vtkMRMLAbstractSliceViewDisplayableManager
+{
+public:
+  static vtkMRMLVolumeGPUSliceDisplayableManager* New();
+  vtkTypeMacro(vtkMRMLVolumeGPUSliceDisplayableManager,
+                       vtkMRMLAbstractSliceViewDisplayableManager);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+protected:
+
+  vtkMRMLVolumeGPUSliceDisplayableManager();
+  ~vtkMRMLVolumeGPUSliceDisplayableManager() override;
+
+  void UnobserveMRMLScene() override;
+  void UpdateFromMRMLScene() override;
+  void OnMRMLSliceNodeModifiedEvent() override;
+  void ProcessMRMLLogicsEvents(vtkObject* caller, unsigned long event, void* callData) override;
+
+  /// Initialize the displayable manager based on its associated
+  /// vtkMRMLSliceNode
+  void Create() override;
+
+private:
+
+  vtkMRMLVolumeGPUSliceDisplayableManager(const vtkMRMLVolumeGPUSliceDisplayableManager&) = delete;
+  void operator=(const vtkMRMLVolumeGPUSliceDisplayableManager&) = delete;
+
+  class vtkInternal;
+  vtkInternal * Internal;
+  friend class vtkInternal;
+};
+
+#endif
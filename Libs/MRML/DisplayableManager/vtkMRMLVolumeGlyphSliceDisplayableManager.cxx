@@ -23,6 +23,7 @@
 
 // MRML includes
 #include <vtkMRMLColorNode.h>
+#include <vtkMRMLDiffusionTensorDisplayPropertiesNode.h>
 #include <vtkMRMLDiffusionTensorVolumeNode.h>
 #include <vtkMRMLDiffusionTensorVolumeSliceDisplayNode.h>
 #include <vtkMRMLScene.h>
@@ -30,12 +31,17 @@
 #include <vtkMRMLSliceNode.h>
 
 // VTK includes
+#include <vtkActor.h>
 #include <vtkActor2D.h>
 #include <vtkCallbackCommand.h>
+#include <vtkCamera.h>
+#include <vtkGlyph3DMapper.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPolyDataMapper2D.h>
 #include <vtkRenderer.h>
+#include <vtkRenderWindow.h>
+#include <vtkSmartPointer.h>
 #include <vtkWeakPointer.h>
 #include <vtkVersion.h>
 
@@ -43,6 +49,10 @@
 #include <algorithm>
 #include <cassert>
 
+// Distance of the camera from the slice plane in the glyph instancing renderer (in pixels).
+// Glyphs are clipped if they extend farther from the slice plane.
+static const double INSTANCED_GLYPH_CAMERA_DISTANCE = 10000.0;
+
 //---------------------------------------------------------------------------
 vtkStandardNewMacro(vtkMRMLVolumeGlyphSliceDisplayableManager );
 
@@ -99,12 +109,24 @@ public:
   void AddActor(vtkMRMLDisplayNode* displayNode);
   void RemoveActor(DisplayActorsType::iterator actorIt);
   void UpdateActor(vtkMRMLDisplayNode* displayNode, vtkProp* actor);
+  void RemoveAllActors();
+
+  // Glyph instancing
+  void SetupInstancedGlyphRenderer();
+  void RemoveInstancedGlyphRenderer();
+  void UpdateInstancedGlyphCamera();
+  static void OnRendererStart(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
 
   vtkWeakPointer<vtkMRMLSliceCompositeNode> SliceCompositeNode;
   std::vector<vtkMRMLDisplayableNode*>      VolumeNodes;
   DisplayNodesType                          DisplayNodes;
   DisplayActorsType                         Actors;
   vtkMRMLVolumeGlyphSliceDisplayableManager*      External;
+
+  /// Renderer that displays glyph instances in slice XY coordinates
+  vtkSmartPointer<vtkRenderer>              InstancedGlyphRenderer;
+  vtkWeakPointer<vtkRenderer>               ObservedRenderer;
+  vtkNew<vtkCallbackCommand>                RendererStartCallback;
 };
 
 //---------------------------------------------------------------------------
@@ -116,12 +138,15 @@ vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal
 {
   this->External = external;
   this->SliceCompositeNode = nullptr;
+  this->RendererStartCallback->SetClientData(this);
+  this->RendererStartCallback->SetCallback(vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal::OnRendererStart);
 }
 
 //---------------------------------------------------------------------------
 vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal::~vtkInternal()
 {
   this->SetSliceCompositeNode(nullptr);
+  this->RemoveInstancedGlyphRenderer();
   // everything should be empty
   assert(this->SliceCompositeNode == nullptr);
   assert(this->VolumeNodes.size() == 0);
@@ -485,6 +510,26 @@ void vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal::UpdateVolumeDisplay
 void vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal::AddActor(
   vtkMRMLDisplayNode* displayNode)
 {
+  if (this->External->GetUseGlyphInstancing())
+    {
+    this->SetupInstancedGlyphRenderer();
+    vtkActor* actor = vtkActor::New();
+    if (displayNode->IsA("vtkMRMLDiffusionTensorVolumeSliceDisplayNode"))
+      {
+      vtkNew<vtkGlyph3DMapper> mapper;
+      mapper->OrientOn();
+      mapper->SetOrientationModeToQuaternion();
+      mapper->SetOrientationArray("GlyphOrientation");
+      mapper->ScalingOn();
+      mapper->SetScaleModeToScaleByVectorComponents();
+      mapper->SetScaleArray("GlyphScale");
+      actor->SetMapper(mapper.GetPointer());
+      }
+    this->InstancedGlyphRenderer->AddActor( actor );
+    this->Actors[displayNode] = actor;
+    this->UpdateActor(displayNode, actor);
+    return;
+    }
   vtkActor2D* actor = vtkActor2D::New();
   if (displayNode->IsA("vtkMRMLDiffusionTensorVolumeSliceDisplayNode"))
     {
@@ -505,6 +550,23 @@ void vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal::UpdateActor(
     vtkMRMLDiffusionTensorVolumeSliceDisplayNode* dtiDisplayNode =
       vtkMRMLDiffusionTensorVolumeSliceDisplayNode::SafeDownCast(displayNode);
 
+    vtkActor* instancedGlyphActor = vtkActor::SafeDownCast(actor);
+    if (instancedGlyphActor)
+      {
+      vtkGlyph3DMapper* glyphMapper = vtkGlyph3DMapper::SafeDownCast(instancedGlyphActor->GetMapper());
+      vtkMRMLDiffusionTensorDisplayPropertiesNode* dtDPN = dtiDisplayNode->GetDiffusionTensorDisplayPropertiesNode();
+      glyphMapper->SetInputConnection( dtiDisplayNode->GetGlyphInstancesConnection() );
+      glyphMapper->SetSourceConnection( dtDPN ? dtDPN->GetGlyphConnection() : nullptr );
+      glyphMapper->SetLookupTable( dtiDisplayNode->GetColorNode() ?
+                                   dtiDisplayNode->GetColorNode()->GetScalarsToColors() : nullptr);
+      glyphMapper->SetScalarRange(dtiDisplayNode->GetScalarRange());
+      // Glyph instances are in slice coordinates, the actor transforms them to XY
+      instancedGlyphActor->SetUserMatrix(dtiDisplayNode->GetSliceToXYMatrix());
+      actor->SetVisibility(this->IsVisible(displayNode) && dtDPN != nullptr);
+      this->External->RequestRender();
+      return;
+      }
+
     vtkActor2D* actor2D = vtkActor2D::SafeDownCast(actor);
     vtkPolyDataMapper2D* mapper = vtkPolyDataMapper2D::SafeDownCast(
       actor2D->GetMapper());
@@ -527,10 +589,92 @@ void vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal::RemoveActor(
     return;
     }
   this->External->GetRenderer()->RemoveActor( actorIt->second );
+  if (this->InstancedGlyphRenderer)
+    {
+    this->InstancedGlyphRenderer->RemoveActor( actorIt->second );
+    }
   actorIt->second->Delete();
   this->Actors.erase(actorIt);
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal::RemoveAllActors()
+{
+  while (!this->Actors.empty())
+    {
+    this->RemoveActor(this->Actors.begin());
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal::SetupInstancedGlyphRenderer()
+{
+  vtkRenderer* renderer = this->External->GetRenderer();
+  if (this->InstancedGlyphRenderer || !renderer || !renderer->GetRenderWindow())
+    {
+    return;
+    }
+  // Glyphs are rendered on top of the slice view renderer content,
+  // in a renderer with a camera that maps world coordinates to slice XY (pixel) coordinates.
+  this->InstancedGlyphRenderer = vtkSmartPointer<vtkRenderer>::New();
+  this->InstancedGlyphRenderer->InteractiveOff();
+  this->InstancedGlyphRenderer->PreserveColorBufferOn();
+  this->InstancedGlyphRenderer->SetLayer(renderer->GetLayer());
+  renderer->GetRenderWindow()->AddRenderer(this->InstancedGlyphRenderer);
+  this->ObservedRenderer = renderer;
+  renderer->AddObserver(vtkCommand::StartEvent, this->RendererStartCallback);
+  this->UpdateInstancedGlyphCamera();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal::RemoveInstancedGlyphRenderer()
+{
+  if (this->ObservedRenderer)
+    {
+    this->ObservedRenderer->RemoveObserver(this->RendererStartCallback);
+    this->ObservedRenderer = nullptr;
+    }
+  if (!this->InstancedGlyphRenderer)
+    {
+    return;
+    }
+  if (this->InstancedGlyphRenderer->GetRenderWindow())
+    {
+    this->InstancedGlyphRenderer->GetRenderWindow()->RemoveRenderer(this->InstancedGlyphRenderer);
+    }
+  this->InstancedGlyphRenderer = nullptr;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal::UpdateInstancedGlyphCamera()
+{
+  vtkRenderer* renderer = this->External->GetRenderer();
+  if (!this->InstancedGlyphRenderer || !renderer)
+    {
+    return;
+    }
+  this->InstancedGlyphRenderer->SetViewport(renderer->GetViewport());
+  const int* size = renderer->GetSize();
+  double center[2] = { size[0] / 2.0, size[1] / 2.0 };
+  vtkCamera* camera = this->InstancedGlyphRenderer->GetActiveCamera();
+  camera->ParallelProjectionOn();
+  camera->SetFocalPoint(center[0], center[1], 0.0);
+  camera->SetPosition(center[0], center[1], INSTANCED_GLYPH_CAMERA_DISTANCE);
+  camera->SetViewUp(0.0, 1.0, 0.0);
+  camera->SetParallelScale(center[1] > 0.0 ? center[1] : 1.0);
+  camera->SetClippingRange(1.0, 2.0 * INSTANCED_GLYPH_CAMERA_DISTANCE);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal::OnRendererStart(
+  vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
+{
+  vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal* self =
+    reinterpret_cast<vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal*>(clientData);
+  // The view may have been resized since the last render
+  self->UpdateInstancedGlyphCamera();
+}
+
 //---------------------------------------------------------------------------
 bool vtkMRMLVolumeGlyphSliceDisplayableManager::vtkInternal::IsDisplayable(
   vtkMRMLDisplayNode* displayNode)
@@ -569,6 +713,34 @@ vtkMRMLVolumeGlyphSliceDisplayableManager::~vtkMRMLVolumeGlyphSliceDisplayableMa
 void vtkMRMLVolumeGlyphSliceDisplayableManager::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseGlyphInstancing: " << (this->UseGlyphInstancing ? "true" : "false") << "\n";
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeGlyphSliceDisplayableManager::SetUseGlyphInstancing(bool enable)
+{
+  if (this->UseGlyphInstancing == enable)
+    {
+    return;
+    }
+  this->UseGlyphInstancing = enable;
+  // Recreate actors with the requested rendering method
+  this->Internal->RemoveAllActors();
+  if (!enable)
+    {
+    this->Internal->RemoveInstancedGlyphRenderer();
+    }
+  for (vtkInternal::DisplayNodesType::iterator it = this->Internal->DisplayNodes.begin();
+    it != this->Internal->DisplayNodes.end(); ++it)
+    {
+    for (std::vector<vtkMRMLDisplayNode*>::iterator displayNodeIt = it->second.begin();
+      displayNodeIt != it->second.end(); ++displayNodeIt)
+      {
+      this->Internal->UpdateVolumeDisplayNode(*displayNodeIt);
+      }
+    }
+  this->Modified();
+  this->RequestRender();
 }
 
 //---------------------------------------------------------------------------
@@ -39,6 +39,16 @@ public:
                        vtkMRMLAbstractSliceViewDisplayableManager);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  /// Render glyphs by GPU instancing of a single glyph source, instead of rendering
+  /// glyph geometry generated for each tensor. Tensor orientations and scales
+  /// are passed to the mapper as per-instance attributes, which requires much less
+  /// memory and processing time for dense glyphs.
+  /// Glyphs are rendered in a separate renderer on top of the slice view renderer.
+  /// Disabled by default.
+  void SetUseGlyphInstancing(bool enable);
+  vtkGetMacro(UseGlyphInstancing, bool);
+  vtkBooleanMacro(UseGlyphInstancing, bool);
+
 protected:
 
   vtkMRMLVolumeGlyphSliceDisplayableManager();
@@ -58,6 +68,8 @@ private:
   vtkMRMLVolumeGlyphSliceDisplayableManager(const vtkMRMLVolumeGlyphSliceDisplayableManager&) = delete;
   void operator=(const vtkMRMLVolumeGlyphSliceDisplayableManager&) = delete;
 
+  bool UseGlyphInstancing{false};
+
   class vtkInternal;
   vtkInternal * Internal;
   friend class vtkInternal;
@@ -0,0 +1,221 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#include "vtkMRMLWidgetPickingIndex.h"
+
+// MRMLDisplayableManager includes
+#include "vtkMRMLAbstractWidget.h"
+#include "vtkMRMLAbstractWidgetRepresentation.h"
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkObjectFactory.h>
+#include <vtkRenderer.h>
+
+// STD includes
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+/// If the interaction region of a widget covers more cells than this then
+/// it is not worth storing it in cells, it is treated as always candidate instead.
+const long long MAXIMUM_NUMBER_OF_CELLS_PER_WIDGET = 4096;
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkMRMLWidgetPickingIndex);
+
+//----------------------------------------------------------------------------
+vtkMRMLWidgetPickingIndex::vtkMRMLWidgetPickingIndex()
+{
+  this->RenderCallbackCommand = vtkSmartPointer<vtkCallbackCommand>::New();
+  this->RenderCallbackCommand->SetClientData(this);
+  this->RenderCallbackCommand->SetCallback(vtkMRMLWidgetPickingIndex::RenderCallback);
+}
+
+//----------------------------------------------------------------------------
+vtkMRMLWidgetPickingIndex::~vtkMRMLWidgetPickingIndex()
+{
+  this->SetRenderer(nullptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLWidgetPickingIndex::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "CellSize: " << this->CellSize << "\n";
+  os << indent << "Valid: " << (this->Valid ? "true" : "false") << "\n";
+  os << indent << "NumberOfWidgets: " << this->Widgets.size() << "\n";
+  os << indent << "NumberOfAlwaysCandidateWidgets: " << this->AlwaysCandidateWidgetIndices.size() << "\n";
+  os << indent << "NumberOfCells: " << this->CellWidgetIndices.size() << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLWidgetPickingIndex::SetRenderer(vtkRenderer* renderer)
+{
+  if (this->Renderer == renderer)
+    {
+    return;
+    }
+  if (this->Renderer)
+    {
+    this->Renderer->RemoveObserver(this->RenderCallbackCommand);
+    }
+  this->Renderer = renderer;
+  if (this->Renderer)
+    {
+    this->Renderer->AddObserver(vtkCommand::EndEvent, this->RenderCallbackCommand);
+    }
+  this->Invalidate();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkRenderer* vtkMRMLWidgetPickingIndex::GetRenderer()
+{
+  return this->Renderer;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLWidgetPickingIndex::SetCellSize(int cellSize)
+{
+  cellSize = std::max(cellSize, 1);
+  if (this->CellSize == cellSize)
+    {
+    return;
+    }
+  this->CellSize = cellSize;
+  this->Invalidate();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLWidgetPickingIndex::RenderCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+  void* clientData, void* vtkNotUsed(callData))
+{
+  vtkMRMLWidgetPickingIndex* self = reinterpret_cast<vtkMRMLWidgetPickingIndex*>(clientData);
+  // Camera, view size, or widget representations may have changed
+  self->Invalidate();
+}
+
+//----------------------------------------------------------------------------
+long long vtkMRMLWidgetPickingIndex::GetCellKey(long long cellX, long long cellY)
+{
+  // Display coordinates are well within 32-bit range, so they can be packed into a single key
+  return static_cast<long long>((static_cast<unsigned long long>(cellX) << 32)
+    ^ (static_cast<unsigned long long>(cellY) & 0xffffffffULL));
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLWidgetPickingIndex::Reset()
+{
+  this->Widgets.clear();
+  this->AlwaysCandidateWidgetIndices.clear();
+  this->CellWidgetIndices.clear();
+  this->Valid = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLWidgetPickingIndex::Invalidate()
+{
+  this->Valid = false;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLWidgetPickingIndex::IsValid()
+{
+  return this->Valid;
+}
+
+//----------------------------------------------------------------------------
+int vtkMRMLWidgetPickingIndex::GetNumberOfWidgets()
+{
+  return static_cast<int>(this->Widgets.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLWidgetPickingIndex::AddWidget(vtkMRMLAbstractWidget* widget, bool alwaysCandidate/*=false*/)
+{
+  if (!widget)
+    {
+    return;
+    }
+  int widgetIndex = static_cast<int>(this->Widgets.size());
+  this->Widgets.emplace_back(widget);
+
+  double displayBounds[4] = { 0.0, -1.0, 0.0, -1.0 };
+  vtkMRMLAbstractWidgetRepresentation* rep = widget->GetRepresentation();
+  if (alwaysCandidate || !rep || !rep->GetInteractionDisplayBounds(displayBounds))
+    {
+    this->AlwaysCandidateWidgetIndices.push_back(widgetIndex);
+    return;
+    }
+  if (displayBounds[0] > displayBounds[1] || displayBounds[2] > displayBounds[3])
+    {
+    // cannot be interacted with anywhere
+    return;
+    }
+
+  long long cellXMin = static_cast<long long>(std::floor(displayBounds[0] / this->CellSize));
+  long long cellXMax = static_cast<long long>(std::floor(displayBounds[1] / this->CellSize));
+  long long cellYMin = static_cast<long long>(std::floor(displayBounds[2] / this->CellSize));
+  long long cellYMax = static_cast<long long>(std::floor(displayBounds[3] / this->CellSize));
+  if ((cellXMax - cellXMin + 1) * (cellYMax - cellYMin + 1) > MAXIMUM_NUMBER_OF_CELLS_PER_WIDGET)
+    {
+    this->AlwaysCandidateWidgetIndices.push_back(widgetIndex);
+    return;
+    }
+  for (long long cellY = cellYMin; cellY <= cellYMax; ++cellY)
+    {
+    for (long long cellX = cellXMin; cellX <= cellXMax; ++cellX)
+      {
+      this->CellWidgetIndices[vtkMRMLWidgetPickingIndex::GetCellKey(cellX, cellY)].push_back(widgetIndex);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLWidgetPickingIndex::GetCandidateWidgets(const int displayPosition[2],
+  std::vector<vtkMRMLAbstractWidget*>& candidateWidgets)
+{
+  candidateWidgets.clear();
+  if (!this->Valid)
+    {
+    vtkErrorMacro("GetCandidateWidgets: index is not valid, it must be rebuilt before use");
+    return;
+    }
+  for (int widgetIndex : this->AlwaysCandidateWidgetIndices)
+    {
+    if (this->Widgets[widgetIndex])
+      {
+      candidateWidgets.push_back(this->Widgets[widgetIndex]);
+      }
+    }
+  long long cellX = static_cast<long long>(std::floor(static_cast<double>(displayPosition[0]) / this->CellSize));
+  long long cellY = static_cast<long long>(std::floor(static_cast<double>(displayPosition[1]) / this->CellSize));
+  auto cellIt = this->CellWidgetIndices.find(vtkMRMLWidgetPickingIndex::GetCellKey(cellX, cellY));
+  if (cellIt == this->CellWidgetIndices.end())
+    {
+    return;
+    }
+  for (int widgetIndex : cellIt->second)
+    {
+    if (this->Widgets[widgetIndex])
+      {
+      candidateWidgets.push_back(this->Widgets[widgetIndex]);
+      }
+    }
+}
@@ -0,0 +1,120 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+/**
+ * @class   vtkMRMLWidgetPickingIndex
+ * @brief   Screen-space index of widgets for quickly finding widgets near a display position
+ *
+ * Displayable managers that manage many widgets (such as markups) need to find the
+ * widget that is closest to the mouse pointer for each mouse move event. Asking each widget
+ * if it can process the event may be slow if there are hundreds of widgets in a view.
+ *
+ * This class stores the interaction region of each widget in display coordinates
+ * (see vtkMRMLAbstractWidgetRepresentation::GetInteractionDisplayBounds()) in a uniform grid,
+ * so that only those widgets need to be asked whose interaction region contains the display position.
+ * Widgets that cannot provide their interaction region are always returned as candidates.
+ *
+ * The index is automatically invalidated each time the renderer is rendered (because camera,
+ * view size, widget positions may have changed) and the displayable manager is expected to
+ * rebuild it before the next query.
+ *
+ * @sa
+ * vtkMRMLAbstractWidget vtkMRMLAbstractWidgetRepresentation
+*/
+
+#ifndef vtkMRMLWidgetPickingIndex_h
+#define vtkMRMLWidgetPickingIndex_h
+
+#include "vtkMRMLDisplayableManagerExport.h"
+
+// VTK includes
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+#include <vtkWeakPointer.h>
+
+// STD includes
+#include <unordered_map>
+#include <vector>
+
+class vtkCallbackCommand;
+class vtkMRMLAbstractWidget;
+class vtkRenderer;
+
+class VTK_MRML_DISPLAYABLEMANAGER_EXPORT vtkMRMLWidgetPickingIndex : public vtkObject
+{
+public:
+  static vtkMRMLWidgetPickingIndex *New();
+  vtkTypeMacro(vtkMRMLWidgetPickingIndex, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Renderer of the view. The index is invalidated each time rendering of the renderer is completed.
+  void SetRenderer(vtkRenderer* renderer);
+  vtkRenderer* GetRenderer();
+
+  /// Size of grid cells, in pixels. Default is 32.
+  /// Invalidates the index.
+  void SetCellSize(int cellSize);
+  vtkGetMacro(CellSize, int);
+
+  /// Remove all widgets and mark the index as valid.
+  /// After this, widgets can be added to the index using AddWidget().
+  void Reset();
+
+  /// Add a widget to the index. Interaction region is retrieved from the widget representation.
+  /// If alwaysCandidate is true then the widget is returned as candidate for any display position
+  /// (for example, because it is being dragged).
+  void AddWidget(vtkMRMLAbstractWidget* widget, bool alwaysCandidate = false);
+
+  /// Mark the index as invalid. It has to be rebuilt (using Reset() and AddWidget()) before use.
+  /// Must be called when a widget is added or removed or its state is changed.
+  void Invalidate();
+
+  /// Returns true if the index can be used for finding candidate widgets.
+  bool IsValid();
+
+  /// Get widgets that may be able to interact at the specified display position.
+  /// The index must be valid.
+  void GetCandidateWidgets(const int displayPosition[2], std::vector<vtkMRMLAbstractWidget*>& candidateWidgets);
+
+  /// Number of widgets in the index
+  int GetNumberOfWidgets();
+
+protected:
+  vtkMRMLWidgetPickingIndex();
+  ~vtkMRMLWidgetPickingIndex() override;
+
+  static void RenderCallback(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
+
+  /// Get key of the grid cell that contains the specified cell indices
+  static long long GetCellKey(long long cellX, long long cellY);
+
+  int CellSize{32};
+  bool Valid{false};
+
+  vtkWeakPointer<vtkRenderer> Renderer;
+  vtkSmartPointer<vtkCallbackCommand> RenderCallbackCommand;
+
+  std::vector< vtkWeakPointer<vtkMRMLAbstractWidget> > Widgets;
+  /// Indices of widgets that are candidates at any position
+  std::vector<int> AlwaysCandidateWidgetIndices;
+  /// Indices of widgets in each grid cell
+  std::unordered_map<long long, std::vector<int> > CellWidgetIndices;
+
+private:
+  vtkMRMLWidgetPickingIndex(const vtkMRMLWidgetPickingIndex&) = delete;
+  void operator=(const vtkMRMLWidgetPickingIndex&) = delete;
+};
+
+#endif
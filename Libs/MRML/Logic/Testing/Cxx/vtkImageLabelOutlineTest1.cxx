@@ -0,0 +1,117 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH)
+  All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   3D Slicer
+
+=========================================================================auto=*/
+
+// MRMLLogic includes
+#include "vtkImageLabelOutline.h"
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Outline computed by visiting the neighborhood of each pixel
+short ReferenceOutline(vtkImageData* image, int i, int j, int k, int outline)
+{
+  int* extent = image->GetExtent();
+  short label = *static_cast<short*>(image->GetScalarPointer(i, j, k));
+  if (label == 0)
+    {
+    return 0;
+    }
+  for (int hoodJ = j - outline; hoodJ <= j + outline; ++hoodJ)
+    {
+    for (int hoodI = i - outline; hoodI <= i + outline; ++hoodI)
+      {
+      if (hoodI < extent[0] || hoodI > extent[1] || hoodJ < extent[2] || hoodJ > extent[3]
+        || *static_cast<short*>(image->GetScalarPointer(hoodI, hoodJ, k)) != label)
+        {
+        return label;
+        }
+      }
+    }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+int TestOutline(vtkImageData* image, int outline)
+{
+  vtkNew<vtkImageLabelOutline> filter;
+  filter->SetInputData(image);
+  filter->SetOutline(outline);
+  filter->Update();
+  vtkImageData* output = filter->GetOutput();
+  int* extent = image->GetExtent();
+  for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+        {
+        short value = *static_cast<short*>(output->GetScalarPointer(i, j, k));
+        short expected = ReferenceOutline(image, i, j, k, outline);
+        if (value != expected)
+          {
+          std::cerr << "Line " << __LINE__ << ": outline " << outline << " at (" << i << ", " << j << ", " << k
+                    << ") is " << value << " instead of " << expected << std::endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkImageLabelOutlineTest1(int , char * [] )
+{
+  vtkNew<vtkImageLabelOutline> filter;
+  EXERCISE_BASIC_OBJECT_METHODS(filter.GetPointer());
+
+  // Blocks of labels, so that there are regions thicker than the outline
+  vtkNew<vtkImageData> image;
+  image->SetExtent(-3, 36, 2, 41, 0, 1);
+  image->AllocateScalars(VTK_SHORT, 1);
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  int* extent = image->GetExtent();
+  for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+        {
+        short label = static_cast<short>(((i + 10) / 7 + (j / 5) * 3 + k) % 4);
+        random->Next();
+        if (random->GetValue() < 0.02)
+          {
+          label = 5;
+          }
+        *static_cast<short*>(image->GetScalarPointer(i, j, k)) = label;
+        }
+      }
+    }
+
+  for (int outline = 0; outline <= 3; ++outline)
+    {
+    CHECK_EXIT_SUCCESS(TestOutline(image, outline));
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRMLLogic includes
+#include "vtkImageSharedReslice.h"
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkImageReslice.h>
+#include <vtkImageStencilData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkTransform.h>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Compare the output of \a reslice with the output of vtkImageReslice
+int CompareWithImageReslice(vtkImageSharedReslice* reslice, int interpolationMode)
+{
+  vtkNew<vtkImageReslice> reference;
+  reference->SetInputData(vtkImageData::SafeDownCast(reslice->GetInput()));
+  reference->SetResliceTransform(reslice->GetResliceTransform());
+  reference->SetOutputExtent(reslice->GetOutputExtent());
+  reference->SetOutputSpacing(1., 1., 1.);
+  reference->SetOutputOrigin(0., 0., 0.);
+  reference->SetBackgroundColor(reslice->GetBackgroundColor());
+  reference->GenerateStencilOutputOn();
+  reference->SetInterpolationMode(interpolationMode);
+  reference->Update();
+  reslice->SetInterpolationMode(interpolationMode);
+  reslice->Update();
+
+  vtkImageData* output = reslice->GetOutput();
+  vtkImageData* referenceOutput = reference->GetOutput();
+  int* extent = referenceOutput->GetExtent();
+  for (int i = 0; i < 6; ++i)
+    {
+    CHECK_INT(output->GetExtent()[i], extent[i]);
+    }
+  for (int z = extent[4]; z <= extent[5]; ++z)
+    {
+    for (int y = extent[2]; y <= extent[3]; ++y)
+      {
+      for (int x = extent[0]; x <= extent[1]; ++x)
+        {
+        CHECK_DOUBLE(output->GetScalarComponentAsDouble(x, y, z, 0),
+                     referenceOutput->GetScalarComponentAsDouble(x, y, z, 0));
+        CHECK_BOOL(reslice->GetStencilOutput()->IsInside(x, y, z) != 0,
+                   reference->GetStencilOutput()->IsInside(x, y, z) != 0);
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkImageSharedResliceTest1(int, char*[])
+{
+  vtkNew<vtkImageSharedReslice> reslice;
+  EXERCISE_BASIC_OBJECT_METHODS(reslice.GetPointer());
+  CHECK_BOOL(reslice->GetAxisAlignedCopy(), true);
+
+  vtkNew<vtkImageData> imageData;
+  imageData->SetDimensions(12, 10, 8);
+  imageData->AllocateScalars(VTK_SHORT, 1);
+  for (int k = 0; k < 8; ++k)
+    {
+    for (int j = 0; j < 10; ++j)
+      {
+      for (int i = 0; i < 12; ++i)
+        {
+        imageData->SetScalarComponentFromDouble(i, j, k, 0, 1 + i + 20 * j + 200 * k);
+        }
+      }
+    }
+
+  // i = 2 * y + 1, j = 9 - x, k = z + 3: rows are along -j, every other
+  // voxel along i, part of the output is outside of the volume
+  vtkNew<vtkMatrix4x4> xyToIJK;
+  xyToIJK->Zero();
+  xyToIJK->SetElement(0, 1, 2.);
+  xyToIJK->SetElement(0, 3, 1.);
+  xyToIJK->SetElement(1, 0, -1.);
+  xyToIJK->SetElement(1, 3, 9.);
+  xyToIJK->SetElement(2, 2, 1.);
+  xyToIJK->SetElement(2, 3, 3.);
+  xyToIJK->SetElement(3, 3, 1.);
+  vtkNew<vtkTransform> transform;
+  transform->SetMatrix(xyToIJK);
+
+  reslice->SetInputData(imageData);
+  reslice->SetResliceTransform(transform);
+  reslice->SetOutputExtent(0, 13, 0, 7, 0, 5);
+  reslice->SetOutputSpacing(1., 1., 1.);
+  reslice->SetOutputOrigin(0., 0., 0.);
+  reslice->SetBackgroundColor(-1., -1., -1., -1.);
+  reslice->GenerateStencilOutputOn();
+  reslice->ShareOutputOff();
+
+  CHECK_EXIT_SUCCESS(CompareWithImageReslice(reslice, VTK_RESLICE_NEAREST));
+  CHECK_INT(reslice->GetAxisAlignedCopyCount(), 1);
+  CHECK_DOUBLE(reslice->GetOutput()->GetScalarComponentAsDouble(2, 3, 1, 0), 1 + 7 + 20 * 7 + 200 * 4);
+  CHECK_DOUBLE(reslice->GetOutput()->GetScalarComponentAsDouble(12, 3, 1, 0), -1.);
+
+  // Output voxels are on input voxels, interpolation does not change them
+  CHECK_EXIT_SUCCESS(CompareWithImageReslice(reslice, VTK_RESLICE_LINEAR));
+  CHECK_INT(reslice->GetAxisAlignedCopyCount(), 2);
+
+  // Output voxels between input voxels are interpolated
+  xyToIJK->SetElement(0, 3, 1.5);
+  transform->SetMatrix(xyToIJK);
+  CHECK_EXIT_SUCCESS(CompareWithImageReslice(reslice, VTK_RESLICE_LINEAR));
+  CHECK_INT(reslice->GetAxisAlignedCopyCount(), 2);
+
+  // Disabled copy
+  xyToIJK->SetElement(0, 3, 1.);
+  transform->SetMatrix(xyToIJK);
+  reslice->AxisAlignedCopyOff();
+  reslice->ResetAxisAlignedCopyCount();
+  CHECK_EXIT_SUCCESS(CompareWithImageReslice(reslice, VTK_RESLICE_NEAREST));
+  CHECK_INT(reslice->GetAxisAlignedCopyCount(), 0);
+
+  return EXIT_SUCCESS;
+}
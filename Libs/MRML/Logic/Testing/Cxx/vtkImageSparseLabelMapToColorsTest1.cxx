@@ -0,0 +1,88 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRMLLogic includes
+#include "vtkImageSparseLabelMapToColors.h"
+
+// MRML includes
+#include "vtkMRMLColorTableNode.h"
+#include "vtkMRMLCoreTestingMacros.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkImageMapToColors.h>
+#include <vtkLookupTable.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+
+// STD includes
+#include <cstring>
+
+//----------------------------------------------------------------------------
+int vtkImageSparseLabelMapToColorsTest1(int vtkNotUsed(argc), char * vtkNotUsed(argv)[])
+{
+  // Large table with only a few defined colors, as in FreeSurfer color tables
+  const int numberOfColors = 14176;
+  vtkNew<vtkMRMLColorTableNode> colorTableNode;
+  colorTableNode->SetTypeToUser();
+  colorTableNode->SetNumberOfColors(numberOfColors);
+  colorTableNode->GetLookupTable()->SetTableRange(0, numberOfColors - 1);
+  colorTableNode->SetColors(0, numberOfColors - 1, "", 0.0, 0.0, 0.0, 0.0);
+  const int definedLabels[] = { 2, 41, 1000, 2035, numberOfColors - 1 };
+  for (int label : definedLabels)
+    {
+    colorTableNode->SetColor(label, "label", (label % 7) / 7.0, (label % 5) / 5.0, (label % 3) / 3.0, 1.0);
+    }
+  CHECK_BOOL(colorTableNode->HasSparseLabelColors(), true);
+  CHECK_INT(static_cast<int>(colorTableNode->GetSparseLabelColorMap().size()), 5);
+
+  // Label map with the defined labels, undefined labels, and out of range values
+  vtkNew<vtkImageData> labelMap;
+  labelMap->SetDimensions(32, 16, 2);
+  labelMap->AllocateScalars(VTK_INT, 1);
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  int* labels = static_cast<int*>(labelMap->GetScalarPointer());
+  for (vtkIdType i = 0; i < labelMap->GetNumberOfPoints(); ++i)
+    {
+    random->Next();
+    int choice = static_cast<int>(random->GetRangeValue(0, 8));
+    labels[i] = (choice < 5 ? definedLabels[choice] : (choice == 5 ? 123 : (choice == 6 ? -5 : 20000)));
+    }
+
+  vtkNew<vtkImageMapToColors> mapToColors;
+  mapToColors->SetInputData(labelMap);
+  mapToColors->SetLookupTable(colorTableNode->GetLookupTable());
+  mapToColors->SetOutputFormatToRGBA();
+  mapToColors->Update();
+
+  vtkNew<vtkImageSparseLabelMapToColors> sparseMapToColors;
+  sparseMapToColors->SetInputData(labelMap);
+  sparseMapToColors->SetColorTableNode(colorTableNode);
+  sparseMapToColors->Update();
+
+  CHECK_INT(sparseMapToColors->GetOutput()->GetNumberOfScalarComponents(), 4);
+  CHECK_INT(memcmp(sparseMapToColors->GetOutput()->GetScalarPointer(), mapToColors->GetOutput()->GetScalarPointer(),
+    labelMap->GetNumberOfPoints() * 4), 0);
+
+  // Changing a color in the table updates the output
+  vtkMTimeType outputMTime = sparseMapToColors->GetOutput()->GetMTime();
+  colorTableNode->SetColor(123, "label", 1.0, 1.0, 1.0, 1.0);
+  sparseMapToColors->Update();
+  CHECK_BOOL(sparseMapToColors->GetOutput()->GetMTime() > outputMTime, true);
+  CHECK_INT(static_cast<int>(colorTableNode->GetSparseLabelColorMap().size()), 6);
+
+  return EXIT_SUCCESS;
+}
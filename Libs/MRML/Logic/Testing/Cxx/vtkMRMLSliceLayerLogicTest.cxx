@@ -23,10 +23,16 @@
 
 // MRML includes
 #include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLScalarVolumeNode.h"
 #include "vtkMRMLScene.h"
+#include "vtkMRMLSliceNode.h"
+
+// MRMLLogic includes
+#include "vtkImageSharedReslice.h"
 
 // VTK includes
 #include <vtkAssignAttribute.h>
+#include <vtkCallbackCommand.h>
 #include <vtkDataSetAttributes.h>
 #include <vtkFloatArray.h>
 #include <vtkImageData.h>
@@ -39,6 +45,9 @@
 namespace
 {
 bool testDTIPipeline();
+int testResliceCache();
+int testLightBoxStack();
+int testSharedReslice();
 }
 
 //----------------------------------------------------------------------------
@@ -71,6 +80,10 @@ int vtkMRMLSliceLayerLogicTest(int , char * [] )
     TEST_SET_GET_VALUE(logic, VolumeNode, VolumeNode.GetPointer());
   }
 
+  CHECK_EXIT_SUCCESS(testResliceCache());
+  CHECK_EXIT_SUCCESS(testLightBoxStack());
+  CHECK_EXIT_SUCCESS(testSharedReslice());
+
   bool res = true;
   res = res && testDTIPipeline();
   return res ? EXIT_SUCCESS : EXIT_FAILURE;
@@ -78,6 +91,153 @@ int vtkMRMLSliceLayerLogicTest(int , char * [] )
 
 namespace{
 
+//----------------------------------------------------------------------------
+int testResliceCache()
+{
+  vtkNew<vtkMRMLScene> scene;
+  vtkNew<vtkImageData> imageData;
+  imageData->SetDimensions(10, 10, 10);
+  imageData->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  vtkMRMLScalarVolumeNode* volumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLScalarVolumeNode"));
+  volumeNode->SetAndObserveImageData(imageData);
+  vtkNew<vtkMRMLSliceNode> sliceNode;
+  scene->AddNode(sliceNode);
+  sliceNode->SetDimensions(64, 64, 1);
+
+  vtkNew<vtkMRMLSliceLayerLogic> logic;
+  logic->SetMRMLScene(scene);
+  logic->SetSliceNode(sliceNode);
+  logic->SetVolumeNode(volumeNode);
+  logic->ResetResliceCacheStatistics();
+  vtkMTimeType resliceMTime = logic->GetReslice()->GetMTime();
+
+  // the slice node is modified without changing the geometry
+  sliceNode->Modified();
+  CHECK_INT(logic->GetResliceCacheHitCount(), 1);
+  CHECK_INT(logic->GetResliceCacheMissCount(), 0);
+  CHECK_BOOL(logic->GetReslice()->GetMTime() == resliceMTime, true);
+
+  // the geometry changes
+  sliceNode->SetFieldOfView(50., 50., 1.);
+  CHECK_BOOL(logic->GetResliceCacheMissCount() > 0, true);
+  CHECK_BOOL(logic->GetReslice()->GetMTime() > resliceMTime, true);
+
+  // the image data changes
+  int misses = logic->GetResliceCacheMissCount();
+  imageData->Modified();
+  volumeNode->Modified();
+  CHECK_INT(logic->GetResliceCacheMissCount(), misses + 1);
+
+  return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+void CountExecutionsCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid),
+  void* clientData, void* vtkNotUsed(callData))
+{
+  ++(*reinterpret_cast<int*>(clientData));
+}
+
+//----------------------------------------------------------------------------
+int testLightBoxStack()
+{
+  vtkNew<vtkMRMLScene> scene;
+  vtkNew<vtkImageData> imageData;
+  imageData->SetDimensions(20, 20, 20);
+  imageData->AllocateScalars(VTK_SHORT, 1);
+  vtkMRMLScalarVolumeNode* volumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLScalarVolumeNode"));
+  volumeNode->SetAndObserveImageData(imageData);
+  vtkNew<vtkMRMLSliceNode> sliceNode;
+  scene->AddNode(sliceNode);
+  sliceNode->SetDimensions(60, 60, 1);
+  sliceNode->SetLayoutGrid(3, 2);
+
+  vtkNew<vtkMRMLSliceLayerLogic> logic;
+  logic->SetMRMLScene(scene);
+  logic->SetSliceNode(sliceNode);
+  logic->SetVolumeNode(volumeNode);
+
+  int numberOfExecutions = 0;
+  vtkNew<vtkCallbackCommand> countExecutions;
+  countExecutions->SetCallback(CountExecutionsCallback);
+  countExecutions->SetClientData(&numberOfExecutions);
+  logic->GetReslice()->AddObserver(vtkCommand::StartEvent, countExecutions);
+
+  // all the tiles are resliced at once, in a single stack
+  logic->GetReslice()->Update();
+  CHECK_INT(numberOfExecutions, 1);
+  int dimensions[3] = { 0, 0, 0 };
+  logic->GetReslice()->GetOutput()->GetDimensions(dimensions);
+  CHECK_INT(dimensions[0], 30);
+  CHECK_INT(dimensions[1], 20);
+  CHECK_INT(dimensions[2], 6);
+
+  return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+int testSharedReslice()
+{
+  vtkNew<vtkMRMLScene> scene;
+  vtkNew<vtkImageData> imageData;
+  imageData->SetDimensions(10, 10, 10);
+  imageData->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  vtkMRMLScalarVolumeNode* volumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLScalarVolumeNode"));
+  volumeNode->SetAndObserveImageData(imageData);
+  vtkNew<vtkMRMLSliceNode> sliceNode;
+  scene->AddNode(sliceNode);
+  sliceNode->SetDimensions(64, 64, 1);
+  vtkNew<vtkMRMLSliceNode> otherSliceNode;
+  scene->AddNode(otherSliceNode);
+  otherSliceNode->SetDimensions(64, 64, 1);
+
+  // two views showing the same volume with the same geometry
+  vtkNew<vtkMRMLSliceLayerLogic> logic;
+  logic->SetMRMLScene(scene);
+  logic->SetSliceNode(sliceNode);
+  logic->SetVolumeNode(volumeNode);
+  vtkNew<vtkMRMLSliceLayerLogic> otherLogic;
+  otherLogic->SetMRMLScene(scene);
+  otherLogic->SetSliceNode(otherSliceNode);
+  otherLogic->SetVolumeNode(volumeNode);
+
+  vtkImageSharedReslice* reslice = vtkImageSharedReslice::SafeDownCast(logic->GetReslice());
+  vtkImageSharedReslice* otherReslice = vtkImageSharedReslice::SafeDownCast(otherLogic->GetReslice());
+  CHECK_NOT_NULL(reslice);
+  CHECK_NOT_NULL(otherReslice);
+  CHECK_BOOL(reslice->GetShareOutput(), true);
+  reslice->Update();
+  otherReslice->Update();
+  CHECK_INT(reslice->GetSharedOutputCount(), 0);
+  CHECK_INT(otherReslice->GetSharedOutputCount(), 1);
+  CHECK_POINTER(otherReslice->GetOutput()->GetScalarPointer(), reslice->GetOutput()->GetScalarPointer());
+
+  // the first view is moved, the second view keeps its image
+  void* sharedScalars = otherReslice->GetOutput()->GetScalarPointer();
+  sliceNode->SetFieldOfView(50., 50., 1.);
+  reslice->Update();
+  CHECK_INT(reslice->GetSharedOutputCount(), 0);
+  CHECK_POINTER_DIFFERENT(reslice->GetOutput()->GetScalarPointer(), sharedScalars);
+  CHECK_POINTER(otherReslice->GetOutput()->GetScalarPointer(), sharedScalars);
+
+  // the second view is moved to the same geometry
+  otherSliceNode->SetFieldOfView(50., 50., 1.);
+  otherReslice->Update();
+  CHECK_INT(otherReslice->GetSharedOutputCount(), 2);
+
+  // sharing is disabled
+  otherReslice->ShareOutputOff();
+  otherReslice->ResetSharedOutputCount();
+  otherReslice->Modified();
+  otherReslice->Update();
+  CHECK_INT(otherReslice->GetSharedOutputCount(), 0);
+
+  return EXIT_SUCCESS;
+}
+
 //----------------------------------------------------------------------------
 bool testDTIPipeline()
 {
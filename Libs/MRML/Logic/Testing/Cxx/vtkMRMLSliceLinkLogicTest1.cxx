@@ -0,0 +1,93 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH)
+  All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   3D Slicer
+
+=========================================================================auto=*/
+
+// MRMLLogic includes
+#include "vtkMRMLSliceLinkLogic.h"
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+#include <vtkMRMLCoreTestingUtilities.h>
+#include <vtkMRMLScene.h>
+#include <vtkMRMLSliceCompositeNode.h>
+#include <vtkMRMLSliceNode.h>
+
+// VTK includes
+#include <vtkNew.h>
+
+//----------------------------------------------------------------------------
+int vtkMRMLSliceLinkLogicTest1(int , char * [] )
+{
+  vtkNew<vtkMRMLSliceLinkLogic> logic;
+  EXERCISE_BASIC_OBJECT_METHODS(logic.GetPointer());
+
+  vtkNew<vtkMRMLScene> scene;
+  logic->SetMRMLScene(scene);
+
+  vtkNew<vtkMRMLSliceNode> redSliceNode;
+  redSliceNode->SetName("Red");
+  redSliceNode->SetLayoutName("Red");
+  scene->AddNode(redSliceNode);
+
+  vtkNew<vtkMRMLSliceNode> yellowSliceNode;
+  yellowSliceNode->SetName("Yellow");
+  yellowSliceNode->SetLayoutName("Yellow");
+  scene->AddNode(yellowSliceNode);
+
+  vtkNew<vtkMRMLSliceCompositeNode> redCompositeNode;
+  redCompositeNode->SetLayoutName("Red");
+  redCompositeNode->SetLinkedControl(1);
+  scene->AddNode(redCompositeNode);
+
+  vtkNew<vtkMRMLCoreTestingUtilities::vtkMRMLNodeCallback> callback;
+  yellowSliceNode->AddObserver(vtkCommand::ModifiedEvent, callback);
+
+  // Start interacting with the red slice node
+  redSliceNode->SetInteractionFlags(vtkMRMLSliceNode::XYZOriginFlag
+    | vtkMRMLSliceNode::FieldOfViewFlag | vtkMRMLSliceNode::SliceSpacingFlag);
+  redSliceNode->SetInteracting(1);
+  callback->ResetNumberOfEvents();
+  logic->ResetNumberOfBatchedModifiedEvents();
+  CHECK_INT(logic->GetNumberOfBatchedModifiedEvents(), 0);
+
+  // A single modification of the red slice node changes several properties of the linked node
+  int wasModifying = redSliceNode->StartModify();
+  redSliceNode->SetXYZOrigin(10.0, 20.0, 0.0);
+  redSliceNode->SetFieldOfView(100.0, 100.0, 1.0);
+  redSliceNode->SetSliceSpacingModeToPrescribed();
+  redSliceNode->SetPrescribedSliceSpacing(2.0, 2.0, 2.0);
+  redSliceNode->EndModify(wasModifying);
+
+  CHECK_DOUBLE(yellowSliceNode->GetXYZOrigin()[0], 10.0);
+  CHECK_DOUBLE(yellowSliceNode->GetFieldOfView()[0], 100.0);
+  CHECK_INT(yellowSliceNode->GetSliceSpacingMode(), vtkMRMLSliceNode::PrescribedSliceSpacingMode);
+  CHECK_DOUBLE(yellowSliceNode->GetPrescribedSliceSpacing()[2], 2.0);
+
+  // The changes of the broadcast are applied to the linked node with a single modified event
+  CHECK_INT(callback->GetNumberOfModified(), 1);
+  // and the other modified events are counted as batched
+  CHECK_BOOL(logic->GetNumberOfBatchedModifiedEvents() > 0, true);
+  int numberOfBatchedModifiedEvents = logic->GetNumberOfBatchedModifiedEvents();
+
+  // End of the interaction does not broadcast
+  redSliceNode->SetInteracting(0);
+  callback->ResetNumberOfEvents();
+  redSliceNode->SetXYZOrigin(30.0, 20.0, 0.0);
+  CHECK_DOUBLE(yellowSliceNode->GetXYZOrigin()[0], 10.0);
+  CHECK_INT(callback->GetNumberOfModified(), 0);
+  CHECK_INT(logic->GetNumberOfBatchedModifiedEvents(), numberOfBatchedModifiedEvents);
+
+  logic->ResetNumberOfBatchedModifiedEvents();
+  CHECK_INT(logic->GetNumberOfBatchedModifiedEvents(), 0);
+
+  logic->SetMRMLScene(nullptr);
+  return EXIT_SUCCESS;
+}
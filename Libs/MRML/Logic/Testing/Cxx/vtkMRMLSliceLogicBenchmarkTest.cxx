@@ -0,0 +1,116 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// MRMLLogic includes
+#include "vtkMRMLSliceLayerLogic.h"
+#include "vtkMRMLSliceLogic.h"
+
+// MRML includes
+#include "vtkMRMLColorTableNode.h"
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLCoreTestingUtilities.h"
+#include "vtkMRMLScalarVolumeDisplayNode.h"
+#include "vtkMRMLScalarVolumeNode.h"
+#include "vtkMRMLScene.h"
+#include "vtkMRMLSliceCompositeNode.h"
+#include "vtkMRMLSliceNode.h"
+
+// VTK includes
+#include <vtkAlgorithm.h>
+#include <vtkAlgorithmOutput.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+
+//---------------------------------------------------------------------------
+/// Benchmarks of slice view reslicing.
+/// Times are reported as DartMeasurement. If a baseline file is specified as first argument
+/// (see vtkMRMLSliceLogicBenchmarkTestBaselines.txt) then the test fails if any benchmark takes
+/// longer than its baseline.
+int vtkMRMLSliceLogicBenchmarkTest(int argc, char* argv[])
+{
+  std::map<std::string, double> baselines;
+  if (argc > 1)
+    {
+    CHECK_BOOL(vtkMRMLCoreTestingUtilities::ReadBenchmarkBaselines(argv[1], baselines), true);
+    }
+  const int numberOfRepetitions = 3;
+  const int numberOfSlices = 50;
+
+  vtkNew<vtkMRMLScene> scene;
+  vtkMRMLSliceNode::AddDefaultSliceOrientationPresets(scene);
+
+  // Synthetic volume
+  vtkNew<vtkImageData> imageData;
+  imageData->SetDimensions(256, 256, 128);
+  imageData->AllocateScalars(VTK_SHORT, 1);
+  short* voxels = static_cast<short*>(imageData->GetScalarPointer());
+  for (vtkIdType i = 0; i < imageData->GetNumberOfPoints(); ++i)
+    {
+    voxels[i] = static_cast<short>(i % 1000);
+    }
+  vtkNew<vtkMRMLColorTableNode> colorNode;
+  colorNode->SetTypeToGrey();
+  scene->AddNode(colorNode);
+  vtkNew<vtkMRMLScalarVolumeDisplayNode> displayNode;
+  displayNode->SetAutoWindowLevel(false);
+  displayNode->SetWindowLevel(1000, 500);
+  displayNode->SetAndObserveColorNodeID(colorNode->GetID());
+  scene->AddNode(displayNode);
+  vtkNew<vtkMRMLScalarVolumeNode> volumeNode;
+  volumeNode->SetAndObserveImageData(imageData);
+  scene->AddNode(volumeNode);
+  volumeNode->SetAndObserveDisplayNodeID(displayNode->GetID());
+
+  vtkNew<vtkMRMLSliceLogic> sliceLogic;
+  sliceLogic->SetMRMLScene(scene);
+  vtkMRMLSliceNode* sliceNode = sliceLogic->AddSliceNode("Red");
+  CHECK_NOT_NULL(sliceNode);
+  sliceLogic->ResizeSliceNode(512, 512);
+  vtkNew<vtkMRMLSliceLayerLogic> sliceLayerLogic;
+  sliceLogic->SetBackgroundLayer(sliceLayerLogic);
+  sliceLogic->GetSliceCompositeNode()->SetBackgroundVolumeID(volumeNode->GetID());
+  sliceLogic->FitSliceToAll();
+
+  // Move through the volume, reslicing a new slice each time
+  bool success = vtkMRMLCoreTestingUtilities::RunBenchmark("vtkMRMLSliceLogic-Reslice", baselines, numberOfRepetitions,
+    [&]()
+    {
+    for (int sliceIndex = 0; sliceIndex < numberOfSlices; ++sliceIndex)
+      {
+      sliceLogic->SetSliceOffset(sliceIndex - numberOfSlices / 2);
+      vtkAlgorithmOutput* imagePort = sliceLogic->GetImageDataConnection();
+      imagePort->GetProducer()->Update();
+      }
+    });
+
+  // Window/level changes without reslicing
+  success &= vtkMRMLCoreTestingUtilities::RunBenchmark("vtkMRMLSliceLogic-WindowLevel", baselines, numberOfRepetitions,
+    [&]()
+    {
+    for (int i = 0; i < numberOfSlices; ++i)
+      {
+      displayNode->SetWindowLevel(1000 + i, 500);
+      vtkAlgorithmOutput* imagePort = sliceLogic->GetImageDataConnection();
+      imagePort->GetProducer()->Update();
+      }
+    });
+
+  vtkImageData* sliceImage = vtkImageData::SafeDownCast(sliceLogic->GetImageDataConnection()->GetProducer()->GetOutputDataObject(0));
+  CHECK_NOT_NULL(sliceImage);
+  CHECK_INT(sliceImage->GetDimensions()[0], sliceNode->GetDimensions()[0]);
+
+  CHECK_BOOL(success, true);
+  return EXIT_SUCCESS;
+}
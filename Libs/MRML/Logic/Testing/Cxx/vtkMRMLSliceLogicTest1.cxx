@@ -26,6 +26,7 @@
 #include <vtkNew.h>
 
 #include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLCoreTestingUtilities.h"
 
 int vtkMRMLSliceLogicTest1(int , char * [] )
 {
@@ -68,6 +69,37 @@ int vtkMRMLSliceLogicTest1(int , char * [] )
   TEST_GET_OBJECT(logic, SliceModelTransformNode);
   TEST_GET_OBJECT(logic, Blend);
 
+  // Progressive rendering
+  TEST_SET_GET_BOOLEAN(logic, ProgressiveRendering);
+  TEST_SET_GET_INT(logic, ProgressiveRenderingRefinementDelay, 500);
+  CHECK_BOOL(logic->GetReducedQualityRendering(), false);
+  logic->StartSliceNodeInteraction(vtkMRMLSliceNode::SliceToRASFlag);
+  logic->EndSliceNodeInteraction();
+  CHECK_BOOL(logic->GetReducedQualityRendering(), false);
+
+  vtkNew<vtkMRMLCoreTestingUtilities::vtkMRMLNodeCallback> refineRenderingSpy;
+  logic->AddObserver(vtkMRMLSliceLogic::RefineRenderingRequestedEvent, refineRenderingSpy.GetPointer());
+  logic->ProgressiveRenderingOn();
+  logic->StartSliceNodeInteraction(vtkMRMLSliceNode::LabelOutlineFlag);
+  logic->EndSliceNodeInteraction();
+  CHECK_BOOL(logic->GetReducedQualityRendering(), false);
+  CHECK_INT(refineRenderingSpy->GetNumberOfEvents(vtkMRMLSliceLogic::RefineRenderingRequestedEvent), 0);
+  logic->StartSliceNodeInteraction(vtkMRMLSliceNode::SliceToRASFlag);
+  CHECK_BOOL(logic->GetReducedQualityRendering(), true);
+  CHECK_BOOL(BackgroundLayer->GetReducedQualityRendering(), true);
+  CHECK_BOOL(LabelLayer->GetReducedQualityRendering(), true);
+  // the refinement is only requested at the end of the interaction
+  CHECK_INT(refineRenderingSpy->GetNumberOfEvents(vtkMRMLSliceLogic::RefineRenderingRequestedEvent), 0);
+  // and a pending refinement does not interrupt the interaction
+  logic->RefineRendering();
+  CHECK_BOOL(logic->GetReducedQualityRendering(), true);
+  logic->EndSliceNodeInteraction();
+  CHECK_INT(refineRenderingSpy->GetNumberOfEvents(vtkMRMLSliceLogic::RefineRenderingRequestedEvent), 1);
+  CHECK_BOOL(logic->GetReducedQualityRendering(), true);
+  logic->RefineRendering();
+  CHECK_BOOL(logic->GetReducedQualityRendering(), false);
+  CHECK_BOOL(BackgroundLayer->GetReducedQualityRendering(), false);
+
   logic->Print(std::cout);
   return EXIT_SUCCESS;
 }
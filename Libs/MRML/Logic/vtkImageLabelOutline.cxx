@@ -17,9 +17,12 @@
 #include <vtkInformation.h>
 #include "vtkObjectFactory.h"
 #include "vtkImageData.h"
-#include <vtkStreamingDemandDrivenPipeline.h>
 #include <vtkVersion.h>
 
+// STD includes
+#include <algorithm>
+#include <vector>
+
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkImageLabelOutline);
 
@@ -42,79 +45,80 @@ vtkImageLabelOutline::~vtkImageLabelOutline() = default;
 
 // Description:
 // This templated function executes the filter for any type of data.
+//
+// A non-background pixel is an outline pixel if its (2*Outline+1)^2 in-slice
+// neighborhood contains a different label or reaches outside of the image.
+// Instead of visiting the neighborhood of every pixel, the neighborhood is
+// checked in two separable passes, so that the cost per pixel does not
+// depend on the outline thickness:
+//  - rows: a pixel is "row uniform" if the runs of identical labels on its
+//    left and on its right are both longer than Outline.
+//  - columns: a pixel is inside a label if it ends a vertical run of
+//    2*Outline+1 row uniform pixels of the same label centered on it.
 template <class T>
 static void vtkImageLabelOutlineExecute(vtkImageLabelOutline *self,
-                     vtkImageData *inData, T *vtkNotUsed(inPtr),
-                     vtkImageData *outData,
+                     vtkImageData *inData, vtkImageData *outData,
                      int outExt[6], int id)
 {
-  int *kernelMiddle, *kernelSize;
-  // For looping though output (and input) pixels.
-  int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
-  int outIdx0, outIdx1, outIdx2;
-  vtkIdType inInc0, inInc1, inInc2;
-  vtkIdType outInc0, outInc1, outInc2;
-  T *inPtr0, *inPtr1, *inPtr2;
-  T *outPtr0, *outPtr1, *outPtr2;
-  // For looping through hood pixels
-  int hoodMin0, hoodMax0, hoodMin1, hoodMax1, hoodMin2, hoodMax2;
-  int hoodIdx0, hoodIdx1, hoodIdx2;
-  T *hoodPtr0, *hoodPtr1, *hoodPtr2;
-  // The extent of the whole input image
-  int inImageMin0, inImageMin1, inImageMin2;
-  int inImageMax0, inImageMax1, inImageMax2;
-  // Other
-  T backgroundLabelValue = (T)(self->GetBackground());
-  T inLabelValue;
-  T *outPtr = (T*)outData->GetScalarPointerForExtent(outExt);
-  unsigned long count = 0;
-  unsigned long target;
-
-  // Get information to march through data
+  const T backgroundLabelValue = static_cast<T>(self->GetBackground());
+  const int outline = std::max(self->GetOutline(), 0);
+
+  // The input extent is the output extent padded by the outline thickness,
+  // clipped to the whole extent: neighborhoods reaching its border reach
+  // outside of the image.
+  int* inExt = inData->GetExtent();
+  const int inMin0 = std::max(outExt[0] - outline, inExt[0]);
+  const int inMax0 = std::min(outExt[1] + outline, inExt[1]);
+  const int inMin1 = std::max(outExt[2] - outline, inExt[2]);
+  const int inMax1 = std::min(outExt[3] + outline, inExt[3]);
+  const int size0 = inMax0 - inMin0 + 1;
+  const int size1 = inMax1 - inMin1 + 1;
+  if (size0 <= 0 || size1 <= 0)
+    {
+    return;
+    }
 
+  vtkIdType inInc0, inInc1, inInc2;
   inData->GetIncrements(inInc0, inInc1, inInc2);
-  int inExt[6];
-  self->GetInputInformation()->Get(
-        vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), inExt);
-  inImageMin0 = inExt[0]; inImageMax0 = inExt[1];
-  inImageMin1 = inExt[2]; inImageMax1 = inExt[3];
-  inImageMin2 = inExt[4]; inImageMax2 = inExt[5];
+  vtkIdType outInc0, outInc1, outInc2;
   outData->GetIncrements(outInc0, outInc1, outInc2);
-  outMin0 = outExt[0];   outMax0 = outExt[1];
-  outMin1 = outExt[2];   outMax1 = outExt[3];
-  outMin2 = outExt[4];   outMax2 = outExt[5];
 
-  // Neighborhood around current voxel
-  kernelSize = self->GetKernelSize();
-  kernelMiddle = self->GetKernelMiddle();
-  hoodMin0 = kernelMiddle[0] - kernelSize[0]/2; // truncate on purpose
-  hoodMin1 = kernelMiddle[1] - kernelSize[1]/2; // to round down odd sizes
-  hoodMin2 = kernelMiddle[2] - kernelSize[2]/2;
-  hoodMax0 = hoodMin0 + kernelSize[0];
-  hoodMax1 = hoodMin1 + kernelSize[1];
-  hoodMax2 = hoodMin2 + kernelSize[2];
+  // Length of the run of identical labels ending at each pixel of a row
+  std::vector<int> leftRuns(size0);
+  // Row uniform flag of each pixel of the slice
+  std::vector<unsigned char> rowUniform(static_cast<size_t>(size0) * size1);
+  // Length of the vertical run of row uniform pixels of the same label
+  // ending at each pixel of the current row
+  std::vector<int> columnRuns(size0);
 
-  int outline = self->GetOutline();
-  hoodMin0 = - outline;
-  hoodMin1 = - outline;
-  hoodMin2 = 0;
-  hoodMax0 = outline;
-  hoodMax1 = outline;
-  hoodMax2 = 0;
-
-  // in and out should be marching through corresponding pixels.
-  target = (unsigned long)((outMax2-outMin2+1)*(outMax1-outMin1+1)/50.0);
+  unsigned long count = 0;
+  unsigned long target = static_cast<unsigned long>((outExt[5] - outExt[4] + 1) * size1 / 50.0);
   target++;
 
-  // loop through pixels of output
-  outPtr2 = outPtr;
-  inPtr2 = (T*)(inData->GetScalarPointer(outMin0, outMin1, outMin2));
-  for (outIdx2 = outMin2; outIdx2 <= outMax2; outIdx2++)
+  for (int outIdx2 = outExt[4]; outIdx2 <= outExt[5] && !self->AbortExecute; ++outIdx2)
     {
-    outPtr1 = outPtr2;
-    inPtr1 = inPtr2;
-    for (outIdx1 = outMin1;
-      !self->AbortExecute && outIdx1 <= outMax1; outIdx1++)
+    // Rows pass
+    for (int idx1 = 0; idx1 < size1; ++idx1)
+      {
+      const T* inRow = static_cast<T*>(inData->GetScalarPointer(inMin0, inMin1 + idx1, outIdx2));
+      leftRuns[0] = 1;
+      for (int idx0 = 1; idx0 < size0; ++idx0)
+        {
+        leftRuns[idx0] = (inRow[idx0 * inInc0] == inRow[(idx0 - 1) * inInc0]) ? leftRuns[idx0 - 1] + 1 : 1;
+        }
+      unsigned char* uniform = &rowUniform[static_cast<size_t>(idx1) * size0];
+      int rightRun = 0;
+      for (int idx0 = size0 - 1; idx0 >= 0; --idx0)
+        {
+        rightRun = (idx0 < size0 - 1 && inRow[idx0 * inInc0] == inRow[(idx0 + 1) * inInc0]) ? rightRun + 1 : 1;
+        uniform[idx0] = (leftRuns[idx0] > outline && rightRun > outline);
+        }
+      }
+
+    // Columns pass, output row outIdx1 is complete once its neighborhood
+    // (rows outIdx1 - outline to outIdx1 + outline) has been visited
+    std::fill(columnRuns.begin(), columnRuns.end(), 0);
+    for (int idx1 = 0; idx1 < size1 && !self->AbortExecute; ++idx1)
       {
       if (!id)
         {
@@ -124,74 +128,54 @@ static void vtkImageLabelOutlineExecute(vtkImageLabelOutline *self,
           }
         count++;
         }
-      outPtr0 = outPtr1;
-      inPtr0 = inPtr1;
-      for (outIdx0 = outMin0; outIdx0 <= outMax0; outIdx0++)
+      const T* inRow = static_cast<T*>(inData->GetScalarPointer(inMin0, inMin1 + idx1, outIdx2));
+      const unsigned char* uniform = &rowUniform[static_cast<size_t>(idx1) * size0];
+      for (int idx0 = 0; idx0 < size0; ++idx0)
         {
-        inLabelValue = *inPtr0;
-        // Default output equal to backgroundLabelValue
-        // on the assumption this is not an outline pixel
-        *outPtr0 = backgroundLabelValue;
-
-        // look at neighborhood around non-background
-        // pixels to see if there is a transition.
-        // If there is, then this is an outline pixel
-        if (inLabelValue != backgroundLabelValue)
+        if (!uniform[idx0])
           {
-          // Loop through neighborhood pixels
-          // Note: hood pointer marches out of bounds.
-          // start at lower left pixel
-          hoodPtr2 = inPtr0 + hoodMin0 * inInc0
-                            + hoodMin1 * inInc1
-                            + hoodMin2 * inInc2;
+          columnRuns[idx0] = 0;
+          }
+        else if (columnRuns[idx0] > 0 && inRow[idx0 * inInc0] == inRow[idx0 * inInc0 - inInc1])
+          {
+          ++columnRuns[idx0];
+          }
+        else
+          {
+          columnRuns[idx0] = 1;
+          }
+        }
+
+      const int outIdx1 = inMin1 + idx1 - outline;
+      if (outIdx1 < outExt[2] || outIdx1 > outExt[3])
+        {
+        continue;
+        }
+      const T* inPtr0 = static_cast<T*>(inData->GetScalarPointer(outExt[0], outIdx1, outIdx2));
+      T* outPtr0 = static_cast<T*>(outData->GetScalarPointer(outExt[0], outIdx1, outIdx2));
+      for (int outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
+        {
+        const T inLabelValue = *inPtr0;
+        const bool inside = columnRuns[outIdx0 - inMin0] > 2 * outline;
+        *outPtr0 = (inLabelValue == backgroundLabelValue || inside) ? backgroundLabelValue : inLabelValue;
+        inPtr0 += inInc0;
+        outPtr0 += outInc0;
+        }
+      }
 
-          for (hoodIdx2 = hoodMin2; hoodIdx2 <= hoodMax2; ++hoodIdx2)
-            {
-            hoodPtr1 = hoodPtr2;
-            for (hoodIdx1 = hoodMin1; hoodIdx1 <= hoodMax1; ++hoodIdx1)
-              {
-              hoodPtr0 = hoodPtr1;
-              for (hoodIdx0 = hoodMin0; hoodIdx0 <= hoodMax0; ++hoodIdx0)
-                {
-                // handle boundaries
-                if (outIdx0 + hoodIdx0 >= inImageMin0 &&
-                    outIdx0 + hoodIdx0 <= inImageMax0 &&
-                    outIdx1 + hoodIdx1 >= inImageMin1 &&
-                    outIdx1 + hoodIdx1 <= inImageMax1 &&
-                    outIdx2 + hoodIdx2 >= inImageMin2 &&
-                    outIdx2 + hoodIdx2 <= inImageMax2)
-                  {
-                  // If the neighbor value is not the same label value
-                  // that means this is an outline pixel
-                  // (border is within neighborhood).
-                  // so set the output to foreground
-                  if (*hoodPtr0 != inLabelValue)
-                    {
-                    *outPtr0 = inLabelValue;
-                    }
-                  }
-                else
-                  {
-                  // neighborhood reaches outside of the input
-                  // domain, so this is also an outline pixel
-                  *outPtr0 = inLabelValue;
-                  }
-                hoodPtr0 += inInc0;
-                }//for0
-              hoodPtr1 += inInc1;
-              }//for1
-            hoodPtr2 += inInc2;
-            }//for2
-          }//if
+    // The neighborhood of the last rows reaches outside of the image
+    for (int outIdx1 = std::max(outExt[2], inMax1 - outline + 1); outIdx1 <= outExt[3]; ++outIdx1)
+      {
+      const T* inPtr0 = static_cast<T*>(inData->GetScalarPointer(outExt[0], outIdx1, outIdx2));
+      T* outPtr0 = static_cast<T*>(outData->GetScalarPointer(outExt[0], outIdx1, outIdx2));
+      for (int outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
+        {
+        *outPtr0 = *inPtr0;
         inPtr0 += inInc0;
         outPtr0 += outInc0;
-        }//for0
-      inPtr1 += inInc1;
-      outPtr1 += outInc1;
-      }//for1
-    inPtr2 += inInc2;
-    outPtr2 += outInc2;
-    }//for2
+        }
+      }
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -214,54 +198,9 @@ void vtkImageLabelOutline::ThreadedExecute(vtkImageData *inData,
   }
 
 
-  void *inPtr = inData->GetScalarPointerForExtent(outExt);
-
   switch (inData->GetScalarType())
     {
-  case VTK_DOUBLE:
-    vtkImageLabelOutlineExecute(this, inData, (double *)(inPtr),
-      outData, outExt, id);
-    break;
-  case VTK_FLOAT:
-    vtkImageLabelOutlineExecute(this, inData, (float *)(inPtr),
-      outData, outExt, id);
-    break;
-  case VTK_LONG:
-    vtkImageLabelOutlineExecute(this, inData, (long *)(inPtr),
-      outData, outExt, id);
-    break;
-  case VTK_UNSIGNED_LONG:
-    vtkImageLabelOutlineExecute(this, inData, (unsigned long *)(inPtr),
-      outData, outExt, id);
-    break;
-  case VTK_INT:
-    vtkImageLabelOutlineExecute(this, inData, (int *)(inPtr),
-      outData, outExt, id);
-    break;
-  case VTK_UNSIGNED_INT:
-    vtkImageLabelOutlineExecute(this, inData, (unsigned int *)(inPtr),
-      outData, outExt, id);
-    break;
-  case VTK_SHORT:
-    vtkImageLabelOutlineExecute(this, inData, (short *)(inPtr),
-      outData, outExt, id);
-    break;
-  case VTK_UNSIGNED_SHORT:
-    vtkImageLabelOutlineExecute(this, inData, (unsigned short *)(inPtr),
-      outData, outExt, id);
-    break;
-  case VTK_CHAR:
-    vtkImageLabelOutlineExecute(this, inData, (char *)(inPtr),
-      outData, outExt, id);
-    break;
-  case VTK_SIGNED_CHAR:
-    vtkImageLabelOutlineExecute(this, inData, (signed char *)(inPtr),
-      outData, outExt, id);
-    break;
-  case VTK_UNSIGNED_CHAR:
-    vtkImageLabelOutlineExecute(this, inData, (unsigned char *)(inPtr),
-      outData, outExt, id);
-    break;
+    vtkTemplateMacro(vtkImageLabelOutlineExecute<VTK_TT>(this, inData, outData, outExt, id));
   default:
     vtkErrorMacro(<< "Execute: Unknown input ScalarType");
     return;
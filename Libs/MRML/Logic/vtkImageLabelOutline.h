@@ -25,6 +25,11 @@ class vtkImageData;
 ///
 /// Used  in slicer for the Label layer to outline the segmented
 /// structures (instead of showing them filled-in).
+///
+/// Each slice of the input is processed independently. A non-background
+/// pixel is kept if a pixel with a different label, or the border of the
+/// image, is within Outline pixels of it (in both directions of the slice).
+/// The cost per pixel does not depend on the outline thickness.
 class VTK_MRML_LOGIC_EXPORT vtkImageLabelOutline : public vtkImageNeighborhoodFilter
 {
 public:
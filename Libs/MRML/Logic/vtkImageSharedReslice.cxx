@@ -0,0 +1,450 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#include "vtkImageSharedReslice.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkImageStencilData.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkMath.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
+#include <vtkTransform.h>
+
+// STD includes
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Everything the output of a reslice depends on
+struct OutputKey
+{
+  vtkImageData* Input{nullptr};
+  vtkMTimeType InputMTime{0};
+  double ResliceMatrix[16];
+  int Extent[6];
+  double Spacing[3];
+  double Origin[3];
+  int InterpolationMode{0};
+  int SlabMode{0};
+  int SlabNumberOfSlices{0};
+  double BackgroundColor[4];
+  int OutputScalarType{0};
+  int GenerateStencilOutput{0};
+  int Wrap{0};
+  int Mirror{0};
+  int Border{0};
+
+  bool operator==(const OutputKey& other) const
+    {
+    return this->Input == other.Input
+      && this->InputMTime == other.InputMTime
+      && std::equal(this->ResliceMatrix, this->ResliceMatrix + 16, other.ResliceMatrix)
+      && std::equal(this->Extent, this->Extent + 6, other.Extent)
+      && std::equal(this->Spacing, this->Spacing + 3, other.Spacing)
+      && std::equal(this->Origin, this->Origin + 3, other.Origin)
+      && this->InterpolationMode == other.InterpolationMode
+      && this->SlabMode == other.SlabMode
+      && this->SlabNumberOfSlices == other.SlabNumberOfSlices
+      && std::equal(this->BackgroundColor, this->BackgroundColor + 4, other.BackgroundColor)
+      && this->OutputScalarType == other.OutputScalarType
+      && this->GenerateStencilOutput == other.GenerateStencilOutput
+      && this->Wrap == other.Wrap
+      && this->Mirror == other.Mirror
+      && this->Border == other.Border;
+    }
+};
+
+//----------------------------------------------------------------------------
+struct SharedOutput
+{
+  vtkImageSharedReslice* Reslice;
+  OutputKey Key;
+};
+
+//----------------------------------------------------------------------------
+/// Latest output of all the shared reslices
+std::vector<SharedOutput>& GetSharedOutputs()
+{
+  static std::vector<SharedOutput> sharedOutputs;
+  return sharedOutputs;
+}
+
+//----------------------------------------------------------------------------
+void RemoveSharedOutput(vtkImageSharedReslice* reslice)
+{
+  std::vector<SharedOutput>& sharedOutputs = GetSharedOutputs();
+  sharedOutputs.erase(std::remove_if(sharedOutputs.begin(), sharedOutputs.end(),
+    [reslice](const SharedOutput& sharedOutput) { return sharedOutput.Reslice == reslice; }),
+    sharedOutputs.end());
+}
+
+//----------------------------------------------------------------------------
+int FloorDivide(int numerator, int denominator)
+{
+  int quotient = numerator / denominator;
+  if ((numerator % denominator != 0) && ((numerator < 0) != (denominator < 0)))
+    {
+    --quotient;
+    }
+  return quotient;
+}
+
+//----------------------------------------------------------------------------
+/// Copy the rows of \a outExt. The output voxel (x, y, z) is the input voxel
+/// indexMatrix * (x, y, z, 1), output rows are along \a rowAxis of the input.
+/// Voxels outside of the input are set to \a background.
+template <class T>
+void vtkImageSharedResliceCopy(vtkImageData* inData, vtkImageData* outData,
+  const int outExt[6], const int indexMatrix[3][4], int rowAxis,
+  const double background[4], vtkImageStencilData* stencil)
+{
+  const int* inExt = inData->GetExtent();
+  vtkIdType* inIncrements = inData->GetIncrements();
+  int numberOfComponents = outData->GetNumberOfScalarComponents();
+  std::vector<T> backgroundValues(numberOfComponents, static_cast<T>(0));
+  for (int c = 0; c < numberOfComponents && c < 4; ++c)
+    {
+    backgroundValues[c] = static_cast<T>(background[c]);
+    }
+  int step = indexMatrix[rowAxis][0];
+  vtkIdType inStep = step * inIncrements[rowAxis];
+
+  T* outPtr = static_cast<T*>(outData->GetScalarPointerForExtent(const_cast<int*>(outExt)));
+  for (int z = outExt[4]; z <= outExt[5]; ++z)
+    {
+    for (int y = outExt[2]; y <= outExt[3]; ++y)
+      {
+      // input index of the first voxel of the row
+      int firstIndex[3];
+      bool rowInside = true;
+      for (int r = 0; r < 3; ++r)
+        {
+        firstIndex[r] = indexMatrix[r][0] * outExt[0] + indexMatrix[r][1] * y
+          + indexMatrix[r][2] * z + indexMatrix[r][3];
+        if (r != rowAxis && (firstIndex[r] < inExt[2 * r] || firstIndex[r] > inExt[2 * r + 1]))
+          {
+          rowInside = false;
+          }
+        }
+      // voxels xMin to xMax of the row are inside the input
+      int xMin = outExt[1] + 1;
+      int xMax = outExt[1];
+      if (rowInside)
+        {
+        int lower = inExt[2 * rowAxis] - firstIndex[rowAxis];
+        int upper = inExt[2 * rowAxis + 1] - firstIndex[rowAxis];
+        if (step > 0)
+          {
+          xMin = outExt[0] + FloorDivide(lower + step - 1, step);
+          xMax = outExt[0] + FloorDivide(upper, step);
+          }
+        else
+          {
+          xMin = outExt[0] + FloorDivide(upper + step + 1, step);
+          xMax = outExt[0] + FloorDivide(lower, step);
+          }
+        xMin = std::max(xMin, outExt[0]);
+        xMax = std::min(xMax, outExt[1]);
+        }
+      if (xMin > xMax)
+        {
+        xMin = outExt[1] + 1;
+        xMax = outExt[1];
+        }
+      for (int x = outExt[0]; x < xMin; ++x)
+        {
+        outPtr = std::copy(backgroundValues.begin(), backgroundValues.end(), outPtr);
+        }
+      if (xMin <= xMax)
+        {
+        int index[3] = { firstIndex[0], firstIndex[1], firstIndex[2] };
+        index[rowAxis] += (xMin - outExt[0]) * step;
+        const T* inPtr = static_cast<const T*>(inData->GetScalarPointer(index));
+        for (int x = xMin; x <= xMax; ++x, inPtr += inStep)
+          {
+          outPtr = std::copy(inPtr, inPtr + numberOfComponents, outPtr);
+          }
+        if (stencil)
+          {
+          stencil->InsertNextExtent(xMin, xMax, y, z);
+          }
+        }
+      for (int x = xMax + 1; x <= outExt[1]; ++x)
+        {
+        outPtr = std::copy(backgroundValues.begin(), backgroundValues.end(), outPtr);
+        }
+      }
+    }
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkImageSharedReslice);
+
+//----------------------------------------------------------------------------
+vtkImageSharedReslice::vtkImageSharedReslice()
+{
+  this->ShareOutput = true;
+  this->SharedOutputCount = 0;
+  this->AxisAlignedCopy = true;
+  this->AxisAlignedCopyCount = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkImageSharedReslice::~vtkImageSharedReslice()
+{
+  RemoveSharedOutput(this);
+}
+
+//----------------------------------------------------------------------------
+void vtkImageSharedReslice::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "ShareOutput: " << this->ShareOutput << "\n";
+  os << indent << "SharedOutputCount: " << this->SharedOutputCount << "\n";
+  os << indent << "AxisAlignedCopy: " << this->AxisAlignedCopy << "\n";
+  os << indent << "AxisAlignedCopyCount: " << this->AxisAlignedCopyCount << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkImageSharedReslice::ResetSharedOutputCount()
+{
+  this->SharedOutputCount = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkImageSharedReslice::ResetAxisAlignedCopyCount()
+{
+  this->AxisAlignedCopyCount = 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageSharedReslice::RequestData(vtkInformation* request,
+                                       vtkInformationVector** inputVector,
+                                       vtkInformationVector* outputVector)
+{
+  // The previous output is about to be replaced
+  RemoveSharedOutput(this);
+
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkImageData* input = vtkImageData::GetData(inInfo);
+  vtkTransform* transform = vtkTransform::SafeDownCast(this->GetResliceTransform());
+  bool shareable = this->ShareOutput && input
+    && (transform || !this->GetResliceTransform())
+    && !this->GetResliceAxes() && !this->GetInterpolator();
+  if (!shareable)
+    {
+    if (this->RequestDataAxisAligned(inputVector, outputVector))
+      {
+      return 1;
+      }
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+    }
+
+  OutputKey key;
+  key.Input = input;
+  key.InputMTime = input->GetMTime();
+  vtkNew<vtkMatrix4x4> identity;
+  vtkMatrix4x4* matrix = transform ? transform->GetMatrix() : identity.GetPointer();
+  std::copy(&matrix->Element[0][0], &matrix->Element[0][0] + 16, key.ResliceMatrix);
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), key.Extent);
+  outInfo->Get(vtkDataObject::SPACING(), key.Spacing);
+  outInfo->Get(vtkDataObject::ORIGIN(), key.Origin);
+  key.InterpolationMode = this->GetInterpolationMode();
+  key.SlabMode = this->GetSlabMode();
+  key.SlabNumberOfSlices = this->GetSlabNumberOfSlices();
+  this->GetBackgroundColor(key.BackgroundColor);
+  key.OutputScalarType = this->GetOutputScalarType();
+  key.GenerateStencilOutput = this->GetGenerateStencilOutput();
+  key.Wrap = this->GetWrap();
+  key.Mirror = this->GetMirror();
+  key.Border = this->GetBorder();
+
+  std::vector<SharedOutput>& sharedOutputs = GetSharedOutputs();
+  std::vector<SharedOutput>::iterator sharedIt = std::find_if(sharedOutputs.begin(), sharedOutputs.end(),
+    [&key](const SharedOutput& sharedOutput) { return sharedOutput.Key == key; });
+  int result = 1;
+  if (sharedIt != sharedOutputs.end())
+    {
+    // The scalars are shared, they are not reused when the other reslice
+    // executes again because vtkImageData only reuses unreferenced arrays.
+    vtkImageData* output = vtkImageData::GetData(outInfo);
+    output->ShallowCopy(sharedIt->Reslice->GetOutputDataObject(0));
+    if (this->GetGenerateStencilOutput())
+      {
+      vtkImageStencilData* stencil = vtkImageStencilData::GetData(outputVector, 1);
+      vtkImageStencilData* sharedStencil =
+        vtkImageStencilData::SafeDownCast(sharedIt->Reslice->GetOutputDataObject(1));
+      if (stencil && sharedStencil)
+        {
+        stencil->ShallowCopy(sharedStencil);
+        }
+      }
+    ++this->SharedOutputCount;
+    }
+  else if (!this->RequestDataAxisAligned(inputVector, outputVector))
+    {
+    result = this->Superclass::RequestData(request, inputVector, outputVector);
+    }
+
+  if (result)
+    {
+    SharedOutput sharedOutput;
+    sharedOutput.Reslice = this;
+    sharedOutput.Key = key;
+    sharedOutputs.push_back(sharedOutput);
+    }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+bool vtkImageSharedReslice::RequestDataAxisAligned(vtkInformationVector** inputVector,
+                                                   vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkImageData* input = vtkImageData::GetData(inInfo);
+  vtkImageData* output = vtkImageData::GetData(outInfo);
+  vtkTransform* transform = vtkTransform::SafeDownCast(this->GetResliceTransform());
+  if (!this->AxisAlignedCopy || !input || !output
+    || !input->GetPointData()->GetScalars()
+    || (!transform && this->GetResliceTransform())
+    || this->GetResliceAxes() || this->GetInterpolator()
+    || this->GetSlabNumberOfSlices() > 1 || this->GetWrap() || this->GetMirror()
+    || (this->GetOutputScalarType() >= 0 && this->GetOutputScalarType() != input->GetScalarType())
+    || !input->GetDirectionMatrix()->IsIdentity())
+    {
+    return false;
+    }
+
+  // Matrix mapping output indices to input indices
+  vtkNew<vtkMatrix4x4> matrix;
+  if (transform)
+    {
+    matrix->DeepCopy(transform->GetMatrix());
+    }
+  if (matrix->Element[3][0] != 0. || matrix->Element[3][1] != 0.
+    || matrix->Element[3][2] != 0. || matrix->Element[3][3] != 1.)
+    {
+    return false;
+    }
+  double outSpacing[3] = { 1., 1., 1. };
+  double outOrigin[3] = { 0., 0., 0. };
+  outInfo->Get(vtkDataObject::SPACING(), outSpacing);
+  outInfo->Get(vtkDataObject::ORIGIN(), outOrigin);
+  double* inSpacing = input->GetSpacing();
+  double* inOrigin = input->GetOrigin();
+  // output voxels closer than this to an input voxel are considered on it
+  const double tolerance = 1e-4;
+  int indexMatrix[3][4];
+  int rowAxis = -1;
+  for (int r = 0; r < 3; ++r)
+    {
+    double values[4];
+    values[3] = matrix->Element[r][3];
+    for (int c = 0; c < 3; ++c)
+      {
+      values[c] = matrix->Element[r][c] * outSpacing[c] / inSpacing[r];
+      values[3] += matrix->Element[r][c] * outOrigin[c];
+      }
+    values[3] = (values[3] - inOrigin[r]) / inSpacing[r];
+    int numberOfNonZeroColumns = 0;
+    for (int c = 0; c < 4; ++c)
+      {
+      indexMatrix[r][c] = vtkMath::Round(values[c]);
+      if (fabs(values[c] - indexMatrix[r][c]) > tolerance)
+        {
+        // output voxels are between input voxels
+        return false;
+        }
+      if (c < 3 && indexMatrix[r][c] != 0)
+        {
+        ++numberOfNonZeroColumns;
+        }
+      }
+    if (numberOfNonZeroColumns != 1)
+      {
+      return false;
+      }
+    if (indexMatrix[r][0] != 0)
+      {
+      rowAxis = r;
+      }
+    }
+  if (rowAxis < 0)
+    {
+    return false;
+    }
+  // each output axis must map to a different input axis
+  for (int c = 1; c < 3; ++c)
+    {
+    int numberOfNonZeroRows = 0;
+    for (int r = 0; r < 3; ++r)
+      {
+      numberOfNonZeroRows += (indexMatrix[r][c] != 0 ? 1 : 0);
+      }
+    if (numberOfNonZeroRows != 1)
+      {
+      return false;
+      }
+    }
+
+  int outExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
+  output->SetExtent(outExt);
+  output->AllocateScalars(outInfo);
+  if (output->GetScalarType() != input->GetScalarType()
+    || output->GetNumberOfScalarComponents() != input->GetNumberOfScalarComponents())
+    {
+    return false;
+    }
+  output->GetPointData()->GetScalars()->SetName(input->GetPointData()->GetScalars()->GetName());
+
+  vtkImageStencilData* stencil = nullptr;
+  if (this->GetGenerateStencilOutput())
+    {
+    stencil = vtkImageStencilData::GetData(outputVector, 1);
+    if (stencil)
+      {
+      stencil->SetSpacing(outSpacing);
+      stencil->SetOrigin(outOrigin);
+      stencil->SetExtent(outExt);
+      stencil->AllocateExtents();
+      }
+    }
+
+  double* background = this->GetBackgroundColor();
+  switch (output->GetScalarType())
+    {
+    vtkTemplateMacro(vtkImageSharedResliceCopy<VTK_TT>(input, output, outExt,
+      indexMatrix, rowAxis, background, stencil));
+    default:
+      return false;
+    }
+  ++this->AxisAlignedCopyCount;
+  return true;
+}
@@ -0,0 +1,101 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __vtkImageSharedReslice_h
+#define __vtkImageSharedReslice_h
+
+#include <vtkImageReslice.h>
+
+#include "vtkMRMLLogicExport.h"
+
+/// \brief vtkImageReslice that shares its output with identical reslices.
+///
+/// Used by vtkMRMLSliceLayerLogic: when several slice views show the same
+/// volume with the same slice geometry (e.g. linked compare views), the
+/// first reslice to execute computes the image and the others shallow copy
+/// its output instead of reslicing again.
+///
+/// Two reslices are identical if they have the same input image data (same
+/// object, not modified since), the same linear reslice transform, the same
+/// output extent, spacing and origin, and the same interpolation, slab and
+/// background settings. Reslices with a non-linear transform, reslice axes
+/// or a custom interpolator are never shared.
+///
+/// The result of a reslice is available to the others until it executes
+/// again or is deleted. Must only be used on the main thread.
+///
+/// If the reslice transform maps every output voxel exactly onto an input
+/// voxel (axis-aligned linear transform with integer steps and offsets, as
+/// for a slice view aligned with the volume at a 1:1 or integer zoom), the
+/// voxels are copied row by row without evaluating the transform nor
+/// interpolating, see AxisAlignedCopy.
+class VTK_MRML_LOGIC_EXPORT vtkImageSharedReslice : public vtkImageReslice
+{
+public:
+  static vtkImageSharedReslice *New();
+  vtkTypeMacro(vtkImageSharedReslice,vtkImageReslice);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///
+  /// Copy the output of an identical reslice instead of computing it,
+  /// and let the other reslices copy the output of this one.
+  /// Enabled by default.
+  vtkSetMacro(ShareOutput, bool);
+  vtkGetMacro(ShareOutput, bool);
+  vtkBooleanMacro(ShareOutput, bool);
+
+  ///
+  /// Number of executions that copied the output of another reslice.
+  vtkGetMacro(SharedOutputCount, int);
+  void ResetSharedOutputCount();
+
+  ///
+  /// Copy the input voxels when the reslice transform maps output voxels
+  /// onto input voxels. The result is the same as with any interpolation
+  /// mode, without slab, wrap or mirror.
+  /// Enabled by default.
+  vtkSetMacro(AxisAlignedCopy, bool);
+  vtkGetMacro(AxisAlignedCopy, bool);
+  vtkBooleanMacro(AxisAlignedCopy, bool);
+
+  ///
+  /// Number of executions that copied the input voxels.
+  vtkGetMacro(AxisAlignedCopyCount, int);
+  void ResetAxisAlignedCopyCount();
+
+protected:
+  vtkImageSharedReslice();
+  ~vtkImageSharedReslice() override;
+
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+                  vtkInformationVector* outputVector) override;
+
+  /// Copy the input voxels into the output if the output to input index
+  /// mapping is a permutation with integer steps and offsets.
+  /// Returns false if the mapping is not of that kind.
+  bool RequestDataAxisAligned(vtkInformationVector** inputVector,
+                              vtkInformationVector* outputVector);
+
+  bool ShareOutput;
+  int SharedOutputCount;
+  bool AxisAlignedCopy;
+  int AxisAlignedCopyCount;
+
+private:
+  vtkImageSharedReslice(const vtkImageSharedReslice&) = delete;
+  void operator=(const vtkImageSharedReslice&) = delete;
+};
+
+#endif
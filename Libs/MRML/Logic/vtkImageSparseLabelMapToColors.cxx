@@ -0,0 +1,185 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#include "vtkImageSparseLabelMapToColors.h"
+
+// VTK includes
+#include <vtkDataObject.h>
+#include <vtkImageData.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkLookupTable.h>
+#include <vtkObjectFactory.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
+
+// STD includes
+#include <algorithm>
+#include <cstring>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkImageSparseLabelMapToColors);
+
+//----------------------------------------------------------------------------
+vtkImageSparseLabelMapToColors::vtkImageSparseLabelMapToColors() = default;
+
+//----------------------------------------------------------------------------
+vtkImageSparseLabelMapToColors::~vtkImageSparseLabelMapToColors() = default;
+
+//----------------------------------------------------------------------------
+void vtkImageSparseLabelMapToColors::SetColorTableNode(vtkMRMLColorTableNode* colorTableNode)
+{
+  if (this->ColorTableNode == colorTableNode)
+    {
+    return;
+    }
+  this->ColorTableNode = colorTableNode;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkMRMLColorTableNode* vtkImageSparseLabelMapToColors::GetColorTableNode()
+{
+  return this->ColorTableNode;
+}
+
+//----------------------------------------------------------------------------
+vtkMTimeType vtkImageSparseLabelMapToColors::GetMTime()
+{
+  vtkMTimeType mTime = this->Superclass::GetMTime();
+  if (this->ColorTableNode && this->ColorTableNode->GetLookupTable())
+    {
+    mTime = std::max(mTime, this->ColorTableNode->GetLookupTable()->GetMTime());
+    }
+  return mTime;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageSparseLabelMapToColors::RequestInformation(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_UNSIGNED_CHAR, 4);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkImageSparseLabelMapToColors::RequestData(vtkInformation* request,
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // The color map is updated here, so that the threads only read it
+  this->ExecuteColorMap = nullptr;
+  this->ExecuteColorMapRange[0] = 0;
+  this->ExecuteColorMapRange[1] = -1;
+  if (this->ColorTableNode)
+    {
+    this->ExecuteColorMap = &this->ColorTableNode->GetSparseLabelColorMap();
+    this->ColorTableNode->GetSparseLabelColorMapRange(this->ExecuteColorMapRange);
+    }
+  int result = this->Superclass::RequestData(request, inputVector, outputVector);
+  this->ExecuteColorMap = nullptr;
+  return result;
+}
+
+//----------------------------------------------------------------------------
+namespace
+{
+template <class T>
+void vtkImageSparseLabelMapToColorsExecute(vtkImageData* inData, vtkImageData* outData, int outExt[6],
+  const vtkMRMLColorTableNode::SparseLabelColorMapType& colorMap, const int colorMapRange[2])
+{
+  vtkIdType inInc0 = 0;
+  vtkIdType inInc1 = 0;
+  vtkIdType inInc2 = 0;
+  inData->GetContinuousIncrements(outExt, inInc0, inInc1, inInc2);
+  vtkIdType outInc0 = 0;
+  vtkIdType outInc1 = 0;
+  vtkIdType outInc2 = 0;
+  outData->GetContinuousIncrements(outExt, outInc0, outInc1, outInc2);
+  int numberOfInputComponents = inData->GetNumberOfScalarComponents();
+
+  const T* inPtr = static_cast<const T*>(inData->GetScalarPointerForExtent(outExt));
+  unsigned char* outPtr = static_cast<unsigned char*>(outData->GetScalarPointerForExtent(outExt));
+
+  // Color of the previous voxel, reused if the label is the same
+  bool previousValid = false;
+  T previousLabel = 0;
+  vtkTypeUInt32 previousColor = 0;
+  for (int idx2 = outExt[4]; idx2 <= outExt[5]; ++idx2)
+    {
+    for (int idx1 = outExt[2]; idx1 <= outExt[3]; ++idx1)
+      {
+      for (int idx0 = outExt[0]; idx0 <= outExt[1]; ++idx0)
+        {
+        T label = *inPtr;
+        if (!previousValid || label != previousLabel)
+          {
+          long long labelValue = static_cast<long long>(label);
+          labelValue = std::min(std::max(labelValue, static_cast<long long>(colorMapRange[0])),
+            static_cast<long long>(colorMapRange[1]));
+          auto colorIt = colorMap.find(static_cast<int>(labelValue));
+          previousColor = (colorIt != colorMap.end()) ? colorIt->second : 0;
+          previousLabel = label;
+          previousValid = true;
+          }
+        memcpy(outPtr, &previousColor, 4);
+        inPtr += numberOfInputComponents;
+        outPtr += 4;
+        }
+      inPtr += inInc1;
+      outPtr += outInc1;
+      }
+    inPtr += inInc2;
+    outPtr += outInc2;
+    }
+}
+}
+
+//----------------------------------------------------------------------------
+void vtkImageSparseLabelMapToColors::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* vtkNotUsed(outputVector),
+  vtkImageData*** inData, vtkImageData** outData, int outExt[6], int vtkNotUsed(threadId))
+{
+  vtkImageData* input = inData[0][0];
+  vtkImageData* output = outData[0];
+  if (!this->ExecuteColorMap || this->ExecuteColorMapRange[1] < this->ExecuteColorMapRange[0])
+    {
+    // No colors, the output is fully transparent
+    for (int idx2 = outExt[4]; idx2 <= outExt[5]; ++idx2)
+      {
+      for (int idx1 = outExt[2]; idx1 <= outExt[3]; ++idx1)
+        {
+        unsigned char* outPtr = static_cast<unsigned char*>(output->GetScalarPointer(outExt[0], idx1, idx2));
+        memset(outPtr, 0, static_cast<size_t>(outExt[1] - outExt[0] + 1) * 4);
+        }
+      }
+    return;
+    }
+
+  switch (input->GetScalarType())
+    {
+    vtkTemplateMacro(vtkImageSparseLabelMapToColorsExecute<VTK_TT>(input, output, outExt,
+      *this->ExecuteColorMap, this->ExecuteColorMapRange));
+    default:
+      vtkErrorMacro(<< "ThreadedRequestData: Unknown input ScalarType");
+      return;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkImageSparseLabelMapToColors::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "ColorTableNode: " << this->ColorTableNode.GetPointer() << "\n";
+}
@@ -0,0 +1,79 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __vtkImageSparseLabelMapToColors_h
+#define __vtkImageSparseLabelMapToColors_h
+
+// MRML includes
+#include "vtkMRMLColorTableNode.h"
+
+// VTK includes
+#include <vtkThreadedImageAlgorithm.h>
+#include <vtkWeakPointer.h>
+
+#include "vtkMRMLLogicExport.h"
+
+/// \brief Map a label map to RGBA colors using the sparse label color map of a color table node.
+///
+/// Used by vtkMRMLSliceLayerLogic instead of the vtkImageMapToColors filter of
+/// the label map display node when the color table has sparse label values
+/// (see vtkMRMLColorTableNode::HasSparseLabelColors()). Labels are looked up in the compact
+/// label value to color map instead of in a lookup table that has an entry for
+/// every possible label value. Since neighbor voxels usually have the same label,
+/// the color of the previous voxel is reused without a lookup if the label is the same.
+///
+/// The output is identical to mapping the label map with the full lookup table:
+/// label values that are not in the map are fully transparent, values outside of
+/// the table range get the color of the closest end of the table.
+/// Only integer input scalar types are supported.
+class VTK_MRML_LOGIC_EXPORT vtkImageSparseLabelMapToColors : public vtkThreadedImageAlgorithm
+{
+public:
+  static vtkImageSparseLabelMapToColors *New();
+  vtkTypeMacro(vtkImageSparseLabelMapToColors, vtkThreadedImageAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Color table node that provides the label colors.
+  /// The filter is updated when the lookup table of the node is modified.
+  void SetColorTableNode(vtkMRMLColorTableNode* colorTableNode);
+  vtkMRMLColorTableNode* GetColorTableNode();
+
+  /// Also considers the modified time of the lookup table of the color table node
+  vtkMTimeType GetMTime() override;
+
+protected:
+  vtkImageSparseLabelMapToColors();
+  ~vtkImageSparseLabelMapToColors() override;
+
+  int RequestInformation(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+  void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
+    int outExt[6], int threadId) override;
+
+  vtkWeakPointer<vtkMRMLColorTableNode> ColorTableNode;
+
+  /// Color map and range used by the threads of the current execution
+  const vtkMRMLColorTableNode::SparseLabelColorMapType* ExecuteColorMap{nullptr};
+  int ExecuteColorMapRange[2]{0, -1};
+
+private:
+  vtkImageSparseLabelMapToColors(const vtkImageSparseLabelMapToColors&) = delete;
+  void operator=(const vtkImageSparseLabelMapToColors&) = delete;
+};
+
+#endif
@@ -24,6 +24,7 @@
 
 // RemoteIO includes
 #include <vtkHTTPHandler.h>
+#include <vtkObjectStoreHandler.h>
 
 #include "vtkMRMLRemoteIOLogic.h"
 
@@ -97,6 +98,14 @@ void vtkMRMLRemoteIOLogic::AddDataIOToScene()
   this->GetMRMLScene()->AddURIHandler(httpHandler);
   httpHandler->Delete();
 
+  // s3:// and gs:// URIs
+  vtkObjectStoreHandler *objectStoreHandler = vtkObjectStoreHandler::New();
+  objectStoreHandler->SetPrefix("s3://");
+  objectStoreHandler->SetName("ObjectStoreHandler");
+  objectStoreHandler->SetCaCertificatesPath(this->GetCaCertificatesPath());
+  this->GetMRMLScene()->AddURIHandler(objectStoreHandler);
+  objectStoreHandler->Delete();
+
   //add something to hold user tags
   vtkTagTable *userTagTable = vtkTagTable::New();
   this->GetMRMLScene()->SetUserTagTable( userTagTable );
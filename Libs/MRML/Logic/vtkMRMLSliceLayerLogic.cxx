@@ -18,6 +18,8 @@
 // MRML includes
 #include "vtkMRMLLabelMapVolumeNode.h"
 #include "vtkMRMLLabelMapVolumeDisplayNode.h"
+#include "vtkMRMLColorTableNode.h"
+#include "vtkMRMLMultiResolutionVolumeNode.h"
 #include "vtkMRMLVectorVolumeDisplayNode.h"
 #include "vtkMRMLDiffusionWeightedVolumeDisplayNode.h"
 #include "vtkMRMLDiffusionTensorVolumeDisplayNode.h"
@@ -32,14 +34,17 @@
 #include <vtkDiffusionTensorMathematics.h>
 #include <vtkFloatArray.h>
 #include <vtkGeneralTransform.h>
+#include <vtkGridTransform.h>
 #include <vtkImageData.h>
 #include <vtkImageReslice.h>
 #include <vtkInformation.h>
 #include <vtkInformationVector.h>
+#include <vtkMath.h>
 #include <vtkMatrix4x4.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPointData.h>
+#include <vtkPoints.h>
 #include <vtkTrivialProducer.h>
 #include <vtkTransform.h>
 #include <vtkVersion.h>
@@ -47,13 +52,42 @@
 
 //
 #include "vtkImageLabelOutline.h"
+#include "vtkImageSharedReslice.h"
+#include "vtkImageSparseLabelMapToColors.h"
 
 // STD includes
 #include <algorithm>
+#include <cmath>
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkMRMLSliceLayerLogic);
 
+//----------------------------------------------------------------------------
+/// State of the layer that the resliced image depends on
+struct vtkMRMLSliceLayerLogic::ResliceCacheKeyType
+{
+  bool Valid{false};
+  /// Reslice transform matrix, only set if the transform is linear
+  bool LinearTransform{false};
+  double XYToIJK[16];
+  int Dimensions[3]{0, 0, 0};
+  int InterpolationMode{VTK_RESLICE_NEAREST};
+  vtkMTimeType ImageDataMTime{0};
+  vtkMTimeType DisplayNodeMTime{0};
+
+  bool operator==(const ResliceCacheKeyType& other) const
+    {
+    return this->Valid && other.Valid
+      // a non-linear transform cannot be compared, it is always considered modified
+      && this->LinearTransform && other.LinearTransform
+      && std::equal(this->XYToIJK, this->XYToIJK + 16, other.XYToIJK)
+      && std::equal(this->Dimensions, this->Dimensions + 3, other.Dimensions)
+      && this->InterpolationMode == other.InterpolationMode
+      && this->ImageDataMTime == other.ImageDataMTime
+      && this->DisplayNodeMTime == other.DisplayNodeMTime;
+    }
+};
+
 bool AreMatricesEqual(const vtkMatrix4x4* first, const vtkMatrix4x4* second)
 {
   return vtkAddonMathUtilities::MatrixAreEqual(first, second);
@@ -100,6 +134,70 @@ void SnapToPermuteMatrix(vtkTransform* transform)
   }
 }
 
+// Compute the mapping of the reslice output voxels (origin 0, spacing 1) to IJK
+// through the non-linear transform of the volume and store it in a grid transform.
+// The transform from world is computed for all voxels at once by inverting the
+// transform to world (see vtkMRMLTransformNode::InverseTransformPoints), which is
+// much faster than inverting the transform for each voxel independently in vtkImageReslice.
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkGridTransform> CreateResliceGridTransform(vtkMatrix4x4* outputToRAS,
+  vtkMRMLTransformNode* transformNode, vtkMatrix4x4* rasToIJK, const int dimensions[3])
+{
+  const vtkIdType numberOfPoints = static_cast<vtkIdType>(dimensions[0]) * dimensions[1] * dimensions[2];
+  vtkNew<vtkPoints> rasPoints;
+  rasPoints->SetDataTypeToDouble();
+  rasPoints->SetNumberOfPoints(numberOfPoints);
+  double point[4] = { 0.0, 0.0, 0.0, 1.0 };
+  double rasPoint[4] = { 0.0, 0.0, 0.0, 1.0 };
+  vtkIdType pointId = 0;
+  for (int k = 0; k < dimensions[2]; ++k)
+    {
+    for (int j = 0; j < dimensions[1]; ++j)
+      {
+      for (int i = 0; i < dimensions[0]; ++i)
+        {
+        point[0] = i;
+        point[1] = j;
+        point[2] = k;
+        outputToRAS->MultiplyPoint(point, rasPoint);
+        rasPoints->SetPoint(pointId++, rasPoint);
+        }
+      }
+    }
+
+  vtkNew<vtkGeneralTransform> transformToWorld;
+  transformNode->GetTransformToWorld(transformToWorld.GetPointer());
+  vtkNew<vtkPoints> localPoints;
+  vtkMRMLTransformNode::InverseTransformPoints(transformToWorld.GetPointer(), rasPoints.GetPointer(), localPoints.GetPointer());
+
+  vtkNew<vtkImageData> displacementGrid;
+  displacementGrid->SetDimensions(dimensions[0], dimensions[1], dimensions[2]);
+  displacementGrid->AllocateScalars(VTK_DOUBLE, 3);
+  double* displacement = static_cast<double*>(displacementGrid->GetScalarPointer());
+  double localPoint[4] = { 0.0, 0.0, 0.0, 1.0 };
+  double ijkPoint[4] = { 0.0, 0.0, 0.0, 1.0 };
+  pointId = 0;
+  for (int k = 0; k < dimensions[2]; ++k)
+    {
+    for (int j = 0; j < dimensions[1]; ++j)
+      {
+      for (int i = 0; i < dimensions[0]; ++i)
+        {
+        localPoints->GetPoint(pointId++, localPoint);
+        rasToIJK->MultiplyPoint(localPoint, ijkPoint);
+        *(displacement++) = ijkPoint[0] - i;
+        *(displacement++) = ijkPoint[1] - j;
+        *(displacement++) = ijkPoint[2] - k;
+        }
+      }
+    }
+
+  vtkSmartPointer<vtkGridTransform> gridTransform = vtkSmartPointer<vtkGridTransform>::New();
+  gridTransform->SetInterpolationModeToLinear();
+  gridTransform->SetDisplacementGridData(displacementGrid.GetPointer());
+  return gridTransform;
+}
+
 //----------------------------------------------------------------------------
 vtkMRMLSliceLayerLogic::vtkMRMLSliceLayerLogic()
 {
@@ -122,10 +220,13 @@ vtkMRMLSliceLayerLogic::vtkMRMLSliceLayerLogic()
   this->AssignAttributeScalarsToTensorsUVW->Assign(vtkDataSetAttributes::SCALARS, vtkDataSetAttributes::TENSORS, vtkAssignAttribute::POINT_DATA);
 
   // Create the parts for the scalar layer pipeline
-  this->Reslice = vtkImageReslice::New();
-  this->ResliceUVW = vtkImageReslice::New();
+  this->Reslice = vtkImageSharedReslice::New();
+  this->ResliceUVW = vtkImageSharedReslice::New();
   this->LabelOutline = vtkImageLabelOutline::New();
   this->LabelOutlineUVW = vtkImageLabelOutline::New();
+  this->SparseLabelMapToColors = vtkImageSparseLabelMapToColors::New();
+  this->SparseLabelMapToColorsUVW = vtkImageSparseLabelMapToColors::New();
+  this->UseSparseLabelMapToColors = false;
 
   //
   // Set parameters that won't change based on input
@@ -149,6 +250,18 @@ vtkMRMLSliceLayerLogic::vtkMRMLSliceLayerLogic()
   this->UpdatingTransforms = 0;
 
   this->InterpolationMode = VTK_RESLICE_LINEAR;
+  this->ReducedQualityRendering = false;
+
+  this->ResliceCacheKey = new ResliceCacheKeyType;
+  this->ResliceCacheHitCount = 0;
+  this->ResliceCacheMissCount = 0;
+
+  this->MultiResolutionImageData = vtkImageData::New();
+  this->MultiResolutionLevel = -1;
+  this->MultiResolutionRegionLevel = -1;
+  std::fill(this->MultiResolutionRegionExtent, this->MultiResolutionRegionExtent + 6, 0);
+  this->MultiResolutionRegionNumberOfLoadedTiles = 0;
+  this->MultiResolutionRegionComplete = false;
 }
 
 //----------------------------------------------------------------------------
@@ -176,12 +289,16 @@ vtkMRMLSliceLayerLogic::~vtkMRMLSliceLayerLogic()
   this->ResliceUVW->SetInputConnection( nullptr );
   this->LabelOutline->SetInputConnection( nullptr );
   this->LabelOutlineUVW->SetInputConnection( nullptr );
+  this->SparseLabelMapToColors->SetInputConnection( nullptr );
+  this->SparseLabelMapToColorsUVW->SetInputConnection( nullptr );
 
   this->Reslice->Delete();
   this->ResliceUVW->Delete();
 
   this->LabelOutline->Delete();
   this->LabelOutlineUVW->Delete();
+  this->SparseLabelMapToColors->Delete();
+  this->SparseLabelMapToColorsUVW->Delete();
 
   this->AssignAttributeTensorsToScalars->Delete();
   this->AssignAttributeScalarsToTensors->Delete();
@@ -197,6 +314,8 @@ vtkMRMLSliceLayerLogic::~vtkMRMLSliceLayerLogic()
     this->VolumeDisplayNodeUVW->Delete();
     }
 
+  delete this->ResliceCacheKey;
+  this->MultiResolutionImageData->Delete();
 }
 
 //---------------------------------------------------------------------------
@@ -260,6 +379,13 @@ void vtkMRMLSliceLayerLogic::ProcessMRMLNodesEvents(vtkObject * caller,
         this->UpdateLogic();
         }
       break;
+    case vtkMRMLMultiResolutionVolumeNode::TilesLoadedEvent:
+      // tiles requested for the slice may be available now
+      if (caller == this->VolumeNode)
+        {
+        this->UpdateLogic();
+        }
+      break;
     default:
       this->Superclass::ProcessMRMLNodesEvents(caller, event, callData);
       break;
@@ -316,6 +442,7 @@ void vtkMRMLSliceLayerLogic::SetVolumeNode(vtkMRMLVolumeNode *volumeNode)
   vtkNew<vtkIntArray> events;
   events->InsertNextValue(vtkMRMLTransformableNode::TransformModifiedEvent);
   events->InsertNextValue(vtkCommand::ModifiedEvent);
+  events->InsertNextValue(vtkMRMLMultiResolutionVolumeNode::TilesLoadedEvent);
   vtkSetAndObserveMRMLNodeEventsMacro(this->VolumeNode, volumeNode, events.GetPointer());
 
   // Update the reslice transform to move this image into XY
@@ -537,28 +664,52 @@ void vtkMRMLSliceLayerLogic::UpdateTransforms()
     this->XYToIJKTransform->Concatenate(rasToIJK.GetPointer());
     this->UVWToIJKTransform->Concatenate(rasToIJK.GetPointer());
 
+    // Non-linear transforms from world are computed for all output voxels at once,
+    // unless a grid of the transform has been baked already.
+    bool useResliceGridTransform = (transformNode != nullptr
+      && !transformNode->IsTransformToWorldLinear() && !transformNode->IsTransformToWorldBaked());
+
     // vtkImageReslice works faster if the input is a linear transform, so try to convert it
     // to a linear transform.
     // Also attempt to make it a permute transform, as it makes reslicing even faster.
     vtkSmartPointer<vtkTransform> linearXYToIJKTransform = vtkSmartPointer<vtkTransform>::New();
     if (vtkMRMLTransformNode::IsGeneralTransformLinear(this->XYToIJKTransform, linearXYToIJKTransform))
       {
+      this->UpdateMultiResolutionRegion(linearXYToIJKTransform, dimensions);
       SnapToPermuteMatrix(linearXYToIJKTransform);
-      this->Reslice->SetResliceTransform(linearXYToIJKTransform);
+      vtkMRMLSliceLayerLogic::SetResliceTransformIfModified(this->Reslice, linearXYToIJKTransform);
       }
     else
       {
-      this->Reslice->SetResliceTransform(this->XYToIJKTransform);
+      // regions of multi-resolution volumes are only computed for linear transforms
+      this->MultiResolutionLevel = -1;
+      if (useResliceGridTransform)
+        {
+        this->Reslice->SetResliceTransform(CreateResliceGridTransform(
+          xyToIJK.GetPointer(), transformNode, rasToIJK.GetPointer(), dimensions));
+        }
+      else
+        {
+        this->Reslice->SetResliceTransform(this->XYToIJKTransform);
+        }
       }
     vtkSmartPointer<vtkTransform> linearUVWToIJKTransform = vtkSmartPointer<vtkTransform>::New();
     if (vtkMRMLTransformNode::IsGeneralTransformLinear(this->UVWToIJKTransform, linearUVWToIJKTransform))
       {
       SnapToPermuteMatrix(linearUVWToIJKTransform);
-      this->ResliceUVW->SetResliceTransform( linearUVWToIJKTransform );
+      vtkMRMLSliceLayerLogic::SetResliceTransformIfModified(this->ResliceUVW, linearUVWToIJKTransform);
       }
     else
       {
-      this->ResliceUVW->SetResliceTransform( this->UVWToIJKTransform );
+      if (useResliceGridTransform)
+        {
+        this->ResliceUVW->SetResliceTransform(CreateResliceGridTransform(
+          uvwToIJK.GetPointer(), transformNode, rasToIJK.GetPointer(), dimensionsUVW));
+        }
+      else
+        {
+        this->ResliceUVW->SetResliceTransform( this->UVWToIJKTransform );
+        }
       }
 
   }
@@ -604,6 +755,10 @@ vtkImageData* vtkMRMLSliceLayerLogic::GetImageData()
     {
     return nullptr;
     }
+  if (this->UseSparseLabelMapToColors)
+    {
+    return this->SparseLabelMapToColors->GetOutput();
+    }
   return this->GetVolumeDisplayNode()->GetOutputImageData();
 }
 
@@ -614,6 +769,10 @@ vtkAlgorithmOutput* vtkMRMLSliceLayerLogic::GetImageDataConnection()
     {
     return nullptr;
     }
+  if (this->UseSparseLabelMapToColors)
+    {
+    return this->SparseLabelMapToColors->GetOutputPort();
+    }
   return this->GetVolumeDisplayNode()->GetOutputImageDataConnection();
 }
 
@@ -624,6 +783,10 @@ vtkImageData* vtkMRMLSliceLayerLogic::GetImageDataUVW()
     {
     return nullptr;
     }
+  if (this->UseSparseLabelMapToColors && this->SparseLabelMapToColorsUVW->GetNumberOfInputConnections(0) > 0)
+    {
+    return this->SparseLabelMapToColorsUVW->GetOutput();
+    }
   return this->GetVolumeDisplayNodeUVW()->GetOutputImageData();
 }
 
@@ -634,6 +797,10 @@ vtkAlgorithmOutput* vtkMRMLSliceLayerLogic::GetImageDataConnectionUVW()
     {
     return nullptr;
     }
+  if (this->UseSparseLabelMapToColors && this->SparseLabelMapToColorsUVW->GetNumberOfInputConnections(0) > 0)
+    {
+    return this->SparseLabelMapToColorsUVW->GetOutputPort();
+    }
   return this->GetVolumeDisplayNodeUVW()->GetOutputImageDataConnection();
 }
 
@@ -668,6 +835,8 @@ void vtkMRMLSliceLayerLogic::UpdateImageDisplay()
   vtkMTimeType oldAssign = this->AssignAttributeTensorsToScalars->GetMTime();
   vtkMTimeType oldLabel = this->LabelOutline->GetMTime();
   vtkMTimeType oldLabelUVW = this->LabelOutlineUVW->GetMTime();
+  vtkMTimeType oldSparseLabel = this->SparseLabelMapToColors->GetMTime();
+  bool oldUseSparseLabelMapToColors = this->UseSparseLabelMapToColors;
 
   if ( (this->VolumeNode->GetImageData() && labelMapVolumeDisplayNode) ||
        (scalarVolumeDisplayNode && scalarVolumeDisplayNode->GetInterpolate() == 0))
@@ -677,7 +846,10 @@ void vtkMRMLSliceLayerLogic::UpdateImageDisplay()
     }
   else
     {
-    this->Reslice->SetInterpolationMode(this->InterpolationMode);
+    // the UVW output is used for texturing models, it is not updated while
+    // interacting with the slice view so it is always resliced at full quality
+    this->Reslice->SetInterpolationMode(this->ReducedQualityRendering ?
+      VTK_RESLICE_NEAREST : this->InterpolationMode);
     this->ResliceUVW->SetInterpolationMode(this->InterpolationMode);
     }
 
@@ -762,7 +934,9 @@ void vtkMRMLSliceLayerLogic::UpdateImageDisplay()
 //      {
 //      volumeNode->GetImageData()->Print(std::cout);
 //      }
-    this->Reslice->SetInputData(volumeNode->GetImageData());
+    this->Reslice->SetInputData(this->MultiResolutionLevel >= 0 ?
+      this->MultiResolutionImageData : volumeNode->GetImageData());
+    // the UVW output is used for texturing models, it is resliced from the overview
     this->ResliceUVW->SetInputData(volumeNode->GetImageData());
     // use the label outline if we have a label map volume, this is the label
     // layer (turned on in slice logic when the label layer is instantiated)
@@ -811,7 +985,31 @@ void vtkMRMLSliceLayerLogic::UpdateImageDisplay()
       }
     }
 
-  if ( oldReSliceMTime != this->Reslice->GetMTime() ||
+  // Label maps with sparse label values (such as FreeSurfer labels) are mapped to colors
+  // using the compact label color map of the color table instead of the full lookup table.
+  vtkMRMLColorTableNode* colorTableNode = labelMapVolumeDisplayNode ?
+    vtkMRMLColorTableNode::SafeDownCast(labelMapVolumeDisplayNode->GetColorNode()) : nullptr;
+  this->UseSparseLabelMapToColors = (colorTableNode != nullptr
+    && imageData != nullptr
+    && imageData->GetScalarType() != VTK_FLOAT
+    && imageData->GetScalarType() != VTK_DOUBLE
+    && colorTableNode->HasSparseLabelColors());
+  if (this->UseSparseLabelMapToColors)
+    {
+    this->SparseLabelMapToColors->SetColorTableNode(colorTableNode);
+    this->SparseLabelMapToColors->SetInputConnection(this->GetSliceImageDataConnection());
+    this->SparseLabelMapToColorsUVW->SetColorTableNode(colorTableNode);
+    this->SparseLabelMapToColorsUVW->SetInputConnection(this->GetSliceImageDataConnectionUVW());
+    }
+  else
+    {
+    this->SparseLabelMapToColors->SetInputConnection(nullptr);
+    this->SparseLabelMapToColorsUVW->SetInputConnection(nullptr);
+    }
+
+  if ( oldUseSparseLabelMapToColors != this->UseSparseLabelMapToColors ||
+       oldSparseLabel != this->SparseLabelMapToColors->GetMTime() ||
+       oldReSliceMTime != this->Reslice->GetMTime() ||
        oldReSliceUVWMTime != this->ResliceUVW->GetMTime() ||
        oldAssign != this->AssignAttributeTensorsToScalars->GetMTime() ||
        oldLabel != this->LabelOutline->GetMTime() ||
@@ -823,6 +1021,162 @@ void vtkMRMLSliceLayerLogic::UpdateImageDisplay()
     {
     this->Modified();
     }
+
+  this->UpdateResliceCache();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSliceLayerLogic::SetResliceTransformIfModified(vtkImageReslice* reslice, vtkTransform* transform)
+{
+  // A new transform object always modifies vtkImageReslice, which then
+  // reslices the whole volume again even if the geometry is the same.
+  vtkTransform* currentTransform = vtkTransform::SafeDownCast(reslice->GetResliceTransform());
+  if (currentTransform && AreMatricesEqual(currentTransform->GetMatrix(), transform->GetMatrix()))
+    {
+    return;
+    }
+  reslice->SetResliceTransform(transform);
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLSliceLayerLogic::UpdateMultiResolutionRegion(vtkTransform* xyToIJK, const int dimensions[3])
+{
+  vtkMRMLMultiResolutionVolumeNode* volumeNode = vtkMRMLMultiResolutionVolumeNode::SafeDownCast(this->VolumeNode);
+  if (!volumeNode || !this->SliceNode || volumeNode->GetNumberOfLevels() == 0
+    || !volumeNode->GetTileStorageNode())
+    {
+    this->MultiResolutionLevel = -1;
+    return false;
+    }
+
+  // Size of the pixels of the slice view in mm
+  vtkMatrix4x4* xyToRAS = this->SliceNode->GetXYToRAS();
+  double pixelSpacing = VTK_DOUBLE_MAX;
+  for (int column = 0; column < 2; ++column)
+    {
+    double axis[3] = { xyToRAS->GetElement(0, column), xyToRAS->GetElement(1, column), xyToRAS->GetElement(2, column) };
+    pixelSpacing = std::min(pixelSpacing, vtkMath::Norm(axis));
+    }
+
+  vtkNew<vtkMatrix4x4> ijkToRAS;
+  volumeNode->GetIJKToRASMatrix(ijkToRAS);
+  // Maximum number of voxels of the region, coarser levels are used for larger regions
+  const double maximumNumberOfVoxels = 16.0 * 1024 * 1024;
+  int numberOfLevels = volumeNode->GetNumberOfLevels();
+  for (int level = volumeNode->GetLevelForSpacing(pixelSpacing); level < numberOfLevels; ++level)
+    {
+    vtkNew<vtkMatrix4x4> ijkToLevelIJK;
+    volumeNode->GetLevelIJKToRASMatrix(level, ijkToLevelIJK);
+    ijkToLevelIJK->Invert();
+    vtkMatrix4x4::Multiply4x4(ijkToLevelIJK, ijkToRAS, ijkToLevelIJK);
+    vtkNew<vtkTransform> xyToLevelIJK;
+    xyToLevelIJK->PostMultiply();
+    xyToLevelIJK->SetMatrix(xyToIJK->GetMatrix());
+    xyToLevelIJK->Concatenate(ijkToLevelIJK);
+
+    // Voxels of the level covered by the slice, with a margin for interpolation
+    double bounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+    for (int corner = 0; corner < 8; ++corner)
+      {
+      double xy[3] = {
+        (corner & 1) ? dimensions[0] - 1.0 : 0.0,
+        (corner & 2) ? dimensions[1] - 1.0 : 0.0,
+        (corner & 4) ? dimensions[2] - 1.0 : 0.0 };
+      double levelIJK[3];
+      xyToLevelIJK->TransformPoint(xy, levelIJK);
+      for (int i = 0; i < 3; ++i)
+        {
+        bounds[2 * i] = std::min(bounds[2 * i], levelIJK[i]);
+        bounds[2 * i + 1] = std::max(bounds[2 * i + 1], levelIJK[i]);
+        }
+      }
+    int levelDimensions[3];
+    volumeNode->GetLevelDimensions(level, levelDimensions);
+    int extent[6];
+    double numberOfVoxels = 1.0;
+    for (int i = 0; i < 3; ++i)
+      {
+      extent[2 * i] = std::max(static_cast<int>(std::floor(bounds[2 * i])) - 1, 0);
+      extent[2 * i + 1] = std::min(static_cast<int>(std::ceil(bounds[2 * i + 1])) + 1, levelDimensions[i] - 1);
+      numberOfVoxels *= std::max(extent[2 * i + 1] - extent[2 * i] + 1, 0);
+      }
+    if (numberOfVoxels == 0.0)
+      {
+      // the slice does not intersect the volume
+      break;
+      }
+    if (numberOfVoxels > maximumNumberOfVoxels && level < numberOfLevels - 1)
+      {
+      continue;
+      }
+
+    if (level != this->MultiResolutionRegionLevel
+      || !std::equal(extent, extent + 6, this->MultiResolutionRegionExtent)
+      || volumeNode->GetNumberOfLoadedTiles() != this->MultiResolutionRegionNumberOfLoadedTiles)
+      {
+      // missing tiles are loaded in the background, TilesLoadedEvent updates the layer again
+      int numberOfMissingTiles = volumeNode->GetRegion(level, extent, this->MultiResolutionImageData);
+      this->MultiResolutionRegionLevel = level;
+      std::copy(extent, extent + 6, this->MultiResolutionRegionExtent);
+      this->MultiResolutionRegionNumberOfLoadedTiles = volumeNode->GetNumberOfLoadedTiles();
+      this->MultiResolutionRegionComplete = (numberOfMissingTiles == 0);
+      }
+    if (!this->MultiResolutionRegionComplete)
+      {
+      break;
+      }
+    this->MultiResolutionLevel = level;
+    xyToIJK->SetMatrix(xyToLevelIJK->GetMatrix());
+    return true;
+    }
+
+  this->MultiResolutionLevel = -1;
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSliceLayerLogic::UpdateResliceCache()
+{
+  ResliceCacheKeyType key;
+  key.Valid = (this->VolumeNode != nullptr && this->VolumeNode->GetImageData() != nullptr);
+  if (key.Valid)
+    {
+    vtkTransform* transform = vtkTransform::SafeDownCast(this->Reslice->GetResliceTransform());
+    key.LinearTransform = (transform != nullptr);
+    if (transform)
+      {
+      vtkMatrix4x4* matrix = transform->GetMatrix();
+      std::copy(&matrix->Element[0][0], &matrix->Element[0][0] + 16, key.XYToIJK);
+      }
+    int* extent = this->Reslice->GetOutputExtent();
+    for (int i = 0; i < 3; ++i)
+      {
+      key.Dimensions[i] = extent[2 * i + 1] - extent[2 * i] + 1;
+      }
+    key.InterpolationMode = this->Reslice->GetInterpolationMode();
+    key.ImageDataMTime = (this->MultiResolutionLevel >= 0 ?
+      this->MultiResolutionImageData->GetMTime() : this->VolumeNode->GetImageData()->GetMTime());
+    key.DisplayNodeMTime = this->VolumeDisplayNodeObserved ? this->VolumeDisplayNodeObserved->GetMTime() : 0;
+    }
+
+  if (key == *this->ResliceCacheKey)
+    {
+    ++this->ResliceCacheHitCount;
+    vtkDebugMacro("UpdateResliceCache: reuse the image of layer "
+      << (this->VolumeNode->GetID() ? this->VolumeNode->GetID() : "(none)"));
+    }
+  else if (key.Valid)
+    {
+    ++this->ResliceCacheMissCount;
+    }
+  *this->ResliceCacheKey = key;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSliceLayerLogic::ResetResliceCacheStatistics()
+{
+  this->ResliceCacheHitCount = 0;
+  this->ResliceCacheMissCount = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -924,6 +1278,18 @@ void vtkMRMLSliceLayerLogic::UpdateGlyphs()
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLSliceLayerLogic::SetReducedQualityRendering(bool reduced)
+{
+  if (this->ReducedQualityRendering == reduced)
+    {
+    return;
+    }
+  this->ReducedQualityRendering = reduced;
+  // UpdateImageDisplay() invokes Modified if the interpolation mode changes
+  this->UpdateImageDisplay();
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLSliceLayerLogic::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -999,6 +1365,11 @@ void vtkMRMLSliceLayerLogic::PrintSelf(ostream& os, vtkIndent indent)
     }
 
   os << indent << "IsLabelLayer: " << this->GetIsLabelLayer() << "\n";
+  os << indent << "UseSparseLabelMapToColors: " << this->UseSparseLabelMapToColors << "\n";
+  os << indent << "ReducedQualityRendering: " << this->ReducedQualityRendering << "\n";
+  os << indent << "ResliceCacheHitCount: " << this->ResliceCacheHitCount << "\n";
+  os << indent << "ResliceCacheMissCount: " << this->ResliceCacheMissCount << "\n";
+  os << indent << "MultiResolutionLevel: " << this->MultiResolutionLevel << "\n";
   os << indent << "LabelOutline:\n";
   if (this->LabelOutline)
     {
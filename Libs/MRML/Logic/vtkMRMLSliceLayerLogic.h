@@ -24,6 +24,20 @@
 /// - Outputs
 /// -- Colors vtkImageData for the given slice
 /// -- image is mapped through current window/level and lookup table
+/// - Light box
+/// -- all the tiles of a light box layout are resliced in a single
+///    multithreaded vtkImageReslice execution: the output has one slice per
+///    tile (see vtkMRMLSliceNode::SetLayoutGrid()), and window/level and
+///    lookup table are applied once to the whole stack.
+/// - Multi-resolution volumes
+/// -- for a vtkMRMLMultiResolutionVolumeNode the 2D slice is resliced from
+///    the region of the pyramid level that matches the slice resolution
+///    (see GetMultiResolutionLevel()), the overview is shown while its
+///    tiles are loading.
+/// - Shared reslicing
+/// -- layers of different slice views showing the same volume with the same
+///    slice geometry compute the resliced image only once (see
+///    vtkImageSharedReslice).
 //
 /// This class can also be used for resampling volumes for further computation.
 //
@@ -55,6 +69,7 @@ class vtkGeneralTransform;
 //#include <cstdlib>
 
 class vtkImageLabelOutline;
+class vtkImageSparseLabelMapToColors;
 class vtkTransform;
 
 class VTK_MRML_LOGIC_EXPORT vtkMRMLSliceLayerLogic
@@ -100,6 +115,14 @@ public:
   /// The filter that turns the label map into an outline
   vtkGetObjectMacro (LabelOutline, vtkImageLabelOutline);
 
+  ///
+  /// The filter that maps label maps with sparse label values to colors.
+  /// It is used instead of the pipeline of the label map display node if the
+  /// color table of the label map has sparse label colors
+  /// (see vtkMRMLColorTableNode::HasSparseLabelColors()).
+  vtkGetObjectMacro (SparseLabelMapToColors, vtkImageSparseLabelMapToColors);
+  vtkGetMacro (UseSparseLabelMapToColors, bool);
+
   ///
   /// Get the output of the pipeline for this layer
   vtkImageData *GetImageData();
@@ -135,6 +158,31 @@ public:
   vtkGetMacro(InterpolationMode, int);
   vtkSetMacro(InterpolationMode, int);
 
+  ///
+  /// Get/set reduced quality rendering. When enabled, the 2D slice is always
+  /// resliced with nearest neighbor interpolation, which is faster than the
+  /// interpolation requested by the display node. Used by vtkMRMLSliceLogic
+  /// while the slice view is being interacted with.
+  /// Disabled by default.
+  vtkGetMacro(ReducedQualityRendering, bool);
+  void SetReducedQualityRendering(bool reduced);
+
+  ///
+  /// Number of updates of the layer that reused the image of the previous
+  /// update because the slice geometry (XYToRAS and dimensions), the volume
+  /// image data and the display node did not change (cache hits), and number
+  /// of updates that required the image to be computed again (cache misses).
+  /// Useful for profiling the slice rendering.
+  vtkGetMacro(ResliceCacheHitCount, int);
+  vtkGetMacro(ResliceCacheMissCount, int);
+  void ResetResliceCacheStatistics();
+
+  ///
+  /// Level of the vtkMRMLMultiResolutionVolumeNode pyramid that the 2D slice
+  /// is resliced from, or -1 if the image data of the volume node is used
+  /// (volume nodes of other types, or tiles of the level still loading).
+  vtkGetMacro(MultiResolutionLevel, int);
+
 protected:
   vtkMRMLSliceLayerLogic();
   ~vtkMRMLSliceLayerLogic() override;
@@ -161,6 +209,23 @@ protected:
   // Copy VolumeDisplayNodeObserved into VolumeDisplayNode
   void UpdateVolumeDisplayNode();
 
+  /// Compare the current state of the layer with the cached one and update
+  /// the cache statistics
+  void UpdateResliceCache();
+
+  /// Set the reslice transform of \a reslice. The current transform is kept
+  /// if it is linear and equal to \a transform, so that vtkImageReslice does
+  /// not execute again.
+  static void SetResliceTransformIfModified(vtkImageReslice* reslice, vtkTransform* transform);
+
+  /// If the volume node is a vtkMRMLMultiResolutionVolumeNode, select the
+  /// pyramid level matching the resolution of the slice view and fetch the
+  /// region of that level covering the slice. \a xyToIJK is then changed to
+  /// map XY to the voxels of the region. The image data of the volume node
+  /// is used until all the tiles of the region are loaded.
+  /// Returns true if the slice is resliced from the region.
+  bool UpdateMultiResolutionRegion(vtkTransform* xyToIJK, const int dimensions[3]);
+
   ///
   /// the MRML Nodes that define this Logic's parameters
   vtkMRMLVolumeNode *VolumeNode;
@@ -175,6 +240,9 @@ protected:
   vtkImageReslice *ResliceUVW;
   vtkImageLabelOutline *LabelOutline;
   vtkImageLabelOutline *LabelOutlineUVW;
+  vtkImageSparseLabelMapToColors *SparseLabelMapToColors;
+  vtkImageSparseLabelMapToColors *SparseLabelMapToColorsUVW;
+  bool UseSparseLabelMapToColors;
 
   vtkAssignAttribute* AssignAttributeTensorsToScalars;
   vtkAssignAttribute* AssignAttributeScalarsToTensors;
@@ -189,6 +257,23 @@ protected:
   int UpdatingTransforms;
 
   int InterpolationMode;
+
+  bool ReducedQualityRendering;
+
+  struct ResliceCacheKeyType;
+  ResliceCacheKeyType* ResliceCacheKey;
+  int ResliceCacheHitCount;
+  int ResliceCacheMissCount;
+
+  /// Region of the multi-resolution volume pyramid used as reslice input
+  vtkImageData* MultiResolutionImageData;
+  int MultiResolutionLevel;
+  /// Last requested region, it is fetched again only if it changes or if
+  /// new tiles are loaded
+  int MultiResolutionRegionLevel;
+  int MultiResolutionRegionExtent[6];
+  vtkTypeInt64 MultiResolutionRegionNumberOfLoadedTiles;
+  bool MultiResolutionRegionComplete;
 };
 
 #endif
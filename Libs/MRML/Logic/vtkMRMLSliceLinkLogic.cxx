@@ -44,6 +44,7 @@ vtkStandardNewMacro(vtkMRMLSliceLinkLogic);
 vtkMRMLSliceLinkLogic::vtkMRMLSliceLinkLogic()
 {
   this->BroadcastingEvents = 0;
+  this->NumberOfBatchedModifiedEvents = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -68,6 +69,25 @@ int vtkMRMLSliceLinkLogic::GetBroadcastingEvents()
 }
 
 
+//----------------------------------------------------------------------------
+void vtkMRMLSliceLinkLogic::EndModifyLinkedNode(vtkMRMLNode* linkedNode, int wasModifying)
+{
+  // All the pending modified events but one are saved
+  int numberOfPendingModifiedEvents = linkedNode->GetModifiedEventPending();
+  if (!wasModifying && numberOfPendingModifiedEvents > 1)
+    {
+    this->NumberOfBatchedModifiedEvents += numberOfPendingModifiedEvents - 1;
+    }
+  linkedNode->EndModify(wasModifying);
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSliceLinkLogic::ResetNumberOfBatchedModifiedEvents()
+{
+  this->NumberOfBatchedModifiedEvents = 0;
+}
+
+
 //----------------------------------------------------------------------------
 void vtkMRMLSliceLinkLogic::SetMRMLSceneInternal(vtkMRMLScene * newScene)
 {
@@ -303,6 +323,8 @@ void vtkMRMLSliceLinkLogic::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   vtkIndent nextIndent;
   nextIndent = indent.GetNextIndent();
+
+  os << indent << "NumberOfBatchedModifiedEvents: " << this->NumberOfBatchedModifiedEvents << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -364,6 +386,7 @@ void vtkMRMLSliceLinkLogic::BroadcastSliceNodeEvent(vtkMRMLSliceNode *sliceNode)
         {
         continue;
         }
+      int wasModifying = sNode->StartModify();
 
       // Link slice parameters whenever the reformation is consistent
       if (vtkMRMLSliceLinkLogic::IsOrientationMatching(sliceNode, sNode))
@@ -520,6 +543,8 @@ void vtkMRMLSliceLinkLogic::BroadcastSliceNodeEvent(vtkMRMLSliceNode *sliceNode)
           {
           sNode->SetSlabReconstructionThickness(sliceNode->GetSlabReconstructionThickness());
           }
+
+      this->EndModifyLinkedNode(sNode, wasModifying);
       //
       // End of the block for broadcasting parameters and commands
       // that do not require the orientation to match
@@ -574,6 +599,7 @@ void vtkMRMLSliceLinkLogic::BroadcastSliceCompositeNodeEvent(vtkMRMLSliceComposi
           continue;
           }
         }
+      int wasModifying = cNode->StartModify();
       // Foreground selection
       if (sliceCompositeNode->GetInteractionFlags() & sliceCompositeNode->GetInteractionFlagsModifier()
           & vtkMRMLSliceCompositeNode::ForegroundVolumeFlag)
@@ -610,6 +636,7 @@ void vtkMRMLSliceLinkLogic::BroadcastSliceCompositeNodeEvent(vtkMRMLSliceComposi
         cNode->SetLabelOpacity(sliceCompositeNode->GetLabelOpacity());
         }
 
+      this->EndModifyLinkedNode(cNode, wasModifying);
       }
 
     this->BroadcastingEventsOff();
@@ -45,6 +45,14 @@ public:
   vtkTypeMacro(vtkMRMLSliceLinkLogic,vtkMRMLAbstractLogic);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  /// Number of modified events of the linked slice and slice composite nodes
+  /// that were merged into a single event while broadcasting a change.
+  /// Each of them would have updated and rendered the linked view again.
+  /// Useful for profiling.
+  /// \sa ResetNumberOfBatchedModifiedEvents()
+  vtkGetMacro(NumberOfBatchedModifiedEvents, int);
+  void ResetNumberOfBatchedModifiedEvents();
+
 protected:
 
   vtkMRMLSliceLinkLogic();
@@ -75,6 +83,11 @@ protected:
   /// Broadcast a slice composite node to other slice composite nodes
   void BroadcastSliceCompositeNodeEvent(vtkMRMLSliceCompositeNode *compositeNode);
 
+  /// End the modification of a linked node started with StartModify(), so
+  /// that all the changes of a broadcast to a node are applied with a single
+  /// modified event, and count the merged events.
+  void EndModifyLinkedNode(vtkMRMLNode* linkedNode, int wasModifying);
+
   /// Returns true if orientation of the slices match. Slice position and scaling is ignored.
   bool IsOrientationMatching(vtkMRMLSliceNode *sliceNode1, vtkMRMLSliceNode *sliceNode2, double comparisonTolerance = 0.001);
 
@@ -93,6 +106,8 @@ private:
   // last End event (StartBatchProcess, StartImport, StartRestore).
   int BroadcastingEvents;
 
+  int NumberOfBatchedModifiedEvents;
+
   struct SliceNodeInfos
     {
     SliceNodeInfos(int interacting) : Interacting(interacting) {}
@@ -222,6 +222,10 @@ vtkMRMLSliceLogic::vtkMRMLSliceLogic()
   this->SliceModelTransformNode = nullptr;
   this->SliceModelDisplayNode = nullptr;
   this->ImageDataConnection = nullptr;
+  this->GPURenderingSupported = true;
+  this->ProgressiveRendering = false;
+  this->ProgressiveRenderingRefinementDelay = 200;
+  this->ReducedQualityRendering = false;
   this->SliceSpacing[0] = this->SliceSpacing[1] = this->SliceSpacing[2] = 1;
   this->AddingSliceModelNodes = false;
 }
@@ -878,6 +882,93 @@ vtkAlgorithmOutput * vtkMRMLSliceLogic::GetImageDataConnection()
   return this->ImageDataConnection;
 }
 
+//----------------------------------------------------------------------------
+void vtkMRMLSliceLogic::SetGPURenderingSupported(bool supported)
+{
+  if (this->GPURenderingSupported == supported)
+    {
+    return;
+    }
+  this->GPURenderingSupported = supported;
+  if (this->SliceNode && this->SliceNode->GetGPURenderingEnabled())
+    {
+    this->UpdatePipeline();
+    }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+namespace
+{
+bool IsLayerRenderableOnGPU(vtkMRMLSliceLayerLogic* layer)
+{
+  vtkMRMLVolumeNode* volumeNode = layer->GetVolumeNode();
+  vtkMRMLVolumeDisplayNode* displayNode = layer->GetVolumeDisplayNode();
+  vtkImageData* imageData = volumeNode ? volumeNode->GetImageData() : nullptr;
+  if (!imageData || !displayNode || !displayNode->GetColorNode()
+    || imageData->GetNumberOfScalarComponents() != 1)
+    {
+    return false;
+    }
+  // Display nodes of tensor, vector and diffusion weighted volumes derive from
+  // the scalar display node but apply additional filters.
+  if (strcmp(displayNode->GetClassName(), "vtkMRMLScalarVolumeDisplayNode") == 0)
+    {
+    if (displayNode->GetScalarRangeFlag() == vtkMRMLDisplayNode::UseDirectMapping
+      || displayNode->GetColorNode()->GetScalarsToColors() == nullptr)
+      {
+      return false;
+      }
+    }
+  else if (strcmp(displayNode->GetClassName(), "vtkMRMLLabelMapVolumeDisplayNode") == 0)
+    {
+    if (displayNode->GetColorNode()->GetLookupTable() == nullptr)
+      {
+      return false;
+      }
+    }
+  else
+    {
+    return false;
+    }
+  return vtkMRMLTransformNode::IsGeneralTransformLinear(layer->GetXYToIJKTransform());
+}
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLSliceLogic::IsGPURenderingActive()
+{
+  if (!this->GPURenderingSupported || !this->SliceNode || !this->SliceCompositeNode
+    || !this->SliceNode->GetGPURenderingEnabled()
+    || this->SliceNode->GetSlabReconstructionEnabled()
+    || this->SliceNode->GetLayoutGridRows() != 1
+    || this->SliceNode->GetLayoutGridColumns() != 1)
+    {
+    return false;
+    }
+  int compositing = this->SliceCompositeNode->GetCompositing();
+  if (compositing != vtkMRMLSliceCompositeNode::Alpha
+    && compositing != vtkMRMLSliceCompositeNode::ReverseAlpha)
+    {
+    return false;
+    }
+  bool hasLayer = false;
+  vtkMRMLSliceLayerLogic* layers[3] = { this->BackgroundLayer, this->ForegroundLayer, this->LabelLayer };
+  for (vtkMRMLSliceLayerLogic* layer : layers)
+    {
+    if (!layer || !layer->GetVolumeNode())
+      {
+      continue;
+      }
+    if (!IsLayerRenderableOnGPU(layer))
+      {
+      return false;
+      }
+    hasLayer = true;
+    }
+  return hasLayer;
+}
+
 //----------------------------------------------------------------------------
 void vtkMRMLSliceLogic::UpdateImageData ()
 {
@@ -893,7 +984,13 @@ void vtkMRMLSliceLogic::UpdateImageData ()
   // It seems very strange that the imagedata can be null.
   // It should probably be always a valid imagedata with invalid bounds if needed
 
-  if ( (this->GetBackgroundLayer() != nullptr && this->GetBackgroundLayer()->GetImageDataConnection() != nullptr) ||
+  if (this->IsGPURenderingActive())
+    {
+    // The slice view reslices and blends the volumes on the GPU, do not
+    // make it pull the CPU pipeline.
+    this->ImageDataConnection = nullptr;
+    }
+  else if ( (this->GetBackgroundLayer() != nullptr && this->GetBackgroundLayer()->GetImageDataConnection() != nullptr) ||
        (this->GetForegroundLayer() != nullptr && this->GetForegroundLayer()->GetImageDataConnection() != nullptr) ||
        (this->GetLabelLayer() != nullptr && this->GetLabelLayer()->GetImageDataConnection() != nullptr) )
     {
@@ -1243,6 +1340,9 @@ void vtkMRMLSliceLogic::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "BlendUVW: (none)\n";
     }
 
+  os << indent << "ProgressiveRendering: " << this->ProgressiveRendering << "\n";
+  os << indent << "ProgressiveRenderingRefinementDelay: " << this->ProgressiveRenderingRefinementDelay << "\n";
+  os << indent << "ReducedQualityRendering: " << this->ReducedQualityRendering << "\n";
   os << indent << "SLICE_MODEL_NODE_NAME_SUFFIX: " << this->SLICE_MODEL_NODE_NAME_SUFFIX << "\n";
 
 }
@@ -2020,6 +2120,47 @@ void vtkMRMLSliceLogic::StartSliceNodeInteraction(unsigned int parameters)
     {
     this->SliceNode->InteractingOn();
     }
+
+  // Reslicing is done for every event of the interaction, make it faster
+  const unsigned int progressiveParameters = vtkMRMLSliceNode::SliceToRASFlag
+    | vtkMRMLSliceNode::FieldOfViewFlag | vtkMRMLSliceNode::XYZOriginFlag
+    | vtkMRMLSliceNode::MultiplanarReformatFlag;
+  // The refinement is requested at the end of the interaction
+  if (this->ProgressiveRendering && (parameters & progressiveParameters))
+    {
+    this->SetLayersReducedQualityRendering(true);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSliceLogic::RefineRendering()
+{
+  // a refinement requested by a previous interaction must not interrupt
+  // the current one, EndSliceNodeInteraction() requests it again
+  if (this->SliceNode && this->SliceNode->GetInteractionFlags() != 0)
+    {
+    return;
+    }
+  this->SetLayersReducedQualityRendering(false);
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLSliceLogic::SetLayersReducedQualityRendering(bool reduced)
+{
+  if (this->ReducedQualityRendering == reduced)
+    {
+    return;
+    }
+  this->ReducedQualityRendering = reduced;
+  vtkMRMLSliceLayerLogic* layers[] = { this->BackgroundLayer, this->ForegroundLayer, this->LabelLayer };
+  for (vtkMRMLSliceLayerLogic* layer : layers)
+    {
+    if (layer)
+      {
+      layer->SetReducedQualityRendering(reduced);
+      }
+    }
+  this->Modified();
 }
 
 //----------------------------------------------------------------------------
@@ -2137,6 +2278,12 @@ void vtkMRMLSliceLogic::EndSliceNodeInteraction()
     }
 
   this->SliceNode->SetInteractionFlags(0);
+
+  if (this->ReducedQualityRendering)
+    {
+    // start the refinement delay from the end of the interaction
+    this->InvokeEvent(RefineRenderingRequestedEvent);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -65,9 +65,14 @@ public:
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
   /// CompositeModifiedEvent is generated when slice composite node is modified
+  /// RefineRenderingRequestedEvent is generated by EndSliceNodeInteraction()
+  /// when the slice was rendered at reduced quality during the interaction;
+  /// observers (e.g. the slice view) should call RefineRendering() once no
+  /// event was received during ProgressiveRenderingRefinementDelay milliseconds.
   enum
     {
-    CompositeModifiedEvent = 18000
+    CompositeModifiedEvent = 18000,
+    RefineRenderingRequestedEvent
     };
 
   enum
@@ -169,8 +174,52 @@ public:
   ///
   /// the tail of the pipeline
   /// -- returns nullptr if none of the inputs exist
+  /// -- returns nullptr if the slice is rendered on the GPU
+  /// \sa IsGPURenderingActive()
   vtkAlgorithmOutput *GetImageDataConnection();
 
+  /// Return true if the slice is resliced, mapped and blended on the GPU
+  /// by the slice view instead of the CPU imaging pipeline of the
+  /// layers. This is the case if GPU rendering is enabled in the slice
+  /// node, the view supports it and all the displayed layers can be
+  /// rendered on the GPU: single component scalar or label map volumes
+  /// with a linear transform, no direct color mapping, alpha or reverse
+  /// alpha compositing, no slab reconstruction and no lightbox layout.
+  /// \sa vtkMRMLSliceNode::GetGPURenderingEnabled(), SetGPURenderingSupported()
+  bool IsGPURenderingActive();
+
+  /// Set by the slice view to report whether it can render the slice on the
+  /// GPU. If the view fails to render the slice on the GPU, the CPU
+  /// imaging pipeline is used even if GPU rendering is enabled in the slice node.
+  /// Default is true.
+  vtkGetMacro(GPURenderingSupported, bool);
+  void SetGPURenderingSupported(bool supported);
+
+  /// If enabled, the layers are resliced with nearest neighbor interpolation
+  /// while the slice is being moved, rotated, panned or zoomed (see
+  /// StartSliceNodeInteraction()), and at full quality once the interaction
+  /// is idle (see RefineRendering()).
+  /// Disabled by default.
+  vtkSetMacro(ProgressiveRendering, bool);
+  vtkGetMacro(ProgressiveRendering, bool);
+  vtkBooleanMacro(ProgressiveRendering, bool);
+
+  /// Time in milliseconds without interaction after which the slice should
+  /// be rendered again at full quality. Used by the observers of
+  /// RefineRenderingRequestedEvent.
+  /// Default is 200ms.
+  vtkSetClampMacro(ProgressiveRenderingRefinementDelay, int, 0, 10000);
+  vtkGetMacro(ProgressiveRenderingRefinementDelay, int);
+
+  /// Return true if the layers are currently rendered at reduced quality.
+  vtkGetMacro(ReducedQualityRendering, bool);
+
+  /// Render the layers at full quality again after an interaction.
+  /// Does nothing if the layers are not rendered at reduced quality or if
+  /// an interaction is in progress (between StartSliceNodeInteraction() and
+  /// EndSliceNodeInteraction()).
+  void RefineRendering();
+
   ///
   /// update the pipeline to reflect the current state of the nodes
   void UpdatePipeline();
@@ -417,6 +466,9 @@ protected:
   static vtkMRMLSliceNode* GetSliceNode(vtkMRMLScene* scene,
     const char* layoutName);
 
+  /// Helper to enable or disable reduced quality rendering in all the layers
+  void SetLayersReducedQualityRendering(bool reduced);
+
   ///
   /// Helper to set Window/Level in any layer
   void SetWindowLevel(double window, double level, int layer);
@@ -457,6 +509,10 @@ protected:
   BlendPipeline* PipelineUVW;
   vtkImageReslice * ExtractModelTexture;
   vtkAlgorithmOutput *    ImageDataConnection;
+  bool GPURenderingSupported;
+  bool ProgressiveRendering;
+  int ProgressiveRenderingRefinementDelay;
+  bool ReducedQualityRendering;
 
   vtkMRMLModelNode *            SliceModelNode;
   vtkMRMLModelDisplayNode *     SliceModelDisplayNode;
@@ -134,6 +134,7 @@ int qMRMLSliceWidgetTest2(int argc, char * argv [] )
   // test the list of displayable managers
   QStringList expectedDisplayableManagerClassNames =
     QStringList() << "vtkMRMLVolumeGlyphSliceDisplayableManager"
+                  << "vtkMRMLVolumeGPUSliceDisplayableManager"
                   << "vtkMRMLModelSliceDisplayableManager"
                   << "vtkMRMLCrosshairDisplayableManager"
                   << "vtkMRMLOrientationMarkerDisplayableManager"
@@ -49,6 +49,10 @@ namespace
     NameColumn = 0,
     ElapsedTimeColumn,
     TotalTimeColumn,
+    InvocationCountColumn,
+    SelfTimeColumn,
+    MaximumTimeColumn,
+    NestingLevelColumn,
     CommentColumn
   };
 }
@@ -256,6 +260,16 @@ void qMRMLEventBrokerWidgetPrivate::addObservation(vtkObservation* observation)
   // Total Time
   observationItem->setText(TotalTimeColumn, QString::number(observation->GetTotalElapsedTime()) + " s");
   observationItem->setToolTip(TotalTimeColumn, QString::number(1. / observation->GetTotalElapsedTime()) + " fps");
+  // Profiling statistics
+  if (observation->GetInvocationCount() > 0)
+    {
+    observationItem->setText(InvocationCountColumn, QString::number(observation->GetInvocationCount()));
+    observationItem->setText(SelfTimeColumn, QString::number(observation->GetTotalSelfElapsedTime()) + " s");
+    observationItem->setToolTip(SelfTimeColumn, QString("Average: ") +
+      QString::number(observation->GetTotalSelfElapsedTime() / observation->GetInvocationCount()) + " s");
+    observationItem->setText(MaximumTimeColumn, QString::number(observation->GetMaximumElapsedTime()) + " s");
+    observationItem->setText(NestingLevelColumn, QString::number(observation->GetMaximumEventNestingLevel()));
+    }
   observationItem->setFlags(observationItem->flags() | Qt::ItemIsEditable);
   // Comments
   observationItem->setText(CommentColumn, observation->GetComment());
@@ -272,8 +286,17 @@ void qMRMLEventBrokerWidgetPrivate::setupUi(QWidget* parentWidget)
   this->ConnectionsTreeWidget = new QTreeWidget;
 
   QStringList headers;
-  headers << "Object/Type"  << "Elapsed" << "Total" << "Comment";
+  headers << "Object/Type"  << "Elapsed" << "Total"
+          << "Count" << "Self" << "Max" << "Depth" << "Comment";
   this->ConnectionsTreeWidget->setHeaderLabels(headers);
+  this->ConnectionsTreeWidget->headerItem()->setToolTip(InvocationCountColumn,
+    "Number of invocations (recorded when event profiling is enabled)");
+  this->ConnectionsTreeWidget->headerItem()->setToolTip(SelfTimeColumn,
+    "Total elapsed time excluding nested invocations (recorded when event profiling is enabled)");
+  this->ConnectionsTreeWidget->headerItem()->setToolTip(MaximumTimeColumn,
+    "Longest invocation (recorded when event profiling is enabled)");
+  this->ConnectionsTreeWidget->headerItem()->setToolTip(NestingLevelColumn,
+    "Maximum event nesting level (recorded when event profiling is enabled)");
 
   QObject::connect(this->ConnectionsTreeWidget, SIGNAL(itemChanged(QTreeWidgetItem*,int)),
                    parentWidget, SLOT(onItemChanged(QTreeWidgetItem*,int)));
@@ -365,16 +388,22 @@ void qMRMLEventBrokerWidget::onCurrentItemChanged(QTreeWidgetItem* currentItem)
 //------------------------------------------------------------------------------
 void qMRMLEventBrokerWidget::resetElapsedTimes()
 {
-  vtkEventBroker* eventBroker = vtkEventBroker::GetInstance();
-  for (int i = 0; i < eventBroker->GetNumberOfObservations(); ++i)
-    {
-    vtkObservation* observation = eventBroker->GetNthObservation(i);
-    observation->SetTotalElapsedTime(0.);
-    observation->SetLastElapsedTime(0.);
-    }
+  vtkEventBroker::GetInstance()->ResetEventProfile();
   this->refresh();
 }
 
+//------------------------------------------------------------------------------
+void qMRMLEventBrokerWidget::setEventProfiling(bool enable)
+{
+  vtkEventBroker::GetInstance()->SetEventProfiling(enable ? 1 : 0);
+}
+
+//------------------------------------------------------------------------------
+bool qMRMLEventBrokerWidget::eventProfiling()const
+{
+  return vtkEventBroker::GetInstance()->GetEventProfiling() != 0;
+}
+
 //------------------------------------------------------------------------------
 void qMRMLEventBrokerWidget::expandElapsedTimeItems()
 {
@@ -39,14 +39,21 @@ class vtkObject;
 class QMRML_WIDGETS_EXPORT qMRMLEventBrokerWidget: public QWidget
 {
   Q_OBJECT
+  /// Record invocation count, self time, maximum time and nesting level
+  /// of each observation (see vtkEventBroker::SetEventProfiling()).
+  Q_PROPERTY(bool eventProfiling READ eventProfiling WRITE setEventProfiling)
 public:
   typedef QWidget Superclass;
   explicit qMRMLEventBrokerWidget(QWidget *parent = nullptr);
   ~qMRMLEventBrokerWidget() override;
 
+  bool eventProfiling()const;
+
 public slots:
   void refresh();
+  /// Reset elapsed times and profiling statistics of all observations
   void resetElapsedTimes();
+  void setEventProfiling(bool enable);
   void expandElapsedTimeItems();
 
 signals:
@@ -66,6 +66,7 @@
 qMRMLLayoutThreeDViewFactory::qMRMLLayoutThreeDViewFactory(QObject* parent)
   : qMRMLLayoutViewFactory(parent)
 {
+  this->setMaximumNumberOfPooledViews(2);
   this->ViewLogics = vtkCollection::New();
 }
 
@@ -100,7 +101,12 @@ QWidget* qMRMLLayoutThreeDViewFactory::createViewFromNode(vtkMRMLAbstractViewNod
   // There must be a unique ThreeDWidget per node
   Q_ASSERT(!this->viewWidget(viewNode));
 
-  qMRMLThreeDWidget* threeDWidget = new qMRMLThreeDWidget(this->layoutManager()->viewport());
+  // Reuse a pooled widget if available, as creating a new one is expensive
+  qMRMLThreeDWidget* threeDWidget = qobject_cast<qMRMLThreeDWidget*>(this->takePooledView());
+  if (!threeDWidget)
+    {
+    threeDWidget = new qMRMLThreeDWidget(this->layoutManager()->viewport());
+    }
   threeDWidget->setObjectName(QString("ThreeDWidget%1").arg(viewNode->GetLayoutName()));
   threeDWidget->setMRMLScene(this->mrmlScene());
   threeDWidget->setMRMLViewNode(vtkMRMLViewNode::SafeDownCast(viewNode));
@@ -128,6 +134,7 @@ void qMRMLLayoutThreeDViewFactory::deleteView(vtkMRMLAbstractViewNode* viewNode)
 qMRMLLayoutTableViewFactory::qMRMLLayoutTableViewFactory(QObject* parent)
   : qMRMLLayoutViewFactory(parent)
 {
+  this->setMaximumNumberOfPooledViews(2);
 }
 
 //------------------------------------------------------------------------------
@@ -148,7 +155,11 @@ QWidget* qMRMLLayoutTableViewFactory::createViewFromNode(vtkMRMLAbstractViewNode
   // There must be a unique TableWidget per node
   Q_ASSERT(!this->viewWidget(viewNode));
 
-  qMRMLTableWidget* tableWidget = new qMRMLTableWidget(this->layoutManager()->viewport());
+  qMRMLTableWidget* tableWidget = qobject_cast<qMRMLTableWidget*>(this->takePooledView());
+  if (!tableWidget)
+    {
+    tableWidget = new qMRMLTableWidget(this->layoutManager()->viewport());
+    }
   tableWidget->setObjectName(QString("qMRMLTableWidget%1").arg(viewNode->GetLayoutName()));
   tableWidget->setMRMLScene(this->mrmlScene());
   tableWidget->setMRMLTableViewNode(vtkMRMLTableViewNode::SafeDownCast(viewNode));
@@ -162,6 +173,7 @@ QWidget* qMRMLLayoutTableViewFactory::createViewFromNode(vtkMRMLAbstractViewNode
 qMRMLLayoutPlotViewFactory::qMRMLLayoutPlotViewFactory(QObject* parent)
   : qMRMLLayoutViewFactory(parent)
 {
+  this->setMaximumNumberOfPooledViews(2);
 }
 
 //------------------------------------------------------------------------------
@@ -201,7 +213,11 @@ QWidget* qMRMLLayoutPlotViewFactory::createViewFromNode(vtkMRMLAbstractViewNode*
   // There must be a unique plot widget per node
   Q_ASSERT(!this->viewWidget(viewNode));
 
-  qMRMLPlotWidget* plotWidget = new qMRMLPlotWidget(this->layoutManager()->viewport());
+  qMRMLPlotWidget* plotWidget = qobject_cast<qMRMLPlotWidget*>(this->takePooledView());
+  if (!plotWidget)
+    {
+    plotWidget = new qMRMLPlotWidget(this->layoutManager()->viewport());
+    }
   plotWidget->setObjectName(QString("qMRMLPlotWidget%1").arg(viewNode->GetLayoutName()));
   plotWidget->setMRMLScene(this->mrmlScene());
   plotWidget->setMRMLPlotViewNode(vtkMRMLPlotViewNode::SafeDownCast(viewNode));
@@ -219,6 +235,7 @@ qMRMLLayoutSliceViewFactory::qMRMLLayoutSliceViewFactory(QObject* parent)
   this->SliceControllerButtonGroup->setParent(this);
   this->SliceControllerButtonGroup->setExclusive(false);
   this->SliceLogics = vtkCollection::New();
+  this->setMaximumNumberOfPooledViews(2);
 }
 
 //------------------------------------------------------------------------------
@@ -252,7 +269,13 @@ QWidget* qMRMLLayoutSliceViewFactory::createViewFromNode(vtkMRMLAbstractViewNode
   // there is a unique slice widget per node
   Q_ASSERT(!this->viewWidget(viewNode));
 
-  qMRMLSliceWidget * sliceWidget = new qMRMLSliceWidget(this->layoutManager()->viewport());
+  // Reuse a pooled widget if available, as creating a new one is expensive
+  qMRMLSliceWidget* sliceWidget = qobject_cast<qMRMLSliceWidget*>(this->takePooledView());
+  bool reusedWidget = (sliceWidget != nullptr);
+  if (!reusedWidget)
+    {
+    sliceWidget = new qMRMLSliceWidget(this->layoutManager()->viewport());
+    }
 
   // Set slice logic before setting the slice node in the widget
   // to allow displayable managers to use the slice logic during initialization
@@ -261,7 +284,10 @@ QWidget* qMRMLLayoutSliceViewFactory::createViewFromNode(vtkMRMLAbstractViewNode
   sliceWidget->setSliceLogics(this->sliceLogics());
   this->sliceLogics()->AddItem(sliceWidget->sliceLogic());
 
-  sliceWidget->sliceController()->setControllerButtonGroup(this->SliceControllerButtonGroup);
+  if (!reusedWidget)
+    {
+    sliceWidget->sliceController()->setControllerButtonGroup(this->SliceControllerButtonGroup);
+    }
   sliceWidget->setObjectName(QString("qMRMLSliceWidget%1").arg(viewNode->GetLayoutName()));
   // set slice node before setting the scene to allow using slice node names in the slice transform, display, and model nodes
   sliceWidget->setMRMLSliceNode(vtkMRMLSliceNode::SafeDownCast(viewNode));
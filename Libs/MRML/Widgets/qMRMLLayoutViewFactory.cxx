@@ -21,6 +21,7 @@
 // Qt includes
 //#include <QDomElement>
 #include <QDebug>
+#include <QPointer>
 
 // CTK includes
 #include <ctkVTKAbstractView.h>
@@ -68,6 +69,9 @@ protected:
 
   qMRMLLayoutManager* LayoutManager;
   QHash<vtkMRMLAbstractViewNode*, QWidget*> Views;
+  /// View widgets that are kept for reuse
+  QList< QPointer<QWidget> > ViewPool;
+  int MaximumNumberOfPooledViews;
 
   vtkMRMLScene* MRMLScene;
   vtkMRMLAbstractViewNode* ActiveViewNode;
@@ -77,6 +81,7 @@ protected:
 qMRMLLayoutViewFactoryPrivate::qMRMLLayoutViewFactoryPrivate(qMRMLLayoutViewFactory& object)
   : q_ptr(&object)
   , LayoutManager(nullptr)
+  , MaximumNumberOfPooledViews(0)
   , MRMLScene(nullptr)
   , ActiveViewNode(nullptr)
 {
@@ -201,6 +206,7 @@ qMRMLLayoutViewFactory::~qMRMLLayoutViewFactory()
     {
     this->deleteView(d->Views.keys()[0]);
     }
+  this->setMaximumNumberOfPooledViews(0);
 }
 
 // --------------------------------------------------------------------------
@@ -336,6 +342,50 @@ int qMRMLLayoutViewFactory::viewCount()const
   return d->Views.size();
 }
 
+//------------------------------------------------------------------------------
+int qMRMLLayoutViewFactory::maximumNumberOfPooledViews()const
+{
+  Q_D(const qMRMLLayoutViewFactory);
+  return d->MaximumNumberOfPooledViews;
+}
+
+//------------------------------------------------------------------------------
+void qMRMLLayoutViewFactory::setMaximumNumberOfPooledViews(int maximumNumberOfPooledViews)
+{
+  Q_D(qMRMLLayoutViewFactory);
+  d->MaximumNumberOfPooledViews = qMax(maximumNumberOfPooledViews, 0);
+  while (d->ViewPool.size() > d->MaximumNumberOfPooledViews)
+    {
+    QPointer<QWidget> pooledView = d->ViewPool.takeLast();
+    if (pooledView)
+      {
+      pooledView->deleteLater();
+      }
+    }
+}
+
+//------------------------------------------------------------------------------
+int qMRMLLayoutViewFactory::pooledViewCount()const
+{
+  Q_D(const qMRMLLayoutViewFactory);
+  return d->ViewPool.size();
+}
+
+//------------------------------------------------------------------------------
+QWidget* qMRMLLayoutViewFactory::takePooledView()
+{
+  Q_D(qMRMLLayoutViewFactory);
+  while (!d->ViewPool.isEmpty())
+    {
+    QPointer<QWidget> pooledView = d->ViewPool.takeLast();
+    if (pooledView)
+      {
+      return pooledView;
+      }
+    }
+  return nullptr;
+}
+
 // --------------------------------------------------------------------------
 void qMRMLLayoutViewFactory::beginSetupLayout()
 {
@@ -493,7 +543,26 @@ void qMRMLLayoutViewFactory::deleteView(vtkMRMLAbstractViewNode* viewNode)
     }
   this->unregisterView(widgetToDelete);
   d->Views.remove(viewNode);
-  widgetToDelete->deleteLater();
+  if (d->ViewPool.size() < d->MaximumNumberOfPooledViews)
+    {
+    // Keep the widget (and its render window and displayable managers) for reuse
+    qMRMLAbstractViewWidget* viewWidget = qobject_cast<qMRMLAbstractViewWidget*>(widgetToDelete);
+    if (viewWidget && d->LayoutManager)
+      {
+      // Pause render state is initialized again when the view is reused
+      for (int i = 0; i < d->LayoutManager->allViewsPauseRenderCount(); ++i)
+        {
+        viewWidget->resumeRender();
+        }
+      }
+    widgetToDelete->setVisible(false);
+    widgetToDelete->setObjectName(QString());
+    d->ViewPool << widgetToDelete;
+    }
+  else
+    {
+    widgetToDelete->deleteLater();
+    }
   if (this->activeViewNode() == viewNode)
     {
     this->setActiveViewNode(nullptr);
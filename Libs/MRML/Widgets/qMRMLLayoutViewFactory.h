@@ -50,6 +50,16 @@ class QMRML_WIDGETS_EXPORT qMRMLLayoutViewFactory : public ctkLayoutViewFactory
   /// The accessor MUST BE reimplemented in the derived class.
   /// \sa viewClassName(), isElementSupported, isViewNodeSupported
   Q_PROPERTY(QString viewClassName READ viewClassName);
+  /// This property controls how many view widgets are kept for reuse after
+  /// their view node is removed from the scene.
+  /// Creating a view widget is expensive (render window, renderers, displayable
+  /// managers), therefore reusing a pooled widget makes it faster to switch to
+  /// layouts that require new view nodes. Each pooled view keeps its render
+  /// window alive, so the number should be chosen based on available (GPU) memory.
+  /// 0 means that views are always deleted. Default is 0, as derived classes
+  /// need to use takePooledView() in createViewFromNode() for reusing views.
+  /// \sa maximumNumberOfPooledViews(), setMaximumNumberOfPooledViews(), pooledViewCount()
+  Q_PROPERTY(int maximumNumberOfPooledViews READ maximumNumberOfPooledViews WRITE setMaximumNumberOfPooledViews);
 public:
   /// Superclass typedef
   typedef ctkLayoutViewFactory Superclass;
@@ -91,6 +101,15 @@ public:
   Q_INVOKABLE QWidget* viewWidgetByLayoutLabel(const QString& layoutLabel)const;
   Q_INVOKABLE int viewCount()const;
 
+  /// \sa maximumNumberOfPooledViews
+  int maximumNumberOfPooledViews()const;
+  /// Pooled views above the new maximum are deleted.
+  /// \sa maximumNumberOfPooledViews
+  void setMaximumNumberOfPooledViews(int maximumNumberOfPooledViews);
+  /// Number of view widgets that are currently kept for reuse.
+  /// \sa maximumNumberOfPooledViews
+  Q_INVOKABLE int pooledViewCount()const;
+
   void beginSetupLayout() override;
 
   vtkMRMLAbstractViewNode* viewNode(QWidget* widget)const;
@@ -146,8 +165,19 @@ protected:
   /// To be reimplemented
   /// \sa createViewFromXML
   virtual QWidget* createViewFromNode(vtkMRMLAbstractViewNode* node);
+  /// Unregister the view of the node. The view widget is added to the view pool
+  /// if the pool is not full, otherwise it is deleted.
+  /// \sa maximumNumberOfPooledViews
   virtual void deleteView(vtkMRMLAbstractViewNode* node);
 
+  /// Remove a view widget from the view pool and return it.
+  /// Returns nullptr if the pool is empty. The returned widget is hidden and
+  /// has no MRML scene set.
+  /// To be used by createViewFromNode() in derived classes to avoid
+  /// creating a new widget.
+  /// \sa maximumNumberOfPooledViews
+  QWidget* takePooledView();
+
 private:
   Q_DECLARE_PRIVATE(qMRMLLayoutViewFactory);
   Q_DISABLE_COPY(qMRMLLayoutViewFactory);
@@ -28,6 +28,7 @@
 
 // STD includes
 #include <algorithm>
+#include <cmath>
 #include <sstream>
 #include <vector>
 
@@ -56,6 +57,7 @@
 #include <vtkContextMouseEvent.h>
 #include <vtkContextScene.h>
 #include <vtkContextView.h>
+#include <vtkDoubleArray.h>
 #include <vtkGL2PSExporter.h>
 #include <vtkNew.h>
 #include <vtkPen.h>
@@ -82,6 +84,7 @@ qMRMLPlotViewPrivate::qMRMLPlotViewPrivate(qMRMLPlotView& object)
   //this->PinButton = 0;
 //  this->PopupWidget = 0;
   this->UpdatingWidgetFromMRML = false;
+  this->DecimationThreshold = 10000;
 }
 
 //---------------------------------------------------------------------------
@@ -99,6 +102,7 @@ void qMRMLPlotViewPrivate::init()
 
   qvtkConnect(q->chart(), vtkCommand::SelectionChangedEvent, this, SLOT(emitSelection()));
   qvtkConnect(q->chart(), vtkCommand::InteractionEvent, q, SLOT(updateMRMLChartAxisRangeFromWidget()));
+  qvtkConnect(q->chart(), vtkCommand::InteractionEvent, this, SLOT(onChartInteraction()));
 
   if (!q->chart()->GetBackgroundBrush() ||
       !q->chart()->GetTitleProperties() ||
@@ -408,6 +412,316 @@ vtkSmartPointer<vtkPlot> qMRMLPlotViewPrivate::updatePlotFromPlotSeriesNode(vtkM
   return newPlot;
 }
 
+// --------------------------------------------------------------------------
+void qMRMLPlotViewPrivate::updatePlotDecimation(vtkPlot* plot, vtkMRMLPlotSeriesNode* plotSeriesNode, bool useAxisRange)
+{
+  Q_Q(qMRMLPlotView);
+  if (!plot || !plotSeriesNode)
+    {
+    return;
+    }
+
+  vtkMRMLTableNode* tableNode = plotSeriesNode->GetTableNode();
+  vtkTable* table = (tableNode ? tableNode->GetTable() : nullptr);
+  vtkDataArray* yArray = nullptr;
+  vtkDataArray* xArray = nullptr;
+  if (table)
+    {
+    yArray = vtkDataArray::SafeDownCast(table->GetColumnByName(plotSeriesNode->GetYColumnName().c_str()));
+    if (plotSeriesNode->IsXColumnRequired())
+      {
+      xArray = vtkDataArray::SafeDownCast(table->GetColumnByName(plotSeriesNode->GetXColumnName().c_str()));
+      }
+    }
+  vtkStringArray* labelArray = nullptr;
+  if (table && !plotSeriesNode->GetLabelColumnName().empty())
+    {
+    labelArray = vtkStringArray::SafeDownCast(table->GetColumnByName(plotSeriesNode->GetLabelColumnName().c_str()));
+    }
+
+  // Decimation is only used for line and scatter plots, and not when points can be moved
+  // (as moved points could not be mapped to the table)
+  bool decimationEnabled = (this->DecimationThreshold > 0 && yArray && (xArray || !plotSeriesNode->IsXColumnRequired())
+    && vtkPlotLine::SafeDownCast(plot) && table->GetNumberOfRows() > this->DecimationThreshold
+    && this->MRMLPlotViewNode && this->MRMLPlotViewNode->GetInteractionMode() != vtkMRMLPlotViewNode::InteractionModeMovePoints);
+  QMap< vtkPlot*, PlotDecimation >::iterator decimationIt = this->PlotDecimations.find(plot);
+  if (!decimationEnabled)
+    {
+    if (decimationIt != this->PlotDecimations.end())
+      {
+      // restore original plot input
+      this->PlotDecimations.erase(decimationIt);
+      this->updatePlotFromPlotSeriesNode(plotSeriesNode, plot);
+      }
+    return;
+    }
+  if (decimationIt == this->PlotDecimations.end())
+    {
+    decimationIt = this->PlotDecimations.insert(plot, PlotDecimation());
+    }
+  PlotDecimation& decimation = decimationIt.value();
+
+  vtkIdType numberOfPoints = table->GetNumberOfRows();
+  vtkMTimeType sourceMTime = std::max(plotSeriesNode->GetMTime(), table->GetMTime());
+  sourceMTime = std::max(sourceMTime, yArray->GetMTime());
+  sourceMTime = std::max(sourceMTime, xArray ? xArray->GetMTime() : 0);
+  sourceMTime = std::max(sourceMTime, labelArray ? labelArray->GetMTime() : 0);
+  bool sourceChanged = (sourceMTime != decimation.SourceMTime);
+  if (sourceChanged)
+    {
+    // Find the points that determine the bounds of the plot. They are always included in the decimated plot,
+    // so that the plot bounds (used for automatic axis range) are the same as without decimation.
+    decimation.SourceMTime = sourceMTime;
+    decimation.Table = nullptr;
+    decimation.XMonotonic = true;
+    vtkIdType yMinIndex = 0;
+    vtkIdType yMaxIndex = 0;
+    double yMin = yArray->GetComponent(0, 0);
+    double yMax = yMin;
+    double previousX = (xArray ? xArray->GetComponent(0, 0) : 0.0);
+    for (vtkIdType pointIndex = 1; pointIndex < numberOfPoints; ++pointIndex)
+      {
+      double y = yArray->GetComponent(pointIndex, 0);
+      if (y < yMin)
+        {
+        yMin = y;
+        yMinIndex = pointIndex;
+        }
+      else if (y > yMax)
+        {
+        yMax = y;
+        yMaxIndex = pointIndex;
+        }
+      if (xArray)
+        {
+        double x = xArray->GetComponent(pointIndex, 0);
+        if (!(x >= previousX))
+          {
+          decimation.XMonotonic = false;
+          break;
+          }
+        previousX = x;
+        }
+      }
+    decimation.BoundaryPointIndices = { 0, numberOfPoints - 1, yMinIndex, yMaxIndex };
+    }
+  if (!decimation.XMonotonic)
+    {
+    // points cannot be grouped by X coordinate, use the original plot input
+    decimation.Table = nullptr;
+    if (plot->GetInput() != table)
+      {
+      this->updatePlotFromPlotSeriesNode(plotSeriesNode, plot);
+      }
+    return;
+    }
+
+  // Get visible X range
+  vtkAxis* xAxis = q->chart()->GetAxis(q->chart()->GetPlotCorner(plot) < 2 ? vtkAxis::BOTTOM : vtkAxis::TOP);
+  double xRange[2] = { decimation.XRange[0], decimation.XRange[1] };
+  if (useAxisRange || sourceChanged || !decimation.Table)
+    {
+    if (!useAxisRange && (!xAxis || xAxis->GetBehavior() == vtkAxis::AUTO))
+      {
+      // automatic axis range will show all the points
+      xRange[0] = -vtkMath::Inf();
+      xRange[1] = vtkMath::Inf();
+      }
+    else if (xAxis)
+      {
+      xAxis->GetUnscaledRange(xRange);
+      }
+    }
+  // Two points (minimum and maximum) are displayed for each pixel column
+  int numberOfBuckets = std::max(q->width(), 100);
+
+  if (!sourceChanged && decimation.Table && decimation.NumberOfBuckets == numberOfBuckets
+    && decimation.XRange[0] == xRange[0] && decimation.XRange[1] == xRange[1])
+    {
+    // decimation is up-to-date, make sure it is used in the plot
+    if (plot->GetInput() != decimation.Table.GetPointer())
+      {
+      plot->SetUseIndexForXSeries(false);
+      plot->SetInputData(decimation.Table, decimation.XColumnName, decimation.YColumnName);
+      plot->SetIndexedLabels(vtkStringArray::SafeDownCast(decimation.Table->GetColumnByName(plotSeriesNode->GetLabelColumnName().c_str())));
+      }
+    return;
+    }
+
+  // Get range of point indices that are visible (including one more point on each side)
+  vtkIdType firstIndex = 0;
+  vtkIdType lastIndex = numberOfPoints - 1;
+  if (xArray)
+    {
+    vtkIdType low = 0;
+    vtkIdType high = numberOfPoints;
+    while (low < high)
+      {
+      vtkIdType middle = low + (high - low) / 2;
+      if (xArray->GetComponent(middle, 0) < xRange[0])
+        {
+        low = middle + 1;
+        }
+      else
+        {
+        high = middle;
+        }
+      }
+    firstIndex = std::max(low - 1, vtkIdType(0));
+    high = numberOfPoints;
+    while (low < high)
+      {
+      vtkIdType middle = low + (high - low) / 2;
+      if (xArray->GetComponent(middle, 0) <= xRange[1])
+        {
+        low = middle + 1;
+        }
+      else
+        {
+        high = middle;
+        }
+      }
+    lastIndex = std::min(low, numberOfPoints - 1);
+    }
+  else
+    {
+    firstIndex = static_cast<vtkIdType>(std::max(std::min(floor(xRange[0]), double(numberOfPoints - 1)), 0.0));
+    lastIndex = static_cast<vtkIdType>(std::max(std::min(ceil(xRange[1]), double(numberOfPoints - 1)), 0.0));
+    }
+
+  std::vector<vtkIdType> pointIndices = decimation.BoundaryPointIndices;
+  vtkIdType numberOfVisiblePoints = lastIndex - firstIndex + 1;
+  if (numberOfVisiblePoints <= 2 * numberOfBuckets)
+    {
+    for (vtkIdType pointIndex = firstIndex; pointIndex <= lastIndex; ++pointIndex)
+      {
+      pointIndices.push_back(pointIndex);
+      }
+    }
+  else
+    {
+    // Keep the minimum and maximum value of each bucket
+    double bucketSize = double(numberOfVisiblePoints) / numberOfBuckets;
+    for (int bucketIndex = 0; bucketIndex < numberOfBuckets; ++bucketIndex)
+      {
+      vtkIdType bucketStart = firstIndex + static_cast<vtkIdType>(bucketIndex * bucketSize);
+      vtkIdType bucketEnd = std::min(firstIndex + static_cast<vtkIdType>((bucketIndex + 1) * bucketSize), lastIndex + 1);
+      vtkIdType minIndex = bucketStart;
+      vtkIdType maxIndex = bucketStart;
+      double minValue = yArray->GetComponent(bucketStart, 0);
+      double maxValue = minValue;
+      for (vtkIdType pointIndex = bucketStart + 1; pointIndex < bucketEnd; ++pointIndex)
+        {
+        double y = yArray->GetComponent(pointIndex, 0);
+        if (y < minValue)
+          {
+          minValue = y;
+          minIndex = pointIndex;
+          }
+        else if (y > maxValue)
+          {
+          maxValue = y;
+          maxIndex = pointIndex;
+          }
+        }
+      pointIndices.push_back(minIndex);
+      pointIndices.push_back(maxIndex);
+      }
+    pointIndices.push_back(firstIndex);
+    pointIndices.push_back(lastIndex);
+    }
+  std::sort(pointIndices.begin(), pointIndices.end());
+  pointIndices.erase(std::unique(pointIndices.begin(), pointIndices.end()), pointIndices.end());
+
+  // Create decimated table
+  decimation.YColumnName = plotSeriesNode->GetYColumnName();
+  decimation.XColumnName = (xArray ? plotSeriesNode->GetXColumnName() : std::string("Index"));
+  if (decimation.XColumnName == decimation.YColumnName)
+    {
+    decimation.XColumnName += "_X";
+    }
+  vtkNew<vtkDoubleArray> decimatedXArray;
+  decimatedXArray->SetName(decimation.XColumnName.c_str());
+  decimatedXArray->SetNumberOfValues(static_cast<vtkIdType>(pointIndices.size()));
+  vtkNew<vtkDoubleArray> decimatedYArray;
+  decimatedYArray->SetName(decimation.YColumnName.c_str());
+  decimatedYArray->SetNumberOfValues(static_cast<vtkIdType>(pointIndices.size()));
+  vtkSmartPointer<vtkStringArray> decimatedLabelArray;
+  if (labelArray)
+    {
+    decimatedLabelArray = vtkSmartPointer<vtkStringArray>::New();
+    decimatedLabelArray->SetName(labelArray->GetName());
+    decimatedLabelArray->SetNumberOfValues(static_cast<vtkIdType>(pointIndices.size()));
+    }
+  decimation.PointIndices = vtkSmartPointer<vtkIdTypeArray>::New();
+  decimation.PointIndices->SetNumberOfValues(static_cast<vtkIdType>(pointIndices.size()));
+  for (vtkIdType decimatedIndex = 0; decimatedIndex < static_cast<vtkIdType>(pointIndices.size()); ++decimatedIndex)
+    {
+    vtkIdType pointIndex = pointIndices[decimatedIndex];
+    decimatedXArray->SetValue(decimatedIndex, xArray ? xArray->GetComponent(pointIndex, 0) : double(pointIndex));
+    decimatedYArray->SetValue(decimatedIndex, yArray->GetComponent(pointIndex, 0));
+    if (decimatedLabelArray)
+      {
+      decimatedLabelArray->SetValue(decimatedIndex, labelArray->GetValue(pointIndex));
+      }
+    decimation.PointIndices->SetValue(decimatedIndex, pointIndex);
+    }
+  decimation.Table = vtkSmartPointer<vtkTable>::New();
+  decimation.Table->AddColumn(decimatedXArray);
+  decimation.Table->AddColumn(decimatedYArray);
+  if (decimatedLabelArray)
+    {
+    decimation.Table->AddColumn(decimatedLabelArray);
+    }
+  decimation.XRange[0] = xRange[0];
+  decimation.XRange[1] = xRange[1];
+  decimation.NumberOfBuckets = numberOfBuckets;
+
+  plot->SetUseIndexForXSeries(false);
+  plot->SetInputData(decimation.Table, decimation.XColumnName, decimation.YColumnName);
+  plot->SetIndexedLabels(decimatedLabelArray);
+}
+
+// --------------------------------------------------------------------------
+void qMRMLPlotViewPrivate::updatePlotDecimations(bool useAxisRange)
+{
+  Q_Q(qMRMLPlotView);
+  if (!q->chart() || !this->MRMLScene)
+    {
+    return;
+    }
+  for (int plotIndex = 0; plotIndex < q->chart()->GetNumberOfPlots(); plotIndex++)
+    {
+    vtkPlot* plot = q->chart()->GetPlot(plotIndex);
+    this->updatePlotDecimation(plot, this->plotSeriesNodeFromPlot(plot), useAxisRange);
+    }
+}
+
+// --------------------------------------------------------------------------
+vtkIdType qMRMLPlotViewPrivate::plotSeriesPointIndex(vtkPlot* plot, vtkIdType plotPointIndex)
+{
+  QMap< vtkPlot*, PlotDecimation >::iterator decimationIt = this->PlotDecimations.find(plot);
+  if (decimationIt == this->PlotDecimations.end() || !decimationIt.value().Table
+    || plot->GetInput() != decimationIt.value().Table.GetPointer())
+    {
+    // not decimated
+    return plotPointIndex;
+    }
+  vtkIdTypeArray* pointIndices = decimationIt.value().PointIndices;
+  if (plotPointIndex < 0 || plotPointIndex >= pointIndices->GetNumberOfValues())
+    {
+    return plotPointIndex;
+    }
+  return pointIndices->GetValue(plotPointIndex);
+}
+
+// --------------------------------------------------------------------------
+void qMRMLPlotViewPrivate::onChartInteraction()
+{
+  // Visible range may have changed
+  this->updatePlotDecimations(true);
+}
+
 // --------------------------------------------------------------------------
 void qMRMLPlotViewPrivate::startProcessing()
 {
@@ -602,6 +916,7 @@ void qMRMLPlotViewPrivate::RecalculateBounds()
   //q->chart()->RecalculatePlotTransforms();
 
   q->updateMRMLChartAxisRangeFromWidget();
+  this->updatePlotDecimations(true);
 }
 
 // --------------------------------------------------------------------------
@@ -655,7 +970,21 @@ void qMRMLPlotViewPrivate::emitSelection()
 
     if (selection->GetNumberOfValues() > 0)
       {
-      selectionCol->AddItem(selection);
+      if (this->PlotDecimations.contains(plot))
+        {
+        // Report point indices of the plot series table instead of indices in the decimated plot
+        vtkNew<vtkIdTypeArray> plotSeriesSelection;
+        plotSeriesSelection->SetNumberOfValues(selection->GetNumberOfValues());
+        for (vtkIdType selectionIndex = 0; selectionIndex < selection->GetNumberOfValues(); ++selectionIndex)
+          {
+          plotSeriesSelection->SetValue(selectionIndex, this->plotSeriesPointIndex(plot, selection->GetValue(selectionIndex)));
+          }
+        selectionCol->AddItem(plotSeriesSelection);
+        }
+      else
+        {
+        selectionCol->AddItem(selection);
+        }
       vtkMRMLPlotSeriesNode* plotSeriesNode = this->plotSeriesNodeFromPlot(plot);
       if (plotSeriesNode)
         {
@@ -740,6 +1069,7 @@ void qMRMLPlotViewPrivate::updateWidgetFromMRML()
       q->removePlot(q->chart()->GetPlot(0));
       }
     this->MapPlotToPlotSeriesNodeID.clear();
+    this->PlotDecimations.clear();
     this->UpdatingWidgetFromMRML = false;
     return;
     }
@@ -814,6 +1144,7 @@ void qMRMLPlotViewPrivate::updateWidgetFromMRML()
 
       q->removePlot(plot);
       this->MapPlotToPlotSeriesNodeID.remove(plot);
+      this->PlotDecimations.remove(plot);
       }
     }
 
@@ -941,6 +1272,8 @@ void qMRMLPlotViewPrivate::updateWidgetFromMRML()
     axis->GetLabelProperties()->SetFontSize(plotChartNode->GetAxisLabelFontSize());
     }
 
+  this->updatePlotDecimations(false);
+
   q->scene()->SetDirty(true);
   this->UpdatingWidgetFromMRML = false;
 }
@@ -1073,6 +1406,27 @@ void qMRMLPlotView::fitToContent()
   this->update();
 }
 
+// --------------------------------------------------------------------------
+int qMRMLPlotView::decimationThreshold() const
+{
+  Q_D(const qMRMLPlotView);
+  return d->DecimationThreshold;
+}
+
+// --------------------------------------------------------------------------
+void qMRMLPlotView::setDecimationThreshold(int threshold)
+{
+  Q_D(qMRMLPlotView);
+  if (d->DecimationThreshold == threshold)
+    {
+    return;
+    }
+  d->DecimationThreshold = threshold;
+  d->updatePlotDecimations(false);
+  this->scene()->SetDirty(true);
+  this->update();
+}
+
 // --------------------------------------------------------------------------
 void qMRMLPlotView::RemovePlotSelections()
 {
@@ -45,6 +45,11 @@ class vtkStringArray;
 class QMRML_WIDGETS_EXPORT qMRMLPlotView : public ctkVTKChartView
 {
   Q_OBJECT
+  /// Line and scatter plot series that have more points than this value are displayed decimated:
+  /// only the minimum and maximum value of each group of points that fall on the same pixel column
+  /// in the visible range is plotted. Set to 0 to always display all points.
+  /// Decimation is not used when points can be moved in the view. Default is 10000.
+  Q_PROPERTY(int decimationThreshold READ decimationThreshold WRITE setDecimationThreshold)
 public:
   /// Superclass typedef
   typedef ctkVTKChartView Superclass;
@@ -62,6 +67,10 @@ public:
   /// Redefine the sizeHint so layouts work properly.
   QSize sizeHint() const override;
 
+  /// Get minimum number of points in a plot series above which the series is displayed decimated.
+  /// \sa decimationThreshold
+  int decimationThreshold() const;
+
 public slots:
 
   /// Set the MRML \a scene that should be listened for events.
@@ -73,6 +82,10 @@ public slots:
   /// Change axis limits to show all content.
   void fitToContent();
 
+  /// Set minimum number of points in a plot series above which the series is displayed decimated.
+  /// \sa decimationThreshold
+  void setDecimationThreshold(int threshold);
+
   /// Unselect all the points
   void RemovePlotSelections();
 
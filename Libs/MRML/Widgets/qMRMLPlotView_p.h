@@ -35,6 +35,10 @@
 class QToolButton;
 #include <QMap>
 
+// STD includes
+#include <string>
+#include <vector>
+
 // VTK includes
 #include <vtkWeakPointer.h>
 
@@ -47,7 +51,9 @@ class QToolButton;
 #include "qMRMLPlotView.h"
 
 // vtk includes
+#include <vtkIdTypeArray.h>
 #include <vtkSmartPointer.h>
+#include <vtkTable.h>
 class vtkPlot;
 
 class vtkMRMLPlotSeriesNode;
@@ -83,6 +89,16 @@ public:
   // Adjust range to make it displayable with logarithmic scale
   void adjustRangeForLogScale(double range[2], double computedLimit[2]);
 
+  // Display a decimated copy of the plot series data in the plot if the series has many points.
+  // If useAxisRange is false then the visible range is only updated if the data has changed.
+  void updatePlotDecimation(vtkPlot* plot, vtkMRMLPlotSeriesNode* plotSeriesNode, bool useAxisRange);
+
+  // Update decimation of all plots in the chart.
+  void updatePlotDecimations(bool useAxisRange);
+
+  // Get point index in the plot series table from the point index in the (possibly decimated) plot.
+  vtkIdType plotSeriesPointIndex(vtkPlot* plot, vtkIdType plotPointIndex);
+
 public slots:
   /// Handle MRML scene event
   void startProcessing();
@@ -96,8 +112,28 @@ public slots:
 
   void emitSelection();
 
+  void onChartInteraction();
+
 protected:
 
+  struct PlotDecimation
+    {
+    /// Modification time of the plot series node and its table when the decimation was computed
+    vtkMTimeType SourceMTime{0};
+    /// X coordinates of plot series points are monotonically increasing (decimation is only possible then)
+    bool XMonotonic{false};
+    /// Indices of the first, last, minimum and maximum Y value points of the series
+    std::vector<vtkIdType> BoundaryPointIndices;
+    /// Visible X range that the decimation was computed for
+    double XRange[2]{0.0, -1.0};
+    int NumberOfBuckets{0};
+    /// Decimated copy of the plot series data and the corresponding original point indices
+    vtkSmartPointer<vtkTable> Table;
+    vtkSmartPointer<vtkIdTypeArray> PointIndices;
+    std::string XColumnName;
+    std::string YColumnName;
+    };
+
   vtkWeakPointer<vtkMRMLScene>         MRMLScene;
   vtkWeakPointer<vtkMRMLPlotViewNode>  MRMLPlotViewNode;
   vtkWeakPointer<vtkMRMLPlotChartNode> MRMLPlotChartNode;
@@ -108,6 +144,9 @@ protected:
   bool                               UpdatingWidgetFromMRML;
 
   QMap< vtkPlot*, QString > MapPlotToPlotSeriesNodeID;
+
+  int DecimationThreshold;
+  QMap< vtkPlot*, PlotDecimation > PlotDecimations;
 };
 
 #endif
@@ -372,6 +372,7 @@ void qMRMLSceneModel::setMRMLScene(vtkMRMLScene* scene)
     scene->AddObserver(vtkMRMLScene::EndImportEvent, d->CallBack);
     scene->AddObserver(vtkMRMLScene::StartBatchProcessEvent, d->CallBack);
     scene->AddObserver(vtkMRMLScene::EndBatchProcessEvent, d->CallBack);
+    scene->AddObserver(vtkMRMLScene::NodesModifiedEvent, d->CallBack);
     }
 }
 
@@ -1185,6 +1186,9 @@ void qMRMLSceneModel::onMRMLSceneEvent(vtkObject* vtk_obj, unsigned long event,
     case vtkMRMLScene::EndBatchProcessEvent:
       sceneModel->onMRMLSceneEndBatchProcess(scene);
       break;
+    case vtkMRMLScene::NodesModifiedEvent:
+      sceneModel->onMRMLSceneNodesModified(scene, reinterpret_cast<vtkCollection*>(call_data));
+      break;
     }
 }
 
@@ -1246,13 +1250,12 @@ void qMRMLSceneModel::onMRMLSceneNodeAboutToBeRemoved(vtkMRMLScene* scene, vtkMR
   // Remove all the observations on the node
   qvtkDisconnect(node, vtkCommand::NoEvent, this, nullptr);
 
-  // TODO: can be fasten by browsing the tree only once
-  QModelIndexList indexes = this->match(this->mrmlSceneIndex(), qMRMLSceneModel::UIDRole,
-                                        QString(node->GetID()), 1,
-                                        Qt::MatchExactly | Qt::MatchRecursive);
-  if (indexes.count())
+  // Use the row cache to find the node instead of browsing the whole tree
+  // (which made removing many nodes quadratic).
+  QModelIndex nodeIndex = this->indexFromNode(node);
+  if (nodeIndex.isValid())
     {
-    QStandardItem* item = this->itemFromIndex(indexes[0].sibling(indexes[0].row(),0));
+    QStandardItem* item = this->itemFromIndex(nodeIndex);
     // The children may be lost if not reparented, we ensure they got reparented.
     while (item->rowCount())
       {
@@ -1269,8 +1272,11 @@ void qMRMLSceneModel::onMRMLSceneNodeAboutToBeRemoved(vtkMRMLScene* scene, vtkMR
         d->Orphans.removeAll(orphans);
         }
       }
-    this->removeRow(indexes[0].row(), indexes[0].parent());
+    this->removeRow(nodeIndex.row(), nodeIndex.parent());
     }
+  // The cached index is invalid now, remove it so that later lookups
+  // do not fall back to searching through the whole model.
+  d->RowCache.remove(node);
 }
 
 //------------------------------------------------------------------------------
@@ -1363,6 +1369,11 @@ void qMRMLSceneModel::updateNodeItems()
 void qMRMLSceneModel::onMRMLNodeModified(vtkObject* node)
 {
   vtkMRMLNode* modifiedNode = vtkMRMLNode::SafeDownCast(node);
+  if (modifiedNode->GetScene() && modifiedNode->GetScene()->GetInvokingDeferredModifiedEvents())
+    {
+    // items are updated at once in onMRMLSceneNodesModified()
+    return;
+    }
   this->updateNodeItems(modifiedNode, QString(modifiedNode->GetID()));
 }
 
@@ -1543,6 +1554,29 @@ void qMRMLSceneModel::onMRMLSceneEndBatchProcess(vtkMRMLScene* scene)
     }
 }
 
+//------------------------------------------------------------------------------
+void qMRMLSceneModel::onMRMLSceneNodesModified(vtkMRMLScene* scene, vtkCollection* modifiedNodes)
+{
+  Q_UNUSED(scene);
+  if (!modifiedNodes)
+    {
+    return;
+    }
+  vtkMRMLNode* node = nullptr;
+  vtkCollectionSimpleIterator it;
+  for (modifiedNodes->InitTraversal(it);
+       (node = vtkMRMLNode::SafeDownCast(modifiedNodes->GetNextItemAsObject(it))) ;)
+    {
+    // only update the items of the nodes that the model listens to
+    if (!node->GetScene()
+      || !qvtkIsConnected(node, vtkCommand::ModifiedEvent, this, SLOT(onMRMLNodeModified(vtkObject*))))
+      {
+      continue;
+      }
+    this->updateNodeItems(node, QString(node->GetID()));
+    }
+}
+
 //------------------------------------------------------------------------------
 Qt::DropActions qMRMLSceneModel::supportedDropActions()const
 {
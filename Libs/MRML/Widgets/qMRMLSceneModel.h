@@ -31,6 +31,7 @@
 // qMRML includes
 #include "qMRMLWidgetsExport.h"
 
+class vtkCollection;
 class vtkMRMLNode;
 class vtkMRMLScene;
 
@@ -230,6 +231,9 @@ protected slots:
   virtual void onMRMLSceneClosed(vtkMRMLScene* scene);
   virtual void onMRMLSceneStartBatchProcess(vtkMRMLScene* scene);
   virtual void onMRMLSceneEndBatchProcess(vtkMRMLScene* scene);
+  /// Update the items of all the observed nodes that have been modified
+  /// while the scene was in vtkMRMLScene::DeferredModifyState.
+  virtual void onMRMLSceneNodesModified(vtkMRMLScene* scene, vtkCollection* modifiedNodes);
 
   void onMRMLSceneDeleted(vtkMRMLScene* scene);
 
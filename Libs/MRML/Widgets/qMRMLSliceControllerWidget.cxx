@@ -28,6 +28,7 @@
 #include <QMessageBox>
 #include <QPushButton>
 #include <QSpinBox>
+#include <QTimer>
 #include <QWidgetAction>
 
 // CTK includes
@@ -398,6 +399,11 @@ void qMRMLSliceControllerWidgetPrivate::init()
   this->SliderSpacer->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::Ignored);
   this->BarLayout->addWidget(this->SliderSpacer);
 
+  this->RefineRenderingTimer = new QTimer(q);
+  this->RefineRenderingTimer->setSingleShot(true);
+  QObject::connect(this->RefineRenderingTimer, SIGNAL(timeout()),
+                   this, SLOT(refineSliceLogicRendering()));
+
   this->SliceOffsetSlider = new qMRMLSliderWidget(q);
   this->SliceOffsetSlider->setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Preferred);
 
@@ -1304,6 +1310,26 @@ void qMRMLSliceControllerWidgetPrivate::onLabelMapNodeSelected(vtkMRMLNode * nod
   this->enableLayerWidgets();
 }
 
+// --------------------------------------------------------------------------
+void qMRMLSliceControllerWidgetPrivate::onSliceLogicRefineRenderingRequestedEvent()
+{
+  if (!this->SliceLogic)
+    {
+    return;
+    }
+  this->RefineRenderingTimer->start(this->SliceLogic->GetProgressiveRenderingRefinementDelay());
+}
+
+// --------------------------------------------------------------------------
+void qMRMLSliceControllerWidgetPrivate::refineSliceLogicRendering()
+{
+  if (!this->SliceLogic)
+    {
+    return;
+    }
+  this->SliceLogic->RefineRendering();
+}
+
 // --------------------------------------------------------------------------
 void qMRMLSliceControllerWidgetPrivate::onSliceLogicModifiedEvent()
 {
@@ -1782,7 +1808,15 @@ void qMRMLSliceControllerWidget::setSliceLogic(vtkMRMLSliceLogic * newSliceLogic
 
   d->qvtkReconnect(d->SliceLogic, newSliceLogic, vtkCommand::ModifiedEvent,
                    d, SLOT(onSliceLogicModifiedEvent()));
+  d->qvtkReconnect(d->SliceLogic, newSliceLogic, vtkMRMLSliceLogic::RefineRenderingRequestedEvent,
+                   d, SLOT(onSliceLogicRefineRenderingRequestedEvent()));
 
+  if (d->SliceLogic)
+    {
+    // do not leave the previous slice logic at reduced quality
+    d->RefineRenderingTimer->stop();
+    d->SliceLogic->RefineRendering();
+    }
   d->SliceLogic = newSliceLogic;
 
   if (d->SliceLogic && d->SliceLogic->GetMRMLScene())
@@ -56,6 +56,7 @@ class ctkSignalMapper;
 class ctkDoubleSpinBox;
 class ctkVTKSliceView;
 class QSpinBox;
+class QTimer;
 class qMRMLSliderWidget;
 class vtkMRMLSliceNode;
 class vtkObject;
@@ -155,6 +156,12 @@ public slots:
   /// Called after the SliceLogic is modified
   void onSliceLogicModifiedEvent();
 
+  /// Called at the end of an interaction that the SliceLogic rendered at
+  /// reduced quality, restart the refinement timer
+  void onSliceLogicRefineRenderingRequestedEvent();
+  /// Called when the interaction is idle, render at full quality
+  void refineSliceLogicRendering();
+
   void applyCustomLightbox();
 
   void updateSliceOffsetSliderVisibility();
@@ -170,6 +177,7 @@ public:
   vtkSmartPointer<vtkMRMLSliceLogic>  SliceLogic;
   vtkCollection*                      SliceLogics;
   vtkWeakPointer<vtkAlgorithmOutput>  ImageDataConnection;
+  QTimer*                             RefineRenderingTimer{nullptr};
   QButtonGroup*                       ControllerButtonGroup;
 
   QToolButton*                        FitToWindowToolButton;
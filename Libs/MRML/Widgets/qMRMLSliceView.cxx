@@ -195,6 +195,7 @@ void qMRMLSliceViewPrivate::initDisplayableManagers()
 
   QStringList displayableManagers;
   displayableManagers << "vtkMRMLVolumeGlyphSliceDisplayableManager";
+  displayableManagers << "vtkMRMLVolumeGPUSliceDisplayableManager";
   displayableManagers << "vtkMRMLModelSliceDisplayableManager";
   displayableManagers << "vtkMRMLCrosshairDisplayableManager";
   displayableManagers << "vtkMRMLOrientationMarkerDisplayableManager";
@@ -213,6 +214,10 @@ void qMRMLSliceViewPrivate::initDisplayableManagers()
       q->lightBoxRendererManager()->GetRenderer(0));
 
   this->InteractorObserver->SetDisplayableManagers(this->DisplayableManagerGroup);
+  // Limit the update rate to keep the application responsive when many render requests
+  // are received (the Qt event loop processes the deferred render request timer events).
+  this->DisplayableManagerGroup->SetMaximumUpdateRate(60.0);
+  this->DisplayableManagerGroup->AdaptiveUpdateRateOn();
   // Observe displayable manager group to catch RequestRender events
   q->qvtkConnect(this->DisplayableManagerGroup, vtkCommand::UpdateEvent,
                  q, SLOT(scheduleRender()));
@@ -339,6 +344,13 @@ vtkMRMLAbstractDisplayableManager* qMRMLSliceView::displayableManagerByClassName
   return d->DisplayableManagerGroup->GetDisplayableManagerByClassName(className);
 }
 
+//------------------------------------------------------------------------------
+vtkMRMLDisplayableManagerGroup* qMRMLSliceView::displayableManagerGroup()const
+{
+  Q_D(const qMRMLSliceView);
+  return d->DisplayableManagerGroup;
+}
+
 
 //------------------------------------------------------------------------------
 void qMRMLSliceView::setMRMLScene(vtkMRMLScene* newScene)
@@ -31,6 +31,7 @@ class QDropEvent;
 class qMRMLSliceViewPrivate;
 class vtkCollection;
 class vtkMRMLAbstractDisplayableManager;
+class vtkMRMLDisplayableManagerGroup;
 class vtkMRMLScene;
 class vtkMRMLSliceNode;
 class vtkMRMLSliceViewInteractorStyle;
@@ -75,6 +76,11 @@ public:
   /// Return a DisplayableManager given its class name
   Q_INVOKABLE  vtkMRMLAbstractDisplayableManager* displayableManagerByClassName(const char* className);
 
+  /// Return the group of displayable managers of this view.
+  /// It can be used for measuring time spent in updating and rendering the view.
+  /// \sa vtkMRMLDisplayableManagerGroup::SetProfilingEnabled()
+  Q_INVOKABLE vtkMRMLDisplayableManagerGroup* displayableManagerGroup()const;
+
   /// Get the 3D View node observed by view.
   Q_INVOKABLE vtkMRMLSliceNode* mrmlSliceNode()const;
 
@@ -27,6 +27,7 @@
 // VTK includes
 #include <vtkMRMLNode.h>
 #include <vtkMRMLScene.h>
+#include <vtkWeakPointer.h>
 
 // -----------------------------------------------------------------------------
 // qMRMLSortFilterProxyModelPrivate
@@ -37,6 +38,22 @@ class qMRMLSortFilterProxyModelPrivate
 public:
   qMRMLSortFilterProxyModelPrivate();
 
+  /// Part of the filtering result that only depends on the class of the node
+  struct ClassFilterResult
+    {
+    /// First element of NodeTypes that the class matches (taking into account
+    /// ShowChildNodeTypes). Empty if the class does not match any of the node types.
+    QString MatchedNodeType;
+    /// The class is a child of one of the HideChildNodeTypes
+    bool HiddenChildNodeType{false};
+    /// The class is one of the ShowHiddenForTypes
+    bool ShowHiddenForType{false};
+    };
+
+  /// Get class filter result for the node. The result is computed only once for
+  /// each class, which avoids many string comparisons for scenes that contain many nodes.
+  ClassFilterResult classFilterResult(vtkMRMLNode* node)const;
+
   QStringList                      NodeTypes;
   bool                             ShowHidden;
   QStringList                      ShowHiddenForTypes;
@@ -48,6 +65,13 @@ public:
   typedef QPair<QString, QVariant> AttributeType;
   QHash<QString, AttributeType>    Attributes;
   qMRMLSortFilterProxyModel::FilterType Filter;
+
+  /// Cache of ClassFilterResult by class name. Must be cleared when NodeTypes,
+  /// ShowChildNodeTypes, HideChildNodeTypes, or ShowHiddenForTypes are changed.
+  mutable QHash<QString, ClassFilterResult> ClassFilterResultCache;
+  /// Nodes that are observed for attribute changes. Weak pointers are stored
+  /// to detect if a node is deleted and another one is created at the same address.
+  QHash<vtkMRMLNode*, vtkWeakPointer<vtkMRMLNode> > AttributeObservedNodes;
 };
 
 // -----------------------------------------------------------------------------
@@ -58,6 +82,56 @@ qMRMLSortFilterProxyModelPrivate::qMRMLSortFilterProxyModelPrivate()
   this->Filter = qMRMLSortFilterProxyModel::UseFilters;
 }
 
+// -----------------------------------------------------------------------------
+qMRMLSortFilterProxyModelPrivate::ClassFilterResult qMRMLSortFilterProxyModelPrivate
+::classFilterResult(vtkMRMLNode* node)const
+{
+  QString className = QString::fromUtf8(node->GetClassName());
+  QHash<QString, ClassFilterResult>::const_iterator resultIt = this->ClassFilterResultCache.constFind(className);
+  if (resultIt != this->ClassFilterResultCache.constEnd())
+    {
+    return resultIt.value();
+    }
+  ClassFilterResult result;
+  foreach(const QString& nodeType, this->ShowHiddenForTypes)
+    {
+    if (node->IsA(nodeType.toUtf8()))
+      {
+      result.ShowHiddenForType = true;
+      break;
+      }
+    }
+  foreach(const QString& nodeType, this->NodeTypes)
+    {
+    // filter by node type
+    if (!node->IsA(nodeType.toUtf8().data()))
+      {
+      continue;
+      }
+    // filter by excluded child node types
+    if (!this->ShowChildNodeTypes && nodeType != className)
+      {
+      continue;
+      }
+    result.MatchedNodeType = nodeType;
+    // filter by HideChildNodeType
+    if (this->ShowChildNodeTypes)
+      {
+      foreach(const QString& hideChildNodeType, this->HideChildNodeTypes)
+        {
+        if (node->IsA(hideChildNodeType.toUtf8().data()))
+          {
+          result.HiddenChildNodeType = true;
+          break;
+          }
+        }
+      }
+    break;
+    }
+  this->ClassFilterResultCache.insert(className, result);
+  return result;
+}
+
 // -----------------------------------------------------------------------------
 // qMRMLSortFilterProxyModel
 
@@ -231,22 +305,11 @@ qMRMLSortFilterProxyModel::AcceptType qMRMLSortFilterProxyModel
     {
     return Accept;
     }
+  qMRMLSortFilterProxyModelPrivate::ClassFilterResult classFilter = d->classFilterResult(node);
   // HideFromEditors property
-  if (!d->ShowHidden && node->GetHideFromEditors())
+  if (!d->ShowHidden && node->GetHideFromEditors() && !classFilter.ShowHiddenForType)
     {
-    bool hide = true;
-    foreach(const QString& nodeType, d->ShowHiddenForTypes)
-      {
-      if (node->IsA(nodeType.toUtf8()))
-        {
-        hide = false;
-        break;
-        }
-      }
-    if (hide)
-      {
-      return Reject;
-      }
+    return Reject;
     }
 
   if (!d->HideNodesUnaffiliatedWithNodeID.isEmpty())
@@ -266,66 +329,56 @@ qMRMLSortFilterProxyModel::AcceptType qMRMLSortFilterProxyModel
     // Apply filter if any
     return AcceptButPotentiallyRejectable;
     }
-  foreach(const QString& nodeType, d->NodeTypes)
+  // filter by node type (and excluded child node types)
+  if (classFilter.MatchedNodeType.isEmpty())
     {
-    // filter by node type
-    if (!node->IsA(nodeType.toUtf8().data()))
-      {
-      //std::cout << "Reject node: " << node->GetName() << "(" << node->GetID()
-      //          << ") type: " << typeid(*node).name() <<std::endl;
-      continue;
-      }
-    // filter by excluded child node types
-    if (!d->ShowChildNodeTypes && nodeType != node->GetClassName())
-      {
-      continue;
-      }
-    // filter by HideChildNodeType
-    if (d->ShowChildNodeTypes)
-      {
-      foreach(const QString& hideChildNodeType, d->HideChildNodeTypes)
-        {
-        if (node->IsA(hideChildNodeType.toUtf8().data()))
-          {
-          return Reject;
-          }
-        }
-      }
-
-    // filter by attributes
-    if (d->Attributes.contains(nodeType))
+    return Reject;
+    }
+  // filter by HideChildNodeType
+  if (classFilter.HiddenChildNodeType)
+    {
+    return Reject;
+    }
+  QString nodeType = classFilter.MatchedNodeType;
+  // filter by attributes
+  if (d->Attributes.contains(nodeType))
+    {
+    // Observing the node is only needed once. Checking if the connection already exists
+    // (as it is done by Qt::UniqueConnection) would be slow if many nodes are observed.
+    vtkWeakPointer<vtkMRMLNode>& observedNode = const_cast<qMRMLSortFilterProxyModelPrivate*>(d)->AttributeObservedNodes[node];
+    if (observedNode.GetPointer() != node)
       {
       // can be optimized if the event is AttributeModifiedEvent instead of modifiedevent
       const_cast<qMRMLSortFilterProxyModel*>(this)->qvtkConnect(
         node, vtkCommand::ModifiedEvent,
         const_cast<qMRMLSortFilterProxyModel*>(this),
         SLOT(invalidate()),0., Qt::UniqueConnection);
+      observedNode = node;
+      }
 
-      QString attributeName = d->Attributes[nodeType].first;
-      const char *nodeAttribute = node->GetAttribute(attributeName.toUtf8());
-      QString nodeAttributeQString = node->GetAttribute(attributeName.toUtf8());
-      QString testAttribute = d->Attributes[nodeType].second.toString();
+    QString attributeName = d->Attributes[nodeType].first;
+    const char *nodeAttribute = node->GetAttribute(attributeName.toUtf8());
+    QString nodeAttributeQString = node->GetAttribute(attributeName.toUtf8());
+    QString testAttribute = d->Attributes[nodeType].second.toString();
 
-      //std::cout << "attribute name = " << qPrintable(attributeName) << "\n\ttestAttribute = " << qPrintable(testAttribute) << "\n\t" << node->GetID() << " nodeAttributeQString = " << qPrintable(nodeAttributeQString) << "\n\t\tas char str = " << (nodeAttribute ? nodeAttribute : "null") << "." << std::endl;
-      // fail if the attribute isn't defined on the node at all
-      if (nodeAttribute == nullptr)
+    //std::cout << "attribute name = " << qPrintable(attributeName) << "\n\ttestAttribute = " << qPrintable(testAttribute) << "\n\t" << node->GetID() << " nodeAttributeQString = " << qPrintable(nodeAttributeQString) << "\n\t\tas char str = " << (nodeAttribute ? nodeAttribute : "null") << "." << std::endl;
+    // fail if the attribute isn't defined on the node at all
+    if (nodeAttribute == nullptr)
+      {
+      return RejectButPotentiallyAcceptable;
+      }
+    // if the filter value is null, any node attribute value will match
+    if (!d->Attributes[nodeType].second.isNull())
+      {
+      // otherwise, the node and filter attributes have to match
+      if (testAttribute != nodeAttribute)
         {
         return RejectButPotentiallyAcceptable;
         }
-      // if the filter value is null, any node attribute value will match
-      if (!d->Attributes[nodeType].second.isNull())
-        {
-        // otherwise, the node and filter attributes have to match
-        if (testAttribute != nodeAttribute)
-          {
-          return RejectButPotentiallyAcceptable;
-          }
-        }
       }
-    // Apply filter if any
-    return AcceptButPotentiallyRejectable;
     }
-  return Reject;
+  // Apply filter if any
+  return AcceptButPotentiallyRejectable;
 }
 
 //-----------------------------------------------------------------------------
@@ -351,6 +404,7 @@ void qMRMLSortFilterProxyModel::setHideChildNodeTypes(const QStringList& _nodeTy
     return;
     }
   d->HideChildNodeTypes = _nodeTypes;
+  d->ClassFilterResultCache.clear();
   this->invalidateFilter();
 }
 
@@ -363,6 +417,7 @@ void qMRMLSortFilterProxyModel::setNodeTypes(const QStringList& _nodeTypes)
     return;
     }
   d->NodeTypes = _nodeTypes;
+  d->ClassFilterResultCache.clear();
   this->invalidateFilter();
 }
 
@@ -375,6 +430,7 @@ void qMRMLSortFilterProxyModel::setShowChildNodeTypes(bool _show)
     return;
     }
   d->ShowChildNodeTypes = _show;
+  d->ClassFilterResultCache.clear();
   invalidateFilter();
 }
 
@@ -413,6 +469,7 @@ void qMRMLSortFilterProxyModel::setShowHiddenForTypes(const QStringList& types)
     return;
     }
   d->ShowHiddenForTypes = types;
+  d->ClassFilterResultCache.clear();
   this->invalidateFilter();
 }
 
@@ -143,6 +143,10 @@ void qMRMLThreeDViewPrivate::initDisplayableManagers()
   this->DisplayableManagerGroup
     = factory->InstantiateDisplayableManagers(q->renderer());
   this->InteractorObserver->SetDisplayableManagers(this->DisplayableManagerGroup);
+  // Limit the update rate to keep the application responsive when many render requests
+  // are received (the Qt event loop processes the deferred render request timer events).
+  this->DisplayableManagerGroup->SetMaximumUpdateRate(60.0);
+  this->DisplayableManagerGroup->AdaptiveUpdateRateOn();
   // Observe displayable manager group to catch RequestRender events
   this->qvtkConnect(this->DisplayableManagerGroup, vtkCommand::UpdateEvent,
                     q, SLOT(scheduleRender()));
@@ -511,6 +515,13 @@ vtkMRMLAbstractDisplayableManager* qMRMLThreeDView::displayableManagerByClassNam
   return d->DisplayableManagerGroup->GetDisplayableManagerByClassName(className);
 }
 
+// --------------------------------------------------------------------------
+vtkMRMLDisplayableManagerGroup* qMRMLThreeDView::displayableManagerGroup()const
+{
+  Q_D(const qMRMLThreeDView);
+  return d->DisplayableManagerGroup;
+}
+
 // --------------------------------------------------------------------------
 void qMRMLThreeDView::setViewCursor(const QCursor &cursor)
 {
@@ -0,0 +1,171 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// RemoteIO includes
+#include "vtkHTTPHandler.h"
+#include "vtkRemoteIOTestingHTTPServer.h"
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+
+// VTK includes
+#include <vtkNew.h>
+
+// VTKsys includes
+#include <vtksys/SystemTools.hxx>
+
+// STD includes
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+
+//---------------------------------------------------------------------------
+std::string ReadFile(const std::string& fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+//---------------------------------------------------------------------------
+void WriteFile(const std::string& fileName, const std::string& content)
+{
+  std::ofstream file(fileName.c_str(), std::ios::binary);
+  file << content;
+}
+
+//---------------------------------------------------------------------------
+/// Return the content of a file of \a size bytes, different for each \a seed
+std::string GenerateContent(size_t size, int seed)
+{
+  std::string content(size, '\0');
+  for (size_t index = 0; index < size; ++index)
+    {
+    content[index] = static_cast<char>((index * 7 + seed) % 251);
+    }
+  return content;
+}
+
+//---------------------------------------------------------------------------
+void RemoveDownload(const std::string& destination)
+{
+  vtksys::SystemTools::RemoveFile(destination);
+  vtksys::SystemTools::RemoveFile(destination + ".part");
+  vtksys::SystemTools::RemoveFile(destination + ".part.validator");
+}
+
+} // end of anonymous namespace
+
+//---------------------------------------------------------------------------
+int vtkHTTPHandlerTest1(int argc, char * argv[])
+{
+  if (argc < 2)
+    {
+    std::cerr << "Usage: " << argv[0] << " /path/to/temp" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::string tempDir = argv[1];
+
+  vtkRemoteIOTestingHTTPServer server;
+  CHECK_BOOL(server.Start(), true);
+  const size_t fileSize = 100000;
+  const size_t interruptedSize = 40000;
+  std::string content = GenerateContent(fileSize, 1);
+  server.SetResource("/file.bin", content, "\"v1\"");
+  std::string url = server.GetURL() + "/file.bin";
+
+  vtkNew<vtkHTTPHandler> handler;
+  // download in a single request, so that the file is only probed when a download is resumed
+  handler->SetNumberOfParallelSegments(1);
+  CHECK_BOOL(handler->GetResumeDownload(), true);
+
+  // Interrupted download: the partial file is kept with the validator of the file
+  std::string destination = tempDir + "/vtkHTTPHandlerTest1.bin";
+  RemoveDownload(destination);
+  server.InterruptNextResponse(interruptedSize);
+  handler->StageFileRead(url.c_str(), destination.c_str());
+  CHECK_BOOL(vtksys::SystemTools::FileExists(destination), false);
+  CHECK_INT(static_cast<int>(ReadFile(destination + ".part").size()), static_cast<int>(interruptedSize));
+  CHECK_STD_STRING(ReadFile(destination + ".part.validator"), "\"v1\"\n");
+
+  // Resumed download: only the missing bytes are requested, if the file has not changed
+  server.ClearRequests();
+  handler->StageFileRead(url.c_str(), destination.c_str());
+  CHECK_BOOL(ReadFile(destination) == content, true);
+  CHECK_BOOL(vtksys::SystemTools::FileExists(destination + ".part"), false);
+  CHECK_BOOL(vtksys::SystemTools::FileExists(destination + ".part.validator"), false);
+  std::vector<vtkRemoteIOTestingHTTPServer::Request> requests = server.GetRequests();
+  CHECK_INT(static_cast<int>(requests.size()), 2);
+  CHECK_STD_STRING(requests[0].GetHeader("range"), "bytes=0-0");
+  CHECK_STD_STRING(requests[1].GetHeader("range"), "bytes=" + std::to_string(interruptedSize) + "-");
+  CHECK_STD_STRING(requests[1].GetHeader("if-range"), "\"v1\"");
+
+  // File changed on the server since the partial download: it is downloaded again
+  RemoveDownload(destination);
+  server.InterruptNextResponse(interruptedSize);
+  handler->StageFileRead(url.c_str(), destination.c_str());
+  CHECK_STD_STRING(ReadFile(destination + ".part.validator"), "\"v1\"\n");
+  std::string changedContent = GenerateContent(fileSize, 2);
+  server.SetResource("/file.bin", changedContent, "\"v2\"");
+  server.ClearRequests();
+  handler->StageFileRead(url.c_str(), destination.c_str());
+  CHECK_BOOL(ReadFile(destination) == changedContent, true);
+  requests = server.GetRequests();
+  CHECK_INT(static_cast<int>(requests.size()), 2);
+  CHECK_STD_STRING(requests[1].GetHeader("range"), "");
+
+  // Partial file without validator (e.g. left by an earlier version): it is not resumed
+  RemoveDownload(destination);
+  WriteFile(destination + ".part", GenerateContent(interruptedSize, 3));
+  server.ClearRequests();
+  handler->StageFileRead(url.c_str(), destination.c_str());
+  CHECK_BOOL(ReadFile(destination) == changedContent, true);
+  requests = server.GetRequests();
+  CHECK_INT(static_cast<int>(requests.size()), 1);
+  CHECK_STD_STRING(requests[0].GetHeader("range"), "");
+
+  // Server that does not send any validator: partial files cannot be resumed and are removed
+  server.SetResource("/novalidator.bin", content, "");
+  std::string noValidatorURL = server.GetURL() + "/novalidator.bin";
+  RemoveDownload(destination);
+  server.InterruptNextResponse(interruptedSize);
+  handler->StageFileRead(noValidatorURL.c_str(), destination.c_str());
+  CHECK_BOOL(vtksys::SystemTools::FileExists(destination + ".part"), false);
+  CHECK_BOOL(vtksys::SystemTools::FileExists(destination + ".part.validator"), false);
+
+  // Resume disabled: partial files are removed
+  handler->SetResumeDownload(false);
+  RemoveDownload(destination);
+  server.InterruptNextResponse(interruptedSize);
+  handler->StageFileRead(url.c_str(), destination.c_str());
+  CHECK_BOOL(vtksys::SystemTools::FileExists(destination + ".part"), false);
+  CHECK_BOOL(vtksys::SystemTools::FileExists(destination + ".part.validator"), false);
+  handler->SetResumeDownload(true);
+
+  // Segmented download
+  handler->SetNumberOfParallelSegments(4);
+  handler->SetMinimumSegmentSize(fileSize / 4);
+  RemoveDownload(destination);
+  server.ClearRequests();
+  handler->StageFileRead(url.c_str(), destination.c_str());
+  CHECK_BOOL(ReadFile(destination) == changedContent, true);
+  CHECK_INT(static_cast<int>(server.GetRequests().size()), 5);
+
+  RemoveDownload(destination);
+  server.Stop();
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
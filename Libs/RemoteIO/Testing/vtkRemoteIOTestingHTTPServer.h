@@ -0,0 +1,420 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __vtkRemoteIOTestingHTTPServer_h
+#define __vtkRemoteIOTestingHTTPServer_h
+
+#if defined(_WIN32)
+# include <winsock2.h>
+# include <ws2tcpip.h>
+#else
+# include <arpa/inet.h>
+# include <netinet/in.h>
+# include <sys/select.h>
+# include <sys/socket.h>
+# include <sys/types.h>
+# include <unistd.h>
+#endif
+
+// STD includes
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// \brief Minimal HTTP/1.1 server used to test the RemoteIO handlers.
+///
+/// The server listens on a free port of the loopback interface and answers one
+/// request per connection, each connection in its own thread:
+/// - GET returns the content of a resource, with support of byte ranges and If-Range.
+/// - PUT stores the body as the resource of the request path and returns an ETag.
+/// - POST returns the response of an S3 multipart upload creation ("?uploads") or completion.
+/// - DELETE returns 204.
+/// All the requests are recorded, so that tests can check what the handlers sent.
+class vtkRemoteIOTestingHTTPServer
+{
+public:
+#if defined(_WIN32)
+  typedef SOCKET SocketType;
+#else
+  typedef int SocketType;
+#endif
+
+  struct Request
+    {
+    std::string Method;
+    /// Path and query of the request
+    std::string Target;
+    /// Header values by lower case header name
+    std::map<std::string, std::string> Headers;
+    std::string Body;
+    /// ETag header of the response, if any
+    std::string ResponseETag;
+
+    std::string GetHeader(const std::string& name) const
+      {
+      auto headerIt = this->Headers.find(name);
+      return headerIt != this->Headers.end() ? headerIt->second : std::string();
+      }
+    };
+
+  vtkRemoteIOTestingHTTPServer() = default;
+  ~vtkRemoteIOTestingHTTPServer()
+    {
+    this->Stop();
+    }
+
+  /// Start listening. Returns false if the server could not be started.
+  bool Start()
+    {
+#if defined(_WIN32)
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+      {
+      return false;
+      }
+#endif
+    this->ListenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (this->ListenSocket == InvalidSocket())
+      {
+      return false;
+      }
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t addressLength = sizeof(address);
+    if (bind(this->ListenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || listen(this->ListenSocket, 32) != 0
+        || getsockname(this->ListenSocket, reinterpret_cast<sockaddr*>(&address), &addressLength) != 0)
+      {
+      CloseSocket(this->ListenSocket);
+      this->ListenSocket = InvalidSocket();
+      return false;
+      }
+    this->Port = ntohs(address.sin_port);
+    this->StopRequested = false;
+    this->ListenThread = std::thread(&vtkRemoteIOTestingHTTPServer::Run, this);
+    return true;
+    }
+
+  /// Stop listening and wait for the connections to be closed
+  void Stop()
+    {
+    if (this->ListenSocket == InvalidSocket())
+      {
+      return;
+      }
+    this->StopRequested = true;
+    this->ListenThread.join();
+    for (std::thread& connectionThread : this->ConnectionThreads)
+      {
+      connectionThread.join();
+      }
+    this->ConnectionThreads.clear();
+    CloseSocket(this->ListenSocket);
+    this->ListenSocket = InvalidSocket();
+#if defined(_WIN32)
+    WSACleanup();
+#endif
+    }
+
+  /// Return "http://127.0.0.1:<port>"
+  std::string GetURL() const
+    {
+    return "http://127.0.0.1:" + std::to_string(this->Port);
+    }
+
+  /// Set the content returned for GET requests of \a path.
+  /// No ETag header is sent if \a eTag is empty.
+  void SetResource(const std::string& path, const std::string& content, const std::string& eTag)
+    {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Resources[path] = Resource{content, eTag};
+    }
+
+  /// Return the content of the resource \a path (e.g. uploaded by a PUT request)
+  std::string GetResource(const std::string& path)
+    {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto resourceIt = this->Resources.find(path);
+    return resourceIt != this->Resources.end() ? resourceIt->second.Content : std::string();
+    }
+
+  /// Close the connection after sending \a numberOfBytes of the body of the
+  /// next GET response that is longer, to simulate an interrupted download.
+  void InterruptNextResponse(size_t numberOfBytes)
+    {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->InterruptAfter = numberOfBytes;
+    }
+
+  /// Return the requests received since the server started or ClearRequests() was called
+  std::vector<Request> GetRequests()
+    {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->Requests;
+    }
+
+  void ClearRequests()
+    {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Requests.clear();
+    }
+
+private:
+  struct Resource
+    {
+    std::string Content;
+    std::string ETag;
+    };
+
+  static SocketType InvalidSocket()
+    {
+#if defined(_WIN32)
+    return INVALID_SOCKET;
+#else
+    return -1;
+#endif
+    }
+
+  static void CloseSocket(SocketType socketToClose)
+    {
+#if defined(_WIN32)
+    closesocket(socketToClose);
+#else
+    close(socketToClose);
+#endif
+    }
+
+  static bool SendAll(SocketType connection, const std::string& data)
+    {
+#if defined(MSG_NOSIGNAL)
+    const int flags = MSG_NOSIGNAL;
+#else
+    const int flags = 0;
+#endif
+    size_t numberOfSentBytes = 0;
+    while (numberOfSentBytes < data.size())
+      {
+      int sent = static_cast<int>(send(connection, data.data() + numberOfSentBytes,
+        static_cast<int>(data.size() - numberOfSentBytes), flags));
+      if (sent <= 0)
+        {
+        return false;
+        }
+      numberOfSentBytes += static_cast<size_t>(sent);
+      }
+    return true;
+    }
+
+  static std::string Trim(const std::string& text)
+    {
+    std::string::size_type first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos)
+      {
+      return std::string();
+      }
+    std::string::size_type last = text.find_last_not_of(" \t\r\n");
+    return text.substr(first, last - first + 1);
+    }
+
+  void Run()
+    {
+    while (!this->StopRequested)
+      {
+      fd_set readSet;
+      FD_ZERO(&readSet);
+      FD_SET(this->ListenSocket, &readSet);
+      timeval timeout = {0, 100000};
+      if (select(static_cast<int>(this->ListenSocket) + 1, &readSet, nullptr, nullptr, &timeout) <= 0)
+        {
+        continue;
+        }
+      SocketType connection = accept(this->ListenSocket, nullptr, nullptr);
+      if (connection == InvalidSocket())
+        {
+        continue;
+        }
+      this->ConnectionThreads.emplace_back([this, connection]()
+        {
+        this->HandleConnection(connection);
+        CloseSocket(connection);
+        });
+      }
+    }
+
+  void HandleConnection(SocketType connection)
+    {
+    std::string data;
+    char buffer[65536];
+    std::string::size_type headerEnd = std::string::npos;
+    while ((headerEnd = data.find("\r\n\r\n")) == std::string::npos)
+      {
+      int received = static_cast<int>(recv(connection, buffer, sizeof(buffer), 0));
+      if (received <= 0)
+        {
+        return;
+        }
+      data.append(buffer, static_cast<size_t>(received));
+      }
+
+    Request request;
+    std::string::size_type lineStart = 0;
+    std::string::size_type lineEnd = data.find("\r\n");
+    std::string requestLine = data.substr(0, lineEnd);
+    std::string::size_type methodEnd = requestLine.find(' ');
+    std::string::size_type targetEnd = requestLine.find(' ', methodEnd + 1);
+    if (methodEnd == std::string::npos || targetEnd == std::string::npos)
+      {
+      return;
+      }
+    request.Method = requestLine.substr(0, methodEnd);
+    request.Target = requestLine.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+    while (lineEnd < headerEnd)
+      {
+      lineStart = lineEnd + 2;
+      lineEnd = data.find("\r\n", lineStart);
+      std::string line = data.substr(lineStart, lineEnd - lineStart);
+      std::string::size_type separator = line.find(':');
+      if (separator == std::string::npos)
+        {
+        continue;
+        }
+      std::string name = line.substr(0, separator);
+      std::transform(name.begin(), name.end(), name.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+      request.Headers[name] = Trim(line.substr(separator + 1));
+      }
+
+    size_t contentLength = static_cast<size_t>(std::strtoull(request.GetHeader("content-length").c_str(), nullptr, 10));
+    request.Body = data.substr(headerEnd + 4);
+    if (request.Body.size() < contentLength && request.GetHeader("expect") == "100-continue")
+      {
+      SendAll(connection, "HTTP/1.1 100 Continue\r\n\r\n");
+      }
+    while (request.Body.size() < contentLength)
+      {
+      int received = static_cast<int>(recv(connection, buffer, sizeof(buffer), 0));
+      if (received <= 0)
+        {
+        return;
+        }
+      request.Body.append(buffer, static_cast<size_t>(received));
+      }
+
+    std::string path = request.Target.substr(0, request.Target.find('?'));
+    std::string query = request.Target.find('?') != std::string::npos
+      ? request.Target.substr(request.Target.find('?') + 1) : std::string();
+    std::string status = "200 OK";
+    std::string headers;
+    std::string body;
+    size_t numberOfBodyBytesToSend = std::string::npos;
+      {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      if (request.Method == "GET")
+        {
+        auto resourceIt = this->Resources.find(path);
+        if (resourceIt == this->Resources.end())
+          {
+          status = "404 Not Found";
+          }
+        else
+          {
+          const Resource& resource = resourceIt->second;
+          body = resource.Content;
+          if (!resource.ETag.empty())
+            {
+            request.ResponseETag = resource.ETag;
+            headers += "ETag: " + resource.ETag + "\r\n";
+            }
+          headers += "Accept-Ranges: bytes\r\n";
+          std::string range = request.GetHeader("range");
+          std::string ifRange = request.GetHeader("if-range");
+          // the whole resource is sent if it has changed since the validator was received
+          bool rangeValid = range.compare(0, 6, "bytes=") == 0 && (ifRange.empty() || ifRange == resource.ETag);
+          std::string::size_type rangeSeparator = range.find('-');
+          if (rangeValid && rangeSeparator != std::string::npos)
+            {
+            size_t first = static_cast<size_t>(std::strtoull(range.c_str() + 6, nullptr, 10));
+            size_t last = rangeSeparator + 1 < range.size()
+              ? static_cast<size_t>(std::strtoull(range.c_str() + rangeSeparator + 1, nullptr, 10))
+              : resource.Content.size() - 1;
+            last = std::min(last, resource.Content.size() - 1);
+            if (first <= last)
+              {
+              status = "206 Partial Content";
+              body = resource.Content.substr(first, last - first + 1);
+              headers += "Content-Range: bytes " + std::to_string(first) + "-" + std::to_string(last)
+                + "/" + std::to_string(resource.Content.size()) + "\r\n";
+              }
+            }
+          if (this->InterruptAfter > 0 && body.size() > this->InterruptAfter)
+            {
+            numberOfBodyBytesToSend = this->InterruptAfter;
+            this->InterruptAfter = 0;
+            }
+          }
+        }
+      else if (request.Method == "PUT")
+        {
+        request.ResponseETag = "\"put" + std::to_string(++this->NumberOfPutRequests) + "\"";
+        headers += "ETag: " + request.ResponseETag + "\r\n";
+        if (query.empty())
+          {
+          this->Resources[path] = Resource{request.Body, request.ResponseETag};
+          }
+        }
+      else if (request.Method == "POST")
+        {
+        body = (query == "uploads")
+          ? "<InitiateMultipartUploadResult><UploadId>test-upload</UploadId></InitiateMultipartUploadResult>"
+          : "<CompleteMultipartUploadResult></CompleteMultipartUploadResult>";
+        }
+      else if (request.Method == "DELETE")
+        {
+        status = "204 No Content";
+        }
+      this->Requests.push_back(request);
+      }
+
+    std::string response = "HTTP/1.1 " + status + "\r\n" + headers
+      + "Content-Length: " + std::to_string(body.size()) + "\r\n"
+      + "Connection: close\r\n\r\n";
+    if (request.Method != "HEAD")
+      {
+      response += body.substr(0, numberOfBodyBytesToSend);
+      }
+    SendAll(connection, response);
+    }
+
+  SocketType ListenSocket{InvalidSocket()};
+  int Port{0};
+  std::atomic<bool> StopRequested{false};
+  std::thread ListenThread;
+  std::vector<std::thread> ConnectionThreads;
+  std::mutex Mutex;
+  std::map<std::string, Resource> Resources;
+  std::vector<Request> Requests;
+  size_t InterruptAfter{0};
+  int NumberOfPutRequests{0};
+};
+
+#endif
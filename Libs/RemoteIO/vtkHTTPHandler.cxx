@@ -5,13 +5,249 @@
 // MRML includes
 #include <vtkPermissionPrompter.h>
 
+// VTK includes
+#include <vtkCommand.h>
+
+// VTKsys includes
+#include <vtksys/SystemTools.hxx>
+
 // CURL includes
 #include <curl/curl.h>
 
+// STD includes
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #if defined(_MSC_VER)
 #pragma warning ( disable : 4786 )
 #endif
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Share connections, DNS cache and SSL sessions between all the curl handles
+/// so that consecutive transfers to the same server reuse the connections.
+class SharedHandlePool
+{
+public:
+  /// Return the share handle, or nullptr if it could not be created.
+  /// curl_global_init() must be called first.
+  static CURLSH* GetShareHandle()
+    {
+    static SharedHandlePool pool;
+    return pool.ShareHandle;
+    }
+
+private:
+  SharedHandlePool()
+    {
+    this->ShareHandle = curl_share_init();
+    if (!this->ShareHandle)
+      {
+      return;
+      }
+    curl_share_setopt(this->ShareHandle, CURLSHOPT_LOCKFUNC, SharedHandlePool::Lock);
+    curl_share_setopt(this->ShareHandle, CURLSHOPT_UNLOCKFUNC, SharedHandlePool::Unlock);
+    curl_share_setopt(this->ShareHandle, CURLSHOPT_USERDATA, this);
+    curl_share_setopt(this->ShareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(this->ShareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#if LIBCURL_VERSION_NUM >= 0x073900
+    curl_share_setopt(this->ShareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+    }
+
+  ~SharedHandlePool()
+    {
+    if (this->ShareHandle)
+      {
+      curl_share_cleanup(this->ShareHandle);
+      }
+    }
+
+  static void Lock(CURL* vtkNotUsed(handle), curl_lock_data data,
+                   curl_lock_access vtkNotUsed(access), void* userPointer)
+    {
+    static_cast<SharedHandlePool*>(userPointer)->Locks[data].lock();
+    }
+
+  static void Unlock(CURL* vtkNotUsed(handle), curl_lock_data data, void* userPointer)
+    {
+    static_cast<SharedHandlePool*>(userPointer)->Locks[data].unlock();
+    }
+
+  CURLSH* ShareHandle{nullptr};
+  std::mutex Locks[CURL_LOCK_DATA_LAST];
+};
+
+//----------------------------------------------------------------------------
+/// Byte range of a file downloaded in parallel with the other segments.
+struct DownloadSegment
+{
+  CURL* Handle{nullptr};
+  FILE* File{nullptr};
+  std::string Range;
+  /// First byte of the segment
+  curl_off_t Start{0};
+  /// Last byte of the segment (inclusive)
+  curl_off_t End{0};
+  /// Position of the next byte to write
+  curl_off_t Offset{0};
+};
+
+//----------------------------------------------------------------------------
+/// Validator of a downloaded file, sent in If-Range requests so that a partial
+/// download is only resumed if the file has not changed on the server.
+struct ResponseValidator
+{
+  std::string ETag;
+  std::string LastModified;
+
+  /// Return the entity tag if there is one, otherwise the last modification date
+  std::string Get() const
+    {
+    return !this->ETag.empty() ? this->ETag : this->LastModified;
+    }
+};
+
+//----------------------------------------------------------------------------
+/// Result of a request to find out whether the server supports range requests
+struct RangeProbe
+{
+  curl_off_t ContentLength{-1};
+  curl_off_t NumberOfReceivedBytes{0};
+  ResponseValidator Validator;
+};
+
+//----------------------------------------------------------------------------
+/// Update \a validator from the response header line \a header.
+/// \a lowerCaseHeader is \a header in lower case.
+void UpdateValidator(ResponseValidator& validator, const std::string& header, const std::string& lowerCaseHeader)
+{
+  if (lowerCaseHeader.compare(0, 5, "http/") == 0)
+    {
+    // new response (e.g. after a redirection)
+    validator = ResponseValidator();
+    }
+  else if (lowerCaseHeader.compare(0, 5, "etag:") == 0)
+    {
+    std::string eTag = vtksys::SystemTools::TrimWhitespace(header.substr(5));
+    // weak entity tags cannot be used in If-Range
+    validator.ETag = (eTag.compare(0, 2, "W/") == 0) ? std::string() : eTag;
+    }
+  else if (lowerCaseHeader.compare(0, 14, "last-modified:") == 0)
+    {
+    validator.LastModified = vtksys::SystemTools::TrimWhitespace(header.substr(14));
+    }
+}
+
+//----------------------------------------------------------------------------
+size_t ValidatorHeaderCallback(char* buffer, size_t size, size_t nitems, void* userData)
+{
+  std::string header(buffer, size * nitems);
+  UpdateValidator(*static_cast<ResponseValidator*>(userData), header, vtksys::SystemTools::LowerCase(header));
+  return size * nitems;
+}
+
+//----------------------------------------------------------------------------
+/// Return the validator stored next to a partial download, or an empty string if there is none
+std::string ReadValidatorFile(const std::string& fileName)
+{
+  std::ifstream file(fileName.c_str());
+  std::string validator;
+  std::getline(file, validator);
+  return validator;
+}
+
+//----------------------------------------------------------------------------
+bool WriteValidatorFile(const std::string& fileName, const std::string& validator)
+{
+  std::ofstream file(fileName.c_str());
+  file << validator << std::endl;
+  return file.good();
+}
+
+//----------------------------------------------------------------------------
+int SeekFile(FILE* file, curl_off_t offset)
+{
+#if defined(_WIN32)
+  return _fseeki64(file, offset, SEEK_SET);
+#else
+  return fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+//----------------------------------------------------------------------------
+/// Return the size of the file in bytes or -1 if it does not exist
+curl_off_t GetFileSize(const std::string& fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary | std::ios::ate);
+  if (!file.is_open())
+    {
+    return -1;
+    }
+  return static_cast<curl_off_t>(file.tellg());
+}
+
+//----------------------------------------------------------------------------
+size_t SegmentWriteCallback(char* buffer, size_t size, size_t nmemb, void* userData)
+{
+  DownloadSegment* segment = static_cast<DownloadSegment*>(userData);
+  size_t numberOfBytes = size * nmemb;
+  // the server must not send more than the requested range
+  if (segment->Offset + static_cast<curl_off_t>(numberOfBytes) > segment->End + 1
+      || SeekFile(segment->File, segment->Offset) != 0)
+    {
+    return 0;
+    }
+  size_t written = fwrite(buffer, 1, numberOfBytes, segment->File);
+  segment->Offset += static_cast<curl_off_t>(written);
+  return written;
+}
+
+//----------------------------------------------------------------------------
+size_t ProbeWriteCallback(char* vtkNotUsed(buffer), size_t size, size_t nmemb, void* userData)
+{
+  RangeProbe* probe = static_cast<RangeProbe*>(userData);
+  probe->NumberOfReceivedBytes += static_cast<curl_off_t>(size * nmemb);
+  // abort if the server ignores the range and sends the whole file
+  return probe->NumberOfReceivedBytes > 1 ? 0 : size * nmemb;
+}
+
+//----------------------------------------------------------------------------
+size_t ProbeHeaderCallback(char* buffer, size_t size, size_t nitems, void* userData)
+{
+  RangeProbe* probe = static_cast<RangeProbe*>(userData);
+  std::string originalHeader(buffer, size * nitems);
+  std::string header = vtksys::SystemTools::LowerCase(originalHeader);
+  UpdateValidator(probe->Validator, originalHeader, header);
+  if (header.compare(0, 5, "http/") == 0)
+    {
+    // new response (e.g. after a redirection)
+    probe->ContentLength = -1;
+    }
+  else if (header.compare(0, 14, "content-range:") == 0)
+    {
+    // Content-Range: bytes 0-0/<total length or *>
+    std::string::size_type lengthPosition = header.find('/');
+    if (lengthPosition != std::string::npos && lengthPosition + 1 < header.size()
+        && std::isdigit(static_cast<unsigned char>(header[lengthPosition + 1])))
+      {
+      probe->ContentLength = static_cast<curl_off_t>(std::strtoll(header.c_str() + lengthPosition + 1, nullptr, 10));
+      }
+    }
+  return size * nitems;
+}
+
+} // end of anonymous namespace
+
 //----------------------------------------------------------------------------
 class vtkHTTPHandler::vtkInternal
 {
@@ -19,10 +255,53 @@ public:
   vtkInternal(vtkHTTPHandler* external);
   ~vtkInternal();
 
+  /// Set the options shared by all the requests and the request \a headers
+  void ConfigureHandle(CURL* handle, const char* url, const char* method,
+                       const std::vector<std::string>& headers = std::vector<std::string>());
+
+  /// Free the header list of \a handle and clean it up
+  void CleanupHandle(CURL* handle);
+
+  /// Return true if the server supports range requests for \a url,
+  /// in which case \a contentLength is set to the size of the file and
+  /// \a validator to its entity tag or last modification date (empty if the
+  /// server sent neither).
+  bool ProbeRangeSupport(const char* url, curl_off_t& contentLength, std::string& validator);
+
+  /// Download \a url into \a fileName in a single request. If \a resumeFrom
+  /// is positive, only the bytes after \a resumeFrom are requested with
+  /// \a ifRange validator and appended to the file. If the file has changed
+  /// on the server, it is downloaded again from the start.
+  /// StreamValidator is set to the validator of the received file.
+  bool DownloadStream(const char* url, const std::string& fileName,
+                      curl_off_t resumeFrom, curl_off_t contentLength, const std::string& ifRange);
+
+  /// Download \a url into \a fileName using parallel range requests
+  bool DownloadSegments(const char* url, const std::string& fileName, curl_off_t contentLength);
+
+  /// Invoke vtkCommand::ProgressEvent if the progress has changed enough
+  void ReportProgress(curl_off_t numberOfBytes, curl_off_t totalNumberOfBytes);
+
+  /// Report a failed transfer
+  void ReportError(const char* method, CURLcode error);
+
+  static int ProgressCallback(void* clientData, curl_off_t dltotal, curl_off_t dlnow,
+                              curl_off_t ultotal, curl_off_t ulnow);
+
   vtkHTTPHandler* External;
   CURL* CurlHandle;
   int ForbidReuse;
-};
+  /// Progress (in percent) reported by the last progress event
+  int LastProgressPercent{-1};
+  /// Number of bytes that were already downloaded when the transfer started
+  curl_off_t ResumeFrom{0};
+  curl_off_t ContentLength{-1};
+  /// Validator of the file written by the last DownloadStream() call, empty if
+  /// the server did not send any or if the last download was segmented.
+  std::string StreamValidator;
+  /// Header lists of the configured handles, freed when the handle is
+  /// configured again or cleaned up
+  std::map<CURL*, curl_slist*> HeaderLists;
 
 //----------------------------------------------------------------------------
 // vtkInternal methods
@@ -38,6 +317,343 @@ vtkHTTPHandler::vtkInternal::vtkInternal(vtkHTTPHandler* external):External(exte
 vtkHTTPHandler::vtkInternal::~vtkInternal()
 {
   this->CurlHandle = nullptr;
+  for (auto& handleHeaderList : this->HeaderLists)
+    {
+    curl_slist_free_all(handleHeaderList.second);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkHTTPHandler::vtkInternal::ConfigureHandle(CURL* handle, const char* url, const char* method,
+                                                  const std::vector<std::string>& headers)
+{
+  curl_easy_setopt(handle, CURLOPT_URL, url);
+  if (this->ForbidReuse)
+    {
+    curl_easy_setopt(handle, CURLOPT_FORBID_REUSE, 1L);
+    }
+  else if (CURLSH* shareHandle = SharedHandlePool::GetShareHandle())
+    {
+    curl_easy_setopt(handle, CURLOPT_SHARE, shareHandle);
+    }
+#if LIBCURL_VERSION_NUM >= 0x072f00
+  // use HTTP/2 if both curl and the server support it, so that the segments
+  // of a file are multiplexed on the same connection
+  curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+#endif
+  curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+
+  if (this->External->CaCertificatesPath)
+    {
+    curl_easy_setopt(handle, CURLOPT_CAINFO, this->External->CaCertificatesPath);
+    }
+  else
+    {
+    curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, 0L);
+    curl_easy_setopt(handle, CURLOPT_SSL_VERIFYHOST, 0L);
+    }
+
+  // quick timeout during connection phase if URL is not accessible (e.g. blocked by a firewall)
+  curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT, 3L); // in seconds (type long)
+  // transfers run in several networking threads: timeouts must not be implemented
+  // with signals (SIGALRM during name resolution), which are not thread-safe
+  curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+
+  std::vector<std::string> requestHeaders(headers);
+  this->External->ConfigureRequest(handle, method, url, requestHeaders);
+
+  // curl keeps a pointer to the list, it is freed once it is no longer used by the handle
+  curl_slist* headerList = nullptr;
+  for (const std::string& header : requestHeaders)
+    {
+    headerList = curl_slist_append(headerList, header.c_str());
+    }
+  curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headerList);
+  auto headerListIt = this->HeaderLists.find(handle);
+  if (headerListIt != this->HeaderLists.end())
+    {
+    curl_slist_free_all(headerListIt->second);
+    this->HeaderLists.erase(headerListIt);
+    }
+  if (headerList)
+    {
+    this->HeaderLists[handle] = headerList;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkHTTPHandler::vtkInternal::CleanupHandle(CURL* handle)
+{
+  curl_easy_cleanup(handle);
+  auto headerListIt = this->HeaderLists.find(handle);
+  if (headerListIt != this->HeaderLists.end())
+    {
+    curl_slist_free_all(headerListIt->second);
+    this->HeaderLists.erase(headerListIt);
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool vtkHTTPHandler::vtkInternal::ProbeRangeSupport(const char* url, curl_off_t& contentLength,
+                                                    std::string& validator)
+{
+  // Request the first byte: a HEAD request is not used as some servers only
+  // accept GET requests (e.g. pre-signed URLs).
+  RangeProbe probe;
+  curl_easy_reset(this->CurlHandle);
+  this->ConfigureHandle(this->CurlHandle, url, "GET");
+  curl_easy_setopt(this->CurlHandle, CURLOPT_HTTPGET, 1L);
+  curl_easy_setopt(this->CurlHandle, CURLOPT_RANGE, "0-0");
+  curl_easy_setopt(this->CurlHandle, CURLOPT_WRITEFUNCTION, ProbeWriteCallback);
+  curl_easy_setopt(this->CurlHandle, CURLOPT_WRITEDATA, &probe);
+  curl_easy_setopt(this->CurlHandle, CURLOPT_HEADERFUNCTION, ProbeHeaderCallback);
+  curl_easy_setopt(this->CurlHandle, CURLOPT_HEADERDATA, &probe);
+  CURLcode retval = curl_easy_perform(this->CurlHandle);
+
+  long responseCode = 0;
+  curl_easy_getinfo(this->CurlHandle, CURLINFO_RESPONSE_CODE, &responseCode);
+  if (retval != CURLE_OK || responseCode != 206 || probe.ContentLength <= 0)
+    {
+    vtkDebugWithObjectMacro(this->External, "ProbeRangeSupport: range requests are not supported for " << url);
+    return false;
+    }
+  contentLength = probe.ContentLength;
+  validator = probe.Validator.Get();
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkHTTPHandler::vtkInternal::DownloadStream(const char* url, const std::string& fileName,
+                                                curl_off_t resumeFrom, curl_off_t contentLength,
+                                                const std::string& ifRange)
+{
+  this->StreamValidator.clear();
+  this->External->LocalFile = fopen(fileName.c_str(), resumeFrom > 0 ? "ab" : "wb");
+  if (!this->External->LocalFile)
+    {
+    vtkErrorWithObjectMacro(this->External, "StageFileRead: failed to open " << fileName << " for writing");
+    return false;
+    }
+  this->ResumeFrom = resumeFrom;
+  this->ContentLength = contentLength;
+
+  std::vector<std::string> headers;
+  if (resumeFrom > 0)
+    {
+    // the server sends the whole file instead of the range if it has changed,
+    // which curl reports as a range error
+    headers.push_back("If-Range: " + ifRange);
+    }
+  ResponseValidator validator;
+  curl_easy_reset(this->CurlHandle);
+  this->ConfigureHandle(this->CurlHandle, url, "GET", headers);
+  curl_easy_setopt(this->CurlHandle, CURLOPT_HTTPGET, 1L);
+  if (resumeFrom > 0)
+    {
+    curl_easy_setopt(this->CurlHandle, CURLOPT_RESUME_FROM_LARGE, resumeFrom);
+    }
+  curl_easy_setopt(this->CurlHandle, CURLOPT_HEADERFUNCTION, ValidatorHeaderCallback);
+  curl_easy_setopt(this->CurlHandle, CURLOPT_HEADERDATA, &validator);
+  // use the default curl write call back
+  curl_easy_setopt(this->CurlHandle, CURLOPT_WRITEFUNCTION, nullptr);
+  // output goes into LocalFile, must be  FILE*
+  curl_easy_setopt(this->CurlHandle, CURLOPT_WRITEDATA, this->External->LocalFile);
+  curl_easy_setopt(this->CurlHandle, CURLOPT_NOPROGRESS, 0L);
+  curl_easy_setopt(this->CurlHandle, CURLOPT_XFERINFOFUNCTION, vtkInternal::ProgressCallback);
+  curl_easy_setopt(this->CurlHandle, CURLOPT_XFERINFODATA, this);
+
+  vtkDebugWithObjectMacro(this->External, "StageFileRead: about to do the curl download... source = " << url
+    << ", dest = " << fileName << ", resume from = " << resumeFrom);
+  CURLcode retval = curl_easy_perform(this->CurlHandle);
+
+  fclose(this->External->LocalFile);
+  this->External->LocalFile = nullptr;
+  this->StreamValidator = validator.Get();
+
+  if (retval == CURLE_RANGE_ERROR && resumeFrom > 0)
+    {
+    // the file has changed or the server does not support resuming this download after all
+    vtkDebugWithObjectMacro(this->External, "StageFileRead: failed to resume download, restarting it");
+    return this->DownloadStream(url, fileName, 0, contentLength, std::string());
+    }
+  if (retval != CURLE_OK)
+    {
+    this->ReportError("StageFileRead", retval);
+    return false;
+    }
+  vtkDebugWithObjectMacro(this->External, "StageFileRead: successful return from curl");
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkHTTPHandler::vtkInternal::DownloadSegments(const char* url, const std::string& fileName,
+                                                  curl_off_t contentLength)
+{
+  // a partial segmented download has holes, it cannot be resumed
+  this->StreamValidator.clear();
+  FILE* file = fopen(fileName.c_str(), "wb");
+  if (!file)
+    {
+    vtkErrorWithObjectMacro(this->External, "StageFileRead: failed to open " << fileName << " for writing");
+    return false;
+    }
+
+  CURLM* multiHandle = curl_multi_init();
+  if (!multiHandle)
+    {
+    fclose(file);
+    return false;
+    }
+#ifdef CURLPIPE_MULTIPLEX
+  curl_multi_setopt(multiHandle, CURLMOPT_PIPELINING, static_cast<long>(CURLPIPE_MULTIPLEX));
+#endif
+
+  // split the file in segments of equal size
+  curl_off_t minimumSegmentSize = std::max<curl_off_t>(1, this->External->MinimumSegmentSize);
+  curl_off_t numberOfSegments = std::min<curl_off_t>(
+    this->External->NumberOfParallelSegments, std::max<curl_off_t>(1, contentLength / minimumSegmentSize));
+  curl_off_t segmentSize = (contentLength + numberOfSegments - 1) / numberOfSegments;
+  std::vector<DownloadSegment> segments(static_cast<size_t>(numberOfSegments));
+  bool success = true;
+  curl_off_t start = 0;
+  for (DownloadSegment& segment : segments)
+    {
+    segment.File = file;
+    segment.Start = start;
+    segment.End = std::min(start + segmentSize, contentLength) - 1;
+    segment.Offset = start;
+    segment.Range = std::to_string(segment.Start) + "-" + std::to_string(segment.End);
+    start = segment.End + 1;
+
+    segment.Handle = curl_easy_init();
+    if (!segment.Handle)
+      {
+      success = false;
+      break;
+      }
+    this->ConfigureHandle(segment.Handle, url, "GET");
+    curl_easy_setopt(segment.Handle, CURLOPT_HTTPGET, 1L);
+    curl_easy_setopt(segment.Handle, CURLOPT_RANGE, segment.Range.c_str());
+    curl_easy_setopt(segment.Handle, CURLOPT_WRITEFUNCTION, SegmentWriteCallback);
+    curl_easy_setopt(segment.Handle, CURLOPT_WRITEDATA, &segment);
+    curl_multi_add_handle(multiHandle, segment.Handle);
+    }
+
+  vtkDebugWithObjectMacro(this->External, "StageFileRead: downloading " << url << " in "
+    << numberOfSegments << " segments, dest = " << fileName);
+  int numberOfRunningTransfers = success ? 1 : 0;
+  while (numberOfRunningTransfers > 0)
+    {
+    if (this->External->GetTransferCancelRequested()
+        || curl_multi_perform(multiHandle, &numberOfRunningTransfers) != CURLM_OK)
+      {
+      success = false;
+      break;
+      }
+    curl_off_t numberOfDownloadedBytes = 0;
+    for (const DownloadSegment& segment : segments)
+      {
+      numberOfDownloadedBytes += segment.Offset - segment.Start;
+      }
+    this->ReportProgress(numberOfDownloadedBytes, contentLength);
+    if (numberOfRunningTransfers > 0)
+      {
+      curl_multi_wait(multiHandle, nullptr, 0, 1000, nullptr);
+      }
+    }
+
+  CURLMsg* message = nullptr;
+  int numberOfMessages = 0;
+  while ((message = curl_multi_info_read(multiHandle, &numberOfMessages)))
+    {
+    if (message->msg == CURLMSG_DONE && message->data.result != CURLE_OK)
+      {
+      this->ReportError("StageFileRead", message->data.result);
+      success = false;
+      }
+    }
+
+  for (DownloadSegment& segment : segments)
+    {
+    if (!segment.Handle)
+      {
+      continue;
+      }
+    long responseCode = 0;
+    curl_easy_getinfo(segment.Handle, CURLINFO_RESPONSE_CODE, &responseCode);
+    if (responseCode != 206 || segment.Offset != segment.End + 1)
+      {
+      success = false;
+      }
+    curl_multi_remove_handle(multiHandle, segment.Handle);
+    this->CleanupHandle(segment.Handle);
+    }
+  curl_multi_cleanup(multiHandle);
+  fclose(file);
+
+  if (!success)
+    {
+    // the file has holes, it cannot be resumed
+    vtksys::SystemTools::RemoveFile(fileName);
+    }
+  return success;
+}
+
+//-----------------------------------------------------------------------------
+void vtkHTTPHandler::vtkInternal::ReportProgress(curl_off_t numberOfBytes, curl_off_t totalNumberOfBytes)
+{
+  if (totalNumberOfBytes <= 0)
+    {
+    return;
+    }
+  double progress = std::min(1.0, static_cast<double>(numberOfBytes) / static_cast<double>(totalNumberOfBytes));
+  int progressPercent = static_cast<int>(progress * 100.0);
+  if (progressPercent == this->LastProgressPercent)
+    {
+    return;
+    }
+  this->LastProgressPercent = progressPercent;
+  this->External->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+}
+
+//-----------------------------------------------------------------------------
+void vtkHTTPHandler::vtkInternal::ReportError(const char* method, CURLcode error)
+{
+  if (error == CURLE_ABORTED_BY_CALLBACK && this->External->GetTransferCancelRequested())
+    {
+    vtkDebugWithObjectMacro(this->External, << method << ": transfer cancelled");
+    }
+  else if (error == CURLE_BAD_FUNCTION_ARGUMENT)
+    {
+    vtkErrorWithObjectMacro(this->External, << method << ": bad function argument to curl, did you init CurlHandle?");
+    }
+  else if (error == CURLE_OUT_OF_MEMORY)
+    {
+    vtkErrorWithObjectMacro(this->External, << method << ": curl ran out of memory!");
+    }
+  else
+    {
+    vtkErrorWithObjectMacro(this->External, << method << ": error running curl: " << curl_easy_strerror(error));
+    //--- in case the permissions were not correct and that's
+    //--- the reason the read command failed,
+    //--- reset the 'remember check' in the permissions
+    //--- prompter so that new login info  will be prompted.
+    if ( this->External->GetPermissionPrompter() != nullptr )
+      {
+      this->External->GetPermissionPrompter()->SetRemember ( 0 );
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+int vtkHTTPHandler::vtkInternal::ProgressCallback(void* clientData, curl_off_t dltotal, curl_off_t dlnow,
+                                                 curl_off_t vtkNotUsed(ultotal), curl_off_t vtkNotUsed(ulnow))
+{
+  vtkInternal* self = static_cast<vtkInternal*>(clientData);
+  curl_off_t totalNumberOfBytes = dltotal > 0 ? self->ResumeFrom + dltotal : self->ContentLength;
+  self->ReportProgress(self->ResumeFrom + dlnow, totalNumberOfBytes);
+  // a non-zero value aborts the transfer
+  return self->External->GetTransferCancelRequested() ? 1 : 0;
 }
 
 //----------------------------------------------------------------------------
@@ -107,6 +723,50 @@ vtkHTTPHandler::~vtkHTTPHandler()
 void vtkHTTPHandler::PrintSelf(ostream& os, vtkIndent indent)
 {
   Superclass::PrintSelf ( os, indent );
+  os << indent << "NumberOfParallelSegments: " << this->NumberOfParallelSegments << "\n";
+  os << indent << "MinimumSegmentSize: " << this->MinimumSegmentSize << "\n";
+  os << indent << "ResumeDownload: " << this->ResumeDownload << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkHTTPHandler::CopySettings(vtkURIHandler* handler)
+{
+  this->Superclass::CopySettings(handler);
+  vtkHTTPHandler* httpHandler = vtkHTTPHandler::SafeDownCast(handler);
+  if (!httpHandler)
+    {
+    return;
+    }
+  this->SetForbidReuse(httpHandler->GetForbidReuse());
+  this->SetCaCertificatesPath(httpHandler->GetCaCertificatesPath());
+  this->SetNumberOfParallelSegments(httpHandler->GetNumberOfParallelSegments());
+  this->SetMinimumSegmentSize(httpHandler->GetMinimumSegmentSize());
+  this->SetResumeDownload(httpHandler->GetResumeDownload());
+}
+
+//----------------------------------------------------------------------------
+std::string vtkHTTPHandler::GetRequestURL(const char* uri)
+{
+  return uri ? std::string(uri) : std::string();
+}
+
+//----------------------------------------------------------------------------
+void vtkHTTPHandler::ConfigureCurlHandle(void* curlHandle, const char* url, const char* method)
+{
+  this->Internal->ConfigureHandle(static_cast<CURL*>(curlHandle), url, method);
+}
+
+//----------------------------------------------------------------------------
+void vtkHTTPHandler::CleanupCurlHandle(void* curlHandle)
+{
+  this->Internal->CleanupHandle(static_cast<CURL*>(curlHandle));
+}
+
+//----------------------------------------------------------------------------
+void vtkHTTPHandler::ReportTransferProgress(vtkTypeInt64 numberOfBytes, vtkTypeInt64 totalNumberOfBytes)
+{
+  this->Internal->ReportProgress(static_cast<curl_off_t>(numberOfBytes),
+                                 static_cast<curl_off_t>(totalNumberOfBytes));
 }
 
 //----------------------------------------------------------------------------
@@ -165,8 +825,12 @@ int vtkHTTPHandler::GetForbidReuse()
 //----------------------------------------------------------------------------
 void vtkHTTPHandler::InitTransfer( )
 {
-  curl_global_init(CURL_GLOBAL_ALL);
+  // curl_global_init() is not thread-safe, while transfers may be initialized
+  // concurrently by several handlers
+  static std::once_flag globalInitFlag;
+  std::call_once(globalInitFlag, []() { curl_global_init(CURL_GLOBAL_ALL); });
   vtkDebugMacro("vtkHTTPHandler: InitTransfer: initialising CurlHandle");
+  this->Internal->LastProgressPercent = -1;
   this->Internal->CurlHandle = curl_easy_init();
   if (this->Internal->CurlHandle == nullptr)
     {
@@ -177,7 +841,7 @@ void vtkHTTPHandler::InitTransfer( )
 //----------------------------------------------------------------------------
 int vtkHTTPHandler::CloseTransfer( )
 {
-  curl_easy_cleanup(this->Internal->CurlHandle);
+  this->Internal->CleanupHandle(this->Internal->CurlHandle);
   return EXIT_SUCCESS;
 }
 
@@ -190,85 +854,97 @@ void vtkHTTPHandler::StageFileRead(const char * source, const char * destination
     vtkErrorMacro("StageFileRead: source or dest is null!");
     return;
     }
-  /*
-  if (this->LocalFile)
+  this->InitTransfer( );
+  if (this->Internal->CurlHandle == nullptr)
     {
-    this->LocalFile->close();
-    delete this->LocalFile;
-    this->LocalFile = nullptr;
+    return;
     }
-  this->LocalFile = new std::ofstream(destination, std::ios::binary);
-  */
-  this->InitTransfer( );
-
-
-  if ( this->Internal->ForbidReuse )
+  std::string url = this->GetRequestURL(source);
+  if (url.empty())
     {
-    curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_FORBID_REUSE, 1);
+    vtkErrorMacro("StageFileRead: cannot download " << source);
+    this->CloseTransfer();
+    return;
     }
-  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_HTTPGET, 1);
-  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_URL, source);
-//  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_NOPROGRESS, false);
-  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_FOLLOWLOCATION, true);
-  // use the default curl write call back
-  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_WRITEFUNCTION, nullptr); // write_callback);
-  this->LocalFile = fopen(destination, "wb");
-  // output goes into LocalFile, must be  FILE*
-  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_WRITEDATA, this->LocalFile);
-//  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_PROGRESSDATA, nullptr);
-//  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_PROGRESSFUNCTION, ProgressCallback);
 
-  if (this->CaCertificatesPath)
+  // The file is downloaded next to its destination, so that the destination
+  // never contains partial data and failed downloads can be resumed.
+  // The validator of a partial download is stored next to it: the download is
+  // only resumed if the file has not changed on the server since.
+  std::string partFileName = std::string(destination) + ".part";
+  std::string validatorFileName = partFileName + ".validator";
+  curl_off_t partFileSize = -1;
+  std::string partValidator;
+  if (this->ResumeDownload)
     {
-    curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_CAINFO, this->CaCertificatesPath);
+    partFileSize = GetFileSize(partFileName);
+    partValidator = ReadValidatorFile(validatorFileName);
     }
-  else
+  vtksys::SystemTools::RemoveFile(validatorFileName);
+  if (partFileSize > 0 && partValidator.empty())
     {
-    curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_SSL_VERIFYPEER, 0);
-    curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_SSL_VERIFYHOST, 0);
+    vtkDebugMacro("StageFileRead: " << partFileName << " has no validator, downloading the file again");
+    partFileSize = -1;
     }
 
-  // quick timeout during connection phase if URL is not accessible (e.g. blocked by a firewall)
-  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_CONNECTTIMEOUT, 3); // in seconds (type long)
-
-  vtkDebugMacro("StageFileRead: about to do the curl download... source = " << source << ", dest = " << destination);
-  CURLcode retval = curl_easy_perform(this->Internal->CurlHandle);
-
-  if (retval == CURLE_OK)
+  curl_off_t contentLength = -1;
+  std::string validator;
+  bool rangeSupported = false;
+  if (this->NumberOfParallelSegments > 1 || partFileSize > 0)
     {
-    vtkDebugMacro("StageFileRead: successful return from curl");
+    rangeSupported = this->Internal->ProbeRangeSupport(url.c_str(), contentLength, validator);
     }
-  else if (retval == CURLE_BAD_FUNCTION_ARGUMENT)
+  if (partFileSize > 0 && (!rangeSupported || validator != partValidator))
     {
-    vtkErrorMacro("StageFileRead: bad function argument to curl, did you init CurlHandle?");
+    vtkDebugMacro("StageFileRead: " << url << " has changed since " << partFileName
+      << " was downloaded, downloading the file again");
+    partFileSize = -1;
     }
-  else if (retval == CURLE_OUT_OF_MEMORY)
+
+  bool success = false;
+  if (rangeSupported && partFileSize == contentLength)
     {
-    vtkErrorMacro("StageFileRead: curl ran out of memory!");
+    vtkDebugMacro("StageFileRead: " << partFileName << " is already downloaded");
+    success = true;
     }
-  else
+  else if (rangeSupported && partFileSize > 0 && partFileSize < contentLength)
     {
-    const char *stringError = curl_easy_strerror(retval);
-    vtkErrorMacro("StageFileRead: error running curl: " << stringError);
-    //--- in case the permissions were not correct and that's
-    //--- the reason the read command failed,
-    //--- reset the 'remember check' in the permissions
-    //--- prompter so that new login info  will be prompted.
-    if ( this->GetPermissionPrompter() != nullptr )
+    success = this->Internal->DownloadStream(url.c_str(), partFileName, partFileSize, contentLength, partValidator);
+    }
+  else if (rangeSupported && this->NumberOfParallelSegments > 1
+           && contentLength >= 2 * this->MinimumSegmentSize)
+    {
+    success = this->Internal->DownloadSegments(url.c_str(), partFileName, contentLength);
+    if (!success && !this->GetTransferCancelRequested())
       {
-      this->GetPermissionPrompter()->SetRemember ( 0 );
+      // some servers limit the number of parallel requests
+      vtkDebugMacro("StageFileRead: segmented download failed, downloading in a single request");
+      success = this->Internal->DownloadStream(url.c_str(), partFileName, 0, contentLength, std::string());
       }
     }
+  else
+    {
+    success = this->Internal->DownloadStream(url.c_str(), partFileName, 0, contentLength, std::string());
+    }
   this->CloseTransfer();
 
-  /*
-  this->LocalFile->close();
-  delete this->LocalFile;
-  this->LocalFile = nullptr;
-  */
-  if (this->LocalFile)
+  if (success)
+    {
+    if (!vtksys::SystemTools::RenameFile(partFileName, destination))
+      {
+      vtkErrorMacro("StageFileRead: failed to rename " << partFileName << " to " << destination);
+      }
+    }
+  else if (this->ResumeDownload && !this->Internal->StreamValidator.empty()
+           && WriteValidatorFile(validatorFileName, this->Internal->StreamValidator))
+    {
+    vtkDebugMacro("StageFileRead: keeping " << partFileName << " to resume the download later");
+    }
+  else
     {
-    fclose(this->LocalFile);
+    // without a validator, there is no way to know if the partial file can be resumed
+    vtksys::SystemTools::RemoveFile(partFileName);
+    vtksys::SystemTools::RemoveFile(validatorFileName);
     }
 }
 
@@ -291,6 +967,7 @@ void vtkHTTPHandler::StageFileWrite(const char * source, const char * destinatio
   this->InitTransfer( );
 
   curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_PUT, 1);
+  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_NOSIGNAL, 1L);
   curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_URL, destination);
 //  curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_NOPROGRESS, false);
   curl_easy_setopt(this->Internal->CurlHandle, CURLOPT_FOLLOWLOCATION, true);
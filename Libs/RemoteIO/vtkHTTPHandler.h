@@ -12,6 +12,10 @@
 // MRML includes
 #include "vtkURIHandler.h"
 
+// STD includes
+#include <string>
+#include <vector>
+
 class VTK_RemoteIO_EXPORT vtkHTTPHandler : public vtkURIHandler
 {
 public:
@@ -32,7 +36,19 @@ public:
   void SetForbidReuse(int value);
   int GetForbidReuse();
 
-  /// This function wraps curl functionality to download a specified URL to a specified dir
+  /// This function wraps curl functionality to download a specified URL to a specified dir.
+  ///
+  /// The data is first written to "<destination>.part", which is renamed to
+  /// \a destination when the download succeeds. If the server supports range
+  /// requests, large files are downloaded in NumberOfParallelSegments byte ranges
+  /// at once and partial downloads are resumed (see ResumeDownload).
+  /// Connections (HTTP/2 if available), DNS and SSL sessions are shared by all
+  /// the handlers so that consecutive downloads from the same server reuse them.
+  ///
+  /// vtkCommand::ProgressEvent is invoked (in the thread running the transfer)
+  /// each time the progress changes by at least 1%, with a pointer to a double
+  /// between 0 and 1 as call data.
+  /// The download stops if SetTransferCancelRequested(true) is called meanwhile.
   void StageFileRead(const char * source, const char * destination) override;
   using vtkURIHandler::StageFileRead;
   void StageFileWrite(const char * source, const char * destination) override;
@@ -40,20 +56,76 @@ public:
   void InitTransfer () override;
   int CloseTransfer () override;
 
+  /// Copy the settings of \a handler, including the vtkHTTPHandler
+  /// specific ones if \a handler is a vtkHTTPHandler.
+  void CopySettings(vtkURIHandler* handler) override;
+
   /// CA Certificates path for https protocol.
   vtkSetStringMacro(CaCertificatesPath);
   vtkGetStringMacro(CaCertificatesPath);
 
+  /// Maximum number of byte ranges of a file that StageFileRead() downloads at
+  /// the same time. Set to 1 to download files in a single request.
+  /// Default is 4.
+  vtkSetClampMacro(NumberOfParallelSegments, int, 1, 16);
+  vtkGetMacro(NumberOfParallelSegments, int);
+
+  /// Minimum size in bytes of a byte range downloaded by StageFileRead():
+  /// smaller files are downloaded in a single request.
+  /// Default is 8MB.
+  vtkSetMacro(MinimumSegmentSize, vtkTypeInt64);
+  vtkGetMacro(MinimumSegmentSize, vtkTypeInt64);
+
+  /// If enabled, the "<destination>.part" file of a failed download is kept and
+  /// the next download to the same destination resumes from where it stopped.
+  /// The entity tag (or last modification date) of the file is stored in
+  /// "<destination>.part.validator" and sent in an If-Range request, so that
+  /// the download is only resumed if the file has not changed on the server.
+  /// Partial files are discarded if the server did not send any validator.
+  /// Enabled by default.
+  vtkSetMacro(ResumeDownload, bool);
+  vtkGetMacro(ResumeDownload, bool);
+  vtkBooleanMacro(ResumeDownload, bool);
+
 protected:
   vtkHTTPHandler();
   ~vtkHTTPHandler() override;
   vtkHTTPHandler(const vtkHTTPHandler&);
   void operator=(const vtkHTTPHandler&);
 
+  /// Return the URL that StageFileRead() requests to download \a uri.
+  /// Default implementation returns \a uri unchanged.
+  virtual std::string GetRequestURL(const char* uri);
+
+  /// Set on \a curlHandle (a CURL*) the options shared by all the requests
+  /// (URL, connection sharing, redirections, SSL and timeouts), then call
+  /// ConfigureRequest() and set the request headers.
+  /// \a method is the HTTP method of the request (e.g. "GET" or "PUT").
+  /// The handle must be cleaned up with CleanupCurlHandle().
+  void ConfigureCurlHandle(void* curlHandle, const char* url, const char* method);
+
+  /// Clean up a handle configured by ConfigureCurlHandle() and free its headers.
+  void CleanupCurlHandle(void* curlHandle);
+
+  /// Called for each request once the shared options are set, so that
+  /// subclasses can add their own options and \a headers (e.g. authentication).
+  /// \a headers contains the headers that are already set (e.g. If-Range),
+  /// as "Name: value" strings.
+  /// \a curlHandle is a CURL*. Called from the thread running the transfer.
+  virtual void ConfigureRequest(void* vtkNotUsed(curlHandle), const char* vtkNotUsed(method),
+                                const char* vtkNotUsed(url), std::vector<std::string>& vtkNotUsed(headers)) {}
+
+  /// Invoke vtkCommand::ProgressEvent if the progress has changed by at least
+  /// 1% since the last event of the current transfer.
+  void ReportTransferProgress(vtkTypeInt64 numberOfBytes, vtkTypeInt64 totalNumberOfBytes);
+
 private:
   class vtkInternal;
   vtkInternal* Internal;
   char* CaCertificatesPath{nullptr};
+  int NumberOfParallelSegments{4};
+  vtkTypeInt64 MinimumSegmentSize{8 * 1024 * 1024};
+  bool ResumeDownload{true};
 };
 
 #endif
@@ -0,0 +1,987 @@
+// RemoteIO includes
+#include "vtkObjectStoreHandler.h"
+
+// VTK includes
+#include <vtkCommand.h>
+
+// VTKsys includes
+#include <vtksys/SystemTools.hxx>
+
+// CURL includes
+#include <curl/curl.h>
+
+// STD includes
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+/// Maximum number of parts of a multipart upload (limit of the S3 API)
+const curl_off_t MaximumNumberOfUploadParts = 10000;
+
+/// Number of times a part is sent before the upload is considered failed
+const int MaximumNumberOfPartAttempts = 3;
+
+//----------------------------------------------------------------------------
+/// Part of a file uploaded in parallel with the other parts.
+/// A file uploaded in a single request is a multipart upload of one part.
+struct UploadPart
+{
+  CURL* Handle{nullptr};
+  FILE* File{nullptr};
+  /// Part number, starting at 1
+  int Number{0};
+  /// First byte of the part
+  curl_off_t Start{0};
+  curl_off_t Size{0};
+  /// Position of the next byte to read
+  curl_off_t Offset{0};
+  int NumberOfAttempts{0};
+  bool Done{false};
+  std::string URL;
+  std::string ETag;
+};
+
+//----------------------------------------------------------------------------
+/// Split "s3://bucket/key" into its components
+bool ParseObjectURI(const char* uri, std::string& scheme, std::string& bucket, std::string& key)
+{
+  if (!uri)
+    {
+    return false;
+    }
+  std::string uriString(uri);
+  std::string::size_type schemeEnd = uriString.find("://");
+  if (schemeEnd == std::string::npos)
+    {
+    return false;
+    }
+  scheme = uriString.substr(0, schemeEnd);
+  std::transform(scheme.begin(), scheme.end(), scheme.begin(),
+    [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  if (scheme != "s3" && scheme != "gs")
+    {
+    return false;
+    }
+  std::string::size_type bucketEnd = uriString.find('/', schemeEnd + 3);
+  if (bucketEnd == std::string::npos)
+    {
+    return false;
+    }
+  bucket = uriString.substr(schemeEnd + 3, bucketEnd - schemeEnd - 3);
+  key = uriString.substr(bucketEnd + 1);
+  return !bucket.empty() && !key.empty();
+}
+
+//----------------------------------------------------------------------------
+/// Percent-encode the characters that are not allowed in a path or query
+/// component. Already encoded characters are kept as is.
+std::string EncodeURIComponent(const std::string& component, bool keepSlashes)
+{
+  std::ostringstream encoded;
+  const char hexDigits[] = "0123456789ABCDEF";
+  for (unsigned char c : component)
+    {
+    if (std::isalnum(c) || c == '-' || c == '.' || c == '_' || c == '~' || c == '%'
+        || (keepSlashes && c == '/'))
+      {
+      encoded << c;
+      }
+    else
+      {
+      encoded << '%' << hexDigits[c >> 4] << hexDigits[c & 0xF];
+      }
+    }
+  return encoded.str();
+}
+
+//----------------------------------------------------------------------------
+/// Split \a url into its authority ("host:port"), path and query
+void SplitURL(const std::string& url, std::string& authority, std::string& path, std::string& query)
+{
+  std::string::size_type authorityStart = url.find("://");
+  authorityStart = (authorityStart == std::string::npos) ? 0 : authorityStart + 3;
+  std::string::size_type authorityEnd = url.find_first_of("/?", authorityStart);
+  authority = url.substr(authorityStart, authorityEnd - authorityStart);
+  path.clear();
+  query.clear();
+  if (authorityEnd == std::string::npos)
+    {
+    return;
+    }
+  std::string::size_type queryStart = url.find('?', authorityEnd);
+  path = url.substr(authorityEnd, queryStart - authorityEnd);
+  if (queryStart != std::string::npos)
+    {
+    query = url.substr(queryStart + 1);
+    }
+  // default ports are not sent in the host header
+  std::string scheme = vtksys::SystemTools::LowerCase(url.substr(0, authorityStart));
+  if ((scheme == "http://" && vtksys::SystemTools::StringEndsWith(authority, ":80"))
+      || (scheme == "https://" && vtksys::SystemTools::StringEndsWith(authority, ":443")))
+    {
+    authority = authority.substr(0, authority.rfind(':'));
+    }
+}
+
+//----------------------------------------------------------------------------
+/// Return the query parameters sorted and encoded as required by the
+/// canonical request of AWS signature version 4
+std::string GetCanonicalQuery(const std::string& query)
+{
+  std::vector<std::pair<std::string, std::string> > parameters;
+  std::string::size_type parameterStart = 0;
+  while (parameterStart < query.size())
+    {
+    std::string::size_type parameterEnd = query.find('&', parameterStart);
+    if (parameterEnd == std::string::npos)
+      {
+      parameterEnd = query.size();
+      }
+    std::string parameter = query.substr(parameterStart, parameterEnd - parameterStart);
+    parameterStart = parameterEnd + 1;
+    if (parameter.empty())
+      {
+      continue;
+      }
+    std::string::size_type separator = parameter.find('=');
+    std::string name = parameter.substr(0, separator);
+    std::string value = (separator == std::string::npos) ? std::string() : parameter.substr(separator + 1);
+    parameters.emplace_back(EncodeURIComponent(name, false), EncodeURIComponent(value, false));
+    }
+  std::sort(parameters.begin(), parameters.end());
+  std::string canonicalQuery;
+  for (const std::pair<std::string, std::string>& parameter : parameters)
+    {
+    if (!canonicalQuery.empty())
+      {
+      canonicalQuery += "&";
+      }
+    canonicalQuery += parameter.first + "=" + parameter.second;
+    }
+  return canonicalQuery;
+}
+
+//----------------------------------------------------------------------------
+/// SHA-256 message digest (FIPS 180-4), used to sign requests
+class SHA256
+{
+public:
+  SHA256()
+    {
+    const uint32_t initialState[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                       0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    std::copy(initialState, initialState + 8, this->State);
+    }
+
+  void Update(const std::string& data)
+    {
+    for (unsigned char c : data)
+      {
+      this->Block[this->BlockSize++] = c;
+      if (this->BlockSize == 64)
+        {
+        this->ProcessBlock();
+        this->BlockSize = 0;
+        }
+      }
+    this->MessageSize += data.size();
+    }
+
+  /// Return the 32 bytes digest. The object cannot be updated afterward.
+  std::string Finalize()
+    {
+    uint64_t messageSizeInBits = static_cast<uint64_t>(this->MessageSize) * 8;
+    std::string padding(1, static_cast<char>(0x80));
+    padding.append((this->BlockSize < 56 ? 55 - this->BlockSize : 119 - this->BlockSize), '\0');
+    for (int byteIndex = 7; byteIndex >= 0; --byteIndex)
+      {
+      padding.push_back(static_cast<char>((messageSizeInBits >> (byteIndex * 8)) & 0xff));
+      }
+    this->Update(padding);
+    std::string digest;
+    for (uint32_t word : this->State)
+      {
+      for (int byteIndex = 3; byteIndex >= 0; --byteIndex)
+        {
+        digest.push_back(static_cast<char>((word >> (byteIndex * 8)) & 0xff));
+        }
+      }
+    return digest;
+    }
+
+  static std::string Hash(const std::string& data)
+    {
+    SHA256 sha256;
+    sha256.Update(data);
+    return sha256.Finalize();
+    }
+
+private:
+  static uint32_t RotateRight(uint32_t value, int count)
+    {
+    return (value >> count) | (value << (32 - count));
+    }
+
+  void ProcessBlock()
+    {
+    static const uint32_t roundConstants[64] = {
+      0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+      0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+      0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+      0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+      0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+      0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+      0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+      0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
+    uint32_t schedule[64];
+    for (int wordIndex = 0; wordIndex < 16; ++wordIndex)
+      {
+      schedule[wordIndex] = (static_cast<uint32_t>(this->Block[wordIndex * 4]) << 24)
+        | (static_cast<uint32_t>(this->Block[wordIndex * 4 + 1]) << 16)
+        | (static_cast<uint32_t>(this->Block[wordIndex * 4 + 2]) << 8)
+        | static_cast<uint32_t>(this->Block[wordIndex * 4 + 3]);
+      }
+    for (int wordIndex = 16; wordIndex < 64; ++wordIndex)
+      {
+      uint32_t s0 = RotateRight(schedule[wordIndex - 15], 7) ^ RotateRight(schedule[wordIndex - 15], 18)
+        ^ (schedule[wordIndex - 15] >> 3);
+      uint32_t s1 = RotateRight(schedule[wordIndex - 2], 17) ^ RotateRight(schedule[wordIndex - 2], 19)
+        ^ (schedule[wordIndex - 2] >> 10);
+      schedule[wordIndex] = schedule[wordIndex - 16] + s0 + schedule[wordIndex - 7] + s1;
+      }
+    uint32_t a = this->State[0], b = this->State[1], c = this->State[2], d = this->State[3];
+    uint32_t e = this->State[4], f = this->State[5], g = this->State[6], h = this->State[7];
+    for (int round = 0; round < 64; ++round)
+      {
+      uint32_t s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+      uint32_t choice = (e & f) ^ (~e & g);
+      uint32_t temp1 = h + s1 + choice + roundConstants[round] + schedule[round];
+      uint32_t s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+      uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+      uint32_t temp2 = s0 + majority;
+      h = g;
+      g = f;
+      f = e;
+      e = d + temp1;
+      d = c;
+      c = b;
+      b = a;
+      a = temp1 + temp2;
+      }
+    this->State[0] += a;
+    this->State[1] += b;
+    this->State[2] += c;
+    this->State[3] += d;
+    this->State[4] += e;
+    this->State[5] += f;
+    this->State[6] += g;
+    this->State[7] += h;
+    }
+
+  uint32_t State[8];
+  unsigned char Block[64];
+  size_t BlockSize{0};
+  size_t MessageSize{0};
+};
+
+//----------------------------------------------------------------------------
+/// HMAC-SHA256 (RFC 2104) of \a message with \a key
+std::string HMACSHA256(const std::string& key, const std::string& message)
+{
+  std::string blockKey = key.size() > 64 ? SHA256::Hash(key) : key;
+  blockKey.resize(64, '\0');
+  std::string innerPadding(64, '\0');
+  std::string outerPadding(64, '\0');
+  for (size_t index = 0; index < 64; ++index)
+    {
+    innerPadding[index] = static_cast<char>(blockKey[index] ^ 0x36);
+    outerPadding[index] = static_cast<char>(blockKey[index] ^ 0x5c);
+    }
+  return SHA256::Hash(outerPadding + SHA256::Hash(innerPadding + message));
+}
+
+//----------------------------------------------------------------------------
+std::string ToHex(const std::string& data)
+{
+  const char hexDigits[] = "0123456789abcdef";
+  std::string hex;
+  for (unsigned char c : data)
+    {
+    hex.push_back(hexDigits[c >> 4]);
+    hex.push_back(hexDigits[c & 0xF]);
+    }
+  return hex;
+}
+
+//----------------------------------------------------------------------------
+/// Return the current UTC time in the format of the x-amz-date header
+std::string GetAMZDate()
+{
+  std::time_t now = std::time(nullptr);
+  std::tm utcTime;
+#if defined(_WIN32)
+  gmtime_s(&utcTime, &now);
+#else
+  gmtime_r(&now, &utcTime);
+#endif
+  char amzDate[32];
+  std::strftime(amzDate, sizeof(amzDate), "%Y%m%dT%H%M%SZ", &utcTime);
+  return amzDate;
+}
+
+//----------------------------------------------------------------------------
+std::string GetEnvironmentVariable(const char* name)
+{
+  std::string value;
+  vtksys::SystemTools::GetEnv(name, value);
+  return value;
+}
+
+//----------------------------------------------------------------------------
+/// Return the text of the first \a tag element of an XML response
+std::string GetXMLElementText(const std::string& xml, const std::string& tag)
+{
+  std::string startTag = "<" + tag + ">";
+  std::string::size_type start = xml.find(startTag);
+  if (start == std::string::npos)
+    {
+    return std::string();
+    }
+  start += startTag.size();
+  std::string::size_type end = xml.find("</" + tag + ">", start);
+  if (end == std::string::npos)
+    {
+    return std::string();
+    }
+  return xml.substr(start, end - start);
+}
+
+//----------------------------------------------------------------------------
+int SeekFile(FILE* file, curl_off_t offset)
+{
+#if defined(_WIN32)
+  return _fseeki64(file, offset, SEEK_SET);
+#else
+  return fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+//----------------------------------------------------------------------------
+size_t PartReadCallback(char* buffer, size_t size, size_t nitems, void* userData)
+{
+  UploadPart* part = static_cast<UploadPart*>(userData);
+  curl_off_t remaining = part->Start + part->Size - part->Offset;
+  size_t numberOfBytes = static_cast<size_t>(std::min<curl_off_t>(remaining, static_cast<curl_off_t>(size * nitems)));
+  if (numberOfBytes == 0)
+    {
+    return 0;
+    }
+  // parts share the file, the position is set before each read
+  if (SeekFile(part->File, part->Offset) != 0)
+    {
+    return CURL_READFUNC_ABORT;
+    }
+  size_t read = fread(buffer, 1, numberOfBytes, part->File);
+  if (read == 0)
+    {
+    return CURL_READFUNC_ABORT;
+    }
+  part->Offset += static_cast<curl_off_t>(read);
+  return read;
+}
+
+//----------------------------------------------------------------------------
+size_t PartHeaderCallback(char* buffer, size_t size, size_t nitems, void* userData)
+{
+  UploadPart* part = static_cast<UploadPart*>(userData);
+  std::string header(buffer, size * nitems);
+  if (header.size() > 5 && vtksys::SystemTools::LowerCase(header.substr(0, 5)) == "etag:")
+    {
+    part->ETag = vtksys::SystemTools::TrimWhitespace(header.substr(5));
+    }
+  return size * nitems;
+}
+
+//----------------------------------------------------------------------------
+size_t AppendToStringCallback(char* buffer, size_t size, size_t nmemb, void* userData)
+{
+  static_cast<std::string*>(userData)->append(buffer, size * nmemb);
+  return size * nmemb;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+class vtkObjectStoreHandler::vtkInternal
+{
+public:
+  vtkInternal(vtkObjectStoreHandler* external);
+  ~vtkInternal();
+
+  /// Return the region the requests to \a scheme objects are signed for
+  std::string GetSigningRegion(const std::string& scheme);
+
+  /// Get the credentials the requests of a transfer of a \a scheme object
+  /// are signed with.
+  void PrepareRequests(const std::string& scheme);
+
+  /// Send a request without upload data and store the response body in
+  /// \a response. \a method is "POST" or "DELETE".
+  bool PerformRequest(const std::string& url, const std::string& method,
+                      const std::string& body, std::string& response);
+
+  /// Create the handle uploading \a part of the file
+  bool StartPartUpload(CURLM* multiHandle, UploadPart& part);
+
+  /// Upload \a parts of \a file in parallel.
+  bool UploadParts(FILE* file, std::vector<UploadPart>& parts, curl_off_t fileSize);
+
+  /// Upload \a fileName as \a url in a single request
+  bool UploadFile(const std::string& url, FILE* file, curl_off_t fileSize);
+
+  /// Upload \a fileName as \a url using a multipart upload
+  bool UploadMultipart(const std::string& url, FILE* file, curl_off_t fileSize);
+
+  vtkObjectStoreHandler* External;
+  std::string AccessKeyId;
+  std::string SecretAccessKey;
+  std::string SessionToken;
+  std::string SigningRegion;
+};
+
+//----------------------------------------------------------------------------
+// vtkInternal methods
+
+//----------------------------------------------------------------------------
+vtkObjectStoreHandler::vtkInternal::vtkInternal(vtkObjectStoreHandler* external)
+  : External(external)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkObjectStoreHandler::vtkInternal::~vtkInternal() = default;
+
+//----------------------------------------------------------------------------
+std::string vtkObjectStoreHandler::vtkInternal::GetSigningRegion(const std::string& scheme)
+{
+  if (scheme == "gs")
+    {
+    return "auto";
+    }
+  if (this->External->Region && this->External->Region[0] != '\0')
+    {
+    return this->External->Region;
+    }
+  std::string region = GetEnvironmentVariable("AWS_REGION");
+  return region.empty() ? std::string("us-east-1") : region;
+}
+
+//----------------------------------------------------------------------------
+void vtkObjectStoreHandler::vtkInternal::PrepareRequests(const std::string& scheme)
+{
+  // requests are anonymous (public bucket) if there is no access key
+  this->AccessKeyId = this->External->AccessKeyId ? this->External->AccessKeyId : GetEnvironmentVariable("AWS_ACCESS_KEY_ID");
+  this->SecretAccessKey = this->External->SecretAccessKey ? this->External->SecretAccessKey : GetEnvironmentVariable("AWS_SECRET_ACCESS_KEY");
+  this->SessionToken = this->External->SessionToken ? this->External->SessionToken : GetEnvironmentVariable("AWS_SESSION_TOKEN");
+  this->SigningRegion = this->GetSigningRegion(scheme);
+}
+
+//----------------------------------------------------------------------------
+bool vtkObjectStoreHandler::vtkInternal::PerformRequest(const std::string& url, const std::string& method,
+                                                       const std::string& body, std::string& response)
+{
+  CURL* handle = curl_easy_init();
+  if (!handle)
+    {
+    return false;
+    }
+  this->External->ConfigureCurlHandle(handle, url.c_str(), method.c_str());
+  if (method == "POST")
+    {
+    curl_easy_setopt(handle, CURLOPT_POST, 1L);
+    curl_easy_setopt(handle, CURLOPT_POSTFIELDS, body.c_str());
+    curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(body.size()));
+    }
+  else
+    {
+    curl_easy_setopt(handle, CURLOPT_CUSTOMREQUEST, method.c_str());
+    }
+  curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, AppendToStringCallback);
+  curl_easy_setopt(handle, CURLOPT_WRITEDATA, &response);
+  CURLcode retval = curl_easy_perform(handle);
+  this->External->CleanupCurlHandle(handle);
+  if (retval != CURLE_OK)
+    {
+    vtkErrorWithObjectMacro(this->External, "StageFileWrite: " << method << " request to " << url
+      << " failed: " << curl_easy_strerror(retval));
+    return false;
+    }
+  // some errors are reported in the body of a successful response
+  if (response.find("<Error>") != std::string::npos)
+    {
+    vtkErrorWithObjectMacro(this->External, "StageFileWrite: " << method << " request to " << url
+      << " failed: " << GetXMLElementText(response, "Code") << " " << GetXMLElementText(response, "Message"));
+    return false;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkObjectStoreHandler::vtkInternal::StartPartUpload(CURLM* multiHandle, UploadPart& part)
+{
+  if (part.Handle)
+    {
+    curl_multi_remove_handle(multiHandle, part.Handle);
+    this->External->CleanupCurlHandle(part.Handle);
+    }
+  part.Handle = curl_easy_init();
+  if (!part.Handle)
+    {
+    return false;
+    }
+  part.Offset = part.Start;
+  part.ETag.clear();
+  ++part.NumberOfAttempts;
+  this->External->ConfigureCurlHandle(part.Handle, part.URL.c_str(), "PUT");
+  curl_easy_setopt(part.Handle, CURLOPT_UPLOAD, 1L);
+  curl_easy_setopt(part.Handle, CURLOPT_INFILESIZE_LARGE, part.Size);
+  curl_easy_setopt(part.Handle, CURLOPT_READFUNCTION, PartReadCallback);
+  curl_easy_setopt(part.Handle, CURLOPT_READDATA, &part);
+  curl_easy_setopt(part.Handle, CURLOPT_HEADERFUNCTION, PartHeaderCallback);
+  curl_easy_setopt(part.Handle, CURLOPT_HEADERDATA, &part);
+  curl_easy_setopt(part.Handle, CURLOPT_PRIVATE, &part);
+  return curl_multi_add_handle(multiHandle, part.Handle) == CURLM_OK;
+}
+
+//----------------------------------------------------------------------------
+bool vtkObjectStoreHandler::vtkInternal::UploadParts(FILE* file, std::vector<UploadPart>& parts, curl_off_t fileSize)
+{
+  CURLM* multiHandle = curl_multi_init();
+  if (!multiHandle)
+    {
+    return false;
+    }
+#ifdef CURLPIPE_MULTIPLEX
+  curl_multi_setopt(multiHandle, CURLMOPT_PIPELINING, static_cast<long>(CURLPIPE_MULTIPLEX));
+#endif
+
+  bool success = true;
+  size_t numberOfParallelParts = static_cast<size_t>(std::max(1, this->External->GetNumberOfParallelSegments()));
+  size_t nextPart = 0;
+  size_t numberOfDoneParts = 0;
+  for (UploadPart& part : parts)
+    {
+    part.File = file;
+    }
+  while (success && numberOfDoneParts < parts.size())
+    {
+    // keep NumberOfParallelSegments parts in flight
+    int numberOfRunningParts = 0;
+    curl_multi_perform(multiHandle, &numberOfRunningParts);
+    while (success && nextPart < parts.size()
+           && static_cast<size_t>(numberOfRunningParts) < numberOfParallelParts)
+      {
+      success = this->StartPartUpload(multiHandle, parts[nextPart++]);
+      ++numberOfRunningParts;
+      }
+    if (!success || this->External->GetTransferCancelRequested()
+        || curl_multi_perform(multiHandle, &numberOfRunningParts) != CURLM_OK)
+      {
+      success = false;
+      break;
+      }
+
+    CURLMsg* message = nullptr;
+    int numberOfMessages = 0;
+    while (success && (message = curl_multi_info_read(multiHandle, &numberOfMessages)))
+      {
+      if (message->msg != CURLMSG_DONE)
+        {
+        continue;
+        }
+      UploadPart* part = nullptr;
+      curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, reinterpret_cast<char**>(&part));
+      CURLcode result = message->data.result;
+      if (result == CURLE_OK && part->Offset == part->Start + part->Size)
+        {
+        part->Done = true;
+        ++numberOfDoneParts;
+        curl_multi_remove_handle(multiHandle, part->Handle);
+        this->External->CleanupCurlHandle(part->Handle);
+        part->Handle = nullptr;
+        }
+      else if (part->NumberOfAttempts < MaximumNumberOfPartAttempts)
+        {
+        vtkDebugWithObjectMacro(this->External, "StageFileWrite: sending part " << part->Number << " again after error: "
+          << curl_easy_strerror(result));
+        success = this->StartPartUpload(multiHandle, *part);
+        }
+      else
+        {
+        vtkErrorWithObjectMacro(this->External, "StageFileWrite: failed to upload part " << part->Number
+          << ": " << curl_easy_strerror(result));
+        success = false;
+        }
+      }
+
+    curl_off_t numberOfUploadedBytes = 0;
+    for (const UploadPart& part : parts)
+      {
+      numberOfUploadedBytes += part.Offset - part.Start;
+      }
+    this->External->ReportTransferProgress(numberOfUploadedBytes, fileSize);
+    if (success && numberOfDoneParts < parts.size())
+      {
+      curl_multi_wait(multiHandle, nullptr, 0, 1000, nullptr);
+      }
+    }
+
+  for (UploadPart& part : parts)
+    {
+    if (part.Handle)
+      {
+      curl_multi_remove_handle(multiHandle, part.Handle);
+      this->External->CleanupCurlHandle(part.Handle);
+      part.Handle = nullptr;
+      }
+    }
+  curl_multi_cleanup(multiHandle);
+  return success;
+}
+
+//----------------------------------------------------------------------------
+bool vtkObjectStoreHandler::vtkInternal::UploadFile(const std::string& url, FILE* file, curl_off_t fileSize)
+{
+  std::vector<UploadPart> parts(1);
+  parts[0].Number = 1;
+  parts[0].Size = fileSize;
+  parts[0].URL = url;
+  return this->UploadParts(file, parts, fileSize);
+}
+
+//----------------------------------------------------------------------------
+bool vtkObjectStoreHandler::vtkInternal::UploadMultipart(const std::string& url, FILE* file, curl_off_t fileSize)
+{
+  std::string response;
+  if (!this->PerformRequest(url + "?uploads", "POST", std::string(), response))
+    {
+    return false;
+    }
+  std::string uploadId = GetXMLElementText(response, "UploadId");
+  if (uploadId.empty())
+    {
+    vtkErrorWithObjectMacro(this->External, "StageFileWrite: failed to start the multipart upload to " << url);
+    return false;
+    }
+  std::string uploadIdQuery = "uploadId=" + EncodeURIComponent(uploadId, false);
+
+  // the number of parts is limited, larger files have larger parts
+  curl_off_t partSize = std::max<curl_off_t>(this->External->MultipartUploadPartSize,
+    (fileSize + MaximumNumberOfUploadParts - 1) / MaximumNumberOfUploadParts);
+  std::vector<UploadPart> parts(static_cast<size_t>((fileSize + partSize - 1) / partSize));
+  curl_off_t start = 0;
+  for (size_t partIndex = 0; partIndex < parts.size(); ++partIndex)
+    {
+    UploadPart& part = parts[partIndex];
+    part.Number = static_cast<int>(partIndex) + 1;
+    part.Start = start;
+    part.Size = std::min(partSize, fileSize - start);
+    part.URL = url + "?partNumber=" + std::to_string(part.Number) + "&" + uploadIdQuery;
+    start += part.Size;
+    }
+  vtkDebugWithObjectMacro(this->External, "StageFileWrite: uploading " << url << " in " << parts.size() << " parts");
+
+  bool success = this->UploadParts(file, parts, fileSize);
+  if (success)
+    {
+    std::ostringstream completion;
+    completion << "<CompleteMultipartUpload>";
+    for (const UploadPart& part : parts)
+      {
+      completion << "<Part><PartNumber>" << part.Number << "</PartNumber><ETag>" << part.ETag << "</ETag></Part>";
+      }
+    completion << "</CompleteMultipartUpload>";
+    response.clear();
+    success = this->PerformRequest(url + "?" + uploadIdQuery, "POST", completion.str(), response);
+    }
+  if (!success)
+    {
+    // release the parts already stored by the server
+    response.clear();
+    this->PerformRequest(url + "?" + uploadIdQuery, "DELETE", std::string(), response);
+    }
+  return success;
+}
+
+//----------------------------------------------------------------------------
+// vtkObjectStoreHandler methods
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkObjectStoreHandler);
+
+//----------------------------------------------------------------------------
+vtkObjectStoreHandler::vtkObjectStoreHandler()
+{
+  this->Internal = new vtkInternal(this);
+}
+
+//----------------------------------------------------------------------------
+vtkObjectStoreHandler::~vtkObjectStoreHandler()
+{
+  delete this->Internal;
+  this->SetEndpoint(nullptr);
+  this->SetRegion(nullptr);
+  this->SetAccessKeyId(nullptr);
+  this->SetSecretAccessKey(nullptr);
+  this->SetSessionToken(nullptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkObjectStoreHandler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Endpoint: " << (this->Endpoint ? this->Endpoint : "(none)") << "\n";
+  os << indent << "Region: " << (this->Region ? this->Region : "(none)") << "\n";
+  os << indent << "AccessKeyId: " << (this->AccessKeyId ? this->AccessKeyId : "(none)") << "\n";
+  os << indent << "UsePathStyleAddressing: " << this->UsePathStyleAddressing << "\n";
+  os << indent << "MultipartUploadPartSize: " << this->MultipartUploadPartSize << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkObjectStoreHandler::CopySettings(vtkURIHandler* handler)
+{
+  this->Superclass::CopySettings(handler);
+  vtkObjectStoreHandler* objectStoreHandler = vtkObjectStoreHandler::SafeDownCast(handler);
+  if (!objectStoreHandler)
+    {
+    return;
+    }
+  this->SetEndpoint(objectStoreHandler->GetEndpoint());
+  this->SetRegion(objectStoreHandler->GetRegion());
+  this->SetAccessKeyId(objectStoreHandler->GetAccessKeyId());
+  this->SetSecretAccessKey(objectStoreHandler->GetSecretAccessKey());
+  this->SetSessionToken(objectStoreHandler->GetSessionToken());
+  this->SetUsePathStyleAddressing(objectStoreHandler->GetUsePathStyleAddressing());
+  this->SetMultipartUploadPartSize(objectStoreHandler->GetMultipartUploadPartSize());
+}
+
+//----------------------------------------------------------------------------
+int vtkObjectStoreHandler::CanHandleURI(const char *uri)
+{
+  std::string scheme;
+  std::string bucket;
+  std::string key;
+  if (!ParseObjectURI(uri, scheme, bucket, key))
+    {
+    return 0;
+    }
+  vtkDebugMacro("CanHandleURI: can handle this file: " << uri);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkObjectStoreHandler::GetObjectURL(const char* uri)
+{
+  std::string scheme;
+  std::string bucket;
+  std::string key;
+  if (!ParseObjectURI(uri, scheme, bucket, key))
+    {
+    return std::string();
+    }
+
+  std::string endpoint;
+  if (this->Endpoint && this->Endpoint[0] != '\0')
+    {
+    endpoint = this->Endpoint;
+    }
+  else if (scheme == "gs")
+    {
+    endpoint = "https://storage.googleapis.com";
+    }
+  else
+    {
+    endpoint = "https://s3." + this->Internal->GetSigningRegion(scheme) + ".amazonaws.com";
+    }
+  while (!endpoint.empty() && endpoint.back() == '/')
+    {
+    endpoint.pop_back();
+    }
+
+  std::string path = "/" + EncodeURIComponent(key, true);
+  if (this->UsePathStyleAddressing)
+    {
+    return endpoint + "/" + bucket + path;
+    }
+  std::string::size_type hostStart = endpoint.find("://");
+  hostStart = (hostStart == std::string::npos) ? 0 : hostStart + 3;
+  return endpoint.substr(0, hostStart) + bucket + "." + endpoint.substr(hostStart) + path;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkObjectStoreHandler::GetRequestURL(const char* uri)
+{
+  return this->GetObjectURL(uri);
+}
+
+//----------------------------------------------------------------------------
+void vtkObjectStoreHandler::ConfigureRequest(void* curlHandle, const char* method,
+                                             const char* url, std::vector<std::string>& headers)
+{
+  CURL* handle = static_cast<CURL*>(curlHandle);
+  // do not save error documents as downloaded data
+  curl_easy_setopt(handle, CURLOPT_FAILONERROR, 1L);
+  if (this->Internal->AccessKeyId.empty() || !method || !url)
+    {
+    return;
+    }
+  // the payload of uploads is streamed, it is not part of the signature
+  std::vector<std::string> signedHeaders;
+  signedHeaders.emplace_back("x-amz-content-sha256: UNSIGNED-PAYLOAD");
+  signedHeaders.push_back("x-amz-date: " + GetAMZDate());
+  if (!this->Internal->SessionToken.empty())
+    {
+    signedHeaders.push_back("x-amz-security-token: " + this->Internal->SessionToken);
+    }
+  headers.insert(headers.end(), signedHeaders.begin(), signedHeaders.end());
+  headers.push_back("Authorization: " + vtkObjectStoreHandler::GetSignatureV4Authorization(method, url,
+    signedHeaders, "UNSIGNED-PAYLOAD", this->Internal->SigningRegion, "s3",
+    this->Internal->AccessKeyId, this->Internal->SecretAccessKey));
+}
+
+//----------------------------------------------------------------------------
+std::string vtkObjectStoreHandler::GetSignatureV4Authorization(const std::string& method, const std::string& url,
+  const std::vector<std::string>& headers, const std::string& payloadHash,
+  const std::string& region, const std::string& service,
+  const std::string& accessKeyId, const std::string& secretAccessKey)
+{
+  std::string authority;
+  std::string path;
+  std::string query;
+  SplitURL(url, authority, path, query);
+
+  // signed headers, sorted by lower case name
+  std::map<std::string, std::string> signedHeaders;
+  signedHeaders["host"] = authority;
+  for (const std::string& header : headers)
+    {
+    std::string::size_type separator = header.find(':');
+    if (separator == std::string::npos)
+      {
+      continue;
+      }
+    std::string name = vtksys::SystemTools::LowerCase(vtksys::SystemTools::TrimWhitespace(header.substr(0, separator)));
+    signedHeaders[name] = vtksys::SystemTools::TrimWhitespace(header.substr(separator + 1));
+    }
+  std::string amzDate = signedHeaders["x-amz-date"];
+  std::string date = amzDate.substr(0, 8);
+
+  std::ostringstream canonicalRequest;
+  canonicalRequest << method << "\n"
+    << (path.empty() ? std::string("/") : EncodeURIComponent(path, true)) << "\n"
+    << GetCanonicalQuery(query) << "\n";
+  std::string signedHeaderNames;
+  for (const std::pair<const std::string, std::string>& header : signedHeaders)
+    {
+    canonicalRequest << header.first << ":" << header.second << "\n";
+    signedHeaderNames += (signedHeaderNames.empty() ? "" : ";") + header.first;
+    }
+  canonicalRequest << "\n" << signedHeaderNames << "\n" << payloadHash;
+
+  std::string scope = date + "/" + region + "/" + service + "/aws4_request";
+  std::string stringToSign = "AWS4-HMAC-SHA256\n" + amzDate + "\n" + scope + "\n"
+    + ToHex(SHA256::Hash(canonicalRequest.str()));
+
+  std::string signingKey = HMACSHA256("AWS4" + secretAccessKey, date);
+  signingKey = HMACSHA256(signingKey, region);
+  signingKey = HMACSHA256(signingKey, service);
+  signingKey = HMACSHA256(signingKey, "aws4_request");
+
+  return "AWS4-HMAC-SHA256 Credential=" + accessKeyId + "/" + scope
+    + ",SignedHeaders=" + signedHeaderNames
+    + ",Signature=" + ToHex(HMACSHA256(signingKey, stringToSign));
+}
+
+//----------------------------------------------------------------------------
+void vtkObjectStoreHandler::StageFileRead(const char * source, const char * destination)
+{
+  std::string scheme;
+  std::string bucket;
+  std::string key;
+  if (!ParseObjectURI(source, scheme, bucket, key) || destination == nullptr)
+    {
+    vtkErrorMacro("StageFileRead: invalid source " << (source ? source : "(null)")
+                  << " or destination " << (destination ? destination : "(null)"));
+    return;
+    }
+  this->Internal->PrepareRequests(scheme);
+  this->Superclass::StageFileRead(source, destination);
+}
+
+//----------------------------------------------------------------------------
+void vtkObjectStoreHandler::StageFileWrite(const char * source, const char * destination)
+{
+  std::string scheme;
+  std::string bucket;
+  std::string key;
+  if (source == nullptr || !ParseObjectURI(destination, scheme, bucket, key))
+    {
+    vtkErrorMacro("StageFileWrite: invalid source " << (source ? source : "(null)")
+                  << " or destination " << (destination ? destination : "(null)"));
+    return;
+    }
+  std::ifstream sizeStream(source, std::ios::binary | std::ios::ate);
+  if (!sizeStream.is_open())
+    {
+    vtkErrorMacro("StageFileWrite: failed to open " << source);
+    return;
+    }
+  curl_off_t fileSize = static_cast<curl_off_t>(sizeStream.tellg());
+  sizeStream.close();
+  this->Internal->PrepareRequests(scheme);
+
+  this->LocalFile = fopen(source, "rb");
+  if (!this->LocalFile)
+    {
+    vtkErrorMacro("StageFileWrite: failed to open " << source);
+    return;
+    }
+  this->InitTransfer();
+  std::string url = this->GetObjectURL(destination);
+  bool success = false;
+  if (fileSize > this->MultipartUploadPartSize)
+    {
+    success = this->Internal->UploadMultipart(url, this->LocalFile, fileSize);
+    }
+  else
+    {
+    success = this->Internal->UploadFile(url, this->LocalFile, fileSize);
+    }
+  this->CloseTransfer();
+  fclose(this->LocalFile);
+  this->LocalFile = nullptr;
+
+  if (success)
+    {
+    vtkDebugMacro("StageFileWrite: uploaded " << source << " to " << destination);
+    }
+  else if (this->GetTransferCancelRequested())
+    {
+    vtkDebugMacro("StageFileWrite: upload of " << source << " cancelled");
+    }
+  else
+    {
+    vtkErrorMacro("StageFileWrite: failed to upload " << source << " to " << destination);
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef __vtkObjectStoreHandler_h
+#define __vtkObjectStoreHandler_h
+
+// RemoteIO includes
+#include <vtkRemoteIOConfigure.h>
+#include "vtkRemoteIO.h"
+#include "vtkHTTPHandler.h"
+
+/// \brief URI handler for S3 compatible object stores.
+///
+/// Handles "s3://bucket/key" and "gs://bucket/key" URIs. Requests are sent
+/// to the S3 REST API of Endpoint (Google Cloud Storage is accessed through
+/// its S3 compatible XML API) and signed with AWS signature version 4 when
+/// credentials are available.
+///
+/// Downloads use the parallel byte range requests of vtkHTTPHandler.
+/// Files larger than MultipartUploadPartSize are uploaded with a multipart
+/// upload, sending NumberOfParallelSegments parts at the same time.
+class VTK_RemoteIO_EXPORT vtkObjectStoreHandler : public vtkHTTPHandler
+{
+public:
+  static vtkObjectStoreHandler *New();
+  vtkTypeMacro(vtkObjectStoreHandler, vtkHTTPHandler);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Returns 1 for "s3://" and "gs://" URIs, 0 otherwise.
+  int CanHandleURI(const char *uri) override;
+
+  /// Download the object \a source (s3:// or gs:// URI) into the local file
+  /// \a destination.
+  void StageFileRead(const char * source, const char * destination) override;
+  using vtkHTTPHandler::StageFileRead;
+
+  /// Upload the local file \a source as the object \a destination
+  /// (s3:// or gs:// URI).
+  /// vtkCommand::ProgressEvent is invoked as for StageFileRead() and the
+  /// upload is aborted if SetTransferCancelRequested(true) is called meanwhile.
+  void StageFileWrite(const char * source, const char * destination) override;
+  using vtkHTTPHandler::StageFileWrite;
+
+  /// Copy the settings of \a handler, including the object store
+  /// specific ones if \a handler is a vtkObjectStoreHandler.
+  void CopySettings(vtkURIHandler* handler) override;
+
+  /// Base URL of the S3 API (e.g. "https://minio.example.org:9000").
+  /// If not set, "https://s3.<Region>.amazonaws.com" is used for s3:// URIs
+  /// and "https://storage.googleapis.com" for gs:// URIs.
+  vtkSetStringMacro(Endpoint);
+  vtkGetStringMacro(Endpoint);
+
+  /// Region used to sign the requests.
+  /// Default is the AWS_REGION environment variable, or "us-east-1" if not set.
+  /// Requests to Google Cloud Storage are always signed for the "auto" region.
+  vtkSetStringMacro(Region);
+  vtkGetStringMacro(Region);
+
+  /// Credentials used to sign the requests (HMAC keys for Google Cloud Storage).
+  /// Default are the AWS_ACCESS_KEY_ID, AWS_SECRET_ACCESS_KEY and
+  /// AWS_SESSION_TOKEN environment variables. Requests are anonymous if
+  /// there is no access key.
+  vtkSetStringMacro(AccessKeyId);
+  vtkGetStringMacro(AccessKeyId);
+  vtkSetStringMacro(SecretAccessKey);
+  vtkGetStringMacro(SecretAccessKey);
+  vtkSetStringMacro(SessionToken);
+  vtkGetStringMacro(SessionToken);
+
+  /// If enabled, objects are addressed as "<Endpoint>/<bucket>/<key>" instead
+  /// of "<bucket>.<endpoint host>/<key>". Most S3 compatible servers
+  /// (e.g. MinIO) require path style addressing.
+  /// Disabled by default.
+  vtkSetMacro(UsePathStyleAddressing, bool);
+  vtkGetMacro(UsePathStyleAddressing, bool);
+  vtkBooleanMacro(UsePathStyleAddressing, bool);
+
+  /// Size in bytes of the parts of a multipart upload. Smaller files are
+  /// uploaded in a single request.
+  /// Must be between 5MB and 5GB (limits of the S3 API). Default is 16MB.
+  vtkSetClampMacro(MultipartUploadPartSize, vtkTypeInt64, 5 * 1024 * 1024, static_cast<vtkTypeInt64>(5) * 1024 * 1024 * 1024);
+  vtkGetMacro(MultipartUploadPartSize, vtkTypeInt64);
+
+  /// Return the https URL of the object \a uri, or an empty string if \a uri
+  /// is not a valid s3:// or gs:// URI.
+  std::string GetObjectURL(const char* uri);
+
+  /// Return the value of the Authorization header of a request signed with
+  /// AWS signature version 4.
+  /// \a headers are the "name: value" headers to sign in addition to the
+  /// host of \a url, they must contain "x-amz-date".
+  /// \a payloadHash is the hex SHA-256 of the body, or "UNSIGNED-PAYLOAD".
+  static std::string GetSignatureV4Authorization(const std::string& method, const std::string& url,
+    const std::vector<std::string>& headers, const std::string& payloadHash,
+    const std::string& region, const std::string& service,
+    const std::string& accessKeyId, const std::string& secretAccessKey);
+
+protected:
+  vtkObjectStoreHandler();
+  ~vtkObjectStoreHandler() override;
+  vtkObjectStoreHandler(const vtkObjectStoreHandler&);
+  void operator=(const vtkObjectStoreHandler&);
+
+  std::string GetRequestURL(const char* uri) override;
+
+  /// Fail on HTTP errors and sign the request with AWS signature version 4.
+  /// Signing is implemented here rather than with CURLOPT_AWS_SIGV4, which
+  /// requires a newer curl than the one Slicer is built with.
+  void ConfigureRequest(void* curlHandle, const char* method, const char* url,
+                        std::vector<std::string>& headers) override;
+
+private:
+  class vtkInternal;
+  vtkInternal* Internal;
+  char* Endpoint{nullptr};
+  char* Region{nullptr};
+  char* AccessKeyId{nullptr};
+  char* SecretAccessKey{nullptr};
+  char* SessionToken{nullptr};
+  bool UsePathStyleAddressing{false};
+  vtkTypeInt64 MultipartUploadPartSize{16 * 1024 * 1024};
+};
+
+#endif
@@ -40,6 +40,8 @@
 
 // STD includes
 #include <algorithm>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "itkArchetypeSeriesFileNames.h"
@@ -51,8 +53,44 @@
 #include "itkGDCMImageIO.h"
 #endif
 
+// VTKSYS includes
+#include <vtksys/SystemTools.hxx>
+
 vtkStandardNewMacro(vtkITKArchetypeImageSeriesReader);
 
+namespace
+{
+/// DICOM tags that AnalyzeDicomHeaders() uses for grouping and sorting files.
+enum AnalyzedDicomTagIndex
+{
+  SeriesInstanceUIDTag = 0,
+  ContentTimeTag,
+  TriggerTimeTag,
+  EchoNumbersTag,
+  DiffusionGradientOrientationTag,
+  SliceLocationTag,
+  ImageOrientationPatientTag,
+  ImagePositionPatientTag,
+  NumberOfAnalyzedDicomTags // this line must be the last one
+};
+const char* const AnalyzedDicomTags[NumberOfAnalyzedDicomTags] =
+  { "0020|000e", "0008|0033", "0018|1060", "0018|0086", "0010|9089", "0020|1041", "0020|0037", "0020|0032" };
+
+/// Values of the analyzed tags of a file, shared by all readers, so that loading
+/// the same series again (or another series from the same directory) does not
+/// require reading all the headers again.
+struct DicomHeaderCacheEntry
+{
+  unsigned long FileSize{0};
+  long ModifiedTime{0};
+  std::string TagValues[NumberOfAnalyzedDicomTags];
+};
+std::mutex DicomHeaderCacheMutex;
+std::unordered_map<std::string, DicomHeaderCacheEntry> DicomHeaderCache;
+/// The cache is emptied when it grows larger than this, to limit memory usage.
+const size_t MaximumNumberOfDicomHeaderCacheEntries = 500000;
+}
+
 //----------------------------------------------------------------------------
 vtkITKArchetypeImageSeriesReader::vtkITKArchetypeImageSeriesReader()
 {
@@ -73,6 +111,7 @@ vtkITKArchetypeImageSeriesReader::vtkITKArchetypeImageSeriesReader()
 #ifdef VTKITK_BUILD_DICOM_SUPPORT
   this->DICOMImageIOApproach = vtkITKArchetypeImageSeriesReader::GDCM;
 #endif
+  this->NumberOfThreads = 0;
 
   this->OutputScalarType = VTK_FLOAT;
   this->NumberOfComponents = 0;
@@ -92,6 +131,7 @@ vtkITKArchetypeImageSeriesReader::vtkITKArchetypeImageSeriesReader()
   this->ImageOrientationPatient.resize( 0 );
 
   this->AnalyzeHeader = true;
+  this->UseHeaderCache = true;
 
   this->GroupingByTags = false;
   this->IsOnlyFile = false;
@@ -179,6 +219,8 @@ void vtkITKArchetypeImageSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
     os << ", " << this->DefaultDataOrigin[idx];
     }
   os << ")\n";
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "UseHeaderCache: " << (this->UseHeaderCache ? "true" : "false") << "\n";
 #ifdef VTKITK_BUILD_DICOM_SUPPORT
   os << indent << "DICOMImageIOApproach: " << this->GetDICOMImageIOApproach();
 #else
@@ -1254,6 +1296,13 @@ void vtkITKArchetypeImageSeriesReader::GroupFiles ( int idxSeriesInstanceUID,
   return;
 }
 
+//----------------------------------------------------------------------------
+void vtkITKArchetypeImageSeriesReader::ClearHeaderCache()
+{
+  std::lock_guard<std::mutex> lock(DicomHeaderCacheMutex);
+  DicomHeaderCache.clear();
+}
+
 std::string vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(const itk::MetaDataDictionary &dict, const std::string& tag)
 {
   std::string tagValue;
@@ -1372,17 +1421,49 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
   gdcmIO->SetFileName( this->Archetype );
   for (int f = 0; f < nFiles; f++)
     {
-    gdcmIO->SetFileName( this->AllFileNames[f] );
-    gdcmIO->ReadImageInformation();
-    itk::MetaDataDictionary &dict = gdcmIO->GetMetaDataDictionary();
+    const std::string& fileName = this->AllFileNames[f];
+    DicomHeaderCacheEntry header;
+    bool cachedHeaderFound = false;
+    if (this->UseHeaderCache)
+      {
+      header.FileSize = vtksys::SystemTools::FileLength(fileName);
+      header.ModifiedTime = vtksys::SystemTools::ModifiedTime(fileName);
+      std::lock_guard<std::mutex> lock(DicomHeaderCacheMutex);
+      auto cachedHeaderIt = DicomHeaderCache.find(fileName);
+      if (cachedHeaderIt != DicomHeaderCache.end()
+        && cachedHeaderIt->second.FileSize == header.FileSize
+        && cachedHeaderIt->second.ModifiedTime == header.ModifiedTime)
+        {
+        header = cachedHeaderIt->second;
+        cachedHeaderFound = true;
+        }
+      }
+    if (!cachedHeaderFound)
+      {
+      gdcmIO->SetFileName( fileName );
+      gdcmIO->ReadImageInformation();
+      itk::MetaDataDictionary &dict = gdcmIO->GetMetaDataDictionary();
+      // Use vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces to remove extra spaces
+      // from the DICOM tag, because extra spaces were found in some DICOM file before/after the
+      // multi-value separator backslashes.
+      for (int tagIndex = 0; tagIndex < NumberOfAnalyzedDicomTags; ++tagIndex)
+        {
+        header.TagValues[tagIndex] = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, AnalyzedDicomTags[tagIndex]);
+        }
+      if (this->UseHeaderCache)
+        {
+        std::lock_guard<std::mutex> lock(DicomHeaderCacheMutex);
+        if (DicomHeaderCache.size() >= MaximumNumberOfDicomHeaderCacheEntries)
+          {
+          DicomHeaderCache.clear();
+          }
+        DicomHeaderCache[fileName] = header;
+        }
+      }
     std::string tagValue;
 
-    // Use vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces to remove extra spaces
-    // from the DICOM tag, because extra spaces were found in some DICOM file before/after the
-    // multi-value separator backslashes.
-
     // series instance UID
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0020|000e");
+    tagValue = header.TagValues[SeriesInstanceUIDTag];
     if (!tagValue.empty())
       {
       int idx = InsertSeriesInstanceUIDs( tagValue.c_str() );
@@ -1394,7 +1475,7 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
       }
 
     // content time
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0008|0033");
+    tagValue = header.TagValues[ContentTimeTag];
     if (!tagValue.empty())
       {
       int idx = InsertContentTime( tagValue.c_str() );
@@ -1406,7 +1487,7 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
       }
 
     // trigger time
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0018|1060");
+    tagValue = header.TagValues[TriggerTimeTag];
     if (!tagValue.empty())
       {
       int idx = InsertTriggerTime( tagValue.c_str() );
@@ -1418,7 +1499,7 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
       }
 
     // echo numbers
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0018|0086");
+    tagValue = header.TagValues[EchoNumbersTag];
     if (!tagValue.empty())
       {
       int idx = InsertEchoNumbers( tagValue.c_str() );
@@ -1430,7 +1511,7 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
       }
 
     // diffision gradient orientation
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0010|9089");
+    tagValue = header.TagValues[DiffusionGradientOrientationTag];
     if (!tagValue.empty())
       {
       float a[3] = { -1 };
@@ -1444,7 +1525,7 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
       }
 
     // slice location
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0020|1041");
+    tagValue = header.TagValues[SliceLocationTag];
     if (!tagValue.empty())
       {
       float a = -1;
@@ -1458,7 +1539,7 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
       }
 
     // image orientation patient
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0020|0037");
+    tagValue = header.TagValues[ImageOrientationPatientTag];
     if (!tagValue.empty())
       {
       float a[6] = { -1 };
@@ -1471,7 +1552,7 @@ void vtkITKArchetypeImageSeriesReader::AnalyzeDicomHeaders()
       this->IndexImageOrientationPatient[f] = -1;
       }
     // image position patient
-    tagValue = vtkITKArchetypeImageSeriesReader::GetMetaDataWithoutSpaces(dict, "0020|0032");
+    tagValue = header.TagValues[ImagePositionPatientTag];
     if (!tagValue.empty())
       {
       float a[3] = { -1 };
@@ -226,6 +226,13 @@ public:
   void SetDICOMImageIOApproachToGDCM() {this->SetDICOMImageIOApproach(vtkITKArchetypeImageSeriesReader::GDCM);};
   void SetDICOMImageIOApproachToDCMTK() {this->SetDICOMImageIOApproach(vtkITKArchetypeImageSeriesReader::DCMTK);};
 
+  ///
+  /// Number of threads used for reading and decoding the slices of an image series.
+  /// Each thread reads complete files, directly into the output volume.
+  /// 0 (default) uses as many threads as there are processor cores, 1 reads the slices sequentially.
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+
   ///
   /// Get the file format.  Pixels are this type in the file.
   vtkSetMacro(OutputScalarType, int);
@@ -246,6 +253,18 @@ public:
   vtkSetMacro(AnalyzeHeader, bool);
   vtkGetMacro(AnalyzeHeader, bool);
 
+  ///
+  /// Whether to reuse DICOM header information that this or other readers already read
+  /// when analyzing the headers. The cache is keyed by file path, an entry is only used
+  /// if the size and modification time of the file did not change. Enabled by default.
+  vtkSetMacro(UseHeaderCache, bool);
+  vtkGetMacro(UseHeaderCache, bool);
+  vtkBooleanMacro(UseHeaderCache, bool);
+
+  ///
+  /// Remove all entries from the DICOM header cache that is shared by all readers.
+  static void ClearHeaderCache();
+
   ///
   /// Whether to use orientation from file
   vtkSetMacro(UseOrientationFromFile, int);
@@ -845,6 +864,8 @@ protected:
 
   int DICOMImageIOApproach;
 
+  int NumberOfThreads;
+
   bool GroupingByTags;
   int SelectedUID;
   int SelectedContentTime;
@@ -879,6 +900,7 @@ protected:
 
   std::vector<std::string> AllFileNames;
   bool AnalyzeHeader;
+  bool UseHeaderCache;
   bool IsOnlyFile;
   bool ArchetypeIsDICOM;
 
@@ -28,6 +28,7 @@
 #include <vtkVersion.h>
 
 // ITK includes
+#include <itkImageFileReader.h>
 #include <itkOrientImageFilter.h>
 #include <itkImageSeriesReader.h>
 #ifdef VTKITK_BUILD_DICOM_SUPPORT
@@ -35,6 +36,13 @@
 #include <itkGDCMImageIO.h>
 #endif
 
+// STD includes
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 vtkStandardNewMacro(vtkITKArchetypeImageSeriesScalarReader);
 
 namespace {
@@ -45,6 +53,109 @@ vtkAOSDataArrayTemplate<T>* DownCast(vtkAbstractArray* a)
   return vtkAOSDataArrayTemplate<T>::FastDownCast(a);
 }
 
+/// Read an image series by reading and decoding the files in multiple threads,
+/// directly into the buffer of the returned volume.
+/// Size, spacing, origin, and axis directions of the volume are determined by the
+/// series reader, the same way as when the series reader reads the slices sequentially.
+/// Returns nullptr if the series cannot be read this way (only one thread is
+/// available or files do not contain exactly one slice), in this case the series
+/// reader has to be used.
+/// Throws itk::ExceptionObject if reading of any of the files fails.
+template <class TImage>
+typename TImage::Pointer ReadSeriesSlicesInParallel(itk::ImageSeriesReader<TImage>* seriesReader,
+  itk::ImageIOBase* imageIOPrototype, const std::vector<std::string>& fileNames,
+  int numberOfThreads, vtkAlgorithm* progressReporter)
+{
+  if (numberOfThreads <= 0)
+    {
+    numberOfThreads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+  numberOfThreads = std::min(numberOfThreads, static_cast<int>(fileNames.size()));
+  if (numberOfThreads < 2)
+    {
+    return nullptr;
+    }
+
+  seriesReader->UpdateOutputInformation();
+  const typename TImage::RegionType region = seriesReader->GetOutput()->GetLargestPossibleRegion();
+  if (region.GetSize()[2] != fileNames.size())
+    {
+    // files do not contain exactly one slice each
+    return nullptr;
+    }
+  typename TImage::Pointer volume = TImage::New();
+  volume->CopyInformation(seriesReader->GetOutput());
+  volume->SetRegions(region);
+  volume->Allocate();
+  const size_t numberOfPixelsPerSlice = region.GetSize()[0] * region.GetSize()[1];
+  typename TImage::PixelType* volumeBuffer = volume->GetBufferPointer();
+
+  std::atomic<size_t> nextSliceIndex{0};
+  std::atomic<size_t> numberOfReadSlices{0};
+  std::atomic<bool> failed{false};
+  std::mutex errorMutex;
+  std::string errorMessage;
+  auto readSlices = [&](bool reportProgress)
+    {
+    for (size_t sliceIndex = nextSliceIndex++; sliceIndex < fileNames.size() && !failed; sliceIndex = nextSliceIndex++)
+      {
+      try
+        {
+        typename itk::ImageFileReader<TImage>::Pointer sliceReader = itk::ImageFileReader<TImage>::New();
+        if (imageIOPrototype)
+          {
+          // image IO objects cannot be shared between threads, use a new instance for each file
+          itk::ImageIOBase::Pointer imageIO = dynamic_cast<itk::ImageIOBase*>(imageIOPrototype->CreateAnother().GetPointer());
+          sliceReader->SetImageIO(imageIO);
+          }
+        sliceReader->SetFileName(fileNames[sliceIndex]);
+        sliceReader->Update();
+        TImage* slice = sliceReader->GetOutput();
+        if (slice->GetBufferedRegion().GetNumberOfPixels() != numberOfPixelsPerSlice)
+          {
+          itkGenericExceptionMacro(<< "Size of image in file " << fileNames[sliceIndex]
+            << " does not match the size of the first image of the series");
+          }
+        std::copy(slice->GetBufferPointer(), slice->GetBufferPointer() + numberOfPixelsPerSlice,
+          volumeBuffer + sliceIndex * numberOfPixelsPerSlice);
+        }
+      catch (std::exception& e)
+        {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!failed)
+          {
+          errorMessage = e.what();
+          failed = true;
+          }
+        }
+      ++numberOfReadSlices;
+      if (reportProgress)
+        {
+        // VTK events must only be invoked from the thread that executes the reader
+        progressReporter->UpdateProgress(static_cast<double>(numberOfReadSlices) / fileNames.size());
+        }
+      }
+    };
+
+  std::vector<std::thread> threads;
+  for (int threadIndex = 1; threadIndex < numberOfThreads; ++threadIndex)
+    {
+    threads.emplace_back(readSlices, false);
+    }
+  readSlices(true);
+  for (std::thread& thread : threads)
+    {
+    thread.join();
+    }
+
+  if (failed)
+    {
+    itkGenericExceptionMacro(<< "Failed to read image series: " << errorMessage);
+    }
+  progressReporter->UpdateProgress(1.0);
+  return volume;
+}
+
 };
 
 //----------------------------------------------------------------------------
@@ -117,8 +228,6 @@ int vtkITKArchetypeImageSeriesScalarReader::RequestData(
     case typeN: \
     {\
       typedef itk::Image<type,3> image##typeN;\
-      typedef itk::ImageSource<image##typeN> FilterType; \
-      FilterType::Pointer filter; \
       itk::ImageSeriesReader<image##typeN>::Pointer reader##typeN = \
         itk::ImageSeriesReader<image##typeN>::New(); \
       vtkITKExecuteDataDeclareDICOMImageIO \
@@ -132,23 +241,26 @@ int vtkITKArchetypeImageSeriesScalarReader::RequestData(
       reader##typeN->AddObserver(itk::ProgressEvent(),pcl); \
       reader##typeN->SetFileNames(this->FileNames); \
       reader##typeN->ReleaseDataFlagOn(); \
-      if (this->UseNativeCoordinateOrientation) \
+      image##typeN::Pointer volume##typeN = ReadSeriesSlicesInParallel<image##typeN>(reader##typeN, \
+        this->ArchetypeIsDICOM ? imageIO.GetPointer() : nullptr, this->FileNames, this->NumberOfThreads, this); \
+      if (volume##typeN.IsNull()) \
         { \
-        filter = reader##typeN; \
+        reader##typeN->UpdateLargestPossibleRegion(); \
+        volume##typeN = reader##typeN->GetOutput(); \
         } \
-      else \
+      if (!this->UseNativeCoordinateOrientation) \
         { \
         itk::OrientImageFilter<image##typeN,image##typeN>::Pointer orient##typeN = \
             itk::OrientImageFilter<image##typeN,image##typeN>::New(); \
         if (this->Debug) {orient##typeN->DebugOn();} \
-        orient##typeN->SetInput(reader##typeN->GetOutput()); \
+        orient##typeN->SetInput(volume##typeN); \
         orient##typeN->UseImageDirectionOn(); \
         orient##typeN->SetDesiredCoordinateOrientation(this->DesiredCoordinateOrientation); \
-        filter = orient##typeN; \
+        orient##typeN->UpdateLargestPossibleRegion(); \
+        volume##typeN = orient##typeN->GetOutput(); \
         }\
-      filter->UpdateLargestPossibleRegion(); \
       itk::ImportImageContainer<itk::SizeValueType, type>::Pointer PixelContainer##typeN;\
-      PixelContainer##typeN = filter->GetOutput()->GetPixelContainer();\
+      PixelContainer##typeN = volume##typeN->GetPixelContainer();\
       void *ptr = static_cast<void *> (PixelContainer##typeN->GetBufferPointer());\
       DownCast<type>(data->GetPointData()->GetScalars())                \
         ->SetVoidArray(ptr, PixelContainer##typeN->Size(), 0,\
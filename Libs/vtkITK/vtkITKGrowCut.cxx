@@ -34,13 +34,522 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 /// ITK includes
 #include "itkFastGrowCut.h"
 
+/// STD includes
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
 vtkStandardNewMacro(vtkITKGrowCut);
 
+//----------------------------------------------------------------------------
+// Parallel grow-cut.
+//
+// Each voxel gets the label of the seed with the shortest path to it, where
+// the length of a step between two neighbor voxels (26-neighborhood) is their
+// intensity difference plus DistancePenalty times their physical distance.
+// Paths are propagated by buckets of path length (delta-stepping): voxels of
+// the current bucket are processed in parallel and their neighbors are updated
+// with an atomic minimum. The path length and the rank of the label are
+// packed in one 64-bit key; paths of equal length are resolved by the smallest
+// label value. Path lengths are integers (in 1/1024 of the bucket width, at
+// least 1 per step) so that they are summed exactly, which makes the result
+// independent of the order of the updates.
+//
+// When only seeds change, the previous result is updated locally: voxels
+// reached from removed seeds are reset, then paths are propagated from the
+// added seeds and from the voxels around the reset region.
+class vtkITKGrowCutParallelState
+{
+public:
+  typedef std::uint64_t KeyType;
+  static const int LabelRankBits = 20;
+  static const int DistanceUnitsPerBucketBits = 10;
+  static const KeyType MaximumDistance = (KeyType(1) << (64 - LabelRankBits)) - 2;
+  static const KeyType UnreachedKey = std::numeric_limits<KeyType>::max();
+  // masked voxels have the smallest key, they are never updated
+  static const KeyType MaskedKey = 0;
+
+  static KeyType PackKey(KeyType distance, std::uint32_t labelRank)
+  {
+    return (distance << LabelRankBits) | labelRank;
+  }
+  static KeyType KeyDistance(KeyType key)
+  {
+    return key >> LabelRankBits;
+  }
+  static std::uint64_t KeyBucket(KeyType key)
+  {
+    return KeyDistance(key) >> DistanceUnitsPerBucketBits;
+  }
+  static std::uint32_t KeyLabelRank(KeyType key)
+  {
+    return static_cast<std::uint32_t>(key & ((KeyType(1) << LabelRankBits) - 1));
+  }
+  // seeds have zero distance and a label rank > 0
+  static bool IsSeedKey(KeyType key)
+  {
+    return KeyDistance(key) == 0 && key != MaskedKey;
+  }
+
+  void Reset()
+  {
+    this->Keys.reset();
+    this->LabelValues.clear();
+    this->NumberOfVoxels = 0;
+  }
+
+  /// Compute the labels of all the voxels in result.
+  /// Returns false if there are too many labels.
+  template <typename IntensityType, typename SeedLabelType, typename MaskType>
+  bool Run(const IntensityType* intensity, const SeedLabelType* seeds, const MaskType* mask,
+    const int dimensions[3], const double spacing[3], double distancePenalty, SeedLabelType* result);
+
+  std::unique_ptr<std::atomic<KeyType>[]> Keys;
+  std::vector<double> LabelValues; // sorted label values, first is 0 (unreached and masked voxels)
+  vtkIdType NumberOfVoxels{ 0 };
+  int Dimensions[3]{ 0, 0, 0 };
+  double Spacing[3]{ 0.0, 0.0, 0.0 };
+  double DistancePenalty{ 0.0 };
+  double DistanceUnits{ 0.0 }; // distance units per intensity unit
+
+protected:
+  struct Neighbor
+  {
+    int Offset[3];
+    vtkIdType IndexOffset;
+    double DistancePenalty; // in distance units
+  };
+  typedef std::map<std::uint64_t, std::vector<vtkIdType> > BucketsType;
+  typedef std::vector<std::pair<std::uint64_t, vtkIdType> > UpdatedVoxelsType;
+
+  void InitializeNeighbors();
+
+  // Call function(neighbor, neighborIndex) for each neighbor of the voxel, inside the volume
+  template <typename FunctionType>
+  void ForEachNeighbor(vtkIdType index, FunctionType function) const;
+
+  // Key of the path to a neighbor
+  template <typename IntensityType>
+  KeyType GetNeighborKey(KeyType key, const IntensityType* intensity, vtkIdType index,
+    const Neighbor& neighbor, vtkIdType neighborIndex) const
+  {
+    const double step = this->DistanceUnits
+      * std::fabs(static_cast<double>(intensity[index]) - static_cast<double>(intensity[neighborIndex])) + neighbor.DistancePenalty;
+    return PackKey(std::min(KeyDistance(key) + std::max<KeyType>(1, static_cast<KeyType>(step + 0.5)), MaximumDistance),
+      KeyLabelRank(key));
+  }
+
+  // Reset the voxels reached from the removed seeds and add the voxels around them to the buckets
+  template <typename IntensityType>
+  void ResetRemovedSeedRegions(const IntensityType* intensity, const std::vector<vtkIdType>& removedSeeds, BucketsType& buckets);
+
+  template <typename IntensityType>
+  void Propagate(const IntensityType* intensity, BucketsType& buckets);
+
+  std::vector<Neighbor> Neighbors;
+};
+
+//----------------------------------------------------------------------------
+void vtkITKGrowCutParallelState::InitializeNeighbors()
+{
+  this->Neighbors.clear();
+  const vtkIdType dimX = this->Dimensions[0];
+  const vtkIdType dimY = this->Dimensions[1];
+  for (int iz = -1; iz <= 1; ++iz)
+    {
+    for (int iy = -1; iy <= 1; ++iy)
+      {
+      for (int ix = -1; ix <= 1; ++ix)
+        {
+        if (ix == 0 && iy == 0 && iz == 0)
+          {
+          continue;
+          }
+        Neighbor neighbor;
+        neighbor.Offset[0] = ix;
+        neighbor.Offset[1] = iy;
+        neighbor.Offset[2] = iz;
+        neighbor.IndexOffset = ix + dimX * (iy + dimY * iz);
+        neighbor.DistancePenalty = this->DistanceUnits * this->DistancePenalty * sqrt(
+          (this->Spacing[0] * ix) * (this->Spacing[0] * ix)
+          + (this->Spacing[1] * iy) * (this->Spacing[1] * iy)
+          + (this->Spacing[2] * iz) * (this->Spacing[2] * iz));
+        this->Neighbors.push_back(neighbor);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <typename FunctionType>
+void vtkITKGrowCutParallelState::ForEachNeighbor(vtkIdType index, FunctionType function) const
+{
+  const vtkIdType dimX = this->Dimensions[0];
+  const vtkIdType dimY = this->Dimensions[1];
+  const vtkIdType dimZ = this->Dimensions[2];
+  const vtkIdType x = index % dimX;
+  const vtkIdType y = (index / dimX) % dimY;
+  const vtkIdType z = index / (dimX * dimY);
+  for (const Neighbor& neighbor : this->Neighbors)
+    {
+    if (x + neighbor.Offset[0] < 0 || x + neighbor.Offset[0] >= dimX
+      || y + neighbor.Offset[1] < 0 || y + neighbor.Offset[1] >= dimY
+      || z + neighbor.Offset[2] < 0 || z + neighbor.Offset[2] >= dimZ)
+      {
+      continue;
+      }
+    function(neighbor, index + neighbor.IndexOffset);
+    }
+}
+
+//----------------------------------------------------------------------------
+template <typename IntensityType>
+void vtkITKGrowCutParallelState::ResetRemovedSeedRegions(const IntensityType* intensity,
+  const std::vector<vtkIdType>& removedSeeds, BucketsType& buckets)
+{
+  std::atomic<KeyType>* keys = this->Keys.get();
+
+  // A voxel is reset if its key is the key of the path through a reset
+  // neighbor. Path lengths are exact, so the reset region is exactly the
+  // voxels that got their label from the removed seeds (and voxels that have
+  // another path of the same length).
+  std::vector<std::pair<vtkIdType, KeyType> > resetVoxels;
+  for (vtkIdType index : removedSeeds)
+    {
+    resetVoxels.emplace_back(index, keys[index].exchange(UnreachedKey));
+    }
+  std::vector<vtkIdType> resetRegion;
+  typedef std::vector<std::pair<vtkIdType, KeyType> > ResetVoxelsType;
+  vtkSMPThreadLocal<ResetVoxelsType> nextResetVoxels;
+  while (!resetVoxels.empty())
+    {
+    for (const std::pair<vtkIdType, KeyType>& resetVoxel : resetVoxels)
+      {
+      resetRegion.push_back(resetVoxel.first);
+      }
+    vtkSMPTools::For(0, static_cast<vtkIdType>(resetVoxels.size()), 256, [&](vtkIdType begin, vtkIdType end)
+      {
+      ResetVoxelsType& localNextResetVoxels = nextResetVoxels.Local();
+      for (vtkIdType i = begin; i < end; ++i)
+        {
+        const vtkIdType index = resetVoxels[i].first;
+        const KeyType key = resetVoxels[i].second;
+        this->ForEachNeighbor(index, [&](const Neighbor& neighbor, vtkIdType neighborIndex)
+          {
+          KeyType neighborKey = this->GetNeighborKey(key, intensity, index, neighbor, neighborIndex);
+          const KeyType pathKey = neighborKey;
+          if (keys[neighborIndex].compare_exchange_strong(neighborKey, UnreachedKey, std::memory_order_relaxed))
+            {
+            localNextResetVoxels.emplace_back(neighborIndex, pathKey);
+            }
+          });
+        }
+      });
+    resetVoxels.clear();
+    for (ResetVoxelsType& localNextResetVoxels : nextResetVoxels)
+      {
+      resetVoxels.insert(resetVoxels.end(), localNextResetVoxels.begin(), localNextResetVoxels.end());
+      localNextResetVoxels.clear();
+      }
+    }
+
+  // Paths to the reset region are propagated again from the voxels around it
+  vtkSMPThreadLocal<UpdatedVoxelsType> borderVoxels;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(resetRegion.size()), 256, [&](vtkIdType begin, vtkIdType end)
+    {
+    UpdatedVoxelsType& localBorderVoxels = borderVoxels.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+      {
+      this->ForEachNeighbor(resetRegion[i], [&](const Neighbor& vtkNotUsed(neighbor), vtkIdType neighborIndex)
+        {
+        const KeyType neighborKey = keys[neighborIndex].load(std::memory_order_relaxed);
+        if (neighborKey != UnreachedKey && neighborKey != MaskedKey)
+          {
+          localBorderVoxels.emplace_back(KeyBucket(neighborKey), neighborIndex);
+          }
+        });
+      }
+    });
+  for (UpdatedVoxelsType& localBorderVoxels : borderVoxels)
+    {
+    for (const std::pair<std::uint64_t, vtkIdType>& borderVoxel : localBorderVoxels)
+      {
+      buckets[borderVoxel.first].push_back(borderVoxel.second);
+      }
+    }
+  for (BucketsType::value_type& bucket : buckets)
+    {
+    std::sort(bucket.second.begin(), bucket.second.end());
+    bucket.second.erase(std::unique(bucket.second.begin(), bucket.second.end()), bucket.second.end());
+    }
+}
+
+//----------------------------------------------------------------------------
+template <typename IntensityType>
+void vtkITKGrowCutParallelState::Propagate(const IntensityType* intensity, BucketsType& buckets)
+{
+  std::atomic<KeyType>* keys = this->Keys.get();
+  vtkSMPThreadLocal<UpdatedVoxelsType> updatedVoxels;
+  while (!buckets.empty())
+    {
+    std::uint64_t bucket = buckets.begin()->first;
+    std::vector<vtkIdType> voxels;
+    voxels.swap(buckets.begin()->second);
+    buckets.erase(buckets.begin());
+
+    vtkSMPTools::For(0, static_cast<vtkIdType>(voxels.size()), 256, [&](vtkIdType begin, vtkIdType end)
+      {
+      UpdatedVoxelsType& localUpdatedVoxels = updatedVoxels.Local();
+      for (vtkIdType i = begin; i < end; ++i)
+        {
+        const vtkIdType index = voxels[i];
+        const KeyType key = keys[index].load(std::memory_order_relaxed);
+        if (key == UnreachedKey || KeyBucket(key) != bucket)
+          {
+          // voxel was queued again with a shorter path
+          continue;
+          }
+        this->ForEachNeighbor(index, [&](const Neighbor& neighbor, vtkIdType neighborIndex)
+          {
+          const KeyType newKey = this->GetNeighborKey(key, intensity, index, neighbor, neighborIndex);
+          KeyType oldKey = keys[neighborIndex].load(std::memory_order_relaxed);
+          while (newKey < oldKey)
+            {
+            if (keys[neighborIndex].compare_exchange_weak(oldKey, newKey, std::memory_order_relaxed))
+              {
+              localUpdatedVoxels.emplace_back(KeyBucket(newKey), neighborIndex);
+              break;
+              }
+            }
+          });
+        }
+      });
+
+    for (UpdatedVoxelsType& localUpdatedVoxels : updatedVoxels)
+      {
+      for (const std::pair<std::uint64_t, vtkIdType>& updatedVoxel : localUpdatedVoxels)
+        {
+        buckets[updatedVoxel.first].push_back(updatedVoxel.second);
+        }
+      localUpdatedVoxels.clear();
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+template <typename IntensityType, typename SeedLabelType, typename MaskType>
+bool vtkITKGrowCutParallelState::Run(const IntensityType* intensity, const SeedLabelType* seeds, const MaskType* mask,
+  const int dimensions[3], const double spacing[3], double distancePenalty, SeedLabelType* result)
+{
+  const vtkIdType numberOfVoxels = static_cast<vtkIdType>(dimensions[0]) * dimensions[1] * dimensions[2];
+
+  // Label values, in increasing order
+  vtkSMPThreadLocal<std::set<double> > localLabelValueSets;
+  vtkSMPTools::For(0, numberOfVoxels, [&](vtkIdType begin, vtkIdType end)
+    {
+    std::set<double>& localLabelValueSet = localLabelValueSets.Local();
+    SeedLabelType lastSeedValue = 0;
+    for (vtkIdType index = begin; index < end; ++index)
+      {
+      if (seeds[index] != 0 && seeds[index] != lastSeedValue)
+        {
+        lastSeedValue = seeds[index];
+        localLabelValueSet.insert(static_cast<double>(lastSeedValue));
+        }
+      }
+    });
+  std::set<double> labelValueSet;
+  labelValueSet.insert(0.0);
+  for (std::set<double>& localLabelValueSet : localLabelValueSets)
+    {
+    labelValueSet.insert(localLabelValueSet.begin(), localLabelValueSet.end());
+    }
+
+  // Bucket width is the average step length between neighbors along x,
+  // estimated on a sample of the voxels. It also sets the distance units.
+  double sumOfSteps = 0.0;
+  vtkIdType numberOfSteps = 0;
+  const vtkIdType sampling = std::max<vtkIdType>(1, numberOfVoxels / 100000);
+  for (vtkIdType index = 0; index + 1 < numberOfVoxels; index += sampling)
+    {
+    sumOfSteps += std::fabs(static_cast<double>(intensity[index + 1]) - static_cast<double>(intensity[index]));
+    ++numberOfSteps;
+    }
+  double delta = (numberOfSteps > 0 ? sumOfSteps / numberOfSteps : 0.0) + distancePenalty * std::min({ spacing[0], spacing[1], spacing[2] });
+  if (!(delta > 1e-6))
+    {
+    delta = 1.0;
+    }
+  const double distanceUnits = (KeyType(1) << DistanceUnitsPerBucketBits) / delta;
+
+  // Previous results can be updated if only seeds changed
+  bool update = (this->Keys && this->NumberOfVoxels == numberOfVoxels
+    && std::equal(dimensions, dimensions + 3, this->Dimensions) && std::equal(spacing, spacing + 3, this->Spacing)
+    && this->DistancePenalty == distancePenalty && this->DistanceUnits == distanceUnits);
+  std::vector<vtkIdType> removedSeeds;
+  std::vector<vtkIdType> addedSeeds;
+  if (update)
+    {
+    labelValueSet.insert(this->LabelValues.begin(), this->LabelValues.end());
+    }
+  if (labelValueSet.size() > (std::size_t(1) << LabelRankBits))
+    {
+    return false;
+    }
+  std::vector<double> labelValues(labelValueSet.begin(), labelValueSet.end());
+  std::map<double, std::uint32_t> labelRanks;
+  for (std::uint32_t rank = 0; rank < labelValues.size(); ++rank)
+    {
+    labelRanks[labelValues[rank]] = rank;
+    }
+
+  std::atomic<KeyType>* keys = this->Keys.get();
+  typedef std::vector<vtkIdType> VoxelsType;
+  vtkSMPThreadLocal<VoxelsType> localRemovedSeeds;
+  vtkSMPThreadLocal<VoxelsType> localAddedSeeds;
+  if (update)
+    {
+    // Find the seed changes
+    std::atomic<bool> maskChanged(false);
+    vtkSMPTools::For(0, numberOfVoxels, [&](vtkIdType begin, vtkIdType end)
+      {
+      VoxelsType& removed = localRemovedSeeds.Local();
+      VoxelsType& added = localAddedSeeds.Local();
+      for (vtkIdType index = begin; index < end; ++index)
+        {
+        const KeyType key = keys[index].load(std::memory_order_relaxed);
+        const bool masked = (mask && mask[index] != 0);
+        if (masked != (key == MaskedKey))
+          {
+          maskChanged = true;
+          return;
+          }
+        if (masked)
+          {
+          continue;
+          }
+        const bool wasSeed = IsSeedKey(key);
+        if (seeds[index] != 0)
+          {
+          if (!wasSeed || this->LabelValues[KeyLabelRank(key)] != static_cast<double>(seeds[index]))
+            {
+            if (wasSeed)
+              {
+              removed.push_back(index);
+              }
+            added.push_back(index);
+            }
+          }
+        else if (wasSeed)
+          {
+          removed.push_back(index);
+          }
+        }
+      });
+    update = !maskChanged;
+    }
+  if (update && labelValues != this->LabelValues)
+    {
+    // Label ranks changed, because labels were added
+    std::vector<std::uint32_t> newLabelRanks;
+    for (double labelValue : this->LabelValues)
+      {
+      newLabelRanks.push_back(labelRanks[labelValue]);
+      }
+    vtkSMPTools::For(0, numberOfVoxels, [&](vtkIdType begin, vtkIdType end)
+      {
+      for (vtkIdType index = begin; index < end; ++index)
+        {
+        const KeyType key = keys[index].load(std::memory_order_relaxed);
+        if (key != UnreachedKey && key != MaskedKey)
+          {
+          keys[index].store(PackKey(KeyDistance(key), newLabelRanks[KeyLabelRank(key)]), std::memory_order_relaxed);
+          }
+        }
+      });
+    }
+  if (!update)
+    {
+    this->Keys.reset(new std::atomic<KeyType>[numberOfVoxels]);
+    keys = this->Keys.get();
+    this->NumberOfVoxels = numberOfVoxels;
+    std::copy(dimensions, dimensions + 3, this->Dimensions);
+    std::copy(spacing, spacing + 3, this->Spacing);
+    this->DistancePenalty = distancePenalty;
+    this->DistanceUnits = distanceUnits;
+    this->InitializeNeighbors();
+    for (VoxelsType& added : localAddedSeeds)
+      {
+      added.clear();
+      }
+    for (VoxelsType& removed : localRemovedSeeds)
+      {
+      removed.clear();
+      }
+    vtkSMPTools::For(0, numberOfVoxels, [&](vtkIdType begin, vtkIdType end)
+      {
+      VoxelsType& added = localAddedSeeds.Local();
+      for (vtkIdType index = begin; index < end; ++index)
+        {
+        if (mask && mask[index] != 0)
+          {
+          keys[index].store(MaskedKey, std::memory_order_relaxed);
+          }
+        else if (seeds[index] != 0)
+          {
+          keys[index].store(UnreachedKey, std::memory_order_relaxed);
+          added.push_back(index);
+          }
+        else
+          {
+          keys[index].store(UnreachedKey, std::memory_order_relaxed);
+          }
+        }
+      });
+    }
+  this->LabelValues = labelValues;
+  for (VoxelsType& removed : localRemovedSeeds)
+    {
+    removedSeeds.insert(removedSeeds.end(), removed.begin(), removed.end());
+    }
+  for (VoxelsType& added : localAddedSeeds)
+    {
+    addedSeeds.insert(addedSeeds.end(), added.begin(), added.end());
+    }
+
+  BucketsType buckets;
+  this->ResetRemovedSeedRegions(intensity, removedSeeds, buckets);
+  for (vtkIdType index : addedSeeds)
+    {
+    keys[index].store(PackKey(0, labelRanks[static_cast<double>(seeds[index])]), std::memory_order_relaxed);
+    buckets[0].push_back(index);
+    }
+  this->Propagate(intensity, buckets);
+
+  vtkSMPTools::For(0, numberOfVoxels, [&](vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType index = begin; index < end; ++index)
+      {
+      const KeyType key = keys[index].load(std::memory_order_relaxed);
+      result[index] = (key == UnreachedKey ? 0 : static_cast<SeedLabelType>(this->LabelValues[KeyLabelRank(key)]));
+      }
+    });
+  return true;
+}
+
 //----------------------------------------------------------------------------
 class vtkITKGrowCut::vtkInternal
 {
@@ -52,10 +561,12 @@ public:
   virtual ~vtkInternal() = default;
 
   itk::ProcessObject::Pointer FGCFilterProcess{ nullptr };
+  vtkITKGrowCutParallelState ParallelState;
 
   void Reset()
   {
     this->FGCFilterProcess = nullptr;
+    this->ParallelState.Reset();
   }
 
   vtkITKGrowCut* External{ nullptr };
@@ -100,6 +611,24 @@ template <typename IntensityType, typename SeedLabelType, typename MaskType>
 void vtkITKGrowCut::vtkInternal::RunGrowCut(vtkImageData* intensityVolume, vtkImageData* seedLabelVolume,
   vtkImageData* maskLabelVolume, vtkImageData* resultLabelVolume)
 {
+  if (this->External->GetParallelComputation())
+    {
+    resultLabelVolume->CopyStructure(seedLabelVolume);
+    resultLabelVolume->AllocateScalars(seedLabelVolume->GetScalarType(), 1);
+    int dimensions[3] = { 0, 0, 0 };
+    seedLabelVolume->GetDimensions(dimensions);
+    if (this->ParallelState.Run<IntensityType, SeedLabelType, MaskType>(
+      static_cast<IntensityType*>(intensityVolume->GetScalarPointer()),
+      static_cast<SeedLabelType*>(seedLabelVolume->GetScalarPointer()),
+      maskLabelVolume ? static_cast<MaskType*>(maskLabelVolume->GetScalarPointer()) : nullptr,
+      dimensions, intensityVolume->GetSpacing(), this->External->GetDistancePenalty(),
+      static_cast<SeedLabelType*>(resultLabelVolume->GetScalarPointer())))
+      {
+      return;
+      }
+    vtkWarningWithObjectMacro(this->External, "vtkITKGrowCut: too many labels for parallel computation, using sequential computation.");
+    }
+
   typedef itk::Image<IntensityType, 3> IntensityImageType;
   typedef itk::Image<SeedLabelType, 3> SeedLabelImageType;
   typedef itk::Image<MaskType, 3> MaskImageType;
@@ -170,6 +699,8 @@ vtkITKGrowCut::~vtkITKGrowCut()
 void vtkITKGrowCut::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+  os << indent << "DistancePenalty: " << this->DistancePenalty << "\n";
+  os << indent << "ParallelComputation: " << (this->ParallelComputation ? "true" : "false") << "\n";
 }
 
 //-----------------------------------------------------------------------------
@@ -210,11 +741,20 @@ void vtkITKGrowCut::ExecuteDataWithInformation(
     }
 
   vtkDataArray* seedScalars = seedLabelVolume ? seedLabelVolume->GetPointData()->GetScalars() : nullptr;
-  if (!intensityVolume)
+  if (!seedScalars)
     {
     vtkErrorMacro("Invalid seed image data");
     return;
     }
+  int seedLabelVolumeDimensions[3] = { 0, 0, 0 };
+  seedLabelVolume->GetDimensions(seedLabelVolumeDimensions);
+  if (this->ParallelComputation
+    && (!std::equal(intensityVolumeDimensions, intensityVolumeDimensions + 3, seedLabelVolumeDimensions)
+    || intensityScalars->GetNumberOfComponents() != 1 || seedScalars->GetNumberOfComponents() != 1))
+    {
+    vtkErrorMacro("vtkITKGrowCut: intensity and seed volumes must have the same dimensions and a single component.");
+    return;
+    }
 
   vtkInternal::FastGrowCutWorker worker;
   if (maskLabelVolume)
@@ -225,6 +765,13 @@ void vtkITKGrowCut::ExecuteDataWithInformation(
       vtkErrorMacro("Invalid mask image data");
       return;
       }
+    int maskLabelVolumeDimensions[3] = { 0, 0, 0 };
+    maskLabelVolume->GetDimensions(maskLabelVolumeDimensions);
+    if (this->ParallelComputation && !std::equal(intensityVolumeDimensions, intensityVolumeDimensions + 3, maskLabelVolumeDimensions))
+      {
+      vtkErrorMacro("vtkITKGrowCut: intensity and mask volumes must have the same dimensions.");
+      return;
+      }
 
     vtkArrayDispatch::Dispatch3::Execute(intensityScalars, seedScalars, maskScalars, worker,
       intensityVolume, seedLabelVolume, maskLabelVolume, resultLabelVolume,
@@ -258,3 +805,16 @@ void vtkITKGrowCut::SetDistancePenalty(double distancePenalty)
     this->Modified();
     }
 }
+
+//-----------------------------------------------------------------------------
+void vtkITKGrowCut::SetParallelComputation(bool parallelComputation)
+{
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting ParallelComputation to " << parallelComputation);
+  if (this->ParallelComputation != parallelComputation)
+    {
+    this->ParallelComputation = parallelComputation;
+    // results of the previous computation cannot be reused by the other method
+    this->Reset();
+    this->Modified();
+    }
+}
@@ -63,6 +63,19 @@ class VTK_ITK_EXPORT vtkITKGrowCut : public vtkImageAlgorithm
   vtkGetMacro(DistancePenalty, double);
   void SetDistancePenalty(double distancePenalty);
 
+  /// Compute the result with a parallel algorithm (multiple threads grow the
+  /// regions by increasing path length, see vtkSMPTools) instead of the
+  /// sequential FastGrowCut filter. Recommended for large volumes.
+  /// Results are the same for any number of threads. Where paths from seeds
+  /// of different labels have the same length, the smallest label is used.
+  /// When only the seeds change after a computation, the previous result is
+  /// updated locally around the added and removed seeds (Reset() is not needed
+  /// when seeds are removed).
+  /// By default = false.
+  vtkGetMacro(ParallelComputation, bool);
+  void SetParallelComputation(bool parallelComputation);
+  vtkBooleanMacro(ParallelComputation, bool);
+
 protected:
   vtkITKGrowCut();
   ~vtkITKGrowCut() override;
@@ -71,6 +84,7 @@ protected:
   void ExecuteDataWithInformation(vtkDataObject* outData, vtkInformation* outInfo) override;
 
   double DistancePenalty{ 0.0 };
+  bool ParallelComputation{ false };
 
 private:
   vtkITKGrowCut(const vtkITKGrowCut&) = delete;
@@ -20,6 +20,7 @@
 
 /// vtkITK includes
 #include "vtkITKImageMargin.h"
+#include "vtkITKUtility.h"
 
 /// VTK includes
 #include <vtkAlgorithm.h>
@@ -34,8 +35,21 @@
 #include <itkCommand.h>
 #include <itkSignedMaurerDistanceMapImageFilter.h>
 
+/// STD includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 vtkStandardNewMacro(vtkITKImageMargin);
 
+namespace
+{
+/// Margins that are at most this number of voxels along all axes are computed
+/// by a morphological dilation instead of a distance map.
+const int MaximumDilationRadius = 3;
+}
+
 //----------------------------------------------------------------------------
 vtkITKImageMargin::vtkITKImageMargin()
   : InnerMarginMM(vtkMath::NegInf())
@@ -93,6 +107,142 @@ sdfMargin(itk::SmartPointer<ImageType> labelImage, int backgroundValue, double i
   return sdfTh->GetOutput();
 }
 
+//----------------------------------------------------------------------------
+// Compute the margin of the foreground in the distance map of an image buffer
+template <class T>
+void vtkITKImageMarginDistanceMapExecute(vtkITKImageMargin *self, T* inPtr, T* outPtr, const int dims[3],
+  const double spacing[3], double innerMarginDistance, double outerMarginDistance)
+{
+  // Wrap scalars into an ITK image
+  // - mostly rely on defaults for spacing, origin etc for this filter
+  typedef itk::Image<T, 3> ImageType;
+  typename ImageType::Pointer inImage = ImageType::New();
+  typename ImageType::RegionType region;
+  typename ImageType::IndexType index;
+  typename ImageType::SizeType size;
+
+  inImage->GetPixelContainer()->SetImportPointer(inPtr, dims[0] * dims[1] * dims[2], false);
+  index[0] = index[1] = index[2] = 0;
+  region.SetIndex(index);
+  size[0] = dims[0]; size[1] = dims[1]; size[2] = dims[2];
+  region.SetSize(size);
+  inImage->SetLargestPossibleRegion(region);
+  inImage->SetBufferedRegion(region);
+  inImage->SetSpacing(spacing);
+
+  itk::SmartPointer<ImageType> outputImage;
+  outputImage = sdfMargin<ImageType>(inImage, self->GetBackgroundValue(), innerMarginDistance, outerMarginDistance);
+
+  // Copy to the output
+  memcpy(outPtr, outputImage->GetBufferPointer(), outputImage->GetBufferedRegion().GetNumberOfPixels() * sizeof(T));
+}
+
+//----------------------------------------------------------------------------
+// Compute an outer margin by dilation of the foreground with an ellipsoid.
+// A voxel is in the margin if a foreground voxel of one of the rows around it
+// is closer along the row than the half width of the ellipsoid at that row.
+template <class T>
+void vtkITKImageMarginDilationExecute(vtkITKImageMargin *self, const T* inPtr, T* outPtr, const int dims[3],
+  const double spacing[3], double outerMarginDistance)
+{
+  const T backgroundValue = static_cast<T>(self->GetBackgroundValue());
+  const vtkIdType dimX = dims[0];
+  const vtkIdType dimY = dims[1];
+  const vtkIdType dimZ = dims[2];
+  // same threshold as the distance map
+  outerMarginDistance += std::numeric_limits<double>::epsilon();
+  const double squaredMargin = outerMarginDistance * outerMarginDistance;
+
+  // Half width of the ellipsoid (in voxels along x) at the row offsets
+  struct RowOffset
+  {
+    int Y;
+    int Z;
+    int HalfWidth;
+  };
+  std::vector<RowOffset> rowOffsets;
+  const int radiusY = static_cast<int>(outerMarginDistance / spacing[1]);
+  const int radiusZ = static_cast<int>(outerMarginDistance / spacing[2]);
+  for (int z = -radiusZ; z <= radiusZ; ++z)
+    {
+    for (int y = -radiusY; y <= radiusY; ++y)
+      {
+      const double remaining = squaredMargin - (y * spacing[1]) * (y * spacing[1]) - (z * spacing[2]) * (z * spacing[2]);
+      if (remaining < 0.0)
+        {
+        continue;
+        }
+      RowOffset rowOffset;
+      rowOffset.Y = y;
+      rowOffset.Z = z;
+      rowOffset.HalfWidth = static_cast<int>(std::sqrt(remaining) / spacing[0]);
+      while ((rowOffset.HalfWidth + 1) * spacing[0] * (rowOffset.HalfWidth + 1) * spacing[0] <= remaining)
+        {
+        ++rowOffset.HalfWidth;
+        }
+      while (rowOffset.HalfWidth > 0 && rowOffset.HalfWidth * spacing[0] * rowOffset.HalfWidth * spacing[0] > remaining)
+        {
+        --rowOffset.HalfWidth;
+        }
+      rowOffsets.push_back(rowOffset);
+      }
+    }
+
+  // Distance (in voxels along x, at most MaximumDilationRadius+1) to the closest foreground voxel of the row
+  const unsigned char farDistance = static_cast<unsigned char>(MaximumDilationRadius + 1);
+  std::vector<unsigned char> rowDistances(dimX * dimY * dimZ);
+  vtkSMPTools::For(0, dimY * dimZ, [&](vtkIdType rowBegin, vtkIdType rowEnd)
+    {
+    for (vtkIdType row = rowBegin; row < rowEnd; ++row)
+      {
+      const T* in = inPtr + row * dimX;
+      unsigned char* distances = rowDistances.data() + row * dimX;
+      unsigned char distance = farDistance;
+      for (vtkIdType x = 0; x < dimX; ++x)
+        {
+        distance = (in[x] != backgroundValue ? 0 : std::min<unsigned char>(distance + 1, farDistance));
+        distances[x] = distance;
+        }
+      distance = farDistance;
+      for (vtkIdType x = dimX - 1; x >= 0; --x)
+        {
+        distance = (distances[x] == 0 ? 0 : std::min<unsigned char>(distance + 1, farDistance));
+        distances[x] = std::min(distances[x], distance);
+        }
+      }
+    });
+
+  const T insideValue = std::numeric_limits<T>::max();
+  vtkSMPTools::For(0, dimZ, [&](vtkIdType zBegin, vtkIdType zEnd)
+    {
+    for (vtkIdType z = zBegin; z < zEnd; ++z)
+      {
+      for (vtkIdType y = 0; y < dimY; ++y)
+        {
+        T* out = outPtr + (z * dimY + y) * dimX;
+        std::fill(out, out + dimX, static_cast<T>(0));
+        for (const RowOffset& rowOffset : rowOffsets)
+          {
+          const vtkIdType neighborY = y + rowOffset.Y;
+          const vtkIdType neighborZ = z + rowOffset.Z;
+          if (neighborY < 0 || neighborY >= dimY || neighborZ < 0 || neighborZ >= dimZ)
+            {
+            continue;
+            }
+          const unsigned char* distances = rowDistances.data() + (neighborZ * dimY + neighborY) * dimX;
+          for (vtkIdType x = 0; x < dimX; ++x)
+            {
+            if (distances[x] <= rowOffset.HalfWidth)
+              {
+              out[x] = insideValue;
+              }
+            }
+          }
+        }
+      }
+    });
+}
+
 //----------------------------------------------------------------------------
 template <class T>
 void vtkITKImageMarginExecute(vtkITKImageMargin *self, vtkImageData* input,
@@ -103,39 +253,98 @@ void vtkITKImageMarginExecute(vtkITKImageMargin *self, vtkImageData* input,
     {
     int dims[3];
     input->GetDimensions(dims);
-    double spacing[3];
-    input->GetSpacing(spacing);
-
-    // Wrap scalars into an ITK image
-    // - mostly rely on defaults for spacing, origin etc for this filter
-    typedef itk::Image<T, 3> ImageType;
-    typename ImageType::Pointer inImage = ImageType::New();
-    typename ImageType::RegionType region;
-    typename ImageType::IndexType index;
-    typename ImageType::SizeType size;
-
-    inImage->GetPixelContainer()->SetImportPointer(inPtr, dims[0] * dims[1] * dims[2], false);
-    index[0] = index[1] = index[2] = 0;
-    region.SetIndex(index);
-    size[0] = dims[0]; size[1] = dims[1]; size[2] = dims[2];
-    region.SetSize(size);
-    inImage->SetLargestPossibleRegion(region);
-    inImage->SetBufferedRegion(region);
+    double spacing[3] = { 1.0, 1.0, 1.0 };
+    const vtkIdType numberOfVoxels = static_cast<vtkIdType>(dims[0]) * dims[1] * dims[2];
 
     double innerMarginDistance = self->GetInnerMarginVoxels();
     double outerMarginDistance = self->GetOuterMarginVoxels();
     if (self->GetCalculateMarginInMM())
       {
-      inImage->SetSpacing(spacing);
+      input->GetSpacing(spacing);
       innerMarginDistance = self->GetInnerMarginMM();
       outerMarginDistance = self->GetOuterMarginMM();
       }
 
-    itk::SmartPointer<ImageType> outputImage;
-    outputImage = sdfMargin<ImageType>(inImage, self->GetBackgroundValue(), innerMarginDistance, outerMarginDistance);
+    // Only the foreground and the voxels that may be in its outer margin are
+    // processed. One more voxel is kept around them, so that the distances
+    // inside the foreground are the same as in the full image.
+    int extent[6] = { 0, -1, 0, -1, 0, -1 };
+    if (!vtkITKCalculateEffectiveExtent(inPtr, dims, static_cast<T>(self->GetBackgroundValue()), extent))
+      {
+      // no foreground, no margin
+      std::fill(outPtr, outPtr + numberOfVoxels, static_cast<T>(0));
+      return;
+      }
+    int extentDims[3] = { 0, 0, 0 };
+    bool fullExtent = true;
+    for (int i = 0; i < 3; ++i)
+      {
+      const int padding = static_cast<int>(std::ceil(std::max(outerMarginDistance, 0.0) / spacing[i])) + 1;
+      extent[2 * i] = std::max(extent[2 * i] - padding, 0);
+      extent[2 * i + 1] = std::min(extent[2 * i + 1] + padding, dims[i] - 1);
+      extentDims[i] = extent[2 * i + 1] - extent[2 * i] + 1;
+      fullExtent = fullExtent && (extentDims[i] == dims[i]);
+      }
 
-    // Copy to the output
-    memcpy(outPtr, outputImage->GetBufferPointer(), outputImage->GetBufferedRegion().GetNumberOfPixels() * sizeof(T));
+    bool dilation = (innerMarginDistance == vtkMath::NegInf() && outerMarginDistance >= 0.0);
+    for (int i = 0; i < 3; ++i)
+      {
+      dilation = dilation && (outerMarginDistance / spacing[i] <= MaximumDilationRadius);
+      }
+
+    T* extentInPtr = inPtr;
+    T* extentOutPtr = outPtr;
+    std::vector<T> extentIn;
+    std::vector<T> extentOut;
+    auto extentRowOffset = [&](vtkIdType y, vtkIdType z)
+      {
+      return ((extent[4] + z) * dims[1] + extent[2] + y) * dims[0] + extent[0];
+      };
+    if (!fullExtent)
+      {
+      extentIn.resize(static_cast<size_t>(extentDims[0]) * extentDims[1] * extentDims[2]);
+      extentOut.resize(extentIn.size());
+      extentInPtr = extentIn.data();
+      extentOutPtr = extentOut.data();
+      vtkSMPTools::For(0, extentDims[2], [&](vtkIdType zBegin, vtkIdType zEnd)
+        {
+        for (vtkIdType z = zBegin; z < zEnd; ++z)
+          {
+          for (vtkIdType y = 0; y < extentDims[1]; ++y)
+            {
+            const T* in = inPtr + extentRowOffset(y, z);
+            std::copy(in, in + extentDims[0], extentInPtr + (z * extentDims[1] + y) * extentDims[0]);
+            }
+          }
+        });
+      }
+
+    if (dilation)
+      {
+      vtkITKImageMarginDilationExecute(self, extentInPtr, extentOutPtr, extentDims, spacing, outerMarginDistance);
+      }
+    else
+      {
+      vtkITKImageMarginDistanceMapExecute(self, extentInPtr, extentOutPtr, extentDims, spacing,
+        innerMarginDistance, outerMarginDistance);
+      }
+
+    if (!fullExtent)
+      {
+      // voxels outside the extent are farther than the outer margin
+      std::fill(outPtr, outPtr + numberOfVoxels, static_cast<T>(0));
+      vtkSMPTools::For(0, extentDims[2], [&](vtkIdType zBegin, vtkIdType zEnd)
+        {
+        for (vtkIdType z = zBegin; z < zEnd; ++z)
+          {
+          for (vtkIdType y = 0; y < extentDims[1]; ++y)
+            {
+            const T* out = extentOutPtr + (z * extentDims[1] + y) * extentDims[0];
+            std::copy(out, out + extentDims[0], outPtr + extentRowOffset(y, z));
+            }
+          }
+        });
+      }
     }
   catch (itk::ExceptionObject & err)
     {
@@ -25,6 +25,9 @@
 #include "vtkSimpleImageToImageFilter.h"
 
 /// \brief ITK-based utilities for manipulating connected regions in label maps.
+/// Only the bounding box of the foreground, extended by the outer margin, is
+/// processed. Outer margins of up to 3 voxels (without inner margin) are
+/// computed by dilation, larger margins using a signed distance map.
 /// Limitation: The filter does not work correctly with input volume that has
 /// unsigned long scalar type on Linux and macOS.
 ///
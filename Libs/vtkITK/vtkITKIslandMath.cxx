@@ -8,18 +8,28 @@
 ==========================================================================*/
 
 #include "vtkITKIslandMath.h"
+#include "vtkITKUtility.h"
 #include "vtkObjectFactory.h"
 
 #include "vtkDataArray.h"
 #include "vtkPointData.h"
 #include "vtkImageData.h"
 #include "vtkAlgorithm.h"
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
 #include <vtkVersion.h>
 
 #include "itkConnectedComponentImageFilter.h"
 #include "itkRelabelComponentImageFilter.h"
 #include "itkCommand.h"
 
+// STD includes
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
+
 vtkStandardNewMacro(vtkITKIslandMath);
 
 vtkITKIslandMath::vtkITKIslandMath()
@@ -30,7 +40,8 @@ vtkITKIslandMath::vtkITKIslandMath()
   this->MaximumSize = VTK_ID_MAX;
   this->NumberOfIslands = 0;
   this->OriginalNumberOfIslands = 0;
-
+  this->ParallelComputation = 0;
+  this->RestrictToEffectiveExtent = 0;
 }
 
 vtkITKIslandMath::~vtkITKIslandMath() = default;
@@ -45,6 +56,8 @@ void vtkITKIslandMath::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "MaximumSize: " << MaximumSize << std::endl;
   os << indent << "NumberOfIslands: " << NumberOfIslands << std::endl;
   os << indent << "OriginalNumberOfIslands: " << OriginalNumberOfIslands << std::endl;
+  os << indent << "ParallelComputation: " << ParallelComputation << std::endl;
+  os << indent << "RestrictToEffectiveExtent: " << RestrictToEffectiveExtent << std::endl;
 }
 
 // Note: local function not method - conforms to signature in itkCommand.h
@@ -60,17 +73,299 @@ void vtkITKIslandMathHandleProgressEvent (itk::Object *caller,
     }
 };
 
+//----------------------------------------------------------------------------
+// Multithreaded connected component labeling.
+//
+// The nonzero voxels of each row are grouped into runs. Runs of neighbor rows
+// that touch are merged with a union-find, in parallel within slabs of
+// slices and then across the slab boundaries. The root of each island is its
+// first run in memory order, so that islands of the same size are labeled
+// in the same order as by the ITK filters (by their first voxel).
+class vtkITKIslandMathParallelLabeling
+{
+public:
+  struct RunType
+  {
+    int Begin; // first x index
+    int End; // last x index + 1
+  };
+
+  template <class T>
+  void Execute(vtkITKIslandMath* self, const T* inPtr, T* outPtr, const int dims[3], const int extent[6]);
+
+protected:
+  vtkIdType Find(vtkIdType run) const
+  {
+    while (this->Parents[run] != run)
+      {
+      run = this->Parents[run];
+      }
+    return run;
+  }
+  // Roots are the runs with the smallest index
+  void Union(vtkIdType run1, vtkIdType run2)
+  {
+    run1 = this->FindAndCompress(run1);
+    run2 = this->FindAndCompress(run2);
+    if (run1 < run2)
+      {
+      this->Parents[run2] = run1;
+      }
+    else if (run2 < run1)
+      {
+      this->Parents[run1] = run2;
+      }
+  }
+  vtkIdType FindAndCompress(vtkIdType run)
+  {
+    while (this->Parents[run] != run)
+      {
+      // path halving
+      this->Parents[run] = this->Parents[this->Parents[run]];
+      run = this->Parents[run];
+      }
+    return run;
+  }
+
+  // Merge the runs of a row with the runs of the neighbor rows that come before
+  // it in memory order, in the same slice and/or in the previous slice.
+  void MergeRow(vtkIdType y, vtkIdType z, bool fullyConnected, bool sameSlice, bool previousSlice);
+  void MergeRows(vtkIdType row, vtkIdType previousRow, int xDistance);
+
+  vtkIdType RowIndex(vtkIdType y, vtkIdType z) const
+  {
+    return z * this->Dimensions[1] + y;
+  }
+
+  int Dimensions[3] = { 0, 0, 0 }; // of the processed extent
+  std::vector<vtkIdType> RowRunOffsets; // index of the first run of each row, and total number of runs
+  std::vector<RunType> Runs;
+  std::vector<vtkIdType> Parents;
+};
+
+//----------------------------------------------------------------------------
+void vtkITKIslandMathParallelLabeling::MergeRows(vtkIdType row, vtkIdType previousRow, int xDistance)
+{
+  vtkIdType run = this->RowRunOffsets[row];
+  const vtkIdType runEnd = this->RowRunOffsets[row + 1];
+  vtkIdType previousRun = this->RowRunOffsets[previousRow];
+  const vtkIdType previousRunEnd = this->RowRunOffsets[previousRow + 1];
+  while (run < runEnd && previousRun < previousRunEnd)
+    {
+    // runs touch if they overlap, or if they are xDistance apart
+    const RunType& current = this->Runs[run];
+    const RunType& previous = this->Runs[previousRun];
+    if (current.Begin < previous.End + xDistance && previous.Begin < current.End + xDistance)
+      {
+      this->Union(run, previousRun);
+      }
+    if (current.End < previous.End)
+      {
+      ++run;
+      }
+    else
+      {
+      ++previousRun;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkITKIslandMathParallelLabeling::MergeRow(vtkIdType y, vtkIdType z, bool fullyConnected,
+  bool sameSlice, bool previousSlice)
+{
+  const vtkIdType row = this->RowIndex(y, z);
+  // for fully connected islands, diagonal neighbors touch too
+  const vtkIdType maximumDy = (fullyConnected ? 1 : 0);
+  const int xDistance = (fullyConnected ? 1 : 0);
+  if (sameSlice && y > 0)
+    {
+    this->MergeRows(row, this->RowIndex(y - 1, z), xDistance);
+    }
+  if (previousSlice && z > 0)
+    {
+    for (vtkIdType dy = -maximumDy; dy <= maximumDy; ++dy)
+      {
+      if (y + dy >= 0 && y + dy < this->Dimensions[1])
+        {
+        this->MergeRows(row, this->RowIndex(y + dy, z - 1), xDistance);
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
 template <class T>
-void vtkITKIslandMathExecute(vtkITKIslandMath *self, vtkImageData* input,
-                vtkImageData* vtkNotUsed(output),
-                T* inPtr, T* outPtr)
+void vtkITKIslandMathParallelLabeling::Execute(vtkITKIslandMath* self, const T* inPtr, T* outPtr,
+  const int dims[3], const int extent[6])
 {
+  const vtkIdType inDimX = dims[0];
+  const vtkIdType inDimY = dims[1];
+  for (int i = 0; i < 3; ++i)
+    {
+    this->Dimensions[i] = extent[2 * i + 1] - extent[2 * i] + 1;
+    }
+  const vtkIdType numberOfRows = static_cast<vtkIdType>(this->Dimensions[1]) * this->Dimensions[2];
+  auto inputRow = [&](vtkIdType row) -> vtkIdType
+  {
+    const vtkIdType y = extent[2] + row % this->Dimensions[1];
+    const vtkIdType z = extent[4] + row / this->Dimensions[1];
+    return (z * inDimY + y) * inDimX + extent[0];
+  };
+
+  // Runs of each row
+  this->RowRunOffsets.assign(numberOfRows + 1, 0);
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType rowBegin, vtkIdType rowEnd)
+    {
+    for (vtkIdType row = rowBegin; row < rowEnd; ++row)
+      {
+      const T* in = inPtr + inputRow(row);
+      vtkIdType numberOfRuns = 0;
+      for (int x = 0; x < this->Dimensions[0]; ++x)
+        {
+        if (in[x] != 0 && (x == 0 || in[x - 1] == 0))
+          {
+          ++numberOfRuns;
+          }
+        }
+      this->RowRunOffsets[row + 1] = numberOfRuns;
+      }
+    });
+  for (vtkIdType row = 0; row < numberOfRows; ++row)
+    {
+    this->RowRunOffsets[row + 1] += this->RowRunOffsets[row];
+    }
+  const vtkIdType numberOfRuns = this->RowRunOffsets[numberOfRows];
+  this->Runs.resize(numberOfRuns);
+  this->Parents.resize(numberOfRuns);
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType rowBegin, vtkIdType rowEnd)
+    {
+    for (vtkIdType row = rowBegin; row < rowEnd; ++row)
+      {
+      const T* in = inPtr + inputRow(row);
+      vtkIdType run = this->RowRunOffsets[row];
+      for (int x = 0; x < this->Dimensions[0]; ++x)
+        {
+        if (in[x] == 0)
+          {
+          continue;
+          }
+        this->Runs[run].Begin = x;
+        while (x < this->Dimensions[0] && in[x] != 0)
+          {
+          ++x;
+          }
+        this->Runs[run].End = x;
+        this->Parents[run] = run;
+        ++run;
+        }
+      }
+    });
+
+  // Merge touching runs within slabs in parallel, then across slab boundaries
+  const bool fullyConnected = (self->GetFullyConnected() != 0);
+  const vtkIdType dimY = this->Dimensions[1];
+  const vtkIdType dimZ = this->Dimensions[2];
+  const vtkIdType numberOfSlabs = std::min<vtkIdType>(dimZ, 4 * vtkSMPTools::GetEstimatedNumberOfThreads());
+  auto slabBegin = [&](vtkIdType slab) { return slab * dimZ / numberOfSlabs; };
+  vtkSMPTools::For(0, numberOfSlabs, 1, [&](vtkIdType first, vtkIdType last)
+    {
+    for (vtkIdType slab = first; slab < last; ++slab)
+      {
+      const vtkIdType zBegin = slabBegin(slab);
+      for (vtkIdType z = zBegin; z < slabBegin(slab + 1); ++z)
+        {
+        for (vtkIdType y = 0; y < dimY; ++y)
+          {
+          // the previous slice of the first slice is in another slab
+          this->MergeRow(y, z, fullyConnected, true, z != zBegin);
+          }
+        }
+      }
+    });
+  for (vtkIdType slab = 1; slab < numberOfSlabs; ++slab)
+    {
+    const vtkIdType z = slabBegin(slab);
+    for (vtkIdType y = 0; y < dimY; ++y)
+      {
+      this->MergeRow(y, z, fullyConnected, false, true);
+      }
+    }
 
-  int dims[3];
-  input->GetDimensions(dims);
-  double spacing[3];
-  input->GetSpacing(spacing);
+  // Island sizes, computed while the runs are resolved to their root
+  std::vector<vtkIdType> roots(numberOfRuns);
+  std::unique_ptr<std::atomic<vtkIdType>[]> sizes(new std::atomic<vtkIdType>[numberOfRuns]);
+  vtkSMPTools::For(0, numberOfRuns, [&](vtkIdType runBegin, vtkIdType runEnd)
+    {
+    for (vtkIdType run = runBegin; run < runEnd; ++run)
+      {
+      sizes[run].store(0, std::memory_order_relaxed);
+      }
+    });
+  vtkSMPTools::For(0, numberOfRuns, [&](vtkIdType runBegin, vtkIdType runEnd)
+    {
+    for (vtkIdType run = runBegin; run < runEnd; ++run)
+      {
+      roots[run] = this->Find(run);
+      sizes[roots[run]].fetch_add(this->Runs[run].End - this->Runs[run].Begin, std::memory_order_relaxed);
+      }
+    });
+
+  // Islands sorted by decreasing size, islands of the same size remain in memory order
+  std::vector<vtkIdType> islands;
+  for (vtkIdType run = 0; run < numberOfRuns; ++run)
+    {
+    if (roots[run] == run)
+      {
+      islands.push_back(run);
+      }
+    }
+  std::stable_sort(islands.begin(), islands.end(), [&](vtkIdType island1, vtkIdType island2)
+    {
+    return sizes[island1].load(std::memory_order_relaxed) > sizes[island2].load(std::memory_order_relaxed);
+    });
+  vtkIdType numberOfIslands = 0;
+  while (numberOfIslands < static_cast<vtkIdType>(islands.size())
+    && sizes[islands[numberOfIslands]].load(std::memory_order_relaxed) >= self->GetMinimumSize())
+    {
+    ++numberOfIslands;
+    }
+  self->SetOriginalNumberOfIslands(static_cast<unsigned long>(islands.size()));
+  self->SetNumberOfIslands(static_cast<unsigned long>(numberOfIslands));
+  if (static_cast<double>(numberOfIslands) > static_cast<double>(std::numeric_limits<T>::max()))
+    {
+    vtkErrorWithObjectMacro(self, "vtkITKIslandMath: number of islands (" << numberOfIslands
+      << ") exceeds the maximum value of the image scalar type.");
+    numberOfIslands = 0;
+    self->SetNumberOfIslands(0);
+    }
+  // island labels are stored in place of the sizes of the roots
+  for (vtkIdType island = 0; island < static_cast<vtkIdType>(islands.size()); ++island)
+    {
+    sizes[islands[island]].store(island < numberOfIslands ? island + 1 : 0, std::memory_order_relaxed);
+    }
 
+  // Output
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType rowBegin, vtkIdType rowEnd)
+    {
+    for (vtkIdType row = rowBegin; row < rowEnd; ++row)
+      {
+      T* out = outPtr + inputRow(row);
+      std::fill(out, out + this->Dimensions[0], static_cast<T>(0));
+      for (vtkIdType run = this->RowRunOffsets[row]; run < this->RowRunOffsets[row + 1]; ++run)
+        {
+        const T label = static_cast<T>(sizes[roots[run]].load(std::memory_order_relaxed));
+        std::fill(out + this->Runs[run].Begin, out + this->Runs[run].End, label);
+        }
+      }
+    });
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkITKIslandMathITKExecute(vtkITKIslandMath *self, T* inPtr, T* outPtr,
+                                const int dims[3], const double spacing[3])
+{
   // Wrap scalars into an ITK image
   // - mostly rely on defaults for spacing, origin etc for this filter
   typedef itk::Image<T, 3> ImageType;
@@ -119,6 +414,76 @@ void vtkITKIslandMathExecute(vtkITKIslandMath *self, vtkImageData* input,
 
 }
 
+//----------------------------------------------------------------------------
+template <class T>
+void vtkITKIslandMathExecute(vtkITKIslandMath *self, vtkImageData* input,
+                vtkImageData* vtkNotUsed(output),
+                T* inPtr, T* outPtr)
+{
+
+  int dims[3];
+  input->GetDimensions(dims);
+  double spacing[3];
+  input->GetSpacing(spacing);
+  const vtkIdType numberOfVoxels = static_cast<vtkIdType>(dims[0]) * dims[1] * dims[2];
+
+  int extent[6] = { 0, dims[0] - 1, 0, dims[1] - 1, 0, dims[2] - 1 };
+  if (self->GetRestrictToEffectiveExtent())
+    {
+    if (!vtkITKCalculateEffectiveExtent(inPtr, dims, static_cast<T>(0), extent))
+      {
+      // no islands
+      std::fill(outPtr, outPtr + numberOfVoxels, static_cast<T>(0));
+      self->SetNumberOfIslands(0);
+      self->SetOriginalNumberOfIslands(0);
+      return;
+      }
+    }
+  int extentDims[3] = { extent[1] - extent[0] + 1, extent[3] - extent[2] + 1, extent[5] - extent[4] + 1 };
+  bool fullExtent = (extentDims[0] == dims[0] && extentDims[1] == dims[1] && extentDims[2] == dims[2]);
+  if (!fullExtent)
+    {
+    // voxels outside the processed extent are not written
+    std::fill(outPtr, outPtr + numberOfVoxels, static_cast<T>(0));
+    }
+
+  if (self->GetParallelComputation())
+    {
+    vtkITKIslandMathParallelLabeling labeling;
+    labeling.Execute(self, inPtr, outPtr, dims, extent);
+    return;
+    }
+
+  if (fullExtent)
+    {
+    vtkITKIslandMathITKExecute(self, inPtr, outPtr, dims, spacing);
+    return;
+    }
+
+  // Process a copy of the voxels of the extent
+  std::vector<T> extentIn(static_cast<size_t>(extentDims[0]) * extentDims[1] * extentDims[2]);
+  std::vector<T> extentOut(extentIn.size());
+  for (int z = 0; z < extentDims[2]; ++z)
+    {
+    for (int y = 0; y < extentDims[1]; ++y)
+      {
+      const vtkIdType inputOffset = (static_cast<vtkIdType>(extent[4] + z) * dims[1] + extent[2] + y) * dims[0] + extent[0];
+      std::copy(inPtr + inputOffset, inPtr + inputOffset + extentDims[0],
+        extentIn.begin() + (static_cast<vtkIdType>(z) * extentDims[1] + y) * extentDims[0]);
+      }
+    }
+  vtkITKIslandMathITKExecute(self, extentIn.data(), extentOut.data(), extentDims, spacing);
+  for (int z = 0; z < extentDims[2]; ++z)
+    {
+    for (int y = 0; y < extentDims[1]; ++y)
+      {
+      const vtkIdType outputOffset = (static_cast<vtkIdType>(extent[4] + z) * dims[1] + extent[2] + y) * dims[0] + extent[0];
+      const vtkIdType extentOffset = (static_cast<vtkIdType>(z) * extentDims[1] + y) * extentDims[0];
+      std::copy(extentOut.begin() + extentOffset, extentOut.begin() + extentOffset + extentDims[0], outPtr + outputOffset);
+      }
+    }
+}
+
 
 
 //
@@ -51,6 +51,22 @@ class VTK_ITK_EXPORT vtkITKIslandMath : public vtkSimpleImageToImageFilter
   void SetSliceBySliceToIK() {this->SetSliceBySlice(2);}
   void SetSliceBySliceToJK() {this->SetSliceBySlice(1);}
 
+  ///
+  /// If non-zero, islands are labeled by a multithreaded union-find of the
+  /// runs of nonzero voxels (see vtkSMPTools) instead of the ITK connected
+  /// component and relabel filters, with the same result.
+  /// Island sizes are computed while the runs are merged.
+  vtkGetMacro(ParallelComputation, int);
+  vtkSetMacro(ParallelComputation, int);
+  vtkBooleanMacro(ParallelComputation, int);
+
+  ///
+  /// If non-zero, only the bounding box of the nonzero voxels is processed,
+  /// which is faster for islands that fill a small part of the volume.
+  vtkGetMacro(RestrictToEffectiveExtent, int);
+  vtkSetMacro(RestrictToEffectiveExtent, int);
+  vtkBooleanMacro(RestrictToEffectiveExtent, int);
+
   ///
   /// Accessors to describe result of calculations
   vtkGetMacro(NumberOfIslands, unsigned long);
@@ -69,6 +85,8 @@ protected:
   int SliceBySlice;
   vtkIdType MinimumSize;
   vtkIdType MaximumSize;
+  int ParallelComputation;
+  int RestrictToEffectiveExtent;
 
   unsigned long NumberOfIslands;
   unsigned long OriginalNumberOfIslands;
@@ -30,12 +30,20 @@
 #include <vtkObjectFactory.h>
 #include <vtkPoints.h>
 #include <vtkPointData.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
 
 // ITK includes
 #include <itkLabelImageToShapeLabelMapFilter.h>
 #include <itkShapeLabelObject.h>
 #include <itkVTKImageToImageFilter.h>
 
+// STD includes
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
 vtkStandardNewMacro(vtkITKLabelShapeStatistics);
 
 //----------------------------------------------------------------------------
@@ -199,6 +207,172 @@ T* GetArray(vtkTable* table, std::string name, int numberOfComponents, std::vect
   return array.GetPointer();
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+using VoxelIndexType = std::array<long, 3>;
+
+//----------------------------------------------------------------------------
+/// Cross product of (b - a) and (c - a), in the x-y plane
+long Cross2D(const VoxelIndexType& a, const VoxelIndexType& b, const VoxelIndexType& c)
+{
+  return (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+}
+
+//----------------------------------------------------------------------------
+/// Replace points (all in the same slice) by the vertices of their 2D convex hull (monotone chain algorithm)
+void ConvexHull2D(std::vector<VoxelIndexType>& points)
+{
+  std::sort(points.begin(), points.end());
+  points.erase(std::unique(points.begin(), points.end()), points.end());
+  if (points.size() < 3)
+    {
+    return;
+    }
+  std::vector<VoxelIndexType> hull(2 * points.size());
+  size_t hullSize = 0;
+  for (size_t i = 0; i < points.size(); ++i)
+    {
+    while (hullSize >= 2 && Cross2D(hull[hullSize - 2], hull[hullSize - 1], points[i]) <= 0)
+      {
+      --hullSize;
+      }
+    hull[hullSize++] = points[i];
+    }
+  for (size_t i = points.size() - 1, lowerHullSize = hullSize + 1; i > 0; --i)
+    {
+    while (hullSize >= lowerHullSize && Cross2D(hull[hullSize - 2], hull[hullSize - 1], points[i - 1]) <= 0)
+      {
+      --hullSize;
+      }
+    hull[hullSize++] = points[i - 1];
+    }
+  hull.resize(hullSize - 1); // last point is the same as the first
+  points.swap(hull);
+}
+
+//----------------------------------------------------------------------------
+/// Compute Feret diameter (largest distance between voxel centers) of a label object.
+/// Same result as itk::ShapeLabelMapFilter, which compares all pairs of border voxels,
+/// but only vertices of the convex hull can be the farthest points: only the end voxels
+/// of each row are kept, reduced to the vertices of the convex hull of each slice.
+template <class TImage, class TLabelObject>
+double ComputeFeretDiameter(const TImage* image, const TLabelObject* labelObject)
+{
+  // End voxels of each row, collected from the run-length encoded lines (along the first axis)
+  struct RowExtent
+    {
+    long Z;
+    long Y;
+    long MinX;
+    long MaxX;
+    bool operator<(const RowExtent& other) const { return Z < other.Z || (Z == other.Z && Y < other.Y); }
+    };
+  std::vector<RowExtent> rows;
+  rows.reserve(labelObject->GetNumberOfLines());
+  for (typename TLabelObject::SizeValueType lineIndex = 0; lineIndex < labelObject->GetNumberOfLines(); ++lineIndex)
+    {
+    const typename TLabelObject::LineType& line = labelObject->GetLine(lineIndex);
+    const typename TLabelObject::IndexType& index = line.GetIndex();
+    const long minX = static_cast<long>(index[0]);
+    rows.push_back({ static_cast<long>(index[2]), static_cast<long>(index[1]), minX, minX + static_cast<long>(line.GetLength()) - 1 });
+    }
+  std::sort(rows.begin(), rows.end());
+
+  // Group row end voxels by slice
+  std::vector<std::vector<VoxelIndexType>> slicePoints;
+  for (size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex)
+    {
+    const RowExtent& row = rows[rowIndex];
+    if (rowIndex == 0 || row.Z != rows[rowIndex - 1].Z)
+      {
+      slicePoints.emplace_back();
+      }
+    slicePoints.back().push_back({ row.MinX, row.Y, row.Z });
+    slicePoints.back().push_back({ row.MaxX, row.Y, row.Z });
+    }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(slicePoints.size()), [&](vtkIdType sliceBegin, vtkIdType sliceEnd)
+    {
+    for (vtkIdType sliceIndex = sliceBegin; sliceIndex < sliceEnd; ++sliceIndex)
+      {
+      ConvexHull2D(slicePoints[sliceIndex]);
+      }
+    });
+
+  // Physical positions of the remaining candidate voxels, sorted by decreasing distance from their center
+  std::vector<std::array<double, 3>> points;
+  for (const std::vector<VoxelIndexType>& slice : slicePoints)
+    {
+    for (const VoxelIndexType& voxel : slice)
+      {
+      typename TImage::IndexType index;
+      index[0] = voxel[0];
+      index[1] = voxel[1];
+      index[2] = voxel[2];
+      typename TImage::PointType point;
+      image->TransformIndexToPhysicalPoint(index, point);
+      points.push_back({ point[0], point[1], point[2] });
+      }
+    }
+  if (points.size() < 2)
+    {
+    return 0.0;
+    }
+  std::array<double, 3> center = { 0.0, 0.0, 0.0 };
+  for (const std::array<double, 3>& point : points)
+    {
+    for (int i = 0; i < 3; ++i)
+      {
+      center[i] += point[i] / points.size();
+      }
+    }
+  std::vector<std::pair<double, std::array<double, 3>>> pointsByRadius;
+  pointsByRadius.reserve(points.size());
+  for (const std::array<double, 3>& point : points)
+    {
+    double radius = std::sqrt((point[0] - center[0]) * (point[0] - center[0])
+      + (point[1] - center[1]) * (point[1] - center[1])
+      + (point[2] - center[2]) * (point[2] - center[2]));
+    pointsByRadius.emplace_back(radius, point);
+    }
+  std::sort(pointsByRadius.begin(), pointsByRadius.end(),
+    [](const std::pair<double, std::array<double, 3>>& a, const std::pair<double, std::array<double, 3>>& b)
+      { return a.first > b.first; });
+
+  // Largest distance between the candidates. Distance of two points cannot be larger than
+  // the sum of their distances from the center, so most pairs are skipped.
+  vtkSMPThreadLocal<double> maximumDistanceSquared(0.0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(pointsByRadius.size()), [&](vtkIdType first, vtkIdType last)
+    {
+    double& localMaximumDistanceSquared = maximumDistanceSquared.Local();
+    for (vtkIdType i = first; i < last; ++i)
+      {
+      const std::array<double, 3>& point1 = pointsByRadius[i].second;
+      for (size_t j = i + 1; j < pointsByRadius.size(); ++j)
+        {
+        double maximumPossibleDistance = pointsByRadius[i].first + pointsByRadius[j].first;
+        if (maximumPossibleDistance * maximumPossibleDistance <= localMaximumDistanceSquared)
+          {
+          break;
+          }
+        const std::array<double, 3>& point2 = pointsByRadius[j].second;
+        double distanceSquared = (point1[0] - point2[0]) * (point1[0] - point2[0])
+          + (point1[1] - point2[1]) * (point1[1] - point2[1])
+          + (point1[2] - point2[2]) * (point1[2] - point2[2]);
+        localMaximumDistanceSquared = std::max(localMaximumDistanceSquared, distanceSquared);
+        }
+      }
+    });
+  double diameterSquared = 0.0;
+  for (double localMaximumDistanceSquared : maximumDistanceSquared)
+    {
+    diameterSquared = std::max(diameterSquared, localMaximumDistanceSquared);
+    }
+  return std::sqrt(diameterSquared);
+}
+}
+
 //----------------------------------------------------------------------------
 template <class T>
 void vtkITKLabelShapeStatisticsExecute(vtkITKLabelShapeStatistics* self, vtkImageData* input, vtkTable* output,
@@ -252,7 +426,8 @@ void vtkITKLabelShapeStatisticsExecute(vtkITKLabelShapeStatistics* self, vtkImag
   typename LableShapeFilterType::Pointer labelFilter = LableShapeFilterType::New();
   labelFilter->AddObserver(itk::ProgressEvent(), progressCommand);
   labelFilter->SetInput(inImage);
-  labelFilter->SetComputeFeretDiameter(computeFeretDiameter);
+  // Feret diameter is computed below, much faster than by comparing all pairs of border voxels
+  labelFilter->SetComputeFeretDiameter(false);
   labelFilter->SetComputePerimeter(computePerimeter);
   labelFilter->SetComputeOrientedBoundingBox(computeOrientedBoundingBox);
   labelFilter->Update();
@@ -263,6 +438,28 @@ void vtkITKLabelShapeStatisticsExecute(vtkITKLabelShapeStatistics* self, vtkImag
   // Number of rows in the table is equal to the number of label values
   output->SetNumberOfRows(labelValues.size());
 
+  // Label objects are processed in parallel
+  std::vector<double> feretDiameters;
+  if (computeFeretDiameter)
+    {
+    std::vector<const ShapeLabelObjectType*> labelObjects;
+    for (typename ShapeLabelObjectType::LabelType labelValue : labelValues)
+      {
+      labelObjects.push_back(labelmapObject->GetLabelObject(labelValue));
+      }
+    feretDiameters.resize(labelValues.size(), 0.0);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(labelObjects.size()), [&](vtkIdType first, vtkIdType last)
+      {
+      for (vtkIdType labelIndex = first; labelIndex < last; ++labelIndex)
+        {
+        if (labelObjects[labelIndex])
+          {
+          feretDiameters[labelIndex] = ComputeFeretDiameter(inImage, labelObjects[labelIndex]);
+          }
+        }
+      });
+    }
+
   int rowIndex = -1;
   for (unsigned int i = 0; i < labelValues.size(); ++i)
     {
@@ -306,7 +503,7 @@ void vtkITKLabelShapeStatisticsExecute(vtkITKLabelShapeStatistics* self, vtkImag
         }
       else if (statisticName == self->GetShapeStatisticAsString(vtkITKLabelShapeStatistics::FeretDiameter))
         {
-        double feretDiameter = shapeObject->GetFeretDiameter();
+        double feretDiameter = feretDiameters[i];
         vtkDoubleArray* array = GetArray<vtkDoubleArray>(output, statisticName, 1);
         array->InsertTuple1(rowIndex, feretDiameter);
         }
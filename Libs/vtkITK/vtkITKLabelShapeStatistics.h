@@ -45,6 +45,8 @@ class vtkPoints;
 /// For a list of available parameters, see: vtkITKLabelShapeStatistics::ShapeStatistic
 /// Calculated statistics can be changed using the SetComputeShapeStatistic/ComputeShapeStatisticOn/ComputeShapeStatisticOff methods.
 /// Output statistics are represented in a vtkTable where each column represents a statistic and each row is a different label value.
+/// Only the requested statistics are computed. Feret diameter is computed from the vertices of the
+/// convex hull of each slice of the label (instead of all pairs of border voxels), in parallel for each label.
 class VTK_ITK_EXPORT vtkITKLabelShapeStatistics : public vtkTableAlgorithm
 {
 public:
@@ -13,26 +13,81 @@
 #include "vtkDataArray.h"
 #include "vtkPointData.h"
 #include "vtkImageData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 
 #include "itkMorphologicalContourInterpolator.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <map>
+#include <tuple>
+#include <vector>
+
 vtkStandardNewMacro(vtkITKMorphologicalContourInterpolator);
 
-vtkITKMorphologicalContourInterpolator::vtkITKMorphologicalContourInterpolator() = default;
-vtkITKMorphologicalContourInterpolator::~vtkITKMorphologicalContourInterpolator() = default;
+//----------------------------------------------------------------------------
+/// Interpolation results of the parallel computation, kept between executions so that
+/// only the labels and slice intervals that are modified are interpolated again.
+class vtkITKMorphologicalContourInterpolator::vtkInternal
+{
+public:
+  typedef std::array<int, 6> ExtentType;
 
+  /// Interpolation of a label along an axis (or along all axes if -1) within an extent
+  /// of the image (in absolute voxel coordinates).
+  struct Task
+  {
+    double Label{ 0.0 };
+    int Axis{ -1 };
+    ExtentType Extent{ { 0, -1, 0, -1, 0, -1 } };
+    /// Interpolated voxels, as indices in the task extent
+    std::vector<vtkIdType> InterpolatedVoxels;
+    bool Computed{ false };
+  };
 
-template <class T>
-void vtkITKMorphologicalContourInterpolatorExecute(vtkITKMorphologicalContourInterpolator *self, vtkImageData* input,
-                vtkImageData* vtkNotUsed(output),
-                T* inPtr, T* outPtr)
+  void Reset()
+  {
+    this->PreviousInput = nullptr;
+    this->Tasks.clear();
+  }
+
+  template <class T>
+  void Execute(vtkITKMorphologicalContourInterpolator* self, vtkImageData* input, T* inPtr, T* outPtr);
+
+  /// Input of the previous execution and its interpolation tasks (sorted by label)
+  vtkSmartPointer<vtkImageData> PreviousInput;
+  std::vector<Task> Tasks;
+
+  /// Parameters of the previous execution
+  long Label{ 0 };
+  int Axis{ -1 };
+  bool HeuristicAlignment{ true };
+  bool UseDistanceTransform{ false };
+  bool UseBallStructuringElement{ false };
+};
+
+//----------------------------------------------------------------------------
+vtkITKMorphologicalContourInterpolator::vtkITKMorphologicalContourInterpolator()
+  : Internal(new vtkInternal)
 {
+}
 
-  int dims[3];
-  input->GetDimensions(dims);
-  double spacing[3];
-  input->GetSpacing(spacing);
+//----------------------------------------------------------------------------
+vtkITKMorphologicalContourInterpolator::~vtkITKMorphologicalContourInterpolator()
+{
+  delete this->Internal;
+  this->Internal = nullptr;
+}
 
+//----------------------------------------------------------------------------
+template <class T>
+void vtkITKMorphologicalContourInterpolatorRun(vtkITKMorphologicalContourInterpolator *self,
+                const int dims[3], const double spacing[3], T label, int axis,
+                T* inPtr, T* outPtr)
+{
   // Wrap scalars into an ITK image
   // - mostly rely on defaults for spacing, origin etc for this filter
   typedef itk::Image<T, 3> ImageType;
@@ -56,8 +111,8 @@ void vtkITKMorphologicalContourInterpolatorExecute(vtkITKMorphologicalContourInt
   typedef itk::MorphologicalContourInterpolator<ImageType> ContourInterpolatorType;
   typename ContourInterpolatorType::Pointer interpolatorFilter = ContourInterpolatorType::New();
 
-  interpolatorFilter->SetLabel(static_cast<T>(self->GetLabel()));
-  interpolatorFilter->SetAxis(self->GetAxis());
+  interpolatorFilter->SetLabel(label);
+  interpolatorFilter->SetAxis(axis);
   interpolatorFilter->SetHeuristicAlignment(self->GetHeuristicAlignment());
   interpolatorFilter->SetUseDistanceTransform(self->GetUseDistanceTransform());
   interpolatorFilter->SetUseBallStructuringElement(self->GetUseBallStructuringElement());
@@ -71,7 +126,359 @@ void vtkITKMorphologicalContourInterpolatorExecute(vtkITKMorphologicalContourInt
 
 }
 
+//----------------------------------------------------------------------------
+template <class T>
+void vtkITKMorphologicalContourInterpolatorExecute(vtkITKMorphologicalContourInterpolator *self, vtkImageData* input,
+                vtkImageData* vtkNotUsed(output),
+                T* inPtr, T* outPtr)
+{
+
+  int dims[3];
+  input->GetDimensions(dims);
+  double spacing[3];
+  input->GetSpacing(spacing);
+
+  vtkITKMorphologicalContourInterpolatorRun<T>(self, dims, spacing, static_cast<T>(self->GetLabel()), self->GetAxis(), inPtr, outPtr);
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void vtkITKMorphologicalContourInterpolator::vtkInternal::Execute(
+  vtkITKMorphologicalContourInterpolator* self, vtkImageData* input, T* inPtr, T* outPtr)
+{
+  ExtentType extent;
+  input->GetExtent(extent.data());
+  int dims[3] = { 0, 0, 0 };
+  input->GetDimensions(dims);
+  double spacing[3] = { 1.0, 1.0, 1.0 };
+  input->GetSpacing(spacing);
+  const vtkIdType numberOfVoxels = static_cast<vtkIdType>(dims[0]) * dims[1] * dims[2];
+  const int axis = (self->GetAxis() >= 0 && self->GetAxis() < 3) ? self->GetAxis() : -1;
+
+  // Previous results can be reused if the parameters and the image grid did not change
+  // (the extent may change). Labels whose voxels changed are updated within the
+  // bounding box of the changed voxels.
+  bool reuse = (this->PreviousInput
+    && this->PreviousInput->GetScalarType() == input->GetScalarType()
+    && this->Label == self->GetLabel() && this->Axis == self->GetAxis()
+    && this->HeuristicAlignment == self->GetHeuristicAlignment()
+    && this->UseDistanceTransform == self->GetUseDistanceTransform()
+    && this->UseBallStructuringElement == self->GetUseBallStructuringElement());
+  for (int i = 0; reuse && i < 3; ++i)
+    {
+    reuse = (this->PreviousInput->GetSpacing()[i] == input->GetSpacing()[i]
+      && this->PreviousInput->GetOrigin()[i] == input->GetOrigin()[i]);
+    }
+  std::map<T, ExtentType> changedExtents;
+  if (reuse)
+    {
+    ExtentType previousExtent;
+    this->PreviousInput->GetExtent(previousExtent.data());
+    const T* previousPtr = static_cast<T*>(this->PreviousInput->GetScalarPointer());
+    const vtkIdType previousIncrements[3] = { 1, previousExtent[1] - previousExtent[0] + 1,
+      static_cast<vtkIdType>(previousExtent[1] - previousExtent[0] + 1) * (previousExtent[3] - previousExtent[2] + 1) };
+    const vtkIdType increments[3] = { 1, dims[0], static_cast<vtkIdType>(dims[0]) * dims[1] };
+    ExtentType unionExtent;
+    for (int i = 0; i < 3; ++i)
+      {
+      unionExtent[2 * i] = std::min(extent[2 * i], previousExtent[2 * i]);
+      unionExtent[2 * i + 1] = std::max(extent[2 * i + 1], previousExtent[2 * i + 1]);
+      }
+    vtkSMPThreadLocal<std::map<T, ExtentType> > localChangedExtents;
+    vtkSMPTools::For(unionExtent[4], unionExtent[5] + 1, [&](vtkIdType firstSlice, vtkIdType endSlice)
+      {
+      std::map<T, ExtentType>& sliceChangedExtents = localChangedExtents.Local();
+      for (int k = static_cast<int>(firstSlice); k < endSlice; ++k)
+        {
+        for (int j = unionExtent[2]; j <= unionExtent[3]; ++j)
+          {
+          for (int i = unionExtent[0]; i <= unionExtent[1]; ++i)
+            {
+            // voxels outside of an image are considered to be background
+            const int ijk[3] = { i, j, k };
+            bool inside = true;
+            bool previousInside = true;
+            for (int a = 0; a < 3; ++a)
+              {
+              inside = inside && ijk[a] >= extent[2 * a] && ijk[a] <= extent[2 * a + 1];
+              previousInside = previousInside && ijk[a] >= previousExtent[2 * a] && ijk[a] <= previousExtent[2 * a + 1];
+              }
+            const T value = inside ? inPtr[(i - extent[0]) * increments[0]
+              + (j - extent[2]) * increments[1] + (k - extent[4]) * increments[2]] : 0;
+            const T previousValue = previousInside ? previousPtr[(i - previousExtent[0]) * previousIncrements[0]
+              + (j - previousExtent[2]) * previousIncrements[1] + (k - previousExtent[4]) * previousIncrements[2]] : 0;
+            if (value == previousValue)
+              {
+              continue;
+              }
+            for (T changedLabel : { value, previousValue })
+              {
+              if (changedLabel == 0)
+                {
+                continue;
+                }
+              typename std::map<T, ExtentType>::iterator changedIt = sliceChangedExtents.find(changedLabel);
+              if (changedIt == sliceChangedExtents.end())
+                {
+                sliceChangedExtents[changedLabel] = { { i, i, j, j, k, k } };
+                continue;
+                }
+              for (int a = 0; a < 3; ++a)
+                {
+                changedIt->second[2 * a] = std::min(changedIt->second[2 * a], ijk[a]);
+                changedIt->second[2 * a + 1] = std::max(changedIt->second[2 * a + 1], ijk[a]);
+                }
+              }
+            }
+          }
+        }
+      });
+    for (std::map<T, ExtentType>& sliceChangedExtents : localChangedExtents)
+      {
+      for (const std::pair<const T, ExtentType>& changed : sliceChangedExtents)
+        {
+        typename std::map<T, ExtentType>::iterator changedIt = changedExtents.find(changed.first);
+        if (changedIt == changedExtents.end())
+          {
+          changedExtents.insert(changed);
+          continue;
+          }
+        for (int a = 0; a < 3; ++a)
+          {
+          changedIt->second[2 * a] = std::min(changedIt->second[2 * a], changed.second[2 * a]);
+          changedIt->second[2 * a + 1] = std::max(changedIt->second[2 * a + 1], changed.second[2 * a + 1]);
+          }
+        }
+      }
+    }
+
+  // Bounding box of each label in each slice along the interpolation axis (z if all axes are interpolated)
+  const int sliceAxis = (axis >= 0 ? axis : 2);
+  std::vector<std::map<T, ExtentType> > sliceLabelExtents(dims[sliceAxis]);
+  vtkSMPTools::For(0, dims[sliceAxis], [&](vtkIdType firstSlice, vtkIdType endSlice)
+    {
+    for (vtkIdType slice = firstSlice; slice < endSlice; ++slice)
+      {
+      int sliceExtent[6] = { 0, dims[0] - 1, 0, dims[1] - 1, 0, dims[2] - 1 };
+      sliceExtent[2 * sliceAxis] = sliceExtent[2 * sliceAxis + 1] = static_cast<int>(slice);
+      std::map<T, ExtentType>& labelExtents = sliceLabelExtents[slice];
+      for (int k = sliceExtent[4]; k <= sliceExtent[5]; ++k)
+        {
+        for (int j = sliceExtent[2]; j <= sliceExtent[3]; ++j)
+          {
+          const T* rowPtr = inPtr + (static_cast<vtkIdType>(k) * dims[1] + j) * dims[0];
+          for (int i = sliceExtent[0]; i <= sliceExtent[1]; ++i)
+            {
+            const T value = rowPtr[i];
+            if (value == 0 || (self->GetLabel() != 0 && value != static_cast<T>(self->GetLabel())))
+              {
+              continue;
+              }
+            const int ijk[3] = { i + extent[0], j + extent[2], k + extent[4] };
+            typename std::map<T, ExtentType>::iterator labelIt = labelExtents.find(value);
+            if (labelIt == labelExtents.end())
+              {
+              labelExtents[value] = { { ijk[0], ijk[0], ijk[1], ijk[1], ijk[2], ijk[2] } };
+              continue;
+              }
+            for (int a = 0; a < 3; ++a)
+              {
+              labelIt->second[2 * a] = std::min(labelIt->second[2 * a], ijk[a]);
+              labelIt->second[2 * a + 1] = std::max(labelIt->second[2 * a + 1], ijk[a]);
+              }
+            }
+          }
+        }
+      }
+    });
 
+  // Interpolation tasks: one for each label, or one for each interval between labeled slices if an axis is set.
+  // Task extents are padded by one voxel (except along the interpolation axis of intervals).
+  std::map<T, std::vector<int> > labeledSlices;
+  for (int slice = 0; slice < dims[sliceAxis]; ++slice)
+    {
+    for (const std::pair<const T, ExtentType>& labelExtent : sliceLabelExtents[slice])
+      {
+      labeledSlices[labelExtent.first].push_back(slice);
+      }
+    }
+  auto padExtent = [&](ExtentType& taskExtent, int paddedAxes)
+    {
+    for (int a = 0; a < 3; ++a)
+      {
+      if (paddedAxes & (1 << a))
+        {
+        taskExtent[2 * a] = std::max(extent[2 * a], taskExtent[2 * a] - 1);
+        taskExtent[2 * a + 1] = std::min(extent[2 * a + 1], taskExtent[2 * a + 1] + 1);
+        }
+      }
+    };
+  auto mergeExtent = [](ExtentType& taskExtent, const ExtentType& labelExtent)
+    {
+    for (int a = 0; a < 3; ++a)
+      {
+      taskExtent[2 * a] = std::min(taskExtent[2 * a], labelExtent[2 * a]);
+      taskExtent[2 * a + 1] = std::max(taskExtent[2 * a + 1], labelExtent[2 * a + 1]);
+      }
+    };
+  std::vector<Task> tasks;
+  for (const std::pair<const T, std::vector<int> >& label : labeledSlices)
+    {
+    const std::vector<int>& slices = label.second;
+    if (axis < 0)
+      {
+      Task task;
+      task.Label = static_cast<double>(label.first);
+      task.Axis = -1;
+      task.Extent = sliceLabelExtents[slices.front()][label.first];
+      for (int slice : slices)
+        {
+        mergeExtent(task.Extent, sliceLabelExtents[slice][label.first]);
+        }
+      padExtent(task.Extent, 7);
+      tasks.push_back(task);
+      continue;
+      }
+    for (size_t sliceIndex = 1; sliceIndex < slices.size(); ++sliceIndex)
+      {
+      if (slices[sliceIndex] - slices[sliceIndex - 1] < 2)
+        {
+        // neighbor slices, nothing to interpolate
+        continue;
+        }
+      Task task;
+      task.Label = static_cast<double>(label.first);
+      task.Axis = axis;
+      task.Extent = sliceLabelExtents[slices[sliceIndex - 1]][label.first];
+      mergeExtent(task.Extent, sliceLabelExtents[slices[sliceIndex]][label.first]);
+      padExtent(task.Extent, 7 & ~(1 << axis));
+      tasks.push_back(task);
+      }
+    }
+
+  // Reuse results of the previous execution
+  if (reuse)
+    {
+    std::map<std::tuple<double, int, ExtentType>, Task*> previousTasks;
+    for (Task& previousTask : this->Tasks)
+      {
+      previousTasks[std::make_tuple(previousTask.Label, previousTask.Axis, previousTask.Extent)] = &previousTask;
+      }
+    for (Task& task : tasks)
+      {
+      typename std::map<T, ExtentType>::iterator changedIt = changedExtents.find(static_cast<T>(task.Label));
+      if (changedIt != changedExtents.end())
+        {
+        bool intersects = true;
+        for (int a = 0; a < 3; ++a)
+          {
+          intersects = intersects && changedIt->second[2 * a] <= task.Extent[2 * a + 1] && changedIt->second[2 * a + 1] >= task.Extent[2 * a];
+          }
+        if (intersects)
+          {
+          continue;
+          }
+        }
+      std::map<std::tuple<double, int, ExtentType>, Task*>::iterator previousIt =
+        previousTasks.find(std::make_tuple(task.Label, task.Axis, task.Extent));
+      if (previousIt != previousTasks.end())
+        {
+        task.InterpolatedVoxels.swap(previousIt->second->InterpolatedVoxels);
+        task.Computed = true;
+        }
+      }
+    }
+
+  // Interpolate in parallel. The input of each task only contains its label.
+  std::atomic<bool> failed(false);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()), 1, [&](vtkIdType firstTask, vtkIdType endTask)
+    {
+    for (vtkIdType taskIndex = firstTask; taskIndex < endTask; ++taskIndex)
+      {
+      Task& task = tasks[taskIndex];
+      if (task.Computed)
+        {
+        continue;
+        }
+      const T label = static_cast<T>(task.Label);
+      const int taskDims[3] = { task.Extent[1] - task.Extent[0] + 1, task.Extent[3] - task.Extent[2] + 1, task.Extent[5] - task.Extent[4] + 1 };
+      const vtkIdType numberOfTaskVoxels = static_cast<vtkIdType>(taskDims[0]) * taskDims[1] * taskDims[2];
+      std::vector<T> taskInput(numberOfTaskVoxels);
+      std::vector<T> taskOutput(numberOfTaskVoxels);
+      vtkIdType taskVoxel = 0;
+      for (int k = task.Extent[4]; k <= task.Extent[5]; ++k)
+        {
+        for (int j = task.Extent[2]; j <= task.Extent[3]; ++j)
+          {
+          const T* rowPtr = inPtr + (static_cast<vtkIdType>(k - extent[4]) * dims[1] + (j - extent[2])) * dims[0];
+          for (int i = task.Extent[0]; i <= task.Extent[1]; ++i, ++taskVoxel)
+            {
+            taskInput[taskVoxel] = (rowPtr[i - extent[0]] == label ? label : 0);
+            }
+          }
+        }
+      try
+        {
+        vtkITKMorphologicalContourInterpolatorRun<T>(self, taskDims, spacing, label, task.Axis, taskInput.data(), taskOutput.data());
+        }
+      catch (itk::ExceptionObject&)
+        {
+        failed = true;
+        continue;
+        }
+      for (taskVoxel = 0; taskVoxel < numberOfTaskVoxels; ++taskVoxel)
+        {
+        if (taskOutput[taskVoxel] == label && taskInput[taskVoxel] != label)
+          {
+          task.InterpolatedVoxels.push_back(taskVoxel);
+          }
+        }
+      task.Computed = true;
+      }
+    });
+  if (failed)
+    {
+    vtkErrorWithObjectMacro(self, "Contour interpolation failed");
+    }
+
+  // Set interpolated voxels in the background, in increasing label order
+  std::copy(inPtr, inPtr + numberOfVoxels, outPtr);
+  for (const Task& task : tasks)
+    {
+    const T label = static_cast<T>(task.Label);
+    const vtkIdType taskDimX = task.Extent[1] - task.Extent[0] + 1;
+    const vtkIdType taskDimY = task.Extent[3] - task.Extent[2] + 1;
+    for (vtkIdType taskVoxel : task.InterpolatedVoxels)
+      {
+      const vtkIdType i = task.Extent[0] - extent[0] + taskVoxel % taskDimX;
+      const vtkIdType j = task.Extent[2] - extent[2] + (taskVoxel / taskDimX) % taskDimY;
+      const vtkIdType k = task.Extent[4] - extent[4] + taskVoxel / (taskDimX * taskDimY);
+      const vtkIdType voxel = i + dims[0] * (j + dims[1] * k);
+      if (outPtr[voxel] == 0)
+        {
+        outPtr[voxel] = label;
+        }
+      }
+    }
+
+  // Keep the input and the results for the next execution
+  if (!this->PreviousInput)
+    {
+    this->PreviousInput = vtkSmartPointer<vtkImageData>::New();
+    }
+  this->PreviousInput->DeepCopy(input);
+  this->Tasks.swap(tasks);
+  this->Label = self->GetLabel();
+  this->Axis = self->GetAxis();
+  this->HeuristicAlignment = self->GetHeuristicAlignment();
+  this->UseDistanceTransform = self->GetUseDistanceTransform();
+  this->UseBallStructuringElement = self->GetUseBallStructuringElement();
+  if (failed)
+    {
+    // do not reuse incomplete results
+    this->Reset();
+    }
+}
 
 
 //
@@ -98,6 +505,11 @@ void vtkITKMorphologicalContourInterpolator::SimpleExecute(vtkImageData *input,
     return;
     }
 
+  if (!this->ParallelComputation)
+    {
+    this->Internal->Reset();
+    }
+
   if (inScalars->GetNumberOfComponents() == 1 )
     {
 
@@ -105,7 +517,10 @@ void vtkITKMorphologicalContourInterpolator::SimpleExecute(vtkImageData *input,
 #undef VTK_TYPE_USE_LONG_LONG
 #undef VTK_TYPE_USE___INT64
 
-#define CALL  vtkITKMorphologicalContourInterpolatorExecute(this, input, output, static_cast<VTK_TT *>(inPtr), static_cast<VTK_TT *>(outPtr));
+#define CALL  if (this->ParallelComputation) \
+                { this->Internal->Execute(this, input, static_cast<VTK_TT *>(inPtr), static_cast<VTK_TT *>(outPtr)); } \
+              else \
+                { vtkITKMorphologicalContourInterpolatorExecute(this, input, output, static_cast<VTK_TT *>(inPtr), static_cast<VTK_TT *>(outPtr)); }
 
     void* inPtr = input->GetScalarPointer();
     void* outPtr = output->GetScalarPointer();
@@ -137,4 +552,5 @@ void vtkITKMorphologicalContourInterpolator::PrintSelf(ostream& os, vtkIndent in
   os << indent << "HeuristicAlignment: " << HeuristicAlignment << std::endl;
   os << indent << "UseDistanceTransform: " << UseDistanceTransform << std::endl;
   os << indent << "UseBallStructuringElement: " << UseBallStructuringElement << std::endl;
+  os << indent << "ParallelComputation: " << ParallelComputation << std::endl;
 }
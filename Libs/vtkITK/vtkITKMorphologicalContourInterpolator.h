@@ -44,6 +44,18 @@ public:
   vtkGetMacro(UseBallStructuringElement, bool);
   vtkSetMacro(UseBallStructuringElement, bool);
 
+  /// Interpolate each label independently, on the bounding box of the label, with the labels
+  /// processed in parallel. If Axis is set then each interval between two labeled slices is also
+  /// interpolated independently and in parallel. When the filter is executed again (for example
+  /// to update a preview), only the labels and slice intervals whose input changed are interpolated
+  /// again, results of the others are reused from the previous execution.
+  /// Interpolated voxels are only set in background voxels. If several labels are interpolated into
+  /// the same voxel then the lowest label value is used.
+  /// Default is OFF (the whole image is interpolated by a single filter).
+  vtkGetMacro(ParallelComputation, bool);
+  vtkSetMacro(ParallelComputation, bool);
+  vtkBooleanMacro(ParallelComputation, bool);
+
 protected:
   vtkITKMorphologicalContourInterpolator();
   ~vtkITKMorphologicalContourInterpolator() override;
@@ -55,6 +67,10 @@ protected:
   bool HeuristicAlignment{true};
   bool UseDistanceTransform{false};
   bool UseBallStructuringElement{false};
+  bool ParallelComputation{false};
+
+  class vtkInternal;
+  vtkInternal* Internal;
 
 private:
   vtkITKMorphologicalContourInterpolator(const vtkITKMorphologicalContourInterpolator&) = delete;
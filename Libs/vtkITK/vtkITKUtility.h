@@ -17,6 +17,11 @@
 
 #include "vtkObjectFactory.h"
 #include "vtkSetGet.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+// STD includes
+#include <algorithm>
 
 /**
  * This function will connect the given itk::VTKImageExport filter to
@@ -61,6 +66,67 @@ void ConnectPipelines(VTK_Exporter* exporter, ITK_Importer importer)
 }
 
 
+/**
+ * Compute the bounding box (inclusive voxel index ranges, from 0) of the
+ * voxels of a single component image buffer that are different from the
+ * background value, using multiple threads.
+ * Returns false if all voxels are background.
+ */
+template <class T>
+bool vtkITKCalculateEffectiveExtent(const T* inPtr, const int dims[3], T backgroundValue, int effectiveExtent[6])
+{
+  const vtkIdType dimX = dims[0];
+  const vtkIdType dimY = dims[1];
+  struct ExtentType
+  {
+    int Extent[6] = { VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN };
+  };
+  vtkSMPThreadLocal<ExtentType> localExtents;
+  vtkSMPTools::For(0, dims[2], [&](vtkIdType zBegin, vtkIdType zEnd)
+    {
+    int* extent = localExtents.Local().Extent;
+    for (vtkIdType z = zBegin; z < zEnd; ++z)
+      {
+      for (vtkIdType y = 0; y < dimY; ++y)
+        {
+        const T* row = inPtr + (z * dimY + y) * dimX;
+        vtkIdType x = 0;
+        while (x < dimX && row[x] == backgroundValue)
+          {
+          ++x;
+          }
+        if (x == dimX)
+          {
+          continue;
+          }
+        vtkIdType lastX = dimX - 1;
+        while (row[lastX] == backgroundValue)
+          {
+          --lastX;
+          }
+        extent[0] = std::min(extent[0], static_cast<int>(x));
+        extent[1] = std::max(extent[1], static_cast<int>(lastX));
+        extent[2] = std::min(extent[2], static_cast<int>(y));
+        extent[3] = std::max(extent[3], static_cast<int>(y));
+        extent[4] = std::min(extent[4], static_cast<int>(z));
+        extent[5] = std::max(extent[5], static_cast<int>(z));
+        }
+      }
+    });
+  ExtentType mergedExtent;
+  for (ExtentType& localExtent : localExtents)
+    {
+    for (int i = 0; i < 3; ++i)
+      {
+      mergedExtent.Extent[2 * i] = std::min(mergedExtent.Extent[2 * i], localExtent.Extent[2 * i]);
+      mergedExtent.Extent[2 * i + 1] = std::max(mergedExtent.Extent[2 * i + 1], localExtent.Extent[2 * i + 1]);
+      }
+    }
+  std::copy(mergedExtent.Extent, mergedExtent.Extent + 6, effectiveExtent);
+  return effectiveExtent[0] <= effectiveExtent[1];
+}
+
+
 #define DelegateSetMacro(name,arg) DelegateITKInputMacro(Set##name,arg)
 #define DelegateITKInputMacro(name,arg) \
 if ( 1 ) { \
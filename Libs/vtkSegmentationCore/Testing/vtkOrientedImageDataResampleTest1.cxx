@@ -0,0 +1,227 @@
+/*==============================================================================
+
+  Copyright (c) Laboratory for Percutaneous Surgery (PerkLab)
+  Queen's University, Kingston, ON, Canada. All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VTK includes
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+#include <vtkTimerLog.h>
+
+// SegmentationCore includes
+#include "vtkOrientedImageData.h"
+#include "vtkOrientedImageDataResample.h"
+
+// STD includes
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+template <class T>
+void FillRandomLabels(vtkOrientedImageData* image, const int extent[6], int scalarType, int seed)
+{
+  image->SetExtent(const_cast<int*>(extent));
+  image->AllocateScalars(scalarType, 1);
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  T* imagePtr = static_cast<T*>(image->GetScalarPointer());
+  vtkIdType numberOfVoxels = image->GetNumberOfPoints();
+  for (vtkIdType i = 0; i < numberOfVoxels; ++i)
+    {
+    imagePtr[i] = static_cast<T>(random->GetNextRangeValue(0, 4));
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+T GetExpectedValue(T baseValue, T modifierValue, int operation, T fillValue)
+{
+  switch (operation)
+    {
+    case vtkOrientedImageDataResample::OPERATION_MAXIMUM: return std::max(baseValue, modifierValue);
+    case vtkOrientedImageDataResample::OPERATION_MINIMUM: return std::min(baseValue, modifierValue);
+    case vtkOrientedImageDataResample::OPERATION_MASKING: return (modifierValue > 0) ? fillValue : baseValue;
+    default: return baseValue;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+bool TestModifyImage(int scalarType, int operation, const char* name)
+{
+  int baseExtent[6] = { 0, 199, 0, 199, 0, 199 };
+  int modifierExtent[6] = { 20, 219, -10, 189, 5, 204 };
+  vtkNew<vtkOrientedImageData> baseImage;
+  FillRandomLabels<T>(baseImage, baseExtent, scalarType, 1);
+  vtkNew<vtkOrientedImageData> modifierImage;
+  FillRandomLabels<T>(modifierImage, modifierExtent, scalarType, 2);
+  vtkNew<vtkOrientedImageData> originalBaseImage;
+  originalBaseImage->DeepCopy(baseImage);
+
+  const T fillValue = 3;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  vtkOrientedImageDataResample::ModifyImage(baseImage, modifierImage, operation, nullptr, 0, fillValue);
+  timer->StopTimer();
+  std::cout << "ModifyImage " << name << " (" << baseImage->GetScalarTypeAsString() << "): "
+    << timer->GetElapsedTime() * 1000.0 << " ms" << std::endl;
+
+  for (int k = baseExtent[4]; k <= baseExtent[5]; ++k)
+    {
+    for (int j = baseExtent[2]; j <= baseExtent[3]; ++j)
+      {
+      for (int i = baseExtent[0]; i <= baseExtent[1]; ++i)
+        {
+        T originalValue = *static_cast<T*>(originalBaseImage->GetScalarPointer(i, j, k));
+        T expectedValue = originalValue;
+        if (i >= modifierExtent[0] && i <= modifierExtent[1]
+          && j >= modifierExtent[2] && j <= modifierExtent[3]
+          && k >= modifierExtent[4] && k <= modifierExtent[5])
+          {
+          T modifierValue = *static_cast<T*>(modifierImage->GetScalarPointer(i, j, k));
+          expectedValue = GetExpectedValue<T>(originalValue, modifierValue, operation, fillValue);
+          }
+        T actualValue = *static_cast<T*>(baseImage->GetScalarPointer(i, j, k));
+        if (actualValue != expectedValue)
+          {
+          std::cerr << "ModifyImage " << name << " failed at voxel (" << i << ", " << j << ", " << k << "): "
+            << static_cast<int>(actualValue) << " should be " << static_cast<int>(expectedValue) << std::endl;
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+bool TestModifyImageOperations(int scalarType)
+{
+  return TestModifyImage<T>(scalarType, vtkOrientedImageDataResample::OPERATION_MAXIMUM, "maximum")
+    && TestModifyImage<T>(scalarType, vtkOrientedImageDataResample::OPERATION_MINIMUM, "minimum")
+    && TestModifyImage<T>(scalarType, vtkOrientedImageDataResample::OPERATION_MASKING, "masking");
+}
+
+
+//----------------------------------------------------------------------------
+void SetVoxel(vtkOrientedImageData* image, int i, int j, int k, unsigned char value, bool recordModifiedExtent)
+{
+  vtkMTimeType baseMTime = image->GetMTime();
+  *static_cast<unsigned char*>(image->GetScalarPointer(i, j, k)) = value;
+  image->Modified();
+  if (recordModifiedExtent)
+    {
+    int modifiedExtent[6] = { i, i, j, j, k, k };
+    image->SetModifiedExtent(modifiedExtent, baseMTime);
+    }
+}
+
+//----------------------------------------------------------------------------
+bool CheckEffectiveExtent(vtkOrientedImageData* image, const int expectedExtent[6], const char* description)
+{
+  int effectiveExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  vtkOrientedImageDataResample::CalculateEffectiveExtent(image, effectiveExtent);
+  for (int i = 0; i < 6; ++i)
+    {
+    if (effectiveExtent[i] != expectedExtent[i])
+      {
+      std::cerr << "CalculateEffectiveExtent failed after " << description << ": got ("
+        << effectiveExtent[0] << ", " << effectiveExtent[1] << ", " << effectiveExtent[2] << ", "
+        << effectiveExtent[3] << ", " << effectiveExtent[4] << ", " << effectiveExtent[5] << "), expected ("
+        << expectedExtent[0] << ", " << expectedExtent[1] << ", " << expectedExtent[2] << ", "
+        << expectedExtent[3] << ", " << expectedExtent[4] << ", " << expectedExtent[5] << ")" << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool TestCachedEffectiveExtent()
+{
+  int extent[6] = { 0, 49, 0, 49, 0, 49 };
+  vtkNew<vtkOrientedImageData> image;
+  image->SetExtent(extent);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  vtkOrientedImageDataResample::FillImage(image, 0);
+
+  const int emptyExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  if (!CheckEffectiveExtent(image, emptyExtent, "initialization"))
+    {
+    return false;
+    }
+
+  // Grow from empty using the recorded modified extent
+  SetVoxel(image, 10, 20, 30, 1, true);
+  const int singleVoxelExtent[6] = { 10, 10, 20, 20, 30, 30 };
+  if (!CheckEffectiveExtent(image, singleVoxelExtent, "adding a voxel"))
+    {
+    return false;
+    }
+  if (!CheckEffectiveExtent(image, singleVoxelExtent, "repeated query"))
+    {
+    return false;
+    }
+
+  SetVoxel(image, 40, 5, 30, 1, true);
+  const int twoVoxelsExtent[6] = { 10, 40, 5, 20, 30, 30 };
+  if (!CheckEffectiveExtent(image, twoVoxelsExtent, "adding a second voxel"))
+    {
+    return false;
+    }
+
+  // Removing a voxel from the boundary shrinks the extent
+  SetVoxel(image, 40, 5, 30, 0, true);
+  if (!CheckEffectiveExtent(image, singleVoxelExtent, "removing a voxel"))
+    {
+    return false;
+    }
+
+  // Modification without recording the modified extent
+  SetVoxel(image, 0, 0, 0, 1, false);
+  const int unrecordedExtent[6] = { 0, 10, 0, 20, 0, 30 };
+  if (!CheckEffectiveExtent(image, unrecordedExtent, "unrecorded modification"))
+    {
+    return false;
+    }
+
+  return true;
+}
+
+}
+
+//----------------------------------------------------------------------------
+int vtkOrientedImageDataResampleTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  if (!TestModifyImageOperations<unsigned char>(VTK_UNSIGNED_CHAR))
+    {
+    return EXIT_FAILURE;
+    }
+  if (!TestModifyImageOperations<short>(VTK_SHORT))
+    {
+    return EXIT_FAILURE;
+    }
+
+  if (!TestCachedEffectiveExtent())
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Oriented image data resample test 1 passed." << std::endl;
+  return EXIT_SUCCESS;
+}
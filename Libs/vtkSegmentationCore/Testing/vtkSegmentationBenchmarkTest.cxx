@@ -0,0 +1,237 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// SegmentationCore includes
+#include "vtkBinaryLabelmapToClosedSurfaceConversionRule.h"
+#include "vtkClosedSurfaceToBinaryLabelmapConversionRule.h"
+#include "vtkOrientedImageData.h"
+#include "vtkOrientedImageDataResample.h"
+#include "vtkSegment.h"
+#include "vtkSegmentation.h"
+#include "vtkSegmentationConverterFactory.h"
+#include "vtkSegmentationHistory.h"
+
+// VTK includes
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+#include <vtkTimerLog.h>
+#include <vtksys/SystemInformation.hxx>
+
+// STD includes
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Keeps track of the largest memory usage of the process during the benchmark
+class MemoryUsageTracker
+{
+public:
+  MemoryUsageTracker()
+    {
+    this->InitialMemoryUsedKiB = this->SystemInformation.GetProcMemoryUsed();
+    this->PeakMemoryUsedKiB = this->InitialMemoryUsedKiB;
+    }
+  void Update()
+    {
+    this->PeakMemoryUsedKiB = std::max(this->PeakMemoryUsedKiB, this->SystemInformation.GetProcMemoryUsed());
+    }
+  double GetPeakMemoryIncreaseMB()
+    {
+    return (this->PeakMemoryUsedKiB - this->InitialMemoryUsedKiB) / 1024.0;
+    }
+protected:
+  vtksys::SystemInformation SystemInformation;
+  vtksys::SystemInformation::LongLong InitialMemoryUsedKiB;
+  vtksys::SystemInformation::LongLong PeakMemoryUsedKiB;
+};
+
+//----------------------------------------------------------------------------
+void ReportMeasurement(const std::string& name, double value)
+{
+  std::cout << "<DartMeasurement name=\"vtkSegmentation-" << name << "\" type=\"numeric/double\">"
+            << value << "</DartMeasurement>" << std::endl;
+}
+
+//----------------------------------------------------------------------------
+/// Report time and throughput (voxels processed per second) of a benchmark step
+void ReportStep(const std::string& name, vtkTimerLog* timer, double numberOfVoxels, MemoryUsageTracker& memoryUsage)
+{
+  memoryUsage.Update();
+  double elapsedTime = timer->GetElapsedTime();
+  ReportMeasurement(name + "-Time", elapsedTime);
+  if (elapsedTime > 0)
+    {
+    ReportMeasurement(name + "-MegavoxelsPerSecond", numberOfVoxels / elapsedTime / 1.0e6);
+    }
+}
+
+//----------------------------------------------------------------------------
+/// Create a labelmap that contains a sphere with the specified center and radius (in voxels)
+void CreateSphereLabelmap(vtkOrientedImageData* labelmap, int dimension, const double center[3], double radius)
+{
+  labelmap->SetExtent(0, dimension - 1, 0, dimension - 1, 0, dimension - 1);
+  labelmap->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  unsigned char* voxel = static_cast<unsigned char*>(labelmap->GetScalarPointer());
+  for (int k = 0; k < dimension; ++k)
+    {
+    for (int j = 0; j < dimension; ++j)
+      {
+      for (int i = 0; i < dimension; ++i, ++voxel)
+        {
+        double dx = i - center[0];
+        double dy = j - center[1];
+        double dz = k - center[2];
+        *voxel = (dx * dx + dy * dy + dz * dz <= radius * radius) ? 1 : 0;
+        }
+      }
+    }
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+/// Benchmark of segmentation operations on a synthetic segmentation.
+/// Usage: vtkSegmentationBenchmarkTest [dimension] [numberOfSegments]
+/// Each segment is a sphere at a random position in a volume of dimension^3 voxels.
+/// Time, throughput and peak memory increase of each step are reported as DartMeasurement.
+int vtkSegmentationBenchmarkTest(int argc, char* argv[])
+{
+  int dimension = 64;
+  int numberOfSegments = 10;
+  if (argc > 1)
+    {
+    dimension = atoi(argv[1]);
+    }
+  if (argc > 2)
+    {
+    numberOfSegments = atoi(argv[2]);
+    }
+  if (dimension < 8 || numberOfSegments < 1)
+    {
+    std::cerr << "Usage: vtkSegmentationBenchmarkTest [dimension (at least 8)] [numberOfSegments (at least 1)]" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::cout << "Segmentation benchmark: " << numberOfSegments << " segments, "
+            << dimension << "^3 voxels" << std::endl;
+
+  vtkSegmentationConverterFactory::GetInstance()->RegisterConverterRule(
+    vtkSmartPointer<vtkBinaryLabelmapToClosedSurfaceConversionRule>::New());
+  vtkSegmentationConverterFactory::GetInstance()->RegisterConverterRule(
+    vtkSmartPointer<vtkClosedSurfaceToBinaryLabelmapConversionRule>::New());
+
+  MemoryUsageTracker memoryUsage;
+  vtkNew<vtkTimerLog> timer;
+  const double numberOfVoxels = static_cast<double>(dimension) * dimension * dimension;
+  const double totalNumberOfVoxels = numberOfVoxels * numberOfSegments;
+
+  // Create segments, each in a separate labelmap
+  vtkNew<vtkSegmentation> segmentation;
+  segmentation->SetSourceRepresentationName(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName());
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  timer->StartTimer();
+  for (int segmentIndex = 0; segmentIndex < numberOfSegments; ++segmentIndex)
+    {
+    double center[3] = { 0.0, 0.0, 0.0 };
+    for (int i = 0; i < 3; ++i)
+      {
+      random->Next();
+      center[i] = random->GetRangeValue(0.2 * dimension, 0.8 * dimension);
+      }
+    random->Next();
+    double radius = random->GetRangeValue(0.05 * dimension, 0.2 * dimension);
+    vtkNew<vtkOrientedImageData> labelmap;
+    CreateSphereLabelmap(labelmap, dimension, center, radius);
+    vtkNew<vtkSegment> segment;
+    std::stringstream segmentName;
+    segmentName << "Segment_" << segmentIndex;
+    segment->SetName(segmentName.str().c_str());
+    segment->AddRepresentation(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName(), labelmap);
+    segmentation->AddSegment(segment);
+    }
+  timer->StopTimer();
+  ReportStep("CreateSegments", timer, totalNumberOfVoxels, memoryUsage);
+
+  // Merge segments into shared labelmaps
+  timer->StartTimer();
+  segmentation->CollapseBinaryLabelmaps(false);
+  timer->StopTimer();
+  ReportStep("CollapseBinaryLabelmaps", timer, totalNumberOfVoxels, memoryUsage);
+  ReportMeasurement("NumberOfLayers", segmentation->GetNumberOfLayers());
+
+  // Save and restore history states
+  vtkNew<vtkSegmentationHistory> history;
+  history->SetSegmentation(segmentation);
+  timer->StartTimer();
+  history->SaveState();
+  timer->StopTimer();
+  ReportStep("SaveState", timer, numberOfVoxels * segmentation->GetNumberOfLayers(), memoryUsage);
+  ReportMeasurement("HistoryMemorySizeMB", history->GetMemorySize() / 1024.0);
+
+  // Modify the first shared labelmap with a large sphere
+  vtkSegment* firstSegment = segmentation->GetNthSegment(0);
+  vtkOrientedImageData* sharedLabelmap = vtkOrientedImageData::SafeDownCast(
+    firstSegment->GetRepresentation(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName()));
+  vtkNew<vtkOrientedImageData> modifierLabelmap;
+  const double modifierCenter[3] = { dimension / 2.0, dimension / 2.0, dimension / 2.0 };
+  CreateSphereLabelmap(modifierLabelmap, dimension, modifierCenter, dimension / 4.0);
+  modifierLabelmap->CopyDirections(sharedLabelmap);
+  timer->StartTimer();
+  vtkOrientedImageDataResample::ModifyImage(sharedLabelmap, modifierLabelmap,
+    vtkOrientedImageDataResample::OPERATION_MAXIMUM, nullptr, 0.0, firstSegment->GetLabelValue());
+  timer->StopTimer();
+  ReportStep("ModifyImage", timer, numberOfVoxels, memoryUsage);
+
+  timer->StartTimer();
+  bool restored = history->RestorePreviousState();
+  timer->StopTimer();
+  ReportStep("RestorePreviousState", timer, numberOfVoxels * segmentation->GetNumberOfLayers(), memoryUsage);
+  if (!restored)
+    {
+    std::cerr << "Failed to restore previous segmentation state" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Conversion rules
+  timer->StartTimer();
+  bool converted = segmentation->CreateRepresentation(vtkSegmentationConverter::GetClosedSurfaceRepresentationName());
+  timer->StopTimer();
+  ReportStep("ConvertToClosedSurface", timer, totalNumberOfVoxels, memoryUsage);
+  if (!converted)
+    {
+    std::cerr << "Failed to convert segmentation to closed surface" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  segmentation->SetSourceRepresentationName(vtkSegmentationConverter::GetClosedSurfaceRepresentationName());
+  timer->StartTimer();
+  converted = segmentation->CreateRepresentation(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName(), true);
+  timer->StopTimer();
+  ReportStep("ConvertToBinaryLabelmap", timer, totalNumberOfVoxels, memoryUsage);
+  if (!converted)
+    {
+    std::cerr << "Failed to convert segmentation to binary labelmap" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  ReportMeasurement("PeakMemoryIncreaseMB", memoryUsage.GetPeakMemoryIncreaseMB());
+  return EXIT_SUCCESS;
+}
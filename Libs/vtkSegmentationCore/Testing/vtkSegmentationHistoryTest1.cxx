@@ -185,6 +185,21 @@ int vtkSegmentationHistoryTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
     return EXIT_FAILURE;
     }
 
+  // Labelmap that was shared between segments must be restored as a shared labelmap
+  if (segment2->GetRepresentation(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName()) != undoLabelmap)
+    {
+    std::cerr << "Segment 1 and segment 2 labelmaps are not shared after undo!" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Labelmaps are stored compressed, so the states must take less memory than the uncompressed labelmaps
+  if (history->GetMemorySize() >= 2 * undoLabelmap->GetActualMemorySize())
+    {
+    std::cerr << "Segmentation history memory size (" << history->GetMemorySize() << "kB) is larger than the uncompressed states ("
+      << 2 * undoLabelmap->GetActualMemorySize() << "kB)!" << std::endl;
+    return EXIT_FAILURE;
+    }
+
   // Segmentation state is already saved, check that it does not create a new state
   // (it would be the duplicate of the previous state) and does not remove future states.
   history->SaveState();
@@ -26,6 +26,7 @@
 #include <vtkSphereSource.h>
 #include <vtkMatrix4x4.h>
 #include <vtkImageAccumulate.h>
+#include <vtkDataArray.h>
 
 // SegmentationCore includes
 #include "vtkSegmentation.h"
@@ -34,6 +35,7 @@
 #include "vtkOrientedImageData.h"
 #include "vtkOrientedImageDataResample.h"
 #include "vtkSegmentationConverterFactory.h"
+#include "vtkSegmentationModifier.h"
 #include "vtkBinaryLabelmapToClosedSurfaceConversionRule.h"
 #include "vtkClosedSurfaceToBinaryLabelmapConversionRule.h"
 
@@ -314,6 +316,291 @@ bool TestSharedLabelmapCasting()
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool TestSharedLabelmapMinimum()
+{
+  vtkNew<vtkOrientedImageData> cubeImage1;
+  int extent1[6] = { 0, 4, 0, 4, 0, 4 };
+  CreateCubeLabelmap(cubeImage1, extent1);
+
+  vtkNew<vtkOrientedImageData> cubeImage2;
+  int extent2[6] = { 5, 7, 5, 7, 5, 7 };
+  int imageCount2 = CreateCubeLabelmap(cubeImage2, extent2);
+
+  vtkNew<vtkSegment> segment1;
+  segment1->SetName("cube1");
+  segment1->AddRepresentation(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName(), cubeImage1);
+
+  vtkNew<vtkSegment> segment2;
+  segment2->SetName("cube2");
+  segment2->AddRepresentation(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName(), cubeImage2);
+
+  vtkNew<vtkSegmentation> segmentation;
+  segmentation->SetSourceRepresentationName(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName());
+  segmentation->AddSegment(segment1, "cube1");
+  segmentation->AddSegment(segment2, "cube2");
+  segmentation->CollapseBinaryLabelmaps(false);
+  if (segmentation->GetNumberOfLayers() != 1)
+    {
+    std::cerr << "Invalid number of layers " << segmentation->GetNumberOfLayers() << " should be 1" << std::endl;
+    return false;
+    }
+
+  // Modifier covers both segments, but it is only non-zero in the corner of the first segment
+  int modifierExtent[6] = { 0, 7, 0, 7, 0, 7 };
+  vtkNew<vtkOrientedImageData> modifierLabelmap;
+  CreateCubeLabelmap(modifierLabelmap, modifierExtent);
+  modifierLabelmap->GetPointData()->GetScalars()->Fill(0);
+  int expectedCount1 = 0;
+  for (int k = 0; k <= 2; ++k)
+    {
+    for (int j = 0; j <= 2; ++j)
+      {
+      for (int i = 0; i <= 2; ++i)
+        {
+        modifierLabelmap->SetScalarComponentFromDouble(i, j, k, 0, 1.0);
+        ++expectedCount1;
+        }
+      }
+    }
+  vtkSegmentationModifier::ModifyBinaryLabelmap(modifierLabelmap, segmentation, "cube1", vtkSegmentationModifier::MODE_MERGE_MIN);
+
+  // Only the modified segment may be removed outside the modifier
+  vtkOrientedImageData* sharedLabelmap = vtkOrientedImageData::SafeDownCast(
+    segment1->GetRepresentation(vtkSegmentationConverter::GetBinaryLabelmapRepresentationName()));
+  int count1 = 0;
+  int count2 = 0;
+  vtkDataArray* scalars = sharedLabelmap->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+    {
+    int value = static_cast<int>(scalars->GetTuple1(i));
+    if (value == segment1->GetLabelValue())
+      {
+      ++count1;
+      }
+    else if (value == segment2->GetLabelValue())
+      {
+      ++count2;
+      }
+    }
+  if (count1 != expectedCount1 || count2 != imageCount2)
+    {
+    std::cerr << "Minimum merge failed: segment voxel counts are " << count1 << " and " << count2
+      << ", should be " << expectedCount1 << " and " << imageCount2 << std::endl;
+    return false;
+    }
+
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool TestModifiedExtent()
+{
+  int segmentExtent[6] = { 0, 9, 0, 9, 0, 9 };
+  vtkNew<vtkOrientedImageData> labelmap;
+  CreateCubeLabelmap(labelmap, segmentExtent);
+
+  vtkNew<vtkSegment> segment;
+  segment->SetName("Segment");
+  segment->AddRepresentation(vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName(), labelmap);
+
+  vtkNew<vtkSegmentation> segmentation;
+  segmentation->AddSegment(segment, "Segment");
+
+  int modifiedExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  vtkMTimeType lastUpdateTime = labelmap->GetMTime();
+  if (!labelmap->GetModifiedExtent(lastUpdateTime, modifiedExtent) || modifiedExtent[0] <= modifiedExtent[1])
+    {
+    std::cerr << "Modified extent is expected to be empty if the labelmap has not been modified" << std::endl;
+    return false;
+    }
+
+  int modifierExtent[6] = { 2, 4, 3, 5, 4, 6 };
+  vtkNew<vtkOrientedImageData> modifierLabelmap;
+  CreateCubeLabelmap(modifierLabelmap, modifierExtent);
+  vtkSegmentationModifier::ModifyBinaryLabelmap(modifierLabelmap, segmentation, "Segment", vtkSegmentationModifier::MODE_MERGE_MAX);
+  if (!labelmap->GetModifiedExtent(lastUpdateTime, modifiedExtent))
+    {
+    std::cerr << "Modified extent is expected to be known after ModifyBinaryLabelmap" << std::endl;
+    return false;
+    }
+  for (int i = 0; i < 6; ++i)
+    {
+    if (modifiedExtent[i] != modifierExtent[i])
+      {
+      std::cerr << "Modified extent mismatch at index " << i << ": " << modifiedExtent[i] << " should be " << modifierExtent[i] << std::endl;
+      return false;
+      }
+    }
+
+  // Modification without recording the modified region makes the modified extent unknown
+  labelmap->Modified();
+  if (labelmap->GetModifiedExtent(lastUpdateTime, modifiedExtent))
+    {
+    std::cerr << "Modified extent is expected to be unknown after an unrecorded modification" << std::endl;
+    return false;
+    }
+
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool TestIncrementalClosedSurfaceUpdate()
+{
+  int segmentExtent[6] = { 0, 39, 0, 39, 0, 39 };
+  vtkNew<vtkOrientedImageData> labelmap;
+  CreateCubeLabelmap(labelmap, segmentExtent);
+
+  vtkNew<vtkSegment> segment;
+  segment->SetName("Segment");
+  segment->SetLabelValue(1);
+  segment->AddRepresentation(vtkSegmentationConverter::GetSegmentationBinaryLabelmapRepresentationName(), labelmap);
+
+  vtkNew<vtkSegmentation> segmentation;
+  segmentation->AddSegment(segment, "Segment");
+
+  vtkNew<vtkBinaryLabelmapToClosedSurfaceConversionRule> incrementalRule;
+  incrementalRule->SetConversionParameter(vtkBinaryLabelmapToClosedSurfaceConversionRule::GetSmoothingFactorParameterName(), "0.0");
+  incrementalRule->SetConversionParameter(vtkBinaryLabelmapToClosedSurfaceConversionRule::GetIncrementalUpdateParameterName(), "1");
+  vtkNew<vtkBinaryLabelmapToClosedSurfaceConversionRule> fullRule;
+  fullRule->SetConversionParameter(vtkBinaryLabelmapToClosedSurfaceConversionRule::GetSmoothingFactorParameterName(), "0.0");
+
+  // Create initial surface, then modify the labelmap so that only some of the blocks are updated
+  incrementalRule->Convert(segment);
+  int modifierExtent[6] = { 35, 45, 35, 45, 35, 45 };
+  vtkNew<vtkOrientedImageData> modifierLabelmap;
+  CreateCubeLabelmap(modifierLabelmap, modifierExtent);
+  vtkSegmentationModifier::ModifyBinaryLabelmap(modifierLabelmap, segmentation, "Segment", vtkSegmentationModifier::MODE_MERGE_MAX);
+  incrementalRule->Convert(segment);
+
+  vtkNew<vtkPolyData> incrementalSurface;
+  incrementalSurface->DeepCopy(segment->GetRepresentation(vtkSegmentationConverter::GetSegmentationClosedSurfaceRepresentationName()));
+
+  // Without smoothing and decimation the merged blocks must be the same as the surface created from the entire labelmap
+  fullRule->Convert(segment);
+  vtkPolyData* fullSurface = vtkPolyData::SafeDownCast(
+    segment->GetRepresentation(vtkSegmentationConverter::GetSegmentationClosedSurfaceRepresentationName()));
+  if (!fullSurface || fullSurface->GetNumberOfPolys() == 0)
+    {
+    std::cerr << "Failed to create closed surface" << std::endl;
+    return false;
+    }
+  if (incrementalSurface->GetNumberOfPolys() != fullSurface->GetNumberOfPolys()
+    || incrementalSurface->GetNumberOfPoints() != fullSurface->GetNumberOfPoints())
+    {
+    std::cerr << "Incrementally updated surface (" << incrementalSurface->GetNumberOfPolys() << " polys, "
+      << incrementalSurface->GetNumberOfPoints() << " points) does not match the surface created from the entire labelmap ("
+      << fullSurface->GetNumberOfPolys() << " polys, " << fullSurface->GetNumberOfPoints() << " points)" << std::endl;
+    return false;
+    }
+
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int GetNumberOfVoxelsWithLabel(vtkOrientedImageData* imageData, int labelValue)
+{
+  vtkDataArray* scalars = imageData ? imageData->GetPointData()->GetScalars() : nullptr;
+  if (!scalars)
+    {
+    return 0;
+    }
+  int numberOfVoxels = 0;
+  for (vtkIdType voxelIndex = 0; voxelIndex < scalars->GetNumberOfTuples(); ++voxelIndex)
+    {
+    if (scalars->GetComponent(voxelIndex, 0) == labelValue)
+      {
+      ++numberOfVoxels;
+      }
+    }
+  return numberOfVoxels;
+}
+
+//----------------------------------------------------------------------------
+bool TestParallelConversion()
+{
+  // The same segments are converted serially and in parallel, with a rule that collapses labelmaps
+  double sphereCenters[3][3] = { { 0, 0, 0 }, { -1, -1, -1 }, { 5, 5, 5 } };
+  double sphereRadii[3] = { 1, 2, 2 };
+  vtkNew<vtkSegmentation> serialSegmentation;
+  vtkNew<vtkSegmentation> parallelSegmentation;
+  vtkSegmentation* segmentations[2] = { serialSegmentation, parallelSegmentation };
+  for (vtkSegmentation* segmentation : segmentations)
+    {
+    segmentation->SetSourceRepresentationName(vtkSegmentationConverter::GetClosedSurfaceRepresentationName());
+    for (int sphereIndex = 0; sphereIndex < 3; ++sphereIndex)
+      {
+      vtkNew<vtkPolyData> spherePolyData;
+      CreateSpherePolyData(spherePolyData, sphereCenters[sphereIndex], sphereRadii[sphereIndex]);
+      vtkNew<vtkSegment> segment;
+      segment->AddRepresentation(vtkSegmentationConverter::GetSegmentationClosedSurfaceRepresentationName(), spherePolyData);
+      segmentation->AddSegment(segment, "sphere" + std::to_string(sphereIndex));
+      }
+    SetReferenceGeometry(segmentation);
+    }
+
+  vtkNew<vtkClosedSurfaceToBinaryLabelmapConversionRule> rule;
+  rule->SetConversionParameter(vtkSegmentationConverter::GetReferenceImageGeometryParameterName(),
+    serialSegmentation->GetConversionParameter(vtkSegmentationConverter::GetReferenceImageGeometryParameterName()));
+  if (!rule->IsThreadSafe())
+    {
+    std::cerr << __LINE__ << ": Closed surface to binary labelmap conversion rule is expected to be thread-safe" << std::endl;
+    return false;
+    }
+
+  // Serial conversion, as in vtkSegmentation::ConvertSegmentsUsingPath
+  rule->PreConvert(serialSegmentation);
+  std::vector<vtkSegment*> parallelSegments;
+  for (int segmentIndex = 0; segmentIndex < serialSegmentation->GetNumberOfSegments(); ++segmentIndex)
+    {
+    rule->Convert(serialSegmentation->GetNthSegment(segmentIndex));
+    parallelSegments.push_back(parallelSegmentation->GetNthSegment(segmentIndex));
+    }
+  rule->PostConvert(serialSegmentation);
+
+  if (!vtkSegmentationConverter::ConvertSegmentsInParallel(rule, parallelSegmentation, parallelSegments))
+    {
+    std::cerr << __LINE__ << ": Parallel conversion failed" << std::endl;
+    return false;
+    }
+
+  std::string labelmapName = vtkSegmentationConverter::GetBinaryLabelmapRepresentationName();
+  int numberOfSerialLayers = serialSegmentation->GetNumberOfLayers(labelmapName);
+  int numberOfParallelLayers = parallelSegmentation->GetNumberOfLayers(labelmapName);
+  if (numberOfSerialLayers != 2 || numberOfParallelLayers != numberOfSerialLayers)
+    {
+    std::cerr << __LINE__ << ": Invalid number of binary labelmap layers after parallel conversion " << numberOfParallelLayers
+      << ", serial conversion " << numberOfSerialLayers << ", should be 2" << std::endl;
+    return false;
+    }
+  for (int segmentIndex = 0; segmentIndex < serialSegmentation->GetNumberOfSegments(); ++segmentIndex)
+    {
+    std::string segmentId = serialSegmentation->GetNthSegmentID(segmentIndex);
+    vtkSegment* serialSegment = serialSegmentation->GetSegment(segmentId);
+    vtkSegment* parallelSegment = parallelSegmentation->GetSegment(segmentId);
+    if (!parallelSegment
+      || parallelSegmentation->GetLayerIndex(segmentId, labelmapName) != serialSegmentation->GetLayerIndex(segmentId, labelmapName)
+      || parallelSegment->GetLabelValue() != serialSegment->GetLabelValue())
+      {
+      std::cerr << __LINE__ << ": Layer or label value of segment " << segmentId
+        << " differs between parallel and serial conversion" << std::endl;
+      return false;
+      }
+    int numberOfSerialVoxels = GetNumberOfVoxelsWithLabel(
+      vtkOrientedImageData::SafeDownCast(serialSegment->GetRepresentation(labelmapName)), serialSegment->GetLabelValue());
+    int numberOfParallelVoxels = GetNumberOfVoxelsWithLabel(
+      vtkOrientedImageData::SafeDownCast(parallelSegment->GetRepresentation(labelmapName)), parallelSegment->GetLabelValue());
+    if (numberOfSerialVoxels == 0 || numberOfParallelVoxels != numberOfSerialVoxels)
+      {
+      std::cerr << __LINE__ << ": Number of voxels of segment " << segmentId << " after parallel conversion "
+        << numberOfParallelVoxels << ", serial conversion " << numberOfSerialVoxels << std::endl;
+      return false;
+      }
+    }
+
+  return true;
+}
+
 //----------------------------------------------------------------------------
 int vtkSegmentationTest2(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
 {
@@ -338,6 +625,26 @@ int vtkSegmentationTest2(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
     return EXIT_FAILURE;
     }
 
+  if (!TestSharedLabelmapMinimum())
+    {
+    return EXIT_FAILURE;
+    }
+
+  if (!TestModifiedExtent())
+    {
+    return EXIT_FAILURE;
+    }
+
+  if (!TestIncrementalClosedSurfaceUpdate())
+    {
+    return EXIT_FAILURE;
+    }
+
+  if (!TestParallelConversion())
+    {
+    return EXIT_FAILURE;
+    }
+
   std::cout << "Segmentation test 2 passed." << std::endl;
   return EXIT_SUCCESS;
 }
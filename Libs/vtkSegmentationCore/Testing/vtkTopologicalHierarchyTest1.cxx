@@ -0,0 +1,93 @@
+/*==============================================================================
+
+  Copyright (c) Laboratory for Percutaneous Surgery (PerkLab)
+  Queen's University, Kingston, ON, Canada. All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VTK includes
+#include <vtkIntArray.h>
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataCollection.h>
+#include <vtkSphereSource.h>
+
+// SegmentationCore includes
+#include "vtkTopologicalHierarchy.h"
+
+// STD includes
+#include <iostream>
+
+namespace
+{
+void AddSphere(vtkPolyDataCollection* collection, double x, double y, double z, double radius)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(x, y, z);
+  sphere->SetRadius(radius);
+  sphere->Update();
+  collection->AddItem(sphere->GetOutput());
+}
+}
+
+//----------------------------------------------------------------------------
+int vtkTopologicalHierarchyTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkPolyDataCollection> polyDataCollection;
+  // Three nested spheres, added in random order
+  AddSphere(polyDataCollection, 0.0, 0.0, 0.0, 20.0); // 0: middle
+  AddSphere(polyDataCollection, 0.0, 0.0, 0.0, 5.0); // 1: inner
+  AddSphere(polyDataCollection, 0.0, 0.0, 0.0, 50.0); // 2: outer
+  // Separate sphere inside the outer sphere
+  AddSphere(polyDataCollection, 30.0, 0.0, 0.0, 5.0); // 3
+  // Separate sphere, not inside any other
+  AddSphere(polyDataCollection, 200.0, 0.0, 0.0, 10.0); // 4
+
+  vtkNew<vtkTopologicalHierarchy> topologicalHierarchy;
+  topologicalHierarchy->SetInputPolyDataCollection(polyDataCollection);
+  topologicalHierarchy->Update();
+  vtkIntArray* levels = topologicalHierarchy->GetOutputLevels();
+
+  const int expectedLevels[5] = { 1, 0, 2, 0, 0 };
+  if (levels->GetNumberOfTuples() != 5)
+    {
+    std::cerr << "Invalid number of output levels: " << levels->GetNumberOfTuples() << std::endl;
+    return EXIT_FAILURE;
+    }
+  for (int i = 0; i < 5; ++i)
+    {
+    if (levels->GetValue(i) != expectedLevels[i])
+      {
+      std::cerr << "Invalid level for polydata " << i << ": " << levels->GetValue(i)
+        << " (expected " << expectedLevels[i] << ")" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // With a large gap required between outer and inner polydata, the inner sphere
+  // is still contained in the middle and outer ones, but the middle one is not contained in the outer one.
+  topologicalHierarchy->SetContainConstraintFactor(0.35);
+  topologicalHierarchy->Update();
+  const int expectedLevelsWithGap[5] = { 1, 0, 1, 0, 0 };
+  for (int i = 0; i < 5; ++i)
+    {
+    if (levels->GetValue(i) != expectedLevelsWithGap[i])
+      {
+      std::cerr << "Invalid level with gap for polydata " << i << ": " << levels->GetValue(i)
+        << " (expected " << expectedLevelsWithGap[i] << ")" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  std::cout << "Topological hierarchy test passed" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -61,6 +61,71 @@
 #include <vtkInformation.h>
 #include <vtkExtractSelection.h>
 #include <vtkSelectionSource.h>
+#include <vtkCellArray.h>
+#include <vtkDoubleArray.h>
+#include <vtkPoints.h>
+
+namespace
+{
+
+/// Size of blocks (in voxels along each axis) that are updated independently in incremental update mode
+const int INCREMENTAL_UPDATE_BLOCK_SIZE = 32;
+/// Number of voxels around blocks that are used for generating the block surface in incremental update mode
+const int INCREMENTAL_UPDATE_BLOCK_MARGIN = 8;
+/// Point data array that stores point positions before smoothing, used for merging block surfaces
+const char* ORIGINAL_POSITION_ARRAY_NAME = "OriginalPosition";
+
+//----------------------------------------------------------------------------
+int GetBlockIndex(int voxelIndex)
+{
+  // Integer division rounding towards negative infinity
+  if (voxelIndex >= 0)
+    {
+    return voxelIndex / INCREMENTAL_UPDATE_BLOCK_SIZE;
+    }
+  return -((-voxelIndex + INCREMENTAL_UPDATE_BLOCK_SIZE - 1) / INCREMENTAL_UPDATE_BLOCK_SIZE);
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> DecimateSurface(vtkPolyData* surface, double decimationFactor, bool preserveBoundary)
+{
+  vtkSmartPointer<vtkDecimatePro> decimator = vtkSmartPointer<vtkDecimatePro>::New();
+  decimator->SetInputData(surface);
+  decimator->SetFeatureAngle(60);
+  decimator->SplittingOff();
+  decimator->PreserveTopologyOn();
+  decimator->SetMaximumError(1);
+  decimator->SetTargetReduction(decimationFactor);
+  if (preserveBoundary)
+    {
+    decimator->BoundaryVertexDeletionOff();
+    }
+  decimator->Update();
+  return decimator->GetOutput();
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> SmoothSurface(vtkPolyData* surface, double smoothingFactor)
+{
+  vtkSmartPointer<vtkWindowedSincPolyDataFilter> smoother = vtkSmartPointer<vtkWindowedSincPolyDataFilter>::New();
+  smoother->SetInputData(surface);
+  smoother->SetNumberOfIterations(20); // based on VTK documentation ("Ten or twenty iterations is all the is usually necessary")
+  // This formula maps:
+  // 0.0  -> 1.0   (almost no smoothing)
+  // 0.25 -> 0.1   (average smoothing)
+  // 0.5  -> 0.01  (more smoothing)
+  // 1.0  -> 0.001 (very strong smoothing)
+  double passBand = pow(10.0, -4.0 * smoothingFactor);
+  smoother->SetPassBand(passBand);
+  smoother->BoundarySmoothingOff();
+  smoother->FeatureEdgeSmoothingOff();
+  smoother->NonManifoldSmoothingOn();
+  smoother->NormalizeCoordinatesOn();
+  smoother->Update();
+  return smoother->GetOutput();
+}
+
+}
 
 //----------------------------------------------------------------------------
 const std::string vtkBinaryLabelmapToClosedSurfaceConversionRule::CONVERSION_METHOD_FLYING_EDGES = std::string("0");
@@ -88,11 +153,21 @@ vtkBinaryLabelmapToClosedSurfaceConversionRule::vtkBinaryLabelmapToClosedSurface
     "1 = Smoothing done in surface nets filter.");
   this->ConversionParameters->SetParameter(GetJointSmoothingParameterName(), "0",
     "Perform joint smoothing.");
+  this->ConversionParameters->SetParameter(GetIncrementalUpdateParameterName(), "0",
+    "Incremental update. 0 (default) = the entire surface is regenerated after each change. "
+    "1 = only the parts of the surface near the modified region of the labelmap are regenerated. "
+    "Not used if joint smoothing or SurfaceNets smoothing is enabled.");
 }
 
 //----------------------------------------------------------------------------
 vtkBinaryLabelmapToClosedSurfaceConversionRule::~vtkBinaryLabelmapToClosedSurfaceConversionRule() = default;
 
+//----------------------------------------------------------------------------
+bool vtkBinaryLabelmapToClosedSurfaceConversionRule::IsThreadSafe()
+{
+  return this->ConversionParameters->GetValueAsInt(GetIncrementalUpdateParameterName()) == 0;
+}
+
 //----------------------------------------------------------------------------
 unsigned int vtkBinaryLabelmapToClosedSurfaceConversionRule::GetConversionCost(
     vtkDataObject* vtkNotUsed(sourceRepresentation)/*=nullptr*/,
@@ -218,6 +293,11 @@ bool vtkBinaryLabelmapToClosedSurfaceConversionRule::Convert(vtkSegment* segment
     vtkPolyData* thresholdedSurface = geometry->GetOutput();
     closedSurfacePolyData->ShallowCopy(thresholdedSurface);
     }
+  else if (this->ConversionParameters->GetValueAsInt(GetIncrementalUpdateParameterName()) > 0
+    && this->ConversionParameters->GetValueAsInt(GetSurfaceNetInternalSmoothingParameterName()) == 0)
+    {
+    this->CreateClosedSurfaceIncremental(orientedBinaryLabelmap, closedSurfacePolyData, segment->GetLabelValue());
+    }
   else
     {
     std::vector<int> labelValue = { segment->GetLabelValue() };
@@ -296,7 +376,45 @@ bool vtkBinaryLabelmapToClosedSurfaceConversionRule::CreateClosedSurface(vtkOrie
   // Get conversion parameters
   double decimationFactor = this->ConversionParameters->GetValueAsDouble(GetDecimationFactorParameterName());
   double smoothingFactor = this->ConversionParameters->GetValueAsDouble(GetSmoothingFactorParameterName());
-  int computeSurfaceNormals = this->ConversionParameters->GetValueAsInt(GetComputeSurfaceNormalsParameterName());
+
+  // SurfaceNetInternalSmoothing
+  // 0 = use vtkWindowedSincPolyDataFilter
+  // 1 = use surface nets internal smoothing filter (vtkConstrainedSmoothingFilter)
+  int surfaceNetsSmoothing = this->ConversionParameters->GetValueAsInt(GetSurfaceNetInternalSmoothingParameterName());
+
+  vtkSmartPointer<vtkPolyData> processingResult = vtkSmartPointer<vtkPolyData>::New();
+  if (!this->ExtractSurface(binaryLabelmapWithIdentityGeometry, labelValues, processingResult))
+    {
+    return false;
+    }
+
+  if (processingResult->GetNumberOfPolys() == 0)
+    {
+    vtkDebugMacro("Convert: No polygons can be created, probably all voxels are empty");
+    closedSurfacePolyData->Initialize();
+    return true;
+    }
+
+  // Decimate
+  if (decimationFactor > 0.0)
+    {
+    processingResult = DecimateSurface(processingResult, decimationFactor, false);
+    }
+
+  if (smoothingFactor > 0 && surfaceNetsSmoothing == 0)
+    {
+    processingResult = SmoothSurface(processingResult, smoothingFactor);
+    }
+
+  this->TransformSurfaceToWorld(processingResult, orientedBinaryLabelmap, closedSurfacePolyData);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkBinaryLabelmapToClosedSurfaceConversionRule::ExtractSurface(vtkImageData* binaryLabelmapWithIdentityGeometry,
+  std::vector<int> labelValues, vtkPolyData* surface)
+{
+  double smoothingFactor = this->ConversionParameters->GetValueAsDouble(GetSmoothingFactorParameterName());
 
   // Conversion method
   std::string conversionMethod = this->ConversionParameters->GetValue(GetConversionMethodParameterName());
@@ -306,8 +424,7 @@ bool vtkBinaryLabelmapToClosedSurfaceConversionRule::CreateClosedSurface(vtkOrie
   // 1 = use surface nets internal smoothing filter (vtkConstrainedSmoothingFilter)
   int surfaceNetsSmoothing = this->ConversionParameters->GetValueAsInt(GetSurfaceNetInternalSmoothingParameterName());
 
-  vtkSmartPointer<vtkPolyData> processingResult = vtkSmartPointer<vtkPolyData>::New();
-
+  surface->Initialize();
   if (conversionMethod == vtkBinaryLabelmapToClosedSurfaceConversionRule::CONVERSION_METHOD_FLYING_EDGES)
     {
     vtkNew<vtkDiscreteFlyingEdges3D> flyingEdges;
@@ -331,7 +448,7 @@ bool vtkBinaryLabelmapToClosedSurfaceConversionRule::CreateClosedSurface(vtkOrie
       vtkErrorMacro("Convert: Error while running flying edges!");
       return false;
       }
-    processingResult = flyingEdges->GetOutput();
+    surface->ShallowCopy(flyingEdges->GetOutput());
     }
   else if (conversionMethod == vtkBinaryLabelmapToClosedSurfaceConversionRule::CONVERSION_METHOD_SURFACE_NETS)
     {
@@ -372,60 +489,21 @@ bool vtkBinaryLabelmapToClosedSurfaceConversionRule::CreateClosedSurface(vtkOrie
       vtkErrorMacro("Convert: Error while running surface nets!");
       return false;
       }
-    processingResult = surfaceNets->GetOutput();
+    surface->ShallowCopy(surfaceNets->GetOutput());
     }
   else
     {
     vtkErrorMacro("Conversion Rule: Unknown surface generation method");
     }
+  return true;
+}
 
-  vtkSmartPointer<vtkPolyData> convertedSegment = vtkSmartPointer<vtkPolyData>::New();
-
-  if (processingResult->GetNumberOfPolys() == 0)
-    {
-    vtkDebugMacro("Convert: No polygons can be created, probably all voxels are empty");
-    convertedSegment = nullptr;
-    closedSurfacePolyData->Initialize();
-    }
-
-  if (!convertedSegment)
-    {
-    return true;
-    }
-
-  // Decimate
-  if (decimationFactor > 0.0)
-    {
-    vtkSmartPointer<vtkDecimatePro> decimator = vtkSmartPointer<vtkDecimatePro>::New();
-    decimator->SetInputData(processingResult);
-    decimator->SetFeatureAngle(60);
-    decimator->SplittingOff();
-    decimator->PreserveTopologyOn();
-    decimator->SetMaximumError(1);
-    decimator->SetTargetReduction(decimationFactor);
-    decimator->Update();
-    processingResult = decimator->GetOutput();
-    }
-
-  if (smoothingFactor > 0 && surfaceNetsSmoothing == 0)
-    {
-    vtkSmartPointer<vtkWindowedSincPolyDataFilter> smoother = vtkSmartPointer<vtkWindowedSincPolyDataFilter>::New();
-    smoother->SetInputData(processingResult);
-    smoother->SetNumberOfIterations(20); // based on VTK documentation ("Ten or twenty iterations is all the is usually necessary")
-    // This formula maps:
-    // 0.0  -> 1.0   (almost no smoothing)
-    // 0.25 -> 0.1   (average smoothing)
-    // 0.5  -> 0.01  (more smoothing)
-    // 1.0  -> 0.001 (very strong smoothing)
-    double passBand = pow(10.0, -4.0 * smoothingFactor);
-    smoother->SetPassBand(passBand);
-    smoother->BoundarySmoothingOff();
-    smoother->FeatureEdgeSmoothingOff();
-    smoother->NonManifoldSmoothingOn();
-    smoother->NormalizeCoordinatesOn();
-    smoother->Update();
-    processingResult = smoother->GetOutput();
-    }
+//----------------------------------------------------------------------------
+void vtkBinaryLabelmapToClosedSurfaceConversionRule::TransformSurfaceToWorld(vtkPolyData* surface,
+  vtkOrientedImageData* orientedBinaryLabelmap, vtkPolyData* closedSurfacePolyData)
+{
+  int computeSurfaceNormals = this->ConversionParameters->GetValueAsInt(GetComputeSurfaceNormalsParameterName());
+  std::string conversionMethod = this->ConversionParameters->GetValue(GetConversionMethodParameterName());
 
   // Transform the result surface from labelmap IJK to world coordinate system
   vtkSmartPointer<vtkTransform> labelmapGeometryTransform = vtkSmartPointer<vtkTransform>::New();
@@ -434,9 +512,10 @@ bool vtkBinaryLabelmapToClosedSurfaceConversionRule::CreateClosedSurface(vtkOrie
   labelmapGeometryTransform->SetMatrix(labelmapImageToWorldMatrix);
 
   vtkSmartPointer<vtkTransformPolyDataFilter> transformPolyDataFilter = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
-  transformPolyDataFilter->SetInputData(processingResult);
+  transformPolyDataFilter->SetInputData(surface);
   transformPolyDataFilter->SetTransform(labelmapGeometryTransform);
 
+  vtkSmartPointer<vtkPolyData> convertedSegment = vtkSmartPointer<vtkPolyData>::New();
   if (computeSurfaceNormals > 0 && conversionMethod == vtkBinaryLabelmapToClosedSurfaceConversionRule::CONVERSION_METHOD_FLYING_EDGES)
     {
     vtkSmartPointer<vtkPolyDataNormals> polyDataNormals = vtkSmartPointer<vtkPolyDataNormals>::New();
@@ -455,6 +534,334 @@ bool vtkBinaryLabelmapToClosedSurfaceConversionRule::CreateClosedSurface(vtkOrie
     }
 
   closedSurfacePolyData->ShallowCopy(convertedSegment);
+}
+
+//----------------------------------------------------------------------------
+bool vtkBinaryLabelmapToClosedSurfaceConversionRule::CreateClosedSurfaceIncremental(vtkOrientedImageData* orientedBinaryLabelmap,
+  vtkPolyData* closedSurfacePolyData, int labelValue)
+{
+  if (!closedSurfacePolyData)
+    {
+    vtkErrorMacro("Convert: Target representation is not poly data");
+    return false;
+    }
+  if (!orientedBinaryLabelmap)
+    {
+    vtkErrorMacro("Convert: Source representation is not oriented image data");
+    return false;
+    }
+
+  // Remove cached surfaces of labelmaps that have been deleted
+  for (IncrementalSurfaceCacheMap::iterator cacheIt = this->IncrementalSurfaceCaches.begin(); cacheIt != this->IncrementalSurfaceCaches.end();)
+    {
+    if (cacheIt->second.Labelmap.GetPointer() == nullptr)
+      {
+      cacheIt = this->IncrementalSurfaceCaches.erase(cacheIt);
+      }
+    else
+      {
+      ++cacheIt;
+      }
+    }
+
+  // All blocks have to be updated if any of the parameters that affect block surfaces have changed
+  std::string parameters = this->ConversionParameters->GetValue(GetDecimationFactorParameterName())
+    + ";" + this->ConversionParameters->GetValue(GetSmoothingFactorParameterName())
+    + ";" + this->ConversionParameters->GetValue(GetConversionMethodParameterName());
+
+  IncrementalSurfaceCache& cache = this->IncrementalSurfaceCaches[std::make_pair(orientedBinaryLabelmap, labelValue)];
+  int modifiedExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  bool fullUpdate = (cache.Labelmap.GetPointer() != orientedBinaryLabelmap || cache.Parameters != parameters
+    || !orientedBinaryLabelmap->GetModifiedExtent(cache.LabelmapMTime, modifiedExtent));
+  if (fullUpdate)
+    {
+    cache.Blocks.clear();
+    cache.Labelmap = orientedBinaryLabelmap;
+    cache.Parameters = parameters;
+    }
+  cache.LabelmapMTime = orientedBinaryLabelmap->GetMTime();
+
+  if (orientedBinaryLabelmap->IsEmpty())
+    {
+    vtkDebugMacro("Convert: No polygons can be created, input image extent is empty");
+    cache.Blocks.clear();
+    closedSurfacePolyData->Initialize();
+    return true;
+    }
+
+  // Blocks are processed in IJK space, the whole transform is applied on the merged surface
+  vtkSmartPointer<vtkImageData> binaryLabelmapWithIdentityGeometry = vtkSmartPointer<vtkImageData>::New();
+  binaryLabelmapWithIdentityGeometry->ShallowCopy(orientedBinaryLabelmap);
+  binaryLabelmapWithIdentityGeometry->SetOrigin(0, 0, 0);
+  binaryLabelmapWithIdentityGeometry->SetSpacing(1.0, 1.0, 1.0);
+
+  // Surface cells are generated between neighbor voxels, including the background voxels around the labelmap.
+  // A cell belongs to the block that contains the lowest index voxel of the cell.
+  int extent[6] = { 0, -1, 0, -1, 0, -1 };
+  orientedBinaryLabelmap->GetExtent(extent);
+  int firstBlockIndex[3] = { 0, 0, 0 };
+  int lastBlockIndex[3] = { 0, 0, 0 };
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    firstBlockIndex[axis] = GetBlockIndex(extent[axis * 2] - 1);
+    lastBlockIndex[axis] = GetBlockIndex(extent[axis * 2 + 1]);
+    }
+
+  // Remove blocks that are outside the labelmap
+  for (IncrementalSurfaceCache::BlockMap::iterator blockIt = cache.Blocks.begin(); blockIt != cache.Blocks.end();)
+    {
+    bool blockInLabelmap = true;
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      if (blockIt->first[axis] < firstBlockIndex[axis] || blockIt->first[axis] > lastBlockIndex[axis])
+        {
+        blockInLabelmap = false;
+        break;
+        }
+      }
+    if (blockInLabelmap)
+      {
+      ++blockIt;
+      }
+    else
+      {
+      blockIt = cache.Blocks.erase(blockIt);
+      }
+    }
+
+  // Update blocks that are affected by the modified voxels
+  for (int k = firstBlockIndex[2]; k <= lastBlockIndex[2]; ++k)
+    {
+    for (int j = firstBlockIndex[1]; j <= lastBlockIndex[1]; ++j)
+      {
+      for (int i = firstBlockIndex[0]; i <= lastBlockIndex[0]; ++i)
+        {
+        std::array<int, 3> blockIndex = { i, j, k };
+        int blockExtent[6] = { 0, -1, 0, -1, 0, -1 };
+        for (int axis = 0; axis < 3; ++axis)
+          {
+          blockExtent[axis * 2] = blockIndex[axis] * INCREMENTAL_UPDATE_BLOCK_SIZE;
+          blockExtent[axis * 2 + 1] = blockExtent[axis * 2] + INCREMENTAL_UPDATE_BLOCK_SIZE - 1;
+          }
+        if (!fullUpdate && cache.Blocks.find(blockIndex) != cache.Blocks.end())
+          {
+          // Surface of the block depends on all voxels within the block margin
+          bool blockModified = true;
+          for (int axis = 0; axis < 3; ++axis)
+            {
+            if (modifiedExtent[axis * 2] > blockExtent[axis * 2 + 1] + 1 + INCREMENTAL_UPDATE_BLOCK_MARGIN
+              || modifiedExtent[axis * 2 + 1] < blockExtent[axis * 2] - INCREMENTAL_UPDATE_BLOCK_MARGIN)
+              {
+              blockModified = false;
+              break;
+              }
+            }
+          if (!blockModified)
+            {
+            continue;
+            }
+          }
+        vtkSmartPointer<vtkPolyData> blockSurface = vtkSmartPointer<vtkPolyData>::New();
+        if (!this->CreateClosedSurfaceBlock(binaryLabelmapWithIdentityGeometry, blockExtent, labelValue, blockSurface))
+          {
+          cache.Blocks.clear();
+          cache.Labelmap = nullptr;
+          return false;
+          }
+        cache.Blocks[blockIndex] = blockSurface;
+        }
+      }
+    }
+
+  // Merge block surfaces. Points that are shared between neighbor blocks are identified by their position before smoothing.
+  vtkNew<vtkPoints> mergedPoints;
+  vtkNew<vtkCellArray> mergedPolys;
+  std::map<std::array<double, 3>, vtkIdType> mergedPointIds;
+  for (IncrementalSurfaceCache::BlockMap::iterator blockIt = cache.Blocks.begin(); blockIt != cache.Blocks.end(); ++blockIt)
+    {
+    vtkPolyData* blockSurface = blockIt->second;
+    if (!blockSurface || blockSurface->GetNumberOfPolys() == 0)
+      {
+      continue;
+      }
+    vtkDataArray* originalPositions = blockSurface->GetPointData()->GetArray(ORIGINAL_POSITION_ARRAY_NAME);
+    std::vector<vtkIdType> mergedPointIdsInBlock(blockSurface->GetNumberOfPoints());
+    for (vtkIdType pointId = 0; pointId < blockSurface->GetNumberOfPoints(); ++pointId)
+      {
+      std::array<double, 3> originalPosition = { 0.0, 0.0, 0.0 };
+      if (originalPositions)
+        {
+        originalPositions->GetTuple(pointId, originalPosition.data());
+        }
+      else
+        {
+        blockSurface->GetPoint(pointId, originalPosition.data());
+        }
+      std::map<std::array<double, 3>, vtkIdType>::iterator mergedPointIt = mergedPointIds.find(originalPosition);
+      if (mergedPointIt == mergedPointIds.end())
+        {
+        mergedPointIt = mergedPointIds.insert(std::make_pair(originalPosition, mergedPoints->InsertNextPoint(blockSurface->GetPoint(pointId)))).first;
+        }
+      mergedPointIdsInBlock[pointId] = mergedPointIt->second;
+      }
+    vtkCellArray* blockPolys = blockSurface->GetPolys();
+    vtkIdType numberOfCellPoints = 0;
+    const vtkIdType* cellPointIds = nullptr;
+    std::vector<vtkIdType> mergedCellPointIds;
+    blockPolys->InitTraversal();
+    while (blockPolys->GetNextCell(numberOfCellPoints, cellPointIds))
+      {
+      mergedCellPointIds.resize(numberOfCellPoints);
+      for (vtkIdType cellPointIndex = 0; cellPointIndex < numberOfCellPoints; ++cellPointIndex)
+        {
+        mergedCellPointIds[cellPointIndex] = mergedPointIdsInBlock[cellPointIds[cellPointIndex]];
+        }
+      mergedPolys->InsertNextCell(numberOfCellPoints, mergedCellPointIds.data());
+      }
+    }
+
+  if (mergedPolys->GetNumberOfCells() == 0)
+    {
+    vtkDebugMacro("Convert: No polygons can be created, probably all voxels are empty");
+    closedSurfacePolyData->Initialize();
+    return true;
+    }
+
+  vtkNew<vtkPolyData> mergedSurface;
+  mergedSurface->SetPoints(mergedPoints);
+  mergedSurface->SetPolys(mergedPolys);
+  this->TransformSurfaceToWorld(mergedSurface, orientedBinaryLabelmap, closedSurfacePolyData);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkBinaryLabelmapToClosedSurfaceConversionRule::CreateClosedSurfaceBlock(vtkImageData* binaryLabelmapWithIdentityGeometry,
+  const int blockExtent[6], int labelValue, vtkPolyData* blockSurface)
+{
+  double decimationFactor = this->ConversionParameters->GetValueAsDouble(GetDecimationFactorParameterName());
+  double smoothingFactor = this->ConversionParameters->GetValueAsDouble(GetSmoothingFactorParameterName());
+
+  blockSurface->Initialize();
+
+  // Extract the surface from the block and a margin around it, so that smoothing of the block is
+  // not affected by the block boundary. Voxels outside the labelmap are considered as background.
+  int marginExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    marginExtent[axis * 2] = blockExtent[axis * 2] - INCREMENTAL_UPDATE_BLOCK_MARGIN;
+    marginExtent[axis * 2 + 1] = blockExtent[axis * 2 + 1] + 1 + INCREMENTAL_UPDATE_BLOCK_MARGIN;
+    }
+  vtkNew<vtkImageConstantPad> padder;
+  padder->SetInputData(binaryLabelmapWithIdentityGeometry);
+  padder->SetOutputWholeExtent(marginExtent);
+  padder->SetConstant(0);
+  padder->Update();
+
+  std::vector<int> labelValues = { labelValue };
+  vtkSmartPointer<vtkPolyData> processingResult = vtkSmartPointer<vtkPolyData>::New();
+  if (!this->ExtractSurface(padder->GetOutput(), labelValues, processingResult))
+    {
+    return false;
+    }
+  if (processingResult->GetNumberOfPolys() == 0)
+    {
+    return true;
+    }
+
+  // Store point positions before smoothing, they are used for finding matching points in neighbor blocks
+  vtkNew<vtkDoubleArray> extractedPositions;
+  extractedPositions->SetName(ORIGINAL_POSITION_ARRAY_NAME);
+  extractedPositions->SetNumberOfComponents(3);
+  extractedPositions->SetNumberOfTuples(processingResult->GetNumberOfPoints());
+  for (vtkIdType pointId = 0; pointId < processingResult->GetNumberOfPoints(); ++pointId)
+    {
+    extractedPositions->SetTuple(pointId, processingResult->GetPoint(pointId));
+    }
+  processingResult->GetPointData()->Initialize();
+  processingResult->GetPointData()->AddArray(extractedPositions);
+
+  vtkDataArray* originalPositions = extractedPositions;
+  if (smoothingFactor > 0)
+    {
+    processingResult = SmoothSurface(processingResult, smoothingFactor);
+    originalPositions = processingResult->GetPointData()->GetArray(ORIGINAL_POSITION_ARRAY_NAME);
+    if (!originalPositions)
+      {
+      vtkErrorMacro("CreateClosedSurfaceBlock: Point positions are lost during smoothing");
+      return false;
+      }
+    }
+
+  // Keep only cells that belong to this block
+  vtkNew<vtkPoints> blockPoints;
+  vtkNew<vtkDoubleArray> blockOriginalPositions;
+  blockOriginalPositions->SetName(ORIGINAL_POSITION_ARRAY_NAME);
+  blockOriginalPositions->SetNumberOfComponents(3);
+  vtkNew<vtkCellArray> blockPolys;
+  std::vector<vtkIdType> blockPointIds(processingResult->GetNumberOfPoints(), -1);
+  vtkCellArray* polys = processingResult->GetPolys();
+  vtkIdType numberOfCellPoints = 0;
+  const vtkIdType* cellPointIds = nullptr;
+  std::vector<vtkIdType> blockCellPointIds;
+  polys->InitTraversal();
+  while (polys->GetNextCell(numberOfCellPoints, cellPointIds))
+    {
+    if (numberOfCellPoints == 0)
+      {
+      continue;
+      }
+    double cellCenter[3] = { 0.0, 0.0, 0.0 };
+    for (vtkIdType cellPointIndex = 0; cellPointIndex < numberOfCellPoints; ++cellPointIndex)
+      {
+      double* position = originalPositions->GetTuple3(cellPointIds[cellPointIndex]);
+      cellCenter[0] += position[0];
+      cellCenter[1] += position[1];
+      cellCenter[2] += position[2];
+      }
+    bool cellInBlock = true;
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      int voxelIndex = static_cast<int>(floor(cellCenter[axis] / numberOfCellPoints));
+      if (voxelIndex < blockExtent[axis * 2] || voxelIndex > blockExtent[axis * 2 + 1])
+        {
+        cellInBlock = false;
+        break;
+        }
+      }
+    if (!cellInBlock)
+      {
+      continue;
+      }
+    blockCellPointIds.resize(numberOfCellPoints);
+    for (vtkIdType cellPointIndex = 0; cellPointIndex < numberOfCellPoints; ++cellPointIndex)
+      {
+      vtkIdType pointId = cellPointIds[cellPointIndex];
+      if (blockPointIds[pointId] < 0)
+        {
+        blockPointIds[pointId] = blockPoints->InsertNextPoint(processingResult->GetPoint(pointId));
+        blockOriginalPositions->InsertNextTuple(originalPositions->GetTuple3(pointId));
+        }
+      blockCellPointIds[cellPointIndex] = blockPointIds[pointId];
+      }
+    blockPolys->InsertNextCell(numberOfCellPoints, blockCellPointIds.data());
+    }
+  if (blockPolys->GetNumberOfCells() == 0)
+    {
+    return true;
+    }
+
+  vtkSmartPointer<vtkPolyData> blockResult = vtkSmartPointer<vtkPolyData>::New();
+  blockResult->SetPoints(blockPoints);
+  blockResult->SetPolys(blockPolys);
+  blockResult->GetPointData()->AddArray(blockOriginalPositions);
+
+  // Decimate. Points on the block boundary are kept to allow merging with neighbor blocks.
+  if (decimationFactor > 0.0)
+    {
+    blockResult = DecimateSurface(blockResult, decimationFactor, true);
+    }
+
+  blockSurface->ShallowCopy(blockResult);
   return true;
 }
 
@@ -24,11 +24,17 @@
 // SegmentationCore includes
 #include "vtkSegmentationConverterRule.h"
 #include "vtkSegmentationConverter.h"
+#include "vtkOrientedImageData.h"
 
 #include "vtkSegmentationCoreConfigure.h"
 
 // VTK includes
 #include <vtkPolyData.h>
+#include <vtkWeakPointer.h>
+
+// STD includes
+#include <array>
+#include <map>
 
 /// \brief Convert binary labelmap representation (vtkOrientedImageData type) to
 ///   closed surface representation (vtkPolyData type). The conversion algorithm
@@ -54,6 +60,10 @@ public:
   /// If joint smoothing is enabled, surfaces will be created and smoothed as one vtkPolyData.
   /// Joint smoothing converts all segments in shared labelmap together, reducing smoothing artifacts.
   static const std::string GetJointSmoothingParameterName() { return "Joint smoothing"; };
+  /// Conversion parameter: incremental update
+  /// If incremental update is enabled, the surface is generated in blocks and only the blocks
+  /// near the modified region of the labelmap (see vtkOrientedImageData::GetModifiedExtent) are regenerated.
+  static const std::string GetIncrementalUpdateParameterName() { return "Incremental update"; };
 
   // Conversion methods
   static const std::string CONVERSION_METHOD_FLYING_EDGES;
@@ -84,6 +94,10 @@ public:
   /// Clears the joint smoothing cache
   bool PostConvert(vtkSegmentation* segmentation) override;
 
+  /// Segments can be converted concurrently, except in incremental update mode
+  /// (the surface blocks are cached in the rule instance).
+  bool IsThreadSafe() override;
+
   /// Get the cost of the conversion.
   unsigned int GetConversionCost(vtkDataObject* sourceRepresentation=nullptr, vtkDataObject* targetRepresentation=nullptr) override;
 
@@ -101,6 +115,19 @@ protected:
   /// This function checks whether this is the case.
   bool IsLabelmapPaddingNecessary(vtkImageData* binaryLabelMap);
 
+  /// Create surface from an image that has identity geometry (IJK coordinates)
+  bool ExtractSurface(vtkImageData* binaryLabelmapWithIdentityGeometry, std::vector<int> labelValues, vtkPolyData* surface);
+
+  /// Transform surface from labelmap IJK to world coordinate system and compute surface normals
+  void TransformSurfaceToWorld(vtkPolyData* surface, vtkOrientedImageData* orientedBinaryLabelmap, vtkPolyData* closedSurfacePolyData);
+
+  /// Create closed surface by only regenerating surface blocks that are near the modified region of the labelmap
+  bool CreateClosedSurfaceIncremental(vtkOrientedImageData* orientedBinaryLabelmap, vtkPolyData* closedSurfacePolyData, int labelValue);
+
+  /// Create surface of a block of the labelmap in IJK coordinate system
+  bool CreateClosedSurfaceBlock(vtkImageData* binaryLabelmapWithIdentityGeometry, const int blockExtent[6], int labelValue,
+    vtkPolyData* blockSurface);
+
 protected:
   vtkBinaryLabelmapToClosedSurfaceConversionRule();
   ~vtkBinaryLabelmapToClosedSurfaceConversionRule() override;
@@ -110,6 +137,22 @@ protected:
   /// The key used is the binary labelmap representation, which maps to the combined vtkPolyData containing surfaces for all segments in the segmentation
   std::map<vtkOrientedImageData*, vtkSmartPointer<vtkPolyData> > JointSmoothCache;
 
+  /// Surface blocks that are kept between conversions for incremental update
+  struct IncrementalSurfaceCache
+    {
+    typedef std::map<std::array<int, 3>, vtkSmartPointer<vtkPolyData> > BlockMap;
+    vtkWeakPointer<vtkOrientedImageData> Labelmap;
+    /// Modified time of the labelmap when the blocks were last updated
+    vtkMTimeType LabelmapMTime{0};
+    /// Conversion parameters that were used for creating the blocks
+    std::string Parameters;
+    /// Surface of each block in IJK coordinate system (key: block index)
+    BlockMap Blocks;
+    };
+  /// The key used is the binary labelmap representation and the label value
+  typedef std::map<std::pair<vtkOrientedImageData*, int>, IncrementalSurfaceCache> IncrementalSurfaceCacheMap;
+  IncrementalSurfaceCacheMap IncrementalSurfaceCaches;
+
 private:
   vtkBinaryLabelmapToClosedSurfaceConversionRule(const vtkBinaryLabelmapToClosedSurfaceConversionRule&) = delete;
   void operator=(const vtkBinaryLabelmapToClosedSurfaceConversionRule&) = delete;
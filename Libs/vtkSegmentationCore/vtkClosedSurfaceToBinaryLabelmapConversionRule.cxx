@@ -36,14 +36,15 @@
 #include <vtkPolyData.h>
 #include <vtkTransform.h>
 #include <vtkTransformPolyDataFilter.h>
-#include <vtkImageCast.h>
-#include <vtkImageStencil.h>
+#include <vtkImageStencilData.h>
 #include <vtkPolyDataNormals.h>
+#include <vtkSMPTools.h>
 #include <vtkStripper.h>
 #include <vtkTriangleFilter.h>
 #include <vtkPolyDataToImageStencil.h>
 
 // STD includes
+#include <cstring>
 #include <sstream>
 
 int DEFAULT_LABEL_VALUE = 1;
@@ -219,28 +220,52 @@ bool vtkClosedSurfaceToBinaryLabelmapConversionRule::Convert(vtkSegment* segment
   vtkSmartPointer<vtkStripper> stripper=vtkSmartPointer<vtkStripper>::New();
   stripper->SetInputConnection(triangle->GetOutputPort());
 
-  // Convert polydata to stencil
-  vtkNew<vtkPolyDataToImageStencil> polyDataToImageStencil;
-  polyDataToImageStencil->SetInputConnection(stripper->GetOutputPort());
-  polyDataToImageStencil->SetOutputSpacing(binaryLabelmap->GetSpacing());
-  polyDataToImageStencil->SetOutputOrigin(binaryLabelmap->GetOrigin());
-  polyDataToImageStencil->SetOutputWholeExtent(binaryLabelmap->GetExtent());
-
-  // Convert stencil to image
-  vtkNew<vtkImageStencil> stencil;
-  stencil->SetInputData(binaryLabelmap);
-  stencil->SetStencilConnection(polyDataToImageStencil->GetOutputPort());
-  stencil->ReverseStencilOn();
+  stripper->Update();
+  vtkPolyData* closedSurfacePolyData_IJK = stripper->GetOutput();
+  // Build cells now, as the surface is accessed from multiple threads
+  closedSurfacePolyData_IJK->BuildCells();
+
+  // Convert polydata to stencil and fill the voxels inside the stencil.
+  // Slices are rasterized in parallel (each chunk of slices is processed by a separate stencil source)
+  // and the voxels are set directly in the output labelmap.
   // If the output labelmap was to required to be unsigned char, we could use the segment label value.
   // To ensure that the label value is < 255, we set it to 1. Collapsing the labelmaps during post-conversion may assign new a value regardless.
-  stencil->SetBackgroundValue(DEFAULT_LABEL_VALUE); // General foreground value is 1 (background value because of reverse stencil)
-
-  // Save result to output
-  vtkNew<vtkImageCast> imageCast;
-  imageCast->SetInputConnection(stencil->GetOutputPort());
-  imageCast->SetOutputScalarTypeToUnsignedChar();
-  imageCast->Update();
-  binaryLabelmap->ShallowCopy(imageCast->GetOutput());
+  int extent[6] = { 0, -1, 0, -1, 0, -1 };
+  binaryLabelmap->GetExtent(extent);
+  vtkIdType increments[3] = { 0, 0, 0 };
+  binaryLabelmap->GetIncrements(increments);
+  unsigned char* binaryLabelmapVoxels = static_cast<unsigned char*>(binaryLabelmapVoxelsPointer);
+  double* outputSpacing = binaryLabelmap->GetSpacing();
+  double* outputOrigin = binaryLabelmap->GetOrigin();
+  vtkSMPTools::For(extent[4], extent[5] + 1, [&](vtkIdType firstSlice, vtkIdType endSlice)
+    {
+    // Each thread uses its own shallow copy of the input, as the pipeline modifies information of its input data object
+    vtkNew<vtkPolyData> chunkClosedSurfacePolyData_IJK;
+    chunkClosedSurfacePolyData_IJK->ShallowCopy(closedSurfacePolyData_IJK);
+    int chunkExtent[6] = { extent[0], extent[1], extent[2], extent[3], static_cast<int>(firstSlice), static_cast<int>(endSlice - 1) };
+    vtkNew<vtkPolyDataToImageStencil> polyDataToImageStencil;
+    polyDataToImageStencil->SetInputData(chunkClosedSurfacePolyData_IJK);
+    polyDataToImageStencil->SetOutputSpacing(outputSpacing);
+    polyDataToImageStencil->SetOutputOrigin(outputOrigin);
+    polyDataToImageStencil->SetOutputWholeExtent(chunkExtent);
+    polyDataToImageStencil->Update();
+    vtkImageStencilData* stencilData = polyDataToImageStencil->GetOutput();
+    for (int k = chunkExtent[4]; k <= chunkExtent[5]; ++k)
+      {
+      for (int j = extent[2]; j <= extent[3]; ++j)
+        {
+        unsigned char* rowPtr = binaryLabelmapVoxels + (j - extent[2]) * increments[1] + (k - extent[4]) * increments[2];
+        int iter = 0;
+        int r1 = 0;
+        int r2 = -1;
+        while (stencilData->GetNextExtent(r1, r2, extent[0], extent[1], j, k, iter))
+          {
+          memset(rowPtr + (r1 - extent[0]), DEFAULT_LABEL_VALUE, r2 - r1 + 1);
+          }
+        }
+      }
+    });
+  binaryLabelmap->Modified();
 
   // Restore geometry of the labelmap that we set to identity before conversion
   // (so that we can perform the stencil operations in IJK space)
@@ -252,6 +277,12 @@ bool vtkClosedSurfaceToBinaryLabelmapConversionRule::Convert(vtkSegment* segment
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool vtkClosedSurfaceToBinaryLabelmapConversionRule::IsThreadSafe()
+{
+  return true;
+}
+
 //----------------------------------------------------------------------------
 bool vtkClosedSurfaceToBinaryLabelmapConversionRule::PostConvert(vtkSegmentation* segmentation)
 {
@@ -68,6 +68,9 @@ public:
   /// Collapses the segments to as few labelmaps as is possible
   bool PostConvert(vtkSegmentation* segmentation) override;
 
+  /// Segments can be converted concurrently, the rule does not store any state during conversion
+  bool IsThreadSafe() override;
+
   /// Get the cost of the conversion.
   unsigned int GetConversionCost(vtkDataObject* sourceRepresentation=nullptr, vtkDataObject* targetRepresentation=nullptr) override;
 
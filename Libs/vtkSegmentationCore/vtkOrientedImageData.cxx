@@ -44,6 +44,15 @@ vtkOrientedImageData::vtkOrientedImageData()
       this->Directions[i][j] = (i == j) ? 1.0 : 0.0;
       }
     }
+  for (i = 0; i < 6; i++)
+    {
+    this->ModifiedExtent[i] = (i % 2 == 0) ? 0 : -1;
+    this->CachedEffectiveExtent[i] = (i % 2 == 0) ? 0 : -1;
+    }
+  this->ModifiedExtentBaseMTime = 0;
+  this->ModifiedExtentMTime = 0;
+  this->CachedEffectiveExtentThreshold = 0.0;
+  this->CachedEffectiveExtentMTime = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -370,3 +379,53 @@ bool vtkOrientedImageData::IsEmpty()
     }
   return false;
 }
+
+//----------------------------------------------------------------------------
+void vtkOrientedImageData::SetModifiedExtent(const int modifiedExtent[6], vtkMTimeType baseMTime)
+{
+  std::copy(modifiedExtent, modifiedExtent + 6, this->ModifiedExtent);
+  this->ModifiedExtentBaseMTime = baseMTime;
+  this->ModifiedExtentMTime = this->GetMTime();
+}
+
+//----------------------------------------------------------------------------
+bool vtkOrientedImageData::GetModifiedExtent(vtkMTimeType sinceMTime, int modifiedExtent[6])
+{
+  vtkMTimeType mtime = this->GetMTime();
+  if (sinceMTime >= mtime)
+    {
+    // Not modified since the specified time
+    const int emptyExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    std::copy(emptyExtent, emptyExtent + 6, modifiedExtent);
+    return true;
+    }
+  if (mtime != this->ModifiedExtentMTime || sinceMTime < this->ModifiedExtentBaseMTime)
+    {
+    // The image has been modified without recording the modified region,
+    // or there were other modifications since the specified time.
+    this->GetExtent(modifiedExtent);
+    return false;
+    }
+  std::copy(this->ModifiedExtent, this->ModifiedExtent + 6, modifiedExtent);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkOrientedImageData::SetCachedEffectiveExtent(const int effectiveExtent[6], double threshold)
+{
+  std::copy(effectiveExtent, effectiveExtent + 6, this->CachedEffectiveExtent);
+  this->CachedEffectiveExtentThreshold = threshold;
+  this->CachedEffectiveExtentMTime = this->GetMTime();
+}
+
+//----------------------------------------------------------------------------
+bool vtkOrientedImageData::GetCachedEffectiveExtent(double threshold, int effectiveExtent[6], vtkMTimeType& cacheMTime)
+{
+  if (this->CachedEffectiveExtentMTime == 0 || this->CachedEffectiveExtentThreshold != threshold)
+    {
+    return false;
+    }
+  std::copy(this->CachedEffectiveExtent, this->CachedEffectiveExtent + 6, effectiveExtent);
+  cacheMTime = this->CachedEffectiveExtentMTime;
+  return true;
+}
@@ -86,6 +86,34 @@ public:
   /// Determines whether the image data is empty (if the extent has 0 voxels then it is)
   bool IsEmpty();
 
+  /// Record the region of the image that was changed by the last modification.
+  /// Must be called after the modification is completed (after the modified time of the image is updated).
+  /// \param modifiedExtent Extent that contains all the voxels that have been changed.
+  ///   Voxels outside this extent have the same value as before the modification, but the image
+  ///   extent may have been grown (by padding with empty voxels) or shrunk (by removing empty voxels).
+  /// \param baseMTime Modified time of the image before the modification.
+  /// Does not invoke modified event.
+  void SetModifiedExtent(const int modifiedExtent[6], vtkMTimeType baseMTime);
+
+  /// Get the region of the image that has been changed since the specified modified time.
+  /// Allows consumers to only update the changed region instead of processing the entire image.
+  /// \param sinceMTime Modified time of the image when the consumer was last updated.
+  /// \param modifiedExtent Output extent containing all the voxels that have been changed since sinceMTime.
+  ///   It is an empty extent if the image has not been modified.
+  /// \return False if the changed region is unknown (the entire image has to be considered modified).
+  bool GetModifiedExtent(vtkMTimeType sinceMTime, int modifiedExtent[6]);
+
+  /// Store the effective extent computed from the current image content.
+  /// Used by vtkOrientedImageDataResample::CalculateEffectiveExtent to avoid rescanning unchanged images.
+  /// Does not invoke modified event.
+  void SetCachedEffectiveExtent(const int effectiveExtent[6], double threshold);
+
+  /// Get the last stored effective extent.
+  /// \param cacheMTime Output modified time of the image when the effective extent was stored.
+  ///   If it is older than the current modified time then the extent may be out of date.
+  /// \return False if no effective extent has been stored for the specified threshold.
+  bool GetCachedEffectiveExtent(double threshold, int effectiveExtent[6], vtkMTimeType& cacheMTime);
+
 protected:
   vtkOrientedImageData();
   ~vtkOrientedImageData() override;
@@ -95,6 +123,17 @@ protected:
   /// These are unit length direction cosines
   double Directions[3][3];
 
+  /// Region that was changed by the last recorded modification
+  int ModifiedExtent[6];
+  /// Modified time of the image before and after the last recorded modification
+  vtkMTimeType ModifiedExtentBaseMTime;
+  vtkMTimeType ModifiedExtentMTime;
+
+  /// Last computed effective extent, the threshold it was computed with and the modified time of the image at that time
+  int CachedEffectiveExtent[6];
+  double CachedEffectiveExtentThreshold;
+  vtkMTimeType CachedEffectiveExtentMTime;
+
 private:
   vtkOrientedImageData(const vtkOrientedImageData&) = delete;
   void operator=(const vtkOrientedImageData&) = delete;
@@ -36,6 +36,7 @@
 #include <vtkObjectFactory.h>
 #include <vtkPlaneSource.h>
 #include <vtkPointData.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkTransform.h>
 #include <vtkTransformPolyDataFilter.h>
@@ -44,10 +45,63 @@
 
 // STD includes
 #include <algorithm>
+#include <atomic>
 #include <vector>
 
 vtkStandardNewMacro(vtkOrientedImageDataResample);
 
+//----------------------------------------------------------------------------
+// Minimum number of voxels that are processed by one thread in MergeImage and ModifyImage
+const vtkIdType MERGE_IMAGE_MINIMUM_VOXELS_PER_THREAD = 65536;
+
+//----------------------------------------------------------------------------
+// Row kernels of MergeImageGeneric2. They do not contain branches in the loop body so that
+// the compiler can vectorize them (the modified flag is computed as a reduction).
+// Returns true if any of the base voxels have been changed.
+template <class BaseImageScalarType, class ModifierImageScalarType>
+bool MergeRowMaximum(BaseImageScalarType* base, const ModifierImageScalarType* modifier, vtkIdType length)
+{
+  int modified = 0;
+  for (vtkIdType i = 0; i < length; ++i)
+    {
+    BaseImageScalarType modifierValue = static_cast<BaseImageScalarType>(modifier[i]);
+    BaseImageScalarType baseValue = base[i];
+    modified |= (modifierValue > baseValue);
+    base[i] = (modifierValue > baseValue) ? modifierValue : baseValue;
+    }
+  return modified != 0;
+}
+
+//----------------------------------------------------------------------------
+template <class BaseImageScalarType, class ModifierImageScalarType>
+bool MergeRowMinimum(BaseImageScalarType* base, const ModifierImageScalarType* modifier, vtkIdType length)
+{
+  int modified = 0;
+  for (vtkIdType i = 0; i < length; ++i)
+    {
+    BaseImageScalarType modifierValue = static_cast<BaseImageScalarType>(modifier[i]);
+    BaseImageScalarType baseValue = base[i];
+    modified |= (modifierValue < baseValue);
+    base[i] = (modifierValue < baseValue) ? modifierValue : baseValue;
+    }
+  return modified != 0;
+}
+
+//----------------------------------------------------------------------------
+template <class BaseImageScalarType, class ModifierImageScalarType>
+bool MergeRowMasking(BaseImageScalarType* base, const ModifierImageScalarType* modifier, vtkIdType length,
+  ModifierImageScalarType maskThreshold, BaseImageScalarType fillValue)
+{
+  int modified = 0;
+  for (vtkIdType i = 0; i < length; ++i)
+    {
+    bool inMask = (modifier[i] > maskThreshold);
+    modified |= inMask;
+    base[i] = inMask ? fillValue : base[i];
+    }
+  return modified != 0;
+}
+
 //----------------------------------------------------------------------------
 // This templated function executes the filter for any type of data.
 template <class BaseImageScalarType, class ModifierImageScalarType>
@@ -88,21 +142,18 @@ void MergeImageGeneric2(
     return;
     }
 
-  // Get increments to march through data
-  vtkIdType baseIncX = 0;
-  vtkIdType baseIncY = 0;
-  vtkIdType baseIncZ = 0;
-  vtkIdType modifierIncX = 0;
-  vtkIdType modifierIncY = 0;
-  vtkIdType modifierIncZ = 0;
-  baseImage->GetContinuousIncrements(updateExt, baseIncX, baseIncY, baseIncZ);
-  modifierImage->GetContinuousIncrements(updateExt, modifierIncX, modifierIncY, modifierIncZ);
-  int maxX = (updateExt[1] - updateExt[0]) * baseImage->GetNumberOfScalarComponents();
-  int maxY = updateExt[3] - updateExt[2];
-  int maxZ = updateExt[5] - updateExt[4];
+  // Get increments to march through data.
+  // Rows of the update extent are contiguous in memory in both images.
+  vtkIdType baseIncrements[3] = { 0, 0, 0 };
+  baseImage->GetIncrements(baseIncrements);
+  vtkIdType modifierIncrements[3] = { 0, 0, 0 };
+  modifierImage->GetIncrements(modifierIncrements);
+  const int numberOfComponents = baseImage->GetNumberOfScalarComponents();
+  const vtkIdType rowLength = static_cast<vtkIdType>(updateExt[1] - updateExt[0] + 1) * numberOfComponents;
+  const vtkIdType numberOfRowsPerSlice = updateExt[3] - updateExt[2] + 1;
+  const vtkIdType numberOfRows = numberOfRowsPerSlice * (updateExt[5] - updateExt[4] + 1);
   BaseImageScalarType* baseImagePtr = static_cast<BaseImageScalarType*>(baseImage->GetScalarPointerForExtent(updateExt));
-  ModifierImageScalarType* modifierImagePtr = static_cast<ModifierImageScalarType*>(modifierImage->GetScalarPointerForExtent(updateExt));
-
+  const ModifierImageScalarType* modifierImagePtr = static_cast<const ModifierImageScalarType*>(modifierImage->GetScalarPointerForExtent(updateExt));
   if (baseImagePtr == nullptr)
     {
     vtkGenericWarningMacro("vtkOrientedImageDataResample::MergeImageGeneric: Base image pointer is invalid");
@@ -114,65 +165,12 @@ void MergeImageGeneric2(
     return;
     }
 
-  bool baseImageModified = false;
-
-  // Loop through output pixels
-  // There is difference in only one line between min/max computation but the comparison
-  // is performed for each pixel, so it is faster to make the conditional expression in the outer loop.
-  // Looping is performed in two step: first we just check if any of the pixels have to be changed,
-  // if we find any, then we set baseImageModified flag and to the second loop without need to set
-  // baseImageModified flag again (setting a flag in a hot loop may impact speed).
-  if (operation == vtkOrientedImageDataResample::OPERATION_MAXIMUM)
-    {
-    for (vtkIdType idxZ = 0; idxZ <= maxZ; idxZ++)
-      {
-      for (vtkIdType idxY = 0; idxY <= maxY; idxY++)
-        {
-        for (vtkIdType idxX = 0; idxX <= maxX; idxX++)
-          {
-          if (static_cast<BaseImageScalarType>(*modifierImagePtr) > *baseImagePtr)
-            {
-            *baseImagePtr = *modifierImagePtr;
-            baseImageModified = true;
-            }
-          baseImagePtr++;
-          modifierImagePtr++;
-          }
-        baseImagePtr += baseIncY;
-        modifierImagePtr += modifierIncY;
-        }
-      baseImagePtr += baseIncZ;
-      modifierImagePtr += modifierIncZ;
-      }
-    }
-  else if (operation == vtkOrientedImageDataResample::OPERATION_MINIMUM)
-    {
-    for (vtkIdType idxZ = 0; idxZ <= maxZ; idxZ++)
-      {
-      for (vtkIdType idxY = 0; idxY <= maxY; idxY++)
-        {
-        for (vtkIdType idxX = 0; idxX <= maxX; idxX++)
-          {
-          if (static_cast<BaseImageScalarType>(*modifierImagePtr) < *baseImagePtr)
-            {
-            *baseImagePtr = *modifierImagePtr;
-            baseImageModified = true;
-            }
-          baseImagePtr++;
-          modifierImagePtr++;
-          }
-        baseImagePtr += baseIncY;
-        modifierImagePtr += modifierIncY;
-        }
-      baseImagePtr += baseIncZ;
-      modifierImagePtr += modifierIncZ;
-      }
-    }
-  else if (operation == vtkOrientedImageDataResample::OPERATION_MASKING)
+  // Make sure the fill value is valid for the base image scalar range
+  BaseImageScalarType fillValueBaseImageType = 0;
+  // Make sure the threshold is valid for the modifier scalar range
+  ModifierImageScalarType maskThresholdModifierType = 0;
+  if (operation == vtkOrientedImageDataResample::OPERATION_MASKING)
     {
-
-    // Make sure the fill value is valid for the base image scalar range
-    BaseImageScalarType fillValueBaseImageType = 0;
     if (fillValue < baseImage->GetScalarTypeMin())
       {
       fillValueBaseImageType = static_cast<BaseImageScalarType>(baseImage->GetScalarTypeMin());
@@ -186,8 +184,6 @@ void MergeImageGeneric2(
       fillValueBaseImageType = static_cast<BaseImageScalarType>(fillValue);
       }
 
-    // Make sure the threshold is valid for the modifier scalar range
-    ModifierImageScalarType maskThresholdModifierType = 0;
     if (maskThreshold < modifierImage->GetScalarTypeMin())
       {
       maskThresholdModifierType = static_cast<ModifierImageScalarType>(modifierImage->GetScalarTypeMin());
@@ -200,28 +196,45 @@ void MergeImageGeneric2(
       {
       maskThresholdModifierType = static_cast<ModifierImageScalarType>(maskThreshold);
       }
+    }
 
-    for (vtkIdType idxZ = 0; idxZ <= maxZ; idxZ++)
+  // Rows are processed in parallel. Each row is processed by a loop without branches that compilers can vectorize.
+  // Chunks are made large enough so that small updates (such as a paint brush stroke) are not slowed down
+  // by the parallelization overhead.
+  std::atomic<bool> baseImageModified(false);
+  const vtkIdType grain = std::max<vtkIdType>(1, MERGE_IMAGE_MINIMUM_VOXELS_PER_THREAD / std::max<vtkIdType>(1, rowLength));
+  vtkSMPTools::For(0, numberOfRows, grain, [&](vtkIdType firstRow, vtkIdType endRow)
+    {
+    bool chunkModified = false;
+    for (vtkIdType row = firstRow; row < endRow; ++row)
       {
-      for (vtkIdType idxY = 0; idxY <= maxY; idxY++)
+      vtkIdType j = row % numberOfRowsPerSlice;
+      vtkIdType k = row / numberOfRowsPerSlice;
+      BaseImageScalarType* baseRowPtr = baseImagePtr + j * baseIncrements[1] + k * baseIncrements[2];
+      const ModifierImageScalarType* modifierRowPtr = modifierImagePtr + j * modifierIncrements[1] + k * modifierIncrements[2];
+      bool rowModified = false;
+      switch (operation)
         {
-        for (vtkIdType idxX = 0; idxX <= maxX; idxX++)
-          {
-          if ((*modifierImagePtr) > maskThresholdModifierType)
-            {
-            *baseImagePtr = fillValueBaseImageType;
-            baseImageModified = true;
-            }
-          baseImagePtr++;
-          modifierImagePtr++;
-        }
-        baseImagePtr += baseIncY;
-        modifierImagePtr += modifierIncY;
+        case vtkOrientedImageDataResample::OPERATION_MAXIMUM:
+          rowModified = MergeRowMaximum(baseRowPtr, modifierRowPtr, rowLength);
+          break;
+        case vtkOrientedImageDataResample::OPERATION_MINIMUM:
+          rowModified = MergeRowMinimum(baseRowPtr, modifierRowPtr, rowLength);
+          break;
+        case vtkOrientedImageDataResample::OPERATION_MASKING:
+          rowModified = MergeRowMasking(baseRowPtr, modifierRowPtr, rowLength, maskThresholdModifierType, fillValueBaseImageType);
+          break;
+        default:
+          break;
         }
-      baseImagePtr += baseIncZ;
-      modifierImagePtr += modifierIncZ;
+      chunkModified = chunkModified || rowModified;
       }
-    }
+    if (chunkModified)
+      {
+      baseImageModified = true;
+      }
+    });
+
   if (baseImageModified)
     {
     baseImage->Modified();
@@ -585,10 +598,10 @@ bool vtkOrientedImageDataResample::IsEqual(vtkMatrix4x4* lhs, vtkMatrix4x4* rhs)
 }
 
 //----------------------------------------------------------------------------
-template <typename T> void CalculateEffectiveExtentGeneric(vtkOrientedImageData* image, int effectiveExtent[6], T threshold)
+template <typename T> void CalculateEffectiveExtentGeneric(vtkOrientedImageData* image, const int scanExtent[6], int effectiveExtent[6], T threshold)
 {
-  // Get increments to march through image
-  int *wholeExt = image->GetExtent();
+  // Only voxels within scanExtent are visited
+  const int* wholeExt = scanExtent;
 
   effectiveExtent[0] = wholeExt[1]+1;
   effectiveExtent[1] = wholeExt[0]-1;
@@ -653,23 +666,115 @@ template <typename T> void CalculateEffectiveExtentGeneric(vtkOrientedImageData*
 }
 
 //----------------------------------------------------------------------------
-bool vtkOrientedImageDataResample::CalculateEffectiveExtent(vtkOrientedImageData* image, int effectiveExtent[6], double threshold /*=0.0*/)
+bool IsExtentEmpty(const int extent[6])
 {
-  if (!image)
+  return extent[0] > extent[1] || extent[2] > extent[3] || extent[4] > extent[5];
+}
+
+//----------------------------------------------------------------------------
+bool DoExtentsIntersect(const int extent1[6], const int extent2[6])
+{
+  for (int axis = 0; axis < 3; ++axis)
     {
-    return false;
+    if (extent1[axis * 2] > extent2[axis * 2 + 1] || extent1[axis * 2 + 1] < extent2[axis * 2])
+      {
+      return false;
+      }
     }
+  return true;
+}
 
+//----------------------------------------------------------------------------
+void UpdateEffectiveExtent(vtkOrientedImageData* image, const int scanExtent[6], int effectiveExtent[6], double threshold)
+{
   switch (image->GetScalarType())
     {
-    vtkTemplateMacro(CalculateEffectiveExtentGeneric<VTK_TT>(image, effectiveExtent, threshold));
+    vtkTemplateMacro(CalculateEffectiveExtentGeneric<VTK_TT>(image, scanExtent, effectiveExtent, threshold));
   default:
     vtkGenericWarningMacro("vtkOrientedImageDataResample::CalculateEffectiveExtent: Unknown ScalarType");
+    effectiveExtent[0] = 0;
+    effectiveExtent[1] = -1;
+    effectiveExtent[2] = 0;
+    effectiveExtent[3] = -1;
+    effectiveExtent[4] = 0;
+    effectiveExtent[5] = -1;
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkOrientedImageDataResample::CalculateEffectiveExtent(vtkOrientedImageData* image, int effectiveExtent[6], double threshold /*=0.0*/)
+{
+  if (!image)
+    {
     return false;
     }
 
+  int wholeExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  image->GetExtent(wholeExtent);
+
+  int cachedEffectiveExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  vtkMTimeType cacheMTime = 0;
+  int modifiedExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  if (image->GetCachedEffectiveExtent(threshold, cachedEffectiveExtent, cacheMTime)
+    && image->GetModifiedExtent(cacheMTime, modifiedExtent))
+    {
+    // Voxels outside the modified extent are unchanged since the effective extent was cached,
+    // therefore only the modified region has to be scanned.
+    for (int i = 0; i < 3; ++i)
+      {
+      modifiedExtent[i * 2] = std::max(modifiedExtent[i * 2], wholeExtent[i * 2]);
+      modifiedExtent[i * 2 + 1] = std::min(modifiedExtent[i * 2 + 1], wholeExtent[i * 2 + 1]);
+      }
+    if (IsExtentEmpty(modifiedExtent))
+      {
+      std::copy(cachedEffectiveExtent, cachedEffectiveExtent + 6, effectiveExtent);
+      }
+    else
+      {
+      // The cached extent remains tight if each of its boundary slices contains a voxel that is not modified.
+      // Otherwise voxels may have been removed from the boundary and the entire cached region has to be rescanned.
+      bool cachedExtentBoundaryUnchanged = true;
+      for (int i = 0; i < 6 && cachedExtentBoundaryUnchanged && !IsExtentEmpty(cachedEffectiveExtent); ++i)
+        {
+        int boundarySlice[6] = { 0, -1, 0, -1, 0, -1 };
+        std::copy(cachedEffectiveExtent, cachedEffectiveExtent + 6, boundarySlice);
+        boundarySlice[i % 2 == 0 ? i + 1 : i - 1] = cachedEffectiveExtent[i];
+        cachedExtentBoundaryUnchanged = !DoExtentsIntersect(boundarySlice, modifiedExtent);
+        }
+      int scanExtent[6] = { 0, -1, 0, -1, 0, -1 };
+      std::copy(modifiedExtent, modifiedExtent + 6, scanExtent);
+      if (!cachedExtentBoundaryUnchanged)
+        {
+        for (int i = 0; i < 3; ++i)
+          {
+          scanExtent[i * 2] = std::max(std::min(scanExtent[i * 2], cachedEffectiveExtent[i * 2]), wholeExtent[i * 2]);
+          scanExtent[i * 2 + 1] = std::min(std::max(scanExtent[i * 2 + 1], cachedEffectiveExtent[i * 2 + 1]), wholeExtent[i * 2 + 1]);
+          }
+        }
+      UpdateEffectiveExtent(image, scanExtent, effectiveExtent, threshold);
+      if (cachedExtentBoundaryUnchanged && IsExtentEmpty(effectiveExtent))
+        {
+        std::copy(cachedEffectiveExtent, cachedEffectiveExtent + 6, effectiveExtent);
+        }
+      else if (cachedExtentBoundaryUnchanged && !IsExtentEmpty(cachedEffectiveExtent))
+        {
+        for (int i = 0; i < 3; ++i)
+          {
+          effectiveExtent[i * 2] = std::min(effectiveExtent[i * 2], cachedEffectiveExtent[i * 2]);
+          effectiveExtent[i * 2 + 1] = std::max(effectiveExtent[i * 2 + 1], cachedEffectiveExtent[i * 2 + 1]);
+          }
+        }
+      }
+    }
+  else
+    {
+    UpdateEffectiveExtent(image, wholeExtent, effectiveExtent, threshold);
+    }
+
+  image->SetCachedEffectiveExtent(effectiveExtent, threshold);
+
   // Return with failure if effective input extent is empty
-  if ( effectiveExtent[0] > effectiveExtent[1] || effectiveExtent[2] > effectiveExtent[3] || effectiveExtent[4] > effectiveExtent[5] )
+  if (IsExtentEmpty(effectiveExtent))
     {
     return false;
     }
@@ -1635,11 +1740,17 @@ void vtkOrientedImageDataResample::GetLabelValuesInMask(std::vector<int>& labelV
   int maskExtent[6] = { 0 };
   mask->GetExtent(maskExtent);
 
+  // Only the region where the labelmap, the mask, and the requested extent overlap is resampled and scanned
   int effectiveExtent[6] = { 0 };
   for (int i = 0; i < 3; ++i)
     {
     effectiveExtent[2 * i] = std::max(binaryExtent[2 * i], maskExtent[2 * i]);
     effectiveExtent[2 * i + 1] = std::min(binaryExtent[2 * i + 1], maskExtent[2 * i + 1]);
+    if (extent)
+      {
+      effectiveExtent[2 * i] = std::max(effectiveExtent[2 * i], extent[2 * i]);
+      effectiveExtent[2 * i + 1] = std::min(effectiveExtent[2 * i + 1], extent[2 * i + 1]);
+      }
     }
 
   // No labels in mask if effective extent is empty
@@ -1798,11 +1909,17 @@ bool vtkOrientedImageDataResample::IsLabelInMask(
   int maskExtent[6] = { 0 };
   mask->GetExtent(maskExtent);
 
+  // Only the region where the labelmap, the mask, and the requested extent overlap is resampled and scanned
   int effectiveExtent[6] = { 0 };
   for (int i = 0; i < 3; ++i)
     {
     effectiveExtent[2 * i] = std::max(binaryExtent[2 * i], maskExtent[2 * i]);
     effectiveExtent[2 * i + 1] = std::min(binaryExtent[2 * i + 1], maskExtent[2 * i + 1]);
+    if (extent)
+      {
+      effectiveExtent[2 * i] = std::max(effectiveExtent[2 * i], extent[2 * i]);
+      effectiveExtent[2 * i + 1] = std::min(effectiveExtent[2 * i + 1], extent[2 * i + 1]);
+      }
     }
 
   // No labels in mask if effective extent is empty
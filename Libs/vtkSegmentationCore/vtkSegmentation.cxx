@@ -1032,8 +1032,7 @@ bool vtkSegmentation::ConvertSegmentsUsingPath(std::vector<std::string> segmentI
       return false;
       }
 
-    // Perform conversion step
-    currentConversionRule->PreConvert(this);
+    std::vector<vtkSegment*> segmentsToConvert;
     for (auto segmentID : segmentIDs)
       {
       vtkSegment* segment = this->GetSegment(segmentID);
@@ -1056,9 +1055,23 @@ bool vtkSegmentation::ConvertSegmentsUsingPath(std::vector<std::string> segmentI
         {
         continue;
         }
-      currentConversionRule->Convert(segment);
+      segmentsToConvert.push_back(segment);
+      }
+
+    // Perform conversion step
+    if (segmentsToConvert.size() > 1 && currentConversionRule->IsThreadSafe())
+      {
+      vtkSegmentationConverter::ConvertSegmentsInParallel(currentConversionRule, this, segmentsToConvert);
+      }
+    else
+      {
+      currentConversionRule->PreConvert(this);
+      for (vtkSegment* segment : segmentsToConvert)
+        {
+        currentConversionRule->Convert(segment);
+        }
+      currentConversionRule->PostConvert(this);
       }
-    currentConversionRule->PostConvert(this);
 
   }
 
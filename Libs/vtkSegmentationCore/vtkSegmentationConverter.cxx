@@ -24,9 +24,11 @@
 #include "vtkOrientedImageData.h"
 #include "vtkOrientedImageDataResample.h"
 #include "vtkSegmentationConverterRule.h"
+#include "vtkSegment.h"
 
 // VTK includes
 #include <vtkObjectFactory.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkMatrix4x4.h>
 #include <vtkNumberToString.h>
@@ -567,3 +569,106 @@ void vtkSegmentationConverter::ApplyTransformOnReferenceImageGeometry(vtkAbstrac
   this->SetConversionParameter(
     vtkSegmentationConverter::GetReferenceImageGeometryParameterName(), newGeometryString );
 }
+
+//----------------------------------------------------------------------------
+bool vtkSegmentationConverter::ConvertSegmentsInParallel(vtkSegmentationConverterRule* rule, vtkSegmentation* segmentation,
+  const std::vector<vtkSegment*>& segments)
+{
+  if (!rule || !rule->IsThreadSafe())
+    {
+    vtkGenericWarningMacro("vtkSegmentationConverter::ConvertSegmentsInParallel failed: invalid or not thread-safe conversion rule");
+    return false;
+    }
+  if (segments.empty())
+    {
+    return true;
+    }
+
+  // Conversion is performed on detached copies of the segments, so that the segmentation
+  // does not receive any events during conversion. Segments are grouped by source representation,
+  // each group is converted by a separate clone of the rule.
+  std::vector<vtkSmartPointer<vtkSegment> > workSegments(segments.size());
+  std::map<vtkDataObject*, size_t> groupIndexForSourceRepresentation;
+  std::vector<std::vector<size_t> > groups;
+  for (size_t segmentIndex = 0; segmentIndex < segments.size(); ++segmentIndex)
+    {
+    vtkSegment* segment = segments[segmentIndex];
+    vtkDataObject* sourceRepresentation = segment ? segment->GetRepresentation(rule->GetSourceRepresentationName()) : nullptr;
+    if (!sourceRepresentation)
+      {
+      vtkGenericWarningMacro("vtkSegmentationConverter::ConvertSegmentsInParallel failed: source representation does not exist");
+      return false;
+      }
+    vtkSmartPointer<vtkSegment> workSegment = vtkSmartPointer<vtkSegment>::New();
+    workSegment->DeepCopyMetadata(segment);
+    workSegment->AddRepresentation(rule->GetSourceRepresentationName(), sourceRepresentation);
+    // Rules update an existing target representation instead of creating a new one (unless
+    // ReplaceTargetRepresentation is enabled), so the work segment must contain it, too.
+    // A shallow copy is used so that the observed target representation is not modified
+    // from the worker threads.
+    vtkDataObject* targetRepresentation = segment->GetRepresentation(rule->GetTargetRepresentationName());
+    if (targetRepresentation && !rule->ReplaceTargetRepresentation)
+      {
+      vtkSmartPointer<vtkDataObject> workTargetRepresentation = vtkSmartPointer<vtkDataObject>::Take(targetRepresentation->NewInstance());
+      workTargetRepresentation->ShallowCopy(targetRepresentation);
+      workSegment->AddRepresentation(rule->GetTargetRepresentationName(), workTargetRepresentation);
+      }
+    workSegments[segmentIndex] = workSegment;
+
+    std::map<vtkDataObject*, size_t>::iterator groupIt = groupIndexForSourceRepresentation.find(sourceRepresentation);
+    if (groupIt == groupIndexForSourceRepresentation.end())
+      {
+      groupIt = groupIndexForSourceRepresentation.insert(std::make_pair(sourceRepresentation, groups.size())).first;
+      groups.emplace_back();
+      }
+    groups[groupIt->second].push_back(segmentIndex);
+    }
+
+  std::vector<vtkSmartPointer<vtkSegmentationConverterRule> > groupRules(groups.size());
+  for (size_t groupIndex = 0; groupIndex < groups.size(); ++groupIndex)
+    {
+    groupRules[groupIndex] = vtkSmartPointer<vtkSegmentationConverterRule>::Take(rule->Clone());
+    groupRules[groupIndex]->PreConvert(segmentation);
+    }
+
+  // Not std::vector<bool>, as elements are written from multiple threads
+  std::vector<char> conversionSucceeded(segments.size(), 0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(groups.size()), [&](vtkIdType firstGroupIndex, vtkIdType endGroupIndex)
+    {
+    for (vtkIdType groupIndex = firstGroupIndex; groupIndex < endGroupIndex; ++groupIndex)
+      {
+      for (size_t segmentIndex : groups[groupIndex])
+        {
+        conversionSucceeded[segmentIndex] = groupRules[groupIndex]->Convert(workSegments[segmentIndex]) ? 1 : 0;
+        }
+      }
+    });
+
+  // Set conversion results in the segments
+  bool success = true;
+  const char* targetRepresentationName = rule->GetTargetRepresentationName();
+  for (size_t segmentIndex = 0; segmentIndex < segments.size(); ++segmentIndex)
+    {
+    vtkDataObject* convertedRepresentation = workSegments[segmentIndex]->GetRepresentation(targetRepresentationName);
+    if (!conversionSucceeded[segmentIndex] || !convertedRepresentation)
+      {
+      success = false;
+      continue;
+      }
+    vtkDataObject* targetRepresentation = segments[segmentIndex]->GetRepresentation(targetRepresentationName);
+    if (targetRepresentation && !rule->ReplaceTargetRepresentation && targetRepresentation->IsA(convertedRepresentation->GetClassName()))
+      {
+      // Keep the existing target representation object, as it may be observed
+      targetRepresentation->ShallowCopy(convertedRepresentation);
+      }
+    else
+      {
+      segments[segmentIndex]->AddRepresentation(targetRepresentationName, convertedRepresentation);
+      }
+    }
+
+  // Post-processing operates on the whole segmentation (for example, collapsing labelmaps),
+  // therefore it is performed once, after the results are set in the segments.
+  rule->PostConvert(segmentation);
+  return success;
+}
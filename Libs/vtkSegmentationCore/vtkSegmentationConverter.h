@@ -40,6 +40,7 @@
 
 class vtkAbstractTransform;
 class vtkSegment;
+class vtkSegmentation;
 class vtkMatrix4x4;
 class vtkImageData;
 class vtkOrientedImageData;
@@ -124,6 +125,19 @@ public:
   /// Return cheapest path from a list of paths with costs
   static vtkSegmentationConversionPath* GetCheapestPath(vtkSegmentationConversionPaths* paths);
 
+  /// Convert segments using a thread-safe conversion rule (see vtkSegmentationConverterRule::IsThreadSafe).
+  /// Segments are converted in parallel by clones of the rule. Segments sharing the same source
+  /// representation (for example, segments in a shared labelmap) are converted by the same clone.
+  /// Conversion results are set in the segments in the calling thread, therefore all events are invoked
+  /// from the calling thread.
+  /// \param rule Conversion rule. PreConvert is called for each clone. PostConvert is called once for this rule,
+  ///   after the conversion results are set in the segments.
+  /// \param segmentation Segmentation that is passed to PreConvert and PostConvert.
+  /// \param segments Segments to convert. All segments must contain the source representation of the rule.
+  /// \return False if the rule is not thread-safe or conversion of any of the segments failed.
+  static bool ConvertSegmentsInParallel(vtkSegmentationConverterRule* rule, vtkSegmentation* segmentation,
+    const std::vector<vtkSegment*>& segments);
+
   /// Utility function for serializing geometry of oriented image data
   static std::string SerializeImageGeometry(vtkOrientedImageData* orientedImageData);
 
@@ -70,6 +70,13 @@ public:
   /// Create a new instance of this rule and copy its contents
   virtual vtkSegmentationConverterRule* Clone();
 
+  /// Returns true if clones of this rule can convert segments concurrently.
+  /// Each thread uses its own clone (created by Clone() in the main thread) and converts segments
+  /// that are not attached to a segmentation. Segments that share a source representation
+  /// are always converted by the same clone.
+  /// Rules are not considered thread-safe by default.
+  virtual bool IsThreadSafe() { return false; };
+
   /// Constructs representation object from representation name for the supported representation classes
   /// (typically source and target representation VTK classes, subclasses of vtkDataObject)
   /// Note: Need to take ownership of the created object! For example using vtkSmartPointer<vtkDataObject>::Take
@@ -22,14 +22,111 @@
 #include "vtkSegmentationHistory.h"
 #include "vtkSegmentationConverterFactory.h"
 #include "vtkSegmentation.h"
+#include "vtkOrientedImageData.h"
 
 // VTK includes
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkCallbackCommand.h>
+#include <vtkPointData.h>
 
 // std includes
 #include <algorithm>
+#include <cstring>
+#include <set>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+// Run-length encode voxels of an image block. Each run is stored as a run length
+// (32-bit unsigned integer) followed by the bytes of the repeated voxel value.
+void EncodeBlock(vtkImageData* image, const int blockExtent[6], int elementSize, std::vector<unsigned char>& encoded)
+{
+  const unsigned char* runValue = nullptr;
+  vtkTypeUInt32 runLength = 0;
+  auto appendRun = [&]()
+    {
+    const unsigned char* runLengthBytes = reinterpret_cast<const unsigned char*>(&runLength);
+    encoded.insert(encoded.end(), runLengthBytes, runLengthBytes + sizeof(runLength));
+    encoded.insert(encoded.end(), runValue, runValue + elementSize);
+    };
+  for (int k = blockExtent[4]; k <= blockExtent[5]; ++k)
+    {
+    for (int j = blockExtent[2]; j <= blockExtent[3]; ++j)
+      {
+      const unsigned char* voxel = static_cast<const unsigned char*>(image->GetScalarPointer(blockExtent[0], j, k));
+      for (int i = blockExtent[0]; i <= blockExtent[1]; ++i, voxel += elementSize)
+        {
+        if (runValue && memcmp(runValue, voxel, elementSize) == 0)
+          {
+          ++runLength;
+          continue;
+          }
+        if (runValue)
+          {
+          appendRun();
+          }
+        runValue = voxel;
+        runLength = 1;
+        }
+      }
+    }
+  if (runValue)
+    {
+    appendRun();
+    }
+}
+
+//----------------------------------------------------------------------------
+// Fill voxels of an image block from run-length encoded data created by EncodeBlock.
+bool DecodeBlock(const std::vector<unsigned char>& encoded, vtkImageData* image, const int blockExtent[6], int elementSize)
+{
+  std::vector<unsigned char>::const_iterator runIt = encoded.begin();
+  const unsigned char* runValue = nullptr;
+  vtkTypeUInt32 runLength = 0;
+  for (int k = blockExtent[4]; k <= blockExtent[5]; ++k)
+    {
+    for (int j = blockExtent[2]; j <= blockExtent[3]; ++j)
+      {
+      unsigned char* voxel = static_cast<unsigned char*>(image->GetScalarPointer(blockExtent[0], j, k));
+      for (int i = blockExtent[0]; i <= blockExtent[1]; ++i, voxel += elementSize)
+        {
+        if (runLength == 0)
+          {
+          if (encoded.end() - runIt < static_cast<std::ptrdiff_t>(sizeof(runLength) + elementSize))
+            {
+            return false;
+            }
+          memcpy(&runLength, &(*runIt), sizeof(runLength));
+          runValue = &(*runIt) + sizeof(runLength);
+          runIt += sizeof(runLength) + elementSize;
+          if (runLength == 0)
+            {
+            return false;
+            }
+          }
+        memcpy(voxel, runValue, elementSize);
+        --runLength;
+        }
+      }
+    }
+  return (runLength == 0 && runIt == encoded.end());
+}
+
+//----------------------------------------------------------------------------
+// Get extent of the block that starts at the specified voxel, clipped to the image extent.
+void GetBlockExtent(const int extent[6], int i, int j, int k, int blockExtent[6])
+{
+  blockExtent[0] = i;
+  blockExtent[1] = std::min(i + vtkSegmentationHistory::BlockSize - 1, extent[1]);
+  blockExtent[2] = j;
+  blockExtent[3] = std::min(j + vtkSegmentationHistory::BlockSize - 1, extent[3]);
+  blockExtent[4] = k;
+  blockExtent[5] = std::min(k + vtkSegmentationHistory::BlockSize - 1, extent[5]);
+}
+
+}
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSegmentationHistory);
@@ -130,6 +227,7 @@ bool vtkSegmentationHistory::SaveState()
   this->Segmentation->GetSegmentIDs(segmentIDs);
   newSegmentationState.SegmentIds = segmentIDs;
   std::map<vtkDataObject*, vtkDataObject*> savedObjects;
+  std::map<vtkDataObject*, std::shared_ptr<CompressedLabelmap> > savedLabelmaps;
   for (std::vector<std::string>::iterator segmentIDIt = segmentIDs.begin(); segmentIDIt != segmentIDs.end(); ++segmentIDIt)
     {
     vtkSegment* segment = this->Segmentation->GetSegment(*segmentIDIt);
@@ -141,18 +239,73 @@ bool vtkSegmentationHistory::SaveState()
     // Previous saved state of the segment
     // (if the new state has exactly the same representation then only a shallow copy will be made)
     vtkSegment* baselineSegment = nullptr;
+    const CompressedRepresentationsMap* baselineCompressedRepresentations = nullptr;
     if (this->SegmentationStates.size() > 0)
       {
-      SegmentsMap::iterator baselineSegmentIt = this->SegmentationStates.back().Segments.find(*segmentIDIt);
-      if (baselineSegmentIt != this->SegmentationStates.back().Segments.end())
+      SegmentationState& baselineState = this->SegmentationStates.back();
+      SegmentsMap::iterator baselineSegmentIt = baselineState.Segments.find(*segmentIDIt);
+      if (baselineSegmentIt != baselineState.Segments.end())
         {
         baselineSegment = baselineSegmentIt->second.GetPointer();
         }
+      std::map<std::string, CompressedRepresentationsMap>::iterator baselineCompressedIt =
+        baselineState.CompressedRepresentations.find(*segmentIDIt);
+      if (baselineCompressedIt != baselineState.CompressedRepresentations.end())
+        {
+        baselineCompressedRepresentations = &(baselineCompressedIt->second);
+        }
+      }
+
+    // Labelmaps are stored compressed, all other representations are copied into the segment clone
+    vtkNew<vtkSegment> segmentWithoutLabelmaps;
+    segmentWithoutLabelmaps->DeepCopyMetadata(segment);
+    CompressedRepresentationsMap compressedRepresentations;
+    std::vector<std::string> representationNames;
+    segment->GetContainedRepresentationNames(representationNames);
+    for (const std::string& representationName : representationNames)
+      {
+      vtkDataObject* representation = segment->GetRepresentation(representationName);
+      vtkOrientedImageData* labelmap = vtkOrientedImageData::SafeDownCast(representation);
+      if (!labelmap)
+        {
+        segmentWithoutLabelmaps->AddRepresentation(representationName, representation);
+        continue;
+        }
+      std::map<vtkDataObject*, std::shared_ptr<CompressedLabelmap> >::iterator savedLabelmapIt = savedLabelmaps.find(labelmap);
+      if (savedLabelmapIt != savedLabelmaps.end())
+        {
+        // Shared labelmap has already been compressed for a previous segment
+        compressedRepresentations[representationName] = savedLabelmapIt->second;
+        continue;
+        }
+      const CompressedLabelmap* baselineLabelmap = nullptr;
+      if (baselineCompressedRepresentations)
+        {
+        CompressedRepresentationsMap::const_iterator baselineLabelmapIt = baselineCompressedRepresentations->find(representationName);
+        if (baselineLabelmapIt != baselineCompressedRepresentations->end())
+          {
+          baselineLabelmap = baselineLabelmapIt->second.get();
+          if (baselineLabelmap->Source.GetPointer() == labelmap && baselineLabelmap->SourceMTime == labelmap->GetMTime())
+            {
+            // Labelmap has not changed since the previous state was saved
+            compressedRepresentations[representationName] = baselineLabelmapIt->second;
+            savedLabelmaps[labelmap] = baselineLabelmapIt->second;
+            continue;
+            }
+          }
+        }
+      std::shared_ptr<CompressedLabelmap> compressedLabelmap = vtkSegmentationHistory::CompressLabelmap(labelmap, baselineLabelmap);
+      compressedRepresentations[representationName] = compressedLabelmap;
+      savedLabelmaps[labelmap] = compressedLabelmap;
       }
 
     vtkSmartPointer<vtkSegment> segmentClone = vtkSmartPointer<vtkSegment>::New();
-    vtkSegmentation::CopySegment(segmentClone, segment, baselineSegment, savedObjects);
+    vtkSegmentation::CopySegment(segmentClone, segmentWithoutLabelmaps, baselineSegment, savedObjects);
     newSegmentationState.Segments[*segmentIDIt] = segmentClone;
+    if (!compressedRepresentations.empty())
+      {
+      newSegmentationState.CompressedRepresentations[*segmentIDIt] = compressedRepresentations;
+      }
     }
   this->SegmentationStates.push_back(newSegmentationState);
 
@@ -226,6 +379,7 @@ bool vtkSegmentationHistory::RestoreState(unsigned int stateIndex)
 
   std::set<std::string> segmentIDsToKeep;
   std::map<vtkDataObject*, vtkDataObject*> restoredRepresentations;
+  std::map<const CompressedLabelmap*, vtkSmartPointer<vtkOrientedImageData> > restoredLabelmaps;
   for (SegmentsMap::iterator restoredSegmentsIt = restoredState.Segments.begin();
     restoredSegmentsIt != restoredState.Segments.end(); ++restoredSegmentsIt)
     {
@@ -238,8 +392,22 @@ bool vtkSegmentationHistory::RestoreState(unsigned int stateIndex)
       this->Segmentation->AddSegment(segment, restoredSegmentsIt->first);
       }
 
+    CompressedRepresentationsMap compressedRepresentations;
+    std::map<std::string, CompressedRepresentationsMap>::iterator compressedIt =
+      restoredState.CompressedRepresentations.find(restoredSegmentsIt->first);
+    if (compressedIt != restoredState.CompressedRepresentations.end())
+      {
+      compressedRepresentations = compressedIt->second;
+      }
+
     std::vector<std::string> restoredRepresentationNames;
     segmentToRestore->GetContainedRepresentationNames(restoredRepresentationNames);
+    for (CompressedRepresentationsMap::iterator compressedRepresentationIt = compressedRepresentations.begin();
+      compressedRepresentationIt != compressedRepresentations.end(); ++compressedRepresentationIt)
+      {
+      restoredRepresentationNames.push_back(compressedRepresentationIt->first);
+      }
+    std::sort(restoredRepresentationNames.begin(), restoredRepresentationNames.end());
     std::vector<std::string> currentRepresentationNames;
     segment->GetContainedRepresentationNames(currentRepresentationNames);
     if (restoredRepresentationNames != currentRepresentationNames)
@@ -249,6 +417,26 @@ bool vtkSegmentationHistory::RestoreState(unsigned int stateIndex)
 
     vtkSegmentation::CopySegment(segment, segmentToRestore, nullptr, restoredRepresentations);
 
+    // Decompress labelmaps. Labelmaps that were shared between segments are restored as shared labelmaps.
+    for (CompressedRepresentationsMap::iterator compressedRepresentationIt = compressedRepresentations.begin();
+      compressedRepresentationIt != compressedRepresentations.end(); ++compressedRepresentationIt)
+      {
+      const CompressedLabelmap* compressedLabelmap = compressedRepresentationIt->second.get();
+      vtkSmartPointer<vtkOrientedImageData> labelmap = restoredLabelmaps[compressedLabelmap];
+      if (!labelmap)
+        {
+        labelmap = vtkSegmentationHistory::DecompressLabelmap(compressedLabelmap);
+        if (!labelmap)
+          {
+          vtkErrorMacro("RestoreState: Failed to restore " << compressedRepresentationIt->first
+            << " representation of segment " << restoredSegmentsIt->first);
+          continue;
+          }
+        restoredLabelmaps[compressedLabelmap] = labelmap;
+        }
+      segment->AddRepresentation(compressedRepresentationIt->first, labelmap);
+      }
+
     // Remove representations that are not in the restoring segment
     for (std::string representationName : currentRepresentationNames)
       {
@@ -385,3 +573,145 @@ int vtkSegmentationHistory::GetNumberOfStates()
 {
   return this->SegmentationStates.size();
 }
+
+//---------------------------------------------------------------------------
+unsigned long vtkSegmentationHistory::GetMemorySize()
+{
+  std::set<vtkDataObject*> countedObjects;
+  std::set<const void*> countedBlocks;
+  unsigned long memorySizeKB = 0;
+  unsigned long long compressedSizeBytes = 0;
+  for (const SegmentationState& state : this->SegmentationStates)
+    {
+    for (SegmentsMap::const_iterator segmentIt = state.Segments.begin(); segmentIt != state.Segments.end(); ++segmentIt)
+      {
+      std::vector<std::string> representationNames;
+      segmentIt->second->GetContainedRepresentationNames(representationNames);
+      for (const std::string& representationName : representationNames)
+        {
+        vtkDataObject* representation = segmentIt->second->GetRepresentation(representationName);
+        if (representation && countedObjects.insert(representation).second)
+          {
+          memorySizeKB += representation->GetActualMemorySize();
+          }
+        }
+      }
+    for (std::map<std::string, CompressedRepresentationsMap>::const_iterator segmentIt = state.CompressedRepresentations.begin();
+      segmentIt != state.CompressedRepresentations.end(); ++segmentIt)
+      {
+      for (CompressedRepresentationsMap::const_iterator labelmapIt = segmentIt->second.begin(); labelmapIt != segmentIt->second.end(); ++labelmapIt)
+        {
+        for (const CompressedBlock& block : labelmapIt->second->Blocks)
+          {
+          if (countedBlocks.insert(block.get()).second)
+            {
+            compressedSizeBytes += block->size();
+            }
+          }
+        }
+      }
+    }
+  return memorySizeKB + static_cast<unsigned long>(compressedSizeBytes / 1024);
+}
+
+//---------------------------------------------------------------------------
+std::shared_ptr<vtkSegmentationHistory::CompressedLabelmap> vtkSegmentationHistory::CompressLabelmap(
+  vtkOrientedImageData* labelmap, const CompressedLabelmap* baseline)
+{
+  std::shared_ptr<CompressedLabelmap> compressedLabelmap = std::make_shared<CompressedLabelmap>();
+  compressedLabelmap->Geometry = vtkSmartPointer<vtkOrientedImageData>::New();
+  compressedLabelmap->Geometry->CopyStructure(labelmap);
+  compressedLabelmap->Geometry->CopyDirections(labelmap);
+  compressedLabelmap->Source = labelmap;
+  compressedLabelmap->SourceMTime = labelmap->GetMTime();
+  if (!labelmap->GetPointData() || !labelmap->GetPointData()->GetScalars())
+    {
+    // No voxels are allocated
+    return compressedLabelmap;
+    }
+  compressedLabelmap->ScalarType = labelmap->GetScalarType();
+  compressedLabelmap->NumberOfScalarComponents = labelmap->GetNumberOfScalarComponents();
+  const int elementSize = labelmap->GetScalarSize() * compressedLabelmap->NumberOfScalarComponents;
+
+  int extent[6] = { 0, -1, 0, -1, 0, -1 };
+  labelmap->GetExtent(extent);
+
+  // Blocks can only be shared with the baseline if they cover the same region
+  bool baselineBlocksCompatible = false;
+  if (baseline && baseline->Geometry
+    && baseline->ScalarType == compressedLabelmap->ScalarType
+    && baseline->NumberOfScalarComponents == compressedLabelmap->NumberOfScalarComponents)
+    {
+    int baselineExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    baseline->Geometry->GetExtent(baselineExtent);
+    baselineBlocksCompatible = std::equal(extent, extent + 6, baselineExtent);
+    }
+
+  size_t blockIndex = 0;
+  for (int k = extent[4]; k <= extent[5]; k += vtkSegmentationHistory::BlockSize)
+    {
+    for (int j = extent[2]; j <= extent[3]; j += vtkSegmentationHistory::BlockSize)
+      {
+      for (int i = extent[0]; i <= extent[1]; i += vtkSegmentationHistory::BlockSize, ++blockIndex)
+        {
+        int blockExtent[6] = { 0, -1, 0, -1, 0, -1 };
+        GetBlockExtent(extent, i, j, k, blockExtent);
+        std::shared_ptr<std::vector<unsigned char> > encodedBlock = std::make_shared<std::vector<unsigned char> >();
+        EncodeBlock(labelmap, blockExtent, elementSize, *encodedBlock);
+        if (baselineBlocksCompatible && blockIndex < baseline->Blocks.size()
+          && *baseline->Blocks[blockIndex] == *encodedBlock)
+          {
+          // Block has not changed, share it with the baseline
+          compressedLabelmap->Blocks.push_back(baseline->Blocks[blockIndex]);
+          }
+        else
+          {
+          encodedBlock->shrink_to_fit();
+          compressedLabelmap->Blocks.push_back(encodedBlock);
+          }
+        }
+      }
+    }
+  return compressedLabelmap;
+}
+
+//---------------------------------------------------------------------------
+vtkSmartPointer<vtkOrientedImageData> vtkSegmentationHistory::DecompressLabelmap(const CompressedLabelmap* compressedLabelmap)
+{
+  if (!compressedLabelmap || !compressedLabelmap->Geometry)
+    {
+    return nullptr;
+    }
+  vtkSmartPointer<vtkOrientedImageData> labelmap = vtkSmartPointer<vtkOrientedImageData>::New();
+  labelmap->CopyStructure(compressedLabelmap->Geometry);
+  labelmap->CopyDirections(compressedLabelmap->Geometry);
+  if (compressedLabelmap->ScalarType == 0)
+    {
+    // No voxels were allocated
+    return labelmap;
+    }
+  labelmap->AllocateScalars(compressedLabelmap->ScalarType, compressedLabelmap->NumberOfScalarComponents);
+  const int elementSize = labelmap->GetScalarSize() * compressedLabelmap->NumberOfScalarComponents;
+
+  int extent[6] = { 0, -1, 0, -1, 0, -1 };
+  labelmap->GetExtent(extent);
+  size_t blockIndex = 0;
+  for (int k = extent[4]; k <= extent[5]; k += vtkSegmentationHistory::BlockSize)
+    {
+    for (int j = extent[2]; j <= extent[3]; j += vtkSegmentationHistory::BlockSize)
+      {
+      for (int i = extent[0]; i <= extent[1]; i += vtkSegmentationHistory::BlockSize, ++blockIndex)
+        {
+        int blockExtent[6] = { 0, -1, 0, -1, 0, -1 };
+        GetBlockExtent(extent, i, j, k, blockExtent);
+        if (blockIndex >= compressedLabelmap->Blocks.size()
+          || !DecodeBlock(*compressedLabelmap->Blocks[blockIndex], labelmap, blockExtent, elementSize))
+          {
+          vtkErrorWithObjectMacro(nullptr, "vtkSegmentationHistory::DecompressLabelmap failed: invalid compressed block " << blockIndex);
+          return nullptr;
+          }
+        }
+      }
+    }
+  return labelmap;
+}
@@ -24,16 +24,19 @@
 // VTK includes
 #include <vtkObject.h>
 #include <vtkSmartPointer.h>
+#include <vtkWeakPointer.h>
 
 // STD includes
 #include <deque>
 #include <map>
+#include <memory>
 #include <vector>
 
 #include "vtkSegmentationCoreConfigure.h"
 
 class vtkCallbackCommand;
 class vtkDataObject;
+class vtkOrientedImageData;
 class vtkSegment;
 class vtkSegmentation;
 
@@ -85,6 +88,14 @@ public:
   /// Get the current number of states.
   int GetNumberOfStates();
 
+  /// Get the memory size (in kilobytes) of all the stored states.
+  /// Data objects and compressed labelmap blocks that are shared between states are counted once.
+  unsigned long GetMemorySize();
+
+  /// Labelmap representations are stored compressed in blocks of BlockSize^3 voxels.
+  /// Blocks that are the same as in the previous state are shared between states.
+  static const int BlockSize = 64;
+
 protected:
   /// Callback function called when the segmentation has been modified.
   /// It clears all states that are more recent than the last restored state.
@@ -105,12 +116,43 @@ protected:
 
   typedef std::map<std::string, vtkSmartPointer<vtkSegment> > SegmentsMap;
 
+  /// Run-length encoded voxels of one block of a labelmap
+  typedef std::shared_ptr<const std::vector<unsigned char> > CompressedBlock;
+
+  /// Labelmap representation stored in compressed form. Voxels are decompressed when the state is restored.
+  struct CompressedLabelmap
+    {
+    /// Geometry (extent, origin, spacing, directions) of the labelmap, without voxels
+    vtkSmartPointer<vtkOrientedImageData> Geometry;
+    int ScalarType{0};
+    int NumberOfScalarComponents{0};
+    /// Labelmap that was compressed and its modified time at that time.
+    /// Used for avoiding compressing the same labelmap again when it is not modified.
+    vtkWeakPointer<vtkDataObject> Source;
+    vtkMTimeType SourceMTime{0};
+    /// Compressed voxel blocks, ordered by increasing k, j, i block index
+    std::vector<CompressedBlock> Blocks;
+    };
+
+  /// Compressed labelmaps of a segment (key: representation name)
+  typedef std::map<std::string, std::shared_ptr<CompressedLabelmap> > CompressedRepresentationsMap;
+
   struct SegmentationState
     {
+    /// Segments. Labelmap representations are not stored in them but in CompressedRepresentations.
     SegmentsMap Segments;
+    /// Compressed labelmap representations of segments (key: segment ID)
+    std::map<std::string, CompressedRepresentationsMap> CompressedRepresentations;
     std::vector<std::string> SegmentIds; // order of segments
     };
 
+  /// Compress labelmap. Blocks that are identical to blocks in the baseline are shared with the baseline.
+  static std::shared_ptr<CompressedLabelmap> CompressLabelmap(vtkOrientedImageData* labelmap,
+    const CompressedLabelmap* baseline);
+
+  /// Create labelmap from compressed data
+  static vtkSmartPointer<vtkOrientedImageData> DecompressLabelmap(const CompressedLabelmap* compressedLabelmap);
+
   vtkSegmentation* Segmentation;
   vtkCallbackCommand* SegmentationModifiedCallbackCommand;
   std::deque<SegmentationState> SegmentationStates;
@@ -36,6 +36,61 @@
 
 vtkStandardNewMacro(vtkSegmentationModifier);
 
+//-----------------------------------------------------------------------------
+template <class LabelmapScalarType, class SegmentScalarType>
+void FillMinimumModifierLabelmapGeneric2(vtkOrientedImageData* labelmap, vtkOrientedImageData* segmentLabelmap, int labelValue,
+  vtkOrientedImageData* modifierLabelmap)
+{
+  // Voxels inside the labelmap are kept (set to maximum), voxels outside are removed (set to 0).
+  // If segmentLabelmap is specified then only voxels of the segment are removed, all other voxels are kept.
+  int modifierExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  modifierLabelmap->GetExtent(modifierExtent);
+  int segmentExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  if (segmentLabelmap)
+    {
+    segmentLabelmap->GetExtent(segmentExtent);
+    }
+  const SegmentScalarType keepValue = static_cast<SegmentScalarType>(modifierLabelmap->GetScalarTypeMax());
+  const SegmentScalarType segmentValue = static_cast<SegmentScalarType>(labelValue);
+  for (int z = modifierExtent[4]; z <= modifierExtent[5]; ++z)
+    {
+    for (int y = modifierExtent[2]; y <= modifierExtent[3]; ++y)
+      {
+      LabelmapScalarType* labelmapRow = static_cast<LabelmapScalarType*>(labelmap->GetScalarPointer(modifierExtent[0], y, z));
+      SegmentScalarType* modifierRow = static_cast<SegmentScalarType*>(modifierLabelmap->GetScalarPointer(modifierExtent[0], y, z));
+      SegmentScalarType* segmentRow = nullptr;
+      if (segmentLabelmap && y >= segmentExtent[2] && y <= segmentExtent[3] && z >= segmentExtent[4] && z <= segmentExtent[5])
+        {
+        segmentRow = static_cast<SegmentScalarType*>(segmentLabelmap->GetScalarPointer(segmentExtent[0], y, z));
+        }
+      for (int x = modifierExtent[0]; x <= modifierExtent[1]; ++x, ++labelmapRow, ++modifierRow)
+        {
+        bool keep = (*labelmapRow > 0);
+        if (!keep && segmentLabelmap)
+          {
+          bool inSegment = segmentRow && x >= segmentExtent[0] && x <= segmentExtent[1]
+            && segmentRow[x - segmentExtent[0]] == segmentValue;
+          keep = !inSegment;
+          }
+        *modifierRow = keep ? keepValue : 0;
+        }
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+template <class LabelmapScalarType>
+void FillMinimumModifierLabelmapGeneric(vtkOrientedImageData* labelmap, vtkOrientedImageData* segmentLabelmap, int labelValue,
+  vtkOrientedImageData* modifierLabelmap)
+{
+  switch (modifierLabelmap->GetScalarType())
+    {
+    vtkTemplateMacro((FillMinimumModifierLabelmapGeneric2<LabelmapScalarType, VTK_TT>(labelmap, segmentLabelmap, labelValue, modifierLabelmap)));
+    default:
+      vtkGenericWarningMacro("vtkSegmentationModifier::FillMinimumModifierLabelmap: Unknown ScalarType");
+    }
+}
+
 //-----------------------------------------------------------------------------
 vtkSegmentationModifier::vtkSegmentationModifier() = default;
 
@@ -87,6 +142,15 @@ bool vtkSegmentationModifier::ModifyBinaryLabelmap(
     return false;
     }
 
+  // Store the state of the segment labelmap before the modification so that the modified region can be recorded
+  vtkMTimeType segmentLabelmapBaseMTime = segmentLabelmap->GetMTime();
+  int segmentLabelmapBaseScalarType = segmentLabelmap->GetScalarType();
+  int segmentLabelmapBaseExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  segmentLabelmap->GetExtent(segmentLabelmapBaseExtent);
+  bool segmentLabelmapBaseEmpty = segmentLabelmap->IsEmpty();
+  // If the geometries do not match then the modifier extent cannot be used as modified region
+  bool modifiedExtentKnown = segmentLabelmapBaseEmpty || vtkOrientedImageDataResample::DoGeometriesMatch(segmentLabelmap, labelmap);
+
   bool wasSourceRepresentationModifiedEnabled = segmentation->SetSourceRepresentationModifiedEnabled(sourceRepresentationModifiedEnabled);
 
   bool segmentLabelmapModified = true;
@@ -97,8 +161,30 @@ bool vtkSegmentationModifier::ModifyBinaryLabelmap(
     return false;
     }
 
+  // Record the modified region so that consumers can update only the changed part of the labelmap.
+  // It is recorded before shrinking the labelmap so that the effective extent is only computed in the modified region.
+  bool modifiedExtentRecorded = false;
+  int modifiedExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  if (modifiedExtentKnown && segmentLabelmap->GetScalarType() == segmentLabelmapBaseScalarType)
+    {
+    vtkSegmentationModifier::GetExtentIntersection(labelmap->GetExtent(), extent, modifiedExtent);
+    if (mergeMode == MODE_REPLACE && !segmentLabelmapBaseEmpty)
+      {
+      // Replaced labelmap may be different anywhere within the original labelmap extent
+      vtkSegmentationModifier::GetExtentUnion(modifiedExtent, segmentLabelmapBaseExtent, modifiedExtent);
+      }
+    segmentLabelmap->SetModifiedExtent(modifiedExtent, segmentLabelmapBaseMTime);
+    modifiedExtentRecorded = true;
+    }
+
   // Shrink the image data extent to only contain the effective data (extent of non-zero voxels)
+  vtkMTimeType segmentLabelmapModifiedMTime = segmentLabelmap->GetMTime();
   vtkSegmentationModifier::ShrinkSegmentToEffectiveExtent(segmentLabelmap);
+  if (modifiedExtentRecorded && segmentLabelmap->GetMTime() != segmentLabelmapModifiedMTime)
+    {
+    // Shrinking only removed empty voxels, voxel values are still only changed in the modified region
+    segmentLabelmap->SetModifiedExtent(modifiedExtent, segmentLabelmapBaseMTime);
+    }
 
   // Re-enable source representation modified event
   segmentation->SetSourceRepresentationModifiedEnabled(wasSourceRepresentationModifiedEnabled);
@@ -240,6 +326,42 @@ void vtkSegmentationModifier::GetExtentIntersection(const int extentA[6], const
     }
 }
 
+//-----------------------------------------------------------------------------
+void vtkSegmentationModifier::GetExtentUnion(const int extentA[6], const int extentB[6], int extentUnion[6])
+{
+  if (!extentUnion)
+    {
+    vtkGenericWarningMacro("vtkSegmentationModifier::GetExtentUnion failed: invalid extentUnion");
+    return;
+    }
+  bool validExtentA = extentA && extentA[0]<=extentA[1] && extentA[2]<=extentA[3] && extentA[4]<=extentA[5];
+  bool validExtentB = extentB && extentB[0]<=extentB[1] && extentB[2]<=extentB[3] && extentB[4]<=extentB[5];
+  if (validExtentA && validExtentB)
+    {
+    for (int axis=0; axis<3; axis++)
+      {
+      extentUnion[axis*2] = std::min(extentA[axis*2], extentB[axis*2]);
+      extentUnion[axis*2+1] = std::max(extentA[axis*2+1], extentB[axis*2+1]);
+      }
+    }
+  else if (validExtentA)
+    {
+    std::copy(extentA, extentA + 6, extentUnion);
+    }
+  else if (validExtentB)
+    {
+    std::copy(extentB, extentB + 6, extentUnion);
+    }
+  else
+    {
+    for (int axis=0; axis<3; axis++)
+      {
+      extentUnion[axis*2] = 0;
+      extentUnion[axis*2+1] = -1;
+      }
+    }
+}
+
 //-----------------------------------------------------------------------------
 bool vtkSegmentationModifier::IsExtentValid(int extent[6])
 {
@@ -361,22 +483,22 @@ bool vtkSegmentationModifier::AppendLabelmapToSegment(vtkOrientedImageData* labe
       }
 
     vtkSmartPointer<vtkOrientedImageData> modifierLabelmap = labelmap;
+    bool fillMinimumModifierLabelmap = false;
     if (operation == vtkOrientedImageDataResample::OPERATION_MINIMUM)
       {
       int updateExtent[6] = { 0, -1, 0, -1, 0, -1 };
       vtkSegmentationModifier::GetExtentIntersection(labelmap->GetExtent(), extent, updateExtent);
       if (vtkSegmentationModifier::IsExtentValid(updateExtent))
         {
-        vtkNew<vtkImageThreshold> threshold;
-        threshold->SetInputData(labelmap);
-        threshold->ThresholdByLower(0);
-        threshold->SetInValue(0);
-        threshold->SetOutValue(segmentLabelmap->GetScalarTypeMax());
-        threshold->SetOutputScalarType(segmentLabelmap->GetScalarType());
-        threshold->UpdateExtent(updateExtent);
+        // The modifier is only allocated in the update extent. Its content is computed after the
+        // segment labelmap is resampled, in a single pass (without thresholding and masking the full image).
         modifierLabelmap = vtkSmartPointer<vtkOrientedImageData>::New();
-        modifierLabelmap->ShallowCopy(threshold->GetOutput());
+        modifierLabelmap->SetOrigin(labelmap->GetOrigin());
+        modifierLabelmap->SetSpacing(labelmap->GetSpacing());
         modifierLabelmap->CopyDirections(labelmap);
+        modifierLabelmap->SetExtent(updateExtent);
+        modifierLabelmap->AllocateScalars(segmentLabelmap->GetScalarType(), 1);
+        fillMinimumModifierLabelmap = true;
         }
       }
     else
@@ -404,31 +526,21 @@ bool vtkSegmentationModifier::AppendLabelmapToSegment(vtkOrientedImageData* labe
       resampledSegmentLabelmap = segmentLabelmap;
       }
 
-    if (operation == vtkOrientedImageDataResample::OPERATION_MINIMUM && !minimumOfAllSegments)
+    if (fillMinimumModifierLabelmap)
       {
-      vtkNew<vtkOrientedImageData> segmentMask;
-      vtkNew<vtkImageThreshold> thresholdSegment;
-      thresholdSegment->SetInputData(resampledSegmentLabelmap);
-      thresholdSegment->ThresholdBetween(labelValue, labelValue);
-      thresholdSegment->SetInValue(1);
-      thresholdSegment->SetOutValue(0);
-      thresholdSegment->SetOutputScalarTypeToUnsignedChar();
-      int updateExtent[6] = {0, -1, 0, -1, 0, -1};
-      vtkSegmentationModifier::GetExtentIntersection(resampledSegmentLabelmap->GetExtent(), extent, updateExtent);
-      if (vtkSegmentationModifier::IsExtentValid(updateExtent))
+      // Unless minimum of all segments is requested, only voxels of this segment are removed
+      vtkOrientedImageData* segmentMask = (minimumOfAllSegments ? nullptr : resampledSegmentLabelmap.GetPointer());
+      if (segmentMask && segmentMask->GetScalarType() != modifierLabelmap->GetScalarType())
+        {
+        vtkErrorWithObjectMacro(segmentation, "vtkSegmentationModifier::AppendLabelmapToSegment: Scalar type mismatch after resampling segment labelmap");
+        return false;
+        }
+      switch (labelmap->GetScalarType())
         {
-        vtkNew<vtkImageThreshold> thresholdSegment;
-        thresholdSegment->SetInputData(resampledSegmentLabelmap);
-        thresholdSegment->ThresholdBetween(labelValue, labelValue);
-        thresholdSegment->SetInValue(1);
-        thresholdSegment->SetOutValue(0);
-        thresholdSegment->SetOutputScalarTypeToUnsignedChar();
-        thresholdSegment->UpdateExtent(updateExtent);
-
-        vtkNew<vtkOrientedImageData> segmentMask;
-        segmentMask->ShallowCopy(thresholdSegment->GetOutput());
-        segmentMask->CopyDirections(resampledSegmentLabelmap);
-        vtkOrientedImageDataResample::ApplyImageMask(modifierLabelmap, segmentMask, modifierLabelmap->GetScalarTypeMax());
+        vtkTemplateMacro(FillMinimumModifierLabelmapGeneric<VTK_TT>(labelmap, segmentMask, labelValue, modifierLabelmap));
+        default:
+          vtkErrorWithObjectMacro(segmentation, "vtkSegmentationModifier::AppendLabelmapToSegment: Unknown ScalarType");
+          return false;
         }
       }
 
@@ -472,6 +584,9 @@ void vtkSegmentationModifier::ShrinkSegmentToEffectiveExtent(vtkOrientedImageDat
       padder->SetOutputWholeExtent(effectiveExtent);
       padder->Update();
       segmentLabelmap->ShallowCopy(padder->GetOutput());
+      // Cropping does not change the effective extent. Store it for the new modified time so that
+      // it does not have to be computed from scratch at the next modification.
+      segmentLabelmap->SetCachedEffectiveExtent(effectiveExtent, 0.0);
       }
     }
 }
@@ -45,6 +45,7 @@ public:
   /// Source representation must be binary labelmap! Source representation changed event is disabled to prevent deletion of all
   /// other representation in all segments. The other representations in the given segment are re-converted. The extent of the
   /// segment binary labelmap is shrunk to the effective extent. Display update is triggered.
+  /// The modified region is recorded in the segment binary labelmap (see vtkOrientedImageData::GetModifiedExtent).
   /// \param mergeMode Determines if the labelmap should replace the segment, combined with a maximum or minimum operation, or set under the mask.
   /// \param extent If extent is specified then only that extent of the labelmap is used.
   enum
@@ -86,6 +87,13 @@ protected:
   /// \param extentIntersection computed intersection of the two input extents
   static void GetExtentIntersection(const int extentA[6], const int extentB[6], int extentIntersection[6]);
 
+  /// Get the smallest extent that contains both extents.
+  /// If any of the input extents are nullptr or empty then the other extent is returned.
+  /// \param extentA first input extent
+  /// \param extentA second input extent
+  /// \param extentUnion computed union of the two input extents
+  static void GetExtentUnion(const int extentA[6], const int extentB[6], int extentUnion[6]);
+
   /// Returns true if the extent is valid, false otherwise
   /// \param Extent to be validated
   static bool IsExtentValid(int extent[6]);
@@ -26,6 +26,12 @@
 #include <vtkNew.h>
 #include <vtkPolyDataCollection.h>
 #include <vtkIntArray.h>
+#include <vtkSMPTools.h>
+
+// STD includes
+#include <algorithm>
+#include <array>
+#include <vector>
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkTopologicalHierarchy);
@@ -80,6 +86,12 @@ bool vtkTopologicalHierarchy::Contains(vtkPolyData* polyOut, vtkPolyData* polyIn
   double extentIn[6] = {0.0,0.0,0.0,0.0,0.0,0.0};
   polyIn->GetBounds(extentIn);
 
+  return this->BoundsContain(extentOut, extentIn);
+}
+
+//----------------------------------------------------------------------------
+bool vtkTopologicalHierarchy::BoundsContain(const double extentOut[6], const double extentIn[6])
+{
   if ( extentOut[0] < extentIn[0] - this->ContainConstraintFactor * (extentOut[1]-extentOut[0])
     && extentOut[1] > extentIn[1] + this->ContainConstraintFactor * (extentOut[1]-extentOut[0])
     && extentOut[2] < extentIn[2] - this->ContainConstraintFactor * (extentOut[3]-extentOut[2])
@@ -105,15 +117,20 @@ void vtkTopologicalHierarchy::Update()
   this->OutputLevels->Initialize();
   unsigned int numberOfPolyData = this->InputPolyDataCollection->GetNumberOfItems();
 
-  // Check input polydata collection
+  // Check input polydata collection and get bounds of all polydata
+  // (bounds computation is not thread-safe, therefore it is done before the parallel containment test)
+  std::vector<std::array<double, 6> > bounds(numberOfPolyData);
+  vtkCollectionSimpleIterator it;
+  this->InputPolyDataCollection->InitTraversal(it);
   for (unsigned int polyOutIndex=0; polyOutIndex<numberOfPolyData; ++polyOutIndex)
     {
-    vtkPolyData* polyOut = vtkPolyData::SafeDownCast(this->InputPolyDataCollection->GetItemAsObject(polyOutIndex));
+    vtkPolyData* polyOut = vtkPolyData::SafeDownCast(this->InputPolyDataCollection->GetNextItemAsObject(it));
     if (!polyOut)
       {
       vtkErrorMacro("Update: Input collection contains invalid object at item " << polyOutIndex);
       return;
       }
+    polyOut->GetBounds(bounds[polyOutIndex].data());
     }
 
   std::vector<std::vector<unsigned int> > containedPolyData(numberOfPolyData);
@@ -122,26 +139,53 @@ void vtkTopologicalHierarchy::Update()
   this->OutputLevels->FillComponent(0, -1);
 
   // Step 1: Set level of polydata containing no other polydata to 0
-  this->InputPolyDataCollection->InitTraversal();
-  for (unsigned int polyOutIndex=0; polyOutIndex<numberOfPolyData; ++polyOutIndex)
+  // Polydata are sorted by the lower X bound, so that for each outer polydata only those inner polydata
+  // are tested whose lower X bound is within the (constrained) X range of the outer polydata.
+  std::vector<unsigned int> sortedIndices(numberOfPolyData);
+  for (unsigned int index = 0; index < numberOfPolyData; ++index)
+    {
+    sortedIndices[index] = index;
+    }
+  std::sort(sortedIndices.begin(), sortedIndices.end(), [&bounds](unsigned int a, unsigned int b)
     {
-    vtkPolyData* polyOut = vtkPolyData::SafeDownCast(this->InputPolyDataCollection->GetItemAsObject(polyOutIndex));
+    return bounds[a][0] < bounds[b][0];
+    });
+  std::vector<double> sortedLowerXBounds(numberOfPolyData);
+  for (unsigned int index = 0; index < numberOfPolyData; ++index)
+    {
+    sortedLowerXBounds[index] = bounds[sortedIndices[index]][0];
+    }
 
-    for (unsigned int polyInIndex=0; polyInIndex<numberOfPolyData; ++polyInIndex)
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numberOfPolyData), [&](vtkIdType firstPolyOutIndex, vtkIdType endPolyOutIndex)
+    {
+    for (vtkIdType polyOutIndex = firstPolyOutIndex; polyOutIndex < endPolyOutIndex; ++polyOutIndex)
       {
-      if (polyOutIndex==polyInIndex)
-        {
-        continue;
-        }
-
-      vtkPolyData* polyIn = vtkPolyData::SafeDownCast(this->InputPolyDataCollection->GetItemAsObject(polyInIndex));
-
-      if (this->Contains(polyOut, polyIn))
+      const double* extentOut = bounds[polyOutIndex].data();
+      double margin = this->ContainConstraintFactor * (extentOut[1] - extentOut[0]);
+      // Contained polydata must have its lower X bound in the range (extentOut[0] + margin, extentOut[1] - margin)
+      std::vector<double>::iterator candidateBegin =
+        std::upper_bound(sortedLowerXBounds.begin(), sortedLowerXBounds.end(), extentOut[0] + margin);
+      std::vector<double>::iterator candidateEnd =
+        std::lower_bound(candidateBegin, sortedLowerXBounds.end(), extentOut[1] - margin);
+      for (std::vector<double>::iterator candidateIt = candidateBegin; candidateIt != candidateEnd; ++candidateIt)
         {
-        containedPolyData[polyOutIndex].push_back(polyInIndex);
+        unsigned int polyInIndex = sortedIndices[candidateIt - sortedLowerXBounds.begin()];
+        if (polyInIndex == static_cast<unsigned int>(polyOutIndex))
+          {
+          continue;
+          }
+        if (this->BoundsContain(extentOut, bounds[polyInIndex].data()))
+          {
+          containedPolyData[polyOutIndex].push_back(polyInIndex);
+          }
         }
+      // Keep the same order as if all polydata were tested
+      std::sort(containedPolyData[polyOutIndex].begin(), containedPolyData[polyOutIndex].end());
       }
+    });
 
+  for (unsigned int polyOutIndex=0; polyOutIndex<numberOfPolyData; ++polyOutIndex)
+    {
     if (containedPolyData[polyOutIndex].size() == 0)
       {
       this->OutputLevels->SetValue(polyOutIndex, 0);
@@ -169,30 +213,8 @@ void vtkTopologicalHierarchy::Update()
       //   The level that is to be set cannot be lower than the current level value, because then we would
       //   already have assigned it in the previous iterations.
       bool allContainedPolydataHasLevelValueAssigned = true;
-      for (unsigned int polyInIndex = 0;
-           polyInIndex < numberOfPolyData;
-           ++polyInIndex)
+      for (unsigned int polyInIndex : containedPolyData[polyOutIndex])
         {
-        if (polyOutIndex==polyInIndex)
-          {
-          continue;
-          }
-        bool isContained = false;
-        for (std::vector<unsigned int>::iterator it = containedPolyData[polyOutIndex].begin();
-             it != containedPolyData[polyOutIndex].end();
-             ++it)
-          {
-          if ((*it) == polyInIndex)
-            {
-            isContained = true;
-            break;
-            }
-          }
-        if (!isContained)
-          {
-          continue;
-          }
-
         if (outputLevelsSnapshot->GetValue(polyInIndex) == -1)
           {
           allContainedPolydataHasLevelValueAssigned = false;
@@ -73,6 +73,9 @@ protected:
   /// /sa ContainConstraintFactor
   bool Contains(vtkPolyData* polyOut, vtkPolyData* polyIn);
 
+  /// Determines if bounds extentOut contains bounds extentIn considering the constraint factor
+  bool BoundsContain(const double extentOut[6], const double extentIn[6]);
+
   /// Determines if there are empty entries in the output level array
   bool OutputContainsEmptyLevels();
 
@@ -0,0 +1,118 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// vtkTeem includes
+#include <vtkDiffusionTensorGlyph.h>
+
+// VTK includes
+#include <vtkDataArray.h>
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkMath.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkSphereSource.h>
+
+// STD includes
+#include <iostream>
+
+//----------------------------------------------------------------------------
+int vtkDiffusionTensorGlyphInstancesTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // Two voxels with different, non-axis-aligned tensors
+  vtkNew<vtkImageData> tensorImage;
+  tensorImage->SetDimensions(2, 1, 1);
+  tensorImage->SetSpacing(2.0, 2.0, 2.0);
+  vtkNew<vtkFloatArray> tensors;
+  tensors->SetNumberOfComponents(9);
+  tensors->SetNumberOfTuples(2);
+  const float tensor0[9] = { 3e-3f, 1e-3f, 0.0f, 1e-3f, 2e-3f, 0.5e-3f, 0.0f, 0.5e-3f, 1e-3f };
+  const float tensor1[9] = { 1e-3f, 0.0f, 0.2e-3f, 0.0f, 1e-3f, 0.0f, 0.2e-3f, 0.0f, 4e-3f };
+  tensors->SetTypedTuple(0, tensor0);
+  tensors->SetTypedTuple(1, tensor1);
+  tensorImage->GetPointData()->SetTensors(tensors);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(6);
+  sphere->SetPhiResolution(6);
+  sphere->Update();
+  vtkPoints* sourcePoints = sphere->GetOutput()->GetPoints();
+
+  vtkNew<vtkDiffusionTensorGlyph> glyphFilter;
+  glyphFilter->SetInputData(tensorImage);
+  glyphFilter->SetSourceConnection(sphere->GetOutputPort());
+  glyphFilter->SetScaleFactor(100.0);
+  glyphFilter->ClampScalingOff();
+  glyphFilter->Update();
+  vtkPolyData* glyphs = glyphFilter->GetOutput();
+
+  vtkNew<vtkDiffusionTensorGlyph> instancesFilter;
+  instancesFilter->SetInputData(tensorImage);
+  instancesFilter->SetSourceConnection(sphere->GetOutputPort());
+  instancesFilter->SetScaleFactor(100.0);
+  instancesFilter->ClampScalingOff();
+  instancesFilter->OutputGlyphInstancesOn();
+  instancesFilter->Update();
+  vtkPolyData* instances = instancesFilter->GetOutput();
+
+  vtkDataArray* orientations = instances->GetPointData()->GetArray("GlyphOrientation");
+  vtkDataArray* scales = instances->GetPointData()->GetArray("GlyphScale");
+  if (instances->GetNumberOfPoints() != 2 || !orientations || !scales
+    || glyphs->GetNumberOfPoints() != 2 * sourcePoints->GetNumberOfPoints())
+    {
+    std::cerr << "Unexpected output: " << instances->GetNumberOfPoints() << " instances, "
+      << glyphs->GetNumberOfPoints() << " glyph points" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if (glyphs->GetPointData()->GetScalars()->GetTuple1(0) != instances->GetPointData()->GetScalars()->GetTuple1(0))
+    {
+    std::cerr << "Glyph instance scalar mismatch" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Transforming the source by the instance transforms must give the generated glyph geometry
+  for (vtkIdType instanceIndex = 0; instanceIndex < 2; instanceIndex++)
+    {
+    double position[3] = { 0.0, 0.0, 0.0 };
+    instances->GetPoint(instanceIndex, position);
+    double orientation[4] = { 1.0, 0.0, 0.0, 0.0 };
+    orientations->GetTuple(instanceIndex, orientation);
+    double rotation[3][3];
+    vtkMath::QuaternionToMatrix3x3(orientation, rotation);
+    double* scale = scales->GetTuple3(instanceIndex);
+    double scaleCopy[3] = { scale[0], scale[1], scale[2] };
+    for (vtkIdType sourcePointIndex = 0; sourcePointIndex < sourcePoints->GetNumberOfPoints(); sourcePointIndex++)
+      {
+      double sourcePoint[3] = { 0.0, 0.0, 0.0 };
+      sourcePoints->GetPoint(sourcePointIndex, sourcePoint);
+      double scaledPoint[3] = { sourcePoint[0] * scaleCopy[0], sourcePoint[1] * scaleCopy[1], sourcePoint[2] * scaleCopy[2] };
+      double instancePoint[3] = { 0.0, 0.0, 0.0 };
+      vtkMath::Multiply3x3(rotation, scaledPoint, instancePoint);
+      vtkMath::Add(instancePoint, position, instancePoint);
+      double glyphPoint[3] = { 0.0, 0.0, 0.0 };
+      glyphs->GetPoint(instanceIndex * sourcePoints->GetNumberOfPoints() + sourcePointIndex, glyphPoint);
+      if (sqrt(vtkMath::Distance2BetweenPoints(instancePoint, glyphPoint)) > 1e-3)
+        {
+        std::cerr << "Glyph instance " << instanceIndex << " point " << sourcePointIndex << " mismatch: "
+          << instancePoint[0] << ", " << instancePoint[1] << ", " << instancePoint[2] << " != "
+          << glyphPoint[0] << ", " << glyphPoint[1] << ", " << glyphPoint[2] << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -24,6 +24,7 @@
 // VTK includes
 #include <vtkDataArray.h>
 #include <vtkImageData.h>
+#include <vtkMath.h>
 #include <vtkMultiThreader.h>
 #include <vtkNew.h>
 #include <vtkPointData.h>
@@ -95,6 +96,14 @@ int vtkDiffusionTensorMathematicsTest1(int vtkNotUsed(argc), char* vtkNotUsed(ar
   filter->SetScalarMask(maskImage.GetPointer());
   filter->SetMaskLabelValue(0);  // mask all the labels different from 0
   filter->SetMaskWithScalars(1); // turn on masking
+
+  // Same filter with eigensystem caching enabled must give the same results
+  vtkNew<vtkDiffusionTensorMathematics> cachingFilter;
+  cachingFilter->SetInputData(tensorImage.GetPointer());
+  cachingFilter->SetScalarMask(maskImage.GetPointer());
+  cachingFilter->SetMaskLabelValue(0);
+  cachingFilter->SetMaskWithScalars(1);
+  cachingFilter->CacheEigensystemsOn();
   for (int i = vtkDiffusionTensorMathematics::VTK_TENS_TRACE;
        i <=vtkDiffusionTensorMathematics::VTK_TENS_MEAN_DIFFUSIVITY;
        ++i)
@@ -118,6 +127,28 @@ int vtkDiffusionTensorMathematicsTest1(int vtkNotUsed(argc), char* vtkNotUsed(ar
         }
       }
     std::cout << std::endl << std::endl;
+
+    cachingFilter->SetOperation(i);
+    cachingFilter->Update();
+    vtkDataArray* expectedScalars = output->GetPointData()->GetScalars();
+    vtkDataArray* cachedScalars = cachingFilter->GetOutput()->GetPointData()->GetScalars();
+    if (cachedScalars->GetNumberOfValues() != expectedScalars->GetNumberOfValues())
+      {
+      std::cerr << "Operation " << i << ": number of output values mismatch with eigensystem caching" << std::endl;
+      return EXIT_FAILURE;
+      }
+    for (vtkIdType valueIndex = 0; valueIndex < expectedScalars->GetNumberOfValues(); ++valueIndex)
+      {
+      int numberOfComponents = expectedScalars->GetNumberOfComponents();
+      double expected = expectedScalars->GetComponent(valueIndex / numberOfComponents, valueIndex % numberOfComponents);
+      double actual = cachedScalars->GetComponent(valueIndex / numberOfComponents, valueIndex % numberOfComponents);
+      if (expected != actual && !(vtkMath::IsNan(expected) && vtkMath::IsNan(actual)))
+        {
+        std::cerr << "Operation " << i << ": output value " << valueIndex << " is " << actual
+          << " with eigensystem caching, expected " << expected << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
     }
   return EXIT_SUCCESS;
 }
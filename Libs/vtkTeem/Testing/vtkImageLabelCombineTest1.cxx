@@ -0,0 +1,131 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// vtkTeem includes
+#include <vtkImageLabelCombine.h>
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkNew.h>
+
+// STD includes
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+void SetImageValues(vtkImageData* image, const short* values, int numberOfValues)
+{
+  image->SetDimensions(numberOfValues, 1, 1);
+  image->AllocateScalars(VTK_SHORT, 1);
+  short* ptr = static_cast<short*>(image->GetScalarPointer());
+  for (int i = 0; i < numberOfValues; ++i)
+    {
+    ptr[i] = values[i];
+    }
+}
+
+//----------------------------------------------------------------------------
+short CombineLabels(short v1, short v2, bool overwrite)
+{
+  if (overwrite)
+    {
+    std::swap(v1, v2);
+    }
+  if (v1 > 0)
+    {
+    return v1;
+    }
+  return (v1 == 0 && v2 > 0) ? v2 : 0;
+}
+
+//----------------------------------------------------------------------------
+bool CheckOutput(vtkImageLabelCombine* filter, const short* expected, int numberOfValues, const char* testName)
+{
+  filter->Update();
+  vtkImageData* output = filter->GetOutput();
+  if (output->GetScalarType() != VTK_SHORT
+    || output->GetNumberOfPoints() != numberOfValues)
+    {
+    std::cerr << testName << ": unexpected output type or size" << std::endl;
+    return false;
+    }
+  short* ptr = static_cast<short*>(output->GetScalarPointer());
+  for (int i = 0; i < numberOfValues; ++i)
+    {
+    if (ptr[i] != expected[i])
+      {
+      std::cerr << testName << ": mismatch at voxel " << i
+                << ", expected " << expected[i] << ", got " << ptr[i] << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkImageLabelCombineTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  const int numberOfValues = 9;
+  const short values1[numberOfValues] = { 0, 0, 0, 3, 3, 3, -1, -1, -1 };
+  const short values2[numberOfValues] = { 0, 5, -2, 0, 5, -2, 0, 5, -2 };
+  const short values3[numberOfValues] = { 7, 0, 7, -4, 0, 7, 7, 7, 0 };
+
+  vtkNew<vtkImageData> image1;
+  vtkNew<vtkImageData> image2;
+  vtkNew<vtkImageData> image3;
+  SetImageValues(image1, values1, numberOfValues);
+  SetImageValues(image2, values2, numberOfValues);
+  SetImageValues(image3, values3, numberOfValues);
+
+  for (int overwrite = 0; overwrite <= 1; ++overwrite)
+    {
+    // Two inputs
+    vtkNew<vtkImageLabelCombine> twoInputFilter;
+    twoInputFilter->SetOverwriteInput(overwrite);
+    twoInputFilter->SetInput1(image1);
+    twoInputFilter->SetInput2(image2);
+    short expected[numberOfValues];
+    for (int i = 0; i < numberOfValues; ++i)
+      {
+      expected[i] = CombineLabels(values1[i], values2[i], overwrite != 0);
+      }
+    if (!CheckOutput(twoInputFilter, expected, numberOfValues, "Two inputs"))
+      {
+      return EXIT_FAILURE;
+      }
+
+    // Three inputs must give the same result as combining them pairwise in order
+    vtkNew<vtkImageLabelCombine> threeInputFilter;
+    threeInputFilter->SetOverwriteInput(overwrite);
+    threeInputFilter->AddInputLabelMap(image1);
+    threeInputFilter->AddInputLabelMap(image2);
+    threeInputFilter->AddInputLabelMap(image3);
+    for (int i = 0; i < numberOfValues; ++i)
+      {
+      expected[i] = CombineLabels(CombineLabels(values1[i], values2[i], overwrite != 0), values3[i], overwrite != 0);
+      }
+    if (!CheckOutput(threeInputFilter, expected, numberOfValues, "Three inputs"))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
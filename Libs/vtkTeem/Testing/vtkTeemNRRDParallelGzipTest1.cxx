@@ -0,0 +1,125 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// vtkTeem includes
+#include <vtkTeemNRRDReader.h>
+#include <vtkTeemNRRDWriter.h>
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkTimerLog.h>
+
+// STD includes
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+bool ReadAndCompare(const std::string& fileName, vtkImageData* expectedImage, int numberOfThreads)
+{
+  vtkNew<vtkTeemNRRDReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetNumberOfThreads(numberOfThreads);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  reader->Update();
+  timer->StopTimer();
+  std::cout << "Read with " << numberOfThreads << " threads: " << timer->GetElapsedTime() << "s" << std::endl;
+
+  vtkImageData* image = reader->GetOutput();
+  int expectedDimensions[3] = { 0, 0, 0 };
+  expectedImage->GetDimensions(expectedDimensions);
+  int dimensions[3] = { 0, 0, 0 };
+  image->GetDimensions(dimensions);
+  if (dimensions[0] != expectedDimensions[0] || dimensions[1] != expectedDimensions[1] || dimensions[2] != expectedDimensions[2]
+    || image->GetScalarType() != expectedImage->GetScalarType())
+    {
+    std::cerr << "Image read from " << fileName << " has unexpected dimensions or scalar type" << std::endl;
+    return false;
+    }
+  short* expectedPtr = static_cast<short*>(expectedImage->GetScalarPointer());
+  short* ptr = static_cast<short*>(image->GetScalarPointer());
+  for (vtkIdType i = 0; i < expectedImage->GetNumberOfPoints(); ++i)
+    {
+    if (ptr[i] != expectedPtr[i])
+      {
+      std::cerr << "Image read from " << fileName << " differs from the written image at voxel " << i << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool TestWriteRead(const std::string& fileName, vtkImageData* image, int numberOfThreads)
+{
+  vtkNew<vtkTeemNRRDWriter> writer;
+  writer->SetFileName(fileName.c_str());
+  writer->SetInputData(image);
+  writer->SetUseCompression(true);
+  writer->SetCompressionLevel(1);
+  writer->SetNumberOfThreads(numberOfThreads);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  writer->Write();
+  timer->StopTimer();
+  if (writer->GetWriteError())
+    {
+    std::cerr << "Failed to write " << fileName << std::endl;
+    return false;
+    }
+  std::cout << "Write with " << numberOfThreads << " threads: " << timer->GetElapsedTime() << "s" << std::endl;
+
+  // Files must be readable by both the parallel and the standard reader
+  return ReadAndCompare(fileName, image, 0) && ReadAndCompare(fileName, image, 1);
+}
+
+}
+
+//----------------------------------------------------------------------------
+int vtkTeemNRRDParallelGzipTest1(int argc, char* argv[])
+{
+  if (argc != 2)
+    {
+    std::cerr << "Usage: " << argv[0] << " /path/to/temp" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::string tempDir = argv[1];
+
+  // Image that is split into multiple compressed chunks, the last chunk is incomplete
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(300, 200, 100);
+  image->AllocateScalars(VTK_SHORT, 1);
+  short* imagePtr = static_cast<short*>(image->GetScalarPointer());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    imagePtr[i] = static_cast<short>((i / 7) % 1000);
+    }
+
+  if (!TestWriteRead(tempDir + "/vtkTeemNRRDParallelGzipTest1.nrrd", image, 0))
+    {
+    return EXIT_FAILURE;
+    }
+  if (!TestWriteRead(tempDir + "/vtkTeemNRRDParallelGzipTest1SingleThread.nrrd", image, 1))
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Parallel gzip NRRD test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,129 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// vtkTeem includes
+#include <vtkTeemNRRDReader.h>
+#include <vtkTeemNRRDWriter.h>
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+
+// STD includes
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> ReadImage(const std::string& fileName, bool useMemoryMapping)
+{
+  vtkNew<vtkTeemNRRDReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetUseMemoryMapping(useMemoryMapping);
+  reader->Update();
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->ShallowCopy(reader->GetOutput());
+  return image;
+}
+
+//----------------------------------------------------------------------------
+bool CompareImages(vtkImageData* image, vtkImageData* expectedImage, const std::string& description)
+{
+  if (!image->GetScalarPointer() || image->GetNumberOfPoints() != expectedImage->GetNumberOfPoints()
+    || image->GetScalarType() != expectedImage->GetScalarType())
+    {
+    std::cerr << description << ": image size or scalar type mismatch" << std::endl;
+    return false;
+    }
+  float* expectedPtr = static_cast<float*>(expectedImage->GetScalarPointer());
+  float* ptr = static_cast<float*>(image->GetScalarPointer());
+  for (vtkIdType i = 0; i < expectedImage->GetNumberOfPoints(); ++i)
+    {
+    if (ptr[i] != expectedPtr[i])
+      {
+      std::cerr << description << ": voxel mismatch at index " << i << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool TestMemoryMapping(const std::string& fileName, vtkImageData* image)
+{
+  vtkNew<vtkTeemNRRDWriter> writer;
+  writer->SetFileName(fileName.c_str());
+  writer->SetInputData(image);
+  writer->SetUseCompression(false);
+  writer->Write();
+  if (writer->GetWriteError())
+    {
+    std::cerr << "Failed to write " << fileName << std::endl;
+    return false;
+    }
+
+  vtkSmartPointer<vtkImageData> mappedImage = ReadImage(fileName, true);
+  if (!CompareImages(mappedImage, image, fileName + " memory-mapped"))
+    {
+    return false;
+    }
+
+  // Modifying the memory-mapped image must not change the file
+  static_cast<float*>(mappedImage->GetScalarPointer())[0] = -1.0f;
+  mappedImage = nullptr;
+  vtkSmartPointer<vtkImageData> readImage = ReadImage(fileName, false);
+  if (!CompareImages(readImage, image, fileName + " after modifying memory-mapped image"))
+    {
+    return false;
+    }
+  return true;
+}
+
+}
+
+//----------------------------------------------------------------------------
+int vtkTeemNRRDReaderMemoryMappingTest1(int argc, char* argv[])
+{
+  if (argc != 2)
+    {
+    std::cerr << "Usage: " << argv[0] << " /path/to/temp" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::string tempDir = argv[1];
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(64, 48, 32);
+  image->AllocateScalars(VTK_FLOAT, 1);
+  float* imagePtr = static_cast<float*>(image->GetScalarPointer());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+    {
+    imagePtr[i] = static_cast<float>(i) * 0.5f;
+    }
+
+  if (!TestMemoryMapping(tempDir + "/vtkTeemNRRDReaderMemoryMappingTest1.nrrd", image))
+    {
+    return EXIT_FAILURE;
+    }
+  if (!TestMemoryMapping(tempDir + "/vtkTeemNRRDReaderMemoryMappingTest1.nhdr", image))
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "NRRD reader memory mapping test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
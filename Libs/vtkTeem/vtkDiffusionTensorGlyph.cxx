@@ -53,6 +53,8 @@ vtkDiffusionTensorGlyph::vtkDiffusionTensorGlyph()
   // Default to highest rendering resolution
   this->Resolution = 1;
 
+  this->OutputGlyphInstances = 0;
+
   this->DimensionResolution[0] = 20;
   this->DimensionResolution[1] = 20;
 
@@ -168,6 +170,8 @@ int vtkDiffusionTensorGlyph::RequestData(
   vtkPoints *newPts;
   vtkFloatArray *newScalars=nullptr;
   vtkFloatArray *newNormals=nullptr;
+  vtkFloatArray *newOrientations=nullptr;
+  vtkFloatArray *newScales=nullptr;
   double x[3], x2[3], s;
   vtkTransform *trans;
   vtkCell *cell;
@@ -263,36 +267,54 @@ int vtkDiffusionTensorGlyph::RequestData(
   sourcePts = source->GetPoints();
   numSourcePts = sourcePts->GetNumberOfPoints();
   numSourceCells = source->GetNumberOfCells();
+  // In glyph instances mode a single point represents each glyph
+  vtkIdType numOutputPtsPerGlyph = (this->OutputGlyphInstances ? 1 : numSourcePts);
 
   newPts = vtkPoints::New();
   // Allocate as if we will glyph every point
   // If some are masked/skipped for Resolution this will be fixed later with Squeeze
   // TO DO allocate less for lower resolution
-  newPts->Allocate(numDirs*numInputPts*numSourcePts);
+  newPts->Allocate(numDirs*numInputPts*numOutputPtsPerGlyph);
+
+  if (this->OutputGlyphInstances)
+    {
+    newOrientations = vtkFloatArray::New();
+    newOrientations->SetName("GlyphOrientation");
+    newOrientations->SetNumberOfComponents(4);
+    newOrientations->Allocate(numDirs*4*numInputPts);
+    newScales = vtkFloatArray::New();
+    newScales->SetName("GlyphScale");
+    newScales->SetNumberOfComponents(3);
+    newScales->Allocate(numDirs*3*numInputPts);
+    }
 
   // Setting up for calls to PolyData::InsertNextCell()
-  if ( (sourceCells=source->GetVerts())->GetNumberOfCells() > 0 )
+  if (this->OutputGlyphInstances)
+    {
+    // no topology is generated
+    }
+  else if ( (sourceCells=source->GetVerts())->GetNumberOfCells() > 0 )
     {
     cells = vtkCellArray::New();
     cells->Allocate(numDirs*numInputPts*sourceCells->GetSize());
     output->SetVerts(cells);
     cells->Delete();
     }
-  if ( (sourceCells=this->GetSource()->GetLines())->GetNumberOfCells() > 0 )
+  if ( !this->OutputGlyphInstances && (sourceCells=this->GetSource()->GetLines())->GetNumberOfCells() > 0 )
     {
     cells = vtkCellArray::New();
     cells->Allocate(numDirs*numInputPts*sourceCells->GetSize());
     output->SetLines(cells);
     cells->Delete();
     }
-  if ( (sourceCells=this->GetSource()->GetPolys())->GetNumberOfCells() > 0 )
+  if ( !this->OutputGlyphInstances && (sourceCells=this->GetSource()->GetPolys())->GetNumberOfCells() > 0 )
     {
     cells = vtkCellArray::New();
     cells->Allocate(numDirs*numInputPts*sourceCells->GetSize());
     output->SetPolys(cells);
     cells->Delete();
     }
-  if ( (sourceCells=this->GetSource()->GetStrips())->GetNumberOfCells() > 0 )
+  if ( !this->OutputGlyphInstances && (sourceCells=this->GetSource()->GetStrips())->GetNumberOfCells() > 0 )
     {
     cells = vtkCellArray::New();
     cells->Allocate(numDirs*numInputPts*sourceCells->GetSize());
@@ -309,9 +331,9 @@ int vtkDiffusionTensorGlyph::RequestData(
        (inScalars && (this->ColorMode == COLOR_BY_SCALARS)) ) )
     {
     newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numDirs*numInputPts*numSourcePts);
+    newScalars->Allocate(numDirs*numInputPts*numOutputPtsPerGlyph);
     }
-  else
+  else if (!this->OutputGlyphInstances)
     {
     // only copy scalar data through
     // (superclass does this but why? if user has not asked for ColorGlyphs)
@@ -319,7 +341,7 @@ int vtkDiffusionTensorGlyph::RequestData(
     outPD->CopyScalarsOn();
     outPD->CopyAllocate(pd,numDirs*numInputPts*numSourcePts);
     }
-  if ( (sourceNormals = pd->GetNormals()) )
+  if ( !this->OutputGlyphInstances && (sourceNormals = pd->GetNormals()) )
     {
     newNormals = vtkFloatArray::New();
     newNormals->SetNumberOfComponents(3);
@@ -402,7 +424,7 @@ int vtkDiffusionTensorGlyph::RequestData(
     if (( ( inMask != nullptr ) && inMask->GetTuple1( inPtId ) ) || ( !this->MaskGlyphs && trace > 0 ))
       {
       // copy topology of output glyph for this point
-      for (cellId=0; cellId < numSourceCells; cellId++)
+      for (cellId=0; cellId < numSourceCells && !this->OutputGlyphInstances; cellId++)
         {
         cell = this->GetSource()->GetCell(cellId);
         cellPts = cell->GetPointIds();
@@ -609,12 +631,12 @@ int vtkDiffusionTensorGlyph::RequestData(
         // Actually output the scalar invariant calculated above
         if ( newScalars != nullptr )
           {
-          for (i=0; i < numSourcePts; i++)
+          for (i=0; i < numOutputPtsPerGlyph; i++)
             {
             newScalars->InsertTuple(ptOffset+i, &s);
             }
           }
-        else
+        else if (!this->OutputGlyphInstances)
           {
           for (i=0; i < numSourcePts; i++)
             {
@@ -691,6 +713,40 @@ int vtkDiffusionTensorGlyph::RequestData(
           trans->Translate(-this->Length, 0., 0.);
           }
 
+        if (this->OutputGlyphInstances)
+          {
+          // Store glyph transform as position, rotation, and scaling.
+          // Columns of the transform matrix are orthogonal, their length is the scaling.
+          vtkMatrix4x4* glyphMatrix = trans->GetMatrix();
+          newPts->InsertNextPoint(glyphMatrix->GetElement(0, 3), glyphMatrix->GetElement(1, 3), glyphMatrix->GetElement(2, 3));
+          double rotation[3][3];
+          double scale[3];
+          for (int column = 0; column < 3; column++)
+            {
+            double axis[3] = { glyphMatrix->GetElement(0, column), glyphMatrix->GetElement(1, column), glyphMatrix->GetElement(2, column) };
+            scale[column] = vtkMath::Normalize(axis);
+            for (int row = 0; row < 3; row++)
+              {
+              rotation[row][column] = axis[row];
+              }
+            }
+          if (vtkMath::Determinant3x3(rotation) < 0)
+            {
+            // mirroring is represented by negative scaling, as orientation must be a rotation
+            for (int row = 0; row < 3; row++)
+              {
+              rotation[row][0] = -rotation[row][0];
+              }
+            scale[0] = -scale[0];
+            }
+          double orientation[4] = { 1.0, 0.0, 0.0, 0.0 };
+          vtkMath::Matrix3x3ToQuaternion(rotation, orientation);
+          newOrientations->InsertNextTuple(orientation);
+          newScales->InsertNextTuple(scale);
+          ptOffset += numOutputPtsPerGlyph;
+          continue;
+          }
+
         // multiply points (and normals if available) by resulting
         // matrix.
         // This also appends them to the output "new" data.
@@ -741,6 +797,18 @@ int vtkDiffusionTensorGlyph::RequestData(
     newNormals->Delete();
     }
 
+  if ( newOrientations )
+    {
+    outPD->AddArray(newOrientations);
+    newOrientations->Delete();
+    }
+
+  if ( newScales )
+    {
+    outPD->AddArray(newScales);
+    newScales->Delete();
+    }
+
   output->Squeeze();
   trans->Delete();
   matrix->Delete();
@@ -762,6 +830,7 @@ void vtkDiffusionTensorGlyph::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Color Glyphs by Scalar Invariant: " << this->ScalarInvariant << "\n";
   os << indent << "Mask Glyphs: " << (this->MaskGlyphs ? "On\n" : "Off\n");
   os << indent << "Resolution: " << this->Resolution << endl;
+  os << indent << "Output Glyph Instances: " << (this->OutputGlyphInstances ? "On\n" : "Off\n");
 
   // print objects
   if ( this->VolumePositionMatrix )
@@ -111,6 +111,25 @@ public:
   /// Output R,G,B scalars according to orientation of max eigenvalue
   void ColorGlyphsByOrientation();
 
+  ///
+  /// Output one component scalars according to the specified scalar invariant
+  /// (one of the operations defined in vtkDiffusionTensorMathematics).
+  void ColorGlyphsBy(int measure);
+  vtkGetMacro(ScalarInvariant, int);
+
+  ///
+  /// If enabled then glyph geometry is not generated, but only one point is output
+  /// for each glyph, with point data arrays that describe how the glyph source
+  /// has to be transformed: GlyphOrientation (quaternion, as w, x, y, z)
+  /// and GlyphScale (scaling along the three glyph axes). Scalars are output
+  /// the same way as for generated geometry.
+  /// The output can be rendered efficiently using vtkGlyph3DMapper, which uses
+  /// GPU instancing to draw the same glyph source at each point.
+  /// Disabled by default.
+  vtkSetMacro(OutputGlyphInstances, int);
+  vtkBooleanMacro(OutputGlyphInstances, int);
+  vtkGetMacro(OutputGlyphInstances, int);
+
   /// Description
   /// Transform output glyph locations (not orientations!)
   /// by this matrix.
@@ -173,11 +192,10 @@ protected:
 
   int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *) override;
 
-  void ColorGlyphsBy(int measure);
-
   int ScalarInvariant;  /// which function of eigenvalues to use for coloring
   int MaskGlyphs;  /// mask glyphs outside of the brain for example, using the Mask
   int Resolution; /// allows skipping some tensors for lower resolution glyphing
+  int OutputGlyphInstances; /// output glyph transforms instead of glyph geometry
 
   int DimensionResolution[2];
 
@@ -60,11 +60,17 @@ vtkDiffusionTensorMathematics::vtkDiffusionTensorMathematics()
 
   this->ScaleFactor = 1.0;
   this->ExtractEigenvalues = 1;
+  this->CacheEigensystems = 0;
+  this->EigensystemCacheTensors = nullptr;
+  this->EigensystemCacheTensorsMTime = 0;
   this->TensorRotationMatrix = nullptr;
   this->ScalarMask = nullptr;
   this->MaskWithScalars = 0;
   this->FixNegativeEigenvalues = 1;
   this->MaskLabelValue = 1;
+  // Split the image into many small pieces that are processed in parallel
+  // using vtkSMPTools, which balances load better than a fixed number of threads
+  this->EnableSMP = true;
 }
 
 //----------------------------------------------------------------------------
@@ -142,6 +148,24 @@ int vtkDiffusionTensorMathematics
 ::RequestData(vtkInformation* request, vtkInformationVector** inputVector,
               vtkInformationVector* outputVector)
 {
+  // Eigensystems are stored in the cache by the threads, it has to be allocated before executing them
+  vtkImageData* inData = vtkImageData::GetData(inputVector[0]);
+  vtkDataArray* inTensors = (inData ? inData->GetPointData()->GetTensors() : nullptr);
+  if (!this->CacheEigensystems || !this->ExtractEigenvalues || !inTensors)
+    {
+    std::vector<double>().swap(this->EigensystemCache);
+    this->EigensystemCacheTensors = nullptr;
+    }
+  else if (inTensors != this->EigensystemCacheTensors
+    || inTensors->GetMTime() != this->EigensystemCacheTensorsMTime
+    || this->EigensystemCache.size() != static_cast<size_t>(inTensors->GetNumberOfTuples()) * 12)
+    {
+    this->EigensystemCache.assign(static_cast<size_t>(inTensors->GetNumberOfTuples()) * 12,
+      std::numeric_limits<double>::quiet_NaN());
+    this->EigensystemCacheTensors = inTensors;
+    this->EigensystemCacheTensorsMTime = inTensors->GetMTime();
+    }
+
   int res = this->Superclass::RequestData(request, inputVector, outputVector);
   for (int i = 0; i < this->GetNumberOfOutputPorts(); ++i)
     {
@@ -451,6 +475,18 @@ static void vtkDiffusionTensorMathematicsExecute1Eigen(vtkDiffusionTensorMathema
   // decide whether to extract eigenfunctions or just use input cols
   extractEigenvalues = self->GetExtractEigenvalues();
 
+  // eigensystems computed by previous executions (12 values for each voxel)
+  double* cachePtr = self->GetEigensystemCache();
+  vtkIdType cacheIncY = 0;
+  vtkIdType cacheIncZ = 0;
+  if (cachePtr)
+    {
+    int startIjk[3] = { outExt[0], outExt[2], outExt[4] };
+    cachePtr += in1Data->ComputePointId(startIjk) * 12;
+    cacheIncY = inIncY / 9 * 12;
+    cacheIncZ = inIncZ / 9 * 12;
+    }
+
   // transformation of tensor orientations for coloring
   vtkTransform *trans = vtkTransform::New();
   int useTransform = 0;
@@ -523,7 +559,18 @@ static void vtkDiffusionTensorMathematicsExecute1Eigen(vtkDiffusionTensorMathema
           tensor[2][2] = static_cast<double>(inPtr[8]);
 
           // get eigenvalues and eigenvectors appropriately
-          if (extractEigenvalues)
+          if (cachePtr && !vtkMath::IsNan(cachePtr[0]))
+            {
+            for (i=0; i<3; i++)
+              {
+              w[i] = cachePtr[i];
+              for (j=0; j<3; j++)
+                {
+                v[i][j] = cachePtr[3 + i*3 + j];
+                }
+              }
+            }
+          else if (extractEigenvalues)
             {
             for (j=0; j<3; j++)
               {
@@ -536,6 +583,17 @@ static void vtkDiffusionTensorMathematicsExecute1Eigen(vtkDiffusionTensorMathema
             // compute eigensystem
             //vtkMath::Jacobi(m, w, v);
             vtkDiffusionTensorMathematics::TeemEigenSolver(m,w,v);
+            if (cachePtr)
+              {
+              for (i=0; i<3; i++)
+                {
+                cachePtr[i] = w[i];
+                for (j=0; j<3; j++)
+                  {
+                  cachePtr[3 + i*3 + j] = v[i][j];
+                  }
+                }
+              }
             }
           else
             {
@@ -782,14 +840,26 @@ static void vtkDiffusionTensorMathematicsExecute1Eigen(vtkDiffusionTensorMathema
         outPtr++;
         inPtr+=9;
         inMaskPtr++;
+        if (cachePtr)
+          {
+          cachePtr += 12;
+          }
         }
       outPtr += outIncY;
       inPtr += inIncY;
       inMaskPtr += maskIncY;
+      if (cachePtr)
+        {
+        cachePtr += cacheIncY;
+        }
       }
     outPtr += outIncZ;
     inPtr += inIncZ;
     inMaskPtr += maskIncZ;
+    if (cachePtr)
+      {
+      cachePtr += cacheIncZ;
+      }
     }
   // Cleanup
   trans->Delete();
@@ -1152,6 +1222,13 @@ void vtkDiffusionTensorMathematics::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os,indent);
 
   os << indent << "Operation: " << this->Operation << "\n";
+  os << indent << "CacheEigensystems: " << this->CacheEigensystems << "\n";
+}
+
+//----------------------------------------------------------------------------
+double* vtkDiffusionTensorMathematics::GetEigensystemCache()
+{
+  return (this->EigensystemCache.empty() ? nullptr : this->EigensystemCache.data());
 }
 
 // Colormap: convert our mode value (-1..1) to RGB
@@ -32,6 +32,10 @@
 // VTK includes
 #include <vtkThreadedImageAlgorithm.h>
 
+// STD includes
+#include <vector>
+
+class vtkDataArray;
 class vtkMatrix4x4;
 class vtkImageData;
 class VTK_Teem_EXPORT vtkDiffusionTensorMathematics : public vtkThreadedImageAlgorithm
@@ -186,6 +190,16 @@ public:
   vtkBooleanMacro(ExtractEigenvalues,int);
   vtkGetMacro(ExtractEigenvalues,int);
 
+  ///
+  /// Keep eigenvalues and eigenvectors computed for each voxel, so that
+  /// switching to another eigensystem-based operation does not require
+  /// solving the eigensystems again. The cache is discarded when the input
+  /// tensors are modified. It requires 12 doubles per voxel, therefore it is
+  /// disabled by default.
+  vtkSetMacro(CacheEigensystems,int);
+  vtkBooleanMacro(CacheEigensystems,int);
+  vtkGetMacro(CacheEigensystems,int);
+
   /// Description
   /// This matrix is only used for ColorByOrientation.
   /// We transform the tensor orientation by this matrix
@@ -230,6 +244,9 @@ public:
   vtkGetMacro(MaskLabelValue, int);
 
   /// Public for access from threads
+  /// Eigenvalues (3) and eigenvectors (9) of each input voxel, nullptr if not cached.
+  /// Eigenvalue is NaN for voxels that have not been computed yet.
+  double* GetEigensystemCache();
   static void ModeToRGB(double Mode, double FA,
                  double &R, double &G, double &B);
 
@@ -277,6 +294,11 @@ protected:
   int Operation; /// math operation to perform
   double ScaleFactor; /// Scale factor for output scalars
   int ExtractEigenvalues; /// Boolean controls eigenfunction extraction
+  int CacheEigensystems;
+  std::vector<double> EigensystemCache;
+  /// Tensor array that the cache was computed for (only used for comparison)
+  vtkDataArray* EigensystemCacheTensors;
+  vtkMTimeType EigensystemCacheTensorsMTime;
 
   int MaskWithScalars;
   vtkImageData *ScalarMask;
@@ -19,6 +19,9 @@
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+// STD includes
+#include <vector>
+
 
 vtkStandardNewMacro(vtkImageLabelCombine);
 
@@ -27,6 +30,9 @@ vtkImageLabelCombine::vtkImageLabelCombine()
 {
   this->SetNumberOfInputPorts(2);
   this->OverwriteInput = 0;
+  // Split the image into many small pieces that are processed in parallel
+  // using vtkSMPTools, which balances load better than a fixed number of threads
+  this->EnableSMP = true;
 }
 
 //----------------------------------------------------------------------------
@@ -39,29 +45,32 @@ int vtkImageLabelCombine::RequestInformation (
   // get the info objects
   vtkInformation *outInfo = outputVector->GetInformationObject(0);
   vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
-  vtkInformation *inInfo2 = inputVector[1]->GetInformationObject(0);
 
   int ext[6], ext2[6], idx;
 
   inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), ext);
 
-  // two input take intersection
-  if (!inInfo2)
+  // two or more inputs take intersection
+  if (inputVector[1]->GetNumberOfInformationObjects() < 1)
     {
     vtkErrorMacro(<< "Second input must be specified for this operation.");
     return 1;
     }
 
-  inInfo2->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), ext2);
-  for (idx = 0; idx < 3; ++idx)
+  for (int inputIndex = 0; inputIndex < inputVector[1]->GetNumberOfInformationObjects(); ++inputIndex)
     {
-    if (ext2[idx*2] > ext[idx*2])
-      {
-      ext[idx*2] = ext2[idx*2];
-      }
-    if (ext2[idx*2+1] < ext[idx*2+1])
+    vtkInformation *inInfo2 = inputVector[1]->GetInformationObject(inputIndex);
+    inInfo2->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), ext2);
+    for (idx = 0; idx < 3; ++idx)
       {
-      ext[idx*2+1] = ext2[idx*2+1];
+      if (ext2[idx*2] > ext[idx*2])
+        {
+        ext[idx*2] = ext2[idx*2];
+        }
+      if (ext2[idx*2+1] < ext[idx*2+1])
+        {
+        ext[idx*2+1] = ext2[idx*2+1];
+        }
       }
     }
 
@@ -70,44 +79,64 @@ int vtkImageLabelCombine::RequestInformation (
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Combine a row of two inputs. The priority input label is used if it is positive,
+// the other input label is used if the priority input is background.
+// The loop body has no branches, so that compilers can vectorize it. The output
+// may be the same as the first input, which is used for combining more than two inputs.
+template <class T>
+void vtkImageLabelCombineRow(const T *in1Ptr, const T *in2Ptr, T *outPtr, int rowLength, bool secondHasPriority)
+{
+  const T *priorityPtr = secondHasPriority ? in2Ptr : in1Ptr;
+  const T *otherPtr = secondHasPriority ? in1Ptr : in2Ptr;
+  for (int idxR = 0; idxR < rowLength; idxR++)
+    {
+    const T priorityValue = priorityPtr[idxR];
+    const T otherValue = otherPtr[idxR];
+    const T fallbackValue = ((priorityValue == 0) & (otherValue > 0)) ? otherValue : static_cast<T>(0);
+    outPtr[idxR] = (priorityValue > 0) ? priorityValue : fallbackValue;
+    }
+}
 
 //----------------------------------------------------------------------------
 // This templated function executes the filter for any type of data.
-// Handles the two input operations
+// All inputs are combined in a single pass over the output extent.
 template <class T>
-void vtkImageLabelCombineExecute2(vtkImageLabelCombine *self,
-                                 vtkImageData *in1Data, T *in1Ptr,
-                                 vtkImageData *in2Data, T *in2Ptr,
+void vtkImageLabelCombineExecute(vtkImageLabelCombine *self,
+                                 const std::vector<vtkImageData*>& inputs,
                                  vtkImageData *outData, T *outPtr,
                                  int outExt[6], int id)
 {
-  int idxR, idxY, idxZ;
+  int idxY, idxZ;
   int maxY, maxZ;
-  vtkIdType inIncX, inIncY, inIncZ;
-  vtkIdType in2IncX, in2IncY, in2IncZ;
+  vtkIdType inIncX;
   vtkIdType outIncX, outIncY, outIncZ;
   int rowLength;
   unsigned long count = 0;
   unsigned long target;
-  int op = self->GetOverwriteInput();
+  bool overwrite = (self->GetOverwriteInput() != 0);
 
   // find the region to loop over
-  rowLength = (outExt[1] - outExt[0]+1)*in1Data->GetNumberOfScalarComponents();
+  rowLength = (outExt[1] - outExt[0]+1)*inputs[0]->GetNumberOfScalarComponents();
 
   maxY = outExt[3] - outExt[2];
   maxZ = outExt[5] - outExt[4];
   target = (unsigned long)((maxZ+1)*(maxY+1)/50.0);
   target++;
 
-  T v1;
-  T v2;
-
-  // Get increments to march through data
-  in1Data->GetContinuousIncrements(outExt, inIncX, inIncY, inIncZ);
-  in2Data->GetContinuousIncrements(outExt, in2IncX, in2IncY, in2IncZ);
+  // Get pointers and increments to march through data
+  const size_t numberOfInputs = inputs.size();
+  std::vector<T*> inPtrs(numberOfInputs);
+  std::vector<vtkIdType> inIncY(numberOfInputs);
+  std::vector<vtkIdType> inIncZ(numberOfInputs);
+  for (size_t inputIndex = 0; inputIndex < numberOfInputs; ++inputIndex)
+    {
+    inPtrs[inputIndex] = static_cast<T*>(inputs[inputIndex]->GetScalarPointerForExtent(outExt));
+    inputs[inputIndex]->GetContinuousIncrements(outExt, inIncX, inIncY[inputIndex], inIncZ[inputIndex]);
+    }
   outData->GetContinuousIncrements(outExt, outIncX, outIncY, outIncZ);
 
-  // Loop through output pixels
+  // Loop through output rows
   for (idxZ = 0; idxZ <= maxZ; idxZ++)
     {
     for (idxY = 0; !self->AbortExecute && idxY <= maxY; idxY++)
@@ -120,52 +149,23 @@ void vtkImageLabelCombineExecute2(vtkImageLabelCombine *self,
           }
         count++;
         }
-      for (idxR = 0; idxR < rowLength; idxR++)
+      // Combine the first two inputs, then the result with each further input
+      vtkImageLabelCombineRow(inPtrs[0], inPtrs[1], outPtr, rowLength, overwrite);
+      for (size_t inputIndex = 2; inputIndex < numberOfInputs; ++inputIndex)
         {
-        // Pixel operation
-        v1 = *in1Ptr;
-        v2 = *in2Ptr;
-        if (op == 0)
-          {
-          if (v1 > 0)
-            {
-            *outPtr = v1;
-            }
-          else if (v2 > 0 && v1 == 0)
-            {
-            *outPtr = v2;
-            }
-          else
-            {
-            *outPtr = 0;
-            }
-          }
-        else
-          {
-          if (v2 > 0)
-            {
-            *outPtr = v2;
-            }
-          else if (v1 > 0 && v2 == 0)
-            {
-            *outPtr = v1;
-            }
-          else
-            {
-            *outPtr = 0;
-            }
-          }
-        outPtr++;
-        in1Ptr++;
-        in2Ptr++;
+        vtkImageLabelCombineRow(outPtr, inPtrs[inputIndex], outPtr, rowLength, overwrite);
+        }
+      outPtr += rowLength + outIncY;
+      for (size_t inputIndex = 0; inputIndex < numberOfInputs; ++inputIndex)
+        {
+        inPtrs[inputIndex] += rowLength + inIncY[inputIndex];
         }
-      outPtr += outIncY;
-      in1Ptr += inIncY;
-      in2Ptr += in2IncY;
       }
     outPtr += outIncZ;
-    in1Ptr += inIncZ;
-    in2Ptr += in2IncZ;
+    for (size_t inputIndex = 0; inputIndex < numberOfInputs; ++inputIndex)
+      {
+      inPtrs[inputIndex] += inIncZ[inputIndex];
+      }
     }
 }
 
@@ -177,64 +177,55 @@ void vtkImageLabelCombineExecute2(vtkImageLabelCombine *self,
 // the data data types.
 void vtkImageLabelCombine::ThreadedRequestData(
   vtkInformation * vtkNotUsed( request ),
-  vtkInformationVector ** vtkNotUsed( inputVector ),
+  vtkInformationVector ** inputVector,
   vtkInformationVector * vtkNotUsed( outputVector ),
   vtkImageData ***inData,
   vtkImageData **outData,
   int outExt[6], int id)
 {
-  void *inPtr1;
-  void *outPtr;
+  void *outPtr = outData[0]->GetScalarPointerForExtent(outExt);
 
-  inPtr1 = inData[0][0]->GetScalarPointerForExtent(outExt);
-  outPtr = outData[0]->GetScalarPointerForExtent(outExt);
-
-  void *inPtr2;
-
-  if (!inData[1] || ! inData[1][0])
+  const int numberOfSecondaryInputs = inputVector[1]->GetNumberOfInformationObjects();
+  if (numberOfSecondaryInputs < 1 || !inData[1] || !inData[1][0])
     {
-    vtkErrorMacro("ImageMathematics requested to perform a two input operation with only one input\n");
+    vtkErrorMacro("ImageLabelCombine requested to perform a two input operation with only one input\n");
     return;
     }
 
-  inPtr2 = inData[1][0]->GetScalarPointerForExtent(outExt);
-
-  // this filter expects that input is the same type as output.
-  if (inData[0][0]->GetScalarType() != outData[0]->GetScalarType())
+  std::vector<vtkImageData*> inputs;
+  inputs.push_back(inData[0][0]);
+  for (int inputIndex = 0; inputIndex < numberOfSecondaryInputs; ++inputIndex)
     {
-      vtkErrorMacro(<< "Execute: input1 ScalarType, "
-                    <<  inData[0][0]->GetScalarType()
-                    << ", must match output ScalarType "
-                    << outData[0]->GetScalarType());
-      return;
+    inputs.push_back(inData[1][inputIndex]);
     }
-  /**
-  if (inData[1][0]->GetScalarType() != outData[0]->GetScalarType())
+
+  for (size_t inputIndex = 0; inputIndex < inputs.size(); ++inputIndex)
     {
-      vtkErrorMacro(<< "Execute: input2 ScalarType, "
-                    << inData[1][0]->GetScalarType()
+    // this filter expects that inputs are the same type as output.
+    if (!inputs[inputIndex] || inputs[inputIndex]->GetScalarType() != outData[0]->GetScalarType())
+      {
+      vtkErrorMacro(<< "Execute: input" << inputIndex + 1 << " ScalarType, "
+                    << (inputs[inputIndex] ? inputs[inputIndex]->GetScalarType() : -1)
                     << ", must match output ScalarType "
                     << outData[0]->GetScalarType());
       return;
-    }
-  **/
-  // this filter expects that inputs that have the same number of components
-  if (inData[0][0]->GetNumberOfScalarComponents() !=
-      inData[1][0]->GetNumberOfScalarComponents())
-    {
+      }
+    // this filter expects that inputs that have the same number of components
+    if (inputs[inputIndex]->GetNumberOfScalarComponents() != inputs[0]->GetNumberOfScalarComponents())
+      {
       vtkErrorMacro(<< "Execute: input1 NumberOfScalarComponents, "
-                    << inData[0][0]->GetNumberOfScalarComponents()
-                    << ", must match out input2 NumberOfScalarComponents "
-                    << inData[1][0]->GetNumberOfScalarComponents());
+                    << inputs[0]->GetNumberOfScalarComponents()
+                    << ", must match input" << inputIndex + 1 << " NumberOfScalarComponents "
+                    << inputs[inputIndex]->GetNumberOfScalarComponents());
       return;
+      }
     }
 
-  switch (inData[0][0]->GetScalarType())
+  switch (outData[0]->GetScalarType())
     {
     vtkTemplateMacro(
-                     vtkImageLabelCombineExecute2(this,inData[0][0], (VTK_TT *)(inPtr1),
-                                                  inData[1][0], (VTK_TT *)(inPtr2),
-                                                  outData[0], (VTK_TT *)(outPtr), outExt, id));
+                     vtkImageLabelCombineExecute(this, inputs,
+                                                 outData[0], static_cast<VTK_TT*>(outPtr), outExt, id));
     default:
       vtkErrorMacro(<< "Execute: Unknown ScalarType");
       return;
@@ -22,11 +22,15 @@
 
 #include "vtkThreadedImageAlgorithm.h"
 
-/// \brief Add, subtract, multiply, divide, invert, sin, cos, exp, log.
+/// \brief Combine label maps.
 ///
-/// vtkImageLabelCombine implements basic mathematical operations. SetOperation is
-/// used to select the filters behavior.  The filter can take two or one
-/// input.
+/// vtkImageLabelCombine combines two or more label maps of the same scalar type.
+/// A voxel of the output gets the label of the input that has priority if that label
+/// is positive (foreground), otherwise the label of the other input if the priority input
+/// is background (0) there. When more than two inputs are set then they are combined in a
+/// single pass, the result is the same as combining the inputs pairwise in order.
+/// By default the first input has priority, if OverwriteInput is enabled then later
+/// inputs overwrite earlier ones.
 class VTK_Teem_EXPORT vtkImageLabelCombine : public vtkThreadedImageAlgorithm
 {
 public:
@@ -35,7 +39,7 @@ public:
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
   ///
-  /// Set/Get the Operation to perform.
+  /// Set/Get if the labels of later inputs overwrite labels of earlier inputs.
   vtkSetMacro(OverwriteInput,int);
   vtkGetMacro(OverwriteInput,int);
 
@@ -50,6 +54,21 @@ public:
       this->SetInputData(1,in);
   }
 
+  ///
+  /// Add an input after the ones already set. The first input is set to the
+  /// first port, all other inputs are added to the second port.
+  virtual void AddInputLabelMap(vtkDataObject *in)
+  {
+      if (this->GetNumberOfInputConnections(0) == 0)
+        {
+        this->SetInputData(0,in);
+        }
+      else
+        {
+        this->AddInputData(1,in);
+        }
+  }
+
 protected:
   vtkImageLabelCombine();
   ~vtkImageLabelCombine() override  = default;
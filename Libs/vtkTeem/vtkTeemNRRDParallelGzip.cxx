@@ -0,0 +1,277 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH) All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+=========================================================================auto=*/
+
+#include "vtkTeemNRRDParallelGzip.h"
+
+// VTK includes
+#include <vtkSMPTools.h>
+#include <vtksys/SystemTools.hxx>
+
+// ITK includes
+#include <itk_zlib.h>
+
+// STD includes
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+  /// Size of the gzip member header: fixed header (10 bytes), extra field length (2 bytes),
+  /// "SL" subfield ID (2 bytes), subfield length (2 bytes), and compressed member size (4 bytes).
+  const size_t MEMBER_HEADER_SIZE = vtkTeemNRRDParallelGzip::MemberHeaderSize;
+  /// Size of the gzip member trailer: CRC32 and uncompressed size (4 bytes each)
+  const size_t MEMBER_TRAILER_SIZE = 8;
+  /// Number of chunks compressed by each thread before the result is written to file.
+  /// Limits the amount of memory used for buffering compressed data.
+  const size_t CHUNKS_PER_THREAD_IN_BATCH = 4;
+
+  //----------------------------------------------------------------------------
+  void WriteUInt16(unsigned char* buffer, unsigned int value)
+  {
+    buffer[0] = static_cast<unsigned char>(value & 0xFF);
+    buffer[1] = static_cast<unsigned char>((value >> 8) & 0xFF);
+  }
+
+  //----------------------------------------------------------------------------
+  void WriteUInt32(unsigned char* buffer, unsigned long value)
+  {
+    WriteUInt16(buffer, value & 0xFFFF);
+    WriteUInt16(buffer + 2, (value >> 16) & 0xFFFF);
+  }
+
+  //----------------------------------------------------------------------------
+  unsigned int ReadUInt16(const unsigned char* buffer)
+  {
+    return static_cast<unsigned int>(buffer[0]) | (static_cast<unsigned int>(buffer[1]) << 8);
+  }
+
+  //----------------------------------------------------------------------------
+  unsigned long ReadUInt32(const unsigned char* buffer)
+  {
+    return static_cast<unsigned long>(ReadUInt16(buffer)) | (static_cast<unsigned long>(ReadUInt16(buffer + 2)) << 16);
+  }
+
+  //----------------------------------------------------------------------------
+  bool CompressMember(const unsigned char* data, size_t dataSize, int compressionLevel, std::vector<unsigned char>& member)
+  {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    // Negative window bits: raw deflate stream, gzip header and trailer are written here
+    if (deflateInit2(&stream, compressionLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+      {
+      return false;
+      }
+    uLong compressedSizeBound = deflateBound(&stream, static_cast<uLong>(dataSize));
+    member.resize(MEMBER_HEADER_SIZE + compressedSizeBound + MEMBER_TRAILER_SIZE);
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(dataSize);
+    stream.next_out = member.data() + MEMBER_HEADER_SIZE;
+    stream.avail_out = static_cast<uInt>(compressedSizeBound);
+    int result = deflate(&stream, Z_FINISH);
+    size_t compressedSize = stream.total_out;
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END)
+      {
+      return false;
+      }
+    member.resize(MEMBER_HEADER_SIZE + compressedSize + MEMBER_TRAILER_SIZE);
+
+    unsigned char* header = member.data();
+    header[0] = 0x1f; // ID1
+    header[1] = 0x8b; // ID2
+    header[2] = 8; // CM = deflate
+    header[3] = 4; // FLG = FEXTRA
+    WriteUInt32(header + 4, 0); // MTIME
+    header[8] = 0; // XFL
+    header[9] = 255; // OS = unknown
+    WriteUInt16(header + 10, 8); // XLEN
+    header[12] = 'S'; // SI1
+    header[13] = 'L'; // SI2
+    WriteUInt16(header + 14, 4); // LEN
+    WriteUInt32(header + 16, static_cast<unsigned long>(member.size()));
+
+    unsigned char* trailer = member.data() + MEMBER_HEADER_SIZE + compressedSize;
+    WriteUInt32(trailer, crc32(crc32(0L, Z_NULL, 0), data, static_cast<uInt>(dataSize)));
+    WriteUInt32(trailer + 4, static_cast<unsigned long>(dataSize & 0xFFFFFFFF));
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  bool DecompressMember(const unsigned char* member, const vtkTeemNRRDParallelGzip::Member& memberInfo, unsigned char* data)
+  {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+      {
+      return false;
+      }
+    stream.next_in = const_cast<Bytef*>(member + MEMBER_HEADER_SIZE);
+    stream.avail_in = static_cast<uInt>(memberInfo.CompressedSize - MEMBER_HEADER_SIZE - MEMBER_TRAILER_SIZE);
+    stream.next_out = data;
+    stream.avail_out = static_cast<uInt>(memberInfo.UncompressedSize);
+    int result = inflate(&stream, Z_FINISH);
+    size_t uncompressedSize = stream.total_out;
+    inflateEnd(&stream);
+    if (result != Z_STREAM_END || uncompressedSize != memberInfo.UncompressedSize)
+      {
+      return false;
+      }
+    const unsigned char* trailer = member + memberInfo.CompressedSize - MEMBER_TRAILER_SIZE;
+    return ReadUInt32(trailer) == crc32(crc32(0L, Z_NULL, 0), data, static_cast<uInt>(uncompressedSize));
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkTeemNRRDParallelGzip::AppendCompressedData(const std::string& fileName, const void* data, size_t dataSize,
+  int compressionLevel, int numberOfThreads)
+{
+  FILE* file = vtksys::SystemTools::Fopen(fileName, "ab");
+  if (!file)
+    {
+    return false;
+    }
+
+  const unsigned char* dataPtr = static_cast<const unsigned char*>(data);
+  const size_t numberOfChunks = (dataSize + ChunkSize - 1) / ChunkSize;
+  vtkSMPTools::Config config;
+  config.MaxNumberOfThreads = numberOfThreads;
+  const size_t numberOfThreadsUsed = static_cast<size_t>(
+    numberOfThreads > 0 ? numberOfThreads : vtkSMPTools::GetEstimatedNumberOfThreads());
+  const size_t batchSize = std::max<size_t>(1, numberOfThreadsUsed * CHUNKS_PER_THREAD_IN_BATCH);
+  std::vector<std::vector<unsigned char> > members(std::min(batchSize, numberOfChunks));
+
+  bool success = true;
+  for (size_t batchStart = 0; batchStart < numberOfChunks && success; batchStart += batchSize)
+    {
+    const size_t batchEnd = std::min(batchStart + batchSize, numberOfChunks);
+    std::atomic<bool> compressionFailed(false);
+    vtkSMPTools::LocalScope(config, [&]()
+      {
+      vtkSMPTools::For(static_cast<vtkIdType>(batchStart), static_cast<vtkIdType>(batchEnd), 1,
+        [&](vtkIdType chunkBegin, vtkIdType chunkEnd)
+        {
+        for (size_t chunkIndex = static_cast<size_t>(chunkBegin); chunkIndex < static_cast<size_t>(chunkEnd); ++chunkIndex)
+          {
+          const size_t chunkOffset = chunkIndex * ChunkSize;
+          const size_t chunkSize = std::min(ChunkSize, dataSize - chunkOffset);
+          if (!CompressMember(dataPtr + chunkOffset, chunkSize, compressionLevel, members[chunkIndex - batchStart]))
+            {
+            compressionFailed = true;
+            }
+          }
+        });
+      });
+    if (compressionFailed)
+      {
+      success = false;
+      break;
+      }
+    for (size_t chunkIndex = batchStart; chunkIndex < batchEnd; ++chunkIndex)
+      {
+      const std::vector<unsigned char>& member = members[chunkIndex - batchStart];
+      if (fwrite(member.data(), 1, member.size(), file) != member.size())
+        {
+        success = false;
+        break;
+        }
+      }
+    }
+
+  if (fclose(file) != 0)
+    {
+    success = false;
+    }
+  return success;
+}
+
+//----------------------------------------------------------------------------
+bool vtkTeemNRRDParallelGzip::IsMemberHeader(const unsigned char* compressedData, size_t compressedDataSize)
+{
+  if (!compressedData || compressedDataSize < MEMBER_HEADER_SIZE)
+    {
+    return false;
+    }
+  // gzip magic, deflate method, FEXTRA flag, 8-byte extra field containing the 4-byte "SL" subfield
+  return compressedData[0] == 0x1f && compressedData[1] == 0x8b && compressedData[2] == 8 && compressedData[3] == 4
+    && ReadUInt16(compressedData + 10) == 8 && compressedData[12] == 'S' && compressedData[13] == 'L'
+    && ReadUInt16(compressedData + 14) == 4;
+}
+
+//----------------------------------------------------------------------------
+bool vtkTeemNRRDParallelGzip::GetMembers(const unsigned char* compressedData, size_t compressedDataSize,
+  std::vector<Member>& members)
+{
+  members.clear();
+  size_t offset = 0;
+  while (offset < compressedDataSize)
+    {
+    if (compressedDataSize - offset < MEMBER_HEADER_SIZE + MEMBER_TRAILER_SIZE)
+      {
+      return false;
+      }
+    const unsigned char* header = compressedData + offset;
+    if (!vtkTeemNRRDParallelGzip::IsMemberHeader(header, compressedDataSize - offset))
+      {
+      // Not written by AppendCompressedData
+      return false;
+      }
+    Member member;
+    member.Offset = offset;
+    member.CompressedSize = ReadUInt32(header + 16);
+    if (member.CompressedSize < MEMBER_HEADER_SIZE + MEMBER_TRAILER_SIZE
+      || member.CompressedSize > compressedDataSize - offset)
+      {
+      return false;
+      }
+    member.UncompressedSize = ReadUInt32(header + member.CompressedSize - 4);
+    members.push_back(member);
+    offset += member.CompressedSize;
+    }
+  return !members.empty();
+}
+
+//----------------------------------------------------------------------------
+bool vtkTeemNRRDParallelGzip::DecompressMembers(const unsigned char* compressedData, const std::vector<Member>& members,
+  void* data, size_t dataSize, int numberOfThreads)
+{
+  // Compute offset of each member in the uncompressed data
+  std::vector<size_t> dataOffsets(members.size());
+  size_t totalUncompressedSize = 0;
+  for (size_t memberIndex = 0; memberIndex < members.size(); ++memberIndex)
+    {
+    dataOffsets[memberIndex] = totalUncompressedSize;
+    totalUncompressedSize += members[memberIndex].UncompressedSize;
+    }
+  if (totalUncompressedSize != dataSize)
+    {
+    return false;
+    }
+
+  unsigned char* dataPtr = static_cast<unsigned char*>(data);
+  std::atomic<bool> decompressionFailed(false);
+  vtkSMPTools::Config config;
+  config.MaxNumberOfThreads = numberOfThreads;
+  vtkSMPTools::LocalScope(config, [&]()
+    {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(members.size()), 1, [&](vtkIdType memberBegin, vtkIdType memberEnd)
+      {
+      for (vtkIdType memberIndex = memberBegin; memberIndex < memberEnd; ++memberIndex)
+        {
+        const Member& member = members[memberIndex];
+        if (!DecompressMember(compressedData + member.Offset, member, dataPtr + dataOffsets[memberIndex]))
+          {
+          decompressionFailed = true;
+          }
+        }
+      });
+    });
+  return !decompressionFailed;
+}
@@ -0,0 +1,65 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH) All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+=========================================================================auto=*/
+
+#ifndef __vtkTeemNRRDParallelGzip_h
+#define __vtkTeemNRRDParallelGzip_h
+
+// STD includes
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// \brief Utility functions for reading and writing gzip-encoded NRRD data in parallel.
+///
+/// Data is split into fixed-size chunks and each chunk is compressed into a separate
+/// gzip member. Concatenated gzip members form a valid gzip stream, therefore files
+/// can be read by any NRRD reader. The compressed size of each member is stored in the
+/// "SL" subfield of the gzip header extra field, which allows locating all members without
+/// decompressing them, so that they can be decompressed in parallel as well.
+///
+/// This is an internal helper of vtkTeemNRRDWriter and vtkTeemNRRDReader.
+namespace vtkTeemNRRDParallelGzip
+{
+  /// Size of uncompressed data in one gzip member
+  const size_t ChunkSize = 4 * 1024 * 1024;
+
+  /// Location of a gzip member in the compressed data
+  struct Member
+    {
+    size_t Offset{0};
+    size_t CompressedSize{0};
+    size_t UncompressedSize{0};
+    };
+
+  /// Write data to the end of the file as concatenated gzip members.
+  /// \param numberOfThreads Maximum number of threads to use. 0 means all available threads.
+  /// \return Success flag
+  bool AppendCompressedData(const std::string& fileName, const void* data, size_t dataSize,
+    int compressionLevel, int numberOfThreads);
+
+  /// Size of the gzip header of members written by AppendCompressedData
+  const size_t MemberHeaderSize = 20;
+
+  /// Check if compressed data starts with a gzip member written by AppendCompressedData.
+  /// Only the first MemberHeaderSize bytes are examined, which allows deciding how to read
+  /// a file without reading all the compressed data.
+  bool IsMemberHeader(const unsigned char* compressedData, size_t compressedDataSize);
+
+  /// Get position of all gzip members in compressed data.
+  /// \return False if the data was not written by AppendCompressedData.
+  bool GetMembers(const unsigned char* compressedData, size_t compressedDataSize, std::vector<Member>& members);
+
+  /// Decompress gzip members into a preallocated buffer.
+  /// \param numberOfThreads Maximum number of threads to use. 0 means all available threads.
+  /// \return Success flag
+  bool DecompressMembers(const unsigned char* compressedData, const std::vector<Member>& members,
+    void* data, size_t dataSize, int numberOfThreads);
+}
+
+#endif
@@ -27,6 +27,7 @@
 =========================================================================*/
 // vtkTeem includes
 #include "vtkTeemNRRDReader.h"
+#include "vtkTeemNRRDParallelGzip.h"
 
 // VTK includes
 #include "vtkBitArray.h"
@@ -52,6 +53,126 @@
 // Teem includes
 #include "teem/ten.h"
 
+// STD includes
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#ifdef _WIN32
+# include <windows.h>
+# include <vtksys/Encoding.hxx>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+namespace
+{
+  /// Memory-mapped file regions, indexed by the data pointer that is given to the data array
+  struct MappedFileRegion
+    {
+    void* MappingBase{nullptr};
+    size_t MappingLength{0};
+    };
+  std::mutex MappedFileRegionsMutex;
+  std::map<void*, MappedFileRegion> MappedFileRegions;
+
+  //----------------------------------------------------------------------------
+  /// Map a region of a file to memory (copy-on-write).
+  /// \return Pointer to the first byte of the region, nullptr in case of failure.
+  void* MapFileRegion(const std::string& fileName, size_t offset, size_t size)
+  {
+    MappedFileRegion region;
+    size_t alignedOffset = 0;
+#ifdef _WIN32
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    alignedOffset = offset - offset % systemInfo.dwAllocationGranularity;
+    region.MappingLength = size + (offset - alignedOffset);
+    HANDLE file = CreateFileW(vtksys::Encoding::ToWide(fileName).c_str(), GENERIC_READ, FILE_SHARE_READ,
+      nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      {
+      return nullptr;
+      }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+      {
+      return nullptr;
+      }
+    ULARGE_INTEGER mappingOffset;
+    mappingOffset.QuadPart = alignedOffset;
+    region.MappingBase = MapViewOfFile(mapping, FILE_MAP_COPY, mappingOffset.HighPart, mappingOffset.LowPart, region.MappingLength);
+    // The view keeps the mapping object alive
+    CloseHandle(mapping);
+    if (!region.MappingBase)
+      {
+      return nullptr;
+      }
+#else
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    alignedOffset = offset - offset % pageSize;
+    region.MappingLength = size + (offset - alignedOffset);
+    int file = open(fileName.c_str(), O_RDONLY);
+    if (file < 0)
+      {
+      return nullptr;
+      }
+    int mappingFlags = MAP_PRIVATE;
+#ifdef MAP_NORESERVE
+    // Do not reserve swap space for the whole copy-on-write mapping, otherwise mapping
+    // of files larger than the physical memory may be refused
+    mappingFlags |= MAP_NORESERVE;
+#endif
+    void* mappingBase = mmap(nullptr, region.MappingLength, PROT_READ | PROT_WRITE, mappingFlags, file, static_cast<off_t>(alignedOffset));
+    // The mapping remains valid after the file is closed
+    close(file);
+    if (mappingBase == MAP_FAILED)
+      {
+      return nullptr;
+      }
+    region.MappingBase = mappingBase;
+#endif
+    void* data = static_cast<unsigned char*>(region.MappingBase) + (offset - alignedOffset);
+    std::lock_guard<std::mutex> lock(MappedFileRegionsMutex);
+    MappedFileRegions[data] = region;
+    return data;
+  }
+
+  //----------------------------------------------------------------------------
+  /// Array free function for memory-mapped data arrays
+  void UnmapFileRegion(void* data)
+  {
+    MappedFileRegion region;
+    {
+    std::lock_guard<std::mutex> lock(MappedFileRegionsMutex);
+    std::map<void*, MappedFileRegion>::iterator regionIt = MappedFileRegions.find(data);
+    if (regionIt == MappedFileRegions.end())
+      {
+      return;
+      }
+    region = regionIt->second;
+    MappedFileRegions.erase(regionIt);
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(region.MappingBase);
+#else
+    munmap(region.MappingBase, region.MappingLength);
+#endif
+  }
+
+  //----------------------------------------------------------------------------
+  /// Array free function for data arrays that use voxel data allocated by teem
+  void FreeNrrdData(void* data)
+  {
+    airFree(data);
+  }
+}
+
 vtkStandardNewMacro(vtkTeemNRRDReader);
 
 //----------------------------------------------------------------------------
@@ -67,6 +188,8 @@ vtkTeemNRRDReader::vtkTeemNRRDReader()
   this->DataType = -1;
   this->NumberOfComponents = -1;
   this->DataArrayName = "NRRDImage";
+  this->NumberOfThreads = 0;
+  this->UseMemoryMapping = false;
 }
 
 //----------------------------------------------------------------------------
@@ -726,13 +849,21 @@ void vtkTeemNRRDReader::AllocatePointData(vtkImageData *out, vtkInformation* out
   int extent[6] = { 0, -1, 0, -1, 0, -1 };
   out->GetExtent(extent);
 
+  vtkIdType numberOfTuples = vtkIdType(extent[1] - extent[0] + 1)*
+    vtkIdType(extent[3] - extent[2] + 1)*
+    vtkIdType(extent[5] - extent[4] + 1);
+  if (this->UseMemoryMapping)
+    {
+    // Voxel memory is only allocated if the file cannot be memory-mapped,
+    // so that volumes that do not fit into physical memory can be loaded.
+    numberOfTuples = 0;
+    }
+
   if (pd && pd->GetDataType() == this->DataType
-    && pd->GetReferenceCount() == 1)
+    && pd->GetReferenceCount() == 1 && !this->UseMemoryMapping)
     {
     pd->SetNumberOfComponents(this->GetNumberOfComponents());
-    pd->SetNumberOfTuples(vtkIdType(extent[1] - extent[0] + 1)*
-      vtkIdType(extent[3] - extent[2] + 1)*
-      vtkIdType(extent[5] - extent[4] + 1));
+    pd->SetNumberOfTuples(numberOfTuples);
     // Since the execute method will be modifying the scalars
     // directly.
     pd->Modified();
@@ -783,9 +914,7 @@ void vtkTeemNRRDReader::AllocatePointData(vtkImageData *out, vtkInformation* out
   pd->SetNumberOfComponents(this->GetNumberOfComponents());
 
   // allocate enough memory
-  pd->SetNumberOfTuples(vtkIdType(extent[1] - extent[0] + 1)*
-    vtkIdType(extent[3] - extent[2] + 1)*
-    vtkIdType(extent[5] - extent[4] + 1));
+  pd->SetNumberOfTuples(numberOfTuples);
 
   switch (this->PointDataType)
     {
@@ -914,9 +1043,23 @@ void vtkTeemNRRDReader::ExecuteDataWithInformation(vtkDataObject *output, vtkInf
     return;
     }
 
+  if (this->UseMemoryMapping)
+    {
+    if (this->MapDataIntoOutput(imageData))
+      {
+      return;
+      }
+    // The file cannot be memory-mapped, allocate voxel memory and read it normally
+    vtkDataArray* voxelArray = imageData->GetPointData()->GetAttribute(this->PointDataType);
+    if (voxelArray)
+      {
+      voxelArray->SetNumberOfTuples(imageData->GetNumberOfPoints());
+      }
+    }
+
   // Read in the this->nrrd.  Yes, this means that the header is being read
   // twice: once by ExecuteInformation, and once here
-  if ( nrrdLoad(this->nrrd, this->GetFileName(), nullptr) != 0 )
+  if ( !this->ReadParallelCompressedData() && nrrdLoad(this->nrrd, this->GetFileName(), nullptr) != 0 )
     {
     char *err =  biffGetDone(NRRD); // would be nice to free(err)
     vtkErrorMacro("Read: Error reading " << this->GetFileName() << ":\n" << err);
@@ -929,27 +1072,17 @@ void vtkTeemNRRDReader::ExecuteDataWithInformation(vtkDataObject *output, vtkInf
     return;
     }
 
-  void *ptr = nullptr;
+  vtkDataArray* voxelArray = nullptr;
   switch(this->PointDataType)
     {
-    case vtkDataSetAttributes::SCALARS:
-      imageData->GetPointData()->GetScalars()->SetName(this->DataArrayName.c_str());
-      //get pointer
-      ptr = imageData->GetPointData()->GetScalars()->GetVoidPointer(0);
-      break;
-    case vtkDataSetAttributes::VECTORS:
-      imageData->GetPointData()->GetVectors()->SetName(this->DataArrayName.c_str());
-      //get pointer
-      ptr = imageData->GetPointData()->GetVectors()->GetVoidPointer(0);
-      break;
-    case vtkDataSetAttributes::NORMALS:
-      imageData->GetPointData()->GetNormals()->SetName(this->DataArrayName.c_str());
-      ptr = imageData->GetPointData()->GetNormals()->GetVoidPointer(0);
-      break;
-    case vtkDataSetAttributes::TENSORS:
-      imageData->GetPointData()->GetTensors()->SetName(this->DataArrayName.c_str());
-      ptr = imageData->GetPointData()->GetTensors()->GetVoidPointer(0);
-      break;
+    case vtkDataSetAttributes::SCALARS: voxelArray = imageData->GetPointData()->GetScalars(); break;
+    case vtkDataSetAttributes::VECTORS: voxelArray = imageData->GetPointData()->GetVectors(); break;
+    case vtkDataSetAttributes::NORMALS: voxelArray = imageData->GetPointData()->GetNormals(); break;
+    case vtkDataSetAttributes::TENSORS: voxelArray = imageData->GetPointData()->GetTensors(); break;
+    }
+  if (voxelArray)
+    {
+    voxelArray->SetName(this->DataArrayName.c_str());
     }
   this->ComputeDataIncrements();
 
@@ -1090,17 +1223,252 @@ void vtkTeemNRRDReader::ExecuteDataWithInformation(vtkDataObject *output, vtkInf
     // be called here if it existed.
     }
 
-  if (ptr)
+  if (voxelArray)
     {
-    memcpy(ptr, this->nrrd->data, nrrdElementSize(this->nrrd)*nrrdElementNumber(this->nrrd));
+    const size_t dataSize = nrrdElementSize(this->nrrd) * nrrdElementNumber(this->nrrd);
+    if (dataSize == static_cast<size_t>(voxelArray->GetNumberOfValues()) * voxelArray->GetDataTypeSize())
+      {
+      // Use the voxel buffer read by teem directly in the output array instead of copying it
+      voxelArray->SetVoidArray(this->nrrd->data, voxelArray->GetNumberOfValues(), 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+      voxelArray->SetArrayFreeFunction(FreeNrrdData);
+      this->nrrd->data = nullptr;
+      }
+    else
+      {
+      memcpy(voxelArray->GetVoidPointer(0), this->nrrd->data,
+        std::min(dataSize, static_cast<size_t>(voxelArray->GetNumberOfValues()) * voxelArray->GetDataTypeSize()));
+      }
     }
 
   // release the memory while keeping the struct
   nrrdEmpty(this->nrrd);
 }
 
+//----------------------------------------------------------------------------
+bool vtkTeemNRRDReader::ReadParallelCompressedData()
+{
+  if (this->NumberOfThreads == 1)
+    {
+    return false;
+    }
+
+  NrrdIoState *nio = nrrdIoStateNew();
+  nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+  if (nrrdLoad(this->nrrd, this->GetFileName(), nio) != 0)
+    {
+    char *err = biffGetDone(NRRD);
+    free(err);
+    nio = nrrdIoStateNix(nio);
+    return false;
+    }
+  // Only gzip-compressed data attached to the header, in native byte order, is supported
+  bool supportedFormat = (nio->encoding == nrrdEncodingGzip && !nio->detachedHeader && nio->dataFNArr->len == 0
+    && nio->lineSkip == 0 && nio->byteSkip == 0
+    && (nrrdElementSize(this->nrrd) == 1 || nio->endian == airMyEndian()));
+  nio = nrrdIoStateNix(nio);
+  if (!supportedFormat)
+    {
+    return false;
+    }
+
+  std::string fileName = this->GetFileName();
+  FILE* file = vtksys::SystemTools::Fopen(fileName, "rb");
+  if (!file)
+    {
+    return false;
+    }
+
+  // Data starts after the empty line that terminates the header
+  size_t dataOffset = 0;
+  bool headerEndFound = false;
+  int previousCharacter = 0;
+  int character = 0;
+  while ((character = fgetc(file)) != EOF)
+    {
+    dataOffset++;
+    if (character == '\n' && previousCharacter == '\n')
+      {
+      headerEndFound = true;
+      break;
+      }
+    previousCharacter = character;
+    }
+  size_t fileSize = static_cast<size_t>(vtksys::SystemTools::FileLength(fileName));
+  if (!headerEndFound || fileSize < dataOffset)
+    {
+    fclose(file);
+    return false;
+    }
+
+  // Only read the first gzip member header to decide if the file was written with parallel compression,
+  // so that files compressed by other writers are not read twice.
+  unsigned char memberHeader[vtkTeemNRRDParallelGzip::MemberHeaderSize] = { 0 };
+  const size_t memberHeaderSize = vtkTeemNRRDParallelGzip::MemberHeaderSize;
+  if (fileSize - dataOffset < memberHeaderSize
+    || fread(memberHeader, 1, memberHeaderSize, file) != memberHeaderSize
+    || !vtkTeemNRRDParallelGzip::IsMemberHeader(memberHeader, memberHeaderSize))
+    {
+    // Not written with parallel compression
+    fclose(file);
+    return false;
+    }
+  std::vector<unsigned char> compressedData(fileSize - dataOffset);
+  std::copy(memberHeader, memberHeader + memberHeaderSize, compressedData.begin());
+  const size_t remainingSize = compressedData.size() - memberHeaderSize;
+  bool readSuccess = (fread(compressedData.data() + memberHeaderSize, 1, remainingSize, file) == remainingSize);
+  fclose(file);
+  if (!readSuccess)
+    {
+    return false;
+    }
+
+  std::vector<vtkTeemNRRDParallelGzip::Member> members;
+  if (!vtkTeemNRRDParallelGzip::GetMembers(compressedData.data(), compressedData.size(), members))
+    {
+    // Not written with parallel compression
+    return false;
+    }
+
+  size_t axisSizes[NRRD_DIM_MAX] = { 0 };
+  nrrdAxisInfoGet_nva(this->nrrd, nrrdAxisInfoSize, axisSizes);
+  if (nrrdMaybeAlloc_nva(this->nrrd, this->nrrd->type, this->nrrd->dim, axisSizes) != 0)
+    {
+    char *err = biffGetDone(NRRD);
+    free(err);
+    return false;
+    }
+  return vtkTeemNRRDParallelGzip::DecompressMembers(compressedData.data(), members,
+    this->nrrd->data, nrrdElementNumber(this->nrrd) * nrrdElementSize(this->nrrd), this->NumberOfThreads);
+}
+
+//----------------------------------------------------------------------------
+bool vtkTeemNRRDReader::MapDataIntoOutput(vtkImageData* imageData)
+{
+  vtkDataArray* voxelArray = nullptr;
+  switch (this->PointDataType)
+    {
+    case vtkDataSetAttributes::SCALARS: voxelArray = imageData->GetPointData()->GetScalars(); break;
+    case vtkDataSetAttributes::VECTORS: voxelArray = imageData->GetPointData()->GetVectors(); break;
+    case vtkDataSetAttributes::NORMALS: voxelArray = imageData->GetPointData()->GetNormals(); break;
+    default:
+      // Tensors have to be converted after reading
+      return false;
+    }
+  if (!voxelArray)
+    {
+    return false;
+    }
+
+  // Voxel memory is not allocated yet, size is determined by the image extent
+  const vtkIdType numberOfValues = imageData->GetNumberOfPoints() * voxelArray->GetNumberOfComponents();
+
+  // Voxel data can be used as is only if the range axis (if any) is the fastest axis
+  unsigned int rangeAxisIdx[NRRD_DIM_MAX] = { 0 };
+  unsigned int rangeAxisNum = nrrdRangeAxesGet(this->nrrd, rangeAxisIdx);
+  if (rangeAxisNum > 1 || (rangeAxisNum == 1 && rangeAxisIdx[0] != 0))
+    {
+    return false;
+    }
+
+  // Get location of voxel data from the header
+  Nrrd* nrrdHeader = nrrdNew();
+  NrrdIoState *nio = nrrdIoStateNew();
+  nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+  if (nrrdLoad(nrrdHeader, this->GetFileName(), nio) != 0)
+    {
+    char *err = biffGetDone(NRRD);
+    free(err);
+    nio = nrrdIoStateNix(nio);
+    nrrdHeader = nrrdNuke(nrrdHeader);
+    return false;
+    }
+  const size_t elementSize = nrrdElementSize(nrrdHeader);
+  const size_t dataSize = nrrdElementNumber(nrrdHeader) * elementSize;
+  bool supportedFormat = (nio->encoding == nrrdEncodingRaw && nio->lineSkip == 0
+    && (elementSize == 1 || nio->endian == airMyEndian())
+    && nio->dataFNArr->len <= 1
+    && dataSize == static_cast<size_t>(numberOfValues) * voxelArray->GetDataTypeSize());
+  long int byteSkip = nio->byteSkip;
+  std::string dataFileName = this->GetFileName();
+  if (supportedFormat && nio->dataFNArr->len == 1)
+    {
+    // Detached header, data file path is relative to the header file
+    dataFileName = vtksys::SystemTools::CollapseFullPath(nio->dataFN[0],
+      vtksys::SystemTools::GetFilenamePath(dataFileName));
+    }
+  nio = nrrdIoStateNix(nio);
+  nrrdHeader = nrrdNuke(nrrdHeader);
+  if (!supportedFormat || dataSize == 0)
+    {
+    return false;
+    }
+
+  size_t fileSize = static_cast<size_t>(vtksys::SystemTools::FileLength(dataFileName));
+  size_t dataOffset = 0;
+  if (byteSkip == -1)
+    {
+    // Data is at the end of the file
+    if (fileSize < dataSize)
+      {
+      return false;
+      }
+    dataOffset = fileSize - dataSize;
+    }
+  else
+    {
+    if (dataFileName == this->GetFileName())
+      {
+      // Attached header: data starts after the empty line that terminates the header
+      FILE* file = vtksys::SystemTools::Fopen(dataFileName, "rb");
+      if (!file)
+        {
+        return false;
+        }
+      bool headerEndFound = false;
+      int previousCharacter = 0;
+      int character = 0;
+      while ((character = fgetc(file)) != EOF)
+        {
+        dataOffset++;
+        if (character == '\n' && previousCharacter == '\n')
+          {
+          headerEndFound = true;
+          break;
+          }
+        if (character != '\r')
+          {
+          previousCharacter = character;
+          }
+        }
+      fclose(file);
+      if (!headerEndFound)
+        {
+        return false;
+        }
+      }
+    dataOffset += static_cast<size_t>(byteSkip);
+    }
+  if (dataOffset + dataSize > fileSize || dataOffset % voxelArray->GetDataTypeSize() != 0)
+    {
+    // Data is truncated or not aligned to the data element size
+    return false;
+    }
+
+  void* data = MapFileRegion(dataFileName, dataOffset, dataSize);
+  if (!data)
+    {
+    return false;
+    }
+  voxelArray->SetVoidArray(data, numberOfValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  voxelArray->SetArrayFreeFunction(UnmapFileRegion);
+  voxelArray->SetName(this->DataArrayName.c_str());
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkTeemNRRDReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "UseMemoryMapping: " << (this->UseMemoryMapping ? "true" : "false") << "\n";
 }
@@ -155,6 +155,26 @@ public:
   vtkSetMacro(DataArrayName, std::string);
   vtkGetMacro(DataArrayName, std::string);
 
+  ///
+  /// Number of threads used for decompressing data that was written
+  /// with parallel gzip compression by vtkTeemNRRDWriter.
+  /// 0 (default) means that all available threads are used. If set to 1 then
+  /// all files are read by the standard (single-threaded) NRRD reader.
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+
+  ///
+  /// Map uncompressed voxel data directly from the file instead of reading it into
+  /// a newly allocated buffer. The mapping is copy-on-write: modifying the voxels
+  /// does not change the file. Pages that are not modified are shared with other
+  /// processes that map the same file. Only used for raw encoding in native byte order,
+  /// other files are read normally. Disabled by default.
+  /// Voxel memory is not allocated in advance when mapping is enabled, therefore files
+  /// larger than the physical memory can be loaded.
+  vtkSetMacro(UseMemoryMapping, bool);
+  vtkGetMacro(UseMemoryMapping, bool);
+  vtkBooleanMacro(UseMemoryMapping, bool);
+
   int NrrdToVTKScalarType( const int nrrdPixelType ) const
   {
   switch( nrrdPixelType )
@@ -265,6 +285,8 @@ protected:
   int NumberOfComponents;
   bool UseNativeOrigin;
   std::string DataArrayName;
+  int NumberOfThreads;
+  bool UseMemoryMapping;
 
   std::map <std::string, std::string> HeaderKeyValue;
   std::string HeaderKeys; // buffer for returning key list
@@ -277,6 +299,14 @@ protected:
 
   int tenSpaceDirectionReduce(Nrrd *nout, const Nrrd *nin, double SD[9]);
 
+  /// Read header and data into this->nrrd if data is stored in independently compressed gzip chunks.
+  /// \return False if the data is not stored in independent chunks or reading fails.
+  bool ReadParallelCompressedData();
+
+  /// Set memory-mapped file data as voxel array of the output image.
+  /// \return False if the file cannot be memory-mapped.
+  bool MapDataIntoOutput(vtkImageData* imageData);
+
 private:
   vtkTeemNRRDReader(const vtkTeemNRRDReader&) = delete;
   void operator=(const vtkTeemNRRDReader&) = delete;
@@ -1,6 +1,7 @@
 #include <map>
 
 #include "vtkTeemNRRDWriter.h"
+#include "vtkTeemNRRDParallelGzip.h"
 
 
 #include "vtkImageData.h"
@@ -8,6 +9,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkInformation.h"
 #include <vtkVersion.h>
+#include <vtksys/SystemTools.hxx>
 
 #include <itkMath.h>
 #include <vnl/vnl_double_3.h>
@@ -31,6 +33,7 @@ vtkTeemNRRDWriter::vtkTeemNRRDWriter()
   this->UseCompression = 1;
   // use default CompressionLevel
   this->CompressionLevel = -1;
+  this->NumberOfThreads = 0;
   this->DiffusionWeightedData = 0;
   this->FileType = VTK_BINARY;
   this->WriteErrorOff();
@@ -439,6 +442,18 @@ void vtkTeemNRRDWriter::WriteData()
   // set endianness as unknown of output
   nio->endian = airEndianUnknown;
 
+  // Compress large data in parallel, in independent gzip chunks.
+  // Only used for attached headers, as data is appended to the file after the header is written.
+  size_t dataSize = nrrdElementNumber(nrrd) * nrrdElementSize(nrrd);
+  bool parallelCompression = (nio->encoding == nrrdEncodingGzip && this->NumberOfThreads != 1
+    && dataSize > vtkTeemNRRDParallelGzip::ChunkSize
+    && vtksys::SystemTools::LowerCase(vtksys::SystemTools::GetFilenameLastExtension(this->GetFileName())) == ".nrrd");
+  if (parallelCompression)
+    {
+    // Write only the header, data is appended to it
+    nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+    }
+
   // Write the nrrd to file.
   if (nrrdSave(this->GetFileName(), nrrd, nio))
     {
@@ -447,14 +462,58 @@ void vtkTeemNRRDWriter::WriteData()
                       << this->GetFileName() << ":\n" << err);
     this->WriteErrorOn();
     }
+  else if (parallelCompression)
+    {
+    if (!this->AppendParallelCompressedData(nrrd->data, dataSize))
+      {
+      vtkErrorMacro("Write: Error writing compressed data to " << this->GetFileName());
+      this->WriteErrorOn();
+      }
+    }
   // Free the nrrd struct but don't touch nrrd->data
   nrrd = nrrdNix(nrrd);
   nio = nrrdIoStateNix(nio);
 }
 
+//----------------------------------------------------------------------------
+bool vtkTeemNRRDWriter::AppendParallelCompressedData(const void* data, size_t dataSize)
+{
+  // Header and data are separated by an empty line. Make sure it is present
+  // (it may be omitted by nrrdSave when data writing is skipped).
+  std::string fileName = this->GetFileName();
+  FILE* file = vtksys::SystemTools::Fopen(fileName, "rb");
+  if (!file)
+    {
+    return false;
+    }
+  char headerEnd[2] = { 0, 0 };
+  bool emptyLinePresent = (fseek(file, -2, SEEK_END) == 0 && fread(headerEnd, 1, 2, file) == 2
+    && headerEnd[0] == '\n' && headerEnd[1] == '\n');
+  fclose(file);
+  if (!emptyLinePresent)
+    {
+    file = vtksys::SystemTools::Fopen(fileName, "ab");
+    if (!file)
+      {
+      return false;
+      }
+    bool success = (fputc('\n', file) != EOF);
+    success = (fclose(file) == 0) && success;
+    if (!success)
+      {
+      return false;
+      }
+    }
+
+  // Negative compression level selects the zlib default
+  return vtkTeemNRRDParallelGzip::AppendCompressedData(fileName, data, dataSize, this->CompressionLevel, this->NumberOfThreads);
+}
+
+//----------------------------------------------------------------------------
 void vtkTeemNRRDWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
 
   os << indent << "RAS to IJK Matrix: ";
      this->IJKToRASMatrix->PrintSelf(os,indent);
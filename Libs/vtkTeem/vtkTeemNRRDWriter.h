@@ -58,6 +58,13 @@ public:
   vtkSetClampMacro(CompressionLevel, int, 0, 9);
   vtkGetMacro(CompressionLevel, int);
 
+  /// Number of threads used for gzip compression.
+  /// 0 (default) means that all available threads are used. If set to 1 then data is written as
+  /// a single gzip stream. Otherwise the data is compressed in independent chunks in parallel.
+  /// Files written with parallel compression can be read by all NRRD readers.
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+
   vtkSetClampMacro(FileType,int,VTK_ASCII,VTK_BINARY);
   vtkGetMacro(FileType,int);
   void SetFileTypeToASCII() {this->SetFileType(VTK_ASCII);};
@@ -115,6 +122,9 @@ protected:
   /// Write method. It is called by vtkWriter::Write();
   void WriteData() override;
 
+  /// Append gzip-compressed data to the file (after the header), using multiple threads.
+  bool AppendParallelCompressedData(const void* data, size_t dataSize);
+
   ///
   /// Flag to set to on when a write error occurred
   int WriteError;
@@ -129,6 +139,7 @@ protected:
 
   int UseCompression;
   int CompressionLevel;
+  int NumberOfThreads;
   int FileType;
 
   AttributeMapType *Attributes;
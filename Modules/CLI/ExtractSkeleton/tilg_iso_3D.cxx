@@ -21,8 +21,14 @@
 // adapted to C++: Martin Styner 20.July.2000
 // integrated into slicer: Stephen Aylward, 20, Aug, 2007
 /*****************************************************************************/
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "itkMultiThreaderBase.h"
 
 /********************************  Konstanten  *******************************/
 #define LIM  1 /* Voxelwert >= LIM => Objekt (Input-Bild) */
@@ -173,6 +179,157 @@ int Env_Code_3(int i)
   return nc;
 }
 
+/* Object voxels that have at least one background voxel in their        */
+/* 26-neighborhood. Voxels that are completely surrounded by object      */
+/* voxels can never be removed (neither the direction test nor the       */
+/* Euler test can pass), therefore only boundary voxels have to be tested */
+struct BoundaryVoxels
+{
+  std::vector<int>           Indices;
+  /* non-zero if the voxel is in Indices */
+  std::vector<unsigned char> Listed;
+};
+
+int get_number_of_chunks(int numberOfItems)
+/* number of chunks that a list of voxels is split to for parallel processing */
+{
+  int numberOfChunks = 4 * itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  return std::max(1, std::min(numberOfChunks, numberOfItems));
+}
+
+void get_neighbor_offsets(int offsets[26])
+/* index offsets of the 26 neighbors of a voxel */
+{
+  int k = 0;
+  for( int dz = -1; dz <= 1; dz++ )
+    {
+    for( int dy = -1; dy <= 1; dy++ )
+      {
+      for( int dx = -1; dx <= 1; dx++ )
+        {
+        if( dx != 0 || dy != 0 || dz != 0 )
+          {
+          offsets[k++] = dx + nx * (dy + ny * dz);
+          }
+        }
+      }
+    }
+}
+
+void init_boundary_voxels(const int offsets[26], BoundaryVoxels& boundary)
+/* collects boundary voxels in the bounding box of the object, in raster order */
+{
+  boundary.Listed.assign(nzz * nz, 0);
+  boundary.Indices.clear();
+
+  /* bounding box of the object (voxels at the edge of the image are background) */
+  std::vector<int> sliceBounds(nz * 4);
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, nz,
+    [&](itk::SizeValueType z)
+    {
+    int* bounds = &sliceBounds[z * 4];
+    bounds[0] = nx;
+    bounds[1] = -1;
+    bounds[2] = ny;
+    bounds[3] = -1;
+    for( int y = 1; y < ny - 1; y++ )
+      {
+      for( int x = 1; x < nx - 1; x++ )
+        {
+        if( P(result, x, y, z) == OBJ )
+          {
+          bounds[0] = std::min(bounds[0], x);
+          bounds[1] = std::max(bounds[1], x);
+          bounds[2] = std::min(bounds[2], y);
+          bounds[3] = std::max(bounds[3], y);
+          }
+        }
+      }
+    }, nullptr);
+  int xMin = nx, xMax = -1, yMin = ny, yMax = -1, zMin = nz, zMax = -1;
+  for( int z = 0; z < nz; z++ )
+    {
+    const int* bounds = &sliceBounds[z * 4];
+    if( bounds[1] < 0 )
+      {
+      continue;
+      }
+    xMin = std::min(xMin, bounds[0]);
+    xMax = std::max(xMax, bounds[1]);
+    yMin = std::min(yMin, bounds[2]);
+    yMax = std::max(yMax, bounds[3]);
+    zMin = std::min(zMin, z);
+    zMax = std::max(zMax, z);
+    }
+  if( zMax < zMin )
+    {
+    /* empty object */
+    return;
+    }
+
+  /* boundary voxels of each slice */
+  std::vector<std::vector<int> > sliceIndices(zMax - zMin + 1);
+  itk::MultiThreaderBase::New()->ParallelizeArray(zMin, zMax + 1,
+    [&](itk::SizeValueType z)
+    {
+    std::vector<int>& indices = sliceIndices[z - zMin];
+    for( int y = yMin; y <= yMax; y++ )
+      {
+      for( int x = xMin; x <= xMax; x++ )
+        {
+        int i = x + nx * (y + ny * static_cast<int>(z));
+        if( result[i] != OBJ )
+          {
+          continue;
+          }
+        for( int k = 0; k < 26; k++ )
+          {
+          if( result[i + offsets[k]] == BG )
+            {
+            indices.push_back(i);
+            boundary.Listed[i] = 1;
+            break;
+            }
+          }
+        }
+      }
+    }, nullptr);
+  for( const std::vector<int>& indices : sliceIndices )
+    {
+    boundary.Indices.insert(boundary.Indices.end(), indices.begin(), indices.end());
+    }
+}
+
+void update_boundary_voxels(const int offsets[26], const std::vector<int>& removed, BoundaryVoxels& boundary)
+/* removes deleted voxels from the boundary and adds the voxels that they uncovered */
+{
+  size_t numberOfKeptVoxels = 0;
+  for( int i : boundary.Indices )
+    {
+    if( result[i] == OBJ )
+      {
+      boundary.Indices[numberOfKeptVoxels++] = i;
+      }
+    else
+      {
+      boundary.Listed[i] = 0;
+      }
+    }
+  boundary.Indices.resize(numberOfKeptVoxels);
+  for( int i : removed )
+    {
+    for( int k = 0; k < 26; k++ )
+      {
+      int j = i + offsets[k];
+      if( result[j] == OBJ && !boundary.Listed[j] )
+        {
+        boundary.Listed[j] = 1;
+        boundary.Indices.push_back(j);
+        }
+      }
+    }
+}
+
 /*************************** ENDE  Hilfsprozeduren **************************/
 
 /******************************  Hauptprozedur ******************************/
@@ -605,10 +762,9 @@ void tilg_iso_3D(int dx, int dy, int dz,
 {
 
   int cnt = 0, cnt1 = 0;
-  int nc, x, y, z;
+  int x, y, z;
   int end, i, dir, dir_mask;
   // int free_mask;
-  int *list;
   int  dir_tab[26];
 
   // int b[3][3][3];
@@ -620,12 +776,6 @@ void tilg_iso_3D(int dx, int dy, int dz,
 
   workbuf = data;
   nzz = nx * ny;
-  /* Speicher allozieren */
-  if( (list = (int *) malloc(nzz * nz * sizeof(int) / 4) ) == nullptr )
-    {
-    printf("out of memory\n");
-    return;
-    }
   /* Arbeitskopie des Bildes erstellen und binaerisieren */
   end = nx * ny * nz;
   for( i = 0; i < end; i++ )
@@ -696,62 +846,115 @@ void tilg_iso_3D(int dx, int dy, int dz,
   f_tab[17] =      512;    /*  9 */
 
   /* eigentliches Bildparsing */
-  end = end - nzz - nx - 1;
+  /* Only boundary voxels in the bounding box of the object are tested, instead */
+  /* of scanning the whole image in each iteration.                             */
+  int offsets[26];
+  get_neighbor_offsets(offsets);
+  BoundaryVoxels boundary;
+  init_boundary_voxels(offsets, boundary);
+
+  /* Directional subiterations: all voxels of the boundary are tested on the */
+  /* same image and deletable voxels are removed at the end of the           */
+  /* subiteration, therefore the voxels can be tested in parallel.           */
+  std::vector<std::vector<int> > chunkLists;
+  std::vector<int> list;
   cnt = 1;
   while( cnt )
     {
     cnt = 0;
     for( dir = 0; dir < 18; dir++ )
       {
-      cnt1 = 0;
       dir_mask = dir_tab[dir];
-      for( i = nzz + nx + 1; i < end; i++ )
+      int numberOfBoundaryVoxels = static_cast<int>(boundary.Indices.size());
+      int numberOfChunks = get_number_of_chunks(numberOfBoundaryVoxels);
+      int voxelsPerChunk = (numberOfBoundaryVoxels + numberOfChunks - 1) / numberOfChunks;
+      chunkLists.resize(numberOfChunks);
+      itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfChunks,
+        [&](itk::SizeValueType chunk)
         {
-        if( result[i] == OBJ )
+        std::vector<int>& chunkList = chunkLists[chunk];
+        chunkList.clear();
+        int chunkEnd = std::min(numberOfBoundaryVoxels, static_cast<int>(chunk + 1) * voxelsPerChunk);
+        for( int k = static_cast<int>(chunk) * voxelsPerChunk; k < chunkEnd; k++ )
           {
-          nc = Env_Code_3(i);
+          int voxel = boundary.Indices[k];
+          int nc = Env_Code_3(voxel);
           if( ( (~ nc) & dir_mask) == dir_mask )
             {
             if( bitcount(nc) > 2 )
               {
               if( Tilg_Test_3(nc, dir, type) == BG )
                 {
-                list[cnt1++] = i;
+                chunkList.push_back(voxel);
                 }
               }
             }
           }
-        }
+        }, nullptr);
       /* Voxel der Liste loeschen */
+      list.clear();
+      for( const std::vector<int>& chunkList : chunkLists )
+        {
+        list.insert(list.end(), chunkList.begin(), chunkList.end());
+        }
+      cnt1 = static_cast<int>(list.size());
       for( i = 0; i < cnt1; i++ )
         {
         result[list[i]] = BG;
         }
+      if( cnt1 > 0 )
+        {
+        update_boundary_voxels(offsets, list, boundary);
+        }
       cnt += cnt1;
       }
     }
 
   /* sequentiell maximal Verduennen */
-  cnt = 1;
-  while( cnt )
-    {
-    cnt = 0;
-    for( i = nzz + nx + 1; i < end; i++ )
+  /* Voxels are visited in raster order and removed immediately, as in a full */
+  /* scan of the image, but a voxel is only tested again if its neighborhood  */
+  /* has changed since it was last tested. Voxels uncovered after the current */
+  /* position are tested in the same scan, the others in the next scan.       */
+  std::vector<int> nextScan;
+  nextScan.swap(boundary.Indices);
+  std::vector<unsigned char>& queued = boundary.Listed;
+  while( !nextScan.empty() )
+    {
+    std::priority_queue<int, std::vector<int>, std::greater<int> > scan(std::greater<int>(), std::move(nextScan));
+    nextScan.clear();
+    while( !scan.empty() )
       {
-      if( result[i] == OBJ )
+      i = scan.top();
+      scan.pop();
+      queued[i] = 0;
+      if( result[i] != OBJ )
+        {
+        continue;
+        }
+      int nc = Env_Code_3(i);
+      if( bitcount(nc) > 2 )
         {
-        nc = Env_Code_3(i);
-        if( bitcount(nc) > 2 )
+        if( Tilg_Test_3(nc, 18, type) == BG )
           {
-          if( Tilg_Test_3(nc, 18, type) == BG )
+          result[i] = BG;
+          for( int k = 0; k < 26; k++ )
             {
-            cnt++;
-            result[i] = BG;
+            int j = i + offsets[k];
+            if( result[j] == OBJ && !queued[j] )
+              {
+              queued[j] = 1;
+              if( j > i )
+                {
+                scan.push(j);
+                }
+              else
+                {
+                nextScan.push_back(j);
+                }
+              }
             }
           }
         }
       }
     }
-
-  free(list);
 }
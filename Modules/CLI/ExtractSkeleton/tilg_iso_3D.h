@@ -36,5 +36,7 @@ void tilg_iso_3D(int dx, int dy, int dz, unsigned char *data, unsigned char *res
 // output image has to be allocated
 // if type == 1 -> sheet preserving tilg
 // if type == 0 -> full tilg
+// only boundary voxels of the object are tested and the directional
+// subiterations are computed using multiple threads
 
 #endif
@@ -24,9 +24,16 @@
 #include "itkPluginUtilities.h"
 
 #include "itkHistogramMatchingImageFilter.h"
+#include "itkMultiThreaderBase.h"
 
 #include "HistogramMatchingCLP.h"
 
+// STD includes
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <vector>
+
 // Use an anonymous namespace to keep class types and function names
 // from colliding when module is used as shared object module.  Every
 // thing should be in an anonymous namespace except for the module
@@ -35,11 +42,346 @@
 namespace
 {
 
+const char* REFERENCE_HISTOGRAM_CACHE_FILE_HEADER = "SlicerHistogramMatchingHistogram";
+const int REFERENCE_HISTOGRAM_CACHE_FILE_VERSION = 1;
+
+// Intensity histogram of the voxels of an image, with the same bin layout and
+// quantile computation as itk::HistogramMatchingImageFilter.
+struct IntensityHistogram
+{
+  // Parameters that were used for computing the histogram
+  int NumberOfHistogramLevels{0};
+  bool ThresholdAtMeanIntensity{false};
+  long NumberOfSamples{0};
+
+  double MinValue{0.0};
+  double MaxValue{0.0};
+  double MeanValue{0.0};
+  // Intensity of the lower bound of the first bin (MinValue or MeanValue)
+  double LowerBound{0.0};
+  std::vector<double> Frequencies;
+
+  double GetBinMin(int binIndex) const
+  {
+    return this->LowerBound + binIndex * (this->MaxValue - this->LowerBound) / this->Frequencies.size();
+  }
+
+  double Quantile(double p) const
+  {
+    double totalFrequency = 0.0;
+    for (double frequency : this->Frequencies)
+      {
+      totalFrequency += frequency;
+      }
+    if (totalFrequency <= 0.0 || this->Frequencies.empty())
+      {
+      return this->LowerBound;
+      }
+    double cumulatedFrequency = 0.0;
+    double previousProportion = 0.0;
+    double proportion = 0.0;
+    int binIndex = 0;
+    int numberOfBins = static_cast<int>(this->Frequencies.size());
+    for (binIndex = 0; binIndex < numberOfBins; ++binIndex)
+      {
+      cumulatedFrequency += this->Frequencies[binIndex];
+      previousProportion = proportion;
+      proportion = cumulatedFrequency / totalFrequency;
+      if (proportion >= p)
+        {
+        break;
+        }
+      }
+    binIndex = std::min(binIndex, numberOfBins - 1);
+    double binProportion = this->Frequencies[binIndex] / totalFrequency;
+    double binMin = this->GetBinMin(binIndex);
+    double binWidth = this->GetBinMin(binIndex + 1) - binMin;
+    if (binProportion <= 0.0)
+      {
+      return binMin;
+      }
+    return binMin + ((p - previousProportion) / binProportion) * binWidth;
+  }
+
+  bool Write(const std::string& fileName) const
+  {
+    std::ofstream file(fileName.c_str());
+    if (!file)
+      {
+      return false;
+      }
+    file.precision(std::numeric_limits<double>::max_digits10);
+    file << REFERENCE_HISTOGRAM_CACHE_FILE_HEADER << " " << REFERENCE_HISTOGRAM_CACHE_FILE_VERSION << "\n";
+    file << this->NumberOfHistogramLevels << " " << (this->ThresholdAtMeanIntensity ? 1 : 0) << " " << this->NumberOfSamples << "\n";
+    file << this->MinValue << " " << this->MaxValue << " " << this->MeanValue << " " << this->LowerBound << "\n";
+    for (double frequency : this->Frequencies)
+      {
+      file << frequency << "\n";
+      }
+    return static_cast<bool>(file);
+  }
+
+  bool Read(const std::string& fileName)
+  {
+    std::ifstream file(fileName.c_str());
+    if (!file)
+      {
+      return false;
+      }
+    std::string header;
+    int version = 0;
+    file >> header >> version;
+    if (header != REFERENCE_HISTOGRAM_CACHE_FILE_HEADER || version != REFERENCE_HISTOGRAM_CACHE_FILE_VERSION)
+      {
+      return false;
+      }
+    int thresholdAtMeanIntensity = 0;
+    file >> this->NumberOfHistogramLevels >> thresholdAtMeanIntensity >> this->NumberOfSamples;
+    this->ThresholdAtMeanIntensity = (thresholdAtMeanIntensity != 0);
+    file >> this->MinValue >> this->MaxValue >> this->MeanValue >> this->LowerBound;
+    if (!file || this->NumberOfHistogramLevels < 1)
+      {
+      return false;
+      }
+    this->Frequencies.resize(this->NumberOfHistogramLevels);
+    for (double& frequency : this->Frequencies)
+      {
+      file >> frequency;
+      }
+    return static_cast<bool>(file);
+  }
+};
+
+// Get the number of chunks that the voxels are split to for multithreaded processing
+itk::SizeValueType GetNumberOfChunks(itk::SizeValueType numberOfItems)
+{
+  itk::SizeValueType numberOfChunks = 4 * itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  return std::max<itk::SizeValueType>(1, std::min(numberOfChunks, numberOfItems));
+}
+
+// Compute histogram from all voxels of the image or a regularly sampled subset of voxels.
+// Voxels are processed in parallel, each chunk of voxels is accumulated into a separate histogram.
+template <class TImage>
+void ComputeHistogram(const TImage* image, int numberOfHistogramLevels, bool thresholdAtMeanIntensity,
+  long numberOfSamples, IntensityHistogram& histogram)
+{
+  histogram.NumberOfHistogramLevels = numberOfHistogramLevels;
+  histogram.ThresholdAtMeanIntensity = thresholdAtMeanIntensity;
+  histogram.NumberOfSamples = numberOfSamples;
+
+  const typename TImage::PixelType* voxels = image->GetBufferPointer();
+  itk::SizeValueType numberOfVoxels = image->GetBufferedRegion().GetNumberOfPixels();
+  itk::SizeValueType stride = 1;
+  if (numberOfSamples > 0 && static_cast<itk::SizeValueType>(numberOfSamples) < numberOfVoxels)
+    {
+    stride = numberOfVoxels / numberOfSamples;
+    }
+  itk::SizeValueType numberOfSampledVoxels = (numberOfVoxels + stride - 1) / stride;
+  itk::SizeValueType numberOfChunks = GetNumberOfChunks(numberOfSampledVoxels);
+  itk::SizeValueType samplesPerChunk = (numberOfSampledVoxels + numberOfChunks - 1) / numberOfChunks;
+
+  // Intensity range and mean
+  std::vector<double> chunkMin(numberOfChunks, std::numeric_limits<double>::max());
+  std::vector<double> chunkMax(numberOfChunks, std::numeric_limits<double>::lowest());
+  std::vector<double> chunkSum(numberOfChunks, 0.0);
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfChunks,
+    [&](itk::SizeValueType chunkIndex)
+    {
+    itk::SizeValueType endSample = std::min(numberOfSampledVoxels, (chunkIndex + 1) * samplesPerChunk);
+    for (itk::SizeValueType sample = chunkIndex * samplesPerChunk; sample < endSample; ++sample)
+      {
+      double value = static_cast<double>(voxels[sample * stride]);
+      chunkMin[chunkIndex] = std::min(chunkMin[chunkIndex], value);
+      chunkMax[chunkIndex] = std::max(chunkMax[chunkIndex], value);
+      chunkSum[chunkIndex] += value;
+      }
+    }, nullptr);
+  double sum = 0.0;
+  histogram.MinValue = std::numeric_limits<double>::max();
+  histogram.MaxValue = std::numeric_limits<double>::lowest();
+  for (itk::SizeValueType chunkIndex = 0; chunkIndex < numberOfChunks; ++chunkIndex)
+    {
+    histogram.MinValue = std::min(histogram.MinValue, chunkMin[chunkIndex]);
+    histogram.MaxValue = std::max(histogram.MaxValue, chunkMax[chunkIndex]);
+    sum += chunkSum[chunkIndex];
+    }
+  histogram.MeanValue = (numberOfSampledVoxels > 0 ? sum / numberOfSampledVoxels : 0.0);
+  histogram.LowerBound = (thresholdAtMeanIntensity ? histogram.MeanValue : histogram.MinValue);
+
+  // Histogram of voxels in the [LowerBound, MaxValue] range
+  double lowerBound = histogram.LowerBound;
+  double upperBound = histogram.MaxValue;
+  double binsPerIntensity = (upperBound > lowerBound ? numberOfHistogramLevels / (upperBound - lowerBound) : 0.0);
+  std::vector< std::vector<double> > chunkFrequencies(numberOfChunks);
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfChunks,
+    [&](itk::SizeValueType chunkIndex)
+    {
+    std::vector<double>& frequencies = chunkFrequencies[chunkIndex];
+    frequencies.assign(numberOfHistogramLevels, 0.0);
+    itk::SizeValueType endSample = std::min(numberOfSampledVoxels, (chunkIndex + 1) * samplesPerChunk);
+    for (itk::SizeValueType sample = chunkIndex * samplesPerChunk; sample < endSample; ++sample)
+      {
+      double value = static_cast<double>(voxels[sample * stride]);
+      if (value < lowerBound || value > upperBound)
+        {
+        continue;
+        }
+      // values at the upper bound are included in the last bin
+      int binIndex = std::min(static_cast<int>((value - lowerBound) * binsPerIntensity), numberOfHistogramLevels - 1);
+      frequencies[binIndex] += 1.0;
+      }
+    }, nullptr);
+  histogram.Frequencies.assign(numberOfHistogramLevels, 0.0);
+  for (const std::vector<double>& frequencies : chunkFrequencies)
+    {
+    for (int binIndex = 0; binIndex < numberOfHistogramLevels; ++binIndex)
+      {
+      histogram.Frequencies[binIndex] += frequencies[binIndex];
+      }
+    }
+}
+
+// Map intensities of the input image so that its histogram matches the reference histogram.
+// The mapping is the same piecewise linear function as in itk::HistogramMatchingImageFilter.
+template <class TInputImage, class TOutputImage>
+void MatchHistogram(const TInputImage* inputImage, const IntensityHistogram& sourceHistogram,
+  const IntensityHistogram& referenceHistogram, int numberOfMatchPoints, TOutputImage* outputImage)
+{
+  // Quantile table: first row is source, second row is reference intensity
+  std::vector<double> sourceQuantiles(numberOfMatchPoints + 2);
+  std::vector<double> referenceQuantiles(numberOfMatchPoints + 2);
+  sourceQuantiles[0] = sourceHistogram.LowerBound;
+  referenceQuantiles[0] = referenceHistogram.LowerBound;
+  sourceQuantiles[numberOfMatchPoints + 1] = sourceHistogram.MaxValue;
+  referenceQuantiles[numberOfMatchPoints + 1] = referenceHistogram.MaxValue;
+  double delta = 1.0 / (static_cast<double>(numberOfMatchPoints) + 1.0);
+  for (int j = 1; j < numberOfMatchPoints + 1; ++j)
+    {
+    sourceQuantiles[j] = sourceHistogram.Quantile(j * delta);
+    referenceQuantiles[j] = referenceHistogram.Quantile(j * delta);
+    }
+  std::vector<double> gradients(numberOfMatchPoints + 1, 0.0);
+  for (int j = 0; j < numberOfMatchPoints + 1; ++j)
+    {
+    double denominator = sourceQuantiles[j + 1] - sourceQuantiles[j];
+    gradients[j] = (denominator != 0.0 ? (referenceQuantiles[j + 1] - referenceQuantiles[j]) / denominator : 0.0);
+    }
+  double denominator = sourceQuantiles[0] - sourceHistogram.MinValue;
+  double lowerGradient = (denominator != 0.0 ? (referenceQuantiles[0] - referenceHistogram.MinValue) / denominator : 0.0);
+  denominator = sourceQuantiles[numberOfMatchPoints + 1] - sourceHistogram.MaxValue;
+  double upperGradient = (denominator != 0.0 ? (referenceQuantiles[numberOfMatchPoints + 1] - referenceHistogram.MaxValue) / denominator : 0.0);
+
+  outputImage->CopyInformation(inputImage);
+  outputImage->SetRegions(inputImage->GetBufferedRegion());
+  outputImage->Allocate();
+
+  const typename TInputImage::PixelType* inputVoxels = inputImage->GetBufferPointer();
+  typename TOutputImage::PixelType* outputVoxels = outputImage->GetBufferPointer();
+  itk::SizeValueType numberOfVoxels = inputImage->GetBufferedRegion().GetNumberOfPixels();
+  itk::SizeValueType numberOfChunks = GetNumberOfChunks(numberOfVoxels);
+  itk::SizeValueType voxelsPerChunk = (numberOfVoxels + numberOfChunks - 1) / numberOfChunks;
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfChunks,
+    [&](itk::SizeValueType chunkIndex)
+    {
+    itk::SizeValueType endVoxel = std::min(numberOfVoxels, (chunkIndex + 1) * voxelsPerChunk);
+    for (itk::SizeValueType voxel = chunkIndex * voxelsPerChunk; voxel < endVoxel; ++voxel)
+      {
+      double sourceValue = static_cast<double>(inputVoxels[voxel]);
+      int j = 0;
+      for (j = 0; j < numberOfMatchPoints + 2; ++j)
+        {
+        if (sourceValue < sourceQuantiles[j])
+          {
+          break;
+          }
+        }
+      double mappedValue = 0.0;
+      if (j == 0)
+        {
+        mappedValue = referenceHistogram.MinValue + (sourceValue - sourceHistogram.MinValue) * lowerGradient;
+        }
+      else if (j == numberOfMatchPoints + 2)
+        {
+        mappedValue = referenceHistogram.MaxValue + (sourceValue - sourceHistogram.MaxValue) * upperGradient;
+        }
+      else
+        {
+        mappedValue = referenceQuantiles[j - 1] + (sourceValue - sourceQuantiles[j - 1]) * gradients[j - 1];
+        }
+      outputVoxels[voxel] = static_cast<typename TOutputImage::PixelType>(mappedValue);
+      }
+    }, nullptr);
+}
+
+// Compute histogram matching using sampled histograms and optionally cached reference histogram
+template <class T>
+int DoItSampled( int argc, char * argv[], T )
+{
+  PARSE_ARGS;
+
+  const unsigned int Dimension = 3;
+
+  typedef itk::Image<T, Dimension> ImageType;
+  typedef itk::ImageFileReader<ImageType> ReaderType;
+  typedef itk::ImageFileWriter<ImageType> WriterType;
+
+  IntensityHistogram referenceHistogram;
+  bool referenceHistogramValid = false;
+  if (!referenceHistogramCacheFile.empty() && referenceHistogram.Read(referenceHistogramCacheFile))
+    {
+    // Only use the cached histogram if it was computed with the same parameters
+    referenceHistogramValid = (referenceHistogram.NumberOfHistogramLevels == numberOfHistogramLevels
+      && referenceHistogram.ThresholdAtMeanIntensity == thresholdAtMeanIntensity
+      && referenceHistogram.NumberOfSamples == numberOfSamples);
+    if (!referenceHistogramValid)
+      {
+      std::cout << "Reference histogram cache file " << referenceHistogramCacheFile
+        << " was computed with different parameters, the histogram is recomputed." << std::endl;
+      }
+    }
+  if (!referenceHistogramValid)
+    {
+    typename ReaderType::Pointer referenceReader = ReaderType::New();
+    referenceReader->SetFileName( referenceVolume.c_str() );
+    referenceReader->Update();
+    ComputeHistogram<ImageType>(referenceReader->GetOutput(), numberOfHistogramLevels, thresholdAtMeanIntensity,
+      numberOfSamples, referenceHistogram);
+    if (!referenceHistogramCacheFile.empty() && !referenceHistogram.Write(referenceHistogramCacheFile))
+      {
+      std::cerr << "Failed to write reference histogram cache file " << referenceHistogramCacheFile << std::endl;
+      }
+    }
+
+  typename ReaderType::Pointer inputReader = ReaderType::New();
+  inputReader->SetFileName( inputVolume.c_str() );
+  inputReader->Update();
+  IntensityHistogram sourceHistogram;
+  ComputeHistogram<ImageType>(inputReader->GetOutput(), numberOfHistogramLevels, thresholdAtMeanIntensity,
+    numberOfSamples, sourceHistogram);
+
+  typename ImageType::Pointer outputImage = ImageType::New();
+  MatchHistogram<ImageType, ImageType>(inputReader->GetOutput(), sourceHistogram, referenceHistogram,
+    numberOfMatchPoints, outputImage);
+
+  typename WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName( outputVolume.c_str() );
+  writer->SetUseCompression(1);
+  writer->SetInput( outputImage );
+  writer->Update();
+
+  return EXIT_SUCCESS;
+}
+
 template <class T>
 int DoIt( int argc, char * argv[], T )
 {
   PARSE_ARGS;
 
+  if (numberOfSamples > 0 || !referenceHistogramCacheFile.empty())
+    {
+    return DoItSampled<T>(argc, argv, static_cast<T>(0));
+    }
+
   const unsigned int Dimension = 3;
 
   typedef T InputPixelType;
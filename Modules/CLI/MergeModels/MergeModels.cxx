@@ -16,38 +16,41 @@
 
 // VTK includes
 #include <vtkAppendPolyData.h>
+#include <vtkSmartPointer.h>
 
 // MRML includes
 #include "vtkMRMLModelNode.h"
 #include "vtkMRMLModelStorageNode.h"
 
+// STD includes
+#include <vector>
 
 int main( int argc, char * argv[] )
 {
   PARSE_ARGS;
 
-  vtkNew<vtkMRMLModelStorageNode> model1StorageNode;
-  model1StorageNode->SetFileName(Model1.c_str());
-  vtkNew<vtkMRMLModelNode> model1Node;
-  if (!model1StorageNode->ReadData(model1Node))
-    {
-    std::cerr << "Failed to read input model 1 file " << Model1 << std::endl;
-    return EXIT_FAILURE;
-    }
+  std::vector<std::string> inputModelFileNames;
+  inputModelFileNames.push_back(Model1);
+  inputModelFileNames.push_back(Model2);
+  inputModelFileNames.insert(inputModelFileNames.end(), AdditionalModels.begin(), AdditionalModels.end());
 
-  vtkNew<vtkMRMLModelStorageNode> model2StorageNode;
-  model2StorageNode->SetFileName(Model2.c_str());
-  vtkNew<vtkMRMLModelNode> model2Node;
-  if (!model2StorageNode->ReadData(model2Node))
+  // Read all the models and add them together.
+  // All inputs are appended in a single pass, output arrays are allocated once.
+  vtkNew<vtkAppendPolyData> add;
+  std::vector< vtkSmartPointer<vtkMRMLModelNode> > inputModelNodes;
+  for (const std::string& inputModelFileName : inputModelFileNames)
     {
-    std::cerr << "Failed to read input model 2 file " << Model2 << std::endl;
-    return EXIT_FAILURE;
+    vtkNew<vtkMRMLModelStorageNode> modelStorageNode;
+    modelStorageNode->SetFileName(inputModelFileName.c_str());
+    vtkSmartPointer<vtkMRMLModelNode> modelNode = vtkSmartPointer<vtkMRMLModelNode>::New();
+    if (!modelStorageNode->ReadData(modelNode))
+      {
+      std::cerr << "Failed to read input model file " << inputModelFileName << std::endl;
+      return EXIT_FAILURE;
+      }
+    add->AddInputConnection(modelNode->GetPolyDataConnection());
+    inputModelNodes.push_back(modelNode);
     }
-
-  // add them together
-  vtkNew<vtkAppendPolyData> add;
-  add->AddInputConnection(model1Node->GetPolyDataConnection());
-  add->AddInputConnection(model2Node->GetPolyDataConnection());
   add->Update();
 
   vtkNew<vtkMRMLModelNode> outputModelNode;
@@ -62,6 +62,490 @@ Version:   $Revision$
 // VTKsys includes
 #include <vtksys/SystemTools.hxx>
 
+// STD includes
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+// models are saved in LPS coordinate system
+const char modelFileHeader[] = "3D Slicer output. SPACE=LPS";
+
+//----------------------------------------------------------------------------
+/// Parameters of the model generation that are the same for all the labels.
+struct ModelMakerSettings
+{
+  bool         JointSmoothing;
+  int          Smooth;
+  bool         SincFilter;
+  double       Decimate;
+  bool         SplitNormals;
+  bool         PointNormals;
+  bool         SaveIntermediateModels;
+  bool         Debug;
+  std::string  RootDir;
+  vtkMatrix4x4* IJKToLPSMatrix; // read only while models are made
+};
+
+//----------------------------------------------------------------------------
+/// Model made from one label.
+/// Input is a shallow copy of the padded image (or of the jointly smoothed
+/// surface), so that the filters of concurrent labels do not share a data object.
+struct LabelModel
+{
+  int                            Label{0};
+  std::string                    Name;
+  vtkSmartPointer<vtkDataObject> Input;
+  std::string                    FileName;
+  /// No polygon could be created from the label
+  bool                           Empty{false};
+  bool                           Failed{false};
+  /// Messages are buffered so that they are printed in label order
+  std::stringstream              Output;
+  std::stringstream              Errors;
+};
+
+//----------------------------------------------------------------------------
+/// Progress reporting of the filters of sequentially made models.
+struct FilterProgress
+{
+  ModuleProcessInformation* ProcessInformation;
+  float                     NumberOfFilterSteps;
+  float*                    CurrentFilterOffset;
+  bool                      Quiet;
+};
+
+//----------------------------------------------------------------------------
+std::unique_ptr<vtkPluginFilterWatcher> WatchFilter(vtkAlgorithm* filter, const std::string& comment,
+                                                    FilterProgress* progress)
+{
+  if (!progress)
+    {
+    return nullptr;
+    }
+  std::unique_ptr<vtkPluginFilterWatcher> watcher(new vtkPluginFilterWatcher(filter,
+    comment.c_str(),
+    progress->ProcessInformation,
+    1.0 / progress->NumberOfFilterSteps,
+    *progress->CurrentFilterOffset / progress->NumberOfFilterSteps));
+  *progress->CurrentFilterOffset += 1.0;
+  if (progress->Quiet)
+    {
+    watcher->QuietOn();
+    }
+  return watcher;
+}
+
+//----------------------------------------------------------------------------
+/// Report progress the same way as vtkPluginFilterWatcher.
+/// Must be called from the main thread.
+void ReportProgress(ModuleProcessInformation* processInformation, double progress, const std::string& comment)
+{
+  if (processInformation)
+    {
+    processInformation->Progress = progress;
+    strncpy(processInformation->ProgressMessage, comment.c_str(), 1023);
+    if (processInformation->ProgressCallbackFunction &&
+        processInformation->ProgressCallbackClientData)
+      {
+      (*(processInformation->ProgressCallbackFunction))(processInformation->ProgressCallbackClientData);
+      }
+    }
+  else
+    {
+    std::cout << "<filter-progress>" << progress << "</filter-progress>" << std::endl << std::flush;
+    }
+}
+
+//----------------------------------------------------------------------------
+bool WriteModel(vtkAlgorithm* source, const std::string& fileName, const std::string& comment,
+                FilterProgress* progress, bool legacyFileVersion = false)
+{
+  vtkNew<vtkPolyDataWriter> writer;
+  if (legacyFileVersion)
+    {
+    // version 5.1 is not compatible with earlier Slicer versions (VTK < 9) and most other software
+    writer->SetFileVersion(42);
+    }
+  std::unique_ptr<vtkPluginFilterWatcher> watchWriter = WatchFilter(writer, comment, progress);
+  writer->SetInputConnection(source->GetOutputPort());
+  writer->SetHeader(modelFileHeader);
+  writer->SetFileType(2);
+  writer->SetFileName(fileName.c_str());
+  bool success = (writer->Write() != 0);
+  writer->SetInputData(nullptr);
+  return success;
+}
+
+//----------------------------------------------------------------------------
+/// Make the model of one label and write it in the output directory.
+/// Different labels can be made concurrently: the filters are not shared and
+/// the messages are buffered in the label model.
+/// Filter progress is reported only if \a progress is not null.
+void MakeLabelModel(LabelModel& model, const ModelMakerSettings& settings, FilterProgress* progress)
+{
+  const int          i = model.Label;
+  const std::string& labelName = model.Name;
+  std::ostream&      out = model.Output;
+  std::ostream&      err = model.Errors;
+  std::unique_ptr<vtkPluginFilterWatcher> watchThreshold, watchCubes, watchDecimator,
+    watchReverser, watchSmoother, watchTransformer, watchNormals, watchStripper;
+
+  vtkSmartPointer<vtkImageThreshold>             imageThreshold;
+  vtkSmartPointer<vtkThreshold>                  threshold;
+  vtkSmartPointer<vtkImageToStructuredPoints>    imageToStructuredPoints;
+  vtkSmartPointer<vtkGeometryFilter>             geometryFilter;
+  vtkSmartPointer<vtkFlyingEdges3D>              mcubes;
+  vtkSmartPointer<vtkReverseSense>               reverser;
+  vtkSmartPointer<vtkWindowedSincPolyDataFilter> smootherSinc;
+  vtkSmartPointer<vtkSmoothPolyDataFilter>       smootherPoly;
+
+  // threshold
+  if (!settings.JointSmoothing)
+    {
+    imageThreshold = vtkSmartPointer<vtkImageThreshold>::New();
+    watchThreshold = WatchFilter(imageThreshold, "Threshold " + labelName, progress);
+    imageThreshold->SetInputData(model.Input);
+    imageThreshold->SetReplaceIn(1);
+    imageThreshold->SetReplaceOut(1);
+    imageThreshold->SetInValue(200);
+    imageThreshold->SetOutValue(0);
+
+    imageThreshold->ThresholdBetween(i, i);
+    imageThreshold->ReleaseDataFlagOn();
+
+    imageToStructuredPoints = vtkSmartPointer<vtkImageToStructuredPoints>::New();
+    imageToStructuredPoints->SetInputConnection(imageThreshold->GetOutputPort());
+    try
+      {
+      imageToStructuredPoints->Update();
+      }
+    catch(...)
+      {
+      err << "ERROR while updating image to structured points for label " << i << std::endl;
+      model.Failed = true;
+      return;
+      }
+    imageToStructuredPoints->ReleaseDataFlagOn();
+    }
+  else
+    {
+    // use the output of the smoother
+    threshold = vtkSmartPointer<vtkThreshold>::New();
+    watchThreshold = WatchFilter(threshold, "Threshold " + labelName, progress);
+    threshold->SetInputData(model.Input);
+    // In VTK 5.0, this is deprecated - the default behavior seems to
+    // be okay
+    // threshold->SetAttributeModeToUseCellData();
+
+    threshold->SetLowerThreshold(i);
+    threshold->SetUpperThreshold(i);
+    threshold->SetThresholdFunction(vtkThreshold::THRESHOLD_BETWEEN);
+    threshold->ReleaseDataFlagOn();
+
+    geometryFilter = vtkSmartPointer<vtkGeometryFilter>::New();
+    geometryFilter->SetInputConnection(threshold->GetOutputPort());
+    geometryFilter->ReleaseDataFlagOn();
+    }
+
+  // if not joint smoothing, may need to skip this label
+  if (!settings.JointSmoothing)
+    {
+    mcubes = vtkSmartPointer<vtkFlyingEdges3D>::New();
+    watchCubes = WatchFilter(mcubes, "Marching Cubes " + labelName, progress);
+    mcubes->SetInputConnection(imageToStructuredPoints->GetOutputPort());
+    mcubes->SetValue(0, 100.5);
+    mcubes->ComputeScalarsOff();
+    mcubes->ComputeGradientsOff();
+    mcubes->ComputeNormalsOff();
+    mcubes->ReleaseDataFlagOn();
+    try
+      {
+      mcubes->Update();
+      }
+    catch(...)
+      {
+      err << "ERROR while running marching cubes, for label " << i << std::endl;
+      model.Failed = true;
+      return;
+      }
+    if (settings.Debug)
+      {
+      out << "\n" << "Number of polygons = " << (mcubes->GetOutput())->GetNumberOfPolys() << endl;
+      }
+
+    if ((mcubes->GetOutput())->GetNumberOfPolys()  == 0)
+      {
+      out << "Cannot create a model from label " << i
+          << "\nNo polygons can be created,\nthere may be no voxels with this label in the volume." << endl;
+      out << "...continuing" << endl;
+      model.Empty = true;
+      return;
+      }
+    if (settings.SaveIntermediateModels)
+      {
+      std::string fileName;
+      if (settings.RootDir != "")
+        {
+        fileName = settings.RootDir + std::string("/") + labelName + std::string("-MarchingCubes.vtk");
+        }
+      else
+        {
+        fileName = labelName + std::string("-MarchingCubes.vtk");
+        }
+      if (settings.Debug)
+        {
+        out << "Writing intermediate file " << fileName.c_str() << std::endl;
+        }
+      if (!WriteModel(mcubes, fileName, "Writing intermediate model after marching cubes " + labelName,
+                      progress, true))
+        {
+        err << "ERROR: Failed to write intermediate file " << fileName.c_str() << std::endl;
+        }
+      }
+    }
+  else
+    {
+    out << "Skipping marching cubes..." << endl;
+    }
+
+  // In switch from vtk 4 to vtk 5, vtkDecimate was deprecated from the Patented dir, use vtkDecimatePro
+  // TODO: look at vtkQuadraticDecimation
+  vtkNew<vtkDecimatePro> decimator;
+  watchDecimator = WatchFilter(decimator, "Decimate " + labelName, progress);
+  if (!settings.JointSmoothing)
+    {
+    decimator->SetInputConnection(mcubes->GetOutputPort());
+    }
+  else
+    {
+    decimator->SetInputConnection(geometryFilter->GetOutputPort());
+    }
+  decimator->SetFeatureAngle(60);
+  // decimator->SetMaximumIterations(Decimate);
+  // decimator->SetMaximumSubIterations(0);
+
+  // decimator->PreserveEdgesOn();
+  decimator->SplittingOff();
+  decimator->PreserveTopologyOn();
+
+  decimator->SetMaximumError(1);
+  decimator->SetTargetReduction(settings.Decimate);
+  // decimator->SetInitialError(0.0002);
+  // decimator->SetErrorIncrement(0.002);
+  decimator->ReleaseDataFlagOff();
+
+  try
+    {
+    decimator->Update();
+    }
+  catch(...)
+    {
+    err << "ERROR decimating model " << i << std::endl;
+    model.Failed = true;
+    return;
+    }
+  if (settings.Debug)
+    {
+    out << "After decimation, number of polygons = " << (decimator->GetOutput())->GetNumberOfPolys() << endl;
+    }
+
+  if (settings.SaveIntermediateModels)
+    {
+    std::string fileName;
+    if (settings.RootDir != "")
+      {
+      fileName = settings.RootDir + std::string("/") + labelName + std::string("-Decimated.vtk");
+      }
+    else
+      {
+      fileName = labelName + std::string("-MarchingCubes.vtk");
+      }
+    if (settings.Debug)
+      {
+      out << "Writing intermediate file " << fileName.c_str() << std::endl;
+      }
+    if (!WriteModel(decimator, fileName, "Writing intermediate model after decimation " + labelName, progress))
+      {
+      err << "ERROR: Failed to write intermediate file " << fileName.c_str() << std::endl;
+      }
+    }
+
+  // the surface is the output of the reverser if the IJK to LPS transform flips the normals
+  vtkAlgorithm* surface = decimator;
+  if (settings.IJKToLPSMatrix->Determinant() < 0)
+    {
+    if (settings.Debug)
+      {
+      out << "Determinant " << settings.IJKToLPSMatrix->Determinant()
+          << " is less than zero, reversing..." << endl;
+      }
+    reverser = vtkSmartPointer<vtkReverseSense>::New();
+    watchReverser = WatchFilter(reverser, "Reverse " + labelName, progress);
+    reverser->SetInputConnection(decimator->GetOutputPort());
+    reverser->ReverseNormalsOn();
+    reverser->ReleaseDataFlagOn();
+    surface = reverser;
+    }
+
+  if (!settings.JointSmoothing)
+    {
+    if (settings.SincFilter)
+      {
+      smootherSinc = vtkSmartPointer<vtkWindowedSincPolyDataFilter>::New();
+      watchSmoother = WatchFilter(smootherSinc, "Smooth " + labelName, progress);
+      smootherSinc->SetPassBand(0.1);
+      smootherSinc->SetInputConnection(surface->GetOutputPort());
+      smootherSinc->SetNumberOfIterations(settings.Smooth);
+      smootherSinc->FeatureEdgeSmoothingOff();
+      smootherSinc->BoundarySmoothingOff();
+      smootherSinc->ReleaseDataFlagOn();
+      try
+        {
+        smootherSinc->Update();
+        }
+      catch(...)
+        {
+        err << "ERROR updating Sinc smoother for model " << i << std::endl;
+        model.Failed = true;
+        return;
+        }
+      surface = smootherSinc;
+      }
+    else
+      {
+      smootherPoly = vtkSmartPointer<vtkSmoothPolyDataFilter>::New();
+      watchSmoother = WatchFilter(smootherPoly, "Smooth " + labelName, progress);
+
+      // this next line massively rounds corners
+      smootherPoly->SetRelaxationFactor(0.33);
+      smootherPoly->SetFeatureAngle(60);
+      smootherPoly->SetConvergence(0);
+
+      smootherPoly->SetInputConnection(surface->GetOutputPort());
+      smootherPoly->SetNumberOfIterations(settings.Smooth);
+      smootherPoly->FeatureEdgeSmoothingOff();
+      smootherPoly->BoundarySmoothingOff();
+      smootherPoly->ReleaseDataFlagOn();
+      try
+        {
+        smootherPoly->Update();
+        }
+      catch(...)
+        {
+        err << "ERROR updating Poly smoother for model " << i << std::endl;
+        model.Failed = true;
+        return;
+        }
+      surface = smootherPoly;
+      }
+
+    if (settings.SaveIntermediateModels)
+      {
+      std::string fileName;
+      if (settings.RootDir != "")
+        {
+        fileName = settings.RootDir + std::string("/") + labelName + std::string("-Smoothed.vtk");
+        }
+      else
+        {
+        fileName = labelName + std::string("-Smoothed.vtk");
+        }
+      if (settings.Debug)
+        {
+        out << "Writing intermediate file " << fileName.c_str() << std::endl;
+        }
+      if (!WriteModel(surface, fileName, "Writing intermediate model after smoothing " + labelName, progress))
+        {
+        err << "ERROR: Failed to write intermediate file " << fileName.c_str() << std::endl;
+        }
+      }
+    }
+
+  // each label has its own transform, vtkTransform updates itself lazily
+  vtkNew<vtkTransform> transformIJKtoLPS;
+  transformIJKtoLPS->SetMatrix(settings.IJKToLPSMatrix);
+
+  vtkNew<vtkTransformPolyDataFilter> transformer;
+  watchTransformer = WatchFilter(transformer, "Transform " + labelName, progress);
+  transformer->SetInputConnection(surface->GetOutputPort());
+  transformer->SetTransform(transformIJKtoLPS);
+  transformer->ReleaseDataFlagOn();
+
+  vtkNew<vtkPolyDataNormals> normals;
+  watchNormals = WatchFilter(normals, "Normals " + labelName, progress);
+  if (settings.PointNormals)
+    {
+    normals->ComputePointNormalsOn();
+    }
+  else
+    {
+    normals->ComputePointNormalsOff();
+    }
+  normals->SetInputConnection(transformer->GetOutputPort());
+  normals->SetFeatureAngle(60);
+  normals->SetSplitting(settings.SplitNormals);
+
+  normals->ReleaseDataFlagOn();
+
+  vtkNew<vtkStripper> stripper;
+  watchStripper = WatchFilter(stripper, "Strip " + labelName, progress);
+  stripper->SetInputConnection(normals->GetOutputPort());
+  stripper->ReleaseDataFlagOff();
+
+  // the poly data output from the stripper can be set as an input to a
+  // model's polydata
+  try
+    {
+    stripper->Update();
+    }
+  catch(...)
+    {
+    err << "ERROR updating stripper for model " << i << std::endl;
+    model.Failed = true;
+    return;
+    }
+
+  // but for now we're just going to write it out
+  if (settings.RootDir != "")
+    {
+    model.FileName = settings.RootDir + std::string("/") + labelName + std::string(".vtk");
+    }
+  else
+    {
+    out << "WARNING: output directory is an empty string..." << endl;
+    model.FileName = labelName + std::string(".vtk");
+    }
+  if (settings.Debug)
+    {
+    out << "Writing model " << " " << labelName << " to file " << model.FileName << endl;
+    }
+  if (!WriteModel(stripper, model.FileName, "Write " + labelName, progress))
+    {
+    err << "ERROR: Failed to write model file " << model.FileName.c_str() << std::endl;
+    }
+}
+
+//----------------------------------------------------------------------------
+void PrintMessages(LabelModel& model)
+{
+  std::cout << model.Output.str();
+  std::cerr << model.Errors.str();
+  model.Output.str("");
+  model.Errors.str("");
+}
+
+} // end of anonymous namespace
+
+
 int main(int argc, char * argv[])
 {
   PARSE_ARGS;
@@ -86,6 +570,7 @@ int main(int argc, char * argv[])
     std::cout << "Split normals? " << SplitNormals << std::endl;
     std::cout << "Calculate point normals? " << PointNormals << std::endl;
     std::cout << "Pad? " << Pad << std::endl;
+    std::cout << "Number of threads: " << NumberOfThreads << std::endl;
     std::cout << "Filter type: " << FilterType << std::endl;
     std::cout << "Input color hierarchy scene file: "
               << (ModelHierarchyFile.size() > 0 ? ModelHierarchyFile.c_str() : "None")  << std::endl;
@@ -279,25 +764,9 @@ int main(int argc, char * argv[])
   vtkSmartPointer<vtkImageAccumulate>               hist;
   std::vector<int>                                  skippedModels;
   std::vector<int>                                  madeModels;
-  vtkSmartPointer<vtkWindowedSincPolyDataFilter>    smootherSinc;
-  vtkSmartPointer<vtkSmoothPolyDataFilter>          smootherPoly;
 
   vtkSmartPointer<vtkImageConstantPad>        padder;
-  vtkSmartPointer<vtkDecimatePro>             decimator;
-
-  vtkSmartPointer<vtkFlyingEdges3D>           mcubes;
-  vtkSmartPointer<vtkImageThreshold>          imageThreshold;
-  vtkSmartPointer<vtkThreshold>               threshold;
-  vtkSmartPointer<vtkImageToStructuredPoints> imageToStructuredPoints;
-  vtkSmartPointer<vtkGeometryFilter>          geometryFilter;
   vtkSmartPointer<vtkTransform>               transformIJKtoLPS;
-  vtkSmartPointer<vtkReverseSense>            reverser;
-  vtkSmartPointer<vtkTransformPolyDataFilter> transformer;
-  vtkSmartPointer<vtkPolyDataNormals>         normals;
-  vtkSmartPointer<vtkStripper>                stripper;
-  vtkSmartPointer<vtkPolyDataWriter>          writer;
-
-  const char modelFileHeader[] = "3D Slicer output. SPACE=LPS"; // models are saved in LPS coordinate system
 
   // keep track of number of models that will be generated, for filter
   // watcher reporting
@@ -871,6 +1340,10 @@ int main(int argc, char * argv[])
       loopLabels.push_back(Labels[i]);
       }
     }
+  // name the models first, the labels that are not skipped are then made
+  // concurrently and added to the scene in label order
+  std::vector<LabelModel> models;
+  models.reserve(loopLabels.size());
   for(::size_t l = 0; l < loopLabels.size(); l++)
     {
     // get the label out of the vector
@@ -963,771 +1436,270 @@ int main(int argc, char * argv[])
       {
       // just make one
       labelName = Name;
-      /*
-      if (colorNode != nullptr)
+      }
+
+    models.emplace_back();
+    models.back().Label = i;
+    models.back().Name = labelName;
+    }   // end of loop over labels
+
+  // all the labels share the same input, it is updated once and read only
+  // while the models are made
+  vtkSmartPointer<vtkDataObject> labelInput;
+  if (JointSmoothing)
+    {
+    // use the output of the smoother
+    if (smoother == nullptr && !models.empty())
+      {
+      std::cerr << "\nERROR smoothing filter is null for joint smoothing!" << std::endl;
+      return EXIT_FAILURE;
+      }
+    labelInput = (smoother ? smoother->GetOutput() : nullptr);
+    }
+  else if (Pad)
+    {
+    try
+      {
+      padder->Update();
+      }
+    catch(...)
+      {
+      std::cerr << "ERROR while padding the input volume" << std::endl;
+      return EXIT_FAILURE;
+      }
+    labelInput = padder->GetOutput();
+    }
+  else
+    {
+    labelInput = image;
+    }
+  for (LabelModel& model : models)
+    {
+    model.Input = vtkSmartPointer<vtkDataObject>::Take(labelInput->NewInstance());
+    model.Input->ShallowCopy(labelInput);
+    }
+
+  if (JointSmoothing == 0 && strcmp(FilterType.c_str(), "Sinc") == 0 && Smooth == 1)
+    {
+    std::cerr << "Warning: Smoothing iterations of 1 not allowed for Sinc filter, using 2" << endl;
+    Smooth = 2;
+    }
+  transformIJKtoLPS->Update();
+  ModelMakerSettings settings;
+  settings.JointSmoothing = (JointSmoothing != 0);
+  settings.Smooth = Smooth;
+  settings.SincFilter = (strcmp(FilterType.c_str(), "Sinc") == 0);
+  settings.Decimate = Decimate;
+  settings.SplitNormals = SplitNormals;
+  settings.PointNormals = PointNormals;
+  settings.SaveIntermediateModels = SaveIntermediateModels;
+  settings.Debug = debug;
+  settings.RootDir = rootDir;
+  settings.IJKToLPSMatrix = transformIJKtoLPS->GetMatrix();
+
+  unsigned int numberOfThreads = NumberOfThreads > 0 ?
+    static_cast<unsigned int>(NumberOfThreads) : std::thread::hardware_concurrency();
+  numberOfThreads = std::max(1u, std::min(numberOfThreads, static_cast<unsigned int>(models.size())));
+  if (debug)
+    {
+    std::cout << "Making " << models.size() << " models with " << numberOfThreads << " threads" << std::endl;
+    }
+  if (numberOfThreads == 1)
+    {
+    FilterProgress progress = { CLPProcessInformation, numFilterSteps, &currentFilterOffset, debug };
+    for (LabelModel& model : models)
+      {
+      MakeLabelModel(model, settings, &progress);
+      PrintMessages(model);
+      if (model.Failed)
         {
-        if (colorNode->GetColorNameAsFileName(i).c_str() != nullptr)
+        return EXIT_FAILURE;
+        }
+      }
+    }
+  else
+    {
+    // filter watchers are not thread safe, the main thread reports the
+    // progress of the models as they are completed
+    std::atomic<::size_t> nextModel(0);
+    std::atomic<bool>     aborted(false);
+    std::mutex            completedMutex;
+    std::condition_variable modelCompleted;
+    ::size_t              numberOfCompletedModels = 0;
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < numberOfThreads; ++t)
+      {
+      threads.emplace_back([&]()
+        {
+        for (::size_t m = nextModel++; m < models.size() && !aborted; m = nextModel++)
           {
-          std::stringstream    stream;
-          stream <<    i;
-          std::string stringI =    stream.str();
-          labelName = Name + std::string("_") + stringI + std::string("_") + std::string(colorNode->GetColorNameAsFileName(i));
+          MakeLabelModel(models[m], settings, nullptr);
+          if (models[m].Failed)
+            {
+            aborted = true;
+            }
+          std::lock_guard<std::mutex> lock(completedMutex);
+          ++numberOfCompletedModels;
+          modelCompleted.notify_one();
           }
-        }
-      else
+        });
+      }
+    float startFilterOffset = currentFilterOffset;
+    ::size_t numberOfReportedModels = 0;
+    std::unique_lock<std::mutex> lock(completedMutex);
+    while (numberOfReportedModels < models.size() && !aborted)
+      {
+      modelCompleted.wait(lock, [&]() { return numberOfCompletedModels > numberOfReportedModels || aborted; });
+      numberOfReportedModels = numberOfCompletedModels;
+      lock.unlock();
+      currentFilterOffset = startFilterOffset
+        + (numFilterSteps - startFilterOffset) * numberOfReportedModels / models.size();
+      std::stringstream comment;
+      comment << "Made " << numberOfReportedModels << " of " << models.size() << " models";
+      ReportProgress(CLPProcessInformation, currentFilterOffset / numFilterSteps, comment.str());
+      if (CLPProcessInformation && CLPProcessInformation->Abort)
         {
-        labelName = Name;
+        aborted = true;
         }
-      */
+      lock.lock();
+      }
+    lock.unlock();
+    for (std::thread& thread : threads)
+      {
+      thread.join();
+      }
+    bool failed = false;
+    for (LabelModel& model : models)
+      {
+      PrintMessages(model);
+      failed = failed || model.Failed;
+      }
+    if (failed)
+      {
+      return EXIT_FAILURE;
       }
+    }
 
-    // threshold
-    if (JointSmoothing == 0)
+  for (LabelModel& model : models)
+    {
+    int i = model.Label;
+    labelName = model.Name;
+    if (model.Empty || model.FileName.empty())
+      {
+      // aborted or no polygons
+      continue;
+      }
+    std::string fileName = model.FileName;
+    if (modelScene.GetPointer() != nullptr)
       {
-      if (imageThreshold)
-        {
-        imageThreshold->SetInputData(nullptr);
-        imageThreshold->RemoveAllInputs();
-        imageThreshold = nullptr;
-        }
-      imageThreshold = vtkSmartPointer<vtkImageThreshold>::New();
-      std::string            comment3 = "Threshold " + labelName;
-      vtkPluginFilterWatcher watchImageThreshold(imageThreshold,
-                                                 comment3.c_str(),
-                                                 CLPProcessInformation,
-                                                 1.0 / numFilterSteps,
-                                                 currentFilterOffset / numFilterSteps);
-      currentFilterOffset += 1.0;
       if (debug)
         {
-        watchImageThreshold.QuietOn();
+        std::cout << "Adding model " << labelName << " to the output scene, with filename " << fileName.c_str()
+                  << endl;
         }
-      if (Pad)
+      // each model needs a mrml node, a storage node and a display node
+      vtkNew<vtkMRMLModelNode> mnode;
+      mnode->SetScene(modelScene.GetPointer());
+      mnode->SetName(labelName.c_str());
+
+      vtkNew<vtkMRMLModelStorageNode> snode;
+      snode->SetFileName(fileName.c_str());
+      if (modelScene->AddNode(snode.GetPointer()) == nullptr)
         {
-        imageThreshold->SetInputConnection(padder->GetOutputPort());
+        std::cerr << "ERROR: unable to add the storage node to the model scene" << endl;
         }
-      else
+      vtkNew<vtkMRMLModelDisplayNode> dnode;
+      dnode->SetColor(0.5, 0.5, 0.5);
+      double *rgba;
+      if (colorNode != nullptr)
         {
-        imageThreshold->SetInputData(image);
+        rgba = colorNode->GetLookupTable()->GetTableValue(i);
+        if (rgba != nullptr)
+          {
+          if (debug)
+            {
+            std::cout << "Got color: " << rgba[0] << " " << rgba[1] << " " << rgba[2] << " " << rgba[3] << endl;
+            }
+          dnode->SetColor(rgba[0], rgba[1], rgba[2]);
+          }
+        else
+          {
+          std::cerr << "Couldn't get look up table value for " << i << ", display node color is not set (grey)"
+                    << endl;
+          }
         }
-      imageThreshold->SetReplaceIn(1);
-      imageThreshold->SetReplaceOut(1);
-      imageThreshold->SetInValue(200);
-      imageThreshold->SetOutValue(0);
 
-      imageThreshold->ThresholdBetween(i, i);
-      imageThreshold->ReleaseDataFlagOn();
-
-      if (imageToStructuredPoints)
+      dnode->SetVisibility(1);
+      modelScene->AddNode(dnode.GetPointer());
+      if (debug)
         {
-        imageToStructuredPoints->SetInputData(nullptr);
-        imageToStructuredPoints = nullptr;
+        std::cout << "Added display node: id = " << (dnode->GetID() == nullptr ? "(null)" : dnode->GetID()) << endl;
+        std::cout << "Setting model's storage node: id = "
+                  << (snode->GetID() == nullptr ? "(null)" : snode->GetID()) << endl;
         }
-      imageToStructuredPoints = vtkSmartPointer<vtkImageToStructuredPoints>::New();
-      imageToStructuredPoints->SetInputConnection(imageThreshold->GetOutputPort());
-      try
+      mnode->SetAndObserveStorageNodeID(snode->GetID());
+      mnode->SetAndObserveDisplayNodeID(dnode->GetID());
+      modelScene->AddNode(mnode.GetPointer());
+
+      // put it in the hierarchy, either the flat one by default or
+      // try to find the matching color hierarchy node to make this an
+      // associated node
+      std::string colorName;
+      if (colorNode != nullptr)
         {
-        imageToStructuredPoints->Update();
+        colorName = std::string(colorNode->GetColorNameAsFileName(i));
         }
-      catch(...)
+      else
         {
-        std::cerr << "ERROR while updating image to structured points for label " << i << std::endl;
-        return EXIT_FAILURE;
+        // might be in a testing case where the hierarchy nodes are
+        // numbered (made from the generic colors)
+        std::stringstream ss;
+        ss << i;
+        colorName = ss.str();
+        if (debug)
+          {
+          std::cout << "No color node, guessing at color name being same as label number " << colorName.c_str() << std::endl;
+          }
         }
-      imageToStructuredPoints->ReleaseDataFlagOn();
-      }
-    else
-      {
-      // use the output of the smoother
-      if (threshold)
+      vtkMRMLNode *mrmlNode = nullptr;
+      if (colorName.compare("") != 0)
         {
-        threshold->SetInputData(nullptr);
-        threshold = nullptr;
+        mrmlNode = modelScene->GetFirstNodeByName(colorName.c_str());
         }
-      threshold = vtkSmartPointer<vtkThreshold>::New();
-      std::string            comment4 = "Threshold " + labelName;
-      vtkPluginFilterWatcher watchThreshold(threshold,
-                                            comment4.c_str(),
-                                            CLPProcessInformation,
-                                            1.0 / numFilterSteps,
-                                            currentFilterOffset / numFilterSteps);
-      currentFilterOffset += 1.0;
-      if (debug)
+      // if there's no color hierarchy, or no color name or the mrml node
+      // named for the color isn't a model hierarchy node, use a flat hierarchy
+      if (topColorHierarchyNode == nullptr ||
+          colorName.compare("") == 0 ||
+          mrmlNode == nullptr ||
+          strcmp(mrmlNode->GetClassName(),"vtkMRMLModelHierarchyNode") != 0)
         {
-        watchThreshold.QuietOn();
-        }
-      if (smoother == nullptr)
-        {
-        std::cerr << "\nERROR smoothing filter is null for joint smoothing!" << std::endl;
-        return EXIT_FAILURE;
-        }
-      threshold->SetInputConnection(smoother->GetOutputPort());
-      // In VTK 5.0, this is deprecated - the default behavior seems to
-      // be okay
-      // threshold->SetAttributeModeToUseCellData();
-
-      threshold->SetLowerThreshold(i);
-      threshold->SetUpperThreshold(i);
-      threshold->SetThresholdFunction(vtkThreshold::THRESHOLD_BETWEEN);
-      threshold->ReleaseDataFlagOn();
-
-      if (geometryFilter)
-        {
-        geometryFilter->SetInputData(nullptr);
-        geometryFilter = nullptr;
-        }
-      geometryFilter = vtkSmartPointer<vtkGeometryFilter>::New();
-      geometryFilter->SetInputConnection(threshold->GetOutputPort());
-      geometryFilter->ReleaseDataFlagOn();
-      }
-
-    // if not joint smoothing, may need to skip this label
-    int skipLabel = 0;
-    if (JointSmoothing == 0)
-      {
-      if (mcubes)
-        {
-        mcubes->SetInputData(nullptr);
-        mcubes = nullptr;
-        }
-      mcubes = vtkSmartPointer<vtkFlyingEdges3D>::New();
-      std::string            comment5 = "Marching Cubes " + labelName;
-      vtkPluginFilterWatcher watchThreshold(mcubes,
-                                            comment5.c_str(),
-                                            CLPProcessInformation,
-                                            1.0 / numFilterSteps,
-                                            currentFilterOffset / numFilterSteps);
-      currentFilterOffset += 1.0;
-      if (debug)
-        {
-        watchThreshold.QuietOn();
-        }
-      mcubes->SetInputConnection(imageToStructuredPoints->GetOutputPort());
-      mcubes->SetValue(0, 100.5);
-      mcubes->ComputeScalarsOff();
-      mcubes->ComputeGradientsOff();
-      mcubes->ComputeNormalsOff();
-      mcubes->ReleaseDataFlagOn();
-      try
-        {
-        mcubes->Update();
-        }
-      catch(...)
-        {
-        std::cerr << "ERROR while running marching cubes, for label " << i << std::endl;
-        return EXIT_FAILURE;
-        }
-      if (debug)
-        {
-        std::cout << "\n" << "Number of polygons = " << (mcubes->GetOutput())->GetNumberOfPolys() << endl;
-        }
-
-      if ((mcubes->GetOutput())->GetNumberOfPolys()  == 0)
-        {
-        std::cout << "Cannot create a model from label " << i
-                  << "\nNo polygons can be created,\nthere may be no voxels with this label in the volume." << endl;
-        if (transformIJKtoLPS)
-          {
-          transformIJKtoLPS = nullptr;
-          }
-        if (imageThreshold)
-          {
-          if (debug)
-            {
-            std::cout << "Setting image threshold input to null" << endl;
-            }
-          imageThreshold->SetInputData(nullptr);
-          imageThreshold->RemoveAllInputs();
-          imageThreshold = nullptr;
-
-          }
-        if (imageToStructuredPoints)
-          {
-          imageToStructuredPoints->SetInputData(nullptr);
-          imageToStructuredPoints = nullptr;
-          }
-        if (mcubes)
-          {
-          mcubes->SetInputData(nullptr);
-          mcubes = nullptr;
-          }
-        skipLabel = 1;
-        std::cout << "...continuing" << endl;
-        continue;
-        }
-      if (SaveIntermediateModels)
-        {
-        writer = vtkSmartPointer<vtkPolyDataWriter>::New();
-        // version 5.1 is not compatible with earlier Slicer versions (VTK < 9) and most other software
-        writer->SetFileVersion(42);
-        std::string            commentSaveCubes = "Writing intermediate model after marching cubes " + labelName;
-        vtkPluginFilterWatcher watchWriter(writer,
-                                           commentSaveCubes.c_str(),
-                                           CLPProcessInformation,
-                                           1.0 / numFilterSteps,
-                                           currentFilterOffset / numFilterSteps);
-        currentFilterOffset += 1.0;
-        writer->SetInputConnection(cubes->GetOutputPort());
-        writer->SetHeader(modelFileHeader);
-        writer->SetFileType(2);
-        std::string fileName;
-        if (rootDir != "")
-          {
-          fileName = rootDir + std::string("/") + labelName + std::string("-MarchingCubes.vtk");
-          }
-        else
-          {
-          fileName = labelName + std::string("-MarchingCubes.vtk");
-          }
-        if (debug)
-          {
-          watchWriter.QuietOn();
-          std::cout << "Writing intermediate file " << fileName.c_str() << std::endl;
-          }
-        writer->SetFileName(fileName.c_str());
-        if (!writer->Write())
-          {
-          std::cerr << "ERROR: Failed to write intermediate file " << fileName.c_str() << std::endl;
-          }
-        writer->SetInputData(nullptr);
-        writer = nullptr;
-        }
-      }
-    else
-      {
-      std::cout << "Skipping marching cubes..." << endl;
-      }
-    if (!skipLabel)
-      {
-      // In switch from vtk 4 to vtk 5, vtkDecimate was deprecated from the Patented dir, use vtkDecimatePro
-      // TODO: look at vtkQuadraticDecimation
-      if (decimator != nullptr)
-        {
-        decimator->SetInputData(nullptr);
-        decimator = nullptr;
-        }
-      decimator = vtkSmartPointer<vtkDecimatePro>::New();
-      std::string            comment6 = "Decimate " + labelName;
-      vtkPluginFilterWatcher watchImageThreshold(decimator,
-                                                 comment6.c_str(),
-                                                 CLPProcessInformation,
-                                                 1.0 / numFilterSteps,
-                                                 currentFilterOffset / numFilterSteps);
-      currentFilterOffset += 1.0;
-      if (debug)
-        {
-        watchImageThreshold.QuietOn();
-        }
-      if (JointSmoothing == 0)
-        {
-        decimator->SetInputConnection(mcubes->GetOutputPort());
+        vtkNew<vtkMRMLModelHierarchyNode> mhnd;
+        mhnd->SetHideFromEditors(1);
+        modelScene->AddNode(mhnd.GetPointer());
+        mhnd->SetParentNodeID(rnd->GetID());
+        mhnd->SetModelNodeID(mnode->GetID());
         }
       else
         {
-        decimator->SetInputConnection(geometryFilter->GetOutputPort());
-        }
-      decimator->SetFeatureAngle(60);
-      // decimator->SetMaximumIterations(Decimate);
-      // decimator->SetMaximumSubIterations(0);
-
-      // decimator->PreserveEdgesOn();
-      decimator->SplittingOff();
-      decimator->PreserveTopologyOn();
-
-      decimator->SetMaximumError(1);
-      decimator->SetTargetReduction(Decimate);
-      // decimator->SetInitialError(0.0002);
-      // decimator->SetErrorIncrement(0.002);
-      decimator->ReleaseDataFlagOff();
-
-      try
-        {
-        decimator->Update();
-        }
-      catch(...)
-        {
-        std::cerr << "ERROR decimating model " << i << std::endl;
-        return EXIT_FAILURE;
-        }
-      if (debug)
-        {
-        std::cout << "After decimation, number of polygons = " << (decimator->GetOutput())->GetNumberOfPolys() << endl;
-        }
-
-      if (SaveIntermediateModels)
-        {
-        writer = vtkSmartPointer<vtkPolyDataWriter>::New();
-        std::string            commentSaveDecimation = "Writing intermediate model after decimation " + labelName;
-        vtkPluginFilterWatcher watchWriter(writer,
-                                           commentSaveDecimation.c_str(),
-                                           CLPProcessInformation,
-                                           1.0 / numFilterSteps,
-                                           currentFilterOffset / numFilterSteps);
-        currentFilterOffset += 1.0;
-        writer->SetInputConnection(decimator->GetOutputPort());
-        writer->SetHeader(modelFileHeader);
-        writer->SetFileType(2);
-        std::string fileName;
-        if (rootDir != "")
-          {
-          fileName = rootDir + std::string("/") + labelName + std::string("-Decimated.vtk");
-          }
-        else
-          {
-          fileName = labelName + std::string("-MarchingCubes.vtk");
-          }
-        if (debug)
-          {
-          watchWriter.QuietOn();
-          std::cout << "Writing intermediate file " << fileName.c_str() << std::endl;
-          }
-        writer->SetFileName(fileName.c_str());
-        if (!writer->Write())
-          {
-          std::cerr << "ERROR: Failed to write intermediate file " << fileName.c_str() << std::endl;
-          }
-        writer->SetInputData(nullptr);
-        writer = nullptr;
-        }
-      if (transformIJKtoLPS == nullptr ||
-          transformIJKtoLPS->GetMatrix() == nullptr)
-        {
-        std::cout << "transformIJKtoLPS is "
-                  << (transformIJKtoLPS ==
-            nullptr ? "null" : "okay") << ", it's matrix is "
-                  << (transformIJKtoLPS->GetMatrix() == nullptr ? "null" : "okay") << endl;
-        }
-      else if ((transformIJKtoLPS->GetMatrix())->Determinant() < 0)
-        {
-        if (debug)
-          {
-          std::cout << "Determinant " << (transformIJKtoLPS->GetMatrix())->Determinant()
-                    << " is less than zero, reversing..." << endl;
-          }
-        if (reverser)
-          {
-          reverser->SetInputData(nullptr);
-          reverser = nullptr;
-          }
-        reverser = vtkSmartPointer<vtkReverseSense>::New();
-        std::string            comment7 = "Reverse " + labelName;
-        vtkPluginFilterWatcher watchReverser(reverser,
-                                             comment7.c_str(),
-                                             CLPProcessInformation,
-                                             1.0 / numFilterSteps,
-                                             currentFilterOffset / numFilterSteps);
-        currentFilterOffset += 1.0;
-        if (debug)
+        // use the template color hierarchy
+        vtkMRMLModelHierarchyNode *colorHierarchyNode = vtkMRMLModelHierarchyNode::SafeDownCast(mrmlNode);
+        if (colorHierarchyNode)
           {
-          watchReverser.QuietOn();
-          }
-        reverser->SetInputConnection(decimator->GetOutputPort());
-        reverser->ReverseNormalsOn();
-        reverser->ReleaseDataFlagOn();
-        }
-
-      if (JointSmoothing == 0)
-        {
-        if (strcmp(FilterType.c_str(), "Sinc") == 0)
-          {
-
-          if (smootherSinc)
-            {
-            smootherSinc->SetInputData(nullptr);
-            smootherSinc = nullptr;
-            }
-          smootherSinc = vtkSmartPointer<vtkWindowedSincPolyDataFilter>::New();
-          std::string            comment8 = "Smooth " + labelName;
-          vtkPluginFilterWatcher watchSmoother(smootherSinc,
-                                               comment8.c_str(),
-                                               CLPProcessInformation,
-                                               1.0 / numFilterSteps,
-                                               currentFilterOffset / numFilterSteps);
-          currentFilterOffset += 1.0;
+          colorHierarchyNode->SetAssociatedNodeID(mnode->GetID());
+          // and hide it so that it doesn't clutter up the tree
+          colorHierarchyNode->SetHideFromEditors(1);
           if (debug)
             {
-            watchSmoother.QuietOn();
-            }
-          smootherSinc->SetPassBand(0.1);
-          if (Smooth == 1)
-            {
-            std::cerr << "Warning: Smoothing iterations of 1 not allowed for Sinc filter, using 2" << endl;
-            Smooth = 2;
-            }
-          if ((transformIJKtoLPS->GetMatrix())->Determinant() < 0)
-            {
-            smootherSinc->SetInputConnection(reverser->GetOutputPort());
-            }
-          else
-            {
-            smootherSinc->SetInputConnection(decimator->GetOutputPort());
+            std::cout << "Found a color hierarchy node with name " << colorHierarchyNode->GetName() << ", set it's associated node to this model id: " << mnode->GetID() << std::endl;
             }
-          smootherSinc->SetNumberOfIterations(Smooth);
-          smootherSinc->FeatureEdgeSmoothingOff();
-          smootherSinc->BoundarySmoothingOff();
-          smootherSinc->ReleaseDataFlagOn();
-          try
-            {
-            smootherSinc->Update();
-            }
-          catch(...)
-            {
-            std::cerr << "ERROR updating Sinc smoother for model " << i << std::endl;
-            return EXIT_FAILURE;
-            }
-          }
-        else
-          {
-          if (smootherPoly)
-            {
-            smootherPoly->SetInputData(nullptr);
-            smootherPoly = nullptr;
-            }
-          smootherPoly = vtkSmartPointer<vtkSmoothPolyDataFilter>::New();
-          std::string            comment9 = "Smooth " + labelName;
-          vtkPluginFilterWatcher watchSmoother(smootherPoly,
-                                               comment9.c_str(),
-                                               CLPProcessInformation,
-                                               1.0 / numFilterSteps,
-                                               currentFilterOffset / numFilterSteps);
-          currentFilterOffset += 1.0;
-          if (debug)
-            {
-            watchSmoother.QuietOn();
-            }
-
-          // this next line massively rounds corners
-          smootherPoly->SetRelaxationFactor(0.33);
-          smootherPoly->SetFeatureAngle(60);
-          smootherPoly->SetConvergence(0);
-
-          if ((transformIJKtoLPS->GetMatrix())->Determinant() < 0)
-            {
-            smootherPoly->SetInputConnection(reverser->GetOutputPort());
-            }
-          else
-            {
-            smootherPoly->SetInputConnection(decimator->GetOutputPort());
-            }
-          smootherPoly->SetNumberOfIterations(Smooth);
-          smootherPoly->FeatureEdgeSmoothingOff();
-          smootherPoly->BoundarySmoothingOff();
-          smootherPoly->ReleaseDataFlagOn();
-          try
-            {
-            smootherPoly->Update();
-            }
-          catch(...)
-            {
-            std::cerr << "ERROR updating Poly smoother for model " << i << std::endl;
-            return EXIT_FAILURE;
-            }
-          }
-
-        if (SaveIntermediateModels)
-          {
-          writer = vtkSmartPointer<vtkPolyDataWriter>::New();
-          std::string            commentSaveSmoothed = "Writing intermediate model after smoothing " + labelName;
-          vtkPluginFilterWatcher watchWriter(writer,
-                                             commentSaveSmoothed.c_str(),
-                                             CLPProcessInformation,
-                                             1.0 / numFilterSteps,
-                                             currentFilterOffset / numFilterSteps);
-          currentFilterOffset += 1.0;
-          if (strcmp(FilterType.c_str(), "Sinc") == 0)
-            {
-            writer->SetInputConnection(smootherSinc->GetOutputPort());
-            }
-          else
-            {
-            writer->SetInputConnection(smootherPoly->GetOutputPort());
-            }
-          writer->SetHeader(modelFileHeader);
-          writer->SetFileType(2);
-          std::string fileName;
-          if (rootDir != "")
-            {
-            fileName = rootDir + std::string("/") + labelName + std::string("-Smoothed.vtk");
-            }
-          else
-            {
-            fileName = labelName + std::string("-Smoothed.vtk");
-            }
-          if (debug)
-            {
-            watchWriter.QuietOn();
-            std::cout << "Writing intermediate file " << fileName.c_str() << std::endl;
-            }
-          writer->SetFileName(fileName.c_str());
-          if (!writer->Write())
-            {
-            std::cerr << "ERROR: Failed to write intermediate file " << fileName.c_str() << std::endl;
-            }
-          writer->SetInputData(nullptr);
-          writer = nullptr;
-          }
-        }
-
-      if (transformer)
-        {
-        transformer->SetInputData(nullptr);
-        transformer = nullptr;
-        }
-      transformer = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
-      std::string            comment1 = "Transform " + labelName;
-      vtkPluginFilterWatcher watchTransformer(transformer,
-                                              comment1.c_str(),
-                                              CLPProcessInformation,
-                                              1.0 / numFilterSteps,
-                                              currentFilterOffset / numFilterSteps);
-      currentFilterOffset += 1.0;
-      if (debug)
-        {
-        watchTransformer.QuietOn();
-        }
-      if (JointSmoothing == 0)
-        {
-        if (strcmp(FilterType.c_str(), "Sinc") == 0)
-          {
-          transformer->SetInputConnection(smootherSinc->GetOutputPort());
-          }
-        else
-          {
-          transformer->SetInputConnection(smootherPoly->GetOutputPort());
-          }
-        }
-      else
-        {
-        if ((transformIJKtoLPS->GetMatrix())->Determinant() < 0)
-          {
-          transformer->SetInputConnection(reverser->GetOutputPort());
-          }
-        else
-          {
-          transformer->SetInputConnection(decimator->GetOutputPort());
           }
         }
-
-      transformer->SetTransform(transformIJKtoLPS);
-      if (debug)
-        {
-        // transformIJKtoLPS->GetMatrix()->Print(std::cout);
-        }
-
-      transformer->ReleaseDataFlagOn();
-      if (normals)
-        {
-        normals->SetInputData(nullptr);
-        normals = nullptr;
-        }
-      normals = vtkSmartPointer<vtkPolyDataNormals>::New();
-      std::string            comment2 = "Normals " + labelName;
-      vtkPluginFilterWatcher watchNormals(normals,
-                                          comment2.c_str(),
-                                          CLPProcessInformation,
-                                          1.0 / numFilterSteps,
-                                          currentFilterOffset / numFilterSteps);
-      currentFilterOffset += 1.0;
-      if (debug)
-        {
-        watchNormals.QuietOn();
-        }
-
-      if (PointNormals)
-        {
-        normals->ComputePointNormalsOn();
-        }
-      else
-        {
-        normals->ComputePointNormalsOff();
-        }
-      normals->SetInputConnection(transformer->GetOutputPort());
-      normals->SetFeatureAngle(60);
-      normals->SetSplitting(SplitNormals);
-
-      normals->ReleaseDataFlagOn();
-
-      if (stripper)
-        {
-        stripper->SetInputData(nullptr);
-        stripper = nullptr;
-        }
-      stripper = vtkSmartPointer<vtkStripper>::New();
-      std::string            comment3 = "Strip " + labelName;
-      vtkPluginFilterWatcher watchStripper(stripper,
-                                           comment3.c_str(),
-                                           CLPProcessInformation,
-                                           1.0 / numFilterSteps,
-                                           currentFilterOffset / numFilterSteps);
-      currentFilterOffset += 1.0;
-      if (debug)
-        {
-        watchStripper.QuietOn();
-        }
-      stripper->SetInputConnection(normals->GetOutputPort());
-      stripper->ReleaseDataFlagOff();
-
-      // the poly data output from the stripper can be set as an input to a
-      // model's polydata
-      try
-        {
-        stripper->Update();
-        }
-      catch(...)
-        {
-        std::cerr << "ERROR updating stripper for model " << i << std::endl;
-        return EXIT_FAILURE;
-        }
-
-      // but for now we're just going to write it out
-      writer = vtkSmartPointer<vtkPolyDataWriter>::New();
-      std::string            comment4 = "Write " + labelName;
-      vtkPluginFilterWatcher watchWriter(writer,
-                                         comment4.c_str(),
-                                         CLPProcessInformation,
-                                         1.0 / numFilterSteps,
-                                         currentFilterOffset / numFilterSteps);
-      currentFilterOffset += 1.0;
-      if (debug)
-        {
-        watchWriter.QuietOn();
-        }
-      writer->SetInputConnection(stripper->GetOutputPort());
-      writer->SetHeader(modelFileHeader);
-      writer->SetFileType(2);
-      std::string fileName;
-      if (rootDir != "")
-        {
-        fileName = rootDir + std::string("/") + labelName + std::string(".vtk");
-        }
-      else
-        {
-        std::cout << "WARNING: output directory is an empty string..." << endl;
-        fileName = labelName + std::string(".vtk");
-        }
-      writer->SetFileName(fileName.c_str());
-
       if (debug)
         {
-        std::cout << "Writing model " << " " << labelName << " to file " << writer->GetFileName()  << endl;
+        std::cout << "...done adding model to output scene" << endl;
         }
-      if (!writer->Write())
-        {
-        std::cerr << "ERROR: Failed to write model file " << fileName.c_str() << std::endl;
-        }
-      writer->SetInputData(nullptr);
-      writer = nullptr;
-      if (modelScene.GetPointer() != nullptr)
-        {
-        if (debug)
-          {
-          std::cout << "Adding model " << labelName << " to the output scene, with filename " << fileName.c_str()
-                    << endl;
-          }
-        // each model needs a mrml node, a storage node and a display node
-        vtkNew<vtkMRMLModelNode> mnode;
-        mnode->SetScene(modelScene.GetPointer());
-        mnode->SetName(labelName.c_str());
-
-        vtkNew<vtkMRMLModelStorageNode> snode;
-        snode->SetFileName(fileName.c_str());
-        if (modelScene->AddNode(snode.GetPointer()) == nullptr)
-          {
-          std::cerr << "ERROR: unable to add the storage node to the model scene" << endl;
-          }
-        vtkNew<vtkMRMLModelDisplayNode> dnode;
-        dnode->SetColor(0.5, 0.5, 0.5);
-        double *rgba;
-        if (colorNode != nullptr)
-          {
-          rgba = colorNode->GetLookupTable()->GetTableValue(i);
-          if (rgba != nullptr)
-            {
-            if (debug)
-              {
-              std::cout << "Got color: " << rgba[0] << " " << rgba[1] << " " << rgba[2] << " " << rgba[3] << endl;
-              }
-            dnode->SetColor(rgba[0], rgba[1], rgba[2]);
-            }
-          else
-            {
-            std::cerr << "Couldn't get look up table value for " << i << ", display node color is not set (grey)"
-                      << endl;
-            }
-          }
-
-        dnode->SetVisibility(1);
-        modelScene->AddNode(dnode.GetPointer());
-        if (debug)
-          {
-          std::cout << "Added display node: id = " << (dnode->GetID() == nullptr ? "(null)" : dnode->GetID()) << endl;
-          std::cout << "Setting model's storage node: id = "
-                    << (snode->GetID() == nullptr ? "(null)" : snode->GetID()) << endl;
-          }
-        mnode->SetAndObserveStorageNodeID(snode->GetID());
-        mnode->SetAndObserveDisplayNodeID(dnode->GetID());
-        modelScene->AddNode(mnode.GetPointer());
-
-        // put it in the hierarchy, either the flat one by default or
-        // try to find the matching color hierarchy node to make this an
-        // associated node
-        std::string colorName;
-        if (colorNode != nullptr)
-          {
-          colorName = std::string(colorNode->GetColorNameAsFileName(i));
-          }
-        else
-          {
-          // might be in a testing case where the hierarchy nodes are
-          // numbered (made from the generic colors)
-          std::stringstream ss;
-          ss << i;
-          colorName = ss.str();
-          if (debug)
-            {
-            std::cout << "No color node, guessing at color name being same as label number " << colorName.c_str() << std::endl;
-            }
-          }
-        vtkMRMLNode *mrmlNode = nullptr;
-        if (colorName.compare("") != 0)
-          {
-          mrmlNode = modelScene->GetFirstNodeByName(colorName.c_str());
-          }
-        // if there's no color hierarchy, or no color name or the mrml node
-        // named for the color isn't a model hierarchy node, use a flat hierarchy
-        if (topColorHierarchyNode == nullptr ||
-            colorName.compare("") == 0 ||
-            mrmlNode == nullptr ||
-            strcmp(mrmlNode->GetClassName(),"vtkMRMLModelHierarchyNode") != 0)
-          {
-          vtkNew<vtkMRMLModelHierarchyNode> mhnd;
-          mhnd->SetHideFromEditors(1);
-          modelScene->AddNode(mhnd.GetPointer());
-          mhnd->SetParentNodeID(rnd->GetID());
-          mhnd->SetModelNodeID(mnode->GetID());
-          }
-        else
-          {
-          // use the template color hierarchy
-          vtkMRMLModelHierarchyNode *colorHierarchyNode = vtkMRMLModelHierarchyNode::SafeDownCast(mrmlNode);
-          if (colorHierarchyNode)
-            {
-            colorHierarchyNode->SetAssociatedNodeID(mnode->GetID());
-            // and hide it so that it doesn't clutter up the tree
-            colorHierarchyNode->SetHideFromEditors(1);
-            if (debug)
-              {
-              std::cout << "Found a color hierarchy node with name " << colorHierarchyNode->GetName() << ", set it's associated node to this model id: " << mnode->GetID() << std::endl;
-              }
-            }
-          }
-        if (debug)
-          {
-          std::cout << "...done adding model to output scene" << endl;
-          }
-        }
-      } // end of skipping an empty label
-    }   // end of loop over labels
+      }
+    }   // end of loop over models
   if (debug)
     {
     std::cout << "End of looping over labels" << endl;
@@ -1845,83 +1817,6 @@ int main(int argc, char * argv[])
     hist->SetInputData(nullptr);
     hist = nullptr;
     }
-  if (smootherSinc)
-    {
-    if (debug)
-      {
-      std::cout << "Deleting smootherSinc" << endl;
-      }
-    smootherSinc->SetInputData(nullptr);
-    smootherSinc = nullptr;
-    }
-  if (smootherPoly)
-    {
-    if (debug)
-      {
-      std::cout << "Deleting smoother poly" << endl;
-      }
-    smootherPoly->SetInputData(nullptr);
-    smootherPoly = nullptr;
-    }
-  if (decimator)
-    {
-    if (debug)
-      {
-      std::cout << "Deleting decimator" << endl;
-      }
-    decimator->SetInputData(nullptr);
-    decimator = nullptr;
-    }
-  if (mcubes)
-    {
-    if (debug)
-      {
-      std::cout << "Deleting mcubes" << endl;
-      }
-    mcubes->SetInputData(nullptr);
-    mcubes = nullptr;
-    }
-  if (imageThreshold)
-    {
-    if (debug)
-      {
-      std::cout << "Deleting image threshold" << endl;
-      }
-    imageThreshold->SetInputData(nullptr);
-    imageThreshold->RemoveAllInputs();
-    imageThreshold = nullptr;
-    if (debug)
-      {
-      std::cout << "... done deleting image threshold" << endl;
-      }
-    }
-  if (threshold)
-    {
-    if (debug)
-      {
-      cout << "Deleting threshold" << endl;
-      }
-    threshold->SetInputData(nullptr);
-    threshold = nullptr;
-    }
-  if (imageToStructuredPoints)
-    {
-    if (debug)
-      {
-      std::cout << "Deleting image to structured points" << endl;
-      }
-    imageToStructuredPoints->SetInputData(nullptr);
-    imageToStructuredPoints = nullptr;
-    }
-  if (geometryFilter)
-    {
-    if (debug)
-      {
-      cout << "Deleting geometry filter" << endl;
-      }
-    geometryFilter->SetInputData(nullptr);
-    geometryFilter = nullptr;
-    }
   if (transformIJKtoLPS)
     {
     if (debug)
@@ -1931,42 +1826,6 @@ int main(int argc, char * argv[])
     transformIJKtoLPS->SetInput(nullptr);
     transformIJKtoLPS = nullptr;
     }
-  if (reverser)
-    {
-    if (debug)
-      {
-      std::cout << "Deleting reverser" << endl;
-      }
-    reverser->SetInputData(nullptr);
-    reverser = nullptr;
-    }
-  if (transformer)
-    {
-    if (debug)
-      {
-      std::cout << "Deleting transformer" << endl;
-      }
-    transformer->SetInputData(nullptr);
-    transformer = nullptr;
-    }
-  if (normals)
-    {
-    if (debug)
-      {
-      std::cout << "Deleting normals" << endl;
-      }
-    normals->SetInputData(nullptr);
-    normals = nullptr;
-    }
-  if (stripper)
-    {
-    if (debug)
-      {
-      std::cout << "Deleting stripper" << endl;
-      }
-    stripper->SetInputData(nullptr);
-    stripper = nullptr;
-    }
   if (ici.GetPointer())
     {
     if (debug)
@@ -1,10 +1,15 @@
 #include "itkConstantPadImageFilter.h"
 #include "itkExtractImageFilter.h"
+#include "itkImageDuplicator.h"
 #include "itkImageFileWriter.h"
+#include "itkMultiplyImageFilter.h"
 #include "itkN4BiasFieldCorrectionImageFilter.h"
 #include "itkOtsuThresholdImageFilter.h"
 #include "itkShrinkImageFilter.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "N4ITKBiasFieldCorrectionCLP.h"
 #include "itkPluginUtilities.h"
 
@@ -14,6 +19,10 @@ namespace
 typedef float RealType;
 const int ImageDimension = 3;
 typedef itk::Image<RealType, ImageDimension> ImageType;
+typedef itk::Image<unsigned char, ImageDimension> MaskImageType;
+typedef itk::N4BiasFieldCorrectionImageFilter<ImageType, MaskImageType, ImageType> CorrecterType;
+typedef CorrecterType::BiasFieldControlPointLatticeType LatticeType;
+typedef itk::BSplineControlPointImageFilter<LatticeType, CorrecterType::ScalarImageType> BSplinerType;
 
 template <class TFilter>
 class CommandIterationUpdate : public itk::Command
@@ -58,6 +67,222 @@ int SaveIt(ImageType::Pointer img, const char* fname)
   return EXIT_SUCCESS;
 }
 
+// Evaluate the log bias field of a control point lattice on the grid of
+// \a image. The lattice is mapped onto the domain of the size of the image
+// that starts at \a domainOrigin.
+ImageType::Pointer ReconstructLogBiasField(const LatticeType* lattice, unsigned int splineOrder,
+                                           const ImageType::PointType& domainOrigin,
+                                           const ImageType* image)
+{
+  BSplinerType::Pointer bspliner = BSplinerType::New();
+  bspliner->SetInput( lattice );
+  bspliner->SetSplineOrder( splineOrder );
+  bspliner->SetSize( image->GetLargestPossibleRegion().GetSize() );
+  bspliner->SetOrigin( domainOrigin );
+  bspliner->SetDirection( image->GetDirection() );
+  bspliner->SetSpacing( image->GetSpacing() );
+  bspliner->Update();
+
+  ImageType::Pointer logField = ImageType::New();
+  logField->SetOrigin( image->GetOrigin() );
+  logField->SetSpacing( image->GetSpacing() );
+  logField->SetRegions( image->GetLargestPossibleRegion() );
+  logField->SetDirection( image->GetDirection() );
+  logField->Allocate();
+
+  itk::ImageRegionIterator<CorrecterType::ScalarImageType> IB(
+    bspliner->GetOutput(),
+    bspliner->GetOutput()->GetLargestPossibleRegion() );
+  itk::ImageRegionIterator<ImageType> IF( logField,
+                                          logField->GetLargestPossibleRegion() );
+  for( IB.GoToBegin(), IF.GoToBegin(); !IB.IsAtEnd(); ++IB, ++IF )
+    {
+    IF.Set( IB.Get()[0] );
+    }
+  return logField;
+}
+
+// Standard deviation of a log bias field inside the mask, i.e. about the
+// coefficient of variation of the intensity correction it applies.
+double LogBiasFieldVariation(const ImageType* logField, const MaskImageType* mask,
+                             MaskImageType::PixelType maskLabel)
+{
+  itk::ImageRegionConstIterator<ImageType> IF( logField, logField->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator<MaskImageType> IM( mask, mask->GetLargestPossibleRegion() );
+  double sum = 0.0;
+  double sumOfSquares = 0.0;
+  double count = 0.0;
+  for( IF.GoToBegin(), IM.GoToBegin(); !IF.IsAtEnd(); ++IF, ++IM )
+    {
+    if( IM.Get() == maskLabel )
+      {
+      sum += IF.Get();
+      sumOfSquares += IF.Get() * IF.Get();
+      count += 1.0;
+      }
+    }
+  if( count == 0.0 )
+    {
+    return 0.0;
+    }
+  double mean = sum / count;
+  return std::sqrt( std::max( 0.0, sumOfSquares / count - mean * mean ) );
+}
+
+// Run the resolution levels of N4 one after the other: each level fits the
+// bias field remaining after the correction by the previous levels. This
+// allows to stop the schedule when a level does not change the bias field
+// significantly anymore, and to estimate the coarse levels on more downsampled
+// images (fast mode). The parameters of the levels are copied from
+// \a reference. Returns the log bias field lattice at the resolution of the
+// last level that was run, mapped onto the domain of \a inputImage that
+// starts at \a domainOrigin.
+LatticeType::Pointer CorrectLevels(const CorrecterType* reference,
+                                   ImageType::Pointer inputImage,
+                                   const ImageType::PointType& domainOrigin,
+                                   MaskImageType::Pointer maskImage,
+                                   ImageType::Pointer weightImage,
+                                   const std::vector<int>& numberOfIterations,
+                                   int shrinkFactor,
+                                   bool fastMode,
+                                   double scheduleConvergenceThreshold,
+                                   ModuleProcessInformation* processInformation)
+{
+  typedef itk::ShrinkImageFilter<ImageType, ImageType> ShrinkerType;
+  typedef itk::ShrinkImageFilter<MaskImageType, MaskImageType> MaskShrinkerType;
+  const unsigned int numberOfLevels = static_cast<unsigned int>( std::max<::size_t>( numberOfIterations.size(), 1 ) );
+  const ImageType::SizeType inputSize = inputImage->GetLargestPossibleRegion().GetSize();
+  const unsigned int splineOrder = reference->GetSplineOrder();
+  CorrecterType::ArrayType numberOfControlPoints = reference->GetNumberOfControlPoints();
+  LatticeType::Pointer logBiasLattice;
+
+  for( unsigned int level = 0; level < numberOfLevels; level++ )
+    {
+    // The shrink factor is doubled for each level coarser than the last one,
+    // while keeping two voxels per control point.
+    ShrinkerType::ShrinkFactorsType shrinkFactors;
+    for( unsigned int d = 0; d < ImageDimension; d++ )
+      {
+      unsigned int factor = std::max( shrinkFactor, 1 );
+      if( fastMode )
+        {
+        factor <<= ( numberOfLevels - 1 - level );
+        unsigned int maximumFactor = static_cast<unsigned int>( inputSize[d] / ( 2 * numberOfControlPoints[d] ) );
+        factor = std::max( std::max( shrinkFactor, 1 ), static_cast<int>( std::min( factor, maximumFactor ) ) );
+        }
+      shrinkFactors[d] = factor;
+      }
+    ShrinkerType::Pointer shrinker = ShrinkerType::New();
+    shrinker->SetInput( inputImage );
+    shrinker->SetShrinkFactors( shrinkFactors );
+    shrinker->Update();
+    ImageType::Pointer levelInput = shrinker->GetOutput();
+    MaskShrinkerType::Pointer maskshrinker = MaskShrinkerType::New();
+    maskshrinker->SetInput( maskImage );
+    maskshrinker->SetShrinkFactors( shrinkFactors );
+    maskshrinker->Update();
+
+    // Remove the bias field estimated by the previous levels
+    if( logBiasLattice )
+      {
+      typedef itk::ExpImageFilter<ImageType, ImageType> ExpFilterType;
+      ExpFilterType::Pointer expFilter = ExpFilterType::New();
+      expFilter->SetInput( ReconstructLogBiasField( logBiasLattice, splineOrder, domainOrigin, inputImage ) );
+      ShrinkerType::Pointer fieldShrinker = ShrinkerType::New();
+      fieldShrinker->SetInput( expFilter->GetOutput() );
+      fieldShrinker->SetShrinkFactors( shrinkFactors );
+      typedef itk::DivideImageFilter<ImageType, ImageType, ImageType> DividerType;
+      DividerType::Pointer divider = DividerType::New();
+      divider->SetInput1( levelInput );
+      divider->SetInput2( fieldShrinker->GetOutput() );
+      divider->Update();
+      levelInput = divider->GetOutput();
+      }
+
+    CorrecterType::Pointer correcter = CorrecterType::New();
+    correcter->SetInput( levelInput );
+    correcter->SetMaskImage( maskshrinker->GetOutput() );
+    correcter->SetMaskLabel( reference->GetMaskLabel() );
+    if( weightImage )
+      {
+      ShrinkerType::Pointer weightshrinker = ShrinkerType::New();
+      weightshrinker->SetInput( weightImage );
+      weightshrinker->SetShrinkFactors( shrinkFactors );
+      weightshrinker->Update();
+      correcter->SetConfidenceImage( weightshrinker->GetOutput() );
+      }
+    correcter->SetSplineOrder( splineOrder );
+    correcter->SetNumberOfControlPoints( numberOfControlPoints );
+    CorrecterType::ArrayType numberOfFittingLevels;
+    numberOfFittingLevels.Fill( 1 );
+    correcter->SetNumberOfFittingLevels( numberOfFittingLevels );
+    if( level < numberOfIterations.size() && numberOfIterations[level] )
+      {
+      CorrecterType::VariableSizeArrayType maximumNumberOfIterations( 1 );
+      maximumNumberOfIterations[0] = numberOfIterations[level];
+      correcter->SetMaximumNumberOfIterations( maximumNumberOfIterations );
+      }
+    correcter->SetConvergenceThreshold( reference->GetConvergenceThreshold() );
+    correcter->SetBiasFieldFullWidthAtHalfMaximum( reference->GetBiasFieldFullWidthAtHalfMaximum() );
+    correcter->SetWienerFilterNoise( reference->GetWienerFilterNoise() );
+    correcter->SetNumberOfHistogramBins( reference->GetNumberOfHistogramBins() );
+    {
+    itk::PluginFilterWatcher watchN4(correcter, "N4 Bias field correction", processInformation,
+                                     1.0 / numberOfLevels, static_cast<double>( level ) / numberOfLevels);
+    correcter->Update();
+    }
+
+    const LatticeType* levelLattice = correcter->GetLogBiasFieldControlPointLattice();
+    if( !logBiasLattice )
+      {
+      typedef itk::ImageDuplicator<LatticeType> DuplicatorType;
+      DuplicatorType::Pointer duplicator = DuplicatorType::New();
+      duplicator->SetInputImage( levelLattice );
+      duplicator->Update();
+      logBiasLattice = duplicator->GetOutput();
+      }
+    else
+      {
+      // Refine the lattice of the previous levels to the resolution of this
+      // level and add the field of this level.
+      BSplinerType::Pointer bspliner = BSplinerType::New();
+      bspliner->SetInput( logBiasLattice );
+      bspliner->SetSplineOrder( splineOrder );
+      bspliner->SetSize( inputSize );
+      bspliner->SetOrigin( domainOrigin );
+      bspliner->SetDirection( inputImage->GetDirection() );
+      bspliner->SetSpacing( inputImage->GetSpacing() );
+      BSplinerType::ArrayType numberOfRefinementLevels;
+      numberOfRefinementLevels.Fill( 2 );
+      logBiasLattice = bspliner->RefineControlPointLattice( numberOfRefinementLevels );
+      itk::ImageRegionIterator<LatticeType> IA( logBiasLattice, logBiasLattice->GetLargestPossibleRegion() );
+      itk::ImageRegionConstIterator<LatticeType> IL( levelLattice, levelLattice->GetLargestPossibleRegion() );
+      for( IA.GoToBegin(), IL.GoToBegin(); !IA.IsAtEnd(); ++IA, ++IL )
+        {
+        IA.Set( IA.Get() + IL.Get() );
+        }
+      }
+
+    if( scheduleConvergenceThreshold > 0 && level + 1 < numberOfLevels )
+      {
+      double variation = LogBiasFieldVariation(
+        ReconstructLogBiasField( levelLattice, splineOrder, levelInput->GetOrigin(), levelInput ),
+        maskshrinker->GetOutput(), reference->GetMaskLabel() );
+      std::cout << "Level " << level << " bias field variation: " << variation << std::endl;
+      if( variation < scheduleConvergenceThreshold )
+        {
+        std::cout << "Bias field converged, skipping the remaining levels." << std::endl;
+        break;
+        }
+      }
+    for( unsigned int d = 0; d < ImageDimension; d++ )
+      {
+      numberOfControlPoints[d] = 2 * ( numberOfControlPoints[d] - splineOrder ) + splineOrder;
+      }
+    }
+  return logBiasLattice;
+}
+
 };
 
 int main(int argc, char* * argv)
@@ -67,10 +292,8 @@ int main(int argc, char* * argv)
 
   ImageType::Pointer inputImage = nullptr;
 
-  typedef itk::Image<unsigned char, ImageDimension> MaskImageType;
   MaskImageType::Pointer maskImage = nullptr;
 
-  typedef    itk::N4BiasFieldCorrectionImageFilter<ImageType, MaskImageType, ImageType> CorrecterType;
   CorrecterType::Pointer correcter = CorrecterType::New();
 
   typedef itk::ImageFileReader<ImageType> ReaderType;
@@ -80,6 +303,33 @@ int main(int argc, char* * argv)
   reader->Update();
   inputImage = reader->GetOutput();
 
+  /**
+   * A bias field computed previously, for example on another acquisition
+   * of the same subject, initializes the estimation: the input image is
+   * corrected by it and only the remaining bias field is estimated.
+   */
+  ImageType::Pointer initialBiasField = nullptr;
+  if( initialBiasFieldName != "" )
+    {
+    ReaderType::Pointer biasFieldReader = ReaderType::New();
+    biasFieldReader->SetFileName( initialBiasFieldName.c_str() );
+    biasFieldReader->Update();
+    initialBiasField = biasFieldReader->GetOutput();
+    if( initialBiasField->GetLargestPossibleRegion() != inputImage->GetLargestPossibleRegion() )
+      {
+      std::cerr << "The initial bias field must have the same size as the input image." << std::endl;
+      return EXIT_FAILURE;
+      }
+    // the bias field is written with the geometry of the input image
+    initialBiasField->CopyInformation( inputImage );
+    typedef itk::DivideImageFilter<ImageType, ImageType, ImageType> DividerType;
+    DividerType::Pointer divider = DividerType::New();
+    divider->SetInput1( inputImage );
+    divider->SetInput2( initialBiasField );
+    divider->Update();
+    inputImage = divider->GetOutput();
+    }
+
   /**
    * handle he mask image
    */
@@ -288,10 +538,22 @@ int main(int argc, char* * argv)
     correcter->SetNumberOfHistogramBins( nHistogramBins );
     }
 
+  LatticeType::ConstPointer logBiasFieldLattice;
   try
     {
-    itk::PluginFilterWatcher watchN4(correcter, "N4 Bias field correction", CLPProcessInformation, 1.0 / 1.0, 0.0);
-    correcter->Update();
+    if( fastMode || scheduleConvergenceThreshold > 0 )
+      {
+      logBiasFieldLattice = CorrectLevels( correcter, inputImage, newOrigin, maskImage, weightImage,
+                                           numberOfIterations, shrinkFactor, fastMode,
+                                           scheduleConvergenceThreshold, CLPProcessInformation );
+      }
+    else
+      {
+      itk::PluginFilterWatcher watchN4(correcter, "N4 Bias field correction", CLPProcessInformation, 1.0 / 1.0, 0.0);
+      correcter->Update();
+      correcter->Print( std::cout, 3 );
+      logBiasFieldLattice = correcter->GetLogBiasFieldControlPointLattice();
+      }
     }
   catch( itk::ExceptionObject & err )
     {
@@ -304,8 +566,6 @@ int main(int argc, char* * argv)
     return EXIT_FAILURE;
     }
 
-  correcter->Print( std::cout, 3 );
-
   timer.Stop();
   std::cout << "Elapsed ime: " << timer.GetMean() << std::endl;
 
@@ -319,34 +579,8 @@ int main(int argc, char* * argv)
      * the original input image by the bias field to get the final
      * corrected image.
      */
-    typedef itk::BSplineControlPointImageFilter<
-      CorrecterType::BiasFieldControlPointLatticeType,
-      CorrecterType::ScalarImageType> BSplinerType;
-    BSplinerType::Pointer bspliner = BSplinerType::New();
-    bspliner->SetInput( correcter->GetLogBiasFieldControlPointLattice() );
-    bspliner->SetSplineOrder( correcter->GetSplineOrder() );
-    bspliner->SetSize( inputImage->GetLargestPossibleRegion().GetSize() );
-    bspliner->SetOrigin( newOrigin );
-    bspliner->SetDirection( inputImage->GetDirection() );
-    bspliner->SetSpacing( inputImage->GetSpacing() );
-    bspliner->Update();
-
-    ImageType::Pointer logField = ImageType::New();
-    logField->SetOrigin( inputImage->GetOrigin() );
-    logField->SetSpacing( inputImage->GetSpacing() );
-    logField->SetRegions( inputImage->GetLargestPossibleRegion() );
-    logField->SetDirection( inputImage->GetDirection() );
-    logField->Allocate();
-
-    itk::ImageRegionIterator<CorrecterType::ScalarImageType> IB(
-      bspliner->GetOutput(),
-      bspliner->GetOutput()->GetLargestPossibleRegion() );
-    itk::ImageRegionIterator<ImageType> IF( logField,
-                                            logField->GetLargestPossibleRegion() );
-    for( IB.GoToBegin(), IF.GoToBegin(); !IB.IsAtEnd(); ++IB, ++IF )
-      {
-      IF.Set( IB.Get()[0] );
-      }
+    ImageType::Pointer logField = ReconstructLogBiasField(
+      logBiasFieldLattice, correcter->GetSplineOrder(), newOrigin, inputImage );
 
     typedef itk::ExpImageFilter<ImageType, ImageType> ExpFilterType;
     ExpFilterType::Pointer expFilter = ExpFilterType::New();
@@ -378,10 +612,20 @@ int main(int argc, char* * argv)
 
     if( outputBiasFieldName != "" )
       {
+      ImageType::Pointer biasField = biasFieldCropper->GetOutput();
+      if( initialBiasField )
+        {
+        typedef itk::MultiplyImageFilter<ImageType, ImageType, ImageType> MultiplierType;
+        MultiplierType::Pointer multiplier = MultiplierType::New();
+        multiplier->SetInput1( biasField );
+        multiplier->SetInput2( initialBiasField );
+        multiplier->Update();
+        biasField = multiplier->GetOutput();
+        }
       typedef itk::ImageFileWriter<ImageType> WriterType;
       WriterType::Pointer writer = WriterType::New();
       writer->SetFileName( outputBiasFieldName.c_str() );
-      writer->SetInput( biasFieldCropper->GetOutput() );
+      writer->SetInput( biasField );
       writer->SetUseCompression(true);
       writer->Update();
       }
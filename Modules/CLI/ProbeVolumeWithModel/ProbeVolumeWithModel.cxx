@@ -5,19 +5,164 @@
 #include <vtkTeemNRRDReader.h>
 
 // VTK includes
+#include <vtkCharArray.h>
+#include <vtkDataArray.h>
 #include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
 #include <vtkNew.h>
-#include <vtkPolyData.h>
+#include <vtkPointData.h>
+#include <vtkPointSet.h>
 #include <vtkProbeFilter.h>
-#include <vtkTransform.h>
-#include <vtkTransformFilter.h>
-#include <vtkImageChangeInformation.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
 
 #include "vtkMRMLModelNode.h"
 #include "vtkMRMLModelStorageNode.h"
 
 #include <vtksys/SystemTools.hxx>
 
+// STD includes
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Sample all point data arrays of the volume at the points of the mesh using trilinear interpolation.
+/// Points are processed in parallel. The output has the same structure and field data as the input mesh
+/// and its point data contains the sampled arrays and a valid point mask array (same as the output of vtkProbeFilter).
+void ProbeVolumeAtMeshPoints(vtkImageData* volume, vtkMatrix4x4* rasToIjk, vtkPointSet* inputMesh, vtkPointSet* outputMesh)
+{
+  outputMesh->CopyStructure(inputMesh);
+  outputMesh->GetFieldData()->PassData(inputMesh->GetFieldData());
+
+  vtkIdType numberOfPoints = inputMesh->GetNumberOfPoints();
+  vtkPointData* volumePointData = volume->GetPointData();
+  std::vector<vtkDataArray*> sourceArrays;
+  std::vector<vtkSmartPointer<vtkDataArray> > outputArrays;
+  for (int arrayIndex = 0; arrayIndex < volumePointData->GetNumberOfArrays(); ++arrayIndex)
+    {
+    vtkDataArray* sourceArray = volumePointData->GetArray(arrayIndex);
+    if (!sourceArray)
+      {
+      continue;
+      }
+    vtkSmartPointer<vtkDataArray> outputArray = vtkSmartPointer<vtkDataArray>::Take(sourceArray->NewInstance());
+    outputArray->SetName(sourceArray->GetName());
+    outputArray->SetNumberOfComponents(sourceArray->GetNumberOfComponents());
+    outputArray->SetNumberOfTuples(numberOfPoints);
+    sourceArrays.push_back(sourceArray);
+    outputArrays.push_back(outputArray);
+    }
+  vtkNew<vtkCharArray> validPointMask;
+  vtkNew<vtkProbeFilter> probeFilter; // only used for getting the default name of the mask array
+  validPointMask->SetName(probeFilter->GetValidPointMaskArrayName());
+  validPointMask->SetNumberOfTuples(numberOfPoints);
+
+  int extent[6] = { 0, -1, 0, -1, 0, -1 };
+  volume->GetExtent(extent);
+  // Point index increments along each axis
+  vtkIdType pointIncrements[3] = { 1, extent[1] - extent[0] + 1, 0 };
+  pointIncrements[2] = pointIncrements[1] * (extent[3] - extent[2] + 1);
+  double rasToIjkMatrix[16] = { 0.0 };
+  vtkMatrix4x4::DeepCopy(rasToIjkMatrix, rasToIjk);
+
+  vtkSMPTools::For(0, numberOfPoints, [&](vtkIdType firstPointId, vtkIdType endPointId)
+    {
+    for (vtkIdType pointId = firstPointId; pointId < endPointId; ++pointId)
+      {
+      double point_Ras[4] = { 0.0, 0.0, 0.0, 1.0 };
+      inputMesh->GetPoint(pointId, point_Ras);
+      double point_Ijk[4] = { 0.0, 0.0, 0.0, 1.0 };
+      vtkMatrix4x4::MultiplyPoint(rasToIjkMatrix, point_Ras, point_Ijk);
+
+      // Find the voxel cell that contains the point. Points that are on the boundary
+      // (within a small tolerance) are considered to be inside, same as in vtkProbeFilter.
+      const double tolerance = 1e-6;
+      int baseIndex[3] = { 0, 0, 0 };
+      double weight[3] = { 0.0, 0.0, 0.0 };
+      bool inside = true;
+      for (int axis = 0; axis < 3 && inside; ++axis)
+        {
+        double position = point_Ijk[axis];
+        int minIndex = extent[axis * 2];
+        int maxIndex = extent[axis * 2 + 1];
+        if (position < minIndex - tolerance || position > maxIndex + tolerance)
+          {
+          inside = false;
+          break;
+          }
+        if (minIndex == maxIndex)
+          {
+          // single slice along this axis
+          baseIndex[axis] = minIndex;
+          weight[axis] = 0.0;
+          continue;
+          }
+        int index = static_cast<int>(std::floor(position));
+        index = std::max(minIndex, std::min(index, maxIndex - 1));
+        baseIndex[axis] = index;
+        weight[axis] = std::max(0.0, std::min(1.0, position - index));
+        }
+
+      validPointMask->SetValue(pointId, inside ? 1 : 0);
+      for (size_t arrayIndex = 0; arrayIndex < sourceArrays.size(); ++arrayIndex)
+        {
+        vtkDataArray* sourceArray = sourceArrays[arrayIndex];
+        vtkDataArray* outputArray = outputArrays[arrayIndex];
+        int numberOfComponents = sourceArray->GetNumberOfComponents();
+        bool integerType = (sourceArray->GetDataType() != VTK_FLOAT && sourceArray->GetDataType() != VTK_DOUBLE);
+        for (int component = 0; component < numberOfComponents; ++component)
+          {
+          double value = 0.0;
+          if (inside)
+            {
+            // Trilinear interpolation of the 8 corners of the voxel cell
+            for (int corner = 0; corner < 8; ++corner)
+              {
+              int offset[3] = { corner & 1, (corner >> 1) & 1, (corner >> 2) & 1 };
+              double cornerWeight = 1.0;
+              vtkIdType voxelIndex = 0;
+              for (int axis = 0; axis < 3; ++axis)
+                {
+                cornerWeight *= offset[axis] ? weight[axis] : 1.0 - weight[axis];
+                voxelIndex += (baseIndex[axis] + offset[axis] - extent[axis * 2]) * pointIncrements[axis];
+                }
+              if (cornerWeight == 0.0)
+                {
+                // corner is not used (it may also be outside the extent)
+                continue;
+                }
+              value += cornerWeight * sourceArray->GetComponent(voxelIndex, component);
+              }
+            if (integerType)
+              {
+              value = std::round(value);
+              }
+            }
+          outputArray->SetComponent(pointId, component, value);
+          }
+        }
+      }
+    });
+
+  vtkPointData* outputPointData = outputMesh->GetPointData();
+  outputPointData->Initialize();
+  for (vtkDataArray* outputArray : outputArrays)
+    {
+    outputPointData->AddArray(outputArray);
+    }
+  if (!outputArrays.empty())
+    {
+    outputPointData->SetActiveScalars(outputArrays[0]->GetName());
+    }
+  outputPointData->AddArray(validPointMask);
+}
+
+} // end of anonymous namespace
+
 int main(int argc, char* argv[])
 {
   PARSE_ARGS;
@@ -37,13 +182,6 @@ int main(int argc, char* argv[])
     }
   std::cout << "Done reading the file " << InputVolume << endl;
 
-  vtkNew<vtkImageChangeInformation> ici;
-  ici->SetInputConnection(readerVol->GetOutputPort());
-  ici->SetOutputSpacing(1, 1, 1);
-  ici->SetOutputOrigin(0, 0, 0);
-  ici->Update();
-  vtkImageData* volume_Ijk = ici->GetOutput();
-
   vtkNew<vtkMRMLModelStorageNode> modelStorageNode;
   vtkNew<vtkMRMLModelNode> modelNode;
   modelStorageNode->SetFileName(InputModel.c_str());
@@ -53,25 +191,19 @@ int main(int argc, char* argv[])
     return EXIT_FAILURE;
     }
 
-  // Transform the model into the volume's IJK space
-  vtkNew<vtkTransformFilter> modelTransformerRasToIjk;
-  vtkNew<vtkTransform> transformRasToIjk;
-  transformRasToIjk->SetMatrix(readerVol->GetRasToIjkMatrix());
-  modelTransformerRasToIjk->SetTransform(transformRasToIjk);
-  modelTransformerRasToIjk->SetInputConnection(modelNode->GetMeshConnection());
-
-  vtkNew<vtkProbeFilter> probe;
-  probe->SetSourceData(volume_Ijk);
-  probe->SetInputConnection(modelTransformerRasToIjk->GetOutputPort());
-
-  // Transform the model back into RAS space
-  vtkNew<vtkTransformFilter> modelTransformerIjkToRas;
-  modelTransformerIjkToRas->SetTransform(transformRasToIjk->GetInverse());
-  modelTransformerIjkToRas->SetInputConnection(probe->GetOutputPort());
-  modelTransformerIjkToRas->Update();
+  // Sample the volume at the model points. Points are transformed into the volume's IJK space
+  // on the fly, so the model geometry remains unchanged.
+  vtkPointSet* inputMesh = modelNode->GetMesh();
+  if (!inputMesh)
+    {
+    std::cerr << "Invalid mesh in input model file " << InputModel << std::endl;
+    return EXIT_FAILURE;
+    }
+  vtkSmartPointer<vtkPointSet> outputMesh = vtkSmartPointer<vtkPointSet>::Take(inputMesh->NewInstance());
+  ProbeVolumeAtMeshPoints(volume, readerVol->GetRasToIjkMatrix(), inputMesh, outputMesh);
 
   // Save the output
-  modelNode->SetAndObserveMesh(modelTransformerIjkToRas->GetOutput());
+  modelNode->SetAndObserveMesh(outputMesh);
   modelStorageNode->SetFileName(OutputModel.c_str());
   if (!modelStorageNode->WriteData(modelNode))
     {
@@ -18,6 +18,7 @@
 #include <itkImageFileReader.h>
 #include <itkImageFileWriter.h>
 #include <itkMetaDataObject.h>
+#include <itkMultiThreaderBase.h>
 #include <itkNearestNeighborInterpolateImageFunction.h>
 #include <itkResampleImageFilter.h>
 #include <itkBSplineInterpolateImageFunction.h>
@@ -38,6 +39,11 @@
 #include "itkWarpTransform3D.h"
 
 // STD includes
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 // Use an anonymous namespace to keep class types and function names
 // from colliding when module is used as shared object module.  Every
@@ -685,45 +691,6 @@ SetAllTransform( parameters & list,
   return transform;
 }
 
-// Write back the vector of images into a image vector
-template <class PixelType>
-int AddImage( typename itk::VectorImage<PixelType, 3>
-              ::Pointer & imagePile,
-              const std::vector<typename itk::Image<PixelType, 3>::Pointer> & vectorImage
-              )
-{
-  typedef itk::Image<PixelType, 3> ImageType;
-  imagePile->SetRegions( vectorImage.at( 0 )->GetLargestPossibleRegion().GetSize() );
-  imagePile->SetOrigin( vectorImage.at( 0 )->GetOrigin() );
-  imagePile->SetDirection( vectorImage.at( 0 )->GetDirection() );
-  imagePile->SetSpacing( vectorImage.at( 0 )->GetSpacing() );
-  imagePile->SetVectorLength( vectorImage.size() );
-  imagePile->Allocate();
-  typename itk::ImageRegionIterator<itk::VectorImage<PixelType, 3> > out( imagePile,
-                                                                          imagePile->GetLargestPossibleRegion()
-                                                                          );
-  typedef typename itk::ImageRegionIterator<ImageType> IteratorImageType;
-  std::vector<IteratorImageType> in;
-  for( unsigned int i = 0; i < imagePile->GetVectorLength(); i++ )
-    {
-    IteratorImageType intemp( vectorImage.at( i ), vectorImage.at( i )->GetLargestPossibleRegion() );
-    intemp.GoToBegin();
-    in.push_back( intemp );
-    }
-  itk::VariableLengthVector<PixelType> value;
-  value.SetSize( vectorImage.size() );
-  for( out.GoToBegin(); !out.IsAtEnd(); ++out )
-    {
-    for( unsigned int i = 0; i < imagePile->GetVectorLength(); i++ )
-      {
-      value.SetElement( i, in.at( i ).Get() );
-      ++in[i];
-      }
-    out.Set( value );
-    }
-  return EXIT_SUCCESS;
-}
-
 // Separate the vector image into a vector of images
 template <class PixelType>
 int SeparateImages( const typename itk::VectorImage<PixelType, 3>
@@ -1269,19 +1236,88 @@ int Rotate( parameters & list )
     }
   resample->SetTransform( transform );
   resample->SetInterpolator( interpol );
-  std::vector<typename ImageType::Pointer> vectorOutputImage;
-  // Resample all the images separately
-  for( ::size_t idx = 0; idx < vectorOfImage.size(); idx++ )
+  // Resample the components in parallel. The threads are split between the
+  // components and the resampler of each component. Each worker has its own
+  // resampler and interpolator and reuses the output buffer of its resampler
+  // for all its components, which are copied into the output vector image.
+  const unsigned int numberOfComponents = static_cast<unsigned int>( vectorOfImage.size() );
+  unsigned int numberOfThreads = list.numberOfThread > 0 ? static_cast<unsigned int>( list.numberOfThread )
+    : itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  const unsigned int numberOfWorkers = std::max( 1u, std::min( numberOfThreads, numberOfComponents ) );
+  const unsigned int threadsPerWorker = std::max( 1u, numberOfThreads / numberOfWorkers );
+  std::vector<typename ResampleType::Pointer> resamplers;
+  resamplers.push_back( resample );
+  for( unsigned int i = 1; i < numberOfWorkers; i++ )
     {
-    resample->SetInput( vectorOfImage[idx] );
-    resample->Update();
-    vectorOutputImage.push_back( resample->GetOutput() );
-    vectorOutputImage[idx]->DisconnectPipeline();
+    typename ResampleType::Pointer workerResample = ResampleType::New();
+    workerResample->SetSize( resample->GetSize() );
+    workerResample->SetOutputStartIndex( resample->GetOutputStartIndex() );
+    workerResample->SetOutputSpacing( resample->GetOutputSpacing() );
+    workerResample->SetOutputOrigin( resample->GetOutputOrigin() );
+    workerResample->SetOutputDirection( resample->GetOutputDirection() );
+    workerResample->SetDefaultPixelValue( resample->GetDefaultPixelValue() );
+    workerResample->SetTransform( transform );
+    workerResample->SetInterpolator( SetInterpolator<ImageType>( list ) );
+    resamplers.push_back( workerResample );
+    }
+  typename VectorImageType::Pointer outputImage = VectorImageType::New();
+  outputImage->SetRegions( resample->GetSize() );
+  outputImage->SetOrigin( resample->GetOutputOrigin() );
+  outputImage->SetDirection( resample->GetOutputDirection() );
+  outputImage->SetSpacing( resample->GetOutputSpacing() );
+  outputImage->SetVectorLength( numberOfComponents );
+  outputImage->Allocate();
+  PixelType* outputBuffer = outputImage->GetBufferPointer();
+  const ::size_t numberOfPixels = outputImage->GetLargestPossibleRegion().GetNumberOfPixels();
+
+  std::atomic<unsigned int> nextComponent( 0 );
+  std::atomic<bool>         failed( false );
+  std::mutex                errorMutex;
+  std::string               errorMessage;
+  auto resampleComponents = [&]( typename ResampleType::Pointer workerResample )
+    {
+    workerResample->SetNumberOfThreads( threadsPerWorker );
+    for( unsigned int idx = nextComponent++; idx < numberOfComponents && !failed; idx = nextComponent++ )
+      {
+      try
+        {
+        workerResample->SetInput( vectorOfImage[idx] );
+        workerResample->Update();
+        }
+      catch( itk::ExceptionObject &exception )
+        {
+        std::lock_guard<std::mutex> lock( errorMutex );
+        std::ostringstream message;
+        message << exception;
+        errorMessage = message.str();
+        failed = true;
+        break;
+        }
+      // the resampler keeps a reference to its input until the next component
+      vectorOfImage[idx] = nullptr;
+      const PixelType* componentBuffer = workerResample->GetOutput()->GetBufferPointer();
+      for( ::size_t i = 0; i < numberOfPixels; i++ )
+        {
+        outputBuffer[i * numberOfComponents + idx] = componentBuffer[i];
+        }
+      }
+    };
+  std::vector<std::thread> workers;
+  for( unsigned int i = 1; i < numberOfWorkers; i++ )
+    {
+    workers.emplace_back( resampleComponents, resamplers[i] );
+    }
+  resampleComponents( resamplers[0] );
+  for( std::thread& worker : workers )
+    {
+    worker.join();
+    }
+  resamplers.clear();
+  if( failed )
+    {
+    std::cerr << errorMessage << std::endl;
+    return EXIT_FAILURE;
     }
-  typename itk::VectorImage<PixelType, 3>::Pointer outputImage;
-  outputImage = itk::VectorImage<PixelType, 3>::New();
-  AddImage<PixelType>( outputImage, vectorOutputImage );
-  vectorOutputImage.clear();
   // If necessary, transform gradient vectors with the loaded transformations
   int dwmriProblem = CheckDWMRI( dico, transform );
   if( list.space ) // && list.transformationFile.compare( "" ) )
@@ -15,6 +15,7 @@
 
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionConstIterator.h"
+#include "itkMultiThreaderBase.h"
 
 /* ============================================================   */
 template <typename TPixel>
@@ -98,7 +99,12 @@ CSFLSRobustStatSegmentor3DLabelMap<TPixel>
 // #ifndef NDEBUG
 //     std::ofstream ff("/tmp/force.txt");
 // #endif
-  for( long i = 0; i < n; ++i )
+
+  /* Points of the zero layer are processed in parallel. Each point of the
+     layer is unique, therefore each thread only computes and caches
+     features of its own points. */
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, n,
+    [&](itk::SizeValueType i)
     {
     typename CSFLSLayer::iterator itz = m_lzIterVct[i];
 
@@ -115,12 +121,12 @@ CSFLSRobustStatSegmentor3DLabelMap<TPixel>
     computeFeatureAt(idx, f);
 
     // double a = -kernelEvaluation(f);
-    double a = -kernelEvaluationUsingPDF(f);
-
-    fmax = fmax > fabs(a) ? fmax : fabs(a);
+    cvForce[i] = -kernelEvaluationUsingPDF(f);
+    }, nullptr);
+  for( long i = 0; i < n; ++i )
+    {
+    fmax = fmax > fabs(cvForce[i]) ? fmax : fabs(cvForce[i]);
     kappaMax = kappaMax > fabs(kappaOnZeroLS[i]) ? kappaMax : fabs(kappaOnZeroLS[i]);
-
-    cvForce[i] = a;
     }
 
   // std::cout<<"fmax = "<<fmax<<std::endl;
@@ -630,30 +636,17 @@ CSFLSRobustStatSegmentor3DLabelMap<TPixel>
       std::cerr << "Error: 3 != m_seeds[i].size()\n";
       raise(SIGABRT);
       }
-
-    long ix = m_seeds[i][0];
-    long iy = m_seeds[i][1];
-    long iz = m_seeds[i][2];
-
-    TIndex idx = {{ix, iy, iz}};
-
-    std::vector<double> featureHere(m_numberOfFeature);
-    computeFeatureAt(idx, featureHere);
-
-//       //test
-//       for (int tttt = 0; tttt < m_numberOfFeature; ++tttt)
-//         std::cout<<featureHere[tttt]<<"\t";
-//       std::cout<<std::endl;
-//       ////test
-
-    m_featureAtTheSeeds.push_back(featureHere);
-
-// #ifndef NDEBUG
-//       //intensityAtSeeds<<"inensity at ( "<<ix<<", "<<iy<<", "<<iz<<") is "<<this->mp_img->GetPixel(idx)<<std::endl;
-//       intensityAtSeeds<<this->mp_img->GetPixel(idx)<<std::endl;
-// #endif
     }
 
+  /* Seeds are unique voxels of the label image, so features can be computed in parallel */
+  m_featureAtTheSeeds.resize(n);
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, n,
+    [&](itk::SizeValueType i)
+    {
+    TIndex idx = {{m_seeds[i][0], m_seeds[i][1], m_seeds[i][2]}};
+    computeFeatureAt(idx, m_featureAtTheSeeds[i]);
+    }, nullptr);
+
 // #ifndef NDEBUG
 //   intensityAtSeeds.close();
 // #endif
@@ -829,9 +822,12 @@ CSFLSRobustStatSegmentor3DLabelMap<TPixel>
 
     double var2 = -1.0 / (2 * stdDev * stdDev);
     double c = 1.0 / sqrt(2 * (itk::Math::pi) ) / stdDev;
-    for( TPixel a = m_inputImageIntensityMin; a <= m_inputImageIntensityMax; ++a )
+
+    /* Each intensity value of the PDF is evaluated independently, in parallel */
+    itk::MultiThreaderBase::New()->ParallelizeArray(0, thisPDF.size(),
+      [&](itk::SizeValueType ia)
       {
-      long ia = static_cast<long>(a - m_inputImageIntensityMin);
+      double a = static_cast<double>(m_inputImageIntensityMin) + ia;
 
       double pp = 0.0;
       for( long ii = 0; ii < n; ++ii )
@@ -844,7 +840,7 @@ CSFLSRobustStatSegmentor3DLabelMap<TPixel>
       pp /= n;
 
       thisPDF[ia] = pp;
-      }
+      }, nullptr);
 
     m_PDFlearnedFromSeeds.push_back(thisPDF);
     }
@@ -167,8 +167,8 @@ void vtkMRMLColorLegendDisplayNode::CopyContent(vtkMRMLNode* anode, bool deepCop
   vtkMRMLCopyVectorMacro(Size, double, 2);
   vtkMRMLCopyStdStringMacro(TitleText);
   // The name is misleading, this ShallowCopy method actually creates a deep copy
-  this->TitleTextProperty->ShallowCopy(this->SafeDownCast(copySourceNode)->GetTitleTextProperty());
-  this->LabelTextProperty->ShallowCopy(this->SafeDownCast(copySourceNode)->GetLabelTextProperty());
+  this->TitleTextProperty->ShallowCopy(copySourceNode->GetTitleTextProperty());
+  this->LabelTextProperty->ShallowCopy(copySourceNode->GetLabelTextProperty());
   vtkMRMLCopyStdStringMacro(LabelFormat);
   vtkMRMLCopyIntMacro(MaxNumberOfColors);
   vtkMRMLCopyIntMacro(NumberOfLabels);
@@ -45,6 +45,7 @@
 #include <vtkMatrix4x4.h>
 #include <vtkMatrix3x3.h>
 #include <vtkObjectFactory.h>
+#include <vtkPointData.h>
 #include <vtkSmartPointer.h>
 #include <vtkTransform.h>
 #include <vtkVersion.h>
@@ -53,6 +54,7 @@
 
 // STD includes
 #include <cassert>
+#include <cstring>
 #include <iostream>
 
 //----------------------------------------------------------------------------
@@ -138,6 +140,73 @@ public:
     vtkMatrix4x4::Multiply4x4(rasToIJK, objectToVolumeRAS, objectToVolumeIJK);
     }
 
+  /// Copy the voxels of inputImage within the specified extent (that must be within the input image extent)
+  /// into an image. If reusableImage has the same size, scalar type, and number of components as the
+  /// output then its scalar buffer is overwritten instead of allocating a new one (this avoids
+  /// memory allocation for each item when cropping sequences).
+  /// Voxels are copied using a single memcpy call per contiguous row (or slice, if rows are complete).
+  static vtkSmartPointer<vtkImageData> CopyImageRegion(vtkImageData* inputImage, const int extent[6], vtkImageData* reusableImage)
+    {
+    int outputDimensions[3] = { extent[1] - extent[0] + 1, extent[3] - extent[2] + 1, extent[5] - extent[4] + 1 };
+    int scalarType = inputImage->GetScalarType();
+    int numberOfComponents = inputImage->GetNumberOfScalarComponents();
+
+    vtkSmartPointer<vtkImageData> outputImage;
+    if (reusableImage && reusableImage != inputImage && reusableImage->GetPointData()->GetScalars()
+      && reusableImage->GetScalarType() == scalarType && reusableImage->GetNumberOfScalarComponents() == numberOfComponents)
+      {
+      int* reusableDimensions = reusableImage->GetDimensions();
+      if (reusableDimensions[0] == outputDimensions[0] && reusableDimensions[1] == outputDimensions[1]
+        && reusableDimensions[2] == outputDimensions[2])
+        {
+        outputImage = reusableImage;
+        outputImage->SetExtent(const_cast<int*>(extent));
+        }
+      }
+    if (!outputImage)
+      {
+      outputImage = vtkSmartPointer<vtkImageData>::New();
+      outputImage->SetExtent(const_cast<int*>(extent));
+      outputImage->AllocateScalars(scalarType, numberOfComponents);
+      }
+    outputImage->SetOrigin(inputImage->GetOrigin());
+    outputImage->SetSpacing(inputImage->GetSpacing());
+
+    int* inputExtent = inputImage->GetExtent();
+    size_t voxelSize = static_cast<size_t>(inputImage->GetScalarSize()) * numberOfComponents;
+    size_t rowSize = static_cast<size_t>(outputDimensions[0]) * voxelSize;
+    bool completeRows = (extent[0] == inputExtent[0] && extent[1] == inputExtent[1]);
+    bool completeSlices = completeRows && (extent[2] == inputExtent[2] && extent[3] == inputExtent[3]);
+    char* outputPtr = static_cast<char*>(outputImage->GetScalarPointer());
+    if (completeSlices)
+      {
+      size_t sliceSize = rowSize * outputDimensions[1];
+      memcpy(outputPtr, inputImage->GetScalarPointer(extent[0], extent[2], extent[4]), sliceSize * outputDimensions[2]);
+      }
+    else if (completeRows)
+      {
+      size_t sliceSize = rowSize * outputDimensions[1];
+      for (int k = extent[4]; k <= extent[5]; ++k)
+        {
+        memcpy(outputPtr, inputImage->GetScalarPointer(extent[0], extent[2], k), sliceSize);
+        outputPtr += sliceSize;
+        }
+      }
+    else
+      {
+      for (int k = extent[4]; k <= extent[5]; ++k)
+        {
+        for (int j = extent[2]; j <= extent[3]; ++j)
+          {
+          memcpy(outputPtr, inputImage->GetScalarPointer(extent[0], j, k), rowSize);
+          outputPtr += rowSize;
+          }
+        }
+      }
+    outputImage->Modified();
+    return outputImage;
+    }
+
 };
 
 //----------------------------------------------------------------------------
@@ -371,14 +440,38 @@ int vtkSlicerCropVolumeLogic::CropVoxelBased(vtkMRMLDisplayableNode* roi,
   vtkNew<vtkMatrix4x4> inputIJKToRAS;
   inputVolume->GetIJKToRASMatrix(inputIJKToRAS.GetPointer());
 
-  vtkNew<vtkImageConstantPad> imageClip;
-  imageClip->SetInputData(inputVolume->GetImageData());
-  imageClip->SetOutputWholeExtent(outputExtent);
-  imageClip->SetConstant(fillValue);
-  imageClip->Update();
+  vtkImageData* inputImage = inputVolume->GetImageData();
+  int* inputExtent = inputImage->GetExtent();
+  bool outputExtentWithinInputExtent = inputImage->GetPointData()->GetScalars() != nullptr;
+  for (int axisIndex = 0; axisIndex < 3; ++axisIndex)
+    {
+    if (outputExtent[axisIndex * 2] < inputExtent[axisIndex * 2]
+      || outputExtent[axisIndex * 2 + 1] > inputExtent[axisIndex * 2 + 1]
+      || outputExtent[axisIndex * 2] > outputExtent[axisIndex * 2 + 1])
+      {
+      outputExtentWithinInputExtent = false;
+      }
+    }
+
+  vtkSmartPointer<vtkImageData> outputImage;
+  if (outputExtentWithinInputExtent)
+    {
+    // No padding is needed, just copy the voxels (reusing the current output image buffer, if possible)
+    outputImage = vtkSlicerCropVolumeLogic::vtkInternal::CopyImageRegion(inputImage, outputExtent,
+      outputVolume != inputVolume ? outputVolume->GetImageData() : nullptr);
+    }
+  else
+    {
+    vtkNew<vtkImageConstantPad> imageClip;
+    imageClip->SetInputData(inputImage);
+    imageClip->SetOutputWholeExtent(outputExtent);
+    imageClip->SetConstant(fillValue);
+    imageClip->Update();
+    outputImage = imageClip->GetOutput();
+    }
 
   int wasModified = outputVolume->StartModify();
-  outputVolume->SetAndObserveImageData(imageClip->GetOutput());
+  outputVolume->SetAndObserveImageData(outputImage);
   outputVolume->SetIJKToRASMatrix(inputIJKToRAS.GetPointer());
   outputVolume->ShiftImageDataExtentToZeroStart();
   outputVolume->SetAndObserveTransformNodeID(inputVolume->GetTransformNodeID());
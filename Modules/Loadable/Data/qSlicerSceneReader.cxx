@@ -92,6 +92,9 @@ bool qSlicerSceneReader::load(const qSlicerIO::IOProperties& properties)
   this->mrmlScene()->SetURL(file.toUtf8());
   bool clear = properties.value("clear", false).toBool();
   bool success = false;
+  // Read data of storage nodes that support it on multiple threads
+  bool wasReadDataInParallel = this->mrmlScene()->GetReadDataInParallel();
+  this->mrmlScene()->SetReadDataInParallel(true);
   if (clear)
     {
     qDebug("Clear and import into main MRML scene");
@@ -111,6 +114,7 @@ bool qSlicerSceneReader::load(const qSlicerIO::IOProperties& properties)
       }
     success = this->mrmlScene()->Import(this->userMessages());
     }
+  this->mrmlScene()->SetReadDataInParallel(wasReadDataInParallel);
 
   // Display warning message if scene file was created with a different application or with a future application version
   std::string currentApplication;
@@ -261,8 +261,12 @@ bool qSlicerSceneWriter::writeToDirectory(const qSlicerIO::IOProperties& propert
   vtkSlicerApplicationLogic* applicationLogic =
     qSlicerCoreApplication::application()->applicationLogic();
   Q_ASSERT(this->mrmlScene() == applicationLogic->GetMRMLScene());
+  // Write data of storage nodes that support it on multiple threads
+  bool wasWriteDataInParallel = this->mrmlScene()->GetWriteDataInParallel();
+  this->mrmlScene()->SetWriteDataInParallel(true);
   bool retval = applicationLogic->SaveSceneToSlicerDataBundleDirectory(
     saveDirName.toUtf8(), imageData);
+  this->mrmlScene()->SetWriteDataInParallel(wasWriteDataInParallel);
   if (retval)
     {
     qDebug() << "Saved scene to dir" << saveDirName;
@@ -36,6 +36,9 @@
 #include <vtkPolyData.h>
 #include <vtkTriangleFilter.h>
 
+// STD includes
+#include <algorithm>
+
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkCurveMeasurementsCalculator);
 
@@ -217,56 +220,104 @@ bool vtkCurveMeasurementsCalculator::CalculatePolyDataCurvature(vtkPolyData* pol
   curvatureValues->Reset();
   curvatureValues->FillComponent(0,0.0);
 
+  // Get curve point positions in the order of the line
+  std::vector<double> curvePoints(numberOfPoints * 3);
+  for (vtkIdType idx = 0; idx < numberOfPoints; ++idx)
+    {
+    points->GetPoint(linePoints->GetId(idx), &curvePoints[idx * 3]);
+    }
+
+  // Curvature and length weight of a curve point only depend on the point and its two neighbors,
+  // therefore if only a part of the curve has changed (e.g., a control point is moved) then values
+  // are only recomputed in that part and cached values are used elsewhere.
+  vtkIdType firstModifiedIndex = 1;
+  vtkIdType lastModifiedIndex = numberOfPoints - 2;
+  if (this->CachedCurvatureCurvePoints.size() == curvePoints.size()
+    && this->CachedCurvatureCurveIsClosed == this->CurveIsClosed)
+    {
+    firstModifiedIndex = numberOfPoints;
+    lastModifiedIndex = -1;
+    for (vtkIdType idx = 0; idx < numberOfPoints; ++idx)
+      {
+      if (!std::equal(curvePoints.begin() + idx * 3, curvePoints.begin() + idx * 3 + 3,
+        this->CachedCurvatureCurvePoints.begin() + idx * 3))
+        {
+        firstModifiedIndex = idx;
+        break;
+        }
+      }
+    for (vtkIdType idx = numberOfPoints - 1; idx >= firstModifiedIndex; --idx)
+      {
+      if (!std::equal(curvePoints.begin() + idx * 3, curvePoints.begin() + idx * 3 + 3,
+        this->CachedCurvatureCurvePoints.begin() + idx * 3))
+        {
+        lastModifiedIndex = idx;
+        break;
+        }
+      }
+    // include neighbors of modified points
+    firstModifiedIndex = std::max<vtkIdType>(1, firstModifiedIndex - 1);
+    lastModifiedIndex = std::min<vtkIdType>(numberOfPoints - 2, lastModifiedIndex + 1);
+    }
+  else
+    {
+    this->CachedCurvatures.assign(numberOfPoints, 0.0);
+    this->CachedCurvatureLengths.assign(numberOfPoints, 0.0);
+    }
+
+  for (vtkIdType idx = firstModifiedIndex; idx <= lastModifiedIndex; ++idx)
+    {
+    const double* prevPoint = &curvePoints[(idx - 1) * 3]; // pp
+    const double* point = &curvePoints[idx * 3]; // p
+    const double* nextPoint = &curvePoints[(idx + 1) * 3];
+
+    double prevDiffVector[3] = {point[0]-prevPoint[0], point[1]-prevPoint[1], point[2]-prevPoint[2]};
+    double prevDiffNorm = sqrt(prevDiffVector[0]*prevDiffVector[0] + prevDiffVector[1]*prevDiffVector[1] + prevDiffVector[2]*prevDiffVector[2]);
+    double prevNormDiffVector[3] = {prevDiffVector[0]/prevDiffNorm, prevDiffVector[1]/prevDiffNorm, prevDiffVector[2]/prevDiffNorm}; // pT
+
+    double diffVector[3] = {nextPoint[0]-point[0], nextPoint[1]-point[1], nextPoint[2]-point[2]};
+    double diffNorm = sqrt(diffVector[0]*diffVector[0] + diffVector[1]*diffVector[1] + diffVector[2]*diffVector[2]); // ds
+    double normDiffVector[3] = {diffVector[0]/diffNorm, diffVector[1]/diffNorm, diffVector[2]/diffNorm}; // T
+
+    // Local curvature
+    this->CachedCurvatures[idx] = sqrt( (normDiffVector[0]-prevNormDiffVector[0])*(normDiffVector[0]-prevNormDiffVector[0])
+                + (normDiffVector[1]-prevNormDiffVector[1])*(normDiffVector[1]-prevNormDiffVector[1])
+                + (normDiffVector[2]-prevNormDiffVector[2])*(normDiffVector[2]-prevNormDiffVector[2]) )
+            / diffNorm;
+
+    // Length of the curve around the point (between the centers of the adjacent segments),
+    // used for weighting the mean. The first point is skipped.
+    double meanPoint[3] = {(nextPoint[0]+point[0]) / 2.0, (nextPoint[1]+point[1]) / 2.0, (nextPoint[2]+point[2]) / 2.0}; // m
+    double prevMeanPoint[3] = {point[0], point[1], point[2]}; // pm
+    if (idx > 1)
+      {
+      prevMeanPoint[0] = (point[0]+prevPoint[0]) / 2.0;
+      prevMeanPoint[1] = (point[1]+prevPoint[1]) / 2.0;
+      prevMeanPoint[2] = (point[2]+prevPoint[2]) / 2.0;
+      }
+    this->CachedCurvatureLengths[idx] = sqrt( (meanPoint[0]-prevMeanPoint[0])*(meanPoint[0]-prevMeanPoint[0])
+                        + (meanPoint[1]-prevMeanPoint[1])*(meanPoint[1]-prevMeanPoint[1])
+                        + (meanPoint[2]-prevMeanPoint[2])*(meanPoint[2]-prevMeanPoint[2]) );
+    }
+  this->CachedCurvatureCurvePoints.swap(curvePoints);
+  this->CachedCurvatureCurveIsClosed = this->CurveIsClosed;
+
   // Initialize curvature variables
   double minKappa = 0.0;
   double maxKappa = 0.0;
   double meanKappa = 0.0; // Mean is weighted by the length of each segment
-
-  // Get values for first point
-  double prevPoint[3] = {points->GetPoint(linePoints->GetId(0))[0], points->GetPoint(linePoints->GetId(0))[1], points->GetPoint(linePoints->GetId(0))[2]}; // pp
-  double* currPoint = points->GetPoint(linePoints->GetId(1)); // p
-  double diffVector[3] = {currPoint[0]-prevPoint[0], currPoint[1]-prevPoint[1], currPoint[2]-prevPoint[2]};
-  double diffNorm = sqrt(diffVector[0]*diffVector[0] + diffVector[1]*diffVector[1] + diffVector[2]*diffVector[2]); // ds
-  double normDiffVector[3] = {0.0, 0.0, 0.0}; // T
-  double prevNormDiffVector[3] = {diffVector[0]/diffNorm, diffVector[1]/diffNorm, diffVector[2]/diffNorm}; // pT
-  double meanPoint[3] = {0.0, 0.0, 0.0}; // m
-  double prevMeanPoint[3] = {currPoint[0], currPoint[1], currPoint[2]}; // pm (Skip first point)
-  double kappa = 0.0;
-  double currentLength = 0.0;
   double length = 0.0;
 
   // The curvature for the first cell is 0.0 for open curves
   curvatureValues->InsertValue(linePoints->GetId(0), 0.0);
 
-  prevPoint[0] = currPoint[0]; prevPoint[1] = currPoint[1]; prevPoint[2] = currPoint[2];
   for (vtkIdType idx=1; idx<numberOfPoints-1; ++idx)
     {
-    currPoint = points->GetPoint(linePoints->GetId(idx+1));
-
-    diffVector[0] = currPoint[0]-prevPoint[0];
-    diffVector[1] = currPoint[1]-prevPoint[1];
-    diffVector[2] = currPoint[2]-prevPoint[2];
-    diffNorm = sqrt(diffVector[0]*diffVector[0] + diffVector[1]*diffVector[1] + diffVector[2]*diffVector[2]);
-
-    normDiffVector[0] = diffVector[0] / diffNorm;
-    normDiffVector[1] = diffVector[1] / diffNorm;
-    normDiffVector[2] = diffVector[2] / diffNorm;
-
-    // Local curvature
-    kappa = sqrt( (normDiffVector[0]-prevNormDiffVector[0])*(normDiffVector[0]-prevNormDiffVector[0])
-                + (normDiffVector[1]-prevNormDiffVector[1])*(normDiffVector[1]-prevNormDiffVector[1])
-                + (normDiffVector[2]-prevNormDiffVector[2])*(normDiffVector[2]-prevNormDiffVector[2]) )
-            / diffNorm;
+    double kappa = this->CachedCurvatures[idx];
+    double currentLength = this->CachedCurvatureLengths[idx];
     curvatureValues->InsertValue(linePoints->GetId(idx), kappa);
 
     // Statistics
-    meanPoint[0] = (currPoint[0]+prevPoint[0]) / 2.0;
-    meanPoint[1] = (currPoint[1]+prevPoint[1]) / 2.0;
-    meanPoint[2] = (currPoint[2]+prevPoint[2]) / 2.0;
-
-    currentLength = sqrt( (meanPoint[0]-prevMeanPoint[0])*(meanPoint[0]-prevMeanPoint[0])
-                        + (meanPoint[1]-prevMeanPoint[1])*(meanPoint[1]-prevMeanPoint[1])
-                        + (meanPoint[2]-prevMeanPoint[2])*(meanPoint[2]-prevMeanPoint[2]) );
     if (kappa < minKappa)
       {
       minKappa = kappa;
@@ -277,14 +328,6 @@ bool vtkCurveMeasurementsCalculator::CalculatePolyDataCurvature(vtkPolyData* pol
       }
     meanKappa += kappa * currentLength; // weighted mean
     length += currentLength;
-
-    // Propagate current values to previous
-    for (int i=0; i<3; ++i)
-      {
-      prevPoint[i] = currPoint[i];
-      prevMeanPoint[i] = meanPoint[i];
-      prevNormDiffVector[i] = normDiffVector[i];
-      }
     } // For each line point
 
   if (!this->CurveIsClosed)
@@ -301,9 +344,13 @@ bool vtkCurveMeasurementsCalculator::CalculatePolyDataCurvature(vtkPolyData* pol
       curvatureValues->GetValue(linePoints->GetId(numberOfPoints-2)));
     }
 
-  currentLength = sqrt( (prevPoint[0]-prevMeanPoint[0])*(prevPoint[0]-prevMeanPoint[0])
-                      + (prevPoint[1]-prevMeanPoint[1])*(prevPoint[1]-prevMeanPoint[1])
-                      + (prevPoint[2]-prevMeanPoint[2])*(prevPoint[2]-prevMeanPoint[2]) );
+  // Length from the center of the last segment to the last point
+  const double* lastPoint = &this->CachedCurvatureCurvePoints[(numberOfPoints - 1) * 3];
+  const double* beforeLastPoint = &this->CachedCurvatureCurvePoints[(numberOfPoints - 2) * 3];
+  double lastMeanPoint[3] = {(lastPoint[0]+beforeLastPoint[0]) / 2.0, (lastPoint[1]+beforeLastPoint[1]) / 2.0, (lastPoint[2]+beforeLastPoint[2]) / 2.0};
+  double currentLength = sqrt( (lastPoint[0]-lastMeanPoint[0])*(lastPoint[0]-lastMeanPoint[0])
+                      + (lastPoint[1]-lastMeanPoint[1])*(lastPoint[1]-lastMeanPoint[1])
+                      + (lastPoint[2]-lastMeanPoint[2])*(lastPoint[2]-lastMeanPoint[2]) );
   length += currentLength;
   if (length > 0.0)
     {
@@ -25,6 +25,9 @@
 #include <vtkSetGet.h>
 #include <vtkWeakPointer.h>
 
+// STD includes
+#include <vector>
+
 // Markups MRML includes
 #include <vtkMRMLMarkupsNode.h>
 
@@ -133,6 +136,14 @@ protected:
   std::string CurvatureUnits{"mm-1"};
   std::string TorsionUnits{"mm-1"};
 
+  /// Curve points (in the order of the curve line) and corresponding curvature and
+  /// length weight values of the last curvature computation.
+  /// Used for only recomputing the curvature where the curve points changed.
+  std::vector<double> CachedCurvatureCurvePoints;
+  std::vector<double> CachedCurvatures;
+  std::vector<double> CachedCurvatureLengths;
+  bool CachedCurvatureCurveIsClosed{false};
+
 protected:
   int FillInputPortInformation(int port, vtkInformation* info) override;
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector) override;
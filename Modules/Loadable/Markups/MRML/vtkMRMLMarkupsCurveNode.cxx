@@ -30,6 +30,9 @@
 #include "vtkProjectMarkupsCurvePointsFilter.h"
 #include "vtkSlicerDijkstraGraphGeodesicPath.h"
 
+// vtkAddon includes
+#include <vtkAddonMathUtilities.h>
+
 // VTK includes
 #include <vtkArrayCalculator.h>
 #include <vtkAssignAttribute.h>
@@ -56,6 +59,7 @@
 #include <vtkPolyData.h>
 #include <vtkPolyDataNormals.h>
 #include <vtkStringArray.h>
+#include <vtkTransform.h>
 #include <vtkTransformPolyDataFilter.h>
 #include <vtkTriangleFilter.h>
 
@@ -1342,15 +1346,29 @@ void vtkMRMLMarkupsCurveNode::OnSurfaceModelTransformChanged()
     return;
     }
 
-  vtkSmartPointer<vtkGeneralTransform> surfaceToLocalTransform = vtkGeneralTransform::SafeDownCast(
+  vtkNew<vtkGeneralTransform> newSurfaceToLocalTransform;
+  vtkMRMLTransformNode::GetTransformBetweenNodes(modelNode->GetParentTransformNode(), this->GetParentTransformNode(), newSurfaceToLocalTransform);
+
+  // Modifying the transform would transform the entire surface again and the surface graph
+  // used for shortest path computation would need to be rebuilt, so only update the transform
+  // if it has actually changed (e.g., the surface and curve are under the same transform
+  // then the transform between them does not change when the parent transform is modified).
+  vtkGeneralTransform* surfaceToLocalTransform = vtkGeneralTransform::SafeDownCast(
     this->SurfaceToLocalTransformer->GetTransform());
-  if (!surfaceToLocalTransform)
+  if (surfaceToLocalTransform)
     {
-    surfaceToLocalTransform = vtkSmartPointer<vtkGeneralTransform>::New();
-    this->SurfaceToLocalTransformer->SetTransform(surfaceToLocalTransform);
+    vtkNew<vtkTransform> surfaceToLocalLinearTransform;
+    vtkNew<vtkTransform> newSurfaceToLocalLinearTransform;
+    if (vtkMRMLTransformNode::IsGeneralTransformLinear(surfaceToLocalTransform, surfaceToLocalLinearTransform)
+      && vtkMRMLTransformNode::IsGeneralTransformLinear(newSurfaceToLocalTransform, newSurfaceToLocalLinearTransform)
+      && vtkAddonMathUtilities::MatrixAreEqual(surfaceToLocalLinearTransform->GetMatrix(), newSurfaceToLocalLinearTransform->GetMatrix(), 1e-6))
+      {
+      // no change
+      return;
+      }
     }
 
-  vtkMRMLTransformNode::GetTransformBetweenNodes(modelNode->GetParentTransformNode(), this->GetParentTransformNode(), surfaceToLocalTransform);
+  this->SurfaceToLocalTransformer->SetTransform(newSurfaceToLocalTransform);
 }
 
 //---------------------------------------------------------------------------
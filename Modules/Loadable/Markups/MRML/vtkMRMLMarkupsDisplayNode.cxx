@@ -340,7 +340,7 @@ void vtkMRMLMarkupsDisplayNode::CopyContent(vtkMRMLNode* anode, bool deepCopy/*=
   vtkMRMLCopyBooleanMacro(OccludedVisibility);
   vtkMRMLCopyFloatMacro(OccludedOpacity);
   // The name is misleading, this ShallowCopy method actually creates a deep copy
-  this->TextProperty->ShallowCopy(this->SafeDownCast(copySourceNode)->GetTextProperty());
+  this->TextProperty->ShallowCopy(copySourceNode->GetTextProperty());
   vtkMRMLCopyVectorMacro(ActiveColor, double, 3);
   vtkMRMLCopyVectorMacro(RotationHandleComponentVisibility, bool, 4);
   vtkMRMLCopyVectorMacro(ScaleHandleComponentVisibility, bool, 4);
@@ -23,6 +23,17 @@
 #define RAPIDJSON_WRITE_DEFAULT_FLAGS 2
 // kParseNanAndInfFlag = 256,      //!< Allow parsing NaN, Inf, Infinity, -Inf and -Infinity as doubles.
 #define RAPIDJSON_PARSE_DEFAULT_FLAGS 256
+// Use SIMD instructions for skipping whitespace (pretty-printed files contain
+// lots of indentation). Only used when parsing from an in-memory buffer.
+#if !defined(RAPIDJSON_SSE2) && !defined(RAPIDJSON_SSE42) && !defined(RAPIDJSON_NEON)
+# if defined(__SSE4_2__)
+#  define RAPIDJSON_SSE42
+# elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define RAPIDJSON_SSE2
+# elif defined(__ARM_NEON)
+#  define RAPIDJSON_NEON
+# endif
+#endif
 
 #include "rapidjson/document.h" // rapidjson's DOM-style API
 #include "rapidjson/prettywriter.h" // for stringify JSON
@@ -109,98 +120,81 @@ bool vtkMRMLMarkupsJsonElement::HasMember(const char* propertyName)
 //----------------------------------------------------------------------------
 std::string vtkMRMLMarkupsJsonElement::GetStringProperty(const char* propertyName)
 {
-  if (!this->Internal->JsonValue.HasMember(propertyName))
+  rapidjson::Value::MemberIterator member = this->Internal->JsonValue.FindMember(propertyName);
+  if (member == this->Internal->JsonValue.MemberEnd() || !member->value.IsString())
     {
     return "";
     }
-  if (!this->Internal->JsonValue[propertyName].IsString())
-    {
-    return "";
-    }
-  return this->Internal->JsonValue[propertyName].GetString();
+  return member->value.GetString();
 }
 
 //----------------------------------------------------------------------------
 bool vtkMRMLMarkupsJsonElement::GetStringProperty(const char* propertyName, std::string& propertyValue)
 {
-  if (!this->Internal->JsonValue.HasMember(propertyName))
+  rapidjson::Value::MemberIterator member = this->Internal->JsonValue.FindMember(propertyName);
+  if (member == this->Internal->JsonValue.MemberEnd() || !member->value.IsString())
     {
     return false;
     }
-  if (!this->Internal->JsonValue[propertyName].IsString())
-    {
-    return false;
-    }
-  propertyValue = this->Internal->JsonValue[propertyName].GetString();
+  propertyValue = member->value.GetString();
   return true;
 }
 
 //----------------------------------------------------------------------------
 bool vtkMRMLMarkupsJsonElement::GetDoubleProperty(const char* propertyName, double& propertyValue)
 {
-  if (!this->Internal->JsonValue.HasMember(propertyName))
+  rapidjson::Value::MemberIterator member = this->Internal->JsonValue.FindMember(propertyName);
+  if (member == this->Internal->JsonValue.MemberEnd() || !member->value.IsDouble())
     {
     return false;
     }
-  if (!this->Internal->JsonValue[propertyName].IsDouble())
-    {
-    return false;
-    }
-  propertyValue = this->Internal->JsonValue[propertyName].GetDouble();
+  propertyValue = member->value.GetDouble();
   return true;
 }
 
 //----------------------------------------------------------------------------
 double vtkMRMLMarkupsJsonElement::GetDoubleProperty(const char* propertyName)
 {
-  if (!this->Internal->JsonValue.HasMember(propertyName))
-    {
-    return 0.0;
-    }
-  if (!this->Internal->JsonValue[propertyName].IsDouble())
+  rapidjson::Value::MemberIterator member = this->Internal->JsonValue.FindMember(propertyName);
+  if (member == this->Internal->JsonValue.MemberEnd() || !member->value.IsDouble())
     {
     return 0.0;
     }
-  return this->Internal->JsonValue[propertyName].GetDouble();
+  return member->value.GetDouble();
 }
 
 //----------------------------------------------------------------------------
 bool vtkMRMLMarkupsJsonElement::GetIntProperty(const char* propertyName, int& propertyValue)
 {
-  if (!this->Internal->JsonValue.HasMember(propertyName))
-    {
-    return false;
-    }
-  if (!this->Internal->JsonValue[propertyName].IsInt())
+  rapidjson::Value::MemberIterator member = this->Internal->JsonValue.FindMember(propertyName);
+  if (member == this->Internal->JsonValue.MemberEnd() || !member->value.IsInt())
     {
     return false;
     }
-  propertyValue = this->Internal->JsonValue[propertyName].GetInt();
+  propertyValue = member->value.GetInt();
   return true;
 }
 
 //----------------------------------------------------------------------------
 int vtkMRMLMarkupsJsonElement::GetIntProperty(const char* propertyName)
 {
-  if (!this->Internal->JsonValue.HasMember(propertyName))
+  rapidjson::Value::MemberIterator member = this->Internal->JsonValue.FindMember(propertyName);
+  if (member == this->Internal->JsonValue.MemberEnd() || !member->value.IsInt())
     {
     return 0;
     }
-  if (!this->Internal->JsonValue[propertyName].IsInt())
-    {
-    return 0;
-    }
-  return this->Internal->JsonValue[propertyName].GetInt();
+  return member->value.GetInt();
 }
 
 //----------------------------------------------------------------------------
 bool vtkMRMLMarkupsJsonElement::GetBoolProperty(const char* propertyName)
 {
-  if (!this->Internal->JsonValue.HasMember(propertyName))
+  rapidjson::Value::MemberIterator member = this->Internal->JsonValue.FindMember(propertyName);
+  if (member == this->Internal->JsonValue.MemberEnd())
     {
     return false;
     }
-  return this->Internal->JsonValue[propertyName].GetBool();
+  return member->value.GetBool();
 }
 
 
@@ -354,12 +348,12 @@ std::string vtkMRMLMarkupsJsonElement::GetSchema()
 //----------------------------------------------------------------------------
 bool vtkMRMLMarkupsJsonElement::GetVectorProperty(const char* propertyName, double* v, int numberOfComponents/*=3*/)
 {
-  if (!this->Internal->JsonValue.HasMember(propertyName))
+  rapidjson::Value::MemberIterator member = this->Internal->JsonValue.FindMember(propertyName);
+  if (member == this->Internal->JsonValue.MemberEnd())
     {
     return false;
     }
-  rapidjson::Value& item = this->Internal->JsonValue[propertyName];
-  return this->Internal->ReadVector(item, v, numberOfComponents);
+  return this->Internal->ReadVector(member->value, v, numberOfComponents);
 }
 
 //----------------------------------------------------------------------------
@@ -387,11 +381,12 @@ bool vtkMRMLMarkupsJsonElement::GetMatrix4x4Property(const char* propertyName, d
 //----------------------------------------------------------------------------
 bool vtkMRMLMarkupsJsonElement::GetStringVectorProperty(const char* propertyName, std::vector<std::string>& arrayValues)
 {
-  if (!this->Internal->JsonValue.HasMember(propertyName))
+  rapidjson::Value::MemberIterator member = this->Internal->JsonValue.FindMember(propertyName);
+  if (member == this->Internal->JsonValue.MemberEnd())
     {
     return false;
     }
-  rapidjson::Value& item = this->Internal->JsonValue[propertyName];
+  rapidjson::Value& item = member->value;
   if (!item.IsArray())
     {
     return false;
@@ -419,11 +414,12 @@ bool vtkMRMLMarkupsJsonElement::HasErrors()
 //----------------------------------------------------------------------------
 vtkDoubleArray* vtkMRMLMarkupsJsonElement::GetDoubleArrayProperty(const char* propertyName)
 {
-  if (!this->Internal->JsonValue.HasMember(propertyName))
+  rapidjson::Value::MemberIterator member = this->Internal->JsonValue.FindMember(propertyName);
+  if (member == this->Internal->JsonValue.MemberEnd())
     {
     return nullptr;
     }
-  rapidjson::Value& arrayItem = this->Internal->JsonValue[propertyName];
+  rapidjson::Value& arrayItem = member->value;
   if (!arrayItem.IsArray())
     {
     vtkErrorToMessageCollectionWithObjectMacro(this, this->GetUserMessages(),
@@ -443,7 +439,7 @@ vtkDoubleArray* vtkMRMLMarkupsJsonElement::GetDoubleArrayProperty(const char* pr
     {
     values->SetNumberOfValues(numberOfTuples);
     double* valuesPtr = values->GetPointer(0);
-    bool success = this->GetVectorProperty(propertyName, valuesPtr, numberOfTuples);
+    bool success = this->Internal->ReadVector(arrayItem, valuesPtr, numberOfTuples);
     if (!success)
       {
       vtkErrorToMessageCollectionWithObjectMacro(this, this->GetUserMessages(),
@@ -518,7 +514,7 @@ vtkMRMLMarkupsJsonElement* vtkMRMLMarkupsJsonReader::ReadFromFile(const char* fi
     }
 
   // Read document from file
-  FILE* fp = fopen(filePath, "r");
+  FILE* fp = fopen(filePath, "rb");
   if (!fp)
     {
     vtkErrorToMessageCollectionWithObjectMacro(this, this->GetUserMessages(),
@@ -531,17 +527,32 @@ vtkMRMLMarkupsJsonElement* vtkMRMLMarkupsJsonReader::ReadFromFile(const char* fi
 
   jsonElement->Internal->JsonRoot = std::make_shared<vtkMRMLMarkupsJsonElement::vtkInternal::JsonDocumentContainer>();
 
-  char buffer[4096];
-  rapidjson::FileReadStream fs(fp, buffer, sizeof(buffer));
-  if (jsonElement->Internal->JsonRoot->Document->ParseStream(fs).HasParseError())
+  // The whole file is loaded into memory and parsed in-situ. This avoids copying
+  // of all the strings and allows using SIMD instructions for skipping whitespace,
+  // which makes reading of files with many control points much faster.
+  std::vector<char>& buffer = jsonElement->Internal->JsonRoot->Buffer;
+  fseek(fp, 0, SEEK_END);
+  long fileSize = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  if (fileSize < 0)
     {
     vtkErrorToMessageCollectionWithObjectMacro(this, this->GetUserMessages(),
       "vtkMRMLMarkupsJsonIO::ReadFromFile",
-      "Error parsing the file '" << filePath << "'");
+      "Error reading the file '" << filePath << "'");
     fclose(fp);
     return nullptr;
     }
+  buffer.resize(static_cast<size_t>(fileSize) + 1);
+  size_t readSize = fread(buffer.data(), 1, static_cast<size_t>(fileSize), fp);
   fclose(fp);
+  buffer[readSize] = '\0';
+  if (jsonElement->Internal->JsonRoot->Document->ParseInsitu(buffer.data()).HasParseError())
+    {
+    vtkErrorToMessageCollectionWithObjectMacro(this, this->GetUserMessages(),
+      "vtkMRMLMarkupsJsonIO::ReadFromFile",
+      "Error parsing the file '" << filePath << "'");
+    return nullptr;
+    }
 
   if (jsonElement->Internal->JsonRoot->Document->IsObject())
     {
@@ -651,8 +662,8 @@ bool vtkMRMLMarkupsJsonWriter::WriteToFileBegin(const char* filePath, const char
 //----------------------------------------------------------------------------
 void vtkMRMLMarkupsJsonWriter::WriteStringProperty(const std::string& propertyName, const std::string& propertyValue)
 {
-  this->Internal->Writer->Key(propertyName.c_str());
-  this->Internal->Writer->String(propertyValue.c_str());
+  this->Internal->Writer->Key(propertyName.c_str(), static_cast<rapidjson::SizeType>(propertyName.size()));
+  this->Internal->Writer->String(propertyValue.c_str(), static_cast<rapidjson::SizeType>(propertyValue.size()));
 }
 
 //----------------------------------------------------------------------------
@@ -32,6 +32,17 @@
 #define RAPIDJSON_WRITE_DEFAULT_FLAGS 2
 // kParseNanAndInfFlag = 256,      //!< Allow parsing NaN, Inf, Infinity, -Inf and -Infinity as doubles.
 #define RAPIDJSON_PARSE_DEFAULT_FLAGS 256
+// Use SIMD instructions for skipping whitespace (pretty-printed files contain
+// lots of indentation). Only used when parsing from an in-memory buffer.
+#if !defined(RAPIDJSON_SSE2) && !defined(RAPIDJSON_SSE42) && !defined(RAPIDJSON_NEON)
+# if defined(__SSE4_2__)
+#  define RAPIDJSON_SSE42
+# elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define RAPIDJSON_SSE2
+# elif defined(__ARM_NEON)
+#  define RAPIDJSON_NEON
+# endif
+#endif
 
 #include "rapidjson/document.h"     // rapidjson's DOM-style API
 #include "rapidjson/prettywriter.h" // for stringify JSON
@@ -40,6 +51,7 @@
 
 #include <deque>
 #include <memory>
+#include <vector>
 
 //---------------------------------------------------------------------------
 class vtkMRMLMarkupsJsonElement::vtkInternal
@@ -61,6 +73,9 @@ public:
     JsonDocumentContainer(const JsonDocumentContainer&) = delete;
     JsonDocumentContainer& operator= (const JsonDocumentContainer&) = delete;
     rapidjson::Document* Document;
+    // The document is parsed in-situ from this buffer, therefore
+    // strings in the document point into this buffer.
+    std::vector<char> Buffer;
     };
 
   // Helper methods
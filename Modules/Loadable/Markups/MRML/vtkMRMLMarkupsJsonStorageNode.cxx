@@ -49,6 +49,16 @@ namespace
     "https://raw.githubusercontent.com/slicer/slicer/master/Modules/Loadable/Markups/Resources/Schema/markups-schema-v1.0.3.json#";
   // regex should be lower case
   const std::string ACCEPTED_MARKUPS_SCHEMA_REGEX = ".*markups-schema-v1\\.[0-9]+\\.[0-9]+\\.json#*$";
+
+  // Delete control points that have not been added to a markups node
+  void DeleteControlPoints(vtkMRMLMarkupsNode::ControlPointsListType& controlPoints)
+  {
+    for (vtkMRMLMarkupsNode::ControlPoint* controlPoint : controlPoints)
+      {
+      delete controlPoint;
+      }
+    controlPoints.clear();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -720,11 +730,15 @@ bool vtkMRMLMarkupsJsonStorageNode::ReadControlPoints(vtkMRMLMarkupsJsonElement*
   bool wasUpdatingPoints = markupsNode->IsUpdatingPoints;
   markupsNode->IsUpdatingPoints = true;
   int numberOfControlPoints = controlPointsArray->GetArraySize();
+  // Control points are collected and added at once, so that curve and measurements are only updated once
+  vtkMRMLMarkupsNode::ControlPointsListType controlPoints;
+  controlPoints.reserve(numberOfControlPoints);
   for (int controlPointIndex = 0; controlPointIndex < numberOfControlPoints; ++controlPointIndex)
     {
     vtkSmartPointer<vtkMRMLMarkupsJsonElement> controlPointItem
       = vtkSmartPointer<vtkMRMLMarkupsJsonElement>::Take(controlPointsArray->GetArrayItem(controlPointIndex));
     vtkMRMLMarkupsNode::ControlPoint* cp = new vtkMRMLMarkupsNode::ControlPoint;
+    controlPoints.push_back(cp);
     controlPointItem->GetStringProperty("id", cp->ID);
     controlPointItem->GetStringProperty("label", cp->Label);
     controlPointItem->GetStringProperty("description", cp->Description);
@@ -741,6 +755,8 @@ bool vtkMRMLMarkupsJsonStorageNode::ReadControlPoints(vtkMRMLMarkupsJsonElement*
           "vtkMRMLMarkupsJsonStorageNode::ReadControlPoints",
           "File reading failed: invalid positionStatus '" << positionStatusStr
           << "' for control point " << controlPointIndex + 1 << ".");
+        DeleteControlPoints(controlPoints);
+        markupsNode->IsUpdatingPoints = wasUpdatingPoints;
         return false;
         }
       cp->PositionStatus = positionStatus;
@@ -758,6 +774,8 @@ bool vtkMRMLMarkupsJsonStorageNode::ReadControlPoints(vtkMRMLMarkupsJsonElement*
         "vtkMRMLMarkupsJsonStorageNode::ReadControlPoints",
         "File reading failed: position must be a 3-element numeric array"
         << " for control point " << controlPointIndex + 1 << ".");
+      DeleteControlPoints(controlPoints);
+      markupsNode->IsUpdatingPoints = wasUpdatingPoints;
       return false;
       }
     if (hasPosition)
@@ -787,6 +805,8 @@ bool vtkMRMLMarkupsJsonStorageNode::ReadControlPoints(vtkMRMLMarkupsJsonElement*
         "vtkMRMLMarkupsJsonStorageNode::ReadControlPoints",
         "File reading failed: orientation must be a 9-element numeric array"
         << " for control point " << controlPointIndex + 1 << ".");
+      DeleteControlPoints(controlPoints);
+      markupsNode->IsUpdatingPoints = wasUpdatingPoints;
       return false;
       }
     if (hasOrientation)
@@ -812,7 +832,11 @@ bool vtkMRMLMarkupsJsonStorageNode::ReadControlPoints(vtkMRMLMarkupsJsonElement*
       {
       cp->Visibility = controlPointItem->GetBoolProperty("visibility");
       }
-    markupsNode->AddControlPoint(cp, false);
+    }
+  if (markupsNode->AddControlPoints(controlPoints, false) < 0)
+    {
+    // points could not be added (e.g., too many points)
+    DeleteControlPoints(controlPoints);
     }
 
   markupsNode->IsUpdatingPoints = wasUpdatingPoints;
@@ -300,6 +300,10 @@ int vtkMRMLMarkupsNode::EndModify(int previousDisableModifiedEventState)
     {
     this->UpdateCurvePolyFromControlPoints();
     this->UpdateInteractionHandleToWorldMatrix();
+    if (this->GetDisplayNode())
+      {
+      this->GetDisplayNode()->UpdateScalarRange();
+      }
     }
 
   int wasModified = Superclass::EndModify(previousDisableModifiedEventState);
@@ -662,6 +666,67 @@ int vtkMRMLMarkupsNode::AddControlPoint(ControlPoint *controlPoint, bool autoLab
   return controlPointIndex;
 }
 
+//-----------------------------------------------------------
+int vtkMRMLMarkupsNode::AddControlPoints(const ControlPointsListType& controlPoints, bool autoLabel/*=true*/)
+{
+  int numberOfNewControlPoints = static_cast<int>(controlPoints.size());
+  if (this->MaximumNumberOfControlPoints >= 0 &&
+      this->GetNumberOfControlPoints() + numberOfNewControlPoints > this->MaximumNumberOfControlPoints)
+    {
+    vtkErrorMacro("AddControlPoints: number of existing points (" << this->GetNumberOfControlPoints()
+      << ") plus number of new points (" << numberOfNewControlPoints << ") are more than maximum number of control points allowed ("
+      << this->MaximumNumberOfControlPoints << ")");
+    return -1;
+    }
+  if (this->GetFixedNumberOfControlPoints())
+    {
+    vtkErrorMacro("AddControlPoints: Markup node control point number is locked.");
+    return -1;
+    }
+  if (numberOfNewControlPoints == 0)
+    {
+    return this->GetNumberOfControlPoints() - 1;
+    }
+
+  // Modified events are merged, and curve, scalar range, and measurements
+  // are only updated once, in EndModify().
+  int wasModified = this->StartModify();
+
+  this->ControlPoints.reserve(this->ControlPoints.size() + controlPoints.size());
+  bool positionsDefined = false;
+  bool positionsMissing = false;
+  for (ControlPoint* controlPoint : controlPoints)
+    {
+    // generate a unique id based on list policy
+    if (controlPoint->ID.empty())
+      {
+      controlPoint->ID = this->GenerateUniqueControlPointID();
+      }
+    if (controlPoint->Label.empty() && autoLabel)
+      {
+      controlPoint->Label = this->GenerateControlPointLabel(this->LastUsedControlPointNumber);
+      }
+    positionsDefined |= (controlPoint->PositionStatus == PositionDefined);
+    positionsMissing |= (controlPoint->PositionStatus == PositionMissing);
+    this->ControlPoints.push_back(controlPoint);
+    }
+
+  this->InvokeCustomModifiedEvent(vtkMRMLMarkupsNode::PointAddedEvent);
+  this->InvokeCustomModifiedEvent(vtkMRMLMarkupsNode::PointModifiedEvent);
+  if (positionsDefined)
+    {
+    this->InvokeCustomModifiedEvent(vtkMRMLMarkupsNode::PointPositionDefinedEvent);
+    }
+  if (positionsMissing)
+    {
+    this->InvokeCustomModifiedEvent(vtkMRMLMarkupsNode::PointPositionMissingEvent);
+    }
+  this->StorableModifiedTime.Modified();
+
+  this->EndModify(wasModified);
+  return this->GetNumberOfControlPoints() - 1;
+}
+
 //-----------------------------------------------------------
 int vtkMRMLMarkupsNode::AddNControlPoints(int n, std::string label, double point[3])
 {
@@ -1062,10 +1127,11 @@ void vtkMRMLMarkupsNode::SetNthControlPointPosition(const int pointIndex,
   if (!this->GetDisableModifiedEvent())
     {
     this->UpdateAllMeasurements();
-    }
-  if (this->GetDisplayNode())
-    {
-    this->GetDisplayNode()->UpdateScalarRange();
+    // scalar range is updated in EndModify() if modified events are disabled
+    if (this->GetDisplayNode())
+      {
+      this->GetDisplayNode()->UpdateScalarRange();
+      }
     }
 }
 
@@ -2490,32 +2556,105 @@ void vtkMRMLMarkupsNode::SetControlPointPositionsWorld(vtkPoints* points, bool s
   int wasModified = this->StartModify();
   this->IsUpdatingPoints = true;
 
+  // Get the transform once for all points (creating the transform chain for each point
+  // would take significant time for large point lists).
+  vtkSmartPointer<vtkGeneralTransform> worldToNodeTransform;
+  if (this->GetParentTransformNode())
+    {
+    worldToNodeTransform = vtkSmartPointer<vtkGeneralTransform>::New();
+    this->GetParentTransformNode()->GetTransformFromWorld(worldToNodeTransform);
+    }
+
   vtkIdType numberOfPoints = points->GetNumberOfPoints();
-  for (vtkIdType pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
+  vtkIdType numberOfExistingPoints = std::min(numberOfPoints, static_cast<vtkIdType>(this->ControlPoints.size()));
+
+  // Update existing points.
+  // Control point structures are updated directly, as pointwise modified events would be
+  // merged into a single event anyway, and display node scalar range is updated only once.
+  bool positionChanged = false;
+  bool positionsDefined = false;
+  bool positionsNonMissing = false;
+  for (vtkIdType pointIndex = 0; pointIndex < numberOfExistingPoints; pointIndex++)
+    {
+    ControlPoint* controlPoint = this->ControlPoints[pointIndex];
+    if (!setUndefinedPoints && controlPoint->PositionStatus != PositionDefined)
+      {
+      continue;
+      }
+    double* posWorld = points->GetPoint(pointIndex);
+    if (worldToNodeTransform)
+      {
+      worldToNodeTransform->TransformPoint(posWorld, controlPoint->Position);
+      }
+    else
+      {
+      controlPoint->Position[0] = posWorld[0];
+      controlPoint->Position[1] = posWorld[1];
+      controlPoint->Position[2] = posWorld[2];
+      }
+    int oldPositionStatus = controlPoint->PositionStatus;
+    controlPoint->PositionStatus = PositionDefined;
+    positionsDefined |= (oldPositionStatus != PositionDefined);
+    positionsNonMissing |= (oldPositionStatus == PositionMissing);
+    positionChanged = true;
+    }
+  if (positionChanged)
+    {
+    this->InvokeCustomModifiedEvent(vtkMRMLMarkupsNode::PointModifiedEvent);
+    if (positionsDefined)
+      {
+      this->InvokeCustomModifiedEvent(vtkMRMLMarkupsNode::PointPositionDefinedEvent);
+      }
+    if (positionsNonMissing)
+      {
+      this->InvokeCustomModifiedEvent(vtkMRMLMarkupsNode::PointPositionNonMissingEvent);
+      }
+    this->StorableModifiedTime.Modified();
+    }
+
+  // Add new points
+  if (numberOfPoints > numberOfExistingPoints)
     {
+    this->ControlPoints.reserve(numberOfPoints);
+    }
+  for (vtkIdType pointIndex = numberOfExistingPoints; pointIndex < numberOfPoints; pointIndex++)
+    {
+    ControlPoint* controlPoint = new ControlPoint;
     double* posWorld = points->GetPoint(pointIndex);
-    if (pointIndex < this->GetNumberOfControlPoints())
+    if (worldToNodeTransform)
       {
-      // point already exists, just update it
-      if (setUndefinedPoints || this->GetNthControlPointPositionStatus(pointIndex) == PositionDefined)
-        {
-        this->SetNthControlPointPositionWorld(pointIndex, posWorld);
-        }
+      worldToNodeTransform->TransformPoint(posWorld, controlPoint->Position);
       }
     else
       {
-      // need to add a new point
-      vtkMRMLMarkupsNode::AddControlPointWorld(vtkVector3d(posWorld));
+      controlPoint->Position[0] = posWorld[0];
+      controlPoint->Position[1] = posWorld[1];
+      controlPoint->Position[2] = posWorld[2];
+      }
+    controlPoint->PositionStatus = PositionDefined;
+    if (this->AddControlPoint(controlPoint) < 0)
+      {
+      // maximum number of control points is reached or the number of points is locked
+      delete controlPoint;
+      break;
       }
     }
+
+  // Remove extra points
   while (this->GetNumberOfControlPoints() > numberOfPoints)
     {
-    this->RemoveNthControlPoint(this->GetNumberOfControlPoints() - 1);
+    int numberOfControlPointsBefore = this->GetNumberOfControlPoints();
+    this->RemoveNthControlPoint(numberOfControlPointsBefore - 1);
+    if (this->GetNumberOfControlPoints() == numberOfControlPointsBefore)
+      {
+      // number of points is locked
+      break;
+      }
     }
 
   this->IsUpdatingPoints = false;
-  // No need to call UpdateAllMeasurements(), because it is automatically
-  // called in EndModify().
+  // No need to call UpdateAllMeasurements() and update display node scalar range,
+  // because it is automatically done in EndModify().
   this->EndModify(wasModified);
 }
 
@@ -2526,13 +2665,27 @@ void vtkMRMLMarkupsNode::GetControlPointPositionsWorld(vtkPoints* points)
     {
     return;
     }
+  vtkSmartPointer<vtkGeneralTransform> nodeToWorldTransform;
+  if (this->GetParentTransformNode())
+    {
+    nodeToWorldTransform = vtkSmartPointer<vtkGeneralTransform>::New();
+    this->GetParentTransformNode()->GetTransformToWorld(nodeToWorldTransform);
+    }
   int numberOfControlPoints = this->GetNumberOfControlPoints();
   points->SetNumberOfPoints(numberOfControlPoints);
   double posWorld[3] = { 0.0, 0.0, 0.0 };
   for (int controlPointIndex = 0; controlPointIndex < numberOfControlPoints; controlPointIndex++)
     {
-    this->GetNthControlPointPositionWorld(controlPointIndex, posWorld);
-    points->SetPoint(controlPointIndex, posWorld);
+    const double* position = this->ControlPoints[controlPointIndex]->Position;
+    if (nodeToWorldTransform)
+      {
+      nodeToWorldTransform->TransformPoint(position, posWorld);
+      points->SetPoint(controlPointIndex, posWorld);
+      }
+    else
+      {
+      points->SetPoint(controlPointIndex, position);
+      }
     }
 }
 
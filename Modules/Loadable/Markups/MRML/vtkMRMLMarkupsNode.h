@@ -313,6 +313,8 @@ public:
   /// New control points are added if needed.
   /// Existing control points are updated with the new positions.
   /// Any extra existing control points are removed.
+  /// Modified events are only invoked once for the whole operation,
+  /// therefore this is much faster than setting positions point by point.
   void SetControlPointPositionsWorld(vtkPoints* points, bool setUndefinedPoints=true);
 
   /// Get a copy of all control point positions in world coordinate system
@@ -332,6 +334,15 @@ public:
   /// replaced with automatically generated label.
   int AddControlPoint(ControlPoint *controlPoint, bool autoLabel=true);
 
+  /// Add multiple control points to the end of the list. Return index of the last
+  /// control point, -1 on failure (in this case no points are added).
+  /// Modified events are invoked only once and curve and measurements are updated once,
+  /// therefore this is much faster than adding a large number of points one by one.
+  /// Markups node takes over ownership of the pointers if the points are added successfully.
+  /// \param autoLabel: if enabled (by default it is) then empty point labels will be
+  /// replaced with automatically generated labels.
+  int AddControlPoints(const ControlPointsListType& controlPoints, bool autoLabel=true);
+
   ///@{
   /// Add a new control point, defined in the world coordinate system.
   /// Return index of point index, -1 on failure.
@@ -43,9 +43,12 @@
 #include <vtkPlane.h>
 #include <vtkPlanes.h>
 #include <vtkPointData.h>
+#include <vtkPoints.h>
 #include <vtkPolyData.h>
+#include <vtkSMPTools.h>
 #include <vtkTransform.h>
 #include <vtkTransformPolyDataFilter.h>
+#include <vtkUnsignedCharArray.h>
 
 const int NUMBER_OF_BOX_CONTROL_POINTS = 2; // 2 points used for initial ROI definition, then removed
 const int NUMBER_OF_BOUNDING_BOX_CONTROL_POINTS = -1; // Any number of points
@@ -1333,6 +1336,92 @@ bool vtkMRMLMarkupsROINode::IsPointInROIWorld(double point_World[3])
   return this->ImplicitFunctionWorld->FunctionValue(point_World) <= 0;
 }
 
+//----------------------------------------------------------------------------
+vtkIdType vtkMRMLMarkupsROINode::GetPointsInROI(vtkPoints* points_Node, vtkUnsignedCharArray* pointsInROI)
+{
+  return this->GetPointsInROIInternal(points_Node, this->ObjectToNodeMatrix, this->ImplicitFunction, pointsInROI);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkMRMLMarkupsROINode::GetPointsInROIWorld(vtkPoints* points_World, vtkUnsignedCharArray* pointsInROI)
+{
+  return this->GetPointsInROIInternal(points_World, this->ObjectToWorldMatrix, this->ImplicitFunctionWorld, pointsInROI);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkMRMLMarkupsROINode::GetPointsInROIInternal(vtkPoints* points, vtkMatrix4x4* objectToPointsMatrix,
+  vtkImplicitFunction* implicitFunction, vtkUnsignedCharArray* pointsInROI)
+{
+  if (!points || !pointsInROI)
+    {
+    vtkErrorMacro("GetPointsInROI: Invalid input points or output array");
+    return 0;
+    }
+  vtkIdType numberOfPoints = points->GetNumberOfPoints();
+  pointsInROI->SetNumberOfComponents(1);
+  pointsInROI->SetNumberOfTuples(numberOfPoints);
+  unsigned char* pointsInROIPtr = pointsInROI->GetPointer(0);
+
+  if (this->ROIType != ROITypeBox && this->ROIType != ROITypeBoundingBox)
+    {
+    // Generic implementation, evaluating the implicit function.
+    // Implicit function evaluation is not thread-safe, therefore it is done sequentially.
+    vtkIdType numberOfPointsInROI = 0;
+    for (vtkIdType pointIndex = 0; pointIndex < numberOfPoints; ++pointIndex)
+      {
+      double point[3] = { 0.0, 0.0, 0.0 };
+      points->GetPoint(pointIndex, point);
+      bool inROI = (implicitFunction->FunctionValue(point) <= 0);
+      pointsInROIPtr[pointIndex] = inROI ? 1 : 0;
+      numberOfPointsInROI += inROI ? 1 : 0;
+      }
+    return numberOfPointsInROI;
+    }
+
+  // Transform points to the object coordinate system, where the box is axis-aligned and centered
+  // at the origin, so that the point can be checked against the half size along each axis.
+  vtkNew<vtkMatrix4x4> pointsToObjectMatrix;
+  vtkMatrix4x4::Invert(objectToPointsMatrix, pointsToObjectMatrix);
+  double m[3][4] = { { 0.0 } };
+  for (int row = 0; row < 3; ++row)
+    {
+    for (int column = 0; column < 4; ++column)
+      {
+      m[row][column] = pointsToObjectMatrix->GetElement(row, column);
+      }
+    }
+  const double halfSize[3] = { this->Size[0] / 2.0, this->Size[1] / 2.0, this->Size[2] / 2.0 };
+  const bool insideOut = this->InsideOut;
+
+  vtkSMPTools::For(0, numberOfPoints, [&](vtkIdType firstPointIndex, vtkIdType endPointIndex)
+    {
+    double point[3] = { 0.0, 0.0, 0.0 };
+    for (vtkIdType pointIndex = firstPointIndex; pointIndex < endPointIndex; ++pointIndex)
+      {
+      points->GetPoint(pointIndex, point);
+      bool inBox = true;
+      bool onBoundary = false;
+      for (int row = 0; row < 3; ++row)
+        {
+        double distance = fabs(m[row][0] * point[0] + m[row][1] * point[1] + m[row][2] * point[2] + m[row][3]);
+        inBox = inBox && (distance <= halfSize[row]);
+        onBoundary = onBoundary || (distance == halfSize[row]);
+        }
+      // Points on the boundary are considered to be in the ROI, both when inside out is enabled or disabled
+      // (consistently with IsPointInROI).
+      bool inROI = insideOut ? (!inBox || onBoundary) : inBox;
+      pointsInROIPtr[pointIndex] = inROI ? 1 : 0;
+      }
+    });
+
+  vtkIdType numberOfPointsInROI = 0;
+  for (vtkIdType pointIndex = 0; pointIndex < numberOfPoints; ++pointIndex)
+    {
+    numberOfPointsInROI += pointsInROIPtr[pointIndex];
+    }
+  return numberOfPointsInROI;
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLMarkupsROINode::GenerateOrthogonalMatrix(vtkMatrix4x4* inputMatrix,
   vtkMatrix4x4* outputMatrix, vtkAbstractTransform* transform/*=nullptr*/, bool applyScaling/*=true*/)
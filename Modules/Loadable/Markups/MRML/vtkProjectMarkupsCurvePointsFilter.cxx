@@ -30,9 +30,14 @@
 #include <vtkOBBTree.h>
 #include <vtkPolyDataNormals.h>
 #include <vtkPointData.h>
-#include <vtkPointLocator.h>
+#include <vtkSMPTools.h>
+#include <vtkStaticPointLocator.h>
 #include <vtkTransformPolyDataFilter.h>
 
+// STD includes
+#include <atomic>
+#include <vector>
+
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkProjectMarkupsCurvePointsFilter);
 
@@ -138,7 +143,7 @@ int vtkProjectMarkupsCurvePointsFilter::RequestData(
 }
 
 //---------------------------------------------------------------------------
-bool vtkProjectMarkupsCurvePointsFilter::ConstrainPointsToSurfaceImpl(vtkOBBTree* surfaceObbTree, vtkPointLocator* pointLocator,
+bool vtkProjectMarkupsCurvePointsFilter::ConstrainPointsToSurfaceImpl(vtkOBBTree* surfaceObbTree, vtkStaticPointLocator* pointLocator,
   vtkPoints* originalPoints, vtkDoubleArray* normalVectors, vtkPolyData* surfacePolydata,
   vtkPoints* surfacePoints, double maximumSearchRadiusTolerance)
 {
@@ -155,10 +160,6 @@ bool vtkProjectMarkupsCurvePointsFilter::ConstrainPointsToSurfaceImpl(vtkOBBTree
 
   double tolerance = surfaceObbTree->GetTolerance();
 
-  double originalPoint[3] = { 0.0, 0.0, 0.0 };
-  double rayDirection[3] = { 0.0, 0.0, 0.0 };
-  double exteriorPoint[3] = { 0.0, 0.0, 0.0 };
-
   // Curves are expected to be close to surface. The maximumSearchRadiusTolerance
   // sets the allowable projection distance as a percentage of the model's
   // bounding box diagonal in world coordinate system.
@@ -169,40 +170,54 @@ bool vtkProjectMarkupsCurvePointsFilter::ConstrainPointsToSurfaceImpl(vtkOBBTree
   double polydataDiagonalLength = modelBoundingBox.GetDiagonalLength();
   double rayLength = maximumSearchRadiusTolerance*sqrt(polydataDiagonalLength);
 
-  size_t noIntersectionCount = 0;
-  for (vtkIdType controlPointIndex = 0; controlPointIndex < originalPoints->GetNumberOfPoints(); controlPointIndex++)
+  // Points are projected in parallel. Both the OBB tree and the static point locator
+  // can be queried concurrently once they are built.
+  surfacePolydata->BuildCells();
+  vtkIdType numberOfPoints = originalPoints->GetNumberOfPoints();
+  vtkIdType firstSurfacePointIndex = surfacePoints->GetNumberOfPoints();
+  surfacePoints->SetNumberOfPoints(firstSurfacePointIndex + numberOfPoints);
+  std::atomic<vtkIdType> noIntersectionCount(0);
+  vtkSMPTools::For(0, numberOfPoints, [&](vtkIdType firstPointIndex, vtkIdType endPointIndex)
     {
-    originalPoints->GetPoint(controlPointIndex, originalPoint);
-    normalVectors->GetTuple(controlPointIndex, rayDirection);
-    // Cast ray and find model intersection point
-    double rayEndPoint[3] = { 0.0, 0.0, 0.0 };
-    rayEndPoint[0] = originalPoint[0] + rayDirection[0] * rayLength;
-    rayEndPoint[1] = originalPoint[1] + rayDirection[1] * rayLength;
-    rayEndPoint[2] = originalPoint[2] + rayDirection[2] * rayLength;
-
-    double t = 0.0;
-    double pcoords[3] = { 0.0, 0.0, 0.0 };
-    int subId = 0;
-    vtkIdType cellId = 0;
-    vtkNew <vtkGenericCell> cell;
-    int foundIntersection = surfaceObbTree->IntersectWithLine(rayEndPoint, originalPoint, tolerance, t, exteriorPoint, pcoords, subId, cellId, cell);
-    if(foundIntersection == 0)
+    vtkNew<vtkGenericCell> cell;
+    vtkIdType localNoIntersectionCount = 0;
+    for (vtkIdType controlPointIndex = firstPointIndex; controlPointIndex < endPointIndex; controlPointIndex++)
       {
-      // If no intersection, reverse direction of normal vector ray
-      rayEndPoint[0] = originalPoint[0] + rayDirection[0] * -rayLength;
-      rayEndPoint[1] = originalPoint[1] + rayDirection[1] * -rayLength;
-      rayEndPoint[2] = originalPoint[2] + rayDirection[2] * -rayLength;
-      int foundIntersection = surfaceObbTree->IntersectWithLine(originalPoint, rayEndPoint, tolerance, t, exteriorPoint, pcoords, subId, cellId, cell);
+      double originalPoint[3] = { 0.0, 0.0, 0.0 };
+      double rayDirection[3] = { 0.0, 0.0, 0.0 };
+      double exteriorPoint[3] = { 0.0, 0.0, 0.0 };
+      originalPoints->GetPoint(controlPointIndex, originalPoint);
+      normalVectors->GetTuple(controlPointIndex, rayDirection);
+      // Cast ray and find model intersection point
+      double rayEndPoint[3] = { 0.0, 0.0, 0.0 };
+      rayEndPoint[0] = originalPoint[0] + rayDirection[0] * rayLength;
+      rayEndPoint[1] = originalPoint[1] + rayDirection[1] * rayLength;
+      rayEndPoint[2] = originalPoint[2] + rayDirection[2] * rayLength;
+
+      double t = 0.0;
+      double pcoords[3] = { 0.0, 0.0, 0.0 };
+      int subId = 0;
+      vtkIdType cellId = 0;
+      int foundIntersection = surfaceObbTree->IntersectWithLine(rayEndPoint, originalPoint, tolerance, t, exteriorPoint, pcoords, subId, cellId, cell);
       if(foundIntersection == 0)
         {
-        // If no intersection in either direction, use closest mesh point
-        vtkIdType closestPointId = pointLocator->FindClosestPoint(originalPoint);
-        surfacePolydata->GetPoint(closestPointId, exteriorPoint);
-        ++noIntersectionCount;
+        // If no intersection, reverse direction of normal vector ray
+        rayEndPoint[0] = originalPoint[0] + rayDirection[0] * -rayLength;
+        rayEndPoint[1] = originalPoint[1] + rayDirection[1] * -rayLength;
+        rayEndPoint[2] = originalPoint[2] + rayDirection[2] * -rayLength;
+        foundIntersection = surfaceObbTree->IntersectWithLine(originalPoint, rayEndPoint, tolerance, t, exteriorPoint, pcoords, subId, cellId, cell);
+        if(foundIntersection == 0)
+          {
+          // If no intersection in either direction, use closest mesh point
+          vtkIdType closestPointId = pointLocator->FindClosestPoint(originalPoint);
+          surfacePolydata->GetPoint(closestPointId, exteriorPoint);
+          ++localNoIntersectionCount;
+          }
         }
+      surfacePoints->SetPoint(firstSurfacePointIndex + controlPointIndex, exteriorPoint);
       }
-    surfacePoints->InsertNextPoint(exteriorPoint);
-    }
+    noIntersectionCount += localNoIntersectionCount;
+    });
   if (noIntersectionCount > 0)
     {
     vtkGenericWarningMacro("No intersections found for " << noIntersectionCount << " points for curve ");
@@ -218,7 +233,7 @@ bool vtkProjectMarkupsCurvePointsFilter::ConstrainPointsToSurface(vtkPoints* ori
   surfaceObbTree->SetDataSet(surfacePolydata);
   surfaceObbTree->BuildLocator();
 
-  vtkNew<vtkPointLocator> pointLocator;
+  vtkNew<vtkStaticPointLocator> pointLocator;
   pointLocator->SetDataSet(surfacePolydata);
   pointLocator->BuildLocator();
 
@@ -259,6 +274,7 @@ bool vtkProjectMarkupsCurvePointsFilter::ProjectPointsToSurface(
 //---------------------------------------------------------------------------
 vtkProjectMarkupsCurvePointsFilter::PointProjectionHelper::PointProjectionHelper()
   : Model(nullptr)
+  , LastModelPolyData(nullptr)
   , LastModelModifiedTime(0)
   , LastTransformModifiedTime(0)
   , ModelNormalVectorArray()
@@ -274,7 +290,7 @@ void vtkProjectMarkupsCurvePointsFilter::PointProjectionHelper::SetModel(vtkMRML
 }
 
 //---------------------------------------------------------------------------
-vtkPointLocator* vtkProjectMarkupsCurvePointsFilter::PointProjectionHelper::GetPointLocator()
+vtkStaticPointLocator* vtkProjectMarkupsCurvePointsFilter::PointProjectionHelper::GetPointLocator()
 {
   this->UpdateAll();
   return this->ModelPointLocator;
@@ -299,7 +315,7 @@ bool vtkProjectMarkupsCurvePointsFilter::PointProjectionHelper::UpdateAll()
 {
   if (!this->Model)
     {
-    this->ModelPointLocator = vtkSmartPointer<vtkPointLocator>();
+    this->ModelPointLocator = vtkSmartPointer<vtkStaticPointLocator>();
     this->ModelNormalVectorArray = vtkSmartPointer<vtkDataArray>();
     this->ModelObbTree = vtkSmartPointer<vtkOBBTree>();
     this->SurfacePolyData = vtkSmartPointer<vtkPolyData>();
@@ -307,14 +323,20 @@ bool vtkProjectMarkupsCurvePointsFilter::PointProjectionHelper::UpdateAll()
     }
 
   // by using != instead of say, <, this will catch both if the model is updated
-  // and if a different model was set
+  // and if a different model was set.
+  // The mesh modified time is used instead of the model node modified time, so that
+  // the locators are not rebuilt when only the model node properties are changed.
+  vtkPolyData* modelPolyData = this->Model->GetPolyData();
+  vtkMTimeType modelPolyDataMTime = modelPolyData ? modelPolyData->GetMTime() : 0;
   vtkMRMLTransformNode* parentTransformNode = this->Model->GetParentTransformNode();
-  if (this->Model->GetMTime() != this->LastModelModifiedTime
+  if (modelPolyData != this->LastModelPolyData
+    || modelPolyDataMTime != this->LastModelModifiedTime
     || (parentTransformNode && parentTransformNode->GetTransformToWorldMTime() != this->LastTransformModifiedTime)
     || !this->ModelNormalVectorArray)
     {
-    this->LastModelModifiedTime = this->Model->GetMTime();
-    this->SurfacePolyData = this->Model->GetPolyData();
+    this->LastModelPolyData = modelPolyData;
+    this->LastModelModifiedTime = modelPolyDataMTime;
+    this->SurfacePolyData = modelPolyData;
     if (parentTransformNode)
       {
       this->LastTransformModifiedTime = parentTransformNode->GetTransformToWorldMTime();
@@ -327,7 +349,7 @@ bool vtkProjectMarkupsCurvePointsFilter::PointProjectionHelper::UpdateAll()
       this->SurfacePolyData = transformPolydataFilter->GetOutput();
       }
 
-    this->ModelPointLocator = vtkSmartPointer<vtkPointLocator>::New();
+    this->ModelPointLocator = vtkSmartPointer<vtkStaticPointLocator>::New();
     this->ModelPointLocator->SetDataSet(this->SurfacePolyData);
     this->ModelPointLocator->BuildLocator();
 
@@ -344,7 +366,7 @@ bool vtkProjectMarkupsCurvePointsFilter::PointProjectionHelper::UpdateAll()
     if (!this->ModelNormalVectorArray)
       {
       vtkGenericWarningMacro("vtkProjectMarkupsCurvePointsFilter::PointProjectionHelper::GetPointNormals failed: Unable to calculate normals");
-      this->ModelPointLocator = vtkSmartPointer<vtkPointLocator>();
+      this->ModelPointLocator = vtkSmartPointer<vtkStaticPointLocator>();
       this->ModelNormalVectorArray = vtkSmartPointer<vtkDataArray>();
       this->ModelObbTree = vtkSmartPointer<vtkOBBTree>();
       this->SurfacePolyData = vtkSmartPointer<vtkPolyData>();
@@ -389,6 +411,26 @@ vtkSmartPointer<vtkDoubleArray> vtkProjectMarkupsCurvePointsFilter::PointProject
   auto normals = vtkSmartPointer<vtkDoubleArray>::New();
   normals->SetNumberOfComponents(3);
   const auto numberOfPoints = points->GetNumberOfPoints();
+
+  // Surface normals at control points are looked up only once for each control point
+  // (instead of twice for each curve point).
+  const vtkIdType numberOfControlPoints = controlPoints->GetNumberOfPoints();
+  std::vector<double> controlPointNormals(numberOfControlPoints * 3, 0.0);
+  std::vector<bool> controlPointNormalValid(numberOfControlPoints, false);
+  auto getControlPointNormal = [&](vtkIdType controlPointIndex, const double controlPoint[3], double normal[3])
+    {
+    double* controlPointNormal = &controlPointNormals[controlPointIndex * 3];
+    if (!controlPointNormalValid[controlPointIndex])
+      {
+      vtkIdType pointId = this->ModelPointLocator->FindClosestPoint(controlPoint);
+      this->ModelNormalVectorArray->GetTuple(pointId, controlPointNormal);
+      controlPointNormalValid[controlPointIndex] = true;
+      }
+    normal[0] = controlPointNormal[0];
+    normal[1] = controlPointNormal[1];
+    normal[2] = controlPointNormal[2];
+    };
+
   for (vtkIdType i = 0; i < numberOfPoints; ++i)
     {
     const double* point = points->GetPoint(i);
@@ -429,12 +471,10 @@ vtkSmartPointer<vtkDoubleArray> vtkProjectMarkupsCurvePointsFilter::PointProject
     const auto distance2ToStart = vtkMath::Distance2BetweenPoints(point, segmentStartPoint);
     const auto distance2ToEnd = vtkMath::Distance2BetweenPoints(point, segmentEndPoint);
 
-    vtkIdType pointIdStart = this->ModelPointLocator->FindClosestPoint(segmentStartPoint);
     double startNormal[3] = { 0.0, 0.0, 0.0 };
-    this->ModelNormalVectorArray->GetTuple(pointIdStart, startNormal);
-    vtkIdType pointIdEnd = this->ModelPointLocator->FindClosestPoint(segmentEndPoint);
+    getControlPointNormal(segmentStartIndex, segmentStartPoint, startNormal);
     double endNormal[3] = { 0.0, 0.0, 0.0 };
-    this->ModelNormalVectorArray->GetTuple(pointIdEnd, endNormal);
+    getControlPointNormal(segmentEndIndex, segmentEndPoint, endNormal);
 
     const double startWeight = distance2ToEnd / (distance2ToStart + distance2ToEnd);
     const double endWeight = distance2ToStart / (distance2ToStart + distance2ToEnd);
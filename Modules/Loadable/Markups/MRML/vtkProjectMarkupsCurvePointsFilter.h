@@ -26,9 +26,9 @@
 
 class vtkDoubleArray;
 class vtkOBBTree;
-class vtkPointLocator;
 class vtkPoints;
 class vtkPolyData;
+class vtkStaticPointLocator;
 
 class vtkMRMLMarkupsCurveNode;
 class vtkMRMLModelNode;
@@ -110,7 +110,7 @@ private:
   double MaximumSearchRadiusTolerance;
 
   bool ProjectPointsToSurface(vtkMRMLModelNode* modelNode, double maximumSearchRadiusTolerance, vtkPoints* interpolatedPoints, vtkPoints* outputPoints);
-  static bool ConstrainPointsToSurfaceImpl(vtkOBBTree* surfaceObbTree, vtkPointLocator* pointLocator,
+  static bool ConstrainPointsToSurfaceImpl(vtkOBBTree* surfaceObbTree, vtkStaticPointLocator* pointLocator,
       vtkPoints* originalPoints, vtkDoubleArray* normalVectors, vtkPolyData* surfacePolydata,
       vtkPoints* surfacePoints, double maximumSearchRadius=.25);
 
@@ -122,16 +122,17 @@ private:
     /// Gets the point normals on the model at the points with the given controlPoints.
     /// Both points and control points must have no outstanding transformations.
     vtkSmartPointer<vtkDoubleArray> GetPointNormals(vtkPoints* points, vtkPoints* controlPoints);
-    vtkPointLocator* GetPointLocator();
+    vtkStaticPointLocator* GetPointLocator();
     vtkOBBTree* GetObbTree();
     vtkPolyData* GetSurfacePolyData();
 
   private:
     vtkMRMLModelNode* Model;
+    vtkPolyData* LastModelPolyData;
     vtkMTimeType LastModelModifiedTime;
     vtkMTimeType LastTransformModifiedTime;
     vtkSmartPointer<vtkDataArray> ModelNormalVectorArray;
-    vtkSmartPointer<vtkPointLocator> ModelPointLocator;
+    vtkSmartPointer<vtkStaticPointLocator> ModelPointLocator;
     vtkSmartPointer<vtkOBBTree> ModelObbTree;
     vtkSmartPointer<vtkPolyData> SurfacePolyData;
 
@@ -9,6 +9,7 @@
 #include <vtkMRMLDisplayableManagerGroup.h>
 #include <vtkMRMLInteractionEventData.h>
 #include <vtkMRMLModelDisplayableManager.h>
+#include <vtkMRMLWidgetPickingIndex.h>
 
 // MRML includes
 #include <vtkEventBroker.h>
@@ -68,6 +69,7 @@ vtkMRMLMarkupsDisplayableManager::vtkMRMLMarkupsDisplayableManager()
   this->Helper = vtkSmartPointer<vtkMRMLMarkupsDisplayableManagerHelper>::New();
   this->Helper->SetDisplayableManager(this);
   this->DisableInteractorStyleEventsProcessing = 0;
+  this->PickingIndex = vtkSmartPointer<vtkMRMLWidgetPickingIndex>::New();
 
   this->LastClickWorldCoordinates[0]=0.0;
   this->LastClickWorldCoordinates[1]=0.0;
@@ -559,10 +561,55 @@ vtkSlicerMarkupsWidget* vtkMRMLMarkupsDisplayableManager::FindClosestWidget(vtkM
   vtkSlicerMarkupsWidget* closestWidget = nullptr;
   closestDistance2 = VTK_DOUBLE_MAX;
 
-  for (vtkMRMLMarkupsDisplayableManagerHelper::DisplayNodeToWidgetIt widgetIterator = this->Helper->MarkupsDisplayNodesToWidgets.begin();
-    widgetIterator != this->Helper->MarkupsDisplayNodesToWidgets.end(); ++widgetIterator)
+  std::vector<vtkSlicerMarkupsWidget*> candidateWidgets;
+  if (callData->GetType() == vtkCommand::MouseMoveEvent && callData->IsDisplayPositionValid())
+    {
+    // Mouse hover: only ask those widgets that are near the mouse pointer
+    this->PickingIndex->SetRenderer(this->GetRenderer());
+    if (!this->PickingIndex->IsValid())
+      {
+      this->PickingIndex->Reset();
+      for (vtkMRMLMarkupsDisplayableManagerHelper::DisplayNodeToWidgetIt widgetIterator = this->Helper->MarkupsDisplayNodesToWidgets.begin();
+        widgetIterator != this->Helper->MarkupsDisplayNodesToWidgets.end(); ++widgetIterator)
+        {
+        vtkSlicerMarkupsWidget* widget = widgetIterator->second;
+        if (!widget)
+          {
+          continue;
+          }
+        // Widgets that are being placed or dragged interact everywhere
+        bool alwaysCandidate = (widget->GetWidgetState() != vtkMRMLAbstractWidget::WidgetStateIdle
+          && widget->GetWidgetState() != vtkMRMLAbstractWidget::WidgetStateOnWidget);
+        this->PickingIndex->AddWidget(widget, alwaysCandidate);
+        }
+      }
+    std::vector<vtkMRMLAbstractWidget*> candidates;
+    this->PickingIndex->GetCandidateWidgets(callData->GetDisplayPosition(), candidates);
+    for (vtkMRMLAbstractWidget* candidate : candidates)
+      {
+      candidateWidgets.push_back(vtkSlicerMarkupsWidget::SafeDownCast(candidate));
+      }
+    // The last active widget may have changed its state since the index was built
+    if (this->LastActiveWidget
+      && std::find(candidateWidgets.begin(), candidateWidgets.end(), this->LastActiveWidget.GetPointer()) == candidateWidgets.end())
+      {
+      candidateWidgets.push_back(this->LastActiveWidget);
+      }
+    }
+  else
+    {
+    // Other events (button press, key press, ...) may change widget states,
+    // therefore the index has to be rebuilt for the next mouse move
+    this->PickingIndex->Invalidate();
+    for (vtkMRMLMarkupsDisplayableManagerHelper::DisplayNodeToWidgetIt widgetIterator = this->Helper->MarkupsDisplayNodesToWidgets.begin();
+      widgetIterator != this->Helper->MarkupsDisplayNodesToWidgets.end(); ++widgetIterator)
+      {
+      candidateWidgets.push_back(widgetIterator->second);
+      }
+    }
+
+  for (vtkSlicerMarkupsWidget* widget : candidateWidgets)
     {
-    vtkSlicerMarkupsWidget* widget = widgetIterator->second;
     if (!widget)
       {
       continue;
@@ -922,6 +969,7 @@ vtkSlicerMarkupsWidget * vtkMRMLMarkupsDisplayableManager::CreateWidget(vtkMRMLM
   vtkRenderer* renderer = this->GetRenderer();
   widget->SetMRMLApplicationLogic(this->GetMRMLApplicationLogic());
   widget->CreateDefaultRepresentation(markupsDisplayNode, viewNode, renderer);
+  this->PickingIndex->Invalidate();
   return widget;
 }
 
@@ -33,6 +33,8 @@
 // STD includes
 #include <map>
 
+class vtkMRMLWidgetPickingIndex;
+
 class vtkMRMLMarkupsNode;
 class vtkSlicerViewerWidget;
 class vtkMRMLMarkupsDisplayNode;
@@ -147,6 +149,9 @@ protected:
 
   vtkWeakPointer<vtkSlicerMarkupsWidget> LastActiveWidget;
 
+  /// Screen-space index of widgets, for quickly finding widgets near the mouse pointer on mouse move
+  vtkSmartPointer<vtkMRMLWidgetPickingIndex> PickingIndex;
+
 private:
   vtkMRMLMarkupsDisplayableManager(const vtkMRMLMarkupsDisplayableManager&) = delete;
   void operator=(const vtkMRMLMarkupsDisplayableManager&) = delete;
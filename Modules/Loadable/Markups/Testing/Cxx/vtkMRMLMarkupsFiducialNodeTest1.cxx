@@ -122,6 +122,25 @@ int vtkMRMLMarkupsFiducialNodeTest1(int , char * [] )
     return EXIT_FAILURE;
     }
 
+  // undo of control point position changes
+  // (control point changes are signaled by custom events, undo states must not be shared)
+  scene->SetUndoOn();
+  node1->SetUndoEnabled(true);
+  double undoPos[3] = { 1.0, 2.0, 3.0 };
+  node1->SetNthControlPointPosition(fidIndex2, undoPos);
+  scene->SaveStateForUndo();
+  undoPos[0] = 10.0;
+  node1->SetNthControlPointPosition(fidIndex2, undoPos);
+  scene->SaveStateForUndo();
+  undoPos[0] = 20.0;
+  node1->SetNthControlPointPosition(fidIndex2, undoPos);
+  scene->Undo();
+  CHECK_DOUBLE(node1->GetNthControlPointPositionVector(fidIndex2).GetX(), 10.0);
+  scene->Undo();
+  CHECK_DOUBLE(node1->GetNthControlPointPositionVector(fidIndex2).GetX(), 1.0);
+  scene->ClearUndoStack();
+  scene->SetUndoOff();
+
   node1->Print(std::cout);
 
   return EXIT_SUCCESS;
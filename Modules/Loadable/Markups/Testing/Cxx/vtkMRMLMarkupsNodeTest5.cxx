@@ -30,9 +30,11 @@
 #include <vtkNew.h>
 #include <vtkOrientedBSplineTransform.h>
 #include <vtkPointData.h>
+#include <vtkPoints.h>
 #include <vtkRegularPolygonSource.h>
 #include <vtkTestingOutputWindow.h>
 #include <vtkTransform.h>
+#include <vtkUnsignedCharArray.h>
 
 // STL includes
 #include <sstream>
@@ -248,6 +250,34 @@ int vtkMRMLMarkupsNodeTest5(int , char * [])
   roiNode->HardenTransform();
   CHECK_BOOL(CompareROI(xAxis_World, yAxis_World, zAxis_World, origin_World, size_World, roiNode, EPSILON), true);
 
+  ///////////////
+  std::cout << "Test batch point in ROI query" << std::endl;
+  vtkNew<vtkPoints> points_World;
+  for (int i = -10; i <= 10; ++i)
+    {
+    for (int j = -10; j <= 10; ++j)
+      {
+      points_World->InsertNextPoint(origin_World[0] + i * 0.4, origin_World[1] + j * 0.4, origin_World[2] + (i - j) * 0.2);
+      }
+    }
+  for (int insideOut = 0; insideOut < 2; ++insideOut)
+    {
+    roiNode->SetInsideOut(insideOut != 0);
+    vtkNew<vtkUnsignedCharArray> pointsInROI;
+    vtkIdType numberOfPointsInROI = roiNode->GetPointsInROIWorld(points_World, pointsInROI);
+    CHECK_INT(pointsInROI->GetNumberOfTuples(), points_World->GetNumberOfPoints());
+    vtkIdType expectedNumberOfPointsInROI = 0;
+    for (vtkIdType pointIndex = 0; pointIndex < points_World->GetNumberOfPoints(); ++pointIndex)
+      {
+      bool expectedInROI = roiNode->IsPointInROIWorld(points_World->GetPoint(pointIndex));
+      CHECK_INT(pointsInROI->GetValue(pointIndex), expectedInROI ? 1 : 0);
+      expectedNumberOfPointsInROI += expectedInROI ? 1 : 0;
+      }
+    CHECK_INT(numberOfPointsInROI, expectedNumberOfPointsInROI);
+    CHECK_BOOL(numberOfPointsInROI > 0 && numberOfPointsInROI < points_World->GetNumberOfPoints(), true);
+    }
+  roiNode->SetInsideOut(false);
+
   ///////////////
   std::cout << "Test b-spline transform" << std::endl;
 
@@ -34,12 +34,20 @@
 #include "vtkRenderWindow.h"
 #include "vtkRenderer.h"
 
+// STD includes
+#include <algorithm>
+#include <cmath>
+
 vtkStandardNewMacro(vtkFastSelectVisiblePoints);
 
 //----------------------------------------------------------------------------
 vtkFastSelectVisiblePoints::vtkFastSelectVisiblePoints()
 {
   this->ZBuffer = nullptr;
+  this->ZBufferSelection[0] = 0;
+  this->ZBufferSelection[1] = -1;
+  this->ZBufferSelection[2] = 0;
+  this->ZBufferSelection[3] = -1;
 }
 
 //----------------------------------------------------------------------------
@@ -49,19 +57,142 @@ vtkFastSelectVisiblePoints::~vtkFastSelectVisiblePoints() = default;
 void vtkFastSelectVisiblePoints::ResetZBuffer()
 {
   this->ZBuffer = nullptr;
+  this->ZBufferSelection[0] = 0;
+  this->ZBufferSelection[1] = -1;
+  this->ZBufferSelection[2] = 0;
+  this->ZBufferSelection[3] = -1;
 }
 
 //----------------------------------------------------------------------------
 void vtkFastSelectVisiblePoints::UpdateZBuffer()
 {
   this->ResetZBuffer();
-  float* zPtr = this->Initialize(true);
+  this->UpdateZBufferIfNeeded();
+}
+
+//----------------------------------------------------------------------------
+void vtkFastSelectVisiblePoints::UpdateZBufferIfNeeded()
+{
+  if (!this->Renderer || !this->Renderer->GetRenderWindow() || !this->Renderer->GetActiveCamera())
+    {
+    return;
+    }
+  this->Initialize(false);
+  int selection[4] = { 0, -1, 0, -1 };
+  if (!this->GetInputPointsSelection(selection))
+    {
+    if (!this->ZBuffer)
+      {
+      // no points are in the window, store an empty z-buffer
+      this->ReadZBuffer(selection);
+      }
+    return;
+    }
+  if (this->ZBuffer)
+    {
+    if (selection[0] >= this->ZBufferSelection[0] && selection[1] <= this->ZBufferSelection[1]
+      && selection[2] >= this->ZBufferSelection[2] && selection[3] <= this->ZBufferSelection[3])
+      {
+      // current z-buffer contains all the points
+      return;
+      }
+    if (this->ZBufferSelection[0] <= this->ZBufferSelection[1] && this->ZBufferSelection[2] <= this->ZBufferSelection[3])
+      {
+      // include the current region to allow sharing the z-buffer
+      selection[0] = std::min(selection[0], this->ZBufferSelection[0]);
+      selection[1] = std::max(selection[1], this->ZBufferSelection[1]);
+      selection[2] = std::min(selection[2], this->ZBufferSelection[2]);
+      selection[3] = std::max(selection[3], this->ZBufferSelection[3]);
+      }
+    }
+  this->ReadZBuffer(selection);
+}
 
+//----------------------------------------------------------------------------
+void vtkFastSelectVisiblePoints::ReadZBuffer(const int selection[4])
+{
   this->ZBuffer = vtkSmartPointer<vtkFloatArray>::New();
-  vtkIdType size = (this->InternalSelection[1] - this->InternalSelection[0] + 1) * (this->InternalSelection[3] - this->InternalSelection[2] + 1);
+  for (int i = 0; i < 4; i++)
+    {
+    this->ZBufferSelection[i] = selection[i];
+    }
+  if (selection[0] > selection[1] || selection[2] > selection[3])
+    {
+    // empty region
+    return;
+    }
+  float* zPtr = this->Renderer->GetRenderWindow()->GetZbufferData(selection[0], selection[2], selection[1], selection[3]);
+  vtkIdType size = (selection[1] - selection[0] + 1) * (selection[3] - selection[2] + 1);
   this->ZBuffer->SetArray(zPtr, size, 0);
 }
 
+//----------------------------------------------------------------------------
+bool vtkFastSelectVisiblePoints::GetInputPointsSelection(int selection[4])
+{
+  vtkDataSet* input = vtkDataSet::SafeDownCast(this->GetInput());
+  if (!input || input->GetNumberOfPoints() < 1)
+    {
+    return false;
+    }
+
+  // Points are shifted by the world tolerance along the direction of projection
+  // when visibility is checked, so include the shifted positions in the region.
+  double directionOfProjection[3] = { 0.0, 0.0, 0.0 };
+  this->Renderer->GetActiveCamera()->GetDirectionOfProjection(directionOfProjection);
+  int numberOfShifts = (this->ToleranceWorld > 0.0) ? 3 : 1;
+  const double shifts[3] = { 0.0, -this->ToleranceWorld, this->ToleranceWorld };
+
+  double displayBounds[4] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  vtkIdType numPts = input->GetNumberOfPoints();
+  double x[3] = { 0.0, 0.0, 0.0 };
+  double view[4] = { 0.0, 0.0, 0.0, 0.0 };
+  double dx[3] = { 0.0, 0.0, 0.0 };
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+    {
+    input->GetPoint(ptId, x);
+    for (int shiftIndex = 0; shiftIndex < numberOfShifts; shiftIndex++)
+      {
+      double xx[4] =
+        {
+        x[0] + directionOfProjection[0] * shifts[shiftIndex],
+        x[1] + directionOfProjection[1] * shifts[shiftIndex],
+        x[2] + directionOfProjection[2] * shifts[shiftIndex],
+        1.0
+        };
+      this->CompositePerspectiveTransform->MultiplyPoint(xx, view);
+      if (view[3] == 0.0)
+        {
+        continue;
+        }
+      this->Renderer->SetViewPoint(view[0] / view[3], view[1] / view[3], view[2] / view[3]);
+      this->Renderer->ViewToDisplay();
+      this->Renderer->GetDisplayPoint(dx);
+      displayBounds[0] = std::min(displayBounds[0], dx[0]);
+      displayBounds[1] = std::max(displayBounds[1], dx[0]);
+      displayBounds[2] = std::min(displayBounds[2], dx[1]);
+      displayBounds[3] = std::max(displayBounds[3], dx[1]);
+      }
+    }
+  if (displayBounds[0] > displayBounds[1] || displayBounds[2] > displayBounds[3])
+    {
+    return false;
+    }
+
+  // Add a pixel margin to make sure that rounding does not exclude any points
+  for (int i = 0; i < 2; i++)
+    {
+    double minimum = std::max(displayBounds[i * 2] - 1.0, static_cast<double>(this->InternalSelection[i * 2]));
+    double maximum = std::min(displayBounds[i * 2 + 1] + 1.0, static_cast<double>(this->InternalSelection[i * 2 + 1]));
+    if (minimum > maximum)
+      {
+      return false;
+      }
+    selection[i * 2] = static_cast<int>(std::floor(minimum));
+    selection[i * 2 + 1] = static_cast<int>(std::floor(maximum));
+    }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 int vtkFastSelectVisiblePoints::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -131,6 +262,11 @@ int vtkFastSelectVisiblePoints::RequestData(vtkInformation* vtkNotUsed(request),
     {
     this->Initialize(false);
     }
+  // The z-buffer only contains part of the window, points outside of this region are not visible.
+  for (int i = 0; i < 4; i++)
+    {
+    this->InternalSelection[i] = this->ZBufferSelection[i];
+    }
 
   int abort = 0;
   vtkIdType progressInterval = numPts / 20 + 1;
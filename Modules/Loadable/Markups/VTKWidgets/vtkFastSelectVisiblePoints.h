@@ -67,19 +67,51 @@ public:
    */
   static vtkFastSelectVisiblePoints* New();
 
+  /**
+   * Read the z-buffer from the render window.
+   * Only the region of the window that contains the input points is read,
+   * which is much faster than reading the entire z-buffer if points are in a small region.
+   */
   void UpdateZBuffer();
+
+  /**
+   * Read the z-buffer from the render window only if the current z-buffer
+   * does not cover all the input points. The new region contains the
+   * current z-buffer region as well, so the z-buffer can be shared between
+   * filters that use the same renderer.
+   */
+  void UpdateZBufferIfNeeded();
+
   void ResetZBuffer();
 
   vtkFloatArray* GetZBuffer() { return this->ZBuffer; };
   void SetZBuffer(vtkFloatArray* zBuffer) { this->ZBuffer = zBuffer; };
 
+  ///@{
+  /**
+   * Region of the render window that the z-buffer contains (xmin, xmax, ymin, ymax).
+   * Must be set together with the z-buffer.
+   */
+  vtkSetVector4Macro(ZBufferSelection, int);
+  vtkGetVector4Macro(ZBufferSelection, int);
+  ///@}
+
 protected:
   vtkFastSelectVisiblePoints();
   ~vtkFastSelectVisiblePoints() override;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /// Get display region that contains all input points, intersected with the internal selection.
+  /// Initialize() must be called before this method.
+  /// Returns false if no input points are in the selection.
+  bool GetInputPointsSelection(int selection[4]);
+
+  /// Read the z-buffer in the specified region
+  void ReadZBuffer(const int selection[4]);
+
   vtkSmartPointer<vtkFloatArray> ZBuffer;
+  int ZBufferSelection[4];
 
 private:
   vtkFastSelectVisiblePoints(const vtkFastSelectVisiblePoints&) = delete;
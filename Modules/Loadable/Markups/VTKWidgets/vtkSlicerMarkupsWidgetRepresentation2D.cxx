@@ -581,6 +581,79 @@ void vtkSlicerMarkupsWidgetRepresentation2D::CanInteract(
     }
 }
 
+//----------------------------------------------------------------------
+bool vtkSlicerMarkupsWidgetRepresentation2D::GetInteractionDisplayBounds(double displayBounds[4])
+{
+  vtkMRMLSliceNode* sliceNode = this->GetSliceNode();
+  vtkMRMLMarkupsNode* markupsNode = this->GetMarkupsNode();
+  if (!sliceNode || !markupsNode || !this->MarkupsDisplayNode)
+    {
+    return false;
+    }
+  if (this->InteractionPipeline && this->InteractionPipeline->Actor->GetVisibility())
+    {
+    // interaction handles may be far from the markup
+    return false;
+    }
+  // empty region
+  displayBounds[0] = displayBounds[2] = VTK_DOUBLE_MAX;
+  displayBounds[1] = displayBounds[3] = VTK_DOUBLE_MIN;
+  if (markupsNode->GetLocked() || !this->GetVisibility())
+    {
+    return true;
+    }
+
+  vtkNew<vtkMatrix4x4> rasToxyMatrix;
+  vtkMatrix4x4::Invert(sliceNode->GetXYToRAS(), rasToxyMatrix.GetPointer());
+  double pointWorldPos[4] = { 0.0, 0.0, 0.0, 1.0 };
+  double pointDisplayPos[4] = { 0.0, 0.0, 0.0, 1.0 };
+  auto addPoint = [&]()
+    {
+    rasToxyMatrix->MultiplyPoint(pointWorldPos, pointDisplayPos);
+    displayBounds[0] = std::min(displayBounds[0], pointDisplayPos[0]);
+    displayBounds[1] = std::max(displayBounds[1], pointDisplayPos[0]);
+    displayBounds[2] = std::min(displayBounds[2], pointDisplayPos[1]);
+    displayBounds[3] = std::max(displayBounds[3], pointDisplayPos[1]);
+    };
+
+  // Control points and straight lines between them
+  int numberOfPoints = markupsNode->GetNumberOfControlPoints();
+  for (int i = 0; i < numberOfPoints; i++)
+    {
+    markupsNode->GetNthControlPointPositionWorld(i, pointWorldPos);
+    addPoint();
+    }
+  if (numberOfPoints > 2 && this->CurveClosed)
+    {
+    markupsNode->GetCenterOfRotationWorld(pointWorldPos);
+    addPoint();
+    }
+  // Interpolated curve points (curves may extend beyond the control points)
+  vtkPoints* curvePointsWorld = markupsNode->GetCurvePointsWorld();
+  if (curvePointsWorld)
+    {
+    vtkIdType numberOfCurvePoints = curvePointsWorld->GetNumberOfPoints();
+    for (vtkIdType i = 0; i < numberOfCurvePoints; i++)
+      {
+      curvePointsWorld->GetPoint(i, pointWorldPos);
+      addPoint();
+      }
+    }
+  if (displayBounds[0] > displayBounds[1])
+    {
+    // no points
+    return true;
+    }
+
+  this->UpdateControlPointSize();
+  double margin = sqrt(this->GetMaximumControlPointPickingDistance2()) + 1.0;
+  displayBounds[0] -= margin;
+  displayBounds[1] += margin;
+  displayBounds[2] -= margin;
+  displayBounds[3] += margin;
+  return true;
+}
+
 //----------------------------------------------------------------------
 void vtkSlicerMarkupsWidgetRepresentation2D::CanInteractWithHandles(
   vtkMRMLInteractionEventData* interactionEventData,
@@ -66,6 +66,10 @@ public:
   void CanInteractWithLine(vtkMRMLInteractionEventData* interactionEventData,
     int &foundComponentType, int &foundComponentIndex, double &closestDistance2);
 
+  /// Get the region in display coordinates where control points and lines can be picked.
+  /// Returns false if interaction handles are visible.
+  bool GetInteractionDisplayBounds(double displayBounds[4]) override;
+
   /// Subclasses of vtkSlicerMarkupsWidgetRepresentation2D must implement these methods. These
   /// are the methods that the widget and its representation use to
   /// communicate with each other.
@@ -49,7 +49,7 @@
 #include <vtkMRMLInteractionEventData.h>
 #include <vtkMRMLViewNode.h>
 
-std::map<vtkRenderer*, vtkSmartPointer<vtkFloatArray> > vtkSlicerMarkupsWidgetRepresentation3D::CachedZBuffers;
+std::map<vtkRenderer*, vtkSlicerMarkupsWidgetRepresentation3D::ZBufferCacheEntry> vtkSlicerMarkupsWidgetRepresentation3D::CachedZBuffers;
 
 vtkSlicerMarkupsWidgetRepresentation3D::ControlPointsPipeline3D::ControlPointsPipeline3D()
 {
@@ -512,6 +512,101 @@ void vtkSlicerMarkupsWidgetRepresentation3D::CanInteract(
   */
 }
 
+//----------------------------------------------------------------------
+bool vtkSlicerMarkupsWidgetRepresentation3D::GetInteractionDisplayBounds(double displayBounds[4])
+{
+  vtkMRMLMarkupsNode* markupsNode = this->GetMarkupsNode();
+  if (!this->Renderer || !this->Renderer->GetActiveCamera() || !markupsNode || !this->MarkupsDisplayNode)
+    {
+    return false;
+    }
+  if (this->InteractionPipeline && this->InteractionPipeline->Actor->GetVisibility())
+    {
+    // interaction handles may be far from the markup
+    return false;
+    }
+  // empty region
+  displayBounds[0] = displayBounds[2] = VTK_DOUBLE_MAX;
+  displayBounds[1] = displayBounds[3] = VTK_DOUBLE_MIN;
+  if (markupsNode->GetLocked() || !this->GetVisibility())
+    {
+    return true;
+    }
+
+  // Bounding box of all pickable parts in world coordinates
+  vtkBoundingBox worldBoundingBox;
+  double* actorsBounds = this->GetBounds();
+  if (actorsBounds && vtkMath::AreBoundsInitialized(actorsBounds))
+    {
+    worldBoundingBox.AddBounds(actorsBounds);
+    }
+  double pointWorldPos[3] = { 0.0, 0.0, 0.0 };
+  int numberOfPoints = markupsNode->GetNumberOfControlPoints();
+  for (int i = 0; i < numberOfPoints; i++)
+    {
+    markupsNode->GetNthControlPointPositionWorld(i, pointWorldPos);
+    worldBoundingBox.AddPoint(pointWorldPos);
+    }
+  if (numberOfPoints > 2 && this->CurveClosed)
+    {
+    markupsNode->GetCenterOfRotationWorld(pointWorldPos);
+    worldBoundingBox.AddPoint(pointWorldPos);
+    }
+  vtkPoints* curvePointsWorld = markupsNode->GetCurvePointsWorld();
+  if (curvePointsWorld)
+    {
+    vtkIdType numberOfCurvePoints = curvePointsWorld->GetNumberOfPoints();
+    for (vtkIdType i = 0; i < numberOfCurvePoints; i++)
+      {
+      worldBoundingBox.AddPoint(curvePointsWorld->GetPoint(i));
+      }
+    }
+  if (!worldBoundingBox.IsValid())
+    {
+    // nothing to interact with
+    return true;
+    }
+  worldBoundingBox.Inflate(this->ControlPointSize / 2.0);
+
+  // Project the bounding box corners to display coordinates. The projection of the
+  // corners contains the projection of the entire box, as long as it is in front of the camera.
+  vtkMatrix4x4* worldToViewMatrix = this->Renderer->GetActiveCamera()->GetCompositeProjectionTransformMatrix(
+    this->Renderer->GetTiledAspectRatio(), 0, 1);
+  double worldBounds[6] = { 0.0, -1.0, 0.0, -1.0, 0.0, -1.0 };
+  worldBoundingBox.GetBounds(worldBounds);
+  for (int cornerIndex = 0; cornerIndex < 8; cornerIndex++)
+    {
+    double cornerWorld[4] =
+      {
+      worldBounds[(cornerIndex & 1) ? 1 : 0],
+      worldBounds[(cornerIndex & 2) ? 3 : 2],
+      worldBounds[(cornerIndex & 4) ? 5 : 4],
+      1.0
+      };
+    double cornerView[4] = { 0.0, 0.0, 0.0, 1.0 };
+    worldToViewMatrix->MultiplyPoint(cornerWorld, cornerView);
+    if (cornerView[3] <= 0.0)
+      {
+      // behind the camera, the projected region is unbounded
+      return false;
+      }
+    this->Renderer->SetViewPoint(cornerView[0] / cornerView[3], cornerView[1] / cornerView[3], cornerView[2] / cornerView[3]);
+    this->Renderer->ViewToDisplay();
+    double* cornerDisplay = this->Renderer->GetDisplayPoint();
+    displayBounds[0] = std::min(displayBounds[0], cornerDisplay[0]);
+    displayBounds[1] = std::max(displayBounds[1], cornerDisplay[0]);
+    displayBounds[2] = std::min(displayBounds[2], cornerDisplay[1]);
+    displayBounds[3] = std::max(displayBounds[3], cornerDisplay[1]);
+    }
+
+  double margin = this->PickingTolerance * this->ScreenScaleFactor + 1.0;
+  displayBounds[0] -= margin;
+  displayBounds[1] += margin;
+  displayBounds[2] -= margin;
+  displayBounds[3] += margin;
+  return true;
+}
+
 //----------------------------------------------------------------------
 void vtkSlicerMarkupsWidgetRepresentation3D::CanInteractWithHandles(
   vtkMRMLInteractionEventData* interactionEventData,
@@ -816,7 +911,6 @@ void vtkSlicerMarkupsWidgetRepresentation3D::ReleaseGraphicsResources(
 //----------------------------------------------------------------------
 int vtkSlicerMarkupsWidgetRepresentation3D::RenderOverlay(vtkViewport *viewport)
 {
-  vtkFloatArray* zBuffer = vtkSlicerMarkupsWidgetRepresentation3D::GetCachedZBuffer(this->Renderer);
   int count = Superclass::RenderOverlay(viewport);
   for (int i = 0; i < NumberOfControlPointTypes; i++)
     {
@@ -825,17 +919,28 @@ int vtkSlicerMarkupsWidgetRepresentation3D::RenderOverlay(vtkViewport *viewport)
       {
       if (!this->MarkupsDisplayNode->GetOccludedVisibility())
         {
-        if (!zBuffer)
+        // The z-buffer is only read in the region of the control points and it is shared between all markups
+        // in the renderer. It only needs to be read again if the control points are outside the cached region.
+        vtkFastSelectVisiblePoints* selectVisiblePoints = controlPoints->SelectVisiblePoints;
+        ZBufferCacheEntry* cachedZBuffer = vtkSlicerMarkupsWidgetRepresentation3D::GetCachedZBuffer(this->Renderer);
+        if (cachedZBuffer)
           {
-          controlPoints->SelectVisiblePoints->UpdateZBuffer();
-          zBuffer = controlPoints->SelectVisiblePoints->GetZBuffer();
-          vtkSlicerMarkupsWidgetRepresentation3D::CachedZBuffers[this->Renderer] = zBuffer;
+          selectVisiblePoints->SetZBuffer(cachedZBuffer->ZBuffer);
+          selectVisiblePoints->SetZBufferSelection(cachedZBuffer->Selection);
           }
         else
           {
-          controlPoints->SelectVisiblePoints->SetZBuffer(zBuffer);
+          selectVisiblePoints->ResetZBuffer();
+          }
+        selectVisiblePoints->UpdateZBufferIfNeeded();
+        if (selectVisiblePoints->GetZBuffer()
+          && (!cachedZBuffer || cachedZBuffer->ZBuffer != selectVisiblePoints->GetZBuffer()))
+          {
+          ZBufferCacheEntry& newCachedZBuffer = vtkSlicerMarkupsWidgetRepresentation3D::CachedZBuffers[this->Renderer];
+          newCachedZBuffer.ZBuffer = selectVisiblePoints->GetZBuffer();
+          selectVisiblePoints->GetZBufferSelection(newCachedZBuffer.Selection);
           }
-        controlPoints->SelectVisiblePoints->Update();
+        selectVisiblePoints->Update();
         }
       else
         {
@@ -1172,18 +1277,18 @@ void vtkSlicerMarkupsWidgetRepresentation3D::PrintSelf(ostream& os,
 }
 
 //---------------------------------------------------------------------------
-vtkFloatArray* vtkSlicerMarkupsWidgetRepresentation3D::GetCachedZBuffer(vtkRenderer* renderer)
+vtkSlicerMarkupsWidgetRepresentation3D::ZBufferCacheEntry* vtkSlicerMarkupsWidgetRepresentation3D::GetCachedZBuffer(vtkRenderer* renderer)
 {
   if (!renderer)
     {
   return nullptr;
     }
-  if (vtkSlicerMarkupsWidgetRepresentation3D::CachedZBuffers.find(renderer) ==
-    vtkSlicerMarkupsWidgetRepresentation3D::CachedZBuffers.end())
+  auto cachedZBufferIt = vtkSlicerMarkupsWidgetRepresentation3D::CachedZBuffers.find(renderer);
+  if (cachedZBufferIt == vtkSlicerMarkupsWidgetRepresentation3D::CachedZBuffers.end())
     {
     return nullptr;
     }
-  return vtkSlicerMarkupsWidgetRepresentation3D::CachedZBuffers[renderer];
+  return &cachedZBufferIt->second;
 }
 
 //---------------------------------------------------------------------------
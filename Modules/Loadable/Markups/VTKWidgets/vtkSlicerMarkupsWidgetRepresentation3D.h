@@ -80,6 +80,10 @@ public:
   void CanInteractWithLine(vtkMRMLInteractionEventData* interactionEventData,
     int &foundComponentType, int &foundComponentIndex, double &closestDistance2);
 
+  /// Get the region in display coordinates where control points and lines can be picked.
+  /// Returns false if interaction handles are visible.
+  bool GetInteractionDisplayBounds(double displayBounds[4]) override;
+
   bool AccuratePick(int x, int y, double pickPoint[3], double pickNormal[3]=nullptr);
 
   /// Return true if the control point is actually visible
@@ -164,11 +168,18 @@ protected:
   bool HideTextActorIfAllPointsOccluded;
   double OccludedRelativeOffset;
 
-  static std::map<vtkRenderer*, vtkSmartPointer<vtkFloatArray> > CachedZBuffers;
+  /// Z-buffer that is shared between all markups in the same renderer.
+  /// It only contains the region of the render window specified by Selection.
+  struct ZBufferCacheEntry
+    {
+    vtkSmartPointer<vtkFloatArray> ZBuffer;
+    int Selection[4];
+    };
+  static std::map<vtkRenderer*, ZBufferCacheEntry> CachedZBuffers;
 
   vtkSmartPointer<vtkCallbackCommand> RenderCompletedCallback;
   static void OnRenderCompleted(vtkObject* caller, unsigned long event, void* clientData, void* callData);
-  static vtkFloatArray* GetCachedZBuffer(vtkRenderer* renderer);
+  static ZBufferCacheEntry* GetCachedZBuffer(vtkRenderer* renderer);
 
 private:
   vtkSlicerMarkupsWidgetRepresentation3D(const vtkSlicerMarkupsWidgetRepresentation3D&) = delete;
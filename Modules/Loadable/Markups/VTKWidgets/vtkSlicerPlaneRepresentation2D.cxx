@@ -313,6 +313,12 @@ void vtkSlicerPlaneRepresentation2D::CanInteract(
   this->CanInteractWithPlane(interactionEventData, foundComponentType, foundComponentIndex, closestDistance2);
 }
 
+//-----------------------------------------------------------------------------
+bool vtkSlicerPlaneRepresentation2D::GetInteractionDisplayBounds(double vtkNotUsed(displayBounds)[4])
+{
+  return false;
+}
+
 //-----------------------------------------------------------------------------
 void vtkSlicerPlaneRepresentation2D::CanInteractWithPlane(
   vtkMRMLInteractionEventData* interactionEventData,
@@ -79,6 +79,10 @@ public:
   void CanInteractWithPlane(vtkMRMLInteractionEventData* interactionEventData,
     int& foundComponentType, int& foundComponentIndex, double& closestDistance2);
 
+  /// The plane can be picked far from its control points, therefore this method returns false
+  /// to indicate that interaction may be possible anywhere in the view.
+  bool GetInteractionDisplayBounds(double displayBounds[4]) override;
+
   bool GetTransformationReferencePoint(double referencePointWorld[3]) override;
 
   void BuildPlane();
@@ -466,6 +466,12 @@ void vtkSlicerPlaneRepresentation3D::CanInteract(
   this->CanInteractWithPlane(interactionEventData, foundComponentType, foundComponentIndex, closestDistance2);
 }
 
+//-----------------------------------------------------------------------------
+bool vtkSlicerPlaneRepresentation3D::GetInteractionDisplayBounds(double vtkNotUsed(displayBounds)[4])
+{
+  return false;
+}
+
 //-----------------------------------------------------------------------------
 void vtkSlicerPlaneRepresentation3D::CanInteractWithPlane(
   vtkMRMLInteractionEventData* interactionEventData,
@@ -82,6 +82,10 @@ public:
   void CanInteractWithPlane(vtkMRMLInteractionEventData* interactionEventData,
     int& foundComponentType, int& foundComponentIndex, double& closestDistance2);
 
+  /// The plane can be picked far from its control points, therefore this method returns false
+  /// to indicate that interaction may be possible anywhere in the view.
+  bool GetInteractionDisplayBounds(double displayBounds[4]) override;
+
 protected:
   vtkSlicerPlaneRepresentation3D();
   ~vtkSlicerPlaneRepresentation3D() override;
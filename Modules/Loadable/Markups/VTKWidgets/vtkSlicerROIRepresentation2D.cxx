@@ -330,6 +330,12 @@ void vtkSlicerROIRepresentation2D::CanInteract(
   this->CanInteractWithROI(interactionEventData, foundComponentType, foundComponentIndex, closestDistance2);
 }
 
+//-----------------------------------------------------------------------------
+bool vtkSlicerROIRepresentation2D::GetInteractionDisplayBounds(double vtkNotUsed(displayBounds)[4])
+{
+  return false;
+}
+
 //-----------------------------------------------------------------------------
 void vtkSlicerROIRepresentation2D::CanInteractWithROI(
   vtkMRMLInteractionEventData* interactionEventData,
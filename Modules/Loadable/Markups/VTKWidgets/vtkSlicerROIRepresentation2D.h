@@ -77,6 +77,10 @@ public:
   void CanInteractWithROI(vtkMRMLInteractionEventData* interactionEventData,
     int& foundComponentType, int& foundComponentIndex, double& closestDistance2);
 
+  /// The ROI can be picked far from its control points, therefore this method returns false
+  /// to indicate that interaction may be possible anywhere in the view.
+  bool GetInteractionDisplayBounds(double displayBounds[4]) override;
+
   // Update visibility of interaction handles for representation
   void UpdateInteractionPipeline() override;
 
@@ -380,6 +380,12 @@ void vtkSlicerROIRepresentation3D::CanInteract(
   this->CanInteractWithROI(interactionEventData, foundComponentType, foundComponentIndex, closestDistance2);
 }
 
+//-----------------------------------------------------------------------------
+bool vtkSlicerROIRepresentation3D::GetInteractionDisplayBounds(double vtkNotUsed(displayBounds)[4])
+{
+  return false;
+}
+
 //-----------------------------------------------------------------------------
 void vtkSlicerROIRepresentation3D::CanInteractWithROI(
   vtkMRMLInteractionEventData* interactionEventData,
@@ -87,6 +87,10 @@ public:
   void CanInteractWithROI(vtkMRMLInteractionEventData* interactionEventData,
     int& foundComponentType, int& foundComponentIndex, double& closestDistance2);
 
+  /// The ROI can be picked far from its control points, therefore this method returns false
+  /// to indicate that interaction may be possible anywhere in the view.
+  bool GetInteractionDisplayBounds(double displayBounds[4]) override;
+
 protected:
   vtkSlicerROIRepresentation3D();
   ~vtkSlicerROIRepresentation3D() override;
@@ -26,12 +26,15 @@
 
 /// VTK includes
 #include <vtkAlgorithmOutput.h>
+#include <vtkAppendPolyData.h>
+#include <vtkCollection.h>
 #include <vtkGeneralTransform.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPolyDataNormals.h>
 #include <vtkSmartPointer.h>
 #include <vtkTagTable.h>
+#include <vtkTransformPolyDataFilter.h>
 
 /// ITK includes
 #include <itksys/Directory.hxx>
@@ -427,6 +430,56 @@ void vtkSlicerModelsLogic::TransformModel(vtkMRMLTransformNode *tnode,
   return;
 }
 
+//----------------------------------------------------------------------------
+bool vtkSlicerModelsLogic::MergeModels(vtkCollection* inputModelNodes, vtkMRMLModelNode* outputModelNode)
+{
+  if (!inputModelNodes || !outputModelNode)
+    {
+    vtkGenericWarningMacro("vtkSlicerModelsLogic::MergeModels failed: invalid input or output");
+    return false;
+    }
+
+  // vtkAppendPolyData computes the size of the output from all the inputs
+  // and copies each input into the preallocated output arrays.
+  vtkNew<vtkAppendPolyData> appendPolyData;
+  int numberOfInputs = 0;
+  for (int modelIndex = 0; modelIndex < inputModelNodes->GetNumberOfItems(); ++modelIndex)
+    {
+    vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(inputModelNodes->GetItemAsObject(modelIndex));
+    if (!modelNode || !modelNode->GetPolyData())
+      {
+      continue;
+      }
+    vtkMRMLTransformNode* transformNode = modelNode->GetParentTransformNode();
+    if (transformNode)
+      {
+      vtkNew<vtkGeneralTransform> modelToWorldTransform;
+      transformNode->GetTransformToWorld(modelToWorldTransform);
+      vtkNew<vtkTransformPolyDataFilter> transformFilter;
+      transformFilter->SetTransform(modelToWorldTransform);
+      transformFilter->SetInputData(modelNode->GetPolyData());
+      transformFilter->Update();
+      appendPolyData->AddInputData(transformFilter->GetOutput());
+      }
+    else
+      {
+      appendPolyData->AddInputData(modelNode->GetPolyData());
+      }
+    ++numberOfInputs;
+    }
+
+  vtkNew<vtkPolyData> mergedPolyData;
+  if (numberOfInputs > 0)
+    {
+    appendPolyData->Update();
+    mergedPolyData->ShallowCopy(appendPolyData->GetOutput());
+    }
+  outputModelNode->SetAndObservePolyData(mergedPolyData);
+  // merged polydata is in world coordinate system
+  outputModelNode->SetAndObserveTransformNodeID(nullptr);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkSlicerModelsLogic::SetAllModelsVisibility(int flag)
 {
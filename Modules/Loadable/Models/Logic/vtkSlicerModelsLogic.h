@@ -30,6 +30,7 @@ class vtkMRMLModelNode;
 class vtkMRMLStorageNode;
 class vtkMRMLTransformNode;
 class vtkAlgorithmOutput;
+class vtkCollection;
 class vtkPolyData;
 
 class VTK_SLICER_MODELS_MODULE_LOGIC_EXPORT vtkSlicerModelsLogic
@@ -86,6 +87,16 @@ class VTK_SLICER_MODELS_MODULE_LOGIC_EXPORT vtkSlicerModelsLogic
                               int transformNormals,
                               vtkMRMLModelNode *modelOut);
 
+  /// Merge polydata of all the input model nodes into the output model node in one pass.
+  /// Output point and cell arrays are allocated once for all the inputs, therefore this is
+  /// much faster than appending models one by one.
+  /// Input models that are under a transform are transformed to world coordinate system
+  /// before merging. Input models without polydata are ignored.
+  /// \param inputModelNodes collection of vtkMRMLModelNode objects
+  /// \param outputModelNode model node that will store the merged polydata. It may be one of the input nodes.
+  /// \return true on success
+  static bool MergeModels(vtkCollection* inputModelNodes, vtkMRMLModelNode* outputModelNode);
+
   /// Iterate through all models in the scene, find all their display nodes
   /// and set their visibility flag to flag. Does not touch model hierarchy
   /// nodes with display nodes
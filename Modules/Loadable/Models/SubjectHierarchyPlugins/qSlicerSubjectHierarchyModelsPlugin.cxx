@@ -143,6 +143,12 @@ double qSlicerSubjectHierarchyModelsPlugin::canOwnSubjectHierarchyItem(vtkIdType
   return 0.0;
 }
 
+//---------------------------------------------------------------------------
+bool qSlicerSubjectHierarchyModelsPlugin::ownerConfidenceCacheable()const
+{
+  return true;
+}
+
 //---------------------------------------------------------------------------
 const QString qSlicerSubjectHierarchyModelsPlugin::roleForPlugin()const
 {
@@ -0,0 +1,86 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// Models logic
+#include "vtkSlicerModelsLogic.h"
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+#include <vtkMRMLLinearTransformNode.h>
+#include <vtkMRMLModelNode.h>
+#include <vtkMRMLScene.h>
+
+// VTK includes
+#include <vtkCollection.h>
+#include <vtkCubeSource.h>
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtkSphereSource.h>
+#include <vtkTransform.h>
+
+//-----------------------------------------------------------------------------
+int vtkSlicerModelsLogicMergeModelsTest(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkMRMLScene> scene;
+
+  vtkNew<vtkSphereSource> sphereSource;
+  sphereSource->Update();
+  vtkMRMLModelNode* sphereModelNode = vtkMRMLModelNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLModelNode"));
+  sphereModelNode->SetAndObservePolyData(sphereSource->GetOutput());
+
+  vtkNew<vtkCubeSource> cubeSource;
+  cubeSource->Update();
+  vtkMRMLModelNode* cubeModelNode = vtkMRMLModelNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLModelNode"));
+  cubeModelNode->SetAndObservePolyData(cubeSource->GetOutput());
+
+  // Translate the cube to check that transforms are hardened
+  vtkMRMLLinearTransformNode* transformNode = vtkMRMLLinearTransformNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLLinearTransformNode"));
+  vtkNew<vtkTransform> translation;
+  translation->Translate(100.0, 0.0, 0.0);
+  transformNode->SetMatrixTransformToParent(translation->GetMatrix());
+  cubeModelNode->SetAndObserveTransformNodeID(transformNode->GetID());
+
+  vtkMRMLModelNode* emptyModelNode = vtkMRMLModelNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLModelNode"));
+
+  vtkNew<vtkCollection> inputModelNodes;
+  inputModelNodes->AddItem(sphereModelNode);
+  inputModelNodes->AddItem(cubeModelNode);
+  inputModelNodes->AddItem(emptyModelNode);
+
+  vtkMRMLModelNode* outputModelNode = vtkMRMLModelNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLModelNode"));
+  CHECK_BOOL(vtkSlicerModelsLogic::MergeModels(inputModelNodes, outputModelNode), true);
+  CHECK_NOT_NULL(outputModelNode->GetPolyData());
+  CHECK_INT(outputModelNode->GetPolyData()->GetNumberOfPoints(),
+    sphereSource->GetOutput()->GetNumberOfPoints() + cubeSource->GetOutput()->GetNumberOfPoints());
+  CHECK_INT(outputModelNode->GetPolyData()->GetNumberOfCells(),
+    sphereSource->GetOutput()->GetNumberOfCells() + cubeSource->GetOutput()->GetNumberOfCells());
+  double bounds[6] = { 0.0, -1.0, 0.0, -1.0, 0.0, -1.0 };
+  outputModelNode->GetPolyData()->GetBounds(bounds);
+  CHECK_DOUBLE_TOLERANCE(bounds[1], 100.5, 1e-6);
+
+  // Merging an empty list results in empty polydata
+  vtkNew<vtkCollection> noModelNodes;
+  CHECK_BOOL(vtkSlicerModelsLogic::MergeModels(noModelNodes, outputModelNode), true);
+  CHECK_NOT_NULL(outputModelNode->GetPolyData());
+  CHECK_INT(outputModelNode->GetPolyData()->GetNumberOfPoints(), 0);
+
+  // Invalid input
+  TESTING_OUTPUT_ASSERT_WARNINGS_BEGIN();
+  CHECK_BOOL(vtkSlicerModelsLogic::MergeModels(nullptr, outputModelNode), false);
+  TESTING_OUTPUT_ASSERT_WARNINGS_END();
+
+  return EXIT_SUCCESS;
+}
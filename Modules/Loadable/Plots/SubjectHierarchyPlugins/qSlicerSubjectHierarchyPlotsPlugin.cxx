@@ -160,6 +160,12 @@ double qSlicerSubjectHierarchyPlotsPlugin::canOwnSubjectHierarchyItem(vtkIdType
   return 0.0;
 }
 
+//---------------------------------------------------------------------------
+bool qSlicerSubjectHierarchyPlotsPlugin::ownerConfidenceCacheable()const
+{
+  return true;
+}
+
 //---------------------------------------------------------------------------
 const QString qSlicerSubjectHierarchyPlotsPlugin::roleForPlugin()const
 {
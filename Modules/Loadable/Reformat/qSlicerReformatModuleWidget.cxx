@@ -23,6 +23,9 @@
 #include <QMenu>
 #include <QString>
 
+// CTK includes
+#include <ctkDoubleSlider.h>
+
 // Slicer includes
 #include "qMRMLSliceControllerWidget_p.h" // For updateSliceOrientationSelector
 #include "vtkMRMLSliceNode.h"
@@ -411,6 +414,14 @@ void qSlicerReformatModuleWidget::setup()
                 this, SLOT(onSliderRotationChanged(double)));
   this->connect(d->RotateZSlider, SIGNAL(valueChanged(double)),
                 this, SLOT(onSliderRotationChanged(double)));
+  foreach(qMRMLLinearTransformSlider* rotationSlider,
+          QList<qMRMLLinearTransformSlider*>() << d->RotateXSlider << d->RotateYSlider << d->RotateZSlider)
+    {
+    this->connect(rotationSlider->slider(), SIGNAL(sliderPressed()),
+                  this, SLOT(onSliderRotationStarted()));
+    this->connect(rotationSlider->slider(), SIGNAL(sliderReleased()),
+                  this, SLOT(onSliderRotationEnded()));
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -713,6 +724,28 @@ onSliderRotationChanged(double rotation)
     }
 }
 
+//------------------------------------------------------------------------------
+void qSlicerReformatModuleWidget::onSliderRotationStarted()
+{
+  Q_D(qSlicerReformatModuleWidget);
+  if (!d->MRMLSliceLogic)
+    {
+    return;
+    }
+  d->MRMLSliceLogic->StartSliceNodeInteraction(vtkMRMLSliceNode::MultiplanarReformatFlag);
+}
+
+//------------------------------------------------------------------------------
+void qSlicerReformatModuleWidget::onSliderRotationEnded()
+{
+  Q_D(qSlicerReformatModuleWidget);
+  if (!d->MRMLSliceLogic)
+    {
+    return;
+    }
+  d->MRMLSliceLogic->EndSliceNodeInteraction();
+}
+
 //------------------------------------------------------------------------------
 void qSlicerReformatModuleWidget::centerSliceNode()
 {
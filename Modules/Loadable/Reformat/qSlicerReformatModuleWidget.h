@@ -113,6 +113,12 @@ protected slots:
   void onSliceOrientationChanged(const QString& orientation);
   void onSliderRotationChanged(double rotationX);
 
+  /// Dragging a rotation slider is handled as a reformat interaction of the
+  /// slice node, so that linked views are updated only when the slider is
+  /// released, and progressive slice rendering can be used.
+  void onSliderRotationStarted();
+  void onSliderRotationEnded();
+
 protected:
   QScopedPointer<qSlicerReformatModuleWidgetPrivate> d_ptr;
 
@@ -143,6 +143,12 @@ double qSlicerSubjectHierarchySceneViewsPlugin::canOwnSubjectHierarchyItem(vtkId
   return 0.0;
 }
 
+//---------------------------------------------------------------------------
+bool qSlicerSubjectHierarchySceneViewsPlugin::ownerConfidenceCacheable()const
+{
+  return true;
+}
+
 //---------------------------------------------------------------------------
 const QString qSlicerSubjectHierarchySceneViewsPlugin::roleForPlugin()const
 {
@@ -18,6 +18,7 @@ class SegmentEditorFillBetweenSlicesEffect(AbstractScriptedSegmentEditorAutoComp
         AbstractScriptedSegmentEditorAutoCompleteEffect.__init__(self, scriptedEffect)
         scriptedEffect.name = "Fill between slices"  # no tr (don't translate it because modules find effects by name)
         scriptedEffect.title = _("Fill between slices")
+        self.interpolator = None
 
     def clone(self):
         import qSlicerSegmentationsEditorEffectsPythonQt as effects
@@ -45,13 +46,21 @@ Masking settings are ignored. If segments overlap, segment higher in the segment
 The effect uses  <a href="https://insight-journal.org/browse/publication/977">morphological contour interpolation method</a>.
 <p>""")
 
+    def reset(self):
+        self.interpolator = None
+        AbstractScriptedSegmentEditorAutoCompleteEffect.reset(self)
+
     def computePreviewLabelmap(self, mergedImage, outputLabelmap):
         import vtkITK
 
-        interpolator = vtkITK.vtkITKMorphologicalContourInterpolator()
-        interpolator.SetInputData(mergedImage)
-        interpolator.Update()
-        outputLabelmap.DeepCopy(interpolator.GetOutput())
+        if not self.interpolator:
+            self.interpolator = vtkITK.vtkITKMorphologicalContourInterpolator()
+            # Segments are interpolated in parallel and when the preview is updated,
+            # only the segments that have been modified are interpolated again.
+            self.interpolator.SetParallelComputation(True)
+        self.interpolator.SetInputData(mergedImage)
+        self.interpolator.Update()
+        outputLabelmap.DeepCopy(self.interpolator.GetOutput())
         imageToWorld = vtk.vtkMatrix4x4()
         mergedImage.GetImageToWorldMatrix(imageToWorld)
         outputLabelmap.SetImageToWorldMatrix(imageToWorld)
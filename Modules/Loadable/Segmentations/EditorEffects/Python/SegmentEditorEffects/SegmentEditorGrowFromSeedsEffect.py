@@ -112,6 +112,9 @@ class SegmentEditorGrowFromSeedsEffect(AbstractScriptedSegmentEditorAutoComplete
             self.growCutFilter = vtkITK.vtkITKGrowCut()
             self.growCutFilter.SetIntensityVolume(self.clippedMasterImageData)
             self.growCutFilter.SetMaskVolume(self.clippedMaskImageData)
+            # Large volumes are computed faster using multiple threads
+            dimensions = self.clippedMasterImageData.GetDimensions()
+            self.growCutFilter.SetParallelComputation(dimensions[0] * dimensions[1] * dimensions[2] > 2**24)
             maskExtent = self.clippedMaskImageData.GetExtent() if self.clippedMaskImageData else None
             if (
                 maskExtent is not None
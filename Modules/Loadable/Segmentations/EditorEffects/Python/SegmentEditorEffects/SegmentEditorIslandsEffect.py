@@ -154,6 +154,8 @@ about each operation, hover the mouse over the option and wait for the tooltip t
         islandMath.SetInputConnection(castIn.GetOutputPort())
         islandMath.SetFullyConnected(False)
         islandMath.SetMinimumSize(minimumSize)
+        islandMath.SetParallelComputation(True)
+        islandMath.SetRestrictToEffectiveExtent(True)
         islandMath.Update()
 
         islandImage = slicer.vtkOrientedImageData()
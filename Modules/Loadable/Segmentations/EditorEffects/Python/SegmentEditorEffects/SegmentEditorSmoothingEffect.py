@@ -333,12 +333,22 @@ If segments overlap, segment higher in the segments table will have priority. <b
                 else:
                     clippedSelectedSegmentLabelmap = selectedSegmentLabelmap
 
+                # Binary labelmap kernels of the segmentations logic give the same result as the VTK filters but compute it faster
+                smoothedImage = slicer.vtkOrientedImageData()
                 if smoothingMethod == MEDIAN:
+                    if slicer.vtkSlicerSegmentationsModuleLogic.SmoothBinaryLabelmapMedian(
+                            clippedSelectedSegmentLabelmap, kernelSizePixel, smoothedImage):
+                        self.modifySelectedSegmentByLabelmap(smoothedImage, selectedSegmentLabelmap, modifierLabelmap, maskImage, maskExtent)
+                        return
                     # Median filter does not require a particular label value
                     smoothingFilter = vtk.vtkImageMedian3D()
                     smoothingFilter.SetInputData(clippedSelectedSegmentLabelmap)
 
                 else:
+                    if slicer.vtkSlicerSegmentationsModuleLogic.SmoothBinaryLabelmapOpenClose(
+                            clippedSelectedSegmentLabelmap, kernelSizePixel, smoothingMethod == MORPHOLOGICAL_OPENING, smoothedImage):
+                        self.modifySelectedSegmentByLabelmap(smoothedImage, selectedSegmentLabelmap, modifierLabelmap, maskImage, maskExtent)
+                        return
                     # We need to know exactly the value of the segment voxels, apply threshold to make force the selected label value
                     labelValue = 1
                     backgroundValue = 0
@@ -390,64 +400,15 @@ If segments overlap, segment higher in the segments table will have priority. <b
             segmentId = visibleSegmentIds.GetValue(i)
             segmentLabelValues.append([segmentId, i + 1])
 
-        # Perform smoothing in voxel space
-        ici = vtk.vtkImageChangeInformation()
-        ici.SetInputData(mergedImage)
-        ici.SetOutputSpacing(1, 1, 1)
-        ici.SetOutputOrigin(0, 0, 0)
-
-        # Convert labelmap to combined polydata
-        # vtkDiscreteFlyingEdges3D cannot be used here, as in the output of that filter,
-        # each labeled region is completely disconnected from neighboring regions, and
-        # for joint smoothing it is essential for the points to move together.
-        convertToPolyData = vtk.vtkDiscreteMarchingCubes()
-        convertToPolyData.SetInputConnection(ici.GetOutputPort())
-        convertToPolyData.SetNumberOfContours(len(segmentLabelValues))
-
-        contourIndex = 0
+        # Smooth the surface of all segments jointly and convert it back to binary labelmaps
+        labelValues = vtk.vtkIntArray()
         for segmentId, labelValue in segmentLabelValues:
-            convertToPolyData.SetValue(contourIndex, labelValue)
-            contourIndex += 1
-
-        # Low-pass filtering using Taubin's method
+            labelValues.InsertNextValue(labelValue)
         smoothingFactor = self.scriptedEffect.doubleParameter("JointTaubinSmoothingFactor")
-        smoothingIterations = 100  # according to VTK documentation 10-20 iterations could be enough but we use a higher value to reduce chance of shrinking
-        passBand = pow(10.0, -4.0 * smoothingFactor)  # gives a nice range of 1-0.0001 from a user input of 0-1
-        smoother = vtk.vtkWindowedSincPolyDataFilter()
-        smoother.SetInputConnection(convertToPolyData.GetOutputPort())
-        smoother.SetNumberOfIterations(smoothingIterations)
-        smoother.BoundarySmoothingOff()
-        smoother.FeatureEdgeSmoothingOff()
-        smoother.SetFeatureAngle(90.0)
-        smoother.SetPassBand(passBand)
-        smoother.NonManifoldSmoothingOn()
-        smoother.NormalizeCoordinatesOn()
-
-        # Extract a label
-        threshold = vtk.vtkThreshold()
-        threshold.SetInputConnection(smoother.GetOutputPort())
-
-        # Convert to polydata
-        geometryFilter = vtk.vtkGeometryFilter()
-        geometryFilter.SetInputConnection(threshold.GetOutputPort())
-
-        # Convert polydata to stencil
-        polyDataToImageStencil = vtk.vtkPolyDataToImageStencil()
-        polyDataToImageStencil.SetInputConnection(geometryFilter.GetOutputPort())
-        polyDataToImageStencil.SetOutputSpacing(1, 1, 1)
-        polyDataToImageStencil.SetOutputOrigin(0, 0, 0)
-        polyDataToImageStencil.SetOutputWholeExtent(mergedImage.GetExtent())
-
-        # Convert stencil to image
-        stencil = vtk.vtkImageStencil()
-        emptyBinaryLabelMap = vtk.vtkImageData()
-        emptyBinaryLabelMap.SetExtent(mergedImage.GetExtent())
-        emptyBinaryLabelMap.AllocateScalars(vtk.VTK_UNSIGNED_CHAR, 1)
-        vtkSegmentationCore.vtkOrientedImageDataResample.FillImage(emptyBinaryLabelMap, 0)
-        stencil.SetInputData(emptyBinaryLabelMap)
-        stencil.SetStencilConnection(polyDataToImageStencil.GetOutputPort())
-        stencil.ReverseStencilOn()
-        stencil.SetBackgroundValue(1)  # General foreground value is 1 (background value because of reverse stencil)
+        smoothedLabelmaps = vtk.vtkCollection()
+        if not slicer.vtkSlicerSegmentationsModuleLogic.JointSmoothLabelmap(mergedImage, labelValues, smoothingFactor, smoothedLabelmaps):
+            logging.error("Failed to apply smoothing")
+            return
 
         imageToWorldMatrix = vtk.vtkMatrix4x4()
         mergedImage.GetImageToWorldMatrix(imageToWorldMatrix)
@@ -457,13 +418,11 @@ If segments overlap, segment higher in the segments table will have priority. <b
         # separated/merged automatically. This effect could leverage those options once they have been implemented.
         oldOverwriteMode = self.scriptedEffect.parameterSetNode().GetOverwriteMode()
         self.scriptedEffect.parameterSetNode().SetOverwriteMode(slicer.vtkMRMLSegmentEditorNode.OverwriteVisibleSegments)
-        for segmentId, labelValue in segmentLabelValues:
-            threshold.SetLowerThreshold(labelValue)
-            threshold.SetUpperThreshold(labelValue)
-            threshold.SetThresholdFunction(vtk.vtkThreshold.THRESHOLD_BETWEEN)
-            stencil.Update()
+        for segmentIndex, (segmentId, labelValue) in enumerate(segmentLabelValues):
+            # Smoothed labelmaps only cover the smoothed segment, pad them to the merged labelmap extent
             smoothedBinaryLabelMap = slicer.vtkOrientedImageData()
-            smoothedBinaryLabelMap.ShallowCopy(stencil.GetOutput())
+            slicer.vtkOrientedImageDataResample.PadImageToContainImage(smoothedLabelmaps.GetItemAsObject(segmentIndex),
+                                                                       mergedImage, smoothedBinaryLabelMap)
             smoothedBinaryLabelMap.SetImageToWorldMatrix(imageToWorldMatrix)
             self.scriptedEffect.modifySegmentByLabelmap(segmentationNode, segmentId, smoothedBinaryLabelMap,
                                                         slicer.qSlicerSegmentEditorAbstractEffect.ModificationModeSet, False)
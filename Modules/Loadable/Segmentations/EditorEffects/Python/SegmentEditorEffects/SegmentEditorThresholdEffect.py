@@ -619,7 +619,9 @@ class SegmentEditorThresholdEffect(AbstractScriptedSegmentEditorEffect):
             thresh.SetOutValue(0)
             thresh.SetOutputScalarType(modifierLabelmap.GetScalarType())
             thresh.Update()
-            modifierLabelmap.DeepCopy(thresh.GetOutput())
+            # The filter output is not used anywhere else, so it can be used directly
+            # as modifier labelmap (no need to copy the full volume)
+            modifierLabelmap.ShallowCopy(thresh.GetOutput())
         except IndexError:
             logging.error("apply: Failed to threshold source volume!")
             pass
@@ -691,10 +693,10 @@ class SegmentEditorThresholdEffect(AbstractScriptedSegmentEditorEffect):
         # Set values to pipelines
         for sliceWidget in self.previewPipelines:
             pipeline = self.previewPipelines[sliceWidget]
-            pipeline.lookupTable.SetTableValue(1, r, g, b, opacity)
+            pipeline.setThresholdRange(min, max)
+            pipeline.lookupTable.SetTableValue(0, r, g, b, opacity)
             layerLogic = self.getSourceVolumeLayerLogic(sliceWidget)
-            pipeline.thresholdFilter.SetInputConnection(layerLogic.GetReslice().GetOutputPort())
-            pipeline.thresholdFilter.ThresholdBetween(min, max)
+            pipeline.colorMapper.SetInputConnection(layerLogic.GetReslice().GetOutputPort())
             pipeline.actor.VisibilityOn()
             sliceWidget.sliceView().scheduleRender()
 
@@ -942,18 +944,23 @@ class PreviewPipeline:
     """Visualization objects and pipeline for each slice view for threshold preview"""
 
     def __init__(self):
+        # The resliced source volume is colored directly by the lookup table:
+        # values within the threshold range are mapped to the segment color,
+        # values outside are mapped to transparent below/above range colors.
+        # This way changing the threshold range only requires a single pass over the slice.
         self.lookupTable = vtk.vtkLookupTable()
         self.lookupTable.SetRampToLinear()
-        self.lookupTable.SetNumberOfTableValues(2)
+        self.lookupTable.SetNumberOfTableValues(1)
         self.lookupTable.SetTableRange(0, 1)
         self.lookupTable.SetTableValue(0, 0, 0, 0, 0)
+        self.lookupTable.SetBelowRangeColor(0, 0, 0, 0)
+        self.lookupTable.SetAboveRangeColor(0, 0, 0, 0)
+        self.lookupTable.SetNanColor(0, 0, 0, 0)
+        self.lookupTable.UseBelowRangeColorOn()
+        self.lookupTable.UseAboveRangeColorOn()
         self.colorMapper = vtk.vtkImageMapToRGBA()
         self.colorMapper.SetOutputFormatToRGBA()
         self.colorMapper.SetLookupTable(self.lookupTable)
-        self.thresholdFilter = vtk.vtkImageThreshold()
-        self.thresholdFilter.SetInValue(1)
-        self.thresholdFilter.SetOutValue(0)
-        self.thresholdFilter.SetOutputScalarTypeToUnsignedChar()
 
         # Feedback actor
         self.mapper = vtk.vtkImageMapper()
@@ -967,9 +974,15 @@ class PreviewPipeline:
         self.mapper.SetColorLevel(128)
 
         # Setup pipeline
-        self.colorMapper.SetInputConnection(self.thresholdFilter.GetOutputPort())
         self.mapper.SetInputConnection(self.colorMapper.GetOutputPort())
 
+    def setThresholdRange(self, minimum, maximum):
+        # Lookup table range must not be empty, therefore a minimal range is used
+        # when the minimum and maximum threshold values are the same.
+        if maximum <= minimum:
+            maximum = minimum + max(abs(minimum), 1.0) * 1e-6
+        self.lookupTable.SetTableRange(minimum, maximum)
+
 
 ###
 #
@@ -48,10 +48,8 @@
 #include <vtkGlyph2D.h>
 #include <vtkGlyph3D.h>
 #include <vtkIdList.h>
-#include <vtkImageChangeInformation.h>
 #include <vtkImageStencil.h>
 #include <vtkImageStencilData.h>
-#include <vtkImageStencilToImage.h>
 #include <vtkMath.h>
 #include <vtkMatrix4x4.h>
 #include <vtkNew.h>
@@ -62,7 +60,6 @@
 #include <vtkPolyDataMapper.h>
 #include <vtkPolyDataMapper2D.h>
 #include <vtkPolyDataNormals.h>
-#include <vtkPolyDataToImageStencil.h>
 #include <vtkProperty2D.h>
 #include <vtkProperty.h>
 #include <vtkPropPicker.h>
@@ -263,13 +260,8 @@ qSlicerSegmentEditorPaintEffectPrivate::qSlicerSegmentEditorPaintEffectPrivate(q
   this->WorldOriginToWorldTransformer->SetTransform(this->WorldOriginToWorldTransform);
   this->WorldOriginToWorldTransformer->SetInputConnection(this->BrushPolyDataNormals->GetOutputPort());
 
-  this->WorldOriginToModifierLabelmapIjkTransformer = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
   this->WorldOriginToModifierLabelmapIjkTransform = vtkSmartPointer<vtkTransform>::New();
-  this->WorldOriginToModifierLabelmapIjkTransformer->SetTransform(this->WorldOriginToModifierLabelmapIjkTransform);
-  this->WorldOriginToModifierLabelmapIjkTransformer->SetInputConnection(this->BrushPolyDataNormals->GetOutputPort());
-  this->BrushPolyDataToStencil = vtkSmartPointer<vtkPolyDataToImageStencil>::New();
-  this->BrushPolyDataToStencil->SetOutputSpacing(1.0,1.0,1.0);
-  this->BrushPolyDataToStencil->SetInputConnection(this->WorldOriginToModifierLabelmapIjkTransformer->GetOutputPort());
+  this->BrushStencil = vtkSmartPointer<vtkImageStencilData>::New();
 
   this->FeedbackGlyphFilter = vtkSmartPointer<vtkGlyph3D>::New();
   this->FeedbackGlyphFilter->SetInputData(this->FeedbackPointsPolyData);
@@ -368,7 +360,7 @@ void qSlicerSegmentEditorPaintEffectPrivate::paintAddPoint(qMRMLWidget* viewWidg
 }
 
 //-----------------------------------------------------------------------------
-void qSlicerSegmentEditorPaintEffectPrivate::updateBrushStencil(qMRMLWidget* viewWidget)
+bool qSlicerSegmentEditorPaintEffectPrivate::updateBrushStencil(qMRMLWidget* viewWidget)
 {
   Q_Q(qSlicerSegmentEditorPaintEffect);
   Q_UNUSED(viewWidget);
@@ -376,19 +368,24 @@ void qSlicerSegmentEditorPaintEffectPrivate::updateBrushStencil(qMRMLWidget* vie
   if (!q->parameterSetNode())
     {
     qCritical() << Q_FUNC_INFO << ": Invalid segment editor parameter set node!";
-    return;
+    return false;
     }
   vtkMRMLSegmentationNode* segmentationNode = q->parameterSetNode()->GetSegmentationNode();
   if (!segmentationNode)
     {
     qCritical() << Q_FUNC_INFO << ": Invalid segmentationNode";
-    return;
+    return false;
     }
   vtkOrientedImageData* modifierLabelmap = q->modifierLabelmap();
   if (!modifierLabelmap)
     {
     qCritical() << Q_FUNC_INFO << ": Invalid modifierLabelmap";
-    return;
+    return false;
+    }
+  if (this->BrushToWorldOriginTransformer->GetNumberOfInputConnections(0) == 0)
+    {
+    // brush model has not been created yet
+    return false;
     }
 
   // Brush stencil transform
@@ -412,11 +409,171 @@ void qSlicerSegmentEditorPaintEffectPrivate::updateBrushStencil(qMRMLWidget* vie
   worldToSegmentationTransformMatrix->SetElement(2,3, 0);
   this->WorldOriginToModifierLabelmapIjkTransform->Concatenate(worldToSegmentationTransformMatrix.GetPointer());
 
-  this->WorldOriginToModifierLabelmapIjkTransformer->Update();
-  vtkPolyData* brushModel_ModifierLabelmapIjk = this->WorldOriginToModifierLabelmapIjkTransformer->GetOutput();
-  double* boundsIjk = brushModel_ModifierLabelmapIjk->GetBounds();
-  this->BrushPolyDataToStencil->SetOutputWholeExtent(floor(boundsIjk[0])-1, ceil(boundsIjk[1])+1,
-    floor(boundsIjk[2])-1, ceil(boundsIjk[3])+1, floor(boundsIjk[4])-1, ceil(boundsIjk[5])+1);
+  vtkNew<vtkTransform> brushToModifierLabelmapIjkTransform;
+  brushToModifierLabelmapIjkTransform->Concatenate(this->WorldOriginToModifierLabelmapIjkTransform);
+  brushToModifierLabelmapIjkTransform->Concatenate(this->BrushToWorldOriginTransform);
+  vtkMatrix4x4* brushToModifierLabelmapIjkMatrix = brushToModifierLabelmapIjkTransform->GetMatrix();
+
+  bool sphere = (this->BrushToWorldOriginTransformer->GetInputAlgorithm() == this->BrushSphereSource.GetPointer());
+  double radius = sphere ? this->BrushSphereSource->GetRadius() : this->BrushCylinderSource->GetRadius();
+  double height = sphere ? 0.0 : this->BrushCylinderSource->GetHeight();
+
+  // The brush model is recreated at each mouse move, therefore we cannot rely on
+  // pipeline modification times. Instead, the stencil is recomputed only if any of the
+  // parameters that determine the brush shape in IJK coordinate system changed.
+  std::vector<double> brushStencilParameters;
+  brushStencilParameters.push_back(sphere ? 1.0 : 0.0);
+  brushStencilParameters.push_back(radius);
+  brushStencilParameters.push_back(height);
+  for (int row = 0; row < 3; row++)
+    {
+    for (int column = 0; column < 3; column++)
+      {
+      brushStencilParameters.push_back(brushToModifierLabelmapIjkMatrix->GetElement(row, column));
+      }
+    }
+  if (brushStencilParameters == this->BrushStencilParameters)
+    {
+    // brush stencil is up-to-date
+    return true;
+    }
+
+  this->rasterizeBrushStencil(brushToModifierLabelmapIjkMatrix, sphere, radius, height);
+  this->BrushStencilParameters = brushStencilParameters;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+namespace
+{
+/// Get range of x values where a*x^2 + b*x + c <= 0.
+/// Returns false if there are no such values. If the condition holds for all x
+/// then the input xMin, xMax values are left unchanged.
+bool GetBrushRowQuadraticRange(double a, double b, double c, double& xMin, double& xMax)
+{
+  const double epsilon = 1e-12;
+  if (fabs(a) < epsilon)
+    {
+    if (fabs(b) < epsilon)
+      {
+      return (c <= 0.0);
+      }
+    double root = -c / b;
+    if (b > 0)
+      {
+      xMax = std::min(xMax, root);
+      }
+    else
+      {
+      xMin = std::max(xMin, root);
+      }
+    return (xMin <= xMax);
+    }
+  double discriminant = b * b - 4.0 * a * c;
+  if (discriminant < 0.0)
+    {
+    return false;
+    }
+  double discriminantSqrt = sqrt(discriminant);
+  xMin = std::max(xMin, (-b - discriminantSqrt) / (2.0 * a));
+  xMax = std::min(xMax, (-b + discriminantSqrt) / (2.0 * a));
+  return (xMin <= xMax);
+}
+}
+
+//-----------------------------------------------------------------------------
+void qSlicerSegmentEditorPaintEffectPrivate::rasterizeBrushStencil(vtkMatrix4x4* brushToModifierLabelmapIjk,
+  bool sphere, double radius, double height)
+{
+  // Sphere is centered at the origin. Cylinder is centered at the origin, its axis is the Y axis
+  // (same as the shapes created by vtkSphereSource and vtkCylinderSource).
+  double halfHeight = height / 2.0;
+
+  // Compute brush bounding box in IJK coordinate system
+  int stencilExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  for (int i = 0; i < 3; i++)
+    {
+    double m0 = brushToModifierLabelmapIjk->GetElement(i, 0);
+    double m1 = brushToModifierLabelmapIjk->GetElement(i, 1);
+    double m2 = brushToModifierLabelmapIjk->GetElement(i, 2);
+    double halfSize = 0.0;
+    if (sphere)
+      {
+      halfSize = radius * sqrt(m0 * m0 + m1 * m1 + m2 * m2);
+      }
+    else
+      {
+      halfSize = fabs(m1) * halfHeight + radius * sqrt(m0 * m0 + m2 * m2);
+      }
+    stencilExtent[i * 2] = static_cast<int>(floor(-halfSize));
+    stencilExtent[i * 2 + 1] = static_cast<int>(ceil(halfSize));
+    }
+
+  vtkNew<vtkMatrix4x4> modifierLabelmapIjkToBrush;
+  vtkMatrix4x4::Invert(brushToModifierLabelmapIjk, modifierLabelmapIjkToBrush.GetPointer());
+  // brush position change when moving one voxel along the image row
+  double rowDirection_Brush[3] =
+    {
+    modifierLabelmapIjkToBrush->GetElement(0, 0),
+    modifierLabelmapIjkToBrush->GetElement(1, 0),
+    modifierLabelmapIjkToBrush->GetElement(2, 0)
+    };
+
+  this->BrushStencil->Initialize();
+  this->BrushStencil->SetSpacing(1.0, 1.0, 1.0);
+  this->BrushStencil->SetOrigin(0.0, 0.0, 0.0);
+  this->BrushStencil->SetExtent(stencilExtent);
+  this->BrushStencil->AllocateExtents();
+
+  // Tolerance for including voxels that are exactly on the brush boundary despite rounding errors
+  const double tolerance = 1e-6;
+  for (int k = stencilExtent[4]; k <= stencilExtent[5]; k++)
+    {
+    for (int j = stencilExtent[2]; j <= stencilExtent[3]; j++)
+      {
+      // brush position of voxel (0, j, k)
+      double rowStart_Brush[3] = { 0.0, 0.0, 0.0 };
+      for (int i = 0; i < 3; i++)
+        {
+        rowStart_Brush[i] = modifierLabelmapIjkToBrush->GetElement(i, 1) * j
+          + modifierLabelmapIjkToBrush->GetElement(i, 2) * k;
+        }
+      double xMin = stencilExtent[0];
+      double xMax = stencilExtent[1];
+      bool inside = false;
+      if (sphere)
+        {
+        // |x * rowDirection + rowStart|^2 <= radius^2
+        inside = GetBrushRowQuadraticRange(vtkMath::Dot(rowDirection_Brush, rowDirection_Brush),
+          2.0 * vtkMath::Dot(rowDirection_Brush, rowStart_Brush),
+          vtkMath::Dot(rowStart_Brush, rowStart_Brush) - radius * radius, xMin, xMax);
+        }
+      else
+        {
+        // |x * rowDirection_y + rowStart_y| <= halfHeight (between the two caps)
+        double d1 = rowDirection_Brush[1];
+        double s1 = rowStart_Brush[1];
+        inside = GetBrushRowQuadraticRange(d1 * d1, 2.0 * d1 * s1, s1 * s1 - halfHeight * halfHeight, xMin, xMax);
+        // (x * rowDirection_x + rowStart_x)^2 + (x * rowDirection_z + rowStart_z)^2 <= radius^2
+        double d0 = rowDirection_Brush[0];
+        double s0 = rowStart_Brush[0];
+        double d2 = rowDirection_Brush[2];
+        double s2 = rowStart_Brush[2];
+        inside = inside && GetBrushRowQuadraticRange(d0 * d0 + d2 * d2, 2.0 * (d0 * s0 + d2 * s2),
+          s0 * s0 + s2 * s2 - radius * radius, xMin, xMax);
+        }
+      if (!inside)
+        {
+        continue;
+        }
+      int r1 = std::max(stencilExtent[0], static_cast<int>(ceil(xMin - tolerance)));
+      int r2 = std::min(stencilExtent[1], static_cast<int>(floor(xMax + tolerance)));
+      if (r1 <= r2)
+        {
+        this->BrushStencil->InsertNextExtent(r1, r2, j, k);
+        }
+      }
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -515,6 +672,54 @@ void qSlicerSegmentEditorPaintEffectPrivate::paintPixels(
   modifierLabelmap->Modified();
 }
 
+//-----------------------------------------------------------------------------
+namespace
+{
+/// Set voxels of the image that are inside the stencil shifted by the specified offset
+/// to at least the specified value (same as maximum operation between the image and the brush).
+template <class T>
+void PaintBrushStencilGeneric(vtkImageData* image, T* vtkNotUsed(scalarType), vtkImageStencilData* stencil,
+  const int shift[3], double value)
+{
+  int imageExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  image->GetExtent(imageExtent);
+  int stencilExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  stencil->GetExtent(stencilExtent);
+  T valueToSet = static_cast<T>(value);
+
+  int zMin = std::max(stencilExtent[4], imageExtent[4] - shift[2]);
+  int zMax = std::min(stencilExtent[5], imageExtent[5] - shift[2]);
+  int yMin = std::max(stencilExtent[2], imageExtent[2] - shift[1]);
+  int yMax = std::min(stencilExtent[3], imageExtent[3] - shift[1]);
+  for (int z = zMin; z <= zMax; z++)
+    {
+    for (int y = yMin; y <= yMax; y++)
+      {
+      int r1 = 0;
+      int r2 = -1;
+      int iter = 0;
+      while (stencil->GetNextExtent(r1, r2, stencilExtent[0], stencilExtent[1], y, z, iter))
+        {
+        int xMin = std::max(r1 + shift[0], imageExtent[0]);
+        int xMax = std::min(r2 + shift[0], imageExtent[1]);
+        if (xMin > xMax)
+          {
+          continue;
+          }
+        T* voxelPtr = static_cast<T*>(image->GetScalarPointer(xMin, y + shift[1], z + shift[2]));
+        for (int x = xMin; x <= xMax; x++, voxelPtr++)
+          {
+          if (*voxelPtr < valueToSet)
+            {
+            *voxelPtr = valueToSet;
+            }
+          }
+        }
+      }
+    }
+}
+}
+
 //-----------------------------------------------------------------------------
 void qSlicerSegmentEditorPaintEffectPrivate::paintBrushes(
   vtkOrientedImageData* modifierLabelmap,
@@ -525,7 +730,10 @@ void qSlicerSegmentEditorPaintEffectPrivate::paintBrushes(
   Q_UNUSED(pixelPositions_World);
   Q_Q(qSlicerSegmentEditorPaintEffect);
 
-  this->updateBrushStencil(viewWidget);
+  if (!this->updateBrushStencil(viewWidget))
+    {
+    return;
+    }
 
   if (!modifierLabelmap)
     {
@@ -539,55 +747,41 @@ void qSlicerSegmentEditorPaintEffectPrivate::paintBrushes(
     return;
     }
 
-  this->BrushPolyDataToStencil->Update();
-  vtkImageStencilData* stencilData = this->BrushPolyDataToStencil->GetOutput();
   int stencilExtent[6]={0,-1,0,-1,0,-1};
-  stencilData->GetExtent(stencilExtent);
+  this->BrushStencil->GetExtent(stencilExtent);
 
   vtkNew<vtkPoints> paintCoordinates_Ijk;
   this->transformPointsFromWorldToIJK(modifierLabelmap, segmentationNode, this->PaintCoordinates_World, paintCoordinates_Ijk);
 
-  vtkNew<vtkImageStencilToImage> stencilToImage;
-  stencilToImage->SetInputConnection(this->BrushPolyDataToStencil->GetOutputPort());
-  stencilToImage->SetInsideValue(q->m_FillValue);
-  stencilToImage->SetOutsideValue(q->m_EraseValue);
-  stencilToImage->SetOutputScalarType(modifierLabelmap->GetScalarType());
-
-  vtkNew<vtkImageChangeInformation> brushPositioner;
-  brushPositioner->SetInputConnection(stencilToImage->GetOutputPort());
-  brushPositioner->SetOutputSpacing(modifierLabelmap->GetSpacing());
-  brushPositioner->SetOutputOrigin(modifierLabelmap->GetOrigin());
-
+  // The brush stencil is written directly into the modifier labelmap at each paint position,
+  // which is much faster than converting the stencil to an image and merging it for each point.
   vtkIdType numberOfPoints = this->PaintCoordinates_World->GetNumberOfPoints();
   for (int pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
     {
-    double* shiftDouble = paintCoordinates_Ijk->GetPoint(pointIndex);
+    double shiftDouble[3] = { 0.0, 0.0, 0.0 };
+    paintCoordinates_Ijk->GetPoint(pointIndex, shiftDouble);
     int shift[3] = {vtkMath::Round(shiftDouble[0]), vtkMath::Round(shiftDouble[1]), vtkMath::Round(shiftDouble[2])};
-    brushPositioner->SetExtentTranslation(shift);
-    brushPositioner->Update();
-    vtkNew<vtkOrientedImageData> orientedBrushPositionerOutput;
-    orientedBrushPositionerOutput->ShallowCopy(brushPositioner->GetOutput());
-    orientedBrushPositionerOutput->CopyDirections(modifierLabelmap);
-    if (pointIndex == 0)
+    for (int i = 0; i < 3; i++)
       {
-      orientedBrushPositionerOutput->GetExtent(updateExtent);
-      }
-    else
-      {
-      int* brushExtent = orientedBrushPositionerOutput->GetExtent();
-      for (int i = 0; i < 3; i++)
+      int brushExtentMin = stencilExtent[i * 2] + shift[i];
+      int brushExtentMax = stencilExtent[i * 2 + 1] + shift[i];
+      if (pointIndex == 0 || brushExtentMin < updateExtent[i * 2])
         {
-        if (brushExtent[i * 2] < updateExtent[i * 2])
-          {
-          updateExtent[i * 2] = brushExtent[i * 2];
-          }
-        if (brushExtent[i * 2 + 1] > updateExtent[i * 2 + 1])
-          {
-          updateExtent[i * 2 + 1] = brushExtent[i * 2 + 1];
-          }
+        updateExtent[i * 2] = brushExtentMin;
+        }
+      if (pointIndex == 0 || brushExtentMax > updateExtent[i * 2 + 1])
+        {
+        updateExtent[i * 2 + 1] = brushExtentMax;
         }
       }
-    vtkOrientedImageDataResample::ModifyImage(modifierLabelmap, orientedBrushPositionerOutput.GetPointer(), vtkOrientedImageDataResample::OPERATION_MAXIMUM);
+    switch (modifierLabelmap->GetScalarType())
+      {
+      vtkTemplateMacro(PaintBrushStencilGeneric(modifierLabelmap, static_cast<VTK_TT*>(nullptr),
+        this->BrushStencil, shift, q->m_FillValue));
+      default:
+        qCritical() << Q_FUNC_INFO << ": Unsupported modifier labelmap scalar type " << modifierLabelmap->GetScalarType();
+        return;
+      }
     }
   modifierLabelmap->Modified();
 }
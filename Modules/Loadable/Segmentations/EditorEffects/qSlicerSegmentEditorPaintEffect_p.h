@@ -46,6 +46,9 @@
 #include <vtkTransformPolyDataFilter.h>
 #include <vtkWeakPointer.h>
 
+// STD includes
+#include <vector>
+
 // Qt includes
 #include <QObject>
 #include <QList>
@@ -63,8 +66,9 @@ class qMRMLSpinBox;
 class vtkActor2D;
 class vtkGlyph3D;
 class vtkPoints;
+class vtkImageStencilData;
+class vtkMatrix4x4;
 class vtkPolyDataNormals;
-class vtkPolyDataToImageStencil;
 
 /// \brief Private implementation of the segment editor paint effect
 class qSlicerSegmentEditorPaintEffectPrivate: public QObject
@@ -95,7 +99,15 @@ public:
 
   /// Updates the brush stencil that can be used to quickly paint the brush shape into
   /// modifierLabelmap at many different positions.
-  void updateBrushStencil(qMRMLWidget* viewWidget);
+  /// The stencil is only rasterized again if brush shape, size, or orientation in
+  /// the modifierLabelmap's IJK coordinate system changed since the last update.
+  /// Returns false if the stencil could not be updated.
+  bool updateBrushStencil(qMRMLWidget* viewWidget);
+
+  /// Rasterize the current brush shape (sphere or cylinder) into BrushStencil.
+  /// Voxels are selected by evaluating the brush equation for each voxel row,
+  /// which is exact and much faster than rasterizing the brush polydata.
+  void rasterizeBrushStencil(vtkMatrix4x4* brushToModifierLabelmapIjk, bool sphere, double radius, double height);
 
 protected:
   /// Get brush object for widget. Create if does not exist
@@ -142,9 +154,11 @@ public:
   vtkSmartPointer<vtkTransformPolyDataFilter> WorldOriginToWorldTransformer;
   vtkSmartPointer<vtkTransform> WorldOriginToWorldTransform;
   vtkSmartPointer<vtkPolyDataNormals> BrushPolyDataNormals;
-  vtkSmartPointer<vtkTransformPolyDataFilter> WorldOriginToModifierLabelmapIjkTransformer;
-  vtkSmartPointer<vtkTransform> WorldOriginToModifierLabelmapIjkTransform; // transforms from polydata source to modifierLabelmap's IJK coordinate system (brush origin in IJK origin)
-  vtkSmartPointer<vtkPolyDataToImageStencil> BrushPolyDataToStencil;
+  vtkSmartPointer<vtkTransform> WorldOriginToModifierLabelmapIjkTransform; // transforms from world origin to modifierLabelmap's IJK coordinate system (brush origin in IJK origin)
+  vtkSmartPointer<vtkImageStencilData> BrushStencil; // brush shape in modifierLabelmap's IJK coordinate system (brush origin in IJK origin)
+  /// Brush shape, size, and brush to IJK matrix that BrushStencil was computed for.
+  /// Used for skipping rasterization if the brush has not changed.
+  std::vector<double> BrushStencilParameters;
 
   vtkSmartPointer<vtkGlyph3D> FeedbackGlyphFilter;
 
@@ -39,24 +39,37 @@
 #include <vtkActor.h>
 #include <vtkAppendPolyData.h>
 #include <vtkCallbackCommand.h>
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkCollection.h>
 #include <vtkDataObject.h>
+#include <vtkDiscreteMarchingCubes.h>
+#include <vtkDoubleArray.h>
 #include <vtkGeneralTransform.h>
 #include <vtkGeometryFilter.h>
+#include <vtkIdList.h>
 #include <vtkImageAccumulate.h>
+#include <vtkImageChangeInformation.h>
 #include <vtkImageConstantPad.h>
 #include <vtkImageMathematics.h>
+#include <vtkImageStencilData.h>
 #include <vtkImageThreshold.h>
+#include <vtkIntArray.h>
 #include <vtkLookupTable.h>
 #include <vtkMatrix4x4.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkOBJExporter.h>
 #include <vtkPointData.h>
+#include <vtkPoints.h>
 #include <vtkPolyData.h>
+#include <vtkPolyDataToImageStencil.h>
 #include <vtkPolyDataMapper.h>
 #include <vtkProperty.h>
 #include <vtkRenderer.h>
 #include <vtkRenderWindow.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
 #include <vtkSTLWriter.h>
 #include <vtkStringArray.h>
 #include <vtkTransform.h>
@@ -64,6 +77,7 @@
 #include <vtkTriangleFilter.h>
 #include <vtkTrivialProducer.h>
 #include <vtkUnstructuredGrid.h>
+#include <vtkWindowedSincPolyDataFilter.h>
 #include <vtksys/SystemTools.hxx>
 #include <vtksys/RegularExpression.hxx>
 
@@ -86,6 +100,9 @@
 #include <vtkEventBroker.h>
 
 // STD includes
+#include <algorithm>
+#include <cmath>
+#include <map>
 #include <sstream>
 
 //----------------------------------------------------------------------------
@@ -2801,3 +2818,984 @@ bool vtkSlicerSegmentationsModuleLogic::IsSegmentationExentOutsideReferenceGeome
     }
   return false;
 }
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Same as vtkImageMedian3DAccumulateMedian: adds a value to the sorted
+// neighborhood values and returns the updated pointer to the median.
+double* BinaryLabelmapAccumulateMedian(int& upNum, int& downNum, int& upMax, int& downMax,
+  int numberOfElements, double* median, double value)
+{
+  if (upNum == 0)
+    {
+    *median = value;
+    upNum = downNum = 1;
+    downMax = upMax = (numberOfElements + 1) / 2;
+    return median;
+    }
+  if (value >= *median)
+    {
+    if (upNum > downNum)
+      {
+      ++median;
+      --upNum;
+      ++downNum;
+      --upMax;
+      ++downMax;
+      }
+    const int maximum = (upNum < upMax) ? upNum : upMax;
+    double* ptr = median;
+    int index = 0;
+    while (index < maximum && value >= *ptr)
+      {
+      ++ptr;
+      ++index;
+      }
+    while (index < maximum)
+      {
+      std::swap(*ptr, value);
+      ++ptr;
+      ++index;
+      }
+    *ptr = value;
+    ++upNum;
+    --downMax;
+    return median;
+    }
+  if (downNum > upNum)
+    {
+    --median;
+    --downNum;
+    ++upNum;
+    --downMax;
+    ++upMax;
+    }
+  const int maximum = (downNum < downMax) ? downNum : downMax;
+  double* ptr = median;
+  int index = 0;
+  while (index < maximum && value <= *ptr)
+    {
+    --ptr;
+    ++index;
+    }
+  while (index < maximum)
+    {
+    std::swap(*ptr, value);
+    --ptr;
+    ++index;
+    }
+  *ptr = value;
+  ++downNum;
+  --upMax;
+  return median;
+}
+
+//----------------------------------------------------------------------------
+// Clipped kernel range [first, last] along an axis, same as in vtkImageSpatialAlgorithm
+// (kernel middle is at kernelSize / 2).
+void GetBinaryLabelmapKernelRange(int index, int kernelSize, int dimension, int& first, int& last)
+{
+  first = std::max(0, index - kernelSize / 2);
+  last = std::min(dimension - 1, index - kernelSize / 2 + kernelSize - 1);
+}
+
+//----------------------------------------------------------------------------
+// Replaces each voxel count by the number of nonzero voxels in its clipped kernel.
+// Box sums are separable, they are computed by prefix sums along each axis.
+void ComputeBinaryLabelmapKernelCounts(std::vector<int>& counts, const int dims[3], const int kernelSize[3])
+{
+  const vtkIdType dimX = dims[0];
+  const vtkIdType dimY = dims[1];
+  const vtkIdType dimZ = dims[2];
+
+  // x axis, rows are processed in parallel
+  vtkSMPTools::For(0, dimY * dimZ, [&](vtkIdType firstRow, vtkIdType endRow)
+    {
+    std::vector<int> prefix(dimX + 1, 0);
+    for (vtkIdType row = firstRow; row < endRow; ++row)
+      {
+      int* rowCounts = counts.data() + row * dimX;
+      for (vtkIdType x = 0; x < dimX; ++x)
+        {
+        prefix[x + 1] = prefix[x] + rowCounts[x];
+        }
+      for (int x = 0; x < dimX; ++x)
+        {
+        int first = 0;
+        int last = 0;
+        GetBinaryLabelmapKernelRange(x, kernelSize[0], dims[0], first, last);
+        rowCounts[x] = prefix[last + 1] - prefix[first];
+        }
+      }
+    });
+
+  // y axis, slices are processed in parallel
+  vtkSMPTools::For(0, dimZ, [&](vtkIdType firstSlice, vtkIdType endSlice)
+    {
+    std::vector<int> prefix((dimY + 1) * dimX, 0);
+    for (vtkIdType z = firstSlice; z < endSlice; ++z)
+      {
+      int* sliceCounts = counts.data() + z * dimX * dimY;
+      for (vtkIdType y = 0; y < dimY; ++y)
+        {
+        for (vtkIdType x = 0; x < dimX; ++x)
+          {
+          prefix[(y + 1) * dimX + x] = prefix[y * dimX + x] + sliceCounts[y * dimX + x];
+          }
+        }
+      for (int y = 0; y < dimY; ++y)
+        {
+        int first = 0;
+        int last = 0;
+        GetBinaryLabelmapKernelRange(y, kernelSize[1], dims[1], first, last);
+        for (vtkIdType x = 0; x < dimX; ++x)
+          {
+          sliceCounts[y * dimX + x] = prefix[(last + 1) * dimX + x] - prefix[first * dimX + x];
+          }
+        }
+      }
+    });
+
+  // z axis, the x-z planes are processed in parallel
+  vtkSMPTools::For(0, dimY, [&](vtkIdType firstPlane, vtkIdType endPlane)
+    {
+    std::vector<int> prefix((dimZ + 1) * dimX, 0);
+    for (vtkIdType y = firstPlane; y < endPlane; ++y)
+      {
+      for (vtkIdType z = 0; z < dimZ; ++z)
+        {
+        const int* rowCounts = counts.data() + (z * dimY + y) * dimX;
+        for (vtkIdType x = 0; x < dimX; ++x)
+          {
+          prefix[(z + 1) * dimX + x] = prefix[z * dimX + x] + rowCounts[x];
+          }
+        }
+      for (int z = 0; z < dimZ; ++z)
+        {
+        int first = 0;
+        int last = 0;
+        GetBinaryLabelmapKernelRange(z, kernelSize[2], dims[2], first, last);
+        int* rowCounts = counts.data() + (z * dimY + y) * dimX;
+        for (vtkIdType x = 0; x < dimX; ++x)
+          {
+          rowCounts[x] = prefix[(last + 1) * dimX + x] - prefix[first * dimX + x];
+          }
+        }
+      }
+    });
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+bool SmoothBinaryLabelmapMedianGeneric(const T* inPtr, T* outPtr, const int dims[3], const int kernelSize[3])
+{
+  const vtkIdType dimX = dims[0];
+  const vtkIdType dimY = dims[1];
+  const vtkIdType numberOfVoxels = dimX * dimY * dims[2];
+
+  // Input must only contain 0 and one label value
+  T labelValue = 0;
+  std::vector<int> counts(numberOfVoxels);
+  for (vtkIdType index = 0; index < numberOfVoxels; ++index)
+    {
+    if (inPtr[index] == 0)
+      {
+      counts[index] = 0;
+      continue;
+      }
+    if (labelValue == 0)
+      {
+      labelValue = inPtr[index];
+      }
+    else if (inPtr[index] != labelValue)
+      {
+      return false;
+      }
+    counts[index] = 1;
+    }
+
+  ComputeBinaryLabelmapKernelCounts(counts, dims, kernelSize);
+
+  // The median is the label value if more than half of the kernel voxels are set.
+  // If exactly half of them are set then the result of vtkImageMedian3D depends on the order
+  // in which the values are accumulated, for these voxels the accumulation is replayed.
+  const int numberOfElements = kernelSize[0] * kernelSize[1] * kernelSize[2];
+  vtkSMPTools::For(0, dimY * dims[2], [&](vtkIdType firstRow, vtkIdType endRow)
+    {
+    std::vector<double> sort(numberOfElements + 8);
+    for (vtkIdType row = firstRow; row < endRow; ++row)
+      {
+      const int y = static_cast<int>(row % dimY);
+      const int z = static_cast<int>(row / dimY);
+      int firstY = 0;
+      int lastY = 0;
+      int firstZ = 0;
+      int lastZ = 0;
+      GetBinaryLabelmapKernelRange(y, kernelSize[1], dims[1], firstY, lastY);
+      GetBinaryLabelmapKernelRange(z, kernelSize[2], dims[2], firstZ, lastZ);
+      const int numberOfHoodRows = (lastY - firstY + 1) * (lastZ - firstZ + 1);
+      for (int x = 0; x < dimX; ++x)
+        {
+        int firstX = 0;
+        int lastX = 0;
+        GetBinaryLabelmapKernelRange(x, kernelSize[0], dims[0], firstX, lastX);
+        const int numberOfHoodVoxels = (lastX - firstX + 1) * numberOfHoodRows;
+        const vtkIdType index = row * dimX + x;
+        const int count = 2 * counts[index];
+        if (count != numberOfHoodVoxels)
+          {
+          outPtr[index] = (count > numberOfHoodVoxels ? labelValue : 0);
+          continue;
+          }
+        int upNum = 0;
+        int downNum = 0;
+        int upMax = 0;
+        int downMax = 0;
+        double* median = sort.data() + (numberOfElements / 2) + 4;
+        for (int hoodZ = firstZ; hoodZ <= lastZ; ++hoodZ)
+          {
+          for (int hoodY = firstY; hoodY <= lastY; ++hoodY)
+            {
+            const T* hoodPtr = inPtr + (hoodZ * dimY + hoodY) * dimX;
+            for (int hoodX = firstX; hoodX <= lastX; ++hoodX)
+              {
+              median = BinaryLabelmapAccumulateMedian(upNum, downNum, upMax, downMax,
+                numberOfElements, median, static_cast<double>(hoodPtr[hoodX]));
+              }
+            }
+          }
+        outPtr[index] = static_cast<T>(*median);
+        }
+      }
+    });
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Offsets of the ellipsoid kernel of vtkImageDilateErode3D, as contiguous ranges along x
+// (the ellipsoid is convex) for each y and z offset.
+struct BinaryLabelmapKernelRow
+{
+  int OffsetY;
+  int OffsetZ;
+  int FirstOffsetX;
+  int LastOffsetX;
+};
+
+//----------------------------------------------------------------------------
+std::vector<BinaryLabelmapKernelRow> GetBinaryLabelmapEllipsoidKernelRows(const int kernelSize[3])
+{
+  // Same as the mask computed by vtkImageEllipsoidSource in vtkImageDilateErode3D
+  double center[3] = { 0.0, 0.0, 0.0 };
+  double radius[3] = { 0.0, 0.0, 0.0 };
+  for (int i = 0; i < 3; ++i)
+    {
+    center[i] = static_cast<double>(kernelSize[i] - 1) * 0.5;
+    radius[i] = static_cast<double>(kernelSize[i]) * 0.5;
+    }
+  std::vector<BinaryLabelmapKernelRow> kernelRows;
+  for (int kz = 0; kz < kernelSize[2]; ++kz)
+    {
+    const double tz = (kz - center[2]) / radius[2];
+    for (int ky = 0; ky < kernelSize[1]; ++ky)
+      {
+      const double ty = (ky - center[1]) / radius[1];
+      BinaryLabelmapKernelRow kernelRow = { ky - kernelSize[1] / 2, kz - kernelSize[2] / 2, 0, -1 };
+      for (int kx = 0; kx < kernelSize[0]; ++kx)
+        {
+        const double tx = (kx - center[0]) / radius[0];
+        if (tx * tx + ty * ty + tz * tz > 1.0)
+          {
+          continue;
+          }
+        if (kernelRow.FirstOffsetX > kernelRow.LastOffsetX)
+          {
+          kernelRow.FirstOffsetX = kx - kernelSize[0] / 2;
+          }
+        kernelRow.LastOffsetX = kx - kernelSize[0] / 2;
+        }
+      if (kernelRow.FirstOffsetX <= kernelRow.LastOffsetX)
+        {
+        kernelRows.push_back(kernelRow);
+        }
+      }
+    }
+  return kernelRows;
+}
+
+//----------------------------------------------------------------------------
+// Same as vtkImageDilateErode3D on an image of 0 and 1 values: voxels of erodeValue
+// that have a voxel of the other value in their kernel are set to the other value.
+// Voxels that have none of the other value in the kernel bounding box are found by box counts,
+// for the others the voxels of the other value in the kernel rows are counted using prefix sums along the rows.
+void BinaryLabelmapDilateErode(const unsigned char* inPtr, unsigned char* outPtr, const int dims[3], const int kernelSize[3],
+  const std::vector<BinaryLabelmapKernelRow>& kernelRows, unsigned char erodeValue, std::vector<int>& counts, std::vector<int>& prefix)
+{
+  const vtkIdType dimX = dims[0];
+  const vtkIdType dimY = dims[1];
+  const unsigned char dilateValue = (erodeValue ? 0 : 1);
+  vtkSMPTools::For(0, dimY * dims[2], [&](vtkIdType firstRow, vtkIdType endRow)
+    {
+    for (vtkIdType row = firstRow; row < endRow; ++row)
+      {
+      const unsigned char* rowPtr = inPtr + row * dimX;
+      int* rowCounts = counts.data() + row * dimX;
+      int* rowPrefix = prefix.data() + row * (dimX + 1);
+      rowPrefix[0] = 0;
+      for (vtkIdType x = 0; x < dimX; ++x)
+        {
+        rowCounts[x] = (rowPtr[x] == dilateValue ? 1 : 0);
+        rowPrefix[x + 1] = rowPrefix[x] + rowCounts[x];
+        }
+      }
+    });
+  ComputeBinaryLabelmapKernelCounts(counts, dims, kernelSize);
+  vtkSMPTools::For(0, dimY * dims[2], [&](vtkIdType firstRow, vtkIdType endRow)
+    {
+    for (vtkIdType row = firstRow; row < endRow; ++row)
+      {
+      const int y = static_cast<int>(row % dimY);
+      const int z = static_cast<int>(row / dimY);
+      const unsigned char* rowPtr = inPtr + row * dimX;
+      unsigned char* outRowPtr = outPtr + row * dimX;
+      for (int x = 0; x < dimX; ++x)
+        {
+        outRowPtr[x] = rowPtr[x];
+        if (rowPtr[x] != erodeValue || counts[row * dimX + x] == 0)
+          {
+          continue;
+          }
+        for (const BinaryLabelmapKernelRow& kernelRow : kernelRows)
+          {
+          const int hoodY = y + kernelRow.OffsetY;
+          const int hoodZ = z + kernelRow.OffsetZ;
+          if (hoodY < 0 || hoodY >= dims[1] || hoodZ < 0 || hoodZ >= dims[2])
+            {
+            continue;
+            }
+          const int firstX = std::max(0, x + kernelRow.FirstOffsetX);
+          const int lastX = std::min(dims[0] - 1, x + kernelRow.LastOffsetX);
+          const int* hoodPrefix = prefix.data() + (hoodZ * dimY + hoodY) * (dimX + 1);
+          if (firstX <= lastX && hoodPrefix[lastX + 1] > hoodPrefix[firstX])
+            {
+            outRowPtr[x] = dilateValue;
+            break;
+            }
+          }
+        }
+      }
+    });
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void SmoothBinaryLabelmapOpenCloseGeneric(const T* inPtr, T* outPtr, const int dims[3], const int kernelSize[3], bool opening)
+{
+  const vtkIdType numberOfVoxels = static_cast<vtkIdType>(dims[0]) * dims[1] * dims[2];
+  std::vector<unsigned char> binaryImage(numberOfVoxels);
+  std::vector<unsigned char> erodedImage(numberOfVoxels);
+  vtkSMPTools::For(0, numberOfVoxels, [&](vtkIdType first, vtkIdType end)
+    {
+    for (vtkIdType index = first; index < end; ++index)
+      {
+      binaryImage[index] = (inPtr[index] != 0 ? 1 : 0);
+      }
+    });
+
+  // Opening erodes the label then dilates it, closing erodes the background then dilates it
+  const std::vector<BinaryLabelmapKernelRow> kernelRows = GetBinaryLabelmapEllipsoidKernelRows(kernelSize);
+  std::vector<int> counts(numberOfVoxels);
+  std::vector<int> prefix((static_cast<vtkIdType>(dims[0]) + 1) * dims[1] * dims[2]);
+  const unsigned char firstErodeValue = (opening ? 1 : 0);
+  BinaryLabelmapDilateErode(binaryImage.data(), erodedImage.data(), dims, kernelSize, kernelRows, firstErodeValue, counts, prefix);
+  BinaryLabelmapDilateErode(erodedImage.data(), binaryImage.data(), dims, kernelSize, kernelRows, 1 - firstErodeValue, counts, prefix);
+
+  vtkSMPTools::For(0, numberOfVoxels, [&](vtkIdType first, vtkIdType end)
+    {
+    for (vtkIdType index = first; index < end; ++index)
+      {
+      outPtr[index] = static_cast<T>(binaryImage[index]);
+      }
+    });
+}
+}
+
+//----------------------------------------------------------------------------
+bool vtkSlicerSegmentationsModuleLogic::SmoothBinaryLabelmapMedian(vtkImageData* inputLabelmap, const int kernelSize[3], vtkImageData* outputLabelmap)
+{
+  if (!inputLabelmap || !outputLabelmap || !kernelSize)
+    {
+    vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::SmoothBinaryLabelmapMedian: Invalid input");
+    return false;
+    }
+  if (inputLabelmap->GetNumberOfScalarComponents() != 1 || kernelSize[0] < 1 || kernelSize[1] < 1 || kernelSize[2] < 1)
+    {
+    return false;
+    }
+
+  // Output may be the same as the input
+  vtkSmartPointer<vtkImageData> smoothedLabelmap = vtkSmartPointer<vtkImageData>::Take(inputLabelmap->NewInstance());
+  smoothedLabelmap->CopyStructure(inputLabelmap);
+  smoothedLabelmap->AllocateScalars(inputLabelmap->GetScalarType(), 1);
+  int dims[3] = { 0, 0, 0 };
+  inputLabelmap->GetDimensions(dims);
+  bool binaryLabelmap = false;
+  switch (inputLabelmap->GetScalarType())
+    {
+    vtkTemplateMacro(binaryLabelmap = SmoothBinaryLabelmapMedianGeneric<VTK_TT>(
+      static_cast<VTK_TT*>(inputLabelmap->GetScalarPointer()), static_cast<VTK_TT*>(smoothedLabelmap->GetScalarPointer()), dims, kernelSize));
+    default:
+      vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::SmoothBinaryLabelmapMedian: Unknown scalar type");
+      return false;
+    }
+  if (!binaryLabelmap)
+    {
+    return false;
+    }
+
+  vtkOrientedImageData* orientedSmoothedLabelmap = vtkOrientedImageData::SafeDownCast(smoothedLabelmap);
+  if (orientedSmoothedLabelmap)
+    {
+    orientedSmoothedLabelmap->CopyDirections(inputLabelmap);
+    }
+  outputLabelmap->ShallowCopy(smoothedLabelmap);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSlicerSegmentationsModuleLogic::SmoothBinaryLabelmapOpenClose(vtkImageData* inputLabelmap, const int kernelSize[3], bool opening,
+  vtkImageData* outputLabelmap)
+{
+  if (!inputLabelmap || !outputLabelmap || !kernelSize)
+    {
+    vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::SmoothBinaryLabelmapOpenClose: Invalid input");
+    return false;
+    }
+  if (inputLabelmap->GetNumberOfScalarComponents() != 1 || kernelSize[0] < 1 || kernelSize[1] < 1 || kernelSize[2] < 1)
+    {
+    vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::SmoothBinaryLabelmapOpenClose: Invalid labelmap or kernel size");
+    return false;
+    }
+
+  // Output may be the same as the input
+  vtkSmartPointer<vtkImageData> smoothedLabelmap = vtkSmartPointer<vtkImageData>::Take(inputLabelmap->NewInstance());
+  smoothedLabelmap->CopyStructure(inputLabelmap);
+  smoothedLabelmap->AllocateScalars(inputLabelmap->GetScalarType(), 1);
+  int dims[3] = { 0, 0, 0 };
+  inputLabelmap->GetDimensions(dims);
+  switch (inputLabelmap->GetScalarType())
+    {
+    vtkTemplateMacro(SmoothBinaryLabelmapOpenCloseGeneric<VTK_TT>(
+      static_cast<VTK_TT*>(inputLabelmap->GetScalarPointer()), static_cast<VTK_TT*>(smoothedLabelmap->GetScalarPointer()), dims, kernelSize, opening));
+    default:
+      vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::SmoothBinaryLabelmapOpenClose: Unknown scalar type");
+      return false;
+    }
+
+  vtkOrientedImageData* orientedSmoothedLabelmap = vtkOrientedImageData::SafeDownCast(smoothedLabelmap);
+  if (orientedSmoothedLabelmap)
+    {
+    orientedSmoothedLabelmap->CopyDirections(inputLabelmap);
+    }
+  outputLabelmap->ShallowCopy(smoothedLabelmap);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSlicerSegmentationsModuleLogic::JointSmoothLabelmap(vtkOrientedImageData* labelmap, vtkIntArray* labelValues, double smoothingFactor,
+  vtkCollection* smoothedLabelmaps)
+{
+  if (!labelmap || !labelValues || !smoothedLabelmaps)
+    {
+    vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::JointSmoothLabelmap: Invalid input");
+    return false;
+    }
+  smoothedLabelmaps->RemoveAllItems();
+  const vtkIdType numberOfLabels = labelValues->GetNumberOfValues();
+  if (numberOfLabels == 0)
+    {
+    return true;
+    }
+
+  // Perform smoothing in voxel space
+  vtkNew<vtkImageChangeInformation> changeInformation;
+  changeInformation->SetInputData(labelmap);
+  changeInformation->SetOutputSpacing(1, 1, 1);
+  changeInformation->SetOutputOrigin(0, 0, 0);
+
+  // Convert labelmap to combined polydata
+  // vtkDiscreteFlyingEdges3D cannot be used here, as in the output of that filter,
+  // each labeled region is completely disconnected from neighboring regions, and
+  // for joint smoothing it is essential for the points to move together.
+  vtkNew<vtkDiscreteMarchingCubes> convertToPolyData;
+  convertToPolyData->SetInputConnection(changeInformation->GetOutputPort());
+  convertToPolyData->SetNumberOfContours(static_cast<int>(numberOfLabels));
+  std::map<int, vtkIdType> labelIndices;
+  for (vtkIdType labelIndex = 0; labelIndex < numberOfLabels; ++labelIndex)
+    {
+    convertToPolyData->SetValue(static_cast<int>(labelIndex), labelValues->GetValue(labelIndex));
+    labelIndices[labelValues->GetValue(labelIndex)] = labelIndex;
+    }
+
+  // Low-pass filtering using Taubin's method
+  int smoothingIterations = 100; // according to VTK documentation 10-20 iterations could be enough but we use a higher value to reduce chance of shrinking
+  double passBand = pow(10.0, -4.0 * smoothingFactor); // gives a nice range of 1-0.0001 from a user input of 0-1
+  vtkNew<vtkWindowedSincPolyDataFilter> smoother;
+  smoother->SetInputConnection(convertToPolyData->GetOutputPort());
+  smoother->SetNumberOfIterations(smoothingIterations);
+  smoother->BoundarySmoothingOff();
+  smoother->FeatureEdgeSmoothingOff();
+  smoother->SetFeatureAngle(90.0);
+  smoother->SetPassBand(passBand);
+  smoother->NonManifoldSmoothingOn();
+  smoother->NormalizeCoordinatesOn();
+  smoother->Update();
+  vtkPolyData* smoothedSurface = smoother->GetOutput();
+
+  // Sort the cells by label (cell scalars contain the label value of the contour that generated the cell)
+  std::vector<std::vector<vtkIdType> > labelCellIds(numberOfLabels);
+  vtkDataArray* cellLabels = smoothedSurface->GetCellData()->GetScalars();
+  if (cellLabels)
+    {
+    for (vtkIdType cellId = 0; cellId < smoothedSurface->GetNumberOfCells(); ++cellId)
+      {
+      std::map<int, vtkIdType>::iterator labelIt = labelIndices.find(static_cast<int>(cellLabels->GetTuple1(cellId)));
+      if (labelIt != labelIndices.end())
+        {
+        labelCellIds[labelIt->second].push_back(cellId);
+        }
+      }
+    }
+  // Cells are built before the parallel section, as getting cell points would build them otherwise
+  smoothedSurface->BuildCells();
+
+  int labelmapExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  labelmap->GetExtent(labelmapExtent);
+  vtkNew<vtkMatrix4x4> imageToWorldMatrix;
+  labelmap->GetImageToWorldMatrix(imageToWorldMatrix);
+
+  // Convert the surface of each label back to a labelmap. Polydata to stencil conversion is single-threaded,
+  // therefore the labels are processed in parallel. Each labelmap is only computed in the bounding box of the surface.
+  std::vector<vtkSmartPointer<vtkOrientedImageData> > labelmaps(numberOfLabels);
+  vtkSMPTools::For(0, numberOfLabels, 1, [&](vtkIdType firstLabelIndex, vtkIdType endLabelIndex)
+    {
+    for (vtkIdType labelIndex = firstLabelIndex; labelIndex < endLabelIndex; ++labelIndex)
+      {
+      // Extract the surface of the label
+      vtkNew<vtkPolyData> labelSurface;
+      vtkNew<vtkPoints> labelPoints;
+      labelPoints->SetDataType(smoothedSurface->GetPoints()->GetDataType());
+      vtkNew<vtkCellArray> labelPolys;
+      std::map<vtkIdType, vtkIdType> pointIdMap;
+      vtkNew<vtkIdList> cellPointIds;
+      for (vtkIdType cellId : labelCellIds[labelIndex])
+        {
+        smoothedSurface->GetCellPoints(cellId, cellPointIds);
+        for (vtkIdType i = 0; i < cellPointIds->GetNumberOfIds(); ++i)
+          {
+          std::map<vtkIdType, vtkIdType>::iterator pointIt = pointIdMap.find(cellPointIds->GetId(i));
+          if (pointIt == pointIdMap.end())
+            {
+            double point[3] = { 0.0, 0.0, 0.0 };
+            smoothedSurface->GetPoint(cellPointIds->GetId(i), point);
+            vtkIdType labelPointId = labelPoints->InsertNextPoint(point);
+            pointIt = pointIdMap.insert(std::make_pair(cellPointIds->GetId(i), labelPointId)).first;
+            }
+          cellPointIds->SetId(i, pointIt->second);
+          }
+        labelPolys->InsertNextCell(cellPointIds);
+        }
+      labelSurface->SetPoints(labelPoints);
+      labelSurface->SetPolys(labelPolys);
+
+      // Voxel coordinates are the point coordinates, as spacing is 1 and origin is 0
+      int extent[6] = { 0, -1, 0, -1, 0, -1 };
+      if (labelPoints->GetNumberOfPoints() > 0)
+        {
+        double bounds[6] = { 0.0, -1.0, 0.0, -1.0, 0.0, -1.0 };
+        labelSurface->GetBounds(bounds);
+        for (int i = 0; i < 3; ++i)
+          {
+          extent[2 * i] = std::max(labelmapExtent[2 * i], static_cast<int>(floor(bounds[2 * i])) - 1);
+          extent[2 * i + 1] = std::min(labelmapExtent[2 * i + 1], static_cast<int>(ceil(bounds[2 * i + 1])) + 1);
+          }
+        }
+
+      vtkSmartPointer<vtkOrientedImageData> smoothedLabelmap = vtkSmartPointer<vtkOrientedImageData>::New();
+      smoothedLabelmap->SetExtent(extent);
+      smoothedLabelmap->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+      smoothedLabelmap->SetImageToWorldMatrix(imageToWorldMatrix);
+      labelmaps[labelIndex] = smoothedLabelmap;
+      if (extent[0] > extent[1] || extent[2] > extent[3] || extent[4] > extent[5])
+        {
+        continue;
+        }
+      vtkOrientedImageDataResample::FillImage(smoothedLabelmap, 0);
+
+      // Convert polydata to stencil
+      vtkNew<vtkPolyDataToImageStencil> polyDataToImageStencil;
+      polyDataToImageStencil->SetInputData(labelSurface);
+      polyDataToImageStencil->SetOutputSpacing(1, 1, 1);
+      polyDataToImageStencil->SetOutputOrigin(0, 0, 0);
+      polyDataToImageStencil->SetOutputWholeExtent(extent);
+      polyDataToImageStencil->Update();
+      vtkImageStencilData* stencil = polyDataToImageStencil->GetOutput();
+
+      // Convert stencil to image, voxels inside the stencil are set to 1
+      for (int z = extent[4]; z <= extent[5]; ++z)
+        {
+        for (int y = extent[2]; y <= extent[3]; ++y)
+          {
+          int iter = 0;
+          int firstX = 0;
+          int lastX = 0;
+          while (stencil->GetNextExtent(firstX, lastX, extent[0], extent[1], y, z, iter))
+            {
+            unsigned char* rowPtr = static_cast<unsigned char*>(smoothedLabelmap->GetScalarPointer(firstX, y, z));
+            std::fill(rowPtr, rowPtr + (lastX - firstX + 1), 1);
+            }
+          }
+        }
+      }
+    });
+
+  for (vtkIdType labelIndex = 0; labelIndex < numberOfLabels; ++labelIndex)
+    {
+    smoothedLabelmaps->AddItem(labelmaps[labelIndex]);
+    }
+  return true;
+}
+
+namespace
+{
+/// Maximum number of histogram bins that are used for computing the median of a label
+const int LABEL_SCALAR_STATISTICS_MAXIMUM_NUMBER_OF_BINS = 4096;
+
+/// Statistics of the scalar values of a label. Sums are accumulated (instead of the mean)
+/// so that statistics computed for different parts of the image can be simply merged.
+struct LabelScalarStatistics
+{
+  vtkIdType Count{ 0 };
+  double Minimum{ VTK_DOUBLE_MAX };
+  double Maximum{ VTK_DOUBLE_MIN };
+  double Sum{ 0.0 };
+  double SumOfSquares{ 0.0 };
+
+  void Merge(const LabelScalarStatistics& other)
+  {
+    this->Count += other.Count;
+    this->Minimum = std::min(this->Minimum, other.Minimum);
+    this->Maximum = std::max(this->Maximum, other.Maximum);
+    this->Sum += other.Sum;
+    this->SumOfSquares += other.SumOfSquares;
+  }
+};
+
+/// Histogram bins of a label, covering the range of the values of the label
+struct LabelScalarHistogramBinning
+{
+  double Origin{ 0.0 };
+  double BinWidth{ 1.0 };
+  int NumberOfBins{ 0 };
+  /// Index of the first bin of the label in the array of all histogram bins
+  vtkIdType FirstBinIndex{ 0 };
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+void GetLabelIndicesForRow(const T* labelPtr, int numberOfComponents, int numberOfVoxels,
+  const std::vector<int>& labelIndexLookup, int minimumLabelValue, int* labelIndices)
+{
+  const long long lookupSize = static_cast<long long>(labelIndexLookup.size());
+  for (int x = 0; x < numberOfVoxels; ++x)
+    {
+    const long long lookupIndex = static_cast<long long>(labelPtr[x * numberOfComponents]) - minimumLabelValue;
+    labelIndices[x] = (lookupIndex >= 0 && lookupIndex < lookupSize) ? labelIndexLookup[lookupIndex] : -1;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void AccumulateLabelScalarStatisticsForRow(const T* scalarPtr, int numberOfComponents, int numberOfVoxels,
+  const int* labelIndices, std::vector<LabelScalarStatistics>& statistics)
+{
+  for (int x = 0; x < numberOfVoxels; ++x)
+    {
+    if (labelIndices[x] < 0)
+      {
+      continue;
+      }
+    const double value = static_cast<double>(scalarPtr[x * numberOfComponents]);
+    LabelScalarStatistics& labelStatistics = statistics[labelIndices[x]];
+    ++labelStatistics.Count;
+    labelStatistics.Minimum = std::min(labelStatistics.Minimum, value);
+    labelStatistics.Maximum = std::max(labelStatistics.Maximum, value);
+    labelStatistics.Sum += value;
+    labelStatistics.SumOfSquares += value * value;
+    }
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+void AccumulateLabelScalarHistogramsForRow(const T* scalarPtr, int numberOfComponents, int numberOfVoxels,
+  const int* labelIndices, const std::vector<LabelScalarHistogramBinning>& binnings, std::vector<vtkIdType>& histograms)
+{
+  for (int x = 0; x < numberOfVoxels; ++x)
+    {
+    if (labelIndices[x] < 0)
+      {
+      continue;
+      }
+    const LabelScalarHistogramBinning& binning = binnings[labelIndices[x]];
+    const double value = static_cast<double>(scalarPtr[x * numberOfComponents]);
+    int binIndex = static_cast<int>((value - binning.Origin) / binning.BinWidth);
+    binIndex = std::max(0, std::min(binning.NumberOfBins - 1, binIndex));
+    ++histograms[binning.FirstBinIndex + binIndex];
+    }
+}
+}
+
+//----------------------------------------------------------------------------
+bool vtkSlicerSegmentationsModuleLogic::ComputeLabelScalarStatistics(vtkImageData* labelmap, vtkImageData* scalarImage,
+  vtkIntArray* labelValues, vtkDoubleArray* statistics)
+{
+  if (!labelmap || !scalarImage || !labelValues || !statistics)
+    {
+    vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::ComputeLabelScalarStatistics: Invalid input");
+    return false;
+    }
+  if (!labelmap->GetPointData() || !labelmap->GetPointData()->GetScalars()
+    || !scalarImage->GetPointData() || !scalarImage->GetPointData()->GetScalars())
+    {
+    vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::ComputeLabelScalarStatistics: Input images do not contain scalars");
+    return false;
+    }
+
+  const vtkIdType numberOfLabels = labelValues->GetNumberOfValues();
+  statistics->Initialize();
+  statistics->SetNumberOfComponents(6);
+  statistics->SetComponentName(0, "VoxelCount");
+  statistics->SetComponentName(1, "Minimum");
+  statistics->SetComponentName(2, "Maximum");
+  statistics->SetComponentName(3, "Mean");
+  statistics->SetComponentName(4, "StandardDeviation");
+  statistics->SetComponentName(5, "Median");
+  statistics->SetNumberOfTuples(numberOfLabels);
+  statistics->Fill(0.0);
+  if (numberOfLabels == 0)
+    {
+    return true;
+    }
+
+  // Lookup table from label value to the index of the first occurrence of the label in labelValues
+  int minimumLabelValue = labelValues->GetValue(0);
+  int maximumLabelValue = labelValues->GetValue(0);
+  for (vtkIdType labelIndex = 1; labelIndex < numberOfLabels; ++labelIndex)
+    {
+    minimumLabelValue = std::min(minimumLabelValue, labelValues->GetValue(labelIndex));
+    maximumLabelValue = std::max(maximumLabelValue, labelValues->GetValue(labelIndex));
+    }
+  const long long labelValueRange = static_cast<long long>(maximumLabelValue) - minimumLabelValue + 1;
+  if (labelValueRange > (1LL << 24))
+    {
+    vtkGenericWarningMacro("vtkSlicerSegmentationsModuleLogic::ComputeLabelScalarStatistics: Range of label values is too large");
+    return false;
+    }
+  std::vector<int> labelIndexLookup(labelValueRange, -1);
+  for (vtkIdType labelIndex = numberOfLabels - 1; labelIndex >= 0; --labelIndex)
+    {
+    labelIndexLookup[labelValues->GetValue(labelIndex) - minimumLabelValue] = static_cast<int>(labelIndex);
+    }
+
+  // Statistics are computed in the overlapping region of the two images
+  int labelmapExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  int scalarExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  labelmap->GetExtent(labelmapExtent);
+  scalarImage->GetExtent(scalarExtent);
+  int extent[6] = { 0, -1, 0, -1, 0, -1 };
+  for (int i = 0; i < 3; ++i)
+    {
+    extent[2 * i] = std::max(labelmapExtent[2 * i], scalarExtent[2 * i]);
+    extent[2 * i + 1] = std::min(labelmapExtent[2 * i + 1], scalarExtent[2 * i + 1]);
+    if (extent[2 * i] > extent[2 * i + 1])
+      {
+      // no overlap, all labels are empty
+      return true;
+      }
+    }
+
+  const int rowLength = extent[1] - extent[0] + 1;
+  const int numberOfRowsPerSlice = extent[3] - extent[2] + 1;
+  const vtkIdType numberOfRows = static_cast<vtkIdType>(numberOfRowsPerSlice) * (extent[5] - extent[4] + 1);
+  const int labelmapType = labelmap->GetScalarType();
+  const int labelmapComponents = labelmap->GetNumberOfScalarComponents();
+  const int scalarType = scalarImage->GetScalarType();
+  const int scalarComponents = scalarImage->GetNumberOfScalarComponents();
+  const int labelmapScalarSize = labelmap->GetScalarSize() * labelmapComponents;
+  const int scalarScalarSize = scalarImage->GetScalarSize() * scalarComponents;
+  const char* labelmapPtr = static_cast<const char*>(labelmap->GetScalarPointer());
+  const char* scalarPtr = static_cast<const char*>(scalarImage->GetScalarPointer());
+
+  // Get pointers to the first voxel of a row of the overlapping region in each image
+  auto getRowPointers = [&](vtkIdType row, const void*& labelRowPtr, const void*& scalarRowPtr)
+    {
+    const int y = extent[2] + static_cast<int>(row % numberOfRowsPerSlice);
+    const int z = extent[4] + static_cast<int>(row / numberOfRowsPerSlice);
+    const vtkIdType labelmapVoxelIndex = ((static_cast<vtkIdType>(z - labelmapExtent[4]) * (labelmapExtent[3] - labelmapExtent[2] + 1)
+      + (y - labelmapExtent[2])) * (labelmapExtent[1] - labelmapExtent[0] + 1)) + (extent[0] - labelmapExtent[0]);
+    const vtkIdType scalarVoxelIndex = ((static_cast<vtkIdType>(z - scalarExtent[4]) * (scalarExtent[3] - scalarExtent[2] + 1)
+      + (y - scalarExtent[2])) * (scalarExtent[1] - scalarExtent[0] + 1)) + (extent[0] - scalarExtent[0]);
+    labelRowPtr = labelmapPtr + labelmapVoxelIndex * labelmapScalarSize;
+    scalarRowPtr = scalarPtr + scalarVoxelIndex * scalarScalarSize;
+    };
+
+  // Get the label index of each voxel of a row
+  auto getLabelIndices = [&](const void* labelRowPtr, int* labelIndices)
+    {
+    switch (labelmapType)
+      {
+      vtkTemplateMacro(GetLabelIndicesForRow<VTK_TT>(static_cast<const VTK_TT*>(labelRowPtr), labelmapComponents, rowLength,
+        labelIndexLookup, minimumLabelValue, labelIndices));
+      }
+    };
+
+  // First pass: voxel count, minimum, maximum, sum, and sum of squares
+  vtkSMPThreadLocal<std::vector<LabelScalarStatistics>> threadStatistics;
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType firstRow, vtkIdType endRow)
+    {
+    std::vector<LabelScalarStatistics>& localStatistics = threadStatistics.Local();
+    localStatistics.resize(numberOfLabels);
+    std::vector<int> labelIndices(rowLength);
+    for (vtkIdType row = firstRow; row < endRow; ++row)
+      {
+      const void* labelRowPtr = nullptr;
+      const void* scalarRowPtr = nullptr;
+      getRowPointers(row, labelRowPtr, scalarRowPtr);
+      getLabelIndices(labelRowPtr, labelIndices.data());
+      switch (scalarType)
+        {
+        vtkTemplateMacro(AccumulateLabelScalarStatisticsForRow<VTK_TT>(static_cast<const VTK_TT*>(scalarRowPtr), scalarComponents,
+          rowLength, labelIndices.data(), localStatistics));
+        }
+      }
+    });
+  std::vector<LabelScalarStatistics> labelStatistics(numberOfLabels);
+  for (const std::vector<LabelScalarStatistics>& localStatistics : threadStatistics)
+    {
+    for (vtkIdType labelIndex = 0; labelIndex < static_cast<vtkIdType>(localStatistics.size()); ++labelIndex)
+      {
+      labelStatistics[labelIndex].Merge(localStatistics[labelIndex]);
+      }
+    }
+
+  // Second pass: histogram of the values of each label in the range of the label, for computing the median.
+  // For integer images the bin width is 1 if the range is small enough, so the median is exact.
+  const bool integerScalars = (scalarType != VTK_FLOAT && scalarType != VTK_DOUBLE);
+  std::vector<LabelScalarHistogramBinning> binnings(numberOfLabels);
+  vtkIdType numberOfBins = 0;
+  for (vtkIdType labelIndex = 0; labelIndex < numberOfLabels; ++labelIndex)
+    {
+    const LabelScalarStatistics& labelStatistic = labelStatistics[labelIndex];
+    if (labelStatistic.Count == 0)
+      {
+      continue;
+      }
+    LabelScalarHistogramBinning& binning = binnings[labelIndex];
+    binning.Origin = labelStatistic.Minimum;
+    binning.FirstBinIndex = numberOfBins;
+    const double valueRange = labelStatistic.Maximum - labelStatistic.Minimum;
+    if (integerScalars)
+      {
+      binning.NumberOfBins = static_cast<int>(std::min(valueRange + 1.0, static_cast<double>(LABEL_SCALAR_STATISTICS_MAXIMUM_NUMBER_OF_BINS)));
+      binning.BinWidth = (valueRange + 1.0) / binning.NumberOfBins;
+      }
+    else
+      {
+      binning.NumberOfBins = (valueRange > 0.0 ? LABEL_SCALAR_STATISTICS_MAXIMUM_NUMBER_OF_BINS : 1);
+      binning.BinWidth = (valueRange > 0.0 ? valueRange / binning.NumberOfBins : 1.0);
+      }
+    numberOfBins += binning.NumberOfBins;
+    }
+  vtkSMPThreadLocal<std::vector<vtkIdType>> threadHistograms;
+  vtkSMPTools::For(0, numberOfRows, [&](vtkIdType firstRow, vtkIdType endRow)
+    {
+    std::vector<vtkIdType>& localHistograms = threadHistograms.Local();
+    localHistograms.resize(numberOfBins, 0);
+    std::vector<int> labelIndices(rowLength);
+    for (vtkIdType row = firstRow; row < endRow; ++row)
+      {
+      const void* labelRowPtr = nullptr;
+      const void* scalarRowPtr = nullptr;
+      getRowPointers(row, labelRowPtr, scalarRowPtr);
+      getLabelIndices(labelRowPtr, labelIndices.data());
+      switch (scalarType)
+        {
+        vtkTemplateMacro(AccumulateLabelScalarHistogramsForRow<VTK_TT>(static_cast<const VTK_TT*>(scalarRowPtr), scalarComponents,
+          rowLength, labelIndices.data(), binnings, localHistograms));
+        }
+      }
+    });
+  std::vector<vtkIdType> histograms(numberOfBins, 0);
+  for (const std::vector<vtkIdType>& localHistograms : threadHistograms)
+    {
+    for (vtkIdType binIndex = 0; binIndex < static_cast<vtkIdType>(localHistograms.size()); ++binIndex)
+      {
+      histograms[binIndex] += localHistograms[binIndex];
+      }
+    }
+
+  for (vtkIdType outputIndex = 0; outputIndex < numberOfLabels; ++outputIndex)
+    {
+    // Duplicate label values get the statistics of the first occurrence
+    const int labelIndex = labelIndexLookup[labelValues->GetValue(outputIndex) - minimumLabelValue];
+    const LabelScalarStatistics& labelStatistic = labelStatistics[labelIndex];
+    if (labelStatistic.Count == 0)
+      {
+      continue;
+      }
+    const double count = static_cast<double>(labelStatistic.Count);
+    const double mean = labelStatistic.Sum / count;
+    // Sample standard deviation, same as in vtkImageAccumulate
+    double standardDeviation = 0.0;
+    if (labelStatistic.Count > 1)
+      {
+      standardDeviation = std::sqrt(std::max(0.0, (labelStatistic.SumOfSquares - mean * mean * count) / (count - 1.0)));
+      }
+
+    // Median is in the first bin where the cumulative count reaches half of the voxels,
+    // linearly interpolated within the bin (for bins that contain more than one value).
+    const LabelScalarHistogramBinning& binning = binnings[labelIndex];
+    const double halfCount = count / 2.0;
+    double median = labelStatistic.Minimum;
+    vtkIdType cumulativeCount = 0;
+    for (int binIndex = 0; binIndex < binning.NumberOfBins; ++binIndex)
+      {
+      const vtkIdType binCount = histograms[binning.FirstBinIndex + binIndex];
+      if (static_cast<double>(cumulativeCount + binCount) >= halfCount && binCount > 0)
+        {
+        if (integerScalars && binning.BinWidth <= 1.0)
+          {
+          median = binning.Origin + binIndex;
+          }
+        else
+          {
+          const double fraction = (halfCount - cumulativeCount) / binCount;
+          median = binning.Origin + binning.BinWidth * (binIndex + fraction);
+          }
+        break;
+        }
+      cumulativeCount += binCount;
+      }
+    median = std::max(labelStatistic.Minimum, std::min(labelStatistic.Maximum, median));
+
+    double* tuple = statistics->GetPointer(outputIndex * 6);
+    tuple[0] = count;
+    tuple[1] = labelStatistic.Minimum;
+    tuple[2] = labelStatistic.Maximum;
+    tuple[3] = mean;
+    tuple[4] = standardDeviation;
+    tuple[5] = median;
+    }
+  return true;
+}
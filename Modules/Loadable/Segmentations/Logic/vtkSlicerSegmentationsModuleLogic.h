@@ -34,9 +34,11 @@
 #include "vtkMRMLSegmentationNode.h"
 
 class vtkCallbackCommand;
+class vtkCollection;
 class vtkOrientedImageData;
 class vtkPolyData;
 class vtkDataObject;
+class vtkDoubleArray;
 class vtkGeneralTransform;
 
 class vtkMRMLSegmentationStorageNode;
@@ -463,6 +465,53 @@ public:
   /// \return True if the segmentation extent is outside of the reference volume, False otherwise.
   static bool IsSegmentationExentOutsideReferenceGeometry(vtkOrientedImageData* referenceGeometry, vtkOrientedImageData* segmentationGeometry);
 
+  /// Median filter of a binary labelmap (voxels are 0 or a single label value). The result is the same as
+  /// the output of vtkImageMedian3D with the same kernel size, but it is computed from kernel voxel counts
+  /// (in parallel, independently of the kernel size) instead of sorting the kernel voxels.
+  /// If the output is an oriented image data then the directions of the input are copied to it.
+  /// \param kernelSize Kernel size in voxels along each axis
+  /// \return False if the input is not a single component binary labelmap, in which case the output is not modified.
+  static bool SmoothBinaryLabelmapMedian(vtkImageData* inputLabelmap, const int kernelSize[3], vtkImageData* outputLabelmap);
+
+  /// Morphological opening or closing of a binary labelmap. Nonzero voxels are considered as the segment and are
+  /// set to 1 in the output. The result is the same as the output of vtkImageOpenClose3D (with the same kernel size)
+  /// applied on the input thresholded to 0 and 1, but it is computed in parallel and the kernel is only scanned
+  /// in the voxels near the segment boundary.
+  /// If the output is an oriented image data then the directions of the input are copied to it.
+  /// \param kernelSize Kernel size in voxels along each axis
+  /// \param opening Opening (remove extrusions) if true, closing (fill holes) otherwise
+  static bool SmoothBinaryLabelmapOpenClose(vtkImageData* inputLabelmap, const int kernelSize[3], bool opening, vtkImageData* outputLabelmap);
+
+  /// Smooth the segments of a labelmap jointly, so that no gaps or overlaps are created between them.
+  /// A surface mesh of all the labels is smoothed (the same way as in the joint smoothing method of the
+  /// Smoothing segment editor effect) then converted back to binary labelmaps, in parallel for the labels.
+  /// \param labelmap Labelmap containing the segments
+  /// \param labelValues Label values of the segments to smooth
+  /// \param smoothingFactor Smoothing factor (0-1) that determines the pass band of the windowed sinc filter
+  /// \param smoothedLabelmaps Output collection that receives one binary (0/1) labelmap of unsigned char type for each label value,
+  ///   in the order of labelValues, in the geometry of the input labelmap. The extent of each labelmap only covers the smoothed
+  ///   segment, so it has to be padded to the input labelmap extent if a labelmap of the full extent is needed.
+  /// \return Success flag
+  static bool JointSmoothLabelmap(vtkOrientedImageData* labelmap, vtkIntArray* labelValues, double smoothingFactor,
+    vtkCollection* smoothedLabelmaps);
+
+  /// Compute statistics of the scalar values under each label of a labelmap, for all the labels in a single
+  /// pass over the images (processed in parallel). This is much faster than computing the statistics separately
+  /// for each segment of a shared labelmap layer.
+  /// Voxel (i,j,k) of the labelmap corresponds to voxel (i,j,k) of the scalar image, only the extents of the images
+  /// are used, therefore the labelmap must be resampled to the geometry of the scalar image before calling this method.
+  /// Statistics are computed in the overlapping region of the two extents, from the first component of the images.
+  /// \param labelmap Labelmap containing the segments, typically a shared labelmap layer
+  /// \param scalarImage Image containing the scalar values
+  /// \param labelValues Label values to compute the statistics for
+  /// \param statistics Output array with one tuple for each label value, in the order of labelValues.
+  ///   Components are: voxel count, minimum, maximum, mean, standard deviation, median. All values are 0 for labels
+  ///   that have no voxels. Median is computed from a histogram of the values of the label, which has one bin
+  ///   for each value (exact median) for integer images if the range of the values is less than 4096.
+  /// \return Success flag
+  static bool ComputeLabelScalarStatistics(vtkImageData* labelmap, vtkImageData* scalarImage, vtkIntArray* labelValues,
+    vtkDoubleArray* statistics);
+
 protected:
   void SetMRMLSceneInternal(vtkMRMLScene * newScene) override;
 
@@ -50,6 +50,7 @@
 #include <vtkDoubleArray.h>
 #include <vtkEventBroker.h>
 #include <vtkGeneralTransform.h>
+#include <vtkImageData.h>
 #include <vtkImageMapper.h>
 #include <vtkImageMapToRGBA.h>
 #include <vtkImageThreshold.h>
@@ -123,6 +124,24 @@ void SnapToPermuteMatrix(vtkTransform* transform)
     }
 }
 
+//---------------------------------------------------------------------------
+// Set lookup table value only if it is different from the current value.
+// Setting a table value always modifies the lookup table, which would
+// recompute the colored slice image even if the colors did not change.
+void SetLookupTableValueIfChanged(vtkLookupTable* lookupTable, vtkIdType index, double r, double g, double b, double a)
+{
+  const double rgba[4] = { r, g, b, a };
+  const unsigned char* currentRgba = lookupTable->GetPointer(index);
+  for (int i = 0; i < 4; i++)
+    {
+    if (currentRgba[i] != static_cast<unsigned char>(rgba[i] * 255.0 + 0.5))
+      {
+      lookupTable->SetTableValue(index, r, g, b, a);
+      return;
+      }
+    }
+}
+
 //---------------------------------------------------------------------------
 class vtkMRMLSegmentationsDisplayableManager2D::vtkInternal
 {
@@ -183,6 +202,10 @@ public:
       this->ImageFillActor = vtkSmartPointer<vtkActor2D>::New();
       this->Reslice = vtkSmartPointer<vtkImageReslice>::New();
       this->SliceToImageTransform = vtkSmartPointer<vtkGeneralTransform>::New();
+      this->LinearSliceToImageTransform = vtkSmartPointer<vtkTransform>::New();
+      this->ResliceInputImage = vtkSmartPointer<vtkImageData>::New();
+      this->ResliceInputMTime = 0;
+      this->ResliceMTime = 0;
       this->LabelOutline = vtkSmartPointer<vtkImageLabelOutline>::New();
       this->LookupTableOutline = vtkSmartPointer<vtkLookupTable>::New();
       this->LookupTableFill = vtkSmartPointer<vtkLookupTable>::New();
@@ -244,6 +267,14 @@ public:
     vtkSmartPointer<vtkActor2D> ImageFillActor;
     vtkSmartPointer<vtkImageReslice> Reslice;
     vtkSmartPointer<vtkGeneralTransform> SliceToImageTransform;
+    vtkSmartPointer<vtkTransform> LinearSliceToImageTransform;
+    /// Copy of the displayed labelmap layer with default origin and spacing, used as reslice input.
+    /// One reslice is used for all segments that share the same labelmap layer.
+    vtkSmartPointer<vtkImageData> ResliceInputImage;
+    /// Modified time of the labelmap layer when ResliceInputImage was last updated
+    vtkMTimeType ResliceInputMTime;
+    /// Modified time of the reslice filter when ResliceInputImage was last updated
+    vtkMTimeType ResliceMTime;
     vtkSmartPointer<vtkImageLabelOutline> LabelOutline;
     vtkSmartPointer<vtkLookupTable> LookupTableOutline;
     vtkSmartPointer<vtkLookupTable> LookupTableFill;
@@ -950,9 +981,9 @@ void vtkMRMLSegmentationsDisplayableManager2D::vtkInternal::UpdateDisplayNodePip
         pipeline->LookupTableFill->Build();
 
         int index = pipeline->LookupTableOutline->GetIndex(0.0);
-        pipeline->LookupTableOutline->SetTableValue(index, 0, 0, 0, 0);
+        SetLookupTableValueIfChanged(pipeline->LookupTableOutline, index, 0, 0, 0, 0);
         index = pipeline->LookupTableFill->GetIndex(0.0);
-        pipeline->LookupTableFill->SetTableValue(index, 0, 0, 0, 0);
+        SetLookupTableValueIfChanged(pipeline->LookupTableFill, index, 0, 0, 0, 0);
         }
 
       for (std::string segmentId : sharedSegmentIds)
@@ -1022,9 +1053,9 @@ void vtkMRMLSegmentationsDisplayableManager2D::vtkInternal::UpdateDisplayNodePip
         else
           {
           int index = pipeline->LookupTableFill->GetIndex(labelmapValue);
-          pipeline->LookupTableOutline->SetTableValue(index, color[0], color[1], color[2], outlineOpacity);
+          SetLookupTableValueIfChanged(pipeline->LookupTableOutline, index, color[0], color[1], color[2], outlineOpacity);
           index = pipeline->LookupTableFill->GetIndex(labelmapValue);
-          pipeline->LookupTableFill->SetTableValue(index, color[0], color[1], color[2], fillOpacity);
+          SetLookupTableValueIfChanged(pipeline->LookupTableFill, index, color[0], color[1], color[2], fillOpacity);
           }
         }
       pipeline->Reslice->SetBackgroundLevel(minimumValue);
@@ -1037,21 +1068,37 @@ void vtkMRMLSegmentationsDisplayableManager2D::vtkInternal::UpdateDisplayNodePip
       imageData->GetWorldToImageMatrix(worldToImageMatrix);
       pipeline->SliceToImageTransform->Concatenate(worldToImageMatrix);
 
-      // Create temporary copy of the segment image with default origin and spacing
-      vtkSmartPointer<vtkImageData> identityImageData = vtkSmartPointer<vtkImageData>::New();
-      identityImageData->ShallowCopy(imageData);
-      identityImageData->SetOrigin(0.0, 0.0, 0.0);
-      identityImageData->SetSpacing(1.0, 1.0, 1.0);
-
       // Set Reslice transform
       // vtkImageReslice works faster if the input is a linear transform, so try to convert it
       // to a linear transform.
       // Also attempt to make it a permute transform, as it makes reslicing even faster.
+      // The linear transform is only modified if the matrix has changed so that the slice is not resliced
+      // again when only the display properties of the segments changed.
+      bool linearResliceTransform = false;
       vtkSmartPointer<vtkTransform> linearSliceToImageTransform = vtkSmartPointer<vtkTransform>::New();
       if (vtkMRMLTransformNode::IsGeneralTransformLinear(pipeline->SliceToImageTransform, linearSliceToImageTransform))
         {
         SnapToPermuteMatrix(linearSliceToImageTransform);
-        pipeline->Reslice->SetResliceTransform(linearSliceToImageTransform);
+        vtkMatrix4x4* newMatrix = linearSliceToImageTransform->GetMatrix();
+        vtkMatrix4x4* currentMatrix = pipeline->LinearSliceToImageTransform->GetMatrix();
+        bool matrixChanged = false;
+        for (int row = 0; row < 4 && !matrixChanged; row++)
+          {
+          for (int column = 0; column < 4; column++)
+            {
+            if (newMatrix->GetElement(row, column) != currentMatrix->GetElement(row, column))
+              {
+              matrixChanged = true;
+              break;
+              }
+            }
+          }
+        if (matrixChanged)
+          {
+          pipeline->LinearSliceToImageTransform->SetMatrix(newMatrix);
+          }
+        pipeline->Reslice->SetResliceTransform(pipeline->LinearSliceToImageTransform);
+        linearResliceTransform = true;
         }
       else
         {
@@ -1072,13 +1119,46 @@ void vtkMRMLSegmentationsDisplayableManager2D::vtkInternal::UpdateDisplayNodePip
         pipeline->Reslice->SetInterpolationMode(this->DefaultFractionalInterpolationType);
         }
 
-      pipeline->Reslice->SetInputData(identityImageData);
+      pipeline->Reslice->SetInputData(pipeline->ResliceInputImage);
 
       int dimensions[3] = { 0, 0, 0 };
       this->SliceNode->GetDimensions(dimensions);
       int sliceOutputExtent[6] = { 0, dimensions[0] - 1, 0, dimensions[1] - 1, 0, dimensions[2] - 1 };
       pipeline->Reslice->SetOutputExtent(sliceOutputExtent);
 
+      // Update the reslice input (copy of the layer image with default origin and spacing) if the layer has changed.
+      // If reslice parameters are unchanged and the recorded modified region of the layer does not intersect
+      // the slice then the resliced image would be the same, so the reslice is not updated.
+      bool resliceInputUpdateRequired = (imageData->GetMTime() > pipeline->ResliceInputMTime);
+      if (resliceInputUpdateRequired && linearResliceTransform && pipeline->Reslice->GetMTime() <= pipeline->ResliceMTime)
+        {
+        int modifiedExtent[6] = { 0, -1, 0, -1, 0, -1 };
+        if (imageData->GetModifiedExtent(pipeline->ResliceInputMTime, modifiedExtent))
+          {
+          int sliceExtentInImage[6] = { 0, -1, 0, -1, 0, -1 };
+          vtkOrientedImageDataResample::TransformExtent(sliceOutputExtent, pipeline->LinearSliceToImageTransform, sliceExtentInImage);
+          bool modifiedRegionInSlice = true;
+          for (int i = 0; i < 3; ++i)
+            {
+            // add a voxel margin for interpolation
+            if (modifiedExtent[i * 2] > sliceExtentInImage[i * 2 + 1] + 1 || modifiedExtent[i * 2 + 1] < sliceExtentInImage[i * 2] - 1)
+              {
+              modifiedRegionInSlice = false;
+              break;
+              }
+            }
+          resliceInputUpdateRequired = modifiedRegionInSlice;
+          }
+        }
+      if (resliceInputUpdateRequired)
+        {
+        pipeline->ResliceInputImage->ShallowCopy(imageData);
+        pipeline->ResliceInputImage->SetOrigin(0.0, 0.0, 0.0);
+        pipeline->ResliceInputImage->SetSpacing(1.0, 1.0, 1.0);
+        pipeline->ResliceInputMTime = imageData->GetMTime();
+        }
+      pipeline->ResliceMTime = pipeline->Reslice->GetMTime();
+
       // Smooth the border of fractional labelmaps
       pipeline->LabelOutline->SetInputConnection(pipeline->Reslice->GetOutputPort());
       pipeline->ImageFillActor->GetMapper()->GetInputAlgorithm()->SetInputConnection(pipeline->Reslice->GetOutputPort());
@@ -293,6 +293,12 @@ double qSlicerSubjectHierarchySegmentsPlugin::canOwnSubjectHierarchyItem(vtkIdTy
   return 0.0;
 }
 
+//---------------------------------------------------------------------------
+bool qSlicerSubjectHierarchySegmentsPlugin::ownerConfidenceCacheable()const
+{
+  return true;
+}
+
 //---------------------------------------------------------------------------
 const QString qSlicerSubjectHierarchySegmentsPlugin::roleForPlugin()const
 {
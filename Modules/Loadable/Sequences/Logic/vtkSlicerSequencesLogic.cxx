@@ -37,6 +37,7 @@
 #include "vtkMRMLModelNode.h"
 #include "vtkMRMLScalarVolumeNode.h"
 #include "vtkMRMLScene.h"
+#include "vtkMRMLStorableNode.h"
 #include "vtkMRMLTransformNode.h"
 #ifdef ENABLE_PERFORMANCE_PROFILING
 #include "vtkTimerLog.h"
@@ -59,6 +60,34 @@
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSlicerSequencesLogic);
 
+//----------------------------------------------------------------------------
+namespace
+{
+/// Get the latest modification time of the node and its data object.
+/// Data objects are checked explicitly because their in-place modification
+/// does not change the modification time of the node.
+vtkMTimeType GetNodeContentMTime(vtkMRMLNode* node)
+{
+  vtkMTimeType mtime = node->GetMTime();
+  vtkMRMLVolumeNode* volumeNode = vtkMRMLVolumeNode::SafeDownCast(node);
+  if (volumeNode && volumeNode->GetImageData())
+    {
+    mtime = std::max(mtime, volumeNode->GetImageData()->GetMTime());
+    }
+  vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(node);
+  if (modelNode && modelNode->GetMesh())
+    {
+    mtime = std::max(mtime, modelNode->GetMesh()->GetMTime());
+    }
+  vtkMRMLTransformNode* transformNode = vtkMRMLTransformNode::SafeDownCast(node);
+  if (transformNode && transformNode->GetTransformToParent())
+    {
+    mtime = std::max(mtime, transformNode->GetTransformToParent()->GetMTime());
+    }
+  return mtime;
+}
+}
+
 //----------------------------------------------------------------------------
 vtkSlicerSequencesLogic::vtkSlicerSequencesLogic() = default;
 
@@ -131,6 +160,7 @@ void vtkSlicerSequencesLogic::OnMRMLSceneNodeRemoved(vtkMRMLNode* node)
     vtkErrorMacro("An invalid node is attempted to be removed");
     return;
     }
+  this->ProxyNodeCopySources.erase(node);
   if (node->IsA("vtkMRMLSequenceBrowserNode"))
     {
     vtkDebugMacro("OnMRMLSceneNodeRemoved: Have a vtkMRMLSequenceBrowserNode node");
@@ -255,6 +285,7 @@ void vtkSlicerSequencesLogic::UpdateAllProxyNodes()
     if (!browserNode->GetPlaybackActive())
       {
       this->LastSequenceBrowserUpdateTimeSec.erase(browserNode);
+      this->LastPrefetchedSelectedItemNumber.erase(browserNode);
       continue;
       }
     if ( this->LastSequenceBrowserUpdateTimeSec.find(browserNode) == this->LastSequenceBrowserUpdateTimeSec.end() )
@@ -277,6 +308,76 @@ void vtkSlicerSequencesLogic::UpdateAllProxyNodes()
         }
       browserNode->SelectNextItem(selectionIncrement);
       }
+    else if (this->PlaybackPrefetchItemCount > 0)
+      {
+      // Use the idle time until the next item has to be displayed to read data of the upcoming items.
+      // Data is read on the main thread because MRML nodes must not be modified from worker threads.
+      int selectedItemNumber = browserNode->GetSelectedItemNumber();
+      std::map< vtkMRMLSequenceBrowserNode*, int >::iterator lastPrefetchedIt =
+        this->LastPrefetchedSelectedItemNumber.find(browserNode);
+      if (lastPrefetchedIt == this->LastPrefetchedSelectedItemNumber.end() || lastPrefetchedIt->second != selectedItemNumber)
+        {
+        this->LastPrefetchedSelectedItemNumber[browserNode] = selectedItemNumber;
+        this->PrefetchNextItems(browserNode, this->PlaybackPrefetchItemCount);
+        }
+      }
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkSlicerSequencesLogic::PrefetchNextItems(vtkMRMLSequenceBrowserNode* browserNode, int numberOfItems)
+{
+  if (browserNode == nullptr || numberOfItems <= 0)
+    {
+    return;
+    }
+  vtkMRMLSequenceNode* masterNode = browserNode->GetMasterSequenceNode();
+  if (masterNode == nullptr)
+    {
+    return;
+    }
+  int numberOfMasterItems = masterNode->GetNumberOfDataNodes();
+  int selectedItemNumber = browserNode->GetSelectedItemNumber();
+  if (selectedItemNumber < 0 || numberOfMasterItems < 2)
+    {
+    return;
+    }
+  // Do not prefetch more items than the number of items in the sequence
+  numberOfItems = std::min(numberOfItems, numberOfMasterItems - 1);
+
+  std::vector< vtkMRMLSequenceNode* > synchronizedSequenceNodes;
+  browserNode->GetSynchronizedSequenceNodes(synchronizedSequenceNodes, true);
+  for (vtkMRMLSequenceNode* sequenceNode : synchronizedSequenceNodes)
+    {
+    if (sequenceNode == nullptr || !browserNode->GetPlayback(sequenceNode))
+      {
+      continue;
+      }
+    int numberOfItemsToPrefetch = numberOfItems;
+    int maximumNumberOfLoadedDataNodes = sequenceNode->GetMaximumNumberOfLoadedDataNodes();
+    if (maximumNumberOfLoadedDataNodes > 0)
+      {
+      // Leave room for the currently displayed item, otherwise prefetching would release its data
+      numberOfItemsToPrefetch = std::min(numberOfItemsToPrefetch, maximumNumberOfLoadedDataNodes - 1);
+      }
+    for (int offset = 1; offset <= numberOfItemsToPrefetch; offset++)
+      {
+      int itemNumber = selectedItemNumber + offset;
+      if (itemNumber >= numberOfMasterItems)
+        {
+        if (!browserNode->GetPlaybackLooped())
+          {
+          break;
+          }
+        itemNumber -= numberOfMasterItems;
+        }
+      std::string indexValue = masterNode->GetNthIndexValue(itemNumber);
+      vtkMRMLStorableNode* dataNode = vtkMRMLStorableNode::SafeDownCast(sequenceNode->GetDataNodeAtValue(indexValue, false));
+      if (dataNode && dataNode->GetDataReadPending())
+        {
+        dataNode->ReadPendingData();
+        }
+      }
     }
 }
 
@@ -332,6 +433,8 @@ void vtkSlicerSequencesLogic::UpdateProxyNodesFromSequences(vtkMRMLSequenceBrows
 
   // Store the previous modified state of nodes to allow calling EndModify when all the nodes are updated (to prevent multiple renderings on partial update)
   std::vector< std::pair<vtkMRMLNode*, int> > nodeModifiedStates;
+  // Proxy nodes whose content is copied from a sequence data node in this update
+  std::vector< std::pair<vtkMRMLNode*, vtkMRMLNode*> > copiedProxyNodes;
 
   for (std::vector< vtkMRMLSequenceNode* >::iterator sourceSequenceNodeIt = synchronizedSequenceNodes.begin();
     sourceSequenceNodeIt!=synchronizedSequenceNodes.end(); ++sourceSequenceNodeIt)
@@ -483,7 +586,24 @@ void vtkSlicerSequencesLogic::UpdateProxyNodesFromSequences(vtkMRMLSequenceBrows
     // TODO: if we really want to force non-mutable nodes in the sequence then we have to deep-copy, but that's slow.
     // Make sure that by default/most of the time shallow-copy is used.
     bool shallowCopy = browserNode->GetSaveChanges(synchronizedSequenceNode);
-    targetProxyNode->CopyContent(sourceDataNode, !shallowCopy);
+    // If the proxy node already contains the content of the same source node and none of them
+    // have been modified since then then copying would just allocate and fire events for nothing
+    // (this is common for sparse sequences, where the same item is displayed for many index values).
+    bool contentUpToDate = false;
+    if (!newTargetProxyNodeWasCreated)
+      {
+      std::map< vtkMRMLNode*, ProxyNodeCopySource >::iterator copySourceIt = this->ProxyNodeCopySources.find(targetProxyNode);
+      contentUpToDate = (copySourceIt != this->ProxyNodeCopySources.end()
+        && copySourceIt->second.SourceDataNode.GetPointer() == sourceDataNode.GetPointer()
+        && copySourceIt->second.DeepCopy == !shallowCopy
+        && copySourceIt->second.SourceContentMTime == GetNodeContentMTime(sourceDataNode)
+        && copySourceIt->second.ProxyContentMTime == GetNodeContentMTime(targetProxyNode));
+      }
+    if (!contentUpToDate)
+      {
+      targetProxyNode->CopyContent(sourceDataNode, !shallowCopy);
+      copiedProxyNodes.emplace_back(targetProxyNode, sourceDataNode);
+      }
 
     // Singleton nodes must not be renamed, as they are often expected to exist by a specific name
     if (browserNode->GetOverwriteProxyName(synchronizedSequenceNode) && !targetProxyNode->GetSingletonTag())
@@ -538,6 +658,17 @@ void vtkSlicerSequencesLogic::UpdateProxyNodesFromSequences(vtkMRMLSequenceBrows
     (nodeModifiedStateIt->first)->EndModify(nodeModifiedStateIt->second);
     }
 
+  // Modification times are recorded after EndModify because pending modifications are applied then
+  for (const std::pair<vtkMRMLNode*, vtkMRMLNode*>& copiedProxyNode : copiedProxyNodes)
+    {
+    vtkMRMLSequenceNode* synchronizedSequenceNode = browserNode->GetSequenceNode(copiedProxyNode.first);
+    ProxyNodeCopySource& copySource = this->ProxyNodeCopySources[copiedProxyNode.first];
+    copySource.SourceDataNode = copiedProxyNode.second;
+    copySource.DeepCopy = !(synchronizedSequenceNode && browserNode->GetSaveChanges(synchronizedSequenceNode));
+    copySource.SourceContentMTime = GetNodeContentMTime(copiedProxyNode.second);
+    copySource.ProxyContentMTime = GetNodeContentMTime(copiedProxyNode.first);
+    }
+
   this->UpdateProxyNodesFromSequencesInProgress = false;
 
 #ifdef ENABLE_PERFORMANCE_PROFILING
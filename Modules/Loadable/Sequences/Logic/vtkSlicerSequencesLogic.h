@@ -32,6 +32,9 @@
 // STD includes
 #include <cstdlib>
 
+// VTK includes
+#include <vtkWeakPointer.h>
+
 #include "vtkSlicerSequencesModuleLogicExport.h"
 
 class vtkMRMLMessageCollection;
@@ -59,6 +62,18 @@ public:
   /// Refreshes the output of all the active browser nodes. Called regularly by a timer.
   void UpdateAllProxyNodes();
 
+  /// Read data of the data nodes of the next few items (after the selected item) of all synchronized sequences
+  /// that have playback enabled, if the data has not been read yet (for example, because the scene's
+  /// ReadDataOnDemand is enabled or vtkMRMLSequenceNode::MaximumNumberOfLoadedDataNodes caused release of the data).
+  /// Called during playback when there is idle time between displaying two items so that
+  /// reading from file does not delay the display of the next item.
+  void PrefetchNextItems(vtkMRMLSequenceBrowserNode* browserNode, int numberOfItems);
+
+  /// Number of items ahead of the selected item that are prefetched during playback.
+  /// Set to 0 to disable prefetching. Default is 1.
+  vtkSetMacro(PlaybackPrefetchItemCount, int);
+  vtkGetMacro(PlaybackPrefetchItemCount, int);
+
   /// Updates the contents of all the proxy nodes (all the nodes copied from the master and synchronized sequences to the scene)
   void UpdateProxyNodesFromSequences(vtkMRMLSequenceBrowserNode* browserNode);
 
@@ -121,6 +136,22 @@ protected:
   // Time of the last update of each browser node (in universal time)
   std::map< vtkMRMLSequenceBrowserNode*, double > LastSequenceBrowserUpdateTimeSec;
 
+  // Selected item number of each browser node when the next items were last prefetched
+  std::map< vtkMRMLSequenceBrowserNode*, int > LastPrefetchedSelectedItemNumber;
+
+  int PlaybackPrefetchItemCount{1};
+
+  // Data node that was last copied into each proxy node and the content modification times of
+  // the source and proxy nodes after the copy. Used for skipping copying of unchanged content.
+  struct ProxyNodeCopySource
+    {
+    vtkWeakPointer<vtkMRMLNode> SourceDataNode;
+    vtkMTimeType SourceContentMTime{0};
+    vtkMTimeType ProxyContentMTime{0};
+    bool DeepCopy{false};
+    };
+  std::map< vtkMRMLNode*, ProxyNodeCopySource > ProxyNodeCopySources;
+
 private:
 
   bool UpdateProxyNodesFromSequencesInProgress{false};
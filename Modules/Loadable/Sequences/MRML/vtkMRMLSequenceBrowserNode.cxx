@@ -404,6 +404,9 @@ void vtkMRMLSequenceBrowserNode::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << " Recording active: " << (this->RecordingActive ? "true" : "false") << '\n';
   os << indent << " Recording on master modified only: " << (this->RecordMasterOnly ? "true" : "false") << '\n';
   os << indent << " Recording sampling mode: " << this->GetRecordingSamplingModeAsString() << "\n";
+  os << indent << " Recording commit interval (sec): " << this->RecordingCommitIntervalSec << "\n";
+  os << indent << " Number of pending recorded states: " << this->PendingRecordedStates.size() << "\n";
+  os << indent << " Number of dropped recorded states: " << this->NumberOfDroppedRecordedStates << "\n";
   os << indent << " Index display mode: " << this->GetIndexDisplayModeAsString() << "\n";
   os << indent << " Index display format: " << this->GetIndexDisplayFormat() << "\n";
 
@@ -980,6 +983,16 @@ void vtkMRMLSequenceBrowserNode::SetRecordingActive(bool recording)
     }
   if (this->RecordingActive!=recording)
     {
+    MRMLNodeModifyBlocker blocker(this);
+    if (recording)
+      {
+      this->NumberOfDroppedRecordedStates = 0;
+      this->LastRecordingCommitTimeSec = vtkTimerLog::GetUniversalTime();
+      }
+    else
+      {
+      this->CommitPendingRecordedStates();
+      }
     this->RecordingActive = recording;
     this->Modified();
     }
@@ -1138,11 +1151,43 @@ void vtkMRMLSequenceBrowserNode::SaveProxyNodesState()
       if (this->GetPlaybackRateFps() > 0 && (timeElapsedSinceLastSave < 1.0 / this->GetPlaybackRateFps()))
         {
         // this state is too close in time to the previous saved state, don't record it
+        this->NumberOfDroppedRecordedStates++;
         return;
         }
       }
     this->LastSaveProxyNodesStateTimeSec = currentTime;
     currTime << (currentTime - this->RecordingTimeOffsetSec);
+
+    if (this->RecordingCommitIntervalSec > 0)
+      {
+      // Take a snapshot of the proxy nodes now but add them to the sequences later, in a batch
+      std::vector< vtkMRMLSequenceNode* > sequenceNodes;
+      this->GetSynchronizedSequenceNodes(sequenceNodes, true);
+      PendingRecordedState pendingState;
+      pendingState.IndexValue = currTime.str();
+      for (vtkMRMLSequenceNode* sequenceNode : sequenceNodes)
+        {
+        vtkMRMLNode* proxyNode = this->GetRecording(sequenceNode) ? this->GetProxyNode(sequenceNode) : nullptr;
+        if (!proxyNode)
+          {
+          continue;
+          }
+        vtkSmartPointer<vtkMRMLNode> snapshotNode = vtkSmartPointer<vtkMRMLNode>::Take(proxyNode->CreateNodeInstance());
+        snapshotNode->CopyContent(proxyNode); // deep-copy
+        snapshotNode->SetName(proxyNode->GetName());
+        snapshotNode->SetAttribute("Sequences.BaseName", proxyNode->GetAttribute("Sequences.BaseName"));
+        pendingState.DataNodes.emplace_back(sequenceNode, snapshotNode);
+        }
+      if (!pendingState.DataNodes.empty())
+        {
+        this->PendingRecordedStates.push_back(pendingState);
+        }
+      if (currentTime - this->LastRecordingCommitTimeSec >= this->RecordingCommitIntervalSec)
+        {
+        this->CommitPendingRecordedStates();
+        }
+      return;
+      }
     }
   else
     {
@@ -1162,6 +1207,8 @@ void vtkMRMLSequenceBrowserNode::SaveProxyNodesState()
 
   // Record into each sequence
   MRMLNodeModifyBlocker blocker(this);
+  // Previously recorded states must be added first to keep the order of items
+  this->CommitPendingRecordedStates();
   std::vector< vtkMRMLSequenceNode* > sequenceNodes;
   this->GetSynchronizedSequenceNodes(sequenceNodes, true);
   bool snapshotAdded = false;
@@ -1181,6 +1228,63 @@ void vtkMRMLSequenceBrowserNode::SaveProxyNodesState()
     }
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLSequenceBrowserNode::CommitPendingRecordedStates()
+{
+  this->LastRecordingCommitTimeSec = vtkTimerLog::GetUniversalTime();
+  if (this->PendingRecordedStates.empty())
+    {
+    return;
+    }
+  MRMLNodeModifyBlocker blocker(this);
+
+  // Each sequence node is modified only once, when all the states are added
+  std::vector< std::pair<vtkMRMLSequenceNode*, int> > sequenceNodeModifiedStates;
+  std::vector< vtkMRMLSequenceNode* > sequenceNodes;
+  this->GetSynchronizedSequenceNodes(sequenceNodes, true);
+  for (vtkMRMLSequenceNode* sequenceNode : sequenceNodes)
+    {
+    sequenceNodeModifiedStates.emplace_back(sequenceNode, sequenceNode->StartModify());
+    }
+
+  bool snapshotAdded = false;
+  for (PendingRecordedState& pendingState : this->PendingRecordedStates)
+    {
+    for (std::pair< vtkWeakPointer<vtkMRMLSequenceNode>, vtkSmartPointer<vtkMRMLNode> >& dataNode : pendingState.DataNodes)
+      {
+      vtkMRMLSequenceNode* sequenceNode = dataNode.first.GetPointer();
+      if (!sequenceNode || !this->IsSynchronizedSequenceNode(sequenceNode, true))
+        {
+        // sequence node has been deleted or removed from this browser since the state was recorded
+        continue;
+        }
+      if (sequenceNode->SetDataNodeAtValueWithoutCopy(dataNode.second, pendingState.IndexValue))
+        {
+        snapshotAdded = true;
+        }
+      }
+    }
+  // Clearing keeps the allocated capacity, so the buffer does not need to be reallocated for the next batch
+  this->PendingRecordedStates.clear();
+
+  for (std::pair<vtkMRMLSequenceNode*, int>& sequenceNodeModifiedState : sequenceNodeModifiedStates)
+    {
+    sequenceNodeModifiedState.first->EndModify(sequenceNodeModifiedState.second);
+    }
+
+  if (snapshotAdded)
+    {
+    this->Modified();
+    this->SelectLastItem();
+    }
+}
+
+//---------------------------------------------------------------------------
+int vtkMRMLSequenceBrowserNode::GetNumberOfPendingRecordedStates()
+{
+  return static_cast<int>(this->PendingRecordedStates.size());
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLSequenceBrowserNode::OnNodeReferenceAdded(vtkMRMLNodeReference* nodeReference)
 {
@@ -28,10 +28,13 @@
 #include <vtkMRML.h>
 #include <vtkMRMLNode.h>
 #include <vtkNew.h>
+#include <vtkSmartPointer.h>
+#include <vtkWeakPointer.h>
 
 // STD includes
 #include <set>
 #include <map>
+#include <vector>
 
 class vtkCollection;
 class vtkMRMLSequenceNode;
@@ -196,6 +199,32 @@ public:
   virtual std::string GetRecordingSamplingModeAsString();
   //@}
 
+  //@{
+  /// Get/set the time interval (in seconds) for adding recorded proxy node states to the sequences
+  /// during continuous recording.
+  /// If the value is larger than zero then snapshots of the proxy nodes are collected and added to the
+  /// sequences in batches, which greatly reduces the number of sequence and browser node modified events
+  /// (and the resulting GUI updates) when proxy nodes are modified at a high rate (e.g., tracking and video).
+  /// Pending snapshots are added at the first recorded state after the interval has elapsed, when recording
+  /// is stopped, or when CommitPendingRecordedStates() is called.
+  /// Set to 0 (default) to add each recorded state to the sequences immediately.
+  /// The value is not saved in the scene.
+  vtkSetMacro(RecordingCommitIntervalSec, double);
+  vtkGetMacro(RecordingCommitIntervalSec, double);
+  //@}
+
+  /// Add all pending recorded proxy node states to the sequences.
+  /// \sa SetRecordingCommitIntervalSec
+  void CommitPendingRecordedStates();
+
+  /// Get number of recorded proxy node states that have not been added to the sequences yet.
+  int GetNumberOfPendingRecordedStates();
+
+  /// Get number of proxy node states that were not recorded since recording was activated,
+  /// because they were too close in time to the previously recorded state
+  /// (see SamplingLimitedToPlaybackFrameRate recording sampling mode).
+  vtkGetMacro(NumberOfDroppedRecordedStates, int);
+
   //@{
   /// Helper functions for converting between string and code representation of recording sampling modes
   static std::string GetRecordingSamplingModeAsString(int recordingSamplingMode);
@@ -398,6 +427,17 @@ protected:
   double LastSaveProxyNodesStateTimeSec;
   bool RecordMasterOnly{false};
   int RecordingSamplingMode{vtkMRMLSequenceBrowserNode::SamplingLimitedToPlaybackFrameRate};
+  double RecordingCommitIntervalSec{0.0};
+  double LastRecordingCommitTimeSec{0.0};
+  int NumberOfDroppedRecordedStates{0};
+
+  // Recorded proxy node states that have not been added to the sequences yet
+  struct PendingRecordedState
+    {
+    std::string IndexValue;
+    std::vector< std::pair< vtkWeakPointer<vtkMRMLSequenceNode>, vtkSmartPointer<vtkMRMLNode> > > DataNodes;
+    };
+  std::vector< PendingRecordedState > PendingRecordedStates;
   int IndexDisplayMode{vtkMRMLSequenceBrowserNode::IndexDisplayAsIndexValue};
   std::string IndexDisplayFormat;
 
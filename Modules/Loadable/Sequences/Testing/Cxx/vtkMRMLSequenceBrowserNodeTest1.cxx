@@ -163,11 +163,46 @@ int TestSelectNextItem()
   return EXIT_SUCCESS;
 }
 
+int TestBatchedRecording()
+{
+  vtkNew<vtkMRMLScene> scene;
+
+  // Register vtkMRMLSequenceBrowserNode
+  vtkNew<vtkSlicerSequencesLogic> sequencesLogic;
+  sequencesLogic->SetMRMLScene(scene.GetPointer());
+
+  vtkMRMLTransformNode* proxyNode = vtkMRMLTransformNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLTransformNode"));
+  vtkMRMLSequenceBrowserNode* browserNode = vtkMRMLSequenceBrowserNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLSequenceBrowserNode"));
+  CHECK_NOT_NULL(browserNode);
+  vtkMRMLSequenceNode* sequenceNode = sequencesLogic->AddSynchronizedNode(nullptr, proxyNode, browserNode);
+  CHECK_NOT_NULL(sequenceNode);
+  browserNode->SetRecording(sequenceNode, true);
+  browserNode->SetRecordingSamplingMode(vtkMRMLSequenceBrowserNode::SamplingAll);
+
+  // States are collected but not added to the sequence until the commit interval elapses
+  browserNode->SetRecordingCommitIntervalSec(1000.0);
+  browserNode->SetRecordingActive(true);
+  browserNode->SaveProxyNodesState();
+  browserNode->SaveProxyNodesState();
+  CHECK_INT(browserNode->GetNumberOfPendingRecordedStates(), 2);
+  CHECK_INT(sequenceNode->GetNumberOfDataNodes(), 0);
+
+  // Stopping the recording adds all pending states
+  browserNode->SetRecordingActive(false);
+  CHECK_INT(browserNode->GetNumberOfPendingRecordedStates(), 0);
+  CHECK_BOOL(sequenceNode->GetNumberOfDataNodes() > 0, true);
+  CHECK_INT(browserNode->GetSelectedItemNumber(), sequenceNode->GetNumberOfDataNodes() - 1);
+  CHECK_INT(browserNode->GetNumberOfDroppedRecordedStates(), 0);
+
+  return EXIT_SUCCESS;
+}
+
 }  // end anonymous namespace
 
 int vtkMRMLSequenceBrowserNodeTest1(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
 {
   CHECK_EXIT_SUCCESS(TestIndexFormatting());
   CHECK_EXIT_SUCCESS(TestSelectNextItem());
+  CHECK_EXIT_SUCCESS(TestBatchedRecording());
   return EXIT_SUCCESS;
 }
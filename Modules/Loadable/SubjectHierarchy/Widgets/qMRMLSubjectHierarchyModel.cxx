@@ -1485,6 +1485,14 @@ void qMRMLSubjectHierarchyModel::onEvent(
 //------------------------------------------------------------------------------
 void qMRMLSubjectHierarchyModel::onSubjectHierarchyItemAdded(vtkIdType itemID)
 {
+  Q_D(qMRMLSubjectHierarchyModel);
+  if (d->MRMLScene->IsClosing() || d->MRMLScene->IsBatchProcessing())
+    {
+    // The whole model is rebuilt at the end of batch processing, so there is no need
+    // to insert items one by one (which is slow when many items are added, for example
+    // when importing a large DICOM study).
+    return;
+    }
   this->insertSubjectHierarchyItem(itemID);
 }
 
@@ -1497,11 +1505,11 @@ void qMRMLSubjectHierarchyModel::onSubjectHierarchyItemAboutToBeRemoved(vtkIdTyp
     return;
     }
 
-  QModelIndexList itemIndexes = this->match(
-    this->subjectHierarchySceneIndex(), SubjectHierarchyItemIDRole, itemID, 1, Qt::MatchExactly | Qt::MatchRecursive );
-  if (itemIndexes.count() > 0)
+  // Use the row cache to find the item instead of searching through the whole model
+  QModelIndex itemIndex = this->indexFromSubjectHierarchyItem(itemID);
+  if (itemIndex.isValid())
     {
-    QStandardItem* item = this->itemFromIndex(itemIndexes[0].sibling(itemIndexes[0].row(),0));
+    QStandardItem* item = this->itemFromIndex(itemIndex);
     // The children may be lost if not reparented, we ensure they got reparented.
     while (item->rowCount())
       {
@@ -1516,7 +1524,10 @@ void qMRMLSubjectHierarchyModel::onSubjectHierarchyItemAboutToBeRemoved(vtkIdTyp
         d->Orphans.removeAll(orphans);
         }
       }
-    this->removeRow(itemIndexes[0].row(), itemIndexes[0].parent());
+    this->removeRow(itemIndex.row(), itemIndex.parent());
+    // Remove the invalidated index from the cache so that later lookups of this item
+    // do not have to search through the whole model
+    d->RowCache.remove(itemID);
     }
 }
 
@@ -84,6 +84,12 @@ double qSlicerSubjectHierarchyAbstractPlugin::canOwnSubjectHierarchyItem(vtkIdTy
   return 0.0;
 }
 
+//---------------------------------------------------------------------------
+bool qSlicerSubjectHierarchyAbstractPlugin::ownerConfidenceCacheable()const
+{
+  return false;
+}
+
 //---------------------------------------------------------------------------
 const QString qSlicerSubjectHierarchyAbstractPlugin::roleForPlugin()const
 {
@@ -88,6 +88,13 @@ public:
   ///   item, and 1 means that the plugin is the only one that can handle the item (by node type or identifier attribute)
   Q_INVOKABLE virtual double canOwnSubjectHierarchyItem(vtkIdType itemID)const;
 
+  /// Determines if the confidence value returned by \sa canOwnSubjectHierarchyItem only depends on the class of
+  /// the data node, the level of the item, and the names of the attributes of the data node and the item.
+  /// If it does, then the plugin handler caches the confidence values for these properties, so that the plugin
+  /// is not asked again for items that have the same properties (which makes adding many nodes faster).
+  /// False by default, so that plugins using any other information for their decision are always asked.
+  Q_INVOKABLE virtual bool ownerConfidenceCacheable()const;
+
   /// Get role that the plugin assigns to the subject hierarchy item.
   ///   Each plugin should provide only one role.
   Q_INVOKABLE virtual const QString roleForPlugin()const;
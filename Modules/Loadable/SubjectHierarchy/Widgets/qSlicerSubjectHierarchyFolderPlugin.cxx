@@ -210,6 +210,12 @@ double qSlicerSubjectHierarchyFolderPlugin::canOwnSubjectHierarchyItem(vtkIdType
   return 0.0;
 }
 
+//---------------------------------------------------------------------------
+bool qSlicerSubjectHierarchyFolderPlugin::ownerConfidenceCacheable()const
+{
+  return true;
+}
+
 //---------------------------------------------------------------------------
 const QString qSlicerSubjectHierarchyFolderPlugin::roleForPlugin()const
 {
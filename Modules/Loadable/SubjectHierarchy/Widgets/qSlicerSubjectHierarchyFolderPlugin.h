@@ -84,6 +84,9 @@ public:
   ///   item, and 1 means that the plugin is the only one that can handle the item (by node type or identifier attribute)
   double canOwnSubjectHierarchyItem(vtkIdType itemID)const override;
 
+  /// Confidence value only depends on the item level, so it can be cached
+  bool ownerConfidenceCacheable()const override;
+
   /// Get role that the plugin assigns to the subject hierarchy item.
   ///   Each plugin should provide only one role.
   Q_INVOKABLE const QString roleForPlugin()const override;
@@ -42,9 +42,16 @@
 // VTK includes
 #include <vtkCallbackCommand.h>
 
+// STD includes
+#include <algorithm>
+
 //----------------------------------------------------------------------------
 qSlicerSubjectHierarchyPluginHandler *qSlicerSubjectHierarchyPluginHandler::m_Instance = nullptr;
 
+/// Owner confidence cache is cleared when it has more entries than this, to prevent unlimited growth
+/// in case items have many different combinations of attribute names
+static const int OWNER_CONFIDENCE_CACHE_MAXIMUM_SIZE = 10000;
+
 //----------------------------------------------------------------------------
 class qSlicerSubjectHierarchyPluginHandlerCleanup
 {
@@ -161,6 +168,9 @@ bool qSlicerSubjectHierarchyPluginHandler::registerPlugin(qSlicerSubjectHierarch
   // Update timestamp
   this->LastPluginRegistrationTime = QDateTime::currentDateTimeUtc();
 
+  // Cached confidence values do not include the new plugin
+  this->clearOwnerConfidenceCache();
+
   return true;
 }
 
@@ -271,12 +281,46 @@ qSlicerSubjectHierarchyPluginHandler::findOwnerPluginForSubjectHierarchyItem(vtk
     return nullptr;
     }
 
+  // Determine which plugins allow caching their confidence values. It is done here instead of at
+  // registration, because scripted plugins are registered before their Python object is fully initialized.
+  const int numberOfPlugins = this->m_RegisteredPlugins.size();
+  if (this->m_OwnerConfidenceCacheable.size() != numberOfPlugins)
+    {
+    this->m_OwnerConfidenceCacheable.clear();
+    foreach (qSlicerSubjectHierarchyAbstractPlugin* plugin, this->m_RegisteredPlugins)
+      {
+      this->m_OwnerConfidenceCacheable << plugin->ownerConfidenceCacheable();
+      }
+    }
+
+  // The cached values are copied, as plugins may trigger owner plugin search for other items
+  QString cacheKey = this->ownerConfidenceCacheKey(itemID);
+  QVector<double> cachedConfidences;
+  if (!cacheKey.isEmpty())
+    {
+    cachedConfidences = this->m_OwnerConfidenceCache.value(cacheKey);
+    }
+  bool cacheUpdated = false;
+  if (cachedConfidences.size() != numberOfPlugins)
+    {
+    cachedConfidences.fill(-1.0, numberOfPlugins);
+    }
+
   QList<qSlicerSubjectHierarchyAbstractPlugin*> mostSuitablePlugins;
   double bestConfidence = 0.0;
-  qSlicerSubjectHierarchyAbstractPlugin* currentPlugin = nullptr;
-  foreach (currentPlugin, this->m_RegisteredPlugins)
+  for (int pluginIndex = 0; pluginIndex < numberOfPlugins; ++pluginIndex)
     {
-    double currentConfidence = currentPlugin->canOwnSubjectHierarchyItem(itemID);
+    qSlicerSubjectHierarchyAbstractPlugin* currentPlugin = this->m_RegisteredPlugins[pluginIndex];
+    double currentConfidence = cachedConfidences[pluginIndex];
+    if (currentConfidence < 0.0)
+      {
+      currentConfidence = currentPlugin->canOwnSubjectHierarchyItem(itemID);
+      if (this->m_OwnerConfidenceCacheable[pluginIndex] && !cacheKey.isEmpty())
+        {
+        cachedConfidences[pluginIndex] = std::max(currentConfidence, 0.0);
+        cacheUpdated = true;
+        }
+      }
     if (currentConfidence > bestConfidence)
       {
       bestConfidence = currentConfidence;
@@ -291,6 +335,14 @@ qSlicerSubjectHierarchyPluginHandler::findOwnerPluginForSubjectHierarchyItem(vtk
       mostSuitablePlugins << currentPlugin;
       }
     }
+  if (cacheUpdated && this->m_RegisteredPlugins.size() == numberOfPlugins)
+    {
+    if (this->m_OwnerConfidenceCache.size() >= OWNER_CONFIDENCE_CACHE_MAXIMUM_SIZE)
+      {
+      this->m_OwnerConfidenceCache.clear();
+      }
+    this->m_OwnerConfidenceCache[cacheKey] = cachedConfidences;
+    }
 
   // Determine owner plugin based on plugins returning the highest non-zero confidence values for the input item
   qSlicerSubjectHierarchyAbstractPlugin* ownerPlugin = nullptr;
@@ -331,6 +383,62 @@ qSlicerSubjectHierarchyAbstractPlugin* qSlicerSubjectHierarchyPluginHandler::fin
   return ownerPlugin;
 }
 
+//---------------------------------------------------------------------------
+void qSlicerSubjectHierarchyPluginHandler::findAndSetOwnerPluginForSubjectHierarchyItems(vtkIdList* itemIDs)
+{
+  if (!itemIDs)
+    {
+    qCritical() << Q_FUNC_INFO << ": Invalid item list";
+    return;
+    }
+  if (this->m_MRMLScene != nullptr && this->m_MRMLScene->GetSubjectHierarchyNode() == nullptr)
+    {
+    qCritical() << Q_FUNC_INFO << ": Invalid subject hierarchy node";
+    return;
+    }
+
+  for (vtkIdType index = 0; index < itemIDs->GetNumberOfIds(); ++index)
+    {
+    this->findAndSetOwnerPluginForSubjectHierarchyItem(itemIDs->GetId(index));
+    }
+}
+
+//---------------------------------------------------------------------------
+void qSlicerSubjectHierarchyPluginHandler::clearOwnerConfidenceCache()
+{
+  this->m_OwnerConfidenceCacheable.clear();
+  this->m_OwnerConfidenceCache.clear();
+}
+
+//---------------------------------------------------------------------------
+QString qSlicerSubjectHierarchyPluginHandler::ownerConfidenceCacheKey(vtkIdType itemID)
+{
+  vtkMRMLSubjectHierarchyNode* shNode = (this->m_MRMLScene ? this->m_MRMLScene->GetSubjectHierarchyNode() : nullptr);
+  if (!shNode || itemID == vtkMRMLSubjectHierarchyNode::INVALID_ITEM_ID || itemID == shNode->GetSceneItemID())
+    {
+    // Confidence values are not cached
+    return QString();
+    }
+
+  // Attribute names are sorted, so the key does not depend on the order the attributes were added
+  vtkMRMLNode* dataNode = shNode->GetItemDataNode(itemID);
+  QStringList keyParts;
+  keyParts << QString(dataNode ? dataNode->GetClassName() : "") << QString::fromStdString(shNode->GetItemLevel(itemID));
+  if (dataNode)
+    {
+    for (const std::string& attributeName : dataNode->GetAttributeNames())
+      {
+      keyParts << QString::fromStdString(attributeName);
+      }
+    }
+  keyParts << QString();
+  for (const std::string& attributeName : shNode->GetItemAttributeNames(itemID))
+    {
+    keyParts << QString::fromStdString(attributeName);
+    }
+  return keyParts.join(QLatin1Char('\n'));
+}
+
 //---------------------------------------------------------------------------
 qSlicerSubjectHierarchyAbstractPlugin* qSlicerSubjectHierarchyPluginHandler::getOwnerPluginForSubjectHierarchyItem(vtkIdType itemID)
 {
@@ -36,9 +36,11 @@
 
 // Qt includes
 #include <QDateTime>
+#include <QHash>
 #include <QList>
 #include <QObject>
 #include <QString>
+#include <QVector>
 
 class vtkMRMLScene;
 class vtkCallbackCommand;
@@ -183,6 +185,18 @@ public:
   /// \param item Item to be owned
   qSlicerSubjectHierarchyAbstractPlugin* findAndSetOwnerPluginForSubjectHierarchyItem(vtkIdType itemID);
 
+  /// Find and set plugin that is most suitable to own each of the given subject hierarchy items.
+  /// Faster than calling \sa findAndSetOwnerPluginForSubjectHierarchyItem for each item when many items are
+  /// added at once (for example after bulk import), because confidence values of cacheable plugins are only
+  /// computed once for items of the same data node class, level, and attribute names.
+  /// \param itemIDs Items to be owned
+  Q_INVOKABLE void findAndSetOwnerPluginForSubjectHierarchyItems(vtkIdList* itemIDs);
+
+  /// Clear the cached owner plugin confidence values.
+  /// The cache is cleared automatically when a plugin is registered. It needs to be cleared manually if the
+  /// decision of a plugin that allows caching its confidence values changes (\sa qSlicerSubjectHierarchyAbstractPlugin::ownerConfidenceCacheable).
+  Q_INVOKABLE void clearOwnerConfidenceCache();
+
   /// Get plugin owning a certain subject hierarchy item.
   /// This function doesn't try to find a suitable plugin, it just returns the one already assigned.
   Q_INVOKABLE qSlicerSubjectHierarchyAbstractPlugin* getOwnerPluginForSubjectHierarchyItem(vtkIdType itemID);
@@ -211,6 +225,10 @@ protected:
   /// Handle subject hierarchy node events
   static void onSubjectHierarchyNodeEvent(vtkObject* caller, unsigned long event, void* clientData, void* callData);
 
+  /// Get the key of the owner confidence cache for an item. Items that have the same data node class,
+  /// level, and attribute names get the same confidence values from plugins that allow caching.
+  QString ownerConfidenceCacheKey(vtkIdType itemID);
+
 protected:
   /// List of registered plugin instances
   QList<qSlicerSubjectHierarchyAbstractPlugin*> m_RegisteredPlugins;
@@ -235,6 +253,13 @@ protected:
   /// Callback handling deletion of the subject hierarchy node
   vtkSmartPointer<vtkCallbackCommand> m_CallBack;
 
+  /// Flag for each registered plugin (in the same order) telling if its owner confidence values can be cached.
+  /// Empty if it needs to be updated (after a plugin is registered).
+  QVector<bool> m_OwnerConfidenceCacheable;
+  /// Cached owner confidence values of the registered plugins (in the same order), by \sa ownerConfidenceCacheKey.
+  /// Negative value means that the confidence value is not cached for the plugin.
+  QHash<QString, QVector<double> > m_OwnerConfidenceCache;
+
 public:
   /// Timestamp of the last plugin registration. Used to allow context menus be repopulated if needed.
   QDateTime LastPluginRegistrationTime;
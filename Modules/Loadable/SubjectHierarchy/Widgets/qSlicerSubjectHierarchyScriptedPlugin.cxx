@@ -66,7 +66,8 @@ public:
     ShowViewContextMenuActionsForItemMethod,
     CanAddNodeToSubjectHierarchyMethod,
     CanReparentItemInsideSubjectHierarchyMethod,
-    ReparentItemInsideSubjectHierarchyMethod
+    ReparentItemInsideSubjectHierarchyMethod,
+    OwnerConfidenceCacheableMethod
     };
 
   mutable qSlicerPythonCppAPI PythonCppAPI;
@@ -101,6 +102,7 @@ qSlicerSubjectHierarchyScriptedPluginPrivate::qSlicerSubjectHierarchyScriptedPlu
   this->PythonCppAPI.declareMethod(Self::CanAddNodeToSubjectHierarchyMethod, "canAddNodeToSubjectHierarchy");
   this->PythonCppAPI.declareMethod(Self::CanReparentItemInsideSubjectHierarchyMethod, "canReparentItemInsideSubjectHierarchy");
   this->PythonCppAPI.declareMethod(Self::ReparentItemInsideSubjectHierarchyMethod, "reparentItemInsideSubjectHierarchy");
+  this->PythonCppAPI.declareMethod(Self::OwnerConfidenceCacheableMethod, "ownerConfidenceCacheable");
 }
 
 //-----------------------------------------------------------------------------
@@ -246,6 +248,27 @@ double qSlicerSubjectHierarchyScriptedPlugin::canOwnSubjectHierarchyItem(vtkIdTy
   return PyFloat_AsDouble(result);
 }
 
+//-----------------------------------------------------------------------------
+bool qSlicerSubjectHierarchyScriptedPlugin::ownerConfidenceCacheable()const
+{
+  Q_D(const qSlicerSubjectHierarchyScriptedPlugin);
+  PyObject* result = d->PythonCppAPI.callMethod(d->OwnerConfidenceCacheableMethod);
+  if (!result)
+    {
+    // Method call failed (probably an omitted function), call default implementation
+    return this->Superclass::ownerConfidenceCacheable();
+    }
+
+  // Parse result
+  if (!PyBool_Check(result))
+    {
+    qWarning() << d->PythonSourceFilePath << ": " << Q_FUNC_INFO << ": Function 'ownerConfidenceCacheable' is expected to return a boolean!";
+    return this->Superclass::ownerConfidenceCacheable();
+    }
+
+  return result == Py_True;
+}
+
 //---------------------------------------------------------------------------
 const QString qSlicerSubjectHierarchyScriptedPlugin::roleForPlugin()const
 {
@@ -92,6 +92,13 @@ public:
   ///   item, and 1 means that the plugin is the only one that can handle the item (by node type or identifier attribute)
   double canOwnSubjectHierarchyItem(vtkIdType itemID)const override;
 
+  /// Determines if the confidence value returned by \sa canOwnSubjectHierarchyItem only depends on the class of
+  /// the data node, the level of the item, and the names of the attributes of the data node and the item.
+  /// If it does, then the plugin handler caches the confidence values for these properties, so that the plugin
+  /// is not asked again for items that have the same properties (which makes adding many nodes faster).
+  /// False by default, so that plugins using any other information for their decision are always asked.
+  bool ownerConfidenceCacheable()const override;
+
   /// Get role that the plugin assigns to the subject hierarchy item.
   ///   Each plugin should provide only one role.
   const QString roleForPlugin()const override;
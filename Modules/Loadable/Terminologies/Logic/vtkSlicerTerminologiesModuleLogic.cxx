@@ -44,6 +44,7 @@
 
 // STD includes
 #include <algorithm>
+#include <future>
 
 #include "rapidjson/document.h"     // rapidjson's DOM-style API
 #include "rapidjson/prettywriter.h" // for stringify JSON
@@ -66,9 +67,31 @@ public:
   // on Linux and Mac), therefore we store a simple pointer and create/delete
   // the document object manually
   typedef std::map<std::string, rapidjson::Document* > TerminologyMap;
-  vtkInternal();
+
+  /// JSON file parsed in the background. Document is nullptr if the file could not be parsed.
+  struct ParsedContextFile
+    {
+    std::string FilePath;
+    bool AnatomicContext{false};
+    rapidjson::Document* Document{nullptr};
+    };
+  typedef std::vector<ParsedContextFile> ParsedContextFileList;
+
+  vtkInternal(vtkSlicerTerminologiesModuleLogic* external);
   ~vtkInternal();
 
+  /// Start parsing the default terminology and anatomic context files on a background thread.
+  /// Parsing is independent of the logic, the parsed documents are only stored
+  /// in the loaded context maps by \sa WaitForDefaultContexts.
+  void StartLoadingDefaultContexts(const std::vector<std::string>& terminologyFilePaths,
+    const std::vector<std::string>& anatomicContextFilePaths);
+  /// Wait for the background loading of the default contexts (if still in progress) and store the
+  /// parsed documents. Contexts that have been loaded with the same name in the meantime are kept,
+  /// as they would have replaced the default ones if those were loaded synchronously.
+  void WaitForDefaultContexts();
+  /// Parse JSON file. Returns nullptr on failure. May be called from any thread.
+  static rapidjson::Document* ParseJsonFile(const std::string& filePath);
+
   /// Utility function to get code in Json array
   /// \param foundIndex Output parameter for index of found object in input array. -1 if not found
   /// \return Json object if found, otherwise null Json object
@@ -160,17 +183,34 @@ public:
 
   /// Loaded anatomical region contexts. Key is the context name, value is the root item.
   TerminologyMap LoadedAnatomicContexts;
+
+  /// Result of the background parsing of default contexts, valid until it is collected.
+  std::future<ParsedContextFileList> DefaultContextsFuture;
+
+  vtkSlicerTerminologiesModuleLogic* External{nullptr};
 };
 
 //---------------------------------------------------------------------------
 // vtkInternal methods
 
 //---------------------------------------------------------------------------
-vtkSlicerTerminologiesModuleLogic::vtkInternal::vtkInternal() = default;
+vtkSlicerTerminologiesModuleLogic::vtkInternal::vtkInternal(vtkSlicerTerminologiesModuleLogic* external)
+  : External(external)
+{
+}
 
 //---------------------------------------------------------------------------
 vtkSlicerTerminologiesModuleLogic::vtkInternal::~vtkInternal()
 {
+  if (this->DefaultContextsFuture.valid())
+    {
+    // Loading is still in progress, wait for it to complete so that the documents can be deleted
+    ParsedContextFileList parsedFiles = this->DefaultContextsFuture.get();
+    for (ParsedContextFile& parsedFile : parsedFiles)
+      {
+      delete parsedFile.Document;
+      }
+    }
   for (TerminologyMap::iterator termIt = this->LoadedTerminologies.begin();
     termIt != this->LoadedTerminologies.end(); ++termIt)
     {
@@ -183,6 +223,106 @@ vtkSlicerTerminologiesModuleLogic::vtkInternal::~vtkInternal()
     }
 }
 
+//---------------------------------------------------------------------------
+rapidjson::Document* vtkSlicerTerminologiesModuleLogic::vtkInternal::ParseJsonFile(const std::string& filePath)
+{
+  FILE *fp = fopen(filePath.c_str(), "r");
+  if (!fp)
+    {
+    return nullptr;
+    }
+  rapidjson::Document* jsonRoot = new rapidjson::Document;
+  char buffer[4096];
+  rapidjson::FileReadStream fs(fp, buffer, sizeof(buffer));
+  if (jsonRoot->ParseStream(fs).HasParseError())
+    {
+    delete jsonRoot;
+    jsonRoot = nullptr;
+    }
+  fclose(fp);
+  return jsonRoot;
+}
+
+//---------------------------------------------------------------------------
+void vtkSlicerTerminologiesModuleLogic::vtkInternal::StartLoadingDefaultContexts(
+  const std::vector<std::string>& terminologyFilePaths, const std::vector<std::string>& anatomicContextFilePaths)
+{
+  // Collect results of any previous request first
+  this->WaitForDefaultContexts();
+
+  ParsedContextFileList filesToParse;
+  for (const std::string& filePath : terminologyFilePaths)
+    {
+    ParsedContextFile file;
+    file.FilePath = filePath;
+    filesToParse.push_back(file);
+    }
+  for (const std::string& filePath : anatomicContextFilePaths)
+    {
+    ParsedContextFile file;
+    file.FilePath = filePath;
+    file.AnatomicContext = true;
+    filesToParse.push_back(file);
+    }
+
+  this->DefaultContextsFuture = std::async(std::launch::async, [filesToParse]()
+    {
+    ParsedContextFileList parsedFiles = filesToParse;
+    for (ParsedContextFile& parsedFile : parsedFiles)
+      {
+      parsedFile.Document = vtkInternal::ParseJsonFile(parsedFile.FilePath);
+      }
+    return parsedFiles;
+    });
+}
+
+//---------------------------------------------------------------------------
+void vtkSlicerTerminologiesModuleLogic::vtkInternal::WaitForDefaultContexts()
+{
+  if (!this->DefaultContextsFuture.valid())
+    {
+    // Not loading or already loaded
+    return;
+    }
+  ParsedContextFileList parsedFiles = this->DefaultContextsFuture.get();
+  for (ParsedContextFile& parsedFile : parsedFiles)
+    {
+    rapidjson::Document* jsonRoot = parsedFile.Document;
+    const char* nameMember = parsedFile.AnatomicContext ? "AnatomicContextName" : "SegmentationCategoryTypeContextName";
+    bool validSchema = false;
+    if (jsonRoot && jsonRoot->IsObject())
+      {
+      rapidjson::Value::MemberIterator schemaIt = jsonRoot->FindMember("@schema");
+      if (schemaIt != jsonRoot->MemberEnd() && schemaIt->value.IsString())
+        {
+        std::string schema = schemaIt->value.GetString();
+        validSchema = parsedFile.AnatomicContext
+          ? (!schema.compare(ANATOMIC_CONTEXT_SCHEMA) || !schema.compare(ANATOMIC_CONTEXT_SCHEMA_1))
+          : (!schema.compare(TERMINOLOGY_CONTEXT_SCHEMA) || !schema.compare(TERMINOLOGY_CONTEXT_SCHEMA_1));
+        }
+      validSchema = validSchema && jsonRoot->HasMember(nameMember) && (*jsonRoot)[nameMember].IsString();
+      }
+    if (!validSchema)
+      {
+      vtkErrorWithObjectMacro(this->External, "WaitForDefaultContexts: Failed to load "
+        << (parsedFile.AnatomicContext ? "anatomic context" : "terminology") << " from file '" << parsedFile.FilePath << "'");
+      delete jsonRoot;
+      continue;
+      }
+
+    std::string contextName = (*jsonRoot)[nameMember].GetString();
+    TerminologyMap& contextMap = parsedFile.AnatomicContext ? this->LoadedAnatomicContexts : this->LoadedTerminologies;
+    if (contextMap.find(contextName) != contextMap.end())
+      {
+      // Context with the same name has been loaded since the default contexts were requested, keep that
+      delete jsonRoot;
+      continue;
+      }
+    contextMap[contextName] = jsonRoot;
+    vtkDebugWithObjectMacro(this->External, "Default context named '" << contextName << "' successfully loaded from file " << parsedFile.FilePath);
+    }
+}
+
 //---------------------------------------------------------------------------
 rapidjson::Value& vtkSlicerTerminologiesModuleLogic::vtkInternal::GetCodeInArray(CodeIdentifier codeId, rapidjson::Value &jsonArray, int &foundIndex)
 {
@@ -218,6 +358,7 @@ rapidjson::Value& vtkSlicerTerminologiesModuleLogic::vtkInternal::GetCodeInArray
 //---------------------------------------------------------------------------
 rapidjson::Value& vtkSlicerTerminologiesModuleLogic::vtkInternal::GetTerminologyRootByName(std::string terminologyName)
 {
+  this->WaitForDefaultContexts();
   TerminologyMap::iterator termIt = this->LoadedTerminologies.find(terminologyName);
   if (termIt != this->LoadedTerminologies.end() && termIt->second != nullptr)
     {
@@ -505,6 +646,7 @@ rapidjson::Value& vtkSlicerTerminologiesModuleLogic::vtkInternal::GetTypeModifie
 //---------------------------------------------------------------------------
 rapidjson::Value& vtkSlicerTerminologiesModuleLogic::vtkInternal::GetAnatomicContextRootByName(std::string anatomicContextName)
 {
+  this->WaitForDefaultContexts();
   TerminologyMap::iterator anIt = this->LoadedAnatomicContexts.find(anatomicContextName);
   if (anIt != this->LoadedAnatomicContexts.end() && anIt->second != nullptr)
     {
@@ -994,7 +1136,7 @@ void vtkSlicerTerminologiesModuleLogic::vtkInternal::GetJsonCodeFromIdentifier(
 //----------------------------------------------------------------------------
 vtkSlicerTerminologiesModuleLogic::vtkSlicerTerminologiesModuleLogic()
 {
-  this->Internal = new vtkInternal();
+  this->Internal = new vtkInternal(this);
 }
 
 //----------------------------------------------------------------------------
@@ -1018,11 +1160,12 @@ void vtkSlicerTerminologiesModuleLogic::SetMRMLSceneInternal(vtkMRMLScene* newSc
   Superclass::SetMRMLSceneInternal(newScene);
 
   // Load default terminologies and anatomical contexts
-  // Note: Do it here not in the constructor so that the module shared directory is properly initialized
+  // Note: Do it here not in the constructor so that the module shared directory is properly initialized.
+  // The large default files are parsed on a background thread, so that they do not delay application startup.
+  // They are stored when they are first needed (any query blocks until they are available).
   bool wasModifying = this->GetDisableModifiedEvent();
   this->SetDisableModifiedEvent(true);
-  this->LoadDefaultTerminologies();
-  this->LoadDefaultAnatomicContexts();
+  this->LoadDefaultContextsInBackground();
   this->LoadUserContexts();
   this->SetDisableModifiedEvent(wasModifying);
 }
@@ -1160,6 +1303,7 @@ bool vtkSlicerTerminologiesModuleLogic::LoadTerminologyFromSegmentDescriptorFile
     }
 
   // Convert the loaded descriptor json file into terminology dictionary context json format
+  this->Internal->WaitForDefaultContexts();
   rapidjson::Document* convertedDoc = nullptr;
   vtkInternal::TerminologyMap::iterator termIt = this->Internal->LoadedTerminologies.find(contextName);
   if (termIt != this->Internal->LoadedTerminologies.end() && termIt->second != nullptr)
@@ -1278,6 +1422,7 @@ bool vtkSlicerTerminologiesModuleLogic::LoadAnatomicContextFromSegmentDescriptor
     }
 
   // Convert the loaded descriptor json file into anatomic context json format
+  this->Internal->WaitForDefaultContexts();
   rapidjson::Document* convertedDoc = nullptr;
   vtkInternal::TerminologyMap::iterator anIt = this->Internal->LoadedAnatomicContexts.find(contextName);
   if (anIt != this->Internal->LoadedAnatomicContexts.end() && anIt->second != nullptr)
@@ -1318,6 +1463,23 @@ void vtkSlicerTerminologiesModuleLogic::LoadDefaultAnatomicContexts()
     }
 }
 
+//---------------------------------------------------------------------------
+void vtkSlicerTerminologiesModuleLogic::LoadDefaultContextsInBackground()
+{
+  std::vector<std::string> terminologyFilePaths;
+  terminologyFilePaths.push_back(this->GetModuleShareDirectory() + "/SegmentationCategoryTypeModifier-SlicerGeneralAnatomy.term.json");
+  terminologyFilePaths.push_back(this->GetModuleShareDirectory() + "/SegmentationCategoryTypeModifier-DICOM-Master.term.json");
+  std::vector<std::string> anatomicContextFilePaths;
+  anatomicContextFilePaths.push_back(this->GetModuleShareDirectory() + "/AnatomicRegionAndModifier-DICOM-Master.term.json");
+  this->Internal->StartLoadingDefaultContexts(terminologyFilePaths, anatomicContextFilePaths);
+}
+
+//---------------------------------------------------------------------------
+void vtkSlicerTerminologiesModuleLogic::WaitForDefaultContexts()
+{
+  this->Internal->WaitForDefaultContexts();
+}
+
 //---------------------------------------------------------------------------
 void vtkSlicerTerminologiesModuleLogic::LoadUserContexts()
 {
@@ -1355,6 +1517,7 @@ void vtkSlicerTerminologiesModuleLogic::LoadUserContexts()
 void vtkSlicerTerminologiesModuleLogic::GetLoadedTerminologyNames(std::vector<std::string> &terminologyNames)
 {
   terminologyNames.clear();
+  this->Internal->WaitForDefaultContexts();
 
   vtkSlicerTerminologiesModuleLogic::vtkInternal::TerminologyMap::iterator termIt;
   for (termIt=this->Internal->LoadedTerminologies.begin(); termIt!=this->Internal->LoadedTerminologies.end(); ++termIt)
@@ -1384,6 +1547,7 @@ void vtkSlicerTerminologiesModuleLogic::GetLoadedTerminologyNames(vtkStringArray
 void vtkSlicerTerminologiesModuleLogic::GetLoadedAnatomicContextNames(std::vector<std::string> &anatomicContextNames)
 {
   anatomicContextNames.clear();
+  this->Internal->WaitForDefaultContexts();
 
   vtkSlicerTerminologiesModuleLogic::vtkInternal::TerminologyMap::iterator anIt;
   for (anIt=this->Internal->LoadedAnatomicContexts.begin(); anIt!=this->Internal->LoadedAnatomicContexts.end(); ++anIt)
@@ -225,6 +225,12 @@ public:
   /// Assemble human readable info string from a terminology entry, for example for tooltips
   static std::string GetInfoStringFromTerminologyEntry(vtkSlicerTerminologyEntry* entry);
 
+  /// Wait until the default terminologies and anatomic contexts are loaded.
+  /// Default contexts are loaded on a background thread when the scene is set. All queries
+  /// wait for them automatically, therefore this method only needs to be called if the
+  /// default contexts are needed to be available at a specific time.
+  void WaitForDefaultContexts();
+
 public:
   vtkGetStringMacro(UserContextsPath);
   vtkSetStringMacro(UserContextsPath);
@@ -239,6 +245,10 @@ protected:
   void LoadDefaultTerminologies();
   /// Load default anatomic context dictionaries from JSON into \sa LoadedAnatomicContexts
   void LoadDefaultAnatomicContexts();
+  /// Start loading default terminology and anatomic context dictionaries on a background thread.
+  /// The parsed dictionaries are stored in \sa LoadedTerminologies and \sa LoadedAnatomicContexts
+  /// when they are first accessed or when \sa WaitForDefaultContexts is called.
+  void LoadDefaultContextsInBackground();
   /// Load terminologies and anatomic contexts from the user settings directory \sa UserContextsPath
   void LoadUserContexts();
 
@@ -119,6 +119,12 @@ double qSlicerSubjectHierarchyTextsPlugin::canOwnSubjectHierarchyItem(vtkIdType
   return 0.0;
 }
 
+//---------------------------------------------------------------------------
+bool qSlicerSubjectHierarchyTextsPlugin::ownerConfidenceCacheable()const
+{
+  return true;
+}
+
 //---------------------------------------------------------------------------
 const QString qSlicerSubjectHierarchyTextsPlugin::roleForPlugin()const
 {
@@ -0,0 +1,156 @@
+/*=auto=========================================================================
+
+  Portions (c) Copyright 2005 Brigham and Women's Hospital (BWH) All Rights Reserved.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Program:   3D Slicer
+
+=========================================================================auto=*/
+
+// Performance of hardening non-linear transforms on models and volumes
+
+// Logic includes
+#include "vtkSlicerTransformLogic.h"
+
+// MRML includes
+#include "vtkMRMLCoreTestingMacros.h"
+#include "vtkMRMLModelNode.h"
+#include "vtkMRMLScalarVolumeNode.h"
+#include "vtkMRMLScene.h"
+#include "vtkMRMLTransformNode.h"
+
+// VTK includes
+#include <vtkGeneralTransform.h>
+#include <vtkImageData.h>
+#include <vtkMath.h>
+#include <vtkNew.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSphereSource.h>
+#include <vtkThinPlateSplineTransform.h>
+#include <vtkTimerLog.h>
+
+// STD includes
+#include <algorithm>
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+vtkMRMLTransformNode* AddWarpingTransform(vtkMRMLScene* scene)
+{
+  vtkNew<vtkPoints> sourceLandmarks;
+  vtkNew<vtkPoints> targetLandmarks;
+  const double landmarks[6][3] = { { -50, -50, -50 }, { 50, -50, 0 }, { 0, 50, 50 }, { 0, 0, 0 }, { 50, 50, -50 }, { -50, 50, 0 } };
+  for (int i = 0; i < 6; i++)
+    {
+    sourceLandmarks->InsertNextPoint(landmarks[i]);
+    targetLandmarks->InsertNextPoint(landmarks[i][0] + (i == 3 ? 5.0 : 0.0), landmarks[i][1] + (i == 1 ? -4.0 : 0.0), landmarks[i][2]);
+    }
+  vtkNew<vtkThinPlateSplineTransform> tpsTransform;
+  tpsTransform->SetBasisToR();
+  tpsTransform->SetSourceLandmarks(sourceLandmarks.GetPointer());
+  tpsTransform->SetTargetLandmarks(targetLandmarks.GetPointer());
+  vtkMRMLTransformNode* transformNode = vtkMRMLTransformNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLTransformNode"));
+  transformNode->SetAndObserveTransformToParent(tpsTransform.GetPointer());
+  return transformNode;
+}
+
+//-----------------------------------------------------------------------------
+int TestHardenModel(vtkMRMLScene* scene, vtkMRMLTransformNode* transformNode)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(40.0);
+  sphere->SetThetaResolution(500);
+  sphere->SetPhiResolution(500);
+  sphere->Update();
+  vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLModelNode"));
+  modelNode->SetAndObservePolyData(sphere->GetOutput());
+  modelNode->SetAndObserveTransformNodeID(transformNode->GetID());
+  vtkIdType numberOfPoints = modelNode->GetPolyData()->GetNumberOfPoints();
+
+  // Expected positions of a few points
+  vtkNew<vtkGeneralTransform> transformToWorld;
+  transformNode->GetTransformToWorld(transformToWorld.GetPointer());
+  const vtkIdType testPointIds[3] = { 0, numberOfPoints / 3, numberOfPoints - 1 };
+  double expectedPoints[3][3];
+  for (int i = 0; i < 3; i++)
+    {
+    transformToWorld->TransformPoint(modelNode->GetPolyData()->GetPoint(testPointIds[i]), expectedPoints[i]);
+    }
+
+  vtkNew<vtkTimerLog> timerLog;
+  timerLog->StartTimer();
+  CHECK_BOOL(vtkSlicerTransformLogic::hardenTransform(modelNode), true);
+  timerLog->StopTimer();
+  std::cout << "Harden model: " << numberOfPoints << " points in " << timerLog->GetElapsedTime() << "s, "
+    << numberOfPoints / std::max(timerLog->GetElapsedTime(), 1e-6) << " points/s" << std::endl;
+
+  CHECK_NULL(modelNode->GetParentTransformNode());
+  CHECK_INT(modelNode->GetPolyData()->GetNumberOfPoints(), numberOfPoints);
+  for (int i = 0; i < 3; i++)
+    {
+    double* point = modelNode->GetPolyData()->GetPoint(testPointIds[i]);
+    CHECK_DOUBLE_TOLERANCE(sqrt(vtkMath::Distance2BetweenPoints(point, expectedPoints[i])), 0.0, 1e-6);
+    }
+  return EXIT_SUCCESS;
+}
+
+//-----------------------------------------------------------------------------
+int TestHardenVolume(vtkMRMLScene* scene, vtkMRMLTransformNode* transformNode, bool useBakedTransform)
+{
+  vtkNew<vtkImageData> imageData;
+  imageData->SetDimensions(100, 100, 100);
+  imageData->AllocateScalars(VTK_SHORT, 1);
+  short* voxels = static_cast<short*>(imageData->GetScalarPointer());
+  for (vtkIdType i = 0; i < imageData->GetNumberOfPoints(); i++)
+    {
+    voxels[i] = static_cast<short>(i % 1000);
+    }
+  vtkMRMLScalarVolumeNode* volumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLScalarVolumeNode"));
+  volumeNode->SetOrigin(-49.5, -49.5, -49.5);
+  volumeNode->SetAndObserveImageData(imageData.GetPointer());
+  volumeNode->SetAndObserveTransformNodeID(transformNode->GetID());
+  vtkIdType numberOfVoxels = imageData->GetNumberOfPoints();
+
+  vtkNew<vtkTimerLog> timerLog;
+  timerLog->StartTimer();
+  CHECK_BOOL(vtkSlicerTransformLogic::hardenTransform(volumeNode, useBakedTransform), true);
+  timerLog->StopTimer();
+  std::cout << "Harden volume" << (useBakedTransform ? " (baked transform)" : "") << ": "
+    << numberOfVoxels << " voxels in " << timerLog->GetElapsedTime() << "s, "
+    << numberOfVoxels / std::max(timerLog->GetElapsedTime(), 1e-6) << " voxels/s" << std::endl;
+
+  CHECK_NULL(volumeNode->GetParentTransformNode());
+  CHECK_NOT_NULL(volumeNode->GetImageData());
+  // the warped volume is larger than the original because the volume bulges out
+  int* dimensions = volumeNode->GetImageData()->GetDimensions();
+  CHECK_BOOL(static_cast<vtkIdType>(dimensions[0]) * dimensions[1] * dimensions[2] >= numberOfVoxels, true);
+  return EXIT_SUCCESS;
+}
+
+} // end namespace
+
+//-----------------------------------------------------------------------------
+int vtkSlicerTransformLogicTest4(int vtkNotUsed(argc), char * vtkNotUsed(argv) [])
+{
+  vtkNew<vtkMRMLScene> scene;
+  vtkMRMLTransformNode* transformNode = AddWarpingTransform(scene.GetPointer());
+
+  CHECK_EXIT_SUCCESS(TestHardenModel(scene.GetPointer(), transformNode));
+  CHECK_EXIT_SUCCESS(TestHardenVolume(scene.GetPointer(), transformNode, false));
+
+  const double bounds[6] = { -60, 60, -60, 60, -60, 60 };
+  const double spacing[3] = { 2.0, 2.0, 2.0 };
+  vtkNew<vtkTimerLog> timerLog;
+  timerLog->StartTimer();
+  CHECK_BOOL(transformNode->BakeTransformToWorld(bounds, spacing), true);
+  timerLog->StopTimer();
+  std::cout << "Bake transform: " << timerLog->GetElapsedTime() << "s" << std::endl;
+  CHECK_EXIT_SUCCESS(TestHardenVolume(scene.GetPointer(), transformNode, true));
+
+  std::cout << "Success" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -44,7 +44,6 @@ or http://www.slicer.org/copyright/copyright.txt for details.
 #include <vtkGeneralTransform.h>
 #include <vtkGlyphSource2D.h>
 #include <vtkImageData.h>
-#include <vtkLine.h>
 #include <vtkLookupTable.h>
 #include <vtkMath.h>
 #include <vtkTransform.h>
@@ -55,12 +54,14 @@ or http://www.slicer.org/copyright/copyright.txt for details.
 #include <vtkPoints.h>
 #include <vtkPointSet.h>
 #include <vtkPointData.h>
+#include <vtkSMPTools.h>
 #include <vtkSphereSource.h>
 #include <vtkThinPlateSplineTransform.h>
 #include <vtkTransform.h>
 #include <vtkTransformPolyDataFilter.h>
 #include <vtkTubeFilter.h>
 #include <vtkUnstructuredGrid.h>
+#include <vtkWeakPointer.h>
 #include <vtkVectorNorm.h>
 #include <vtkWarpVector.h>
 
@@ -80,6 +81,40 @@ or http://www.slicer.org/copyright/copyright.txt for details.
 #include "itkTranslationTransform.h"
 #include "itkTransformFactory.h"
 
+// STD includes
+#include <deque>
+
+//----------------------------------------------------------------------------
+namespace
+{
+/// Displacements of the sample points of a transform visualization.
+/// Visualizations are updated whenever a slice view or the display node changes,
+/// so the displacements are reused while the samples and the transform are the same.
+struct DisplacementCacheEntry
+{
+  vtkWeakPointer<vtkMRMLTransformNode> TransformNode;
+  vtkMTimeType TransformMTime{0};
+  bool TransformToWorld{true};
+  std::vector<double> SamplePositions;
+  std::vector<double> Displacements;
+};
+/// Most recently used entry first
+std::deque<DisplacementCacheEntry> DisplacementCache;
+const size_t DisplacementCacheMaximumSize = 16;
+
+/// Lines of the grid visualization, they only depend on the grid size and subdivision.
+/// Cells are stored in legacy format (number of points followed by the point IDs of each cell).
+/// VTK objects are not kept in these caches so that they are not reported as leaks.
+struct GridLinesCacheEntry
+{
+  int NumGridPoints[3]{0, 0, 0};
+  int GridSubdivision{0};
+  std::vector<vtkIdType> Lines;
+};
+std::deque<GridLinesCacheEntry> GridLinesCache;
+const size_t GridLinesCacheMaximumSize = 8;
+}
+
 vtkStandardNewMacro(vtkSlicerTransformLogic);
 
 //----------------------------------------------------------------------------
@@ -89,12 +124,24 @@ vtkSlicerTransformLogic::vtkSlicerTransformLogic() = default;
 vtkSlicerTransformLogic::~vtkSlicerTransformLogic() = default;
 
 //-----------------------------------------------------------------------------
-bool vtkSlicerTransformLogic::hardenTransform(vtkMRMLTransformableNode* transformableNode)
+bool vtkSlicerTransformLogic::hardenTransform(vtkMRMLTransformableNode* transformableNode,
+  bool useBakedTransform/*=false*/)
 {
   if (!transformableNode)
     {
     return false;
     }
+  vtkMRMLTransformNode* transformNode = transformableNode->GetParentTransformNode();
+  if (useBakedTransform && transformNode && transformableNode->CanApplyNonLinearTransforms()
+    && transformNode->IsTransformToWorldBaked())
+    {
+    // GetTransformToWorld returns the baked grid
+    vtkNew<vtkGeneralTransform> bakedTransformToWorld;
+    transformNode->GetTransformToWorld(bakedTransformToWorld.GetPointer());
+    transformableNode->ApplyTransform(bakedTransformToWorld.GetPointer());
+    transformableNode->SetAndObserveTransformNodeID(nullptr);
+    return true;
+    }
   return transformableNode->HardenTransform();
 }
 
@@ -215,21 +262,13 @@ void vtkSlicerTransformLogic::GetTransformedPointSamples(vtkPointSet* outputPoin
   vtkMRMLTransformNode* inputTransformNode, vtkMatrix4x4* gridToRAS, int* gridSize,
   bool transformToWorld /* = true */)
 {
-  vtkNew<vtkGeneralTransform> inputTransform;
-  if (transformToWorld)
-  {
-    inputTransformNode->GetTransformToWorld(inputTransform.GetPointer());
-  }
-  else
-  {
-    inputTransformNode->GetTransformFromWorld(inputTransform.GetPointer());
-  }
-  // Generate sample point set on a grid
+  // Generate sample point set on a grid, the displacements are computed
+  // by the point set version of this method
   vtkNew<vtkPoints> samplePositions_RAS;
+  samplePositions_RAS->SetDataTypeToDouble();
   int numOfSamples = gridSize[0] * gridSize[1] * gridSize[2];
   samplePositions_RAS->SetNumberOfPoints(numOfSamples);
   double point_RAS[4] = { 0, 0, 0, 1 };
-  double transformedPoint_RAS[4] = { 0, 0, 0, 1 };
   double point_Grid[4] = { 0, 0, 0, 1 };
   int sampleIndex = 0;
   for (point_Grid[2] = 0; point_Grid[2]<gridSize[2]; point_Grid[2]++)
@@ -239,7 +278,6 @@ void vtkSlicerTransformLogic::GetTransformedPointSamples(vtkPointSet* outputPoin
       for (point_Grid[0] = 0; point_Grid[0]<gridSize[0]; point_Grid[0]++)
         {
         gridToRAS->MultiplyPoint(point_Grid, point_RAS);
-        inputTransform->TransformPoint(point_RAS, transformedPoint_RAS);
         samplePositions_RAS->SetPoint(sampleIndex, point_RAS[0], point_RAS[1], point_RAS[2]);
         sampleIndex++;
         }
@@ -259,39 +297,91 @@ void vtkSlicerTransformLogic::GetTransformedPointSamples(vtkPointSet* outputPoin
     return;
     }
 
-  //Will contain the corresponding vectors for outputPointSet
-  int numOfSamples = samplePositions_RAS->GetNumberOfPoints();
-  vtkNew<vtkDoubleArray> sampleVectors_RAS;
-  sampleVectors_RAS->Initialize();
-  sampleVectors_RAS->SetNumberOfComponents(3);
-  sampleVectors_RAS->SetNumberOfTuples(numOfSamples);
-  sampleVectors_RAS->SetName("DisplacementVector");
-
-  vtkNew<vtkGeneralTransform> inputTransform;
-  if (transformToWorld)
+  vtkIdType numOfSamples = samplePositions_RAS->GetNumberOfPoints();
+  std::vector<double> samplePositions(3 * numOfSamples);
+  for (vtkIdType sampleIndex = 0; sampleIndex < numOfSamples; sampleIndex++)
     {
-    inputTransformNode->GetTransformToWorld(inputTransform.GetPointer());
+    samplePositions_RAS->GetPoint(sampleIndex, &samplePositions[3 * sampleIndex]);
     }
-  else
+
+  // Reuse displacements computed for the same samples (same slice or ROI geometry) and transform
+  vtkMTimeType transformMTime = inputTransformNode->GetTransformToWorldMTime();
+  auto displacementsIt = DisplacementCache.end();
+  for (auto cacheIt = DisplacementCache.begin(); cacheIt != DisplacementCache.end(); ++cacheIt)
     {
-    inputTransformNode->GetTransformFromWorld(inputTransform.GetPointer());
+    if (cacheIt->TransformNode == inputTransformNode && cacheIt->TransformMTime == transformMTime
+      && cacheIt->TransformToWorld == transformToWorld && cacheIt->SamplePositions == samplePositions)
+      {
+      DisplacementCacheEntry entry = std::move(*cacheIt);
+      DisplacementCache.erase(cacheIt);
+      DisplacementCache.push_front(std::move(entry));
+      displacementsIt = DisplacementCache.begin();
+      break;
+      }
     }
 
-  double transformedPoint_RAS[4] = { 0, 0, 0, 1 };
-  double pointDislocationVector_RAS[4] = { 0, 0, 0, 1 };
-  for (int sampleIndex = 0; sampleIndex < numOfSamples; sampleIndex++)
+  if (displacementsIt == DisplacementCache.end())
     {
-    double* point_RAS = samplePositions_RAS->GetPoint(sampleIndex);
-
-    inputTransform->TransformPoint(point_RAS, transformedPoint_RAS);
-
-    pointDislocationVector_RAS[0] = transformedPoint_RAS[0] - point_RAS[0];
-    pointDislocationVector_RAS[1] = transformedPoint_RAS[1] - point_RAS[1];
-    pointDislocationVector_RAS[2] = transformedPoint_RAS[2] - point_RAS[2];
+    // Compute transformed sample positions in parallel
+    vtkNew<vtkPoints> transformedPositions_RAS;
+    if (!transformToWorld && !inputTransformNode->IsTransformToWorldLinear() && !inputTransformNode->IsTransformToWorldBaked())
+      {
+      vtkNew<vtkGeneralTransform> inputTransformToWorld;
+      inputTransformNode->GetTransformToWorld(inputTransformToWorld.GetPointer());
+      vtkMRMLTransformNode::InverseTransformPoints(inputTransformToWorld.GetPointer(),
+        samplePositions_RAS, transformedPositions_RAS.GetPointer());
+      }
+    else
+      {
+      vtkNew<vtkGeneralTransform> inputTransform;
+      if (transformToWorld)
+        {
+        inputTransformNode->GetTransformToWorld(inputTransform.GetPointer());
+        }
+      else
+        {
+        inputTransformNode->GetTransformFromWorld(inputTransform.GetPointer());
+        }
+      // the transform must be up to date before it is used from multiple threads
+      inputTransform->Update();
+      transformedPositions_RAS->SetDataTypeToDouble();
+      transformedPositions_RAS->SetNumberOfPoints(numOfSamples);
+      double* transformedPositionsPtr = static_cast<double*>(transformedPositions_RAS->GetVoidPointer(0));
+      vtkSMPTools::For(0, numOfSamples, [&](vtkIdType sampleBegin, vtkIdType sampleEnd)
+        {
+        for (vtkIdType sampleIndex = sampleBegin; sampleIndex < sampleEnd; sampleIndex++)
+          {
+          inputTransform->InternalTransformPoint(&samplePositions[3 * sampleIndex], transformedPositionsPtr + 3 * sampleIndex);
+          }
+        });
+      }
 
-    sampleVectors_RAS->SetTuple3(sampleIndex, pointDislocationVector_RAS[0], pointDislocationVector_RAS[1], pointDislocationVector_RAS[2]);
+    DisplacementCacheEntry entry;
+    entry.TransformNode = inputTransformNode;
+    entry.TransformMTime = transformMTime;
+    entry.TransformToWorld = transformToWorld;
+    entry.Displacements.resize(3 * numOfSamples);
+    double* transformedPositionsPtr = static_cast<double*>(transformedPositions_RAS->GetVoidPointer(0));
+    for (vtkIdType i = 0; i < 3 * numOfSamples; i++)
+      {
+      entry.Displacements[i] = transformedPositionsPtr[i] - samplePositions[i];
+      }
+    entry.SamplePositions.swap(samplePositions);
+    DisplacementCache.push_front(std::move(entry));
+    if (DisplacementCache.size() > DisplacementCacheMaximumSize)
+      {
+      DisplacementCache.pop_back();
+      }
+    displacementsIt = DisplacementCache.begin();
     }
 
+  // Will contain the corresponding vectors for outputPointSet
+  vtkNew<vtkDoubleArray> sampleVectors_RAS;
+  sampleVectors_RAS->SetNumberOfComponents(3);
+  sampleVectors_RAS->SetNumberOfTuples(numOfSamples);
+  sampleVectors_RAS->SetName("DisplacementVector");
+  std::copy(displacementsIt->Displacements.begin(), displacementsIt->Displacements.end(), sampleVectors_RAS->GetPointer(0));
+
   outputPointSet->SetPoints(samplePositions_RAS);
   vtkPointData* pointData = outputPointSet->GetPointData();
   pointData->SetVectors(sampleVectors_RAS.GetPointer());
@@ -390,58 +480,101 @@ void vtkSlicerTransformLogic::GetTransformedPointSamplesOnSlice(vtkPointSet* out
 }
 
 //----------------------------------------------------------------------------
-bool vtkSlicerTransformLogic::GetTransformedPointSamplesAsMagnitudeImage(vtkImageData* magnitudeImage,
-  vtkMRMLTransformNode* inputTransformNode, vtkMatrix4x4* ijkToRAS, bool transformToWorld /* = true */)
+namespace
 {
-  if (!magnitudeImage || !inputTransformNode || !ijkToRAS)
+/// Compute the displacement of each voxel of \a image by the transform to or from world.
+/// The transform to world is evaluated in parallel. The transform from world is computed
+/// by inverting the transform to world for all voxels at once, which is much faster than
+/// the voxel by voxel inversion of non-linear transforms.
+/// Displacements are stored in \a displacements as 3 components per voxel.
+void ComputeVoxelDisplacements(vtkImageData* image, vtkMRMLTransformNode* inputTransformNode,
+  vtkMatrix4x4* ijkToRAS, bool transformToWorld, std::vector<double>& displacements)
+{
+  int* extent = image->GetExtent();
+  vtkNew<vtkPoints> points_RAS;
+  points_RAS->SetDataTypeToDouble();
+  points_RAS->SetNumberOfPoints(image->GetNumberOfPoints());
+  double point_RAS[4] = { 0, 0, 0, 1 };
+  double point_IJK[4] = { 0, 0, 0, 1 };
+  vtkIdType pointId = 0;
+  for (point_IJK[2] = extent[4]; point_IJK[2] <= extent[5]; point_IJK[2]++)
   {
-    vtkGenericWarningMacro("vtkSlicerTransformLogic::GetTransformedPointSamplesAsMagnitudeImage failed: invalid input");
-    return false;
+    for (point_IJK[1] = extent[2]; point_IJK[1] <= extent[3]; point_IJK[1]++)
+    {
+      for (point_IJK[0] = extent[0]; point_IJK[0] <= extent[1]; point_IJK[0]++)
+      {
+        ijkToRAS->MultiplyPoint(point_IJK, point_RAS);
+        points_RAS->SetPoint(pointId++, point_RAS);
+      }
+    }
   }
 
-  vtkNew<vtkGeneralTransform> inputTransform;
-  if (transformToWorld)
+  vtkNew<vtkPoints> transformedPoints_RAS;
+  if (!transformToWorld && !inputTransformNode->IsTransformToWorldLinear() && !inputTransformNode->IsTransformToWorldBaked())
   {
-    inputTransformNode->GetTransformToWorld(inputTransform.GetPointer());
+    vtkNew<vtkGeneralTransform> inputTransformToWorld;
+    inputTransformNode->GetTransformToWorld(inputTransformToWorld.GetPointer());
+    vtkMRMLTransformNode::InverseTransformPoints(inputTransformToWorld.GetPointer(),
+      points_RAS.GetPointer(), transformedPoints_RAS.GetPointer());
   }
   else
   {
-    inputTransformNode->GetTransformFromWorld(inputTransform.GetPointer());
+    vtkNew<vtkGeneralTransform> inputTransform;
+    if (transformToWorld)
+    {
+      inputTransformNode->GetTransformToWorld(inputTransform.GetPointer());
+    }
+    else
+    {
+      inputTransformNode->GetTransformFromWorld(inputTransform.GetPointer());
+    }
+    // the transform must be up to date before it is used from multiple threads
+    inputTransform->Update();
+    transformedPoints_RAS->SetDataTypeToDouble();
+    transformedPoints_RAS->SetNumberOfPoints(pointId);
+    double* inputPtr = static_cast<double*>(points_RAS->GetVoidPointer(0));
+    double* outputPtr = static_cast<double*>(transformedPoints_RAS->GetVoidPointer(0));
+    vtkSMPTools::For(0, pointId, [&](vtkIdType pointBegin, vtkIdType pointEnd)
+    {
+      for (vtkIdType id = pointBegin; id < pointEnd; ++id)
+      {
+        inputTransform->InternalTransformPoint(inputPtr + 3 * id, outputPtr + 3 * id);
+      }
+    });
   }
 
+  displacements.resize(3 * pointId);
+  double* inputPtr = static_cast<double*>(points_RAS->GetVoidPointer(0));
+  double* outputPtr = static_cast<double*>(transformedPoints_RAS->GetVoidPointer(0));
+  for (vtkIdType i = 0; i < 3 * pointId; ++i)
+  {
+    displacements[i] = outputPtr[i] - inputPtr[i];
+  }
+}
+}
+
+//----------------------------------------------------------------------------
+bool vtkSlicerTransformLogic::GetTransformedPointSamplesAsMagnitudeImage(vtkImageData* magnitudeImage,
+  vtkMRMLTransformNode* inputTransformNode, vtkMatrix4x4* ijkToRAS, bool transformToWorld /* = true */)
+{
+  if (!magnitudeImage || !inputTransformNode || !ijkToRAS)
+  {
+    vtkGenericWarningMacro("vtkSlicerTransformLogic::GetTransformedPointSamplesAsMagnitudeImage failed: invalid input");
+    return false;
+  }
+
+  std::vector<double> displacements;
+  ComputeVoxelDisplacements(magnitudeImage, inputTransformNode, ijkToRAS, transformToWorld, displacements);
+
   // The orientation of the volume cannot be set in the image
   // therefore the volume will not appear in the correct position
   // if the direction matrix is not identity.
   magnitudeImage->AllocateScalars(VTK_FLOAT, 1);
 
-  double point_RAS[4] = { 0, 0, 0, 1 };
-  double transformedPoint_RAS[4] = { 0, 0, 0, 1 };
-  double pointDislocationVector_RAS[4] = { 0, 0, 0, 1 };
-  double point_IJK[4] = { 0, 0, 0, 1 };
   float* voxelPtr = static_cast<float*>(magnitudeImage->GetScalarPointer());
-  int* extent = magnitudeImage->GetExtent();
-  for (point_IJK[2] = extent[4]; point_IJK[2] <= extent[5]; point_IJK[2]++)
+  for (size_t i = 0; i < displacements.size(); i += 3)
   {
-    for (point_IJK[1] = extent[2]; point_IJK[1] <= extent[3]; point_IJK[1]++)
-    {
-      for (point_IJK[0] = extent[0]; point_IJK[0] <= extent[1]; point_IJK[0]++)
-      {
-        ijkToRAS->MultiplyPoint(point_IJK, point_RAS);
-
-        inputTransform->TransformPoint(point_RAS, transformedPoint_RAS);
-
-        pointDislocationVector_RAS[0] = transformedPoint_RAS[0] - point_RAS[0];
-        pointDislocationVector_RAS[1] = transformedPoint_RAS[1] - point_RAS[1];
-        pointDislocationVector_RAS[2] = transformedPoint_RAS[2] - point_RAS[2];
-
-        float mag = sqrt(
-          pointDislocationVector_RAS[0] * pointDislocationVector_RAS[0] +
-          pointDislocationVector_RAS[1] * pointDislocationVector_RAS[1] +
-          pointDislocationVector_RAS[2] * pointDislocationVector_RAS[2]);
-
-        *(voxelPtr++) = mag;
-      }
-    }
+    *(voxelPtr++) = static_cast<float>(vtkMath::Norm(&displacements[i]));
   }
 
   return true;
@@ -706,42 +839,19 @@ bool vtkSlicerTransformLogic::GetTransformedPointSamplesAsVectorImage(vtkImageDa
     vtkGenericWarningMacro("vtkSlicerTransformLogic::GetTransformedPointSamplesAsVectorImage failed: invalid input");
     return false;
   }
-  vtkNew<vtkGeneralTransform> inputTransform;
-  if (transformToWorld)
-  {
-    inputTransformNode->GetTransformToWorld(inputTransform.GetPointer());
-  }
-  else
-  {
-    inputTransformNode->GetTransformFromWorld(inputTransform.GetPointer());
-  }
+  std::vector<double> displacements;
+  ComputeVoxelDisplacements(vectorImage, inputTransformNode, ijkToRAS, transformToWorld, displacements);
 
   // The orientation of the volume cannot be set in the image
   // therefore the volume will not appear in the correct position
   // if the direction matrix is not identity.
   vectorImage->AllocateScalars(VTK_FLOAT, 3);
 
-  double point_RAS[4] = { 0, 0, 0, 1 };
-  double transformedPoint_RAS[4] = { 0, 0, 0, 1 };
-  double point_IJK[4] = { 0, 0, 0, 1 };
+  // store the pointDislocationVector_RAS components in the image
   float* voxelPtr = static_cast<float*>(vectorImage->GetScalarPointer());
-  int* extent = vectorImage->GetExtent();
-  for (point_IJK[2] = extent[4]; point_IJK[2] <= extent[5]; point_IJK[2]++)
+  for (size_t i = 0; i < displacements.size(); ++i)
   {
-    for (point_IJK[1] = extent[2]; point_IJK[1] <= extent[3]; point_IJK[1]++)
-    {
-      for (point_IJK[0] = extent[0]; point_IJK[0] <= extent[1]; point_IJK[0]++)
-      {
-        ijkToRAS->MultiplyPoint(point_IJK, point_RAS);
-
-        inputTransform->TransformPoint(point_RAS, transformedPoint_RAS);
-
-        // store the pointDislocationVector_RAS components in the image
-        *(voxelPtr++) = static_cast<float>(transformedPoint_RAS[0] - point_RAS[0]);
-        *(voxelPtr++) = static_cast<float>(transformedPoint_RAS[1] - point_RAS[1]);
-        *(voxelPtr++) = static_cast<float>(transformedPoint_RAS[2] - point_RAS[2]);
-      }
-    }
+    *(voxelPtr++) = static_cast<float>(displacements[i]);
   }
 
   return true;
@@ -969,14 +1079,13 @@ int vtkSlicerTransformLogic::GetGridSubdivision(vtkMRMLTransformDisplayNode* dis
   return subdivision;
 }
 
+namespace
+{
 //----------------------------------------------------------------------------
-void vtkSlicerTransformLogic::CreateGrid(vtkPolyData* gridPolyData,
-  vtkMRMLTransformDisplayNode* displayNode, int numGridPoints[3], vtkPolyData* warpedGrid/*=nullptr*/)
+/// Get the lines of the grid in legacy cell array format
+void CreateGridLines(int numGridPoints[3], int gridSubdivision, std::vector<vtkIdType>& grid)
 {
-  vtkNew<vtkCellArray> grid;
-  vtkNew<vtkLine> line;
-
-  int gridSubdivision = GetGridSubdivision(displayNode);
+  grid.clear();
 
   // Create lines along i
   for (int k = 0; k < numGridPoints[2]; k += gridSubdivision)
@@ -985,9 +1094,9 @@ void vtkSlicerTransformLogic::CreateGrid(vtkPolyData* gridPolyData,
     {
       for (int i = 0; i < numGridPoints[0] - 1; i++)
       {
-        line->GetPointIds()->SetId(0, (i)+(j*numGridPoints[0]) + (k*numGridPoints[0] * numGridPoints[1]));
-        line->GetPointIds()->SetId(1, (i + 1) + (j*numGridPoints[0]) + (k*numGridPoints[0] * numGridPoints[1]));
-        grid->InsertNextCell(line.GetPointer());
+        grid.push_back(2);
+        grid.push_back((i)+(j*numGridPoints[0]) + (k*numGridPoints[0] * numGridPoints[1]));
+        grid.push_back((i + 1) + (j*numGridPoints[0]) + (k*numGridPoints[0] * numGridPoints[1]));
       }
     }
   }
@@ -999,9 +1108,9 @@ void vtkSlicerTransformLogic::CreateGrid(vtkPolyData* gridPolyData,
     {
       for (int i = 0; i < numGridPoints[0]; i += gridSubdivision)
       {
-        line->GetPointIds()->SetId(0, (i)+((j)*numGridPoints[0]) + (k*numGridPoints[0] * numGridPoints[1]));
-        line->GetPointIds()->SetId(1, (i)+((j + 1)*numGridPoints[0]) + (k*numGridPoints[0] * numGridPoints[1]));
-        grid->InsertNextCell(line.GetPointer());
+        grid.push_back(2);
+        grid.push_back((i)+((j)*numGridPoints[0]) + (k*numGridPoints[0] * numGridPoints[1]));
+        grid.push_back((i)+((j + 1)*numGridPoints[0]) + (k*numGridPoints[0] * numGridPoints[1]));
       }
     }
   }
@@ -1013,13 +1122,50 @@ void vtkSlicerTransformLogic::CreateGrid(vtkPolyData* gridPolyData,
     {
       for (int i = 0; i < numGridPoints[0]; i += gridSubdivision)
       {
-        line->GetPointIds()->SetId(0, (i)+((j)*numGridPoints[0]) + ((k)*numGridPoints[0] * numGridPoints[1]));
-        line->GetPointIds()->SetId(1, (i)+((j)*numGridPoints[0]) + ((k + 1)*numGridPoints[0] * numGridPoints[1]));
-        grid->InsertNextCell(line.GetPointer());
+        grid.push_back(2);
+        grid.push_back((i)+((j)*numGridPoints[0]) + ((k)*numGridPoints[0] * numGridPoints[1]));
+        grid.push_back((i)+((j)*numGridPoints[0]) + ((k + 1)*numGridPoints[0] * numGridPoints[1]));
       }
     }
   }
+}
+}
 
+//----------------------------------------------------------------------------
+void vtkSlicerTransformLogic::CreateGrid(vtkPolyData* gridPolyData,
+  vtkMRMLTransformDisplayNode* displayNode, int numGridPoints[3], vtkPolyData* warpedGrid/*=nullptr*/)
+{
+  int gridSubdivision = GetGridSubdivision(displayNode);
+
+  // Grid lines only depend on the grid size, reuse them if they have been created already
+  auto gridIt = GridLinesCache.end();
+  for (auto cacheIt = GridLinesCache.begin(); cacheIt != GridLinesCache.end(); ++cacheIt)
+  {
+    if (std::equal(numGridPoints, numGridPoints + 3, cacheIt->NumGridPoints) && cacheIt->GridSubdivision == gridSubdivision)
+    {
+      GridLinesCacheEntry entry = std::move(*cacheIt);
+      GridLinesCache.erase(cacheIt);
+      GridLinesCache.push_front(std::move(entry));
+      gridIt = GridLinesCache.begin();
+      break;
+    }
+  }
+  if (gridIt == GridLinesCache.end())
+  {
+    GridLinesCacheEntry entry;
+    std::copy(numGridPoints, numGridPoints + 3, entry.NumGridPoints);
+    entry.GridSubdivision = gridSubdivision;
+    CreateGridLines(numGridPoints, gridSubdivision, entry.Lines);
+    GridLinesCache.push_front(std::move(entry));
+    if (GridLinesCache.size() > GridLinesCacheMaximumSize)
+    {
+      GridLinesCache.pop_back();
+    }
+    gridIt = GridLinesCache.begin();
+  }
+
+  vtkNew<vtkCellArray> grid;
+  grid->ImportLegacyFormat(gridIt->Lines.data(), static_cast<vtkIdType>(gridIt->Lines.size()));
   gridPolyData->SetLines(grid.GetPointer());
 
   if (warpedGrid)
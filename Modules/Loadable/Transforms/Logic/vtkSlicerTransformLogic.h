@@ -61,9 +61,14 @@ class VTK_SLICER_TRANSFORMS_MODULE_LOGIC_EXPORT vtkSlicerTransformLogic : public
 
   /// Apply the associated transform to the transformable node. Return true
   /// on success, false otherwise.
-  /// This method is kept for backward compatibility only, it is recommended to use
+  /// Non-linear transforms are applied to the points of models and to the voxels
+  /// of volumes in parallel.
+  /// If useBakedTransform is true and the displacement grid of the parent transform
+  /// has been computed by vtkMRMLTransformNode::BakeTransformToWorld() then the grid is
+  /// applied instead of the chain of transforms, which is faster but less accurate.
+  /// Without useBakedTransform, it is recommended to use
   /// vtkMRMLTransformableNode::HardenTransform() method instead.
-  static bool hardenTransform(vtkMRMLTransformableNode* node);
+  static bool hardenTransform(vtkMRMLTransformableNode* node, bool useBakedTransform=false);
 
   ///
   /// Read transform from file
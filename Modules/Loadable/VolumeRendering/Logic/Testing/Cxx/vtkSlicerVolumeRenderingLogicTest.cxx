@@ -29,13 +29,17 @@
 #include <vtkMRMLVolumeNode.h>
 
 // VTK includes
+#include <vtkDoubleArray.h>
 #include <vtkImageData.h>
+#include <vtkMath.h>
 #include <vtkNew.h>
+#include <vtkShortArray.h>
 #include <vtkSmartPointer.h>
 
 //----------------------------------------------------------------------------
 int testDefaultRenderingMethod(const std::string& moduleShareDirectory);
 int testPresets(const std::string &moduleShareDirectory);
+int testComputeScalarRange();
 
 //----------------------------------------------------------------------------
 int vtkSlicerVolumeRenderingLogicTest(int argc, char* argv[])
@@ -49,6 +53,7 @@ int vtkSlicerVolumeRenderingLogicTest(int argc, char* argv[])
 
   CHECK_EXIT_SUCCESS(testDefaultRenderingMethod(moduleShareDirectory));
   CHECK_EXIT_SUCCESS(testPresets(moduleShareDirectory));
+  CHECK_EXIT_SUCCESS(testComputeScalarRange());
   return EXIT_SUCCESS;
 }
 
@@ -106,3 +111,40 @@ int testPresets(const std::string& moduleShareDirectory)
 
   return EXIT_SUCCESS;
 }
+
+//----------------------------------------------------------------------------
+int testComputeScalarRange()
+{
+  double range[2] = { 0.0, 0.0 };
+  CHECK_BOOL(vtkSlicerVolumeRenderingLogic::ComputeScalarRange(nullptr, range), false);
+
+  // Two components, only the first one is used
+  vtkNew<vtkShortArray> scalars;
+  scalars->SetNumberOfComponents(2);
+  scalars->SetNumberOfTuples(1000);
+  for (vtkIdType i = 0; i < 1000; ++i)
+    {
+    scalars->SetComponent(i, 0, static_cast<short>(i - 500));
+    scalars->SetComponent(i, 1, 10000);
+    }
+  CHECK_BOOL(vtkSlicerVolumeRenderingLogic::ComputeScalarRange(scalars, range), true);
+  CHECK_DOUBLE(range[0], -500.0);
+  CHECK_DOUBLE(range[1], 499.0);
+
+  // Every 10th tuple is sampled
+  CHECK_BOOL(vtkSlicerVolumeRenderingLogic::ComputeScalarRange(scalars, range, 100), true);
+  CHECK_DOUBLE(range[0], -500.0);
+  CHECK_DOUBLE(range[1], 490.0);
+
+  // NaN values are ignored
+  vtkNew<vtkDoubleArray> nanScalars;
+  nanScalars->InsertNextValue(vtkMath::Nan());
+  CHECK_BOOL(vtkSlicerVolumeRenderingLogic::ComputeScalarRange(nanScalars, range), false);
+  nanScalars->InsertNextValue(2.5);
+  nanScalars->InsertNextValue(-1.5);
+  CHECK_BOOL(vtkSlicerVolumeRenderingLogic::ComputeScalarRange(nanScalars, range), true);
+  CHECK_DOUBLE(range[0], -1.5);
+  CHECK_DOUBLE(range[1], 2.5);
+
+  return EXIT_SUCCESS;
+}
@@ -27,6 +27,7 @@
 
 // MRML includes
 #include <vtkCacheManager.h>
+#include <vtkEventBroker.h>
 #include <vtkMRMLColorNode.h>
 #include <vtkMRMLLabelMapVolumeDisplayNode.h>
 #include <vtkMRMLScene.h>
@@ -42,13 +43,20 @@
 #include <itksys/SystemTools.hxx>
 
 // VTK includes
+#include <vtkCallbackCommand.h>
 #include <vtkColorTransferFunction.h>
+#include <vtkDataArray.h>
 #include <vtkImageData.h>
 #include <vtkLookupTable.h>
+#include <vtkMath.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPiecewiseFunction.h>
 #include <vtkPointData.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
+#include <vtkVolumeMapper.h>
 #include <vtkVolumeProperty.h>
 
 #if defined(Slicer_VTK_RENDERING_USE_OpenGL_BACKEND)
@@ -58,6 +66,119 @@
 
 // STD includes
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <list>
+#include <thread>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+template <class T>
+bool ComputeScalarRangeTemplate(const T* data, vtkIdType numberOfTuples, int numberOfComponents, vtkIdType step,
+  double range[2])
+{
+  const vtkIdType numberOfSamples = (numberOfTuples + step - 1) / step;
+  const std::array<double, 2> emptyRange = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+  vtkSMPThreadLocal<std::array<double, 2> > localRanges(emptyRange);
+  vtkSMPTools::For(0, numberOfSamples, [&](vtkIdType begin, vtkIdType end)
+    {
+    std::array<double, 2>& localRange = localRanges.Local();
+    for (vtkIdType sample = begin; sample < end; ++sample)
+      {
+      double value = static_cast<double>(data[sample * step * numberOfComponents]);
+      if (vtkMath::IsNan(value))
+        {
+        continue;
+        }
+      localRange[0] = std::min(localRange[0], value);
+      localRange[1] = std::max(localRange[1], value);
+      }
+    });
+  range[0] = emptyRange[0];
+  range[1] = emptyRange[1];
+  for (const std::array<double, 2>& localRange : localRanges)
+    {
+    range[0] = std::min(range[0], localRange[0]);
+    range[1] = std::max(range[1], localRange[1]);
+    }
+  return range[0] <= range[1];
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+class vtkSlicerVolumeRenderingLogic::vtkInternal
+{
+public:
+  /// Display node to update when the exact range is computed
+  struct ScalarRangeUpdate
+  {
+    std::string DisplayNodeID;
+    bool RecommendedProperties;
+    /// The update is skipped if the volume property is modified after the estimated range was applied
+    vtkMTimeType VolumePropertyMTime;
+  };
+
+  /// Exact range computation of an array on a worker thread.
+  /// Only Completed, Success and Range are written by the worker thread.
+  struct ScalarRangeComputation
+  {
+    /// Kept alive until the thread is joined
+    vtkSmartPointer<vtkDataArray> Scalars;
+    vtkMTimeType ScalarsMTime{0};
+    std::thread Thread;
+    std::atomic<bool> Completed{false};
+    bool Success{false};
+    double Range[2] = { 0.0, 0.0 };
+    std::vector<ScalarRangeUpdate> Updates;
+  };
+
+  /// Exact range of an array, valid until the array is modified
+  struct ComputedScalarRange
+  {
+    vtkWeakPointer<vtkDataArray> Scalars;
+    vtkMTimeType ScalarsMTime;
+    double Range[2];
+  };
+
+  void RequestNotification();
+  void JoinThreads();
+
+  /// Elements are not moved, as they are accessed by the worker threads
+  std::list<ScalarRangeComputation> Computations;
+  std::vector<ComputedScalarRange> ComputedRanges;
+  vtkNew<vtkObject> ComputedNotifier;
+  vtkNew<vtkCallbackCommand> ComputedCallbackCommand;
+  std::atomic<bool> NotificationRequested{false};
+};
+
+//----------------------------------------------------------------------------
+void vtkSlicerVolumeRenderingLogic::vtkInternal::RequestNotification()
+{
+  // Notify the main thread once for all the ranges computed until it processes the notification
+  if (!this->NotificationRequested.exchange(true))
+    {
+    if (!vtkEventBroker::GetInstance()->RequestModified(this->ComputedNotifier))
+      {
+      this->NotificationRequested = false;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerVolumeRenderingLogic::vtkInternal::JoinThreads()
+{
+  for (ScalarRangeComputation& computation : this->Computations)
+    {
+    if (computation.Thread.joinable())
+      {
+      computation.Thread.join();
+      }
+    }
+  this->Computations.clear();
+}
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSlicerVolumeRenderingLogic);
@@ -70,6 +191,11 @@ vtkSlicerVolumeRenderingLogic::vtkSlicerVolumeRenderingLogic()
   this->PresetsScene = nullptr;
   this->DefaultROIClassName = "vtkMRMLMarkupsROINode";
 
+  this->Internal = new vtkInternal;
+  this->Internal->ComputedCallbackCommand->SetClientData(this);
+  this->Internal->ComputedCallbackCommand->SetCallback(vtkSlicerVolumeRenderingLogic::ScalarRangeComputedCallback);
+  this->Internal->ComputedNotifier->AddObserver(vtkCommand::ModifiedEvent, this->Internal->ComputedCallbackCommand);
+
   this->RegisterRenderingMethod("VTK CPU Ray Casting",
     "vtkMRMLCPURayCastVolumeRenderingDisplayNode");
   this->RegisterRenderingMethod("VTK GPU Ray Casting",
@@ -90,6 +216,12 @@ vtkSlicerVolumeRenderingLogic::~vtkSlicerVolumeRenderingLogic()
     this->PresetsScene->Delete();
   }
   this->RemoveAllVolumeRenderingDisplayNodes();
+
+  this->Internal->JoinThreads();
+  // The notifier may still be in the modified queue of the application
+  this->Internal->ComputedNotifier->RemoveObserver(this->Internal->ComputedCallbackCommand);
+  this->Internal->ComputedCallbackCommand->SetClientData(nullptr);
+  delete this->Internal;
 }
 
 //----------------------------------------------------------------------------
@@ -101,6 +233,10 @@ void vtkSlicerVolumeRenderingLogic::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << this->DisplayNodes[i]->GetID() << std::endl;
   }
+  os << indent << "ShareGPUVolumeMappers: " << (this->ShareGPUVolumeMappers ? "true" : "false") << std::endl;
+  os << indent << "Number of shared volume mappers: " << this->GetNumberOfSharedVolumeMappers() << std::endl;
+  os << indent << "ScalarRangeSampleSize: " << this->ScalarRangeSampleSize << std::endl;
+  os << indent << "Number of scalar range computations: " << this->Internal->Computations.size() << std::endl;
 #if defined(Slicer_VTK_RENDERING_USE_OpenGL_BACKEND)
   const char *gl_vendor=reinterpret_cast<const char *>(glGetString(GL_VENDOR));
   os << indent << "Vendor: " << gl_vendor << std::endl;
@@ -370,7 +506,65 @@ void vtkSlicerVolumeRenderingLogic::OnMRMLSceneNodeRemoved(vtkMRMLNode* node)
   if (vrDisplayNode)
   {
     this->RemoveVolumeRenderingDisplayNode(vrDisplayNode);
+    if (vrDisplayNode->GetID())
+    {
+      this->SharedVolumeMappers.erase(vrDisplayNode->GetID());
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkVolumeMapper* vtkSlicerVolumeRenderingLogic::GetSharedVolumeMapper(vtkMRMLVolumeRenderingDisplayNode* displayNode)
+{
+  if (!displayNode || !displayNode->GetID())
+  {
+    return nullptr;
+  }
+  auto mapperIt = this->SharedVolumeMappers.find(displayNode->GetID());
+  if (mapperIt == this->SharedVolumeMappers.end())
+  {
+    return nullptr;
   }
+  if (!mapperIt->second)
+  {
+    // all the views that used the mapper have released it
+    this->SharedVolumeMappers.erase(mapperIt);
+    return nullptr;
+  }
+  return mapperIt->second;
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerVolumeRenderingLogic::SetSharedVolumeMapper(vtkMRMLVolumeRenderingDisplayNode* displayNode, vtkVolumeMapper* mapper)
+{
+  if (!displayNode || !displayNode->GetID())
+  {
+    vtkErrorMacro("SetSharedVolumeMapper: Invalid display node");
+    return;
+  }
+  if (!mapper)
+  {
+    this->SharedVolumeMappers.erase(displayNode->GetID());
+    return;
+  }
+  this->SharedVolumeMappers[displayNode->GetID()] = mapper;
+}
+
+//----------------------------------------------------------------------------
+int vtkSlicerVolumeRenderingLogic::GetNumberOfSharedVolumeMappers()
+{
+  for (auto mapperIt = this->SharedVolumeMappers.begin(); mapperIt != this->SharedVolumeMappers.end();)
+  {
+    if (mapperIt->second)
+    {
+      ++mapperIt;
+    }
+    else
+    {
+      mapperIt = this->SharedVolumeMappers.erase(mapperIt);
+    }
+  }
+  return static_cast<int>(this->SharedVolumeMappers.size());
 }
 
 //----------------------------------------------------------------------------
@@ -420,14 +614,12 @@ void vtkSlicerVolumeRenderingLogic::UpdateTranferFunctionRangeFromImage(vtkMRMLV
   //update scalar range
   vtkColorTransferFunction *functionColor = prop->GetRGBTransferFunction();
 
-  vtkDataArray* scalars = input->GetPointData()->GetScalars();
-  if (!scalars)
+  double rangeNew[2];
+  bool approximate = false;
+  if (!this->GetVolumeScalarRange(vspNode, rangeNew, approximate))
   {
     return;
   }
-
-  double rangeNew[2];
-  scalars->GetRange(rangeNew);
   functionColor->AdjustRange(rangeNew);
   vtkDebugMacro("Color range: "<< functionColor->GetRange()[0] << " " << functionColor->GetRange()[1]);
 
@@ -443,6 +635,221 @@ void vtkSlicerVolumeRenderingLogic::UpdateTranferFunctionRangeFromImage(vtkMRMLV
   functionOpacity->RemovePoint(255); //Remove the standard value
   functionOpacity->AdjustRange(rangeNew);
   vtkDebugMacro("Gradient Opacity range: " << functionOpacity->GetRange()[0] << " " << functionOpacity->GetRange()[1]);
+
+  if (approximate)
+  {
+    this->AddScalarRangeUpdate(vspNode, false);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkSlicerVolumeRenderingLogic::ComputeScalarRange(vtkDataArray* scalars, double range[2], vtkIdType numberOfSamples/*=0*/)
+{
+  if (!scalars || !range || scalars->GetNumberOfTuples() == 0)
+  {
+    return false;
+  }
+  vtkIdType numberOfTuples = scalars->GetNumberOfTuples();
+  vtkIdType step = 1;
+  if (numberOfSamples > 0 && numberOfSamples < numberOfTuples)
+  {
+    step = numberOfTuples / numberOfSamples;
+  }
+  if (!scalars->HasStandardMemoryLayout())
+  {
+    // Unusual arrays are read one value at a time
+    range[0] = VTK_DOUBLE_MAX;
+    range[1] = -VTK_DOUBLE_MAX;
+    for (vtkIdType tupleIndex = 0; tupleIndex < numberOfTuples; tupleIndex += step)
+    {
+      double value = scalars->GetComponent(tupleIndex, 0);
+      if (!vtkMath::IsNan(value))
+      {
+        range[0] = std::min(range[0], value);
+        range[1] = std::max(range[1], value);
+      }
+    }
+    return range[0] <= range[1];
+  }
+  bool success = false;
+  switch (scalars->GetDataType())
+  {
+    vtkTemplateMacro(success = ComputeScalarRangeTemplate(static_cast<const VTK_TT*>(scalars->GetVoidPointer(0)),
+      numberOfTuples, scalars->GetNumberOfComponents(), step, range));
+    default:
+      break;
+  }
+  return success;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSlicerVolumeRenderingLogic::GetVolumeScalarRange(vtkMRMLVolumeRenderingDisplayNode* vspNode, double range[2],
+  bool& approximate)
+{
+  approximate = false;
+  vtkMRMLVolumeNode* volumeNode = vspNode ? vspNode->GetVolumeNode() : nullptr;
+  vtkImageData* imageData = volumeNode ? volumeNode->GetImageData() : nullptr;
+  vtkDataArray* scalars = imageData ? imageData->GetPointData()->GetScalars() : nullptr;
+  if (!scalars)
+  {
+    return false;
+  }
+
+  bool asynchronous = this->ScalarRangeSampleSize > 0
+    && scalars->GetNumberOfTuples() > this->ScalarRangeSampleSize
+    && scalars->HasStandardMemoryLayout()
+    && vtkEventBroker::GetInstance()->GetRequestModifiedCallback() != nullptr;
+  if (!asynchronous)
+  {
+    scalars->GetRange(range);
+    return true;
+  }
+
+  // Exact range that was already computed
+  for (const vtkInternal::ComputedScalarRange& computedRange : this->Internal->ComputedRanges)
+  {
+    if (computedRange.Scalars == scalars && computedRange.ScalarsMTime == scalars->GetMTime())
+    {
+      range[0] = computedRange.Range[0];
+      range[1] = computedRange.Range[1];
+      return true;
+    }
+  }
+
+  if (!vtkSlicerVolumeRenderingLogic::ComputeScalarRange(scalars, range, this->ScalarRangeSampleSize))
+  {
+    return false;
+  }
+  approximate = true;
+
+  // Start the exact range computation if it is not in progress yet
+  for (const vtkInternal::ScalarRangeComputation& computation : this->Internal->Computations)
+  {
+    if (computation.Scalars == scalars && computation.ScalarsMTime == scalars->GetMTime())
+    {
+      return true;
+    }
+  }
+  this->Internal->Computations.emplace_back();
+  vtkInternal::ScalarRangeComputation* computation = &this->Internal->Computations.back();
+  computation->Scalars = scalars;
+  computation->ScalarsMTime = scalars->GetMTime();
+  vtkInternal* internal = this->Internal;
+  computation->Thread = std::thread([internal, computation]()
+  {
+    computation->Success = vtkSlicerVolumeRenderingLogic::ComputeScalarRange(computation->Scalars, computation->Range);
+    computation->Completed = true;
+    internal->RequestNotification();
+  });
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerVolumeRenderingLogic::AddScalarRangeUpdate(vtkMRMLVolumeRenderingDisplayNode* vspNode, bool recommendedProperties)
+{
+  vtkMRMLVolumeNode* volumeNode = vspNode ? vspNode->GetVolumeNode() : nullptr;
+  vtkImageData* imageData = volumeNode ? volumeNode->GetImageData() : nullptr;
+  vtkDataArray* scalars = imageData ? imageData->GetPointData()->GetScalars() : nullptr;
+  if (!scalars || !vspNode->GetID() || !vspNode->GetVolumePropertyNode())
+  {
+    return;
+  }
+  for (vtkInternal::ScalarRangeComputation& computation : this->Internal->Computations)
+  {
+    if (computation.Scalars != scalars)
+    {
+      continue;
+    }
+    vtkInternal::ScalarRangeUpdate update;
+    update.DisplayNodeID = vspNode->GetID();
+    update.RecommendedProperties = recommendedProperties;
+    update.VolumePropertyMTime = vspNode->GetVolumePropertyNode()->GetMTime();
+    for (vtkInternal::ScalarRangeUpdate& existingUpdate : computation.Updates)
+    {
+      if (existingUpdate.DisplayNodeID == update.DisplayNodeID)
+      {
+        // The recommended properties include the transfer function range
+        update.RecommendedProperties = update.RecommendedProperties || existingUpdate.RecommendedProperties;
+        existingUpdate = update;
+        return;
+      }
+    }
+    computation.Updates.push_back(update);
+    return;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerVolumeRenderingLogic::ProcessComputedScalarRanges()
+{
+  this->Internal->NotificationRequested = false;
+
+  std::vector<vtkInternal::ScalarRangeUpdate> updates;
+  for (auto computationIt = this->Internal->Computations.begin(); computationIt != this->Internal->Computations.end();)
+  {
+    if (!computationIt->Completed)
+    {
+      ++computationIt;
+      continue;
+    }
+    computationIt->Thread.join();
+    // The range is discarded if the array was modified during the computation
+    if (computationIt->Success && computationIt->Scalars->GetMTime() == computationIt->ScalarsMTime)
+    {
+      vtkInternal::ComputedScalarRange computedRange;
+      computedRange.Scalars = computationIt->Scalars;
+      computedRange.ScalarsMTime = computationIt->ScalarsMTime;
+      computedRange.Range[0] = computationIt->Range[0];
+      computedRange.Range[1] = computationIt->Range[1];
+      this->Internal->ComputedRanges.push_back(computedRange);
+      updates.insert(updates.end(), computationIt->Updates.begin(), computationIt->Updates.end());
+    }
+    computationIt = this->Internal->Computations.erase(computationIt);
+  }
+
+  // Forget the ranges of deleted or modified arrays
+  this->Internal->ComputedRanges.erase(std::remove_if(this->Internal->ComputedRanges.begin(), this->Internal->ComputedRanges.end(),
+    [](const vtkInternal::ComputedScalarRange& computedRange)
+    {
+      return !computedRange.Scalars || computedRange.Scalars->GetMTime() != computedRange.ScalarsMTime;
+    }), this->Internal->ComputedRanges.end());
+
+  vtkMRMLScene* scene = this->GetMRMLScene();
+  if (!scene)
+  {
+    return;
+  }
+  for (const vtkInternal::ScalarRangeUpdate& update : updates)
+  {
+    vtkMRMLVolumeRenderingDisplayNode* vspNode =
+      vtkMRMLVolumeRenderingDisplayNode::SafeDownCast(scene->GetNodeByID(update.DisplayNodeID));
+    if (!vspNode || !vspNode->GetVolumePropertyNode()
+      || vspNode->GetVolumePropertyNode()->GetMTime() != update.VolumePropertyMTime)
+    {
+      // The volume property was modified meanwhile, keep the changes
+      continue;
+    }
+    if (update.RecommendedProperties)
+    {
+      this->SetRecommendedVolumeRenderingProperties(vspNode);
+    }
+    else
+    {
+      this->UpdateTranferFunctionRangeFromImage(vspNode);
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+void vtkSlicerVolumeRenderingLogic::ScalarRangeComputedCallback(vtkObject* vtkNotUsed(caller),
+  unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
+{
+  vtkSlicerVolumeRenderingLogic* self = reinterpret_cast<vtkSlicerVolumeRenderingLogic*>(clientData);
+  if (!self)
+  {
+    return;
+  }
+  self->ProcessComputedScalarRanges();
 }
 
 //----------------------------------------------------------------------------
@@ -1506,9 +1913,6 @@ bool vtkSlicerVolumeRenderingLogic::SetRecommendedVolumeRenderingProperties(vtkM
     return false;
   }
 
-  double* scalarRange = volumeNode->GetImageData()->GetScalarRange();
-  double scalarRangeSize = scalarRange[1] - scalarRange[0];
-
   if (volumeNode->GetImageData()->GetScalarType() == VTK_UNSIGNED_CHAR)
   {
     // 8-bit grayscale image, it is probably ultrasound
@@ -1516,6 +1920,27 @@ bool vtkSlicerVolumeRenderingLogic::SetRecommendedVolumeRenderingProperties(vtkM
     return true;
   }
 
+  double scalarRange[2] = { 0.0, 0.0 };
+  bool approximate = false;
+  if (!this->GetVolumeScalarRange(vspNode, scalarRange, approximate))
+  {
+    return false;
+  }
+  bool recommended = this->SetRecommendedVolumeRenderingPropertiesFromScalarRange(vspNode, scalarRange);
+  if (approximate)
+  {
+    // Detect the volume type again with the exact range
+    this->AddScalarRangeUpdate(vspNode, true);
+  }
+  return recommended;
+}
+
+//---------------------------------------------------------------------------
+bool vtkSlicerVolumeRenderingLogic::SetRecommendedVolumeRenderingPropertiesFromScalarRange(
+  vtkMRMLVolumeRenderingDisplayNode* vspNode, double scalarRange[2])
+{
+  double scalarRangeSize = scalarRange[1] - scalarRange[0];
+
   if (scalarRangeSize > 50.0 && scalarRangeSize < 1500.0 && this->GetPresetByName("MR-Default"))
   {
     // small dynamic range, probably MRI
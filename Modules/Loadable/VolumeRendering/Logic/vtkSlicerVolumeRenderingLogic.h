@@ -36,9 +36,12 @@ class vtkMRMLVolumePropertyNode;
 
 // VTK includes
 class vtkColorTransferFunction;
+class vtkDataArray;
 class vtkPiecewiseFunction;
 class vtkScalarsToColors;
+class vtkVolumeMapper;
 class vtkVolumeProperty;
+#include <vtkWeakPointer.h>
 
 // STD includes
 #include <map>
@@ -138,6 +141,9 @@ public:
   /// The function uses heuristics to detect what kind of volume it is (CT, MRI, other),
   /// based on its intensity range and chooses preset accordingly.
   /// Returns false is volume type could not be detected and so properties are not changed.
+  /// For volumes larger than ScalarRangeSampleSize, the type is first detected from an
+  /// estimated range and detected again when the exact range is computed.
+  /// \sa ScalarRangeSampleSize
   bool SetRecommendedVolumeRenderingProperties(vtkMRMLVolumeRenderingDisplayNode* vrDisplayNode);
 
   /// Applies the properties (window level, threshold and color function) of
@@ -265,8 +271,29 @@ public:
   /// Find the first volume rendering display node that uses the ROI
   vtkMRMLVolumeRenderingDisplayNode* GetFirstVolumeRenderingDisplayNodeByROINode(vtkMRMLNode* roiNode);
 
+  /// Adjust the range of the transfer functions to the scalar range of the volume.
+  /// \sa ScalarRangeSampleSize
   void UpdateTranferFunctionRangeFromImage(vtkMRMLVolumeRenderingDisplayNode* vspNode);
 
+  /// Number of voxels used for estimating the scalar range of large volumes.
+  /// The scalar range of volumes with more voxels is first estimated from this number
+  /// of regularly spaced voxels, and the exact range is computed on a worker thread.
+  /// When it is available, UpdateTranferFunctionRangeFromImage() and
+  /// SetRecommendedVolumeRenderingProperties() are applied again to the display nodes
+  /// whose volume property has not been modified meanwhile.
+  /// The exact range is always computed on the main thread if the application does not
+  /// process requests from other threads (see vtkEventBroker::RequestModified)
+  /// or if ScalarRangeSampleSize is 0.
+  /// Default is 1M voxels.
+  vtkSetClampMacro(ScalarRangeSampleSize, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(ScalarRangeSampleSize, vtkIdType);
+
+  /// Compute the range of the first component of the scalars from \a numberOfSamples
+  /// regularly spaced tuples, or from all the tuples if \a numberOfSamples is 0.
+  /// This method can be called from any thread if the scalars are not modified meanwhile.
+  /// Returns false if the scalars have no valid value.
+  static bool ComputeScalarRange(vtkDataArray* scalars, double range[2], vtkIdType numberOfSamples = 0);
+
   /// Utility function that modifies the ROI node of the display node
   /// to fit the boundaries of the volume node
   /// \sa vtkMRMLVolumeRenderingDisplayNode::GetROINode
@@ -329,6 +356,31 @@ public:
   vtkSetMacro(DefaultROIClassName, std::string);
   vtkGetMacro(DefaultROIClassName, std::string);
 
+  /// If enabled, the GPU ray cast display nodes are rendered in all the 3D views
+  /// by the same volume mapper, so that only one 3D texture of the volume is
+  /// allocated in GPU memory instead of one per view.
+  /// Sharing requires render windows that share their OpenGL context, as in the
+  /// Slicer application (Qt::AA_ShareOpenGLContexts). The texture may need to be
+  /// reloaded when the mapper renders into another render window, therefore
+  /// sharing is meant for volumes that do not fit in GPU memory multiple times.
+  /// Disabled by default.
+  /// \sa GetSharedVolumeMapper
+  vtkSetMacro(ShareGPUVolumeMappers, bool);
+  vtkGetMacro(ShareGPUVolumeMappers, bool);
+  vtkBooleanMacro(ShareGPUVolumeMappers, bool);
+
+  /// Get the volume mapper shared by the views that render the display node.
+  /// Returns nullptr if no view has registered a mapper for the display node.
+  /// The logic does not keep the mappers alive: a mapper is released
+  /// when the last view that renders with it releases it.
+  /// \sa SetSharedVolumeMapper, ShareGPUVolumeMappers
+  vtkVolumeMapper* GetSharedVolumeMapper(vtkMRMLVolumeRenderingDisplayNode* displayNode);
+  /// Register the mapper that other views will use to render the display node.
+  /// \sa GetSharedVolumeMapper
+  void SetSharedVolumeMapper(vtkMRMLVolumeRenderingDisplayNode* displayNode, vtkVolumeMapper* mapper);
+  /// Get the number of display nodes that are currently rendered with a shared mapper.
+  int GetNumberOfSharedVolumeMappers();
+
 protected:
   vtkSlicerVolumeRenderingLogic();
   ~vtkSlicerVolumeRenderingLogic() override;
@@ -346,6 +398,22 @@ protected:
   // Update from
   void UpdateVolumeRenderingDisplayNode(vtkMRMLVolumeRenderingDisplayNode* node);
 
+  /// Get the scalar range of the volume of the display node.
+  /// \a approximate is set to true if the range is estimated while the exact range
+  /// is computed on a worker thread.
+  /// \sa ScalarRangeSampleSize
+  bool GetVolumeScalarRange(vtkMRMLVolumeRenderingDisplayNode* vspNode, double range[2], bool& approximate);
+  /// Update the display node again with the exact range when it is computed.
+  /// \a recommendedProperties selects SetRecommendedVolumeRenderingProperties()
+  /// instead of UpdateTranferFunctionRangeFromImage().
+  void AddScalarRangeUpdate(vtkMRMLVolumeRenderingDisplayNode* vspNode, bool recommendedProperties);
+  /// Choose the preset of SetRecommendedVolumeRenderingProperties() from the scalar range.
+  bool SetRecommendedVolumeRenderingPropertiesFromScalarRange(vtkMRMLVolumeRenderingDisplayNode* vspNode,
+    double scalarRange[2]);
+  /// Apply the exact ranges computed by the worker threads.
+  void ProcessComputedScalarRanges();
+  static void ScalarRangeComputedCallback(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
+
   std::map<std::string, std::string> RenderingMethods;
   /// This property holds the default rendering method to instantiate in
   /// \a CreateVolumeRenderingDisplayNode().
@@ -364,7 +432,17 @@ protected:
   vtkMRMLScene* PresetsScene;
 
   std::string DefaultROIClassName;
+
+  bool ShareGPUVolumeMappers{false};
+  /// Shared volume mappers indexed by display node ID
+  std::map<std::string, vtkWeakPointer<vtkVolumeMapper> > SharedVolumeMappers;
+
+  vtkIdType ScalarRangeSampleSize{1024 * 1024};
+
 private:
+  class vtkInternal;
+  vtkInternal* Internal;
+
   vtkSlicerVolumeRenderingLogic(const vtkSlicerVolumeRenderingLogic&) = delete;
   void operator=(const vtkSlicerVolumeRenderingLogic&) = delete;
 };
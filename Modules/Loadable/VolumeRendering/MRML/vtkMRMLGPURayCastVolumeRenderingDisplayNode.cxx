@@ -41,18 +41,44 @@ void vtkMRMLGPURayCastVolumeRenderingDisplayNode::ReadXMLAttributes(const char**
 {
   this->Superclass::ReadXMLAttributes(atts);
 
-//  vtkMRMLReadXMLBeginMacro(atts);
-//  vtkMRMLReadXMLEndMacro();
+  vtkMRMLReadXMLBeginMacro(atts);
+  vtkMRMLReadXMLBooleanMacro(prefetchSequenceFrames, PrefetchSequenceFrames);
+  vtkMRMLReadXMLBooleanMacro(emptySpaceSkipping, EmptySpaceSkipping);
+  vtkMRMLReadXMLEndMacro();
 }
 
 //----------------------------------------------------------------------------
 void vtkMRMLGPURayCastVolumeRenderingDisplayNode::WriteXML(ostream& of, int nIndent)
 {
   this->Superclass::WriteXML(of, nIndent);
+
+  vtkMRMLWriteXMLBeginMacro(of);
+  vtkMRMLWriteXMLBooleanMacro(prefetchSequenceFrames, PrefetchSequenceFrames);
+  vtkMRMLWriteXMLBooleanMacro(emptySpaceSkipping, EmptySpaceSkipping);
+  vtkMRMLWriteXMLEndMacro();
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLGPURayCastVolumeRenderingDisplayNode::Copy(vtkMRMLNode *anode)
+{
+  int wasModifying = this->StartModify();
+  this->Superclass::Copy(anode);
+
+  vtkMRMLCopyBeginMacro(anode);
+  vtkMRMLCopyBooleanMacro(PrefetchSequenceFrames);
+  vtkMRMLCopyBooleanMacro(EmptySpaceSkipping);
+  vtkMRMLCopyEndMacro();
+
+  this->EndModify(wasModifying);
 }
 
 //----------------------------------------------------------------------------
 void vtkMRMLGPURayCastVolumeRenderingDisplayNode::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+
+  vtkMRMLPrintBeginMacro(os,indent);
+  vtkMRMLPrintBooleanMacro(PrefetchSequenceFrames);
+  vtkMRMLPrintBooleanMacro(EmptySpaceSkipping);
+  vtkMRMLPrintEndMacro();
 }
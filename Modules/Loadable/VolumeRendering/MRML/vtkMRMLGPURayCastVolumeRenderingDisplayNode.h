@@ -44,6 +44,10 @@ public:
   // Write this node's information to a MRML file in XML format.
   void WriteXML(ostream& of, int indent) override;
 
+  // Description:
+  // Copy the node's attributes to this object
+  void Copy(vtkMRMLNode *node) override;
+
   /// Copy node content (excludes basic data, such as name and node references).
   /// \sa vtkMRMLNode::CopyContent
   vtkMRMLCopyContentDefaultMacro(vtkMRMLGPURayCastVolumeRenderingDisplayNode);
@@ -52,11 +56,36 @@ public:
   // Get node XML tag name (like Volume, Model)
   const char* GetNodeTagName() override {return "GPURayCastVolumeRendering";}
 
+  /// If the volume is the proxy node of a sequence browser, keep the textures of
+  /// the recently shown frames and upload the upcoming frames ahead of time, so
+  /// that sequence playback does not wait for texture uploads.
+  /// The number of frames that are kept is limited by the GPU memory size of the view.
+  /// Frames are rendered from the volumes stored in the sequence, therefore
+  /// changes made to the voxels of the proxy node are not displayed.
+  /// Disabled by default.
+  vtkSetMacro(PrefetchSequenceFrames, bool);
+  vtkGetMacro(PrefetchSequenceFrames, bool);
+  vtkBooleanMacro(PrefetchSequenceFrames, bool);
+
+  /// If enabled, the regions of the volume where the scalar opacity is zero
+  /// are not uploaded to the GPU: only the blocks of voxels that are inside the
+  /// bounding box of the voxels with non-zero opacity are uploaded. Voxels are scanned
+  /// again when the opacity transfer function changes, which makes editing the
+  /// transfer function slower. Only used for single component volumes in composite mode.
+  /// Blocks outside the cropping ROI are never uploaded.
+  /// Disabled by default.
+  vtkSetMacro(EmptySpaceSkipping, bool);
+  vtkGetMacro(EmptySpaceSkipping, bool);
+  vtkBooleanMacro(EmptySpaceSkipping, bool);
+
 protected:
   vtkMRMLGPURayCastVolumeRenderingDisplayNode();
   ~vtkMRMLGPURayCastVolumeRenderingDisplayNode() override;
   vtkMRMLGPURayCastVolumeRenderingDisplayNode(const vtkMRMLGPURayCastVolumeRenderingDisplayNode&);
   void operator=(const vtkMRMLGPURayCastVolumeRenderingDisplayNode&);
+
+  bool PrefetchSequenceFrames{false};
+  bool EmptySpaceSkipping{false};
 };
 
 #endif
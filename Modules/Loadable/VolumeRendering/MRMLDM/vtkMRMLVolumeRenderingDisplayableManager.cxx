@@ -28,11 +28,16 @@
 #include "vtkMRMLGPURayCastVolumeRenderingDisplayNode.h"
 #include "vtkMRMLMultiVolumeRenderingDisplayNode.h"
 
+// Sequences includes
+#include "vtkMRMLSequenceBrowserNode.h"
+
 // MRML includes
+#include "vtkMRMLApplicationLogic.h"
 #include "vtkMRMLMarkupsROINode.h"
 #include "vtkMRMLFolderDisplayNode.h"
 #include "vtkMRMLScene.h"
 #include "vtkMRMLScalarVolumeNode.h"
+#include "vtkMRMLSequenceNode.h"
 #include "vtkMRMLTransformNode.h"
 #include "vtkMRMLViewNode.h"
 #include "vtkMRMLVolumePropertyNode.h"
@@ -45,10 +50,12 @@
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkCallbackCommand.h>
+#include <vtkCullerCollection.h>
 #include <vtkFixedPointVolumeRayCastMapper.h>
 #include <vtkGPUVolumeRayCastMapper.h>
 #include <vtkImageAppendComponents.h>
 #include <vtkImageChangeInformation.h>
+#include <vtkImageClip.h>
 #include <vtkImageLuminance.h>
 #include <vtkInteractorStyle.h>
 #include <vtkMatrix4x4.h>
@@ -58,6 +65,8 @@
 #include <vtkRenderWindow.h>
 #include <vtkRenderWindowInteractor.h>
 #include <vtkRenderer.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
 #include <vtkMultiVolume.h>
 #include <vtkVolume.h>
 #include <vtkVolumeProperty.h>
@@ -68,6 +77,12 @@
 #include <vtkTrivialProducer.h> //TODO: Used for workaround. Remove when fixed
 #include <vtkPiecewiseFunction.h> //TODO: Used for workaround. Remove when fixed
 
+// STD includes
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+
 // Register VTK object factory overrides
 #include <vtkAutoInit.h>
 #if defined(Slicer_VTK_RENDERING_USE_OpenGL2_BACKEND)
@@ -81,6 +96,182 @@ VTK_MODULE_INIT(vtkRenderingVolumeOpenGL);
 //---------------------------------------------------------------------------
 vtkStandardNewMacro(vtkMRMLVolumeRenderingDisplayableManager);
 
+namespace
+{
+
+/// Size of the blocks of voxels that are uploaded when the texture is cropped.
+/// Aligning the cropped extent to blocks avoids uploading the texture again
+/// when the ROI or the transfer function changes slightly.
+const int TEXTURE_BLOCK_SIZE = 32;
+
+//---------------------------------------------------------------------------
+/// Get the IJK extent of the volume that contains the ROI.
+bool GetROIExtent(vtkMRMLMarkupsROINode* roiNode, vtkMatrix4x4* ijkToWorldMatrix, const int wholeExtent[6], int extent[6])
+{
+  double bounds[6] = { 0.0, -1.0, 0.0, -1.0, 0.0, -1.0 };
+  roiNode->GetRASBounds(bounds);
+  if (bounds[0] > bounds[1] || bounds[2] > bounds[3] || bounds[4] > bounds[5])
+    {
+    return false;
+    }
+  vtkNew<vtkMatrix4x4> worldToIJKMatrix;
+  vtkMatrix4x4::Invert(ijkToWorldMatrix, worldToIJKMatrix);
+  double ijkBounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  for (int corner = 0; corner < 8; ++corner)
+    {
+    double world[4] = { bounds[corner & 1], bounds[2 + ((corner >> 1) & 1)], bounds[4 + ((corner >> 2) & 1)], 1.0 };
+    double ijk[4] = { 0.0, 0.0, 0.0, 1.0 };
+    worldToIJKMatrix->MultiplyPoint(world, ijk);
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      ijkBounds[axis * 2] = std::min(ijkBounds[axis * 2], ijk[axis]);
+      ijkBounds[axis * 2 + 1] = std::max(ijkBounds[axis * 2 + 1], ijk[axis]);
+      }
+    }
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    int axisMin = static_cast<int>(std::max(floor(ijkBounds[axis * 2]), static_cast<double>(wholeExtent[axis * 2])));
+    int axisMax = static_cast<int>(std::min(ceil(ijkBounds[axis * 2 + 1]), static_cast<double>(wholeExtent[axis * 2 + 1])));
+    // If the ROI does not intersect the volume then nothing is visible, keep a single voxel
+    axisMin = std::min(axisMin, wholeExtent[axis * 2 + 1]);
+    extent[axis * 2] = axisMin;
+    extent[axis * 2 + 1] = std::max(axisMin, axisMax);
+    }
+  return true;
+}
+
+//---------------------------------------------------------------------------
+/// Get the range of scalar values where the opacity may be non-zero.
+/// Returns false if all values may be visible.
+bool GetNonZeroOpacityRange(vtkPiecewiseFunction* opacity, double range[2])
+{
+  int size = opacity ? opacity->GetSize() : 0;
+  int firstNonZero = -1;
+  int lastNonZero = -1;
+  double node[4] = { 0.0, 0.0, 0.0, 0.0 };
+  for (int i = 0; i < size; ++i)
+    {
+    opacity->GetNodeValue(i, node);
+    if (node[1] > 0.0)
+      {
+      if (firstNonZero < 0)
+        {
+        firstNonZero = i;
+        }
+      lastNonZero = i;
+      }
+    }
+  if (firstNonZero < 0)
+    {
+    return false;
+    }
+  // Values are interpolated between the nodes
+  if (firstNonZero > 0)
+    {
+    opacity->GetNodeValue(firstNonZero - 1, node);
+    range[0] = node[0];
+    }
+  else
+    {
+    opacity->GetNodeValue(0, node);
+    range[0] = opacity->GetClamping() ? VTK_DOUBLE_MIN : node[0];
+    }
+  if (lastNonZero < size - 1)
+    {
+    opacity->GetNodeValue(lastNonZero + 1, node);
+    range[1] = node[0];
+    }
+  else
+    {
+    opacity->GetNodeValue(size - 1, node);
+    range[1] = opacity->GetClamping() ? VTK_DOUBLE_MAX : node[0];
+    }
+  return range[0] > VTK_DOUBLE_MIN || range[1] < VTK_DOUBLE_MAX;
+}
+
+//---------------------------------------------------------------------------
+/// Compute the bounding box of the voxels of a single component image
+/// that are within the range, in the search extent.
+/// Returns false if no voxels are in the range.
+template <typename T>
+bool ComputeNonEmptyExtent(vtkImageData* imageData, const T* scalars, const int searchExtent[6], const double range[2],
+  int nonEmptyExtent[6])
+{
+  const int* wholeExtent = imageData->GetExtent();
+  vtkIdType increments[3] = { 0, 0, 0 };
+  imageData->GetIncrements(increments);
+  const std::array<int, 6> emptyExtent = { { VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN, VTK_INT_MAX, VTK_INT_MIN } };
+  vtkSMPThreadLocal< std::array<int, 6> > localExtents(emptyExtent);
+  vtkSMPTools::For(searchExtent[4], searchExtent[5] + 1, [&](int kBegin, int kEnd)
+    {
+    std::array<int, 6>& localExtent = localExtents.Local();
+    for (int k = kBegin; k < kEnd; ++k)
+      {
+      for (int j = searchExtent[2]; j <= searchExtent[3]; ++j)
+        {
+        const T* row = scalars + (k - wholeExtent[4]) * increments[2] + (j - wholeExtent[2]) * increments[1]
+          - wholeExtent[0];
+        int rowMin = VTK_INT_MAX;
+        int rowMax = VTK_INT_MIN;
+        for (int i = searchExtent[0]; i <= searchExtent[1]; ++i)
+          {
+          double value = static_cast<double>(row[i]);
+          if (value >= range[0] && value <= range[1])
+            {
+            rowMin = std::min(rowMin, i);
+            rowMax = i;
+            }
+          }
+        if (rowMin > rowMax)
+          {
+          continue;
+          }
+        localExtent[0] = std::min(localExtent[0], rowMin);
+        localExtent[1] = std::max(localExtent[1], rowMax);
+        localExtent[2] = std::min(localExtent[2], j);
+        localExtent[3] = std::max(localExtent[3], j);
+        localExtent[4] = std::min(localExtent[4], k);
+        localExtent[5] = std::max(localExtent[5], k);
+        }
+      }
+    });
+  std::array<int, 6> extent = emptyExtent;
+  for (const std::array<int, 6>& localExtent : localExtents)
+    {
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      extent[axis * 2] = std::min(extent[axis * 2], localExtent[axis * 2]);
+      extent[axis * 2 + 1] = std::max(extent[axis * 2 + 1], localExtent[axis * 2 + 1]);
+      }
+    }
+  if (extent[0] > extent[1])
+    {
+    return false;
+    }
+  std::copy(extent.begin(), extent.end(), nonEmptyExtent);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+/// Extend the extent by a margin (for interpolation and gradient computation)
+/// and align it to texture blocks.
+void AlignExtentToBlocks(const int extent[6], const int wholeExtent[6], int alignedExtent[6])
+{
+  const int margin = 1;
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    int wholeMin = wholeExtent[axis * 2];
+    int wholeMax = wholeExtent[axis * 2 + 1];
+    int axisMin = std::max(wholeMin, extent[axis * 2] - margin);
+    int axisMax = std::min(wholeMax, extent[axis * 2 + 1] + margin);
+    alignedExtent[axis * 2] = wholeMin + ((axisMin - wholeMin) / TEXTURE_BLOCK_SIZE) * TEXTURE_BLOCK_SIZE;
+    alignedExtent[axis * 2 + 1] = std::min(wholeMax,
+      wholeMin + ((axisMax - wholeMin) / TEXTURE_BLOCK_SIZE + 1) * TEXTURE_BLOCK_SIZE - 1);
+    }
+}
+
+} // end of anonymous namespace
+
 //---------------------------------------------------------------------------
 int vtkMRMLVolumeRenderingDisplayableManager::DefaultGPUMemorySize = 256;
 
@@ -133,11 +324,44 @@ public:
   class PipelineGPU : public Pipeline
   {
   public:
-    PipelineGPU() : Pipeline()
+    PipelineGPU(vtkGPUVolumeRayCastMapper* sharedMapper = nullptr) : Pipeline()
     {
-      this->RayCastMapperGPU = vtkSmartPointer<vtkGPUVolumeRayCastMapper>::New();
+      if (sharedMapper)
+        {
+        this->RayCastMapperGPU = sharedMapper;
+        this->SharedMapper = true;
+        }
+      else
+        {
+        this->RayCastMapperGPU = vtkSmartPointer<vtkGPUVolumeRayCastMapper>::New();
+        }
+      this->TextureClip = vtkSmartPointer<vtkImageClip>::New();
+      this->TextureClip->ClipDataOn();
     }
     vtkSmartPointer<vtkGPUVolumeRayCastMapper> RayCastMapperGPU;
+    /// The mapper is also used by the other 3D views that display the same display node,
+    /// see vtkSlicerVolumeRenderingLogic::GetShareGPUVolumeMappers
+    bool SharedMapper{ false };
+
+    /// Texture ring of sequence frames, most recently used first.
+    /// Each frame is rendered by its own mapper, which keeps the texture of the frame
+    /// in GPU memory, see vtkMRMLGPURayCastVolumeRenderingDisplayNode::PrefetchSequenceFrames
+    struct SequenceFrame
+    {
+      vtkWeakPointer<vtkMRMLVolumeNode> FrameVolumeNode;
+      vtkSmartPointer<vtkGPUVolumeRayCastMapper> Mapper;
+    };
+    std::deque<SequenceFrame> SequenceFrames;
+    /// Actors that upload the textures of the upcoming frames
+    std::vector< vtkSmartPointer<vtkVolume> > PrefetchActors;
+
+    /// Only the blocks of the volume that may be visible are uploaded
+    vtkSmartPointer<vtkImageClip> TextureClip;
+    /// Cached bounding box of the voxels with non-zero opacity
+    vtkMTimeType NonEmptyImageMTime{ 0 };
+    double NonEmptyRange[2]{ 0.0, -1.0 };
+    int NonEmptySearchExtent[6]{ 0, -1, 0, -1, 0, -1 };
+    int NonEmptyExtent[6]{ 0, -1, 0, -1, 0, -1 };
   };
   //-------------------------------------------------------------------------
   class PipelineMultiVolume : public Pipeline
@@ -181,6 +405,53 @@ public:
 
   double GetFramerate();
   vtkIdType GetMaxMemoryInBytes(vtkMRMLVolumeRenderingDisplayNode* displayNode);
+  void UpdateBlendMode(vtkVolumeMapper* mapper, vtkMRMLViewNode* viewNode);
+  void UpdateGPUMapper(vtkGPUVolumeRayCastMapper* gpuMapper, vtkMRMLGPURayCastVolumeRenderingDisplayNode* gpuDisplayNode,
+    vtkMRMLViewNode* viewNode);
+
+  // Shared GPU mappers
+  vtkSlicerVolumeRenderingLogic* GetVolumeRenderingLogic();
+  PipelineGPU* CreatePipelineGPU(vtkMRMLVolumeRenderingDisplayNode* displayNode);
+  /// Shared mappers are configured by the view that renders with them,
+  /// so the settings of this view are applied before its renderer renders.
+  void UpdateSharedMappers();
+  void ObserveRenderer();
+  static void OnRendererStart(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
+  static void OnRendererEnd(vtkObject* caller, unsigned long eid, void* clientData, void* callData);
+
+  // Adaptive quality control
+  /// Returns true if the sampling is adjusted based on the measured rendering time
+  /// (adaptive quality and positive target latency in the view node).
+  bool IsQualityControlled(vtkMRMLViewNode* viewNode);
+  /// Returns true if the render window renders an interactive (low quality) frame
+  bool IsInteractiveRender();
+  /// Scale of the sample distances used for the current frame (1.0 for full quality)
+  double GetQualityScale();
+  /// Apply the sampling of the current frame to the mappers of all visible volumes
+  void UpdateRenderingQuality();
+  /// Adjust the quality scale so that the next interactive frame is rendered in the target latency
+  void UpdateQualityScale();
+  void UpdateCPUMapper(vtkFixedPointVolumeRayCastMapper* cpuMapper, vtkMRMLVolumeRenderingDisplayNode* displayNode,
+    vtkMRMLViewNode* viewNode);
+
+  // Sequence frames
+  vtkMRMLSequenceNode* GetSequenceNode(vtkMRMLVolumeNode* proxyNode, vtkMRMLSequenceBrowserNode*& browserNode);
+  vtkMRMLVolumeNode* GetSequenceFrameVolumeNode(vtkMRMLSequenceBrowserNode* browserNode, vtkMRMLSequenceNode* sequenceNode,
+    int itemNumber);
+  /// Get the mapper of the frame from the texture ring, add the frame to the ring if it is not in it yet.
+  /// Returns true if the frame was already in the ring.
+  bool GetSequenceFrameMapper(PipelineGPU* pipelineGpu, vtkMRMLVolumeNode* frameVolumeNode, int maximumNumberOfFrames,
+    vtkGPUVolumeRayCastMapper*& frameMapper);
+  /// Render the display node with the mapper of the current sequence frame and upload the upcoming frames.
+  /// The pipeline mapper is used if the volume is not a sequence proxy node or prefetching is disabled.
+  void UpdateSequenceFrames(vtkMRMLGPURayCastVolumeRenderingDisplayNode* gpuDisplayNode, vtkGPUVolumeRayCastMapper* gpuMapper);
+  void RemovePrefetchActors(PipelineGPU* pipelineGpu);
+  vtkRenderer* GetPrefetchRenderer();
+
+  /// Get the connection of the part of the image that is uploaded to the GPU:
+  /// blocks outside the cropping ROI or with zero opacity are skipped.
+  vtkAlgorithmOutput* GetCroppedTextureConnection(vtkMRMLGPURayCastVolumeRenderingDisplayNode* gpuDisplayNode,
+    vtkAlgorithmOutput* imageConnection, vtkImageData* imageData, vtkMRMLViewNode* viewNode);
   void UpdateDesiredUpdateRate(vtkMRMLVolumeRenderingDisplayNode* displayNode);
 
   // Observations
@@ -223,6 +494,25 @@ public:
   /// Last picked volume rendering display node ID
   std::string PickedNodeID;
 
+  /// Renderer observed for applying the view settings to shared mappers
+  vtkWeakPointer<vtkRenderer> ObservedRenderer;
+  vtkSmartPointer<vtkCallbackCommand> RendererStartCallback;
+  vtkSmartPointer<vtkCallbackCommand> RendererEndCallback;
+
+  /// Multiplier of the sample distances of interactive frames, computed from the rendering time
+  /// of the previous interactive frames. The image sample distance is limited to MaximumImageSampleDistance.
+  double QualityScale{1.0};
+  /// Set before each render of the view, true if the frame is rendered during interaction
+  bool InteractiveRender{false};
+  static constexpr double MaximumQualityScale = 8.0;
+  static constexpr double MaximumImageSampleDistance = 4.0;
+
+  /// Renderer of a few pixels, drawn on top of the view without clearing it,
+  /// that renders the upcoming sequence frames with a transparent volume property
+  /// so that their textures are uploaded before they are displayed.
+  vtkSmartPointer<vtkRenderer> PrefetchRenderer;
+  vtkSmartPointer<vtkVolumeProperty> PrefetchVolumeProperty;
+
 private:
   /// Multi-volume actor using a common mapper for rendering the multiple volumes
   vtkSmartPointer<vtkMultiVolume> MultiVolumeActor;
@@ -282,6 +572,13 @@ vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::vtkInternal(vtkMRMLVolume
 
   this->VolumePicker = vtkSmartPointer<vtkVolumePicker>::New();
   this->VolumePicker->SetTolerance(0.005);
+
+  this->RendererStartCallback = vtkSmartPointer<vtkCallbackCommand>::New();
+  this->RendererStartCallback->SetClientData(this);
+  this->RendererStartCallback->SetCallback(vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::OnRendererStart);
+  this->RendererEndCallback = vtkSmartPointer<vtkCallbackCommand>::New();
+  this->RendererEndCallback->SetClientData(this);
+  this->RendererEndCallback->SetCallback(vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::OnRendererEnd);
 }
 
 //---------------------------------------------------------------------------
@@ -289,6 +586,16 @@ vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::~vtkInternal()
 {
   this->ClearDisplayableNodes();
 
+  if (this->ObservedRenderer)
+    {
+    this->ObservedRenderer->RemoveObserver(this->RendererStartCallback);
+    this->ObservedRenderer->RemoveObserver(this->RendererEndCallback);
+    }
+  if (this->PrefetchRenderer && this->PrefetchRenderer->GetRenderWindow())
+    {
+    this->PrefetchRenderer->GetRenderWindow()->RemoveRenderer(this->PrefetchRenderer);
+    }
+
   if (this->DisplayObservedEvents)
     {
     this->DisplayObservedEvents->Delete();
@@ -543,7 +850,7 @@ void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::AddDisplayNode(vtkMR
     }
   else if (displayNode->IsA("vtkMRMLGPURayCastVolumeRenderingDisplayNode"))
     {
-    PipelineGPU* pipelineGpu = new PipelineGPU();
+    PipelineGPU* pipelineGpu = this->CreatePipelineGPU(displayNode);
     pipelineGpu->DisplayNode = displayNode;
     // Set volume to the mapper
     // Reconnection is expensive operation, therefore only do it if needed
@@ -641,6 +948,12 @@ vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::RemovePipelineIt(Pipeline
       this->External->GetRenderer()->RemoveVolume(pipeline->VolumeActor);
       }
 
+    PipelineGPU* pipelineGpu = dynamic_cast<PipelineGPU*>(pipeline);
+    if (pipelineGpu)
+      {
+      this->RemovePrefetchActors(pipelineGpu);
+      }
+
     PipelineMultiVolume* pipelineMulti = dynamic_cast<PipelineMultiVolume*>(pipeline);
     if (pipelineMulti)
       {
@@ -891,28 +1204,7 @@ void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateDisplayNodePip
   if (displayNode->IsA("vtkMRMLCPURayCastVolumeRenderingDisplayNode"))
     {
     vtkFixedPointVolumeRayCastMapper* cpuMapper = vtkFixedPointVolumeRayCastMapper::SafeDownCast(mapper);
-
-    switch (viewNode->GetVolumeRenderingQuality())
-      {
-      case vtkMRMLViewNode::Adaptive:
-        cpuMapper->SetAutoAdjustSampleDistances(true);
-        cpuMapper->SetLockSampleDistanceToInputSpacing(false);
-        cpuMapper->SetImageSampleDistance(1.0);
-        break;
-      case vtkMRMLViewNode::Normal:
-        cpuMapper->SetAutoAdjustSampleDistances(false);
-        cpuMapper->SetLockSampleDistanceToInputSpacing(true);
-        cpuMapper->SetImageSampleDistance(1.0);
-        break;
-      case vtkMRMLViewNode::Maximum:
-        cpuMapper->SetAutoAdjustSampleDistances(false);
-        cpuMapper->SetLockSampleDistanceToInputSpacing(false);
-        cpuMapper->SetImageSampleDistance(0.5);
-        break;
-      }
-
-    cpuMapper->SetSampleDistance(displayNode->GetSampleDistance());
-    cpuMapper->SetInteractiveSampleDistance(displayNode->GetSampleDistance());
+    this->UpdateCPUMapper(cpuMapper, displayNode, viewNode);
 
     // Make sure the correct mapper is set to the volume
     pipeline->VolumeActor->SetMapper(mapper);
@@ -932,31 +1224,12 @@ void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateDisplayNodePip
     vtkMRMLGPURayCastVolumeRenderingDisplayNode* gpuDisplayNode =
       vtkMRMLGPURayCastVolumeRenderingDisplayNode::SafeDownCast(displayNode);
     vtkGPUVolumeRayCastMapper* gpuMapper = vtkGPUVolumeRayCastMapper::SafeDownCast(mapper);
-
-    switch (viewNode->GetVolumeRenderingQuality())
-      {
-      case vtkMRMLViewNode::Adaptive:
-        gpuMapper->SetAutoAdjustSampleDistances(true);
-        gpuMapper->SetLockSampleDistanceToInputSpacing(false);
-        gpuMapper->SetUseJittering(viewNode->GetVolumeRenderingSurfaceSmoothing());
-        break;
-      case vtkMRMLViewNode::Normal:
-        gpuMapper->SetAutoAdjustSampleDistances(false);
-        gpuMapper->SetLockSampleDistanceToInputSpacing(true);
-        gpuMapper->SetUseJittering(viewNode->GetVolumeRenderingSurfaceSmoothing());
-        break;
-      case vtkMRMLViewNode::Maximum:
-        gpuMapper->SetAutoAdjustSampleDistances(false);
-        gpuMapper->SetLockSampleDistanceToInputSpacing(false);
-        gpuMapper->SetUseJittering(viewNode->GetVolumeRenderingSurfaceSmoothing());
-        break;
-      }
-
-    gpuMapper->SetSampleDistance(gpuDisplayNode->GetSampleDistance());
-    gpuMapper->SetMaxMemoryInBytes(this->GetMaxMemoryInBytes(gpuDisplayNode));
+    this->UpdateGPUMapper(gpuMapper, gpuDisplayNode, viewNode);
 
     // Make sure the correct mapper is set to the volume
     pipeline->VolumeActor->SetMapper(mapper);
+    // Only upload the parts of the volume that may be visible
+    imageConnection = this->GetCroppedTextureConnection(gpuDisplayNode, imageConnection, imageData, viewNode);
     // Make sure the correct volume is set to the mapper
     // Reconnection is expensive operation, therefore only do it if needed
     if (mapper->GetInputConnection(0, 0) != imageConnection)
@@ -1001,23 +1274,24 @@ void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateDisplayNodePip
     }
 
   // Set ray casting technique
-  switch (viewNode->GetRaycastTechnique())
+  this->UpdateBlendMode(mapper, viewNode);
+
+  if (this->IsQualityControlled(viewNode))
     {
-    case vtkMRMLViewNode::MaximumIntensityProjection:
-      mapper->SetBlendMode(vtkVolumeMapper::MAXIMUM_INTENSITY_BLEND);
-      break;
-    case vtkMRMLViewNode::MinimumIntensityProjection:
-      mapper->SetBlendMode(vtkVolumeMapper::MINIMUM_INTENSITY_BLEND);
-      break;
-    case vtkMRMLViewNode::Composite:
-    default:
-      mapper->SetBlendMode(vtkVolumeMapper::COMPOSITE_BLEND);
-      break;
+    // Sampling is adjusted before each render
+    this->ObserveRenderer();
     }
 
   // Update ROI clipping planes
   this->UpdatePipelineROIs(displayNode, pipeline);
 
+  if (displayNode->IsA("vtkMRMLGPURayCastVolumeRenderingDisplayNode"))
+    {
+    // Sequence frames are rendered by their own mappers
+    this->UpdateSequenceFrames(vtkMRMLGPURayCastVolumeRenderingDisplayNode::SafeDownCast(displayNode),
+      vtkGPUVolumeRayCastMapper::SafeDownCast(mapper));
+    }
+
   // Set volume property
   vtkVolumeProperty* volumeProperty = displayNode->GetVolumePropertyNode() ? displayNode->GetVolumePropertyNode()->GetVolumeProperty() : nullptr;
   if (volumeProperty)
@@ -1045,6 +1319,578 @@ void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateDisplayNodePip
   this->UpdateDesiredUpdateRate(displayNode);
 }
 
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateBlendMode(vtkVolumeMapper* mapper, vtkMRMLViewNode* viewNode)
+{
+  switch (viewNode->GetRaycastTechnique())
+    {
+    case vtkMRMLViewNode::MaximumIntensityProjection:
+      mapper->SetBlendMode(vtkVolumeMapper::MAXIMUM_INTENSITY_BLEND);
+      break;
+    case vtkMRMLViewNode::MinimumIntensityProjection:
+      mapper->SetBlendMode(vtkVolumeMapper::MINIMUM_INTENSITY_BLEND);
+      break;
+    case vtkMRMLViewNode::Composite:
+    default:
+      mapper->SetBlendMode(vtkVolumeMapper::COMPOSITE_BLEND);
+      break;
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateGPUMapper(vtkGPUVolumeRayCastMapper* gpuMapper,
+  vtkMRMLGPURayCastVolumeRenderingDisplayNode* gpuDisplayNode, vtkMRMLViewNode* viewNode)
+{
+  switch (viewNode->GetVolumeRenderingQuality())
+    {
+    case vtkMRMLViewNode::Adaptive:
+      // The sampling is either adjusted by VTK to reach the desired update rate
+      // or by this displayable manager to reach the target latency
+      gpuMapper->SetAutoAdjustSampleDistances(!this->IsQualityControlled(viewNode));
+      gpuMapper->SetLockSampleDistanceToInputSpacing(false);
+      gpuMapper->SetUseJittering(viewNode->GetVolumeRenderingSurfaceSmoothing());
+      break;
+    case vtkMRMLViewNode::Normal:
+      gpuMapper->SetAutoAdjustSampleDistances(false);
+      gpuMapper->SetLockSampleDistanceToInputSpacing(true);
+      gpuMapper->SetUseJittering(viewNode->GetVolumeRenderingSurfaceSmoothing());
+      break;
+    case vtkMRMLViewNode::Maximum:
+      gpuMapper->SetAutoAdjustSampleDistances(false);
+      gpuMapper->SetLockSampleDistanceToInputSpacing(false);
+      gpuMapper->SetUseJittering(viewNode->GetVolumeRenderingSurfaceSmoothing());
+      break;
+    }
+
+  double qualityScale = (this->IsQualityControlled(viewNode) ? this->GetQualityScale() : 1.0);
+  if (!gpuMapper->GetAutoAdjustSampleDistances())
+    {
+    gpuMapper->SetImageSampleDistance(std::min(qualityScale, MaximumImageSampleDistance));
+    }
+  gpuMapper->SetSampleDistance(gpuDisplayNode->GetSampleDistance() * qualityScale);
+  gpuMapper->SetMaxMemoryInBytes(this->GetMaxMemoryInBytes(gpuDisplayNode));
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateCPUMapper(vtkFixedPointVolumeRayCastMapper* cpuMapper,
+  vtkMRMLVolumeRenderingDisplayNode* displayNode, vtkMRMLViewNode* viewNode)
+{
+  double qualityScale = 1.0;
+  switch (viewNode->GetVolumeRenderingQuality())
+    {
+    case vtkMRMLViewNode::Adaptive:
+      if (this->IsQualityControlled(viewNode))
+        {
+        qualityScale = this->GetQualityScale();
+        cpuMapper->SetAutoAdjustSampleDistances(false);
+        cpuMapper->SetImageSampleDistance(std::min(qualityScale, MaximumImageSampleDistance));
+        }
+      else
+        {
+        cpuMapper->SetAutoAdjustSampleDistances(true);
+        cpuMapper->SetImageSampleDistance(1.0);
+        }
+      cpuMapper->SetLockSampleDistanceToInputSpacing(false);
+      break;
+    case vtkMRMLViewNode::Normal:
+      cpuMapper->SetAutoAdjustSampleDistances(false);
+      cpuMapper->SetLockSampleDistanceToInputSpacing(true);
+      cpuMapper->SetImageSampleDistance(1.0);
+      break;
+    case vtkMRMLViewNode::Maximum:
+      cpuMapper->SetAutoAdjustSampleDistances(false);
+      cpuMapper->SetLockSampleDistanceToInputSpacing(false);
+      cpuMapper->SetImageSampleDistance(0.5);
+      break;
+    }
+
+  cpuMapper->SetSampleDistance(displayNode->GetSampleDistance() * qualityScale);
+  cpuMapper->SetInteractiveSampleDistance(displayNode->GetSampleDistance() * qualityScale);
+}
+
+//---------------------------------------------------------------------------
+vtkSlicerVolumeRenderingLogic* vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::GetVolumeRenderingLogic()
+{
+  vtkMRMLApplicationLogic* appLogic = this->External->GetMRMLApplicationLogic();
+  if (!appLogic)
+    {
+    return nullptr;
+    }
+  return vtkSlicerVolumeRenderingLogic::SafeDownCast(appLogic->GetModuleLogic("VolumeRendering"));
+}
+
+//---------------------------------------------------------------------------
+vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::PipelineGPU*
+vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::CreatePipelineGPU(vtkMRMLVolumeRenderingDisplayNode* displayNode)
+{
+  vtkSlicerVolumeRenderingLogic* logic = this->GetVolumeRenderingLogic();
+  vtkMRMLVolumeNode* volumeNode = displayNode->GetVolumeNode();
+  vtkImageData* imageData = volumeNode ? volumeNode->GetImageData() : nullptr;
+  // The alpha channel of RGB volumes is computed by each pipeline,
+  // therefore the mapper would be reconnected in each view
+  bool rgbVolume = (imageData && imageData->GetNumberOfScalarComponents() == 3);
+  if (!logic || !logic->GetShareGPUVolumeMappers() || rgbVolume)
+    {
+    return new PipelineGPU();
+    }
+
+  vtkGPUVolumeRayCastMapper* sharedMapper = vtkGPUVolumeRayCastMapper::SafeDownCast(logic->GetSharedVolumeMapper(displayNode));
+  PipelineGPU* pipelineGpu = new PipelineGPU(sharedMapper);
+  if (!sharedMapper)
+    {
+    // First view that displays the node, other views will use its mapper
+    pipelineGpu->SharedMapper = true;
+    logic->SetSharedVolumeMapper(displayNode, pipelineGpu->RayCastMapperGPU);
+    }
+
+  this->ObserveRenderer();
+  return pipelineGpu;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::ObserveRenderer()
+{
+  vtkRenderer* renderer = this->External->GetRenderer();
+  if (!renderer || this->ObservedRenderer == renderer)
+    {
+    return;
+    }
+  if (this->ObservedRenderer)
+    {
+    this->ObservedRenderer->RemoveObserver(this->RendererStartCallback);
+    this->ObservedRenderer->RemoveObserver(this->RendererEndCallback);
+    }
+  renderer->AddObserver(vtkCommand::StartEvent, this->RendererStartCallback);
+  renderer->AddObserver(vtkCommand::EndEvent, this->RendererEndCallback);
+  this->ObservedRenderer = renderer;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateSharedMappers()
+{
+  vtkMRMLViewNode* viewNode = this->External->GetMRMLViewNode();
+  if (!viewNode)
+    {
+    return;
+    }
+  for (Pipeline* pipeline : this->DisplayPipelines)
+    {
+    PipelineGPU* pipelineGpu = dynamic_cast<PipelineGPU*>(pipeline);
+    if (!pipelineGpu || !pipelineGpu->SharedMapper || !pipelineGpu->VolumeActor->GetVisibility())
+      {
+      continue;
+      }
+    vtkMRMLGPURayCastVolumeRenderingDisplayNode* gpuDisplayNode =
+      vtkMRMLGPURayCastVolumeRenderingDisplayNode::SafeDownCast(pipelineGpu->DisplayNode);
+    if (!gpuDisplayNode)
+      {
+      continue;
+      }
+    this->UpdateGPUMapper(pipelineGpu->RayCastMapperGPU, gpuDisplayNode, viewNode);
+    this->UpdateBlendMode(pipelineGpu->RayCastMapperGPU, viewNode);
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::OnRendererStart(
+  vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
+{
+  vtkMRMLVolumeRenderingDisplayableManager::vtkInternal* self =
+    reinterpret_cast<vtkMRMLVolumeRenderingDisplayableManager::vtkInternal*>(clientData);
+  self->InteractiveRender = self->IsInteractiveRender();
+  if (self->IsQualityControlled(self->External->GetMRMLViewNode()))
+    {
+    self->UpdateRenderingQuality();
+    }
+  self->UpdateSharedMappers();
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::OnRendererEnd(
+  vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
+{
+  vtkMRMLVolumeRenderingDisplayableManager::vtkInternal* self =
+    reinterpret_cast<vtkMRMLVolumeRenderingDisplayableManager::vtkInternal*>(clientData);
+  self->UpdateQualityScale();
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::IsQualityControlled(vtkMRMLViewNode* viewNode)
+{
+  return viewNode
+    && viewNode->GetVolumeRenderingQuality() == vtkMRMLViewNode::Adaptive
+    && viewNode->GetVolumeRenderingTargetLatency() > 0.0;
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::IsInteractiveRender()
+{
+  if (this->Interaction > 0)
+    {
+    return true;
+    }
+  // Interactor styles increase the desired update rate of the render window during interaction,
+  // and render a still frame when the interaction ends
+  vtkRenderWindow* renderWindow = this->External->GetRenderer() ? this->External->GetRenderer()->GetRenderWindow() : nullptr;
+  vtkRenderWindowInteractor* renderWindowInteractor = renderWindow ? renderWindow->GetInteractor() : nullptr;
+  if (!renderWindowInteractor)
+    {
+    return false;
+    }
+  return renderWindow->GetDesiredUpdateRate() > renderWindowInteractor->GetStillUpdateRate();
+}
+
+//---------------------------------------------------------------------------
+double vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::GetQualityScale()
+{
+  return (this->InteractiveRender ? this->QualityScale : 1.0);
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateRenderingQuality()
+{
+  vtkMRMLViewNode* viewNode = this->External->GetMRMLViewNode();
+  if (!viewNode)
+    {
+    return;
+    }
+  for (Pipeline* pipeline : this->DisplayPipelines)
+    {
+    if (!pipeline->VolumeActor->GetVisibility())
+      {
+      continue;
+      }
+    // The actor mapper is used to also update the mappers of sequence frames
+    vtkVolumeMapper* mapper = pipeline->VolumeActor->GetMapper();
+    vtkMRMLGPURayCastVolumeRenderingDisplayNode* gpuDisplayNode =
+      vtkMRMLGPURayCastVolumeRenderingDisplayNode::SafeDownCast(pipeline->DisplayNode);
+    vtkGPUVolumeRayCastMapper* gpuMapper = vtkGPUVolumeRayCastMapper::SafeDownCast(mapper);
+    vtkFixedPointVolumeRayCastMapper* cpuMapper = vtkFixedPointVolumeRayCastMapper::SafeDownCast(mapper);
+    if (gpuDisplayNode && gpuMapper)
+      {
+      this->UpdateGPUMapper(gpuMapper, gpuDisplayNode, viewNode);
+      }
+    else if (cpuMapper && pipeline->DisplayNode)
+      {
+      this->UpdateCPUMapper(cpuMapper, pipeline->DisplayNode, viewNode);
+      }
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateQualityScale()
+{
+  vtkMRMLViewNode* viewNode = this->External->GetMRMLViewNode();
+  if (!this->InteractiveRender || !this->IsQualityControlled(viewNode))
+    {
+    return;
+    }
+  double renderTime = this->External->GetRenderer()->GetLastRenderTimeInSeconds();
+  double targetTime = viewNode->GetVolumeRenderingTargetLatency() / 1000.0;
+  if (renderTime <= 0.0)
+    {
+    return;
+    }
+  // The rendering time is roughly proportional to the number of samples along the rays
+  // and to the number of rays, i.e., to the third power of the scale of the sample distances.
+  // The correction is halved to avoid oscillating between low and high quality.
+  double correction = std::pow(renderTime / targetTime, 1.0 / 3.0);
+  double qualityScale = this->QualityScale * (0.5 + 0.5 * correction);
+  this->QualityScale = std::max(1.0, std::min(qualityScale, MaximumQualityScale));
+}
+
+//---------------------------------------------------------------------------
+vtkMRMLSequenceNode* vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::GetSequenceNode(
+  vtkMRMLVolumeNode* proxyNode, vtkMRMLSequenceBrowserNode*& browserNode)
+{
+  browserNode = nullptr;
+  vtkMRMLScene* scene = this->External->GetMRMLScene();
+  if (!scene || !proxyNode)
+    {
+    return nullptr;
+    }
+  std::vector<vtkMRMLNode*> browserNodes;
+  scene->GetNodesByClass("vtkMRMLSequenceBrowserNode", browserNodes);
+  for (vtkMRMLNode* node : browserNodes)
+    {
+    vtkMRMLSequenceBrowserNode* currentBrowserNode = vtkMRMLSequenceBrowserNode::SafeDownCast(node);
+    vtkMRMLSequenceNode* sequenceNode = currentBrowserNode ? currentBrowserNode->GetSequenceNode(proxyNode) : nullptr;
+    if (sequenceNode)
+      {
+      browserNode = currentBrowserNode;
+      return sequenceNode;
+      }
+    }
+  return nullptr;
+}
+
+//---------------------------------------------------------------------------
+vtkMRMLVolumeNode* vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::GetSequenceFrameVolumeNode(
+  vtkMRMLSequenceBrowserNode* browserNode, vtkMRMLSequenceNode* sequenceNode, int itemNumber)
+{
+  vtkMRMLSequenceNode* masterSequenceNode = browserNode->GetMasterSequenceNode();
+  if (!masterSequenceNode || itemNumber < 0 || itemNumber >= masterSequenceNode->GetNumberOfDataNodes())
+    {
+    return nullptr;
+    }
+  if (sequenceNode == masterSequenceNode)
+    {
+    return vtkMRMLVolumeNode::SafeDownCast(sequenceNode->GetNthDataNode(itemNumber));
+    }
+  // Synchronized sequence, same lookup as when the proxy node is updated
+  std::string indexValue = masterSequenceNode->GetNthIndexValue(itemNumber);
+  return vtkMRMLVolumeNode::SafeDownCast(sequenceNode->GetDataNodeAtValue(indexValue, /* exactMatchRequired= */ false));
+}
+
+//---------------------------------------------------------------------------
+bool vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::GetSequenceFrameMapper(PipelineGPU* pipelineGpu,
+  vtkMRMLVolumeNode* frameVolumeNode, int maximumNumberOfFrames, vtkGPUVolumeRayCastMapper*& frameMapper)
+{
+  for (auto frameIt = pipelineGpu->SequenceFrames.begin(); frameIt != pipelineGpu->SequenceFrames.end(); ++frameIt)
+    {
+    if (frameIt->FrameVolumeNode != frameVolumeNode)
+      {
+      continue;
+      }
+    // Move to the front of the ring
+    PipelineGPU::SequenceFrame frame = *frameIt;
+    pipelineGpu->SequenceFrames.erase(frameIt);
+    pipelineGpu->SequenceFrames.push_front(frame);
+    frameMapper = frame.Mapper;
+    if (frameMapper->GetInput() != frameVolumeNode->GetImageData())
+      {
+      // image data of the sequence item has been replaced
+      frameMapper->SetInputData(frameVolumeNode->GetImageData());
+      }
+    return true;
+    }
+
+  PipelineGPU::SequenceFrame frame;
+  frame.FrameVolumeNode = frameVolumeNode;
+  frame.Mapper = vtkSmartPointer<vtkGPUVolumeRayCastMapper>::New();
+  frame.Mapper->SetInputData(frameVolumeNode->GetImageData());
+  pipelineGpu->SequenceFrames.push_front(frame);
+  // Release the textures of the least recently used frames
+  while (static_cast<int>(pipelineGpu->SequenceFrames.size()) > maximumNumberOfFrames)
+    {
+    pipelineGpu->SequenceFrames.pop_back();
+    }
+  frameMapper = frame.Mapper;
+  return false;
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdateSequenceFrames(
+  vtkMRMLGPURayCastVolumeRenderingDisplayNode* gpuDisplayNode, vtkGPUVolumeRayCastMapper* gpuMapper)
+{
+  PipelineGPU* pipelineGpu = dynamic_cast<PipelineGPU*>(this->GetPipeline(gpuDisplayNode));
+  if (!pipelineGpu)
+    {
+    return;
+    }
+  this->RemovePrefetchActors(pipelineGpu);
+
+  vtkMRMLVolumeNode* volumeNode = gpuDisplayNode->GetVolumeNode();
+  vtkMRMLSequenceBrowserNode* browserNode = nullptr;
+  vtkMRMLSequenceNode* sequenceNode = nullptr;
+  vtkMRMLVolumeNode* frameVolumeNode = nullptr;
+  if (gpuDisplayNode->GetPrefetchSequenceFrames() && !pipelineGpu->SharedMapper)
+    {
+    sequenceNode = this->GetSequenceNode(volumeNode, browserNode);
+    }
+  if (sequenceNode)
+    {
+    frameVolumeNode = this->GetSequenceFrameVolumeNode(browserNode, sequenceNode, browserNode->GetSelectedItemNumber());
+    }
+  vtkImageData* frameImageData = frameVolumeNode ? frameVolumeNode->GetImageData() : nullptr;
+  if (!frameImageData || frameImageData->GetNumberOfScalarComponents() == 3)
+    {
+    // Not a sequence frame (or an RGB frame, which needs the alpha channel computed by the pipeline)
+    pipelineGpu->SequenceFrames.clear();
+    return;
+    }
+
+  // Number of frames that fit in the GPU memory of the view
+  vtkIdType frameSizeInBytes = std::max(vtkIdType(1), static_cast<vtkIdType>(frameImageData->GetNumberOfPoints())
+    * frameImageData->GetNumberOfScalarComponents() * frameImageData->GetScalarSize());
+  int maximumNumberOfFrames = static_cast<int>(std::min(vtkIdType(VTK_INT_MAX),
+    this->GetMaxMemoryInBytes(gpuDisplayNode) / frameSizeInBytes));
+  maximumNumberOfFrames = std::max(maximumNumberOfFrames, 2);
+
+  vtkGPUVolumeRayCastMapper* frameMapper = nullptr;
+  this->GetSequenceFrameMapper(pipelineGpu, frameVolumeNode, maximumNumberOfFrames, frameMapper);
+  vtkMRMLViewNode* viewNode = this->External->GetMRMLViewNode();
+  this->UpdateGPUMapper(frameMapper, gpuDisplayNode, viewNode);
+  this->UpdateBlendMode(frameMapper, viewNode);
+  frameMapper->SetClippingPlanes(gpuMapper->GetClippingPlanes());
+  pipelineGpu->VolumeActor->SetMapper(frameMapper);
+
+  // Upload the upcoming frames, without evicting the current frame from the ring
+  const int numberOfFramesToPrefetch = std::min(2, maximumNumberOfFrames - 1);
+  int numberOfItems = browserNode->GetNumberOfItems();
+  int itemNumber = browserNode->GetSelectedItemNumber();
+  for (int prefetchIndex = 1; prefetchIndex <= numberOfFramesToPrefetch; ++prefetchIndex)
+    {
+    int prefetchItemNumber = itemNumber + prefetchIndex;
+    if (prefetchItemNumber >= numberOfItems)
+      {
+      if (!browserNode->GetPlaybackLooped())
+        {
+        break;
+        }
+      prefetchItemNumber %= numberOfItems;
+      }
+    vtkMRMLVolumeNode* prefetchVolumeNode = this->GetSequenceFrameVolumeNode(browserNode, sequenceNode, prefetchItemNumber);
+    if (!prefetchVolumeNode || prefetchVolumeNode == frameVolumeNode || !prefetchVolumeNode->GetImageData())
+      {
+      continue;
+      }
+    vtkGPUVolumeRayCastMapper* prefetchMapper = nullptr;
+    if (this->GetSequenceFrameMapper(pipelineGpu, prefetchVolumeNode, maximumNumberOfFrames, prefetchMapper))
+      {
+      // already uploaded
+      continue;
+      }
+    vtkNew<vtkVolume> prefetchActor;
+    prefetchActor->SetMapper(prefetchMapper);
+    prefetchActor->SetProperty(this->PrefetchVolumeProperty);
+    this->GetPrefetchRenderer()->AddVolume(prefetchActor);
+    pipelineGpu->PrefetchActors.emplace_back(prefetchActor.GetPointer());
+    }
+  // The current frame is used most recently
+  this->GetSequenceFrameMapper(pipelineGpu, frameVolumeNode, maximumNumberOfFrames, frameMapper);
+  if (!pipelineGpu->PrefetchActors.empty())
+    {
+    this->GetPrefetchRenderer()->ResetCamera();
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::RemovePrefetchActors(PipelineGPU* pipelineGpu)
+{
+  if (this->PrefetchRenderer)
+    {
+    for (vtkVolume* prefetchActor : pipelineGpu->PrefetchActors)
+      {
+      this->PrefetchRenderer->RemoveVolume(prefetchActor);
+      }
+    }
+  pipelineGpu->PrefetchActors.clear();
+}
+
+//---------------------------------------------------------------------------
+vtkRenderer* vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::GetPrefetchRenderer()
+{
+  if (this->PrefetchRenderer)
+    {
+    return this->PrefetchRenderer;
+    }
+  this->PrefetchRenderer = vtkSmartPointer<vtkRenderer>::New();
+  this->PrefetchRenderer->SetViewport(0.0, 0.0, 0.01, 0.01);
+  this->PrefetchRenderer->PreserveColorBufferOn();
+  this->PrefetchRenderer->PreserveDepthBufferOn();
+  this->PrefetchRenderer->InteractiveOff();
+  // Volumes must be rendered even if they are not in the field of view
+  this->PrefetchRenderer->GetCullers()->RemoveAllItems();
+
+  vtkNew<vtkPiecewiseFunction> transparentOpacity;
+  transparentOpacity->AddPoint(VTK_DOUBLE_MIN, 0.0);
+  transparentOpacity->AddPoint(VTK_DOUBLE_MAX, 0.0);
+  this->PrefetchVolumeProperty = vtkSmartPointer<vtkVolumeProperty>::New();
+  this->PrefetchVolumeProperty->SetScalarOpacity(transparentOpacity);
+
+  vtkRenderer* renderer = this->External->GetRenderer();
+  this->PrefetchRenderer->SetLayer(renderer->GetLayer());
+  if (renderer->GetRenderWindow())
+    {
+    renderer->GetRenderWindow()->AddRenderer(this->PrefetchRenderer);
+    }
+  return this->PrefetchRenderer;
+}
+
+//---------------------------------------------------------------------------
+vtkAlgorithmOutput* vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::GetCroppedTextureConnection(
+  vtkMRMLGPURayCastVolumeRenderingDisplayNode* gpuDisplayNode, vtkAlgorithmOutput* imageConnection,
+  vtkImageData* imageData, vtkMRMLViewNode* viewNode)
+{
+  PipelineGPU* pipelineGpu = dynamic_cast<PipelineGPU*>(this->GetPipeline(gpuDisplayNode));
+  // Views that share the mapper would reconnect it to their own clip filter
+  if (!pipelineGpu || pipelineGpu->SharedMapper || !imageData)
+    {
+    return imageConnection;
+    }
+
+  int wholeExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  imageData->GetExtent(wholeExtent);
+  int extent[6] = { 0, -1, 0, -1, 0, -1 };
+  std::copy(wholeExtent, wholeExtent + 6, extent);
+  bool cropped = false;
+
+  // Cropping ROI
+  vtkMRMLMarkupsROINode* roiNode = gpuDisplayNode->GetCroppingEnabled() ? gpuDisplayNode->GetMarkupsROINode() : nullptr;
+  if (roiNode)
+    {
+    vtkNew<vtkMatrix4x4> ijkToWorldMatrix;
+    bool ijkToWorldLinear = true;
+    if (this->GetVolumeTransformToWorld(gpuDisplayNode->GetVolumeNode(), ijkToWorldMatrix, ijkToWorldLinear)
+      && ijkToWorldLinear)
+      {
+      cropped = GetROIExtent(roiNode, ijkToWorldMatrix, wholeExtent, extent);
+      }
+    }
+
+  // Empty space skipping
+  vtkVolumeProperty* volumeProperty = gpuDisplayNode->GetVolumePropertyNode() ?
+    gpuDisplayNode->GetVolumePropertyNode()->GetVolumeProperty() : nullptr;
+  double nonZeroOpacityRange[2] = { 0.0, -1.0 };
+  if (gpuDisplayNode->GetEmptySpaceSkipping() && volumeProperty
+    && viewNode->GetRaycastTechnique() == vtkMRMLViewNode::Composite
+    && imageData->GetNumberOfScalarComponents() == 1
+    && GetNonZeroOpacityRange(volumeProperty->GetScalarOpacity(), nonZeroOpacityRange))
+    {
+    bool cacheValid = (pipelineGpu->NonEmptyImageMTime == imageData->GetMTime()
+      && pipelineGpu->NonEmptyRange[0] == nonZeroOpacityRange[0]
+      && pipelineGpu->NonEmptyRange[1] == nonZeroOpacityRange[1]
+      && std::equal(extent, extent + 6, pipelineGpu->NonEmptySearchExtent));
+    if (!cacheValid)
+      {
+      bool found = false;
+      switch (imageData->GetScalarType())
+        {
+        vtkTemplateMacro(found = ComputeNonEmptyExtent(imageData, static_cast<VTK_TT*>(imageData->GetScalarPointer()),
+          extent, nonZeroOpacityRange, pipelineGpu->NonEmptyExtent));
+        }
+      if (!found)
+        {
+        // Nothing is visible, keep a single voxel
+        pipelineGpu->NonEmptyExtent[0] = pipelineGpu->NonEmptyExtent[1] = extent[0];
+        pipelineGpu->NonEmptyExtent[2] = pipelineGpu->NonEmptyExtent[3] = extent[2];
+        pipelineGpu->NonEmptyExtent[4] = pipelineGpu->NonEmptyExtent[5] = extent[4];
+        }
+      pipelineGpu->NonEmptyImageMTime = imageData->GetMTime();
+      pipelineGpu->NonEmptyRange[0] = nonZeroOpacityRange[0];
+      pipelineGpu->NonEmptyRange[1] = nonZeroOpacityRange[1];
+      std::copy(extent, extent + 6, pipelineGpu->NonEmptySearchExtent);
+      }
+    std::copy(pipelineGpu->NonEmptyExtent, pipelineGpu->NonEmptyExtent + 6, extent);
+    cropped = true;
+    }
+
+  int alignedExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  AlignExtentToBlocks(extent, wholeExtent, alignedExtent);
+  if (!cropped || std::equal(alignedExtent, alignedExtent + 6, wholeExtent))
+    {
+    pipelineGpu->TextureClip->RemoveAllInputConnections(0);
+    return imageConnection;
+    }
+  if (pipelineGpu->TextureClip->GetInputConnection(0, 0) != imageConnection)
+    {
+    pipelineGpu->TextureClip->SetInputConnection(imageConnection);
+    }
+  pipelineGpu->TextureClip->SetOutputWholeExtent(alignedExtent);
+  return pipelineGpu->TextureClip->GetOutputPort();
+}
+
 //---------------------------------------------------------------------------
 void vtkMRMLVolumeRenderingDisplayableManager::vtkInternal::UpdatePipelineROIs(
   vtkMRMLVolumeRenderingDisplayNode* displayNode, const Pipeline* pipeline)
@@ -19,6 +19,7 @@
 ==============================================================================*/
 
 // Qt includes
+#include <QCoreApplication>
 #include <QDebug>
 #include <QLineEdit>
 
@@ -133,6 +134,22 @@ void qSlicerVolumeRenderingSettingsPanelPrivate::init()
   q->registerProperty("VolumeRendering/GPUMemorySize", q,
                       "gpuMemory", SIGNAL(gpuMemoryChanged(QString)));
 
+  //
+  // Share GPU volume mappers between views
+  //
+
+  // Volume textures can only be used in multiple views if the views share OpenGL context
+  if (!QCoreApplication::testAttribute(Qt::AA_ShareOpenGLContexts))
+    {
+    this->ShareGPUVolumeMappersCheckBox->setEnabled(false);
+    this->ShareGPUVolumeMappersCheckBox->setToolTip(qSlicerVolumeRenderingSettingsPanel::tr(
+      "Sharing is not available because the application does not share OpenGL contexts between views."));
+    }
+  QObject::connect(this->ShareGPUVolumeMappersCheckBox, SIGNAL(toggled(bool)),
+                   q, SLOT(onShareGPUVolumeMappersChanged(bool)));
+  q->registerProperty("VolumeRendering/ShareGPUVolumeMappers", q,
+                      "shareGPUVolumeMappers", SIGNAL(shareGPUVolumeMappersChanged(bool)));
+
   // Update default view node from settings when startup completed.
   // MRML scene is not accessible yet from the logic when it is set, so cannot access default view node
   // either. Need to setup default node and set defaults to 3D views when the scene is available.
@@ -211,6 +228,7 @@ void qSlicerVolumeRenderingSettingsPanel::setVolumeRenderingLogic(vtkSlicerVolum
   d->VolumeRenderingLogic = logic;
 
   this->onVolumeRenderingLogicModified();
+  this->onShareGPUVolumeMappersChanged(d->ShareGPUVolumeMappersCheckBox->isChecked());
 
   this->registerProperty("VolumeRendering/RenderingMethod", this,
                          "defaultRenderingMethod", SIGNAL(defaultRenderingMethodChanged(QString)));
@@ -512,4 +530,32 @@ void qSlicerVolumeRenderingSettingsPanel::updateDefaultViewNodeFromWidget()
   this->onDefaultSurfaceSmoothingChanged(d->SurfaceSmoothingCheckBox->isChecked());
   this->onDefaultAutoReleaseGraphicsResourcesChanged(d->AutoReleaseGraphicsResourcesCheckBox->isChecked());
   this->onGPUMemoryChanged();
+  this->onShareGPUVolumeMappersChanged(d->ShareGPUVolumeMappersCheckBox->isChecked());
+}
+
+// --------------------------------------------------------------------------
+bool qSlicerVolumeRenderingSettingsPanel::shareGPUVolumeMappers()const
+{
+  Q_D(const qSlicerVolumeRenderingSettingsPanel);
+  return d->ShareGPUVolumeMappersCheckBox->isChecked();
+}
+
+// --------------------------------------------------------------------------
+void qSlicerVolumeRenderingSettingsPanel::setShareGPUVolumeMappers(bool share)
+{
+  Q_D(qSlicerVolumeRenderingSettingsPanel);
+  d->ShareGPUVolumeMappersCheckBox->setChecked(share);
+}
+
+// --------------------------------------------------------------------------
+void qSlicerVolumeRenderingSettingsPanel::onShareGPUVolumeMappersChanged(bool share)
+{
+  Q_D(qSlicerVolumeRenderingSettingsPanel);
+  if (d->VolumeRenderingLogic)
+    {
+    // Only enable sharing if views share OpenGL context
+    d->VolumeRenderingLogic->SetShareGPUVolumeMappers(
+      share && QCoreApplication::testAttribute(Qt::AA_ShareOpenGLContexts));
+    }
+  emit shareGPUVolumeMappersChanged(share);
 }
@@ -42,6 +42,7 @@ class Q_SLICER_QTMODULES_VOLUMERENDERING_EXPORT qSlicerVolumeRenderingSettingsPa
   Q_PROPERTY(bool defaultAutoReleaseGraphicsResources READ defaultAutoReleaseGraphicsResources \
     WRITE setDefaultAutoReleaseGraphicsResources NOTIFY defaultAutoReleaseGraphicsResourcesChanged)
   Q_PROPERTY(QString gpuMemory READ gpuMemory WRITE setGPUMemory NOTIFY gpuMemoryChanged)
+  Q_PROPERTY(bool shareGPUVolumeMappers READ shareGPUVolumeMappers WRITE setShareGPUVolumeMappers NOTIFY shareGPUVolumeMappersChanged)
 
 public:
   /// Superclass typedef
@@ -64,6 +65,8 @@ public:
   bool defaultSurfaceSmoothing()const;
   bool defaultAutoReleaseGraphicsResources()const;
   QString gpuMemory()const;
+  /// \sa vtkSlicerVolumeRenderingLogic::SetShareGPUVolumeMappers
+  bool shareGPUVolumeMappers()const;
 
 public slots:
   void setDefaultRenderingMethod(const QString& method);
@@ -72,6 +75,7 @@ public slots:
   void setDefaultSurfaceSmoothing(bool surfaceSmoothing);
   void setDefaultAutoReleaseGraphicsResources(bool autoRelease);
   void setGPUMemory(const QString& gpuMemory);
+  void setShareGPUVolumeMappers(bool share);
 
 signals:
   void defaultRenderingMethodChanged(const QString&);
@@ -80,6 +84,7 @@ signals:
   void defaultSurfaceSmoothingChanged(bool);
   void defaultAutoReleaseGraphicsResourcesChanged(bool);
   void gpuMemoryChanged(QString);
+  void shareGPUVolumeMappersChanged(bool);
 
 protected slots:
   void onVolumeRenderingLogicModified();
@@ -90,6 +95,7 @@ protected slots:
   void onDefaultSurfaceSmoothingChanged(bool);
   void onDefaultAutoReleaseGraphicsResourcesChanged(bool);
   void onGPUMemoryChanged();
+  void onShareGPUVolumeMappersChanged(bool);
   void updateDefaultViewNodeFromWidget();
 
 protected:
@@ -158,6 +158,12 @@ double qSlicerSubjectHierarchyDiffusionTensorVolumesPlugin::canOwnSubjectHierarc
   return 0.0;
 }
 
+//---------------------------------------------------------------------------
+bool qSlicerSubjectHierarchyDiffusionTensorVolumesPlugin::ownerConfidenceCacheable()const
+{
+  return true;
+}
+
 //---------------------------------------------------------------------------
 const QString qSlicerSubjectHierarchyDiffusionTensorVolumesPlugin::roleForPlugin()const
 {
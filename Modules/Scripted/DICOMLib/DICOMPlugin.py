@@ -17,6 +17,34 @@ comment = """
 #########################################################
 
 
+#
+# Examine result cache
+#
+
+_examineCache = None
+
+
+def examineCache():
+    """Return the cache of examine results that is shared by all DICOM plugin instances.
+    It stores for each series and plugin how many loadables the plugin found,
+    so that series that a plugin already found not loadable are not examined again
+    by that plugin, even if the plugin is instantiated again.
+    """
+    global _examineCache
+    if _examineCache is None:
+        _examineCache = slicer.vtkSlicerDICOMExamineCache()
+    return _examineCache
+
+
+def _filesToStringArray(files):
+    import vtk
+
+    fileArray = vtk.vtkStringArray()
+    for file in files:
+        fileArray.InsertNextValue(file)
+    return fileArray
+
+
 #
 # DICOMLoadable
 #
@@ -127,13 +155,29 @@ class DICOMPlugin:
             m.update(f.encode("UTF-8", "ignore"))
         return m.digest()
 
+    def seriesInstanceUIDForFiles(self, files):
+        """Helper method to get the series instance UID of a list of files
+        from the DICOM database. Returns None if not available.
+        """
+        if not files or not slicer.dicomDatabase:
+            return None
+        seriesUID = slicer.dicomDatabase.fileValue(files[0], "0020,000E")
+        return seriesUID if seriesUID else None
+
     def getCachedLoadables(self, files):
         """Helper method to access the results of a previous
-        examination of a list of files
+        examination of a list of files.
+        Returns None if the files have not been examined yet.
         """
         key = self.hashFiles(files)
         if key in self.loadableCache:
             return self.loadableCache[key]
+        # Loadables are only stored in this plugin instance, but the shared examine cache
+        # tells if another instance of this plugin already found the series not loadable.
+        seriesUID = self.seriesInstanceUIDForFiles(files)
+        if seriesUID and examineCache().GetNumberOfLoadables(
+                self.__class__.__name__, seriesUID, _filesToStringArray(files)) == 0:
+            return []
         return None
 
     def cacheLoadables(self, files, loadables):
@@ -142,6 +186,10 @@ class DICOMPlugin:
         """
         key = self.hashFiles(files)
         self.loadableCache[key] = loadables
+        seriesUID = self.seriesInstanceUIDForFiles(files)
+        if seriesUID:
+            examineCache().SetNumberOfLoadables(
+                self.__class__.__name__, seriesUID, _filesToStringArray(files), len(loadables))
 
     def examineForImport(self, fileList):
         """Look at the list of lists of filenames and return
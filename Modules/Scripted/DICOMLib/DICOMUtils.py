@@ -445,14 +445,33 @@ class TemporaryDICOMDatabase:
 
 # ------------------------------------------------------------------------------
 def importDicom(dicomDataDir, dicomDatabase=None, copyFiles=False):
-    """Import DICOM files from folder into Slicer database"""
+    """Import DICOM files from folder into Slicer database.
+
+    Files are parsed and inserted into the database by the background import thread
+    of the indexer, which writes the parsed files into the database in batches.
+    Import throughput is logged when the import is completed.
+    """
+    import time
+
     try:
         indexer = ctk.ctkDICOMIndexer()
         assert indexer is not None
+        indexer.backgroundImportEnabled = True
         if dicomDatabase is None:
             dicomDatabase = slicer.dicomDatabase
+        numberOfImagesAdded = [0]
+
+        def onIndexingComplete(patientsAdded, studiesAdded, seriesAdded, imagesAdded):
+            numberOfImagesAdded[0] += imagesAdded
+
+        indexer.connect("indexingComplete(int,int,int,int)", onIndexingComplete)
+        startTime = time.time()
         indexer.addDirectory(dicomDatabase, dicomDataDir, copyFiles)
         indexer.waitForImportFinished()
+        elapsedTimeSec = time.time() - startTime
+        if numberOfImagesAdded[0] > 0 and elapsedTimeSec > 0:
+            logging.info(f"Imported {numberOfImagesAdded[0]} DICOM files in {elapsedTimeSec:.1f}s"
+                         f" ({numberOfImagesAdded[0] / elapsedTimeSec:.1f} files/second)")
     except Exception as e:
         import traceback
 
@@ -751,6 +770,16 @@ def getLoadablesFromFileLists(fileLists, pluginClassNames=None, messages=None, p
     if pluginInstances is None:
         pluginInstances = {}
 
+    # Read size and modification time of all the files at once (in parallel), which plugins
+    # use to check if results stored in the shared examine cache are still valid.
+    from DICOMLib.DICOMPlugin import examineCache
+
+    allFiles = vtk.vtkStringArray()
+    for files in fileLists:
+        for file in files:
+            allFiles.InsertNextValue(file)
+    examineCache().UpdateFileStates(allFiles)
+
     for step, pluginClassName in enumerate(pluginClassNames):
         if pluginClassName not in pluginInstances:
             pluginInstances[pluginClassName] = slicer.modules.dicomPlugins[pluginClassName]()
@@ -0,0 +1,194 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// DICOMLib includes
+#include "vtkSlicerDICOMExamineCache.h"
+
+// VTK includes
+#include <vtkObjectFactory.h>
+#include <vtkSMPTools.h>
+#include <vtkStringArray.h>
+
+// VTKSYS includes
+#include <vtksys/SystemTools.hxx>
+
+// STD includes
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//------------------------------------------------------------------------------
+class vtkSlicerDICOMExamineCache::vtkInternal
+{
+public:
+  struct FileState
+    {
+    unsigned long Size{0};
+    long ModifiedTime{0};
+    };
+
+  struct ExamineResult
+    {
+    /// File names, sizes, and modification times of the examined files
+    std::string FilesSignature;
+    int NumberOfLoadables{0};
+    };
+
+  /// Get signature of the files. Size and modification time is taken from FileStates,
+  /// if not found there then it is read from the file system.
+  std::string GetFilesSignature(vtkStringArray* files)
+    {
+    std::ostringstream signature;
+    if (!files)
+      {
+      return signature.str();
+      }
+    for (vtkIdType fileIndex = 0; fileIndex < files->GetNumberOfValues(); ++fileIndex)
+      {
+      const std::string& fileName = files->GetValue(fileIndex);
+      FileState state;
+      auto stateIt = this->FileStates.find(fileName);
+      if (stateIt != this->FileStates.end())
+        {
+        state = stateIt->second;
+        }
+      else
+        {
+        state.Size = vtksys::SystemTools::FileLength(fileName);
+        state.ModifiedTime = vtksys::SystemTools::ModifiedTime(fileName);
+        }
+      signature << fileName << "|" << state.Size << "|" << state.ModifiedTime << "\n";
+      }
+    return signature.str();
+    }
+
+  std::unordered_map<std::string, FileState> FileStates;
+  /// Examine results indexed by series instance UID and plugin class name
+  std::map<std::string, std::map<std::string, ExamineResult> > Results;
+};
+
+//------------------------------------------------------------------------------
+vtkStandardNewMacro(vtkSlicerDICOMExamineCache);
+
+//----------------------------------------------------------------------------
+vtkSlicerDICOMExamineCache::vtkSlicerDICOMExamineCache()
+{
+  this->Internal = new vtkInternal;
+}
+
+//----------------------------------------------------------------------------
+vtkSlicerDICOMExamineCache::~vtkSlicerDICOMExamineCache()
+{
+  delete this->Internal;
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerDICOMExamineCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  Superclass::PrintSelf(os,indent);
+  os << indent << "NumberOfSeries:   " << this->Internal->Results.size() << "\n";
+  os << indent << "NumberOfFileStates:   " << this->Internal->FileStates.size() << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerDICOMExamineCache::UpdateFileStates(vtkStringArray* files)
+{
+  this->Internal->FileStates.clear();
+  if (!files)
+    {
+    return;
+    }
+  vtkIdType numberOfFiles = files->GetNumberOfValues();
+  std::vector<vtkInternal::FileState> states(numberOfFiles);
+  vtkSMPTools::For(0, numberOfFiles, [&](vtkIdType begin, vtkIdType end)
+    {
+    for (vtkIdType fileIndex = begin; fileIndex < end; ++fileIndex)
+      {
+      const std::string& fileName = files->GetValue(fileIndex);
+      states[fileIndex].Size = vtksys::SystemTools::FileLength(fileName);
+      states[fileIndex].ModifiedTime = vtksys::SystemTools::ModifiedTime(fileName);
+      }
+    });
+  this->Internal->FileStates.reserve(numberOfFiles);
+  for (vtkIdType fileIndex = 0; fileIndex < numberOfFiles; ++fileIndex)
+    {
+    this->Internal->FileStates[files->GetValue(fileIndex)] = states[fileIndex];
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkSlicerDICOMExamineCache::GetNumberOfLoadables(const char* pluginClassName, const char* seriesInstanceUID,
+  vtkStringArray* files)
+{
+  if (!pluginClassName || !seriesInstanceUID)
+    {
+    vtkErrorMacro("GetNumberOfLoadables: invalid plugin class name or series instance UID");
+    return -1;
+    }
+  auto seriesIt = this->Internal->Results.find(seriesInstanceUID);
+  if (seriesIt == this->Internal->Results.end())
+    {
+    return -1;
+    }
+  auto resultIt = seriesIt->second.find(pluginClassName);
+  if (resultIt == seriesIt->second.end())
+    {
+    return -1;
+    }
+  if (resultIt->second.FilesSignature != this->Internal->GetFilesSignature(files))
+    {
+    // files of the series changed since it was examined
+    return -1;
+    }
+  return resultIt->second.NumberOfLoadables;
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerDICOMExamineCache::SetNumberOfLoadables(const char* pluginClassName, const char* seriesInstanceUID,
+  vtkStringArray* files, int numberOfLoadables)
+{
+  if (!pluginClassName || !seriesInstanceUID)
+    {
+    vtkErrorMacro("SetNumberOfLoadables: invalid plugin class name or series instance UID");
+    return;
+    }
+  vtkInternal::ExamineResult& result = this->Internal->Results[seriesInstanceUID][pluginClassName];
+  result.FilesSignature = this->Internal->GetFilesSignature(files);
+  result.NumberOfLoadables = numberOfLoadables;
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerDICOMExamineCache::RemoveSeries(const char* seriesInstanceUID)
+{
+  if (!seriesInstanceUID)
+    {
+    return;
+    }
+  this->Internal->Results.erase(seriesInstanceUID);
+}
+
+//----------------------------------------------------------------------------
+void vtkSlicerDICOMExamineCache::RemoveAllSeries()
+{
+  this->Internal->Results.clear();
+}
+
+//----------------------------------------------------------------------------
+int vtkSlicerDICOMExamineCache::GetNumberOfSeries()
+{
+  return static_cast<int>(this->Internal->Results.size());
+}
@@ -0,0 +1,77 @@
+/*==============================================================================
+
+  Program: 3D Slicer
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef __vtkSlicerDICOMExamineCache_h
+#define __vtkSlicerDICOMExamineCache_h
+
+// VTK includes
+#include <vtkObject.h>
+
+#include "vtkSlicerDICOMLibModuleLogicExport.h"
+
+class vtkStringArray;
+
+/// \brief Stores results of examining DICOM series by DICOM plugins.
+///
+/// For each series instance UID and plugin the number of loadables that the plugin
+/// found in the series is stored, along with the size and modification time of the
+/// examined files. This allows skipping examination of series that a plugin
+/// already found not loadable, even if the plugin is instantiated again.
+/// A result is only returned if the same files are examined and none of the files
+/// changed since the result was stored.
+///
+/// Size and modification time of the files are read in parallel by UpdateFileStates(),
+/// which should be called with all the files before a large number of series are examined.
+class VTK_SLICER_DICOMLIB_MODULE_LOGIC_EXPORT vtkSlicerDICOMExamineCache : public vtkObject
+{
+public:
+  static vtkSlicerDICOMExamineCache *New();
+  vtkTypeMacro(vtkSlicerDICOMExamineCache, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Read size and modification time of all the files, using multiple threads.
+  /// The file states are used by GetNumberOfLoadables() and SetNumberOfLoadables()
+  /// until the next call of this method. State of files that are not included
+  /// in \a files is read from the file system when needed.
+  void UpdateFileStates(vtkStringArray* files);
+
+  /// Return the number of loadables that the plugin found when it examined the series.
+  /// Returns -1 if the series has not been examined by the plugin yet, or the examined files are different.
+  int GetNumberOfLoadables(const char* pluginClassName, const char* seriesInstanceUID, vtkStringArray* files);
+
+  /// Store the number of loadables that the plugin found when it examined the files of the series.
+  void SetNumberOfLoadables(const char* pluginClassName, const char* seriesInstanceUID, vtkStringArray* files,
+    int numberOfLoadables);
+
+  /// Remove all stored results of a series (for example, because the series is deleted from the database).
+  void RemoveSeries(const char* seriesInstanceUID);
+
+  /// Remove all stored results.
+  void RemoveAllSeries();
+
+  /// Number of series that results are stored for.
+  int GetNumberOfSeries();
+
+protected:
+  vtkSlicerDICOMExamineCache();
+  ~vtkSlicerDICOMExamineCache() override;
+  vtkSlicerDICOMExamineCache(const vtkSlicerDICOMExamineCache&);
+  void operator=(const vtkSlicerDICOMExamineCache&);
+
+  class vtkInternal;
+  vtkInternal* Internal;
+};
+
+#endif
@@ -39,7 +39,13 @@ class DICOMEnhancedUSVolumePluginClass(DICOMPlugin):
         """
         loadables = []
         for files in fileLists:
-            loadables += self.examineFiles(files)
+            cachedLoadables = self.getCachedLoadables(files)
+            if cachedLoadables is not None:
+                loadables += cachedLoadables
+            else:
+                loadablesForFiles = self.examineFiles(files)
+                loadables += loadablesForFiles
+                self.cacheLoadables(files, loadablesForFiles)
 
         return loadables
 
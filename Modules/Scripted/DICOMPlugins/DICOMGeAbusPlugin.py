@@ -45,7 +45,13 @@ class DICOMGeAbusPluginClass(DICOMPlugin):
         """
         loadables = []
         for files in fileLists:
-            loadables += self.examineFiles(files)
+            cachedLoadables = self.getCachedLoadables(files)
+            if cachedLoadables is not None:
+                loadables += cachedLoadables
+            else:
+                loadablesForFiles = self.examineFiles(files)
+                loadables += loadablesForFiles
+                self.cacheLoadables(files, loadablesForFiles)
 
         return loadables
 
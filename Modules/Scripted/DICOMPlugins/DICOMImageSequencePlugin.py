@@ -51,7 +51,13 @@ class DICOMImageSequencePluginClass(DICOMPlugin):
         """
         loadables = []
         for files in fileLists:
-            loadables += self.examineFiles(files)
+            cachedLoadables = self.getCachedLoadables(files)
+            if cachedLoadables is not None:
+                loadables += cachedLoadables
+            else:
+                loadablesForFiles = self.examineFiles(files)
+                loadables += loadablesForFiles
+                self.cacheLoadables(files, loadablesForFiles)
 
         return loadables
 
@@ -160,7 +160,7 @@ class DICOMScalarVolumePluginClass(DICOMPlugin):
         loadables = []
         for files in fileLists:
             cachedLoadables = self.getCachedLoadables(files)
-            if cachedLoadables:
+            if cachedLoadables is not None:
                 loadables += cachedLoadables
             else:
                 loadablesForFiles = self.examineFiles(files)
@@ -38,7 +38,7 @@ class DICOMSlicerDataBundlePluginClass(DICOMPlugin):
         loadables = []
         for files in fileLists:
             cachedLoadables = self.getCachedLoadables(files)
-            if cachedLoadables:
+            if cachedLoadables is not None:
                 loadables += cachedLoadables
             else:
                 loadablesForFiles = self.examineFiles(files)
@@ -807,6 +807,65 @@ class ScreenCaptureWidget(ScriptedLoadableModuleWidget):
         self.enableInputOutputWidgets(True)
 
 
+#
+# ScreenCaptureFrameWriter
+#
+
+
+class ScreenCaptureFrameWriter:
+    """Write captured frames to image files in a background thread.
+
+    Compressing and writing an image file may take about as long as rendering the frame,
+    therefore writing files in a background thread allows starting rendering of the next frame earlier.
+    The number of frames that are waiting to be written is limited to keep memory usage low.
+    """
+
+    def __init__(self, logic, maximumNumberOfQueuedFrames=8):
+        import queue
+        import threading
+
+        self.logic = logic
+        self.frameQueue = queue.Queue(maxsize=maximumNumberOfQueuedFrames)
+        self.errorMessage = None
+        self.thread = threading.Thread(target=self._writeFrames, daemon=True)
+        self.thread.start()
+
+    def addFrame(self, capturedImage, filename):
+        """Add a frame to the queue of frames to be written. Blocks if too many frames are already waiting."""
+        if self.errorMessage:
+            raise ValueError(self.errorMessage)
+        # The captured image may be reused by the next capture, therefore a copy is stored
+        imageCopy = vtk.vtkImageData()
+        imageCopy.DeepCopy(capturedImage)
+        self.frameQueue.put((imageCopy, filename))
+
+    def finish(self):
+        """Wait until all frames are written. Raises ValueError if writing of any frame failed."""
+        self.frameQueue.put(None)
+        self.thread.join()
+        if self.errorMessage:
+            raise ValueError(self.errorMessage)
+
+    def _writeFrames(self):
+        while True:
+            frame = self.frameQueue.get()
+            if frame is None:
+                return
+            if self.errorMessage:
+                # skip remaining frames after an error (but keep consuming the queue to not block the caller)
+                continue
+            imageData, filename = frame
+            try:
+                writer = self.logic.createImageWriter(filename)
+                writer.SetInputData(imageData)
+                writer.SetFileName(filename)
+                writer.Write()
+                if writer.GetErrorCode() != 0:
+                    self.errorMessage = _("Failed to write image file {filename}").format(filename=filename)
+            except Exception as e:
+                self.errorMessage = str(e)
+
+
 #
 # ScreenCaptureLogic
 #
@@ -826,6 +885,9 @@ class ScreenCaptureLogic(ScriptedLoadableModuleLogic):
         self.logCallback = None
         self.cancelRequested = False
 
+        # Write image files of animations in a background thread, while the next frame is rendered
+        self.writeFramesInBackground = True
+
         self.videoFormatPresets = [
             {"name": _("H.264"), "fileExtension": "mp4", "extraVideoOptions": "-codec libx264 -preset slower -pix_fmt yuv420p"},
             {"name": _("H.264 (high-quality)"), "fileExtension": "mp4", "extraVideoOptions": "-codec libx264 -preset slower -crf 18 -pix_fmt yuv420p"},
@@ -1027,7 +1089,14 @@ class ScreenCaptureLogic(ScriptedLoadableModuleLogic):
 
         return sliceOffsetResolution
 
-    def captureImageFromView(self, view, filename=None, transparentBackground=False, volumeNode=None):
+    def createFrameWriter(self):
+        """Create a writer that writes captured frames in the background.
+        Returns None if frames should be written synchronously."""
+        if not self.writeFramesInBackground:
+            return None
+        return ScreenCaptureFrameWriter(self)
+
+    def captureImageFromView(self, view, filename=None, transparentBackground=False, volumeNode=None, frameWriter=None):
         """
         Capture an image of the specified view and store in the specified object.
 
@@ -1035,6 +1104,8 @@ class ScreenCaptureLogic(ScriptedLoadableModuleLogic):
         :param filename: Filename of the desired output file. If none, no file will be written.
         :param transparentBackground: Set the background to be transparent for single-view captures.
         :param volumeNode: Vector volume node to store the capture image. If none, no vector volume node will be updated.
+        :param frameWriter: If specified then the file is written by this :py:class:`ScreenCaptureFrameWriter`
+          in the background. Files are only guaranteed to be written after calling ``frameWriter.finish()``.
         """
         slicer.app.processEvents()
         if view:
@@ -1127,7 +1198,9 @@ class ScreenCaptureLogic(ScriptedLoadableModuleLogic):
                 volumeNode.SetAndObserveImageData(vflip.GetOutput())
             else:
                 raise ValueError(_("Invalid vector volume node."))
-        if filename:
+        if filename and frameWriter:
+            frameWriter.addFrame(capturedImage, filename)
+        elif filename:
             writer = self.createImageWriter(filename)
             writer.SetInputData(capturedImage)
             writer.SetFileName(filename)
@@ -1243,13 +1316,19 @@ class ScreenCaptureLogic(ScriptedLoadableModuleLogic):
         sliceView = self.viewFromNode(sliceNode)
         compositeNode = sliceLogic.GetSliceCompositeNode()
         offsetStepSize = (endSliceOffset - startSliceOffset) / (numberOfImages - 1)
-        for offsetIndex in range(numberOfImages):
-            filename = filePathPattern % offsetIndex
-            self.addLog(_("Write {filename}").format(filename=filename))
-            sliceLogic.SetSliceOffset(startSliceOffset + offsetIndex * offsetStepSize)
-            self.captureImageFromView(None if captureAllViews else sliceView, filename, transparentBackground)
-            if self.cancelRequested:
-                break
+        frameWriter = self.createFrameWriter()
+        try:
+            for offsetIndex in range(numberOfImages):
+                filename = filePathPattern % offsetIndex
+                self.addLog(_("Write {filename}").format(filename=filename))
+                sliceLogic.SetSliceOffset(startSliceOffset + offsetIndex * offsetStepSize)
+                self.captureImageFromView(None if captureAllViews else sliceView, filename, transparentBackground,
+                                          frameWriter=frameWriter)
+                if self.cancelRequested:
+                    break
+        finally:
+            if frameWriter:
+                frameWriter.finish()
 
         sliceLogic.SetSliceOffset(originalSliceOffset)
         if self.cancelRequested:
@@ -1274,13 +1353,19 @@ class ScreenCaptureLogic(ScriptedLoadableModuleLogic):
         startForegroundOpacity = 0.0
         endForegroundOpacity = 1.0
         opacityStepSize = (endForegroundOpacity - startForegroundOpacity) / (numberOfImages - 1)
-        for offsetIndex in range(numberOfImages):
-            filename = filePathPattern % offsetIndex
-            self.addLog(_("Write {filename}").format(filename=filename))
-            compositeNode.SetForegroundOpacity(startForegroundOpacity + offsetIndex * opacityStepSize)
-            self.captureImageFromView(None if captureAllViews else sliceView, filename, transparentBackground)
-            if self.cancelRequested:
-                break
+        frameWriter = self.createFrameWriter()
+        try:
+            for offsetIndex in range(numberOfImages):
+                filename = filePathPattern % offsetIndex
+                self.addLog(_("Write {filename}").format(filename=filename))
+                compositeNode.SetForegroundOpacity(startForegroundOpacity + offsetIndex * opacityStepSize)
+                self.captureImageFromView(None if captureAllViews else sliceView, filename, transparentBackground,
+                                          frameWriter=frameWriter)
+                if self.cancelRequested:
+                    break
+        finally:
+            if frameWriter:
+                frameWriter.finish()
 
         compositeNode.SetForegroundOpacity(originalForegroundOpacity)
 
@@ -1317,15 +1402,21 @@ class ScreenCaptureLogic(ScriptedLoadableModuleLogic):
             renderView.yawDirection = renderView.YawLeft
         else:
             renderView.pitchDirection = renderView.PitchUp
-        for offsetIndex in range(numberOfImages):
-            if not self.cancelRequested:
-                filename = filePathPattern % offsetIndex
-                self.addLog(_("Write {filename}").format(filename=filename))
-                self.captureImageFromView(None if captureAllViews else renderView, filename, transparentBackground)
-            if rotationAxis == AXIS_YAW:
-                renderView.yaw()
-            else:
-                renderView.pitch()
+        frameWriter = self.createFrameWriter()
+        try:
+            for offsetIndex in range(numberOfImages):
+                if not self.cancelRequested:
+                    filename = filePathPattern % offsetIndex
+                    self.addLog(_("Write {filename}").format(filename=filename))
+                    self.captureImageFromView(None if captureAllViews else renderView, filename, transparentBackground,
+                                              frameWriter=frameWriter)
+                if rotationAxis == AXIS_YAW:
+                    renderView.yaw()
+                else:
+                    renderView.pitch()
+        finally:
+            if frameWriter:
+                frameWriter.finish()
 
         # Restore original orientation and rotation step size & direction
         if rotationAxis == AXIS_YAW:
@@ -1361,13 +1452,19 @@ class ScreenCaptureLogic(ScriptedLoadableModuleLogic):
 
         renderView = self.viewFromNode(viewNode)
         stepSize = (sequenceEndIndex - sequenceStartIndex) / (numberOfImages - 1)
-        for offsetIndex in range(numberOfImages):
-            sequenceBrowserNode.SetSelectedItemNumber(int(sequenceStartIndex + offsetIndex * stepSize))
-            filename = filePathPattern % offsetIndex
-            self.addLog(_("Write {filename}").format(filename=filename))
-            self.captureImageFromView(None if captureAllViews else renderView, filename, transparentBackground)
-            if self.cancelRequested:
-                break
+        frameWriter = self.createFrameWriter()
+        try:
+            for offsetIndex in range(numberOfImages):
+                sequenceBrowserNode.SetSelectedItemNumber(int(sequenceStartIndex + offsetIndex * stepSize))
+                filename = filePathPattern % offsetIndex
+                self.addLog(_("Write {filename}").format(filename=filename))
+                self.captureImageFromView(None if captureAllViews else renderView, filename, transparentBackground,
+                                          frameWriter=frameWriter)
+                if self.cancelRequested:
+                    break
+        finally:
+            if frameWriter:
+                frameWriter.finish()
 
         sequenceBrowserNode.SetSelectedItemNumber(originalSelectedItemNumber)
         if self.cancelRequested:
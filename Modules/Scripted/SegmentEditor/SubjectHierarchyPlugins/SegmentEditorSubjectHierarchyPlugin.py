@@ -45,6 +45,11 @@ class SegmentEditorSubjectHierarchyPlugin(AbstractScriptedSubjectHierarchyPlugin
         #   return 1.0
         return 0.0
 
+    def ownerConfidenceCacheable(self):
+        # Confidence value returned by canOwnSubjectHierarchyItem only depends on the data node class,
+        # the item level, and the attribute names, so the plugin handler can cache it
+        return True
+
     def roleForPlugin(self):
         # As this plugin cannot own any items, it doesn't have a role either
         return "N/A"
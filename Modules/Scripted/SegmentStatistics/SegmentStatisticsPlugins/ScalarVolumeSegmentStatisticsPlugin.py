@@ -14,6 +14,8 @@ class ScalarVolumeSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
         self.keys = ["voxel_count", "volume_mm3", "volume_cm3", "min", "max", "mean", "median", "stdev"]
         self.defaultKeys = self.keys  # calculate all measurements by default
         # ... developer may add extra options to configure other parameters
+        # Statistics of all segments of a labelmap layer are computed at once, cached by layer index
+        self.layerStatisticsCache = {}
 
     def computeStatistics(self, segmentID):
         requestedKeys = self.getRequestedKeys()
@@ -24,44 +26,115 @@ class ScalarVolumeSegmentStatisticsPlugin(SegmentStatisticsPluginBase):
         if len(requestedKeys) == 0:
             return {}
 
-        stencil = self.getStencilForVolume(segmentationNode, segmentID, grayscaleNode)
-        if not stencil:
+        labelStatistics = self.getLabelStatisticsForSegment(segmentationNode, segmentID, grayscaleNode)
+        if labelStatistics is None:
             return {}
+        voxelCount, minimum, maximum, mean, stdev, median = labelStatistics
+        voxelCount = int(voxelCount)
 
         cubicMMPerVoxel = reduce(lambda x, y: x * y, grayscaleNode.GetSpacing())
         ccPerCubicMM = 0.001
 
-        stat = vtk.vtkImageAccumulate()
-        stat.SetInputData(grayscaleNode.GetImageData())
-        stat.SetStencilData(stencil.GetOutput())
-        stat.Update()
-
-        medians = vtk.vtkImageHistogramStatistics()
-        medians.SetInputData(grayscaleNode.GetImageData())
-        medians.SetStencilData(stencil.GetOutput())
-        medians.Update()
-
         # create statistics list
         stats = {}
         if "voxel_count" in requestedKeys:
-            stats["voxel_count"] = stat.GetVoxelCount()
+            stats["voxel_count"] = voxelCount
         if "volume_mm3" in requestedKeys:
-            stats["volume_mm3"] = stat.GetVoxelCount() * cubicMMPerVoxel
+            stats["volume_mm3"] = voxelCount * cubicMMPerVoxel
         if "volume_cm3" in requestedKeys:
-            stats["volume_cm3"] = stat.GetVoxelCount() * cubicMMPerVoxel * ccPerCubicMM
-        if stat.GetVoxelCount() > 0:
+            stats["volume_cm3"] = voxelCount * cubicMMPerVoxel * ccPerCubicMM
+        if voxelCount > 0:
             if "min" in requestedKeys:
-                stats["min"] = stat.GetMin()[0]
+                stats["min"] = minimum
             if "max" in requestedKeys:
-                stats["max"] = stat.GetMax()[0]
+                stats["max"] = maximum
             if "mean" in requestedKeys:
-                stats["mean"] = stat.GetMean()[0]
+                stats["mean"] = mean
             if "stdev" in requestedKeys:
-                stats["stdev"] = stat.GetStandardDeviation()[0]
+                stats["stdev"] = stdev
             if "median" in requestedKeys:
-                stats["median"] = medians.GetMedian()
+                stats["median"] = median
         return stats
 
+    def getLabelStatisticsForSegment(self, segmentationNode, segmentID, grayscaleNode):
+        """Get voxel count, minimum, maximum, mean, standard deviation, and median of the scalar volume in a segment.
+        Statistics of all the segments that share the labelmap layer of the segment are computed in a single pass
+        and cached, so that the layer is resampled and the scalar volume is processed only once for all these segments.
+        """
+        import vtkSegmentationCorePython as vtkSegmentationCore
+
+        labelmapRepresentationName = vtkSegmentationCore.vtkSegmentationConverter.GetSegmentationBinaryLabelmapRepresentationName()
+        segmentation = segmentationNode.GetSegmentation()
+        if not segmentation.ContainsRepresentation(labelmapRepresentationName):
+            return None
+
+        if (not grayscaleNode
+            or not grayscaleNode.GetImageData()
+            or not grayscaleNode.GetImageData().GetPointData()
+            or not grayscaleNode.GetImageData().GetPointData().GetScalars()):
+            # Input grayscale node does not contain valid image data
+            return None
+
+        segment = segmentation.GetSegment(segmentID)
+        layerLabelmap = segment.GetRepresentation(labelmapRepresentationName) if segment else None
+        if (not layerLabelmap
+            or not layerLabelmap.GetPointData()
+                or not layerLabelmap.GetPointData().GetScalars()):
+            # No input label data
+            return None
+
+        layerIndex = segmentation.GetLayerIndex(segmentID, labelmapRepresentationName)
+        layerSegmentIDs = list(segmentation.GetSegmentIDsForLayer(layerIndex, labelmapRepresentationName))
+        layerLabelValues = [segmentation.GetSegment(layerSegmentID).GetLabelValue() for layerSegmentID in layerSegmentIDs]
+
+        def getTransformMTime(transformableNode):
+            transformNode = transformableNode.GetParentTransformNode()
+            return (transformNode.GetID(), transformNode.GetTransformToWorldMTime()) if transformNode else None
+
+        cacheKey = (segmentationNode.GetID(), layerLabelmap.GetMTime(), tuple(zip(layerSegmentIDs, layerLabelValues)),
+                    grayscaleNode.GetID(), grayscaleNode.GetMTime(), grayscaleNode.GetImageData().GetMTime(),
+                    getTransformMTime(segmentationNode), getTransformMTime(grayscaleNode))
+        cachedLayerStatistics = self.layerStatisticsCache.get(layerIndex)
+        if cachedLayerStatistics is None or cachedLayerStatistics[0] != cacheKey:
+            layerStatistics = self.computeLayerStatistics(segmentationNode, layerLabelmap, layerSegmentIDs, layerLabelValues, grayscaleNode)
+            cachedLayerStatistics = (cacheKey, layerStatistics)
+            self.layerStatisticsCache[layerIndex] = cachedLayerStatistics
+        return cachedLayerStatistics[1].get(segmentID)
+
+    def computeLayerStatistics(self, segmentationNode, layerLabelmap, layerSegmentIDs, layerLabelValues, grayscaleNode):
+        """Compute scalar statistics for all segments of a labelmap layer. Returns a dict of statistics by segment ID."""
+        import vtkSegmentationCorePython as vtkSegmentationCore
+
+        # Get geometry of grayscale volume node as oriented image data
+        # reference geometry in reference node coordinate system
+        referenceGeometry_Reference = vtkSegmentationCore.vtkOrientedImageData()
+        referenceGeometry_Reference.SetExtent(grayscaleNode.GetImageData().GetExtent())
+        ijkToRasMatrix = vtk.vtkMatrix4x4()
+        grayscaleNode.GetIJKToRASMatrix(ijkToRasMatrix)
+        referenceGeometry_Reference.SetGeometryFromImageToWorldMatrix(ijkToRasMatrix)
+
+        # Get transform between grayscale volume and segmentation
+        segmentationToReferenceGeometryTransform = vtk.vtkGeneralTransform()
+        slicer.vtkMRMLTransformNode.GetTransformBetweenNodes(segmentationNode.GetParentTransformNode(),
+                                                             grayscaleNode.GetParentTransformNode(), segmentationToReferenceGeometryTransform)
+
+        layerLabelmap_Reference = vtkSegmentationCore.vtkOrientedImageData()
+        vtkSegmentationCore.vtkOrientedImageDataResample.ResampleOrientedImageToReferenceOrientedImage(
+            layerLabelmap, referenceGeometry_Reference, layerLabelmap_Reference,
+            False,  # nearest neighbor interpolation
+            False,  # no padding
+            segmentationToReferenceGeometryTransform)
+
+        labelValues = vtk.vtkIntArray()
+        for labelValue in layerLabelValues:
+            labelValues.InsertNextValue(labelValue)
+        statistics = vtk.vtkDoubleArray()
+        if not slicer.vtkSlicerSegmentationsModuleLogic.ComputeLabelScalarStatistics(
+                layerLabelmap_Reference, grayscaleNode.GetImageData(), labelValues, statistics):
+            return {}
+
+        return {segmentID: statistics.GetTuple(index) for index, segmentID in enumerate(layerSegmentIDs)}
+
     def getStencilForVolume(self, segmentationNode, segmentID, grayscaleNode):
         import vtkSegmentationCorePython as vtkSegmentationCore
 
@@ -337,11 +337,14 @@ class SlicerHTTPServer(HTTPServer):
             self.logMessage = logMessage
             self.enableCORS = enableCORS
             self.bufferSize = 1024 * 1024
+            # time to wait before querying a response body iterator if it did not have any data available
+            self.waitForDataIntervalMs = 10
             self.requestHandlers = []
             for requestHandler in requestHandlers:
                 self.registerRequestHandler(requestHandler)
             self.expectedRequestSize = -1
-            self.requestSoFar = b""
+            # bytearray is extended in place, so receiving a large request body is not slowed down by copying
+            self.requestSoFar = bytearray()
             fileno = self.connectionSocket.fileno()
             self.readNotifier = qt.QSocketNotifier(fileno, qt.QSocketNotifier.Read)
             self.readNotifier.connect("activated(int)", self.onReadable)
@@ -365,8 +368,8 @@ class SlicerHTTPServer(HTTPServer):
                 if self.expectedRequestSize > 0:
                     self.logMessage("received... %d of %d expected" % (len(self.requestSoFar), self.expectedRequestSize))
                     if len(self.requestSoFar) >= self.expectedRequestSize:
-                        requestHeader = self.requestSoFar[: endOfHeader + 2]
-                        requestBody = self.requestSoFar[4 + endOfHeader :]
+                        requestHeader = bytes(self.requestSoFar[: endOfHeader + 2])
+                        requestBody = bytes(memoryview(self.requestSoFar)[4 + endOfHeader :])
                         requestComplete = True
                 else:
                     if endOfHeader != -1:
@@ -385,7 +388,7 @@ class SlicerHTTPServer(HTTPServer):
                                 requestComplete = True
                         else:
                             self.logMessage("Found end of header with no content, so body is empty")
-                            requestHeader = self.requestSoFar[:-2]
+                            requestHeader = bytes(self.requestSoFar[:-2])
                             requestComplete = True
             except OSError as e:
                 print("Socket error: ", e)
@@ -459,40 +462,101 @@ class SlicerHTTPServer(HTTPServer):
                     contentType = b"text/plain"
                     responseBody = b""
 
+                # The response body may be a bytes-like object, a list of bytes-like objects (sent one after the other
+                # without concatenating them), or an iterator that produces the bytes-like objects while the response
+                # is being sent (sent using chunked transfer encoding, as the total size is not known in advance).
+                # An iterator may return an empty bytes object to indicate that no data is available yet
+                # (for example, a stream of rendered frames), sending is then resumed after a short wait.
                 if responseBody:
-                    self.response = f"HTTP/1.1 {httpStatus}\r\n".encode()
+                    responseHeader = f"HTTP/1.1 {httpStatus}\r\n".encode()
                     if self.enableCORS:
-                        self.response += b"Access-Control-Allow-Origin: *\r\n"
-                    self.response += b"Content-Type: %s\r\n" % contentType
-                    self.response += b"Content-Length: %d\r\n" % len(responseBody)
-                    self.response += b"Cache-Control: no-cache\r\n"
-                    self.response += b"\r\n"
-                    self.response += responseBody
+                        responseHeader += b"Access-Control-Allow-Origin: *\r\n"
+                    responseHeader += b"Content-Type: %s\r\n" % contentType
+                    if isinstance(responseBody, (bytes, bytearray, memoryview)):
+                        responseBody = [responseBody]
+                    if isinstance(responseBody, (list, tuple)):
+                        self.toSend = sum(memoryview(chunk).nbytes for chunk in responseBody)
+                        responseHeader += b"Content-Length: %d\r\n" % self.toSend
+                    else:
+                        self.toSend = -1
+                        responseHeader += b"Transfer-Encoding: chunked\r\n"
+                        responseBody = self.chunkedTransferEncoding(responseBody)
+                    responseHeader += b"Cache-Control: no-cache\r\n"
+                    responseHeader += b"\r\n"
+                    if self.toSend >= 0:
+                        self.toSend += len(responseHeader)
+                    self.responseChunks = self.prependChunk(responseHeader, responseBody)
                 else:
-                    self.response = b"HTTP/1.1 404 Not Found\r\n"
-                    self.response += b"\r\n"
+                    response = b"HTTP/1.1 404 Not Found\r\n"
+                    response += b"\r\n"
+                    self.toSend = len(response)
+                    self.responseChunks = iter([response])
 
-                self.toSend = len(self.response)
+                self.response = memoryview(b"")
                 self.sentSoFar = 0
                 fileno = self.connectionSocket.fileno()
                 self.writeNotifier = qt.QSocketNotifier(fileno, qt.QSocketNotifier.Write)
                 self.writeNotifier.connect("activated(int)", self.onWritable)
 
+        @staticmethod
+        def prependChunk(firstChunk, chunks):
+            yield firstChunk
+            yield from chunks
+
+        @staticmethod
+        def chunkedTransferEncoding(chunks):
+            """Wrap each non-empty bytes-like object in HTTP chunked transfer encoding.
+            Empty objects are passed through (they indicate that no data is available yet).
+            """
+            for chunk in chunks:
+                chunkSize = memoryview(chunk).nbytes
+                if chunkSize == 0:
+                    yield chunk
+                    continue
+                yield b"%X\r\n" % chunkSize
+                yield chunk
+                yield b"\r\n"
+            yield b"0\r\n\r\n"
+
+        def resumeSending(self):
+            if self.connectionSocket.fileno() != -1:
+                self.writeNotifier.setEnabled(True)
+
         def onWritable(self, fileno):
-            self.logMessage("Sending on %d..." % (fileno))
             sendError = False
+            responseComplete = False
             try:
-                sent = self.connectionSocket.send(self.response[: 500 * self.bufferSize])
-                self.response = self.response[sent:]
-                self.sentSoFar += sent
-                self.logMessage("sent: %d (%d of %d, %f%%)" % (sent, self.sentSoFar, self.toSend, 100. * self.sentSoFar / self.toSend))
+                # Get the next part of the response. Slicing a memoryview does not copy the data.
+                if not self.response:
+                    nextChunk = next(self.responseChunks, None)
+                    if nextChunk is None:
+                        responseComplete = True
+                    else:
+                        self.response = memoryview(nextChunk).cast("B")
+                if not self.response and not responseComplete:
+                    # no data is available yet, pause sending
+                    self.writeNotifier.setEnabled(False)
+                    qt.QTimer.singleShot(self.waitForDataIntervalMs, self.resumeSending)
+                    return
+                if not responseComplete:
+                    self.logMessage("Sending on %d..." % (fileno))
+                    sent = self.connectionSocket.send(self.response[: 500 * self.bufferSize])
+                    self.response = self.response[sent:]
+                    self.sentSoFar += sent
+                    if self.toSend > 0:
+                        self.logMessage("sent: %d (%d of %d, %f%%)" % (sent, self.sentSoFar, self.toSend, 100. * self.sentSoFar / self.toSend))
+                    else:
+                        self.logMessage("sent: %d (%d)" % (sent, self.sentSoFar))
             except OSError as e:
                 self.logMessage("Socket error while sending: %s" % e)
                 sendError = True
 
-            if self.sentSoFar >= self.toSend or sendError:
+            if responseComplete or sendError:
                 self.writeNotifier.disconnect("activated(int)", self.onWritable)
                 self.writeNotifier.setEnabled(False)
+                if hasattr(self.responseChunks, "close"):
+                    # release resources (such as observers) of response body generators
+                    self.responseChunks.close()
                 self.connectionSocket.close()
                 self.logMessage("closed fileno %d" % (fileno))
 
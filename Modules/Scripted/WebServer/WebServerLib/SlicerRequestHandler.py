@@ -4,12 +4,14 @@ Docs/user_guide/modules/webserver.md
 """
 
 
+import hashlib
 import json
 import logging
 import numpy
 import os
 import time
 import urllib
+import zlib
 from typing import Optional
 
 import qt
@@ -81,6 +83,8 @@ class SlicerRequestHandler(BaseRequestHandler):
             responseBody, contentType = self.gui(method, request)
         elif request.find(b"/screenshot") == 0:
             responseBody, contentType = self.screenshot(request)
+        elif request.find(b"/viewStream") == 0:
+            responseBody, contentType = self.viewStream(request)
         elif request.find(b"/slice") == 0:
             responseBody, contentType = self.slice(request)
         elif request.find(b"/threeDGraphics") == 0:
@@ -307,6 +311,7 @@ class SlicerRequestHandler(BaseRequestHandler):
         and put it in the scene, either in an existing node or a new one.
 
         If there is no request body then the binary of the nrrd is returned for the given id.
+        If `compression=gzip` is specified then the returned nrrd uses gzip encoding.
         """
         p = urllib.parse.urlparse(request.decode())
         q = urllib.parse.parse_qs(p.query)
@@ -314,11 +319,15 @@ class SlicerRequestHandler(BaseRequestHandler):
             volumeID = q["id"][0].strip()
         except KeyError:
             volumeID = "vtkMRMLScalarVolumeNode*"
+        try:
+            compression = q["compression"][0].strip()
+        except KeyError:
+            compression = None
 
         if requestBody:
             return self.postNRRD(volumeID, requestBody)
         else:
-            return self.getNRRD(volumeID)
+            return self.getNRRD(volumeID, compression)
 
     def gridTransforms(self, request, requestBody):
         """
@@ -359,6 +368,7 @@ class SlicerRequestHandler(BaseRequestHandler):
         :param volumeID: mrml id of the volume to update (new is created if id is invalid)
         :param requestBody: the binary of the nrrd.
         .. note:: only a subset of valid nrrds are supported (just scalar volumes and grid transforms)
+        .. note:: voxels are read from the request body directly into the voxel array of the volume
         """
 
         if requestBody[:4] != b"NRRD":
@@ -381,8 +391,8 @@ class SlicerRequestHandler(BaseRequestHandler):
             raise RuntimeError("Can only read 3D, 1 component volumes")
         if fields[b"endian"] != b"little":
             raise RuntimeError("Can only read little endian")
-        if fields[b"encoding"] != b"raw":
-            raise RuntimeError("Can only read raw encoding")
+        if fields[b"encoding"] not in [b"raw", b"gzip", b"gz"]:
+            raise RuntimeError("Can only read raw or gzip encoding")
         if fields[b"space"] != b"left-posterior-superior":
             raise RuntimeError("Can only read space in LPS")
 
@@ -422,9 +432,26 @@ class SlicerRequestHandler(BaseRequestHandler):
         node.SetAndObserveImageData(imageData)
         node.SetIJKToRASMatrix(ijkToRAS)
 
-        pixels = numpy.frombuffer(requestBody[endOfHeader + 2 :], dtype=numpy.dtype("int16"))
         array = slicer.util.array(node.GetID())
-        array[:] = pixels.reshape(array.shape)
+        if fields[b"encoding"] == b"raw":
+            # use the request body as voxel buffer, without making a copy of it
+            pixels = numpy.frombuffer(requestBody, dtype=numpy.dtype("int16"), offset=endOfHeader + 2, count=array.size)
+            array[:] = pixels.reshape(array.shape)
+        else:
+            # decompress in parts directly into the voxel array
+            arrayBytes = memoryview(array.reshape(-1)).cast("B")
+            decompressor = zlib.decompressobj(16 + zlib.MAX_WBITS)
+            compressed = memoryview(requestBody)[endOfHeader + 2 :]
+            decompressedSize = 0
+            partSize = 1024 * 1024
+            for partStart in range(0, len(compressed), partSize):
+                part = decompressor.decompress(compressed[partStart : partStart + partSize])
+                if decompressedSize + len(part) > len(arrayBytes):
+                    raise RuntimeError("Compressed voxel data is larger than the volume")
+                arrayBytes[decompressedSize : decompressedSize + len(part)] = part
+                decompressedSize += len(part)
+            if decompressedSize != len(arrayBytes):
+                raise RuntimeError("Compressed voxel data is incomplete")
         imageData.GetPointData().GetScalars().Modified()
 
         displayNode = node.GetDisplayNode()
@@ -435,9 +462,13 @@ class SlicerRequestHandler(BaseRequestHandler):
 
         return b"{'status': 'success'}", b"application/json"
 
-    def getNRRD(self, volumeID):
+    def getNRRD(self, volumeID, compression=None):
         """Return a nrrd binary blob with contents of the volume node
         :param volumeID: must be a valid mrml id
+        :param compression: if "gzip" then voxels are compressed while the response is sent
+        .. note:: The returned voxel data refers to the voxel array of the volume, it is not copied.
+            If compression is enabled then it is compressed in parts as the response is sent,
+            so the compressed volume is not stored in memory as a whole.
         """
         volumeNode = slicer.util.getNode(volumeID)
         volumeArray = slicer.util.array(volumeID)
@@ -460,6 +491,10 @@ class SlicerRequestHandler(BaseRequestHandler):
             volumeArray = numpy.array(volumeArray, dtype="int16")
             scalarType = "short"
 
+        if compression not in [None, "gzip"]:
+            raise ValueError(f"Unsupported compression: {compression}. Supported compression: gzip")
+        encoding = "gzip" if compression else "raw"
+
         sizes = imageData.GetDimensions()
         sizes = " ".join(list(map(str, sizes)))
 
@@ -497,13 +532,28 @@ sizes: %%sizes%%
 space directions: %%directions%%
 kinds: domain domain domain
 endian: little
-encoding: raw
+encoding: %%encoding%%
 space origin: %%origin%%
 
-""".replace("%%scalarType%%", scalarType).replace("%%sizes%%", sizes).replace("%%directions%%", directions).replace("%%origin%%", origin)
+""".replace("%%scalarType%%", scalarType).replace("%%sizes%%", sizes).replace("%%directions%%", directions).replace("%%encoding%%", encoding).replace("%%origin%%", origin)
 
-        nrrdData = nrrdHeader.encode() + volumeArray.tobytes()
-        return nrrdData, b"application/octet-stream"
+        voxels = memoryview(numpy.ascontiguousarray(volumeArray)).cast("B")
+        if compression == "gzip":
+            # Size of the compressed data is not known in advance, therefore it is returned as a generator
+            return self.gzipCompressedChunks(nrrdHeader.encode(), voxels), b"application/octet-stream"
+        # Header and voxels are sent one after the other, without concatenating them
+        return [nrrdHeader.encode(), voxels], b"application/octet-stream"
+
+    @staticmethod
+    def gzipCompressedChunks(header, data, partSize=4 * 1024 * 1024, compressionLevel=1):
+        """Generator that returns the header and then the gzip-compressed data, part by part."""
+        yield header
+        compressor = zlib.compressobj(compressionLevel, zlib.DEFLATED, 16 + zlib.MAX_WBITS)
+        for partStart in range(0, len(data), partSize):
+            compressedPart = compressor.compress(data[partStart : partStart + partSize])
+            if compressedPart:
+                yield compressedPart
+        yield compressor.flush()
 
     def getTransformNRRD(self, transformID):
         """Return a nrrd binary blob with contents of the transform node"""
@@ -1076,6 +1126,95 @@ space origin: %%origin%%
         self.logMessage("threeD returning an image of %d length" % len(pngData))
         return pngData, b"image/png"
 
+    def viewStream(self, request):
+        """
+        Handle requests with path: /viewStream
+        Return a continuous stream of JPEG images of a view (multipart/x-mixed-replace, also known as MJPEG).
+        A new frame is only sent if the view has been rendered and its content changed since the last frame.
+        """
+
+        p = urllib.parse.urlparse(request.decode())
+        q = urllib.parse.parse_qs(p.query)
+        try:
+            view = q["view"][0].strip().lower()
+        except KeyError:
+            view = "red"
+        try:
+            quality = int(q["quality"][0].strip())
+        except (KeyError, ValueError):
+            quality = 80
+        try:
+            maxFrameRate = float(q["maxFrameRate"][0].strip())
+        except (KeyError, ValueError):
+            maxFrameRate = 20.0
+
+        layoutManager = slicer.app.layoutManager()
+        if view in ["red", "yellow", "green"]:
+            renderWindow = layoutManager.sliceWidget(view.capitalize()).sliceView().renderWindow()
+        else:
+            try:
+                threeDViewIndex = int(view) - 1
+            except ValueError:
+                raise RuntimeError(f"Invalid view: {view}. Valid views: red, yellow, green, or 3D view number (1, 2, ...)")
+            if threeDViewIndex < 0 or threeDViewIndex >= layoutManager.threeDViewCount:
+                raise RuntimeError(f"3D view {view} is not found")
+            renderWindow = layoutManager.threeDWidget(threeDViewIndex).threeDView().renderWindow()
+
+        return self.viewFrameStream(renderWindow, quality, maxFrameRate), b"multipart/x-mixed-replace; boundary=frame"
+
+    @staticmethod
+    def viewFrameStream(renderWindow, quality=80, maxFrameRate=20.0):
+        """Generator that returns JPEG-encoded frames of the render window in multipart/x-mixed-replace format.
+        If no new frame is available then an empty bytes object is returned, indicating that the caller
+        should try again later.
+        """
+        state = {"rendered": True, "capturing": False}
+
+        def onRendered(caller, event):
+            # The frame capture renders the window too, it must not trigger capturing of a new frame
+            if not state["capturing"]:
+                state["rendered"] = True
+
+        observerTag = renderWindow.AddObserver(vtk.vtkCommand.EndEvent, onRendered)
+        windowToImage = vtk.vtkWindowToImageFilter()
+        windowToImage.SetInput(renderWindow)
+        windowToImage.ReadFrontBufferOff()
+        writer = vtk.vtkJPEGWriter()
+        writer.SetWriteToMemory(True)
+        writer.SetQuality(quality)
+        writer.SetInputConnection(windowToImage.GetOutputPort())
+
+        minimumFrameInterval = 1.0 / maxFrameRate if maxFrameRate > 0 else 0.0
+        lastFrameTime = 0.0
+        lastFrameDigest = None
+        try:
+            while True:
+                currentTime = time.time()
+                if not state["rendered"] or currentTime - lastFrameTime < minimumFrameInterval:
+                    yield b""
+                    continue
+                state["rendered"] = False
+                state["capturing"] = True
+                try:
+                    windowToImage.Modified()
+                    writer.Write()
+                finally:
+                    state["capturing"] = False
+                jpegData = vtk.util.numpy_support.vtk_to_numpy(writer.GetResult()).tobytes()
+                # Rendering does not always change the view content (e.g., rendering is requested by an unrelated
+                # node change), skip the frame if it is the same as the previous one.
+                frameDigest = hashlib.md5(jpegData).digest()
+                if frameDigest == lastFrameDigest:
+                    yield b""
+                    continue
+                lastFrameDigest = frameDigest
+                lastFrameTime = currentTime
+                yield b"--frame\r\nContent-Type: image/jpeg\r\nContent-Length: %d\r\n\r\n" % len(jpegData)
+                yield jpegData
+                yield b"\r\n"
+        finally:
+            renderWindow.RemoveObserver(observerTag)
+
     def timeimage(self, request=""):
         """
         Handle requests with path: /timeimage